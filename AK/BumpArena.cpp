@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Assertions.h>
+#include <AK/BumpArena.h>
+
+namespace AK {
+
+// Enough for a layout pass over a large page, without letting a one-off spike pin memory forever.
+static constexpr size_t max_cached_chunk_count = 128;
+static constexpr size_t trimmed_cached_chunk_count = 32;
+
+namespace {
+
+struct ChunkCache {
+    struct CachedChunk {
+        CachedChunk* next;
+    };
+
+    ~ChunkCache() { trim_to(0); }
+
+    void* take()
+    {
+        if (!head)
+            return kmalloc(HeapPartition::Layout, BumpArena::chunk_size);
+        auto* chunk = head;
+        head = chunk->next;
+        --count;
+        return chunk;
+    }
+
+    void give_back(void* memory)
+    {
+        if (count >= max_cached_chunk_count) {
+            kfree(memory);
+            return;
+        }
+        head = new (memory) CachedChunk { head };
+        ++count;
+    }
+
+    void trim_to(size_t kept_count)
+    {
+        while (count > kept_count) {
+            auto* chunk = head;
+            head = chunk->next;
+            --count;
+            kfree(chunk);
+        }
+    }
+
+    CachedChunk* head { nullptr };
+    size_t count { 0 };
+};
+
+}
+
+static thread_local ChunkCache s_chunk_cache;
+
+void* BumpArena::allocate_slow(size_t size, size_t alignment)
+{
+    // NB: malloc only guarantees fundamental alignment, so the padding needed after the header depends on where the
+    //     memory actually lands. Budget for the worst case and align the address itself.
+    auto worst_case_size = sizeof(Chunk) + alignment - 1 + size;
+
+    // Allocations that don't fit a chunk get one of their own, which goes straight back to malloc afterwards.
+    if (worst_case_size > chunk_size) {
+        auto* memory = kmalloc(HeapPartition::Layout, worst_case_size);
+        VERIFY(memory);
+        m_large_chunks = new (memory) Chunk { m_large_chunks };
+        return reinterpret_cast<void*>(align_up_to(reinterpret_cast<FlatPtr>(memory) + sizeof(Chunk), alignment));
+    }
+
+    auto* memory = s_chunk_cache.take();
+    VERIFY(memory);
+    m_chunks = new (memory) Chunk { m_chunks };
+
+    auto base = reinterpret_cast<FlatPtr>(memory);
+    auto address = align_up_to(base + sizeof(Chunk), alignment);
+    m_cursor = address + size;
+    m_end = base + chunk_size;
+    return reinterpret_cast<void*>(address);
+}
+
+void BumpArena::reset()
+{
+    while (m_chunks) {
+        auto* next = m_chunks->next;
+        s_chunk_cache.give_back(m_chunks);
+        m_chunks = next;
+    }
+    while (m_large_chunks) {
+        auto* next = m_large_chunks->next;
+        kfree(m_large_chunks);
+        m_large_chunks = next;
+    }
+    m_cursor = 0;
+    m_end = 0;
+}
+
+void BumpArena::trim_thread_cache()
+{
+    s_chunk_cache.trim_to(trimmed_cached_chunk_count);
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+// A bump-pointer arena for short-lived allocations that all die together, e.g. everything belonging to one layout
+// pass. Chunks are borrowed from a per-thread cache and handed back on reset(), so a steady stream of arenas doesn't
+// keep going back to malloc. The arena never runs destructors; owners of non-trivial objects must do that themselves.
+class BumpArena {
+    AK_MAKE_NONCOPYABLE(BumpArena);
+    AK_MAKE_NONMOVABLE(BumpArena);
+
+public:
+    static constexpr size_t chunk_size = 32 * KiB;
+
+    BumpArena() = default;
+    ~BumpArena() { reset(); }
+
+    [[nodiscard]] void* allocate(size_t size, size_t alignment)
+    {
+        auto aligned = align_up_to(m_cursor, alignment);
+        if (m_cursor == 0 || aligned + size > m_end)
+            return allocate_slow(size, alignment);
+        m_cursor = aligned + size;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    template<typename T, typename... Args>
+    [[nodiscard]] T* make(Args&&... args)
+    {
+        return new (allocate(sizeof(T), alignof(T))) T { forward<Args>(args)... };
+    }
+
+    // Hands every chunk back. Anything allocated from the arena is gone afterwards.
+    void reset();
+
+    // Frees the cached chunks this thread is unlikely to need again. Call this at quiet points, e.g. after a frame.
+    static void trim_thread_cache();
+
+private:
+    struct Chunk {
+        Chunk* next;
+    };
+
+    void* allocate_slow(size_t size, size_t alignment);
+
+    Chunk* m_chunks { nullptr };
+    Chunk* m_large_chunks { nullptr };
+    FlatPtr m_cursor { 0 };
+    FlatPtr m_end { 0 };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::BumpArena;
+#endif
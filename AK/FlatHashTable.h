@@ -0,0 +1,563 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Concepts.h>
+#include <AK/Error.h>
+#include <AK/HashTable.h>
+#include <AK/IntegralMath.h>
+#include <AK/SIMD.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Traits.h>
+#include <AK/TypedTransfer.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+namespace Detail {
+
+// Every slot of a FlatHashTable has a control byte. Used slots store the low 7 bits of their value's hash in it, so
+// the high bit is only set for slots that are empty or deleted.
+static constexpr i8 flat_hash_table_empty_control = -128;
+static constexpr i8 flat_hash_table_deleted_control = -2;
+
+// The control bytes of 16 consecutive slots, which are compared at once.
+class FlatHashTableGroup {
+public:
+    static constexpr size_t size = 16;
+
+    explicit FlatHashTableGroup(i8 const* control)
+    {
+        __builtin_memcpy(&m_control, control, sizeof(m_control));
+    }
+
+    // Each of these returns a mask with a bit set for every slot in the group that matches.
+    u32 match(i8 control) const { return mask_of(m_control == control); }
+    u32 match_empty() const { return match(flat_hash_table_empty_control); }
+    u32 match_empty_or_deleted() const { return mask_of(m_control); }
+
+private:
+    static u32 mask_of(AK::SIMD::i8x16 vector)
+    {
+#if defined(__SSE2__)
+        return static_cast<u32>(__builtin_ia32_pmovmskb128((AK::SIMD::c8x16)vector));
+#else
+        u32 mask = 0;
+        for (size_t i = 0; i < size; ++i)
+            mask |= static_cast<u32>(vector[i] < 0) << i;
+        return mask;
+#endif
+    }
+
+    AK::SIMD::i8x16 m_control;
+};
+
+}
+
+template<typename HashTableType, typename T>
+class FlatHashTableIterator {
+    friend HashTableType;
+
+public:
+    bool operator==(FlatHashTableIterator const& other) const { return m_control == other.m_control; }
+    bool operator!=(FlatHashTableIterator const& other) const { return m_control != other.m_control; }
+    T& operator*() { return *m_slot; }
+    T* operator->() { return m_slot; }
+    void operator++()
+    {
+        ++m_control;
+        ++m_slot;
+        skip_to_used_slot();
+    }
+
+private:
+    FlatHashTableIterator(i8 const* control, T* slot, i8 const* end_control)
+        : m_control(control)
+        , m_slot(slot)
+        , m_end_control(end_control)
+    {
+        skip_to_used_slot();
+    }
+
+    void skip_to_used_slot()
+    {
+        while (m_control != m_end_control && *m_control < 0) {
+            ++m_control;
+            ++m_slot;
+        }
+    }
+
+    i8 const* m_control { nullptr };
+    T* m_slot { nullptr };
+    i8 const* m_end_control { nullptr };
+};
+
+// A set datastructure based on a hash table with open addressing, in the style of Abseil's "Swiss tables". The values
+// are stored apart from a byte of metadata per slot, and lookups compare the metadata of 16 slots at a time, so that
+// they rarely have to look at a value that doesn't match. This makes lookups faster than with HashTable when the table
+// is large or the values are expensive to compare, at the cost of not keeping any insertion order.
+// Removing a value only invalidates iterators to that value, while inserting one invalidates all of them.
+template<typename T, typename TraitsForT>
+class FlatHashTable {
+    using Group = Detail::FlatHashTableGroup;
+
+    static constexpr size_t grow_capacity_at_least = Group::size;
+    static constexpr size_t grow_at_load_factor_percent = 87;
+
+public:
+    FlatHashTable() = default;
+    explicit FlatHashTable(size_t capacity) { rehash(capacity); }
+
+    ~FlatHashTable()
+    {
+        if (!m_slots)
+            return;
+
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (auto& value : *this)
+                value.~T();
+        }
+
+        kfree(m_slots);
+    }
+
+    FlatHashTable(FlatHashTable const& other)
+    {
+        if (other.is_empty())
+            return;
+        rehash(other.capacity());
+        for (auto& it : other)
+            set(it);
+    }
+
+    FlatHashTable& operator=(FlatHashTable const& other)
+    {
+        FlatHashTable temporary(other);
+        swap(*this, temporary);
+        return *this;
+    }
+
+    FlatHashTable(FlatHashTable&& other) noexcept
+        : m_slots(exchange(other.m_slots, nullptr))
+        , m_control(exchange(other.m_control, nullptr))
+        , m_size(exchange(other.m_size, 0))
+        , m_deleted_count(exchange(other.m_deleted_count, 0))
+        , m_mask(exchange(other.m_mask, 0))
+    {
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept
+    {
+        FlatHashTable temporary { move(other) };
+        swap(*this, temporary);
+        return *this;
+    }
+
+    friend void swap(FlatHashTable& a, FlatHashTable& b) noexcept
+    {
+        swap(a.m_slots, b.m_slots);
+        swap(a.m_control, b.m_control);
+        swap(a.m_size, b.m_size);
+        swap(a.m_deleted_count, b.m_deleted_count);
+        swap(a.m_mask, b.m_mask);
+    }
+
+    [[nodiscard]] bool is_empty() const { return m_size == 0; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_slots ? m_mask + 1 : 0; }
+
+    template<typename U, size_t N>
+    ErrorOr<void> try_set_from(U (&from_array)[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+            TRY(try_set(from_array[i]));
+        return {};
+    }
+    template<typename U, size_t N>
+    void set_from(U (&from_array)[N])
+    {
+        MUST(try_set_from(from_array));
+    }
+
+    ErrorOr<void> try_ensure_capacity(size_t capacity)
+    {
+        // NB: Like HashTable, this treats the capacity as the number of values that can be stored without having to
+        //     reallocate, rather than the number of slots.
+        size_t required_capacity = (capacity * 100 / grow_at_load_factor_percent) + 1;
+        if (required_capacity <= this->capacity())
+            return {};
+        return try_rehash(required_capacity);
+    }
+    void ensure_capacity(size_t capacity)
+    {
+        MUST(try_ensure_capacity(capacity));
+    }
+
+    [[nodiscard]] bool contains(T const& value) const
+    {
+        return find(value) != end();
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] bool contains(K const& value) const
+    {
+        return find(value) != end();
+    }
+
+    using Iterator = FlatHashTableIterator<FlatHashTable, T>;
+    using ConstIterator = FlatHashTableIterator<FlatHashTable const, T const>;
+
+    [[nodiscard]] Iterator begin() { return iterator_at(0); }
+    [[nodiscard]] Iterator end() { return iterator_at(capacity()); }
+    [[nodiscard]] ConstIterator begin() const { return iterator_at(0); }
+    [[nodiscard]] ConstIterator end() const { return iterator_at(capacity()); }
+
+    void clear()
+    {
+        *this = FlatHashTable();
+    }
+
+    void clear_with_capacity()
+    {
+        if (!m_slots)
+            return;
+
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (auto& value : *this)
+                value.~T();
+        }
+        __builtin_memset(m_control, Detail::flat_hash_table_empty_control, control_size(capacity()));
+        m_size = 0;
+        m_deleted_count = 0;
+    }
+
+    template<typename U = T>
+    ErrorOr<HashSetResult> try_set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        if (should_grow())
+            TRY(try_grow());
+
+        return write_value(forward<U>(value), existing_entry_behavior);
+    }
+    template<typename U = T>
+    HashSetResult set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        return MUST(try_set(forward<U>(value), existing_entry_behavior));
+    }
+
+    template<typename TUnaryPredicate, typename InitializationCallback>
+    [[nodiscard]] T& ensure(unsigned hash, TUnaryPredicate predicate, InitializationCallback initialization_callback, HashSetExistingEntryBehavior existing_entry_behavior)
+    {
+        if (should_grow())
+            MUST(try_grow());
+
+        auto [index, found] = lookup_for_writing(hash, move(predicate));
+        if (!found) {
+            // NB: The slot stays unused until the value is constructed, so that the callback may iterate over the table.
+            new (&m_slots[index]) T(initialization_callback());
+            commit_inserted_slot(index, hash);
+        } else if (existing_entry_behavior == HashSetExistingEntryBehavior::Replace) {
+            m_slots[index] = T(initialization_callback());
+        }
+        return m_slots[index];
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] Iterator find(unsigned hash, TUnaryPredicate predicate)
+    {
+        return iterator_at(lookup_with_hash(hash, move(predicate)));
+    }
+
+    [[nodiscard]] Iterator find(T const& value)
+    {
+        if (is_empty())
+            return end();
+        return find(TraitsForT::hash(value), [&](auto& entry) { return TraitsForT::equals(entry, value); });
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] ConstIterator find(unsigned hash, TUnaryPredicate predicate) const
+    {
+        return iterator_at(lookup_with_hash(hash, move(predicate)));
+    }
+
+    [[nodiscard]] ConstIterator find(T const& value) const
+    {
+        if (is_empty())
+            return end();
+        return find(TraitsForT::hash(value), [&](auto& entry) { return TraitsForT::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] Iterator find(K const& value)
+    {
+        if (is_empty())
+            return end();
+        return find(Traits<K>::hash(value), [&](auto& entry) { return Traits<T>::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] ConstIterator find(K const& value) const
+    {
+        if (is_empty())
+            return end();
+        return find(Traits<K>::hash(value), [&](auto& entry) { return Traits<T>::equals(entry, value); });
+    }
+
+    bool remove(T const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) bool remove(K const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    // This invalidates the iterator
+    void remove(Iterator& iterator)
+    {
+        VERIFY(iterator.m_control && iterator.m_control != iterator.m_end_control);
+        delete_slot(iterator.m_control - m_control);
+    }
+
+    template<typename TUnaryPredicate>
+    bool remove_all_matching(TUnaryPredicate const& predicate)
+    {
+        bool has_removed_anything = false;
+        for (size_t i = 0; i < capacity(); ++i) {
+            if (m_control[i] < 0 || !predicate(m_slots[i]))
+                continue;
+
+            delete_slot(i);
+            has_removed_anything = true;
+        }
+        return has_removed_anything;
+    }
+
+    template<typename TUnaryPredicate>
+    Vector<T> take_all_matching(TUnaryPredicate const& predicate)
+    {
+        Vector<T> values;
+        for (size_t i = 0; i < capacity(); ++i) {
+            if (m_control[i] < 0 || !predicate(m_slots[i]))
+                continue;
+
+            values.append(move(m_slots[i]));
+            delete_slot(i);
+        }
+        return values;
+    }
+
+    [[nodiscard]] Vector<T> values() const
+    {
+        Vector<T> list;
+        list.ensure_capacity(size());
+        for (auto& value : *this)
+            list.unchecked_append(value);
+        return list;
+    }
+
+private:
+    // The hash picks the group that a lookup starts at with its high bits, and the control byte with its low 7 bits.
+    static constexpr size_t group_index_for_hash(unsigned hash) { return hash >> 7; }
+    static constexpr i8 control_for_hash(unsigned hash) { return static_cast<i8>(hash & 0x7f); }
+
+    // NB: The control bytes of the first group are repeated after the last slot, so that a group can be loaded at any
+    //     slot without having to wrap around.
+    static constexpr size_t control_size(size_t capacity) { return capacity + Group::size; }
+    static constexpr size_t size_in_bytes(size_t capacity) { return (sizeof(T) * capacity) + control_size(capacity); }
+
+    // Deleted slots are counted as well, since they lengthen lookups just like used ones until the table is rehashed.
+    bool should_grow() const { return ((m_size + m_deleted_count + 1) * 100) >= (capacity() * grow_at_load_factor_percent); }
+
+    Iterator iterator_at(size_t index) { return Iterator(m_control + index, m_slots + index, m_control + capacity()); }
+    ConstIterator iterator_at(size_t index) const { return ConstIterator(m_control + index, m_slots + index, m_control + capacity()); }
+
+    // Groups are visited at increasing distances from the first one, which reaches every group of the table once the
+    // capacity is a power of two.
+    struct ProbeSequence {
+        size_t offset;
+        size_t mask;
+        size_t stride { 0 };
+
+        void next()
+        {
+            stride += Group::size;
+            offset = (offset + stride) & mask;
+        }
+    };
+
+    ProbeSequence probe_sequence_for_hash(unsigned hash) const { return { group_index_for_hash(hash) & m_mask, m_mask }; }
+
+    ErrorOr<void> try_grow()
+    {
+        // If the table is mostly filled up with deleted slots, dropping those makes enough room without growing it.
+        if (capacity() != 0 && (m_size + 1) * 200 <= capacity() * grow_at_load_factor_percent)
+            return try_rehash(capacity());
+        return try_rehash(max(capacity() * 2, grow_capacity_at_least));
+    }
+
+    ErrorOr<void> try_rehash(size_t new_capacity)
+    {
+        new_capacity = AK::exp2<size_t>(AK::ceil_log2(max(new_capacity, grow_capacity_at_least)));
+        VERIFY(new_capacity > size());
+
+        auto* new_slots = kmalloc(size_in_bytes(new_capacity));
+        if (!new_slots)
+            return Error::from_errno(ENOMEM);
+
+        auto* old_slots = m_slots;
+        auto* old_control = m_control;
+        auto old_capacity = capacity();
+
+        m_slots = static_cast<T*>(new_slots);
+        m_control = reinterpret_cast<i8*>(m_slots + new_capacity);
+        m_mask = new_capacity - 1;
+        m_deleted_count = 0;
+        __builtin_memset(m_control, Detail::flat_hash_table_empty_control, control_size(new_capacity));
+
+        if (!old_slots)
+            return {};
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_control[i] < 0)
+                continue;
+
+            auto hash = TraitsForT::hash(old_slots[i]);
+            auto index = find_slot_for_inserting(hash);
+            TypedTransfer<T>::relocate(&m_slots[index], &old_slots[i], 1);
+            set_control(index, control_for_hash(hash));
+        }
+
+        kfree(old_slots);
+        return {};
+    }
+    void rehash(size_t new_capacity)
+    {
+        MUST(try_rehash(new_capacity));
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] size_t lookup_with_hash(unsigned hash, TUnaryPredicate predicate) const
+    {
+        if (is_empty())
+            return capacity();
+
+        auto control = control_for_hash(hash);
+        for (auto probe_sequence = probe_sequence_for_hash(hash);; probe_sequence.next()) {
+            Group group { m_control + probe_sequence.offset };
+            for (auto matches = group.match(control); matches != 0; matches &= matches - 1) {
+                auto index = (probe_sequence.offset + count_trailing_zeroes(matches)) & m_mask;
+                if (predicate(m_slots[index]))
+                    return index;
+            }
+            // A value is never placed beyond a group that had an empty slot when it was inserted.
+            if (group.match_empty() != 0)
+                return capacity();
+        }
+    }
+
+    // Returns the first empty or deleted slot along the probe sequence for the hash.
+    [[nodiscard]] size_t find_slot_for_inserting(unsigned hash) const
+    {
+        for (auto probe_sequence = probe_sequence_for_hash(hash);; probe_sequence.next()) {
+            if (auto matches = Group { m_control + probe_sequence.offset }.match_empty_or_deleted(); matches != 0)
+                return (probe_sequence.offset + count_trailing_zeroes(matches)) & m_mask;
+        }
+    }
+
+    struct LookupForWritingResult {
+        size_t index;
+        bool found;
+    };
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] LookupForWritingResult lookup_for_writing(unsigned hash, TUnaryPredicate predicate) const
+    {
+        if (auto index = lookup_with_hash(hash, move(predicate)); index != capacity())
+            return { index, true };
+        return { find_slot_for_inserting(hash), false };
+    }
+
+    template<typename U = T>
+    HashSetResult write_value(U&& value, HashSetExistingEntryBehavior existing_entry_behavior)
+    {
+        auto hash = TraitsForT::hash(value);
+        auto [index, found] = lookup_for_writing(hash, [&](auto& entry) { return TraitsForT::equals(entry, value); });
+        if (found) {
+            if (existing_entry_behavior == HashSetExistingEntryBehavior::Keep)
+                return HashSetResult::KeptExistingEntry;
+            m_slots[index] = forward<U>(value);
+            return HashSetResult::ReplacedExistingEntry;
+        }
+
+        new (&m_slots[index]) T(forward<U>(value));
+        commit_inserted_slot(index, hash);
+        return HashSetResult::InsertedNewEntry;
+    }
+
+    void commit_inserted_slot(size_t index, unsigned hash)
+    {
+        if (m_control[index] == Detail::flat_hash_table_deleted_control)
+            --m_deleted_count;
+        set_control(index, control_for_hash(hash));
+        ++m_size;
+    }
+
+    void delete_slot(size_t index)
+    {
+        m_slots[index].~T();
+        --m_size;
+
+        // If every group that contains this slot has an empty slot as well, no lookup was ever continued past it, so
+        // it can become empty again rather than deleted.
+        auto empty_after = Group { m_control + index }.match_empty();
+        auto empty_before = Group { m_control + ((index - Group::size) & m_mask) }.match_empty();
+        if (empty_after != 0 && empty_before != 0
+            && static_cast<size_t>(count_trailing_zeroes(empty_after) + count_leading_zeroes(empty_before << 16)) < Group::size) {
+            set_control(index, Detail::flat_hash_table_empty_control);
+            return;
+        }
+
+        set_control(index, Detail::flat_hash_table_deleted_control);
+        ++m_deleted_count;
+    }
+
+    void set_control(size_t index, i8 control)
+    {
+        m_control[index] = control;
+        if (index < Group::size)
+            m_control[index + capacity()] = control;
+    }
+
+    T* m_slots { nullptr };
+    i8* m_control { nullptr };
+    size_t m_size { 0 };
+    size_t m_deleted_count { 0 };
+    size_t m_mask { 0 };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::FlatHashTable;
+#endif
@@ -5,7 +5,7 @@
  */
 
 #include <AK/FlyString.h>
-#include <AK/HashTable.h>
+#include <AK/FlyStringTable.h>
 #include <AK/Singleton.h>
 #include <AK/String.h>
 #include <AK/StringData.h>
@@ -22,7 +22,7 @@ struct FlyStringTableHashTraits : public Traits<Detail::StringData const*> {
 
 static auto& all_fly_strings()
 {
-    static Singleton<HashTable<Detail::StringData const*, FlyStringTableHashTraits>> table;
+    static Singleton<Detail::FlyStringTable<Detail::StringData, FlyStringTableHashTraits>> table;
     return *table;
 }
 
@@ -32,8 +32,8 @@ ErrorOr<FlyString> FlyString::from_utf8(StringView string)
         return FlyString {};
     if (string.length() <= Detail::MAX_SHORT_STRING_BYTE_COUNT)
         return FlyString { TRY(String::from_utf8(string)) };
-    if (auto it = all_fly_strings().find(string.hash(), [&](auto& entry) { return entry->bytes_as_string_view() == string; }); it != all_fly_strings().end())
-        return FlyString { Detail::StringBase(**it) };
+    if (auto data = all_fly_strings().find(string.hash(), [&](auto& entry) { return entry.bytes_as_string_view() == string; }))
+        return FlyString { Detail::StringBase(data.release_nonnull()) };
     return FlyString { TRY(String::from_utf8(string)) };
 }
 
@@ -43,8 +43,8 @@ FlyString FlyString::from_utf8_without_validation(ReadonlyBytes string)
         return FlyString {};
     if (string.size() <= Detail::MAX_SHORT_STRING_BYTE_COUNT)
         return FlyString { String::from_utf8_without_validation(string) };
-    if (auto it = all_fly_strings().find(StringView(string).hash(), [&](auto& entry) { return entry->bytes_as_string_view() == string; }); it != all_fly_strings().end())
-        return FlyString { Detail::StringBase(**it) };
+    if (auto data = all_fly_strings().find(StringView(string).hash(), [&](auto& entry) { return entry.bytes_as_string_view() == string; }))
+        return FlyString { Detail::StringBase(data.release_nonnull()) };
     return FlyString { String::from_utf8_without_validation(string) };
 }
 
@@ -62,15 +62,9 @@ FlyString::FlyString(String const& string)
         return;
     }
 
-    auto it = all_fly_strings().find(string.m_impl.data);
-    if (it == all_fly_strings().end()) {
-        m_data = string;
-        all_fly_strings().set(string.m_impl.data);
-        string.m_impl.data->set_fly_string(true);
-    } else {
-        m_data.m_impl.data = *it;
-        m_data.m_impl.data->ref();
-    }
+    m_data = Detail::StringBase(all_fly_strings().intern(*string.m_impl.data, [](auto const& string_data) {
+        string_data.set_fly_string(true);
+    }));
 }
 
 FlyString& FlyString::operator=(String const& string)
@@ -209,7 +203,7 @@ namespace Detail {
 
 void did_destroy_fly_string_data(Badge<Detail::StringData>, Detail::StringData const& string_data)
 {
-    all_fly_strings().remove(&string_data);
+    all_fly_strings().did_destroy(string_data);
 }
 
 }
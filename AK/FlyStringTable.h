@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/HashTable.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefPtr.h>
+
+namespace AK::Detail {
+
+// The table of interned strings behind FlyString and Utf16FlyString, which is shared by every thread. It is split into
+// shards with a lock each, so that threads interning different strings rarely have to wait for one another.
+template<typename DataType, typename TraitsForData>
+class FlyStringTable {
+    AK_MAKE_NONCOPYABLE(FlyStringTable);
+    AK_MAKE_NONMOVABLE(FlyStringTable);
+
+public:
+    FlyStringTable() = default;
+
+    // Returns a reference to the interned string that the predicate matches, if there is one.
+    template<typename TUnaryPredicate>
+    RefPtr<DataType const> find(unsigned hash, TUnaryPredicate predicate)
+    {
+        auto& shard = shard_for_hash(hash);
+        ShardLocker locker { shard };
+
+        auto it = shard.strings.find(hash, [&](auto const* entry) { return predicate(*entry); });
+        if (it == shard.strings.end() || !(*it)->try_ref_fly_string())
+            return nullptr;
+        return adopt_ref(**it);
+    }
+
+    // Interns the string, unless an equal string was interned before, which is returned instead. The string is marked
+    // as a fly string before any other thread can see it.
+    template<typename MarkAsFlyString>
+    NonnullRefPtr<DataType const> intern(DataType const& data, MarkAsFlyString mark_as_fly_string)
+    {
+        auto hash = TraitsForData::hash(&data);
+        auto& shard = shard_for_hash(hash);
+        ShardLocker locker { shard };
+
+        if (auto it = shard.strings.find(&data); it != shard.strings.end()) {
+            if ((*it)->try_ref_fly_string())
+                return adopt_ref(**it);
+
+            // NB: Another thread is destroying the string, and will find it gone once it gets the lock.
+            shard.strings.remove(it);
+        }
+
+        mark_as_fly_string(data);
+        shard.strings.set(&data);
+        return NonnullRefPtr<DataType const> { data };
+    }
+
+    // Removes this exact string, rather than any string that is equal to it, which may have replaced it already.
+    void did_destroy(DataType const& data)
+    {
+        auto hash = TraitsForData::hash(&data);
+        auto& shard = shard_for_hash(hash);
+        ShardLocker locker { shard };
+
+        if (auto it = shard.strings.find(hash, [&](auto const* entry) { return entry == &data; }); it != shard.strings.end())
+            shard.strings.remove(it);
+    }
+
+    size_t size()
+    {
+        size_t size = 0;
+        for (auto& shard : m_shards) {
+            ShardLocker locker { shard };
+            size += shard.strings.size();
+        }
+        return size;
+    }
+
+private:
+    static constexpr size_t shard_count = 16;
+
+    struct Shard {
+        Atomic<bool> is_locked { false };
+        HashTable<DataType const*, TraitsForData> strings;
+    };
+
+    // NB: The locks are only ever held for a single lookup, so waiting threads spin rather than sleep.
+    class ShardLocker {
+        AK_MAKE_NONCOPYABLE(ShardLocker);
+        AK_MAKE_NONMOVABLE(ShardLocker);
+
+    public:
+        explicit ShardLocker(Shard& shard)
+            : m_shard(shard)
+        {
+            while (m_shard.is_locked.exchange(true, AK::MemoryOrder::memory_order_acquire)) {
+                while (m_shard.is_locked.load(AK::MemoryOrder::memory_order_relaxed))
+                    AK::atomic_pause();
+            }
+        }
+
+        ~ShardLocker()
+        {
+            m_shard.is_locked.store(false, AK::MemoryOrder::memory_order_release);
+        }
+
+    private:
+        Shard& m_shard;
+    };
+
+    // The shards are picked by the high bits of the hash, since the hash tables within them use the low ones.
+    static_assert(shard_count == 16);
+    Shard& shard_for_hash(unsigned hash) { return m_shards[hash >> 28]; }
+
+    Array<Shard, shard_count> m_shards;
+};
+
+}
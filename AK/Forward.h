@@ -112,6 +112,12 @@ class HashMap;
 template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
 using OrderedHashMap = HashMap<K, V, KeyTraits, ValueTraits, true>;
 
+template<typename T, typename TraitsForT = Traits<T>>
+class FlatHashTable;
+
+template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
+class FlatHashMap;
+
 template<typename... Ts>
 class Badge;
 
@@ -193,6 +199,8 @@ using AK::Error;
 using AK::ErrorOr;
 using AK::FastLastAccess;
 using AK::FixedArray;
+using AK::FlatHashMap;
+using AK::FlatHashTable;
 using AK::FlyString;
 using AK::Function;
 using AK::GenericLexer;
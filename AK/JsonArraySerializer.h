@@ -43,7 +43,10 @@ public:
     ErrorOr<void> add(JsonValue const& value)
     {
         TRY(begin_item());
-        value.serialize(m_builder);
+        if constexpr (IsLegacyBuilder<Builder>)
+            value.serialize(m_builder);
+        else
+            TRY(m_builder.append_json_value(value));
         return {};
     }
 
@@ -38,7 +38,10 @@ public:
     ErrorOr<void> add(StringView key, JsonValue const& value)
     {
         TRY(begin_item(key));
-        value.serialize(m_builder);
+        if constexpr (IsLegacyBuilder<Builder>)
+            value.serialize(m_builder);
+        else
+            TRY(m_builder.append_json_value(value));
         return {};
     }
 
@@ -10,6 +10,7 @@
 #include <AK/JsonParser.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringConversions.h>
+#include <AK/Utf8View.h>
 #include <math.h>
 
 namespace AK {
@@ -138,6 +139,59 @@ ErrorOr<String> JsonParser::consume_and_unescape_string()
     return final_sb.to_string();
 }
 
+// Checks a string in the same way as consume_and_unescape_string() does, without building the unescaped string.
+ErrorOr<void> JsonParser::skip_string()
+{
+    if (!consume_specific('"'))
+        return Error::from_string_literal("JsonParser: Expected '\"'");
+    auto start_index = tell();
+
+    for (;;) {
+        char ch = peek();
+        if (ch == 0)
+            return Error::from_string_literal("JsonParser: EOF while parsing String");
+        if (is_ascii_c0_control(ch))
+            return Error::from_string_literal("JsonParser: ASCII control sequence encountered");
+        ignore();
+
+        if (ch == '"') {
+            // NB: Escape sequences are plain ASCII, so checking the bytes as they are written is enough.
+            if (!Utf8View { m_input.substring_view(start_index, tell() - start_index - 1) }.validate())
+                return Error::from_string_literal("JsonParser: Invalid UTF-8 in String");
+            return {};
+        }
+        if (ch != '\\')
+            continue;
+
+        switch (peek()) {
+        case '\0':
+            return Error::from_string_literal("JsonParser: EOF while parsing String");
+        case '"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+            ignore();
+            break;
+        case 'u':
+            ignore(); // 'u'
+            if (decode_single_or_paired_surrogate().is_error())
+                return Error::from_string_literal("JsonParser: Error while parsing Unicode escape");
+            break;
+        default:
+            return Error::from_string_literal("JsonParser: Invalid escaped character");
+        }
+    }
+}
+
+void JsonParser::ignore_whitespace()
+{
+    ignore_while(is_space);
+}
+
 ErrorOr<JsonValue> JsonParser::parse_object()
 {
     if (m_current_nesting_depth >= max_nesting_depth)
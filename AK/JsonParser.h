@@ -16,6 +16,8 @@ public:
     static ErrorOr<JsonValue> parse(StringView);
 
 private:
+    friend class JsonReader;
+
     explicit JsonParser(StringView input)
         : GenericLexer(input)
     {
@@ -25,6 +27,8 @@ private:
     ErrorOr<JsonValue> parse_helper();
 
     ErrorOr<String> consume_and_unescape_string();
+    ErrorOr<void> skip_string();
+    void ignore_whitespace();
     ErrorOr<JsonValue> parse_array();
     ErrorOr<JsonValue> parse_object();
     ErrorOr<JsonValue> parse_number();
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonReader.h>
+
+namespace AK {
+
+JsonReader::JsonReader(StringView input)
+    : m_parser(input)
+{
+}
+
+ErrorOr<JsonReader::Token> JsonReader::next()
+{
+    return read_token(ShouldMaterialize::Yes);
+}
+
+ErrorOr<bool> JsonReader::next_element()
+{
+    VERIFY(!m_containers.is_empty() && m_containers.last() == Container::Array);
+    VERIFY(m_state == State::ValueOrArrayEnd || m_state == State::AfterValue);
+
+    m_parser.ignore_whitespace();
+    if (m_parser.peek() == ']') {
+        read_container_end();
+        return false;
+    }
+
+    if (m_state == State::AfterValue && !m_parser.consume_specific(','))
+        return Error::from_string_literal("JsonReader: Expected ','");
+
+    m_state = State::Value;
+    return true;
+}
+
+ErrorOr<JsonValue> JsonReader::read_value()
+{
+    VERIFY(expects_value());
+
+    // NB: The parser only counts the objects and arrays within the value, so tell it about those that we're inside of.
+    m_parser.m_current_nesting_depth = m_containers.size();
+    auto value = TRY(m_parser.parse_helper());
+
+    m_state = State::AfterValue;
+    return value;
+}
+
+ErrorOr<void> JsonReader::skip_value()
+{
+    VERIFY(expects_value());
+
+    // NB: The end of an array is not a value, so it must not be skipped over as one.
+    m_state = State::Value;
+
+    auto depth = m_containers.size();
+    do {
+        TRY(read_token(ShouldMaterialize::No));
+    } while (m_containers.size() > depth);
+
+    return {};
+}
+
+ErrorOr<JsonReader::Token> JsonReader::read_token(ShouldMaterialize should_materialize)
+{
+    m_parser.ignore_whitespace();
+
+    switch (m_state) {
+    case State::NameOrObjectEnd:
+        if (m_parser.peek() == '}')
+            return read_container_end();
+        [[fallthrough]];
+    case State::Name:
+        if (should_materialize == ShouldMaterialize::Yes)
+            m_name = TRY(m_parser.consume_and_unescape_string());
+        else
+            TRY(m_parser.skip_string());
+
+        m_parser.ignore_whitespace();
+        if (!m_parser.consume_specific(':'))
+            return Error::from_string_literal("JsonReader: Expected ':'");
+
+        m_state = State::Value;
+        return Token::Name;
+
+    case State::ValueOrArrayEnd:
+        if (m_parser.peek() == ']')
+            return read_container_end();
+        [[fallthrough]];
+    case State::Value:
+        switch (m_parser.peek()) {
+        case '{':
+            return read_container_start(Container::Object);
+        case '[':
+            return read_container_start(Container::Array);
+        case '"':
+            // OPTIMIZATION: Strings that are being skipped are only checked, rather than unescaped into a new string.
+            if (should_materialize == ShouldMaterialize::Yes)
+                m_value = TRY(m_parser.parse_string());
+            else
+                TRY(m_parser.skip_string());
+            break;
+        default:
+            m_value = TRY(m_parser.parse_helper());
+            break;
+        }
+
+        m_state = State::AfterValue;
+        return Token::Value;
+
+    case State::AfterValue: {
+        if (m_containers.is_empty()) {
+            m_state = State::Done;
+            return read_token(should_materialize);
+        }
+
+        auto container = m_containers.last();
+        if (m_parser.peek() == (container == Container::Object ? '}' : ']'))
+            return read_container_end();
+        if (!m_parser.consume_specific(','))
+            return Error::from_string_literal("JsonReader: Expected ','");
+
+        m_state = container == Container::Object ? State::Name : State::Value;
+        return read_token(should_materialize);
+    }
+
+    case State::Done:
+        if (!m_parser.is_eof())
+            return Error::from_string_literal("JsonReader: Didn't consume all input");
+        return Token::EndOfInput;
+    }
+
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<JsonReader::Token> JsonReader::read_container_start(Container container)
+{
+    if (m_containers.size() >= JsonParser::max_nesting_depth)
+        return Error::from_string_literal("JsonReader: Exceeded maximum nesting depth");
+
+    TRY(m_containers.try_append(container));
+    m_parser.ignore(); // '{' or '['
+
+    if (container == Container::Object) {
+        m_state = State::NameOrObjectEnd;
+        return Token::ObjectStart;
+    }
+    m_state = State::ValueOrArrayEnd;
+    return Token::ArrayStart;
+}
+
+JsonReader::Token JsonReader::read_container_end()
+{
+    auto container = m_containers.take_last();
+    m_parser.ignore(); // '}' or ']'
+
+    m_state = State::AfterValue;
+    return container == Container::Object ? Token::ObjectEnd : Token::ArrayEnd;
+}
+
+}
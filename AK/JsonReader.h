@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/JsonParser.h>
+#include <AK/JsonValue.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// Reads a JSON text one token at a time, so that the caller can pick out the parts it needs without a JsonValue being
+// built for all of it. Members and elements that aren't needed may be skipped without anything being allocated for
+// them, and those that are needed may be read into a JsonValue on their own.
+//
+//     JsonReader reader { json };
+//     if (TRY(reader.next()) != JsonReader::Token::ObjectStart)
+//         return Error::from_string_literal("Expected an object");
+//     while (TRY(reader.next()) == JsonReader::Token::Name) {
+//         if (reader.name() == "id"sv)
+//             id = TRY(reader.read_value());
+//         else
+//             TRY(reader.skip_value());
+//     }
+//
+// The whole text is checked as strictly as JsonParser does, including the parts that are skipped.
+class JsonReader {
+public:
+    enum class Token : u8 {
+        ObjectStart,
+        ObjectEnd,
+        ArrayStart,
+        ArrayEnd,
+        Name,
+        Value,
+        EndOfInput,
+    };
+
+    explicit JsonReader(StringView input);
+
+    // Reads the next token. The name of a member is available from name() after Token::Name was read, and the value of
+    // a string, number, boolean or null from value() after Token::Value was read.
+    ErrorOr<Token> next();
+
+    // Moves on to the next element of the array that is being read, and returns false once the end of the array was
+    // read instead.
+    ErrorOr<bool> next_element();
+
+    // Reads the value that comes next, which may be a whole object or array, into a JsonValue.
+    ErrorOr<JsonValue> read_value();
+
+    // Skips over the value that comes next, which may be a whole object or array.
+    ErrorOr<void> skip_value();
+
+    String const& name() const { return m_name; }
+    JsonValue const& value() const { return m_value; }
+
+    // The number of objects and arrays that the reader is inside of.
+    size_t depth() const { return m_containers.size(); }
+
+private:
+    enum class Container : u8 {
+        Object,
+        Array,
+    };
+
+    enum class State : u8 {
+        Value,
+        ValueOrArrayEnd,
+        Name,
+        NameOrObjectEnd,
+        AfterValue,
+        Done,
+    };
+
+    enum class ShouldMaterialize : u8 {
+        No,
+        Yes,
+    };
+
+    ErrorOr<Token> read_token(ShouldMaterialize);
+    ErrorOr<Token> read_container_start(Container);
+    Token read_container_end();
+
+    bool expects_value() const { return m_state == State::Value || m_state == State::ValueOrArrayEnd; }
+
+    JsonParser m_parser;
+    Vector<Container, 16> m_containers;
+    State m_state { State::Value };
+
+    String m_name;
+    JsonValue m_value;
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::JsonReader;
+#endif
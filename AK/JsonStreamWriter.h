@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Format.h>
+#include <AK/JsonValue.h>
+#include <AK/Noncopyable.h>
+#include <AK/Stream.h>
+#include <AK/StringBuilder.h>
+
+namespace AK {
+
+// A builder for JsonObjectSerializer and JsonArraySerializer that writes the JSON text to a stream as it is being
+// serialized, so that a large text never has to be held in memory as a whole. The text is written in chunks of about
+// flush_threshold bytes, and whatever is left once serializing is done is written by flush(), which must be called.
+class JsonStreamWriter {
+    AK_MAKE_NONCOPYABLE(JsonStreamWriter);
+    AK_MAKE_NONMOVABLE(JsonStreamWriter);
+
+public:
+    static constexpr size_t flush_threshold = 64 * KiB;
+
+    explicit JsonStreamWriter(Stream& stream)
+        : m_stream(stream)
+    {
+    }
+
+    ErrorOr<void> append(char ch)
+    {
+        TRY(m_buffer.try_append(ch));
+        return flush_if_needed();
+    }
+
+    ErrorOr<void> append(StringView string)
+    {
+        TRY(m_buffer.try_append(string));
+        return flush_if_needed();
+    }
+
+    ErrorOr<void> append_escaped_for_json(StringView string)
+    {
+        TRY(m_buffer.try_append_escaped_for_json(string));
+        return flush_if_needed();
+    }
+
+    template<typename... Parameters>
+    ErrorOr<void> appendff(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
+    {
+        VariadicFormatParams<AllowDebugOnlyFormatters::No, Parameters...> variadic_format_params { parameters... };
+        TRY(vformat(m_buffer, fmtstr.view(), variadic_format_params));
+        return flush_if_needed();
+    }
+
+    ErrorOr<void> append_json_value(JsonValue const& value)
+    {
+        value.serialize(m_buffer);
+        return flush_if_needed();
+    }
+
+    ErrorOr<void> flush()
+    {
+        if (m_buffer.is_empty())
+            return {};
+
+        auto result = m_stream.write_until_depleted(m_buffer.string_view().bytes());
+        m_buffer.clear();
+        return result;
+    }
+
+private:
+    ErrorOr<void> flush_if_needed()
+    {
+        if (m_buffer.length() < flush_threshold)
+            return {};
+        return flush();
+    }
+
+    Stream& m_stream;
+    StringBuilder m_buffer;
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::JsonStreamWriter;
+#endif
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Assertions.h>
+#include <AK/Atomic.h>
 #include <AK/Checked.h>
 #include <AK/Diagnostics.h>
 #include <AK/Noncopyable.h>
@@ -49,6 +50,34 @@ protected:
         return --m_ref_count;
     }
 
+    // NB: These are for objects that start out on one thread and are shared between threads later on. Once an object
+    //     has been shared, every thread has to update its reference count with these rather than the functions above.
+    ALWAYS_INLINE void ref_atomically() const
+    {
+        auto old_ref_count = AK::atomic_fetch_add(&m_ref_count, 1u, AK::MemoryOrder::memory_order_relaxed);
+        VERIFY(old_ref_count > 0);
+        VERIFY(!Checked<RefCountType>::addition_would_overflow(old_ref_count, 1));
+    }
+
+    [[nodiscard]] bool try_ref_atomically() const
+    {
+        RefCountType expected = AK::atomic_load(&m_ref_count, AK::MemoryOrder::memory_order_relaxed);
+        for (;;) {
+            if (expected == 0)
+                return false;
+            VERIFY(!Checked<RefCountType>::addition_would_overflow(expected, 1));
+            if (AK::atomic_compare_exchange_strong(&m_ref_count, expected, expected + 1, AK::MemoryOrder::memory_order_acquire))
+                return true;
+        }
+    }
+
+    ALWAYS_INLINE RefCountType deref_base_atomically() const
+    {
+        auto old_ref_count = AK::atomic_fetch_sub(&m_ref_count, 1u, AK::MemoryOrder::memory_order_acq_rel);
+        VERIFY(old_ref_count > 0);
+        return old_ref_count - 1;
+    }
+
     RefCountType mutable m_ref_count { 1 };
 };
 
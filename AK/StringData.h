@@ -78,6 +78,34 @@ public:
             Detail::did_destroy_fly_string_data({}, *this);
     }
 
+    // NB: Fly strings are shared by every thread through the fly string table, so their reference count is updated
+    //     atomically. Any other string only belongs to one thread at a time.
+    ALWAYS_INLINE void ref() const
+    {
+        if (m_is_fly_string)
+            ref_atomically();
+        else
+            RefCounted::ref();
+    }
+
+    ALWAYS_INLINE bool unref() const
+    {
+        if (!m_is_fly_string)
+            return RefCounted::unref();
+        if (deref_base_atomically() != 0)
+            return false;
+        delete this;
+        return true;
+    }
+
+    // The fly string table may still contain a fly string that another thread is destroying, which this refuses to
+    // take a reference to.
+    [[nodiscard]] bool try_ref_fly_string() const
+    {
+        VERIFY(m_is_fly_string);
+        return try_ref_atomically();
+    }
+
     SubstringData const& substring_data() const
     {
         return *reinterpret_cast<SubstringData const*>(m_bytes_or_substring_data);
@@ -4,7 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/HashTable.h>
+#include <AK/FlyStringTable.h>
 #include <AK/Singleton.h>
 #include <AK/Utf16FlyString.h>
 
@@ -18,7 +18,7 @@ struct Utf16FlyStringTableHashTraits : public Traits<Detail::Utf16StringData con
 
 static auto& all_utf16_fly_strings()
 {
-    static Singleton<HashTable<Detail::Utf16StringData const*, Utf16FlyStringTableHashTraits>> table;
+    static Singleton<Detail::FlyStringTable<Detail::Utf16StringData, Utf16FlyStringTableHashTraits>> table;
     return *table;
 }
 
@@ -26,7 +26,7 @@ namespace Detail {
 
 void did_destroy_utf16_fly_string_data(Badge<Detail::Utf16StringData>, Detail::Utf16StringData const& data)
 {
-    all_utf16_fly_strings().remove(&data);
+    all_utf16_fly_strings().did_destroy(data);
 }
 
 }
@@ -45,8 +45,8 @@ Optional<Utf16FlyString> Utf16FlyString::create_fly_string_from_cache(ViewType c
             return Utf16String::from_utf16(string);
     }
 
-    if (auto it = all_utf16_fly_strings().find(string.hash(), [&](auto const& entry) { return *entry == string; }); it != all_utf16_fly_strings().end())
-        return Utf16FlyString { Detail::Utf16StringBase(**it) };
+    if (auto data = all_utf16_fly_strings().find(string.hash(), [&](auto const& entry) { return entry == string; }))
+        return Utf16FlyString { Detail::Utf16StringBase(data.release_nonnull()) };
 
     return {};
 }
@@ -93,14 +93,9 @@ Utf16FlyString::Utf16FlyString(Utf16String const& string)
         return;
     }
 
-    if (auto it = all_utf16_fly_strings().find(data); it == all_utf16_fly_strings().end()) {
-        m_data = string;
-
-        all_utf16_fly_strings().set(data);
-        data->mark_as_fly_string({});
-    } else {
-        m_data.set_data({}, *it);
-    }
+    m_data = Detail::Utf16StringBase(all_utf16_fly_strings().intern(*data, [](auto const& string_data) {
+        string_data.mark_as_fly_string({});
+    }));
 }
 
 size_t Utf16FlyString::number_of_utf16_fly_strings()
@@ -276,6 +276,16 @@ public:
         return string;
     }
 
+    // The callback must write at least one non-ASCII code unit, since strings of only ASCII use ASCII storage.
+    template<typename Callback>
+    static Utf16String create_uninitialized_utf16(size_t length_in_code_units, Callback callback)
+    {
+        Span<char16_t> buffer;
+        Utf16String string { Detail::Utf16StringData::create_uninitialized_utf16(length_in_code_units, buffer) };
+        callback(buffer);
+        return string;
+    }
+
     constexpr Utf16String(Badge<Optional<Utf16String>>, nullptr_t)
         : Detail::Utf16StringBase(Badge<Utf16String> {}, nullptr)
     {
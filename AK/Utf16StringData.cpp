@@ -72,6 +72,15 @@ NonnullRefPtr<Utf16StringData> Utf16StringData::create_uninitialized_ascii(size_
     return string;
 }
 
+NonnullRefPtr<Utf16StringData> Utf16StringData::create_uninitialized_utf16(size_t length_in_code_units, Span<char16_t>& buffer)
+{
+    VERIFY_UTF16_LENGTH(length_in_code_units);
+
+    auto string = create_uninitialized(StorageType::UTF16, length_in_code_units);
+    buffer = { string->m_utf16_data, length_in_code_units };
+    return string;
+}
+
 NonnullRefPtr<Utf16StringData> Utf16StringData::from_utf8(StringView utf8_string, AllowASCIIStorage allow_ascii_storage)
 {
     RefPtr<Utf16StringData> string;
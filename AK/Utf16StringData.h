@@ -51,6 +51,34 @@ public:
             did_destroy_utf16_fly_string_data({}, *this);
     }
 
+    // NB: Fly strings are shared by every thread through the fly string table, so their reference count is updated
+    //     atomically. Any other string only belongs to one thread at a time.
+    ALWAYS_INLINE void ref() const
+    {
+        if (m_is_fly_string)
+            ref_atomically();
+        else
+            RefCounted::ref();
+    }
+
+    ALWAYS_INLINE bool unref() const
+    {
+        if (!m_is_fly_string)
+            return RefCounted::unref();
+        if (deref_base_atomically() != 0)
+            return false;
+        delete this;
+        return true;
+    }
+
+    // The fly string table may still contain a fly string that another thread is destroying, which this refuses to
+    // take a reference to.
+    [[nodiscard]] bool try_ref_fly_string() const
+    {
+        VERIFY(m_is_fly_string);
+        return try_ref_atomically();
+    }
+
     [[nodiscard]] static constexpr size_t offset_of_string_storage()
     {
         return offsetof(Utf16StringData, m_ascii_data);
@@ -135,6 +163,7 @@ private:
 
     static NonnullRefPtr<Utf16StringData> create_uninitialized(StorageType storage_type, size_t code_unit_length);
     static NonnullRefPtr<Utf16StringData> create_uninitialized_ascii(size_t length_in_code_units, Bytes& buffer);
+    static NonnullRefPtr<Utf16StringData> create_uninitialized_utf16(size_t length_in_code_units, Span<char16_t>& buffer);
 
     template<typename ViewType>
     static NonnullRefPtr<Utf16StringData> create_from_code_point_iterable(ViewType const&);
@@ -18,16 +18,68 @@ ErrorOr<AnonymousBuffer> AnonymousBuffer::create_with_size(size_t size)
     return create_from_anon_fd(fd, size);
 }
 
+#if defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
+static constexpr int sealed_buffer_seals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+#endif
+
 ErrorOr<NonnullRefPtr<AnonymousBufferImpl>> AnonymousBufferImpl::create(int fd, size_t size)
 {
+    bool is_sealed = false;
+#if defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
+    if (auto seals = ::fcntl(fd, F_GET_SEALS); seals >= 0 && (seals & sealed_buffer_seals) == sealed_buffer_seals) {
+        // NB: A sealed buffer can't shrink, so once it's known to be large enough, no access to it can fault.
+        auto stat = TRY(System::fstat(fd));
+        if (stat.st_size < 0 || static_cast<size_t>(stat.st_size) < size)
+            return Error::from_string_literal("Sealed anonymous buffer is smaller than its advertised size");
+        is_sealed = true;
+    }
+#endif
+
     void* data = nullptr;
     // POSIX mmap rejects a zero length with EINVAL, so leave m_data null for zero-size buffers.
     if (size > 0) {
-        data = mmap(nullptr, round_up_to_power_of_two(size, PAGE_SIZE), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        // NB: Write-sealed memory can't be mapped writable.
+        auto protection = is_sealed ? PROT_READ : PROT_READ | PROT_WRITE;
+        data = mmap(nullptr, round_up_to_power_of_two(size, PAGE_SIZE), protection, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED)
+            return Error::from_errno(errno);
+    }
+    return AK::adopt_nonnull_ref_or_enomem(new (nothrow) AnonymousBufferImpl(fd, size, data, is_sealed));
+}
+
+ErrorOr<void> AnonymousBufferImpl::seal()
+{
+#if defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
+    if (m_is_sealed)
+        return {};
+
+    // NB: The write seal can't be added while any writable mapping of the buffer exists, so drop ours first and map
+    //     the buffer again read-only afterwards.
+    auto mapped_size = round_up_to_power_of_two(m_size, PAGE_SIZE);
+    if (m_data) {
+        TRY(System::munmap(m_data, mapped_size));
+        m_data = nullptr;
+    }
+
+    auto seal_result = System::fcntl(m_fd, F_ADD_SEALS, sealed_buffer_seals);
+
+    if (m_size > 0) {
+        auto protection = seal_result.is_error() ? PROT_READ | PROT_WRITE : PROT_READ;
+        auto* data = mmap(nullptr, mapped_size, protection, MAP_SHARED, m_fd, 0);
         if (data == MAP_FAILED)
             return Error::from_errno(errno);
+        m_data = data;
     }
-    return AK::adopt_nonnull_ref_or_enomem(new (nothrow) AnonymousBufferImpl(fd, size, data));
+
+    TRY(seal_result);
+
+    // NB: Receivers trust a buffer that carries these seals, so check that all of them are in place.
+    auto seals = TRY(System::fcntl(m_fd, F_GET_SEALS));
+    if ((seals & sealed_buffer_seals) != sealed_buffer_seals)
+        return Error::from_string_literal("Anonymous buffer is missing seals");
+    m_is_sealed = true;
+#endif
+    return {};
 }
 
 AnonymousBufferImpl::~AnonymousBufferImpl()
@@ -48,10 +100,11 @@ ErrorOr<AnonymousBuffer> AnonymousBuffer::create_from_anon_fd(int fd, size_t siz
     return AnonymousBuffer(move(impl));
 }
 
-AnonymousBufferImpl::AnonymousBufferImpl(int fd, size_t size, void* data)
+AnonymousBufferImpl::AnonymousBufferImpl(int fd, size_t size, void* data, bool is_sealed)
     : m_fd(fd)
     , m_size(size)
     , m_data(data)
+    , m_is_sealed(is_sealed)
 {
 }
 
@@ -27,16 +27,26 @@ public:
     void* data() { return m_data; }
     void const* data() const { return m_data; }
 
+    ErrorOr<void> seal();
+    bool is_sealed() const { return m_is_sealed; }
+
 private:
-    AnonymousBufferImpl(int fd, size_t, void*);
+    AnonymousBufferImpl(int fd, size_t, void*, bool is_sealed);
 
     int m_fd { -1 };
     size_t m_size { 0 };
     void* m_data { nullptr };
+    bool m_is_sealed { false };
 };
 
 class CORE_API AnonymousBuffer {
 public:
+#if defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
+    static constexpr bool supports_sealing = true;
+#else
+    static constexpr bool supports_sealing = false;
+#endif
+
     static ErrorOr<AnonymousBuffer> create_with_size(size_t);
     static ErrorOr<AnonymousBuffer> create_from_anon_fd(int fd, size_t);
 
@@ -47,6 +57,19 @@ public:
     int fd() const { return m_impl ? m_impl->fd() : -1; }
     size_t size() const { return m_impl ? m_impl->size() : 0; }
 
+    // Makes the buffer read-only and fixes its size, for this process and every process it is shared with, so that a
+    // receiver can read it without guarding against concurrent writes or truncation. The buffer is mapped again, so
+    // pointers obtained from data() before sealing are invalidated. Does nothing where sealing isn't supported.
+    ErrorOr<void> seal()
+    {
+        if (!m_impl)
+            return {};
+        return m_impl->seal();
+    }
+
+    // Whether the buffer can no longer be written to or resized by any process.
+    bool is_sealed() const { return m_impl && m_impl->is_sealed(); }
+
     ReadonlyBytes bytes() const
     {
         if (!m_impl)
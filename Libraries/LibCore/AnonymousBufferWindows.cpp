@@ -12,10 +12,11 @@
 
 namespace Core {
 
-AnonymousBufferImpl::AnonymousBufferImpl(int fd, size_t size, void* data)
+AnonymousBufferImpl::AnonymousBufferImpl(int fd, size_t size, void* data, bool is_sealed)
     : m_fd(fd)
     , m_size(size)
     , m_data(data)
+    , m_is_sealed(is_sealed)
 {
 }
 
@@ -49,7 +50,12 @@ ErrorOr<NonnullRefPtr<AnonymousBufferImpl>> AnonymousBufferImpl::create(int fd,
             return Error::from_windows_error();
     }
 
-    return adopt_ref(*new AnonymousBufferImpl(fd, size, ptr));
+    return adopt_ref(*new AnonymousBufferImpl(fd, size, ptr, false));
+}
+
+ErrorOr<void> AnonymousBufferImpl::seal()
+{
+    return {};
 }
 
 ErrorOr<AnonymousBuffer> AnonymousBuffer::create_with_size(size_t size)
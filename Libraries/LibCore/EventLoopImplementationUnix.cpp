@@ -10,6 +10,7 @@
 #include <AK/TemporaryChange.h>
 #include <AK/Time.h>
 #include <AK/WeakPtr.h>
+#include <LibCore/Environment.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoopImplementationUnix.h>
 #include <LibCore/EventReceiver.h>
@@ -25,6 +26,21 @@
 #include <sys/select.h>
 #include <unistd.h>
 
+// Where the OS offers a readiness queue, notifiers are registered with it once instead of handing poll() every
+// file descriptor on each iteration, so a wakeup costs O(ready) instead of O(registered).
+// FIXME: Android posts every notifier on every wakeup (see below); use ALooper there instead.
+#if defined(AK_OS_LINUX) && !defined(AK_OS_ANDROID)
+#    include <sys/epoll.h>
+#    define EVENT_LOOP_USE_EPOLL
+#elif defined(AK_OS_MACOS) || defined(AK_OS_FREEBSD) || defined(AK_OS_NETBSD) || defined(AK_OS_OPENBSD) || defined(AK_OS_DRAGONFLY)
+#    include <sys/event.h>
+#    define EVENT_LOOP_USE_KQUEUE
+#endif
+
+#if defined(EVENT_LOOP_USE_EPOLL) || defined(EVENT_LOOP_USE_KQUEUE)
+#    define EVENT_LOOP_HAS_READINESS_QUEUE
+#endif
+
 namespace Core {
 
 namespace {
@@ -76,6 +92,23 @@ bool has_flag(int value, int flag)
     return (value & flag) == flag;
 }
 
+#ifdef EVENT_LOOP_HAS_READINESS_QUEUE
+// LIBCORE_EVENT_LOOP_BACKEND=poll forces the portable poll() loop, e.g. to rule the readiness queue out while debugging.
+static bool should_use_readiness_queue()
+{
+    auto backend = Core::Environment::get("LIBCORE_EVENT_LOOP_BACKEND"sv);
+    return !backend.has_value() || *backend != "poll"sv;
+}
+
+static NotificationType interest_of(ReadonlySpan<Notifier*> notifiers)
+{
+    NotificationType interest = NotificationType::None;
+    for (auto* notifier : notifiers)
+        interest |= notifier->type() & (NotificationType::Read | NotificationType::Write);
+    return interest;
+}
+#endif
+
 class EventLoopTimer final : public EventLoopTimeout {
 public:
     EventLoopTimer() = default;
@@ -157,10 +190,19 @@ struct ThreadData {
         // The wake pipe informs us of POSIX signals as well as manual calls to wake()
         poll_fds.append({ .fd = wake_pipe_fds[0], .events = POLLIN, .revents = 0 });
         notifiers.append(nullptr);
+
+#ifdef EVENT_LOOP_HAS_READINESS_QUEUE
+        if (should_use_readiness_queue())
+            create_readiness_queue();
+#endif
     }
 
     ~ThreadData()
     {
+#ifdef EVENT_LOOP_HAS_READINESS_QUEUE
+        if (readiness_queue_fd >= 0)
+            close(readiness_queue_fd);
+#endif
         close(wake_pipe_fds[0]);
         close(wake_pipe_fds[1]);
 
@@ -183,8 +225,215 @@ struct ThreadData {
 
     pid_t pid { 0 };
     pthread_t thread_id { 0 };
+
+#ifdef EVENT_LOOP_HAS_READINESS_QUEUE
+    void create_readiness_queue();
+    void update_readiness_registration(int fd, NotificationType old_interest, NotificationType new_interest, bool was_registered);
+    void remove_readiness_registration(int fd, NotificationType old_interest);
+    ErrorOr<int> wait_for_readiness(int timeout, bool& wake_pipe_is_readable);
+
+    // The epoll/kqueue file descriptor, or -1 if this thread uses poll() on poll_fds instead.
+    int readiness_queue_fd { -1 };
+
+    // Several notifiers may watch the same file descriptor (e.g. one for reading and one for writing), but the
+    // readiness queue only takes one registration per descriptor, so we register their combined interest.
+    HashMap<int, Vector<Notifier*, 1>> notifiers_by_fd;
+
+    // Regular files can't be registered with epoll. poll() always reports them as ready, so we do the same.
+    HashTable<int> always_ready_fds;
+
+    // Reused across iterations, so waking up doesn't allocate.
+    HashMap<int, NotificationType> ready_fds;
+#endif
 };
 
+#ifdef EVENT_LOOP_USE_EPOLL
+static u32 notification_type_to_epoll_events(NotificationType type)
+{
+    u32 events = 0;
+    if (has_flag(type, NotificationType::Read))
+        events |= EPOLLIN;
+    if (has_flag(type, NotificationType::Write))
+        events |= EPOLLOUT;
+    return events;
+}
+
+void ThreadData::create_readiness_queue()
+{
+    int fd = epoll_create1(EPOLL_CLOEXEC);
+    if (fd < 0) {
+        dbgln("EventLoopImplementationUnix: epoll_create1 failed, falling back to poll(): {}", Error::from_errno(errno));
+        return;
+    }
+
+    epoll_event event { .events = EPOLLIN, .data = { .fd = wake_pipe_fds[0] } };
+    if (epoll_ctl(fd, EPOLL_CTL_ADD, wake_pipe_fds[0], &event) < 0) {
+        dbgln("EventLoopImplementationUnix: Failed to watch the wake pipe, falling back to poll(): {}", Error::from_errno(errno));
+        close(fd);
+        return;
+    }
+
+    readiness_queue_fd = fd;
+}
+
+void ThreadData::update_readiness_registration(int fd, NotificationType old_interest, NotificationType new_interest, bool was_registered)
+{
+    if (was_registered && (old_interest == new_interest || always_ready_fds.contains(fd)))
+        return;
+
+    epoll_event event { .events = notification_type_to_epoll_events(new_interest), .data = { .fd = fd } };
+
+    // If the descriptor was closed (and maybe reused) before its notifiers were unregistered, the kernel has already
+    // dropped it from the interest list, so a modification has to become a fresh registration.
+    if (was_registered && epoll_ctl(readiness_queue_fd, EPOLL_CTL_MOD, fd, &event) == 0)
+        return;
+    if (epoll_ctl(readiness_queue_fd, EPOLL_CTL_ADD, fd, &event) == 0)
+        return;
+    if (errno == EEXIST && epoll_ctl(readiness_queue_fd, EPOLL_CTL_MOD, fd, &event) == 0)
+        return;
+
+    if (errno == EPERM) {
+        always_ready_fds.set(fd);
+        return;
+    }
+
+    // poll() would silently ignore a bad descriptor (POLLNVAL), so don't fail any harder than that here.
+    dbgln("EventLoopImplementationUnix: Failed to watch fd {}: {}", fd, Error::from_errno(errno));
+}
+
+void ThreadData::remove_readiness_registration(int fd, NotificationType)
+{
+    if (always_ready_fds.remove(fd))
+        return;
+
+    // This fails harmlessly if the descriptor has already been closed.
+    (void)epoll_ctl(readiness_queue_fd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+ErrorOr<int> ThreadData::wait_for_readiness(int timeout, bool& wake_pipe_is_readable)
+{
+    ready_fds.clear_with_capacity();
+    wake_pipe_is_readable = false;
+
+    if (!always_ready_fds.is_empty())
+        timeout = 0;
+
+    Array<epoll_event, 64> events;
+    int event_count = epoll_wait(readiness_queue_fd, events.data(), events.size(), timeout);
+    if (event_count < 0)
+        return Error::from_syscall("epoll_wait"sv, errno);
+
+    for (int i = 0; i < event_count; ++i) {
+        auto fd = events[i].data.fd;
+        if (fd == wake_pipe_fds[0]) {
+            wake_pipe_is_readable = has_flag(events[i].events, EPOLLIN);
+            continue;
+        }
+
+        NotificationType type = NotificationType::None;
+        if (has_flag(events[i].events, EPOLLIN))
+            type |= NotificationType::Read;
+        if (has_flag(events[i].events, EPOLLOUT))
+            type |= NotificationType::Write;
+        if (has_flag(events[i].events, EPOLLHUP))
+            type |= NotificationType::Read | NotificationType::Write | NotificationType::HangUp;
+        if (has_flag(events[i].events, EPOLLERR))
+            type |= NotificationType::Error;
+        ready_fds.set(fd, type);
+    }
+
+    for (auto fd : always_ready_fds)
+        ready_fds.set(fd, NotificationType::Read | NotificationType::Write);
+
+    return event_count + static_cast<int>(always_ready_fds.size());
+}
+#endif
+
+#ifdef EVENT_LOOP_USE_KQUEUE
+void ThreadData::create_readiness_queue()
+{
+    int fd = kqueue();
+    if (fd < 0) {
+        dbgln("EventLoopImplementationUnix: kqueue failed, falling back to poll(): {}", Error::from_errno(errno));
+        return;
+    }
+    (void)fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    struct kevent change;
+    EV_SET(&change, wake_pipe_fds[0], EVFILT_READ, EV_ADD, 0, 0, nullptr);
+    if (kevent(fd, &change, 1, nullptr, 0, nullptr) < 0) {
+        dbgln("EventLoopImplementationUnix: Failed to watch the wake pipe, falling back to poll(): {}", Error::from_errno(errno));
+        close(fd);
+        return;
+    }
+
+    readiness_queue_fd = fd;
+}
+
+void ThreadData::update_readiness_registration(int fd, NotificationType old_interest, NotificationType new_interest, bool was_registered)
+{
+    if (!was_registered)
+        old_interest = NotificationType::None;
+
+    // kqueue has a filter per direction, so only the directions that changed need an update.
+    Array<struct kevent, 2> changes;
+    int change_count = 0;
+    auto update_filter = [&](NotificationType direction, short filter) {
+        bool was_watched = has_flag(old_interest, direction);
+        bool is_watched = has_flag(new_interest, direction);
+        if (was_watched != is_watched)
+            EV_SET(&changes[change_count++], fd, filter, is_watched ? EV_ADD : EV_DELETE, 0, 0, nullptr);
+    };
+    update_filter(NotificationType::Read, EVFILT_READ);
+    update_filter(NotificationType::Write, EVFILT_WRITE);
+
+    // poll() would silently ignore a bad descriptor (POLLNVAL), so don't fail any harder than that here.
+    if (change_count > 0 && kevent(readiness_queue_fd, changes.data(), change_count, nullptr, 0, nullptr) < 0 && errno != ENOENT && errno != EBADF)
+        dbgln("EventLoopImplementationUnix: Failed to watch fd {}: {}", fd, Error::from_errno(errno));
+}
+
+void ThreadData::remove_readiness_registration(int fd, NotificationType old_interest)
+{
+    update_readiness_registration(fd, old_interest, NotificationType::None, true);
+}
+
+ErrorOr<int> ThreadData::wait_for_readiness(int timeout, bool& wake_pipe_is_readable)
+{
+    ready_fds.clear_with_capacity();
+    wake_pipe_is_readable = false;
+
+    timespec timeout_spec {};
+    if (timeout > 0)
+        timeout_spec = AK::Duration::from_milliseconds(timeout).to_timespec();
+
+    Array<struct kevent, 64> events;
+    int event_count = kevent(readiness_queue_fd, nullptr, 0, events.data(), events.size(), timeout < 0 ? nullptr : &timeout_spec);
+    if (event_count < 0)
+        return Error::from_syscall("kevent"sv, errno);
+
+    for (int i = 0; i < event_count; ++i) {
+        auto fd = static_cast<int>(events[i].ident);
+        if (fd == wake_pipe_fds[0]) {
+            wake_pipe_is_readable = true;
+            continue;
+        }
+
+        // Reading and writing are separate events for the same descriptor, so merge them.
+        auto& type = ready_fds.ensure(fd, [] { return NotificationType::None; });
+        if (events[i].filter == EVFILT_READ)
+            type |= NotificationType::Read;
+        if (events[i].filter == EVFILT_WRITE)
+            type |= NotificationType::Write;
+        if (has_flag(events[i].flags, EV_EOF))
+            type |= NotificationType::Read | NotificationType::Write | NotificationType::HangUp;
+        if (has_flag(events[i].flags, EV_ERROR))
+            type |= NotificationType::Error;
+    }
+
+    return event_count;
+}
+#endif
+
 static void destroy_thread_data(void* value)
 {
     s_this_thread_data = nullptr;
@@ -265,7 +514,16 @@ retry:
 
 try_select_again:
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
-    auto error_or_marked_fd_count = System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout);
+    bool wake_pipe_is_readable = false;
+    auto error_or_marked_fd_count = [&]() -> ErrorOr<int> {
+#ifdef EVENT_LOOP_HAS_READINESS_QUEUE
+        if (thread_data.readiness_queue_fd >= 0)
+            return thread_data.wait_for_readiness(should_wait_forever ? -1 : timeout, wake_pipe_is_readable);
+#endif
+        auto marked_fd_count = TRY(System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout));
+        wake_pipe_is_readable = has_flag(thread_data.poll_fds[0].revents, POLLIN);
+        return marked_fd_count;
+    }();
     auto time_after_poll = MonotonicTime::now_coarse();
     // Because POSIX, we might spuriously return from select() with EINTR; just select again.
     if (error_or_marked_fd_count.is_error()) {
@@ -277,7 +535,7 @@ try_select_again:
 
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (has_flag(thread_data.poll_fds[0].revents, POLLIN)) {
+    if (wake_pipe_is_readable) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -306,6 +564,28 @@ try_select_again:
             goto retry;
     }
 
+#ifdef EVENT_LOOP_HAS_READINESS_QUEUE
+    if (thread_data.readiness_queue_fd >= 0) {
+        // Handle file system notifiers by making them normal events.
+        for (auto const& ready_fd : thread_data.ready_fds) {
+            auto notifiers = thread_data.notifiers_by_fd.get(ready_fd.key);
+            if (!notifiers.has_value()) {
+                // Nobody is listening for this descriptor anymore, e.g. because it was closed before its notifiers
+                // were removed. Drop it from the queue, or a level-triggered readiness would wake us up forever.
+                thread_data.remove_readiness_registration(ready_fd.key, ready_fd.value);
+                continue;
+            }
+            for (auto* notifier : *notifiers) {
+                if ((ready_fd.value & notifier->type()) != NotificationType::None)
+                    ThreadEventQueue::current().post_event(notifier, Core::Event::Type::NotifierActivation);
+            }
+        }
+
+        thread_data.timeouts.fire_expired(time_after_poll);
+        return;
+    }
+#endif
+
     if (error_or_marked_fd_count.value() != 0) {
         // Handle file system notifiers by making them normal events.
         for (size_t i = 1; i < thread_data.poll_fds.size(); ++i) {
@@ -535,6 +815,7 @@ intptr_t EventLoopManagerUnix::register_timer(EventReceiver& object, int millise
     timer->owner_thread = thread_data.thread_id;
     timer->owner = object;
     timer->interval = AK::Duration::from_milliseconds(milliseconds);
+    timer->set_tolerance(default_timer_tolerance(timer->interval));
     timer->reload(MonotonicTime::now_coarse());
     timer->should_reload = should_reload;
     thread_data.timeouts.schedule_absolute(timer);
@@ -562,14 +843,24 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
 {
     auto& thread_data = ThreadData::the();
     Sync::MutexLocker locker(thread_data.mutex);
+    notifier.set_owner_thread(thread_data.thread_id);
+
+#ifdef EVENT_LOOP_HAS_READINESS_QUEUE
+    if (thread_data.readiness_queue_fd >= 0) {
+        auto& notifiers = thread_data.notifiers_by_fd.ensure(notifier.fd());
+        bool was_registered = !notifiers.is_empty();
+        auto old_interest = interest_of(notifiers);
+        notifiers.append(&notifier);
+        thread_data.update_readiness_registration(notifier.fd(), old_interest, interest_of(notifiers), was_registered);
+        return;
+    }
+#endif
 
     thread_data.notifier_to_index.set(&notifier, thread_data.poll_fds.size());
     thread_data.notifiers.append(&notifier);
 
     auto events = notification_type_to_poll_events(notifier.type());
     thread_data.poll_fds.append({ .fd = notifier.fd(), .events = events, .revents = 0 });
-
-    notifier.set_owner_thread(thread_data.thread_id);
 }
 
 void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
@@ -580,6 +871,22 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
         return;
     Sync::MutexLocker thread_data_content_locker(thread_data->mutex);
 
+#ifdef EVENT_LOOP_HAS_READINESS_QUEUE
+    if (thread_data->readiness_queue_fd >= 0) {
+        auto it = thread_data->notifiers_by_fd.find(notifier.fd());
+        VERIFY(it != thread_data->notifiers_by_fd.end());
+        auto old_interest = interest_of(it->value);
+        it->value.remove_first_matching([&](auto* registered_notifier) { return registered_notifier == &notifier; });
+        if (it->value.is_empty()) {
+            thread_data->notifiers_by_fd.remove(it);
+            thread_data->remove_readiness_registration(notifier.fd(), old_interest);
+        } else {
+            thread_data->update_readiness_registration(notifier.fd(), old_interest, interest_of(it->value), true);
+        }
+        return;
+    }
+#endif
+
     auto notifier_index = thread_data->notifier_to_index.take(&notifier).release_value();
 
     if (notifier_index + 1 < thread_data->poll_fds.size()) {
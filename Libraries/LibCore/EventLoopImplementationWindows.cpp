@@ -445,6 +445,7 @@ intptr_t EventLoopManagerWindows::register_timer(EventReceiver& object, int mill
     auto timer = make<EventLoopTimer>();
     timer->owner = object.make_weak_ptr();
     timer->interval = AK::Duration::from_milliseconds(milliseconds);
+    timer->set_tolerance(default_timer_tolerance(timer->interval));
     timer->should_reload = should_reload;
     timer->reload(MonotonicTime::now());
     thread_data->timeouts.schedule_absolute(timer.ptr());
@@ -22,9 +22,11 @@ class Event;
 class EventLoop;
 class EventReceiver;
 class File;
+class ImmutableBytes;
 class LocalServer;
 class LocalSocket;
 class MappedFile;
+class MemoryPressureNotifier;
 class MimeData;
 class NetworkJob;
 class Notifier;
@@ -49,6 +51,9 @@ class WeakEventLoopReference;
 
 struct ProxyData;
 
+enum class MemoryPressureLevel : u8;
+enum class TraceCategory : u16;
+
 #ifdef AK_OS_MACH
 class MachPort;
 #endif
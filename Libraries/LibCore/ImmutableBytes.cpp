@@ -23,6 +23,11 @@ ImmutableBytes ImmutableBytes::adopt_mapped_file(NonnullOwnPtr<MappedFile> mappe
     return ImmutableBytes { adopt_ref(*new Impl(move(mapped_file))) };
 }
 
+ImmutableBytes ImmutableBytes::adopt_external_storage(NonnullRefPtr<ExternalStorage> storage)
+{
+    return ImmutableBytes { adopt_ref(*new Impl(move(storage))) };
+}
+
 ErrorOr<ImmutableBytes> ImmutableBytes::map_from_fd_range_and_close(int fd, StringView path, off_t offset, size_t size)
 {
     return adopt_mapped_file(TRY(MappedFile::map_from_fd_range_and_close(fd, path, offset, size)));
@@ -60,6 +65,11 @@ ImmutableBytes::Impl::Impl(NonnullOwnPtr<MappedFile> mapped_file)
 {
 }
 
+ImmutableBytes::Impl::Impl(NonnullRefPtr<ExternalStorage> storage)
+    : m_storage(move(storage))
+{
+}
+
 bool ImmutableBytes::Impl::is_file_backed() const
 {
     return m_storage.has<NonnullOwnPtr<MappedFile>>();
@@ -73,6 +83,9 @@ ReadonlyBytes ImmutableBytes::Impl::bytes() const
         },
         [](NonnullOwnPtr<MappedFile> const& mapped_file) -> ReadonlyBytes {
             return mapped_file->bytes();
+        },
+        [](NonnullRefPtr<ExternalStorage> const& storage) -> ReadonlyBytes {
+            return storage->bytes();
         });
 }
 
@@ -18,9 +18,18 @@ namespace Core {
 
 class CORE_API ImmutableBytes {
 public:
+    // Bytes owned by something else, e.g. the buffer a received IPC message was read into. They must not change for as
+    // long as they're referenced.
+    class ExternalStorage : public RefCounted<ExternalStorage> {
+    public:
+        virtual ~ExternalStorage() = default;
+        [[nodiscard]] virtual ReadonlyBytes bytes() const LIFETIME_BOUND = 0;
+    };
+
     static ErrorOr<ImmutableBytes> copy(ReadonlyBytes);
     static ImmutableBytes adopt(ByteBuffer);
     static ImmutableBytes adopt_mapped_file(NonnullOwnPtr<MappedFile>);
+    static ImmutableBytes adopt_external_storage(NonnullRefPtr<ExternalStorage>);
     static ErrorOr<ImmutableBytes> map_from_fd_range_and_close(int fd, StringView path, off_t offset, size_t size);
 
     ImmutableBytes() = default;
@@ -38,12 +47,13 @@ private:
     public:
         explicit Impl(ByteBuffer);
         explicit Impl(NonnullOwnPtr<MappedFile>);
+        explicit Impl(NonnullRefPtr<ExternalStorage>);
 
         [[nodiscard]] bool is_file_backed() const;
         [[nodiscard]] ReadonlyBytes bytes() const LIFETIME_BOUND;
 
     private:
-        Variant<ByteBuffer, NonnullOwnPtr<MappedFile>> m_storage;
+        Variant<ByteBuffer, NonnullOwnPtr<MappedFile>, NonnullRefPtr<ExternalStorage>> m_storage;
     };
 
     explicit ImmutableBytes(NonnullRefPtr<Impl>);
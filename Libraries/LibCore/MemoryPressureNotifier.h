@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibCore/Export.h>
+
+namespace Core {
+
+enum class MemoryPressureLevel : u8 {
+    Normal,
+    Warning,
+    Critical,
+};
+
+// Reports system memory pressure to the event loop that created it. On Linux this is fed by PSI triggers on the
+// process's cgroup (or the whole system), on macOS by a dispatch memory pressure source.
+class CORE_API MemoryPressureNotifier {
+    AK_MAKE_NONCOPYABLE(MemoryPressureNotifier);
+
+public:
+    static ErrorOr<NonnullOwnPtr<MemoryPressureNotifier>> create();
+    virtual ~MemoryPressureNotifier() = default;
+
+    Function<void(MemoryPressureLevel)> on_memory_pressure;
+
+protected:
+    MemoryPressureNotifier() = default;
+
+    void did_receive_memory_pressure(MemoryPressureLevel level)
+    {
+        if (on_memory_pressure)
+            on_memory_pressure(level);
+    }
+};
+
+}
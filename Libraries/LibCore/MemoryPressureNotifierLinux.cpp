@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteString.h>
+#include <AK/StringView.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/MemoryPressureNotifier.h>
+#include <LibCore/System.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+
+namespace Core {
+
+// PSI triggers, see Documentation/accounting/psi.rst. Each one fires when tasks stalled on memory for the given number
+// of microseconds within the window. Unprivileged processes may only use windows that are a multiple of 2 seconds.
+static constexpr auto warning_trigger = "some 150000 2000000"sv;
+static constexpr auto critical_trigger = "full 100000 2000000"sv;
+
+static constexpr auto system_pressure_file = "/proc/pressure/memory"sv;
+
+// Prefer the process's own cgroup v2 pressure file, so that a container or systemd scope hitting its memory limit
+// counts as pressure even when the rest of the machine is fine.
+static Optional<ByteString> cgroup_pressure_file()
+{
+    auto file = File::open("/proc/self/cgroup"sv, File::OpenMode::Read);
+    if (file.is_error())
+        return {};
+    auto contents = file.value()->read_until_eof();
+    if (contents.is_error())
+        return {};
+
+    for (auto line : StringView { contents.value() }.split_view('\n')) {
+        // The cgroup v2 hierarchy is the one with ID 0 and no controllers, e.g. "0::/user.slice/session-2.scope".
+        if (!line.starts_with("0::"sv))
+            continue;
+        return ByteString::formatted("/sys/fs/cgroup{}/memory.pressure", line.substring_view(3));
+    }
+    return {};
+}
+
+static ErrorOr<int> open_pressure_trigger(StringView path, StringView trigger)
+{
+    auto fd = TRY(System::open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC));
+
+    // The kernel expects the trigger to be NUL-terminated.
+    auto trigger_string = ByteString { trigger };
+    if (auto result = System::write(fd, { reinterpret_cast<u8 const*>(trigger_string.characters()), trigger_string.length() + 1 }); result.is_error()) {
+        (void)System::close(fd);
+        return result.release_error();
+    }
+    return fd;
+}
+
+class MemoryPressureNotifierImpl;
+
+// Shared between the notifier and its polling thread, so that a notification the thread already posted to the event
+// loop can tell whether the notifier is still around.
+struct PressureMonitor final : public AtomicRefCounted<PressureMonitor> {
+    explicit PressureMonitor(NonnullRefPtr<WeakEventLoopReference> event_loop)
+        : event_loop(move(event_loop))
+    {
+    }
+
+    NonnullRefPtr<WeakEventLoopReference> event_loop;
+
+    // Only accessed on the event loop's thread.
+    MemoryPressureNotifierImpl* notifier { nullptr };
+
+    int warning_fd { -1 };
+    int critical_fd { -1 };
+    int wake_fd { -1 };
+};
+
+class MemoryPressureNotifierImpl final : public MemoryPressureNotifier {
+public:
+    static ErrorOr<NonnullOwnPtr<MemoryPressureNotifierImpl>> create()
+    {
+        auto monitor = adopt_ref(*new PressureMonitor(EventLoop::current_weak()));
+
+        auto wake_pipe = TRY(System::pipe2(O_CLOEXEC));
+        monitor->wake_fd = wake_pipe[0];
+
+        auto open_triggers = [&](StringView path) -> ErrorOr<void> {
+            monitor->warning_fd = TRY(open_pressure_trigger(path, warning_trigger));
+
+            auto critical_fd = open_pressure_trigger(path, critical_trigger);
+            if (critical_fd.is_error()) {
+                (void)System::close(exchange(monitor->warning_fd, -1));
+                return critical_fd.release_error();
+            }
+            monitor->critical_fd = critical_fd.value();
+            return {};
+        };
+
+        auto cgroup_path = cgroup_pressure_file();
+        if (!cgroup_path.has_value() || open_triggers(*cgroup_path).is_error()) {
+            if (auto result = open_triggers(system_pressure_file); result.is_error()) {
+                (void)System::close(wake_pipe[0]);
+                (void)System::close(wake_pipe[1]);
+                return result.release_error();
+            }
+        }
+
+        auto notifier = adopt_own(*new MemoryPressureNotifierImpl(monitor, wake_pipe[1]));
+        if (auto rc = pthread_create(&notifier->m_thread, nullptr, poll_for_memory_pressure, &monitor.leak_ref()); rc != 0) {
+            monitor->unref();
+            return Error::from_errno(rc);
+        }
+        notifier->m_thread_started = true;
+        return notifier;
+    }
+
+    virtual ~MemoryPressureNotifierImpl() override
+    {
+        m_monitor->notifier = nullptr;
+
+        if (m_thread_started) {
+            u8 wake = 0;
+            (void)System::write(m_wake_write_fd, { &wake, sizeof(wake) });
+            pthread_join(m_thread, nullptr);
+        }
+
+        (void)System::close(m_wake_write_fd);
+        (void)System::close(m_monitor->wake_fd);
+        (void)System::close(m_monitor->warning_fd);
+        (void)System::close(m_monitor->critical_fd);
+    }
+
+private:
+    MemoryPressureNotifierImpl(NonnullRefPtr<PressureMonitor> monitor, int wake_write_fd)
+        : m_monitor(move(monitor))
+        , m_wake_write_fd(wake_write_fd)
+    {
+        m_monitor->notifier = this;
+    }
+
+    static void* poll_for_memory_pressure(void* argument)
+    {
+        auto monitor = adopt_ref(*static_cast<PressureMonitor*>(argument));
+
+        Array<struct pollfd, 3> poll_fds {
+            pollfd { .fd = monitor->critical_fd, .events = POLLPRI, .revents = 0 },
+            pollfd { .fd = monitor->warning_fd, .events = POLLPRI, .revents = 0 },
+            pollfd { .fd = monitor->wake_fd, .events = POLLIN, .revents = 0 },
+        };
+
+        while (true) {
+            if (auto result = System::poll(poll_fds, -1); result.is_error()) {
+                if (result.error().code() == EINTR)
+                    continue;
+                break;
+            }
+
+            // Either the notifier is going away, or the cgroup we were watching was removed.
+            if (poll_fds[2].revents != 0 || ((poll_fds[0].revents | poll_fds[1].revents) & POLLERR) != 0)
+                break;
+
+            MemoryPressureLevel level;
+            if (poll_fds[0].revents & POLLPRI)
+                level = MemoryPressureLevel::Critical;
+            else if (poll_fds[1].revents & POLLPRI)
+                level = MemoryPressureLevel::Warning;
+            else
+                continue;
+
+            auto event_loop = monitor->event_loop->take();
+            if (!event_loop)
+                break;
+
+            event_loop->deferred_invoke([monitor, level] {
+                if (monitor->notifier)
+                    monitor->notifier->did_receive_memory_pressure(level);
+            });
+        }
+
+        return nullptr;
+    }
+
+    NonnullRefPtr<PressureMonitor> m_monitor;
+    int m_wake_write_fd { -1 };
+    pthread_t m_thread {};
+    bool m_thread_started { false };
+};
+
+ErrorOr<NonnullOwnPtr<MemoryPressureNotifier>> MemoryPressureNotifier::create()
+{
+    return MemoryPressureNotifierImpl::create();
+}
+
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Platform.h>
+#include <LibCore/MemoryPressureNotifier.h>
+
+#if !defined(AK_OS_MACOS)
+static_assert(false, "This file must only be used for macOS");
+#endif
+
+#include <dispatch/dispatch.h>
+
+namespace Core {
+
+class MemoryPressureNotifierImpl final : public MemoryPressureNotifier {
+public:
+    static ErrorOr<NonnullOwnPtr<MemoryPressureNotifierImpl>> create()
+    {
+        auto source = dispatch_source_create(
+            DISPATCH_SOURCE_TYPE_MEMORYPRESSURE,
+            0,
+            DISPATCH_MEMORYPRESSURE_NORMAL | DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+            dispatch_get_main_queue());
+        if (!source)
+            return Error::from_string_literal("Unable to create memory pressure dispatch source");
+
+        return adopt_own(*new MemoryPressureNotifierImpl(source));
+    }
+
+    virtual ~MemoryPressureNotifierImpl() override
+    {
+        // Cancellation stops further handler invocations. The handler runs on the main queue, as does this destructor,
+        // so no handler can be running concurrently.
+        dispatch_source_cancel(m_source);
+        dispatch_release(m_source);
+    }
+
+private:
+    explicit MemoryPressureNotifierImpl(dispatch_source_t source)
+        : m_source(source)
+    {
+        dispatch_set_context(m_source, this);
+        dispatch_source_set_event_handler_f(m_source, memory_pressure_changed);
+        dispatch_resume(m_source);
+    }
+
+    static void memory_pressure_changed(void* context)
+    {
+        auto& notifier = *reinterpret_cast<MemoryPressureNotifierImpl*>(context);
+        auto status = dispatch_source_get_data(notifier.m_source);
+
+        if (status & DISPATCH_MEMORYPRESSURE_CRITICAL)
+            notifier.did_receive_memory_pressure(MemoryPressureLevel::Critical);
+        else if (status & DISPATCH_MEMORYPRESSURE_WARN)
+            notifier.did_receive_memory_pressure(MemoryPressureLevel::Warning);
+        else if (status & DISPATCH_MEMORYPRESSURE_NORMAL)
+            notifier.did_receive_memory_pressure(MemoryPressureLevel::Normal);
+    }
+
+    dispatch_source_t m_source;
+};
+
+ErrorOr<NonnullOwnPtr<MemoryPressureNotifier>> MemoryPressureNotifier::create()
+{
+    return MemoryPressureNotifierImpl::create();
+}
+
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/MemoryPressureNotifier.h>
+
+namespace Core {
+
+ErrorOr<NonnullOwnPtr<MemoryPressureNotifier>> MemoryPressureNotifier::create()
+{
+    return Error::from_errno(ENOTSUP);
+}
+
+}
@@ -20,6 +20,7 @@
 #include <fcntl.h>
 #include <signal.h>
 #include <spawn.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -269,6 +270,33 @@ ErrorOr<void> Process::terminate_process(pid_t pid, TerminationMode mode)
     return System::kill(pid, mode == TerminationMode::Graceful ? SIGTERM : SIGKILL);
 }
 
+ErrorOr<void> Process::set_priority(pid_t pid, Priority priority)
+{
+#if defined(AK_OS_MACOS)
+    if (::setpriority(PRIO_DARWIN_PROCESS, pid, priority == Priority::Background ? PRIO_DARWIN_BG : 0) < 0)
+        return Error::from_syscall("setpriority"sv, errno);
+    return {};
+#else
+    static constexpr int background_nice_value = 10;
+
+    // NB: Unprivileged processes may only make their nice value higher, so unless we are allowed to lower it again,
+    //     a process we move to the background would have to stay there.
+    if (priority == Priority::Background && ::geteuid() != 0) {
+#    if defined(AK_OS_LINUX)
+        auto limits = TRY(System::get_resource_limits(RLIMIT_NICE));
+        if (limits.rlim_cur != RLIM_INFINITY && limits.rlim_cur < 20)
+            return Error::from_errno(EPERM);
+#    else
+        return Error::from_errno(EPERM);
+#    endif
+    }
+
+    if (::setpriority(PRIO_PROCESS, pid, priority == Priority::Background ? background_nice_value : 0) < 0)
+        return Error::from_syscall("setpriority"sv, errno);
+    return {};
+#endif
+}
+
 ErrorOr<String> Process::get_name()
 {
 #if defined(AK_OS_SERENITY)
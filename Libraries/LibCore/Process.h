@@ -73,6 +73,13 @@ public:
     };
     static ErrorOr<void> terminate_process(pid_t, TerminationMode);
 
+    enum class Priority {
+        Normal,
+        Background,
+    };
+    // Fails without changing anything if the priority could not be set back to normal afterwards.
+    static ErrorOr<void> set_priority(pid_t, Priority);
+
     static void wait_for_debugger_and_break();
     static ErrorOr<bool> is_being_debugged();
 
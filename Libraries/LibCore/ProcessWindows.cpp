@@ -136,6 +136,17 @@ ErrorOr<void> Process::terminate_process(pid_t pid, TerminationMode mode)
     return {};
 }
 
+ErrorOr<void> Process::set_priority(pid_t pid, Priority priority)
+{
+    HANDLE handle = OpenProcess(PROCESS_SET_INFORMATION, FALSE, static_cast<DWORD>(pid));
+    if (!handle)
+        return Error::from_windows_error();
+    ScopeGuard close_handle = [&] { CloseHandle(handle); };
+    if (!SetPriorityClass(handle, priority == Priority::Background ? BELOW_NORMAL_PRIORITY_CLASS : NORMAL_PRIORITY_CLASS))
+        return Error::from_windows_error();
+    return {};
+}
+
 // Get the full path of the executable file of the current process
 ErrorOr<String> Process::get_name()
 {
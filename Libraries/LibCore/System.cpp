@@ -192,7 +192,8 @@ ErrorOr<int> anon_create([[maybe_unused]] size_t size, [[maybe_unused]] int opti
     int fd = -1;
 #if defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
     // FIXME: Support more options on Linux.
-    auto linux_options = ((options & O_CLOEXEC) > 0) ? MFD_CLOEXEC : 0;
+    // NB: Allow sealing, so that AnonymousBuffer::seal() can make a buffer immutable before sharing it.
+    auto linux_options = (((options & O_CLOEXEC) > 0) ? MFD_CLOEXEC : 0) | MFD_ALLOW_SEALING;
     fd = memfd_create("", linux_options);
 #elif defined(SHM_ANON)
     fd = shm_open(SHM_ANON, O_RDWR | O_CREAT | options, 0600);
@@ -307,6 +308,14 @@ ErrorOr<size_t> write(int fd, ReadonlyBytes buffer)
     return rc;
 }
 
+ErrorOr<size_t> pread(int fd, Bytes buffer, off_t offset)
+{
+    auto rc = ::pread(fd, buffer.data(), buffer.size(), offset);
+    if (rc < 0)
+        return Error::from_syscall("pread"sv, errno);
+    return rc;
+}
+
 ErrorOr<void> kill(pid_t pid, int signal)
 {
     if (::kill(pid, signal) < 0)
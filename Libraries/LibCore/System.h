@@ -88,6 +88,7 @@ CORE_API ErrorOr<struct stat> stat(StringView path);
 CORE_API ErrorOr<struct stat> lstat(StringView path);
 CORE_API ErrorOr<size_t> read(int fd, Bytes buffer);
 CORE_API ErrorOr<size_t> write(int fd, ReadonlyBytes buffer);
+ErrorOr<size_t> pread(int fd, Bytes buffer, off_t offset);
 ErrorOr<int> dup2(int source_fd, int destination_fd);
 CORE_API ErrorOr<void> ioctl(int fd, unsigned request, ...);
 ErrorOr<struct termios> tcgetattr(int fd);
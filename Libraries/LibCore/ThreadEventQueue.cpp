@@ -10,6 +10,7 @@
 #include <LibCore/EventReceiver.h>
 #include <LibCore/Promise.h>
 #include <LibCore/ThreadEventQueue.h>
+#include <LibCore/TraceEvent.h>
 #include <LibSync/Mutex.h>
 #include <LibSync/Once.h>
 #include <errno.h>
@@ -113,11 +114,13 @@ size_t ThreadEventQueue::process()
         if (auto receiver = queued_event.receiver.strong_ref()) {
             switch (queued_event.event_type) {
             case Event::Type::Timer: {
+                TRACE_EVENT(EventLoop, "Timer"sv);
                 TimerEvent timer_event;
                 receiver->dispatch_event(timer_event);
                 break;
             }
             case Event::Type::NotifierActivation: {
+                TRACE_EVENT(EventLoop, "Notifier activation"sv);
                 NotifierActivationEvent notifier_activation_event;
                 receiver->dispatch_event(notifier_activation_event);
                 break;
@@ -127,6 +130,7 @@ size_t ThreadEventQueue::process()
             }
         } else {
             if (queued_event.event_type == Event::Type::DeferredInvoke) {
+                TRACE_EVENT(EventLoop, "Deferred invoke"sv);
                 queued_event.m_invokee();
             } else {
                 // Receiver gone, drop the event.
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
-#include <AK/BinaryHeap.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/IntrusiveList.h>
 #include <AK/NumericLimits.h>
 #include <AK/Optional.h>
+#include <AK/QuickSort.h>
 #include <AK/Time.h>
 #include <AK/Vector.h>
 
@@ -28,6 +31,13 @@ public:
 
     MonotonicTime fire_time() const { return m_fire_time; }
 
+    // The timeout fires at fire_time() pushed back by at most its tolerance, so that timeouts with some slack can
+    // share a wakeup instead of each needing their own.
+    MonotonicTime deadline() const { return m_fire_time + m_coalescing_delay; }
+
+    AK::Duration tolerance() const { return m_tolerance; }
+    void set_tolerance(AK::Duration tolerance) { m_tolerance = tolerance; }
+
     void absolutize(Badge<TimeoutSet>, MonotonicTime current_time)
     {
         m_fire_time = current_time + m_duration;
@@ -48,48 +58,84 @@ protected:
     };
 
 private:
+    friend class TimeoutSet;
+
     ssize_t m_index = INVALID_INDEX;
     u64 m_sequence_id { 0 };
+    AK::Duration m_tolerance;
+    AK::Duration m_coalescing_delay;
+    IntrusiveListNode<EventLoopTimeout> m_wheel_list_node;
 };
 
+// How late a repeating or single-shot timer may fire by default. Short timers (animations, zero-delay callbacks)
+// stay exact, while long ones get a little slack to coalesce with their neighbours.
+inline AK::Duration default_timer_tolerance(AK::Duration interval)
+{
+    static constexpr auto max_tolerance = AK::Duration::from_seconds(1);
+    auto tolerance = AK::Duration::from_nanoseconds(interval.to_nanoseconds() / 16);
+    return min(tolerance, max_tolerance);
+}
+
+// A hierarchical timing wheel with millisecond ticks. Level 0 has a slot per tick for the next 64 ticks, and each
+// further level has a slot per 64 slots of the level below it. Timeouts cascade down a level whenever the wheel
+// reaches the start of their slot, so scheduling and unscheduling are O(1) no matter how many timeouts there are.
 class TimeoutSet {
 public:
     TimeoutSet() = default;
 
     Optional<MonotonicTime> next_timer_expiration()
     {
-        if (!m_heap.is_empty()) {
-            return m_heap.peek_min()->fire_time();
-        } else {
-            return {};
+        // Each level's earliest timeouts are all in its first occupied slot, so only those slots need a look.
+        Optional<MonotonicTime> earliest;
+        auto consider = [&](WheelList& slot) {
+            for (auto& timeout : slot) {
+                if (!earliest.has_value() || timeout.deadline() < *earliest)
+                    earliest = timeout.deadline();
+            }
+        };
+
+        for (size_t level = 0; level < level_count; ++level) {
+            if (auto slot = first_occupied_slot(level); slot.has_value())
+                consider(m_slots[level][*slot]);
         }
+        consider(m_overflow);
+        return earliest;
     }
 
     void absolutize_relative_timeouts(MonotonicTime current_time)
     {
         for (auto timeout : m_scheduled_timeouts) {
             timeout->absolutize({}, current_time);
-            m_heap.insert(timeout);
+            insert(*timeout);
         }
         m_scheduled_timeouts.clear();
     }
 
     size_t fire_expired(MonotonicTime current_time)
     {
-        size_t fired_count = 0;
-        while (!m_heap.is_empty()) {
-            auto& timeout = *m_heap.peek_min();
-
-            if (timeout.fire_time() <= current_time) {
-                ++fired_count;
-                m_heap.pop_min();
-                timeout.set_index({}, EventLoopTimeout::INVALID_INDEX);
-                timeout.fire(*this, current_time);
-            } else {
-                break;
+        Vector<EventLoopTimeout*, 8> expired_timeouts;
+
+        // Everything in a tick before the current one has expired, but the current tick has to be checked one by one.
+        advance_wheel_to(current_time.milliseconds(), expired_timeouts);
+        auto& current_slot = m_slots[0][slot_index(0, m_current_tick)];
+        for (auto it = current_slot.begin(); it != current_slot.end();) {
+            auto& timeout = *it;
+            ++it;
+            if (timeout.deadline() <= current_time) {
+                unlink(timeout);
+                expired_timeouts.append(&timeout);
             }
         }
-        return fired_count;
+
+        quick_sort(expired_timeouts, [](auto* a, auto* b) {
+            if (a->deadline() == b->deadline())
+                return a->sequence_id() < b->sequence_id();
+            return a->deadline() < b->deadline();
+        });
+
+        for (auto* timeout : expired_timeouts)
+            timeout->fire(*this, current_time);
+        return expired_timeouts.size();
     }
 
     void schedule_relative(EventLoopTimeout* timeout)
@@ -102,7 +148,7 @@ public:
     void schedule_absolute(EventLoopTimeout* timeout)
     {
         timeout->set_sequence_id(m_next_sequence_id++);
-        m_heap.insert(timeout);
+        insert(*timeout);
     }
 
     void unschedule(EventLoopTimeout* timeout)
@@ -114,40 +160,177 @@ public:
             swap(m_scheduled_timeouts[i], m_scheduled_timeouts[j]);
             swap(m_scheduled_timeouts[i]->index({}), m_scheduled_timeouts[j]->index({}));
             (void)m_scheduled_timeouts.take_last();
+            timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
         } else {
-            m_heap.pop(timeout->index({}));
+            unlink(*timeout);
         }
-        timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
     }
 
     void clear()
     {
-        for (auto* timeout : m_heap.nodes_in_arbitrary_order())
-            timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
-        m_heap.clear();
+        auto clear_list = [](WheelList& list) {
+            while (auto* timeout = list.take_first())
+                timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
+        };
+        for (auto& level : m_slots) {
+            for (auto& slot : level)
+                clear_list(slot);
+        }
+        clear_list(m_overflow);
+        m_occupied_slots = {};
+
         for (auto* timeout : m_scheduled_timeouts)
             timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
         m_scheduled_timeouts.clear();
     }
 
 private:
-    struct TimeoutFiresBefore {
-        bool operator()(EventLoopTimeout* a, EventLoopTimeout* b) const
-        {
-            if (a->fire_time() == b->fire_time())
-                return a->sequence_id() < b->sequence_id();
-            return a->fire_time() < b->fire_time();
+    using WheelList = IntrusiveList<&EventLoopTimeout::m_wheel_list_node>;
+
+    static constexpr size_t slot_bits = 6;
+    static constexpr size_t slots_per_level = 1 << slot_bits;
+    static constexpr i64 slot_mask = slots_per_level - 1;
+    static constexpr size_t level_count = 4;
+
+    // With 4 levels of 64 slots, the wheel reaches ~4.6 hours ahead. Anything further out waits in m_overflow.
+    static constexpr ssize_t overflow_index = level_count * slots_per_level;
+
+    static constexpr size_t level_shift(size_t level) { return level * slot_bits; }
+    static size_t slot_index(size_t level, i64 tick) { return (tick >> level_shift(level)) & slot_mask; }
+
+    // Push the deadline back onto a grid of the largest power-of-two number of milliseconds that fits within the
+    // tolerance. This never fires a timeout early, and timeouts with similar tolerances line up on the same ticks.
+    static AK::Duration coalescing_delay(EventLoopTimeout const& timeout)
+    {
+        auto tolerance_ms = timeout.tolerance().to_truncated_milliseconds();
+        if (tolerance_ms < 2)
+            return {};
+
+        auto granularity_ns = (static_cast<i64>(1) << (63 - count_leading_zeroes(static_cast<u64>(tolerance_ms)))) * 1'000'000;
+        auto remainder = timeout.fire_time().nanoseconds() % granularity_ns;
+        if (remainder <= 0)
+            return {};
+        return AK::Duration::from_nanoseconds(granularity_ns - remainder);
+    }
+
+    void insert(EventLoopTimeout& timeout)
+    {
+        timeout.m_coalescing_delay = coalescing_delay(timeout);
+
+        // Anything already overdue goes into the current tick, which fire_expired() checks one by one.
+        auto tick = max(timeout.deadline().milliseconds(), m_current_tick);
+        for (size_t level = 0; level < level_count; ++level) {
+            auto shift = level_shift(level);
+            if ((tick >> shift) - (m_current_tick >> shift) < static_cast<i64>(slots_per_level)) {
+                auto slot = slot_index(level, tick);
+                m_slots[level][slot].append(timeout);
+                m_occupied_slots[level] |= static_cast<u64>(1) << slot;
+                timeout.set_index({}, static_cast<ssize_t>(level * slots_per_level + slot));
+                return;
+            }
         }
-    };
 
-    struct UpdateTimeoutIndex {
-        void operator()(EventLoopTimeout* timeout, size_t index) const
-        {
-            timeout->set_index({}, static_cast<ssize_t>(index));
+        m_overflow.append(timeout);
+        timeout.set_index({}, overflow_index);
+    }
+
+    void unlink(EventLoopTimeout& timeout)
+    {
+        auto index = timeout.index({});
+        VERIFY(index >= 0 && index <= overflow_index);
+        timeout.m_wheel_list_node.remove();
+        timeout.set_index({}, EventLoopTimeout::INVALID_INDEX);
+        if (index == overflow_index)
+            return;
+
+        auto level = static_cast<size_t>(index) / slots_per_level;
+        auto slot = static_cast<size_t>(index) % slots_per_level;
+        if (m_slots[level][slot].is_empty())
+            m_occupied_slots[level] &= ~(static_cast<u64>(1) << slot);
+    }
+
+    // The distance from the wheel's current slot to the first occupied one on this level.
+    Optional<size_t> first_occupied_slot_distance(size_t level) const
+    {
+        auto occupied = m_occupied_slots[level];
+        if (occupied == 0)
+            return {};
+        auto current = slot_index(level, m_current_tick);
+        auto rotated = current == 0 ? occupied : (occupied >> current) | (occupied << (slots_per_level - current));
+        return count_trailing_zeroes(rotated);
+    }
+
+    Optional<size_t> first_occupied_slot(size_t level) const
+    {
+        auto distance = first_occupied_slot_distance(level);
+        if (!distance.has_value())
+            return {};
+        return (slot_index(level, m_current_tick) + *distance) & slot_mask;
+    }
+
+    void advance_wheel_to(i64 target_tick, Vector<EventLoopTimeout*, 8>& expired_timeouts)
+    {
+        while (m_current_tick < target_tick) {
+            auto& slot = m_slots[0][slot_index(0, m_current_tick)];
+            while (auto* timeout = slot.first()) {
+                unlink(*timeout);
+                expired_timeouts.append(timeout);
+            }
+
+            // Skip straight to the next tick where something can happen: a level 0 slot has timeouts that expire,
+            // a slot on a higher level needs to cascade, or the overflow needs another look.
+            auto next_tick = target_tick;
+            for (size_t level = 0; level < level_count; ++level) {
+                auto distance = first_occupied_slot_distance(level);
+                if (!distance.has_value())
+                    continue;
+                auto shift = level_shift(level);
+                auto tick = ((m_current_tick >> shift) + static_cast<i64>(*distance)) << shift;
+                next_tick = min(next_tick, tick);
+            }
+            if (!m_overflow.is_empty()) {
+                auto shift = level_shift(level_count - 1);
+                next_tick = min(next_tick, ((m_current_tick >> shift) + 1) << shift);
+            }
+
+            VERIFY(next_tick > m_current_tick);
+            m_current_tick = next_tick;
+            cascade();
         }
-    };
+    }
+
+    // Move the timeouts of every slot that starts at the current tick down to where they belong now.
+    void cascade()
+    {
+        auto reinsert_all = [this](WheelList& list) {
+            WheelList timeouts;
+            while (auto* timeout = list.take_first())
+                timeouts.append(*timeout);
+            while (auto* timeout = timeouts.take_first()) {
+                timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
+                insert(*timeout);
+            }
+        };
+
+        if ((m_current_tick & ((static_cast<i64>(1) << level_shift(level_count - 1)) - 1)) == 0)
+            reinsert_all(m_overflow);
+
+        for (size_t level = level_count - 1; level > 0; --level) {
+            if ((m_current_tick & ((static_cast<i64>(1) << level_shift(level)) - 1)) != 0)
+                continue;
+            auto slot = slot_index(level, m_current_tick);
+            m_occupied_slots[level] &= ~(static_cast<u64>(1) << slot);
+            reinsert_all(m_slots[level][slot]);
+        }
+    }
+
+    Array<Array<WheelList, slots_per_level>, level_count> m_slots;
+    WheelList m_overflow;
+    Array<u64, level_count> m_occupied_slots {};
+
+    // Every timeout in the wheel expires at or after this tick.
+    i64 m_current_tick { MonotonicTime::now_coarse().milliseconds() };
 
-    IntrusiveBinaryHeap<EventLoopTimeout*, TimeoutFiresBefore, UpdateTimeoutIndex, 8> m_heap;
     Vector<EventLoopTimeout*, 8> m_scheduled_timeouts;
     u64 m_next_sequence_id { 0 };
 };
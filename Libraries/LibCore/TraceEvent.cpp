@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/ByteString.h>
+#include <AK/CircularQueue.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+#include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
+
+namespace Core {
+
+struct TraceCategoryName {
+    TraceCategory category;
+    StringView name;
+};
+
+static constexpr Array trace_category_names {
+    TraceCategoryName { TraceCategory::EventLoop, "event-loop"sv },
+    TraceCategoryName { TraceCategory::IPC, "ipc"sv },
+    TraceCategoryName { TraceCategory::GC, "gc"sv },
+    TraceCategoryName { TraceCategory::Style, "style"sv },
+    TraceCategoryName { TraceCategory::Layout, "layout"sv },
+    TraceCategoryName { TraceCategory::Paint, "paint"sv },
+    TraceCategoryName { TraceCategory::Raster, "raster"sv },
+    TraceCategoryName { TraceCategory::Network, "network"sv },
+    TraceCategoryName { TraceCategory::Decode, "decode"sv },
+};
+
+static StringView trace_category_name(TraceCategory category)
+{
+    for (auto const& category_name : trace_category_names) {
+        if (category_name.category == category)
+            return category_name.name;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+Optional<TraceCategory> trace_categories_from_string(StringView string)
+{
+    if (string == "all"sv)
+        return TraceCategory::All;
+
+    auto categories = TraceCategory::None;
+    for (auto name : string.split_view(',')) {
+        auto category = [&] -> Optional<TraceCategory> {
+            for (auto const& category_name : trace_category_names) {
+                if (category_name.name == name.trim_whitespace())
+                    return category_name.category;
+            }
+            return {};
+        }();
+        if (!category.has_value())
+            return {};
+        categories |= *category;
+    }
+    return categories;
+}
+
+String trace_categories_to_string(TraceCategory categories)
+{
+    StringBuilder builder;
+    for (auto const& category_name : trace_category_names) {
+        if (!has_flag(categories, category_name.category))
+            continue;
+        if (!builder.is_empty())
+            builder.append(',');
+        builder.append(category_name.name);
+    }
+    return builder.to_string_without_validation();
+}
+
+// NB: Each buffer is only ever written by its own thread, and only read while a trace is collected, so its lock is
+//     uncontended almost all of the time and waiting threads spin rather than sleep.
+class TraceSpinLocker {
+    AK_MAKE_NONCOPYABLE(TraceSpinLocker);
+    AK_MAKE_NONMOVABLE(TraceSpinLocker);
+
+public:
+    explicit TraceSpinLocker(Atomic<bool>& is_locked)
+        : m_is_locked(is_locked)
+    {
+        while (m_is_locked.exchange(true, AK::MemoryOrder::memory_order_acquire)) {
+            while (m_is_locked.load(AK::MemoryOrder::memory_order_relaxed))
+                AK::atomic_pause();
+        }
+    }
+
+    ~TraceSpinLocker()
+    {
+        m_is_locked.store(false, AK::MemoryOrder::memory_order_release);
+    }
+
+private:
+    Atomic<bool>& m_is_locked;
+};
+
+struct RecordedTraceEvent {
+    StringView name;
+    TraceCategory category { TraceCategory::None };
+    i64 start_ns { 0 };
+    i64 duration_ns { 0 };
+};
+
+struct ThreadTraceBuffer {
+    Atomic<bool> is_locked { false };
+    u64 thread_index { 0 };
+    ByteString thread_name;
+
+    CircularQueue<RecordedTraceEvent, TraceEvents::max_recorded_events_per_thread> events;
+};
+
+// The events of a thread that has exited, copied out of its ThreadTraceBuffer so that they only take up as much
+// memory as they need.
+struct RetiredThreadTrace {
+    u64 thread_index { 0 };
+    ByteString thread_name;
+    Vector<RecordedTraceEvent> events;
+};
+
+struct ThreadTraceBuffers {
+    Atomic<bool> is_locked { false };
+    u64 next_thread_index { 0 };
+    Vector<NonnullOwnPtr<ThreadTraceBuffer>> buffers;
+
+    // Oldest first. Between them, they hold at most as many events as the buffer of a single running thread.
+    Vector<RetiredThreadTrace> retired_threads;
+    size_t retired_event_count { 0 };
+};
+
+// NB: The buffers are leaked, as threads may still record events while the process exits.
+static ThreadTraceBuffers& thread_trace_buffers()
+{
+    static auto& buffers = *new ThreadTraceBuffers;
+    return buffers;
+}
+
+// Retires the calling thread's buffer when the thread exits.
+struct CurrentThreadTrace {
+    ~CurrentThreadTrace();
+
+    ThreadTraceBuffer* buffer { nullptr };
+    ByteString thread_name;
+};
+
+static thread_local CurrentThreadTrace s_current_thread_trace;
+
+// NB: This is trivially destructible, so it is still safe to read from the thread_local destructors that run after
+//     the one of s_current_thread_trace.
+static thread_local bool s_current_thread_has_exited = false;
+
+CurrentThreadTrace::~CurrentThreadTrace()
+{
+    s_current_thread_has_exited = true;
+    if (!buffer)
+        return;
+
+    // NB: Declared ahead of the locker, so that the buffer is freed after the lock has been released.
+    OwnPtr<ThreadTraceBuffer> retired_buffer;
+
+    auto& buffers = thread_trace_buffers();
+    TraceSpinLocker locker { buffers.is_locked };
+
+    auto index = buffers.buffers.find_first_index_if([&](auto const& it) { return it.ptr() == buffer; });
+    VERIFY(index.has_value());
+    retired_buffer = buffers.buffers.take(*index);
+    buffer = nullptr;
+
+    if (retired_buffer->events.is_empty())
+        return;
+
+    RetiredThreadTrace retired_thread { .thread_index = retired_buffer->thread_index, .thread_name = move(retired_buffer->thread_name) };
+    retired_thread.events.ensure_capacity(retired_buffer->events.size());
+    for (auto const& event : retired_buffer->events)
+        retired_thread.events.unchecked_append(event);
+
+    buffers.retired_event_count += retired_thread.events.size();
+    buffers.retired_threads.append(move(retired_thread));
+
+    // Drop the oldest threads until the rest fit, which always keeps the thread that has just exited.
+    while (buffers.retired_event_count > TraceEvents::max_recorded_events_per_thread)
+        buffers.retired_event_count -= buffers.retired_threads.take_first().events.size();
+}
+
+static ThreadTraceBuffer& current_thread_buffer()
+{
+    if (auto* buffer = s_current_thread_trace.buffer)
+        return *buffer;
+
+    auto buffer = make<ThreadTraceBuffer>();
+    buffer->thread_name = s_current_thread_trace.thread_name;
+    s_current_thread_trace.buffer = buffer.ptr();
+
+    auto& buffers = thread_trace_buffers();
+    TraceSpinLocker locker { buffers.is_locked };
+    buffer->thread_index = buffers.next_thread_index++;
+    buffers.buffers.append(move(buffer));
+    return *s_current_thread_trace.buffer;
+}
+
+Atomic<u16> TraceEvents::s_enabled_categories { 0 };
+
+TraceCategory TraceEvents::enabled_categories()
+{
+    return static_cast<TraceCategory>(s_enabled_categories.load(AK::MemoryOrder::memory_order_relaxed));
+}
+
+void TraceEvents::set_enabled_categories(TraceCategory categories)
+{
+    s_enabled_categories.store(to_underlying(categories), AK::MemoryOrder::memory_order_relaxed);
+}
+
+void TraceEvents::initialize_for_main_thread(StringView categories)
+{
+    set_current_thread_name("Main"sv);
+
+    auto parsed_categories = trace_categories_from_string(categories);
+    if (!parsed_categories.has_value()) {
+        dbgln("Unknown trace categories '{}'", categories);
+        return;
+    }
+    set_enabled_categories(*parsed_categories);
+}
+
+void TraceEvents::set_current_thread_name(StringView name)
+{
+    if (s_current_thread_has_exited)
+        return;
+
+    s_current_thread_trace.thread_name = name;
+
+    if (auto* buffer = s_current_thread_trace.buffer) {
+        TraceSpinLocker locker { buffer->is_locked };
+        buffer->thread_name = name;
+    }
+}
+
+void TraceEvents::record(TraceCategory category, StringView name, MonotonicTime start_time, MonotonicTime end_time)
+{
+    if (s_current_thread_has_exited)
+        return;
+
+    auto& buffer = current_thread_buffer();
+
+    TraceSpinLocker locker { buffer.is_locked };
+    buffer.events.enqueue({
+        .name = name,
+        .category = category,
+        .start_ns = start_time.nanoseconds(),
+        .duration_ns = (end_time - start_time).to_nanoseconds(),
+    });
+}
+
+String TraceEvents::to_trace_event_json(StringView process_name)
+{
+    auto pid = System::getpid();
+
+    JsonArray events;
+    auto add_metadata = [&](StringView name, Optional<u64> thread_index, StringView value) {
+        JsonObject args;
+        args.set("name"sv, value);
+
+        JsonObject event;
+        event.set("name"sv, name);
+        event.set("ph"sv, "M"sv);
+        event.set("pid"sv, pid);
+        if (thread_index.has_value())
+            event.set("tid"sv, *thread_index);
+        event.set("args"sv, move(args));
+        events.must_append(move(event));
+    };
+    add_metadata("process_name"sv, {}, process_name);
+
+    auto add_thread = [&](u64 thread_index, ByteString const& name, auto const& recorded_events) {
+        auto thread_name = name.is_empty() ? ByteString::formatted("Thread {}", thread_index) : name;
+        add_metadata("thread_name"sv, thread_index, thread_name.view());
+
+        for (auto const& recorded_event : recorded_events) {
+            JsonObject event;
+            event.set("name"sv, recorded_event.name);
+            event.set("cat"sv, trace_category_name(recorded_event.category));
+            event.set("ph"sv, "X"sv);
+            event.set("ts"sv, static_cast<double>(recorded_event.start_ns) / 1000.0);
+            event.set("dur"sv, static_cast<double>(recorded_event.duration_ns) / 1000.0);
+            event.set("pid"sv, pid);
+            event.set("tid"sv, thread_index);
+            events.must_append(move(event));
+        }
+    };
+
+    auto& buffers = thread_trace_buffers();
+    TraceSpinLocker buffers_locker { buffers.is_locked };
+
+    for (auto const& retired_thread : buffers.retired_threads)
+        add_thread(retired_thread.thread_index, retired_thread.thread_name, retired_thread.events);
+
+    for (auto const& buffer : buffers.buffers) {
+        TraceSpinLocker buffer_locker { buffer->is_locked };
+        add_thread(buffer->thread_index, buffer->thread_name, buffer->events);
+    }
+
+    JsonObject trace;
+    trace.set("traceEvents"sv, move(events));
+    trace.set("displayTimeUnit"sv, "ms"sv);
+    return trace.serialized();
+}
+
+String TraceEvents::merge_trace_event_json(ReadonlySpan<String> traces)
+{
+    JsonArray events;
+    for (auto const& trace : traces) {
+        auto json = JsonValue::from_string(trace);
+        if (json.is_error() || !json.value().is_object())
+            continue;
+
+        auto trace_events = json.value().as_object().get_array("traceEvents"sv);
+        if (!trace_events.has_value())
+            continue;
+
+        for (auto& event : trace_events->values())
+            events.must_append(move(event));
+    }
+
+    JsonObject trace;
+    trace.set("traceEvents"sv, move(events));
+    trace.set("displayTimeUnit"sv, "ms"sv);
+    return trace.serialized();
+}
+
+}
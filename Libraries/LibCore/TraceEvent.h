@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/EnumBits.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <LibCore/Export.h>
+
+namespace Core {
+
+enum class TraceCategory : u16 {
+    None = 0,
+    EventLoop = 1 << 0,
+    IPC = 1 << 1,
+    GC = 1 << 2,
+    Style = 1 << 3,
+    Layout = 1 << 4,
+    Paint = 1 << 5,
+    Raster = 1 << 6,
+    Network = 1 << 7,
+    Decode = 1 << 8,
+    All = EventLoop | IPC | GC | Style | Layout | Paint | Raster | Network | Decode,
+};
+
+AK_ENUM_BITWISE_OPERATORS(TraceCategory);
+
+// Parses a comma-separated list of category names, e.g. "layout,paint", or "all".
+CORE_API Optional<TraceCategory> trace_categories_from_string(StringView);
+CORE_API String trace_categories_to_string(TraceCategory);
+
+// Opt-in timing of what each thread of this process is busy with, in the categories that are enabled. Every thread
+// records into a buffer of its own, which holds its most recent events. Nothing is recorded unless a category was
+// enabled, either at startup (see --trace-categories) or later on over IPC.
+class CORE_API TraceEvents {
+public:
+    // The most events kept for each running thread, and for all of the threads that have exited put together. The
+    // events of the threads that exited longest ago are dropped first.
+    static constexpr size_t max_recorded_events_per_thread = 10'000;
+
+    static bool is_enabled(TraceCategory category)
+    {
+        return (s_enabled_categories.load(AK::MemoryOrder::memory_order_relaxed) & to_underlying(category)) != 0;
+    }
+
+    static TraceCategory enabled_categories();
+    static void set_enabled_categories(TraceCategory);
+
+    // Names the calling thread "Main" and enables the categories that were passed to --trace-categories, if any.
+    static void initialize_for_main_thread(StringView categories);
+
+    // Names the calling thread in traces. Threads that are never named are listed by their index.
+    static void set_current_thread_name(StringView);
+
+    // Names are the string literals of the instrumented code, so they outlive the buffers.
+    static void record(TraceCategory, StringView name, MonotonicTime start_time, MonotonicTime end_time);
+
+    // The recorded events of every thread in the Trace Event Format, which Perfetto and chrome://tracing can load.
+    // Events are timed by the monotonic clock, which all processes share, so the traces of several processes can be
+    // merged with merge_trace_event_json().
+    static String to_trace_event_json(StringView process_name);
+    static String merge_trace_event_json(ReadonlySpan<String> traces);
+
+private:
+    static Atomic<u16> s_enabled_categories;
+};
+
+class ScopedTraceEvent {
+    AK_MAKE_NONCOPYABLE(ScopedTraceEvent);
+    AK_MAKE_NONMOVABLE(ScopedTraceEvent);
+
+public:
+    ScopedTraceEvent(TraceCategory category, StringView name)
+    {
+        if (!TraceEvents::is_enabled(category))
+            return;
+
+        m_category = category;
+        m_name = name;
+        m_start_time = MonotonicTime::now();
+    }
+
+    ~ScopedTraceEvent()
+    {
+        if (m_start_time.has_value())
+            TraceEvents::record(m_category, m_name, *m_start_time, MonotonicTime::now());
+    }
+
+private:
+    TraceCategory m_category { TraceCategory::None };
+    StringView m_name;
+    Optional<MonotonicTime> m_start_time;
+};
+
+#define TRACE_EVENT_CONCAT(a, b) a##b
+#define TRACE_EVENT_UNIQUE_NAME(base, line) TRACE_EVENT_CONCAT(base, line)
+
+// Records the time from here to the end of the enclosing scope, e.g. TRACE_EVENT(Layout, "Document::update_layout"sv).
+#define TRACE_EVENT(category, name) \
+    ::Core::ScopedTraceEvent TRACE_EVENT_UNIQUE_NAME(trace_event_, __LINE__) { ::Core::TraceCategory::category, name }
+
+}
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/AllOf.h>
 #include <AK/AtomicRefCounted.h>
 #include <AK/CountingStream.h>
 #include <AK/HashTable.h>
@@ -98,6 +99,15 @@ public:
             return;
 
         auto now = AK::UnixDateTime::now();
+
+        // Once every record has expired, keep them all so the resolver can serve the answer stale while it revalidates.
+        auto has_expired = [&](RecordWithExpiration const& record) { return record.expiration.has_value() && record.expiration.value() < now; };
+        if (m_request_done && !m_dnssec_validated && !m_cached_records.is_empty() && all_of(m_cached_records, has_expired)) {
+            dbgln_if(DNS_DEBUG, "DNS: All records for {} expired, keeping them to serve stale", m_name.to_string());
+            m_valid = false;
+            return;
+        }
+
         for (size_t i = 0; i < m_cached_records.size();) {
             auto& record = m_cached_records[i];
             if (record.expiration.has_value() && record.expiration.value() < now) {
@@ -231,6 +241,7 @@ public:
 
     struct LookupOptions {
         bool validate_dnssec_locally { false };
+        bool bypass_stale_cache { false };
         PendingLookup* repeating_lookup { nullptr };
 
         static LookupOptions default_() { return {}; }
@@ -306,6 +317,23 @@ public:
         });
     }
 
+    RefPtr<LookupResult const> lookup_in_stale_cache(StringView name, Span<Messages::ResourceType const> desired_types)
+    {
+        return m_stale_cache.with_read_locked([&](auto& stale_cache) -> RefPtr<LookupResult const> {
+            auto it = stale_cache.find(name);
+            if (it == stale_cache.end())
+                return {};
+
+            auto& result = *it->value.result;
+            for (auto const& type : desired_types) {
+                if (!result.has_record_of_type(type, true))
+                    return {};
+            }
+
+            return result;
+        });
+    }
+
     NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> lookup(ByteString name, Messages::Class class_, Vector<Vector<Messages::ResourceType>> desired_types, LookupOptions options = LookupOptions::default_())
     {
         using ResultPromise = Core::Promise<NonnullRefPtr<LookupResult const>>;
@@ -424,6 +452,21 @@ public:
             dbgln_if(DNS_DEBUG, "DNS: Cache entry for {} is not DNSSEC validated (and we expect that), re-resolving", name);
         }
 
+        // Serve an expired answer right away and revalidate it in the background, rather than blocking the caller on
+        // a fresh lookup (RFC 8767). The stale answer is dropped once the fresh one lands.
+        if (!options.validate_dnssec_locally && !options.bypass_stale_cache && !options.repeating_lookup) {
+            if (auto result = lookup_in_stale_cache(name, desired_types)) {
+                dbgln_if(DNS_DEBUG, "DNS: Resolved {} from stale cache, revalidating", name);
+                promise->resolve(result.release_nonnull());
+                lookup_path = "stale-hit"sv;
+
+                auto revalidation_options = options;
+                revalidation_options.bypass_stale_cache = true;
+                (void)lookup(name, class_, desired_types, revalidation_options);
+                return promise;
+            }
+        }
+
         auto domain_name = Messages::DomainName::from_string(name);
 
         if (!has_connection()) {
@@ -1407,19 +1450,41 @@ private:
 
     void flush_cache()
     {
+        auto now = AK::UnixDateTime::now();
         m_cache.with_write_locked([&](auto& cache) {
-            HashTable<ByteString> to_remove;
-            for (auto& entry : cache) {
-                entry.value->check_expiration();
-                if (entry.value->can_be_removed())
-                    to_remove.set(entry.key);
-            }
-            for (auto const& key : to_remove)
-                cache.remove(key);
+            m_stale_cache.with_write_locked([&](auto& stale_cache) {
+                HashTable<ByteString> to_remove;
+                for (auto& entry : cache) {
+                    entry.value->check_expiration();
+                    if (entry.value->can_be_removed())
+                        to_remove.set(entry.key);
+                }
+                for (auto const& key : to_remove) {
+                    auto result = cache.take(key).release_value();
+                    if (!result->is_empty())
+                        stale_cache.set(key, { move(result), now });
+                }
+
+                stale_cache.remove_all_matching([&](auto const& key, auto const& stale_result) {
+                    if (now - stale_result.expired_at > MAXIMUM_STALE_RESULT_AGE)
+                        return true;
+                    auto it = cache.find(key);
+                    return it != cache.end() && it->value->is_done() && !it->value->is_empty();
+                });
+            });
         });
     }
 
+    // RFC 8767 recommends capping how long an expired answer may be served to somewhere between one and three days.
+    static constexpr AK::Duration MAXIMUM_STALE_RESULT_AGE = AK::Duration::from_seconds(24 * 60 * 60);
+
+    struct StaleResult {
+        NonnullRefPtr<LookupResult> result;
+        AK::UnixDateTime expired_at;
+    };
+
     Sync::RWLockProtected<HashMap<ByteString, NonnullRefPtr<LookupResult>>> m_cache;
+    Sync::RWLockProtected<HashMap<ByteString, StaleResult>> m_stale_cache;
     Sync::RWLockProtected<HashMap<ByteString, NonnullRefPtr<PendingSystemResolution>>> m_pending_system_resolutions;
     Sync::RWLockProtected<NonnullOwnPtr<RedBlackTree<u16, PendingLookup>>> m_pending_lookups;
     Sync::RWLockProtected<Optional<MaybeOwned<Core::Socket>>> m_socket;
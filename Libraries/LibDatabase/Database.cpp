@@ -4,11 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/ByteString.h>
 #include <AK/String.h>
 #include <AK/Time.h>
 #include <LibCore/Directory.h>
 #include <LibDatabase/Database.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibThreading/ThreadPool.h>
 
 #include <sqlite3.h>
 
@@ -55,6 +59,83 @@ static constexpr StringView sql_error(int error_code)
     __ENUMERATE_TYPE(double)             \
     __ENUMERATE_TYPE(bool)
 
+// The number of pages, which are 4 KiB by default, that the write-ahead log may grow to before it is checkpointed. This
+// is the threshold SQLite uses for its own automatic checkpoints.
+static constexpr int WAL_CHECKPOINT_THRESHOLD = 1000;
+
+// SQLite checkpoints the write-ahead log on the connection whose commit grows it past the threshold, which copies the
+// log into the database file and syncs it to disk before the commit returns. File-backed databases instead leave the
+// checkpoints to a connection of their own on a background thread, so that a slow disk doesn't stall their owner.
+class Database::BackgroundCheckpointer final : public AtomicRefCounted<BackgroundCheckpointer> {
+public:
+    static NonnullRefPtr<BackgroundCheckpointer> create(LexicalPath database_path)
+    {
+        return adopt_ref(*new BackgroundCheckpointer(move(database_path)));
+    }
+
+    ~BackgroundCheckpointer()
+    {
+        if (m_connection)
+            sqlite3_close(m_connection);
+    }
+
+    void schedule_checkpoint()
+    {
+        Sync::MutexLocker locker(m_mutex);
+        if (m_is_checkpointing)
+            return;
+        m_is_checkpointing = true;
+
+        Threading::ThreadPool::the().submit([checkpointer = NonnullRefPtr { *this }] {
+            checkpointer->checkpoint();
+        },
+            Threading::TaskPriority::Background);
+    }
+
+    void wait_for_checkpoint()
+    {
+        Sync::MutexLocker locker(m_mutex);
+        while (m_is_checkpointing)
+            m_condition.wait();
+    }
+
+private:
+    explicit BackgroundCheckpointer(LexicalPath database_path)
+        : m_database_path(move(database_path))
+    {
+    }
+
+    void checkpoint()
+    {
+        // NB: Only one checkpoint runs at a time, so the connection is never used by two threads at once.
+        if (!m_connection) {
+            if (auto result = sqlite3_open_v2(m_database_path.string().characters(), &m_connection, SQLITE_OPEN_READWRITE, nullptr); result != SQLITE_OK) {
+                warnln("\033[31;1mDatabase error\033[0m: Unable to open {} for checkpointing: {}", m_database_path.string(), sql_error(result));
+                sqlite3_close(m_connection);
+                m_connection = nullptr;
+            }
+        }
+
+        // A passive checkpoint never waits for the database's other connections. Whatever part of the log they are
+        // still using is copied by the next checkpoint.
+        if (m_connection) {
+            if (auto result = sqlite3_wal_checkpoint_v2(m_connection, nullptr, SQLITE_CHECKPOINT_PASSIVE, nullptr, nullptr); result != SQLITE_OK && result != SQLITE_BUSY)
+                warnln("\033[31;1mDatabase error\033[0m: Unable to checkpoint {}: {}", m_database_path.string(), sql_error(result));
+        }
+
+        Sync::MutexLocker locker(m_mutex);
+        m_is_checkpointing = false;
+        m_condition.broadcast();
+    }
+
+    LexicalPath m_database_path;
+    sqlite3* m_connection { nullptr };
+
+    Sync::Mutex m_mutex;
+    Sync::ConditionVariable m_condition { m_mutex };
+    bool m_is_checkpointing { false };
+};
+
 ErrorOr<NonnullRefPtr<Database>> Database::create_memory_backed()
 {
     sqlite3* sql_database { nullptr };
@@ -79,9 +160,32 @@ ErrorOr<NonnullRefPtr<Database>> Database::create(sqlite3* sql_database, Optiona
     TRY(database->set_journal_mode_pragma(JournalMode::WriteAheadLog));
     TRY(database->set_synchronous_pragma(Synchronous::Normal));
 
+    if (database->m_database_path.has_value())
+        database->enable_background_checkpoints();
+
     return database;
 }
 
+void Database::enable_background_checkpoints()
+{
+    m_background_checkpointer = BackgroundCheckpointer::create(*m_database_path);
+
+    // NB: This replaces SQLite's automatic checkpoints, which are implemented with the same hook.
+    sqlite3_wal_hook(
+        m_database, [](void* context, sqlite3*, char const*, int page_count) {
+            if (page_count >= WAL_CHECKPOINT_THRESHOLD)
+                static_cast<BackgroundCheckpointer*>(context)->schedule_checkpoint();
+            return SQLITE_OK;
+        },
+        m_background_checkpointer.ptr());
+}
+
+void Database::wait_for_background_checkpoint()
+{
+    if (m_background_checkpointer)
+        m_background_checkpointer->wait_for_checkpoint();
+}
+
 Database::Database(sqlite3* database, Optional<LexicalPath> database_path)
     : m_database_path(move(database_path))
     , m_database(database)
@@ -91,6 +195,9 @@ Database::Database(sqlite3* database, Optional<LexicalPath> database_path)
 
 Database::~Database()
 {
+    // NB: A checkpoint that is still running keeps the checkpointer alive, and finishes on its own connection.
+    sqlite3_wal_hook(m_database, nullptr, nullptr);
+
     for (auto* prepared_statement : m_prepared_statements)
         sqlite3_finalize(prepared_statement);
 
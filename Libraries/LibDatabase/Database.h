@@ -13,6 +13,7 @@
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/Span.h>
 #include <AK/StringView.h>
 #include <AK/Vector.h>
@@ -149,23 +150,11 @@ public:
     // https://www.sqlite.org/c3ref/busy_timeout.html
     ErrorOr<void> set_busy_timeout(i32 milliseconds);
 
-private:
-    static ErrorOr<NonnullRefPtr<Database>> create(sqlite3*, Optional<LexicalPath> database_path = {});
-    Database(sqlite3*, Optional<LexicalPath> database_path);
-
-    void execute_statement_internal(StatementID, OnResult);
-    StatementExecutionOutcome execute_interruptible_statement_internal(StatementID, OnResult);
-    ErrorOr<void> try_execute_statement_internal(StatementID, OnResult);
-
-    int bound_parameter_count(StatementID);
-
-    template<typename ValueType>
-    void apply_placeholder(StatementID statement_id, int index, ValueType const& value);
+    // Blocks until a write-ahead log checkpoint that was started in the background has finished. Only meant for tests.
+    void wait_for_background_checkpoint();
 
-    template<typename ValueType>
-    ErrorOr<void> try_apply_placeholder(StatementID statement_id, int index, ValueType const& value);
-
-    class Transaction {
+    // A transaction that is rolled back when it goes out of scope unless it was committed.
+    class DATABASE_API Transaction {
     public:
         explicit Transaction(Database& database)
             : m_database(database)
@@ -186,6 +175,25 @@ private:
         bool m_active { false };
     };
 
+private:
+    static ErrorOr<NonnullRefPtr<Database>> create(sqlite3*, Optional<LexicalPath> database_path = {});
+    Database(sqlite3*, Optional<LexicalPath> database_path);
+
+    class BackgroundCheckpointer;
+    void enable_background_checkpoints();
+
+    void execute_statement_internal(StatementID, OnResult);
+    StatementExecutionOutcome execute_interruptible_statement_internal(StatementID, OnResult);
+    ErrorOr<void> try_execute_statement_internal(StatementID, OnResult);
+
+    int bound_parameter_count(StatementID);
+
+    template<typename ValueType>
+    void apply_placeholder(StatementID statement_id, int index, ValueType const& value);
+
+    template<typename ValueType>
+    ErrorOr<void> try_apply_placeholder(StatementID statement_id, int index, ValueType const& value);
+
     ALWAYS_INLINE sqlite3_stmt* prepared_statement(StatementID statement_id)
     {
         VERIFY(statement_id < m_prepared_statements.size());
@@ -197,6 +205,7 @@ private:
     Vector<sqlite3_stmt*> m_prepared_statements;
     Optional<StatementID> m_table_exists_statement;
     Optional<StatementID> m_schema_version_statement;
+    RefPtr<BackgroundCheckpointer> m_background_checkpointer;
 };
 
 }
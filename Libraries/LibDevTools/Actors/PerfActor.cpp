@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <LibDevTools/Actors/PerfActor.h>
+#include <LibDevTools/DevToolsDelegate.h>
+#include <LibDevTools/DevToolsServer.h>
+
+namespace DevTools {
+
+static constexpr auto default_sampling_interval = AK::Duration::from_milliseconds(1);
+
+NonnullRefPtr<PerfActor> PerfActor::create(DevToolsServer& devtools, String name)
+{
+    return adopt_ref(*new PerfActor(devtools, move(name)));
+}
+
+PerfActor::PerfActor(DevToolsServer& devtools, String name)
+    : Actor(devtools, move(name))
+{
+}
+
+PerfActor::~PerfActor() = default;
+
+// https://firefox-source-docs.mozilla.org/devtools/backend/actor-hierarchy.html
+// The perf actor drives the "Performance" panel, which records a profile and opens it in profiler.firefox.com.
+void PerfActor::handle_message(Message const& message)
+{
+    JsonObject response;
+
+    if (message.type == "isSupportedPlatform"sv) {
+        response.set("value"sv, true);
+        send_response(message, move(response));
+        return;
+    }
+
+    if (message.type == "isActive"sv) {
+        response.set("value"sv, m_is_active);
+        send_response(message, move(response));
+        return;
+    }
+
+    if (message.type == "getSupportedFeatures"sv) {
+        JsonArray features;
+        features.must_append("js"sv);
+
+        response.set("value"sv, move(features));
+        send_response(message, move(response));
+        return;
+    }
+
+    if (message.type == "startProfiler"sv) {
+        auto interval = default_sampling_interval;
+
+        // The interval is given in milliseconds, and may be fractional.
+        if (auto options = message.data.get_object("options"sv); options.has_value()) {
+            if (auto milliseconds = options->get_double_with_precision_loss("interval"sv); milliseconds.has_value() && *milliseconds > 0)
+                interval = AK::Duration::from_microseconds(static_cast<i64>(*milliseconds * 1000.0));
+        }
+
+        start_profiler(interval);
+
+        response.set("value"sv, true);
+        send_response(message, move(response));
+        return;
+    }
+
+    if (message.type == "stopProfilerAndDiscardProfile"sv) {
+        stop_profiler({});
+        send_response(message, move(response));
+        return;
+    }
+
+    if (message.type == "getProfileAndStopProfiler"sv) {
+        stop_profiler(message.id);
+        return;
+    }
+
+    send_unrecognized_packet_type_error(message);
+}
+
+void PerfActor::start_profiler(AK::Duration interval)
+{
+    if (m_is_active)
+        return;
+
+    for (auto const& tab : devtools().delegate().tab_list())
+        devtools().delegate().start_javascript_profiler(tab, interval);
+
+    m_is_active = true;
+
+    JsonObject message;
+    message.set("type"sv, "profiler-started"sv);
+    send_message(move(message));
+}
+
+void PerfActor::stop_profiler(Optional<u64> message_id)
+{
+    auto tabs = devtools().delegate().tab_list();
+    auto profiler_id = ++m_profiler_id;
+
+    m_pending_message_id = message_id;
+    m_pending_profile_count = tabs.size();
+    m_received_profiles.clear();
+
+    if (m_is_active) {
+        m_is_active = false;
+
+        JsonObject message;
+        message.set("type"sv, "profiler-stopped"sv);
+        send_message(move(message));
+    }
+
+    if (tabs.is_empty()) {
+        received_profile(profiler_id, {});
+        return;
+    }
+
+    for (auto const& tab : tabs) {
+        devtools().delegate().stop_javascript_profiler(tab, [weak_self = make_weak_ptr<PerfActor>(), profiler_id](ErrorOr<JsonValue> profile) {
+            auto self = weak_self.strong_ref();
+            if (!self)
+                return;
+
+            if (profile.is_error() || !profile.value().is_object()) {
+                self->received_profile(profiler_id, {});
+                return;
+            }
+            self->received_profile(profiler_id, move(profile.release_value().as_object()));
+        });
+    }
+}
+
+void PerfActor::received_profile(u64 profiler_id, Optional<JsonObject> profile)
+{
+    if (profiler_id != m_profiler_id)
+        return;
+
+    if (profile.has_value())
+        m_received_profiles.append(profile.release_value());
+
+    if (m_pending_profile_count > 0)
+        --m_pending_profile_count;
+    if (m_pending_profile_count > 0)
+        return;
+
+    auto message_id = exchange(m_pending_message_id, {});
+    auto profiles = move(m_received_profiles);
+
+    if (!message_id.has_value())
+        return;
+
+    // Each tab's profile holds a single thread, so combine them by moving every thread into the first profile.
+    JsonValue combined_profile;
+
+    if (!profiles.is_empty()) {
+        auto& first_profile = profiles.first();
+
+        if (auto threads = first_profile.get_array("threads"sv); threads.has_value()) {
+            auto combined_threads = threads.release_value();
+
+            for (size_t i = 1; i < profiles.size(); ++i) {
+                if (auto other_threads = profiles[i].get_array("threads"sv); other_threads.has_value()) {
+                    for (auto& thread : other_threads->values())
+                        combined_threads.must_append(thread);
+                }
+            }
+
+            first_profile.set("threads"sv, move(combined_threads));
+        }
+
+        combined_profile = move(first_profile);
+    }
+
+    JsonObject response;
+    response.set("value"sv, move(combined_profile));
+    send_response({ .id = *message_id }, move(response));
+}
+
+}
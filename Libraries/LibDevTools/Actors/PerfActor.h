@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/JsonObject.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibDevTools/Actor.h>
+#include <LibDevTools/Forward.h>
+
+namespace DevTools {
+
+class DEVTOOLS_API PerfActor final : public Actor {
+public:
+    static constexpr auto base_name = "perf"sv;
+
+    static NonnullRefPtr<PerfActor> create(DevToolsServer&, String name);
+    virtual ~PerfActor() override;
+
+private:
+    PerfActor(DevToolsServer&, String name);
+
+    virtual void handle_message(Message const&) override;
+
+    void start_profiler(AK::Duration interval);
+    void stop_profiler(Optional<u64> message_id);
+    void received_profile(u64 profiler_id, Optional<JsonObject>);
+
+    bool m_is_active { false };
+
+    // Incremented each time the profiler is stopped, so that profiles received for an earlier session are ignored.
+    u64 m_profiler_id { 0 };
+
+    Optional<u64> m_pending_message_id;
+    size_t m_pending_profile_count { 0 };
+    Vector<JsonObject> m_received_profiles;
+};
+
+}
@@ -7,6 +7,7 @@
 #include <AK/JsonObject.h>
 #include <LibDevTools/Actors/DeviceActor.h>
 #include <LibDevTools/Actors/ParentAccessibilityActor.h>
+#include <LibDevTools/Actors/PerfActor.h>
 #include <LibDevTools/Actors/PreferenceActor.h>
 #include <LibDevTools/Actors/ProcessActor.h>
 #include <LibDevTools/Actors/RootActor.h>
@@ -59,6 +60,8 @@ void RootActor::handle_message(Message const& message)
                 response.set("deviceActor"sv, actor.key);
             else if (is<ParentAccessibilityActor>(*actor.value))
                 response.set("parentAccessibilityActor"sv, actor.key);
+            else if (is<PerfActor>(*actor.value))
+                response.set("perfActor"sv, actor.key);
             else if (is<PreferenceActor>(*actor.value))
                 response.set("preferenceActor"sv, actor.key);
         }
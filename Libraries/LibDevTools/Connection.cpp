@@ -46,7 +46,12 @@ void Connection::send_message(JsonValue const& message)
 
     // Temporarily enable blocking mode for large writes to avoid EAGAIN
     (void)m_socket->set_blocking(true);
-    auto result = m_socket->write_until_depleted(MUST(String::formatted("{}:{}", serialized.byte_count(), serialized)));
+    // NB: The length prefix is written on its own, so that the message isn't copied into a single buffer along with it.
+    auto result = [&]() -> ErrorOr<void> {
+        TRY(m_socket->write_until_depleted(MUST(String::formatted("{}:", serialized.byte_count()))));
+        TRY(m_socket->write_until_depleted(serialized));
+        return {};
+    }();
     (void)m_socket->set_blocking(false);
 
     if (result.is_error()) {
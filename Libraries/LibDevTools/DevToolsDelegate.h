@@ -94,6 +94,10 @@ public:
     using OnAccessibilityTreeInspectionComplete = Function<void(ErrorOr<JsonValue>)>;
     virtual void inspect_accessibility_tree(TabDescription const&, OnAccessibilityTreeInspectionComplete) const { }
 
+    using OnJavaScriptProfileReceived = Function<void(ErrorOr<JsonValue>)>;
+    virtual void start_javascript_profiler(TabDescription const&, AK::Duration) const { }
+    virtual void stop_javascript_profiler(TabDescription const&, OnJavaScriptProfileReceived) const { }
+
     using OnDOMNodePropertiesReceived = Function<void(WebView::DOMNodeProperties)>;
     virtual void listen_for_dom_properties(TabDescription const&, OnDOMNodePropertiesReceived) const { }
     virtual void stop_listening_for_dom_properties(TabDescription const&) const { }
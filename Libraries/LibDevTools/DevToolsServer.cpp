@@ -12,6 +12,7 @@
 #include <LibCore/TCPServer.h>
 #include <LibDevTools/Actors/DeviceActor.h>
 #include <LibDevTools/Actors/ParentAccessibilityActor.h>
+#include <LibDevTools/Actors/PerfActor.h>
 #include <LibDevTools/Actors/PreferenceActor.h>
 #include <LibDevTools/Actors/ProcessActor.h>
 #include <LibDevTools/Actors/TabActor.h>
@@ -108,6 +109,7 @@ ErrorOr<void> DevToolsServer::on_new_client()
     m_root_actor = register_actor<RootActor>();
 
     register_actor<DeviceActor>();
+    register_actor<PerfActor>();
     register_actor<PreferenceActor>();
     register_actor<ProcessActor>(ProcessDescription { .is_parent = true });
     register_actor<ParentAccessibilityActor>();
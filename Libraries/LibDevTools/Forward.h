@@ -30,6 +30,7 @@ class NetworkEventActor;
 class NetworkParentActor;
 class NodeActor;
 class PageStyleActor;
+class PerfActor;
 class ParentAccessibilityActor;
 class PreferenceActor;
 class ProcessActor;
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Assertions.h>
+#include <LibGC/BlockAddressBitmap.h>
+
+namespace GC {
+
+u64* BlockAddressBitmap::s_leaves[ROOT_ENTRY_COUNT];
+
+u64* BlockAddressBitmap::ensure_leaf(size_t root_index)
+{
+    if (auto* leaf = AK::atomic_load(&s_leaves[root_index], AK::memory_order_acquire))
+        return leaf;
+
+    auto* new_leaf = new u64[LEAF_WORD_COUNT] {};
+    u64* expected = nullptr;
+    if (AK::atomic_compare_exchange_strong(&s_leaves[root_index], expected, new_leaf, AK::memory_order_acq_rel))
+        return new_leaf;
+
+    // Another thread installed this leaf first.
+    delete[] new_leaf;
+    return expected;
+}
+
+void BlockAddressBitmap::set(FlatPtr block_address)
+{
+    VERIFY(block_address % HeapBlockBase::BLOCK_SIZE == 0);
+    if constexpr (ADDRESS_BITS < sizeof(FlatPtr) * 8)
+        VERIFY(!(block_address >> ADDRESS_BITS));
+
+    auto index = block_address >> BLOCK_SHIFT;
+    auto* leaf = ensure_leaf(index >> LEAF_BITS);
+    auto bit = index & LEAF_MASK;
+    AK::atomic_fetch_or(&leaf[bit / 64], u64 { 1 } << (bit % 64), AK::memory_order_relaxed);
+}
+
+void BlockAddressBitmap::clear(FlatPtr block_address)
+{
+    auto index = block_address >> BLOCK_SHIFT;
+    auto* leaf = AK::atomic_load(&s_leaves[index >> LEAF_BITS], AK::memory_order_acquire);
+    VERIFY(leaf);
+    auto bit = index & LEAF_MASK;
+    AK::atomic_fetch_and(&leaf[bit / 64], ~(u64 { 1 } << (bit % 64)), AK::memory_order_relaxed);
+}
+
+}
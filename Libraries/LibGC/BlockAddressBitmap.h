@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/Types.h>
+#include <LibGC/Export.h>
+#include <LibGC/Internals.h>
+
+namespace GC {
+
+// One bit per HeapBlock-sized slot of the address space, set while a BlockAllocator has the slot handed out. This
+// lets conservative root scanning reject almost every stack word with a shift and a bit test instead of a hash
+// lookup. A set bit only means that some heap owns a block there; callers still have to check it is one of theirs.
+//
+// The bits live in a two-level table so the address space can be covered without reserving the whole bitmap up
+// front. Leaves are allocated on first use and never freed, which keeps lookups lock-free.
+class GC_API BlockAddressBitmap {
+public:
+    static void set(FlatPtr block_address);
+    static void clear(FlatPtr block_address);
+
+    ALWAYS_INLINE static bool contains(FlatPtr address)
+    {
+        if constexpr (ADDRESS_BITS < sizeof(FlatPtr) * 8) {
+            if (address >> ADDRESS_BITS)
+                return false;
+        }
+        auto index = address >> BLOCK_SHIFT;
+        auto* leaf = AK::atomic_load(&s_leaves[index >> LEAF_BITS], AK::memory_order_acquire);
+        if (!leaf)
+            return false;
+        auto bit = index & LEAF_MASK;
+        return AK::atomic_load(&leaf[bit / 64], AK::memory_order_relaxed) & (u64 { 1 } << (bit % 64));
+    }
+
+private:
+    // Matches the user-space pointer width NanBoxedValue assumes.
+    static constexpr size_t ADDRESS_BITS = sizeof(FlatPtr) == 8 ? 48 : 32;
+    static constexpr size_t BLOCK_SHIFT = count_trailing_zeroes(HeapBlockBase::BLOCK_SIZE);
+    static constexpr size_t BLOCK_INDEX_BITS = ADDRESS_BITS - BLOCK_SHIFT;
+    static constexpr size_t LEAF_BITS = BLOCK_INDEX_BITS < 18 ? BLOCK_INDEX_BITS : 18;
+    static constexpr size_t LEAF_MASK = (1ull << LEAF_BITS) - 1;
+    static constexpr size_t LEAF_WORD_COUNT = (1ull << LEAF_BITS) / 64;
+    static constexpr size_t ROOT_ENTRY_COUNT = 1ull << (BLOCK_INDEX_BITS - LEAF_BITS);
+
+    static u64* ensure_leaf(size_t root_index);
+
+    // Plain pointers rather than AK::Atomic so the table is zero-initialized before any static constructor can
+    // allocate a block.
+    static u64* s_leaves[ROOT_ENTRY_COUNT];
+};
+
+}
@@ -9,6 +9,7 @@
 #include <AK/NeverDestroyed.h>
 #include <AK/Platform.h>
 #include <AK/Vector.h>
+#include <LibGC/BlockAddressBitmap.h>
 #include <LibGC/BlockAllocator.h>
 #include <LibGC/HeapBlock.h>
 #include <LibThreading/Thread.h>
@@ -145,6 +146,25 @@ static void yield_during_decommit()
 #endif
 }
 
+// A per-thread cache of free blocks belonging to one BlockAllocator. Entries coming from m_blocks (already madvised
+// for decommit) carry NEEDS_MADVISE_REUSE in their low bit; blocks are BLOCK_SIZE-aligned so the bit is otherwise zero.
+struct BlockMagazine {
+    static constexpr FlatPtr NEEDS_MADVISE_REUSE = 1;
+
+    ~BlockMagazine()
+    {
+        // Hand cached blocks back so they aren't lost when the thread exits.
+        if (owner && count > 0)
+            owner->flush_magazine(*this, count);
+    }
+
+    BlockAllocator* owner { nullptr };
+    size_t count { 0 };
+    FlatPtr entries[BlockAllocator::MAGAZINE_CAPACITY] {};
+};
+
+static thread_local BlockMagazine s_magazine;
+
 class DecommitWorker {
 public:
     static DecommitWorker& the();
@@ -269,6 +289,25 @@ void BlockAllocator::wake_decommit_worker_async()
     DecommitWorker::the().kick();
 }
 
+void BlockAllocator::decommit_free_blocks_now()
+{
+    if (s_magazine.owner == this && s_magazine.count > 0)
+        flush_magazine(s_magazine, s_magazine.count);
+
+    Vector<void*> to_process;
+    {
+        Sync::MutexLocker locker(m_mutex);
+        to_process = move(m_freshly_freed);
+    }
+
+    for (auto* slot : to_process)
+        madvise_block_for_decommit(slot);
+
+    Sync::MutexLocker locker(m_mutex);
+    for (auto* slot : to_process)
+        m_blocks.append(slot);
+}
+
 BlockAllocator::BlockAllocator()
     : m_worker_cv(m_mutex)
 {
@@ -276,6 +315,11 @@ BlockAllocator::BlockAllocator()
 
 BlockAllocator::~BlockAllocator()
 {
+    if (s_magazine.owner == this) {
+        s_magazine.owner = nullptr;
+        s_magazine.count = 0;
+    }
+
     // Chunks are permanent -- we never tear them down. The destructor only
     // exists to make sure the global decommit worker has finished any
     // in-flight processing of *this before our storage goes away.
@@ -292,12 +336,50 @@ size_t BlockAllocator::block_count()
     return m_blocks.size();
 }
 
+void BlockAllocator::refill_magazine(BlockMagazine& magazine)
+{
+    Sync::MutexLocker locker(m_mutex);
+    while (magazine.count < MAGAZINE_BATCH_SIZE && !m_freshly_freed.is_empty())
+        magazine.entries[magazine.count++] = bit_cast<FlatPtr>(m_freshly_freed.take_last());
+    while (magazine.count < MAGAZINE_BATCH_SIZE && !m_blocks.is_empty())
+        magazine.entries[magazine.count++] = bit_cast<FlatPtr>(m_blocks.take_last()) | BlockMagazine::NEEDS_MADVISE_REUSE;
+}
+
+void BlockAllocator::flush_magazine(BlockMagazine& magazine, size_t count)
+{
+    VERIFY(count <= magazine.count);
+
+    // NB: The magazine only ever holds blocks that were freed without deferred decommit, so like those they go back
+    //     to the freshly freed list without registering with the decommit worker.
+    Sync::MutexLocker locker(m_mutex);
+    for (size_t i = 0; i < count; ++i) {
+        auto entry = magazine.entries[--magazine.count];
+        if (entry & BlockMagazine::NEEDS_MADVISE_REUSE)
+            m_blocks.append(bit_cast<void*>(entry & ~BlockMagazine::NEEDS_MADVISE_REUSE));
+        else
+            m_freshly_freed.append(bit_cast<void*>(entry));
+    }
+}
+
 void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
 {
     void* block = nullptr;
     bool needs_madvise_reuse = false;
 
-    {
+    // The first allocator used on a thread owns its magazine; in practice that is the shared allocator.
+    if (!s_magazine.owner)
+        s_magazine.owner = this;
+
+    // Fast path: take a block from this thread's magazine without locking.
+    if (s_magazine.owner == this && s_magazine.count == 0)
+        refill_magazine(s_magazine);
+    if (s_magazine.owner == this && s_magazine.count > 0) {
+        auto entry = s_magazine.entries[--s_magazine.count];
+        block = bit_cast<void*>(entry & ~BlockMagazine::NEEDS_MADVISE_REUSE);
+        needs_madvise_reuse = entry & BlockMagazine::NEEDS_MADVISE_REUSE;
+    }
+
+    if (block == nullptr) {
         Sync::MutexLocker locker(m_mutex);
 
         // Prefer m_freshly_freed: those slots were never madvised, so we
@@ -369,18 +451,30 @@ void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
 #else
     (void)needs_madvise_reuse;
 #endif
+    BlockAddressBitmap::set(bit_cast<FlatPtr>(block));
     return block;
 }
 
 void BlockAllocator::deallocate_block(void* block, DeferDecommit defer_decommit)
 {
     VERIFY(block);
+    BlockAddressBitmap::clear(bit_cast<FlatPtr>(block));
 
     // Fast path: bookkeep only. The actual madvise is deferred to the
     // global decommit worker, which the GC kicks at the end of sweep.
     ASAN_POISON_MEMORY_REGION(block, HeapBlock::BLOCK_SIZE);
     LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::BLOCK_SIZE);
 
+    // Fast path: keep the block in this thread's magazine. Once it fills up, half of it is handed to the shared
+    // lists under a single lock. Blocks that should be decommitted take the slow path, since the decommit worker
+    // can't see into magazines.
+    if (defer_decommit == DeferDecommit::No && s_magazine.owner == this) {
+        if (s_magazine.count == MAGAZINE_CAPACITY)
+            flush_magazine(s_magazine, MAGAZINE_BATCH_SIZE);
+        s_magazine.entries[s_magazine.count++] = bit_cast<FlatPtr>(block);
+        return;
+    }
+
     bool need_to_register = false;
     {
         Sync::MutexLocker locker(m_mutex);
@@ -20,6 +20,7 @@ enum class DeferDecommit {
 };
 
 class DecommitWorker;
+struct BlockMagazine;
 
 class GC_API BlockAllocator {
 public:
@@ -35,8 +36,21 @@ public:
     // work that's piled up. Call this at the end of a GC sweep.
     static void wake_decommit_worker_async();
 
+    // Synchronously decommit every free block that hasn't been madvised yet, including the calling thread's magazine.
+    // Used under memory pressure, where waiting for the decommit worker's stagger would leave the memory resident.
+    void decommit_free_blocks_now();
+
+    // Each thread keeps a small magazine of free blocks so that allocate_block() and deallocate_block() only take
+    // m_mutex once per batch rather than once per block.
+    static constexpr size_t MAGAZINE_CAPACITY = 16;
+    static constexpr size_t MAGAZINE_BATCH_SIZE = MAGAZINE_CAPACITY / 2;
+
 private:
     friend class DecommitWorker;
+    friend struct BlockMagazine;
+
+    void refill_magazine(BlockMagazine&);
+    void flush_magazine(BlockMagazine&, size_t count);
 
     // Slots in "ready to reuse" state -- have been MADV_FREE_REUSABLE'd by
     // the worker (Darwin) so allocate_block pairs them with MADV_FREE_REUSE.
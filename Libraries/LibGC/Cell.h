@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Format.h>
 #include <AK/Forward.h>
 #include <AK/HashMap.h>
@@ -55,6 +56,10 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
+    // Atomically sets the mark bit. Returns true if this call marked the cell, false if it was already marked.
+    // Used by the parallel mark phase, where several threads may race to claim the same cell.
+    bool try_set_marked() { return !AK::atomic_exchange(&m_mark, true, AK::memory_order_relaxed); }
+
     enum class State : bool {
         Live,
         Dead,
@@ -117,6 +117,8 @@ private:
     SweepBlockList m_blocks_pending_sweep;
     FlatPtr m_min_block_address { explode_byte(0xff) };
     FlatPtr m_max_block_address { 0 };
+    // Bytes swept by the collection currently in flight; collected into Heap::CollectionStatistics when it finishes.
+    size_t m_bytes_freed_in_current_collection { 0 };
     bool m_overrides_must_survive_garbage_collection { false };
     bool m_overrides_finalize { false };
 };
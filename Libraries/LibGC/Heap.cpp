@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/BinarySearch.h>
 #include <AK/Checked.h>
@@ -17,15 +18,21 @@
 #include <AK/NeverDestroyed.h>
 #include <AK/NumberFormat.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
+#include <AK/SaturatingMath.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StackInfo.h>
 #include <AK/StackUnwinder.h>
+#include <AK/Stream.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Time.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
+#include <LibCore/MemoryPressureNotifier.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
+#include <LibGC/BlockAddressBitmap.h>
 #include <LibGC/BlockAllocator.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Heap.h>
@@ -33,6 +40,8 @@
 #include <LibGC/NanBoxedValue.h>
 #include <LibGC/Root.h>
 #include <LibGC/Weak.h>
+#include <LibSync/Mutex.h>
+#include <LibThreading/Thread.h>
 #include <setjmp.h>
 
 #ifdef HAS_ADDRESS_SANITIZER
@@ -49,15 +58,25 @@ static constexpr size_t GC_MIN_BYTES_THRESHOLD { 8 * 1024 * 1024 };
 static constexpr size_t GC_HEAP_GROWTH_FACTOR_NUMERATOR { 7 };
 static constexpr size_t GC_HEAP_GROWTH_FACTOR_DENOMINATOR { 4 };
 
+// In generational mode, a young collection runs whenever this fraction of the old-generation threshold has been
+// allocated, but never more often than every GC_MIN_YOUNG_BYTES_THRESHOLD bytes.
+static constexpr size_t GC_MIN_YOUNG_BYTES_THRESHOLD { 2 * 1024 * 1024 };
+static constexpr size_t GC_YOUNG_GENERATION_DIVISOR { 8 };
+
 static constexpr int GC_INCREMENTAL_SWEEP_INTERVAL_MS = 16;
 static constexpr int GC_INCREMENTAL_SWEEP_SLICE_MS = 5;
 
+static constexpr int GC_INCREMENTAL_MARK_INTERVAL_MS = 16;
+static constexpr int GC_INCREMENTAL_MARK_SLICE_MS = 4;
+
 // The idle GC timer ticks at this interval while the mutator is allocating; IdleCollectionPolicy decides on each tick
 // whether to proactively collect. See idle_gc_on_timer().
 static constexpr int GC_IDLE_GC_INTERVAL_MS = 4000;
 
 static Heap* s_the;
 
+Atomic<u32> g_write_barrier_heap_count { 0 };
+
 namespace {
 
 // LIBGC_LOG_LEVEL controls how much detail collect_garbage() prints:
@@ -78,6 +97,16 @@ i32 libgc_log_level()
     return level;
 }
 
+// LIBGC_MARKING_THREADS sets the default number of threads used by the mark phase. 0 or 1 (the default) keeps
+// marking on the collecting thread.
+size_t read_libgc_marking_threads()
+{
+    char const* env = getenv("LIBGC_MARKING_THREADS");
+    if (!env || !*env)
+        return 1;
+    return max(atoi(env), 1);
+}
+
 // Per-phase timings recorded during a single collect_garbage() call. We keep
 // these at file scope (instead of threading more parameters through the GC's
 // internal helpers) since GC is single-threaded, guarded by m_collecting_garbage.
@@ -108,6 +137,9 @@ struct PhaseTimings {
     i64 mark_bfs_us { 0 };
     i64 mark_clear_uprooted_us { 0 };
 
+    // Per-worker time spent in the BFS phase. Only populated when marking in parallel.
+    Vector<i64> mark_worker_us;
+
     // sweep_dead_cells() subphases. Only populated for CollectEverything;
     // normal collections defer sweep to the incremental sweeper.
     i64 sweep_block_iteration_us { 0 };
@@ -187,6 +219,8 @@ void print_gc_report(i64 total_us, size_t live_block_count)
     dbgln("  mark_live_cells               {:>10} us ({:>5.1f}%)", t.mark_live_cells_us, pct(t.mark_live_cells_us));
     dbgln("    initial visit               {:>10} us ({:>5.1f}%)", t.mark_initial_visit_us, pct(t.mark_initial_visit_us));
     dbgln("    BFS marking                 {:>10} us ({:>5.1f}%)", t.mark_bfs_us, pct(t.mark_bfs_us));
+    for (size_t i = 0; i < t.mark_worker_us.size(); ++i)
+        dbgln("      worker {:<3}                {:>10} us ({:>5.1f}%)", i, t.mark_worker_us[i], pct(t.mark_worker_us[i]));
     dbgln("    clear uprooted              {:>10} us ({:>5.1f}%)", t.mark_clear_uprooted_us, pct(t.mark_clear_uprooted_us));
     dbgln("  finalize_unmarked_cells       {:>10} us ({:>5.1f}%)", t.finalize_unmarked_cells_us, pct(t.finalize_unmarked_cells_us));
     dbgln("  sweep_weak_blocks             {:>10} us ({:>5.1f}%)", t.sweep_weak_blocks_us, pct(t.sweep_weak_blocks_us));
@@ -298,12 +332,18 @@ Heap::Heap(AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> gather_embedder_roo
     if (become_process_default == BecomeProcessDefault::Yes)
         s_the = this;
     m_gc_bytes_threshold = GC_MIN_BYTES_THRESHOLD;
+    m_young_gc_bytes_threshold = GC_MIN_YOUNG_BYTES_THRESHOLD;
+    m_marking_thread_count = read_libgc_marking_threads();
     static_assert(HeapBlock::min_possible_cell_size <= 32, "Heap Cell tracking uses too much data!");
 }
 
 Heap::~Heap()
 {
+    // Whoever installed the callback may already be gone by the time the heap is torn down.
+    on_collection_finished = nullptr;
     collect_garbage(CollectionType::CollectEverything);
+    if (m_generational_collection_enabled)
+        g_write_barrier_heap_count.fetch_sub(1);
 
     for (auto& entry : m_cell_allocators_by_type)
         entry.key->forget_heap({}, *this);
@@ -320,14 +360,20 @@ Heap::~Heap()
     m_incoming_cross_heap_members.clear();
 }
 
-void Heap::will_allocate(size_t size)
+void Heap::will_allocate(size_t size, CollectionTrigger trigger)
 {
     if (should_collect_on_every_allocation()) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(CollectionType::CollectGarbage, false, trigger);
+    } else if (m_generational_collection_enabled) {
+        // Old-generation growth is checked after each young sweep; see did_finish_young_generation_sweep().
+        if (m_allocated_bytes_since_last_gc + size > m_young_gc_bytes_threshold) {
+            m_allocated_bytes_since_last_gc = 0;
+            collect_garbage(CollectionType::CollectYoungGeneration, false, trigger);
+        }
     } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(CollectionType::CollectGarbage, false, trigger);
     }
 
     m_allocated_bytes_since_last_gc += size;
@@ -341,7 +387,7 @@ void Heap::will_allocate(size_t size)
 
 void Heap::did_allocate_external_memory(size_t size)
 {
-    will_allocate(size);
+    will_allocate(size, CollectionTrigger::ExternalMemory);
 }
 
 void Heap::did_free_external_memory(size_t size)
@@ -374,6 +420,171 @@ void Heap::update_gc_bytes_threshold(size_t live_cell_bytes, size_t live_externa
     }
 
     m_gc_bytes_threshold = max(next_gc_bytes_threshold.value(), GC_MIN_BYTES_THRESHOLD);
+    m_young_gc_bytes_threshold = max(m_gc_bytes_threshold / GC_YOUNG_GENERATION_DIVISOR, GC_MIN_YOUNG_BYTES_THRESHOLD);
+}
+
+void Heap::did_finish_sweep(size_t live_cell_bytes, size_t live_external_bytes)
+{
+    if (!m_sweeping_young_generation) {
+        update_gc_bytes_threshold(live_cell_bytes, live_external_bytes);
+    } else {
+        // A young sweep leaves the major threshold alone; once enough has been promoted that the heap outgrew it,
+        // the next collection traces the old generation too.
+        m_sweeping_young_generation = false;
+        Checked<size_t> live_bytes = live_cell_bytes;
+        live_bytes += live_external_bytes;
+        if (live_bytes.has_overflow() || live_bytes.value() > m_gc_bytes_threshold)
+            m_next_collection_must_be_major = true;
+    }
+
+    finish_collection_statistics();
+}
+
+void Heap::begin_collection_statistics(CollectionType type, CollectionTrigger trigger, HashMap<Cell*, HeapRoot> const* roots)
+{
+    // Incremental mark slices may already have added to mark_time, so only fill in what this collection knows.
+    auto& statistics = m_pending_collection_statistics;
+    statistics.sequence_number = ++m_collection_count;
+    statistics.type = type;
+    statistics.trigger = trigger;
+    if (!roots)
+        return;
+
+    statistics.root_count = roots->size();
+    for (auto const& it : *roots) {
+        if (it.value.type == HeapRoot::Type::StackPointer || it.value.type == HeapRoot::Type::RegisterPointer)
+            ++statistics.conservative_root_count;
+    }
+}
+
+void Heap::finish_collection_statistics()
+{
+    auto statistics = exchange(m_pending_collection_statistics, CollectionStatistics {});
+    for (auto& allocator : m_all_cell_allocators) {
+        auto bytes = exchange(allocator.m_bytes_freed_in_current_collection, 0);
+        if (bytes == 0)
+            continue;
+        statistics.freed_bytes += bytes;
+        statistics.freed_bytes_by_allocator.append({ allocator.class_name(), allocator.cell_size(), bytes });
+    }
+
+    m_collection_statistics.enqueue(move(statistics));
+    if (on_collection_finished)
+        on_collection_finished(m_collection_statistics.last());
+}
+
+static StringView collection_type_name(Heap::CollectionType type)
+{
+    switch (type) {
+    case Heap::CollectionType::CollectGarbage:
+        return "full"sv;
+    case Heap::CollectionType::CollectEverything:
+        return "everything"sv;
+    case Heap::CollectionType::CollectYoungGeneration:
+        return "young"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static StringView collection_trigger_name(Heap::CollectionTrigger trigger)
+{
+    switch (trigger) {
+    case Heap::CollectionTrigger::Explicit:
+        return "explicit"sv;
+    case Heap::CollectionTrigger::AllocationThreshold:
+        return "threshold"sv;
+    case Heap::CollectionTrigger::ExternalMemory:
+        return "external_memory"sv;
+    case Heap::CollectionTrigger::IdlePolicy:
+        return "idle"sv;
+    case Heap::CollectionTrigger::MemoryPressure:
+        return "memory_pressure"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+AK::JsonArray Heap::dump_collection_statistics() const
+{
+    JsonArray collections;
+    for (auto const& statistics : m_collection_statistics) {
+        JsonArray freed_by_allocator;
+        for (auto const& freed : statistics.freed_bytes_by_allocator) {
+            JsonObject allocator;
+            if (freed.class_name.has_value())
+                allocator.set("class_name"sv, *freed.class_name);
+            allocator.set("cell_size"sv, freed.cell_size);
+            allocator.set("bytes"sv, freed.bytes);
+            freed_by_allocator.must_append(move(allocator));
+        }
+
+        JsonObject collection;
+        collection.set("sequence_number"sv, statistics.sequence_number);
+        collection.set("type"sv, collection_type_name(statistics.type));
+        collection.set("trigger"sv, collection_trigger_name(statistics.trigger));
+        collection.set("root_count"sv, statistics.root_count);
+        collection.set("conservative_root_count"sv, statistics.conservative_root_count);
+        collection.set("mark_time_us"sv, statistics.mark_time.to_microseconds());
+        collection.set("sweep_time_us"sv, statistics.sweep_time.to_microseconds());
+        collection.set("freed_bytes"sv, statistics.freed_bytes);
+        collection.set("freed_bytes_by_allocator"sv, move(freed_by_allocator));
+        collections.must_append(move(collection));
+    }
+    return collections;
+}
+
+Vector<Heap::AllocatorStatistics> Heap::allocator_statistics()
+{
+    Vector<AllocatorStatistics> statistics;
+    for (auto& allocator : m_all_cell_allocators) {
+        AllocatorStatistics allocator_statistics {
+            .class_name = allocator.class_name(),
+            .cell_size = allocator.cell_size(),
+        };
+
+        allocator.for_each_block([&](auto& block) {
+            ++allocator_statistics.block_count;
+            block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+                ++allocator_statistics.live_cell_count;
+                allocator_statistics.external_bytes = saturating_add(allocator_statistics.external_bytes, cell->external_memory_size());
+            });
+            return IterationDecision::Continue;
+        });
+
+        if (allocator_statistics.block_count != 0)
+            statistics.append(allocator_statistics);
+    }
+    return statistics;
+}
+
+void Heap::set_generational_collection_enabled(bool enabled)
+{
+    if (m_generational_collection_enabled == enabled)
+        return;
+    VERIFY(!m_collecting_garbage);
+    abort_incremental_marking();
+    finish_pending_incremental_sweep();
+
+    m_generational_collection_enabled = enabled;
+    m_remembered_cells.clear();
+    if (enabled) {
+        // Marks are clear between collections, so everything starts out young; the first collection establishes the
+        // old generation.
+        m_next_collection_must_be_major = true;
+        g_write_barrier_heap_count.fetch_add(1);
+    } else {
+        clear_all_marks();
+        g_write_barrier_heap_count.fetch_sub(1);
+    }
+}
+
+void Heap::clear_all_marks()
+{
+    for_each_block([](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
 }
 
 static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
@@ -389,11 +600,15 @@ static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, Fl
             possible_pointer = data;
         if (possible_pointer < min_block_address || possible_pointer > max_block_address)
             return;
+        if (!BlockAddressBitmap::contains(possible_pointer))
+            return;
         possible_pointers.set(possible_pointer, move(origin));
     } else {
         static_assert((sizeof(NanBoxedValue) % sizeof(FlatPtr*)) == 0);
         if (data < min_block_address || data > max_block_address)
             return;
+        if (!BlockAddressBitmap::contains(data))
+            return;
         // In the 32-bit case we will look at the top and bottom part of NanBoxedValue separately we just
         // add both the upper and lower bytes as possible pointers.
         possible_pointers.set(data, move(origin));
@@ -425,6 +640,58 @@ static void for_each_cell_among_possible_pointers(HashTable<HeapBlock*> const& a
     }
 }
 
+static void set_root_origin(AK::JsonObject& node, HeapRoot const& root_origin)
+{
+    auto type = root_origin.type;
+    auto const* location = root_origin.location;
+    switch (type) {
+    case HeapRoot::Type::ConservativeHashMap:
+        node.set("root"sv, "ConservativeHashMap"sv);
+        break;
+    case HeapRoot::Type::ConservativeHashTable:
+        node.set("root"sv, "ConservativeHashTable"sv);
+        break;
+    case HeapRoot::Type::ConservativeVector:
+        node.set("root"sv, "ConservativeVector"sv);
+        break;
+    case HeapRoot::Type::CrossHeapMember:
+        node.set("root"sv, "CrossHeapMember"sv);
+        break;
+    case HeapRoot::Type::HeapFunctionCapturedPointer:
+        node.set("root"sv, "HeapFunctionCapturedPointer"sv);
+        break;
+    case HeapRoot::Type::MustSurviveGC:
+        node.set("root"sv, "MustSurviveGC"sv);
+        break;
+    case HeapRoot::Type::Root:
+        node.set("root"sv, MUST(String::formatted("Root {} {}:{}", location->function_name(), location->filename(), location->line_number())));
+        break;
+    case HeapRoot::Type::RootVector:
+        node.set("root"sv, "RootVector"sv);
+        break;
+    case HeapRoot::Type::RootHashMap:
+        node.set("root"sv, "RootHashMap"sv);
+        break;
+    case HeapRoot::Type::RootHashTable:
+        node.set("root"sv, "RootHashTable"sv);
+        break;
+    case HeapRoot::Type::RegisterPointer:
+        node.set("root"sv, "RegisterPointer"sv);
+        if (root_origin.stack_frame_index.has_value())
+            node.set("stack_frame_index"sv, root_origin.stack_frame_index.value());
+        break;
+    case HeapRoot::Type::StackPointer:
+        node.set("root"sv, "StackPointer"sv);
+        if (root_origin.stack_frame_index.has_value())
+            node.set("stack_frame_index"sv, root_origin.stack_frame_index.value());
+        break;
+    case HeapRoot::Type::VM:
+        node.set("root"sv, "VM"sv);
+        break;
+    }
+    VERIFY(node.has("root"sv));
+}
+
 class GraphConstructorVisitor final : public Cell::Visitor {
 public:
     explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
@@ -501,56 +768,8 @@ public:
             }
 
             auto node = AK::JsonObject();
-            if (it.value.root_origin.has_value()) {
-                auto type = it.value.root_origin->type;
-                auto const* location = it.value.root_origin->location;
-                switch (type) {
-                case HeapRoot::Type::ConservativeHashMap:
-                    node.set("root"sv, "ConservativeHashMap"sv);
-                    break;
-                case HeapRoot::Type::ConservativeHashTable:
-                    node.set("root"sv, "ConservativeHashTable"sv);
-                    break;
-                case HeapRoot::Type::ConservativeVector:
-                    node.set("root"sv, "ConservativeVector"sv);
-                    break;
-                case HeapRoot::Type::CrossHeapMember:
-                    node.set("root"sv, "CrossHeapMember"sv);
-                    break;
-                case HeapRoot::Type::HeapFunctionCapturedPointer:
-                    node.set("root"sv, "HeapFunctionCapturedPointer"sv);
-                    break;
-                case HeapRoot::Type::MustSurviveGC:
-                    node.set("root"sv, "MustSurviveGC"sv);
-                    break;
-                case HeapRoot::Type::Root:
-                    node.set("root"sv, MUST(String::formatted("Root {} {}:{}", location->function_name(), location->filename(), location->line_number())));
-                    break;
-                case HeapRoot::Type::RootVector:
-                    node.set("root"sv, "RootVector"sv);
-                    break;
-                case HeapRoot::Type::RootHashMap:
-                    node.set("root"sv, "RootHashMap"sv);
-                    break;
-                case HeapRoot::Type::RootHashTable:
-                    node.set("root"sv, "RootHashTable"sv);
-                    break;
-                case HeapRoot::Type::RegisterPointer:
-                    node.set("root"sv, "RegisterPointer"sv);
-                    if (it.value.root_origin->stack_frame_index.has_value())
-                        node.set("stack_frame_index"sv, it.value.root_origin->stack_frame_index.value());
-                    break;
-                case HeapRoot::Type::StackPointer:
-                    node.set("root"sv, "StackPointer"sv);
-                    if (it.value.root_origin->stack_frame_index.has_value())
-                        node.set("stack_frame_index"sv, it.value.root_origin->stack_frame_index.value());
-                    break;
-                case HeapRoot::Type::VM:
-                    node.set("root"sv, "VM"sv);
-                    break;
-                }
-                VERIFY(node.has("root"sv));
-            }
+            if (it.value.root_origin.has_value())
+                set_root_origin(node, *it.value.root_origin);
             node.set("class_name"sv, it.value.class_name);
             node.set("edges"sv, edges);
             graph.set(ByteString::number(it.key), node);
@@ -604,6 +823,120 @@ AK::JsonObject Heap::dump_graph()
     return graph;
 }
 
+// Collects the outgoing edges of one cell at a time, so a streamed snapshot never holds more than a single node's
+// edges in memory.
+class SnapshotEdgeVisitor final : public Cell::Visitor {
+public:
+    explicit SnapshotEdgeVisitor(Heap& heap)
+        : m_heap(heap)
+    {
+        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
+    }
+
+    Vector<FlatPtr, 32>& collect_edges(Cell& cell)
+    {
+        m_edges.clear_with_capacity();
+        cell.visit_edges(*this);
+
+        quick_sort(m_edges);
+        size_t unique_count = 0;
+        for (size_t i = 0; i < m_edges.size(); ++i) {
+            if (unique_count == 0 || m_edges[unique_count - 1] != m_edges[i])
+                m_edges[unique_count++] = m_edges[i];
+        }
+        m_edges.shrink(unique_count);
+        return m_edges;
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        m_edges.append(bit_cast<FlatPtr>(&cell));
+    }
+
+    virtual void visit_impl(ReadonlySpan<NanBoxedValue> values) override
+    {
+        for (auto const& value : values)
+            visit(value);
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        HashMap<FlatPtr, HeapRoot> possible_pointers;
+
+        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+
+        for_each_cell_among_possible_pointers(m_heap.m_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+            if (cell->state() == Cell::State::Live)
+                m_edges.append(bit_cast<FlatPtr>(cell));
+        });
+    }
+
+private:
+    Heap& m_heap;
+    Vector<FlatPtr, 32> m_edges;
+    FlatPtr m_min_block_address;
+    FlatPtr m_max_block_address;
+};
+
+ErrorOr<void> Heap::write_graph_snapshot(Stream& stream)
+{
+    // Collect first, so that (up to conservative scanning) every live cell is reachable and no cell points into a
+    // freelist. Walking the blocks then yields the same nodes as dump_graph(), without a graph-sized visited set.
+    collect_garbage();
+    finish_pending_incremental_sweep();
+
+    auto write_line = [&](AK::JsonObject const& object) -> ErrorOr<void> {
+        TRY(stream.write_until_depleted(object.serialized().bytes()));
+        TRY(stream.write_until_depleted("\n"sv.bytes()));
+        return {};
+    };
+
+    HashMap<Cell*, HeapRoot> roots;
+    Vector<StackFrameInfo> stack_frames;
+    gather_roots(roots, &stack_frames);
+
+    for (auto const& frame : stack_frames) {
+        AK::JsonObject record;
+        record.set("type"sv, "stack_frame"sv);
+        record.set("label"sv, frame.label);
+        record.set("size"sv, frame.size_bytes);
+        TRY(write_line(record));
+    }
+
+    for (auto const& [cell, root_origin] : roots) {
+        AK::JsonObject record;
+        record.set("type"sv, "root"sv);
+        record.set("id"sv, MUST(String::formatted("{}", bit_cast<FlatPtr>(cell))));
+        set_root_origin(record, root_origin);
+        TRY(write_line(record));
+    }
+    roots.clear();
+
+    SnapshotEdgeVisitor visitor(*this);
+    ErrorOr<void> result;
+    for_each_block([&](HeapBlock& block) {
+        block.for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (result.is_error())
+                return;
+
+            AK::JsonArray edges;
+            for (auto edge : visitor.collect_edges(*cell))
+                edges.must_append(MUST(String::formatted("{}", edge)));
+
+            AK::JsonObject record;
+            record.set("type"sv, "node"sv);
+            record.set("id"sv, MUST(String::formatted("{}", bit_cast<FlatPtr>(cell))));
+            record.set("class_name"sv, cell->class_name());
+            record.set("edges"sv, move(edges));
+            result = write_line(record);
+        });
+        return result.is_error() ? IterationDecision::Break : IterationDecision::Continue;
+    });
+    return result;
+}
+
 void Heap::run_post_mark_phases(bool report)
 {
     {
@@ -638,13 +971,18 @@ void Heap::run_post_mark_phases(bool report)
     }
 }
 
-void Heap::collect_garbage(CollectionType collection_type, bool print_report)
+void Heap::collect_garbage(CollectionType collection_type, bool print_report, CollectionTrigger trigger)
 {
     VERIFY(!m_collecting_garbage);
 
     finish_pending_incremental_sweep();
     g_next_incremental_sweep_should_report = false;
 
+    if (collection_type == CollectionType::CollectYoungGeneration && (!m_generational_collection_enabled || m_next_collection_must_be_major || m_incremental_marking_active))
+        collection_type = CollectionType::CollectGarbage;
+
+    TRACE_EVENT(GC, collection_type == CollectionType::CollectYoungGeneration ? "GC::Heap::collect_garbage (young)"sv : "GC::Heap::collect_garbage"sv);
+
     {
         TemporaryChange change(m_collecting_garbage, true);
 
@@ -662,19 +1000,43 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
         }
         ScopeGuard stop_recording = [&] { g_recording_phase_timings = false; };
 
-        if (collection_type == CollectionType::CollectGarbage) {
+        if (collection_type != CollectionType::CollectEverything) {
             if (m_gc_deferrals) {
                 m_should_gc_when_deferral_ends = true;
+                m_deferred_collection_trigger = trigger;
                 return;
             }
+            // With sticky mark bits, every cell that survived the previous collection is still marked. A young
+            // collection relies on that to stop tracing at old cells; a full collection starts over from all-white.
+            if (m_generational_collection_enabled && collection_type == CollectionType::CollectGarbage) {
+                clear_all_marks();
+                m_remembered_cells.clear();
+                m_next_collection_must_be_major = false;
+            }
             HashMap<Cell*, HeapRoot> roots;
             {
                 ScopedPhaseTimer timer { report, g_phase_timings.gather_roots_us };
                 gather_roots(roots);
             }
+            begin_collection_statistics(collection_type, trigger, &roots);
             {
                 ScopedPhaseTimer timer { report, g_phase_timings.mark_live_cells_us };
-                mark_live_cells(roots);
+                auto mark_start_time = MonotonicTime::now();
+                if (collection_type == CollectionType::CollectYoungGeneration)
+                    mark_young_generation(roots);
+                else if (m_incremental_marking_active)
+                    finish_incremental_marking(roots);
+                else
+                    mark_live_cells(roots);
+                m_pending_collection_statistics.mark_time += MonotonicTime::now() - mark_start_time;
+            }
+            m_sweeping_young_generation = collection_type == CollectionType::CollectYoungGeneration;
+        } else {
+            abort_incremental_marking();
+            begin_collection_statistics(collection_type, trigger, nullptr);
+            if (m_generational_collection_enabled) {
+                clear_all_marks();
+                m_remembered_cells.clear();
             }
         }
         run_post_mark_phases(report);
@@ -1055,9 +1417,9 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 class MarkingVisitor final : public Cell::Visitor {
 public:
     // The domain is a set of heaps whose cells this mark phase is responsible for; cells outside the domain are not visited.
-    explicit MarkingVisitor(ReadonlySpan<Heap* const> domain, HashMap<Cell*, HeapRoot> const& roots)
-        : m_domain(domain)
+    explicit MarkingVisitor(ReadonlySpan<Heap* const> domain)
     {
+        m_domain.append(domain.data(), domain.size());
         m_min_block_address = explode_byte(0xff);
         m_max_block_address = 0;
         for (auto* heap : m_domain) {
@@ -1066,6 +1428,16 @@ public:
             m_min_block_address = min(m_min_block_address, min_block_address);
             m_max_block_address = max(m_max_block_address, max_block_address);
         }
+    }
+
+    MarkingVisitor(ReadonlySpan<Heap* const> domain, HashMap<Cell*, HeapRoot> const& roots)
+        : MarkingVisitor(domain)
+    {
+        visit_roots(roots);
+    }
+
+    void visit_roots(HashMap<Cell*, HeapRoot> const& roots)
+    {
         for (auto* root : roots.keys()) {
             visit(root);
         }
@@ -1141,27 +1513,300 @@ public:
         }
     }
 
+    // Traces cells until the work queue is empty (returns true) or the deadline has passed (returns false).
+    bool mark_live_cells_until(MonotonicTime deadline)
+    {
+        static constexpr size_t cells_between_deadline_checks = 256;
+        while (!m_work_queue.is_empty()) {
+            for (size_t i = 0; i < cells_between_deadline_checks && !m_work_queue.is_empty(); ++i)
+                m_work_queue.take_last()->visit_edges(*this);
+            if (MonotonicTime::now() >= deadline)
+                return m_work_queue.is_empty();
+        }
+        return true;
+    }
+
+    // Traces up to cell_count cells, and returns whether the work queue is empty.
+    bool mark_live_cells(size_t cell_count)
+    {
+        for (size_t i = 0; i < cell_count && !m_work_queue.is_empty(); ++i)
+            m_work_queue.take_last()->visit_edges(*this);
+        return m_work_queue.is_empty();
+    }
+
+    // Shades a cell that the mutator stored into the heap, or allocated, while marking incrementally.
+    void shade(Cell& cell) { visit_impl(cell); }
+
+    // Newly allocated cells are shaded even though they are already marked, so their constructor-initialized edges
+    // are still traced.
+    void shade_new_cell(Cell& cell)
+    {
+        cell.set_marked(true);
+        m_work_queue.append(cell);
+    }
+
 private:
-    ReadonlySpan<Heap* const> m_domain;
+    Vector<Heap*, 1> m_domain;
     Vector<Ref<Cell>> m_work_queue;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
+// State shared by the workers of a parallel mark phase. Every worker owns a mark stack that it publishes part of its
+// local work to; workers that run out of work steal half of another worker's published stack. Cells are claimed with
+// Cell::try_set_marked(), so every reachable cell is traced by exactly one worker.
+class ParallelMarkingState {
+    AK_MAKE_NONCOPYABLE(ParallelMarkingState);
+    AK_MAKE_NONMOVABLE(ParallelMarkingState);
+
+public:
+    struct MarkStack {
+        Sync::Mutex mutex;
+        Vector<Cell*> cells;
+        Atomic<size_t> size { 0 };
+    };
+
+    ParallelMarkingState(ReadonlySpan<Heap* const> domain, size_t worker_count)
+        : m_domain(domain)
+        , m_worker_count(worker_count)
+    {
+        m_min_block_address = explode_byte(0xff);
+        m_max_block_address = 0;
+        for (auto* heap : m_domain) {
+            FlatPtr min_block_address, max_block_address;
+            heap->find_min_and_max_block_addresses(min_block_address, max_block_address);
+            m_min_block_address = min(m_min_block_address, min_block_address);
+            m_max_block_address = max(m_max_block_address, max_block_address);
+        }
+        for (size_t i = 0; i < worker_count; ++i)
+            m_stacks.append(make<MarkStack>());
+    }
+
+    bool cell_is_in_domain(Cell const& cell) const
+    {
+        auto& heap = HeapBlockBase::from_cell(&cell)->heap();
+        for (auto* domain_heap : m_domain) {
+            if (domain_heap == &heap)
+                return true;
+        }
+        return false;
+    }
+
+    ReadonlySpan<Heap* const> domain() const { return m_domain; }
+    FlatPtr min_block_address() const { return m_min_block_address; }
+    FlatPtr max_block_address() const { return m_max_block_address; }
+    size_t worker_count() const { return m_worker_count; }
+
+    MarkStack& stack(size_t index) { return *m_stacks[index]; }
+
+    // Moves up to half of the published work of some worker (trying our own stack first) into `into`.
+    bool steal(size_t thief_index, Vector<Cell*>& into)
+    {
+        for (size_t offset = 0; offset < m_worker_count; ++offset) {
+            auto& victim = stack((thief_index + offset) % m_worker_count);
+            if (victim.size.load(AK::memory_order_relaxed) == 0)
+                continue;
+            Sync::MutexLocker locker(victim.mutex);
+            if (victim.cells.is_empty())
+                continue;
+            auto count = max<size_t>(victim.cells.size() / 2, 1);
+            auto first = victim.cells.size() - count;
+            into.append(victim.cells.data() + first, count);
+            victim.cells.shrink(first);
+            victim.size.store(victim.cells.size(), AK::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    // Called by a worker that has no local work and failed to steal. Returns true once every worker is idle and no
+    // published work remains, i.e. the mark phase is complete; returns false if there may be work to steal.
+    bool wait_for_work_or_termination()
+    {
+        m_idle_workers.fetch_add(1);
+        while (true) {
+            bool any_published_work = false;
+            for (auto& published : m_stacks) {
+                if (published->size.load() != 0) {
+                    any_published_work = true;
+                    break;
+                }
+            }
+            if (any_published_work) {
+                m_idle_workers.fetch_sub(1);
+                return false;
+            }
+            if (m_idle_workers.load() == m_worker_count)
+                return true;
+            AK::atomic_pause();
+        }
+    }
+
+private:
+    ReadonlySpan<Heap* const> m_domain;
+    size_t m_worker_count { 0 };
+    Vector<NonnullOwnPtr<MarkStack>> m_stacks;
+    Atomic<size_t> m_idle_workers { 0 };
+    FlatPtr m_min_block_address { 0 };
+    FlatPtr m_max_block_address { 0 };
+};
+
+class ParallelMarkingVisitor final : public Cell::Visitor {
+public:
+    // Once the local stack grows past this many cells, half of it is published for other workers to steal.
+    static constexpr size_t PUBLISH_THRESHOLD = 256;
+
+    ParallelMarkingVisitor(ParallelMarkingState& state, size_t index)
+        : m_state(state)
+        , m_index(index)
+    {
+    }
+
+    void add_root(Cell& cell)
+    {
+        if (!m_state.cell_is_in_domain(cell))
+            return;
+        if (!cell.try_set_marked())
+            return;
+        m_local.append(&cell);
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        if (!m_state.cell_is_in_domain(cell))
+            return;
+        if (!cell.try_set_marked())
+            return;
+        dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
+        push(cell);
+    }
+
+    virtual void visit_impl(ReadonlySpan<NanBoxedValue> values) override
+    {
+        for (auto value : values) {
+            if (!value.is_cell())
+                continue;
+            visit_impl(value.as_cell());
+        }
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        HashMap<FlatPtr, HeapRoot> possible_pointers;
+
+        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_state.min_block_address(), m_state.max_block_address());
+
+        for (auto* heap : m_state.domain()) {
+            for_each_cell_among_possible_pointers(heap->m_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+                if (cell->state() != Cell::State::Live)
+                    return;
+                if (!cell->try_set_marked())
+                    return;
+                push(*cell);
+            });
+        }
+    }
+
+    void mark_all_live_cells()
+    {
+        while (true) {
+            while (!m_local.is_empty())
+                m_local.take_last()->visit_edges(*this);
+            if (m_state.steal(m_index, m_local))
+                continue;
+            if (m_state.wait_for_work_or_termination())
+                return;
+        }
+    }
+
+private:
+    void push(Cell& cell)
+    {
+        m_local.append(&cell);
+        if (m_local.size() < PUBLISH_THRESHOLD)
+            return;
+
+        // Only publish when our stack has been drained, so the lock is mostly uncontended.
+        auto& published = m_state.stack(m_index);
+        if (published.size.load(AK::memory_order_relaxed) != 0)
+            return;
+        Sync::MutexLocker locker(published.mutex);
+        auto count = m_local.size() / 2;
+        published.cells.append(m_local.data(), count);
+        m_local.remove(0, count);
+        published.size.store(published.cells.size(), AK::memory_order_relaxed);
+    }
+
+    ParallelMarkingState& m_state;
+    size_t m_index { 0 };
+    Vector<Cell*> m_local;
+};
+
 void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
 {
     Heap* domain[] = { this };
     mark_live_cells_across(domain, roots);
 }
 
-void Heap::mark_live_cells_across(ReadonlySpan<Heap* const> heaps, HashMap<Cell*, HeapRoot> const& roots)
+static void mark_live_cells_in_parallel(ReadonlySpan<Heap* const> heaps, HashMap<Cell*, HeapRoot> const& roots, size_t worker_count)
 {
-    dbgln_if(HEAP_DEBUG, "mark_live_cells:");
+    ParallelMarkingState state(heaps, worker_count);
+    Vector<NonnullOwnPtr<ParallelMarkingVisitor>> visitors;
+    for (size_t i = 0; i < worker_count; ++i)
+        visitors.append(make<ParallelMarkingVisitor>(state, i));
 
+    {
+        ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_initial_visit_us };
+        size_t next_worker = 0;
+        for (auto* root : roots.keys()) {
+            visitors[next_worker]->add_root(*root);
+            next_worker = (next_worker + 1) % worker_count;
+        }
+    }
+
+    ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_bfs_us };
+    if (g_recording_phase_timings)
+        g_phase_timings.mark_worker_us.resize(worker_count);
+
+    auto run_worker = [&](size_t index) {
+        Core::ElapsedTimer worker_timer { Core::TimerType::Precise };
+        worker_timer.start();
+        visitors[index]->mark_all_live_cells();
+        if (g_recording_phase_timings)
+            g_phase_timings.mark_worker_us[index] = worker_timer.elapsed_time().to_microseconds();
+    };
+
+    // The collecting thread acts as worker 0.
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 1; i < worker_count; ++i) {
+        auto thread = Threading::Thread::construct(ByteString::formatted("GC Mark/{}", i), [&run_worker, i]() -> intptr_t {
+            run_worker(i);
+            return 0;
+        });
+        thread->start();
+        threads.append(move(thread));
+    }
+    run_worker(0);
+    for (auto& thread : threads)
+        (void)thread->join();
+}
+
+void Heap::mark_young_generation(HashMap<Cell*, HeapRoot> const& roots)
+{
+    dbgln_if(HEAP_DEBUG, "mark_young_generation: {} remembered cells", m_remembered_cells.size());
+
+    // Old cells are still marked, so tracing stops at them. Edges from old to young cells are found through the
+    // remembered set, whose cells are re-traced even though they are marked.
+    Heap* domain[] = { this };
     Optional<MarkingVisitor> visitor;
     {
         ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_initial_visit_us };
-        visitor.emplace(heaps, roots);
+        visitor.emplace(domain, roots);
+        for (auto* cell : m_remembered_cells)
+            cell->visit_edges(*visitor);
+        m_remembered_cells.clear();
     }
 
     {
@@ -1169,6 +1814,37 @@ void Heap::mark_live_cells_across(ReadonlySpan<Heap* const> heaps, HashMap<Cell*
         visitor->mark_all_live_cells();
     }
 
+    {
+        ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_clear_uprooted_us };
+        for (auto& inverse_root : m_uprooted_cells)
+            inverse_root->set_marked(false);
+        m_uprooted_cells.clear();
+    }
+}
+
+void Heap::mark_live_cells_across(ReadonlySpan<Heap* const> heaps, HashMap<Cell*, HeapRoot> const& roots)
+{
+    dbgln_if(HEAP_DEBUG, "mark_live_cells:");
+
+    size_t worker_count = 1;
+    for (auto* heap : heaps)
+        worker_count = max(worker_count, heap->m_marking_thread_count);
+
+    if (worker_count > 1) {
+        mark_live_cells_in_parallel(heaps, roots, worker_count);
+    } else {
+        Optional<MarkingVisitor> visitor;
+        {
+            ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_initial_visit_us };
+            visitor.emplace(heaps, roots);
+        }
+
+        {
+            ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_bfs_us };
+            visitor->mark_all_live_cells();
+        }
+    }
+
     {
         ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_clear_uprooted_us };
         for (auto* heap : heaps) {
@@ -1220,20 +1896,22 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
     size_t live_external_bytes = 0;
+    auto sweep_start_time = MonotonicTime::now();
 
     {
         ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.sweep_block_iteration_us };
         for_each_block([&](auto& block) {
             bool block_has_live_cells = false;
             bool block_was_full = block.is_full();
+            size_t block_collected_cells = 0;
             block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
                 if (!cell->is_marked()) {
                     dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
                     block.deallocate(cell);
-                    ++collected_cells;
-                    collected_cell_bytes += block.cell_size();
+                    ++block_collected_cells;
                 } else {
-                    cell->set_marked(false);
+                    if (!m_generational_collection_enabled)
+                        cell->set_marked(false);
                     block_has_live_cells = true;
                     ++live_cells;
                     live_cell_bytes += block.cell_size();
@@ -1243,6 +1921,9 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
                         : live_external_bytes + cell_external_memory_size;
                 }
             });
+            collected_cells += block_collected_cells;
+            collected_cell_bytes += block_collected_cells * block.cell_size();
+            block.cell_allocator().m_bytes_freed_in_current_collection += block_collected_cells * block.cell_size();
             if (!block_has_live_cells)
                 empty_blocks.append(&block);
             else if (block_was_full != block.is_full())
@@ -1271,9 +1952,11 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         });
     }
 
+    m_pending_collection_statistics.sweep_time += MonotonicTime::now() - sweep_start_time;
+
     {
         ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.sweep_update_threshold_us };
-        update_gc_bytes_threshold(live_cell_bytes, live_external_bytes);
+        did_finish_sweep(live_cell_bytes, live_external_bytes);
     }
 
     if (print_report) {
@@ -1309,7 +1992,9 @@ void Heap::sweep_block(HeapBlock& block)
             block.deallocate(cell);
             ++collected_cells;
         } else {
-            cell->set_marked(false);
+            // In generational mode the mark bit stays set: it is what makes the cell old.
+            if (!m_generational_collection_enabled)
+                cell->set_marked(false);
             block_has_live_cells = true;
             m_sweep_live_cell_bytes += block.cell_size();
             auto cell_external_memory_size = cell->external_memory_size();
@@ -1320,6 +2005,8 @@ void Heap::sweep_block(HeapBlock& block)
         }
     });
 
+    block.cell_allocator().m_bytes_freed_in_current_collection += collected_cells * block.cell_size();
+
     if (!block_has_live_cells) {
         dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", &block, block.cell_size());
         dbgln_if(INCREMENTAL_SWEEP_DEBUG, "[sweep] Block @ {} freed ({} cells collected)",
@@ -1396,7 +2083,7 @@ void Heap::start_incremental_sweep()
 
 void Heap::finish_incremental_sweep()
 {
-    update_gc_bytes_threshold(m_sweep_live_cell_bytes, m_sweep_live_external_bytes);
+    did_finish_sweep(m_sweep_live_cell_bytes, m_sweep_live_external_bytes);
 
     dbgln_if(INCREMENTAL_SWEEP_DEBUG, "[sweep] === Sweep complete ===");
     dbgln_if(INCREMENTAL_SWEEP_DEBUG, "[sweep]     Live cell bytes: {} ({} KiB)", m_sweep_live_cell_bytes, m_sweep_live_cell_bytes / KiB);
@@ -1405,7 +2092,8 @@ void Heap::finish_incremental_sweep()
     print_incremental_sweep_report(m_sweep_live_cell_bytes, m_sweep_live_external_bytes, m_gc_bytes_threshold);
 
     // Clear marks on cells allocated during sweep. Sweep already cleared
-    // marks on cells it visited, so only these remain marked.
+    // marks on cells it visited, so only these remain marked. In generational
+    // mode this makes them young.
     for (auto cell : m_cells_allocated_during_sweep)
         cell->set_marked(false);
     m_cells_allocated_during_sweep.clear();
@@ -1430,6 +2118,7 @@ void Heap::finish_pending_incremental_sweep()
         if (sweep_next_block()) {
             auto elapsed = MonotonicTime::now() - start_time;
             record_incremental_sweep_batch(blocks_swept, elapsed.to_microseconds(), true);
+            m_pending_collection_statistics.sweep_time += elapsed;
             finish_incremental_sweep();
             break;
         }
@@ -1469,6 +2158,7 @@ void Heap::sweep_on_timer()
         if (sweep_next_block()) {
             auto elapsed = MonotonicTime::now() - start_time;
             record_incremental_sweep_batch(blocks_swept, elapsed.to_microseconds(), false);
+            m_pending_collection_statistics.sweep_time += elapsed;
             finish_incremental_sweep();
             finished_sweep = true;
             break;
@@ -1479,6 +2169,7 @@ void Heap::sweep_on_timer()
     if (blocks_swept > 0 && !finished_sweep) {
         auto elapsed = MonotonicTime::now() - start_time;
         record_incremental_sweep_batch(blocks_swept, elapsed.to_microseconds(), false);
+        m_pending_collection_statistics.sweep_time += elapsed;
         dbgln_if(INCREMENTAL_SWEEP_DEBUG, "[sweep] Timer slice: {} blocks in {}ms",
             blocks_swept, elapsed.to_milliseconds());
     }
@@ -1497,9 +2188,9 @@ void Heap::start_idle_gc_timer()
 
 void Heap::idle_gc_on_timer()
 {
-    // Leave an in-progress incremental sweep alone; it is already reclaiming memory. A GC deferral means now is not a
-    // safe time to collect. In both cases we reconsider on the next tick.
-    if (m_incremental_sweep_active || is_gc_deferred())
+    // Leave an in-progress incremental sweep or mark alone; it is already reclaiming memory. A GC deferral means now
+    // is not a safe time to collect. In all cases we reconsider on the next tick.
+    if (m_incremental_sweep_active || m_incremental_marking_active || is_gc_deferred())
         return;
 
     switch (m_idle_collection_policy.evaluate(m_total_allocated_bytes, m_allocated_bytes_since_last_gc, m_gc_bytes_threshold)) {
@@ -1510,13 +2201,200 @@ void Heap::idle_gc_on_timer()
         m_idle_gc_timer->stop();
         return;
     case IdleCollectionPolicy::Decision::Collect:
+        if (m_incremental_marking_enabled && !m_generational_collection_enabled && !m_group) {
+            m_idle_gc_timer->stop();
+            start_incremental_marking();
+            return;
+        }
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(CollectionType::CollectGarbage, false, CollectionTrigger::IdlePolicy);
         m_idle_gc_timer->stop();
         return;
     }
 }
 
+void Heap::did_receive_memory_pressure(Core::MemoryPressureLevel level)
+{
+    if (level == Core::MemoryPressureLevel::Normal || m_collecting_garbage)
+        return;
+
+    // Leave an in-progress incremental mark to finish on its own timer, and never collect while GC is deferred.
+    if (!m_incremental_marking_active && !is_gc_deferred()) {
+        // Use the same gate as the idle policy's rate-drop trigger, so a warning on a heap with little garbage costs
+        // nothing more than the decommit below.
+        bool enough_garbage = m_allocated_bytes_since_last_gc >= m_gc_bytes_threshold / IdleCollectionPolicy::min_garbage_divisor;
+        if (level == Core::MemoryPressureLevel::Critical || enough_garbage) {
+            m_allocated_bytes_since_last_gc = 0;
+            collect_garbage(CollectionType::CollectGarbage, false, CollectionTrigger::MemoryPressure);
+            if (m_idle_gc_timer)
+                m_idle_gc_timer->stop();
+        }
+    }
+
+    // Hand blocks freed by the sweep back to the block allocator before we decommit.
+    finish_pending_incremental_sweep();
+    CellAllocator::shared_block_allocator().decommit_free_blocks_now();
+}
+
+void Heap::start_incremental_marking()
+{
+    begin_incremental_marking();
+
+    if (!m_incremental_marking_timer) {
+        m_incremental_marking_timer = Core::Timer::create_repeating(GC_INCREMENTAL_MARK_INTERVAL_MS, [this] {
+            mark_on_timer();
+        });
+    }
+    m_incremental_marking_timer->start();
+}
+
+void Heap::start_incremental_marking_for_testing()
+{
+    begin_incremental_marking();
+}
+
+bool Heap::mark_incrementally_for_testing(size_t cell_count)
+{
+    VERIFY(m_incremental_marking_active);
+    return m_incremental_marking_visitor->mark_live_cells(cell_count);
+}
+
+void Heap::begin_incremental_marking()
+{
+    VERIFY(!m_incremental_marking_active);
+    VERIFY(!m_incremental_sweep_active);
+
+    dbgln_if(INCREMENTAL_MARK_DEBUG, "[mark] === Starting incremental mark ===");
+
+    // The initial root scan is stop-the-world; the rest of the heap is traced in slices from mark_on_timer(). Roots
+    // that change in the meantime are picked up by the final root scan in finish_incremental_marking().
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+
+    Heap* domain[] = { this };
+    m_incremental_marking_visitor = make<MarkingVisitor>(domain, roots);
+    m_incremental_marking_active = true;
+    g_write_barrier_heap_count.fetch_add(1);
+}
+
+void Heap::finish_incremental_marking(HashMap<Cell*, HeapRoot> const& roots)
+{
+    VERIFY(m_incremental_marking_active);
+
+    if (m_incremental_marking_timer)
+        m_incremental_marking_timer->stop();
+
+    // Anything the mutator stored through a write barrier is already grey, so re-scanning the roots and draining the
+    // work queue completes the mark.
+    {
+        ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_initial_visit_us };
+        m_incremental_marking_visitor->visit_roots(roots);
+    }
+    {
+        ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_bfs_us };
+        m_incremental_marking_visitor->mark_all_live_cells();
+    }
+
+    m_incremental_marking_active = false;
+    g_write_barrier_heap_count.fetch_sub(1);
+    m_incremental_marking_visitor = nullptr;
+
+    {
+        ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_clear_uprooted_us };
+        for (auto& inverse_root : m_uprooted_cells)
+            inverse_root->set_marked(false);
+        m_uprooted_cells.clear();
+    }
+
+    dbgln_if(INCREMENTAL_MARK_DEBUG, "[mark] === Incremental mark complete ===");
+}
+
+void Heap::abort_incremental_marking()
+{
+    if (!m_incremental_marking_active)
+        return;
+
+    dbgln_if(INCREMENTAL_MARK_DEBUG, "[mark] Aborting incremental mark");
+
+    if (m_incremental_marking_timer)
+        m_incremental_marking_timer->stop();
+    m_incremental_marking_active = false;
+    g_write_barrier_heap_count.fetch_sub(1);
+    m_incremental_marking_visitor = nullptr;
+    m_pending_collection_statistics.mark_time = {};
+
+    // Drop the partial marks so the next mark phase starts from all-white.
+    clear_all_marks();
+}
+
+void Heap::mark_on_timer()
+{
+    if (!m_incremental_marking_active || is_gc_deferred())
+        return;
+
+    auto start_time = MonotonicTime::now();
+    auto deadline = start_time + AK::Duration::from_milliseconds(GC_INCREMENTAL_MARK_SLICE_MS);
+    bool finished = m_incremental_marking_visitor->mark_live_cells_until(deadline);
+    auto elapsed = MonotonicTime::now() - start_time;
+    m_pending_collection_statistics.mark_time += elapsed;
+
+    dbgln_if(INCREMENTAL_MARK_DEBUG, "[mark] Timer slice: {}us{}", elapsed.to_microseconds(), finished ? " (done)"sv : ""sv);
+
+    if (finished) {
+        m_allocated_bytes_since_last_gc = 0;
+        collect_garbage(CollectionType::CollectGarbage, false, CollectionTrigger::IdlePolicy);
+    }
+}
+
+void Heap::did_allocate_cell_during_incremental_marking(Cell& cell)
+{
+    m_incremental_marking_visitor->shade_new_cell(cell);
+}
+
+void Heap::remember_slot_pointing_to_young_cell(void const* slot)
+{
+    auto address = bit_cast<FlatPtr>(slot);
+    // The stack is scanned on every collection, so stores into locals need no remembering.
+    if (address >= m_stack_info.base() && address < m_stack_info.top())
+        return;
+
+    auto* owner_block = HeapBlock::from_cell(static_cast<Cell const*>(slot));
+    if (!is_live_heap_block(owner_block)) {
+        // The slot lives outside the GC heap (e.g. in a Vector owned by some cell), so we cannot tell which cell
+        // holds the edge. Fall back to tracing everything next time.
+        m_next_collection_must_be_major = true;
+        return;
+    }
+
+    auto* owner = owner_block->cell_from_possible_pointer(address);
+    if (!owner || owner->state() != Cell::State::Live || !owner->is_marked())
+        return;
+    m_remembered_cells.set(owner);
+}
+
+void write_barrier_slow(void const* slot, void const* stored_cell)
+{
+    auto* block = HeapBlock::from_cell(static_cast<Cell const*>(stored_cell));
+    auto& heap = block->heap();
+    if (heap.m_collecting_garbage)
+        return;
+    if (!heap.m_incremental_marking_active && !heap.m_generational_collection_enabled)
+        return;
+    if (!heap.is_live_heap_block(block))
+        return;
+
+    // The stored pointer may point at a base class subobject rather than the start of the cell.
+    auto* cell = block->cell_from_possible_pointer(bit_cast<FlatPtr>(stored_cell));
+    if (!cell || cell->state() != Cell::State::Live || cell->is_marked())
+        return;
+
+    if (heap.m_incremental_marking_active) {
+        heap.m_incremental_marking_visitor->shade(*cell);
+        return;
+    }
+    heap.remember_slot_pointing_to_young_cell(slot);
+}
+
 void Heap::defer_gc()
 {
     ++m_gc_deferrals;
@@ -1529,8 +2407,9 @@ void Heap::undefer_gc()
 
     if (!m_gc_deferrals) {
         if (m_should_gc_when_deferral_ends)
-            collect_garbage();
+            collect_garbage(CollectionType::CollectGarbage, false, m_deferred_collection_trigger);
         m_should_gc_when_deferral_ends = false;
+        m_deferred_collection_trigger = CollectionTrigger::Explicit;
     }
 }
 
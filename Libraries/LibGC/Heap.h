@@ -7,13 +7,16 @@
 #pragma once
 
 #include <AK/Badge.h>
+#include <AK/CircularQueue.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/String.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -36,6 +39,8 @@
 
 namespace GC {
 
+class MarkingVisitor;
+
 struct StackFrameInfo {
     String label;
     size_t size_bytes { 0 };
@@ -73,6 +78,10 @@ public:
             cell->set_marked(true);
             m_cells_allocated_during_sweep.append(cell);
         }
+        // Cells allocated during incremental marking are shaded grey: their
+        // constructors store edges without going through the write barrier.
+        if (m_incremental_marking_active) [[unlikely]]
+            did_allocate_cell_during_incremental_marking(*cell);
         undefer_gc();
         return *cell;
     }
@@ -80,14 +89,100 @@ public:
     enum class CollectionType {
         CollectGarbage,
         CollectEverything,
+        // Only traces cells allocated since the previous collection. Becomes a full collection unless generational
+        // collection is enabled and the old generation is still within its threshold.
+        CollectYoungGeneration,
+    };
+
+    enum class CollectionTrigger {
+        Explicit,
+        AllocationThreshold,
+        ExternalMemory,
+        IdlePolicy,
+        MemoryPressure,
     };
 
-    void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
+    void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false, CollectionTrigger = CollectionTrigger::Explicit);
     AK::JsonObject dump_graph();
 
+    // Responds to the system running low on memory. Collects if enough garbage has piled up to be worth it (always, when
+    // critical), then returns free heap blocks to the OS right away instead of waiting for the decommit worker.
+    void did_receive_memory_pressure(Core::MemoryPressureLevel);
+
+    // Writes the same graph as dump_graph() as newline-delimited JSON records ("stack_frame", "root" and "node"),
+    // one cell at a time. Runs a collection first. Extra memory is bounded by the root set rather than the edge count.
+    ErrorOr<void> write_graph_snapshot(Stream&);
+
+    // What a single collection cost, from gathering its roots until its (possibly incremental) sweep finished.
+    struct CollectionStatistics {
+        struct FreedBytes {
+            Optional<StringView> class_name;
+            size_t cell_size { 0 };
+            size_t bytes { 0 };
+        };
+
+        u64 sequence_number { 0 };
+        CollectionType type { CollectionType::CollectGarbage };
+        CollectionTrigger trigger { CollectionTrigger::Explicit };
+        size_t root_count { 0 };
+        size_t conservative_root_count { 0 };
+        AK::Duration mark_time;
+        AK::Duration sweep_time;
+        size_t freed_bytes { 0 };
+        Vector<FreedBytes> freed_bytes_by_allocator;
+    };
+
+    static constexpr size_t collection_statistics_history_size = 32;
+    CircularQueue<CollectionStatistics, collection_statistics_history_size> const& collection_statistics() const { return m_collection_statistics; }
+    u64 collection_count() const { return m_collection_count; }
+    u64 total_allocated_bytes() const { return m_total_allocated_bytes; }
+    AK::JsonArray dump_collection_statistics() const;
+
+    // What the cells of one allocator currently hold on to. Cells that died since the last collection count as live
+    // until they are swept, since their memory is still in use.
+    struct AllocatorStatistics {
+        Optional<StringView> class_name;
+        size_t cell_size { 0 };
+        size_t block_count { 0 };
+        size_t live_cell_count { 0 };
+        size_t external_bytes { 0 };
+    };
+
+    // Walks every heap block, so this costs about as much as a sweep.
+    Vector<AllocatorStatistics> allocator_statistics();
+
+    // Called once a collection's sweep has finished. This can run in the middle of collect_garbage(), so the callback
+    // must not allocate GC cells.
+    Function<void(CollectionStatistics const&)> on_collection_finished;
+
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
 
     void set_incremental_sweep_enabled(bool enabled) { m_incremental_sweep_enabled = enabled; }
+
+    // When enabled, idle-triggered collections mark the heap in bounded slices on a timer instead of stopping the
+    // world for the whole mark phase; the final slice re-scans the roots and finishes the collection. This relies on
+    // every heap store of a cell pointer going through write_barrier() (GC::Ptr, GC::Ref and JS::Object property
+    // storage do), so it is off by default.
+    void set_incremental_marking_enabled(bool enabled) { m_incremental_marking_enabled = enabled; }
+    bool is_incremental_marking_active() const { return m_incremental_marking_active; }
+
+    // Lets tests run an incremental mark one step at a time instead of in slices on the marking timer. Each step traces
+    // up to cell_count cells and returns whether the mark has run out of work; collect_garbage() finishes the mark.
+    void start_incremental_marking_for_testing();
+    bool mark_incrementally_for_testing(size_t cell_count);
+
+    // When enabled, cells that survive a collection keep their mark bit and become old. Allocation-driven collections
+    // then only trace young cells, plus old cells that the write barrier recorded as pointing at young cells, and a
+    // full collection only runs once the old generation outgrows the regular threshold. Like incremental marking this
+    // depends on the write barrier seeing every heap store, so it is off by default.
+    void set_generational_collection_enabled(bool);
+    bool is_generational_collection_enabled() const { return m_generational_collection_enabled; }
+
+    // Number of threads that trace the heap during the mark phase. 1 keeps marking on the collecting thread.
+    // Defaults to LIBGC_MARKING_THREADS if set. Every visit_edges() reachable from this heap must be safe to run
+    // concurrently with other visit_edges() calls before this is raised.
+    void set_marking_thread_count(size_t count) { m_marking_thread_count = max<size_t>(count, 1); }
+    size_t marking_thread_count() const { return m_marking_thread_count; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
     void did_create_root(Badge<RootImpl>, RootImpl&);
@@ -140,8 +235,12 @@ private:
     friend class CellAllocator;
     friend class HeapBlock;
     friend class MarkingVisitor;
+    friend class ParallelMarkingState;
+    friend class ParallelMarkingVisitor;
     friend class GraphConstructorVisitor;
+    friend class SnapshotEdgeVisitor;
     friend class DeferGC;
+    friend void write_barrier_slow(void const*);
 
     void defer_gc();
     void undefer_gc();
@@ -159,8 +258,12 @@ private:
         return T::cell_allocator.for_heap(*this).allocate_cell(*this);
     }
 
-    void will_allocate(size_t);
+    void will_allocate(size_t, CollectionTrigger = CollectionTrigger::AllocationThreshold);
     void update_gc_bytes_threshold(size_t live_cell_bytes, size_t live_external_bytes);
+    void did_finish_sweep(size_t live_cell_bytes, size_t live_external_bytes);
+    void clear_all_marks();
+    void begin_collection_statistics(CollectionType, CollectionTrigger, HashMap<Cell*, HeapRoot> const* roots);
+    void finish_collection_statistics();
 
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
     enum class IncludeIncomingCrossHeapMembers {
@@ -173,6 +276,8 @@ private:
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&, Vector<StackFrameInfo>* out_stack_frames = nullptr);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address, FlatPtr stack_reference, FlatPtr stack_top);
     void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_young_generation(HashMap<Cell*, HeapRoot> const& roots);
+    void remember_slot_pointing_to_young_cell(void const* slot);
     void finalize_unmarked_cells();
     void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
     void sweep_weak_blocks();
@@ -189,6 +294,13 @@ private:
     void start_idle_gc_timer();
     void idle_gc_on_timer();
 
+    void start_incremental_marking();
+    void begin_incremental_marking();
+    void finish_incremental_marking(HashMap<Cell*, HeapRoot> const& roots);
+    void abort_incremental_marking();
+    void mark_on_timer();
+    void did_allocate_cell_during_incremental_marking(Cell&);
+
     template<typename Callback>
     void for_each_block(Callback callback)
     {
@@ -199,6 +311,7 @@ private:
     }
 
     size_t m_gc_bytes_threshold { 0 };
+    size_t m_young_gc_bytes_threshold { 0 };
     size_t m_allocated_bytes_since_last_gc { 0 };
 
     bool m_should_collect_on_every_allocation { false };
@@ -217,12 +330,14 @@ private:
     HashTable<CrossHeapMemberBase*> m_incoming_cross_heap_members;
     HeapGroup* m_group { nullptr };
     bool m_incremental_sweep_enabled { true };
+    size_t m_marking_thread_count { 1 };
     WeakContainer::List m_weak_containers;
 
     Vector<Ptr<Cell>> m_uprooted_cells;
 
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
+    CollectionTrigger m_deferred_collection_trigger { CollectionTrigger::Explicit };
 
     bool m_collecting_garbage { false };
     StackInfo m_stack_info;
@@ -244,6 +359,21 @@ private:
     RefPtr<Core::Timer> m_incremental_sweep_timer;
 
     RefPtr<Core::Timer> m_idle_gc_timer;
+
+    bool m_incremental_marking_enabled { false };
+    bool m_incremental_marking_active { false };
+    OwnPtr<MarkingVisitor> m_incremental_marking_visitor;
+    RefPtr<Core::Timer> m_incremental_marking_timer;
+
+    bool m_generational_collection_enabled { false };
+    bool m_next_collection_must_be_major { true };
+    bool m_sweeping_young_generation { false };
+    HashTable<Cell*> m_remembered_cells;
+
+    u64 m_collection_count { 0 };
+    CollectionStatistics m_pending_collection_statistics;
+    CircularQueue<CollectionStatistics, collection_statistics_history_size> m_collection_statistics;
+
     u64 m_total_allocated_bytes { 0 };
     IdleCollectionPolicy m_idle_collection_policy;
 };
@@ -5,6 +5,7 @@
  */
 
 #include <AK/TemporaryChange.h>
+#include <AK/Time.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibGC/Heap.h>
 #include <LibGC/HeapGroup.h>
@@ -44,6 +45,12 @@ void HeapGroup::collect_garbage(bool print_report)
 
     for (auto* heap : m_heaps) {
         heap->finish_pending_incremental_sweep();
+        // Generational heaps keep survivors marked between collections; the group mark has to start from all-white.
+        if (heap->m_generational_collection_enabled) {
+            heap->clear_all_marks();
+            heap->m_remembered_cells.clear();
+            heap->m_next_collection_must_be_major = false;
+        }
         heap->m_collecting_garbage = true;
     }
     ScopeGuard unset_collecting = [&] {
@@ -55,7 +62,13 @@ void HeapGroup::collect_garbage(bool print_report)
     for (auto* heap : m_heaps)
         heap->gather_roots(roots, nullptr, Heap::IncludeIncomingCrossHeapMembers::No);
 
+    for (auto* heap : m_heaps)
+        heap->begin_collection_statistics(Heap::CollectionType::CollectGarbage, Heap::CollectionTrigger::Explicit, &roots);
+    auto mark_start_time = MonotonicTime::now();
     Heap::mark_live_cells_across(m_heaps, roots);
+    auto mark_time = MonotonicTime::now() - mark_start_time;
+    for (auto* heap : m_heaps)
+        heap->m_pending_collection_statistics.mark_time += mark_time;
 
     for (auto* heap : m_heaps)
         heap->run_post_mark_phases(print_report);
@@ -117,4 +117,13 @@ protected:
 
 static_assert(sizeof(NanBoxedValue) == sizeof(double));
 
+// Must be called whenever a value that may hold a GC cell is stored into `slot`. See write_barrier(void const*, void const*).
+ALWAYS_INLINE void write_barrier(void const* slot, NanBoxedValue const& value)
+{
+    if (g_write_barrier_heap_count.load(AK::memory_order_relaxed) == 0) [[likely]]
+        return;
+    if (value.is_cell())
+        write_barrier_slow(slot, &value.as_cell());
+}
+
 }
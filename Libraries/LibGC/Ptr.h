@@ -9,6 +9,7 @@
 #include <AK/Format.h>
 #include <AK/Traits.h>
 #include <AK/Types.h>
+#include <LibGC/WriteBarrier.h>
 
 namespace GC {
 
@@ -39,17 +40,28 @@ public:
     {
     }
 
+    Ref(Ref const&) = default;
+
+    Ref& operator=(Ref const& other)
+    {
+        write_barrier(this, other.m_ptr);
+        m_ptr = other.m_ptr;
+        return *this;
+    }
+
     template<typename U>
     Ref& operator=(Ref<U> const& other)
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other.ptr());
+        write_barrier(this, m_ptr);
         return *this;
     }
 
     Ref& operator=(T& other)
     {
         m_ptr = &other;
+        write_barrier(this, m_ptr);
         return *this;
     }
 
@@ -58,6 +70,7 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = &static_cast<T&>(other);
+        write_barrier(this, m_ptr);
         return *this;
     }
 
@@ -117,17 +130,28 @@ public:
     {
     }
 
+    Ptr(Ptr const&) = default;
+
+    Ptr& operator=(Ptr const& other)
+    {
+        write_barrier(this, other.m_ptr);
+        m_ptr = other.m_ptr;
+        return *this;
+    }
+
     template<typename U>
     Ptr& operator=(Ptr<U> const& other)
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other.ptr());
+        write_barrier(this, m_ptr);
         return *this;
     }
 
     Ptr& operator=(Ref<T> const& other)
     {
         m_ptr = other.ptr();
+        write_barrier(this, m_ptr);
         return *this;
     }
 
@@ -136,12 +160,14 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other.ptr());
+        write_barrier(this, m_ptr);
         return *this;
     }
 
     Ptr& operator=(T& other)
     {
         m_ptr = &other;
+        write_barrier(this, m_ptr);
         return *this;
     }
 
@@ -150,12 +176,14 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = &static_cast<T&>(other);
+        write_barrier(this, m_ptr);
         return *this;
     }
 
     Ptr& operator=(T* other)
     {
         m_ptr = other;
+        write_barrier(this, m_ptr);
         return *this;
     }
 
@@ -164,6 +192,13 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other);
+        write_barrier(this, m_ptr);
+        return *this;
+    }
+
+    Ptr& operator=(nullptr_t)
+    {
+        m_ptr = nullptr;
         return *this;
     }
 
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Platform.h>
+#include <AK/Types.h>
+#include <LibGC/Export.h>
+
+namespace GC {
+
+// Number of heaps that currently need the write barrier, i.e. that are marking incrementally or collecting
+// generationally. While this is zero, the write barrier is a single relaxed load.
+extern GC_API Atomic<u32> g_write_barrier_heap_count;
+
+GC_API void write_barrier_slow(void const* slot, void const* stored_cell);
+
+// Must be called whenever a pointer to a GC cell is stored into `slot`. The slot is either the field being written, or
+// any address inside the cell that owns the out-of-line storage being written (e.g. a JS::Object's property storage).
+// While the cell's heap is marking incrementally, an unmarked cell is shaded grey so that storing it into an
+// already-traced cell cannot hide it from the mark phase. While the heap collects generationally, an old cell that
+// now points at a young cell is added to the remembered set.
+ALWAYS_INLINE void write_barrier(void const* slot, void const* stored_cell)
+{
+    if (g_write_barrier_heap_count.load(AK::memory_order_relaxed) == 0) [[likely]]
+        return;
+    if (stored_cell)
+        write_barrier_slow(slot, stored_cell);
+}
+
+}
@@ -87,6 +87,8 @@ public:
 
     Matrix<4, float> to_matrix() const;
 
+    bool operator==(AffineTransform const&) const = default;
+
 private:
     float m_values[6] { 0 };
 };
@@ -14,6 +14,7 @@
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/TypefaceSkia.h>
 #include <LibGfx/TextLayout.h>
+#include <LibSync/MutexProtected.h>
 
 #if defined(USE_FONTCONFIG)
 #    include <LibGfx/Font/GlobalFontConfig.h>
@@ -30,6 +31,8 @@ namespace Gfx {
 
 static Atomic<u64> s_next_id { 1 };
 
+static Sync::MutexProtected<Font::List> s_all_fonts;
+
 Font::Font(NonnullRefPtr<Typeface const> typeface, float point_width, float point_height, FontVariationSettings const variations, ShapeFeatures const& features)
     : m_id(s_next_id.fetch_add(1, AK::MemoryOrder::memory_order_relaxed))
     , m_typeface(move(typeface))
@@ -53,6 +56,8 @@ Font::Font(NonnullRefPtr<Typeface const> typeface, float point_width, float poin
     metrics.descent = skMetrics.fDescent;
 
     m_pixel_metrics = metrics;
+
+    s_all_fonts.with_locked([&](auto& fonts) { fonts.append(*this); });
 }
 
 float Font::width(Utf16View const& view) const { return measure_text_width(view, *this); }
@@ -84,6 +89,7 @@ float Font::point_size() const
 
 Font::~Font()
 {
+    s_all_fonts.with_locked([&](auto& fonts) { fonts.remove(*this); });
     if (m_harfbuzz_font)
         hb_font_destroy(m_harfbuzz_font);
 }
@@ -193,10 +199,44 @@ Font::ShapingCache::~ShapingCache() = default;
 void Font::ShapingCache::clear()
 {
     map.clear();
+    previous_generation_map.clear();
     for (auto& slot : single_ascii_character_map)
         slot = nullptr;
 }
 
+void Font::clear_all_shaping_caches()
+{
+    s_all_fonts.with_locked([](auto& fonts) {
+        for (auto& font : fonts)
+            font.m_shaping_cache.clear();
+    });
+}
+
+Font::ShapingCacheStatistics Font::shaping_cache_statistics()
+{
+    ShapingCacheStatistics statistics;
+    s_all_fonts.with_locked([&](auto& fonts) {
+        for (auto& font : fonts) {
+            auto const& cache = font.m_shaping_cache;
+            statistics.hit_count += cache.hit_count;
+            statistics.miss_count += cache.miss_count;
+            auto add_entry = [&](ShapedGlyphs const& glyphs) {
+                ++statistics.entry_count;
+                statistics.byte_size += sizeof(ShapedGlyphs) + glyphs.glyphs.capacity() * sizeof(DrawGlyph);
+            };
+            for (auto const& it : cache.map)
+                add_entry(*it.value);
+            for (auto const& it : cache.previous_generation_map)
+                add_entry(*it.value);
+            for (auto const& slot : cache.single_ascii_character_map) {
+                if (slot)
+                    add_entry(*slot);
+            }
+        }
+    });
+    return statistics;
+}
+
 static bool hb_face_has_table(hb_face_t* face, hb_tag_t tag)
 {
     hb_blob_t* blob = hb_face_reference_table(face, tag);
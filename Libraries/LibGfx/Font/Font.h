@@ -12,6 +12,7 @@
 #include <AK/AtomicRefCounted.h>
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
@@ -105,15 +106,37 @@ public:
     FontVariationSettings const& variation_settings() const { return m_font_variation_settings; }
     ShapeFeatures const& features() const { return m_shape_features; }
 
+    // Shapes are looked up in the current generation first, then in the previous one, out of which a hit moves them.
+    // Once the current generation is full, it replaces the previous one. This approximates an LRU: only shapes that
+    // went unused for a whole generation are dropped, and a cache never holds more than two generations.
     struct ShapingCache {
+        static constexpr size_t max_entries_per_generation = 4096;
+
         HashMap<ShapingCacheKey, OwnPtr<ShapedGlyphs>> map;
+        HashMap<ShapingCacheKey, OwnPtr<ShapedGlyphs>> previous_generation_map;
         OwnPtr<ShapedGlyphs> single_ascii_character_map[128];
+        u64 hit_count { 0 };
+        u64 miss_count { 0 };
 
         ~ShapingCache();
         void clear();
     };
     ShapingCache& shaping_cache() const { return m_shaping_cache; }
 
+    // Empties the shaping cache of every live font, e.g. when the system is low on memory. Must be called on the
+    // thread that shapes text with these fonts.
+    static void clear_all_shaping_caches();
+
+    struct ShapingCacheStatistics {
+        u64 hit_count { 0 };
+        u64 miss_count { 0 };
+        size_t entry_count { 0 };
+        // The shaped glyphs only; cache keys mostly share their text with the strings that were shaped.
+        size_t byte_size { 0 };
+    };
+    // Sums up the shaping caches of every live font. Must be called on the thread that shapes text with these fonts.
+    static ShapingCacheStatistics shaping_cache_statistics();
+
     bool is_emoji_font() const;
 
 private:
@@ -144,6 +167,11 @@ private:
     FontPixelMetrics m_pixel_metrics;
 
     float m_pixel_size { 0.0f };
+
+    IntrusiveListNode<Font> m_all_fonts_list_node;
+
+public:
+    using List = IntrusiveList<&Font::m_all_fonts_list_node>;
 };
 
 }
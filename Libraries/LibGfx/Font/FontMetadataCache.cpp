@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <AK/LexicalPath.h>
+#include <AK/MemoryStream.h>
+#include <AK/QuickSort.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
+#include <LibGfx/Font/FontMetadataCache.h>
+
+namespace Gfx {
+
+static constexpr u32 FONT_METADATA_CACHE_MAGIC = 0x434d464c; // "LFMC"
+static constexpr u32 FONT_METADATA_CACHE_VERSION = 1;
+
+struct DirectoryModificationTime {
+    String path;
+    i64 modified_time { 0 };
+
+    bool operator==(DirectoryModificationTime const&) const = default;
+};
+
+static ByteString font_metadata_cache_path(StringView root_path)
+{
+#if defined(AK_OS_WINDOWS)
+    // NB: The cache directory already belongs to Ladybird on Windows.
+    auto directory = LexicalPath::join(Core::StandardPaths::cache_directory(), "FontMetadata"sv);
+#else
+    auto directory = LexicalPath::join(Core::StandardPaths::cache_directory(), "Ladybird"sv, "FontMetadata"sv);
+#endif
+    return directory.append(ByteString::formatted("{:08x}.cache", root_path.hash())).string();
+}
+
+// NB: The directories are visited in the same order every time, so that the lists can be compared as they are.
+static ErrorOr<void> collect_directory_modification_times(StringView path, Vector<DirectoryModificationTime>& modification_times)
+{
+    auto st = TRY(Core::System::stat(path));
+    modification_times.append({ TRY(String::from_utf8(path)), static_cast<i64>(st.st_mtime) });
+
+    Vector<ByteString> subdirectories;
+    Core::DirIterator iterator { path, Core::DirIterator::SkipDots };
+    while (auto entry = iterator.next()) {
+        auto is_directory = entry->type == Core::DirectoryEntry::Type::Directory;
+        if (entry->type == Core::DirectoryEntry::Type::SymbolicLink || entry->type == Core::DirectoryEntry::Type::Unknown) {
+            auto entry_path = LexicalPath::join(path, entry->name).string();
+            if (auto entry_st = Core::System::stat(entry_path); !entry_st.is_error())
+                is_directory = S_ISDIR(entry_st.value().st_mode);
+        }
+        if (is_directory)
+            subdirectories.append(entry->name);
+    }
+    if (iterator.has_error())
+        return iterator.error();
+
+    quick_sort(subdirectories);
+    for (auto const& subdirectory : subdirectories)
+        TRY(collect_directory_modification_times(LexicalPath::join(path, subdirectory).string(), modification_times));
+    return {};
+}
+
+static ErrorOr<void> write_string(Stream& stream, StringView string)
+{
+    TRY(stream.write_value<LittleEndian<u32>>(string.length()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<String> read_string(Stream& stream)
+{
+    auto length = TRY(stream.read_value<LittleEndian<u32>>());
+    return String::from_stream(stream, length);
+}
+
+static ErrorOr<Vector<FontMetadata>> read_font_metadata(ReadonlyBytes bytes, StringView root_path, Vector<DirectoryModificationTime> const& modification_times)
+{
+    FixedMemoryStream stream { bytes };
+
+    if (TRY(stream.read_value<LittleEndian<u32>>()) != FONT_METADATA_CACHE_MAGIC)
+        return Error::from_string_literal("Font metadata cache has the wrong magic");
+    if (TRY(stream.read_value<LittleEndian<u32>>()) != FONT_METADATA_CACHE_VERSION)
+        return Error::from_string_literal("Font metadata cache has the wrong version");
+
+    // NB: Files are named by the hash of their root, so the root has to be checked as well.
+    if (TRY(read_string(stream)) != root_path)
+        return Error::from_string_literal("Font metadata cache belongs to another root");
+
+    auto directory_count = TRY(stream.read_value<LittleEndian<u32>>());
+    if (directory_count != modification_times.size())
+        return Error::from_string_literal("Font directories have been added or removed");
+    for (auto const& modification_time : modification_times) {
+        DirectoryModificationTime cached_modification_time;
+        cached_modification_time.path = TRY(read_string(stream));
+        cached_modification_time.modified_time = TRY(stream.read_value<LittleEndian<i64>>());
+        if (cached_modification_time != modification_time)
+            return Error::from_string_literal("Font directories have been modified");
+    }
+
+    auto font_count = TRY(stream.read_value<LittleEndian<u32>>());
+    Vector<FontMetadata> fonts;
+    TRY(fonts.try_ensure_capacity(font_count));
+    for (u32 i = 0; i < font_count; ++i) {
+        FontMetadata font;
+        font.path = TRY(read_string(stream));
+        font.ttc_index = TRY(stream.read_value<LittleEndian<u32>>());
+        font.family = TRY(read_string(stream));
+        font.weight = TRY(stream.read_value<LittleEndian<u16>>());
+        font.width = TRY(stream.read_value<LittleEndian<u16>>());
+        font.slope = TRY(stream.read_value<u8>());
+        fonts.unchecked_append(move(font));
+    }
+    return fonts;
+}
+
+static ErrorOr<void> write_font_metadata(StringView root_path, ReadonlySpan<FontMetadata> fonts)
+{
+    Vector<DirectoryModificationTime> modification_times;
+    TRY(collect_directory_modification_times(root_path, modification_times));
+
+    AllocatingMemoryStream stream;
+    TRY(stream.write_value<LittleEndian<u32>>(FONT_METADATA_CACHE_MAGIC));
+    TRY(stream.write_value<LittleEndian<u32>>(FONT_METADATA_CACHE_VERSION));
+    TRY(write_string(stream, root_path));
+
+    TRY(stream.write_value<LittleEndian<u32>>(modification_times.size()));
+    for (auto const& modification_time : modification_times) {
+        TRY(write_string(stream, modification_time.path));
+        TRY(stream.write_value<LittleEndian<i64>>(modification_time.modified_time));
+    }
+
+    TRY(stream.write_value<LittleEndian<u32>>(fonts.size()));
+    for (auto const& font : fonts) {
+        TRY(write_string(stream, font.path));
+        TRY(stream.write_value<LittleEndian<u32>>(font.ttc_index));
+        TRY(write_string(stream, font.family));
+        TRY(stream.write_value<LittleEndian<u16>>(font.weight));
+        TRY(stream.write_value<LittleEndian<u16>>(font.width));
+        TRY(stream.write_value<u8>(font.slope));
+    }
+
+    auto cache_path = LexicalPath { font_metadata_cache_path(root_path) };
+    TRY(Core::Directory::create(cache_path.parent(), Core::Directory::CreateDirectories::Yes));
+
+    // NB: Other processes may be reading the cache, or writing it themselves, so a complete file is moved into place
+    //     rather than writing to the cache itself.
+    auto temporary_path = ByteString::formatted("{}.{}", cache_path.string(), Core::System::getpid());
+    {
+        auto contents = TRY(stream.read_until_eof());
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(contents));
+    }
+    if (auto result = Core::System::rename(temporary_path, cache_path.string()); result.is_error()) {
+        (void)Core::System::unlink(temporary_path);
+        return result.release_error();
+    }
+    return {};
+}
+
+Optional<Vector<FontMetadata>> load_cached_font_metadata(StringView root_path)
+{
+    auto file = Core::MappedFile::map(font_metadata_cache_path(root_path));
+    if (file.is_error())
+        return {};
+
+    Vector<DirectoryModificationTime> modification_times;
+    if (collect_directory_modification_times(root_path, modification_times).is_error())
+        return {};
+
+    auto fonts = read_font_metadata(file.value()->bytes(), root_path, modification_times);
+    if (fonts.is_error())
+        return {};
+    return fonts.release_value();
+}
+
+void store_cached_font_metadata(StringView root_path, ReadonlySpan<FontMetadata> fonts)
+{
+    // NB: The cache is only a shortcut, so failing to write it is fine.
+    if (auto result = write_font_metadata(root_path, fonts); result.is_error())
+        dbgln("Unable to cache the fonts in {}: {}", root_path, result.error());
+}
+
+}
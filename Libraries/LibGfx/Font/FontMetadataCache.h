@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+
+namespace Gfx {
+
+// What we need to know about a font to find it again, without having to open its file.
+struct FontMetadata {
+    String path;
+    u32 ttc_index { 0 };
+    FlyString family;
+    u16 weight { 0 };
+    u16 width { 0 };
+    u8 slope { 0 };
+};
+
+// The fonts below a font directory are remembered in a file in the user's cache directory, which every process maps
+// when it starts rather than opening each of the fonts again. The file is only used while none of the directories below
+// the root have been modified since it was written, which is what adding, removing or replacing a font does.
+Optional<Vector<FontMetadata>> load_cached_font_metadata(StringView root_path);
+void store_cached_font_metadata(StringView root_path, ReadonlySpan<FontMetadata>);
+
+}
@@ -51,39 +51,106 @@ void PathFontProvider::load_all_fonts_from_uri(StringView uri)
     }
     auto root = root_or_error.release_value();
 
-    root->for_each_descendant_file([this](Core::Resource const& resource) -> IterationDecision {
-        auto uri = resource.uri();
-        auto path = LexicalPath(uri.bytes_as_string_view());
-        auto is_truetype = path.has_extension(".ttf"sv) || path.has_extension(".ttc"sv) || path.has_extension(".otf"sv);
-        auto is_woff = path.has_extension(".woff"sv);
-        if (!is_truetype && !is_woff)
-            return IterationDecision::Continue;
-
-        if (m_loaded_paths.set(resource.filesystem_path(), AK::HashSetExistingEntryBehavior::Keep) != AK::HashSetResult::InsertedNewEntry)
-            return IterationDecision::Continue;
-
-        if (is_truetype) {
-            auto font_count = number_of_fonts_in_ttc(resource.data());
-            for (u32 ttc_index = 0; ttc_index < font_count; ++ttc_index) {
-                if (auto font_or_error = Typeface::try_load_from_resource(resource, ttc_index); !font_or_error.is_error()) {
-                    auto font = font_or_error.release_value();
-                    auto& family = m_typeface_by_family.ensure(font->family(), [] {
-                        return Vector<NonnullRefPtr<Typeface>> {};
-                    });
-                    family.append(font);
-                }
-            }
-        } else {
-            if (auto font_or_error = WOFF::try_load_from_resource(resource); !font_or_error.is_error()) {
-                auto font = font_or_error.release_value();
-                auto& family = m_typeface_by_family.ensure(font->family(), [] {
-                    return Vector<NonnullRefPtr<Typeface>> {};
-                });
-                family.append(font);
-            }
+    auto root_path = root->filesystem_path();
+    if (root->is_directory()) {
+        if (auto cached_fonts = load_cached_font_metadata(root_path); cached_fonts.has_value()) {
+            load_fonts_from_cached_metadata(cached_fonts.release_value());
+            return;
         }
+    }
+
+    Vector<FontMetadata> fonts_below_root;
+    root->for_each_descendant_file([&](Core::Resource const& resource) -> IterationDecision {
+        fonts_below_root.extend(load_fonts_from_resource(resource));
         return IterationDecision::Continue;
     });
+
+    if (root->is_directory())
+        store_cached_font_metadata(root_path, fonts_below_root);
+}
+
+Vector<FontMetadata> PathFontProvider::load_fonts_from_resource(Core::Resource const& resource)
+{
+    auto uri = resource.uri();
+    auto path = LexicalPath(uri.bytes_as_string_view());
+    auto is_truetype = path.has_extension(".ttf"sv) || path.has_extension(".ttc"sv) || path.has_extension(".otf"sv);
+    auto is_woff = path.has_extension(".woff"sv);
+    if (!is_truetype && !is_woff)
+        return {};
+
+    auto filesystem_path = resource.filesystem_path();
+    if (auto it = m_fonts_by_path.find(filesystem_path); it != m_fonts_by_path.end())
+        return it->value;
+
+    Vector<FontMetadata> fonts;
+    auto add_loaded_typeface = [&](NonnullRefPtr<Typeface> typeface, u32 ttc_index) {
+        FontMetadata metadata { filesystem_path, ttc_index, typeface->family(), typeface->weight(), typeface->width(), typeface->slope() };
+        fonts.append(metadata);
+        add_typeface(move(metadata), move(typeface));
+    };
+
+    if (is_truetype) {
+        auto font_count = number_of_fonts_in_ttc(resource.data());
+        for (u32 ttc_index = 0; ttc_index < font_count; ++ttc_index) {
+            if (auto font_or_error = Typeface::try_load_from_resource(resource, ttc_index); !font_or_error.is_error())
+                add_loaded_typeface(font_or_error.release_value(), ttc_index);
+        }
+    } else {
+        if (auto font_or_error = WOFF::try_load_from_resource(resource); !font_or_error.is_error())
+            add_loaded_typeface(font_or_error.release_value(), 0);
+    }
+
+    m_fonts_by_path.set(filesystem_path, fonts);
+    return fonts;
+}
+
+void PathFontProvider::load_fonts_from_cached_metadata(Vector<FontMetadata> fonts)
+{
+    // NB: Files that were loaded from another font directory already are skipped, but there may be several fonts in a
+    //     file, so they're all looked up before any of them are added.
+    HashTable<String> paths_loaded_before;
+    for (auto const& font : fonts) {
+        if (m_fonts_by_path.contains(font.path))
+            paths_loaded_before.set(font.path);
+    }
+
+    for (auto& font : fonts) {
+        if (paths_loaded_before.contains(font.path))
+            continue;
+        m_fonts_by_path.ensure(font.path).append(font);
+        add_typeface(move(font));
+    }
+}
+
+void PathFontProvider::add_typeface(FontMetadata metadata, RefPtr<Typeface> typeface)
+{
+    auto& family = m_typeface_by_family.ensure(metadata.family, [] {
+        return Vector<TypefaceEntry> {};
+    });
+    family.append({ move(metadata), move(typeface) });
+}
+
+static ErrorOr<NonnullRefPtr<Typeface>> load_typeface(FontMetadata const& metadata)
+{
+    auto resource = TRY(Core::Resource::load_from_filesystem(metadata.path));
+    if (LexicalPath { metadata.path }.has_extension(".woff"sv))
+        return WOFF::try_load_from_resource(*resource);
+    return Typeface::try_load_from_resource(*resource, metadata.ttc_index);
+}
+
+RefPtr<Typeface> PathFontProvider::ensure_typeface_loaded(TypefaceEntry& entry)
+{
+    if (entry.typeface || entry.failed_to_load)
+        return entry.typeface;
+
+    auto typeface_or_error = load_typeface(entry.metadata);
+    if (typeface_or_error.is_error()) {
+        dbgln("PathFontProvider: Unable to load font '{}': {}", entry.metadata.path, typeface_or_error.error());
+        entry.failed_to_load = true;
+        return nullptr;
+    }
+    entry.typeface = typeface_or_error.release_value();
+    return entry.typeface;
 }
 
 RefPtr<Gfx::Font> PathFontProvider::get_font(FlyString const& family, float point_size, unsigned weight, unsigned width, unsigned slope, Optional<FontVariationSettings> const& font_variation_settings, Optional<Gfx::ShapeFeatures> const& shape_features)
@@ -141,8 +208,11 @@ RefPtr<Gfx::Font> PathFontProvider::get_font(FlyString const& family, float poin
     auto it = m_typeface_by_family.find(family);
     if (it == m_typeface_by_family.end())
         return nullptr;
-    for (auto const& typeface : it->value) {
-        if (typeface->weight() == weight && typeface->width() == width && typeface->slope() == slope)
+    for (auto& entry : it->value) {
+        auto const& metadata = entry.metadata;
+        if (metadata.weight != weight || metadata.width != width || metadata.slope != slope)
+            continue;
+        if (auto typeface = ensure_typeface_loaded(entry))
             return typeface->font(point_size, font_variation_settings.value_or_lazy_evaluated([&] { return compute_default_font_variation_settings(weight, width); }), shape_features.value_or_lazy_evaluated([&] { return compute_default_shape_features(); }));
     }
 
@@ -154,8 +224,9 @@ void PathFontProvider::for_each_typeface_with_family_name(FlyString const& famil
     auto it = m_typeface_by_family.find(family_name);
     if (it == m_typeface_by_family.end())
         return;
-    for (auto const& typeface : it->value) {
-        callback(*typeface);
+    for (auto& entry : it->value) {
+        if (auto typeface = ensure_typeface_loaded(entry))
+            callback(*typeface);
     }
 }
 
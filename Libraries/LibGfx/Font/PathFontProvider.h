@@ -11,6 +11,7 @@
 #include <AK/HashMap.h>
 #include <AK/HashTable.h>
 #include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/Font/FontMetadataCache.h>
 #include <LibGfx/Font/Typeface.h>
 
 namespace Gfx {
@@ -32,12 +33,25 @@ public:
     virtual StringView name() const LIFETIME_BOUND override { return m_name.bytes_as_string_view(); }
 
 private:
-    HashMap<FlyString, Vector<NonnullRefPtr<Typeface>>, AK::ASCIICaseInsensitiveFlyStringTraits> m_typeface_by_family;
+    // NB: Typefaces that were found through the font metadata cache are only loaded once they're asked for.
+    struct TypefaceEntry {
+        FontMetadata metadata;
+        RefPtr<Typeface> typeface;
+        bool failed_to_load { false };
+    };
+
+    void add_typeface(FontMetadata, RefPtr<Typeface> = nullptr);
+    void load_fonts_from_cached_metadata(Vector<FontMetadata>);
+    Vector<FontMetadata> load_fonts_from_resource(Core::Resource const&);
+    static RefPtr<Typeface> ensure_typeface_loaded(TypefaceEntry&);
+
+    HashMap<FlyString, Vector<TypefaceEntry>, AK::ASCIICaseInsensitiveFlyStringTraits> m_typeface_by_family;
 
     // Tracks files we've already loaded, to avoid mmap'ing the same .ttf/.otf/.ttc
     // multiple times when overlapping font directories are walked (fontconfig commonly
     // returns nested entries like /usr/share/fonts and /usr/share/fonts/truetype).
-    HashTable<String> m_loaded_paths;
+    // The fonts in each of them are kept, so that they can be cached for every directory they're in.
+    HashMap<String, Vector<FontMetadata>> m_fonts_by_path;
 
     String m_name { "Path"_string };
 };
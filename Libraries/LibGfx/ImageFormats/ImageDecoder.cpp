@@ -77,4 +77,26 @@ ImageDecoder::ImageDecoder(NonnullOwnPtr<ImageDecoderPlugin> plugin)
 {
 }
 
+ErrorOr<OwnPtr<IncrementalImageDecoder>> IncrementalImageDecoder::try_create(ReadonlyBytes initial_data)
+{
+    struct IncrementalDecoderInitializer {
+        bool (*sniff)(ReadonlyBytes) = nullptr;
+        ErrorOr<NonnullOwnPtr<IncrementalImageDecoder>> (*create)() = nullptr;
+    };
+
+    static constexpr IncrementalDecoderInitializer s_initializers[] = {
+        { JPEGImageDecoderPlugin::sniff, JPEGImageDecoderPlugin::create_incremental },
+        { PNGImageDecoderPlugin::sniff, PNGImageDecoderPlugin::create_incremental },
+    };
+
+    for (auto& initializer : s_initializers) {
+        if (!initializer.sniff(initial_data))
+            continue;
+        auto decoder = TRY(initializer.create());
+        TRY(decoder->append_data(initial_data));
+        return decoder;
+    }
+    return OwnPtr<IncrementalImageDecoder> {};
+}
+
 }
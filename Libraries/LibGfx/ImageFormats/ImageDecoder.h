@@ -72,6 +72,10 @@ public:
     // This function should be used to both create the context and parse the image header.
     // static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create(ReadonlyBytes);
 
+    // Implement create_incremental() if the format can be decoded while its data is still arriving, and register it
+    // in ImageDecoder.cpp as well.
+    // static ErrorOr<NonnullOwnPtr<IncrementalImageDecoder>> create_incremental();
+
     // This should always be available as gathered in create()
     virtual IntSize size() = 0;
 
@@ -138,4 +142,24 @@ private:
     NonnullOwnPtr<ImageDecoderPlugin> mutable m_plugin;
 };
 
+// Decodes the first frame of an image while its encoded data is still being received, so that it can be shown
+// before it has fully arrived. Decoding suspends at the end of the appended data, and resumes from there once more of
+// it is appended.
+class IncrementalImageDecoder {
+public:
+    // Returns null if the data is not in a format that can be decoded incrementally.
+    static ErrorOr<OwnPtr<IncrementalImageDecoder>> try_create(ReadonlyBytes initial_data);
+
+    virtual ~IncrementalImageDecoder() = default;
+
+    virtual ErrorOr<void> append_data(ReadonlyBytes) = 0;
+
+    // Returns a copy of the image as far as it has been decoded, with the rows that haven't arrived yet left
+    // transparent, or null if nothing new has been decoded since the last call.
+    virtual ErrorOr<RefPtr<Bitmap>> take_partial_bitmap() = 0;
+
+protected:
+    IncrementalImageDecoder() = default;
+};
+
 }
@@ -38,6 +38,14 @@ struct JPEGErrorManager : jpeg_error_mgr {
     jmp_buf setjmp_buffer {};
 };
 
+static void handle_jpeg_error(j_common_ptr cinfo)
+{
+    char buffer[JMSG_LENGTH_MAX];
+    (*cinfo->err->format_message)(cinfo, buffer);
+    dbgln("JPEG error: {}", buffer);
+    longjmp(static_cast<JPEGErrorManager*>(cinfo->err)->setjmp_buffer, 1);
+}
+
 ErrorOr<void> JPEGLoadingContext::decode()
 {
     struct jpeg_decompress_struct cinfo;
@@ -51,12 +59,7 @@ ErrorOr<void> JPEGLoadingContext::decode()
     if (setjmp(jerr.setjmp_buffer))
         return Error::from_string_literal("Failed to decode JPEG");
 
-    jerr.error_exit = [](j_common_ptr cinfo) {
-        char buffer[JMSG_LENGTH_MAX];
-        (*cinfo->err->format_message)(cinfo, buffer);
-        dbgln("JPEG error: {}", buffer);
-        longjmp(static_cast<JPEGErrorManager*>(cinfo->err)->setjmp_buffer, 1);
-    };
+    jerr.error_exit = handle_jpeg_error;
 
     jpeg_create_decompress(&cinfo);
 
@@ -278,4 +281,222 @@ ErrorOr<NonnullRefPtr<CMYKBitmap>> JPEGImageDecoderPlugin::cmyk_frame()
     return *m_context->cmyk_bitmap;
 }
 
+// A source manager that suspends at the end of the data it has, rather than treating it as the end of the file.
+struct JPEGIncrementalSourceManager : jpeg_source_mgr {
+    // Skips past the end of the data that has arrived so far, to be applied to the data that is appended next.
+    size_t bytes_to_skip { 0 };
+};
+
+class JPEGIncrementalImageDecoder final : public IncrementalImageDecoder {
+public:
+    JPEGIncrementalImageDecoder() = default;
+
+    virtual ~JPEGIncrementalImageDecoder() override
+    {
+        if (m_is_created)
+            jpeg_destroy_decompress(&m_cinfo);
+    }
+
+    ErrorOr<void> initialize();
+
+    virtual ErrorOr<void> append_data(ReadonlyBytes) override;
+    virtual ErrorOr<RefPtr<Bitmap>> take_partial_bitmap() override;
+
+private:
+    enum class State {
+        ReadingHeader,
+        StartingDecompression,
+        ReadingScanlines,
+        ReadingScans,
+        Decoded,
+        Error,
+    };
+
+    ErrorOr<void> decode_available_data();
+    void output_scan(int scan_number);
+    void finish_decompression();
+
+    jpeg_decompress_struct m_cinfo {};
+    JPEGErrorManager m_error_manager {};
+    JPEGIncrementalSourceManager m_source_manager {};
+    bool m_is_created { false };
+
+    // The appended data that libjpeg hasn't consumed yet.
+    ByteBuffer m_data;
+
+    State m_state { State::ReadingHeader };
+    RefPtr<Bitmap> m_bitmap;
+    bool m_has_new_rows { false };
+    int m_last_output_scan { 0 };
+};
+
+ErrorOr<void> JPEGIncrementalImageDecoder::initialize()
+{
+    m_cinfo.err = jpeg_std_error(&m_error_manager);
+    m_error_manager.error_exit = handle_jpeg_error;
+
+    if (setjmp(m_error_manager.setjmp_buffer))
+        return Error::from_string_literal("Failed to create JPEG decompressor");
+
+    jpeg_create_decompress(&m_cinfo);
+    m_is_created = true;
+
+    m_source_manager.init_source = [](j_decompress_ptr) { };
+    m_source_manager.fill_input_buffer = [](j_decompress_ptr) -> boolean { return false; };
+    m_source_manager.skip_input_data = [](j_decompress_ptr context, long num_bytes) {
+        auto& source_manager = *static_cast<JPEGIncrementalSourceManager*>(context->src);
+        if (num_bytes > static_cast<long>(source_manager.bytes_in_buffer)) {
+            source_manager.bytes_to_skip += num_bytes - source_manager.bytes_in_buffer;
+            source_manager.next_input_byte += source_manager.bytes_in_buffer;
+            source_manager.bytes_in_buffer = 0;
+            return;
+        }
+        source_manager.next_input_byte += num_bytes;
+        source_manager.bytes_in_buffer -= num_bytes;
+    };
+    m_source_manager.resync_to_restart = jpeg_resync_to_restart;
+    m_source_manager.term_source = [](j_decompress_ptr) { };
+
+    m_cinfo.src = &m_source_manager;
+    return {};
+}
+
+ErrorOr<void> JPEGIncrementalImageDecoder::append_data(ReadonlyBytes data)
+{
+    if (m_state == State::Decoded || m_state == State::Error)
+        return {};
+
+    auto bytes_to_skip = min(m_source_manager.bytes_to_skip, data.size());
+    m_source_manager.bytes_to_skip -= bytes_to_skip;
+    data = data.slice(bytes_to_skip);
+
+    // libjpeg resumes from the first byte it hasn't consumed, so keep those, followed by the new data.
+    ReadonlyBytes unconsumed_data;
+    if (m_source_manager.next_input_byte)
+        unconsumed_data = { m_source_manager.next_input_byte, m_source_manager.bytes_in_buffer };
+
+    auto new_data = TRY(ByteBuffer::create_uninitialized(unconsumed_data.size() + data.size()));
+    unconsumed_data.copy_to(new_data.bytes());
+    data.copy_to(new_data.bytes().slice(unconsumed_data.size()));
+    m_data = move(new_data);
+
+    m_source_manager.next_input_byte = m_data.data();
+    m_source_manager.bytes_in_buffer = m_data.size();
+
+    return decode_available_data();
+}
+
+ErrorOr<void> JPEGIncrementalImageDecoder::decode_available_data()
+{
+    if (setjmp(m_error_manager.setjmp_buffer)) {
+        m_state = State::Error;
+        return Error::from_string_literal("Failed to decode JPEG");
+    }
+
+    // NB: Each libjpeg call below returns without progress when it runs out of data, and is made again once more has
+    //     been appended.
+    if (m_state == State::ReadingHeader) {
+        if (jpeg_read_header(&m_cinfo, TRUE) != JPEG_HEADER_OK)
+            return {};
+
+        // CMYK images are converted once the whole image has been decoded, so they're only decoded in full.
+        if (m_cinfo.jpeg_color_space == JCS_CMYK || m_cinfo.jpeg_color_space == JCS_YCCK) {
+            m_state = State::Error;
+            return Error::from_string_literal("CMYK JPEGs can't be decoded incrementally");
+        }
+
+        m_cinfo.out_color_space = JCS_EXT_BGRA;
+
+        // Progressive images are shown as each of their scans arrives, which needs libjpeg to keep the coefficients of
+        // the whole image around.
+        m_cinfo.buffered_image = jpeg_has_multiple_scans(&m_cinfo);
+        m_state = State::StartingDecompression;
+    }
+
+    if (m_state == State::StartingDecompression) {
+        if (!jpeg_start_decompress(&m_cinfo))
+            return {};
+
+        // The rows that haven't been decoded yet stay transparent.
+        m_bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Premultiplied, { static_cast<int>(m_cinfo.output_width), static_cast<int>(m_cinfo.output_height) }));
+        m_state = m_cinfo.buffered_image ? State::ReadingScans : State::ReadingScanlines;
+    }
+
+    if (m_state == State::ReadingScanlines) {
+        while (m_cinfo.output_scanline < m_cinfo.output_height) {
+            auto* row_ptr = m_bitmap->scanline_u8(m_cinfo.output_scanline);
+            if (jpeg_read_scanlines(&m_cinfo, &row_ptr, 1) == 0)
+                return {};
+            m_has_new_rows = true;
+        }
+        finish_decompression();
+        return {};
+    }
+
+    if (m_state == State::ReadingScans) {
+        for (;;) {
+            auto result = jpeg_consume_input(&m_cinfo);
+            if (result == JPEG_SUSPENDED)
+                return {};
+            if (result == JPEG_REACHED_EOI)
+                break;
+        }
+        output_scan(m_cinfo.input_scan_number);
+        finish_decompression();
+    }
+
+    return {};
+}
+
+void JPEGIncrementalImageDecoder::output_scan(int scan_number)
+{
+    // NB: The scan must have arrived in full, so that this doesn't need any more input.
+    jpeg_start_output(&m_cinfo, scan_number);
+    while (m_cinfo.output_scanline < m_cinfo.output_height) {
+        auto* row_ptr = m_bitmap->scanline_u8(m_cinfo.output_scanline);
+        if (jpeg_read_scanlines(&m_cinfo, &row_ptr, 1) == 0)
+            break;
+    }
+    jpeg_finish_output(&m_cinfo);
+
+    m_last_output_scan = scan_number;
+    m_has_new_rows = true;
+}
+
+void JPEGIncrementalImageDecoder::finish_decompression()
+{
+    // Whatever follows the image data doesn't matter to us, so don't wait for it.
+    if (!jpeg_finish_decompress(&m_cinfo))
+        jpeg_abort_decompress(&m_cinfo);
+    m_state = State::Decoded;
+}
+
+ErrorOr<RefPtr<Bitmap>> JPEGIncrementalImageDecoder::take_partial_bitmap()
+{
+    if (setjmp(m_error_manager.setjmp_buffer)) {
+        m_state = State::Error;
+        return Error::from_string_literal("Failed to decode JPEG");
+    }
+
+    if (m_state == State::ReadingScans) {
+        // The scan that is being received is still incomplete, so show the one before it.
+        auto last_complete_scan = m_cinfo.input_scan_number - 1;
+        if (last_complete_scan > m_last_output_scan)
+            output_scan(last_complete_scan);
+    }
+
+    if (!m_has_new_rows)
+        return RefPtr<Bitmap> {};
+
+    m_has_new_rows = false;
+    return TRY(m_bitmap->clone());
+}
+
+ErrorOr<NonnullOwnPtr<IncrementalImageDecoder>> JPEGImageDecoderPlugin::create_incremental()
+{
+    auto decoder = make<JPEGIncrementalImageDecoder>();
+    TRY(decoder->initialize());
+    return decoder;
+}
+
 }
@@ -16,6 +16,7 @@ class JPEGImageDecoderPlugin : public ImageDecoderPlugin {
 public:
     static bool sniff(ReadonlyBytes);
     static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create(ReadonlyBytes);
+    static ErrorOr<NonnullOwnPtr<IncrementalImageDecoder>> create_incremental();
 
     virtual ~JPEGImageDecoderPlugin() override;
     virtual IntSize size() override;
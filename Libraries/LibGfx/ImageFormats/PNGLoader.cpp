@@ -161,6 +161,31 @@ static void log_png_warning(png_structp, char const* warning_message)
     dbgln("libpng warning: {}", warning_message);
 }
 
+// Makes libpng output every image as BGRA8888.
+static void set_up_bgra8888_transformations(png_structp png_ptr, png_infop info_ptr, int bit_depth, int color_type, int interlace_type)
+{
+    if (color_type == PNG_COLOR_TYPE_PALETTE)
+        png_set_palette_to_rgb(png_ptr);
+
+    if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
+        png_set_expand_gray_1_2_4_to_8(png_ptr);
+
+    if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
+        png_set_tRNS_to_alpha(png_ptr);
+
+    if (bit_depth == 16)
+        png_set_strip_16(png_ptr);
+
+    if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
+        png_set_gray_to_rgb(png_ptr);
+
+    if (interlace_type != PNG_INTERLACE_NONE)
+        png_set_interlace_handling(png_ptr);
+
+    png_set_filler(png_ptr, 0xFF, PNG_FILLER_AFTER);
+    png_set_bgr(png_ptr);
+}
+
 ErrorOr<void> PNGImageDecoderPlugin::initialize()
 {
     m_context->png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
@@ -198,26 +223,7 @@ ErrorOr<void> PNGImageDecoderPlugin::initialize()
     png_get_IHDR(m_context->png_ptr, m_context->info_ptr, &width, &height, &bit_depth, &color_type, &interlace_type, nullptr, nullptr);
     m_context->size = { static_cast<int>(width), static_cast<int>(height) };
 
-    if (color_type == PNG_COLOR_TYPE_PALETTE)
-        png_set_palette_to_rgb(m_context->png_ptr);
-
-    if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
-        png_set_expand_gray_1_2_4_to_8(m_context->png_ptr);
-
-    if (png_get_valid(m_context->png_ptr, m_context->info_ptr, PNG_INFO_tRNS))
-        png_set_tRNS_to_alpha(m_context->png_ptr);
-
-    if (bit_depth == 16)
-        png_set_strip_16(m_context->png_ptr);
-
-    if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
-        png_set_gray_to_rgb(m_context->png_ptr);
-
-    if (interlace_type != PNG_INTERLACE_NONE)
-        png_set_interlace_handling(m_context->png_ptr);
-
-    png_set_filler(m_context->png_ptr, 0xFF, PNG_FILLER_AFTER);
-    png_set_bgr(m_context->png_ptr);
+    set_up_bgra8888_transformations(m_context->png_ptr, m_context->info_ptr, bit_depth, color_type, interlace_type);
 
     png_byte color_primaries { 0 };
     png_byte transfer_function { 0 };
@@ -408,4 +414,123 @@ Optional<Metadata const&> PNGImageDecoderPlugin::metadata()
     return OptionalNone {};
 }
 
+// Decodes the image with libpng's progressive reader, which is handed the data as it arrives and reports each row as
+// soon as it has been decoded. Interlaced images report the rows of each of their passes in turn.
+class PNGIncrementalImageDecoder final : public IncrementalImageDecoder {
+public:
+    PNGIncrementalImageDecoder() = default;
+
+    virtual ~PNGIncrementalImageDecoder() override
+    {
+        png_destroy_read_struct(&m_png_ptr, &m_info_ptr, nullptr);
+    }
+
+    ErrorOr<void> initialize();
+
+    virtual ErrorOr<void> append_data(ReadonlyBytes) override;
+    virtual ErrorOr<RefPtr<Bitmap>> take_partial_bitmap() override;
+
+private:
+    static void did_read_info(png_structp, png_infop);
+    static void did_read_row(png_structp, png_bytep new_row, png_uint_32 row_number, int pass);
+    static void did_read_end(png_structp, png_infop);
+
+    png_structp m_png_ptr { nullptr };
+    png_infop m_info_ptr { nullptr };
+
+    RefPtr<Bitmap> m_bitmap;
+    bool m_has_new_rows { false };
+    bool m_is_decoded { false };
+    bool m_has_failed { false };
+};
+
+ErrorOr<void> PNGIncrementalImageDecoder::initialize()
+{
+    m_png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, log_png_error, log_png_warning);
+    if (!m_png_ptr)
+        return Error::from_string_view("Failed to allocate read struct"sv);
+
+    m_info_ptr = png_create_info_struct(m_png_ptr);
+    if (!m_info_ptr)
+        return Error::from_string_view("Failed to allocate info struct"sv);
+
+    png_set_progressive_read_fn(m_png_ptr, this, did_read_info, did_read_row, did_read_end);
+    return {};
+}
+
+void PNGIncrementalImageDecoder::did_read_info(png_structp png_ptr, png_infop info_ptr)
+{
+    auto& decoder = *static_cast<PNGIncrementalImageDecoder*>(png_get_progressive_ptr(png_ptr));
+
+    // NB: The frames of an animated PNG are composited onto each other, which is left to the complete decode.
+    u32 frame_count = 0;
+    u32 loop_count = 0;
+    if (png_get_acTL(png_ptr, info_ptr, &frame_count, &loop_count))
+        png_longjmp(png_ptr, 1);
+
+    u32 width = 0;
+    u32 height = 0;
+    int bit_depth = 0;
+    int color_type = 0;
+    int interlace_type = 0;
+    png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, &interlace_type, nullptr, nullptr);
+
+    set_up_bgra8888_transformations(png_ptr, info_ptr, bit_depth, color_type, interlace_type);
+    png_read_update_info(png_ptr, info_ptr);
+
+    // The rows that haven't been decoded yet stay transparent.
+    auto bitmap_or_error = Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Unpremultiplied, { static_cast<int>(width), static_cast<int>(height) });
+    if (bitmap_or_error.is_error())
+        png_error(png_ptr, "Failed to allocate bitmap");
+    decoder.m_bitmap = bitmap_or_error.release_value();
+}
+
+void PNGIncrementalImageDecoder::did_read_row(png_structp png_ptr, png_bytep new_row, png_uint_32 row_number, int)
+{
+    // Passes of interlaced images skip the rows that they have no pixels in.
+    if (!new_row)
+        return;
+
+    auto& decoder = *static_cast<PNGIncrementalImageDecoder*>(png_get_progressive_ptr(png_ptr));
+    png_progressive_combine_row(png_ptr, decoder.m_bitmap->scanline_u8(row_number), new_row);
+    decoder.m_has_new_rows = true;
+}
+
+void PNGIncrementalImageDecoder::did_read_end(png_structp png_ptr, png_infop)
+{
+    auto& decoder = *static_cast<PNGIncrementalImageDecoder*>(png_get_progressive_ptr(png_ptr));
+    decoder.m_is_decoded = true;
+}
+
+ErrorOr<void> PNGIncrementalImageDecoder::append_data(ReadonlyBytes data)
+{
+    if (m_is_decoded || m_has_failed)
+        return {};
+
+    // NOTE: We need to setjmp() here because libpng uses longjmp() for error handling.
+    if (auto error_value = setjmp(png_jmpbuf(m_png_ptr)); error_value) {
+        m_has_failed = true;
+        return Error::from_string_literal("Failed to decode PNG incrementally");
+    }
+
+    png_process_data(m_png_ptr, m_info_ptr, const_cast<png_bytep>(data.data()), data.size());
+    return {};
+}
+
+ErrorOr<RefPtr<Bitmap>> PNGIncrementalImageDecoder::take_partial_bitmap()
+{
+    if (!m_has_new_rows)
+        return RefPtr<Bitmap> {};
+
+    m_has_new_rows = false;
+    return TRY(m_bitmap->clone());
+}
+
+ErrorOr<NonnullOwnPtr<IncrementalImageDecoder>> PNGImageDecoderPlugin::create_incremental()
+{
+    auto decoder = make<PNGIncrementalImageDecoder>();
+    TRY(decoder->initialize());
+    return decoder;
+}
+
 }
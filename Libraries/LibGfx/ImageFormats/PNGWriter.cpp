@@ -5,21 +5,223 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/Endian.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/ScopeGuard.h>
 #include <AK/Vector.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/PNGWriter.h>
+#include <LibThreading/ThreadPool.h>
 #include <png.h>
+#include <zlib.h>
 
 namespace Gfx {
 
+// The image data is filtered and compressed in parts of at least this size, each on its own thread. Every part
+// starts with an empty compression dictionary, which costs a little compression once every few hundred kilobytes.
+static constexpr size_t MINIMUM_BYTES_PER_PART = 256 * KiB;
+
+// libpng writes 8 KiB IDAT chunks by default, but larger chunks are just as valid and have less overhead.
+static constexpr size_t MAXIMUM_IDAT_CHUNK_SIZE = 1 * MiB;
+
+static constexpr size_t BYTES_PER_PIXEL = 4;
+
+enum class FilterType : u8 {
+    None,
+    Sub,
+    Up,
+    Average,
+    Paeth,
+};
+
+static constexpr size_t FILTER_TYPE_COUNT = 5;
+
+struct CompressedPart {
+    ByteBuffer data;
+    u32 checksum { 0 };
+    size_t uncompressed_size { 0 };
+};
+
+static u8 paeth_predictor(u8 a, u8 b, u8 c)
+{
+    int p = a + b - c;
+    int pa = abs(p - a);
+    int pb = abs(p - b);
+    int pc = abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return a;
+    if (pb <= pc)
+        return b;
+    return c;
+}
+
+static void copy_row_as_rgba(Bitmap const& bitmap, int y, Bytes destination)
+{
+    auto const* source = bitmap.scanline_u8(y);
+    if (bitmap.format() != BitmapFormat::BGRA8888 && bitmap.format() != BitmapFormat::BGRx8888) {
+        destination.overwrite(0, source, destination.size());
+        return;
+    }
+    for (size_t i = 0; i < destination.size(); i += BYTES_PER_PIXEL) {
+        destination[i + 0] = source[i + 2];
+        destination[i + 1] = source[i + 1];
+        destination[i + 2] = source[i + 0];
+        destination[i + 3] = source[i + 3];
+    }
+}
+
+static void filter_row(FilterType filter_type, ReadonlyBytes row, ReadonlyBytes previous_row, Bytes destination)
+{
+    for (size_t i = 0; i < row.size(); ++i) {
+        u8 left = i >= BYTES_PER_PIXEL ? row[i - BYTES_PER_PIXEL] : 0;
+        u8 up = previous_row[i];
+        u8 up_left = i >= BYTES_PER_PIXEL ? previous_row[i - BYTES_PER_PIXEL] : 0;
+
+        u8 predictor = 0;
+        switch (filter_type) {
+        case FilterType::None:
+            break;
+        case FilterType::Sub:
+            predictor = left;
+            break;
+        case FilterType::Up:
+            predictor = up;
+            break;
+        case FilterType::Average:
+            predictor = (left + up) / 2;
+            break;
+        case FilterType::Paeth:
+            predictor = paeth_predictor(left, up, up_left);
+            break;
+        }
+        destination[i] = row[i] - predictor;
+    }
+}
+
+// Picks the filter whose output has the smallest sum of absolute values, which is the same heuristic libpng uses.
+static void filter_row_adaptively(ReadonlyBytes row, ReadonlyBytes previous_row, Bytes scratch, Bytes destination)
+{
+    auto row_size = row.size();
+    size_t best_filter = 0;
+    u64 best_sum = NumericLimits<u64>::max();
+
+    for (size_t filter = 0; filter < FILTER_TYPE_COUNT; ++filter) {
+        auto filtered = scratch.slice(filter * row_size, row_size);
+        filter_row(static_cast<FilterType>(filter), row, previous_row, filtered);
+
+        u64 sum = 0;
+        for (auto byte : filtered)
+            sum += abs(static_cast<i8>(byte));
+        if (sum < best_sum) {
+            best_sum = sum;
+            best_filter = filter;
+        }
+    }
+
+    destination[0] = static_cast<u8>(best_filter);
+    destination.slice(1).overwrite(0, scratch.offset(best_filter * row_size), row_size);
+}
+
+// Produces raw deflate data for the rows in [first_row, end_row). All parts but the last end on a byte-aligned sync
+// flush point without a final block, so that the parts can be concatenated into a single stream.
+static ErrorOr<CompressedPart> compress_part(Bitmap const& bitmap, int first_row, int end_row, bool is_last_part)
+{
+    auto row_size = static_cast<size_t>(bitmap.width()) * BYTES_PER_PIXEL;
+    auto filtered_row_size = row_size + 1;
+
+    auto previous_row = TRY(ByteBuffer::create_zeroed(row_size));
+    auto current_row = TRY(ByteBuffer::create_uninitialized(row_size));
+    auto scratch = TRY(ByteBuffer::create_uninitialized(row_size * FILTER_TYPE_COUNT));
+    auto filtered = TRY(ByteBuffer::create_uninitialized(filtered_row_size * (end_row - first_row)));
+
+    // Filters look at the row above, which belongs to the previous part for all but the first one.
+    if (first_row > 0)
+        copy_row_as_rgba(bitmap, first_row - 1, previous_row);
+
+    for (int y = first_row; y < end_row; ++y) {
+        copy_row_as_rgba(bitmap, y, current_row);
+        filter_row_adaptively(current_row, previous_row, scratch, filtered.bytes().slice((y - first_row) * filtered_row_size, filtered_row_size));
+        swap(previous_row, current_row);
+    }
+
+    z_stream stream {};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_FILTERED) != Z_OK)
+        return Error::from_string_literal("Failed to initialize PNG compressor");
+    ScopeGuard end_stream = [&] { deflateEnd(&stream); };
+
+    // deflateBound() only accounts for Z_FINISH, a sync flush may append an empty stored block on top.
+    auto compressed = TRY(ByteBuffer::create_uninitialized(deflateBound(&stream, filtered.size()) + 16));
+
+    stream.next_in = filtered.data();
+    stream.avail_in = filtered.size();
+    stream.next_out = compressed.data();
+    stream.avail_out = compressed.size();
+
+    auto result = deflate(&stream, is_last_part ? Z_FINISH : Z_SYNC_FLUSH);
+    if (stream.avail_in != 0 || (is_last_part ? result != Z_STREAM_END : (result != Z_OK || stream.avail_out == 0)))
+        return Error::from_string_literal("Failed to compress PNG image data");
+
+    compressed.resize(compressed.size() - stream.avail_out);
+
+    return CompressedPart {
+        .data = move(compressed),
+        .checksum = static_cast<u32>(adler32(adler32(0, nullptr, 0), filtered.data(), filtered.size())),
+        .uncompressed_size = filtered.size(),
+    };
+}
+
+static ErrorOr<ByteBuffer> compress_image_data(Bitmap const& bitmap)
+{
+    auto height = static_cast<size_t>(bitmap.height());
+    auto filtered_row_size = (static_cast<size_t>(bitmap.width()) * BYTES_PER_PIXEL) + 1;
+
+    auto part_count = clamp(filtered_row_size * height / MINIMUM_BYTES_PER_PART, static_cast<size_t>(1), height);
+    auto rows_per_part = ceil_div(height, part_count);
+    part_count = ceil_div(height, rows_per_part);
+
+    Vector<Optional<CompressedPart>> parts;
+    TRY(parts.try_resize(part_count));
+
+    Threading::ThreadPool::the().parallel_for(part_count, [&](size_t i) {
+        auto first_row = static_cast<int>(i * rows_per_part);
+        auto end_row = static_cast<int>(min((i + 1) * rows_per_part, height));
+        if (auto part = compress_part(bitmap, first_row, end_row, i == part_count - 1); !part.is_error())
+            parts[i] = part.release_value();
+    });
+
+    // The parts are joined into one zlib stream, whose checksum is the combination of the checksums of the parts.
+    size_t compressed_size = 2 + sizeof(u32);
+    u32 checksum = adler32(0, nullptr, 0);
+    for (auto const& part : parts) {
+        if (!part.has_value())
+            return Error::from_string_literal("Failed to compress PNG image data");
+        compressed_size += part->data.size();
+        checksum = adler32_combine(checksum, part->checksum, static_cast<z_off_t>(part->uncompressed_size));
+    }
+
+    ByteBuffer compressed;
+    TRY(compressed.try_ensure_capacity(compressed_size));
+
+    // CMF and FLG for a 32 KiB window at the default compression level.
+    compressed.append(0x78);
+    compressed.append(0x9c);
+    for (auto const& part : parts)
+        compressed.append(part->data);
+
+    BigEndian<u32> big_endian_checksum { checksum };
+    compressed.append(&big_endian_checksum, sizeof(big_endian_checksum));
+
+    return compressed;
+}
+
 struct WriterContext {
-    Vector<u8*> row_pointers;
     ByteBuffer png_data;
 };
 
 ErrorOr<ByteBuffer> PNGWriter::encode(Gfx::Bitmap const& bitmap, Options options)
 {
+    auto image_data = TRY(compress_image_data(bitmap));
+
     auto context = make<WriterContext>();
     int width = bitmap.width();
     int height = bitmap.height();
@@ -44,23 +246,19 @@ ErrorOr<ByteBuffer> PNGWriter::encode(Gfx::Bitmap const& bitmap, Options options
         png_set_iCCP(png_ptr, info_ptr, "embedded profile", 0, options.icc_data->data(), options.icc_data->size());
     }
 
-    if (bitmap.format() == BitmapFormat::BGRA8888 || bitmap.format() == BitmapFormat::BGRx8888) {
-        png_set_bgr(png_ptr);
-    }
-
     png_set_write_fn(png_ptr, &context->png_data, [](png_structp png_ptr, u8* data, size_t length) {
         auto* buffer = reinterpret_cast<ByteBuffer*>(png_get_io_ptr(png_ptr));
         buffer->append(data, length); }, nullptr);
 
     png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGBA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(png_ptr, info_ptr);
 
-    context->row_pointers.resize(height);
-    for (int y = 0; y < height; ++y) {
-        context->row_pointers[y] = const_cast<u8*>(bitmap.scanline_u8(y));
+    // NB: The image data was compressed by us, so it's written as raw chunks rather than handed to png_write_image().
+    for (size_t offset = 0; offset < image_data.size(); offset += MAXIMUM_IDAT_CHUNK_SIZE) {
+        auto chunk_size = min(MAXIMUM_IDAT_CHUNK_SIZE, image_data.size() - offset);
+        png_write_chunk(png_ptr, reinterpret_cast<png_const_bytep>("IDAT"), image_data.data() + offset, chunk_size);
     }
-
-    png_set_rows(png_ptr, info_ptr, context->row_pointers.data());
-    png_write_png(png_ptr, info_ptr, PNG_TRANSFORM_IDENTITY, nullptr);
+    png_write_chunk(png_ptr, reinterpret_cast<png_const_bytep>("IEND"), nullptr, 0);
 
     png_destroy_write_struct(&png_ptr, &info_ptr);
 
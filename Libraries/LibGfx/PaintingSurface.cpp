@@ -9,10 +9,13 @@
 #include <LibGfx/SharedImageBuffer.h>
 #include <LibGfx/SkiaUtils.h>
 
+#include <core/SkBBHFactory.h>
 #include <core/SkCanvas.h>
 #include <core/SkColorSpace.h>
 #include <core/SkImage.h>
 #include <core/SkPaint.h>
+#include <core/SkPicture.h>
+#include <core/SkPictureRecorder.h>
 #include <core/SkRect.h>
 #include <core/SkSurface.h>
 #include <gpu/ganesh/GrBackendSurface.h>
@@ -39,6 +42,7 @@ struct PaintingSurface::Impl {
     IntSize size;
     sk_sp<SkSurface> surface;
     RefPtr<Bitmap> bitmap;
+    OwnPtr<SkPictureRecorder> recorder;
 };
 
 #if defined(AK_OS_MACOS) || defined(USE_VULKAN_DMABUF_IMAGES) || defined(USE_DIRECTX)
@@ -171,6 +175,15 @@ NonnullRefPtr<PaintingSurface> PaintingSurface::create_from_shared_image_buffer(
 }
 #endif
 
+NonnullRefPtr<PaintingSurface> PaintingSurface::create_for_recording(IntSize size)
+{
+    auto recorder = make<SkPictureRecorder>();
+    // NB: The bounding box hierarchy lets a playback clipped to part of the recording skip the operations outside it.
+    SkRTreeFactory bounding_box_hierarchy_factory;
+    recorder->beginRecording(SkRect::MakeIWH(size.width(), size.height()), &bounding_box_hierarchy_factory);
+    return adopt_ref(*new PaintingSurface(make<Impl>(RefPtr<SkiaBackendContext> {}, size, nullptr, nullptr, move(recorder))));
+}
+
 PaintingSurface::PaintingSurface(NonnullOwnPtr<Impl>&& impl)
     : m_impl(move(impl))
 {
@@ -244,17 +257,21 @@ IntRect PaintingSurface::rect() const
 
 SkCanvas& PaintingSurface::canvas() const
 {
+    if (m_impl->recorder)
+        return *m_impl->recorder->getRecordingCanvas();
     return *m_impl->surface->getCanvas();
 }
 
 SkSurface& PaintingSurface::sk_surface() const
 {
+    VERIFY(m_impl->surface);
     return *m_impl->surface;
 }
 
 void PaintingSurface::notify_content_will_change()
 {
-    m_impl->surface->notifyContentWillChange(SkSurface::kDiscard_ContentChangeMode);
+    if (m_impl->surface)
+        m_impl->surface->notifyContentWillChange(SkSurface::kDiscard_ContentChangeMode);
 }
 
 template<>
@@ -263,6 +280,14 @@ sk_sp<SkImage> PaintingSurface::sk_image_snapshot() const
     return m_impl->surface->makeImageSnapshot();
 }
 
+template<>
+sk_sp<SkPicture> PaintingSurface::take_recording()
+{
+    VERIFY(m_impl->recorder);
+    auto recorder = m_impl->recorder.release_nonnull();
+    return recorder->finishRecordingAsPicture();
+}
+
 RefPtr<SkiaBackendContext> PaintingSurface::skia_backend_context() const
 {
     return m_impl->context;
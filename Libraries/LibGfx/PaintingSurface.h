@@ -55,6 +55,11 @@ public:
     static NonnullRefPtr<PaintingSurface> create_with_size(IntSize size, BitmapFormat color_type, AlphaType alpha_type, RefPtr<SkiaBackendContext> = {});
     static NonnullRefPtr<PaintingSurface> wrap_bitmap(Bitmap&);
 
+    // A surface that records what is drawn onto its canvas instead of rasterizing it, so that the recording can be
+    // rasterized later, possibly in parts and on other threads. It has no pixels: only canvas() may be used until the
+    // recording is taken.
+    static NonnullRefPtr<PaintingSurface> create_for_recording(IntSize);
+
 #ifdef AK_OS_MACOS
     static NonnullRefPtr<PaintingSurface> create_from_shared_image_buffer(SharedImageBuffer&, NonnullRefPtr<SkiaBackendContext>, Origin = Origin::TopLeft);
 #endif
@@ -85,6 +90,9 @@ public:
     template<typename T>
     T sk_image_snapshot() const;
 
+    template<typename T>
+    T take_recording();
+
     RefPtr<SkiaBackendContext> skia_backend_context() const;
 
     void flush();
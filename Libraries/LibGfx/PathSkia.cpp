@@ -46,6 +46,9 @@ PathImplSkia::PathImplSkia(PathImplSkia const& other)
     , m_has_current_point(other.m_has_current_point)
     , m_path_builder(adopt_own(*new SkPathBuilder(*other.m_path_builder)))
 {
+    // NB: SkPath shares its points between copies, so carrying the snapshot over spares the copy from building it anew.
+    if (other.m_cached_path)
+        m_cached_path = adopt_own(*new SkPath(*other.m_cached_path));
 }
 
 PathImplSkia::~PathImplSkia() = default;
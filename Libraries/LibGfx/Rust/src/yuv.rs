@@ -142,26 +142,21 @@ pub unsafe extern "C" fn yuv_u16_to_rgba(
             (false, false) => yuv::i410_to_rgba(&planar_image, dst_slice, dst_stride, range.into(), matrix.into()),
         }
     } else {
-        // 12-bit 4:4:4 has no 8-bit RGBA output; shift to 10-bit and use I410.
+        // 12-bit 4:4:4 has no 8-bit RGBA output; shift to 10-bit and use I410. The shifted planes share a single
+        // allocation, and the shift loops are simple enough for the compiler to vectorize.
         if !subsampling_x && !subsampling_y {
-            let y_10: Vec<u16> = unsafe { core::slice::from_raw_parts(y_plane, y_len) }
-                .iter()
-                .map(|&v| v >> 2)
-                .collect();
-            let u_10: Vec<u16> = unsafe { core::slice::from_raw_parts(u_plane, uv_len) }
-                .iter()
-                .map(|&v| v >> 2)
-                .collect();
-            let v_10: Vec<u16> = unsafe { core::slice::from_raw_parts(v_plane, uv_len) }
-                .iter()
-                .map(|&v| v >> 2)
-                .collect();
+            let mut samples_10: Vec<u16> = Vec::with_capacity(y_len + (uv_len * 2));
+            samples_10.extend(planar_image.y_plane.iter().map(|&v| v >> 2));
+            samples_10.extend(planar_image.u_plane.iter().map(|&v| v >> 2));
+            samples_10.extend(planar_image.v_plane.iter().map(|&v| v >> 2));
+            let (y_10, uv_10) = samples_10.split_at(y_len);
+            let (u_10, v_10) = uv_10.split_at(uv_len);
             let planar_10 = YuvPlanarImage {
-                y_plane: &y_10,
+                y_plane: y_10,
                 y_stride,
-                u_plane: &u_10,
+                u_plane: u_10,
                 u_stride,
-                v_plane: &v_10,
+                v_plane: v_10,
                 v_stride,
                 width,
                 height,
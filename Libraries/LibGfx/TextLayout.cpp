@@ -9,11 +9,13 @@
 
 #include <AK/BitCast.h>
 #include <AK/HashFunctions.h>
+#include <AK/HashTable.h>
 #include <AK/Utf16String.h>
 #include <AK/Utf16View.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Point.h>
 #include <LibGfx/TextLayout.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibUnicode/CharacterTypes.h>
 #include <core/SkFont.h>
 #include <core/SkTextBlob.h>
@@ -272,6 +274,23 @@ static NonnullOwnPtr<ShapedGlyphs> build_origin_relative_shape(Utf16View const&
     return make<ShapedGlyphs>(move(glyphs), point.x());
 }
 
+static bool uses_single_ascii_character_cache(Utf16View const& string, float letter_spacing, GlyphRun::TextType text_type)
+{
+    return string.length_in_code_units() == 1 && letter_spacing == 0.f && text_type == GlyphRun::TextType::Common && string.code_unit_at(0) < 128;
+}
+
+static unsigned shaping_cache_key_hash(Utf16View const& string, u8 text_type_bits, u32 letter_spacing_bit_pattern)
+{
+    return pair_int_hash(string.hash(), pair_int_hash(text_type_bits, letter_spacing_bit_pattern));
+}
+
+static void add_to_current_generation(Font::ShapingCache& shaping_cache, ShapingCacheKey key, OwnPtr<ShapedGlyphs> shape)
+{
+    if (shaping_cache.map.size() >= Font::ShapingCache::max_entries_per_generation)
+        shaping_cache.previous_generation_map = exchange(shaping_cache.map, {});
+    shaping_cache.map.set(move(key), move(shape));
+}
+
 NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf16View const& string, Font const& font, GlyphRun::TextType text_type)
 {
     auto& shaping_cache = font.shaping_cache();
@@ -285,36 +304,133 @@ NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spaci
         return adopt_ref(*new GlyphRun(move(glyphs), font, text_type, shape.width));
     };
 
-    // FIXME: The cache currently grows unbounded. We should have some limit and LRU mechanism.
-    if (string.length_in_code_units() == 1 && letter_spacing == 0.f && text_type == GlyphRun::TextType::Common) {
-        auto code_unit = string.code_unit_at(0);
-        if (code_unit < 128) {
-            auto& cache_slot = shaping_cache.single_ascii_character_map[code_unit];
-            if (!cache_slot)
-                cache_slot = build_origin_relative_shape(string, font, text_type, letter_spacing);
-            return build_glyph_run(*cache_slot);
+    if (uses_single_ascii_character_cache(string, letter_spacing, text_type)) {
+        auto& cache_slot = shaping_cache.single_ascii_character_map[string.code_unit_at(0)];
+        if (cache_slot) {
+            ++shaping_cache.hit_count;
+        } else {
+            ++shaping_cache.miss_count;
+            cache_slot = build_origin_relative_shape(string, font, text_type, letter_spacing);
         }
+        return build_glyph_run(*cache_slot);
     }
 
     auto text_type_bits = static_cast<u8>(to_underlying(text_type));
     auto letter_spacing_bit_pattern = bit_cast<u32>(letter_spacing);
-    auto key_hash = pair_int_hash(string.hash(), pair_int_hash(text_type_bits, letter_spacing_bit_pattern));
+    auto key_hash = shaping_cache_key_hash(string, text_type_bits, letter_spacing_bit_pattern);
+    auto is_same_key = [&](auto const& candidate) {
+        return candidate.key.text_type == text_type_bits
+            && candidate.key.letter_spacing_bit_pattern == letter_spacing_bit_pattern
+            && candidate.key.text == string;
+    };
 
-    if (auto it = shaping_cache.map.find(key_hash, [&](auto const& candidate) {
-            return candidate.key.text_type == text_type_bits
-                && candidate.key.letter_spacing_bit_pattern == letter_spacing_bit_pattern
-                && candidate.key.text == string;
-        });
-        it != shaping_cache.map.end()) {
+    if (auto it = shaping_cache.map.find(key_hash, is_same_key); it != shaping_cache.map.end()) {
+        ++shaping_cache.hit_count;
         return build_glyph_run(*it->value);
     }
 
+    if (auto it = shaping_cache.previous_generation_map.find(key_hash, is_same_key); it != shaping_cache.previous_generation_map.end()) {
+        ++shaping_cache.hit_count;
+        auto key = it->key;
+        auto shape = move(it->value);
+        shaping_cache.previous_generation_map.remove(it);
+        auto run = build_glyph_run(*shape);
+        add_to_current_generation(shaping_cache, move(key), move(shape));
+        return run;
+    }
+
+    ++shaping_cache.miss_count;
     auto shape = build_origin_relative_shape(string, font, text_type, letter_spacing);
     auto run = build_glyph_run(*shape);
-    shaping_cache.map.set({ Utf16String::from_utf16(string), text_type_bits, letter_spacing_bit_pattern }, move(shape));
+    add_to_current_generation(shaping_cache, { Utf16String::from_utf16(string), text_type_bits, letter_spacing_bit_pattern }, move(shape));
     return run;
 }
 
+namespace {
+
+struct PendingShape {
+    TextToShape const* text { nullptr };
+    u8 text_type_bits { 0 };
+    u32 letter_spacing_bit_pattern { 0 };
+    OwnPtr<ShapedGlyphs> shape;
+};
+
+struct TextToShapeTraits : public DefaultTraits<TextToShape const*> {
+    static unsigned hash(TextToShape const* text)
+    {
+        auto key_hash = shaping_cache_key_hash(text->text, static_cast<u8>(to_underlying(text->text_type)), bit_cast<u32>(text->letter_spacing));
+        return pair_int_hash(ptr_hash(text->font.ptr()), key_hash);
+    }
+
+    static bool equals(TextToShape const* a, TextToShape const* b)
+    {
+        return a->font.ptr() == b->font.ptr()
+            && a->text_type == b->text_type
+            && bit_cast<u32>(a->letter_spacing) == bit_cast<u32>(b->letter_spacing)
+            && a->text == b->text;
+    }
+};
+
+}
+
+void prime_shaping_caches(ReadonlySpan<TextToShape> texts)
+{
+    Vector<PendingShape> pending_shapes;
+    pending_shapes.ensure_capacity(texts.size());
+
+    // The same text usually comes up more than once, but only needs to be shaped once.
+    HashTable<TextToShape const*, TextToShapeTraits> seen_texts;
+
+    for (auto const& text : texts) {
+        auto const& shaping_cache = text.font->shaping_cache();
+        auto text_type_bits = static_cast<u8>(to_underlying(text.text_type));
+        auto letter_spacing_bit_pattern = bit_cast<u32>(text.letter_spacing);
+
+        if (uses_single_ascii_character_cache(text.text, text.letter_spacing, text.text_type)) {
+            if (shaping_cache.single_ascii_character_map[text.text.code_unit_at(0)])
+                continue;
+        } else {
+            auto key_hash = shaping_cache_key_hash(text.text, text_type_bits, letter_spacing_bit_pattern);
+            auto is_same_key = [&](auto const& candidate) {
+                return candidate.key.text_type == text_type_bits
+                    && candidate.key.letter_spacing_bit_pattern == letter_spacing_bit_pattern
+                    && candidate.key.text == text.text;
+            };
+            if (shaping_cache.map.find(key_hash, is_same_key) != shaping_cache.map.end()
+                || shaping_cache.previous_generation_map.find(key_hash, is_same_key) != shaping_cache.previous_generation_map.end())
+                continue;
+        }
+
+        if (seen_texts.set(&text) != HashSetResult::InsertedNewEntry)
+            continue;
+        pending_shapes.unchecked_append({ &text, text_type_bits, letter_spacing_bit_pattern, nullptr });
+    }
+    if (pending_shapes.is_empty())
+        return;
+
+    // NB: HarfBuzz fonts are created on first use, which has to happen before they are shared between threads. Once
+    //     created, shaping with them only reads them.
+    for (auto const& pending_shape : pending_shapes)
+        (void)pending_shape.text->font->harfbuzz_font();
+
+    auto shape_pending_text = [&](size_t index) {
+        auto& pending_shape = pending_shapes[index];
+        auto const& text = *pending_shape.text;
+        pending_shape.shape = build_origin_relative_shape(text.text, text.font, text.text_type, text.letter_spacing);
+    };
+    Threading::ThreadPool::the().parallel_for(pending_shapes.size(), shape_pending_text, Threading::TaskPriority::UserBlocking);
+
+    for (auto& pending_shape : pending_shapes) {
+        auto const& text = *pending_shape.text;
+        auto& shaping_cache = text.font->shaping_cache();
+        ++shaping_cache.miss_count;
+        if (uses_single_ascii_character_cache(text.text, text.letter_spacing, text.text_type))
+            shaping_cache.single_ascii_character_map[text.text.code_unit_at(0)] = move(pending_shape.shape);
+        else
+            add_to_current_generation(shaping_cache, { Utf16String::from_utf16(text.text), pending_shape.text_type_bits, pending_shape.letter_spacing_bit_pattern }, move(pending_shape.shape));
+    }
+}
+
 float measure_text_width(Utf16View const& string, Font const& font, float letter_spacing)
 {
     auto* buffer = setup_text_shaping(string, font, GlyphRun::TextType::Common);
@@ -11,6 +11,7 @@
 #include <AK/AtomicRefCounted.h>
 #include <AK/Forward.h>
 #include <AK/OwnPtr.h>
+#include <AK/Utf16View.h>
 #include <AK/Vector.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/FontCascadeList.h>
@@ -78,4 +79,15 @@ NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spaci
 Vector<NonnullRefPtr<GlyphRun>> shape_text(FloatPoint baseline_start, Utf16View const&, FontCascadeList const&, float letter_spacing = 0.f);
 float measure_text_width(Utf16View const&, Font const& font, float letter_spacing = 0.f);
 
+struct TextToShape {
+    Utf16View text;
+    NonnullRefPtr<Font const> font;
+    float letter_spacing { 0 };
+    GlyphRun::TextType text_type { GlyphRun::TextType::Common };
+};
+
+// Shapes the texts that aren't in their font's shaping cache yet on the thread pool, and adds them to the cache, so
+// that shaping them later on is a cache hit. Must be called on the thread that shapes text with these fonts.
+void prime_shaping_caches(ReadonlySpan<TextToShape>);
+
 }
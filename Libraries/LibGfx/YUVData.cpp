@@ -29,9 +29,16 @@ struct YUVDataImpl {
     Media::Subsampling subsampling;
     Media::CodingIndependentCodePoints cicp;
 
-    FixedArray<u8> y_buffer;
-    FixedArray<u8> u_buffer;
-    FixedArray<u8> v_buffer;
+    // The Y, U and V planes, in that order.
+    Core::AnonymousBuffer buffer;
+    YUVData::PlaneSizes plane_sizes;
+
+    Bytes y_plane() { return { buffer.data<u8>(), plane_sizes.y }; }
+    Bytes u_plane() { return { buffer.data<u8>() + plane_sizes.y, plane_sizes.u }; }
+    Bytes v_plane() { return { buffer.data<u8>() + plane_sizes.y + plane_sizes.u, plane_sizes.v }; }
+    ReadonlyBytes y_plane() const { return { buffer.data<u8>(), plane_sizes.y }; }
+    ReadonlyBytes u_plane() const { return { buffer.data<u8>() + plane_sizes.y, plane_sizes.u }; }
+    ReadonlyBytes v_plane() const { return { buffer.data<u8>() + plane_sizes.y + plane_sizes.u, plane_sizes.v }; }
 };
 
 }
@@ -75,19 +82,23 @@ ErrorOr<YUVData::PlaneSizes> YUVData::plane_sizes(IntSize size, u8 bit_depth, Me
 ErrorOr<NonnullOwnPtr<YUVData>> YUVData::create(IntSize size, u8 bit_depth, Media::Subsampling subsampling, Media::CodingIndependentCodePoints cicp)
 {
     auto sizes = TRY(plane_sizes(size, bit_depth, subsampling));
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(sizes.total));
+    return create_from_buffer(size, bit_depth, subsampling, cicp, move(buffer));
+}
 
-    auto y_buffer = TRY(FixedArray<u8>::create(sizes.y));
-    auto u_buffer = TRY(FixedArray<u8>::create(sizes.u));
-    auto v_buffer = TRY(FixedArray<u8>::create(sizes.v));
+ErrorOr<NonnullOwnPtr<YUVData>> YUVData::create_from_buffer(IntSize size, u8 bit_depth, Media::Subsampling subsampling, Media::CodingIndependentCodePoints cicp, Core::AnonymousBuffer buffer)
+{
+    auto sizes = TRY(plane_sizes(size, bit_depth, subsampling));
+    if (!buffer.is_valid() || buffer.size() != sizes.total)
+        return Error::from_string_literal("YUVData buffer size mismatch");
 
     auto impl = TRY(try_make<Details::YUVDataImpl>(Details::YUVDataImpl {
         .size = size,
         .bit_depth = bit_depth,
         .subsampling = subsampling,
         .cicp = cicp,
-        .y_buffer = move(y_buffer),
-        .u_buffer = move(u_buffer),
-        .v_buffer = move(v_buffer),
+        .buffer = move(buffer),
+        .plane_sizes = sizes,
     }));
 
     return adopt_nonnull_own_or_enomem(new (nothrow) YUVData(move(impl)));
@@ -103,6 +114,7 @@ ErrorOr<NonnullOwnPtr<YUVData>> YUVData::create_from_data(IntSize size, u8 bit_d
     y_data.copy_to(yuv_data->y_data());
     u_data.copy_to(yuv_data->u_data());
     v_data.copy_to(yuv_data->v_data());
+    TRY(yuv_data->seal());
     return yuv_data;
 }
 
@@ -133,34 +145,47 @@ Media::CodingIndependentCodePoints const& YUVData::cicp() const
     return m_impl->cicp;
 }
 
+Core::AnonymousBuffer const& YUVData::buffer() const
+{
+    return m_impl->buffer;
+}
+
+ErrorOr<void> YUVData::seal()
+{
+    return m_impl->buffer.seal();
+}
+
 Bytes YUVData::y_data()
 {
-    return m_impl->y_buffer.span();
+    VERIFY(!m_impl->buffer.is_sealed());
+    return m_impl->y_plane();
 }
 
 Bytes YUVData::u_data()
 {
-    return m_impl->u_buffer.span();
+    VERIFY(!m_impl->buffer.is_sealed());
+    return m_impl->u_plane();
 }
 
 Bytes YUVData::v_data()
 {
-    return m_impl->v_buffer.span();
+    VERIFY(!m_impl->buffer.is_sealed());
+    return m_impl->v_plane();
 }
 
 ReadonlyBytes YUVData::y_data() const
 {
-    return m_impl->y_buffer.span();
+    return m_impl->y_plane();
 }
 
 ReadonlyBytes YUVData::u_data() const
 {
-    return m_impl->u_buffer.span();
+    return m_impl->u_plane();
 }
 
 ReadonlyBytes YUVData::v_data() const
 {
-    return m_impl->v_buffer.span();
+    return m_impl->v_plane();
 }
 
 static FFI::YUVMatrix yuv_matrix_for_cicp(Media::CodingIndependentCodePoints const& cicp)
@@ -203,9 +228,9 @@ ErrorOr<NonnullRefPtr<Bitmap>> YUVData::to_bitmap() const
             return Error::from_string_literal("Subsampled RGB is unsupported");
 
         if (impl.bit_depth <= 8) {
-            auto const* y_data = impl.y_buffer.data();
-            auto const* u_data = impl.u_buffer.data();
-            auto const* v_data = impl.v_buffer.data();
+            auto const* y_data = impl.y_plane().data();
+            auto const* u_data = impl.u_plane().data();
+            auto const* v_data = impl.v_plane().data();
             auto y_stride = static_cast<int>(width);
 
             for (u32 row = 0; row < height; row++) {
@@ -224,9 +249,9 @@ ErrorOr<NonnullRefPtr<Bitmap>> YUVData::to_bitmap() const
             // Our buffers hold native N-bit values in the low bits of each u16; shift right to reduce
             // to 8-bit for the output.
             auto shift = impl.bit_depth - 8;
-            auto const* y_data = reinterpret_cast<u16 const*>(impl.y_buffer.data());
-            auto const* u_data = reinterpret_cast<u16 const*>(impl.u_buffer.data());
-            auto const* v_data = reinterpret_cast<u16 const*>(impl.v_buffer.data());
+            auto const* y_data = reinterpret_cast<u16 const*>(impl.y_plane().data());
+            auto const* u_data = reinterpret_cast<u16 const*>(impl.u_plane().data());
+            auto const* v_data = reinterpret_cast<u16 const*>(impl.v_plane().data());
             auto y_stride = static_cast<int>(width);
 
             for (u32 row = 0; row < height; row++) {
@@ -258,18 +283,18 @@ ErrorOr<NonnullRefPtr<Bitmap>> YUVData::to_bitmap() const
     bool success;
     if (impl.bit_depth <= 8) {
         success = FFI::yuv_u8_to_rgba(
-            impl.y_buffer.data(), y_stride,
-            impl.u_buffer.data(), uv_stride,
-            impl.v_buffer.data(), uv_stride,
+            impl.y_plane().data(), y_stride,
+            impl.u_plane().data(), uv_stride,
+            impl.v_plane().data(), uv_stride,
             width, height,
             impl.subsampling.x(), impl.subsampling.y(),
             dst, dst_stride,
             range, matrix);
     } else {
         success = FFI::yuv_u16_to_rgba(
-            reinterpret_cast<u16 const*>(impl.y_buffer.data()), y_stride,
-            reinterpret_cast<u16 const*>(impl.u_buffer.data()), uv_stride,
-            reinterpret_cast<u16 const*>(impl.v_buffer.data()), uv_stride,
+            reinterpret_cast<u16 const*>(impl.y_plane().data()), y_stride,
+            reinterpret_cast<u16 const*>(impl.u_plane().data()), uv_stride,
+            reinterpret_cast<u16 const*>(impl.v_plane().data()), uv_stride,
             width, height,
             impl.bit_depth,
             impl.subsampling.x(), impl.subsampling.y(),
@@ -333,7 +358,7 @@ static u16 expand_sample_to_full_16_bit_range(u16 sample, u8 bit_depth)
     return static_cast<u16>((sample << shift) | (sample >> inverse_shift));
 }
 
-static void copy_plane_expanded_to_full_16_bit_range(FixedArray<u8> const& source_buffer, SkPixmap const& destination, IntSize plane_size, u8 bit_depth)
+static void copy_plane_expanded_to_full_16_bit_range(ReadonlyBytes source_buffer, SkPixmap const& destination, IntSize plane_size, u8 bit_depth)
 {
     VERIFY(bit_depth > 8);
 
@@ -371,11 +396,11 @@ SkYUVAPixmaps YUVData::make_pixmaps() const
         if (!pixmaps.isValid())
             return pixmaps;
 
-        copy_plane_expanded_to_full_16_bit_range(m_impl->y_buffer, pixmaps.plane(0), m_impl->size, m_impl->bit_depth);
+        copy_plane_expanded_to_full_16_bit_range(m_impl->y_plane(), pixmaps.plane(0), m_impl->size, m_impl->bit_depth);
 
         auto uv_size = m_impl->subsampling.subsampled_size(m_impl->size);
-        copy_plane_expanded_to_full_16_bit_range(m_impl->u_buffer, pixmaps.plane(1), uv_size, m_impl->bit_depth);
-        copy_plane_expanded_to_full_16_bit_range(m_impl->v_buffer, pixmaps.plane(2), uv_size, m_impl->bit_depth);
+        copy_plane_expanded_to_full_16_bit_range(m_impl->u_plane(), pixmaps.plane(1), uv_size, m_impl->bit_depth);
+        copy_plane_expanded_to_full_16_bit_range(m_impl->v_plane(), pixmaps.plane(2), uv_size, m_impl->bit_depth);
 
         return pixmaps;
     }
@@ -390,15 +415,15 @@ SkYUVAPixmaps YUVData::make_pixmaps() const
     // Create pixmaps from our buffers
     SkPixmap y_pixmap(
         SkImageInfo::Make(skia_size, color_type, kOpaque_SkAlphaType),
-        m_impl->y_buffer.data(),
+        m_impl->y_plane().data(),
         y_row_bytes);
     SkPixmap u_pixmap(
         SkImageInfo::Make(uv_size.width(), uv_size.height(), color_type, kOpaque_SkAlphaType),
-        m_impl->u_buffer.data(),
+        m_impl->u_plane().data(),
         uv_row_bytes);
     SkPixmap v_pixmap(
         SkImageInfo::Make(uv_size.width(), uv_size.height(), color_type, kOpaque_SkAlphaType),
-        m_impl->v_buffer.data(),
+        m_impl->v_plane().data(),
         uv_row_bytes);
 
     SkPixmap plane_pixmaps[SkYUVAInfo::kMaxPlanes] = { y_pixmap, u_pixmap, v_pixmap, {} };
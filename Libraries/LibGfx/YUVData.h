@@ -7,9 +7,9 @@
 #pragma once
 
 #include <AK/Error.h>
-#include <AK/FixedArray.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibGfx/Forward.h>
 #include <LibGfx/Size.h>
 #include <LibMedia/Color/CodingIndependentCodePoints.h>
@@ -26,7 +26,7 @@ struct YUVDataImpl;
 }
 
 // Holds planar YUV data with metadata needed for GPU conversion.
-// Uses FixedArray for deterministic buffer sizing.
+// All planes live in a single shared memory buffer, so that frames can be sent to the compositor without copying them.
 // Not ref-counted - owned directly by decoded video frame objects via NonnullOwnPtr.
 class YUVData final {
 public:
@@ -39,6 +39,7 @@ public:
 
     static ErrorOr<PlaneSizes> plane_sizes(IntSize size, u8 bit_depth, Media::Subsampling);
     static ErrorOr<NonnullOwnPtr<YUVData>> create(IntSize size, u8 bit_depth, Media::Subsampling, Media::CodingIndependentCodePoints);
+    static ErrorOr<NonnullOwnPtr<YUVData>> create_from_buffer(IntSize size, u8 bit_depth, Media::Subsampling, Media::CodingIndependentCodePoints, Core::AnonymousBuffer);
     static ErrorOr<NonnullOwnPtr<YUVData>> create_from_data(IntSize size, u8 bit_depth, Media::Subsampling, Media::CodingIndependentCodePoints, ReadonlyBytes y_data, ReadonlyBytes u_data, ReadonlyBytes v_data);
 
     ~YUVData();
@@ -48,7 +49,14 @@ public:
     Media::Subsampling subsampling() const;
     Media::CodingIndependentCodePoints const& cicp() const;
 
-    // Writable access for decoder to fill buffers after creation
+    // The Y, U and V planes, in that order and without padding.
+    Core::AnonymousBuffer const& buffer() const;
+
+    // Makes the planes read-only for this and every other process, so that a receiver of buffer() can trust that
+    // they won't change or shrink under it. Decoders call this once they have written every plane.
+    ErrorOr<void> seal();
+
+    // Writable access for decoder to fill buffers after creation. Must not be used after seal().
     Bytes y_data();
     Bytes u_data();
     Bytes v_data();
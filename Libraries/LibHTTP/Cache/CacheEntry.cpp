@@ -138,7 +138,7 @@ ErrorOr<void> CacheEntryWriter::write_status_and_reason(u32 status_code, Optiona
 
         m_vary_key = create_vary_key(request_headers, response_headers);
         m_path = path_for_cache_entry(m_disk_cache.cache_directory(), m_cache_key, m_vary_key);
-        m_temporary_path = LexicalPath::join(m_disk_cache.cache_directory().string(), ByteString::formatted("{}.tmp", m_path->basename()));
+        m_temporary_path = m_path->parent().append(ByteString::formatted("{}.tmp", m_path->basename()));
 
         auto freshness_lifetime = calculate_freshness_lifetime(status_code, response_headers, m_current_time_offset_for_testing);
         auto current_age = calculate_age(response_headers, m_request_time, m_response_time, m_current_time_offset_for_testing);
@@ -59,20 +59,20 @@ static void for_each_cache_entry_file(Database::Database& database, Callback&& c
     if (!index_path.has_value())
         return;
 
-    (void)Core::Directory::for_each_entry(
-        index_path->parent().string(),
-        static_cast<Core::DirIterator::Flags>(Core::DirIterator::SkipDots | Core::DirIterator::NoStat),
-        [&](Core::DirectoryEntry const& entry, Core::Directory const& parent) -> ErrorOr<IterationDecision> {
-            if (entry.type != Core::DirectoryEntry::Type::File)
-                return IterationDecision::Continue;
+    auto cache_directory = index_path->parent();
 
-            // Ignore INDEX.db and related files (e.g. the WAL file, INDEX.db-wal).
-            if (entry.name.starts_with(index_path->basename()))
-                return IterationDecision::Continue;
+    for (size_t shard = 0; shard < CACHE_ENTRY_SHARD_COUNT; ++shard) {
+        (void)Core::Directory::for_each_entry(
+            path_for_cache_entry_shard(cache_directory, static_cast<u8>(shard)).string(),
+            static_cast<Core::DirIterator::Flags>(Core::DirIterator::SkipDots | Core::DirIterator::NoStat),
+            [&](Core::DirectoryEntry const& entry, Core::Directory const& parent) -> ErrorOr<IterationDecision> {
+                if (entry.type != Core::DirectoryEntry::Type::File)
+                    return IterationDecision::Continue;
 
-            callback(parent.path().append(entry.name));
-            return IterationDecision::Continue;
-        });
+                callback(parent.path().append(entry.name));
+                return IterationDecision::Continue;
+            });
+    }
 }
 
 #if HTTP_DISK_CACHE_DEBUG
@@ -286,6 +286,8 @@ void CacheIndex::remove_entries_exceeding_cache_limit(Function<void(u64 cache_ke
     if (m_total_estimated_size <= m_limits.maximum_disk_cache_size)
         return;
 
+    flush_pending_last_access_times();
+
     m_database->execute_statement(
         m_statements.remove_entries_exceeding_cache_limit,
         [&](auto statement_id) {
@@ -303,6 +305,8 @@ void CacheIndex::remove_entries_exceeding_cache_limit(Function<void(u64 cache_ke
 
 void CacheIndex::remove_entries_accessed_since(UnixDateTime since, Function<void(u64 cache_key, u64 vary_key)> on_entry_removed)
 {
+    flush_pending_last_access_times();
+
     m_database->execute_statement(
         m_statements.remove_entries_accessed_since,
         [&](auto statement_id) {
@@ -348,16 +352,52 @@ void CacheIndex::update_associated_data_size(u64 cache_key, u64 vary_key, u64 as
     entry->associated_data_size = associated_data_size;
 }
 
+// Access times only order entries for eviction. Rather than turning every cache read into a database write, they are
+// updated in memory and written back in one transaction once enough of them have accumulated, or before anything that
+// depends on them runs.
+static constexpr size_t PENDING_LAST_ACCESS_TIME_FLUSH_THRESHOLD = 64;
+
 void CacheIndex::update_last_access_time(u64 cache_key, u64 vary_key)
 {
     auto entry = get_entry(cache_key, vary_key);
     if (!entry.has_value())
         return;
 
-    auto now = UnixDateTime::now();
+    entry->last_access_time = UnixDateTime::now();
 
-    m_database->execute_statement(m_statements.update_last_access_time, {}, now, cache_key, vary_key);
-    entry->last_access_time = now;
+    if (!entry->has_pending_last_access_time) {
+        entry->has_pending_last_access_time = true;
+        m_pending_last_access_times.append({ cache_key, vary_key });
+    }
+
+    if (m_pending_last_access_times.size() >= PENDING_LAST_ACCESS_TIME_FLUSH_THRESHOLD)
+        flush_pending_last_access_times();
+}
+
+void CacheIndex::flush_pending_last_access_times()
+{
+    if (m_pending_last_access_times.is_empty())
+        return;
+
+    auto pending_last_access_times = move(m_pending_last_access_times);
+
+    // NB: If the transaction cannot be started, the updates are still written, just one statement at a time.
+    Database::Database::Transaction transaction { *m_database };
+    auto began_transaction = !transaction.begin().is_error();
+
+    for (auto [cache_key, vary_key] : pending_last_access_times) {
+        auto entry = get_entry(cache_key, vary_key);
+        if (!entry.has_value() || !entry->has_pending_last_access_time)
+            continue;
+
+        m_database->execute_statement(m_statements.update_last_access_time, {}, entry->last_access_time, cache_key, vary_key);
+        entry->has_pending_last_access_time = false;
+    }
+
+    if (began_transaction) {
+        if (auto result = transaction.commit(); result.is_error())
+            dbgln("CacheIndex: Unable to write back last access times: {}", result.error());
+    }
 }
 
 Optional<CacheIndex::Entry const&> CacheIndex::find_entry(u64 cache_key, HeaderList const& request_headers)
@@ -420,6 +460,8 @@ void CacheIndex::delete_entry(u64 cache_key, u64 vary_key)
 
 Requests::CacheSizes CacheIndex::estimate_cache_size_accessed_since(UnixDateTime since)
 {
+    flush_pending_last_access_times();
+
     Requests::CacheSizes sizes;
 
     m_database->execute_statement(
@@ -34,6 +34,7 @@ class CacheIndex {
         UnixDateTime request_time;
         UnixDateTime response_time;
         UnixDateTime last_access_time;
+        bool has_pending_last_access_time { false };
 
         u64 estimated_size() const
         {
@@ -57,6 +58,7 @@ public:
     void update_response_headers(u64 cache_key, u64 vary_key, NonnullRefPtr<HeaderList>);
     void update_associated_data_size(u64 cache_key, u64 vary_key, u64 associated_data_size);
     void update_last_access_time(u64 cache_key, u64 vary_key);
+    void flush_pending_last_access_times();
 
     Requests::CacheSizes estimate_cache_size_accessed_since(UnixDateTime since);
 
@@ -92,6 +94,12 @@ private:
 
     HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>> m_entries;
 
+    struct PendingLastAccessTime {
+        u64 cache_key { 0 };
+        u64 vary_key { 0 };
+    };
+    Vector<PendingLastAccessTime> m_pending_last_access_times;
+
     Limits m_limits;
     u64 m_total_estimated_size { 0 };
 };
@@ -5,6 +5,7 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <LibCore/Directory.h>
 #include <LibCore/EventLoop.h>
@@ -16,9 +17,20 @@
 #include <LibHTTP/Cache/Utilities.h>
 #include <LibURL/URL.h>
 
+#if defined(AK_OS_WINDOWS)
+#    include <AK/Windows.h>
+#else
+#    include <sys/file.h>
+#endif
+
 namespace HTTP {
 
 static constexpr auto INDEX_DATABASE = "INDEX"sv;
+static constexpr auto OWNER_LOCK_FILE = "OWNER.lock"sv;
+
+// The shared bytecode store is not tracked by the cache index, so it is bounded separately.
+static constexpr u64 MAXIMUM_SHARED_JAVASCRIPT_BYTECODE_SIZE = 256 * MiB;
+static constexpr size_t SHARED_JAVASCRIPT_BYTECODE_SOURCE_HASH_SIZE = 32;
 
 static ErrorOr<u64> compute_associated_data_size(LexicalPath const& cache_directory, u64 cache_key, u64 vary_key)
 {
@@ -50,6 +62,78 @@ static constexpr StringView cache_directory_for_mode(DiskCache::Mode mode)
     VERIFY_NOT_REACHED();
 }
 
+// Only one RequestServer may own a cache directory at a time. Its index is read into memory and entries are written
+// without coordinating with other processes, so a second owner would corrupt entries the first one refers to. Returns
+// an empty optional if another process already holds the lock.
+static ErrorOr<Optional<NonnullOwnPtr<Core::File>>> acquire_cache_owner_lock(LexicalPath const& cache_directory)
+{
+    auto lock_file = TRY(Core::File::open(cache_directory.append(OWNER_LOCK_FILE).string(), Core::File::OpenMode::ReadWrite));
+
+#if defined(AK_OS_WINDOWS)
+    OVERLAPPED overlapped {};
+    if (!LockFileEx(to_handle(lock_file->fd()), LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+        if (GetLastError() == ERROR_LOCK_VIOLATION)
+            return OptionalNone {};
+        return Error::from_windows_error();
+    }
+#else
+    if (flock(lock_file->fd(), LOCK_EX | LOCK_NB) < 0) {
+        if (errno == EWOULDBLOCK)
+            return OptionalNone {};
+        return Error::from_syscall("flock"sv, errno);
+    }
+#endif
+
+    return lock_file;
+}
+
+static ErrorOr<void> create_cache_entry_shard_directories(LexicalPath const& cache_directory)
+{
+    for (size_t shard = 0; shard < CACHE_ENTRY_SHARD_COUNT; ++shard)
+        TRY(Core::Directory::create(path_for_cache_entry_shard(cache_directory, static_cast<u8>(shard)), Core::Directory::CreateDirectories::Yes));
+    return {};
+}
+
+// Caches created before entry files were sharded keep them at the top level of the cache directory. Move them into
+// their shard so the index keeps referring to them.
+static void move_unsharded_cache_entry_files(LexicalPath const& cache_directory)
+{
+    Vector<LexicalPath> unsharded_files;
+
+    (void)Core::Directory::for_each_entry(
+        cache_directory.string(),
+        static_cast<Core::DirIterator::Flags>(Core::DirIterator::SkipDots | Core::DirIterator::NoStat),
+        [&](Core::DirectoryEntry const& entry, Core::Directory const& parent) -> ErrorOr<IterationDecision> {
+            if (entry.type != Core::DirectoryEntry::Type::File)
+                return IterationDecision::Continue;
+
+            // Ignore INDEX.db and related files (e.g. the WAL file, INDEX.db-wal).
+            if (entry.name.starts_with(INDEX_DATABASE))
+                return IterationDecision::Continue;
+
+            unsharded_files.append(parent.path().append(entry.name));
+            return IterationDecision::Continue;
+        });
+
+    for (auto const& file : unsharded_files) {
+        auto cache_entry_data = cache_entry_data_for_file(file);
+
+        // Leftover temporary files belong to writes that never completed.
+        if (!cache_entry_data.has_value()) {
+            if (file.extension() == "tmp"sv)
+                (void)FileSystem::remove(file.string(), FileSystem::RecursionMode::Disallowed);
+            continue;
+        }
+
+        auto sharded_path = cache_entry_data->associated_data.has_value()
+            ? path_for_cache_entry_associated_data(cache_directory, cache_entry_data->cache_key, cache_entry_data->vary_key, *cache_entry_data->associated_data)
+            : path_for_cache_entry(cache_directory, cache_entry_data->cache_key, cache_entry_data->vary_key);
+
+        if (auto result = FileSystem::move_file(sharded_path.string(), file.string()); result.is_error())
+            dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to move cache file\033[0m {}: {}", file, result.error());
+    }
+}
+
 ErrorOr<Optional<DiskCache>> DiskCache::create(Mode mode, LexicalPath const& cache_root)
 {
     auto cache_directory = cache_root.append(cache_directory_for_mode(mode));
@@ -60,6 +144,19 @@ ErrorOr<Optional<DiskCache>> DiskCache::create(Mode mode, LexicalPath const& cac
 
     TRY(Core::Directory::create(cache_directory, Core::Directory::CreateDirectories::Yes));
 
+    // NB: Test mode starts each session from an empty cache, so there is nothing another process could share.
+    OwnPtr<Core::File> owner_lock;
+    if (mode == Mode::Normal) {
+        auto lock_file = TRY(acquire_cache_owner_lock(cache_directory));
+        if (!lock_file.has_value()) {
+            dbgln("Disk cache is in use by another RequestServer; disabling disk cache for this session");
+            return OptionalNone {};
+        }
+        owner_lock = lock_file.release_value();
+    }
+
+    TRY(create_cache_entry_shard_directories(cache_directory));
+
     auto database = mode == DiskCache::Mode::Normal
         ? TRY(Database::Database::create(cache_directory.string(), INDEX_DATABASE))
         : TRY(Database::Database::create_memory_backed());
@@ -72,13 +169,16 @@ ErrorOr<Optional<DiskCache>> DiskCache::create(Mode mode, LexicalPath const& cac
         return OptionalNone {};
     }
 
+    move_unsharded_cache_entry_files(cache_directory);
+
     auto index = TRY(CacheIndex::create(database, cache_directory));
-    return DiskCache { mode, move(database), move(cache_directory), move(index) };
+    return DiskCache { mode, move(database), move(owner_lock), move(cache_directory), move(index) };
 }
 
-DiskCache::DiskCache(Mode mode, NonnullRefPtr<Database::Database> database, LexicalPath cache_directory, CacheIndex index)
+DiskCache::DiskCache(Mode mode, NonnullRefPtr<Database::Database> database, OwnPtr<Core::File> owner_lock, LexicalPath cache_directory, CacheIndex index)
     : m_mode(mode)
     , m_database(move(database))
+    , m_owner_lock(move(owner_lock))
     , m_cache_directory(move(cache_directory))
     , m_index(move(index))
 {
@@ -87,7 +187,10 @@ DiskCache::DiskCache(Mode mode, NonnullRefPtr<Database::Database> database, Lexi
 DiskCache::DiskCache(DiskCache&&) = default;
 DiskCache& DiskCache::operator=(DiskCache&&) = default;
 
-DiskCache::~DiskCache() = default;
+DiskCache::~DiskCache()
+{
+    m_index.flush_pending_last_access_times();
+}
 
 Variant<Optional<CacheEntryWriter&>, DiskCache::CacheHasOpenEntry> DiskCache::create_entry(CacheRequest& request, URL::URL const& url, StringView method, HeaderList const& request_headers, UnixDateTime request_start_time)
 {
@@ -204,7 +307,10 @@ Variant<Optional<CacheEntryReader&>, DiskCache::CacheHasOpenEntry> DiskCache::op
         break;
 
     case CacheLifetimeStatus::StaleWhileRevalidate:
-        if (cache_mode_permits_stale_responses(cache_mode)) {
+        if (cache_mode == CacheMode::NoCache && open_mode == OpenMode::Read) {
+            // The request must not be answered with the stale response, e.g. when it's the memory cache revalidating it.
+            TRY(revalidate_cache_entry());
+        } else if (cache_mode_permits_stale_responses(cache_mode)) {
             dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[32;1mOpened expired cache entry for\033[0m {} (lifetime={}s age={}s) ({} bytes)", url, freshness_lifetime.to_seconds(), current_age.to_seconds(), index_entry->data_size);
         } else if (open_mode == OpenMode::Read) {
             dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[36;1mMust revalidate, but may use, cache entry for\033[0m {} (lifetime={}s age={}s)", url, freshness_lifetime.to_seconds(), current_age.to_seconds());
@@ -259,7 +365,7 @@ ErrorOr<bool> DiskCache::store_associated_data(URL::URL const& url, StringView m
         return false;
 
     auto path = path_for_cache_entry_associated_data(m_cache_directory, cache_key, *vary_key, associated_data);
-    auto temporary_path = LexicalPath::join(m_cache_directory.string(), ByteString::formatted("{}.tmp", path.basename()));
+    auto temporary_path = path.parent().append(ByteString::formatted("{}.tmp", path.basename()));
     ArmedScopeGuard remove_temporary_file = [&]() {
         (void)FileSystem::remove(temporary_path.string(), FileSystem::RecursionMode::Disallowed);
     };
@@ -340,6 +446,176 @@ ErrorOr<Optional<CacheEntryBodyFile>> DiskCache::retrieve_associated_data_file(U
     };
 }
 
+// RequestServer cannot check the bytecode itself, but it can check that a blob at least claims to be bytecode for the
+// source it is stored under. This mirrors the header of CacheBlob in LibJS/Rust/src/bytecode_cache.rs: an 8-byte magic,
+// a 4-byte format version and a 1-byte program type, followed by the hash of the source the blob was generated from.
+static bool is_javascript_bytecode_for_source(ReadonlyBytes data, ReadonlyBytes source_hash)
+{
+    static constexpr auto magic = "LBJSBC\0\0"sv;
+    static constexpr size_t source_hash_offset = 13;
+
+    if (data.size() < source_hash_offset + source_hash.size())
+        return false;
+    if (data.slice(0, magic.length()) != magic.bytes())
+        return false;
+    return data.slice(source_hash_offset, source_hash.size()) == source_hash;
+}
+
+ErrorOr<void> DiskCache::store_shared_javascript_bytecode(StringView partition, ReadonlyBytes source_hash, ReadonlyBytes data)
+{
+    if (partition.is_empty() || source_hash.size() != SHARED_JAVASCRIPT_BYTECODE_SOURCE_HASH_SIZE || data.size() > MAXIMUM_SHARED_JAVASCRIPT_BYTECODE_SIZE)
+        return {};
+    if (!is_javascript_bytecode_for_source(data, source_hash))
+        return Error::from_string_literal("Shared JavaScript bytecode does not match its source hash");
+
+    load_shared_javascript_bytecode_files();
+
+    auto directory = path_for_shared_javascript_bytecode_directory(m_cache_directory);
+    TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+
+    // Other WebContent processes may have the existing file mapped, so we write to a temporary file and rename it into
+    // place rather than writing over the mapped file.
+    auto path = path_for_shared_javascript_bytecode(m_cache_directory, partition, source_hash);
+    auto temporary_path = directory.append(ByteString::formatted("{}.tmp", path.basename()));
+    ArmedScopeGuard remove_temporary_file = [&]() {
+        (void)FileSystem::remove(temporary_path.string(), FileSystem::RecursionMode::Disallowed);
+    };
+
+    {
+        auto file = TRY(Core::File::open(temporary_path.string(), Core::File::OpenMode::Write));
+        TRY(file->write_until_depleted(data));
+    }
+
+    TRY(FileSystem::move_file(path.string(), temporary_path.string()));
+    remove_temporary_file.disarm();
+
+    mark_shared_javascript_bytecode_file_as_used(path.basename(), data.size());
+    remove_shared_javascript_bytecode_exceeding_limit();
+    return {};
+}
+
+ErrorOr<Optional<CacheEntryBodyFile>> DiskCache::retrieve_shared_javascript_bytecode_file(StringView partition, ReadonlyBytes source_hash)
+{
+    if (partition.is_empty() || source_hash.size() != SHARED_JAVASCRIPT_BYTECODE_SOURCE_HASH_SIZE)
+        return Optional<CacheEntryBodyFile> {};
+
+    load_shared_javascript_bytecode_files();
+
+    auto path = path_for_shared_javascript_bytecode(m_cache_directory, partition, source_hash);
+    auto file = Core::File::open(path.string(), Core::File::OpenMode::Read);
+    if (file.is_error()) {
+        if (file.error().is_errno() && file.error().code() == ENOENT)
+            return Optional<CacheEntryBodyFile> {};
+        return file.release_error();
+    }
+
+    auto size = TRY(file.value()->size());
+    if (!AK::is_within_range<u64>(size))
+        return Error::from_errno(EOVERFLOW);
+
+#if !defined(AK_OS_WINDOWS)
+    // Bump the modification time as well, so that a restarted RequestServer evicts files in the same order.
+    (void)Core::System::utimensat(AT_FDCWD, path.string(), nullptr, 0);
+#endif
+    mark_shared_javascript_bytecode_file_as_used(path.basename(), static_cast<u64>(size));
+
+    return CacheEntryBodyFile {
+        .fd = file.value()->leak_fd(),
+        .offset = 0,
+        .size = static_cast<u64>(size),
+    };
+}
+
+void DiskCache::load_shared_javascript_bytecode_files()
+{
+    if (m_shared_javascript_bytecode_files.has_value())
+        return;
+
+    struct SharedBytecodeFile {
+        ByteString name;
+        u64 size { 0 };
+        i64 modification_time { 0 };
+    };
+    Vector<SharedBytecodeFile> files;
+
+    auto directory = path_for_shared_javascript_bytecode_directory(m_cache_directory);
+    (void)Core::Directory::for_each_entry(directory.string(), Core::DirIterator::SkipDots, [&](Core::DirectoryEntry const& entry, Core::Directory const& parent) -> ErrorOr<IterationDecision> {
+        if (entry.type != Core::DirectoryEntry::Type::File)
+            return IterationDecision::Continue;
+
+        auto stat = Core::System::stat(parent.path().append(entry.name).string());
+        if (stat.is_error())
+            return IterationDecision::Continue;
+
+        files.append({ entry.name, static_cast<u64>(stat.value().st_size), static_cast<i64>(stat.value().st_mtime) });
+        return IterationDecision::Continue;
+    });
+
+    // Every use of a file bumps its modification time, so this restores the order the files were last used in.
+    quick_sort(files, [](auto const& a, auto const& b) { return a.modification_time < b.modification_time; });
+
+    m_shared_javascript_bytecode_files = OrderedHashMap<ByteString, u64> {};
+    m_shared_javascript_bytecode_size = 0;
+
+    for (auto& file : files) {
+        m_shared_javascript_bytecode_size += file.size;
+        m_shared_javascript_bytecode_files->set(move(file.name), file.size);
+    }
+}
+
+void DiskCache::mark_shared_javascript_bytecode_file_as_used(ByteString const& name, u64 size)
+{
+    VERIFY(m_shared_javascript_bytecode_files.has_value());
+
+    if (auto previous_size = m_shared_javascript_bytecode_files->take(name); previous_size.has_value())
+        m_shared_javascript_bytecode_size -= *previous_size;
+
+    m_shared_javascript_bytecode_files->set(name, size);
+    m_shared_javascript_bytecode_size += size;
+}
+
+void DiskCache::remove_shared_javascript_bytecode_accessed_since(UnixDateTime since)
+{
+    load_shared_javascript_bytecode_files();
+
+    auto directory = path_for_shared_javascript_bytecode_directory(m_cache_directory);
+    Vector<ByteString> removed_files;
+
+    // Every use of a file bumps its modification time, so that is when the file was last accessed.
+    for (auto const& [name, size] : *m_shared_javascript_bytecode_files) {
+        auto path = directory.append(name);
+        if (auto stat = Core::System::stat(path.string()); !stat.is_error() && UnixDateTime::from_seconds_since_epoch(stat.value().st_mtime) < since)
+            continue;
+
+        (void)FileSystem::remove(path.string(), FileSystem::RecursionMode::Disallowed);
+        m_shared_javascript_bytecode_size -= size;
+        removed_files.append(name);
+    }
+
+    for (auto const& name : removed_files)
+        m_shared_javascript_bytecode_files->remove(name);
+}
+
+void DiskCache::remove_shared_javascript_bytecode_exceeding_limit()
+{
+    VERIFY(m_shared_javascript_bytecode_files.has_value());
+
+    auto directory = path_for_shared_javascript_bytecode_directory(m_cache_directory);
+    Vector<ByteString> removed_files;
+
+    for (auto const& [name, size] : *m_shared_javascript_bytecode_files) {
+        if (m_shared_javascript_bytecode_size <= MAXIMUM_SHARED_JAVASCRIPT_BYTECODE_SIZE)
+            break;
+
+        (void)FileSystem::remove(directory.append(name).string(), FileSystem::RecursionMode::Disallowed);
+        m_shared_javascript_bytecode_size -= size;
+        removed_files.append(name);
+    }
+
+    for (auto const& name : removed_files)
+        m_shared_javascript_bytecode_files->remove(name);
+}
+
 bool DiskCache::check_if_cache_has_open_entry(CacheRequest& request, u64 cache_key, URL::URL const& url, CheckReaderEntries check_reader_entries)
 {
     // FIXME: We purposefully do not use the vary key here, as we do not yet have it when creating a CacheEntryWriter
@@ -391,6 +667,8 @@ void DiskCache::remove_entries_accessed_since(UnixDateTime since)
     m_index.remove_entries_accessed_since(since, [&](auto cache_key, auto vary_key) {
         delete_entry(cache_key, vary_key);
     });
+
+    remove_shared_javascript_bytecode_accessed_since(since);
 }
 
 void DiskCache::cache_entry_closed(Badge<CacheEntry>, CacheEntry const& cache_entry)
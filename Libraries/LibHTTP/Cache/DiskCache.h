@@ -10,10 +10,12 @@
 #include <AK/Error.h>
 #include <AK/LexicalPath.h>
 #include <AK/Optional.h>
+#include <AK/OwnPtr.h>
 #include <AK/StringView.h>
 #include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/WeakPtr.h>
+#include <LibCore/Forward.h>
 #include <LibDatabase/Database.h>
 #include <LibHTTP/Cache/CacheEntry.h>
 #include <LibHTTP/Cache/CacheIndex.h>
@@ -54,6 +56,12 @@ public:
     ErrorOr<Optional<ByteBuffer>> retrieve_associated_data(URL::URL const&, StringView method, HeaderList const& request_headers, Optional<u64> vary_key, CacheEntryAssociatedData);
     ErrorOr<Optional<CacheEntryBodyFile>> retrieve_associated_data_file(URL::URL const&, StringView method, HeaderList const& request_headers, Optional<u64> vary_key, CacheEntryAssociatedData);
 
+    // Bytecode stored here is keyed by a hash of the script's source text rather than by URL, so that identical scripts
+    // served from different URLs (or whose per-URL entry was evicted) can reuse each other's bytecode. The store is
+    // partitioned by the top-level site the script was loaded for.
+    ErrorOr<void> store_shared_javascript_bytecode(StringView partition, ReadonlyBytes source_hash, ReadonlyBytes);
+    ErrorOr<Optional<CacheEntryBodyFile>> retrieve_shared_javascript_bytecode_file(StringView partition, ReadonlyBytes source_hash);
+
     // Ensure an index row exists for url+method so the shelf has something to attach to even if there are no real HTTP requests in flight.
     ErrorOr<bool> create_synthetic_entry(URL::URL const&, StringView method);
 
@@ -68,7 +76,7 @@ public:
     void cache_entry_closed(Badge<CacheEntry>, CacheEntry const&);
 
 private:
-    DiskCache(Mode, NonnullRefPtr<Database::Database>, LexicalPath cache_directory, CacheIndex);
+    DiskCache(Mode, NonnullRefPtr<Database::Database>, OwnPtr<Core::File> owner_lock, LexicalPath cache_directory, CacheIndex);
 
     enum class CheckReaderEntries {
         No,
@@ -77,10 +85,17 @@ private:
     bool check_if_cache_has_open_entry(CacheRequest&, u64 cache_key, URL::URL const&, CheckReaderEntries);
 
     void delete_entry(u64 cache_key, u64 vary_key);
+    void load_shared_javascript_bytecode_files();
+    void mark_shared_javascript_bytecode_file_as_used(ByteString const& name, u64 size);
+    void remove_shared_javascript_bytecode_accessed_since(UnixDateTime since);
+    void remove_shared_javascript_bytecode_exceeding_limit();
 
     Mode m_mode;
     NonnullRefPtr<Database::Database> m_database;
 
+    // Held for the lifetime of the cache to keep other RequestServer processes from using the same cache directory.
+    OwnPtr<Core::File> m_owner_lock;
+
     struct OpenCacheEntry {
         NonnullOwnPtr<CacheEntry> entry;
         WeakPtr<CacheRequest> request;
@@ -90,6 +105,11 @@ private:
 
     LexicalPath m_cache_directory;
     CacheIndex m_index;
+
+    // The files in the shared bytecode store and their sizes, least recently used first. This is loaded from the store
+    // directory on first use.
+    Optional<OrderedHashMap<ByteString, u64>> m_shared_javascript_bytecode_files;
+    u64 m_shared_javascript_bytecode_size { 0 };
 };
 
 }
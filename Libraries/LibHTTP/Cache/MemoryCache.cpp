@@ -10,9 +10,33 @@
 
 namespace HTTP {
 
-NonnullRefPtr<MemoryCache> MemoryCache::create()
+// The protected segment may hold at most this share of the cache, leaving the rest for newly stored responses.
+static constexpr u64 PROTECTED_SEGMENT_PERCENTAGE = 80;
+
+NonnullRefPtr<MemoryCache> MemoryCache::create(u64 maximum_size)
+{
+    return adopt_ref(*new MemoryCache(maximum_size));
+}
+
+MemoryCache::MemoryCache(u64 maximum_size)
+    : m_maximum_size(maximum_size)
+{
+}
+
+static u64 size_of_entry(MemoryCache::Entry const& entry)
+{
+    auto size = static_cast<u64>(entry.response_body.size());
+    if (entry.javascript_bytecode_cache.has_value())
+        size += entry.javascript_bytecode_cache->size();
+    return size;
+}
+
+static u64 size_of_entries(Vector<MemoryCache::Entry> const& entries)
 {
-    return adopt_ref(*new MemoryCache());
+    u64 size = 0;
+    for (auto const& entry : entries)
+        size += size_of_entry(entry);
+    return size;
 }
 
 // A stored response satisfies a request only if the request header fields nominated by the response's Vary header
@@ -24,8 +48,11 @@ static bool entry_matches_request(HeaderList const& request_headers, MemoryCache
 }
 
 // https://httpwg.org/specs/rfc9111.html#constructing.responses.from.caches
-Optional<MemoryCache::Entry const&> MemoryCache::open_entry(URL::URL const& url, StringView method, HeaderList const& request_headers, CacheMode cache_mode)
+Optional<MemoryCache::Entry const&> MemoryCache::open_entry(URL::URL const& url, StringView method, HeaderList const& request_headers, CacheMode cache_mode, RevalidationType* revalidation_type)
 {
+    if (revalidation_type)
+        *revalidation_type = RevalidationType::None;
+
     if (cache_mode == CacheMode::Reload || cache_mode == CacheMode::NoCache)
         return {};
 
@@ -41,6 +68,7 @@ Optional<MemoryCache::Entry const&> MemoryCache::open_entry(URL::URL const& url,
     auto cache_entries = m_complete_entries.get(cache_key);
     if (!cache_entries.has_value()) {
         dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[35;1mNo cache entry for\033[0m {}", url);
+        ++m_statistics.misses;
         return {};
     }
 
@@ -50,6 +78,7 @@ Optional<MemoryCache::Entry const&> MemoryCache::open_entry(URL::URL const& url,
     });
     if (!cache_entry.has_value()) {
         dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[35;1mVary mismatch for\033[0m {}", url);
+        ++m_statistics.misses;
         return {};
     }
 
@@ -65,22 +94,107 @@ Optional<MemoryCache::Entry const&> MemoryCache::open_entry(URL::URL const& url,
     switch (cache_lifetime_status(request_headers, cache_entry->response_headers, freshness_lifetime, current_age)) {
     case CacheLifetimeStatus::Fresh:
         dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[32;1mOpened cache entry for\033[0m {} (lifetime={}s age={}s) ({} bytes)", url, freshness_lifetime.to_seconds(), current_age.to_seconds(), cache_entry->response_body.size());
+        did_open_entries(cache_key);
         return cache_entry;
 
-    case CacheLifetimeStatus::Expired:
-    case CacheLifetimeStatus::MustRevalidate:
     case CacheLifetimeStatus::StaleWhileRevalidate:
-        if (cache_mode_permits_stale_responses(cache_mode)) {
-            dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[32;1mOpened expired cache entry for\033[0m {} (lifetime={}s age={}s) ({} bytes)", url, freshness_lifetime.to_seconds(), current_age.to_seconds(), cache_entry->response_body.size());
+        // The stale response may be used while it is revalidated in the background, if the caller is able to do so. Only
+        // the first caller is asked to revalidate, until a fresh response replaces this one.
+        if (revalidation_type && !cache_mode_permits_stale_responses(cache_mode)) {
+            if (m_revalidating_cache_keys.set(cache_key) == HashSetResult::InsertedNewEntry) {
+                dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[36;1mMust revalidate, but may use, cache entry for\033[0m {} (lifetime={}s age={}s)", url, freshness_lifetime.to_seconds(), current_age.to_seconds());
+                *revalidation_type = RevalidationType::StaleWhileRevalidate;
+            } else {
+                dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[32;1mOpened cache entry under revalidation for\033[0m {} (lifetime={}s age={}s) ({} bytes)", url, freshness_lifetime.to_seconds(), current_age.to_seconds(), cache_entry->response_body.size());
+            }
+
+            did_open_entries(cache_key);
             return cache_entry;
         }
+        break;
 
-        dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[33;1mCache entry expired for\033[0m {} (lifetime={}s age={}s)", url, freshness_lifetime.to_seconds(), current_age.to_seconds());
-        m_complete_entries.remove(cache_key);
-        return {};
+    case CacheLifetimeStatus::Expired:
+    case CacheLifetimeStatus::MustRevalidate:
+        break;
+    }
+
+    if (cache_mode_permits_stale_responses(cache_mode)) {
+        dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[32;1mOpened expired cache entry for\033[0m {} (lifetime={}s age={}s) ({} bytes)", url, freshness_lifetime.to_seconds(), current_age.to_seconds(), cache_entry->response_body.size());
+        did_open_entries(cache_key);
+        return cache_entry;
+    }
+
+    dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[33;1mCache entry expired for\033[0m {} (lifetime={}s age={}s)", url, freshness_lifetime.to_seconds(), current_age.to_seconds());
+    ++m_statistics.misses;
+    remove_complete_entries(cache_key);
+    return {};
+}
+
+void MemoryCache::did_open_entries(u64 cache_key)
+{
+    ++m_statistics.hits;
+
+    // Opening a protected key makes it the most recently used one. Opening a probationary key promotes it, which may in
+    // turn demote the least recently used protected keys back to probation.
+    if (m_protected_cache_keys.remove(cache_key)) {
+        m_protected_cache_keys.set(cache_key);
+        return;
+    }
+
+    if (!m_probationary_cache_keys.remove(cache_key))
+        return;
+
+    m_protected_cache_keys.set(cache_key);
+    m_protected_size += size_of_entries(*m_complete_entries.get(cache_key));
+
+    auto maximum_protected_size = m_maximum_size / 100 * PROTECTED_SEGMENT_PERCENTAGE;
+
+    while (m_protected_size > maximum_protected_size && m_protected_cache_keys.size() > 1) {
+        auto demoted_cache_key = m_protected_cache_keys.take_first();
+        m_protected_size -= size_of_entries(*m_complete_entries.get(demoted_cache_key));
+        m_probationary_cache_keys.set(demoted_cache_key);
     }
+}
+
+void MemoryCache::remove_complete_entries(u64 cache_key)
+{
+    m_revalidating_cache_keys.remove(cache_key);
 
-    VERIFY_NOT_REACHED();
+    auto cache_entries = m_complete_entries.take(cache_key);
+    if (!cache_entries.has_value())
+        return;
+
+    auto size = size_of_entries(*cache_entries);
+    m_statistics.size -= size;
+
+    if (m_protected_cache_keys.remove(cache_key))
+        m_protected_size -= size;
+    else
+        m_probationary_cache_keys.remove(cache_key);
+}
+
+void MemoryCache::evict_entries_if_needed(u64 cache_key_to_keep)
+{
+    auto find_least_recently_used_cache_key = [&](auto& cache_keys) -> Optional<u64> {
+        for (auto cache_key : cache_keys) {
+            if (cache_key != cache_key_to_keep)
+                return cache_key;
+        }
+        return {};
+    };
+
+    while (m_statistics.size > m_maximum_size) {
+        auto cache_key = find_least_recently_used_cache_key(m_probationary_cache_keys);
+        if (!cache_key.has_value())
+            cache_key = find_least_recently_used_cache_key(m_protected_cache_keys);
+        if (!cache_key.has_value())
+            break;
+
+        dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[33;1mEvicting cache entries\033[0m (size={} maximum={})", m_statistics.size, m_maximum_size);
+
+        m_statistics.evictions += m_complete_entries.get(*cache_key)->size();
+        remove_complete_entries(*cache_key);
+    }
 }
 
 void MemoryCache::create_entry(URL::URL const& url, StringView method, HeaderList const& request_headers, UnixDateTime request_time, u32 status_code, ByteString reason_phrase, HeaderList const& response_headers, Optional<Core::ImmutableBytes> javascript_bytecode_cache, Optional<u64> javascript_bytecode_cache_vary_key)
@@ -137,15 +251,45 @@ void MemoryCache::finalize_entry(URL::URL const& url, StringView method, HeaderL
         if (!index.has_value())
             return;
 
-        dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[34;1mFinished caching\033[0m {} ({} bytes)", url, response_body.size());
-
         auto cache_entry = cache_entries->take(*index);
         cache_entry.response_body = move(response_body);
 
         if (cache_entries->is_empty())
             m_pending_entries.remove(cache_key);
 
-        m_complete_entries.ensure(cache_key).append(move(cache_entry));
+        auto entry_size = size_of_entry(cache_entry);
+        if (entry_size > m_maximum_size) {
+            dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[31;1mNot caching oversized response for\033[0m {} ({} bytes)", url, entry_size);
+            return;
+        }
+
+        dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[34;1mFinished caching\033[0m {} ({} bytes)", url, entry_size);
+
+        auto& complete_entries = m_complete_entries.ensure(cache_key);
+        auto is_protected = m_protected_cache_keys.contains(cache_key);
+
+        // A newer response for the same variant replaces the one stored before it, which open_entry() would otherwise
+        // keep selecting.
+        if (auto existing_index = complete_entries.find_first_index_if([&](auto const& entry) { return entry.vary_key == vary_key; }); existing_index.has_value()) {
+            auto existing_size = size_of_entry(complete_entries[*existing_index]);
+            m_statistics.size -= existing_size;
+            if (is_protected)
+                m_protected_size -= existing_size;
+            complete_entries.remove(*existing_index);
+        }
+
+        complete_entries.append(move(cache_entry));
+        m_statistics.size += entry_size;
+        m_revalidating_cache_keys.remove(cache_key);
+
+        if (is_protected) {
+            m_protected_size += entry_size;
+        } else {
+            m_probationary_cache_keys.remove(cache_key);
+            m_probationary_cache_keys.set(cache_key);
+        }
+
+        evict_entries_if_needed(cache_key);
     }
 }
 
@@ -171,8 +315,17 @@ void MemoryCache::update_javascript_bytecode_cache(URL::URL const& url, StringVi
         }
     };
 
-    if (auto cache_entries = m_complete_entries.get(cache_key); cache_entries.has_value())
+    if (auto cache_entries = m_complete_entries.get(cache_key); cache_entries.has_value()) {
+        auto old_size = size_of_entries(*cache_entries);
         update_entries(*cache_entries);
+        auto new_size = size_of_entries(*cache_entries);
+
+        m_statistics.size = m_statistics.size - old_size + new_size;
+        if (m_protected_cache_keys.contains(cache_key))
+            m_protected_size = m_protected_size - old_size + new_size;
+
+        evict_entries_if_needed(cache_key);
+    }
 
     if (auto cache_entries = m_pending_entries.get(cache_key); cache_entries.has_value())
         update_entries(*cache_entries);
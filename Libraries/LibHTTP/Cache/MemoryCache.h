@@ -8,11 +8,13 @@
 
 #include <AK/ByteString.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Time.h>
 #include <LibCore/ImmutableBytes.h>
 #include <LibHTTP/Cache/CacheMode.h>
+#include <LibHTTP/Cache/Utilities.h>
 #include <LibHTTP/Forward.h>
 #include <LibURL/URL.h>
 
@@ -35,17 +37,52 @@ public:
         UnixDateTime response_time;
     };
 
-    static NonnullRefPtr<MemoryCache> create();
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+        u64 size { 0 };
+    };
+
+    enum class RevalidationType {
+        None,
+        StaleWhileRevalidate,
+    };
+
+    static NonnullRefPtr<MemoryCache> create(u64 maximum_size = DEFAULT_MAXIMUM_MEMORY_CACHE_SIZE);
+
+    u64 maximum_size() const { return m_maximum_size; }
+    Statistics const& statistics() const { return m_statistics; }
 
-    Optional<Entry const&> open_entry(URL::URL const&, StringView method, HeaderList const& request_headers, CacheMode);
+    // Callers that are able to revalidate a response in the background should provide revalidation_type. They may then
+    // be handed a stale-while-revalidate response, along with a request to revalidate it.
+    Optional<Entry const&> open_entry(URL::URL const&, StringView method, HeaderList const& request_headers, CacheMode, RevalidationType* revalidation_type = nullptr);
 
     void create_entry(URL::URL const&, StringView method, HeaderList const& request_headers, UnixDateTime request_time, u32 status_code, ByteString reason_phrase, HeaderList const& response_headers, Optional<Core::ImmutableBytes> javascript_bytecode_cache = {}, Optional<u64> javascript_bytecode_cache_vary_key = {});
     void finalize_entry(URL::URL const&, StringView method, HeaderList const& request_headers, u32 status_code, HeaderList const& response_headers, Core::ImmutableBytes response_body);
     void update_javascript_bytecode_cache(URL::URL const&, StringView method, HeaderList const& request_headers, u64 vary_key, Core::ImmutableBytes javascript_bytecode_cache);
 
 private:
+    explicit MemoryCache(u64 maximum_size);
+
+    void did_open_entries(u64 cache_key);
+    void remove_complete_entries(u64 cache_key);
+    void evict_entries_if_needed(u64 cache_key_to_keep);
+
     HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>> m_pending_entries;
     HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>> m_complete_entries;
+
+    // Complete entries are evicted as a segmented LRU over their cache keys, least recently used first. Keys start out
+    // in the probationary segment and are promoted to the protected segment when they are opened again, so a burst of
+    // one-off responses cannot flush out the resources that a page keeps reusing.
+    OrderedHashTable<u64, IdentityHashTraits<u64>> m_probationary_cache_keys;
+    OrderedHashTable<u64, IdentityHashTraits<u64>> m_protected_cache_keys;
+    u64 m_protected_size { 0 };
+
+    HashTable<u64, IdentityHashTraits<u64>> m_revalidating_cache_keys;
+
+    u64 m_maximum_size { 0 };
+    Statistics m_statistics;
 };
 
 }
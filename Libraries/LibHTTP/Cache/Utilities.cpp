@@ -5,13 +5,16 @@
  */
 
 #include <AK/GenericLexer.h>
+#include <AK/Hex.h>
 #include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
 #include <AK/StringConversions.h>
 #include <LibCrypto/Hash/SHA1.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibHTTP/Cache/Utilities.h>
 #include <LibHTTP/HTTP.h>
+#include <LibURL/Parser.h>
 #include <LibURL/URL.h>
 
 namespace HTTP {
@@ -100,13 +103,26 @@ u64 create_vary_key(HeaderList const& request_headers, HeaderList const& respons
     return has_vary_header ? serialize_hash(*hasher) : 0;
 }
 
+LexicalPath path_for_cache_entry_shard(LexicalPath const& cache_directory, u8 shard)
+{
+    return cache_directory.append(ByteString::formatted("{:02x}", shard));
+}
+
+// Entry files are spread over subdirectories named after the top byte of their cache key, so that no one directory
+// has to hold every entry of a large cache.
+static u8 cache_entry_shard(u64 cache_key)
+{
+    static_assert(CACHE_ENTRY_SHARD_COUNT == 256);
+    return static_cast<u8>(cache_key >> 56);
+}
+
 LexicalPath path_for_cache_entry(LexicalPath const& cache_directory, u64 cache_key, u64 vary_key)
 {
     auto file = vary_key == 0
         ? ByteString::formatted("{:016x}", cache_key)
         : ByteString::formatted("{:016x}_{:016x}", cache_key, vary_key);
 
-    return cache_directory.append(file);
+    return path_for_cache_entry_shard(cache_directory, cache_entry_shard(cache_key)).append(file);
 }
 
 static constexpr StringView cache_entry_associated_data_suffix(CacheEntryAssociatedData associated_data)
@@ -116,6 +132,8 @@ static constexpr StringView cache_entry_associated_data_suffix(CacheEntryAssocia
         return "jsbc"sv;
     case CacheEntryAssociatedData::WebAssemblyCompiledCode:
         return "wasmjit"sv;
+    case CacheEntryAssociatedData::DecompressedFont:
+        return "sfnt"sv;
     }
     VERIFY_NOT_REACHED();
 }
@@ -133,7 +151,39 @@ LexicalPath path_for_cache_entry_associated_data(LexicalPath const& cache_direct
         ? ByteString::formatted("{:016x}.{}", cache_key, cache_entry_associated_data_suffix(associated_data))
         : ByteString::formatted("{:016x}_{:016x}.{}", cache_key, vary_key, cache_entry_associated_data_suffix(associated_data));
 
-    return cache_directory.append(file);
+    return path_for_cache_entry_shard(cache_directory, cache_entry_shard(cache_key)).append(file);
+}
+
+LexicalPath path_for_shared_javascript_bytecode_directory(LexicalPath const& cache_directory)
+{
+    return cache_directory.append("SharedBytecode"sv);
+}
+
+LexicalPath path_for_shared_javascript_bytecode(LexicalPath const& cache_directory, StringView partition, ReadonlyBytes source_hash)
+{
+    // The file name is not the source hash itself, so that the same script loaded for two sites has two unrelated files.
+    auto hasher = Crypto::Hash::SHA256::create();
+    hasher->update(partition);
+    hasher->update("\0"sv);
+    hasher->update(source_hash);
+    auto digest = hasher->digest();
+
+    auto file = ByteString::formatted("{}.{}", encode_hex(digest.bytes()), cache_entry_associated_data_suffix(CacheEntryAssociatedData::JavaScriptBytecode));
+    return path_for_shared_javascript_bytecode_directory(cache_directory).append(file);
+}
+
+Optional<URL::URL> synthetic_url_for_decompressed_font(StringView partition, ReadonlyBytes font_hash)
+{
+    // Decompressed fonts hang off a synthetic entry whose URL is derived from the hash of the compressed font. As with
+    // shared bytecode, the top-level site goes into the URL too, so that the same font loaded for two sites has two
+    // unrelated entries.
+    auto hasher = Crypto::Hash::SHA256::create();
+    hasher->update(partition);
+    hasher->update("\0"sv);
+    hasher->update(font_hash);
+    auto digest = hasher->digest();
+
+    return URL::Parser::basic_parse(ByteString::formatted("font-cache://{}", encode_hex(digest.bytes())));
 }
 
 Optional<CacheEntryData> cache_entry_data_for_file(LexicalPath const& cache_file)
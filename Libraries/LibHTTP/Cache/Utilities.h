@@ -8,6 +8,7 @@
 
 #include <AK/Array.h>
 #include <AK/LexicalPath.h>
+#include <AK/Span.h>
 #include <AK/StringView.h>
 #include <AK/Time.h>
 #include <AK/Types.h>
@@ -23,14 +24,17 @@ constexpr inline auto TEST_CACHE_REVALIDATION_STATUS_HEADER = "X-Ladybird-Revali
 constexpr inline auto TEST_CACHE_REQUEST_TIME_OFFSET = "X-Ladybird-Request-Time-Offset"sv;
 
 constexpr inline u64 DEFAULT_MAXIMUM_DISK_CACHE_SIZE = 5 * GiB;
+constexpr inline u64 DEFAULT_MAXIMUM_MEMORY_CACHE_SIZE = 64 * MiB;
 
 enum class CacheEntryAssociatedData {
     JavaScriptBytecode,
     WebAssemblyCompiledCode,
+    DecompressedFont,
 };
 constexpr inline Array CACHE_ENTRY_ASSOCIATED_DATA_TYPES {
     CacheEntryAssociatedData::JavaScriptBytecode,
     CacheEntryAssociatedData::WebAssemblyCompiledCode,
+    CacheEntryAssociatedData::DecompressedFont,
 };
 
 u64 compute_maximum_disk_cache_size(u64 free_bytes, u64 limit_maximum_disk_cache_size = DEFAULT_MAXIMUM_DISK_CACHE_SIZE);
@@ -39,8 +43,13 @@ u64 compute_maximum_disk_cache_entry_size(u64 maximum_disk_cache_size);
 String serialize_url_for_cache_storage(URL::URL const&);
 u64 create_cache_key(StringView url, StringView method);
 u64 create_vary_key(HeaderList const& request_headers, HeaderList const& response_headers);
+static constexpr size_t CACHE_ENTRY_SHARD_COUNT = 256;
+LexicalPath path_for_cache_entry_shard(LexicalPath const& cache_directory, u8 shard);
 LexicalPath path_for_cache_entry(LexicalPath const& cache_directory, u64 cache_key, u64 vary_key);
 LexicalPath path_for_cache_entry_associated_data(LexicalPath const& cache_directory, u64 cache_key, u64 vary_key, CacheEntryAssociatedData);
+LexicalPath path_for_shared_javascript_bytecode_directory(LexicalPath const& cache_directory);
+LexicalPath path_for_shared_javascript_bytecode(LexicalPath const& cache_directory, StringView partition, ReadonlyBytes source_hash);
+Optional<URL::URL> synthetic_url_for_decompressed_font(StringView partition, ReadonlyBytes font_hash);
 
 struct CacheEntryData {
     u64 cache_key { 0 };
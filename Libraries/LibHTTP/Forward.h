@@ -22,6 +22,8 @@ class HttpResponse;
 class MemoryCache;
 
 struct Header;
+struct Link;
+struct Priority;
 
 }
 
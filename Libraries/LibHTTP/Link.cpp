@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <AK/Find.h>
+#include <AK/GenericLexer.h>
+#include <AK/StringBuilder.h>
+#include <LibHTTP/HTTP.h>
+#include <LibHTTP/Link.h>
+
+namespace HTTP {
+
+Optional<StringView> Link::target_attribute(StringView name) const
+{
+    auto it = find_if(target_attributes.begin(), target_attributes.end(), [&](auto const& attribute) {
+        return attribute.name == name;
+    });
+    if (it == target_attributes.end())
+        return {};
+    return it->value.view();
+}
+
+static void consume_optional_whitespace(GenericLexer& lexer)
+{
+    lexer.ignore_while(is_http_tab_or_space);
+}
+
+// https://httpwg.org/specs/rfc8288.html#parse-quoted-string
+static ByteString parse_quoted_string(GenericLexer& lexer)
+{
+    // 1. Let output be an empty string.
+    StringBuilder output;
+
+    // 2. If the first character of input is not DQUOTE, return output.
+    if (!lexer.next_is('"'))
+        return output.to_byte_string();
+
+    // 3. Discard the first character.
+    lexer.ignore();
+
+    // 4. While input has content:
+    while (!lexer.is_eof()) {
+        // 1. If the first character is a backslash ("\"):
+        if (lexer.next_is('\\')) {
+            // 1. Discard the first character.
+            lexer.ignore();
+
+            // 2. If there is no more input, return output.
+            if (lexer.is_eof())
+                return output.to_byte_string();
+
+            // 3. Else, consume the first character and append it to output.
+            output.append(lexer.consume());
+        }
+        // 2. Else, if the first character is DQUOTE, discard it and return output.
+        else if (lexer.next_is('"')) {
+            lexer.ignore();
+            return output.to_byte_string();
+        }
+        // 3. Else, consume the first character and append it to output.
+        else {
+            output.append(lexer.consume());
+        }
+    }
+
+    // 5. Return output.
+    return output.to_byte_string();
+}
+
+// https://httpwg.org/specs/rfc8288.html#parse-param
+static Vector<Link::TargetAttribute> parse_parameters(GenericLexer& lexer)
+{
+    // 1. Let parameters be an empty list.
+    Vector<Link::TargetAttribute> parameters;
+
+    // 2. While input has content:
+    while (!lexer.is_eof()) {
+        // 1. Consume any leading OWS.
+        consume_optional_whitespace(lexer);
+
+        // 2. If the first character is not ";", return parameters.
+        if (!lexer.next_is(';'))
+            return parameters;
+
+        // 3. Discard the leading ";" character.
+        lexer.ignore();
+
+        // 4. Consume any leading OWS.
+        consume_optional_whitespace(lexer);
+
+        // 5. Consume up to but not including the first BWS, "=", ";", or "," character, or up to the end of input,
+        //    and let the result be parameter_name.
+        auto parameter_name = lexer.consume_until([](char ch) {
+            return is_http_tab_or_space(ch) || ch == '=' || ch == ';' || ch == ',';
+        });
+
+        // 6. Consume any leading BWS.
+        consume_optional_whitespace(lexer);
+
+        ByteString parameter_value;
+
+        // 7. If the next character is "=":
+        if (lexer.next_is('=')) {
+            // 1. Discard the leading "=" character.
+            lexer.ignore();
+
+            // 2. Consume any leading BWS.
+            consume_optional_whitespace(lexer);
+
+            // 3. If the next character is DQUOTE, let parameter_value be the result of Parsing a Quoted String from
+            //    input (consuming zero or more characters of it).
+            if (lexer.next_is('"')) {
+                parameter_value = parse_quoted_string(lexer);
+            }
+            // 4. Else, consume the contents up to but not including the first ";" or "," character, or up to the end
+            //    of input, and let the results be parameter_value.
+            else {
+                // AD-HOC: Trailing OWS before the ";" or "," is not part of the value.
+                parameter_value = lexer.consume_until([](char ch) { return ch == ';' || ch == ','; }).trim(HTTP_TAB_OR_SPACE, TrimMode::Right);
+            }
+
+            // FIXME: 5. If the last character of parameter_name is an asterisk ("*"), decode parameter_value according
+            //           to [RFC8187]. Continue processing input if an unrecoverable error is encountered.
+        }
+        // 8. Else:
+        //    1. Let parameter_value be an empty string.
+
+        // 9. Case-normalize parameter_name to lowercase.
+        // 10. Append (parameter_name, parameter_value) to parameters.
+        parameters.append({ ByteString { parameter_name }.to_lowercase(), move(parameter_value) });
+
+        // 11. Consume any leading OWS.
+        consume_optional_whitespace(lexer);
+
+        // 12. If the next character is "," or the end of input, stop processing input and return parameters.
+        if (lexer.is_eof() || lexer.next_is(','))
+            return parameters;
+    }
+
+    return parameters;
+}
+
+// https://httpwg.org/specs/rfc8288.html#parse-fv
+Vector<Link> parse_link_field_value(StringView field_value)
+{
+    // 1. Let links be an empty list.
+    Vector<Link> links;
+
+    // 2. Create a field_value that is the concatenation of all Link header field values.
+    // NB: The caller passes the combined value of the header list's Link headers.
+    GenericLexer lexer { field_value };
+
+    // 3. While field_value has content:
+    while (!lexer.is_eof()) {
+        // 1. Consume any leading OWS.
+        consume_optional_whitespace(lexer);
+
+        // 2. If the first character is not "<", return links.
+        if (!lexer.next_is('<'))
+            return links;
+
+        // 3. Discard the first character ("<").
+        lexer.ignore();
+
+        // 4. Consume up to but not including the first ">" character or end of field_value and let the result be
+        //    target_string.
+        auto target_string = lexer.consume_until('>');
+
+        // 5. If the next character is not ">", return links.
+        if (!lexer.next_is('>'))
+            return links;
+
+        // 6. Discard the leading ">" character.
+        lexer.ignore();
+
+        // 7. Let link_parameters be the result of Parsing Parameters from field_value (consuming zero or more
+        //    characters of it).
+        auto link_parameters = parse_parameters(lexer);
+
+        // 8. Let target_uri be the result of relatively resolving (as per [RFC3986], Section 5.2) target_string.
+        // NB: This is left to the caller, see Link::target.
+
+        // 9. Let relations_string be the second item of the first tuple of link_parameters whose first item matches
+        //    the string "rel" or the empty string ("") if it is not present.
+        StringView relations_string;
+        if (auto it = find_if(link_parameters.begin(), link_parameters.end(), [](auto const& parameter) { return parameter.name == "rel"sv; }); it != link_parameters.end())
+            relations_string = it->value;
+
+        // 10. Split relations_string on RWS (removing it in the process) into a list of string relation_types.
+        auto relation_types = relations_string.split_view_if([](char ch) { return is_http_tab_or_space(ch); });
+
+        // FIXME: 11. Let context_string be the second item of the first tuple of link_parameters whose first item matches
+        //            the string "anchor". If it is not present, context_string is the URL of the representation
+        //            carrying the Link header [RFC7231], serialized as a URI. Where the URL is anonymous, context_string
+        //            is null.
+        // FIXME: 12. Let context_uri be the result of relatively resolving context_string, unless context_string is
+        //            null, in which case context is null.
+
+        // 13. Let target_attributes be an empty list.
+        Vector<Link::TargetAttribute> target_attributes;
+
+        // 14. For each tuple (param_name, param_value) of link_parameters:
+        for (auto& parameter : link_parameters) {
+            // 1. If param_name matches "rel" or "anchor", skip this tuple.
+            if (parameter.name.is_one_of("rel"sv, "anchor"sv))
+                continue;
+
+            // 2. If param_name matches "media", "title", "title*", or "type" and target_attributes already contains
+            //    a tuple whose first element matches the value of param_name, skip this tuple.
+            if (parameter.name.is_one_of("media"sv, "title"sv, "title*"sv, "type"sv)
+                && any_of(target_attributes, [&](auto const& attribute) { return attribute.name == parameter.name; })) {
+                continue;
+            }
+
+            // 3. Append (param_name, param_value) to target_attributes.
+            target_attributes.append(move(parameter));
+        }
+
+        // FIXME: 15. Let star_param_names be the set of param_names in the (param_name, param_value) tuples of
+        //            target_attributes where the last character of param_name is an asterisk ("*").
+        // FIXME: 16. For each star_param_name in star_param_names: ...
+
+        // 17. For each relation_type in relation_types:
+        for (auto relation_type : relation_types) {
+            // 1. Case-normalize relation_type to lowercase.
+            // 2. Append a link object to links with the target target_uri, relation type of relation_type, context
+            //    of context_uri, and target attributes target_attributes.
+            links.append({ target_string, ByteString { relation_type }.to_lowercase(), target_attributes });
+        }
+
+        // AD-HOC: Discard the "," that separates this link-value from the next. As written, the algorithm stops parsing
+        //         at it.
+        lexer.consume_specific(',');
+    }
+
+    // 4. Return links.
+    return links;
+}
+
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace HTTP {
+
+// https://httpwg.org/specs/rfc8288.html#link-objects
+struct Link {
+    struct TargetAttribute {
+        ByteString name;
+        ByteString value;
+    };
+
+    Optional<StringView> target_attribute(StringView name) const;
+
+    // NB: The target is not resolved against the URL of the representation carrying the Link field, as only the
+    //     caller knows which URL that is.
+    ByteString target;
+    ByteString relation_type;
+    Vector<TargetAttribute> target_attributes;
+};
+
+// https://httpwg.org/specs/rfc8288.html#parse-fv
+Vector<Link> parse_link_field_value(StringView);
+
+}
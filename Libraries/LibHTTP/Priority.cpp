@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibHTTP/Priority.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+
+namespace HTTP {
+
+// https://httpwg.org/specs/rfc9218.html#header-field
+ByteString Priority::serialize() const
+{
+    // Parameters whose value is the default may be omitted.
+    StringBuilder builder;
+
+    if (urgency != DEFAULT_URGENCY)
+        builder.appendff("u={}", urgency);
+
+    if (incremental) {
+        if (!builder.is_empty())
+            builder.append(", "sv);
+        builder.append('i');
+    }
+
+    return builder.to_byte_string();
+}
+
+}
+
+namespace IPC {
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, HTTP::Priority const& priority)
+{
+    TRY(encoder.encode(priority.urgency));
+    TRY(encoder.encode(priority.incremental));
+
+    return {};
+}
+
+template<>
+ErrorOr<HTTP::Priority> decode(Decoder& decoder)
+{
+    auto urgency = TRY(decoder.decode<u8>());
+    auto incremental = TRY(decoder.decode<bool>());
+
+    if (urgency > HTTP::Priority::LOWEST_URGENCY)
+        return Error::from_string_literal("Invalid HTTP priority urgency");
+
+    return HTTP::Priority { urgency, incremental };
+}
+
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Types.h>
+#include <LibIPC/Forward.h>
+
+namespace HTTP {
+
+// https://httpwg.org/specs/rfc9218.html#parameters
+struct Priority {
+    static constexpr u8 DEFAULT_URGENCY = 3;
+    static constexpr u8 LOWEST_URGENCY = 7;
+
+    // https://httpwg.org/specs/rfc9218.html#urgency
+    u8 urgency { DEFAULT_URGENCY };
+
+    // https://httpwg.org/specs/rfc9218.html#incremental
+    bool incremental { false };
+
+    bool is_default() const { return urgency == DEFAULT_URGENCY && !incremental; }
+
+    // https://httpwg.org/specs/rfc9218.html#header-field
+    ByteString serialize() const;
+
+    bool operator==(Priority const&) const = default;
+};
+
+}
+
+namespace IPC {
+
+template<>
+ErrorOr<void> encode(Encoder&, HTTP::Priority const&);
+
+template<>
+ErrorOr<HTTP::Priority> decode(Decoder&);
+
+}
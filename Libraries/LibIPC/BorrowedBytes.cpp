@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/ImmutableBytes.h>
+#include <LibIPC/BorrowedBytes.h>
+
+namespace IPC {
+
+BorrowedBytes::BorrowedBytes(ReceivedMessageBytes message_bytes, size_t offset, size_t size)
+    : m_message_bytes(move(message_bytes))
+{
+    auto bytes = m_message_bytes.bytes();
+    VERIFY(offset <= bytes.size() && size <= bytes.size() - offset);
+    m_bytes = bytes.slice(offset, size);
+}
+
+class BorrowedBytesStorage final : public Core::ImmutableBytes::ExternalStorage {
+public:
+    explicit BorrowedBytesStorage(BorrowedBytes bytes)
+        : m_bytes(move(bytes))
+    {
+    }
+
+    virtual ReadonlyBytes bytes() const override { return m_bytes.bytes(); }
+
+private:
+    BorrowedBytes m_bytes;
+};
+
+Core::ImmutableBytes BorrowedBytes::to_immutable_bytes() const
+{
+    if (is_empty())
+        return Core::ImmutableBytes::adopt(ByteBuffer {});
+    return Core::ImmutableBytes::adopt_external_storage(adopt_ref(*new BorrowedBytesStorage(*this)));
+}
+
+}
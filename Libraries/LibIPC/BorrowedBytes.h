@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Span.h>
+#include <LibCore/Forward.h>
+#include <LibIPC/ReceivedMessageBytes.h>
+
+namespace IPC {
+
+// A byte payload that is decoded as a view into the received message, rather than being copied out of it. The view
+// keeps the whole message alive, so it's meant for large payloads that the handler reads from or passes along.
+// It's encoded the same way as a ByteBuffer.
+class BorrowedBytes {
+public:
+    BorrowedBytes() = default;
+    BorrowedBytes(ReceivedMessageBytes message_bytes, size_t offset, size_t size);
+
+    [[nodiscard]] ReadonlyBytes bytes() const LIFETIME_BOUND { return m_bytes; }
+    [[nodiscard]] size_t size() const { return m_bytes.size(); }
+    [[nodiscard]] bool is_empty() const { return m_bytes.is_empty(); }
+
+    operator ReadonlyBytes() const&& = delete;
+    operator ReadonlyBytes() const& LIFETIME_BOUND { return m_bytes; }
+
+    [[nodiscard]] ErrorOr<ByteBuffer> to_byte_buffer() const { return ByteBuffer::copy(m_bytes); }
+
+    // Shares the received message with the returned bytes instead of copying the payload.
+    [[nodiscard]] Core::ImmutableBytes to_immutable_bytes() const;
+
+private:
+    ReceivedMessageBytes m_message_bytes;
+    ReadonlyBytes m_bytes;
+};
+
+}
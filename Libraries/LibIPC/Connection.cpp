@@ -7,8 +7,11 @@
  */
 
 #include <AK/Vector.h>
+#include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/Statistics.h>
 #include <LibIPC/Stub.h>
 
 namespace IPC {
@@ -38,6 +41,12 @@ ErrorOr<void> ConnectionBase::post_message(Message const& message)
     return post_message(buffer);
 }
 
+// Messages are held back for coalescing for about a frame, so that the peer handles a burst of them at once.
+static constexpr int COALESCED_MESSAGE_FLUSH_INTERVAL_MS = 16;
+
+// Holding back more messages than this would only make the peer handle them later, so they're sent right away.
+static constexpr size_t MAX_COALESCED_MESSAGE_COUNT = 256;
+
 ErrorOr<void> ConnectionBase::post_message(MessageBuffer& buffer)
 {
     // NOTE: If this connection is being shut down, but has not yet been destroyed,
@@ -45,11 +54,56 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer& buffer)
     if (!m_transport->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
+    if (buffer.coalescing() != MessageCoalescing::None) {
+        // NB: The replaced message is removed rather than overwritten, so that the new one is also ordered after the
+        //     other held back messages. A did_hover_link() that follows a did_unhover_link() must not end up before it.
+        m_coalesced_messages.remove_first_matching([&](auto const& queued_buffer) { return buffer.replaces(queued_buffer); });
+        m_coalesced_messages.append(move(buffer));
+
+        if (m_coalesced_messages.size() >= MAX_COALESCED_MESSAGE_COUNT)
+            return flush_coalesced_messages();
+
+        if (!m_coalesced_message_flush_timer) {
+            m_coalesced_message_flush_timer = Core::Timer::create_single_shot(COALESCED_MESSAGE_FLUSH_INTERVAL_MS, [this] {
+                if (!is_open())
+                    return;
+                if (auto result = flush_coalesced_messages(); result.is_error())
+                    dbgln("IPC::ConnectionBase::flush_coalesced_messages: {}", result.error());
+            });
+        }
+        if (!m_coalesced_message_flush_timer->is_active())
+            m_coalesced_message_flush_timer->start();
+
+        return {};
+    }
+
+    // The held back messages were sent before this one, so they're delivered before it too.
+    TRY(flush_coalesced_messages());
+
+    if (Statistics::is_enabled())
+        Statistics::the().did_send_message(buffer.data().size());
+
     TRY(buffer.transfer_message(*m_transport));
 
     return {};
 }
 
+ErrorOr<void> ConnectionBase::flush_coalesced_messages()
+{
+    if (m_coalesced_message_flush_timer)
+        m_coalesced_message_flush_timer->stop();
+
+    auto coalesced_messages = move(m_coalesced_messages);
+    for (auto& buffer : coalesced_messages) {
+        if (Statistics::is_enabled())
+            Statistics::the().did_send_message(buffer.data().size());
+
+        TRY(buffer.transfer_message(*m_transport));
+    }
+
+    return {};
+}
+
 void ConnectionBase::shutdown()
 {
     m_transport->close();
@@ -62,9 +116,36 @@ void ConnectionBase::shutdown_with_error(Error const& error)
     shutdown();
 }
 
+// Low-priority messages that arrived in the same batch as normal-priority ones are handled last, keeping the order
+// within each priority.
+static Vector<NonnullOwnPtr<Message>> order_messages_by_priority(Vector<NonnullOwnPtr<Message>> messages)
+{
+    size_t low_priority_message_count = 0;
+    for (auto const& message : messages) {
+        if (message->priority() == MessagePriority::Low)
+            ++low_priority_message_count;
+    }
+    if (low_priority_message_count == 0 || low_priority_message_count == messages.size())
+        return messages;
+
+    Vector<NonnullOwnPtr<Message>> ordered_messages;
+    Vector<NonnullOwnPtr<Message>> low_priority_messages;
+    ordered_messages.ensure_capacity(messages.size());
+    low_priority_messages.ensure_capacity(low_priority_message_count);
+
+    for (auto& message : messages) {
+        if (message->priority() == MessagePriority::Low)
+            low_priority_messages.unchecked_append(move(message));
+        else
+            ordered_messages.unchecked_append(move(message));
+    }
+    ordered_messages.extend(move(low_priority_messages));
+    return ordered_messages;
+}
+
 void ConnectionBase::handle_messages()
 {
-    auto messages = move(m_unprocessed_messages);
+    auto messages = order_messages_by_priority(move(m_unprocessed_messages));
     for (auto& message : messages) {
         if (message->endpoint_magic() != m_local_endpoint_magic)
             continue;
@@ -72,7 +153,18 @@ void ConnectionBase::handle_messages()
         if (!is_open())
             dbgln("Handling message while connection closed: {}", message->message_name());
 
+        auto received_time = message->received_time();
+        auto message_name = message->message_name();
+        Optional<MonotonicTime> handler_start_time;
+        if (received_time.has_value())
+            handler_start_time = MonotonicTime::now();
+
+        TRACE_EVENT(IPC, message_name);
         auto handler_result = m_local_stub.handle(move(message));
+
+        if (handler_start_time.has_value())
+            Statistics::the().did_handle_message(message_name, *received_time, *handler_start_time, MonotonicTime::now());
+
         if (handler_result.is_error()) {
             dbgln("IPC::ConnectionBase::handle_messages: {}", handler_result.error());
             continue;
@@ -97,11 +189,14 @@ ConnectionBase::PeerEOF ConnectionBase::drain_messages_from_peer()
 {
     bool parse_error = false;
     auto schedule_shutdown = m_transport->read_as_many_messages_as_possible_without_blocking([&](auto&& raw_message) {
-        auto bytes = raw_message.bytes.bytes();
-        if (auto message = try_parse_message(bytes, raw_message.attachments)) {
+        if (auto message = try_parse_message(raw_message.bytes, raw_message.attachments)) {
+            if (Statistics::is_enabled()) {
+                message->set_received_time(MonotonicTime::now());
+                Statistics::the().did_receive_message(message->message_name(), raw_message.bytes.bytes().size());
+            }
             m_unprocessed_messages.append(message.release_nonnull());
         } else {
-            dbgln("Failed to parse IPC message {:hex-dump}", bytes);
+            dbgln("Failed to parse IPC message {:hex-dump}", raw_message.bytes.bytes());
             parse_error = true;
         }
     });
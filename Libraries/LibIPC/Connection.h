@@ -28,6 +28,10 @@ public:
     ErrorOr<void> post_message(Message const&);
     ErrorOr<void> post_message(MessageBuffer&);
 
+    // Sends the messages that are held back for coalescing. This happens by itself before any other message is sent, and
+    // otherwise once per frame.
+    ErrorOr<void> flush_coalesced_messages();
+
     void shutdown();
     virtual void die() { }
 
@@ -37,7 +41,7 @@ protected:
     explicit ConnectionBase(IPC::Stub&, NonnullOwnPtr<Transport>, u32 local_endpoint_magic);
 
     virtual void shutdown_with_error(Error const&);
-    virtual OwnPtr<Message> try_parse_message(ReadonlyBytes, Queue<Attachment>&) = 0;
+    virtual OwnPtr<Message> try_parse_message(ReceivedMessageBytes const&, Queue<Attachment>&) = 0;
 
     OwnPtr<IPC::Message> wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id);
     void wait_for_transport_to_become_readable();
@@ -55,6 +59,9 @@ protected:
 
     Vector<NonnullOwnPtr<Message>> m_unprocessed_messages;
 
+    Vector<MessageBuffer> m_coalesced_messages;
+    RefPtr<Core::Timer> m_coalesced_message_flush_timer;
+
     u32 m_local_endpoint_magic { 0 };
 };
 
@@ -92,7 +99,7 @@ protected:
         return {};
     }
 
-    virtual OwnPtr<Message> try_parse_message(ReadonlyBytes bytes, Queue<Attachment>& attachments) override
+    virtual OwnPtr<Message> try_parse_message(ReceivedMessageBytes const& bytes, Queue<Attachment>& attachments) override
     {
         auto local_message = LocalEndpoint::decode_message(bytes, attachments);
         if (!local_message.is_error())
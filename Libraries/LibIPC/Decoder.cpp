@@ -12,6 +12,7 @@
 #include <AK/Utf16FlyString.h>
 #include <AK/Utf16String.h>
 #include <LibCore/AnonymousBuffer.h>
+#include <LibCore/ImmutableBytes.h>
 #include <LibCore/Proxy.h>
 #include <LibIPC/Decoder.h>
 #include <LibIPC/File.h>
@@ -32,6 +33,24 @@ ErrorOr<size_t> Decoder::decode_size()
     return size;
 }
 
+ErrorOr<BorrowedBytes> Decoder::decode_borrowed_bytes(size_t size)
+{
+    if (size == 0)
+        return BorrowedBytes {};
+
+    if (m_message_bytes) {
+        auto offset = m_message_stream->offset();
+        TRY(m_message_stream->discard(size));
+        return BorrowedBytes { *m_message_bytes, offset, size };
+    }
+
+    // NB: Without a received message to refer to, the bytes have to be copied out of the stream.
+    Vector<u8> bytes;
+    TRY(bytes.try_resize(size));
+    TRY(m_stream.read_until_filled(bytes));
+    return BorrowedBytes { ReceivedMessageBytes::from_vector(move(bytes)), 0, size };
+}
+
 template<>
 ErrorOr<String> decode(Decoder& decoder)
 {
@@ -82,6 +101,20 @@ ErrorOr<ByteBuffer> decode(Decoder& decoder)
     return buffer;
 }
 
+template<>
+ErrorOr<BorrowedBytes> decode(Decoder& decoder)
+{
+    auto length = TRY(decoder.decode_size());
+    return decoder.decode_borrowed_bytes(length);
+}
+
+template<>
+ErrorOr<Core::ImmutableBytes> decode(Decoder& decoder)
+{
+    auto bytes = TRY(decoder.decode<BorrowedBytes>());
+    return bytes.to_immutable_bytes();
+}
+
 template<>
 ErrorOr<JsonValue> decode(Decoder& decoder)
 {
@@ -10,6 +10,7 @@
 #include <AK/ByteString.h>
 #include <AK/Concepts.h>
 #include <AK/Forward.h>
+#include <AK/MemoryStream.h>
 #include <AK/Queue.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Stream.h>
@@ -21,6 +22,7 @@
 #include <AK/Variant.h>
 #include <LibCore/Forward.h>
 #include <LibIPC/Attachment.h>
+#include <LibIPC/BorrowedBytes.h>
 #include <LibIPC/Concepts.h>
 #include <LibIPC/File.h>
 #include <LibIPC/Forward.h>
@@ -44,6 +46,15 @@ public:
     {
     }
 
+    // Decodes a received message from a stream over its bytes, which lets BorrowedBytes refer to them without copying.
+    Decoder(FixedMemoryStream& stream, Queue<Attachment>& attachments, ReceivedMessageBytes const& message_bytes)
+        : m_stream(stream)
+        , m_attachments(attachments)
+        , m_message_stream(&stream)
+        , m_message_bytes(&message_bytes)
+    {
+    }
+
     template<typename T>
     ErrorOr<T> decode();
 
@@ -61,6 +72,7 @@ public:
     }
 
     ErrorOr<size_t> decode_size();
+    ErrorOr<BorrowedBytes> decode_borrowed_bytes(size_t size);
 
     Stream& stream() { return m_stream; }
     Queue<Attachment>& attachments() { return m_attachments; }
@@ -68,6 +80,9 @@ public:
 private:
     Stream& m_stream;
     Queue<Attachment>& m_attachments;
+
+    FixedMemoryStream* m_message_stream { nullptr };
+    ReceivedMessageBytes const* m_message_bytes { nullptr };
 };
 
 template<Arithmetic T>
@@ -106,6 +121,12 @@ ErrorOr<ByteString> decode(Decoder&);
 template<>
 ErrorOr<ByteBuffer> decode(Decoder&);
 
+template<>
+ErrorOr<BorrowedBytes> decode(Decoder&);
+
+template<>
+ErrorOr<Core::ImmutableBytes> decode(Decoder&);
+
 template<>
 ErrorOr<JsonValue> decode(Decoder&);
 
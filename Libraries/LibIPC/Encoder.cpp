@@ -18,8 +18,10 @@
 #include <AK/Utf16String.h>
 #include <AK/Utf16View.h>
 #include <LibCore/AnonymousBuffer.h>
+#include <LibCore/ImmutableBytes.h>
 #include <LibCore/Proxy.h>
 #include <LibIPC/Attachment.h>
+#include <LibIPC/BorrowedBytes.h>
 #include <LibIPC/Encoder.h>
 #include <LibIPC/File.h>
 #include <LibURL/Origin.h>
@@ -101,6 +103,18 @@ ErrorOr<void> encode(Encoder& encoder, ByteBuffer const& value)
     return {};
 }
 
+template<>
+ErrorOr<void> encode(Encoder& encoder, BorrowedBytes const& value)
+{
+    return encoder.encode(value.bytes());
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Core::ImmutableBytes const& value)
+{
+    return encoder.encode(value.bytes());
+}
+
 template<>
 ErrorOr<void> encode(Encoder& encoder, JsonValue const& value)
 {
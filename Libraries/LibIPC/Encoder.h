@@ -110,6 +110,12 @@ ErrorOr<void> encode(Encoder&, ByteString const&);
 template<>
 ErrorOr<void> encode(Encoder&, ByteBuffer const&);
 
+template<>
+ErrorOr<void> encode(Encoder&, BorrowedBytes const&);
+
+template<>
+ErrorOr<void> encode(Encoder&, Core::ImmutableBytes const&);
+
 template<>
 ErrorOr<void> encode(Encoder&, JsonValue const&);
 
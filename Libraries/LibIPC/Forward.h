@@ -13,11 +13,13 @@ namespace IPC {
 
 class Attachment;
 class AutoCloseFileDescriptor;
+class BorrowedBytes;
 class Decoder;
 class Encoder;
 class Message;
 class MessageBuffer;
 class File;
+class ReceivedMessageBytes;
 class Stub;
 class TransportHandle;
 
@@ -41,4 +43,22 @@ ErrorOr<T> decode(Decoder&);
 
 using MessageDataType = Vector<u8, 1024>;
 
+enum class MessagePriority : u8 {
+    Normal,
+    // May be overtaken by normal-priority messages that are queued on the same connection after it. Set by
+    // [Priority=low] in an endpoint definition, which is only meant for background messages that nothing sent after
+    // them depends on. Messages of the same priority are always delivered in the order they were sent in.
+    Low,
+};
+
+enum class MessageCoalescing : u8 {
+    None,
+    // Held back for up to a frame, and replaces any queued message of the same type for the same key (the message's
+    // first parameter). Set by [Coalesce=latest] in an endpoint definition, which is meant for messages that report the
+    // current value of some state.
+    Latest,
+    // Held back for up to a frame and sent together with the other held back messages. Set by [Coalesce=batch].
+    Batch,
+};
+
 }
@@ -8,7 +8,9 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/Optional.h>
 #include <AK/StringView.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
 #include <LibIPC/Attachment.h>
 #include <LibIPC/Forward.h>
@@ -42,9 +44,31 @@ public:
     Vector<Attachment> const& attachments() const { return m_attachments; }
     Vector<Attachment> take_attachments() { return move(m_attachments); }
 
+    MessagePriority priority() const { return m_priority; }
+    void set_priority(MessagePriority priority) { m_priority = priority; }
+
+    MessageCoalescing coalescing() const { return m_coalescing; }
+    void set_coalescing(MessageCoalescing coalescing, i32 message_id, u64 coalescing_key = 0)
+    {
+        m_coalescing = coalescing;
+        m_message_id = message_id;
+        m_coalescing_key = coalescing_key;
+    }
+
+    bool replaces(MessageBuffer const& other) const
+    {
+        return m_coalescing == MessageCoalescing::Latest && other.m_coalescing == MessageCoalescing::Latest
+            && m_message_id == other.m_message_id && m_coalescing_key == other.m_coalescing_key;
+    }
+
 private:
     MessageDataType m_data;
     Vector<Attachment> m_attachments;
+    MessagePriority m_priority { MessagePriority::Normal };
+
+    MessageCoalescing m_coalescing { MessageCoalescing::None };
+    i32 m_message_id { 0 };
+    u64 m_coalescing_key { 0 };
 };
 
 enum class ErrorCode : u32 {
@@ -61,10 +85,18 @@ public:
     virtual u32 endpoint_magic() const = 0;
     virtual int message_id() const = 0;
     virtual StringView message_name() const = 0;
+    virtual MessagePriority priority() const { return MessagePriority::Normal; }
     virtual ErrorOr<MessageBuffer> encode() const = 0;
 
+    // Only recorded while IPC statistics are enabled.
+    Optional<MonotonicTime> received_time() const { return m_received_time; }
+    void set_received_time(MonotonicTime received_time) { m_received_time = received_time; }
+
 protected:
     Message() = default;
+
+private:
+    Optional<MonotonicTime> m_received_time;
 };
 
 }
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibIPC/Statistics.h>
+
+namespace IPC {
+
+bool Statistics::s_enabled = false;
+
+void Statistics::set_enabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+Statistics& Statistics::the()
+{
+    static Statistics statistics;
+    return statistics;
+}
+
+Statistics::Statistics()
+    : m_start_time(MonotonicTime::now())
+{
+}
+
+void Statistics::did_send_message(size_t bytes)
+{
+    Sync::MutexLocker locker(m_mutex);
+    ++m_sent_message_count;
+    m_sent_bytes += bytes;
+}
+
+void Statistics::did_receive_message(StringView message_name, size_t bytes)
+{
+    Sync::MutexLocker locker(m_mutex);
+    ++m_received_message_count;
+    m_received_bytes += bytes;
+
+    auto& statistics = m_messages.ensure(message_name, [&] {
+        return MessageStatistics { .message_name = MUST(String::from_utf8(message_name)) };
+    });
+    ++statistics.count;
+    statistics.bytes += bytes;
+}
+
+void Statistics::did_handle_message(StringView message_name, MonotonicTime received_time, MonotonicTime handler_start_time, MonotonicTime handler_end_time)
+{
+    auto queueing_delay = handler_start_time - received_time;
+    auto handler_time = handler_end_time - handler_start_time;
+
+    Sync::MutexLocker locker(m_mutex);
+
+    if (auto statistics = m_messages.get(message_name); statistics.has_value()) {
+        statistics->total_queueing_delay += queueing_delay;
+        statistics->longest_queueing_delay = max(statistics->longest_queueing_delay, queueing_delay);
+
+        ++statistics->handled_count;
+        statistics->total_handler_time += handler_time;
+        statistics->longest_handler_time = max(statistics->longest_handler_time, handler_time);
+    }
+
+    m_recent_messages.enqueue({
+        .message_name = message_name,
+        .received_ns = received_time.nanoseconds(),
+        .handler_start_ns = handler_start_time.nanoseconds(),
+        .handler_duration_ns = handler_time.to_nanoseconds(),
+    });
+}
+
+TrafficStatistics Statistics::snapshot() const
+{
+    Sync::MutexLocker locker(m_mutex);
+
+    TrafficStatistics snapshot;
+    snapshot.recording_time = MonotonicTime::now() - m_start_time;
+    snapshot.sent_message_count = m_sent_message_count;
+    snapshot.sent_bytes = m_sent_bytes;
+    snapshot.received_message_count = m_received_message_count;
+    snapshot.received_bytes = m_received_bytes;
+
+    snapshot.messages.ensure_capacity(m_messages.size());
+    for (auto const& it : m_messages)
+        snapshot.messages.unchecked_append(it.value);
+
+    quick_sort(snapshot.messages, [](auto const& lhs, auto const& rhs) {
+        return lhs.total_handler_time > rhs.total_handler_time;
+    });
+
+    return snapshot;
+}
+
+String Statistics::to_trace_event_json(StringView process_name) const
+{
+    // Handlers get one row, and the time each message spent queued before its handler ran gets another.
+    constexpr u64 process_track = 1;
+    constexpr u64 handler_row = 1;
+    constexpr u64 queueing_row = 2;
+
+    JsonArray events;
+    auto add_metadata = [&](StringView name, Optional<u64> row, StringView value) {
+        JsonObject args;
+        args.set("name"sv, value);
+
+        JsonObject event;
+        event.set("name"sv, name);
+        event.set("ph"sv, "M"sv);
+        event.set("pid"sv, process_track);
+        if (row.has_value())
+            event.set("tid"sv, *row);
+        event.set("args"sv, move(args));
+        events.must_append(move(event));
+    };
+    add_metadata("process_name"sv, {}, process_name);
+    add_metadata("thread_name"sv, handler_row, "IPC handlers"sv);
+    add_metadata("thread_name"sv, queueing_row, "IPC queueing"sv);
+
+    auto add_event = [&](StringView name, u64 row, i64 start_ns, i64 duration_ns) {
+        JsonObject event;
+        event.set("name"sv, name);
+        event.set("cat"sv, "ipc"sv);
+        event.set("ph"sv, "X"sv);
+        event.set("ts"sv, static_cast<double>(start_ns) / 1000.0);
+        event.set("dur"sv, static_cast<double>(duration_ns) / 1000.0);
+        event.set("pid"sv, process_track);
+        event.set("tid"sv, row);
+        events.must_append(move(event));
+    };
+
+    Sync::MutexLocker locker(m_mutex);
+
+    for (auto const& message : m_recent_messages) {
+        add_event(message.message_name, queueing_row, message.received_ns, message.handler_start_ns - message.received_ns);
+        add_event(message.message_name, handler_row, message.handler_start_ns, message.handler_duration_ns);
+    }
+
+    JsonObject trace;
+    trace.set("traceEvents"sv, move(events));
+    trace.set("displayTimeUnit"sv, "ms"sv);
+    return trace.serialized();
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, MessageStatistics const& statistics)
+{
+    TRY(encoder.encode(statistics.message_name));
+    TRY(encoder.encode(statistics.count));
+    TRY(encoder.encode(statistics.bytes));
+    TRY(encoder.encode(statistics.total_queueing_delay));
+    TRY(encoder.encode(statistics.longest_queueing_delay));
+    TRY(encoder.encode(statistics.handled_count));
+    TRY(encoder.encode(statistics.total_handler_time));
+    TRY(encoder.encode(statistics.longest_handler_time));
+    return {};
+}
+
+template<>
+ErrorOr<MessageStatistics> decode(Decoder& decoder)
+{
+    MessageStatistics statistics;
+    statistics.message_name = TRY(decoder.decode<String>());
+    statistics.count = TRY(decoder.decode<u64>());
+    statistics.bytes = TRY(decoder.decode<u64>());
+    statistics.total_queueing_delay = TRY(decoder.decode<AK::Duration>());
+    statistics.longest_queueing_delay = TRY(decoder.decode<AK::Duration>());
+    statistics.handled_count = TRY(decoder.decode<u64>());
+    statistics.total_handler_time = TRY(decoder.decode<AK::Duration>());
+    statistics.longest_handler_time = TRY(decoder.decode<AK::Duration>());
+    return statistics;
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, TrafficStatistics const& statistics)
+{
+    TRY(encoder.encode(statistics.recording_time));
+    TRY(encoder.encode(statistics.sent_message_count));
+    TRY(encoder.encode(statistics.sent_bytes));
+    TRY(encoder.encode(statistics.received_message_count));
+    TRY(encoder.encode(statistics.received_bytes));
+    TRY(encoder.encode(statistics.messages));
+    return {};
+}
+
+template<>
+ErrorOr<TrafficStatistics> decode(Decoder& decoder)
+{
+    TrafficStatistics statistics;
+    statistics.recording_time = TRY(decoder.decode<AK::Duration>());
+    statistics.sent_message_count = TRY(decoder.decode<u64>());
+    statistics.sent_bytes = TRY(decoder.decode<u64>());
+    statistics.received_message_count = TRY(decoder.decode<u64>());
+    statistics.received_bytes = TRY(decoder.decode<u64>());
+    statistics.messages = TRY(decoder.decode<Vector<MessageStatistics>>());
+    return statistics;
+}
+
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/CircularQueue.h>
+#include <AK/HashMap.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibIPC/Forward.h>
+#include <LibSync/Mutex.h>
+
+namespace IPC {
+
+// The messages of one type that this process received, over all of its connections.
+struct MessageStatistics {
+    String message_name;
+    u64 count { 0 };
+    u64 bytes { 0 };
+
+    // From the message being read off the transport to its handler being invoked.
+    AK::Duration total_queueing_delay;
+    AK::Duration longest_queueing_delay;
+
+    u64 handled_count { 0 };
+    AK::Duration total_handler_time;
+    AK::Duration longest_handler_time;
+};
+
+struct TrafficStatistics {
+    AK::Duration recording_time;
+
+    u64 sent_message_count { 0 };
+    u64 sent_bytes { 0 };
+    u64 received_message_count { 0 };
+    u64 received_bytes { 0 };
+
+    Vector<MessageStatistics> messages;
+};
+
+// Opt-in counters for the IPC traffic of this process, found at ConnectionBase's send, receive, and dispatch points.
+// Nothing is recorded unless statistics were enabled at startup (see --enable-ipc-statistics).
+class Statistics {
+    AK_MAKE_NONCOPYABLE(Statistics);
+    AK_MAKE_NONMOVABLE(Statistics);
+
+public:
+    static bool is_enabled() { return s_enabled; }
+    static void set_enabled(bool);
+
+    static Statistics& the();
+
+    // Message names are the string literals of the generated endpoint code, so they outlive the statistics.
+    void did_send_message(size_t bytes);
+    void did_receive_message(StringView message_name, size_t bytes);
+    void did_handle_message(StringView message_name, MonotonicTime received_time, MonotonicTime handler_start_time, MonotonicTime handler_end_time);
+
+    TrafficStatistics snapshot() const;
+
+    // The recently handled messages in the Trace Event Format, which Perfetto and chrome://tracing can load.
+    String to_trace_event_json(StringView process_name) const;
+
+private:
+    Statistics();
+
+    struct HandledMessage {
+        StringView message_name;
+        i64 received_ns { 0 };
+        i64 handler_start_ns { 0 };
+        i64 handler_duration_ns { 0 };
+    };
+
+    static bool s_enabled;
+
+    mutable Sync::Mutex m_mutex;
+    MonotonicTime m_start_time;
+    u64 m_sent_message_count { 0 };
+    u64 m_sent_bytes { 0 };
+    u64 m_received_message_count { 0 };
+    u64 m_received_bytes { 0 };
+    HashMap<StringView, MessageStatistics> m_messages;
+
+    static constexpr size_t max_recorded_messages = 2000;
+    CircularQueue<HandledMessage, max_recorded_messages> m_recent_messages;
+};
+
+template<>
+ErrorOr<void> encode(Encoder&, MessageStatistics const&);
+template<>
+ErrorOr<MessageStatistics> decode(Decoder&);
+
+template<>
+ErrorOr<void> encode(Encoder&, TrafficStatistics const&);
+template<>
+ErrorOr<TrafficStatistics> decode(Decoder&);
+
+}
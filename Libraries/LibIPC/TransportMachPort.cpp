@@ -224,6 +224,7 @@ intptr_t TransportMachPort::io_thread_loop()
         {
             Sync::MutexLocker locker(m_send_mutex);
             messages_to_send = move(m_pending_send_messages);
+            m_pending_normal_priority_send_message_count = 0;
         }
         for (auto& message : messages_to_send)
             send_mach_message(message);
@@ -489,11 +490,16 @@ void TransportMachPort::wait_until_readable()
         m_incoming_cv.wait();
 }
 
-ErrorOr<void> TransportMachPort::post_message(MessageDataType bytes, Vector<Attachment>& attachments)
+ErrorOr<void> TransportMachPort::post_message(MessageDataType bytes, Vector<Attachment>& attachments, MessagePriority priority)
 {
     {
         Sync::MutexLocker locker(m_send_mutex);
-        m_pending_send_messages.append(PendingMessage { move(bytes), move(attachments) });
+        if (priority == MessagePriority::Normal) {
+            // NB: Each Mach message carries its own port rights, so any message can overtake the ones queued before it.
+            m_pending_send_messages.insert(m_pending_normal_priority_send_message_count++, PendingMessage { move(bytes), move(attachments) });
+        } else {
+            m_pending_send_messages.append(PendingMessage { move(bytes), move(attachments) });
+        }
     }
     wake_io_thread();
     return {};
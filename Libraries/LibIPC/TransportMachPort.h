@@ -51,7 +51,7 @@ public:
 
     void wait_until_readable();
 
-    ErrorOr<void> post_message(MessageDataType, Vector<Attachment>& attachments);
+    ErrorOr<void> post_message(MessageDataType, Vector<Attachment>& attachments, MessagePriority = MessagePriority::Normal);
 
     enum class ShouldShutdown {
         No,
@@ -106,6 +106,8 @@ private:
     Atomic<bool> m_peer_eof { false };
 
     Vector<PendingMessage> m_pending_send_messages;
+    // The normal-priority messages are kept at the front of m_pending_send_messages, ahead of the low-priority ones.
+    size_t m_pending_normal_priority_send_message_count { 0 };
     Sync::Mutex m_send_mutex;
     Vector<u8> m_send_buffer;
 
@@ -9,6 +9,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Types.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Socket.h>
 #include <LibCore/System.h>
 #include <LibIPC/Attachment.h>
@@ -62,13 +63,34 @@ ErrorOr<TransportSocket::Paired> TransportSocket::create_paired()
     };
 }
 
-void SendQueue::enqueue_message(SocketMessageHeader header, MessageDataType payload, Vector<int>&& fds)
+void SendQueue::enqueue_message(SocketMessageHeader header, MessageDataType payload, Vector<int>&& fds, MessagePriority priority)
 {
     VERIFY(fds.size() <= Core::LocalSocket::MAX_TRANSFER_FDS);
     Sync::MutexLocker locker(m_mutex);
     m_queued_byte_count += sizeof(SocketMessageHeader) + payload.size();
+
+    // NB: File descriptors are handed to the socket in the order they were queued in, and the peer acknowledges them in
+    //     that order too. So only a message without any may overtake the low-priority messages queued before it.
+    if (priority == MessagePriority::Normal && fds.is_empty() && m_unpreemptable_message_count < m_queued_messages.size()) {
+        QueuedMessage message { header, move(payload), 0 };
+        if (m_unpreemptable_message_count == 0) {
+            m_queued_messages.prepend(move(message));
+        } else {
+            auto it = m_queued_messages.begin();
+            for (size_t i = 1; i < m_unpreemptable_message_count; ++i)
+                ++it;
+            m_queued_messages.insert_after(it, move(message));
+        }
+        ++m_unpreemptable_message_count;
+        return;
+    }
+
     m_queued_messages.append(QueuedMessage { header, move(payload), fds.size() });
     m_fds.append(fds.data(), fds.size());
+
+    // A normal-priority message queued after this one must not overtake it, nor the low-priority ones before it.
+    if (priority == MessagePriority::Normal)
+        m_unpreemptable_message_count = m_queued_messages.size();
 }
 
 SendQueue::BytesAndFds SendQueue::peek(size_t max_bytes)
@@ -79,17 +101,23 @@ SendQueue::BytesAndFds SendQueue::peek(size_t max_bytes)
     static_assert(Core::LocalSocket::MAX_TRANSFER_FDS == MAX_MESSAGE_FD_COUNT, "IPC message attachments must fit in one sendmsg()");
     size_t bytes_to_send = 0;
     size_t fds_to_send = 0;
+    size_t messages_to_send = 0;
     for (auto const& queued_message : m_queued_messages) {
         if (fds_to_send + queued_message.unsent_fd_count > Core::LocalSocket::MAX_TRANSFER_FDS)
             break;
         fds_to_send += queued_message.unsent_fd_count;
         bytes_to_send += queued_message.size() - queued_message.start_offset;
+        ++messages_to_send;
         if (bytes_to_send >= max_bytes) {
             bytes_to_send = max_bytes;
             break;
         }
     }
 
+    // NB: The bytes handed out here are discarded from the front of the queue once sent, so nothing may be queued
+    //     ahead of the messages they belong to in the meantime.
+    m_unpreemptable_message_count = max(m_unpreemptable_message_count, messages_to_send);
+
     result.bytes.resize(bytes_to_send);
     size_t copied_bytes = 0;
     for (auto const& queued_message : m_queued_messages) {
@@ -144,6 +172,8 @@ void SendQueue::discard(size_t bytes_count, size_t fds_count)
         if (queued_message.start_offset == queued_message.size()) {
             VERIFY(queued_message.unsent_fd_count == 0);
             (void)m_queued_messages.remove(m_queued_messages.begin());
+            if (m_unpreemptable_message_count > 0)
+                --m_unpreemptable_message_count;
         }
     }
 }
@@ -338,7 +368,7 @@ static constexpr size_t MAX_UNPROCESSED_BUFFER_SIZE = 128 * MiB;
 // Maximum number of accumulated unprocessed file descriptors before we disconnect the peer
 static constexpr size_t MAX_UNPROCESSED_FDS = 512;
 
-ErrorOr<void> TransportSocket::post_message(MessageDataType bytes_to_write, Vector<Attachment>& attachments)
+ErrorOr<void> TransportSocket::post_message(MessageDataType bytes_to_write, Vector<Attachment>& attachments, MessagePriority priority)
 {
     auto num_fds_to_transfer = attachments.size();
 
@@ -348,9 +378,21 @@ ErrorOr<void> TransportSocket::post_message(MessageDataType bytes_to_write, Vect
         .fd_count = static_cast<u32>(num_fds_to_transfer),
     };
 
+    // OPTIMIZATION: Large payloads (e.g. display lists) are written once into a shared memory segment that is passed
+    //               along as one more file descriptor, instead of being copied through the socket in small chunks.
+    RefPtr<AutoCloseFileDescriptor> shared_memory_fd;
+    if (bytes_to_write.size() >= SHARED_MEMORY_PAYLOAD_THRESHOLD && num_fds_to_transfer < MAX_MESSAGE_FD_COUNT) {
+        auto buffer = TRY(Core::AnonymousBuffer::create_with_size(bytes_to_write.size()));
+        memcpy(buffer.data<void>(), bytes_to_write.data(), bytes_to_write.size());
+        shared_memory_fd = adopt_ref(*new AutoCloseFileDescriptor(TRY(Core::System::dup(buffer.fd()))));
+        header.type = SocketMessageHeader::Type::SharedMemoryPayload;
+        header.fd_count++;
+        bytes_to_write.clear();
+    }
+
     auto raw_fds = Vector<int, 1> {};
-    if (num_fds_to_transfer > 0) {
-        raw_fds.ensure_capacity(num_fds_to_transfer);
+    if (header.fd_count > 0) {
+        raw_fds.ensure_capacity(header.fd_count);
         Sync::MutexLocker locker(m_fds_retained_until_received_by_peer_mutex);
         for (auto& attachment : attachments) {
             int fd = attachment.to_fd();
@@ -358,9 +400,13 @@ ErrorOr<void> TransportSocket::post_message(MessageDataType bytes_to_write, Vect
             raw_fds.unchecked_append(auto_fd->value());
             m_fds_retained_until_received_by_peer.enqueue(move(auto_fd));
         }
+        if (shared_memory_fd) {
+            raw_fds.unchecked_append(shared_memory_fd->value());
+            m_fds_retained_until_received_by_peer.enqueue(shared_memory_fd.release_nonnull());
+        }
     }
 
-    m_send_queue->enqueue_message(header, move(bytes_to_write), move(raw_fds));
+    m_send_queue->enqueue_message(header, move(bytes_to_write), move(raw_fds), priority);
     wake_io_thread();
     return {};
 }
@@ -391,6 +437,26 @@ ErrorOr<void> TransportSocket::send_message(Core::LocalSocket& socket, ReadonlyB
     return {};
 }
 
+ErrorOr<Vector<u8>> TransportSocket::read_payload_from_shared_memory(int fd, size_t payload_size)
+{
+    ScopeGuard close_fd { [fd] { (void)Core::System::close(fd); } };
+
+    // NB: The sender still holds the segment, and could write to it or shrink it at any time. Mapping it would let a
+    //     concurrent truncation fault this process, and decoding in place would let fields change between two reads.
+    //     Copying it out with pread() is immune to both: a shrunk segment just reads short.
+    Vector<u8> payload;
+    TRY(payload.try_resize(payload_size));
+
+    size_t offset = 0;
+    while (offset < payload_size) {
+        auto nread = TRY(Core::System::pread(fd, payload.span().slice(offset), static_cast<off_t>(offset)));
+        if (nread == 0)
+            return Error::from_string_literal("Shared memory segment is smaller than the payload");
+        offset += nread;
+    }
+    return payload;
+}
+
 TransportSocket::TransferState TransportSocket::transfer_data(ReadonlyBytes& bytes, Vector<int>& fds)
 {
     auto byte_count = bytes.size();
@@ -477,7 +543,9 @@ void TransportSocket::read_incoming_messages()
     while (index + sizeof(SocketMessageHeader) <= m_unprocessed_bytes.size()) {
         SocketMessageHeader header;
         memcpy(&header, m_unprocessed_bytes.data() + index, sizeof(SocketMessageHeader));
-        if (header.type == SocketMessageHeader::Type::Payload) {
+        size_t socket_payload_size = header.payload_size;
+        if (header.type == SocketMessageHeader::Type::Payload || header.type == SocketMessageHeader::Type::SharedMemoryPayload) {
+            bool const is_in_shared_memory = header.type == SocketMessageHeader::Type::SharedMemoryPayload;
             if (header.payload_size > MAX_MESSAGE_PAYLOAD_SIZE) {
                 dbgln("TransportSocket: Rejecting message with payload_size {} exceeding limit {}", header.payload_size, MAX_MESSAGE_PAYLOAD_SIZE);
                 m_peer_eof = true;
@@ -488,7 +556,15 @@ void TransportSocket::read_incoming_messages()
                 m_peer_eof = true;
                 break;
             }
-            Checked<size_t> message_size = header.payload_size;
+            if (is_in_shared_memory) {
+                if (header.fd_count == 0) {
+                    dbgln("TransportSocket: SharedMemoryPayload without a shared memory segment");
+                    m_peer_eof = true;
+                    break;
+                }
+                socket_payload_size = 0;
+            }
+            Checked<size_t> message_size = socket_payload_size;
             message_size += sizeof(SocketMessageHeader);
             if (message_size.has_overflow() || message_size.value() > m_unprocessed_bytes.size() - index)
                 break;
@@ -501,10 +577,19 @@ void TransportSocket::read_incoming_messages()
                 m_peer_eof = true;
                 break;
             }
-            for (size_t i = 0; i < header.fd_count; ++i)
+            auto attachment_count = is_in_shared_memory ? header.fd_count - 1 : header.fd_count;
+            for (size_t i = 0; i < attachment_count; ++i)
                 message->attachments.enqueue(m_unprocessed_attachments.dequeue());
             Vector<u8> payload_bytes;
-            if (payload_bytes.try_append(m_unprocessed_bytes.data() + index + sizeof(SocketMessageHeader), header.payload_size).is_error()) {
+            if (is_in_shared_memory) {
+                auto payload_or_error = read_payload_from_shared_memory(m_unprocessed_attachments.dequeue().to_fd(), header.payload_size);
+                if (payload_or_error.is_error()) {
+                    dbgln("TransportSocket: Failed to read payload_size {} from shared memory: {}", header.payload_size, payload_or_error.error());
+                    m_peer_eof = true;
+                    break;
+                }
+                payload_bytes = payload_or_error.release_value();
+            } else if (payload_bytes.try_append(m_unprocessed_bytes.data() + index + sizeof(SocketMessageHeader), header.payload_size).is_error()) {
                 dbgln("TransportSocket: Failed to allocate message buffer for payload_size {}", header.payload_size);
                 m_peer_eof = true;
                 break;
@@ -529,7 +614,7 @@ void TransportSocket::read_incoming_messages()
             break;
         }
         Checked<size_t> new_index = index;
-        new_index += header.payload_size;
+        new_index += socket_payload_size;
         new_index += sizeof(SocketMessageHeader);
         if (new_index.has_overflow()) {
             dbgln("TransportSocket: index would overflow");
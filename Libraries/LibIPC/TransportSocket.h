@@ -26,6 +26,9 @@ struct SocketMessageHeader {
     enum class Type : u8 {
         Payload = 0,
         FileDescriptorAcknowledgement = 1,
+        // The payload is in a shared memory segment, whose file descriptor is the last one attached to the message.
+        // No payload bytes follow the header on the socket.
+        SharedMemoryPayload = 2,
     };
     Type type { Type::Payload };
     u32 payload_size { 0 };
@@ -34,7 +37,7 @@ struct SocketMessageHeader {
 
 class SendQueue : public AtomicRefCounted<SendQueue> {
 public:
-    void enqueue_message(SocketMessageHeader, MessageDataType payload, Vector<int>&& fds);
+    void enqueue_message(SocketMessageHeader, MessageDataType payload, Vector<int>&& fds, MessagePriority = MessagePriority::Normal);
     struct BytesAndFds {
         Vector<u8> bytes;
         Vector<int> fds;
@@ -52,8 +55,12 @@ private:
         size_t size() const { return sizeof(SocketMessageHeader) + payload.size(); }
     };
 
-    SinglyLinkedList<QueuedMessage, AK::DefaultSizeCalculationPolicy> m_queued_messages;
+    SinglyLinkedList<QueuedMessage, AK::CountingSizeCalculationPolicy> m_queued_messages;
     size_t m_queued_byte_count { 0 };
+    // The number of queued messages that a normal-priority message must be queued behind: the ones that peek() may have
+    // handed out (of which the IO thread may have sent a part), followed by the normal-priority messages queued so far.
+    // Only low-priority messages are queued after them.
+    size_t m_unpreemptable_message_count { 0 };
     Vector<int> m_fds;
     Sync::Mutex m_mutex;
 };
@@ -65,6 +72,9 @@ class TransportSocket {
 public:
     static constexpr socklen_t SOCKET_BUFFER_SIZE = 128 * KiB;
 
+    // Payloads at least this large are sent through a shared memory segment instead of being streamed over the socket.
+    static constexpr size_t SHARED_MEMORY_PAYLOAD_THRESHOLD = 256 * KiB;
+
     struct Paired {
         NonnullOwnPtr<TransportSocket> local;
         TransportHandle remote_handle;
@@ -83,7 +93,7 @@ public:
 
     void wait_until_readable();
 
-    ErrorOr<void> post_message(MessageDataType, Vector<Attachment>& attachments);
+    ErrorOr<void> post_message(MessageDataType, Vector<Attachment>& attachments, MessagePriority = MessagePriority::Normal);
 
     enum class ShouldShutdown {
         No,
@@ -116,6 +126,7 @@ private:
     [[nodiscard]] TransferState transfer_data(ReadonlyBytes& bytes, Vector<int>& fds);
 
     static ErrorOr<void> send_message(Core::LocalSocket&, ReadonlyBytes& bytes, Vector<int>& unowned_fds);
+    static ErrorOr<Vector<u8>> read_payload_from_shared_memory(int fd, size_t payload_size);
 
     enum class IOThreadState {
         Running,
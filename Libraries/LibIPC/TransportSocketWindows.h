@@ -38,7 +38,7 @@ public:
 
     void wait_until_readable();
 
-    ErrorOr<void> post_message(MessageDataType, Vector<Attachment>& attachments);
+    ErrorOr<void> post_message(MessageDataType, Vector<Attachment>& attachments, MessagePriority = MessagePriority::Normal);
 
     enum class ShouldShutdown {
         No,
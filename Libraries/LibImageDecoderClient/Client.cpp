@@ -17,13 +17,14 @@ Client::Client(NonnullOwnPtr<IPC::Transport> transport)
 void Client::die()
 {
     verify_event_loop();
+    m_partial_image_callbacks.clear();
     auto pending_promises = move(m_token_promises);
 
     for (auto& promise : pending_promises)
         promise.value->reject(Error::from_string_literal("ImageDecoder disconnected"));
 }
 
-NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, Optional<ByteString> cache_partition)
 {
     verify_event_loop();
     auto promise = Core::Promise<DecodedImage>::construct();
@@ -50,7 +51,7 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
     i64 request_id = m_next_request_id++;
     m_token_promises.set(request_id, promise);
 
-    async_decode_image(encoded_buffer, ideal_size, mime_type, request_id);
+    async_decode_image(encoded_buffer, ideal_size, mime_type, move(cache_partition), request_id);
 
     return promise;
 }
@@ -98,6 +99,39 @@ void Client::did_decode_image(i64 request_id, bool is_animated, u32 loop_count,
     promise->resolve(move(image));
 }
 
+void Client::did_decode_shared_image(i64 request_id, Gfx::ShareableBitmap bitmap, Gfx::FloatPoint scale, Gfx::ColorSpace color_space)
+{
+    verify_event_loop();
+    Optional<NonnullRefPtr<Core::Promise<DecodedImage>>> maybe_promise = m_token_promises.take(request_id);
+
+    if (!maybe_promise.has_value()) {
+        dbgln("ImageDecoderClient: No pending image with request token {}", request_id);
+        return;
+    }
+    auto promise = maybe_promise.release_value();
+
+    if (!bitmap.is_valid()) {
+        dbgln("ImageDecoderClient: Invalid bitmap for request {}", request_id);
+        promise->reject(Error::from_string_literal("Invalid bitmap"));
+        return;
+    }
+
+    // NB: The bitmap's memory is mapped by other clients that decoded the same image. A sealed buffer is mapped
+    //     read-only, and none of them can change the pixels the others show.
+    if (Core::AnonymousBuffer::supports_sealing && !bitmap.bitmap()->anonymous_buffer().is_sealed()) {
+        dbgln("ImageDecoderClient: Shared bitmap for request {} is not sealed", request_id);
+        promise->reject(Error::from_string_literal("Shared bitmap is not sealed"));
+        return;
+    }
+
+    DecodedImage image;
+    image.scale = scale;
+    image.color_space = move(color_space);
+    image.frames.empend(*bitmap.bitmap(), 0);
+
+    promise->resolve(move(image));
+}
+
 void Client::did_fail_to_decode_image(i64 request_id, String error_message)
 {
     verify_event_loop();
@@ -114,6 +148,43 @@ void Client::did_fail_to_decode_image(i64 request_id, String error_message)
     promise->reject(Error::from_string_literal("Image decoding failed or aborted"));
 }
 
+i64 Client::start_incremental_decode(Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image)
+{
+    verify_event_loop();
+    i64 request_id = m_next_request_id++;
+    m_partial_image_callbacks.set(request_id, move(on_partial_image));
+    async_start_incremental_decode(request_id);
+    return request_id;
+}
+
+void Client::append_incremental_decode_data(i64 request_id, ReadonlyBytes data)
+{
+    verify_event_loop();
+    static constexpr size_t max_incremental_decode_data_ipc_chunk_size = 16 * MiB;
+
+    for (size_t offset = 0; offset < data.size(); offset += max_incremental_decode_data_ipc_chunk_size) {
+        auto chunk_size = min(data.size() - offset, max_incremental_decode_data_ipc_chunk_size);
+        async_append_incremental_decode_data(request_id, data.slice(offset, chunk_size));
+    }
+}
+
+void Client::end_incremental_decode(i64 request_id)
+{
+    verify_event_loop();
+    if (m_partial_image_callbacks.remove(request_id))
+        async_end_incremental_decode(request_id);
+}
+
+void Client::did_decode_partial_image(i64 request_id, Gfx::BitmapSequence bitmap_sequence)
+{
+    verify_event_loop();
+    auto it = m_partial_image_callbacks.find(request_id);
+    if (it == m_partial_image_callbacks.end() || bitmap_sequence.bitmaps.is_empty() || !bitmap_sequence.bitmaps.first())
+        return;
+
+    it->value(bitmap_sequence.bitmaps.first().release_nonnull());
+}
+
 void Client::did_decode_animation_frames(i64 session_id, Gfx::BitmapSequence bitmap_sequence)
 {
     verify_event_loop();
@@ -137,6 +208,13 @@ void Client::did_fail_animation_decode(i64 session_id, String error_message)
         on_animation_decode_failed(session_id, move(error_message));
 }
 
+void Client::did_report_memory_statistics(u64 cached_image_bytes, u64 cached_image_count)
+{
+    verify_event_loop();
+    if (on_memory_statistics)
+        on_memory_statistics(cached_image_bytes, cached_image_count);
+}
+
 void Client::request_animation_frames(i64 session_id, u32 start_frame_index, u32 count)
 {
     verify_event_loop();
@@ -42,7 +42,15 @@ public:
 
     Client(NonnullOwnPtr<IPC::Transport>);
 
-    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
+    // Still images decoded with a cache partition, usually the top-level site they're shown on, may be shared with
+    // other clients that decode the same data for the same partition. Their pixels are read-only.
+    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {}, Optional<ByteString> cache_partition = {});
+
+    // Decodes an image as its data arrives, and reports what has been decoded so far with on_partial_image. This is
+    // only for showing the image early: decode_image() still has to be called with the complete data.
+    i64 start_incremental_decode(Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image);
+    void append_incremental_decode_data(i64 request_id, ReadonlyBytes);
+    void end_incremental_decode(i64 request_id);
 
     void request_animation_frames(i64 session_id, u32 start_frame_index, u32 count);
     void stop_animation_decode(i64 session_id);
@@ -50,20 +58,26 @@ public:
     Function<void()> on_death;
     Function<void(i64 session_id, Vector<NonnullRefPtr<Gfx::Bitmap>>)> on_animation_frames_decoded;
     Function<void(i64 session_id, String error_message)> on_animation_decode_failed;
+    Function<void(u64 cached_image_bytes, u64 cached_image_count)> on_memory_statistics;
 
 private:
     void verify_event_loop() const;
     virtual void die() override;
 
     virtual void did_decode_image(i64 request_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space, i64 session_id) override;
+    virtual void did_decode_shared_image(i64 request_id, Gfx::ShareableBitmap bitmap, Gfx::FloatPoint scale, Gfx::ColorSpace color_space) override;
     virtual void did_fail_to_decode_image(i64 request_id, String error_message) override;
+    virtual void did_decode_partial_image(i64 request_id, Gfx::BitmapSequence bitmaps) override;
 
     virtual void did_decode_animation_frames(i64 session_id, Gfx::BitmapSequence bitmaps) override;
     virtual void did_fail_animation_decode(i64 session_id, String error_message) override;
 
+    virtual void did_report_memory_statistics(u64 cached_image_bytes, u64 cached_image_count) override;
+
     Core::EventLoop* m_creation_event_loop { &Core::EventLoop::current() };
     i64 m_next_request_id { 0 };
     HashMap<i64, NonnullRefPtr<Core::Promise<DecodedImage>>> m_token_promises;
+    HashMap<i64, Function<void(NonnullRefPtr<Gfx::Bitmap>)>> m_partial_image_callbacks;
 };
 
 }
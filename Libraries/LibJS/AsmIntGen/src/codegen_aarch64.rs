@@ -139,6 +139,14 @@ pub fn generate(program: &Program) -> String {
     }
     w!(out);
 
+    // Baseline JIT templates are only generated for x86_64. A table of null
+    // templates tells the baseline JIT to leave everything to the interpreter.
+    w!(out, ".globl CSYM(asm_baseline_jit_templates)");
+    w!(out, ".p2align 3");
+    w!(out, "CSYM(asm_baseline_jit_templates):");
+    w!(out, "    .zero {}", 256 * 16);
+    w!(out);
+
     w!(out, ".text");
     w!(out);
 
@@ -1892,6 +1900,20 @@ fn emit_instruction(
             }
         }
 
+        // enter_baseline_jit entry_points_reg, label_reg
+        // There are no baseline JIT templates for aarch64 yet, so this is
+        // never reached, but the DSL that uses it must still assemble.
+        "enter_baseline_jit" => {
+            if insn.operands.len() >= 2 {
+                let entry_points = resolve_op(&insn.operands[0], handler, program);
+                let reg = resolve_op(&insn.operands[1], handler, program);
+                let wreg = to_w_reg(&reg);
+                w!(out, "    ldr x9, [{entry_points}, {wreg}, uxtw #3]");
+                w!(out, "    add x21, x26, {wreg}, uxtw");
+                w!(out, "    br x9");
+            }
+        }
+
         // mov
         "mov" => {
             if insn.operands.len() == 2 {
@@ -5,14 +5,15 @@
  */
 
 use crate::allocator::flatten_and_allocate;
+use crate::instructions::{OperandKind, lookup};
 use crate::parser::{AsmInstruction, Handler, ObjectFormat, Operand, Program};
 use crate::registers::{Arch, resolve_register};
 use crate::shared::{
-    HandlerState, ResolvedMemoryIndex, get_immediate_value, resolve_adjacent_memory_pair,
+    BaselineJitTemplate, HandlerState, ResolvedMemoryIndex, get_immediate_value, resolve_adjacent_memory_pair,
     resolve_field_ref, resolve_label, resolve_memory_operand, substitute_macro,
     omit_jumps_to_next_label, outline_cold_blocks, uniquify_macro_labels, w,
 };
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
 use std::fmt::Write;
 
 #[derive(Clone, Copy, PartialEq, Eq)]
@@ -58,6 +59,11 @@ pub fn generate(program: &Program) -> String {
     w!(out, ".text");
     w!(out);
 
+    // Generate the baseline JIT templates before the dispatch table, which
+    // also holds the addresses of the functions they call.
+    let baseline_jit_templates =
+        matches!(program.object_format, ObjectFormat::Elf).then(|| generate_baseline_jit_templates(program, abi));
+
     // Generate dispatch table
     // The table contains absolute addresses that need relocation, so on Linux
     // it must go in .data.rel.ro (not .rodata) to avoid DT_TEXTREL in PIE.
@@ -90,6 +96,15 @@ pub fn generate(program: &Program) -> String {
     for _ in program.opcode_list.len()..256 {
         w!(out, "    .quad asm_handler_fallback");
     }
+    if let Some(templates) = &baseline_jit_templates {
+        w!(out, "    .quad .Lexit");
+        for function in &templates.runtime_functions {
+            w!(out, "    .quad CSYM({function})");
+        }
+    }
+    w!(out);
+
+    emit_baseline_jit_template_table(&mut out, baseline_jit_templates.as_ref(), program);
     w!(out);
 
     w!(out, ".text");
@@ -98,7 +113,7 @@ pub fn generate(program: &Program) -> String {
     emit_proc_start(&mut out, program.object_format);
 
     // Generate entry point
-    generate_entry_point(&mut out, program, abi);
+    generate_entry_point(&mut out, program, abi, baseline_jit_templates.is_some());
 
     // Generate fallback handler
     generate_fallback_handler(&mut out, program, abi);
@@ -117,6 +132,11 @@ pub fn generate(program: &Program) -> String {
 
     generate_exit_point(&mut out, program.object_format, abi);
     emit_proc_end(&mut out, program.object_format);
+
+    if let Some(templates) = &baseline_jit_templates {
+        out.push_str(&templates.code);
+    }
+
     emit_file_trailer(&mut out, program.object_format);
 
     out
@@ -196,15 +216,15 @@ fn generate_exit_point(out: &mut String, fmt: ObjectFormat, abi: X86_64Abi) {
     w!(out);
 }
 
-fn generate_entry_point(out: &mut String, program: &Program, abi: X86_64Abi) {
+fn generate_entry_point(out: &mut String, program: &Program, abi: X86_64Abi, has_baseline_jit: bool) {
     if abi.is_win64() {
         generate_win64_entry_point(out, program);
     } else {
-        generate_sysv_entry_point(out, program);
+        generate_sysv_entry_point(out, program, has_baseline_jit);
     }
 }
 
-fn generate_sysv_entry_point(out: &mut String, program: &Program) {
+fn generate_sysv_entry_point(out: &mut String, program: &Program, has_baseline_jit: bool) {
     // void asm_interpreter_entry(u8 const* bytecode, u32 entry_point, Value* values, VM* vm)
     // System V AMD64: rdi=bytecode, esi=entry_point, rdx=values, rcx=vm
 
@@ -248,6 +268,22 @@ fn generate_sysv_entry_point(out: &mut String, program: &Program) {
         "    lea r12, [rip + asm_dispatch_table]  # dispatch table"
     );
 
+    // Start in the executable's baseline JIT code once it has some.
+    if has_baseline_jit {
+        let exec_executable = program
+            .constants
+            .get("EXECUTION_CONTEXT_EXECUTABLE")
+            .copied()
+            .expect("EXECUTION_CONTEXT_EXECUTABLE constant required");
+        let entry_points = baseline_jit_entry_points_offset(program);
+        w!(out, "    mov rax, QWORD PTR [rbx + {exec_executable}]");
+        w!(out, "    mov rax, QWORD PTR [rax + {entry_points}]");
+        w!(out, "    test rax, rax");
+        w!(out, "    jz .Lenter_interpreter");
+        w!(out, "    jmp QWORD PTR [rax + r13 * 8]");
+        w!(out, ".Lenter_interpreter:");
+    }
+
     // Dispatch to first instruction
     w!(out, "    movzx eax, BYTE PTR [r14 + r13]");
     w!(out, "    jmp [r12 + rax * 8]");
@@ -415,6 +451,48 @@ fn emit_dispatch_with_size(out: &mut String, size: u32) {
     emit_dispatch(out);
 }
 
+/// Emit a call to an external function. Templates are copied away from this
+/// object, so they call through the function's dispatch table slot instead.
+fn emit_call(out: &mut String, func_name: &str, state: &mut HandlerState) {
+    if let Some(template) = state.baseline_jit_template.as_mut() {
+        let slot = template.runtime_function_slot(func_name);
+        w!(out, "    call QWORD PTR [r12 + {}]", slot * 8);
+    } else {
+        w!(out, "    call CSYM({func_name})");
+    }
+}
+
+fn emit_exit(out: &mut String, state: &HandlerState) {
+    if state.baseline_jit_template.is_some() {
+        w!(out, "    jmp QWORD PTR [r12 + {}]", BaselineJitTemplate::EXIT_SLOT * 8);
+    } else {
+        w!(out, "    jmp .Lexit");
+    }
+}
+
+/// Emit a jump to the exit path if the sign flag is set.
+fn emit_exit_if_negative(out: &mut String, handler: &Handler, state: &mut HandlerState) {
+    if state.baseline_jit_template.is_none() {
+        w!(out, "    js .Lexit");
+        return;
+    }
+    let exit = format!(".Lasm_{}.exit_{}", handler.name, state.unique_counter);
+    state.unique_counter += 1;
+    w!(out, "    js {exit}");
+    let mut cold = String::new();
+    w!(cold, "{exit}:");
+    emit_exit(&mut cold, state);
+    state.cold_blocks.push_str(&cold);
+}
+
+fn baseline_jit_entry_points_offset(program: &Program) -> i64 {
+    program
+        .constants
+        .get("EXECUTABLE_BASELINE_JIT_ENTRY_POINTS")
+        .copied()
+        .expect("EXECUTABLE_BASELINE_JIT_ENTRY_POINTS constant required")
+}
+
 /// Get the handler's instruction size: from explicit size= attribute, or from Bytecode.def.
 fn handler_size(handler: &Handler, program: &Program) -> u32 {
     if let Some(size) = handler.size {
@@ -487,6 +565,163 @@ fn generate_handler(out: &mut String, handler: &Handler, program: &Program, abi:
     cold
 }
 
+/// The baseline JIT templates of every handler that has one.
+struct BaselineJitTemplates {
+    code: String,
+    /// Opcodes whose handler has a template. The others share the template
+    /// that hands the instruction back to the interpreter.
+    opcodes: HashSet<String>,
+    /// External functions called by the templates, in dispatch table order.
+    runtime_functions: Vec<String>,
+}
+
+const BASELINE_JIT_INTERPRETER_TEMPLATE: &str = "asm_baseline_jit_template_interpreter";
+
+fn generate_baseline_jit_templates(program: &Program, abi: X86_64Abi) -> BaselineJitTemplates {
+    let mut templates = BaselineJitTemplates {
+        code: String::new(),
+        opcodes: HashSet::new(),
+        runtime_functions: Vec::new(),
+    };
+
+    w!(templates.code, "# Baseline JIT templates, only ever run once copied");
+    w!(templates.code, ".p2align 4");
+    w!(templates.code, "{BASELINE_JIT_INTERPRETER_TEMPLATE}:");
+    emit_dispatch(&mut templates.code);
+    w!(templates.code, "{BASELINE_JIT_INTERPRETER_TEMPLATE}_end:");
+    w!(templates.code);
+
+    for handler in &program.handlers {
+        if let Some(code) = generate_baseline_jit_template(handler, program, abi, &mut templates.runtime_functions) {
+            templates.code.push_str(&code);
+            templates.opcodes.insert(handler.name.clone());
+        }
+    }
+    templates
+}
+
+fn generate_baseline_jit_template(
+    handler: &Handler,
+    program: &Program,
+    abi: X86_64Abi,
+    runtime_functions: &mut Vec<String>,
+) -> Option<String> {
+    let mut counter = 0;
+    let instructions = flatten_and_allocate(handler, program, Arch::X86_64, &mut counter)
+        .unwrap_or_else(|err| {
+            panic!(
+                "register allocation failed for handler '{}': {}",
+                err.handler, err.message
+            )
+        });
+    if instructions.iter().any(switches_frames) {
+        return None;
+    }
+
+    let start_label = format!("asm_baseline_jit_template_{}", handler.name);
+    let end_label = format!("{start_label}_end");
+    let mut state = HandlerState::new();
+    state.unique_counter = counter;
+    state.baseline_jit_template = Some(BaselineJitTemplate {
+        end_label: end_label.clone(),
+        runtime_functions: runtime_functions.clone(),
+    });
+
+    let (mut hot_instructions, mut cold_instructions) = outline_cold_blocks(&instructions)
+        .unwrap_or_else(|error| panic!("invalid cold block in handler '{}': {error}", handler.name));
+    omit_jumps_to_next_label(&mut hot_instructions);
+    omit_jumps_to_next_label(&mut cold_instructions);
+
+    // Cold paths stay inside the template, so that they are copied along.
+    let mut body = String::new();
+    for instruction in hot_instructions.iter().chain(&cold_instructions) {
+        emit_instruction(&mut body, instruction, handler, program, &mut state, abi);
+    }
+    body.push_str(&state.cold_blocks);
+    if let Some(stripped) = body.strip_suffix(&format!("    jmp {end_label}\n")) {
+        body.truncate(stripped.len());
+    }
+
+    if !is_position_independent(&body, &end_label) {
+        return None;
+    }
+
+    let template = state.baseline_jit_template.take().unwrap();
+    *runtime_functions = template.runtime_functions;
+
+    let mut code = String::new();
+    w!(code, ".p2align 4");
+    w!(code, "{start_label}:");
+    code.push_str(&body.replace(".Lasm_", ".Lasm_baseline_jit_"));
+    w!(code, "{end_label}:");
+    w!(code);
+    Some(code)
+}
+
+/// Baseline JIT code only ever runs the frames of its own executable, so the
+/// handlers that push, pop or replace frames keep running in the interpreter.
+fn switches_frames(instruction: &AsmInstruction) -> bool {
+    if matches!(instruction.mnemonic.as_str(), "reload_exec_ctx" | "call_raw_native") {
+        return true;
+    }
+    let mentions_frame_state = instruction.operands.iter().any(|operand| {
+        let operand = format!("{operand:?}");
+        operand.contains("VM_RUNNING_EXECUTION_CONTEXT") || operand.contains("VM_INTERPRETER_STACK_TOP")
+    });
+    if mentions_frame_state {
+        return true;
+    }
+    let Some(info) = lookup(&instruction.mnemonic) else {
+        return false;
+    };
+    instruction.operands.iter().zip(info.operands).any(|(operand, kind)| {
+        matches!(kind, OperandKind::GprOut | OperandKind::GprInOut)
+            && matches!(operand, Operand::Register(name) if matches!(name.as_str(), "exec_ctx" | "pb" | "values"))
+    })
+}
+
+/// Checks that a template only refers to its own labels and reaches
+/// everything else through registers, so that it still works once copied.
+fn is_position_independent(body: &str, end_label: &str) -> bool {
+    body.lines().all(|line| {
+        let line = line.trim();
+        if line.is_empty() || line.starts_with('#') {
+            return true;
+        }
+        if let Some(label) = line.strip_suffix(':') {
+            return label.starts_with(".Lasm_");
+        }
+        if line.contains("rip") || line.contains("CSYM") || line.contains(".Lexit") {
+            return false;
+        }
+        let (mnemonic, operand) = line.split_once(' ').unwrap_or((line, ""));
+        if mnemonic.starts_with('j') || mnemonic == "call" {
+            return operand.starts_with(".Lasm_")
+                || operand == end_label
+                || operand.starts_with('[')
+                || operand.starts_with("QWORD PTR [");
+        }
+        true
+    })
+}
+
+fn emit_baseline_jit_template_table(out: &mut String, templates: Option<&BaselineJitTemplates>, program: &Program) {
+    w!(out, ".globl CSYM(asm_baseline_jit_templates)");
+    w!(out, ".p2align 3");
+    w!(out, "CSYM(asm_baseline_jit_templates):");
+    let Some(templates) = templates else {
+        w!(out, "    .zero {}", 256 * 16);
+        return;
+    };
+    for index in 0..256 {
+        let template = match program.opcode_list.get(index) {
+            Some(opcode) if templates.opcodes.contains(opcode) => format!("asm_baseline_jit_template_{opcode}"),
+            _ => BASELINE_JIT_INTERPRETER_TEMPLATE.to_string(),
+        };
+        w!(out, "    .quad {template}, {template}_end");
+    }
+}
+
 fn resolve_op(op: &Operand, handler: &Handler, program: &Program) -> String {
     match op {
         Operand::Register(name) => {
@@ -778,14 +1013,23 @@ fn emit_instruction(
                 let reg = resolve_op(op, handler, program);
                 let reg32 = to_32bit_reg(&reg);
                 w!(out, "    add r13d, {reg32}");
-                emit_dispatch(out);
+                if let Some(template) = &state.baseline_jit_template {
+                    w!(out, "    jmp {}", template.end_label);
+                } else {
+                    emit_dispatch(out);
+                }
             }
         }
 
         // dispatch_next: advance pc by the handler's instruction size and dispatch
         "dispatch_next" => {
             let size = handler_size(handler, program);
-            emit_dispatch_with_size(out, size);
+            if let Some(template) = &state.baseline_jit_template {
+                w!(out, "    add r13d, {size}");
+                w!(out, "    jmp {}", template.end_label);
+            } else {
+                emit_dispatch_with_size(out, size);
+            }
         }
 
         // call_slow_path pseudo-instruction
@@ -798,16 +1042,28 @@ fn emit_instruction(
             if let Some(Operand::Register(func_name)) = insn.operands.first() {
                 emit_sync_pc_to_execution_context(out, program);
                 emit_vm_pc_instruction_args(out, abi);
-                w!(out, "    call CSYM({func_name})");
+                emit_call(out, func_name, state);
                 // Check for exit (return < 0)
                 w!(out, "    test rax, rax");
-                w!(out, "    js .Lexit");
+                emit_exit_if_negative(out, handler, state);
                 // Reload pb and values from the running execution context.
                 // This is necessary because exception handling may unwind
                 // inline frames, changing the current executable and values.
                 emit_state_reload(out, program, abi);
                 // Update pc from return value and dispatch
                 w!(out, "    mov r13d, eax");
+                if state.baseline_jit_template.is_some() {
+                    // The exception handler may live in a caller that has no
+                    // baseline JIT code, so look the tier up again.
+                    let entry_points = baseline_jit_entry_points_offset(program);
+                    let interpret = format!(".Lasm_{}.interpret_{}", handler.name, state.unique_counter);
+                    state.unique_counter += 1;
+                    w!(out, "    mov rax, QWORD PTR [rcx + {entry_points}]");
+                    w!(out, "    test rax, rax");
+                    w!(out, "    jz {interpret}");
+                    w!(out, "    jmp QWORD PTR [rax + r13 * 8]");
+                    w!(out, "{interpret}:");
+                }
                 emit_dispatch(out);
             }
         }
@@ -821,7 +1077,7 @@ fn emit_instruction(
                 if !abi.is_win64() {
                     w!(out, "    mov rdi, rcx");
                 }
-                w!(out, "    call CSYM({func_name})");
+                emit_call(out, func_name, state);
             }
         }
 
@@ -832,7 +1088,7 @@ fn emit_instruction(
         "call_interp" => {
             if let Some(Operand::Register(func_name)) = insn.operands.first() {
                 emit_vm_pc_instruction_args(out, abi);
-                w!(out, "    call CSYM({func_name})");
+                emit_call(out, func_name, state);
             }
         }
 
@@ -1130,7 +1386,7 @@ fn emit_instruction(
         }
 
         "exit" => {
-            w!(out, "    jmp .Lexit");
+            emit_exit(out, state);
         }
 
         // load64 dst_reg, [base, offset] - Load 64-bit value from memory
@@ -1407,7 +1663,33 @@ fn emit_instruction(
                 let reg = resolve_op(op, handler, program);
                 let reg32 = to_32bit_reg(&reg);
                 w!(out, "    mov r13d, {reg32}");
-                emit_dispatch(out);
+                if state.baseline_jit_template.is_some() {
+                    // Templates never switch frames, so the running executable
+                    // is the one being run by this baseline JIT code.
+                    let executable = program
+                        .constants
+                        .get("EXECUTION_CONTEXT_EXECUTABLE")
+                        .copied()
+                        .expect("EXECUTION_CONTEXT_EXECUTABLE constant required");
+                    let entry_points = baseline_jit_entry_points_offset(program);
+                    w!(out, "    mov rax, QWORD PTR [rbx + {executable}]");
+                    w!(out, "    mov rax, QWORD PTR [rax + {entry_points}]");
+                    w!(out, "    jmp QWORD PTR [rax + r13 * 8]");
+                } else {
+                    emit_dispatch(out);
+                }
+            }
+        }
+
+        // enter_baseline_jit entry_points_reg, label_reg - set pc and jump to
+        // the baseline JIT code of the instruction at pc
+        "enter_baseline_jit" => {
+            if insn.operands.len() >= 2 {
+                let entry_points = resolve_op(&insn.operands[0], handler, program);
+                let reg = resolve_op(&insn.operands[1], handler, program);
+                let reg32 = to_32bit_reg(&reg);
+                w!(out, "    mov r13d, {reg32}");
+                w!(out, "    jmp QWORD PTR [{entry_points} + r13 * 8]");
             }
         }
 
@@ -2171,4 +2453,77 @@ mod tests {
         assert!(!out.contains(".seh_startepilogue"));
         assert!(!out.contains(".seh_endepilogue"));
     }
+
+    fn baseline_jit_template_state() -> HandlerState {
+        let mut state = HandlerState::new();
+        state.baseline_jit_template = Some(BaselineJitTemplate {
+            end_label: "asm_baseline_jit_template_Call_end".into(),
+            runtime_functions: vec!["asm_helper_to_boolean".into()],
+        });
+        state
+    }
+
+    #[test]
+    fn baseline_jit_template_calls_through_dispatch_table_slots() {
+        let mut program = test_program();
+        program.constants.insert("EXECUTION_CONTEXT_PROGRAM_COUNTER".into(), 16);
+        program.constants.insert("VM_RUNNING_EXECUTION_CONTEXT".into(), 24);
+        program.constants.insert("EXECUTION_CONTEXT_EXECUTABLE".into(), 32);
+        program.constants.insert("EXECUTABLE_BYTECODE_DATA".into(), 40);
+        program.constants.insert("SIZEOF_EXECUTION_CONTEXT".into(), 48);
+        program.constants.insert("EXECUTABLE_BASELINE_JIT_ENTRY_POINTS".into(), 56);
+        let handler = call_handler();
+        let mut out = String::new();
+        let mut state = baseline_jit_template_state();
+
+        for (mnemonic, function) in [("call_helper", "asm_helper_to_boolean"), ("call_slow_path", "asm_slow_path_call")] {
+            let instruction = AsmInstruction {
+                mnemonic: mnemonic.into(),
+                operands: vec![Operand::Register(function.into())],
+            };
+            emit_instruction(&mut out, &instruction, &handler, &program, &mut state, X86_64Abi::SysV);
+        }
+
+        // Slot 256 is the exit path, so the first function gets slot 257.
+        assert!(out.contains("    call QWORD PTR [r12 + 2056]"));
+        assert!(out.contains("    call QWORD PTR [r12 + 2064]"));
+        assert!(!out.contains("CSYM"));
+        assert!(!out.contains(".Lexit"));
+        assert!(state.cold_blocks.contains("    jmp QWORD PTR [r12 + 2048]"));
+        assert!(out.contains("    mov rax, QWORD PTR [rcx + 56]"));
+        assert_eq!(
+            state.baseline_jit_template.unwrap().runtime_functions,
+            vec!["asm_helper_to_boolean".to_string(), "asm_slow_path_call".to_string()]
+        );
+    }
+
+    #[test]
+    fn baseline_jit_template_falls_through_to_next_instruction() {
+        let mut program = test_program();
+        program.op_layouts.get_mut("Call").unwrap().size = Some(24);
+        let handler = call_handler();
+        let instruction = AsmInstruction {
+            mnemonic: "dispatch_next".into(),
+            operands: vec![],
+        };
+        let mut out = String::new();
+        let mut state = baseline_jit_template_state();
+
+        emit_instruction(&mut out, &instruction, &handler, &program, &mut state, X86_64Abi::SysV);
+
+        assert_eq!(out, "    add r13d, 24\n    jmp asm_baseline_jit_template_Call_end\n");
+    }
+
+    #[test]
+    fn baseline_jit_templates_must_not_refer_to_code_outside_of_them() {
+        let end_label = "asm_baseline_jit_template_Call_end";
+        assert!(is_position_independent(
+            "    jz .Lasm_Call.slow\n    jmp asm_baseline_jit_template_Call_end\n.Lasm_Call.slow:\n    jmp QWORD PTR [rax + r13 * 8]\n",
+            end_label
+        ));
+        assert!(!is_position_independent("    call CSYM(asm_slow_path_call)\n", end_label));
+        assert!(!is_position_independent("    lea rax, [rip + asm_dispatch_table]\n", end_label));
+        assert!(!is_position_independent("    jmp asm_handler_Return\n", end_label));
+        assert!(!is_position_independent("asm_some_global:\n", end_label));
+    }
 }
@@ -244,6 +244,19 @@ pub const INSTRUCTIONS: &[InstructionInfo] = &[
         ArchSpec { clobbers_gpr: &["x9", "x10"], ..ArchSpec::NONE },
     ),
 
+    // enter_baseline_jit entry_points, reg: set pc to `reg` (32-bit) and
+    // jump to the executable's baseline JIT code for that instruction.
+    info(
+        "enter_baseline_jit",
+        &[GprIn, GprIn],
+        None,
+        true,
+        false,
+        ArchSpec::NONE,
+        // aarch64: x9 holds the entry point before the branch.
+        ArchSpec { clobbers_gpr: &["x9"], ..ArchSpec::NONE },
+    ),
+
     // ------------------------------------------------------------------
     // C++ interop
     // ------------------------------------------------------------------
@@ -1108,6 +1121,7 @@ mod tests {
         "dispatch_variable",
         "dispatch_current",
         "goto_handler",
+        "enter_baseline_jit",
         "call_slow_path",
         "call_helper",
         "call_interp",
@@ -22,6 +22,26 @@
 //! The entry point is `asm_interpreter_entry(bytecode, entry_point, values, vm)`.
 //! It saves callee-saved registers, sets up pinned registers, and dispatches.
 //!
+//! ## Baseline JIT templates
+//!
+//! On x86_64 ELF, every handler is also emitted a second time as a
+//! position-independent **template** between `asm_baseline_jit_template_Op`
+//! and `asm_baseline_jit_template_Op_end`. The baseline JIT (`BaselineJIT.cpp`)
+//! copies these templates back to back, one per instruction of an
+//! Executable, so in a template:
+//!
+//! - `dispatch_next` and `dispatch_variable` fall through to the copy of the
+//!   next instruction instead of dispatching.
+//! - `goto_handler` jumps through the Executable's JIT entry points.
+//! - Calls and `exit` go through slots after the 256 opcode handlers in the
+//!   dispatch table, since relative references would break once copied.
+//!
+//! The `asm_baseline_jit_templates` table holds a `{ start, end }` pair per
+//! opcode. Handlers that switch frames (calls and returns) or refer to code
+//! outside of themselves get a template that hands the instruction back to
+//! the interpreter instead. Other targets emit a table of null pointers, which
+//! the baseline JIT takes to mean that it is not supported.
+//!
 //! ## Pinned registers
 //!
 //! These DSL names are mapped to callee-saved platform registers so they survive
@@ -62,6 +82,8 @@
 //!   and dispatch.
 //! - `goto_handler reg` -- Set pc to `reg` and dispatch (unconditional jump
 //!   to a bytecode address).
+//! - `enter_baseline_jit entry_points, reg` -- Set pc to `reg` and jump to
+//!   `entry_points[pc]`, the baseline JIT code for the instruction at pc.
 //! - `jmp label` -- Unconditional branch to a local label within the handler.
 //! - `exit` -- Jump to the exit path, returning control to C++.
 //! - `assert_eq a, b` -- In assertion-enabled builds, trap if `a != b`.
@@ -246,6 +246,9 @@ pub struct HandlerState {
     pub unique_counter: u32,
     /// Last FP comparison operands, used to elide redundant ucomisd/fcmp instructions.
     pub last_fp_compare: Option<(String, String)>,
+    /// Set while emitting a handler as a baseline JIT template instead of an
+    /// interpreter handler.
+    pub baseline_jit_template: Option<BaselineJitTemplate>,
 }
 
 impl HandlerState {
@@ -254,10 +257,44 @@ impl HandlerState {
             cold_blocks: String::new(),
             unique_counter: 0,
             last_fp_compare: None,
+            baseline_jit_template: None,
         }
     }
 }
 
+/// A handler emitted as a baseline JIT template.
+///
+/// The baseline JIT copies one template per bytecode instruction, one after
+/// the other, so templates must be position-independent: the next
+/// instruction is reached by falling off the end of the template, and
+/// everything outside of it is reached through the dispatch table.
+pub struct BaselineJitTemplate {
+    /// Label at the end of the template, where the copy of the next
+    /// instruction's template begins.
+    pub end_label: String,
+    /// External functions called by templates, in the order of their slots
+    /// after the opcode handlers and the exit in the dispatch table. Shared by
+    /// every template.
+    pub runtime_functions: Vec<String>,
+}
+
+impl BaselineJitTemplate {
+    /// Index of the dispatch table slot holding the interpreter's exit path.
+    pub const EXIT_SLOT: usize = 256;
+
+    /// Returns the dispatch table slot holding the address of `function`.
+    pub fn runtime_function_slot(&mut self, function: &str) -> usize {
+        let index = match self.runtime_functions.iter().position(|name| name == function) {
+            Some(index) => index,
+            None => {
+                self.runtime_functions.push(function.to_string());
+                self.runtime_functions.len() - 1
+            }
+        };
+        Self::EXIT_SLOT + 1 + index
+    }
+}
+
 #[derive(Debug, Clone, PartialEq, Eq)]
 pub enum ResolvedMemoryIndex {
     None,
@@ -4,16 +4,20 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/Checked.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Types.h>
+#include <LibJS/Bytecode/BaselineJIT.h>
 #include <LibJS/Bytecode/Builtins.h>
+#include <LibJS/Bytecode/Debug.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/PropertyAccess.h>
 #include <LibJS/Bytecode/PropertyNameIterator.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/ArrayPrototype.h>
 #include <LibJS/Runtime/AsyncFromSyncIteratorPrototype.h>
 #include <LibJS/Runtime/AsyncGenerator.h>
 #include <LibJS/Runtime/ClassConstruction.h>
@@ -75,30 +79,53 @@ static i64 advance_or_continue(u32 pc, i64 next_pc)
     return static_cast<i64>(pc + sizeof(Op));
 }
 
+// A non-strict direct eval can add bindings to the environments that it marks as screwed, so the bindings of those can't
+// be told apart by their position in the environment chain alone. The asm fast paths give up on them, but here we still
+// know the name that is being looked up: a screwed environment that is passed through must not have gained a binding
+// for it, and a screwed target environment must hold it as a fixed binding of its EnvironmentShape.
+static bool asm_environment_can_be_passed_through(Environment const& environment, Utf16FlyString const& name)
+{
+    if (!environment.is_declarative_environment()) [[unlikely]]
+        return false;
+    if (!environment.is_permanently_screwed_by_eval()) [[likely]]
+        return true;
+    return !MUST(environment.has_binding(name));
+}
+
+static bool asm_environment_holds_cached_binding(Environment const& environment, EnvironmentCoordinate const& cache, Utf16FlyString const& name)
+{
+    if (!environment.is_declarative_environment()) [[unlikely]]
+        return false;
+    if (!environment.is_permanently_screwed_by_eval()) [[likely]]
+        return true;
+    auto const& declarative_environment = static_cast<DeclarativeEnvironment const&>(environment);
+    return declarative_environment.is_fixed_shape_binding(cache.index) && declarative_environment.binding_name(cache.index) == name;
+}
+
 template<typename EnvironmentPointer>
-static EnvironmentPointer asm_get_cacheable_environment(EnvironmentPointer environment, EnvironmentCoordinate const& cache)
+static EnvironmentPointer asm_get_cacheable_environment(EnvironmentPointer environment, EnvironmentCoordinate const& cache, Utf16FlyString const& name)
 {
     VERIFY(cache.is_valid());
 
     for (size_t i = 0; i < cache.hops; ++i) {
-        if (!environment->is_declarative_environment() || environment->is_permanently_screwed_by_eval()) [[unlikely]]
+        if (!asm_environment_can_be_passed_through(*environment, name)) [[unlikely]]
             return nullptr;
         environment = environment->outer_environment();
         if (!environment) [[unlikely]]
             return nullptr;
     }
-    if (environment->is_declarative_environment() && !environment->is_permanently_screwed_by_eval()) [[likely]]
+    if (asm_environment_holds_cached_binding(*environment, cache, name)) [[likely]]
         return environment;
     return nullptr;
 }
 
 template<typename EnvironmentPointer>
-static EnvironmentPointer asm_get_cached_environment(EnvironmentPointer environment, EnvironmentCoordinate& cache)
+static EnvironmentPointer asm_get_cached_environment(EnvironmentPointer environment, EnvironmentCoordinate& cache, Utf16FlyString const& name)
 {
     if (!cache.is_valid()) [[unlikely]]
         return nullptr;
 
-    if (auto* cached_environment = asm_get_cacheable_environment(environment, cache)) [[likely]]
+    if (auto* cached_environment = asm_get_cacheable_environment(environment, cache, name)) [[likely]]
         return cached_environment;
 
     cache = {};
@@ -106,12 +133,12 @@ static EnvironmentPointer asm_get_cached_environment(EnvironmentPointer environm
 }
 
 template<typename EnvironmentPointer>
-static void asm_update_environment_coordinate_cache(EnvironmentPointer environment, Reference const& reference, EnvironmentCoordinate& cache)
+static void asm_update_environment_coordinate_cache(EnvironmentPointer environment, Reference const& reference, EnvironmentCoordinate& cache, Utf16FlyString const& name)
 {
     if (!reference.environment_coordinate().has_value())
         return;
     auto candidate = reference.environment_coordinate().value();
-    if (asm_get_cacheable_environment(environment, candidate))
+    if (asm_get_cacheable_environment(environment, candidate, name))
         cache = candidate;
 }
 
@@ -142,8 +169,9 @@ static i64 asm_get_binding(VM& vm, u32 pc, Operand dst, EnvironmentCoordinate co
 template<AsmBindingIsKnownToBeInitialized binding_is_known_to_be_initialized>
 static i64 asm_dynamic_get_binding(VM& vm, u32 pc, Operand dst, IdentifierTableIndex identifier_index, Strict strict, EnvironmentCoordinate& cache)
 {
+    auto const& name = vm.get_identifier(identifier_index);
     auto const* current_environment = vm.running_execution_context().lexical_environment.ptr();
-    if (auto const* cached_environment = asm_get_cached_environment(current_environment, cache)) [[likely]] {
+    if (auto const* cached_environment = asm_get_cached_environment(current_environment, cache, name)) [[likely]] {
         Value value;
         if constexpr (binding_is_known_to_be_initialized == AsmBindingIsKnownToBeInitialized::No) {
             value = ASM_TRY(vm, pc, static_cast<DeclarativeEnvironment const&>(*cached_environment).get_binding_value_direct(vm, cache.index));
@@ -154,9 +182,8 @@ static i64 asm_dynamic_get_binding(VM& vm, u32 pc, Operand dst, IdentifierTableI
         return static_cast<i64>(pc);
     }
 
-    auto& executable = vm.current_executable();
-    auto reference = ASM_TRY(vm, pc, vm.resolve_binding(executable.get_identifier(identifier_index), strict));
-    asm_update_environment_coordinate_cache(current_environment, reference, cache);
+    auto reference = ASM_TRY(vm, pc, vm.resolve_binding(name, strict));
+    asm_update_environment_coordinate_cache(current_environment, reference, cache, name);
 
     vm.set(dst, ASM_TRY(vm, pc, reference.get_value(vm)));
     return static_cast<i64>(pc);
@@ -164,16 +191,17 @@ static i64 asm_dynamic_get_binding(VM& vm, u32 pc, Operand dst, IdentifierTableI
 
 static i64 asm_dynamic_get_callee_and_this_from_environment(VM& vm, u32 pc, Operand callee_dst, Operand this_value_dst, IdentifierTableIndex identifier_index, Strict strict, EnvironmentCoordinate& cache)
 {
+    auto const& name = vm.get_identifier(identifier_index);
     auto const* current_environment = vm.running_execution_context().lexical_environment.ptr();
-    if (auto const* cached_environment = asm_get_cached_environment(current_environment, cache)) [[likely]] {
+    if (auto const* cached_environment = asm_get_cached_environment(current_environment, cache, name)) [[likely]] {
         auto callee = ASM_TRY(vm, pc, static_cast<DeclarativeEnvironment const&>(*cached_environment).get_binding_value_direct(vm, cache.index));
         vm.set(callee_dst, callee);
         vm.set(this_value_dst, js_undefined());
         return static_cast<i64>(pc);
     }
 
-    auto reference = ASM_TRY(vm, pc, vm.resolve_binding(vm.get_identifier(identifier_index), strict));
-    asm_update_environment_coordinate_cache(current_environment, reference, cache);
+    auto reference = ASM_TRY(vm, pc, vm.resolve_binding(name, strict));
+    asm_update_environment_coordinate_cache(current_environment, reference, cache, name);
 
     auto callee = ASM_TRY(vm, pc, reference.get_value(vm));
 
@@ -219,7 +247,8 @@ static i64 asm_dynamic_initialize_or_set_binding(VM& vm, u32 pc, IdentifierTable
         ? vm.running_execution_context().lexical_environment.ptr()
         : vm.running_execution_context().variable_environment.ptr();
 
-    if (auto* cached_environment = asm_get_cached_environment(environment, cache)) [[likely]] {
+    auto const& name = vm.get_identifier(identifier_index);
+    if (auto* cached_environment = asm_get_cached_environment(environment, cache, name)) [[likely]] {
         if constexpr (initialization_mode == Op::BindingInitializationMode::Initialize) {
             ASM_TRY(vm, pc, static_cast<DeclarativeEnvironment&>(*cached_environment).initialize_binding_direct(vm, cache.index, value, Environment::InitializeBindingHint::Normal));
         } else if (initialization_mode == Op::BindingInitializationMode::Set) {
@@ -228,8 +257,8 @@ static i64 asm_dynamic_initialize_or_set_binding(VM& vm, u32 pc, IdentifierTable
         return static_cast<i64>(pc);
     }
 
-    auto reference = ASM_TRY(vm, pc, vm.resolve_binding(vm.get_identifier(identifier_index), strict, environment));
-    asm_update_environment_coordinate_cache(environment, reference, cache);
+    auto reference = ASM_TRY(vm, pc, vm.resolve_binding(name, strict, environment));
+    asm_update_environment_coordinate_cache(environment, reference, cache, name);
     if constexpr (initialization_mode == Op::BindingInitializationMode::Initialize) {
         ASM_TRY(vm, pc, reference.initialize_referenced_binding(vm, value));
     } else if (initialization_mode == Op::BindingInitializationMode::Set) {
@@ -694,6 +723,7 @@ i64 asm_slow_path_instance_of(VM*, u32 pc, Op::InstanceOf const*);
 i64 asm_slow_path_in(VM*, u32 pc, Op::In const*);
 i64 asm_slow_path_get_private_by_id(VM*, u32 pc, Op::GetPrivateById const*);
 i64 asm_slow_path_put_private_by_id(VM*, u32 pc, Op::PutPrivateById const*);
+i64 asm_slow_path_tier_up_to_baseline_jit(VM*, u32 pc, u8 const* instruction);
 
 i64 asm_try_get_global_env_binding(VM*, u32 pc, Op::GetGlobal const*);
 i64 asm_try_set_global_env_binding(VM*, u32 pc, Op::SetGlobal const*);
@@ -705,6 +735,7 @@ u64 asm_helper_single_ascii_character_string(u64 encoded_value);
 u64 asm_helper_single_utf16_code_unit_string(u64 encoded_value);
 i64 asm_helper_handle_raw_native_exception(u64 encoded_exception);
 i64 asm_try_inline_call(VM*, u32 pc, Op::Call const*);
+i64 asm_try_call_builtin(VM*, u32 pc, Op::Call const*);
 i64 asm_try_put_by_id_cache(VM*, u32 pc, Op::PutById const*);
 i64 asm_try_get_by_id_cache(VM*, u32 pc, Op::GetById const*);
 
@@ -718,6 +749,15 @@ i64 asm_fallback_handler(VM*, u32, u8 const*)
     VERIFY_NOT_REACHED();
 }
 
+// ===== Tiering up to the baseline JIT =====
+// Called once the running executable has used up its tier-up budget, with pc at the target of the jump or at the start
+// of the callee. The interpreter carries on from there and enters the new code at the next jump or call.
+i64 asm_slow_path_tier_up_to_baseline_jit(VM* vm, u32 pc, u8 const*)
+{
+    tier_up_to_baseline_jit(*vm->running_execution_context().executable);
+    return pc;
+}
+
 // ===== Specific slow paths for asm-optimized instructions =====
 // These are called from asm handlers when the fast path fails.
 // Convention: i64 func(VM*, u32 pc, Op::Foo const* instruction)
@@ -1598,15 +1638,31 @@ i64 asm_slow_path_iterator_to_array(VM* vm, u32 pc, Op::IteratorToArray const* i
     }
 }
 
+// Builtin calls that were carried out without calling the builtin function, and calls that were compiled for a builtin
+// but found some other callee. The asm interpreter's own fast paths aren't counted, since that would slow them down.
+ALWAYS_INLINE static void count_builtin_call()
+{
+    if (g_collect_statistics) [[unlikely]]
+        ++g_statistics.builtin_call_count;
+}
+
+ALWAYS_INLINE static void count_builtin_call_miss()
+{
+    if (g_collect_statistics) [[unlikely]]
+        ++g_statistics.builtin_call_miss_count;
+}
+
 #define JS_DEFINE_UNARY_BUILTIN_CALL_SLOW_PATH(name, snake_case_name, implementation)                                                                                                                    \
     i64 asm_slow_path_call_builtin_##snake_case_name(VM* vm, u32 pc, Op::CallBuiltin##name const* instruction)                                                                                           \
     {                                                                                                                                                                                                    \
         Operand arguments[] { instruction->argument() };                                                                                                                                                 \
         auto callee = vm->get(instruction->callee());                                                                                                                                                    \
         if (callee.is_function() && callee.as_function().builtin() == Builtin::name) {                                                                                                                   \
+            count_builtin_call();                                                                                                                                                                        \
             vm->set(instruction->dst(), ASM_TRY(*vm, pc, implementation(*vm, vm->get(instruction->argument()))));                                                                                        \
             return static_cast<i64>(pc + sizeof(Op::CallBuiltin##name));                                                                                                                                 \
         }                                                                                                                                                                                                \
+        count_builtin_call_miss();                                                                                                                                                                       \
         ASM_TRY(*vm, pc, execute_asm_call(Op::CallType::Call, *vm, callee, vm->get(instruction->this_value()), arguments, instruction->dst(), instruction->expression_string(), instruction->strict())); \
         return static_cast<i64>(pc + sizeof(Op::CallBuiltin##name));                                                                                                                                     \
     }
@@ -1617,9 +1673,11 @@ i64 asm_slow_path_iterator_to_array(VM* vm, u32 pc, Op::IteratorToArray const* i
         Operand arguments[] { instruction->argument0(), instruction->argument1() };                                                                                                                      \
         auto callee = vm->get(instruction->callee());                                                                                                                                                    \
         if (callee.is_function() && callee.as_function().builtin() == Builtin::name) {                                                                                                                   \
+            count_builtin_call();                                                                                                                                                                        \
             vm->set(instruction->dst(), ASM_TRY(*vm, pc, implementation(*vm, vm->get(instruction->argument0()), vm->get(instruction->argument1()))));                                                    \
             return static_cast<i64>(pc + sizeof(Op::CallBuiltin##name));                                                                                                                                 \
         }                                                                                                                                                                                                \
+        count_builtin_call_miss();                                                                                                                                                                       \
         ASM_TRY(*vm, pc, execute_asm_call(Op::CallType::Call, *vm, callee, vm->get(instruction->this_value()), arguments, instruction->dst(), instruction->expression_string(), instruction->strict())); \
         return static_cast<i64>(pc + sizeof(Op::CallBuiltin##name));                                                                                                                                     \
     }
@@ -1629,9 +1687,11 @@ i64 asm_slow_path_iterator_to_array(VM* vm, u32 pc, Op::IteratorToArray const* i
     {                                                                                                                                                                                             \
         auto callee = vm->get(instruction->callee());                                                                                                                                             \
         if (callee.is_function() && callee.as_function().builtin() == Builtin::name) {                                                                                                            \
+            count_builtin_call();                                                                                                                                                                 \
             vm->set(instruction->dst(), implementation());                                                                                                                                        \
             return static_cast<i64>(pc + sizeof(Op::CallBuiltin##name));                                                                                                                          \
         }                                                                                                                                                                                         \
+        count_builtin_call_miss();                                                                                                                                                                \
         ASM_TRY(*vm, pc, execute_asm_call(Op::CallType::Call, *vm, callee, vm->get(instruction->this_value()), {}, instruction->dst(), instruction->expression_string(), instruction->strict())); \
         return static_cast<i64>(pc + sizeof(Op::CallBuiltin##name));                                                                                                                              \
     }
@@ -1683,6 +1743,8 @@ JS_DEFINE_GENERIC_BUILTIN_CALL_SLOW_PATH(StringIteratorPrototypeNext, string_ite
 JS_DEFINE_UNARY_BUILTIN_CALL_SLOW_PATH(StringFromCharCode, string_from_char_code, StringConstructor::from_char_code_impl)
 JS_DEFINE_UNARY_GENERIC_BUILTIN_CALL_SLOW_PATH(StringPrototypeCharCodeAt, string_prototype_char_code_at)
 JS_DEFINE_UNARY_GENERIC_BUILTIN_CALL_SLOW_PATH(StringPrototypeCharAt, string_prototype_char_at)
+JS_DEFINE_BINARY_BUILTIN_CALL_SLOW_PATH(MathMax, math_max, MathObject::max_impl)
+JS_DEFINE_BINARY_BUILTIN_CALL_SLOW_PATH(MathMin, math_min, MathObject::min_impl)
 
 #undef JS_DEFINE_BINARY_GENERIC_BUILTIN_CALL_SLOW_PATH
 #undef JS_DEFINE_UNARY_GENERIC_BUILTIN_CALL_SLOW_PATH
@@ -1691,6 +1753,38 @@ JS_DEFINE_UNARY_GENERIC_BUILTIN_CALL_SLOW_PATH(StringPrototypeCharAt, string_pro
 #undef JS_DEFINE_BINARY_BUILTIN_CALL_SLOW_PATH
 #undef JS_DEFINE_UNARY_BUILTIN_CALL_SLOW_PATH
 
+i64 asm_slow_path_call_builtin_number_is_integer(VM* vm, u32 pc, Op::CallBuiltinNumberIsInteger const* instruction)
+{
+    auto callee = vm->get(instruction->callee());
+    if (callee.is_function() && callee.as_function().builtin() == Builtin::NumberIsInteger) {
+        count_builtin_call();
+        vm->set(instruction->dst(), Value(vm->get(instruction->argument()).is_integral_number()));
+        return static_cast<i64>(pc + sizeof(Op::CallBuiltinNumberIsInteger));
+    }
+    count_builtin_call_miss();
+    Operand arguments[] { instruction->argument() };
+    ASM_TRY(*vm, pc, execute_asm_call(Op::CallType::Call, *vm, callee, vm->get(instruction->this_value()), arguments, instruction->dst(), instruction->expression_string(), instruction->strict()));
+    return static_cast<i64>(pc + sizeof(Op::CallBuiltinNumberIsInteger));
+}
+
+i64 asm_slow_path_call_builtin_array_prototype_push(VM* vm, u32 pc, Op::CallBuiltinArrayPrototypePush const* instruction)
+{
+    auto callee = vm->get(instruction->callee());
+    if (callee.is_function() && callee.as_function().builtin() == Builtin::ArrayPrototypePush) {
+        Value items[] { vm->get(instruction->argument()) };
+        if (auto new_length = ArrayPrototype::try_push_to_packed_array(vm->get(instruction->this_value()), items); new_length.has_value()) {
+            count_builtin_call();
+            vm->set(instruction->dst(), *new_length);
+            return static_cast<i64>(pc + sizeof(Op::CallBuiltinArrayPrototypePush));
+        }
+    } else {
+        count_builtin_call_miss();
+    }
+    Operand arguments[] { instruction->argument() };
+    ASM_TRY(*vm, pc, execute_asm_call(Op::CallType::Call, *vm, callee, vm->get(instruction->this_value()), arguments, instruction->dst(), instruction->expression_string(), instruction->strict()));
+    return static_cast<i64>(pc + sizeof(Op::CallBuiltinArrayPrototypePush));
+}
+
 i64 asm_slow_path_call_construct(VM* vm, u32 pc, Op::CallConstruct const* instruction)
 {
     ASM_TRY(*vm, pc, execute_asm_call(Op::CallType::Construct, *vm, vm->get(instruction->callee()), js_undefined(), instruction->arguments(), instruction->dst(), instruction->expression_string(), instruction->strict()));
@@ -2126,6 +2220,98 @@ i64 asm_try_inline_call(VM* vm, u32 pc, Op::Call const* instruction)
     return callee_context ? 0 : 1;
 }
 
+// Try to carry out a Call to a builtin function without calling it, like the CallBuiltin instructions do. This covers
+// the calls that the compiler couldn't tell were to a builtin, e.g. through a local alias of Math.floor. Only cases
+// that can neither throw nor call into user code are handled, so that nothing has happened if we bail out.
+// Returns 0 on success (dst written) and 1 if the caller should make the call after all.
+i64 asm_try_call_builtin(VM* vm, u32, Op::Call const* instruction)
+{
+    auto& callee = vm->get(instruction->callee()).as_function();
+    VERIFY(callee.builtin().has_value());
+
+    auto builtin = *callee.builtin();
+    auto arguments = instruction->arguments();
+    if (arguments.size() != builtin_argument_count(builtin))
+        return 1;
+
+    auto argument = [&](size_t index) { return vm->get(arguments[index]); };
+    auto arguments_are_numbers = all_of(arguments, [&](auto operand) { return vm->get(operand).is_number(); });
+
+    Optional<Value> result;
+    switch (builtin) {
+    case Builtin::MathRandom:
+        result = MathObject::random_impl();
+        break;
+    case Builtin::NumberIsInteger:
+        result = Value(argument(0).is_integral_number());
+        break;
+    case Builtin::ArrayPrototypePush: {
+        Value items[] { argument(0) };
+        result = ArrayPrototype::try_push_to_packed_array(vm->get(instruction->this_value()), items);
+        break;
+    }
+    default:
+        if (!arguments_are_numbers)
+            break;
+
+        // NB: The Math functions can only throw while converting their arguments to Numbers.
+        switch (builtin) {
+        case Builtin::MathAbs:
+            result = MUST(MathObject::abs_impl(*vm, argument(0)));
+            break;
+        case Builtin::MathLog:
+            result = MUST(MathObject::log_impl(*vm, argument(0)));
+            break;
+        case Builtin::MathExp:
+            result = MUST(MathObject::exp_impl(*vm, argument(0)));
+            break;
+        case Builtin::MathCeil:
+            result = MUST(MathObject::ceil_impl(*vm, argument(0)));
+            break;
+        case Builtin::MathFloor:
+            result = MUST(MathObject::floor_impl(*vm, argument(0)));
+            break;
+        case Builtin::MathRound:
+            result = MUST(MathObject::round_impl(*vm, argument(0)));
+            break;
+        case Builtin::MathSqrt:
+            result = MUST(MathObject::sqrt_impl(*vm, argument(0)));
+            break;
+        case Builtin::MathSin:
+            result = MUST(MathObject::sin_impl(*vm, argument(0)));
+            break;
+        case Builtin::MathCos:
+            result = MUST(MathObject::cos_impl(*vm, argument(0)));
+            break;
+        case Builtin::MathTan:
+            result = MUST(MathObject::tan_impl(*vm, argument(0)));
+            break;
+        case Builtin::MathPow:
+            result = MUST(MathObject::pow_impl(*vm, argument(0), argument(1)));
+            break;
+        case Builtin::MathImul:
+            result = MUST(MathObject::imul_impl(*vm, argument(0), argument(1)));
+            break;
+        case Builtin::MathMax:
+            result = MUST(MathObject::max_impl(*vm, argument(0), argument(1)));
+            break;
+        case Builtin::MathMin:
+            result = MUST(MathObject::min_impl(*vm, argument(0), argument(1)));
+            break;
+        default:
+            break;
+        }
+        break;
+    }
+
+    if (!result.has_value())
+        return 1;
+
+    count_builtin_call();
+    vm->set(instruction->dst(), *result);
+    return 0;
+}
+
 // Fast cache-only PutById. Tries all cache entries for ChangeOwnProperty and
 // AddOwnProperty. Returns 0 on cache hit, 1 on miss (caller should use full slow path).
 i64 asm_try_put_by_id_cache(VM* vm, u32, Op::PutById const* instruction)
@@ -2336,20 +2522,21 @@ i64 asm_slow_path_typeof_binding(VM* vm, u32 pc, Op::TypeofBinding const* instru
 i64 asm_slow_path_dynamic_typeof_binding(VM* vm, u32 pc, Op::DynamicTypeofBinding const* instruction)
 {
     auto& cache = vm->current_executable().environment_coordinate_caches[instruction->cache()];
+    auto const& name = vm->get_identifier(instruction->identifier());
     auto const* current_environment = vm->running_execution_context().lexical_environment.ptr();
-    if (auto const* environment = asm_get_cached_environment(current_environment, cache)) [[likely]] {
+    if (auto const* environment = asm_get_cached_environment(current_environment, cache, name)) [[likely]] {
         auto value = ASM_TRY(*vm, pc, static_cast<DeclarativeEnvironment const&>(*environment).get_binding_value_direct(*vm, cache.index));
         vm->set(instruction->dst(), value.typeof_(*vm));
         return static_cast<i64>(pc + sizeof(Op::DynamicTypeofBinding));
     }
 
-    auto reference = ASM_TRY(*vm, pc, vm->resolve_binding(vm->get_identifier(instruction->identifier()), instruction->strict()));
+    auto reference = ASM_TRY(*vm, pc, vm->resolve_binding(name, instruction->strict()));
     if (reference.is_unresolvable()) {
         vm->set(instruction->dst(), PrimitiveString::create(*vm, "undefined"_utf16_fly_string));
         return static_cast<i64>(pc + sizeof(Op::DynamicTypeofBinding));
     }
 
-    asm_update_environment_coordinate_cache(current_environment, reference, cache);
+    asm_update_environment_coordinate_cache(current_environment, reference, cache, name);
     auto value = ASM_TRY(*vm, pc, reference.get_value(*vm));
     vm->set(instruction->dst(), value.typeof_(*vm));
     return static_cast<i64>(pc + sizeof(Op::DynamicTypeofBinding));
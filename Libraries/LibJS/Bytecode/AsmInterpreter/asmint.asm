@@ -320,10 +320,10 @@ macro jump_binary_epilogue(slow_path_func)
     call_slow_path slow_path_func
 .take_true:
     load_label target, m_true_target
-    goto_handler target
+    goto_jump_target target
 .take_false:
     load_label target, m_false_target
-    goto_handler target
+    goto_jump_target target
 end
 
 # Coerce two operands to int32 for bitwise operations.
@@ -513,6 +513,47 @@ macro dispatch_current()
     goto_handler pc
 end
 
+# Jump to target in the current executable, in its baseline JIT code if it
+# has been compiled. Until then, every jump through here counts towards the
+# executable's tier-up budget, and the one that finds it used up compiles it.
+macro goto_counting_towards_tier_up(target)
+    temp exe, entry_points, budget
+    load64 exe, [exec_ctx, EXECUTION_CONTEXT_EXECUTABLE]
+    load64 entry_points, [exe, EXECUTABLE_BASELINE_JIT_ENTRY_POINTS]
+    branch_nonzero entry_points, .enter_baseline_jit
+    load32 budget, [exe, EXECUTABLE_BASELINE_JIT_TIER_UP_BUDGET]
+    branch_zero budget, .tier_up
+    sub budget, 1
+    store32 [exe, EXECUTABLE_BASELINE_JIT_TIER_UP_BUDGET], budget
+    goto_handler target
+.enter_baseline_jit:
+    enter_baseline_jit entry_points, target
+.tier_up: @cold
+    mov pc, target
+    call_slow_path asm_slow_path_tier_up_to_baseline_jit
+end
+
+# Like goto_counting_towards_tier_up, but without counting. Used when
+# resuming a caller, which is already counted by the jumps and calls it makes.
+macro goto_current_tier(target)
+    temp exe, entry_points
+    load64 exe, [exec_ctx, EXECUTION_CONTEXT_EXECUTABLE]
+    load64 entry_points, [exe, EXECUTABLE_BASELINE_JIT_ENTRY_POINTS]
+    branch_nonzero entry_points, .enter_baseline_jit
+    goto_handler target
+.enter_baseline_jit:
+    enter_baseline_jit entry_points, target
+end
+
+# Jump to the target of a jump instruction. Backward jumps close loops, so
+# they count towards tiering up.
+macro goto_jump_target(target)
+    branch_ge_unsigned pc, target, .backward
+    goto_handler target
+.backward:
+    goto_counting_towards_tier_up target
+end
+
 # Walk the environment chain using a statically computed EnvironmentCoordinate.
 # Input: m_environment_field is the offset of the starting environment inside
 # ExecutionContext. m_cache_field is the offset of the EnvironmentCoordinate
@@ -593,6 +634,8 @@ macro pop_inline_frame_and_resume(caller_frame, value_reg)
     lea value_addr, [caller_frame, SIZEOF_EXECUTION_CONTEXT]
     store64 [value_addr, dst_idx, 8], value_reg
 
+    # The caller is published before the callee's stack memory is released,
+    # so the sampling profiler never walks a frame that is being reused.
     load_vm vm
     store64 [vm, VM_RUNNING_EXECUTION_CONTEXT], caller_frame
     store64 [vm, VM_INTERPRETER_STACK_TOP], exec_ctx
@@ -604,8 +647,7 @@ macro pop_inline_frame_and_resume(caller_frame, value_reg)
     load64 pb, [exe, EXECUTABLE_BYTECODE_DATA]
     assert_nonzero pb
     lea values, [exec_ctx, SIZEOF_EXECUTION_CONTEXT]
-    mov pc, ret_pc
-    dispatch_current
+    goto_current_tier ret_pc
 end
 
 macro load_property_lookup_cache(cache, fail_label)
@@ -794,7 +836,7 @@ end
 handler Jump
     temp target
     load_label target, m_target
-    goto_handler target
+    goto_jump_target target
 end
 
 # Conditional jumps: check boolean first (most common), then int32, then slow path.
@@ -821,10 +863,10 @@ handler JumpIf
     jmp .take_false
 .take_true:
     load_label target, m_true_target
-    goto_handler target
+    goto_jump_target target
 .take_false:
     load_label target, m_false_target
-    goto_handler target
+    goto_jump_target target
 end
 
 handler JumpTrue
@@ -845,7 +887,7 @@ handler JumpTrue
     dispatch_next
 .take:
     load_label target, m_target
-    goto_handler target
+    goto_jump_target target
 end
 
 handler JumpFalse
@@ -866,7 +908,7 @@ handler JumpFalse
     dispatch_next
 .take:
     load_label target, m_target
-    goto_handler target
+    goto_jump_target target
 end
 
 # Nullish check: undefined and null tags differ only in bit 0,
@@ -879,10 +921,10 @@ handler JumpNullish
     and tag, 0xFFFE
     branch_eq tag, UNDEFINED_TAG, .nullish
     load_label target, m_false_target
-    goto_handler target
+    goto_jump_target target
 .nullish:
     load_label target, m_true_target
-    goto_handler target
+    goto_jump_target target
 end
 
 handler JumpUndefined
@@ -891,10 +933,10 @@ handler JumpUndefined
     mov undef, UNDEFINED_SHIFTED
     branch_eq condition, undef, .is_undefined
     load_label target, m_false_target
-    goto_handler target
+    goto_jump_target target
 .is_undefined:
     load_label target, m_true_target
-    goto_handler target
+    goto_jump_target target
 end
 
 
@@ -1759,7 +1801,7 @@ end
 
 # Fast path for array[int32_index] = value with Packed/Holey indexed storage.
 handler PutByValue
-    temp kind, base, prop, base_tag, prop_tag, index, obj, flags, storage_kind, size, elements, src, capacity_addr, capacity, slot, empty_tag, kind_byte, addr, src_int32, max, result, cached_offset, invalid_offset
+    temp kind, base, prop, base_tag, prop_tag, index, obj, flags, storage_kind, element_kind, size, elements, src, src_tag, capacity_addr, capacity, slot, empty_tag, kind_byte, addr, src_int32, max, result, cached_offset, invalid_offset
     ftemp src_dbl
     # Only fast-path Normal puts (not Getter/Setter/Own)
     load8 kind, [pb, pc, m_kind]
@@ -1788,6 +1830,14 @@ handler PutByValue
     load64 elements, [obj, OBJECT_INDEXED_ELEMENTS]
     assert_nonzero elements
     load_operand src, m_src
+    # Stores that would widen the element kind go through C++, which records the transition.
+    load8 element_kind, [obj, OBJECT_INDEXED_ELEMENT_KIND]
+    branch_eq element_kind, INDEXED_ELEMENT_KIND_ANY, .store_packed
+    extract_tag src_tag, src
+    branch_eq src_tag, INT32_TAG, .store_packed
+    branch_eq element_kind, INDEXED_ELEMENT_KIND_INT32, .slow
+    check_tag_is_double src_tag, .slow
+.store_packed:
     store64 [elements, index, 8], src
     dispatch_next
 .not_packed:
@@ -1914,9 +1964,11 @@ handler GetById
     load64 props, [obj, OBJECT_NAMED_PROPERTIES]
     assert_nonzero props
     load64 value, [props, prop_offset, 8]
-    # Check value is not an accessor
+    # Check value is not an accessor. The C++ cache probe bails on the same
+    # accessor, so getters go straight to the slow path, which calls them
+    # (or their fast version, for WebIDL attributes) through the cache.
     extract_tag tag, value
-    branch_eq tag, ACCESSOR_TAG, .try_cache
+    branch_eq tag, ACCESSOR_TAG, .slow
     store_operand m_dst, value
     dispatch_next
 .proto:
@@ -1932,7 +1984,7 @@ handler GetById
     assert_nonzero props
     load64 value, [props, prop_offset, 8]
     extract_tag tag, value
-    branch_eq tag, ACCESSOR_TAG, .try_cache
+    branch_eq tag, ACCESSOR_TAG, .slow
     store_operand m_dst, value
     dispatch_next
 .try_cache:
@@ -2520,12 +2572,14 @@ handler Call
     load64 pb, [frame_base, EXECUTION_CONTEXT_EXECUTABLE]
     load64 pb, [pb, EXECUTABLE_BYTECODE_DATA]
     assert_nonzero pb
+    # Publish the callee only now that its caller linkage and executable are
+    # stored, as the sampling profiler walks it as soon as it is running.
     load_vm vm_ptr
     store64 [vm_ptr, VM_RUNNING_EXECUTION_CONTEXT], frame_base
     mov exec_ctx, frame_base
     lea values, [exec_ctx, SIZEOF_EXECUTION_CONTEXT]
     xor pc, pc
-    goto_handler pc
+    goto_counting_towards_tier_up pc
 .call_interp_inline:
     # Shared escape hatch for the cases that need C++ help to build the
     # inline frame correctly but can still stay in the asm-managed inline-frame
@@ -2541,7 +2595,7 @@ handler Call
     load64 pb, [scratch, EXECUTABLE_BYTECODE_DATA]
     assert_nonzero pb
     xor pc, pc
-    goto_handler pc
+    goto_counting_towards_tier_up pc
 .call_try_native:
     # Fast path for RawNativeFunction: the callee is a plain C++ function
     # pointer with no JS-visible prologue, so we can build the callee frame
@@ -2549,6 +2603,9 @@ handler Call
     # objects that still carry a callback (NativeJavaScriptBackedFunction)
     # do not have this flag set and fall through to .call_slow.
     load8 flags, [callee, OBJECT_FLAGS]
+    load8 scratch, [callee, FUNCTION_OBJECT_BUILTIN_HAS_VALUE]
+    branch_nonzero scratch, .call_builtin
+.call_try_raw_native:
     branch_bits_clear flags, OBJECT_FLAG_IS_RAW_NATIVE_FUNCTION, .call_slow
 
     # Unlike the ECMAScript path we don't pad to the formal parameter count:
@@ -2674,7 +2731,9 @@ handler Call
 .enter_raw_native:
     # Swap the running ExecutionContext over to the callee and point the
     # asm `values` register at its argument array. After this, we look like
-    # a normal inline frame from the VM's perspective.
+    # a normal inline frame from the VM's perspective. The frame's caller
+    # linkage and null executable are already stored, so the sampling
+    # profiler can walk it as soon as it is published.
     load_vm vm_ptr
     store64 [vm_ptr, VM_RUNNING_EXECUTION_CONTEXT], frame_base
     mov exec_ctx, frame_base
@@ -2696,6 +2755,8 @@ handler Call
     # Normal return path: tear the callee frame off the interpreter stack,
     # restore the caller as the running ExecutionContext, write the return
     # value into the caller's m_dst operand, and dispatch the next insn.
+    # As in pop_inline_frame_and_resume, the caller is published before the
+    # stack top is rewound.
     load64 frame_base, [exec_ctx, EXECUTION_CONTEXT_CALLER_FRAME]
     assert_nonzero frame_base
     load_vm vm_ptr
@@ -2740,6 +2801,20 @@ handler Call
     # No JS handler caught the native exception; bail out of the asm
     # dispatch loop and let the C++ caller of run_asm() see the throw.
     exit
+.call_builtin:
+    # Builtins reached through a plain Call (e.g. an aliased Math.max) can
+    # often be carried out in C++ without building a callee frame at all.
+    # On a miss, the helper has done nothing and we take the generic native
+    # path; temporaries don't survive the call, so reload the callee first.
+    call_interp asm_try_call_builtin, result
+    branch_nonzero result, .call_builtin_miss
+    load32 after_offset, [pb, pc, m_length]
+    dispatch_variable after_offset
+.call_builtin_miss:
+    load_operand callee_value, m_callee
+    unbox_object callee, callee_value
+    load8 flags, [callee, OBJECT_FLAGS]
+    jmp .call_try_raw_native
 .call_slow: @cold
     call_slow_path asm_slow_path_call
 end
@@ -2994,6 +3069,71 @@ handler CallBuiltinStringPrototypeCharAt
     call_slow_path asm_slow_path_call_builtin_string_prototype_char_at
 end
 
+# Math.max/Math.min with two int32 arguments: pick one of the operands as-is.
+# Everything else (doubles, -0, NaN, coercion) is handled in C++.
+macro math_min_max_int32(expected_builtin, keep_lhs_cc, slow_path_func)
+    temp lhs, rhs, tag, lhs_int, rhs_int
+    validate_callee_builtin expected_builtin, .slow
+    load_operand lhs, m_argument0
+    load_operand rhs, m_argument1
+    extract_tag tag, lhs
+    branch_ne tag, INT32_TAG, .slow
+    extract_tag tag, rhs
+    branch_ne tag, INT32_TAG, .slow
+    unbox_int32 lhs_int, lhs
+    unbox_int32 rhs_int, rhs
+    keep_lhs_cc lhs_int, rhs_int, .keep_lhs
+    store_operand m_dst, rhs
+    dispatch_next
+.keep_lhs:
+    store_operand m_dst, lhs
+    dispatch_next
+.slow: @cold
+    call_slow_path slow_path_func
+end
+
+handler CallBuiltinMathMax
+    math_min_max_int32 BUILTIN_MATH_MAX, branch_ge_signed, asm_slow_path_call_builtin_math_max
+end
+
+handler CallBuiltinMathMin
+    math_min_max_int32 BUILTIN_MATH_MIN, branch_le_signed, asm_slow_path_call_builtin_math_min
+end
+
+handler CallBuiltinNumberIsInteger
+    temp arg, tag, result
+    ftemp arg_dbl, scratch_dbl
+    validate_callee_builtin BUILTIN_NUMBER_IS_INTEGER, .slow
+    load_operand arg, m_argument
+    check_is_double arg, .try_int32
+    # x - x is NaN exactly when x is NaN or an infinity, neither of which is
+    # an integral Number.
+    fp_mov arg_dbl, arg
+    fp_mov scratch_dbl, arg
+    fp_sub scratch_dbl, arg_dbl
+    branch_fp_unordered scratch_dbl, scratch_dbl, .store_false
+    fp_floor scratch_dbl, arg_dbl
+    branch_fp_equal scratch_dbl, arg_dbl, .store_true
+    jmp .store_false
+.try_int32:
+    extract_tag tag, arg
+    branch_eq tag, INT32_TAG, .store_true
+.store_false:
+    mov result, BOOLEAN_FALSE
+    store_operand m_dst, result
+    dispatch_next
+.store_true:
+    mov result, BOOLEAN_TRUE
+    store_operand m_dst, result
+    dispatch_next
+.slow: @cold
+    call_slow_path asm_slow_path_call_builtin_number_is_integer
+end
+
+handler CallBuiltinArrayPrototypePush @cold
+    call_slow_path asm_slow_path_call_builtin_array_prototype_push
+end
+
 # ============================================================================
 # Slow-path-only handlers
 # ============================================================================
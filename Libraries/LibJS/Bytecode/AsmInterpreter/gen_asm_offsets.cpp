@@ -55,6 +55,7 @@ int main()
     EMIT_OFFSET(OBJECT_NAMED_PROPERTIES, Object, m_named_properties);
     EMIT_OFFSET(OBJECT_INDEXED_ELEMENTS, Object, m_indexed_elements);
     EMIT_OFFSET(OBJECT_INDEXED_STORAGE_KIND, Object, m_indexed_storage_kind);
+    EMIT_OFFSET(OBJECT_INDEXED_ELEMENT_KIND, Object, m_indexed_element_kind);
     EMIT_OFFSET(OBJECT_INDEXED_ARRAY_LIKE_SIZE, Object, m_indexed_array_like_size);
     EMIT_SIZEOF(OBJECT_SIZE, Object);
 
@@ -130,6 +131,8 @@ int main()
     EMIT_OFFSET(EXECUTABLE_REGISTERS_AND_LOCALS_AND_CONSTANTS_COUNT, Executable, registers_and_locals_and_constants_count);
     EMIT_OFFSET(EXECUTABLE_ASM_CONSTANTS_SIZE, Executable, asm_constants_size);
     EMIT_OFFSET(EXECUTABLE_ASM_CONSTANTS_DATA, Executable, asm_constants_data);
+    EMIT_OFFSET(EXECUTABLE_BASELINE_JIT_ENTRY_POINTS, Executable, baseline_jit_entry_points);
+    EMIT_OFFSET(EXECUTABLE_BASELINE_JIT_TIER_UP_BUDGET, Executable, baseline_jit_tier_up_budget);
 
     // ExecutionContext layout
     outln("\n# ExecutionContext layout");
@@ -195,6 +198,12 @@ int main()
     outln("const INDEXED_STORAGE_KIND_HOLEY = {}", static_cast<u8>(IndexedStorageKind::Holey));
     outln("const INDEXED_STORAGE_KIND_DICTIONARY = {}", static_cast<u8>(IndexedStorageKind::Dictionary));
 
+    // IndexedElementKind enum values
+    outln("\n# IndexedElementKind enum values");
+    outln("const INDEXED_ELEMENT_KIND_INT32 = {}", static_cast<u8>(IndexedElementKind::Int32));
+    outln("const INDEXED_ELEMENT_KIND_NUMBER = {}", static_cast<u8>(IndexedElementKind::Number));
+    outln("const INDEXED_ELEMENT_KIND_ANY = {}", static_cast<u8>(IndexedElementKind::Any));
+
     // ObjectPropertyIteratorFastPath enum values
     outln("\n# ObjectPropertyIteratorFastPath enum values");
     outln("const OBJECT_PROPERTY_ITERATOR_FAST_PATH_NONE = {}", static_cast<u8>(ObjectPropertyIteratorFastPath::None));
@@ -258,6 +267,9 @@ int main()
     outln("const BUILTIN_STRING_FROM_CHAR_CODE = {}", static_cast<u8>(Bytecode::Builtin::StringFromCharCode));
     outln("const BUILTIN_STRING_PROTOTYPE_CHAR_CODE_AT = {}", static_cast<u8>(Bytecode::Builtin::StringPrototypeCharCodeAt));
     outln("const BUILTIN_STRING_PROTOTYPE_CHAR_AT = {}", static_cast<u8>(Bytecode::Builtin::StringPrototypeCharAt));
+    outln("const BUILTIN_MATH_MAX = {}", static_cast<u8>(Bytecode::Builtin::MathMax));
+    outln("const BUILTIN_MATH_MIN = {}", static_cast<u8>(Bytecode::Builtin::MathMin));
+    outln("const BUILTIN_NUMBER_IS_INTEGER = {}", static_cast<u8>(Bytecode::Builtin::NumberIsInteger));
 
     // FunctionObject layout
     outln("\n# FunctionObject layout");
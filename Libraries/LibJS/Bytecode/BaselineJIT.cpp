@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/NumericLimits.h>
+#include <LibJS/Bytecode/BaselineJIT.h>
+#include <LibJS/Bytecode/Debug.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Runtime/ExternalMemory.h>
+
+#if !defined(AK_OS_WINDOWS)
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+namespace JS::Bytecode {
+
+// One { start, end } pair per opcode, emitted by asmintgen next to the asm interpreter's handlers. Targets that have no
+// templates emit null pointers.
+struct AsmBaselineJITTemplate {
+    u8 const* start;
+    u8 const* end;
+};
+
+extern "C" AsmBaselineJITTemplate const asm_baseline_jit_templates[256];
+
+// ud2, for the entry points that fall within an instruction and after the last one.
+static constexpr Array<u8, 2> trap_instruction { 0x0f, 0x0b };
+
+static ReadonlyBytes template_for(Instruction const& instruction)
+{
+    auto const& code = asm_baseline_jit_templates[to_underlying(instruction.type())];
+    return { code.start, static_cast<size_t>(code.end - code.start) };
+}
+
+ErrorOr<NonnullOwnPtr<BaselineJITCode>> BaselineJITCode::compile(Executable const& executable)
+{
+#if defined(AK_OS_WINDOWS)
+    (void)executable;
+    return Error::from_errno(ENOTSUP);
+#else
+    auto bytecode = executable.bytecode.span();
+    if (bytecode.is_empty())
+        return Error::from_errno(EINVAL);
+
+    size_t code_size = trap_instruction.size();
+    for (size_t offset = 0; offset < bytecode.size();) {
+        auto const& instruction = *reinterpret_cast<Instruction const*>(bytecode.offset_pointer(offset));
+        auto code = template_for(instruction);
+        if (!code.data())
+            return Error::from_errno(ENOTSUP);
+        code_size += code.size();
+        offset += instruction.length();
+    }
+
+    auto jit_code = TRY(adopt_nonnull_own_or_enomem(new (nothrow) BaselineJITCode));
+    TRY(jit_code->m_entry_points.try_resize(bytecode.size()));
+
+    auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto mapping_size = align_up_to(code_size, page_size);
+    auto* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (mapping == MAP_FAILED)
+        return Error::from_errno(errno);
+    jit_code->m_code = static_cast<u8*>(mapping);
+    jit_code->m_code_size = mapping_size;
+
+    auto* code_base = jit_code->m_code;
+    auto& entry_points = jit_code->m_entry_points;
+    size_t code_offset = 0;
+    auto trap_address = reinterpret_cast<FlatPtr>(code_base + code_size - trap_instruction.size());
+    for (size_t offset = 0; offset < bytecode.size();) {
+        auto const& instruction = *reinterpret_cast<Instruction const*>(bytecode.offset_pointer(offset));
+        auto code = template_for(instruction);
+        __builtin_memcpy(code_base + code_offset, code.data(), code.size());
+
+        auto length = instruction.length();
+        entry_points[offset] = reinterpret_cast<FlatPtr>(code_base + code_offset);
+        for (size_t i = 1; i < length; ++i)
+            entry_points[offset + i] = trap_address;
+
+        code_offset += code.size();
+        offset += length;
+    }
+    __builtin_memcpy(code_base + code_offset, trap_instruction.data(), trap_instruction.size());
+
+    if (mprotect(mapping, mapping_size, PROT_READ | PROT_EXEC) != 0)
+        return Error::from_errno(errno);
+    __builtin___clear_cache(reinterpret_cast<char*>(code_base), reinterpret_cast<char*>(code_base + code_size));
+
+    return jit_code;
+#endif
+}
+
+BaselineJITCode::~BaselineJITCode()
+{
+#if !defined(AK_OS_WINDOWS)
+    if (m_code)
+        munmap(m_code, m_code_size);
+#endif
+}
+
+size_t BaselineJITCode::external_memory_size() const
+{
+    return saturating_add_external_memory_size(m_code_size, vector_external_memory_size(m_entry_points));
+}
+
+void tier_up_to_baseline_jit(Executable& executable)
+{
+    if (executable.baseline_jit_code)
+        return;
+
+    auto code_or_error = BaselineJITCode::compile(executable);
+    if (code_or_error.is_error()) {
+        executable.baseline_jit_tier_up_budget = NumericLimits<u32>::max();
+        return;
+    }
+
+    executable.baseline_jit_code = code_or_error.release_value();
+    executable.baseline_jit_entry_points = executable.baseline_jit_code->entry_points();
+
+    if (g_collect_statistics) [[unlikely]] {
+        ++g_statistics.baseline_jit_executable_count;
+        g_statistics.baseline_jit_code_bytes += executable.baseline_jit_code->code_size();
+    }
+}
+
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Noncopyable.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+// Straight-line machine code for one Executable, made by copying the asm interpreter's handler template for each of
+// its instructions in bytecode order, so that execution falls from one instruction into the next without dispatching.
+// The templates keep using the Executable's inline caches and the interpreter's slow paths, so execution can move
+// between the two tiers at any instruction boundary.
+class BaselineJITCode {
+    AK_MAKE_NONCOPYABLE(BaselineJITCode);
+    AK_MAKE_NONMOVABLE(BaselineJITCode);
+
+public:
+    static ErrorOr<NonnullOwnPtr<BaselineJITCode>> compile(Executable const&);
+    ~BaselineJITCode();
+
+    // The code for the instruction at each bytecode offset. Offsets within an instruction lead to a trap.
+    [[nodiscard]] FlatPtr const* entry_points() const { return m_entry_points.data(); }
+    [[nodiscard]] size_t code_size() const { return m_code_size; }
+    [[nodiscard]] size_t external_memory_size() const;
+
+private:
+    BaselineJITCode() = default;
+
+    u8* m_code { nullptr };
+    size_t m_code_size { 0 };
+    Vector<FlatPtr> m_entry_points;
+};
+
+// Compiles the executable for the baseline JIT, unless it already has been. An executable that cannot be compiled is
+// left to the interpreter for good.
+void tier_up_to_baseline_jit(Executable&);
+
+}
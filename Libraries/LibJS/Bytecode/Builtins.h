@@ -37,7 +37,11 @@ namespace JS::Bytecode {
     O(StringIteratorPrototypeNext, string_iterator_prototype_next, StringIteratorPrototype, next, 0) \
     O(StringFromCharCode, string_from_char_code, String, fromCharCode, 1)                            \
     O(StringPrototypeCharCodeAt, string_prototype_char_code_at, StringPrototype, charCodeAt, 1)      \
-    O(StringPrototypeCharAt, string_prototype_char_at, StringPrototype, charAt, 1)
+    O(StringPrototypeCharAt, string_prototype_char_at, StringPrototype, charAt, 1)                   \
+    O(MathMax, math_max, Math, max, 2)                                                               \
+    O(MathMin, math_min, Math, min, 2)                                                               \
+    O(NumberIsInteger, number_is_integer, Number, isInteger, 1)                                      \
+    O(ArrayPrototypePush, array_prototype_push, ArrayPrototype, push, 1)
 
 enum class Builtin : u8 {
 #define DEFINE_BUILTIN_ENUM(name, ...) name,
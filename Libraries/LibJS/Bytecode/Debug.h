@@ -6,10 +6,33 @@
 
 #pragma once
 
+#include <AK/Types.h>
 #include <LibJS/Export.h>
 
 namespace JS::Bytecode {
 
 JS_API extern bool g_dump_bytecode;
 
+// Totals for benchmark harnesses to report. Nothing is counted unless g_collect_statistics is set.
+struct Statistics {
+    // Executables that were compiled or loaded from the bytecode cache, and the size of their bytecode.
+    u64 executable_count { 0 };
+    u64 bytecode_bytes { 0 };
+
+    // Entries into the interpreter from native code. Calls from JS to JS stay within the interpreter and aren't counted.
+    u64 interpreter_entry_count { 0 };
+
+    // Calls to builtins that were carried out without calling the builtin function, and calls that were compiled for a
+    // builtin but found a different callee. The calls that the asm interpreter carries out inline aren't counted.
+    u64 builtin_call_count { 0 };
+    u64 builtin_call_miss_count { 0 };
+
+    // Executables that ran hot enough to be compiled for the baseline JIT, and the size of the code made for them.
+    u64 baseline_jit_executable_count { 0 };
+    u64 baseline_jit_code_bytes { 0 };
+};
+
+JS_API extern bool g_collect_statistics;
+JS_API extern Statistics g_statistics;
+
 }
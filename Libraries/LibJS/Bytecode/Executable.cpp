@@ -10,13 +10,17 @@
 #include <AK/StdLibExtras.h>
 #include <LibGC/Heap.h>
 #include <LibGC/HeapBlock.h>
+#include <LibJS/Bytecode/BaselineJIT.h>
+#include <LibJS/Bytecode/Debug.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/RegexTable.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ExternalMemory.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/SharedFunctionInstanceData.h>
+#include <LibJS/Runtime/Symbol.h>
 #include <LibJS/Runtime/Value.h>
 #include <LibJS/RustIntegration.h>
 #include <LibJS/SourceCode.h>
@@ -306,6 +310,11 @@ Executable::Executable(
     object_property_iterator_caches.resize(number_of_object_property_iterator_caches);
     asm_constants_size = this->constants.size();
     asm_constants_data = this->constants.data();
+
+    if (g_collect_statistics) [[unlikely]] {
+        ++g_statistics.executable_count;
+        g_statistics.bytecode_bytes += this->bytecode.size();
+    }
 }
 
 Executable::~Executable() = default;
@@ -515,6 +524,8 @@ size_t Executable::external_memory_size() const
     size = saturating_add_external_memory_size(size, vector_external_memory_size(source_map));
     size = saturating_add_external_memory_size(size, vector_external_memory_size(local_variable_names));
     size = saturating_add_external_memory_size(size, hash_map_external_memory_size(m_source_range_cache));
+    if (baseline_jit_code)
+        size = saturating_add_external_memory_size(size, baseline_jit_code->external_memory_size());
     return size;
 }
 
@@ -557,6 +568,49 @@ void StaticPropertyLookupCache::sweep_all()
     }
 }
 
+size_t MegamorphicPropertyLookupCache::slot_index(Shape const& shape, PropertyKey const& key)
+{
+    return pair_int_hash(ptr_hash(&shape), Traits<PropertyKey>::hash(key)) & (entry_count - 1);
+}
+
+PropertyLookupCache::Entry const* MegamorphicPropertyLookupCache::find(Shape const& shape, PropertyKey const& key) const
+{
+    auto const& slot = m_slots[slot_index(shape, key)];
+    auto const& entry = slot.entry;
+    if (entry.shape != &shape || !slot.key.has_value() || *slot.key != key)
+        return nullptr;
+    if (shape.is_dictionary() && shape.dictionary_generation() != entry.shape_dictionary_generation)
+        return nullptr;
+    if (entry.prototype) {
+        auto const* prototype_chain_validity = entry.prototype_chain_validity.ptr();
+        if (!prototype_chain_validity || !prototype_chain_validity->is_valid())
+            return nullptr;
+    }
+    return &entry;
+}
+
+void MegamorphicPropertyLookupCache::insert(PropertyKey const& key, PropertyLookupCache::Entry const& entry)
+{
+    VERIFY(entry.shape);
+    auto& slot = m_slots[slot_index(*entry.shape, key)];
+    slot.key = key;
+    slot.entry = entry;
+}
+
+void MegamorphicPropertyLookupCache::remove_dead_cells()
+{
+    for (auto& slot : m_slots) {
+        if (!slot.key.has_value())
+            continue;
+        clear_cache_entry_if_dead(slot.entry);
+        // A dead shape or holder makes the slot useless, and a dead symbol key must not be matched by a new symbol
+        // allocated at the same address.
+        bool key_is_dead = slot.key->is_symbol() && cell_is_dead(slot.key->as_symbol());
+        if (!slot.entry.shape || (slot.entry.type == PropertyLookupCache::Entry::Type::GetPropertyInPrototypeChain && !slot.entry.prototype) || key_is_dead)
+            slot = {};
+    }
+}
+
 void Executable::remove_dead_cells(Badge<GC::Heap>)
 {
     for (auto& cache : property_lookup_caches) {
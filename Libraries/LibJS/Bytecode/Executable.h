@@ -33,6 +33,8 @@
 
 namespace JS::Bytecode {
 
+class BaselineJITCode;
+
 class InstructionStream {
 public:
     explicit InstructionStream(Vector<u8>);
@@ -143,6 +145,14 @@ struct PropertyLookupCache {
 
     void clear();
 
+    // Every polymorphic slot has been filled, so remembering further shapes here would only evict the ones we have.
+    // Lookups that miss should go through the VM's MegamorphicPropertyLookupCache instead.
+    [[nodiscard]] bool is_megamorphic() const
+    {
+        auto const* data = polymorphic_data();
+        return data && data->entries.last().type != Entry::Type::Empty;
+    }
+
     static constexpr FlatPtr polymorphic_data_tag = 1;
     FlatPtr m_data { 0 };
 
@@ -156,6 +166,36 @@ private:
     static bool entries_have_same_cache_key(Entry const&, Entry const&);
 };
 
+// A fixed-size, direct-mapped (shape, property key) -> entry table shared by every megamorphic property lookup site.
+// Entries keep their PrototypeChainValidity, so prototype chain mutations invalidate them just like per-site entries.
+class MegamorphicPropertyLookupCache {
+    AK_MAKE_NONCOPYABLE(MegamorphicPropertyLookupCache);
+    AK_MAKE_NONMOVABLE(MegamorphicPropertyLookupCache);
+
+public:
+    static constexpr size_t entry_count = 4096;
+    static_assert(is_power_of_two(entry_count));
+
+    MegamorphicPropertyLookupCache() = default;
+
+    // Returns the entry for (shape, key) if it is still usable: same shape and dictionary generation, and for
+    // prototype chain hits, a prototype chain that hasn't been mutated since.
+    [[nodiscard]] PropertyLookupCache::Entry const* find(Shape const&, PropertyKey const&) const;
+    void insert(PropertyKey const&, PropertyLookupCache::Entry const&);
+
+    void remove_dead_cells();
+
+private:
+    struct Slot {
+        Optional<PropertyKey> key;
+        PropertyLookupCache::Entry entry;
+    };
+
+    [[nodiscard]] static size_t slot_index(Shape const&, PropertyKey const&);
+
+    AK::Array<Slot, entry_count> m_slots;
+};
+
 // A PropertyLookupCache for use as a static local variable.
 // Registers itself for GC sweep since it's not owned by any Executable.
 struct StaticPropertyLookupCache : public PropertyLookupCache {
@@ -319,6 +359,13 @@ public:
     size_t asm_constants_size { 0 };
     Value const* asm_constants_data { nullptr };
 
+    // Jumps backwards and calls into this executable that are left before it is compiled for the baseline JIT.
+    static constexpr u32 baseline_jit_tier_up_threshold = 1000;
+    u32 baseline_jit_tier_up_budget { baseline_jit_tier_up_threshold };
+    OwnPtr<BaselineJITCode> baseline_jit_code;
+    // Read by the asm interpreter, which enters the baseline JIT code once this is set.
+    FlatPtr const* baseline_jit_entry_points { nullptr };
+
     struct ExceptionHandlers {
         size_t start_offset;
         size_t end_offset;
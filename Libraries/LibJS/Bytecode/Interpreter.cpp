@@ -5,7 +5,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <AK/TemporaryChange.h>
+#include <LibJS/Bytecode/BaselineJIT.h>
 #include <LibJS/Bytecode/Debug.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Label.h>
@@ -32,6 +34,8 @@ using namespace Bytecode;
 extern "C" void asm_interpreter_entry(u8 const* bytecode, u32 entry_point, Value* values, VM* vm);
 
 bool Bytecode::g_dump_bytecode = false;
+bool Bytecode::g_collect_statistics = false;
+Bytecode::Statistics Bytecode::g_statistics;
 
 // 16.1.6 ScriptEvaluation ( scriptRecord ), https://tc39.es/ecma262/#sec-runtime-semantics-scriptevaluation
 ThrowCompletionOr<Value> VM::run(Script& script_record, GC::Ptr<Environment> lexical_environment_override)
@@ -155,10 +159,11 @@ VM::HandleExceptionResponse VM::handle_exception(u32 program_counter, Value exce
             auto* caller_frame = callee_frame->caller_frame;
             auto caller_pc = callee_frame->caller_return_pc;
 
+            // NB: The caller is published before the callee's stack memory is released, so that the sampling
+            //     profiler never walks a frame that is being reused.
+            set_running_execution_context(caller_frame);
             vm().interpreter_stack().deallocate(callee_frame);
 
-            m_running_execution_context = caller_frame;
-
             // NB: caller_pc is the return address (one past the Call instruction).
             //     For handler lookup we need a PC inside the Call instruction,
             //     since the exception occurred during that call, not after it.
@@ -224,20 +229,21 @@ ExecutionContext* VM::push_inline_frame(
     }
     callee_context->private_environment = callee_function.m_private_environment;
 
+    // Set up execution context fields that run_executable normally does.
+    // NB: We must use the callee's realm (not the caller's) for global_object
+    //     and global_declarative_environment, since the caller's realm may differ
+    //     in cross-realm calls (e.g. iframe <-> parent).
+    callee_context->executable = callee_executable;
+
     // Inline JS-to-JS frames stay out of the VM execution context stack and
     // are tracked through caller_frame instead.
-    m_running_execution_context = callee_context;
+    // NB: This comes after the executable is set, as the sampling profiler reads it as soon as the frame is published.
+    set_running_execution_context(callee_context);
 
     // Bind this if the function uses it.
     if (callee_function.uses_this())
         callee_function.ordinary_call_bind_this(vm(), *callee_context, this_value);
 
-    // Set up execution context fields that run_executable normally does.
-    // NB: We must use the callee's realm (not the caller's) for global_object
-    //     and global_declarative_environment, since the caller's realm may differ
-    //     in cross-realm calls (e.g. iframe <-> parent).
-    callee_context->executable = callee_executable;
-
     // Set this value register.
     auto* values = callee_context->registers_and_constants_and_locals_and_arguments();
     values[Register::this_value().index()] = callee_context->this_value.value_or(js_special_empty_value());
@@ -252,8 +258,8 @@ NEVER_INLINE void VM::unwind_inline_frame_for_exception()
     VERIFY(callee_frame->caller_frame);
 
     auto* caller_frame = callee_frame->caller_frame;
+    set_running_execution_context(caller_frame);
     vm().interpreter_stack().deallocate(callee_frame);
-    m_running_execution_context = caller_frame;
 }
 
 Utf16FlyString const& VM::get_identifier(IdentifierTableIndex index) const
@@ -276,11 +282,18 @@ ThrowCompletionOr<Value> VM::run_executable(ExecutionContext& context, Executabl
     auto const is_outermost_bytecode_execution = m_run_executable_depth == 0;
     TemporaryChange restore_run_executable_depth { m_run_executable_depth, m_run_executable_depth + 1 };
 
+    context.executable = executable;
+
     // NOTE: This is how we "push" a new execution context onto the VM's
     //       execution context stack.
-    TemporaryChange restore_running_execution_context { m_running_execution_context, &context };
+    auto* previous_running_execution_context = m_running_execution_context;
+    set_running_execution_context(&context);
+    ScopeGuard restore_running_execution_context = [this, previous_running_execution_context] {
+        set_running_execution_context(previous_running_execution_context);
+    };
 
-    context.executable = executable;
+    if (g_collect_statistics) [[unlikely]]
+        ++g_statistics.interpreter_entry_count;
 
     VERIFY(executable.registers_and_locals_count + executable.constants.size() == executable.registers_and_locals_and_constants_count);
     VERIFY(executable.registers_and_locals_and_constants_count <= context.registers_and_constants_and_locals_and_arguments_span().size());
@@ -298,6 +311,15 @@ ThrowCompletionOr<Value> VM::run_executable(ExecutionContext& context, Executabl
         auto* bytecode = executable.bytecode.data();
         auto* values = context.registers_and_constants_and_locals_and_arguments_span().data();
 
+        // NB: Entries from native code count towards tiering up like the calls the asm interpreter makes itself, and
+        //     asm_interpreter_entry() starts in the baseline JIT code once there is some.
+        if (!executable.baseline_jit_entry_points) {
+            if (executable.baseline_jit_tier_up_budget == 0)
+                tier_up_to_baseline_jit(executable);
+            else
+                --executable.baseline_jit_tier_up_budget;
+        }
+
         asm_interpreter_entry(bytecode, entry_point, values, this);
     }
 
@@ -14,6 +14,7 @@
 #include <LibJS/Runtime/Completion.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/FunctionObject.h>
+#include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/VM.h>
@@ -38,6 +39,17 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_cached_property_value(VM& vm, Value v
     auto* getter = value.as_accessor().getter();
     if (!getter)
         return js_undefined();
+
+    // OPTIMIZATION: Getters with a fast version (e.g. those of WebIDL attributes) can be called directly, skipping the
+    //               execution context and argument setup of a call. As that leaves the current realm as it is, this
+    //               is only done if the getter belongs to the current realm.
+    if (auto* native_getter = as_if<RawNativeFunction>(*getter); native_getter && native_getter->fast_getter()
+        && this_value.is_object() && native_getter->realm() == vm.current_realm()) {
+        auto result = TRY(native_getter->fast_getter()(vm, this_value.as_object()));
+        if (!result.is_special_empty_value())
+            return result;
+    }
+
     return TRY(call(vm, *getter, this_value));
 }
 
@@ -157,6 +169,17 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_by_id(VM& vm, GetBaseIdentifier get_b
             }
         }
     }
+
+    // OPTIMIZATION: Sites that have seen more shapes than the inline cache can hold share one global table instead.
+    bool const is_megamorphic = cache.is_megamorphic();
+    if (is_megamorphic) {
+        if (auto const* cache_entry = vm.megamorphic_property_lookup_cache().find(shape, property_name)) {
+            auto const* holder = cache_entry->prototype ? cache_entry->prototype.ptr() : base_obj.ptr();
+            auto value = holder->get_direct(cache_entry->property_offset);
+            return TRY(get_cached_property_value(vm, value, this_value));
+        }
+    }
+
     GC::Ptr<PrototypeChainValidity> prototype_chain_validity;
     if (shape.prototype())
         prototype_chain_validity = shape.prototype()->shape().prototype_chain_validity();
@@ -164,12 +187,23 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_by_id(VM& vm, GetBaseIdentifier get_b
     CacheableGetPropertyMetadata cacheable_metadata;
     auto value = TRY(base_obj->internal_get(property_name, this_value, &cacheable_metadata));
 
+    auto update_cache = [&](PropertyLookupCache::Entry::Type type, auto callback) {
+        if (!is_megamorphic) {
+            cache.update(type, callback);
+            return;
+        }
+        PropertyLookupCache::Entry entry;
+        entry.type = type;
+        callback(entry);
+        vm.megamorphic_property_lookup_cache().insert(property_name, entry);
+    };
+
     // If internal_get() caused object's shape change, we can no longer be sure
     // that collected metadata is valid, e.g. if getter in prototype chain added
     // property with the same name into the object itself.
     if (&shape == &base_obj->shape()) {
         if (cacheable_metadata.type == CacheableGetPropertyMetadata::Type::GetOwnProperty) {
-            cache.update(PropertyLookupCache::Entry::Type::GetOwnProperty, [&](auto& entry) {
+            update_cache(PropertyLookupCache::Entry::Type::GetOwnProperty, [&](auto& entry) {
                 entry.shape = shape;
                 entry.property_offset = cacheable_metadata.property_offset.value();
 
@@ -178,7 +212,7 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_by_id(VM& vm, GetBaseIdentifier get_b
                 }
             });
         } else if (cacheable_metadata.type == CacheableGetPropertyMetadata::Type::GetPropertyInPrototypeChain) {
-            cache.update(PropertyLookupCache::Entry::Type::GetPropertyInPrototypeChain, [&](auto& entry) {
+            update_cache(PropertyLookupCache::Entry::Type::GetPropertyInPrototypeChain, [&](auto& entry) {
                 entry.shape = &base_obj->shape();
                 entry.property_offset = cacheable_metadata.property_offset.value();
                 entry.prototype = const_cast<Object*>(cacheable_metadata.prototype.ptr());
@@ -211,6 +211,7 @@ class Script;
 class Shape;
 class SharedFunctionInstanceData;
 class StringOrSymbol;
+class SamplingProfiler;
 class SourceCode;
 struct SourceRange;
 class SourceTextModule;
@@ -312,6 +313,7 @@ template<typename T>
 requires(!IsLvalueReference<T>)
 class ThrowCompletionOr;
 using NativeFunctionPointer = ThrowCompletionOr<Value> (*)(VM&);
+using NativeFastGetterPointer = ThrowCompletionOr<Value> (*)(VM&, Object& this_object);
 
 namespace Bytecode {
 
@@ -6,6 +6,7 @@
  */
 
 #include <AK/Function.h>
+#include <AK/QuickSort.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayPrototype.h>
@@ -13,6 +14,7 @@
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/NativeFunction.h>
+#include <LibJS/Runtime/TypedArray.h>
 #include <LibJS/Runtime/ValueInlines.h>
 
 namespace JS {
@@ -168,8 +170,73 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     return true;
 }
 
+// Orders the items the way the SortCompare that's used without a comparefn would, if that can be done without calling it
+// and without anyone being able to tell that the sort wasn't stable.
+static bool sort_items_without_sort_compare(VM& vm, GC::RootVector<Value>& items, DefaultSortCompare default_sort_compare)
+{
+    switch (default_sort_compare) {
+    case DefaultSortCompare::None:
+        return false;
+    case DefaultSortCompare::TypedArrayElements:
+        // NB: Without a comparefn, CompareTypedArrayElements can't throw and only finds elements that are the same value
+        //     to be equal, as it orders -0 before +0.
+        quick_sort(items, [&](Value x, Value y) { return MUST(compare_typed_array_elements(vm, x, y, nullptr)) < 0; });
+        return true;
+    case DefaultSortCompare::ArrayElements:
+        break;
+    }
+
+    bool all_strings = true;
+    bool all_numbers = true;
+    for (auto item : items) {
+        if (item.is_undefined())
+            continue;
+        all_strings &= item.is_string();
+        all_numbers &= item.is_number();
+        if (!all_strings && !all_numbers)
+            return false;
+    }
+
+    // Undefined goes after everything else, and every undefined is the same.
+    size_t defined_count = 0;
+    for (auto item : items) {
+        if (!item.is_undefined())
+            items[defined_count++] = item;
+    }
+    for (auto i = defined_count; i < items.size(); ++i)
+        items[i] = js_undefined();
+
+    auto defined_items = items.span().slice(0, defined_count);
+
+    // Strings that are equal are indistinguishable, so they may be sorted by their UTF-16 views in any order.
+    if (all_strings) {
+        quick_sort(defined_items, [](Value x, Value y) { return x.as_string().utf16_string_view() < y.as_string().utf16_string_view(); });
+        return true;
+    }
+
+    // Numbers are ordered by their strings, which are created once up front rather than for every comparison. Only +0
+    // and -0 share a string, so numbers with equal strings keep their order by falling back to their index.
+    struct NumberSortKey {
+        Utf16String string;
+        Value value;
+        size_t index { 0 };
+    };
+    Vector<NumberSortKey> keys;
+    keys.ensure_capacity(defined_count);
+    for (size_t i = 0; i < defined_count; ++i)
+        keys.unchecked_append({ number_to_utf16_string(defined_items[i].as_double()), defined_items[i], i });
+
+    quick_sort(keys, [](auto const& x, auto const& y) {
+        auto result = x.string <=> y.string;
+        return result < 0 || (result == 0 && x.index < y.index);
+    });
+    for (size_t i = 0; i < defined_count; ++i)
+        defined_items[i] = keys[i].value;
+    return true;
+}
+
 // 23.1.3.30.1 SortIndexedProperties ( obj, len, SortCompare, holes ), https://tc39.es/ecma262/#sec-sortindexedproperties
-ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes)
+ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes, DefaultSortCompare default_sort_compare)
 {
     // 1. Let items be a new empty List.
     GC::RootVector<Value> items;
@@ -209,13 +276,12 @@ ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object
     }
 
     // 4. Sort items using an implementation-defined sequence of calls to SortCompare. If any such call returns an abrupt completion, stop before performing any further calls to SortCompare or steps in this algorithm and return that Completion Record.
-
-    // Perform sorting by merge sort. This isn't as efficient compared to quick sort, but
-    // quicksort can't be used in all cases because the spec requires Array.prototype.sort()
-    // to be stable. FIXME: when initially scanning through the array, maintain a flag
-    // for if an unstable sort would be indistinguishable from a stable sort (such as just
-    // just strings or numbers), and in that case use quick sort instead for better performance.
-    TRY(array_merge_sort(vm, sort_compare, items));
+    // OPTIMIZATION: Without a comparefn, typed array elements and items that are all strings or all numbers are sorted
+    //               without going through SortCompare.
+    if (!sort_items_without_sort_compare(vm, items, default_sort_compare)) {
+        // NB: The sort has to be stable, which rules out quick sort for everything else.
+        TRY(array_merge_sort(vm, sort_compare, items));
+    }
 
     // 5. Return items.
     return items;
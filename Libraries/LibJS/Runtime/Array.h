@@ -94,7 +94,15 @@ enum class Holes {
     ReadThroughHoles,
 };
 
-ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
+// NB: Tells SortIndexedProperties which comparison SortCompare performs when there is no comparefn, so that it may order
+//     the items without calling SortCompare where the difference can't be observed.
+enum class DefaultSortCompare {
+    None,
+    ArrayElements,
+    TypedArrayElements,
+};
+
+ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes, DefaultSortCompare = DefaultSortCompare::None);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
 }
@@ -323,6 +323,19 @@ public:
         return callback(storage.bytes());
     }
 
+    // The bytes can be written to in place unless they wrap around the end of the cage.
+    Optional<Bytes> contiguous_bytes(size_t offset, size_t count)
+    {
+        VERIFY(offset <= size());
+        VERIFY(count <= size() - offset);
+
+        if (count == 0)
+            return Bytes {};
+        if (contiguous_bytes_from(offset, count) != count)
+            return {};
+        return Bytes { data_at(offset), count };
+    }
+
     void overwrite(size_t offset, void const* source, size_t count)
     {
         VERIFY(offset <= size());
@@ -487,6 +500,7 @@ public:
     ErrorOr<ByteBuffer> copy_to_byte_buffer() const { return m_data_block.copy_to_byte_buffer(); }
     template<typename Callback>
     decltype(auto) with_readonly_bytes(size_t offset, size_t count, Callback callback) const { return m_data_block.with_readonly_bytes(offset, count, move(callback)); }
+    Optional<Bytes> contiguous_bytes(size_t offset, size_t count) { return m_data_block.contiguous_bytes(offset, count); }
     void copy_data_to(ArrayBuffer& destination, size_t source_offset, size_t destination_offset, size_t count) const { m_data_block.copy_to(destination.m_data_block, source_offset, destination_offset, count); }
     void copy_data_to(DataBlock& destination, size_t source_offset, size_t destination_offset, size_t count) const { m_data_block.copy_to(destination, source_offset, destination_offset, count); }
     void overwrite(size_t offset, void const* source, size_t count) { m_data_block.overwrite(offset, source, count); }
@@ -10,6 +10,7 @@
 #include <AK/Function.h>
 #include <AK/HashTable.h>
 #include <AK/NeverDestroyed.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Utf16StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -68,7 +69,7 @@ void ArrayPrototype::initialize(Realm& realm)
     define_native_function(realm, vm.names.lastIndexOf, last_index_of, 1, attr);
     define_native_function(realm, vm.names.map, map, 1, attr);
     define_native_function(realm, vm.names.pop, pop, 0, attr);
-    define_native_function(realm, vm.names.push, push, 1, attr);
+    define_native_function(realm, vm.names.push, push, 1, attr, Bytecode::Builtin::ArrayPrototypePush);
     define_native_function(realm, vm.names.reduce, reduce, 1, attr);
     define_native_function(realm, vm.names.reduceRight, reduce_right, 1, attr);
     define_native_function(realm, vm.names.reverse, reverse, 0, attr);
@@ -186,6 +187,87 @@ static Array* fast_array_species_result(Object& object)
     return array;
 }
 
+enum class NaNIsEqual {
+    No,
+    Yes,
+};
+
+// Number-only packed elements can be searched without looking at each element's type.
+static Optional<size_t> find_number_in_packed_elements(ReadonlySpan<Value> elements, IndexedElementKind element_kind, size_t start, Value search_element, NaNIsEqual nan_is_equal)
+{
+    VERIFY(element_kind != IndexedElementKind::Any);
+
+    if (!search_element.is_number())
+        return {};
+    auto number = search_element.as_double();
+
+    if (element_kind == IndexedElementKind::Int32) {
+        // NOTE: This also rejects NaN, which no int32 element can match.
+        if (!(number >= NumericLimits<i32>::min() && number <= NumericLimits<i32>::max()) || trunc(number) != number)
+            return {};
+        auto encoded = Value(static_cast<i32>(number)).encoded();
+        for (auto k = start; k < elements.size(); ++k) {
+            if (elements[k].encoded() == encoded)
+                return k;
+        }
+        return {};
+    }
+
+    if (isnan(number)) {
+        if (nan_is_equal == NaNIsEqual::No)
+            return {};
+        for (auto k = start; k < elements.size(); ++k) {
+            if (elements[k].is_nan())
+                return k;
+        }
+        return {};
+    }
+
+    for (auto k = start; k < elements.size(); ++k) {
+        if (elements[k].as_double() == number)
+            return k;
+    }
+    return {};
+}
+
+// Orders two non-negative integers the way their decimal strings would compare.
+static int compare_as_decimal_strings(u64 lhs, u64 rhs)
+{
+    auto digit_count = [](u64 value) {
+        size_t count = 1;
+        for (; value >= 10; value /= 10)
+            ++count;
+        return count;
+    };
+
+    auto lhs_digits = digit_count(lhs);
+    auto rhs_digits = digit_count(rhs);
+
+    // Scale the shorter number up so both have the same number of digits, then compare them numerically. If they
+    // are equal then, the shorter one is a prefix of the longer one and sorts first.
+    auto lhs_scaled = lhs;
+    auto rhs_scaled = rhs;
+    for (auto digits = lhs_digits; digits < rhs_digits; ++digits)
+        lhs_scaled *= 10;
+    for (auto digits = rhs_digits; digits < lhs_digits; ++digits)
+        rhs_scaled *= 10;
+
+    if (lhs_scaled != rhs_scaled)
+        return lhs_scaled < rhs_scaled ? -1 : 1;
+    if (lhs_digits != rhs_digits)
+        return lhs_digits < rhs_digits ? -1 : 1;
+    return 0;
+}
+
+static bool int32_sorts_before_by_string(i32 lhs, i32 rhs)
+{
+    // '-' sorts before every digit, so negative numbers come first, ordered by the digits of their magnitude.
+    if ((lhs < 0) != (rhs < 0))
+        return lhs < 0;
+    auto magnitude = [](i32 value) { return static_cast<u64>(value < 0 ? -static_cast<i64>(value) : value); };
+    return compare_as_decimal_strings(magnitude(lhs), magnitude(rhs)) < 0;
+}
+
 // 23.1.3.1 Array.prototype.at ( index ), https://tc39.es/ecma262/#sec-array.prototype.at
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::at)
 {
@@ -460,6 +542,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::fill)
     else
         to = min(relative_end, length);
 
+    // OPTIMIZATION: Every index of a simple packed array below its size is a writable own data property, so Set is
+    //               a plain store.
+    if (auto* array = as_if<Array>(*this_object); array && array->is_simple_packed_array() && to <= array->indexed_array_like_size()) {
+        if (from < to)
+            array->indexed_fill(from, to, vm.argument(0));
+        return this_object;
+    }
+
     for (u64 i = from; i < to; i++)
         TRY(this_object->set(i, vm.argument(0), Object::ShouldThrowExceptions::Yes));
 
@@ -823,6 +913,20 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // OPTIMIZATION: Simple packed arrays have an own data property for every index below their length,
+    //               so Get cannot produce side effects or observe prototype indexed properties.
+    if (auto* array = as_if<Array>(*this_object); array && array->is_simple_packed_array() && array->indexed_array_like_size() == length) {
+        auto elements = array->indexed_packed_elements_span();
+        if (auto element_kind = array->indexed_element_kind(); element_kind != IndexedElementKind::Any)
+            return Value(find_number_in_packed_elements(elements, element_kind, from_index, value_to_find, NaNIsEqual::Yes).has_value());
+        for (auto i = from_index; i < elements.size(); ++i) {
+            if (same_value_zero(elements[i], value_to_find))
+                return Value(true);
+        }
+        return Value(false);
+    }
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -884,6 +988,10 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
     // so HasProperty and Get cannot produce side effects or observe prototype indexed properties.
     if (auto* array = as_if<Array>(*object); array && array->is_simple_packed_array() && array->indexed_array_like_size() == length) {
         auto elements = array->indexed_packed_elements_span();
+        if (auto element_kind = array->indexed_element_kind(); element_kind != IndexedElementKind::Any) {
+            auto index = find_number_in_packed_elements(elements, element_kind, k, search_element, NaNIsEqual::No);
+            return index.has_value() ? Value(*index) : Value(-1);
+        }
         for (; k < elements.size(); ++k) {
             if (is_strictly_equal(search_element, elements[k]))
                 return Value(k);
@@ -1107,21 +1215,31 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::pop)
     return element;
 }
 
+Optional<Value> ArrayPrototype::try_push_to_packed_array(Value this_value, ReadonlySpan<Value> items)
+{
+    if (!this_value.is_object())
+        return {};
+
+    auto* array = as_if<Array>(this_value.as_object());
+    if (!array || !array->is_simple_packed_array()
+        || !array->default_prototype_chain_intact()
+        || !array->extensible()
+        || !array->length_is_writable())
+        return {};
+
+    for (auto item : items)
+        array->indexed_append(item);
+    return Value(array->indexed_array_like_size());
+}
+
 // 23.1.3.23 Array.prototype.push ( ...items ), https://tc39.es/ecma262/#sec-array.prototype.push
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
 {
-    auto this_object = TRY(vm.this_value().to_object(vm));
-
     // OPTIMIZATION: Fast path for packed arrays.
-    if (auto* array = as_if<Array>(*this_object); array && array->is_simple_packed_array()
-        && array->default_prototype_chain_intact()
-        && array->extensible()
-        && array->length_is_writable()) {
-        auto argument_count = vm.argument_count();
-        for (size_t i = 0; i < argument_count; ++i)
-            array->indexed_append(vm.argument(i));
-        return Value(array->indexed_array_like_size());
-    }
+    if (auto new_length = try_push_to_packed_array(vm.this_value(), vm.running_execution_context().arguments_span()); new_length.has_value())
+        return *new_length;
+
+    auto this_object = TRY(vm.this_value().to_object(vm));
 
     auto length = TRY(length_of_array_like(vm, this_object));
     auto argument_count = vm.argument_count();
@@ -1415,12 +1533,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::slice)
 
     // OPTIMIZATION: Fast path for packed arrays when ArraySpeciesCreate
     // produced a default Array result.
-    if (auto* array = as_if<Array>(*this_object); array && can_use_packed_array_fast_path(*array)) {
+    if (auto* array = as_if<Array>(*this_object); array && can_use_packed_array_fast_path(*array) && final <= array->indexed_array_like_size()) {
         if (auto* result_array = fast_array_species_result(*new_array)) {
             u32 start = static_cast<u32>(actual_start);
             u32 end = static_cast<u32>(final);
-            for (u32 i = start; i < end; ++i)
-                result_array->indexed_put(i - start, array->indexed_get(i)->value);
+            if (start < end)
+                result_array->set_indexed_property_elements(array->indexed_packed_elements_span().slice(start, end - start));
             return result_array;
         }
     }
@@ -1488,62 +1606,440 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::some)
     return Value(false);
 }
 
-ThrowCompletionOr<void> array_merge_sort(VM& vm, Function<ThrowCompletionOr<double>(Value, Value)> const& compare_func, GC::RootVector<Value>& arr_to_sort)
+// A stable sort after Tim Peters' listsort (https://github.com/python/cpython/blob/main/Objects/listsort.txt). It
+// finds the runs that are already in order and merges them, galloping through stretches of one run that all go before
+// the next element of the other one, so arrays that are mostly sorted take far fewer comparisons than a plain merge sort.
+class ArrayTimSort {
+public:
+    ArrayTimSort(Function<ThrowCompletionOr<double>(Value, Value)> const& compare_function, GC::RootVector<Value>& items)
+        : m_compare_function(compare_function)
+        , m_items(items)
+    {
+    }
+
+    ThrowCompletionOr<void> sort();
+
+private:
+    struct Run {
+        size_t start { 0 };
+        size_t length { 0 };
+    };
+
+    static constexpr size_t minimum_gallop = 7;
+
+    ThrowCompletionOr<bool> sorts_before(Value lhs, Value rhs) const { return TRY(m_compare_function(lhs, rhs)) < 0; }
+
+    ThrowCompletionOr<size_t> count_run_and_make_ascending(size_t start);
+    ThrowCompletionOr<void> binary_insertion_sort(size_t start, size_t end, size_t sorted_end);
+    ThrowCompletionOr<size_t> gallop_left(Value key, ReadonlySpan<Value> run, size_t hint) const;
+    ThrowCompletionOr<size_t> gallop_right(Value key, ReadonlySpan<Value> run, size_t hint) const;
+    ThrowCompletionOr<void> merge_collapse();
+    ThrowCompletionOr<void> merge_force_collapse();
+    ThrowCompletionOr<void> merge_at(size_t index);
+    ThrowCompletionOr<void> merge_low(Run, Run);
+    ThrowCompletionOr<void> merge_high(Run, Run);
+
+    Function<ThrowCompletionOr<double>(Value, Value)> const& m_compare_function;
+    GC::RootVector<Value>& m_items;
+
+    // NB: Elements that are being merged are moved out of m_items into here, and the comparator may run a garbage
+    //     collection, so this has to be rooted as well.
+    GC::RootVector<Value> m_scratch;
+
+    Vector<Run, 64> m_runs;
+    size_t m_min_gallop { minimum_gallop };
+};
+
+// Runs shorter than this are extended with an insertion sort first, such that the number of runs is a power of two or
+// just below one, which keeps the merges balanced.
+static size_t minimum_run_length(size_t length)
+{
+    size_t remainder = 0;
+    while (length >= 64) {
+        remainder |= length & 1;
+        length >>= 1;
+    }
+    return length + remainder;
+}
+
+ThrowCompletionOr<void> ArrayTimSort::sort()
 {
-    // FIXME: it would probably be better to switch to insertion sort for small arrays for
-    // better performance
-    if (arr_to_sort.size() <= 1)
+    auto remaining = m_items.size();
+    if (remaining < 2)
         return {};
 
-    GC::RootVector<Value> left;
-    GC::RootVector<Value> right;
+    auto min_run = minimum_run_length(remaining);
+    m_scratch.ensure_capacity(remaining / 2);
 
-    left.ensure_capacity(arr_to_sort.size() / 2);
-    right.ensure_capacity(arr_to_sort.size() / 2 + (arr_to_sort.size() & 1));
+    for (size_t start = 0; remaining > 0;) {
+        auto run_length = TRY(count_run_and_make_ascending(start));
 
-    for (size_t i = 0; i < arr_to_sort.size(); ++i) {
-        if (i < arr_to_sort.size() / 2) {
-            left.append(arr_to_sort[i]);
-        } else {
-            right.append(arr_to_sort[i]);
+        if (run_length < min_run) {
+            auto forced_length = min(min_run, remaining);
+            TRY(binary_insertion_sort(start, start + forced_length, start + run_length));
+            run_length = forced_length;
         }
+
+        m_runs.append({ start, run_length });
+        TRY(merge_collapse());
+
+        start += run_length;
+        remaining -= run_length;
     }
 
-    TRY(array_merge_sort(vm, compare_func, left));
-    TRY(array_merge_sort(vm, compare_func, right));
+    return merge_force_collapse();
+}
 
-    arr_to_sort.clear();
+ThrowCompletionOr<size_t> ArrayTimSort::count_run_and_make_ascending(size_t start)
+{
+    auto end = m_items.size();
+    auto run_end = start + 1;
+    if (run_end == end)
+        return 1;
 
-    size_t left_index = 0, right_index = 0;
+    // NB: Only strictly descending runs may be reversed, as reversing equal elements would make the sort unstable.
+    auto is_descending = TRY(sorts_before(m_items[run_end], m_items[start]));
+    for (++run_end; run_end < end; ++run_end) {
+        if (TRY(sorts_before(m_items[run_end], m_items[run_end - 1])) != is_descending)
+            break;
+    }
 
-    while (left_index < left.size() && right_index < right.size()) {
-        auto x = left[left_index];
-        auto y = right[right_index];
+    if (is_descending)
+        m_items.span().slice(start, run_end - start).reverse();
+    return run_end - start;
+}
 
-        double comparison_result = TRY(compare_func(x, y));
+ThrowCompletionOr<void> ArrayTimSort::binary_insertion_sort(size_t start, size_t end, size_t sorted_end)
+{
+    for (auto index = sorted_end; index < end; ++index) {
+        auto pivot = m_items[index];
+
+        // Find the position after every element that the pivot doesn't sort before, which keeps equal elements in order.
+        auto low = start;
+        auto high = index;
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (TRY(sorts_before(pivot, m_items[middle])))
+                high = middle;
+            else
+                low = middle + 1;
+        }
 
-        if (comparison_result <= 0) {
-            arr_to_sort.append(x);
-            left_index++;
-        } else {
-            arr_to_sort.append(y);
-            right_index++;
+        for (auto i = index; i > low; --i)
+            m_items[i] = m_items[i - 1];
+        m_items[low] = pivot;
+    }
+    return {};
+}
+
+// Returns the number of elements in the run that sort before the key, searching outwards from the hint.
+ThrowCompletionOr<size_t> ArrayTimSort::gallop_left(Value key, ReadonlySpan<Value> run, size_t hint) const
+{
+    size_t low = 0;
+    size_t high = 0;
+    size_t previous_offset = 0;
+    size_t offset = 1;
+
+    if (TRY(sorts_before(run[hint], key))) {
+        auto max_offset = run.size() - hint;
+        while (offset < max_offset) {
+            if (!TRY(sorts_before(run[hint + offset], key)))
+                break;
+            previous_offset = offset;
+            offset = offset * 2 + 1;
+        }
+        offset = min(offset, max_offset);
+        low = hint + previous_offset + 1;
+        high = hint + offset;
+    } else {
+        auto max_offset = hint + 1;
+        while (offset < max_offset) {
+            if (TRY(sorts_before(run[hint - offset], key)))
+                break;
+            previous_offset = offset;
+            offset = offset * 2 + 1;
+        }
+        offset = min(offset, max_offset);
+        low = hint + 1 - offset;
+        high = hint - previous_offset;
+    }
+
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        if (TRY(sorts_before(run[middle], key)))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return high;
+}
+
+// Returns the number of elements in the run that the key doesn't sort before, searching outwards from the hint.
+ThrowCompletionOr<size_t> ArrayTimSort::gallop_right(Value key, ReadonlySpan<Value> run, size_t hint) const
+{
+    size_t low = 0;
+    size_t high = 0;
+    size_t previous_offset = 0;
+    size_t offset = 1;
+
+    if (TRY(sorts_before(key, run[hint]))) {
+        auto max_offset = hint + 1;
+        while (offset < max_offset) {
+            if (!TRY(sorts_before(key, run[hint - offset])))
+                break;
+            previous_offset = offset;
+            offset = offset * 2 + 1;
         }
+        offset = min(offset, max_offset);
+        low = hint + 1 - offset;
+        high = hint - previous_offset;
+    } else {
+        auto max_offset = run.size() - hint;
+        while (offset < max_offset) {
+            if (TRY(sorts_before(key, run[hint + offset])))
+                break;
+            previous_offset = offset;
+            offset = offset * 2 + 1;
+        }
+        offset = min(offset, max_offset);
+        low = hint + previous_offset + 1;
+        high = hint + offset;
     }
 
-    while (left_index < left.size()) {
-        arr_to_sort.append(left[left_index]);
-        left_index++;
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        if (TRY(sorts_before(key, run[middle])))
+            high = middle;
+        else
+            low = middle + 1;
     }
+    return high;
+}
 
-    while (right_index < right.size()) {
-        arr_to_sort.append(right[right_index]);
-        right_index++;
+// Merges the runs at the top of the stack until their lengths shrink faster than the Fibonacci numbers going up.
+ThrowCompletionOr<void> ArrayTimSort::merge_collapse()
+{
+    while (m_runs.size() > 1) {
+        auto index = m_runs.size() - 2;
+        if ((index > 0 && m_runs[index - 1].length <= m_runs[index].length + m_runs[index + 1].length)
+            || (index > 1 && m_runs[index - 2].length <= m_runs[index - 1].length + m_runs[index].length)) {
+            if (m_runs[index - 1].length < m_runs[index + 1].length)
+                --index;
+        } else if (m_runs[index].length > m_runs[index + 1].length) {
+            break;
+        }
+        TRY(merge_at(index));
     }
+    return {};
+}
 
+ThrowCompletionOr<void> ArrayTimSort::merge_force_collapse()
+{
+    while (m_runs.size() > 1) {
+        auto index = m_runs.size() - 2;
+        if (index > 0 && m_runs[index - 1].length < m_runs[index + 1].length)
+            --index;
+        TRY(merge_at(index));
+    }
     return {};
 }
 
+ThrowCompletionOr<void> ArrayTimSort::merge_at(size_t index)
+{
+    auto a = m_runs[index];
+    auto b = m_runs[index + 1];
+    m_runs[index].length += b.length;
+    m_runs.remove(index + 1);
+
+    // The elements of A that B's first element doesn't sort before are in place already.
+    auto elements_in_place = TRY(gallop_right(m_items[b.start], m_items.span().slice(a.start, a.length), 0));
+    a.start += elements_in_place;
+    a.length -= elements_in_place;
+    if (a.length == 0)
+        return {};
+
+    // So are the elements of B that don't sort before A's last element.
+    b.length = TRY(gallop_left(m_items[a.start + a.length - 1], m_items.span().slice(b.start, b.length), b.length - 1));
+    if (b.length == 0)
+        return {};
+
+    if (a.length <= b.length)
+        return merge_low(a, b);
+    return merge_high(a, b);
+}
+
+// Merges A and B from the front, with A moved out of the way.
+ThrowCompletionOr<void> ArrayTimSort::merge_low(Run a, Run b)
+{
+    m_scratch.clear_with_capacity();
+    for (size_t i = 0; i < a.length; ++i)
+        m_scratch.append(m_items[a.start + i]);
+
+    auto a_length = a.length;
+    auto b_length = b.length;
+    auto b_end = b.start + b.length;
+
+    auto next_a = [&] { return m_scratch.size() - a_length; };
+    auto next_b = [&] { return b_end - b_length; };
+    auto take_from_a = [&](size_t count) {
+        for (; count > 0; --count, --a_length)
+            m_items[next_b() - a_length] = m_scratch[next_a()];
+    };
+    auto take_from_b = [&](size_t count) {
+        for (; count > 0; --count, --b_length)
+            m_items[next_b() - a_length] = m_items[next_b()];
+    };
+
+    // B's first element sorts before all of A, or merge_at() would have left it in place.
+    take_from_b(1);
+
+    auto result = [&]() -> ThrowCompletionOr<void> {
+        if (b_length == 0 || a_length == 1)
+            return {};
+
+        while (true) {
+            size_t a_wins = 0;
+            size_t b_wins = 0;
+
+            while ((a_wins | b_wins) < m_min_gallop) {
+                if (TRY(sorts_before(m_items[next_b()], m_scratch[next_a()]))) {
+                    take_from_b(1);
+                    ++b_wins;
+                    a_wins = 0;
+                    if (b_length == 0)
+                        return {};
+                } else {
+                    take_from_a(1);
+                    ++a_wins;
+                    b_wins = 0;
+                    if (a_length == 1)
+                        return {};
+                }
+            }
+
+            // One run keeps winning, so gallop through it for as long as that pays off.
+            ++m_min_gallop;
+            do {
+                m_min_gallop -= m_min_gallop > 1;
+
+                a_wins = TRY(gallop_right(m_items[next_b()], m_scratch.span().slice(next_a(), a_length), 0));
+                take_from_a(a_wins);
+                if (a_length <= 1)
+                    return {};
+
+                take_from_b(1);
+                if (b_length == 0)
+                    return {};
+
+                b_wins = TRY(gallop_left(m_scratch[next_a()], m_items.span().slice(next_b(), b_length), 0));
+                take_from_b(b_wins);
+                if (b_length == 0)
+                    return {};
+
+                take_from_a(1);
+                if (a_length == 1)
+                    return {};
+            } while (a_wins >= minimum_gallop || b_wins >= minimum_gallop);
+            ++m_min_gallop;
+        }
+    }();
+    TRY(result);
+
+    // NB: A's last element goes after whatever is left of B. If it's B that ran out, the rest of A goes at the end.
+    if (a_length == 1)
+        take_from_b(b_length);
+    take_from_a(a_length);
+    return {};
+}
+
+// Merges A and B from the back, with B moved out of the way.
+ThrowCompletionOr<void> ArrayTimSort::merge_high(Run a, Run b)
+{
+    m_scratch.clear_with_capacity();
+    for (size_t i = 0; i < b.length; ++i)
+        m_scratch.append(m_items[b.start + i]);
+
+    auto a_length = a.length;
+    auto b_length = b.length;
+
+    auto last_a = [&] { return a.start + a_length - 1; };
+    auto last_b = [&] { return b_length - 1; };
+    auto take_from_a = [&](size_t count) {
+        for (; count > 0; --count, --a_length)
+            m_items[last_a() + b_length] = m_items[last_a()];
+    };
+    auto take_from_b = [&](size_t count) {
+        for (; count > 0; --count, --b_length)
+            m_items[a.start + a_length + last_b()] = m_scratch[last_b()];
+    };
+
+    // A's last element sorts after all of B, or merge_at() would have left it in place.
+    take_from_a(1);
+
+    auto result = [&]() -> ThrowCompletionOr<void> {
+        if (a_length == 0 || b_length == 1)
+            return {};
+
+        while (true) {
+            size_t a_wins = 0;
+            size_t b_wins = 0;
+
+            while ((a_wins | b_wins) < m_min_gallop) {
+                if (TRY(sorts_before(m_scratch[last_b()], m_items[last_a()]))) {
+                    take_from_a(1);
+                    ++a_wins;
+                    b_wins = 0;
+                    if (a_length == 0)
+                        return {};
+                } else {
+                    take_from_b(1);
+                    ++b_wins;
+                    a_wins = 0;
+                    if (b_length == 1)
+                        return {};
+                }
+            }
+
+            // One run keeps winning, so gallop through it for as long as that pays off.
+            ++m_min_gallop;
+            do {
+                m_min_gallop -= m_min_gallop > 1;
+
+                a_wins = a_length - TRY(gallop_right(m_scratch[last_b()], m_items.span().slice(a.start, a_length), a_length - 1));
+                take_from_a(a_wins);
+                if (a_length == 0)
+                    return {};
+
+                take_from_b(1);
+                if (b_length == 1)
+                    return {};
+
+                b_wins = b_length - TRY(gallop_left(m_items[last_a()], m_scratch.span().slice(0, b_length), b_length - 1));
+                take_from_b(b_wins);
+                if (b_length <= 1)
+                    return {};
+
+                take_from_a(1);
+                if (a_length == 0)
+                    return {};
+            } while (a_wins >= minimum_gallop || b_wins >= minimum_gallop);
+            ++m_min_gallop;
+        }
+    }();
+    TRY(result);
+
+    // NB: B's first element goes before whatever is left of A. If it's A that ran out, the rest of B goes at the start.
+    if (b_length == 1)
+        take_from_a(a_length);
+    take_from_b(b_length);
+    return {};
+}
+
+ThrowCompletionOr<void> array_merge_sort(VM&, Function<ThrowCompletionOr<double>(Value, Value)> const& compare_func, GC::RootVector<Value>& arr_to_sort)
+{
+    return ArrayTimSort { compare_func, arr_to_sort }.sort();
+}
+
 // 23.1.3.30 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -1558,6 +2054,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     // 3. Let len be ? LengthOfArrayLike(obj).
     auto length = TRY(length_of_array_like(vm, object));
 
+    // OPTIMIZATION: Without a comparator, int32 elements are ordered by their decimal strings. Producing those has no
+    //               side effects, and equal strings mean equal elements, so an unstable in-place sort is unobservable.
+    if (auto* array = as_if<Array>(*object); array && comparefn.is_undefined() && array->is_simple_packed_array()
+        && array->indexed_element_kind() == IndexedElementKind::Int32 && array->indexed_array_like_size() == length) {
+        auto elements = array->indexed_packed_elements_span_for_reordering();
+        quick_sort(elements, [](Value lhs, Value rhs) { return int32_sorts_before_by_string(lhs.as_i32(), rhs.as_i32()); });
+        return object;
+    }
+
     // 4. Let SortCompare be a new Abstract Closure with parameters (x, y) that captures comparefn and performs the following steps when called:
     Function<ThrowCompletionOr<double>(Value, Value)> sort_compare = [&](auto x, auto y) -> ThrowCompletionOr<double> {
         // a. Return ? CompareArrayElements(x, y, comparefn).
@@ -1565,7 +2070,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     };
 
     // 5. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, skip-holes).
-    auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles));
+    auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles, comparefn.is_undefined() ? DefaultSortCompare::ArrayElements : DefaultSortCompare::None));
 
     // 6. Let itemCount be the number of elements in sortedList.
     auto item_count = sorted_list.size();
@@ -1923,7 +2428,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::to_sorted)
     };
 
     // 6. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, read-through-holes).
-    auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::ReadThroughHoles));
+    auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::ReadThroughHoles, comparefn.is_undefined() ? DefaultSortCompare::ArrayElements : DefaultSortCompare::None));
 
     // 7. Let j be 0.
     // 8. Repeat, while j < len,
@@ -19,6 +19,10 @@ public:
     virtual void initialize(Realm&) override;
     virtual ~ArrayPrototype() override = default;
 
+    // Appends the items to this_value without any observable side effects if it's a packed array with the default
+    // prototype chain, and returns the new length. Returns an empty Optional, having done nothing, otherwise.
+    static Optional<Value> try_push_to_packed_array(Value this_value, ReadonlySpan<Value> items);
+
 private:
     explicit ArrayPrototype(Realm&);
 
@@ -7,7 +7,6 @@
 #include <AK/TypeCasts.h>
 #include <LibJS/Runtime/AsyncFunctionDriverWrapper.h>
 #include <LibJS/Runtime/GlobalObject.h>
-#include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/PromiseCapability.h>
 #include <LibJS/Runtime/PromiseConstructor.h>
 #include <LibJS/Runtime/VM.h>
@@ -82,18 +81,45 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
 
     // 3. Let fulfilledClosure be a new Abstract Closure with parameters (v) that captures asyncContext and performs the
     //    following steps when called:
+    // 4. Let onFulfilled be CreateBuiltinFunction(fulfilledClosure, 1, "", « »).
     // 5. Let rejectedClosure be a new Abstract Closure with parameters (reason) that captures asyncContext and performs the
     //    following steps when called:
-    // OPTIMIZATION: onRejected and onFulfilled are identical other than the resumption value passed to continue_async_execution.
-    //               To avoid allocated two GC functions down this path, we combine both callbacks into one function.
-    auto settled_closure = [this](VM& vm) -> ThrowCompletionOr<Value> {
-        auto reason = vm.argument(0);
+    // 6. Let onRejected be CreateBuiltinFunction(rejectedClosure, 1, "", « »).
+    // OPTIMIZATION: The closures are never observable, so instead of creating builtin functions we use reactions that
+    //               enqueue our resume job directly. See ensure_resume_job_and_reactions() for the closure steps.
+    ensure_resume_job_and_reactions(realm);
+
+    // 7. Perform PerformPromiseThen(promise, onFulfilled, onRejected).
+    m_current_promise = as<Promise>(promise_object);
+    m_current_promise->perform_then_for_await(*m_await_fulfill_reaction, *m_await_reject_reaction);
+
+    // NOTE: None of these are necessary. 8-12 are handled by step d of the above lambdas.
+    // 8. Remove asyncContext from the execution context stack and restore the execution context that is at the top of the
+    //    execution context stack as the running execution context.
+    // 9. Let callerContext be the running execution context.
+    // 10. Resume callerContext passing empty. If asyncContext is ever resumed again, let completion be the Completion Record with which it is resumed.
+    // 11. Assert: If control reaches here, then asyncContext is the running execution context again.
+    // 12. Return completion.
+    return {};
+}
 
-        // The currently awaited promise is settled when this reaction runs, so we can use
-        // its state to decide whether to resume with a normal or throw completion.
-        VERIFY(m_current_promise);
-        auto is_successful = m_current_promise->state() == Promise::State::Fulfilled;
-        VERIFY(is_successful || m_current_promise->state() == Promise::State::Rejected);
+void AsyncFunctionDriverWrapper::ensure_resume_job_and_reactions(Realm& realm)
+{
+    if (m_resume_job)
+        return;
+
+    auto& vm = realm.vm();
+    m_resume_job = GC::create_function(vm.heap(), [this, &vm]() -> ThrowCompletionOr<Value> {
+        // If we were resumed by a reaction, the currently awaited promise is settled and holds the resumption value.
+        // Otherwise, we were resumed by schedule_resume(), which stored the value for us.
+        auto value = m_resume_value;
+        auto is_successful = m_resume_is_fulfilled;
+        if (auto promise = exchange(m_current_promise, nullptr)) {
+            value = promise->result();
+            is_successful = promise->state() == Promise::State::Fulfilled;
+            VERIFY(is_successful || promise->state() == Promise::State::Rejected);
+        }
+        m_resume_value = js_undefined();
 
         // a. Let prevContext be the running execution context.
         auto& prev_context = vm.running_execution_context();
@@ -106,7 +132,7 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
         //      suspended it.
         // 5.d. Resume the suspended evaluation of asyncContext using ThrowCompletion(reason) as the result of the operation that
         //      suspended it.
-        continue_async_execution(vm, reason, is_successful);
+        continue_async_execution(vm, value, is_successful);
         vm.pop_execution_context();
 
         // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack and
@@ -115,38 +141,21 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
 
         // f. Return undefined.
         return js_undefined();
-    };
-
-    // 4. Let onFulfilled be CreateBuiltinFunction(fulfilledClosure, 1, "", « »).
-    // 6. Let onRejected be CreateBuiltinFunction(rejectedClosure, 1, "", « »).
-    if (!m_on_settled)
-        m_on_settled = NativeFunction::create(realm, move(settled_closure), 1);
+    });
 
-    // 7. Perform PerformPromiseThen(promise, onFulfilled, onRejected).
-    m_current_promise = as<Promise>(promise_object);
-    m_current_promise->perform_then(m_on_settled, m_on_settled, {});
-
-    // NOTE: None of these are necessary. 8-12 are handled by step d of the above lambdas.
-    // 8. Remove asyncContext from the execution context stack and restore the execution context that is at the top of the
-    //    execution context stack as the running execution context.
-    // 9. Let callerContext be the running execution context.
-    // 10. Resume callerContext passing empty. If asyncContext is ever resumed again, let completion be the Completion Record with which it is resumed.
-    // 11. Assert: If control reaches here, then asyncContext is the running execution context again.
-    // 12. Return completion.
-    return {};
+    m_await_fulfill_reaction = PromiseReaction::create_for_await(vm, PromiseReaction::Type::Fulfill, *m_resume_job, realm);
+    m_await_reject_reaction = PromiseReaction::create_for_await(vm, PromiseReaction::Type::Reject, *m_resume_job, realm);
 }
 
 void AsyncFunctionDriverWrapper::schedule_resume(Value value, bool is_fulfilled)
 {
     auto& vm = this->vm();
-    vm.host_enqueue_promise_job(
-        GC::create_function(vm.heap(), [this, value, is_fulfilled, &vm]() -> ThrowCompletionOr<Value> {
-            TRY(vm.push_execution_context(*m_suspended_execution_context, {}));
-            continue_async_execution(vm, value, is_fulfilled);
-            vm.pop_execution_context();
-            return js_undefined();
-        }),
-        vm.current_realm());
+    ensure_resume_job_and_reactions(*vm.current_realm());
+
+    m_current_promise = nullptr;
+    m_resume_value = value;
+    m_resume_is_fulfilled = is_fulfilled;
+    vm.host_enqueue_promise_job(*m_resume_job, vm.current_realm());
 }
 
 void AsyncFunctionDriverWrapper::continue_async_execution(VM& vm, Value value, bool is_successful)
@@ -226,7 +235,10 @@ void AsyncFunctionDriverWrapper::visit_edges(Cell::Visitor& visitor)
         visitor.visit(m_current_promise);
     if (m_suspended_execution_context)
         m_suspended_execution_context->visit_edges(visitor);
-    visitor.visit(m_on_settled);
+    visitor.visit(m_resume_job);
+    visitor.visit(m_await_fulfill_reaction);
+    visitor.visit(m_await_reject_reaction);
+    visitor.visit(m_resume_value);
 }
 
 }
@@ -10,6 +10,7 @@
 #include <LibJS/Runtime/GeneratorObject.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/Promise.h>
+#include <LibJS/Runtime/PromiseReaction.h>
 #include <LibJS/Runtime/VM.h>
 
 namespace JS {
@@ -30,13 +31,21 @@ public:
 private:
     AsyncFunctionDriverWrapper(Realm&, GC::Ref<GeneratorObject>, GC::Ref<Promise> top_level_promise);
     ThrowCompletionOr<void> await(Value);
+    void ensure_resume_job_and_reactions(Realm&);
 
     GC::Ref<GeneratorObject> m_generator_object;
     GC::Ref<Promise> m_top_level_promise;
     GC::Ptr<Promise> m_current_promise { nullptr };
     OwnPtr<ExecutionContext> m_suspended_execution_context;
 
-    GC::Ptr<NativeFunction> m_on_settled;
+    // OPTIMIZATION: Only one resumption can be pending at a time, so the job that resumes this function and the
+    //               reactions that enqueue it are allocated once and reused for every await.
+    GC::Ptr<PromiseReaction::ResumeJob> m_resume_job;
+    GC::Ptr<PromiseReaction> m_await_fulfill_reaction;
+    GC::Ptr<PromiseReaction> m_await_reject_reaction;
+    Value m_resume_value;
+    bool m_resume_is_fulfilled { true };
+
     bool m_is_initial_execution { true };
 };
 
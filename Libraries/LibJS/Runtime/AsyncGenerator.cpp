@@ -57,6 +57,9 @@ void AsyncGenerator::visit_edges(Cell::Visitor& visitor)
     }
     visitor.visit(m_generating_executable);
     visitor.visit(m_current_promise);
+    visitor.visit(m_resume_job);
+    visitor.visit(m_await_fulfill_reaction);
+    visitor.visit(m_await_reject_reaction);
     visitor.visit(m_pending_completion_value);
     m_async_generator_context->visit_edges(visitor);
 }
@@ -85,53 +88,63 @@ ThrowCompletionOr<void> AsyncGenerator::await(Value value)
     auto& realm = *vm.current_realm();
 
     // 1. Let asyncContext be the running execution context.
-    auto& async_context = vm.running_execution_context();
+    // NOTE: This is always our [[AsyncGeneratorContext]], which the resume job pushes back onto the stack.
+    VERIFY(&vm.running_execution_context() == m_async_generator_context.ptr());
 
     // 2. Let promise be ? PromiseResolve(%Promise%, value).
     auto* promise_object = TRY(promise_resolve(vm, realm.intrinsics().promise_constructor(), value));
 
     // 3. Let fulfilledClosure be a new Abstract Closure with parameters (v) that captures asyncContext and performs the
     //    following steps when called:
-    auto fulfilled_closure = [this, &async_context](VM& vm) -> ThrowCompletionOr<Value> {
-        auto value = vm.argument(0);
-
-        // a. Let prevContext be the running execution context.
-        auto& prev_context = vm.running_execution_context();
-
-        // b. Suspend prevContext.
-        // c. Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
-        TRY(vm.push_execution_context(async_context, {}));
+    // 4. Let onFulfilled be CreateBuiltinFunction(fulfilledClosure, 1, "", « »).
+    // 5. Let rejectedClosure be a new Abstract Closure with parameters (reason) that captures asyncContext and performs the
+    //    following steps when called:
+    // 6. Let onRejected be CreateBuiltinFunction(rejectedClosure, 1, "", « »).
+    // OPTIMIZATION: The closures are never observable, so instead of creating builtin functions we use reactions that
+    //               enqueue our resume job directly. See ensure_resume_job_and_reactions() for the closure steps.
+    ensure_resume_job_and_reactions(realm);
 
-        // d. Resume the suspended evaluation of asyncContext using NormalCompletion(v) as the result of the operation that
-        //    suspended it.
-        execute(vm, normal_completion(value));
+    // 7. Perform PerformPromiseThen(promise, onFulfilled, onRejected).
+    m_current_promise = as<Promise>(promise_object);
+    m_current_promise->perform_then_for_await(*m_await_fulfill_reaction, *m_await_reject_reaction);
 
-        // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack and
-        //    prevContext is the currently running execution context.
-        VERIFY(&vm.running_execution_context() == &prev_context);
+    // 8. Remove asyncContext from the execution context stack and restore the execution context that is at the top of the
+    //    execution context stack as the running execution context.
+    vm.pop_execution_context();
 
-        // f. Return undefined.
-        return js_undefined();
-    };
+    // NOTE: None of these are necessary. 10-12 are handled by step d of the above lambdas.
+    // 9. Let callerContext be the running execution context.
+    // 10. Resume callerContext passing empty. If asyncContext is ever resumed again, let completion be the Completion Record with which it is resumed.
+    // 11. Assert: If control reaches here, then asyncContext is the running execution context again.
+    // 12. Return completion.
+    return {};
+}
 
-    // 4. Let onFulfilled be CreateBuiltinFunction(fulfilledClosure, 1, "", « »).
-    auto on_fulfilled = NativeFunction::create(realm, move(fulfilled_closure), 1);
+void AsyncGenerator::ensure_resume_job_and_reactions(Realm& realm)
+{
+    if (m_resume_job)
+        return;
 
-    // 5. Let rejectedClosure be a new Abstract Closure with parameters (reason) that captures asyncContext and performs the
-    //    following steps when called:
-    auto rejected_closure = [this, &async_context](VM& vm) -> ThrowCompletionOr<Value> {
-        auto reason = vm.argument(0);
+    auto& vm = realm.vm();
+    m_resume_job = GC::create_function(vm.heap(), [this, &vm]() -> ThrowCompletionOr<Value> {
+        // The currently awaited promise is settled when this job runs, and holds the resumption value.
+        auto promise = exchange(m_current_promise, nullptr);
+        VERIFY(promise);
+        auto is_fulfilled = promise->state() == Promise::State::Fulfilled;
+        VERIFY(is_fulfilled || promise->state() == Promise::State::Rejected);
 
         // a. Let prevContext be the running execution context.
         auto& prev_context = vm.running_execution_context();
 
         // b. Suspend prevContext.
         // c. Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
-        TRY(vm.push_execution_context(async_context, {}));
+        TRY(vm.push_execution_context(*m_async_generator_context, {}));
 
-        // d. Resume the suspended evaluation of asyncContext using ThrowCompletion(reason) as the result of the operation that
-        //    suspended it.
-        execute(vm, throw_completion(reason));
+        // 3.d. Resume the suspended evaluation of asyncContext using NormalCompletion(v) as the result of the operation that
+        //      suspended it.
+        // 5.d. Resume the suspended evaluation of asyncContext using ThrowCompletion(reason) as the result of the operation that
+        //      suspended it.
+        execute(vm, is_fulfilled ? normal_completion(promise->result()) : throw_completion(promise->result()));
 
         // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack and
         //    prevContext is the currently running execution context.
@@ -139,25 +152,10 @@ ThrowCompletionOr<void> AsyncGenerator::await(Value value)
 
         // f. Return undefined.
         return js_undefined();
-    };
-
-    // 6. Let onRejected be CreateBuiltinFunction(rejectedClosure, 1, "", « »).
-    auto on_rejected = NativeFunction::create(realm, move(rejected_closure), 1);
-
-    // 7. Perform PerformPromiseThen(promise, onFulfilled, onRejected).
-    m_current_promise = as<Promise>(promise_object);
-    m_current_promise->perform_then(on_fulfilled, on_rejected, {});
-
-    // 8. Remove asyncContext from the execution context stack and restore the execution context that is at the top of the
-    //    execution context stack as the running execution context.
-    vm.pop_execution_context();
+    });
 
-    // NOTE: None of these are necessary. 10-12 are handled by step d of the above lambdas.
-    // 9. Let callerContext be the running execution context.
-    // 10. Resume callerContext passing empty. If asyncContext is ever resumed again, let completion be the Completion Record with which it is resumed.
-    // 11. Assert: If control reaches here, then asyncContext is the running execution context again.
-    // 12. Return completion.
-    return {};
+    m_await_fulfill_reaction = PromiseReaction::create_for_await(vm, PromiseReaction::Type::Fulfill, *m_resume_job, realm);
+    m_await_reject_reaction = PromiseReaction::create_for_await(vm, PromiseReaction::Type::Reject, *m_resume_job, realm);
 }
 
 void AsyncGenerator::execute(VM& vm, Completion completion)
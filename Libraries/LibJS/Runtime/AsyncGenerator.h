@@ -10,6 +10,7 @@
 #include <AK/Variant.h>
 #include <LibJS/Runtime/ExecutionContext.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/PromiseReaction.h>
 #include <LibJS/Runtime/VM.h>
 
 namespace JS {
@@ -64,6 +65,7 @@ private:
 
     void execute(VM&, Completion completion);
     ThrowCompletionOr<void> await(Value);
+    void ensure_resume_job_and_reactions(Realm&);
 
     // At the time of constructing an AsyncGenerator, we still need to point to an
     // execution context on the stack, but later need to 'adopt' it.
@@ -75,6 +77,12 @@ private:
     GC::Ref<Bytecode::Executable> m_generating_executable;
     u32 m_yield_continuation { ExecutionContext::no_yield_continuation };
     GC::Ptr<Promise> m_current_promise;
+
+    // OPTIMIZATION: Only one await can be pending at a time, so the job that resumes this generator and the reactions
+    //               that enqueue it are allocated once and reused for every await.
+    GC::Ptr<PromiseReaction::ResumeJob> m_resume_job;
+    GC::Ptr<PromiseReaction> m_await_fulfill_reaction;
+    GC::Ptr<PromiseReaction> m_await_reject_reaction;
     Value m_pending_completion_value { js_undefined() };
     Completion::Type m_pending_completion_type { Completion::Type::Normal };
 };
@@ -15,13 +15,20 @@
 #include <AK/Atomic.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Endian.h>
+#include <AK/OwnPtr.h>
 #include <AK/TypeCasts.h>
+#include <LibCore/EventLoop.h>
+#include <LibGC/Function.h>
+#include <LibGC/Root.h>
+#include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Agent.h>
 #include <LibJS/Runtime/AtomicsObject.h>
 #include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/PromiseCapability.h>
 #include <LibJS/Runtime/TypedArray.h>
 #include <LibJS/Runtime/Value.h>
 #include <LibJS/Runtime/ValueInlines.h>
+#include <LibSync/WaiterList.h>
 
 namespace JS {
 
@@ -122,6 +129,81 @@ enum class WaitMode {
     Async,
 };
 
+// The parts of an asynchronous Waiter Record that stay with the waiting agent. It is only ever touched on the agent's
+// thread, and lives until the waiter is notified or times out.
+struct AsyncWaiter {
+    GC::Root<Realm> realm;
+    GC::Root<PromiseCapability> promise_capability;
+
+    // The agent's event loop, if it has one, so that agents on other threads can hand the notification over to it.
+    Core::EventLoop* event_loop { nullptr };
+    RefPtr<Core::WeakEventLoopReference> weak_event_loop;
+};
+
+static Core::EventLoop* current_event_loop()
+{
+    return Core::EventLoop::is_running() ? &Core::EventLoop::current() : nullptr;
+}
+
+// 25.4.3.13 EnqueueResolveInAgentJob ( agentSignifier, promiseCapability, resolution ), https://tc39.es/ecma262/#sec-enqueueresolveinagentjob
+static void enqueue_resolve_in_agent_job(NonnullOwnPtr<AsyncWaiter> waiter, Utf16String resolution)
+{
+    auto& realm = *waiter->realm;
+    auto& vm = realm.vm();
+    GC::Ref promise_capability = *waiter->promise_capability;
+
+    // 1. Let resolveJob be a new Job Abstract Closure with no parameters that captures agentSignifier, promiseCapability,
+    //    and resolution and performs the following steps when called:
+    auto resolve_job = GC::create_function(vm.heap(), [&vm, promise_capability, resolution = move(resolution)] {
+        // a. Assert: AgentSignifier() is agentSignifier.
+        // b. Perform ! Call(promiseCapability.[[Resolve]], undefined, « resolution »).
+        MUST(call(vm, *promise_capability->resolve(), js_undefined(), PrimitiveString::create(vm, resolution)));
+
+        // c. Return unused.
+    });
+
+    // 2. Let realmInTargetAgent be ! GetFunctionRealm(promiseCapability.[[Resolve]]).
+    // 3. Assert: agentSignifier is realmInTargetAgent.[[AgentSignifier]].
+    // 4. Perform HostEnqueueGenericJob(resolveJob, realmInTargetAgent).
+    vm.host_enqueue_generic_job(resolve_job, realm);
+
+    // 5. Return unused.
+}
+
+// 25.4.3.12 NotifyWaiter ( WL, waiterRecord ), https://tc39.es/ecma262/#sec-notifywaiter
+// NB: These are the steps for asynchronous waiters, which can be called on any thread. Sync::WaiterList wakes blocked
+//     agents itself.
+static void notify_async_waiter(NonnullOwnPtr<AsyncWaiter> waiter, Utf16String result)
+{
+    // 2. Else if AgentSignifier() is waiterRecord.[[AgentSignifier]], then
+    // NB: An agent without an event loop can't be notified from another thread, so it is always the current agent.
+    if (waiter->event_loop == current_event_loop()) {
+        // a. Let promiseCapability be waiterRecord.[[PromiseCapability]].
+        // b. Perform ! Call(promiseCapability.[[Resolve]], undefined, « waiterRecord.[[Result]] »).
+        auto& vm = waiter->realm->vm();
+        MUST(call(vm, *waiter->promise_capability->resolve(), js_undefined(), PrimitiveString::create(vm, move(result))));
+        return;
+    }
+
+    // 3. Else,
+    //    a. Perform EnqueueResolveInAgentJob(waiterRecord.[[AgentSignifier]], waiterRecord.[[PromiseCapability]], waiterRecord.[[Result]]).
+    // NB: The waiter's GC roots must only be touched by its own agent, so the job is enqueued from the agent's thread.
+    //     If the agent can't be reached, or has gone away along with its heap, the waiter is leaked rather than
+    //     unrooted from here.
+    if (!waiter->weak_event_loop) {
+        (void)waiter.leak_ptr();
+        return;
+    }
+    auto event_loop = waiter->weak_event_loop->take();
+    if (!event_loop) {
+        (void)waiter.leak_ptr();
+        return;
+    }
+    event_loop->deferred_invoke([waiter = move(waiter), result = move(result)]() mutable {
+        enqueue_resolve_in_agent_job(move(waiter), move(result));
+    });
+}
+
 // 25.4.3.14 DoWait ( mode, typedArray, index, value, timeout ), https://tc39.es/ecma262/#sec-dowait
 static ThrowCompletionOr<Value> do_wait(VM& vm, WaitMode mode, TypedArrayBase& typed_array, Value index, Value expected_value, Value timeout_value)
 {
@@ -165,12 +247,135 @@ static ThrowCompletionOr<Value> do_wait(VM& vm, WaitMode mode, TypedArrayBase& t
     if (mode == WaitMode::Sync && !agent_can_suspend(vm))
         return vm.throw_completion<TypeError>(ErrorType::AgentCannotSuspend);
 
-    // FIXME: Implement the remaining steps when we support SharedArrayBuffer.
-    (void)byte_index_in_buffer;
-    (void)value;
-    (void)timeout;
+    // 11. Let block be buffer.[[ArrayBufferData]].
+    // 12. Let offset be typedArray.[[ByteOffset]].
+    // 13. Let byteIndexInBuffer be (i × 4) + offset.
+    // 14. Let WL be GetWaiterList(block, byteIndexInBuffer).
+    // NOTE: Waiter lists are keyed by the address of the element, which is shared by every agent (and WebAssembly memory)
+    //       viewing the same Shared Data Block.
+    auto const* address = buffer->data_at(byte_index_in_buffer);
+
+    auto value_matches = [&] {
+        // 19. Let elementType be TypedArrayElementType(typedArray).
+        // 20. Let w be GetValueFromBuffer(buffer, byteIndexInBuffer, elementType, true, seq-cst).
+        // 21. If v ≠ w, then
+        if (array_type_name == vm.names.BigInt64Array.as_string())
+            return AK::atomic_load(reinterpret_cast<i64 const volatile*>(address)) == value;
+        return AK::atomic_load(reinterpret_cast<i32 const volatile*>(address)) == static_cast<i32>(value);
+    };
+
+    // 15. If mode is sync, then
+    //     a. Let promiseCapability be blocking.
+    //     b. Let resultObject be undefined.
+    // 16. Else,
+    if (mode == WaitMode::Async) {
+        auto& realm = *vm.current_realm();
+        auto is_finite_timeout = timeout != js_infinity().as_double();
+
+        if (timeout != 0 && is_finite_timeout && !vm.host_enqueue_timeout_job)
+            return vm.throw_completion<InternalError>(ErrorType::NotImplemented, "Atomics.waitAsync with a timeout in this host"sv);
+
+        // a. Let promiseCapability be ! NewPromiseCapability(%Promise%).
+        auto promise_capability = MUST(new_promise_capability(vm, realm.intrinsics().promise_constructor()));
+
+        // b. Let resultObject be OrdinaryObjectCreate(%Object.prototype%).
+        auto result_object = Object::create(realm, realm.intrinsics().object_prototype());
+
+        auto make_result = [&](bool is_async, Value value) -> Value {
+            MUST(result_object->create_data_property_or_throw(vm.names.async, Value(is_async)));
+            MUST(result_object->create_data_property_or_throw(vm.names.value, value));
+            return result_object;
+        };
+
+        // 21. If v ≠ w, then
+        //     c. If mode is async, then
+        //         i. Perform ! CreateDataPropertyOrThrow(resultObject, "async", false).
+        //         ii. Perform ! CreateDataPropertyOrThrow(resultObject, "value", "not-equal").
+        //         iii. Return resultObject.
+        // 22. If t is 0 and mode is async, then
+        //     a. NOTE: There is no special handling of synchronous immediate timeouts. Asynchronous immediate timeouts
+        //        have special handling in order to fail fast and avoid unnecessary Promise jobs.
+        //     b. Perform LeaveCriticalSection(WL).
+        //     c. Perform ! CreateDataPropertyOrThrow(resultObject, "async", false).
+        //     d. Perform ! CreateDataPropertyOrThrow(resultObject, "value", "timed-out").
+        //     e. Return resultObject.
+        if (timeout == 0)
+            return make_result(false, PrimitiveString::create(vm, value_matches() ? "timed-out"_utf16 : "not-equal"_utf16));
+
+        auto waiter = make<AsyncWaiter>();
+        waiter->realm = GC::make_root(realm);
+        waiter->promise_capability = GC::make_root(promise_capability);
+        waiter->event_loop = current_event_loop();
+        if (waiter->event_loop)
+            waiter->weak_event_loop = Core::EventLoop::current_weak();
+
+        // 24. Perform AddWaiter(WL, waiterRecord).
+        auto waiter_id = Sync::WaiterList::wait_async(address, value_matches, [waiter = waiter.ptr()] {
+            notify_async_waiter(adopt_own(*waiter), "ok"_utf16);
+        });
+        if (!waiter_id.has_value())
+            return make_result(false, PrimitiveString::create(vm, "not-equal"_utf16));
+
+        // NB: From here on, the waiter is freed by whichever of the notification and the timeout comes first.
+        auto* async_waiter = waiter.leak_ptr();
+
+        // 26. Else,
+        //     a. If timeoutTime is finite, then
+        //         i. Perform EnqueueAtomicsWaitAsyncTimeoutJob(WL, waiterRecord).
+        if (is_finite_timeout) {
+            // 25.4.3.15 EnqueueAtomicsWaitAsyncTimeoutJob ( WL, waiterRecord ), https://tc39.es/ecma262/#sec-enqueueatomicswaitasynctimeoutjob
+            // 1. Let timeoutJob be a new Job Abstract Closure with no parameters that captures WL and waiterRecord and
+            //    performs the following steps when called:
+            auto timeout_job = GC::create_function(vm.heap(), [address, waiter_id = *waiter_id, async_waiter] {
+                // a. Perform EnterCriticalSection(WL).
+                // b. If WL.[[Waiters]] contains waiterRecord, then
+                //     iii. Set waiterRecord.[[Result]] to "timed-out".
+                //     iv. Perform RemoveWaiter(WL, waiterRecord).
+                //     v. Perform NotifyWaiter(WL, waiterRecord).
+                // c. Perform LeaveCriticalSection(WL).
+                // NB: If the waiter has been notified instead, it may already have been freed.
+                if (Sync::WaiterList::remove_async_waiter(address, waiter_id))
+                    notify_async_waiter(adopt_own(*async_waiter), "timed-out"_utf16);
+
+                // d. Return unused.
+            });
+
+            // 2. Let now be the time value (UTC) identifying the current time.
+            // 3. Let currentRealm be the current Realm Record.
+            // 4. Perform HostEnqueueTimeoutJob(timeoutJob, currentRealm, 𝔽(waiterRecord.[[TimeoutTime]]) - now).
+            vm.host_enqueue_timeout_job(timeout_job, realm, timeout);
+        }
+
+        // 29. Perform ! CreateDataPropertyOrThrow(resultObject, "async", true).
+        // 30. Perform ! CreateDataPropertyOrThrow(resultObject, "value", promiseCapability.[[Promise]]).
+        // 31. Return resultObject.
+        return make_result(true, promise_capability->promise());
+    }
 
-    return vm.throw_completion<InternalError>(ErrorType::NotImplemented, "SharedArrayBuffer"sv);
+    // 17. Let waiterRecord be a new Waiter Record { [[AgentSignifier]]: AgentSignifier(), [[PromiseCapability]]: promiseCapability, [[TimeoutTime]]: empty, [[Result]]: "ok" }.
+    // 18. Perform EnterCriticalSection(WL).
+    // 22. If t is 0 and mode is async, then ...
+    // 23. If t = +∞, let timeoutTime be +∞; otherwise let timeoutTime be now + t.
+    // 24. Perform AddWaiter(WL, waiterRecord).
+    // 25. If mode is sync, then
+    //     a. Perform SuspendThisAgent(WL, waiterRecord).
+    // 27. Perform LeaveCriticalSection(WL).
+    Optional<AK::Duration> timeout_duration;
+    if (timeout != js_infinity().as_double())
+        timeout_duration = AK::Duration::from_nanoseconds(static_cast<i64>(min(timeout * 1'000'000.0, static_cast<double>(NumericLimits<i64>::max()))));
+
+    switch (Sync::WaiterList::wait(address, value_matches, timeout_duration)) {
+    case Sync::WaiterList::WaitResult::NotEqual:
+        // a. Perform LeaveCriticalSection(WL).
+        // b. If mode is sync, return "not-equal".
+        return PrimitiveString::create(vm, "not-equal"_utf16);
+    case Sync::WaiterList::WaitResult::TimedOut:
+        // 28. If mode is sync, return waiterRecord.[[Result]].
+        return PrimitiveString::create(vm, "timed-out"_utf16);
+    case Sync::WaiterList::WaitResult::Woken:
+        return PrimitiveString::create(vm, "ok"_utf16);
+    }
+    VERIFY_NOT_REACHED();
 }
 
 // 25.4.3.17 AtomicReadModifyWrite ( typedArray, index, value, op ), https://tc39.es/ecma262/#sec-atomicreadmodifywrite
@@ -457,11 +662,20 @@ JS_DEFINE_NATIVE_FUNCTION(AtomicsObject::notify)
     if (!buffer->is_shared_array_buffer())
         return Value { 0 };
 
-    // FIXME: Implement the remaining steps when we support SharedArrayBuffer.
-    (void)byte_index_in_buffer;
-    (void)count;
+    // 7. Let block be buffer.[[ArrayBufferData]].
+    // 8. Let WL be GetWaiterList(block, byteIndexInBuffer).
+    auto const* address = buffer->data_at(byte_index_in_buffer);
+
+    // 9. Perform EnterCriticalSection(WL).
+    // 10. Let S be RemoveWaiters(WL, c).
+    // 11. For each element W of S, do
+    //     a. Perform NotifyWaiter(WL, W).
+    // 12. Perform LeaveCriticalSection(WL).
+    auto woken = Sync::WaiterList::notify(address, static_cast<u32>(min(count, static_cast<double>(NumericLimits<u32>::max()))));
 
-    return vm.throw_completion<InternalError>(ErrorType::NotImplemented, "SharedArrayBuffer"sv);
+    // 13. Let n be the number of elements in S.
+    // 14. Return 𝔽(n).
+    return Value { woken };
 }
 
 // 25.4.11 Atomics.or ( typedArray, index, value ), https://tc39.es/ecma262/#sec-atomics.or
@@ -90,10 +90,15 @@ JS_DEFINE_NATIVE_FUNCTION(BigIntPrototype::to_locale_string)
     auto bigint = TRY(this_bigint_value(vm, vm.this_value()));
 
     // 2. Let numberFormat be ? Construct(%NumberFormat%, « locales, options »).
-    auto* number_format = static_cast<Intl::NumberFormat*>(TRY(construct(vm, realm.intrinsics().intl_number_format_constructor(), locales, options)).ptr());
+    // OPTIMIZATION: Reuse a previously constructed NumberFormat if constructing a new one would not be observable.
+    auto number_format = realm.intrinsics().cached_locale_formatter(Intrinsics::LocaleFormatterType::NumberFormat, locales, options);
+    if (!number_format) {
+        number_format = TRY(construct(vm, realm.intrinsics().intl_number_format_constructor(), locales, options));
+        realm.intrinsics().cache_locale_formatter(Intrinsics::LocaleFormatterType::NumberFormat, locales, options, *number_format);
+    }
 
     // 3. Return ? FormatNumeric(numberFormat, x).
-    auto formatted = Intl::format_numeric(*number_format, Value(bigint));
+    auto formatted = Intl::format_numeric(as<Intl::NumberFormat>(*number_format), Value(bigint));
     return PrimitiveString::create(vm, move(formatted));
 }
 
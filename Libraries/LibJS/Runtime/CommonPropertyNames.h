@@ -45,6 +45,7 @@ namespace JS {
     P(assert)                                \
     P(assign)                                \
     P(asUintN)                               \
+    P(async)                                 \
     P(at)                                    \
     P(atan)                                  \
     P(atan2)                                 \
@@ -1004,10 +1004,15 @@ JS_DEFINE_NATIVE_FUNCTION(DatePrototype::to_locale_date_string)
         return PrimitiveString::create(vm, "Invalid Date"_utf16_fly_string);
 
     // 3. Let dateFormat be ? CreateDateTimeFormat(%DateTimeFormat%, locales, options, "date", "date").
-    auto date_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Date, Intl::OptionDefaults::Date));
+    // OPTIMIZATION: Reuse a previously created DateTimeFormat if creating a new one would not be observable.
+    auto date_format = realm.intrinsics().cached_locale_formatter(Intrinsics::LocaleFormatterType::DateTimeFormatDate, locales, options);
+    if (!date_format) {
+        date_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Date, Intl::OptionDefaults::Date));
+        realm.intrinsics().cache_locale_formatter(Intrinsics::LocaleFormatterType::DateTimeFormatDate, locales, options, *date_format);
+    }
 
     // 4. Return ? FormatDateTime(dateFormat, x).
-    auto formatted = TRY(Intl::format_date_time(vm, date_format, time));
+    auto formatted = TRY(Intl::format_date_time(vm, as<Intl::DateTimeFormat>(*date_format), time));
     return PrimitiveString::create(vm, move(formatted));
 }
 
@@ -1028,10 +1033,15 @@ JS_DEFINE_NATIVE_FUNCTION(DatePrototype::to_locale_string)
         return PrimitiveString::create(vm, "Invalid Date"_utf16_fly_string);
 
     // 3. Let dateFormat be ? CreateDateTimeFormat(%DateTimeFormat%, locales, options, "any", "all").
-    auto date_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Any, Intl::OptionDefaults::All));
+    // OPTIMIZATION: Reuse a previously created DateTimeFormat if creating a new one would not be observable.
+    auto date_format = realm.intrinsics().cached_locale_formatter(Intrinsics::LocaleFormatterType::DateTimeFormatAny, locales, options);
+    if (!date_format) {
+        date_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Any, Intl::OptionDefaults::All));
+        realm.intrinsics().cache_locale_formatter(Intrinsics::LocaleFormatterType::DateTimeFormatAny, locales, options, *date_format);
+    }
 
     // 4. Return ? FormatDateTime(dateFormat, x).
-    auto formatted = TRY(Intl::format_date_time(vm, date_format, time));
+    auto formatted = TRY(Intl::format_date_time(vm, as<Intl::DateTimeFormat>(*date_format), time));
     return PrimitiveString::create(vm, move(formatted));
 }
 
@@ -1052,10 +1062,15 @@ JS_DEFINE_NATIVE_FUNCTION(DatePrototype::to_locale_time_string)
         return PrimitiveString::create(vm, "Invalid Date"_utf16_fly_string);
 
     // 3. Let timeFormat be ? CreateDateTimeFormat(%DateTimeFormat%, locales, options, "time", "time").
-    auto time_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Time, Intl::OptionDefaults::Time));
+    // OPTIMIZATION: Reuse a previously created DateTimeFormat if creating a new one would not be observable.
+    auto time_format = realm.intrinsics().cached_locale_formatter(Intrinsics::LocaleFormatterType::DateTimeFormatTime, locales, options);
+    if (!time_format) {
+        time_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Time, Intl::OptionDefaults::Time));
+        realm.intrinsics().cache_locale_formatter(Intrinsics::LocaleFormatterType::DateTimeFormatTime, locales, options, *time_format);
+    }
 
     // 4. Return ? FormatDateTime(timeFormat, x).
-    auto formatted = TRY(Intl::format_date_time(vm, time_format, time));
+    auto formatted = TRY(Intl::format_date_time(vm, as<Intl::DateTimeFormat>(*time_format), time));
     return PrimitiveString::create(vm, move(formatted));
 }
 
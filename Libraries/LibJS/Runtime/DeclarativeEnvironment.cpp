@@ -260,8 +260,11 @@ ThrowCompletionOr<bool> DeclarativeEnvironment::has_binding(Utf16FlyString const
     auto binding_and_index = find_binding_and_index(name);
     if (!binding_and_index.has_value())
         return false;
-    if (!is_permanently_screwed_by_eval() && out_index && binding_and_index->index().has_value())
-        *out_index = *(binding_and_index->index());
+    if (!out_index || !binding_and_index->index().has_value())
+        return true;
+    auto index = *binding_and_index->index();
+    if (!is_permanently_screwed_by_eval() || is_fixed_shape_binding(index))
+        *out_index = index;
     return true;
 }
 
@@ -79,6 +79,13 @@ public:
     ThrowCompletionOr<Value> get_binding_value_direct(VM&, size_t index) const;
     Value get_initialized_binding_value_direct(size_t index) const { return m_binding_values[index]; }
 
+    // A binding from this environment's shape that can't be deleted keeps its index for the lifetime of the environment,
+    // even when a direct eval adds further bindings to it.
+    [[nodiscard]] bool is_fixed_shape_binding(size_t index) const
+    {
+        return index < shape_binding_count() && index < binding_count() && !binding_can_be_deleted(index);
+    }
+
     void shrink_to_fit();
     void set_environment_shape_cache(GC::Ptr<EnvironmentShape>&, size_t expected_binding_count);
 
@@ -32,6 +32,7 @@
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/DataViewConstructor.h>
 #include <LibJS/Runtime/DataViewPrototype.h>
+#include <LibJS/Runtime/Date.h>
 #include <LibJS/Runtime/DateConstructor.h>
 #include <LibJS/Runtime/DatePrototype.h>
 #include <LibJS/Runtime/DisposableStackConstructor.h>
@@ -134,6 +135,7 @@
 #include <LibJS/Runtime/WeakSetPrototype.h>
 #include <LibJS/Runtime/WrapForValidIteratorPrototype.h>
 #include <LibJS/RustIntegration.h>
+#include <LibUnicode/Locale.h>
 
 // FIXME: Remove this asm hack when we upgrade to GCC 15.
 #define INCLUDE_FILE_WITH_ASSEMBLY(name, file_path) \
@@ -383,9 +385,6 @@ void Intrinsics::initialize_intrinsics(Realm& realm)
     m_async_generator_prototype->define_direct_property(vm.names.constructor, m_async_generator_function_prototype, Attribute::Configurable);
 
     m_array_prototype_values_function = &array_prototype()->get_without_side_effects(vm.names.values).as_function();
-    m_date_constructor_now_function = &date_constructor()->get_without_side_effects(vm.names.now).as_function();
-    m_json_parse_function = &json_object()->get_without_side_effects(vm.names.parse).as_function();
-    m_json_stringify_function = &json_object()->get_without_side_effects(vm.names.stringify).as_function();
     m_object_prototype_to_string_function = &object_prototype()->get_without_side_effects(vm.names.toString).as_function();
 
     array_prototype()->convert_to_prototype_if_needed();
@@ -448,6 +447,10 @@ JS_ENUMERATE_TYPED_ARRAYS
             initialize_constructor(vm, vm.names.Symbol, *m_##snake_namespace##snake_name##_constructor, m_##snake_namespace##snake_name##_prototype);    \
         else                                                                                                                                             \
             initialize_constructor(vm, vm.names.ClassName, *m_##snake_namespace##snake_name##_constructor, m_##snake_namespace##snake_name##_prototype); \
+                                                                                                                                                         \
+        /* NB: The functions we keep around must be captured before user code gets a chance to replace them. */                                         \
+        if constexpr (IsSame<Namespace::ConstructorName, DateConstructor>)                                                                               \
+            m_date_constructor_now_function = &m_##snake_namespace##snake_name##_constructor->get_without_side_effects(vm.names.now).as_function();     \
     }                                                                                                                                                    \
                                                                                                                                                          \
     GC::Ref<Namespace::ConstructorName> Intrinsics::snake_namespace##snake_name##_constructor()                                                          \
@@ -481,16 +484,47 @@ JS_ENUMERATE_TEMPORAL_OBJECTS
 
 #undef __JS_ENUMERATE_INNER
 
-#define __JS_ENUMERATE(ClassName, snake_name)                              \
-    GC::Ref<ClassName> Intrinsics::snake_name##_object()                   \
-    {                                                                      \
-        if (!m_##snake_name##_object)                                      \
-            m_##snake_name##_object = m_realm->create<ClassName>(m_realm); \
-        return *m_##snake_name##_object;                                   \
+#define __JS_ENUMERATE(ClassName, snake_name)                                                                                     \
+    GC::Ref<ClassName> Intrinsics::snake_name##_object()                                                                          \
+    {                                                                                                                             \
+        if (!m_##snake_name##_object) {                                                                                           \
+            m_##snake_name##_object = m_realm->create<ClassName>(m_realm);                                                        \
+                                                                                                                                  \
+            /* NB: The functions we keep around must be captured before user code gets a chance to replace them. */               \
+            if constexpr (IsSame<ClassName, JSONObject>) {                                                                        \
+                auto& vm = this->vm();                                                                                            \
+                m_json_parse_function = &m_##snake_name##_object->get_without_side_effects(vm.names.parse).as_function();         \
+                m_json_stringify_function = &m_##snake_name##_object->get_without_side_effects(vm.names.stringify).as_function(); \
+            }                                                                                                                     \
+        }                                                                                                                         \
+        return *m_##snake_name##_object;                                                                                          \
     }
 JS_ENUMERATE_BUILTIN_NAMESPACE_OBJECTS
 #undef __JS_ENUMERATE
 
+// OPTIMIZATION: These are only looked up when the corresponding constructor or namespace object is first created, so that
+//               realms which never use Date or JSON don't have to create them up front.
+GC::Ref<FunctionObject> Intrinsics::date_constructor_now_function()
+{
+    if (!m_date_constructor_now_function)
+        (void)date_constructor();
+    return *m_date_constructor_now_function;
+}
+
+GC::Ref<FunctionObject> Intrinsics::json_parse_function()
+{
+    if (!m_json_parse_function)
+        (void)json_object();
+    return *m_json_parse_function;
+}
+
+GC::Ref<FunctionObject> Intrinsics::json_stringify_function()
+{
+    if (!m_json_stringify_function)
+        (void)json_object();
+    return *m_json_stringify_function;
+}
+
 void Intrinsics::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -561,6 +595,8 @@ void Intrinsics::visit_edges(Visitor& visitor)
 #undef __JS_ENUMERATE
 
     visitor.visit(m_default_collator);
+    for (auto const& entry : m_locale_formatter_cache)
+        visitor.visit(entry.formatter);
 
 #define __JS_ENUMERATE(snake_name, functionName, length) \
     visitor.visit(m_##snake_name##_abstract_operation_function);
@@ -581,6 +617,62 @@ GC::Ref<Intl::Collator> Intrinsics::default_collator()
     return *m_default_collator;
 }
 
+struct LocaleFormatterCacheKey {
+    Utf16String locale;
+    Utf16String time_zone;
+};
+
+static Optional<LocaleFormatterCacheKey> locale_formatter_cache_key(Intrinsics::LocaleFormatterType type, Value locales, Value options)
+{
+    if (!options.is_undefined())
+        return {};
+
+    LocaleFormatterCacheKey key;
+
+    if (locales.is_undefined())
+        key.locale = Utf16String::from_utf16(Unicode::default_locale());
+    else if (locales.is_string())
+        key.locale = locales.as_string().utf16_string();
+    else
+        return {};
+
+    // Date-time formats without a timeZone option are resolved against the system time zone, which may change while
+    // the formatter is cached.
+    if (first_is_one_of(type, Intrinsics::LocaleFormatterType::DateTimeFormatAny, Intrinsics::LocaleFormatterType::DateTimeFormatDate, Intrinsics::LocaleFormatterType::DateTimeFormatTime))
+        key.time_zone = system_time_zone_identifier();
+
+    return key;
+}
+
+GC::Ptr<Object> Intrinsics::cached_locale_formatter(LocaleFormatterType type, Value locales, Value options)
+{
+    auto key = locale_formatter_cache_key(type, locales, options);
+    if (!key.has_value())
+        return {};
+
+    auto index = m_locale_formatter_cache.find_first_index_if([&](auto const& entry) {
+        return entry.type == type && entry.locale == key->locale && entry.time_zone == key->time_zone;
+    });
+    if (!index.has_value())
+        return {};
+
+    auto entry = m_locale_formatter_cache.take(*index);
+    auto formatter = entry.formatter;
+    m_locale_formatter_cache.prepend(move(entry));
+    return formatter;
+}
+
+void Intrinsics::cache_locale_formatter(LocaleFormatterType type, Value locales, Value options, GC::Ref<Object> formatter)
+{
+    auto key = locale_formatter_cache_key(type, locales, options);
+    if (!key.has_value())
+        return;
+
+    if (m_locale_formatter_cache.size() == locale_formatter_cache_capacity)
+        m_locale_formatter_cache.take_last();
+    m_locale_formatter_cache.prepend(CachedLocaleFormatter { type, move(key->locale), move(key->time_zone), formatter });
+}
+
 #define __JS_ENUMERATE(snake_name, functionName, length)                                                                                                                                                        \
     GC::Ref<NativeJavaScriptBackedFunction> Intrinsics::snake_name##_abstract_operation_function()                                                                                                              \
     {                                                                                                                                                                                                           \
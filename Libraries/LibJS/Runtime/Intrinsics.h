@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <AK/Utf16String.h>
+#include <AK/Vector.h>
 #include <LibGC/CellAllocator.h>
 #include <LibJS/Export.h>
 #include <LibJS/Forward.h>
@@ -104,9 +106,9 @@ public:
 
     // Namespace/constructor object functions
     GC::Ref<FunctionObject> array_prototype_values_function() const { return *m_array_prototype_values_function; }
-    GC::Ref<FunctionObject> date_constructor_now_function() const { return *m_date_constructor_now_function; }
-    GC::Ref<FunctionObject> json_parse_function() const { return *m_json_parse_function; }
-    GC::Ref<FunctionObject> json_stringify_function() const { return *m_json_stringify_function; }
+    GC::Ref<FunctionObject> date_constructor_now_function();
+    GC::Ref<FunctionObject> json_parse_function();
+    GC::Ref<FunctionObject> json_stringify_function();
     GC::Ref<FunctionObject> object_prototype_to_string_function() const { return *m_object_prototype_to_string_function; }
     GC::Ref<FunctionObject> throw_type_error_function() const { return *m_throw_type_error_function; }
 
@@ -143,6 +145,20 @@ public:
 
     [[nodiscard]] GC::Ref<Intl::Collator> default_collator();
 
+    enum class LocaleFormatterType : u8 {
+        Collator,
+        NumberFormat,
+        DateTimeFormatAny,
+        DateTimeFormatDate,
+        DateTimeFormatTime,
+    };
+
+    // The formatters that toLocaleString() and friends construct are never exposed to JS. When they're created from a
+    // locale string without options, constructing them is unobservable, so we can keep a few around instead of creating
+    // new ICU objects on every call.
+    [[nodiscard]] GC::Ptr<Object> cached_locale_formatter(LocaleFormatterType, Value locales, Value options);
+    void cache_locale_formatter(LocaleFormatterType, Value locales, Value options, GC::Ref<Object> formatter);
+
 #define __JS_ENUMERATE(snake_name, functionName, length) \
     GC::Ref<NativeJavaScriptBackedFunction> snake_name##_abstract_operation_function();
     JS_ENUMERATE_NATIVE_JAVASCRIPT_BACKED_ABSTRACT_OPERATIONS
@@ -290,6 +306,15 @@ private:
 #undef __JS_ENUMERATE
 
     GC::Ptr<Intl::Collator> m_default_collator;
+
+    struct CachedLocaleFormatter {
+        LocaleFormatterType type;
+        Utf16String locale;
+        Utf16String time_zone;
+        GC::Ref<Object> formatter;
+    };
+    static constexpr size_t locale_formatter_cache_capacity = 16;
+    Vector<CachedLocaleFormatter, locale_formatter_cache_capacity> m_locale_formatter_cache; // Most recently used first.
 };
 
 void add_restricted_function_properties(FunctionObject&, Realm&);
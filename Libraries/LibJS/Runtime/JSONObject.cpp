@@ -8,6 +8,7 @@
 #include <AK/Function.h>
 #include <AK/GenericLexer.h>
 #include <AK/StringConversions.h>
+#include <AK/TemporaryChange.h>
 #include <AK/TypeCasts.h>
 #include <AK/UnicodeUtils.h>
 #include <AK/Utf16StringBuilder.h>
@@ -23,6 +24,7 @@
 #include <LibJS/Runtime/NumberObject.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/RawJSONObject.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/StringObject.h>
 #include <LibJS/Runtime/ValueInlines.h>
 
@@ -685,7 +687,21 @@ static ErrorOr<JSONTextBytes> json_text_bytes(Utf16View text)
     return text_bytes;
 }
 
-static ThrowCompletionOr<Value> parse_simdjson_value(VM&, JSONTextBytes const&, simdjson::ondemand::value, JSONParseRecord* record = nullptr);
+// The shape of the last object parsed at a nesting depth, and the raw keys that produced it. Arrays of objects that
+// share their keys and key order, as most API responses do, can then give each object its final shape up front and
+// store values straight into property storage, instead of creating a key and looking up a transition per property.
+struct JSONObjectShapeTemplate {
+    GC::Weak<Shape> shape;
+    // NB: These point into the padded input, which outlives the templates since both are scoped to a single parse.
+    Vector<StringView> raw_keys;
+};
+
+struct JSONObjectShapeTemplates {
+    Vector<JSONObjectShapeTemplate> by_depth;
+    size_t depth { 0 };
+};
+
+static ThrowCompletionOr<Value> parse_simdjson_value(VM&, JSONTextBytes const&, JSONObjectShapeTemplates&, simdjson::ondemand::value, JSONParseRecord* record = nullptr);
 
 // The source text matched by a primitive parse node, used by JSON.parse revivers.
 static Utf16String json_token_source(JSONTextBytes const& json_text, std::string_view raw)
@@ -773,9 +789,10 @@ static ThrowCompletionOr<Value> parse_simdjson_string(VM& vm, T& value)
 }
 
 template<typename T>
-static ThrowCompletionOr<Value> parse_simdjson_array(VM& vm, JSONTextBytes const& json_text, T& value, JSONParseRecord* record = nullptr)
+static ThrowCompletionOr<Value> parse_simdjson_array(VM& vm, JSONTextBytes const& json_text, JSONObjectShapeTemplates& shape_templates, T& value, JSONParseRecord* record = nullptr)
 {
     auto& realm = *vm.current_realm();
+    TemporaryChange depth_change { shape_templates.depth, shape_templates.depth + 1 };
 
     simdjson::ondemand::array simdjson_array;
     if (value.get_array().get(simdjson_array))
@@ -789,7 +806,7 @@ static ThrowCompletionOr<Value> parse_simdjson_array(VM& vm, JSONTextBytes const
         if (element.get(element_value))
             return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
         JSONParseRecord element_record;
-        auto parsed = TRY(parse_simdjson_value(vm, json_text, element_value, record ? &element_record : nullptr));
+        auto parsed = TRY(parse_simdjson_value(vm, json_text, shape_templates, element_value, record ? &element_record : nullptr));
         array->define_direct_property(index++, parsed, default_attributes);
         if (record)
             record->elements.append(move(element_record));
@@ -801,8 +818,22 @@ static ThrowCompletionOr<Value> parse_simdjson_array(VM& vm, JSONTextBytes const
     return array;
 }
 
+// Gives the first property_count properties of an object created from a shape template to a new object built the
+// ordinary way, once the object being parsed turns out not to follow the template.
+static GC::Ref<Object> copy_shape_template_prefix(Realm& realm, Object const& template_object, size_t property_count)
+{
+    auto object = Object::create(realm, realm.intrinsics().object_prototype());
+    template_object.shape().for_each_property_in_insertion_order([&](auto const& property_key, auto const& metadata) {
+        if (metadata.offset >= property_count)
+            return IterationDecision::Break;
+        object->define_direct_property(property_key, template_object.get_direct(metadata.offset), default_attributes);
+        return IterationDecision::Continue;
+    });
+    return object;
+}
+
 template<typename T>
-static ThrowCompletionOr<Value> parse_simdjson_object(VM& vm, JSONTextBytes const& json_text, T& value, JSONParseRecord* record = nullptr)
+static ThrowCompletionOr<Value> parse_simdjson_object(VM& vm, JSONTextBytes const& json_text, JSONObjectShapeTemplates& shape_templates, T& value, JSONParseRecord* record = nullptr)
 {
     auto& realm = *vm.current_realm();
 
@@ -810,22 +841,61 @@ static ThrowCompletionOr<Value> parse_simdjson_object(VM& vm, JSONTextBytes cons
     if (value.get_object().get(simdjson_object))
         return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
 
-    auto object = Object::create(realm, realm.intrinsics().object_prototype());
+    auto depth = shape_templates.depth;
+    TemporaryChange depth_change { shape_templates.depth, depth + 1 };
+    if (depth >= shape_templates.by_depth.size())
+        shape_templates.by_depth.resize(depth + 1);
+
+    // NB: Parse records need every key as a string, so reviver parses always take the ordinary path.
+    GC::Ptr<Shape> template_shape;
+    if (!record)
+        template_shape = shape_templates.by_depth[depth].shape.ptr();
+    auto object = template_shape ? Object::create_with_premade_shape(*template_shape) : Object::create(realm, realm.intrinsics().object_prototype());
+
+    // While following the template, the first template_property_count properties are stored directly by offset.
+    bool following_template = template_shape != nullptr;
+    size_t template_property_count = 0;
+    Vector<StringView> raw_keys;
+
+    auto stop_following_template = [&] {
+        auto const& template_raw_keys = shape_templates.by_depth[depth].raw_keys;
+        for (size_t i = 0; i < template_property_count; ++i)
+            raw_keys.append(template_raw_keys[i]);
+        object = copy_shape_template_prefix(realm, *object, template_property_count);
+        following_template = false;
+    };
 
     for (auto field : simdjson_object) {
         // Use escaped_key() to get the raw JSON key (with escapes), then unescape ourselves
         std::string_view raw_key;
         if (field.escaped_key().get(raw_key))
             return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
-        auto unescaped_key = unescape_json_string({ raw_key.data(), raw_key.size() });
+        StringView raw_key_view { raw_key.data(), raw_key.size() };
+        simdjson::ondemand::value field_value;
+
+        if (following_template) {
+            // NB: The templates vector may grow while parsing nested values, so look the template up afresh.
+            auto const& template_raw_keys = shape_templates.by_depth[depth].raw_keys;
+            if (template_property_count < template_raw_keys.size() && template_raw_keys[template_property_count] == raw_key_view) {
+                if (field.value().get(field_value))
+                    return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+                auto parsed = TRY(parse_simdjson_value(vm, json_text, shape_templates, field_value));
+                object->put_direct(template_property_count++, parsed);
+                continue;
+            }
+            stop_following_template();
+        }
+
+        auto unescaped_key = unescape_json_string(raw_key_view);
         if (!unescaped_key.has_value())
             return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
-        simdjson::ondemand::value field_value;
         if (field.value().get(field_value))
             return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+        if (!record)
+            raw_keys.append(raw_key_view);
         auto key = unescaped_key.release_value();
         JSONParseRecord entry_record;
-        auto parsed = TRY(parse_simdjson_value(vm, json_text, field_value, record ? &entry_record : nullptr));
+        auto parsed = TRY(parse_simdjson_value(vm, json_text, shape_templates, field_value, record ? &entry_record : nullptr));
         object->define_direct_property(key, parsed, default_attributes);
         if (record) {
             entry_record.key = key;
@@ -838,12 +908,25 @@ static ThrowCompletionOr<Value> parse_simdjson_object(VM& vm, JSONTextBytes cons
     }
 
     TRY(ensure_simdjson_fully_parsed(vm, value));
+
+    // An object with fewer keys than the template does not have the template's shape either.
+    if (following_template && template_property_count != shape_templates.by_depth[depth].raw_keys.size())
+        stop_following_template();
+
+    // Only remember shapes that map each raw key to the property at the same offset. Duplicate keys, array index keys
+    // (which live in indexed storage) and dictionary shapes all break that.
+    if (!following_template && !record) {
+        auto& shape = object->shape();
+        if (!shape.is_dictionary() && shape.property_count() == raw_keys.size() && object->indexed_array_like_size() == 0)
+            shape_templates.by_depth[depth] = JSONObjectShapeTemplate { shape, move(raw_keys) };
+    }
+
     if (record)
         record->value = object;
     return object;
 }
 
-static ThrowCompletionOr<Value> parse_simdjson_value(VM& vm, JSONTextBytes const& json_text, simdjson::ondemand::value value, JSONParseRecord* record)
+static ThrowCompletionOr<Value> parse_simdjson_value(VM& vm, JSONTextBytes const& json_text, JSONObjectShapeTemplates& shape_templates, simdjson::ondemand::value value, JSONParseRecord* record)
 {
     simdjson::ondemand::json_type type;
     if (value.type().get(type))
@@ -888,9 +971,9 @@ static ThrowCompletionOr<Value> parse_simdjson_value(VM& vm, JSONTextBytes const
         return parsed;
     }
     case simdjson::ondemand::json_type::array:
-        return parse_simdjson_array(vm, json_text, value, record);
+        return parse_simdjson_array(vm, json_text, shape_templates, value, record);
     case simdjson::ondemand::json_type::object:
-        return parse_simdjson_object(vm, json_text, value, record);
+        return parse_simdjson_object(vm, json_text, shape_templates, value, record);
     case simdjson::ondemand::json_type::unknown:
         return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
     }
@@ -898,7 +981,7 @@ static ThrowCompletionOr<Value> parse_simdjson_value(VM& vm, JSONTextBytes const
     VERIFY_NOT_REACHED();
 }
 
-static ThrowCompletionOr<Value> parse_simdjson_document(VM& vm, JSONTextBytes const& json_text, simdjson::ondemand::document& document, JSONParseRecord* record = nullptr)
+static ThrowCompletionOr<Value> parse_simdjson_document(VM& vm, JSONTextBytes const& json_text, JSONObjectShapeTemplates& shape_templates, simdjson::ondemand::document& document, JSONParseRecord* record = nullptr)
 {
     simdjson::ondemand::json_type type;
     if (document.type().get(type))
@@ -959,9 +1042,9 @@ static ThrowCompletionOr<Value> parse_simdjson_document(VM& vm, JSONTextBytes co
         return parsed;
     }
     case simdjson::ondemand::json_type::array:
-        return parse_simdjson_array(vm, json_text, document, record);
+        return parse_simdjson_array(vm, json_text, shape_templates, document, record);
     case simdjson::ondemand::json_type::object:
-        return parse_simdjson_object(vm, json_text, document, record);
+        return parse_simdjson_object(vm, json_text, shape_templates, document, record);
     case simdjson::ondemand::json_type::unknown:
         return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
     }
@@ -993,7 +1076,8 @@ ThrowCompletionOr<Value> JSONObject::parse_json(VM& vm, Utf16View text, JSONPars
     // 4. NOTE: The early error rules defined in 13.2.5.1 have special handling for the above invocation of ParseText.
     // 5. Assert: script is a Parse Node.
     // 6. Let result be ! Evaluation of script.
-    auto result = TRY(parse_simdjson_document(vm, json_text, document, root_record));
+    JSONObjectShapeTemplates shape_templates;
+    auto result = TRY(parse_simdjson_document(vm, json_text, shape_templates, document, root_record));
 
     // 7. NOTE: The PropertyDefinitionEvaluation semantics defined in 13.2.5.5 have special handling for the above evaluation.
     // 8. Assert: result is either a String, a Number, a Boolean, an Object that is defined by either an ArrayLiteral or an ObjectLiteral, or null.
@@ -25,29 +25,36 @@ Map::Map(Object& prototype)
 void Map::map_clear()
 {
     auto old_external_memory_size = external_memory_size();
-    m_keys.clear();
     m_entries.clear();
+    m_index_table.clear();
+    m_size = 0;
+    ++m_entries_generation;
     account_external_memory_change(old_external_memory_size);
 }
 
 // 24.1.3.3 Map.prototype.delete ( key ), https://tc39.es/ecma262/#sec-map.prototype.delete
 bool Map::map_remove(Value const& key)
 {
-    Optional<size_t> index;
+    auto position = find_position(key);
+    if (!position.has_value())
+        return false;
 
-    for (auto it = m_keys.begin(); !it.is_end(); ++it) {
-        if (ValueTraits::equals(*it, key)) {
-            index = it.key();
-            break;
-        }
+    if (m_size == 1) {
+        map_clear();
+        return true;
     }
 
-    if (!index.has_value())
-        return false;
-
     auto old_external_memory_size = external_memory_size();
-    m_keys.remove(*index);
-    m_entries.remove(key);
+
+    // Keep the insertion ID, so the entries stay sorted by it for iterators looking up their position.
+    auto& entry = m_entries[*position];
+    entry.key = js_special_empty_value();
+    entry.value = js_undefined();
+    --m_size;
+
+    if (m_index_table.size() > minimum_index_table_size && m_size * 8 < m_index_table.size())
+        rebuild_index_table(m_size);
+
     account_external_memory_change(old_external_memory_size);
     return true;
 }
@@ -55,50 +62,107 @@ bool Map::map_remove(Value const& key)
 // 24.1.3.6 Map.prototype.get ( key ), https://tc39.es/ecma262/#sec-map.prototype.get
 Optional<Value> Map::map_get(Value const& key) const
 {
-    if (auto it = m_entries.find(key); it != m_entries.end())
-        return it->value;
+    if (auto position = find_position(key); position.has_value())
+        return m_entries[*position].value;
     return {};
 }
 
 // 24.1.3.7 Map.prototype.has ( key ), https://tc39.es/ecma262/#sec-map.prototype.has
 bool Map::map_has(Value const& key) const
 {
-    return m_entries.contains(key);
+    return find_position(key).has_value();
 }
 
 // 24.1.3.9 Map.prototype.set ( key, value ), https://tc39.es/ecma262/#sec-map.prototype.set
 void Map::map_set(Value const& key, Value value)
 {
-    auto it = m_entries.find(key);
-    if (it != m_entries.end()) {
-        it->value = value;
-    } else {
-        auto old_external_memory_size = external_memory_size();
-        auto index = m_next_insertion_id++;
-        m_keys.insert(index, key);
-        m_entries.set(key, value);
-        account_external_memory_change(old_external_memory_size);
+    if (auto position = find_position(key); position.has_value()) {
+        m_entries[*position].value = value;
+        return;
     }
+
+    auto old_external_memory_size = external_memory_size();
+
+    // Keep the table at most half full, counting tombstones, so probe sequences stay short and always terminate.
+    if ((m_entries.size() + 1) * 2 > m_index_table.size())
+        rebuild_index_table(m_size + 1);
+
+    auto position = m_entries.size();
+    m_entries.append({ key, value, m_next_insertion_id++ });
+    insert_into_index_table(key, position);
+    ++m_size;
+
+    account_external_memory_change(old_external_memory_size);
 }
 
 size_t Map::map_size() const
 {
-    return m_keys.size();
+    return m_size;
+}
+
+Optional<size_t> Map::find_position(Value const& key) const
+{
+    if (m_index_table.is_empty())
+        return {};
+
+    auto mask = m_index_table.size() - 1;
+    for (size_t slot = ValueTraits::hash(key) & mask;; slot = (slot + 1) & mask) {
+        auto index = m_index_table[slot];
+        if (index == empty_index_slot)
+            return {};
+        auto const& entry = m_entries[index - 1];
+        if (!entry.is_removed() && ValueTraits::equals(entry.key, key))
+            return index - 1;
+    }
 }
 
-static size_t map_key_tree_external_memory_size(RedBlackTree<size_t, Value> const& keys)
+void Map::insert_into_index_table(Value const& key, size_t position)
 {
-    constexpr auto approximate_node_size = sizeof(AK::BaseRedBlackTree<size_t>::Node) + sizeof(Value);
-    if (keys.size() > NumericLimits<size_t>::max() / approximate_node_size)
-        return NumericLimits<size_t>::max();
-    return keys.size() * approximate_node_size;
+    auto mask = m_index_table.size() - 1;
+    auto slot = ValueTraits::hash(key) & mask;
+    while (m_index_table[slot] != empty_index_slot)
+        slot = (slot + 1) & mask;
+    m_index_table[slot] = static_cast<u32>(position + 1);
+}
+
+size_t Map::position_of_first_entry_not_below(size_t insertion_id) const
+{
+    size_t low = 0;
+    size_t high = m_entries.size();
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        if (m_entries[middle].insertion_id < insertion_id)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+void Map::rebuild_index_table(size_t minimum_live_entry_capacity)
+{
+    if (m_size != m_entries.size()) {
+        m_entries.remove_all_matching([](auto const& entry) { return entry.is_removed(); });
+        ++m_entries_generation;
+    }
+
+    // Leave room for as many insertions again before the next rebuild.
+    auto table_size = minimum_index_table_size;
+    while (table_size < minimum_live_entry_capacity * 4)
+        table_size *= 2;
+    VERIFY(table_size <= NumericLimits<u32>::max());
+
+    m_index_table.clear_with_capacity();
+    m_index_table.resize(table_size);
+    for (size_t position = 0; position < m_entries.size(); ++position)
+        insert_into_index_table(m_entries[position].key, position);
 }
 
 size_t Map::external_memory_size() const
 {
     auto size = Object::external_memory_size();
-    size = saturating_add_external_memory_size(size, map_key_tree_external_memory_size(m_keys));
-    size = saturating_add_external_memory_size(size, hash_map_external_memory_size(m_entries));
+    size = saturating_add_external_memory_size(size, vector_external_memory_size(m_entries));
+    size = saturating_add_external_memory_size(size, vector_external_memory_size(m_index_table));
     return size;
 }
 
@@ -114,12 +178,12 @@ void Map::account_external_memory_change(size_t old_external_memory_size)
 void Map::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
-    for (auto& value : m_entries) {
-        visitor.visit(value.key);
-        visitor.visit(value.value);
+    for (auto& entry : m_entries) {
+        if (entry.is_removed())
+            continue;
+        visitor.visit(entry.key);
+        visitor.visit(entry.value);
     }
-    // NOTE: The entries in m_keys are already visited by the walk over m_entries above.
-    visitor.ignore(m_keys);
 }
 
 }
@@ -6,8 +6,7 @@
 
 #pragma once
 
-#include <AK/HashMap.h>
-#include <AK/RedBlackTree.h>
+#include <AK/Vector.h>
 #include <LibJS/Export.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Object.h>
@@ -44,24 +43,28 @@ public:
         Value value;
     };
 
+    // Iterators remember the insertion ID of the next entry to visit rather than a position, so entries added during
+    // iteration are visited, removed ones are skipped, and compacting the entry storage doesn't disturb them.
     template<bool IsConst>
     struct IteratorImpl {
         bool is_end() const
         {
-            return m_map->m_keys.begin_from(m_index).is_end()
-                && m_map->m_keys.find_smallest_not_below_iterator(m_index).is_end();
+            ensure_next_element();
+            return m_position >= m_map->m_entries.size();
         }
 
         IteratorImpl& operator++()
         {
+            ensure_next_element();
             ++m_index;
+            ++m_position;
             return *this;
         }
 
         Entry operator*() const
         {
             ensure_next_element();
-            auto const& entry = *m_map->m_entries.find(*m_map->m_keys.begin_from(m_index));
+            auto const& entry = m_map->m_entries[m_position];
             return { entry.key, entry.value };
         }
 
@@ -78,35 +81,33 @@ public:
         IteratorImpl(Map const& map)
         requires(IsConst)
             : m_map(map)
+            , m_entries_generation(map.m_entries_generation)
         {
-            ensure_index();
         }
 
         IteratorImpl(Map& map)
         requires(!IsConst)
             : m_map(map)
+            , m_entries_generation(map.m_entries_generation)
         {
-            ensure_index();
-        }
-
-        void ensure_index() const
-        {
-            if (m_map->m_keys.is_empty())
-                m_index = m_map->m_next_insertion_id;
-            else
-                m_index = m_map->m_keys.begin().key();
         }
 
         void ensure_next_element() const
         {
-            if (auto it = m_map->m_keys.find_smallest_not_below_iterator(m_index); it.is_end())
-                m_index = m_map->m_next_insertion_id;
-            else
-                m_index = it.key();
+            auto const& entries = m_map->m_entries;
+            if (m_entries_generation != m_map->m_entries_generation) {
+                m_position = m_map->position_of_first_entry_not_below(m_index);
+                m_entries_generation = m_map->m_entries_generation;
+            }
+            while (m_position < entries.size() && entries[m_position].is_removed())
+                ++m_position;
+            m_index = m_position < entries.size() ? entries[m_position].insertion_id : m_map->m_next_insertion_id;
         }
 
         Conditional<IsConst, GC::Ref<Map const>, GC::Ref<Map>> m_map;
         mutable size_t m_index { 0 };
+        mutable size_t m_position { 0 };
+        mutable u64 m_entries_generation { 0 };
     };
 
     using Iterator = IteratorImpl<false>;
@@ -122,9 +123,35 @@ private:
 
     void account_external_memory_change(size_t old_external_memory_size);
 
+    // Entries are stored densely in insertion order. Removing one leaves a tombstone behind, which is only compacted
+    // away when the index table is rebuilt.
+    struct StoredEntry {
+        Value key;
+        Value value;
+        size_t insertion_id { 0 };
+
+        bool is_removed() const { return key.is_special_empty_value(); }
+    };
+
+    static constexpr u32 empty_index_slot = 0;
+    static constexpr size_t minimum_index_table_size = 8;
+
+    Optional<size_t> find_position(Value const&) const;
+    void insert_into_index_table(Value const&, size_t position);
+    size_t position_of_first_entry_not_below(size_t insertion_id) const;
+    void rebuild_index_table(size_t minimum_live_entry_capacity);
+
     size_t m_next_insertion_id { 0 };
-    RedBlackTree<size_t, Value> m_keys;
-    HashMap<Value, Value, ValueTraits> m_entries;
+    size_t m_size { 0 };
+
+    // Bumped whenever entry positions change, so iterators know to look their position up again.
+    u64 m_entries_generation { 0 };
+
+    Vector<StoredEntry> m_entries;
+
+    // Open-addressed, linearly probed table of positions in m_entries (offset by one, so that 0 means empty). Slots
+    // pointing at tombstones are kept, so probe sequences stay intact until the table is rebuilt.
+    Vector<u32> m_index_table;
 };
 
 template<>
@@ -38,8 +38,8 @@ void MathObject::initialize(Realm& realm)
     define_native_function(realm, vm.names.floor, floor, 1, attr, Bytecode::Builtin::MathFloor);
     define_native_function(realm, vm.names.ceil, ceil, 1, attr, Bytecode::Builtin::MathCeil);
     define_native_function(realm, vm.names.round, round, 1, attr, Bytecode::Builtin::MathRound);
-    define_native_function(realm, vm.names.max, max, 2, attr);
-    define_native_function(realm, vm.names.min, min, 2, attr);
+    define_native_function(realm, vm.names.max, max, 2, attr, Bytecode::Builtin::MathMax);
+    define_native_function(realm, vm.names.min, min, 2, attr, Bytecode::Builtin::MathMin);
     define_native_function(realm, vm.names.trunc, trunc, 1, attr);
     define_native_function(realm, vm.names.sin, sin, 1, attr, Bytecode::Builtin::MathSin);
     define_native_function(realm, vm.names.cos, cos, 1, attr, Bytecode::Builtin::MathCos);
@@ -755,6 +755,23 @@ JS_DEFINE_NATIVE_FUNCTION(MathObject::max)
     return highest;
 }
 
+// Math.max with exactly two arguments, for the interpreter's builtin call fast path.
+ThrowCompletionOr<Value> MathObject::max_impl(VM& vm, Value first, Value second)
+{
+    // OPTIMIZATION: Fast path for Int32 values.
+    if (first.is_int32() && second.is_int32())
+        return Value(AK::max(first.as_i32(), second.as_i32()));
+
+    auto first_number = TRY(first.to_number(vm));
+    auto second_number = TRY(second.to_number(vm));
+
+    if (first_number.is_nan() || second_number.is_nan())
+        return js_nan();
+    if (first_number.is_negative_zero() && second_number.is_positive_zero())
+        return second_number;
+    return second_number.as_double() > first_number.as_double() ? second_number : first_number;
+}
+
 // 21.3.2.26 Math.min ( ...args ), https://tc39.es/ecma262/#sec-math.min
 JS_DEFINE_NATIVE_FUNCTION(MathObject::min)
 {
@@ -789,6 +806,23 @@ JS_DEFINE_NATIVE_FUNCTION(MathObject::min)
     return lowest;
 }
 
+// Math.min with exactly two arguments, for the interpreter's builtin call fast path.
+ThrowCompletionOr<Value> MathObject::min_impl(VM& vm, Value first, Value second)
+{
+    // OPTIMIZATION: Fast path for Int32 values.
+    if (first.is_int32() && second.is_int32())
+        return Value(AK::min(first.as_i32(), second.as_i32()));
+
+    auto first_number = TRY(first.to_number(vm));
+    auto second_number = TRY(second.to_number(vm));
+
+    if (first_number.is_nan() || second_number.is_nan())
+        return js_nan();
+    if (first_number.is_positive_zero() && second_number.is_negative_zero())
+        return second_number;
+    return second_number.as_double() < first_number.as_double() ? second_number : first_number;
+}
+
 // 21.3.2.27 Math.pow ( base, exponent ), https://tc39.es/ecma262/#sec-math.pow
 ThrowCompletionOr<Value> MathObject::pow_impl(VM& vm, Value base, Value exponent)
 {
@@ -31,6 +31,8 @@ public:
     static ThrowCompletionOr<Value> sin_impl(VM&, Value);
     static ThrowCompletionOr<Value> cos_impl(VM&, Value);
     static ThrowCompletionOr<Value> tan_impl(VM&, Value);
+    static ThrowCompletionOr<Value> max_impl(VM&, Value, Value);
+    static ThrowCompletionOr<Value> min_impl(VM&, Value, Value);
 
     static Value random_impl();
 
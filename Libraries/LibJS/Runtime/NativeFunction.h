@@ -80,11 +80,18 @@ public:
 
     NativeFunctionPointer native_function() const { return m_native_function; }
 
+    // A version of this function for use as a getter that takes the this object directly, and that can be called
+    // without an execution context of its own once an inline cache has found the getter. It returns the special empty
+    // value if it can't handle the this object, in which case the getter must be called as usual.
+    NativeFastGetterPointer fast_getter() const { return m_fast_getter; }
+    void set_fast_getter(NativeFastGetterPointer fast_getter) { m_fast_getter = fast_getter; }
+
 private:
     RawNativeFunction(NativeFunctionPointer, Object* prototype, Realm& realm, Optional<Bytecode::Builtin> builtin);
     RawNativeFunction(Utf16FlyString name, NativeFunctionPointer, Object& prototype);
 
     NativeFunctionPointer m_native_function { nullptr };
+    NativeFastGetterPointer m_fast_getter { nullptr };
 };
 
 template<>
@@ -42,7 +42,7 @@ void NumberConstructor::initialize(Realm& realm)
 
     u8 attr = Attribute::Writable | Attribute::Configurable;
     define_native_function(realm, vm.names.isFinite, is_finite, 1, attr);
-    define_native_function(realm, vm.names.isInteger, is_integer, 1, attr);
+    define_native_function(realm, vm.names.isInteger, is_integer, 1, attr, Bytecode::Builtin::NumberIsInteger);
     define_native_function(realm, vm.names.isNaN, is_nan, 1, attr);
     define_native_function(realm, vm.names.isSafeInteger, is_safe_integer, 1, attr);
     define_direct_property(vm.names.parseInt, realm.intrinsics().parse_int_function(), attr);
@@ -1409,6 +1409,7 @@ Optional<u32> Object::storage_set(PropertyKey const& property_key, ValueAndAttri
         u32 new_offset = shape().property_count() - 1;
         ensure_named_storage_capacity(shape().property_count());
         m_named_properties[new_offset] = value;
+        GC::write_barrier(this, value);
         return new_offset;
     }
 
@@ -1420,6 +1421,7 @@ Optional<u32> Object::storage_set(PropertyKey const& property_key, ValueAndAttri
     }
 
     m_named_properties[metadata->offset] = value;
+    GC::write_barrier(this, value);
     return metadata->offset;
 }
 
@@ -1692,6 +1694,9 @@ void Object::visit_edges(Cell::Visitor& visitor)
     case IndexedStorageKind::None:
         break;
     case IndexedStorageKind::Packed:
+        // Numbers are not cells, so number-only arrays have nothing to visit.
+        if (m_indexed_element_kind != IndexedElementKind::Any)
+            break;
         for (u32 i = 0; i < m_indexed_array_like_size; ++i)
             visitor.visit(m_indexed_elements[i]);
         break;
@@ -1828,6 +1833,7 @@ void Object::free_indexed_elements()
     }
     m_indexed_elements = nullptr;
     m_indexed_storage_kind = IndexedStorageKind::None;
+    m_indexed_element_kind = IndexedElementKind::Int32;
     m_indexed_array_like_size = 0;
 }
 
@@ -1935,9 +1941,12 @@ void Object::indexed_put(u32 index, Value value, PropertyAttributes attributes)
 
     if (m_indexed_storage_kind == IndexedStorageKind::None) {
         m_indexed_storage_kind = storing_hole || index > 0 ? IndexedStorageKind::Holey : IndexedStorageKind::Packed;
+        m_indexed_element_kind = IndexedElementKind::Int32;
+        widen_indexed_element_kind(value);
         u32 needed = index + 1;
         ensure_indexed_elements(needed);
         m_indexed_elements[index] = value;
+        GC::write_barrier(this, value);
         m_indexed_array_like_size = max(m_indexed_array_like_size, index + 1);
         return;
     }
@@ -1962,20 +1971,30 @@ void Object::indexed_put(u32 index, Value value, PropertyAttributes attributes)
     if (m_indexed_storage_kind == IndexedStorageKind::Packed && storing_hole)
         m_indexed_storage_kind = IndexedStorageKind::Holey;
 
+    if (m_indexed_storage_kind == IndexedStorageKind::Packed)
+        widen_indexed_element_kind(value);
+
     m_indexed_elements[index] = value;
+    GC::write_barrier(this, value);
 
     // Promote Holey -> Packed when filling the last hole.
     // Only check when writing to the last index to avoid O(N^2) scanning.
     if (m_indexed_storage_kind == IndexedStorageKind::Holey && index == m_indexed_array_like_size - 1) {
         bool has_holes = false;
+        auto element_kind = IndexedElementKind::Int32;
         for (u32 i = 0, available_elements = min(m_indexed_array_like_size, indexed_elements_capacity()); i < available_elements; ++i) {
-            if (m_indexed_elements[i].is_special_empty_value()) {
+            auto element = m_indexed_elements[i];
+            if (element.is_special_empty_value()) {
                 has_holes = true;
                 break;
             }
+            if (element_kind != IndexedElementKind::Any && !element.is_int32())
+                element_kind = element.is_number() ? IndexedElementKind::Number : IndexedElementKind::Any;
         }
-        if (!has_holes && indexed_elements_capacity() >= m_indexed_array_like_size)
+        if (!has_holes && indexed_elements_capacity() >= m_indexed_array_like_size) {
             m_indexed_storage_kind = IndexedStorageKind::Packed;
+            m_indexed_element_kind = element_kind;
+        }
     }
 }
 
@@ -2168,6 +2187,11 @@ Vector<u32> Object::indexed_indices() const
 }
 
 void Object::set_indexed_property_elements(Vector<Value>&& values)
+{
+    set_indexed_property_elements(values.span());
+}
+
+void Object::set_indexed_property_elements(ReadonlySpan<Value> values)
 {
     free_indexed_elements();
 
@@ -2178,8 +2202,26 @@ void Object::set_indexed_property_elements(Vector<Value>&& values)
     m_indexed_storage_kind = IndexedStorageKind::Packed;
     m_indexed_array_like_size = size;
     m_indexed_elements = allocate_indexed_elements(size);
-    for (u32 i = 0; i < size; ++i)
+    for (u32 i = 0; i < size; ++i) {
         m_indexed_elements[i] = values[i];
+        widen_indexed_element_kind(values[i]);
+        GC::write_barrier(this, values[i]);
+    }
+}
+
+void Object::indexed_fill(u32 start, u32 end, Value value)
+{
+    VERIFY(m_indexed_storage_kind == IndexedStorageKind::Packed);
+    VERIFY(start <= end && end <= m_indexed_array_like_size);
+    VERIFY(!value.is_special_empty_value());
+
+    if (start == end)
+        return;
+
+    widen_indexed_element_kind(value);
+    for (u32 i = start; i < end; ++i)
+        m_indexed_elements[i] = value;
+    GC::write_barrier(this, value);
 }
 
 ReadonlySpan<Value> Object::indexed_packed_elements_span() const
@@ -2188,6 +2230,12 @@ ReadonlySpan<Value> Object::indexed_packed_elements_span() const
     return { m_indexed_elements, m_indexed_array_like_size };
 }
 
+Span<Value> Object::indexed_packed_elements_span_for_reordering()
+{
+    VERIFY(m_indexed_storage_kind == IndexedStorageKind::Packed);
+    return { m_indexed_elements, m_indexed_array_like_size };
+}
+
 void Object::convert_to_prototype_if_needed()
 {
     if (shape().is_prototype_shape())
@@ -77,6 +77,14 @@ enum class IndexedStorageKind : u8 {
     Dictionary = 3,
 };
 
+// What every element of Packed indexed storage is known to hold. The kind only widens while the storage stays
+// packed, which lets bulk array operations skip per-element type checks and the GC skip number-only elements.
+enum class IndexedElementKind : u8 {
+    Int32 = 0,
+    Number = 1,
+    Any = 2,
+};
+
 class JS_API Object : public Cell {
     GC_CELL(Object, Cell);
     GC_DECLARE_ALLOCATOR(Object);
@@ -296,7 +304,11 @@ public:
     virtual size_t external_memory_size() const override;
 
     Value get_direct(size_t index) const { return m_named_properties[index]; }
-    void put_direct(size_t index, Value value) { m_named_properties[index] = value; }
+    void put_direct(size_t index, Value value)
+    {
+        m_named_properties[index] = value;
+        GC::write_barrier(this, value);
+    }
 
     // Indexed property storage
     Optional<ValueAndAttributes> indexed_get(u32 index) const;
@@ -311,8 +323,15 @@ public:
     size_t indexed_real_size() const;
     Vector<u32> indexed_indices() const;
     void set_indexed_property_elements(Vector<Value>&& values);
+    void set_indexed_property_elements(ReadonlySpan<Value> values);
     IndexedStorageKind indexed_storage_kind() const { return m_indexed_storage_kind; }
 
+    // Only meaningful while indexed_storage_kind() is Packed.
+    IndexedElementKind indexed_element_kind() const { return m_indexed_element_kind; }
+
+    // Overwrites the existing packed elements in [start, end).
+    void indexed_fill(u32 start, u32 end, Value);
+
     template<typename Callback>
     void indexed_for_each_value(Callback callback)
     {
@@ -339,6 +358,9 @@ public:
     // For FunctionPrototype.apply fast path
     ReadonlySpan<Value> indexed_packed_elements_span() const;
 
+    // Packed elements may be reordered through this span, but not replaced, so that indexed_element_kind() stays true.
+    Span<Value> indexed_packed_elements_span_for_reordering();
+
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
     void unsafe_set_shape(Shape&);
@@ -386,7 +408,8 @@ private:
 
     u8 m_flags { Flag::IsExtensible };
     IndexedStorageKind m_indexed_storage_kind { IndexedStorageKind::None };
-    // 2 bytes padding
+    IndexedElementKind m_indexed_element_kind { IndexedElementKind::Int32 };
+    // 1 byte padding
     u32 m_indexed_array_like_size { 0 };
     void set_shape(Shape& shape) { m_shape = &shape; }
 
@@ -398,6 +421,12 @@ private:
     void ensure_indexed_elements(u32 needed_capacity);
     void grow_indexed_elements(u32 needed_capacity);
     void transition_to_dictionary();
+    void widen_indexed_element_kind(Value value)
+    {
+        if (m_indexed_element_kind == IndexedElementKind::Any || value.is_int32())
+            return;
+        m_indexed_element_kind = value.is_number() ? IndexedElementKind::Number : IndexedElementKind::Any;
+    }
     void free_indexed_elements();
     void ensure_named_storage_capacity(u32 needed);
     bool named_storage_is_inline() const { return m_named_properties == const_cast<Object*>(this)->m_inline_named_storage; }
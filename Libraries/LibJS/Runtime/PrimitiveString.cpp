@@ -5,8 +5,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/CharacterTypes.h>
+#include <AK/Checked.h>
 #include <AK/FlyString.h>
+#include <AK/RefCounted.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf16FlyString.h>
 #include <AK/Utf16StringBuilder.h>
@@ -25,9 +28,73 @@ namespace JS {
 // Longer strings are not cached to avoid excessive hashing and lookup costs.
 static constexpr size_t MAX_LENGTH_FOR_STRING_CACHE = 256;
 
+// Concatenations that would make a rope deeper than this are flattened right away. This keeps every rope shallow
+// enough for its pieces to be collected quickly, and makes loops that only ever append copy each piece once.
+static constexpr u32 MAX_ROPE_DEPTH = 512;
+
+static constexpr size_t MIN_APPEND_BUFFER_CAPACITY_IN_CODE_UNITS = 1024;
+
 GC_DEFINE_ALLOCATOR(PrimitiveString);
 GC_DEFINE_ALLOCATOR(RopeString);
 GC_DEFINE_ALLOCATOR(Substring);
+GC_DEFINE_ALLOCATOR(AppendBufferString);
+
+// The storage of AppendBufferStrings, which share its first code units. Appending never moves the code units that
+// were already written, so that the views of the strings made from it stay valid.
+class StringAppendBuffer : public RefCounted<StringAppendBuffer> {
+public:
+    static NonnullRefPtr<StringAppendBuffer> create(size_t capacity_in_code_units)
+    {
+        return adopt_ref(*new StringAppendBuffer(capacity_in_code_units));
+    }
+
+    size_t length_in_code_units() const { return m_builder.length_in_code_units(); }
+
+    Utf16View view(size_t length_in_code_units) const
+    {
+        return m_builder.view().substring_view(0, length_in_code_units);
+    }
+
+    // Only used until the first string is made from the buffer, as appending non-ASCII to ASCII storage rewrites it.
+    void append(Utf16View const& view)
+    {
+        VERIFY(fits(view.is_ascii(), view.length_in_code_units()));
+        m_builder.append(view);
+    }
+
+    bool try_append(Utf16View const& view)
+    {
+        auto view_is_ascii = view.is_ascii();
+        if (has_ascii_storage() && !view_is_ascii)
+            return false;
+        if (!fits(view_is_ascii, view.length_in_code_units()))
+            return false;
+
+        m_builder.append(view);
+        return true;
+    }
+
+private:
+    explicit StringAppendBuffer(size_t capacity_in_code_units)
+        : m_builder(capacity_in_code_units)
+        , m_capacity_in_bytes(capacity_in_code_units * sizeof(char16_t))
+    {
+    }
+
+    bool has_ascii_storage() const { return m_builder.view().has_ascii_storage(); }
+
+    bool fits(bool view_is_ascii, size_t view_length_in_code_units) const
+    {
+        Checked<size_t> byte_count = length_in_code_units();
+        byte_count += view_length_in_code_units;
+        if (!view_is_ascii || !has_ascii_storage())
+            byte_count *= sizeof(char16_t);
+        return !byte_count.has_overflow() && byte_count.value() <= m_capacity_in_bytes;
+    }
+
+    Utf16StringBuilder m_builder;
+    size_t m_capacity_in_bytes { 0 };
+};
 
 Optional<StringView> PrimitiveString::short_flat_string_storage_view() const
 {
@@ -129,7 +196,88 @@ GC::Ref<PrimitiveString> PrimitiveString::create(VM& vm, PrimitiveString& lhs, P
     if (auto short_flat_string = try_create_short_flat_concatenated_string(vm, lhs, rhs))
         return *short_flat_string;
 
-    return vm.heap().allocate<RopeString>(lhs, rhs);
+    if (auto appended_string = try_append_in_place(vm, lhs, rhs))
+        return *appended_string;
+
+    auto depth = max(rope_depth(lhs), rope_depth(rhs)) + 1;
+
+    // NB: A string that was flattened is likely being built by a loop, which reads it before the next append. Its
+    //     code units are copied into an append buffer once, rather than into a new string for every iteration.
+    if (lhs.m_may_start_append_buffer || depth > MAX_ROPE_DEPTH) {
+        lhs.m_may_start_append_buffer = false;
+        return create_append_buffer_string(vm, lhs, rhs);
+    }
+
+    return vm.heap().allocate<RopeString>(lhs, rhs, depth);
+}
+
+GC::Ptr<PrimitiveString> PrimitiveString::try_append_in_place(VM& vm, PrimitiveString const& lhs, PrimitiveString const& rhs)
+{
+    if (lhs.m_deferred_kind != DeferredKind::AppendBuffer)
+        return nullptr;
+
+    auto const& lhs_string = static_cast<AppendBufferString const&>(lhs);
+    auto& buffer = *lhs_string.m_buffer;
+
+    // Strings that don't end where the buffer does share it with a longer string, whose code units follow theirs.
+    if (lhs_string.m_code_unit_length != buffer.length_in_code_units())
+        return nullptr;
+
+    auto rhs_view = rhs.utf16_string_view();
+    Checked<size_t> length_in_code_units = lhs_string.m_code_unit_length;
+    length_in_code_units += rhs_view.length_in_code_units();
+    VERIFY(!length_in_code_units.has_overflow());
+
+    if (buffer.try_append(rhs_view))
+        return vm.heap().allocate<AppendBufferString>(buffer, length_in_code_units.value());
+
+    // The buffer is full, or can't take non-ASCII code units. The string moves to a larger buffer of its own.
+    return create_append_buffer_string(vm, lhs, rhs);
+}
+
+GC::Ref<PrimitiveString> PrimitiveString::create_append_buffer_string(VM& vm, PrimitiveString const& lhs, PrimitiveString const& rhs)
+{
+    Vector<PrimitiveString const*, 2> pieces;
+    size_t length_in_code_units = 0;
+    collect_flat_pieces(lhs, pieces, length_in_code_units);
+    collect_flat_pieces(rhs, pieces, length_in_code_units);
+
+    Checked<size_t> capacity_in_code_units = length_in_code_units;
+    capacity_in_code_units *= 2;
+    VERIFY(!capacity_in_code_units.has_overflow());
+
+    auto buffer = StringAppendBuffer::create(max(capacity_in_code_units.value(), MIN_APPEND_BUFFER_CAPACITY_IN_CODE_UNITS));
+    for (auto const* piece : pieces)
+        buffer->append(piece->utf16_string_view());
+
+    return vm.heap().allocate<AppendBufferString>(move(buffer), length_in_code_units);
+}
+
+void PrimitiveString::collect_flat_pieces(PrimitiveString const& string, Vector<PrimitiveString const*, 2>& pieces, size_t& length_in_code_units)
+{
+    // NOTE: We traverse the rope tree without using recursion, since we'd run out of
+    //       stack space quickly when handling a long sequence of unresolved concatenations.
+    Vector<PrimitiveString const*, 2> stack;
+    stack.append(&string);
+    while (!stack.is_empty()) {
+        auto const* current = stack.take_last();
+        if (current->m_deferred_kind == DeferredKind::Rope) {
+            auto& current_rope_string = static_cast<RopeString const&>(*current);
+            stack.append(current_rope_string.m_rhs);
+            stack.append(current_rope_string.m_lhs);
+            continue;
+        }
+
+        length_in_code_units += current->length_in_utf16_code_units();
+        pieces.append(current);
+    }
+}
+
+u32 PrimitiveString::rope_depth(PrimitiveString const& string)
+{
+    if (string.m_deferred_kind == DeferredKind::Rope)
+        return static_cast<RopeString const&>(string).m_depth;
+    return 0;
 }
 
 GC::Ref<PrimitiveString> PrimitiveString::create(VM& vm, PrimitiveString const& string, size_t code_unit_offset, size_t code_unit_length)
@@ -190,6 +338,10 @@ bool PrimitiveString::is_empty() const
     }
     if (m_deferred_kind == DeferredKind::Substring)
         return static_cast<Substring const&>(*this).m_code_unit_length == 0;
+    if (m_deferred_kind == DeferredKind::AppendBuffer) {
+        // NOTE: We never make an empty append buffer string.
+        return false;
+    }
 
     if (has_utf16_string())
         return m_utf16_string->is_empty();
@@ -211,6 +363,8 @@ Utf16View PrimitiveString::utf16_string_view() const
             auto const& substring = static_cast<Substring const&>(*this);
             return substring.m_source_string->utf16_string_view().substring_view(substring.m_code_unit_offset, substring.m_code_unit_length);
         }
+        if (m_deferred_kind == DeferredKind::AppendBuffer)
+            return static_cast<AppendBufferString const&>(*this).view();
         (void)utf16_string();
     }
     return *m_utf16_string;
@@ -220,6 +374,8 @@ size_t PrimitiveString::length_in_utf16_code_units() const
 {
     if (m_deferred_kind == DeferredKind::Substring)
         return static_cast<Substring const&>(*this).m_code_unit_length;
+    if (m_deferred_kind == DeferredKind::AppendBuffer)
+        return static_cast<AppendBufferString const&>(*this).m_code_unit_length;
     return utf16_string_view().length_in_code_units();
 }
 
@@ -267,6 +423,9 @@ void PrimitiveString::resolve_if_needed() const
     case DeferredKind::Substring:
         static_cast<Substring const&>(*this).resolve();
         return;
+    case DeferredKind::AppendBuffer:
+        static_cast<AppendBufferString const&>(*this).resolve();
+        return;
     }
 
     VERIFY_NOT_REACHED();
@@ -274,45 +433,58 @@ void PrimitiveString::resolve_if_needed() const
 
 void RopeString::resolve() const
 {
-
     // This vector will hold all the pieces of the rope that need to be assembled
     // into the resolved string.
     Vector<PrimitiveString const*, 2> pieces;
     size_t length_in_utf16_code_units = 0;
-
-    // NOTE: We traverse the rope tree without using recursion, since we'd run out of
-    //       stack space quickly when handling a long sequence of unresolved concatenations.
-    Vector<PrimitiveString const*, 2> stack;
-    stack.append(m_rhs);
-    stack.append(m_lhs);
-    while (!stack.is_empty()) {
-        auto const* current = stack.take_last();
-        if (current->m_deferred_kind == DeferredKind::Rope) {
-            auto& current_rope_string = static_cast<RopeString const&>(*current);
-            stack.append(current_rope_string.m_rhs);
-            stack.append(current_rope_string.m_lhs);
-            continue;
-        }
-
-        length_in_utf16_code_units += current->length_in_utf16_code_units();
-        pieces.append(current);
-    }
-
-    Utf16StringBuilder builder(length_in_utf16_code_units);
-    for (auto const* current : pieces) {
-        builder.append(current->utf16_string_view());
+    collect_flat_pieces(*m_lhs, pieces, length_in_utf16_code_units);
+    collect_flat_pieces(*m_rhs, pieces, length_in_utf16_code_units);
+
+    // NB: The storage is chosen once for all pieces, so that they are copied into the resolved string in a single
+    //     pass, rather than into a builder that may have to widen and grow as it goes.
+    auto is_ascii = all_of(pieces, [](auto const* piece) { return piece->utf16_string_view().is_ascii(); });
+
+    if (is_ascii) {
+        m_utf16_string = Utf16String::create_uninitialized_ascii(length_in_utf16_code_units, [&](Bytes buffer) {
+            size_t offset = 0;
+            for (auto const* piece : pieces) {
+                auto view = piece->utf16_string_view();
+                if (view.has_ascii_storage()) {
+                    view.bytes().copy_to(buffer.slice(offset));
+                } else {
+                    for (size_t i = 0; i < view.length_in_code_units(); ++i)
+                        buffer[offset + i] = static_cast<u8>(view.utf16_span()[i]);
+                }
+                offset += view.length_in_code_units();
+            }
+        });
+    } else {
+        m_utf16_string = Utf16String::create_uninitialized_utf16(length_in_utf16_code_units, [&](Span<char16_t> buffer) {
+            size_t offset = 0;
+            for (auto const* piece : pieces) {
+                auto view = piece->utf16_string_view();
+                if (view.has_ascii_storage()) {
+                    for (size_t i = 0; i < view.length_in_code_units(); ++i)
+                        buffer[offset + i] = static_cast<char16_t>(view.ascii_span()[i]);
+                } else {
+                    view.utf16_span().copy_to(buffer.slice(offset));
+                }
+                offset += view.length_in_code_units();
+            }
+        });
     }
 
-    m_utf16_string = builder.to_string();
     m_deferred_kind = DeferredKind::None;
+    m_may_start_append_buffer = length_in_utf16_code_units > MAX_LENGTH_FOR_STRING_CACHE;
     m_lhs = nullptr;
     m_rhs = nullptr;
 }
 
-RopeString::RopeString(GC::Ref<PrimitiveString> lhs, GC::Ref<PrimitiveString> rhs)
+RopeString::RopeString(GC::Ref<PrimitiveString> lhs, GC::Ref<PrimitiveString> rhs, u32 depth)
     : PrimitiveString(DeferredKind::Rope)
     , m_lhs(lhs)
     , m_rhs(rhs)
+    , m_depth(depth)
 {
 }
 
@@ -350,4 +522,33 @@ void Substring::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_source_string);
 }
 
+AppendBufferString::AppendBufferString(NonnullRefPtr<StringAppendBuffer> buffer, size_t code_unit_length)
+    : PrimitiveString(DeferredKind::AppendBuffer)
+    , m_buffer(move(buffer))
+    , m_code_unit_length(code_unit_length)
+{
+}
+
+AppendBufferString::~AppendBufferString() = default;
+
+size_t AppendBufferString::external_memory_size() const
+{
+    // NB: Strings that share a buffer each report their own code units, as any of them may be the last to keep the
+    //     buffer alive.
+    auto size = Base::external_memory_size();
+    return saturating_add_external_memory_size(size, m_code_unit_length * sizeof(char16_t));
+}
+
+Utf16View AppendBufferString::view() const
+{
+    return m_buffer->view(m_code_unit_length);
+}
+
+void AppendBufferString::resolve() const
+{
+    // NB: The string keeps its buffer after being copied out of it, so that it can still be appended to in place.
+    if (!has_utf16_string())
+        m_utf16_string = Utf16String::from_utf16(view());
+}
+
 }
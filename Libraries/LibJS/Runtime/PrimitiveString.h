@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Optional.h>
+#include <AK/NonnullRefPtr.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
 #include <AK/Utf16String.h>
@@ -20,6 +21,8 @@
 
 namespace JS {
 
+class StringAppendBuffer;
+
 class JS_API PrimitiveString : public Cell {
     GC_CELL(PrimitiveString, Cell);
     GC_DECLARE_ALLOCATOR(PrimitiveString);
@@ -58,6 +61,7 @@ protected:
         None,
         Rope,
         Substring,
+        AppendBuffer,
     };
 
     explicit PrimitiveString(DeferredKind deferred_kind)
@@ -71,9 +75,15 @@ protected:
 
     bool m_utf16_string_is_in_cache { false };
 
+    // Set once a concatenation was flattened into this string, which may then start a StringAppendBuffer for the
+    // next concatenation onto it. Cleared once it did, so that a string which is used as a common prefix only gets
+    // copied once.
+    mutable bool m_may_start_append_buffer { false };
+
 private:
     friend class RopeString;
     friend class Substring;
+    friend class AppendBufferString;
 
     virtual void finalize() override;
     virtual size_t external_memory_size() const override;
@@ -83,6 +93,11 @@ private:
     void resolve_if_needed() const;
     Optional<StringView> short_flat_string_storage_view() const;
     static GC::Ptr<PrimitiveString> try_create_short_flat_concatenated_string(VM&, PrimitiveString const& lhs, PrimitiveString const& rhs);
+    static GC::Ptr<PrimitiveString> try_append_in_place(VM&, PrimitiveString const& lhs, PrimitiveString const& rhs);
+    static GC::Ref<PrimitiveString> create_append_buffer_string(VM&, PrimitiveString const& lhs, PrimitiveString const& rhs);
+
+    static void collect_flat_pieces(PrimitiveString const&, Vector<PrimitiveString const*, 2>& pieces, size_t& length_in_code_units);
+    static u32 rope_depth(PrimitiveString const&);
 };
 
 class RopeString final : public PrimitiveString {
@@ -95,7 +110,7 @@ public:
 private:
     friend class PrimitiveString;
 
-    explicit RopeString(GC::Ref<PrimitiveString>, GC::Ref<PrimitiveString>);
+    explicit RopeString(GC::Ref<PrimitiveString>, GC::Ref<PrimitiveString>, u32 depth);
 
     virtual void visit_edges(Visitor&) override;
 
@@ -103,6 +118,9 @@ private:
 
     mutable GC::Ptr<PrimitiveString> m_lhs;
     mutable GC::Ptr<PrimitiveString> m_rhs;
+
+    // The longest path from this rope to a flat string, which concatenation keeps below a limit.
+    u32 m_depth { 0 };
 };
 
 class Substring final : public PrimitiveString {
@@ -126,4 +144,28 @@ private:
     size_t m_code_unit_length { 0 };
 };
 
+// A flat string made of the first code units of a StringAppendBuffer. Concatenating onto the string that ends where
+// the buffer does appends to the buffer in place. This keeps loops like `s += chunk` linear even when they read s in
+// between, where a rope would have to be flattened every time.
+class AppendBufferString final : public PrimitiveString {
+    GC_CELL(AppendBufferString, PrimitiveString);
+    GC_DECLARE_ALLOCATOR(AppendBufferString);
+
+public:
+    virtual ~AppendBufferString() override;
+
+private:
+    friend class PrimitiveString;
+
+    explicit AppendBufferString(NonnullRefPtr<StringAppendBuffer>, size_t code_unit_length);
+
+    virtual size_t external_memory_size() const override;
+
+    Utf16View view() const;
+    void resolve() const;
+
+    NonnullRefPtr<StringAppendBuffer> m_buffer;
+    size_t m_code_unit_length { 0 };
+};
+
 }
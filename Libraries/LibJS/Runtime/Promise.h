@@ -49,6 +49,9 @@ public:
     void reject(Value reason);
     Value perform_then(Value on_fulfilled, Value on_rejected, GC::Ptr<PromiseCapability> result_capability);
 
+    // PerformPromiseThen without a resultCapability, using reactions from PromiseReaction::create_for_await().
+    void perform_then_for_await(PromiseReaction& fulfill_reaction, PromiseReaction& reject_reaction);
+
     bool is_handled() const { return m_is_handled; }
     void set_is_handled() { m_is_handled = true; }
 
@@ -63,6 +66,7 @@ private:
     bool is_settled() const { return m_state == State::Fulfilled || m_state == State::Rejected; }
 
     void trigger_reactions() const;
+    void add_reactions(PromiseReaction& fulfill_reaction, PromiseReaction& reject_reaction);
 
     // 27.2.6 Properties of Promise Instances, https://tc39.es/ecma262/#sec-properties-of-promise-instances
     State m_state { State::Pending };                     // [[PromiseState]]
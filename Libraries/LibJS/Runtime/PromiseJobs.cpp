@@ -86,6 +86,11 @@ static ThrowCompletionOr<Value> run_reaction_job(VM& vm, PromiseReaction& reacti
 // 27.2.2.1 NewPromiseReactionJob ( reaction, argument ), https://tc39.es/ecma262/#sec-newpromisereactionjob
 PromiseJob create_promise_reaction_job(VM& vm, PromiseReaction& reaction, Value argument)
 {
+    // OPTIMIZATION: Reactions created for Await() resume the awaiting function with a job that reads the result from the
+    //               awaited promise itself, so there's no need to allocate a new job capturing the argument.
+    if (auto resume_job = reaction.resume_job())
+        return { *resume_job, reaction.resume_job_realm() };
+
     // 1. Let job be a new Job Abstract Closure with no parameters that captures reaction and argument and performs the following steps when called:
     //    See run_reaction_job for "the following steps".
     auto job = GC::create_function(vm.heap(), [&vm, &reaction, argument] {
@@ -17,6 +17,11 @@ GC::Ref<PromiseReaction> PromiseReaction::create(VM& vm, Type type, GC::Ptr<Prom
     return vm.heap().allocate<PromiseReaction>(type, capability, move(handler));
 }
 
+GC::Ref<PromiseReaction> PromiseReaction::create_for_await(VM& vm, Type type, GC::Ref<ResumeJob> resume_job, Realm& realm)
+{
+    return vm.heap().allocate<PromiseReaction>(type, resume_job, realm);
+}
+
 PromiseReaction::PromiseReaction(Type type, GC::Ptr<PromiseCapability> capability, GC::Ptr<JobCallback> handler)
     : m_type(type)
     , m_capability(capability)
@@ -24,11 +29,20 @@ PromiseReaction::PromiseReaction(Type type, GC::Ptr<PromiseCapability> capabilit
 {
 }
 
+PromiseReaction::PromiseReaction(Type type, GC::Ref<ResumeJob> resume_job, Realm& realm)
+    : m_type(type)
+    , m_resume_job(resume_job)
+    , m_resume_job_realm(realm)
+{
+}
+
 void PromiseReaction::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_capability);
     visitor.visit(m_handler);
+    visitor.visit(m_resume_job);
+    visitor.visit(m_resume_job_realm);
 }
 
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <LibGC/Function.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Runtime/JobCallback.h>
@@ -24,8 +25,14 @@ public:
         Reject,
     };
 
+    using ResumeJob = GC::Function<ThrowCompletionOr<Value>()>;
+
     static GC::Ref<PromiseReaction> create(VM& vm, Type type, GC::Ptr<PromiseCapability> capability, GC::Ptr<JobCallback> handler);
 
+    // OPTIMIZATION: Await() only needs its reactions to resume the awaiting function. Reactions created by this enqueue
+    //               the given job directly instead of calling a handler, and may be reused for any number of awaits.
+    static GC::Ref<PromiseReaction> create_for_await(VM& vm, Type type, GC::Ref<ResumeJob> resume_job, Realm& realm);
+
     virtual ~PromiseReaction() = default;
 
     Type type() const { return m_type; }
@@ -34,14 +41,21 @@ public:
     GC::Ptr<JobCallback> handler() { return m_handler; }
     GC::Ptr<JobCallback const> handler() const { return m_handler; }
 
+    GC::Ptr<ResumeJob> resume_job() const { return m_resume_job; }
+    GC::Ptr<Realm> resume_job_realm() const { return m_resume_job_realm; }
+
 private:
     PromiseReaction(Type type, GC::Ptr<PromiseCapability> capability, GC::Ptr<JobCallback> handler);
+    PromiseReaction(Type type, GC::Ref<ResumeJob> resume_job, Realm& realm);
 
     virtual void visit_edges(Visitor&) override;
 
     Type m_type;
     GC::Ptr<PromiseCapability> m_capability;
     GC::Ptr<JobCallback> m_handler;
+
+    GC::Ptr<ResumeJob> m_resume_job;
+    GC::Ptr<Realm> m_resume_job_realm;
 };
 
 }
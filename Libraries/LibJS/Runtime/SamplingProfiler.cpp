@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/JsonArray.h>
+#include <AK/Platform.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
+#include <LibJS/Runtime/VM.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+
+#if !defined(AK_OS_WINDOWS)
+#    include <unistd.h>
+#endif
+
+namespace JS {
+
+static Atomic<SamplingProfiler*> s_active_profiler { nullptr };
+
+// clock_gettime() is async-signal-safe, unlike most of what goes into MonotonicTime::now().
+static i64 monotonic_time_in_nanoseconds()
+{
+    timespec now {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<i64>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+}
+
+#if !defined(AK_OS_WINDOWS)
+static ErrorOr<void> install_sample_signal_handler(void (*handler)(int))
+{
+    static bool s_installed = false;
+    if (s_installed)
+        return {};
+
+    // The handler is never uninstalled: a signal sent just before a profiler stops may still be pending, and SIGPROF's
+    // default action would terminate the process. Once no profiler is active, the handler does nothing.
+    struct sigaction action {};
+    action.sa_handler = handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) < 0)
+        return Error::from_errno(errno);
+
+    s_installed = true;
+    return {};
+}
+#endif
+
+ErrorOr<NonnullOwnPtr<SamplingProfiler>> SamplingProfiler::start(VM& vm, Options options)
+{
+#if defined(AK_OS_WINDOWS)
+    (void)vm;
+    (void)options;
+    return Error::from_errno(ENOTSUP);
+#else
+    if (options.interval <= AK::Duration::zero() || options.maximum_sample_count == 0 || options.maximum_frame_count == 0)
+        return Error::from_errno(EINVAL);
+    if (options.maximum_frame_count > NumericLimits<u32>::max())
+        return Error::from_errno(EINVAL);
+
+    TRY(install_sample_signal_handler(sample_signal_handler));
+
+    auto profiler = adopt_own(*new SamplingProfiler(vm, options));
+    TRY(profiler->m_samples.try_resize(options.maximum_sample_count));
+    TRY(profiler->m_frame_executables.try_resize(options.maximum_frame_count));
+    TRY(profiler->m_frame_program_counters.try_resize(options.maximum_frame_count));
+
+    SamplingProfiler* expected = nullptr;
+    if (!s_active_profiler.compare_exchange_strong(expected, profiler.ptr()))
+        return Error::from_errno(EBUSY);
+
+    profiler->m_start_time = UnixDateTime::now();
+    profiler->m_start_time_in_nanoseconds = monotonic_time_in_nanoseconds();
+
+    if (auto rc = pthread_create(&profiler->m_thread, nullptr, sample_periodically, profiler.ptr()); rc != 0) {
+        s_active_profiler.store(nullptr);
+        return Error::from_errno(rc);
+    }
+    profiler->m_thread_started = true;
+
+    return profiler;
+#endif
+}
+
+SamplingProfiler::SamplingProfiler(VM& vm, Options options)
+    : GC::ConservativeRangeProvider(vm.heap())
+    , m_vm(vm)
+    , m_options(options)
+    , m_sampled_thread(pthread_self())
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+}
+
+void SamplingProfiler::stop()
+{
+    if (!m_thread_started)
+        return;
+
+    // Clearing the active profiler first makes any signal that is still in flight a no-op.
+    s_active_profiler.store(nullptr);
+    m_should_stop.store(true);
+    pthread_join(m_thread, nullptr);
+    m_thread_started = false;
+}
+
+void* SamplingProfiler::sample_periodically(void* argument)
+{
+#if !defined(AK_OS_WINDOWS)
+    auto& profiler = *static_cast<SamplingProfiler*>(argument);
+
+    auto interval = profiler.m_options.interval.to_timespec();
+    while (!profiler.m_should_stop.load()) {
+        auto remaining = interval;
+        while (nanosleep(&remaining, &remaining) < 0 && errno == EINTR)
+            ;
+
+        if (profiler.m_should_stop.load())
+            break;
+        if (pthread_kill(profiler.m_sampled_thread, SIGPROF) != 0)
+            break;
+    }
+#else
+    (void)argument;
+#endif
+    return nullptr;
+}
+
+void SamplingProfiler::sample_signal_handler(int)
+{
+    auto saved_errno = errno;
+    if (auto* profiler = s_active_profiler.load(AK::MemoryOrder::memory_order_acquire))
+        profiler->take_sample();
+    errno = saved_errno;
+}
+
+void SamplingProfiler::take_sample()
+{
+    // NB: This runs in a signal handler. It must not allocate, take locks, or touch anything but the preallocated
+    //     sample storage and the frames it reads off the execution context stack.
+    auto sample_index = m_sample_count.load(AK::MemoryOrder::memory_order_relaxed);
+    if (sample_index >= m_samples.size()) {
+        m_dropped_sample_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        return;
+    }
+
+    auto first_frame = m_frame_count.load(AK::MemoryOrder::memory_order_relaxed);
+    auto frame_index = first_frame;
+    bool out_of_frames = false;
+    ExecutionContext const* callee = nullptr;
+
+    auto walked = m_vm.for_each_execution_context_top_to_bottom_from_signal_handler([&](ExecutionContext const& context) {
+        // An inline callee records where its caller will resume, which is more precise than the caller's own program
+        // counter. The innermost frame's program counter is only as fresh as the interpreter last stored it.
+        auto program_counter = context.program_counter;
+        if (callee && callee->caller_frame == &context && callee->caller_return_pc != 0)
+            program_counter = callee->caller_return_pc - 1;
+        callee = &context;
+
+        if (!context.executable)
+            return true;
+
+        if (frame_index >= m_frame_executables.size()) {
+            out_of_frames = true;
+            return false;
+        }
+
+        m_frame_executables[frame_index] = bit_cast<FlatPtr>(context.executable.ptr());
+        m_frame_program_counters[frame_index] = program_counter;
+        ++frame_index;
+        return true;
+    });
+
+    if (!walked || out_of_frames) {
+        m_dropped_sample_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        return;
+    }
+
+    m_samples[sample_index] = {
+        .time_in_nanoseconds = monotonic_time_in_nanoseconds(),
+        .first_frame = static_cast<u32>(first_frame),
+        .frame_count = static_cast<u32>(frame_index - first_frame),
+    };
+    m_frame_count.store(frame_index, AK::MemoryOrder::memory_order_release);
+    m_sample_count.store(sample_index + 1, AK::MemoryOrder::memory_order_release);
+}
+
+void SamplingProfiler::for_each_conservative_range(Function<void(ReadonlySpan<FlatPtr>)> const& callback) const
+{
+    auto frame_count = m_frame_count.load(AK::MemoryOrder::memory_order_acquire);
+    callback(m_frame_executables.span().trim(frame_count));
+}
+
+// https://github.com/firefox-devtools/profiler/blob/main/docs-developer/gecko-profile-format.md
+JsonObject SamplingProfiler::to_gecko_profile(StringView thread_name) const
+{
+    VERIFY(!m_thread_started);
+
+    static constexpr u32 gecko_profile_version = 24;
+    static constexpr size_t javascript_category = 0;
+
+    JsonArray string_table;
+    JsonArray frame_table_data;
+    JsonArray stack_table_data;
+    JsonArray samples_data;
+
+    HashMap<String, size_t> frame_indices;
+    HashMap<u64, size_t> stack_indices;
+
+    auto frame_index_for = [&](Bytecode::Executable const& executable, u32 program_counter) {
+        StringBuilder location;
+        if (executable.name.is_empty())
+            location.append("(anonymous)"sv);
+        else
+            location.appendff("{}", executable.name);
+
+        Optional<Position> position;
+        if (auto source_range = executable.source_range_at(program_counter); source_range.has_value())
+            position = source_range->start;
+
+        auto const& filename = executable.source_code->filename();
+        if (position.has_value())
+            location.appendff(" ({}:{}:{})", filename, position->line, position->column);
+        else if (!filename.is_empty())
+            location.appendff(" ({})", filename);
+
+        auto key = location.to_string_without_validation();
+        if (auto index = frame_indices.get(key); index.has_value())
+            return *index;
+
+        auto string_index = string_table.size();
+        string_table.must_append(key);
+
+        JsonArray frame;
+        frame.must_append(string_index);
+        frame.must_append(true);
+        frame.must_append(0);
+        frame.must_append(JsonValue {});
+        frame.must_append(JsonValue {});
+        if (position.has_value()) {
+            frame.must_append(position->line);
+            frame.must_append(position->column);
+        } else {
+            frame.must_append(JsonValue {});
+            frame.must_append(JsonValue {});
+        }
+        frame.must_append(javascript_category);
+        frame.must_append(0);
+
+        auto frame_index = frame_table_data.size();
+        frame_table_data.must_append(move(frame));
+        frame_indices.set(move(key), frame_index);
+        return frame_index;
+    };
+
+    auto stack_index_for = [&](Optional<size_t> prefix, size_t frame_index) {
+        auto key = (static_cast<u64>(prefix.map([](auto index) { return index + 1; }).value_or(0)) << 32) | frame_index;
+        if (auto index = stack_indices.get(key); index.has_value())
+            return *index;
+
+        JsonArray stack;
+        if (prefix.has_value())
+            stack.must_append(*prefix);
+        else
+            stack.must_append(JsonValue {});
+        stack.must_append(frame_index);
+
+        auto stack_index = stack_table_data.size();
+        stack_table_data.must_append(move(stack));
+        stack_indices.set(key, stack_index);
+        return stack_index;
+    };
+
+    auto sample_count = this->sample_count();
+    for (size_t i = 0; i < sample_count; ++i) {
+        auto const& sample = m_samples[i];
+
+        // Frames were recorded innermost first, but stacks are built from the outermost frame.
+        Optional<size_t> stack_index;
+        for (size_t j = sample.frame_count; j-- > 0;) {
+            auto frame = sample.first_frame + j;
+            auto const& executable = *bit_cast<Bytecode::Executable const*>(m_frame_executables[frame]);
+            stack_index = stack_index_for(stack_index, frame_index_for(executable, m_frame_program_counters[frame]));
+        }
+
+        JsonArray sample_entry;
+        if (stack_index.has_value())
+            sample_entry.must_append(*stack_index);
+        else
+            sample_entry.must_append(JsonValue {});
+        sample_entry.must_append(static_cast<double>(sample.time_in_nanoseconds - m_start_time_in_nanoseconds) / 1'000'000.0);
+        sample_entry.must_append(0);
+        samples_data.must_append(move(sample_entry));
+    }
+
+    auto schema = [](std::initializer_list<StringView> fields) {
+        JsonObject object;
+        size_t index = 0;
+        for (auto field : fields)
+            object.set(field, index++);
+        return object;
+    };
+
+    auto table = [](JsonObject schema, JsonArray data) {
+        JsonObject object;
+        object.set("schema"sv, move(schema));
+        object.set("data"sv, move(data));
+        return object;
+    };
+
+    JsonObject thread;
+    thread.set("name"sv, thread_name);
+    thread.set("processType"sv, "default"sv);
+    thread.set("registerTime"sv, 0);
+    thread.set("unregisterTime"sv, JsonValue {});
+#if !defined(AK_OS_WINDOWS)
+    thread.set("pid"sv, getpid());
+#endif
+    thread.set("tid"sv, 0);
+    thread.set("markers"sv, table(schema({ "name"sv, "startTime"sv, "endTime"sv, "phase"sv, "category"sv, "data"sv }), {}));
+    thread.set("samples"sv, table(schema({ "stack"sv, "time"sv, "eventDelay"sv }), move(samples_data)));
+    thread.set("frameTable"sv, table(schema({ "location"sv, "relevantForJS"sv, "innerWindowID"sv, "implementation"sv, "optimizations"sv, "line"sv, "column"sv, "category"sv, "subcategory"sv }), move(frame_table_data)));
+    thread.set("stackTable"sv, table(schema({ "prefix"sv, "frame"sv }), move(stack_table_data)));
+    thread.set("stringTable"sv, move(string_table));
+
+    JsonObject category;
+    category.set("name"sv, "JavaScript"sv);
+    category.set("color"sv, "yellow"sv);
+    JsonArray subcategories;
+    subcategories.must_append("Other"sv);
+    category.set("subcategories"sv, move(subcategories));
+
+    JsonArray categories;
+    categories.must_append(move(category));
+
+    JsonObject meta;
+    meta.set("version"sv, gecko_profile_version);
+    meta.set("interval"sv, static_cast<double>(m_options.interval.to_microseconds()) / 1000.0);
+    meta.set("startTime"sv, static_cast<double>(m_start_time.milliseconds_since_epoch()));
+    meta.set("shutdownTime"sv, JsonValue {});
+    meta.set("processType"sv, 0);
+    meta.set("product"sv, "Ladybird"sv);
+    meta.set("stackwalk"sv, 0);
+    meta.set("symbolicated"sv, true);
+    meta.set("categories"sv, move(categories));
+    meta.set("droppedSampleCount"sv, dropped_sample_count());
+
+    JsonArray threads;
+    threads.must_append(move(thread));
+
+    JsonObject profile;
+    profile.set("meta"sv, move(meta));
+    profile.set("libs"sv, JsonArray {});
+    profile.set("threads"sv, move(threads));
+    profile.set("processes"sv, JsonArray {});
+    profile.set("pausedRanges"sv, JsonArray {});
+    return profile;
+}
+
+}
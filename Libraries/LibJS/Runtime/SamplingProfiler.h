@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Error.h>
+#include <AK/JsonObject.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibGC/ConservativeRangeProvider.h>
+#include <LibJS/Export.h>
+#include <LibJS/Forward.h>
+#include <pthread.h>
+
+namespace JS {
+
+// Periodically interrupts the VM's thread with a signal and records the execution context stack, so that JavaScript
+// running in production builds can be profiled without instrumenting the interpreter. Samples are written into storage
+// that is allocated up front, and are only symbolicated once the profiler has been stopped.
+//
+// Only one profiler may be running per process, and it must be started and stopped on the VM's thread.
+class JS_API SamplingProfiler final : public GC::ConservativeRangeProvider {
+    AK_MAKE_NONCOPYABLE(SamplingProfiler);
+    AK_MAKE_NONMOVABLE(SamplingProfiler);
+
+public:
+    struct Options {
+        AK::Duration interval { AK::Duration::from_milliseconds(1) };
+        size_t maximum_sample_count { 100'000 };
+        size_t maximum_frame_count { 2'000'000 };
+    };
+    static ErrorOr<NonnullOwnPtr<SamplingProfiler>> start(VM&, Options);
+    static ErrorOr<NonnullOwnPtr<SamplingProfiler>> start(VM& vm) { return start(vm, {}); }
+
+    virtual ~SamplingProfiler() override;
+
+    void stop();
+    bool is_running() const { return m_thread_started; }
+
+    size_t sample_count() const { return m_sample_count.load(AK::MemoryOrder::memory_order_acquire); }
+    size_t dropped_sample_count() const { return m_dropped_sample_count.load(AK::MemoryOrder::memory_order_relaxed); }
+
+    // Serializes the samples in the Gecko profile format, which can be loaded into profiler.firefox.com.
+    JsonObject to_gecko_profile(StringView thread_name) const;
+
+private:
+    SamplingProfiler(VM&, Options);
+
+    static void* sample_periodically(void*);
+    static void sample_signal_handler(int);
+
+    void take_sample();
+
+    virtual void for_each_conservative_range(Function<void(ReadonlySpan<FlatPtr>)> const&) const override;
+
+    struct Sample {
+        i64 time_in_nanoseconds { 0 };
+        u32 first_frame { 0 };
+        u32 frame_count { 0 };
+    };
+
+    VM& m_vm;
+    Options m_options;
+
+    // Written by the signal handler, which runs on the VM's thread between any two instructions. The executables are
+    // kept as raw words so that the heap treats them as conservative roots until the profile has been serialized.
+    Vector<Sample> m_samples;
+    Vector<FlatPtr> m_frame_executables;
+    Vector<u32> m_frame_program_counters;
+    Atomic<size_t> m_sample_count { 0 };
+    Atomic<size_t> m_frame_count { 0 };
+    Atomic<size_t> m_dropped_sample_count { 0 };
+
+    i64 m_start_time_in_nanoseconds { 0 };
+    UnixDateTime m_start_time;
+
+    pthread_t m_sampled_thread {};
+    pthread_t m_thread {};
+    bool m_thread_started { false };
+    Atomic<bool> m_should_stop { false };
+};
+
+}
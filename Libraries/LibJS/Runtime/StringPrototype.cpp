@@ -608,7 +608,12 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::locale_compare)
         }
         collator = realm.intrinsics().default_collator();
     } else {
-        collator = TRY(construct(vm, realm.intrinsics().intl_collator_constructor(), locales, options));
+        // OPTIMIZATION: Reuse a previously constructed Collator if constructing a new one would not be observable.
+        collator = realm.intrinsics().cached_locale_formatter(Intrinsics::LocaleFormatterType::Collator, locales, options);
+        if (!collator) {
+            collator = TRY(construct(vm, realm.intrinsics().intl_collator_constructor(), locales, options));
+            realm.intrinsics().cache_locale_formatter(Intrinsics::LocaleFormatterType::Collator, locales, options, *collator);
+        }
     }
 
     // 5. Return CompareStrings(collator, S, thatValue).
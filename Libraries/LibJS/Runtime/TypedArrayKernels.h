@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BitCast.h>
+#include <AK/Optional.h>
+#include <AK/SIMDExtras.h>
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+#include <LibJS/Forward.h>
+#include <math.h>
+
+// These implement the bulk operations of %TypedArray%.prototype on the raw elements of an array buffer, rather than on
+// one Value at a time. Elements are loaded and stored with memcpy, as the storage of an array buffer is only aligned to
+// its elements in practice, not by contract.
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace JS::TypedArrayKernels {
+
+namespace Detail {
+
+template<typename T>
+struct VectorFor { };
+
+// clang-format off
+template<> struct VectorFor<u8> { using Type = AK::SIMD::u8x16; };
+template<> struct VectorFor<i8> { using Type = AK::SIMD::i8x16; };
+template<> struct VectorFor<u16> { using Type = AK::SIMD::u16x8; };
+template<> struct VectorFor<i16> { using Type = AK::SIMD::i16x8; };
+template<> struct VectorFor<u32> { using Type = AK::SIMD::u32x4; };
+template<> struct VectorFor<i32> { using Type = AK::SIMD::i32x4; };
+template<> struct VectorFor<u64> { using Type = AK::SIMD::u64x2; };
+template<> struct VectorFor<i64> { using Type = AK::SIMD::i64x2; };
+template<> struct VectorFor<float> { using Type = AK::SIMD::f32x4; };
+template<> struct VectorFor<double> { using Type = AK::SIMD::f64x2; };
+// clang-format on
+
+template<typename T>
+concept HasVector = requires { typename VectorFor<T>::Type; };
+
+template<typename T>
+ALWAYS_INLINE static T load(u8 const* data)
+{
+    T value;
+    __builtin_memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+template<typename T>
+ALWAYS_INLINE static void store(u8* data, T value)
+{
+    __builtin_memcpy(data, &value, sizeof(T));
+}
+
+template<typename Vector, typename T>
+ALWAYS_INLINE static Vector splat(T value)
+{
+    Vector vector;
+    for (size_t i = 0; i < AK::SIMD::vector_length<Vector>; ++i)
+        vector[i] = value;
+    return vector;
+}
+
+template<typename Mask>
+ALWAYS_INLINE static bool any(Mask mask)
+{
+    static_assert(sizeof(Mask) == sizeof(AK::SIMD::u64x2));
+    auto lanes = bit_cast<AK::SIMD::u64x2>(mask);
+    return (lanes[0] | lanes[1]) != 0;
+}
+
+}
+
+template<typename T>
+concept IsBigIntElement = IsIntegral<T> && sizeof(T) == 8;
+
+// Returns the index of the first element at or after start that is equal to needle. Elements are compared as values of
+// type T, so +0 and -0 are equal and NaN is never found.
+template<typename T>
+Optional<size_t> find_first(ReadonlyBytes elements, size_t start, T needle)
+{
+    auto const* data = elements.data();
+    auto count = elements.size() / sizeof(T);
+    auto index = start;
+
+    if constexpr (Detail::HasVector<T>) {
+        using Vector = typename Detail::VectorFor<T>::Type;
+        constexpr auto lanes = AK::SIMD::vector_length<Vector>;
+
+        auto needles = Detail::splat<Vector>(needle);
+        for (; index + lanes <= count; index += lanes) {
+            if (Detail::any(AK::SIMD::load_unaligned<Vector>(data + (index * sizeof(T))) == needles))
+                break;
+        }
+    }
+
+    for (; index < count; ++index) {
+        if (Detail::load<T>(data + (index * sizeof(T))) == needle)
+            return index;
+    }
+    return {};
+}
+
+// Returns the index of the last element at or before last that is equal to needle, compared like find_first().
+template<typename T>
+Optional<size_t> find_last(ReadonlyBytes elements, size_t last, T needle)
+{
+    auto const* data = elements.data();
+    auto end = last + 1;
+    VERIFY(end <= elements.size() / sizeof(T));
+
+    if constexpr (Detail::HasVector<T>) {
+        using Vector = typename Detail::VectorFor<T>::Type;
+        constexpr auto lanes = AK::SIMD::vector_length<Vector>;
+
+        auto needles = Detail::splat<Vector>(needle);
+        for (; end >= lanes; end -= lanes) {
+            if (Detail::any(AK::SIMD::load_unaligned<Vector>(data + ((end - lanes) * sizeof(T))) == needles))
+                break;
+        }
+    }
+
+    while (end > 0) {
+        --end;
+        if (Detail::load<T>(data + (end * sizeof(T))) == needle)
+            return end;
+    }
+    return {};
+}
+
+// Returns the index of the first NaN element at or after start.
+template<typename T>
+requires(IsFloatingPoint<T>)
+Optional<size_t> find_first_nan(ReadonlyBytes elements, size_t start)
+{
+    auto const* data = elements.data();
+    auto count = elements.size() / sizeof(T);
+    auto index = start;
+
+    if constexpr (Detail::HasVector<T>) {
+        using Vector = typename Detail::VectorFor<T>::Type;
+        constexpr auto lanes = AK::SIMD::vector_length<Vector>;
+
+        for (; index + lanes <= count; index += lanes) {
+            auto block = AK::SIMD::load_unaligned<Vector>(data + (index * sizeof(T)));
+            if (Detail::any(block != block))
+                break;
+        }
+    }
+
+    for (; index < count; ++index) {
+        auto element = Detail::load<T>(data + (index * sizeof(T)));
+        if (element != element)
+            return index;
+    }
+    return {};
+}
+
+// Reverses the order of the elements in place. T is an unsigned integer of the element size, so that the bits of every
+// element are kept as they are.
+template<typename T>
+requires(IsUnsigned<T>)
+void reverse(Bytes elements)
+{
+    auto* data = elements.data();
+    size_t lower = 0;
+    size_t upper = elements.size() / sizeof(T);
+
+    if constexpr (Detail::HasVector<T>) {
+        using Vector = typename Detail::VectorFor<T>::Type;
+        constexpr auto lanes = AK::SIMD::vector_length<Vector>;
+
+        for (; upper - lower >= 2 * lanes; lower += lanes, upper -= lanes) {
+            auto lower_block = AK::SIMD::load_unaligned<Vector>(data + (lower * sizeof(T)));
+            auto upper_block = AK::SIMD::load_unaligned<Vector>(data + ((upper - lanes) * sizeof(T)));
+            AK::SIMD::store_unaligned(data + (lower * sizeof(T)), AK::SIMD::item_reverse(upper_block));
+            AK::SIMD::store_unaligned(data + ((upper - lanes) * sizeof(T)), AK::SIMD::item_reverse(lower_block));
+        }
+    }
+
+    for (; upper - lower >= 2; ++lower) {
+        --upper;
+        auto lower_element = Detail::load<T>(data + (lower * sizeof(T)));
+        Detail::store(data + (lower * sizeof(T)), Detail::load<T>(data + (upper * sizeof(T))));
+        Detail::store(data + (upper * sizeof(T)), lower_element);
+    }
+}
+
+// Converts an element the way NumericToRawBytes converts the Number or BigInt value that it stands for, when storing it
+// in a typed array of the target type. Target is ClampedU8 for a Uint8ClampedArray.
+template<typename Target, typename Source>
+ALWAYS_INLINE static auto convert_element(Source value)
+{
+    static_assert(IsBigIntElement<Source> == IsBigIntElement<Target>);
+
+    if constexpr (IsFloatingPoint<Target>) {
+        return static_cast<Target>(static_cast<double>(value));
+    } else if constexpr (IsSame<Target, ClampedU8>) {
+        if constexpr (IsIntegral<Source>) {
+            return static_cast<u8>(clamp<i64>(value, 0, 255));
+        } else {
+            auto number = static_cast<double>(value);
+            if (isnan(number) || number <= 0.0)
+                return static_cast<u8>(0);
+            if (number >= 255.0)
+                return static_cast<u8>(255);
+
+            auto floored = floor(number);
+            if (floored + 0.5 < number)
+                return static_cast<u8>(floored + 1.0);
+            if (number < floored + 0.5)
+                return static_cast<u8>(floored);
+            return static_cast<u8>(fmod(floored, 2.0) == 0.0 ? floored : floored + 1.0);
+        }
+    } else if constexpr (IsIntegral<Source>) {
+        return static_cast<Target>(value);
+    } else {
+        // NB: Truncating to an integer of at most 32 bits is modulo 2^32 first, like ToInt32 and ToUint32.
+        auto number = static_cast<double>(value);
+        if (!isfinite(number))
+            return static_cast<Target>(0);
+        auto wrapped = fmod(trunc(number), 4294967296.0);
+        return static_cast<Target>(static_cast<u32>(static_cast<i64>(wrapped)));
+    }
+}
+
+// Converts count elements of type Source into elements of type Target. Source is u8 for a Uint8ClampedArray.
+template<typename Source, typename Target>
+void convert(ReadonlyBytes source, Bytes target, size_t count)
+{
+    using TargetElement = Conditional<IsSame<Target, ClampedU8>, u8, Target>;
+    VERIFY(source.size() >= count * sizeof(Source));
+    VERIFY(target.size() >= count * sizeof(TargetElement));
+
+    auto const* source_data = source.data();
+    auto* target_data = target.data();
+
+    // NB: This loop has no dependencies between iterations, so the compiler vectorizes it for the conversions that the
+    //     target has instructions for.
+    for (size_t i = 0; i < count; ++i) {
+        auto element = Detail::load<Source>(source_data + (i * sizeof(Source)));
+        Detail::store<TargetElement>(target_data + (i * sizeof(TargetElement)), convert_element<Target>(element));
+    }
+}
+
+}
+
+#pragma GCC diagnostic pop
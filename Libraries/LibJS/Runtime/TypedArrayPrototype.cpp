@@ -14,6 +14,7 @@
 #include <LibJS/Runtime/ArrayIterator.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/TypedArray.h>
+#include <LibJS/Runtime/TypedArrayKernels.h>
 #include <LibJS/Runtime/TypedArrayPrototype.h>
 #include <LibJS/Runtime/ValueInlines.h>
 
@@ -485,7 +486,7 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::every)
 // NOTE: This function assumes that the index is valid within the TypedArray,
 //       and that the TypedArray is not detached.
 template<typename T>
-inline void fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 end, T value)
+inline bool fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 end, T value)
 {
     Checked<size_t> computed_begin = begin;
     computed_begin *= sizeof(T);
@@ -496,12 +497,12 @@ inline void fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 en
     computed_end += typed_array.byte_offset();
 
     if (computed_begin.has_overflow() || computed_end.has_overflow()) [[unlikely]] {
-        return;
+        return false;
     }
 
     if (computed_begin.value() >= typed_array.viewed_array_buffer()->byte_length()
         || computed_end.value() > typed_array.viewed_array_buffer()->byte_length()) [[unlikely]] {
-        return;
+        return false;
     }
 
     auto& array_buffer = *typed_array.viewed_array_buffer();
@@ -519,13 +520,25 @@ inline void fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 en
             byte_index += chunk_size;
             remaining_bytes -= chunk_size;
         }
-        return;
+        return true;
     }
 
     for (auto i = begin; i < end; ++i) {
         array_buffer.overwrite(byte_index, &value, sizeof(T));
         byte_index += sizeof(T);
     }
+    return true;
+}
+
+// NOTE: Every element is set to the same raw bytes, so the value is only converted once.
+template<typename T>
+static bool fast_typed_array_fill_with_value(VM& vm, TypedArrayBase& typed_array, u32 begin, u32 end, Value value)
+{
+    using UnderlyingBufferDataType = Conditional<IsSame<ClampedU8, T>, u8, T>;
+
+    UnderlyingBufferDataType raw_value;
+    numeric_to_raw_bytes<T>(vm, value, true, { &raw_value, sizeof(raw_value) });
+    return fast_typed_array_fill(typed_array, begin, end, raw_value);
 }
 
 // 23.2.3.9 %TypedArray%.prototype.fill ( value [ , start [ , end ] ] ), https://tc39.es/ecma262/#sec-%typedarray%.prototype.fill
@@ -596,34 +609,20 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::fill)
     // 17. Set final to min(final, len).
     final = min(final, length);
 
-    if (value.is_int32()) {
-        switch (typed_array->kind()) {
-        case TypedArrayBase::Kind::Uint8Array:
-            fast_typed_array_fill<u8>(*typed_array, k, final, static_cast<u8>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Uint16Array:
-            fast_typed_array_fill<u16>(*typed_array, k, final, static_cast<u16>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Uint32Array:
-            fast_typed_array_fill<u32>(*typed_array, k, final, static_cast<u32>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Int8Array:
-            fast_typed_array_fill<i8>(*typed_array, k, final, static_cast<i8>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Int16Array:
-            fast_typed_array_fill<i16>(*typed_array, k, final, static_cast<i16>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Int32Array:
-            fast_typed_array_fill<i32>(*typed_array, k, final, value.as_i32());
-            return typed_array;
-        case TypedArrayBase::Kind::Uint8ClampedArray:
-            fast_typed_array_fill<u8>(*typed_array, k, final, clamp(value.as_i32(), 0, 255));
-            return typed_array;
-        default:
-            // FIXME: Support more TypedArray kinds.
-            break;
-        }
+    if (k >= final)
+        return typed_array;
+
+    bool filled = false;
+    switch (typed_array->kind()) {
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type)         \
+    case TypedArrayBase::Kind::ClassName:                                                   \
+        filled = fast_typed_array_fill_with_value<Type>(vm, *typed_array, k, final, value); \
+        break;
+        JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
     }
+    if (filled)
+        return typed_array;
 
     // 18. Repeat, while k < final,
     while (k < final) {
@@ -897,6 +896,72 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::for_each)
     return js_undefined();
 }
 
+// NOTE: Coercing fromIndex may have shrunk the array, in which case its elements past the new length have to be read as
+//       undefined by the generic steps.
+static bool typed_array_elements_are_in_bounds(TypedArrayBase const& typed_array, u32 length)
+{
+    auto typed_array_record = make_typed_array_with_buffer_witness_record(typed_array, ArrayBuffer::Order::SeqCst);
+    return !is_typed_array_out_of_bounds(typed_array_record) && typed_array_length(typed_array_record) >= length;
+}
+
+enum class SearchEquality {
+    IsStrictlyEqual,
+    SameValueZero,
+};
+
+// Finds the search element among the raw elements from k on in the given direction, rather than getting each element
+// as a Value. The typed array's elements must be in bounds up to length.
+template<typename T>
+static Optional<u32> search_typed_array_elements(VM& vm, TypedArrayBase const& typed_array, u32 length, u32 k, Direction direction, Value search_element, SearchEquality equality)
+{
+    using UnderlyingBufferDataType = Conditional<IsSame<ClampedU8, T>, u8, T>;
+
+    // Elements are either all Numbers or all BigInts, and neither equality holds between a Number and a BigInt.
+    if (typed_array.content_type() == TypedArrayBase::ContentType::BigInt ? !search_element.is_bigint() : !search_element.is_number())
+        return {};
+
+    auto search = [&](auto callback) -> Optional<u32> {
+        auto const& buffer = *typed_array.viewed_array_buffer();
+        return buffer.with_readonly_bytes(typed_array.byte_offset(), length * sizeof(UnderlyingBufferDataType), [&](ReadonlyBytes elements) -> Optional<u32> {
+            if (auto index = callback(elements); index.has_value())
+                return static_cast<u32>(*index);
+            return {};
+        });
+    };
+
+    if constexpr (IsFloatingPoint<UnderlyingBufferDataType>) {
+        if (search_element.is_nan()) {
+            // NaN is not strictly equal to anything, but it is the same value as every NaN, whatever its bits are.
+            if (equality == SearchEquality::IsStrictlyEqual)
+                return {};
+            VERIFY(direction == Direction::Ascending);
+            return search([&](ReadonlyBytes elements) { return TypedArrayKernels::find_first_nan<UnderlyingBufferDataType>(elements, k); });
+        }
+    }
+
+    // The search element can only be equal to an element if it survives being converted to the element type and back.
+    UnderlyingBufferDataType needle;
+    numeric_to_raw_bytes<T>(vm, search_element, true, { &needle, sizeof(needle) });
+    if (!same_value_zero(raw_bytes_to_numeric<T>(vm, { &needle, sizeof(needle) }, true), search_element))
+        return {};
+
+    if (direction == Direction::Ascending)
+        return search([&](ReadonlyBytes elements) { return TypedArrayKernels::find_first(elements, k, needle); });
+    return search([&](ReadonlyBytes elements) { return TypedArrayKernels::find_last(elements, k, needle); });
+}
+
+static Optional<u32> search_typed_array_elements(VM& vm, TypedArrayBase const& typed_array, u32 length, u32 k, Direction direction, Value search_element, SearchEquality equality)
+{
+    switch (typed_array.kind()) {
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type) \
+    case TypedArrayBase::Kind::ClassName:                                           \
+        return search_typed_array_elements<Type>(vm, typed_array, length, k, direction, search_element, equality);
+        JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+    }
+    VERIFY_NOT_REACHED();
+}
+
 // 23.2.3.16 %TypedArray%.prototype.includes ( searchElement [ , fromIndex ] ), https://tc39.es/ecma262/#sec-%typedarray%.prototype.includes
 JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::includes)
 {
@@ -953,6 +1018,12 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::includes)
         k = relative_k;
     }
 
+    // OPTIMIZATION: Compare the raw elements with the search element, rather than getting each of them as a Value.
+    if (typed_array_elements_are_in_bounds(*typed_array, length)) {
+        auto index = search_typed_array_elements(vm, *typed_array, length, k, Direction::Ascending, search_element, SearchEquality::SameValueZero);
+        return Value { index.has_value() };
+    }
+
     // 11. Repeat, while k < len,
     while (k < length) {
         // a. Let elementK be ! Get(O, ! ToString(𝔽(k))).
@@ -1026,6 +1097,14 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::index_of)
         k = relative_k;
     }
 
+    // OPTIMIZATION: Compare the raw elements with the search element, rather than getting each of them as a Value.
+    if (typed_array_elements_are_in_bounds(*typed_array, length)) {
+        auto index = search_typed_array_elements(vm, *typed_array, length, k, Direction::Ascending, search_element, SearchEquality::IsStrictlyEqual);
+        if (!index.has_value())
+            return Value { -1 };
+        return Value { *index };
+    }
+
     // 11. Repeat, while k < len,
     while (k < length) {
         // a. Let kPresent be ! HasProperty(O, ! ToString(𝔽(k))).
@@ -1167,6 +1246,14 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::last_index_of)
         k = relative_k;
     }
 
+    // OPTIMIZATION: Compare the raw elements with the search element, rather than getting each of them as a Value.
+    if (k >= 0 && typed_array_elements_are_in_bounds(*typed_array, length)) {
+        auto index = search_typed_array_elements(vm, *typed_array, length, k, Direction::Descending, search_element, SearchEquality::IsStrictlyEqual);
+        if (!index.has_value())
+            return Value { -1 };
+        return Value { *index };
+    }
+
     // 9. Repeat, while k ≥ 0,
     while (k >= 0) {
         // a. Let kPresent be ! HasProperty(O, ! ToString(𝔽(k))).
@@ -1395,6 +1482,30 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::reverse)
     // 3. Let len be TypedArrayLength(taRecord).
     auto length = typed_array_length(typed_array_record);
 
+    // OPTIMIZATION: Swap the raw elements, rather than getting and setting each of them as a Value. This keeps the bits
+    //               of NaN elements, which is one of the encodings that setting them may choose.
+    auto& buffer = *typed_array->viewed_array_buffer();
+    if (!buffer.is_shared_array_buffer()) {
+        if (auto elements = buffer.contiguous_bytes(typed_array->byte_offset(), length * typed_array->element_size()); elements.has_value()) {
+            switch (typed_array->element_size()) {
+            case 1:
+                TypedArrayKernels::reverse<u8>(*elements);
+                return typed_array;
+            case 2:
+                TypedArrayKernels::reverse<u16>(*elements);
+                return typed_array;
+            case 4:
+                TypedArrayKernels::reverse<u32>(*elements);
+                return typed_array;
+            case 8:
+                TypedArrayKernels::reverse<u64>(*elements);
+                return typed_array;
+            default:
+                VERIFY_NOT_REACHED();
+            }
+        }
+    }
+
     // 4. Let middle be floor(len / 2).
     auto middle = length / 2;
 
@@ -1429,6 +1540,52 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::reverse)
     return typed_array;
 }
 
+template<typename Source>
+static void convert_typed_array_elements(ReadonlyBytes source, Bytes target, TypedArrayBase::Kind target_kind, size_t count)
+{
+    using SourceElement = Conditional<IsSame<ClampedU8, Source>, u8, Source>;
+
+    switch (target_kind) {
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type)                                  \
+    case TypedArrayBase::Kind::ClassName:                                                                            \
+        if constexpr (TypedArrayKernels::IsBigIntElement<SourceElement> == TypedArrayKernels::IsBigIntElement<Type>) \
+            TypedArrayKernels::convert<SourceElement, Type>(source, target, count);                                  \
+        else                                                                                                         \
+            VERIFY_NOT_REACHED();                                                                                    \
+        return;
+        JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// Converts count elements of the source's type into elements of the target's type, as GetValueFromBuffer and
+// SetValueInBuffer would for each of them, but without a Value in between. The types must have the same content type,
+// and the buffers must not overlap. Returns false if the elements have to be converted by the generic steps instead.
+static bool fast_typed_array_convert(TypedArrayBase const& source, ArrayBuffer const& source_buffer, size_t source_byte_index, TypedArrayBase& target, size_t target_byte_index, size_t count)
+{
+    auto& target_buffer = *target.viewed_array_buffer();
+    if (source_buffer.is_shared_array_buffer() || target_buffer.is_shared_array_buffer())
+        return false;
+
+    auto target_bytes = target_buffer.contiguous_bytes(target_byte_index, count * target.element_size());
+    if (!target_bytes.has_value())
+        return false;
+
+    source_buffer.with_readonly_bytes(source_byte_index, count * source.element_size(), [&](ReadonlyBytes source_bytes) {
+        switch (source.kind()) {
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type)            \
+    case TypedArrayBase::Kind::ClassName:                                                      \
+        convert_typed_array_elements<Type>(source_bytes, *target_bytes, target.kind(), count); \
+        return;
+            JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+        }
+        VERIFY_NOT_REACHED();
+    });
+    return true;
+}
+
 // 23.2.3.26.1 SetTypedArrayFromTypedArray ( target, targetOffset, source ), https://tc39.es/ecma262/#sec-settypedarrayfromtypedarray
 static ThrowCompletionOr<void> set_typed_array_from_typed_array(VM& vm, TypedArrayBase& target, double target_offset, TypedArrayBase const& source)
 {
@@ -1544,7 +1701,9 @@ static ThrowCompletionOr<void> set_typed_array_from_typed_array(VM& vm, TypedArr
         source_buffer->copy_data_to(*target_buffer, source_byte_index, target_byte_index, limit - target_byte_index);
     }
     // 24. Else,
-    else {
+    // OPTIMIZATION: Convert the raw elements from one type into the other, unless they have to be converted through a
+    //               Value one at a time.
+    else if (!fast_typed_array_convert(source, *source_buffer, source_byte_index, target, target_byte_index, source_length)) {
         // a. Repeat, while targetByteIndex < limit,
         while (target_byte_index < limit) {
             // i. Let value be GetValueFromBuffer(srcBuffer, srcByteIndex, srcType, true, Unordered).
@@ -1802,6 +1961,18 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::slice)
         }
         // i. Else,
         else {
+            // OPTIMIZATION: Convert the raw elements from one type into the other, unless A views the same storage as
+            //               O, as the order in which the generic steps read and write elements is then observable.
+            auto array_record = make_typed_array_with_buffer_witness_record(*array, ArrayBuffer::Order::SeqCst);
+            auto& source_buffer = *typed_array->viewed_array_buffer();
+            if (count > 0
+                && !is_typed_array_out_of_bounds(array_record) && typed_array_length(array_record) >= static_cast<u32>(count)
+                && !array->viewed_array_buffer()->shares_storage_with(source_buffer)) {
+                auto source_byte_index = (static_cast<size_t>(k) * typed_array->element_size()) + typed_array->byte_offset();
+                if (fast_typed_array_convert(*typed_array, source_buffer, source_byte_index, *array, array->byte_offset(), count))
+                    return array;
+            }
+
             // i. Let n be 0.
             u32 n = 0;
 
@@ -1895,7 +2066,7 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::sort)
     };
 
     // 7. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, read-through-holes).
-    auto sorted_list = TRY(sort_indexed_properties(vm, *typed_array, length, sort_compare, Holes::ReadThroughHoles));
+    auto sorted_list = TRY(sort_indexed_properties(vm, *typed_array, length, sort_compare, Holes::ReadThroughHoles, compare_function.is_undefined() ? DefaultSortCompare::TypedArrayElements : DefaultSortCompare::None));
 
     // 8. Let j be 0.
     // 9. Repeat, while j < len,
@@ -2141,7 +2312,7 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::to_sorted)
     };
 
     // 8. Let sortedList be ? SortIndexedProperties(O, len, SortCompare, read-through-holes).
-    auto sorted_list = TRY(sort_indexed_properties(vm, *typed_array, length, sort_compare, Holes::ReadThroughHoles));
+    auto sorted_list = TRY(sort_indexed_properties(vm, *typed_array, length, sort_compare, Holes::ReadThroughHoles, compare_function.is_undefined() ? DefaultSortCompare::TypedArrayElements : DefaultSortCompare::None));
 
     // 9. Let j be 0.
     // 10. Repeat, while j < len,
@@ -82,14 +82,16 @@ VM::VM(ErrorMessages error_messages)
         gather_roots(roots);
     })
     , m_error_messages(move(error_messages))
+    , m_megamorphic_property_lookup_cache(make<Bytecode::MegamorphicPropertyLookupCache>())
 {
     s_the = this;
     MUST(GC::PrimitiveStorage::the().ensure_cage());
     m_primitive_storage_cage_base = js_primitive_storage_cage_base;
     VERIFY(m_primitive_storage_cage_base != 0);
 
-    m_heap.register_sweep_callback([] {
+    m_heap.register_sweep_callback([this] {
         Bytecode::StaticPropertyLookupCache::sweep_all();
+        m_megamorphic_property_lookup_cache->remove_dead_cells();
     });
 
     m_empty_string = m_heap.allocate<PrimitiveString>(Utf16String {});
@@ -126,6 +128,16 @@ VM::VM(ErrorMessages error_messages)
         enqueue_promise_job(job, realm);
     };
 
+    // 9.5.4 HostEnqueueGenericJob ( job, realm ), https://tc39.es/ecma262/#sec-hostenqueuegenericjob
+    host_enqueue_generic_job = [this](GC::Ref<GC::Function<void()>> job, Realm& realm) {
+        // NB: Generic jobs have no ordering requirements, so the default runs them along with the promise jobs.
+        enqueue_promise_job(GC::create_function(heap(), [job]() -> ThrowCompletionOr<Value> {
+            job->function()();
+            return js_undefined();
+        }),
+            &realm);
+    };
+
     host_promise_job_queue_is_empty = [this]() -> bool {
         return m_promise_jobs.is_empty();
     };
@@ -555,27 +567,33 @@ void VM::dump_backtrace() const
 
 void VM::save_execution_context_stack()
 {
+    will_change_execution_context_stack();
     m_saved_execution_context_stacks.append({
         .stack = move(m_execution_context_stack),
         .previous_running_contexts = move(m_execution_context_stack_previous_running_contexts),
         .running_execution_context = m_running_execution_context,
     });
     m_running_execution_context = nullptr;
+    did_change_execution_context_stack();
 }
 
 void VM::clear_execution_context_stack()
 {
+    will_change_execution_context_stack();
     m_execution_context_stack.clear_with_capacity();
     m_execution_context_stack_previous_running_contexts.clear_with_capacity();
     m_running_execution_context = nullptr;
+    did_change_execution_context_stack();
 }
 
 void VM::restore_execution_context_stack()
 {
     auto saved_stack = m_saved_execution_context_stacks.take_last();
+    will_change_execution_context_stack();
     m_execution_context_stack = move(saved_stack.stack);
     m_execution_context_stack_previous_running_contexts = move(saved_stack.previous_running_contexts);
     m_running_execution_context = saved_stack.running_execution_context;
+    did_change_execution_context_stack();
 }
 
 ExecutionContext* VM::previous_execution_context() const
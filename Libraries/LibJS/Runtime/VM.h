@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/FlyString.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
@@ -212,9 +213,11 @@ public:
         context.caller_return_pc = 0;
         context.caller_dst_raw = 0;
         context.caller_is_construct = false;
+        will_change_execution_context_stack();
         m_execution_context_stack.append(&context);
         m_execution_context_stack_previous_running_contexts.append(m_running_execution_context);
         m_running_execution_context = &context;
+        did_change_execution_context_stack();
         return {};
     }
 
@@ -224,20 +227,24 @@ public:
         context.caller_return_pc = 0;
         context.caller_dst_raw = 0;
         context.caller_is_construct = false;
+        will_change_execution_context_stack();
         m_execution_context_stack.append(&context);
         m_execution_context_stack_previous_running_contexts.append(m_running_execution_context);
         m_running_execution_context = &context;
+        did_change_execution_context_stack();
     }
 
     ExecutionContext* pop_execution_context()
     {
         VERIFY(!m_execution_context_stack.is_empty());
+        will_change_execution_context_stack();
         auto* context = m_execution_context_stack.take_last();
         context->caller_frame = nullptr;
         context->caller_return_pc = 0;
         context->caller_dst_raw = 0;
         context->caller_is_construct = false;
         m_running_execution_context = m_execution_context_stack_previous_running_contexts.take_last();
+        did_change_execution_context_stack();
         return context;
     }
 
@@ -275,6 +282,17 @@ public:
         for_each_execution_context_top_to_bottom(m_execution_context_stack, m_execution_context_stack_previous_running_contexts, m_running_execution_context, callback);
     }
 
+    // Safe to call from a signal handler that interrupted this VM's thread, e.g. a sampling profiler. Returns false
+    // without walking anything if the signal arrived while the stack was being modified.
+    template<typename Callback>
+    bool for_each_execution_context_top_to_bottom_from_signal_handler(Callback callback) const
+    {
+        if (m_execution_context_stack_is_changing)
+            return false;
+        for_each_execution_context_top_to_bottom(callback);
+        return true;
+    }
+
     template<typename Callback>
     Optional<ExecutionContext*> last_execution_context_matching(Callback callback)
     {
@@ -418,6 +436,8 @@ public:
     Agent* agent() { return m_agent; }
     Agent const* agent() const { return m_agent; }
 
+    Bytecode::MegamorphicPropertyLookupCache& megamorphic_property_lookup_cache() { return *m_megamorphic_property_lookup_cache; }
+
     void save_execution_context_stack();
     void clear_execution_context_stack();
     void restore_execution_context_stack();
@@ -438,6 +458,10 @@ public:
     Function<ThrowCompletionOr<Value>(JobCallback&, Value, ReadonlySpan<Value>)> host_call_job_callback;
     Function<void(FinalizationRegistry&)> host_enqueue_finalization_registry_cleanup_job;
     Function<void(GC::Ref<GC::Function<ThrowCompletionOr<Value>()>>, Realm*)> host_enqueue_promise_job;
+    Function<void(GC::Ref<GC::Function<void()>>, Realm&)> host_enqueue_generic_job;
+    // NB: LibJS has no timers of its own, so this is only set by hosts that have them. Without it, Atomics.waitAsync()
+    //     only supports waits that never time out.
+    Function<void(GC::Ref<GC::Function<void()>>, Realm&, double milliseconds)> host_enqueue_timeout_job;
     Function<GC::Ref<JobCallback>(FunctionObject&)> host_make_job_callback;
     Function<GC::Ptr<PrimitiveString>(Object const&)> host_get_code_for_eval;
     Function<ThrowCompletionOr<void>(Realm&, ReadonlySpan<Utf16String>, Utf16View, Utf16View, CompilationType, ReadonlySpan<Value>, Value)> host_ensure_can_compile_strings;
@@ -462,6 +486,29 @@ private:
 
     explicit VM(ErrorMessages);
 
+    ALWAYS_INLINE void will_change_execution_context_stack()
+    {
+        m_execution_context_stack_is_changing = true;
+        AK::atomic_signal_fence(AK::MemoryOrder::memory_order_seq_cst);
+    }
+
+    ALWAYS_INLINE void did_change_execution_context_stack()
+    {
+        AK::atomic_signal_fence(AK::MemoryOrder::memory_order_seq_cst);
+        m_execution_context_stack_is_changing = false;
+    }
+
+    // NB: The sampling profiler's signal handler walks the frames reachable from the running execution context, so a
+    //     frame must be fully set up before it is published here, and must stay readable until it has been replaced.
+    //     The fences keep the compiler from moving stores across the publication. The asm interpreter emits its
+    //     stores in program order, so it only has to publish last.
+    ALWAYS_INLINE void set_running_execution_context(ExecutionContext* context)
+    {
+        AK::atomic_signal_fence(AK::MemoryOrder::memory_order_seq_cst);
+        m_running_execution_context = context;
+        AK::atomic_signal_fence(AK::MemoryOrder::memory_order_seq_cst);
+    }
+
     template<typename Callback>
     static void for_each_execution_context_top_to_bottom(Vector<ExecutionContext*> const& execution_context_stack, Vector<ExecutionContext*> const& execution_context_stack_previous_running_contexts, ExecutionContext* running_execution_context, Callback callback)
     {
@@ -530,6 +577,7 @@ private:
     // walk the full active stack without relying on caller_frame there.
     Vector<ExecutionContext*> m_execution_context_stack_previous_running_contexts;
     ExecutionContext* m_running_execution_context { nullptr };
+    bool m_execution_context_stack_is_changing { false };
 
     Vector<SavedExecutionContextStack> m_saved_execution_context_stacks;
 
@@ -570,6 +618,8 @@ private:
 
     OwnPtr<Agent> m_agent;
 
+    NonnullOwnPtr<Bytecode::MegamorphicPropertyLookupCache> m_megamorphic_property_lookup_cache;
+
     bool m_dynamic_imports_allowed { false };
 };
 
@@ -8999,6 +8999,10 @@ const BUILTIN_STRING_ITERATOR_PROTOTYPE_NEXT: u8 = 20;
 const BUILTIN_STRING_FROM_CHAR_CODE: u8 = 21;
 const BUILTIN_STRING_PROTOTYPE_CHAR_CODE_AT: u8 = 22;
 const BUILTIN_STRING_PROTOTYPE_CHAR_AT: u8 = 23;
+const BUILTIN_MATH_MAX: u8 = 24;
+const BUILTIN_MATH_MIN: u8 = 25;
+const BUILTIN_NUMBER_IS_INTEGER: u8 = 26;
+const BUILTIN_ARRAY_PROTOTYPE_PUSH: u8 = 27;
 
 /// Detect known builtin methods from a callee expression (e.g. Math.abs).
 /// Returns the Builtin enum value as u8, matching Builtins.h ordering.
@@ -9019,6 +9023,9 @@ fn get_builtin(callee: &Expression, arena: &crate::ast::AstArena) -> Option<u8>
     if property_name == utf16!("charCodeAt") {
         return Some(BUILTIN_STRING_PROTOTYPE_CHAR_CODE_AT);
     }
+    if property_name == utf16!("push") {
+        return Some(BUILTIN_ARRAY_PROTOTYPE_PUSH);
+    }
     let ExpressionKind::Identifier(base_ident) = &member_data.object.inner else {
         return None;
     };
@@ -9075,6 +9082,9 @@ fn get_builtin(callee: &Expression, arena: &crate::ast::AstArena) -> Option<u8>
             BUILTIN_STRING_ITERATOR_PROTOTYPE_NEXT,
         ),
         (utf16!("String"), utf16!("fromCharCode"), BUILTIN_STRING_FROM_CHAR_CODE),
+        (utf16!("Math"), utf16!("max"), BUILTIN_MATH_MAX),
+        (utf16!("Math"), utf16!("min"), BUILTIN_MATH_MIN),
+        (utf16!("Number"), utf16!("isInteger"), BUILTIN_NUMBER_IS_INTEGER),
     ];
     for &(base, property, id) in BUILTINS {
         if base_name == base && property_name == property {
@@ -9111,6 +9121,10 @@ fn builtin_argument_count(builtin: u8) -> usize {
         BUILTIN_STRING_FROM_CHAR_CODE => 1,
         BUILTIN_STRING_PROTOTYPE_CHAR_CODE_AT => 1,
         BUILTIN_STRING_PROTOTYPE_CHAR_AT => 1,
+        BUILTIN_MATH_MAX => 2,
+        BUILTIN_MATH_MIN => 2,
+        BUILTIN_NUMBER_IS_INTEGER => 1,
+        BUILTIN_ARRAY_PROTOTYPE_PUSH => 1,
         _ => usize::MAX,
     }
 }
@@ -9207,6 +9221,12 @@ fn emit_builtin_call(
         BUILTIN_STRING_PROTOTYPE_CHAR_AT => {
             emit_unary_builtin_instruction!(CallBuiltinStringPrototypeCharAt);
         }
+        BUILTIN_MATH_MAX => emit_binary_builtin_instruction!(CallBuiltinMathMax),
+        BUILTIN_MATH_MIN => emit_binary_builtin_instruction!(CallBuiltinMathMin),
+        BUILTIN_NUMBER_IS_INTEGER => emit_unary_builtin_instruction!(CallBuiltinNumberIsInteger),
+        BUILTIN_ARRAY_PROTOTYPE_PUSH => {
+            emit_unary_builtin_instruction!(CallBuiltinArrayPrototypePush);
+        }
         _ => unreachable!(),
     }
 }
@@ -306,6 +306,9 @@ pub struct Generator {
     pub shared_function_data: Vec<PendingSharedFunctionData>,
     pub eager_compile_function_ids: HashSet<FunctionId>,
     pub eager_compile_direct_iifes: bool,
+    /// Whether `assemble()` runs the passes in `optimizer` first. Set for
+    /// executables that are compiled in the background.
+    pub optimize_bytecode: bool,
 
     // --- Class blueprints ---
     // Pending descriptors for ClassBlueprint objects. Ownership transfers to
@@ -474,6 +477,7 @@ impl Generator {
             shared_function_data: Vec::new(),
             eager_compile_function_ids: HashSet::new(),
             eager_compile_direct_iifes: false,
+            optimize_bytecode: false,
             class_blueprints: Vec::new(),
             length_identifier: None,
             current_unwind_handler: None,
@@ -1664,6 +1668,10 @@ impl Generator {
     /// 3. Patch labels in typed instructions (block index → byte offset)
     /// 4. Encode to bytes and build source map + exception handlers
     pub fn assemble(&mut self) -> AssembledBytecode {
+        if self.optimize_bytecode {
+            self.next_register = super::optimizer::optimize(&mut self.basic_blocks, self.next_register);
+        }
+
         let saved_environment = Operand::register(Register::SAVED_LEXICAL_ENVIRONMENT);
         let synthetic_load_block = self.basic_blocks.iter().position(|block| {
             matches!(
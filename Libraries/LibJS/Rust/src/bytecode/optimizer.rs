@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+//! Optimization passes over the basic blocks of a fully generated executable.
+//!
+//! These run at the start of `Generator::assemble()`, before operands are
+//! rewritten, but only for executables that are compiled in the background
+//! (for the bytecode cache, or speculatively ahead of their first call). On
+//! the main thread, getting to run the code sooner matters more than
+//! shaving a few instructions off of it.
+//!
+//! Every pass keeps the block and operand structure that the assembler
+//! expects, so the output goes through the same assembly-time optimizations
+//! and the same validation as unoptimized bytecode.
+
+use super::basic_block::BasicBlock;
+use super::instruction::Instruction;
+use super::operand::Label;
+use super::operand::Operand;
+use super::operand::Register;
+
+/// Run all passes. Returns the number of registers the executable needs
+/// afterwards, which is never more than `number_of_registers`.
+pub fn optimize(basic_blocks: &mut Vec<BasicBlock>, number_of_registers: u32) -> u32 {
+    thread_jumps(basic_blocks);
+    remove_unreachable_blocks(basic_blocks);
+    remove_dead_moves(basic_blocks, number_of_registers);
+    compact_registers(basic_blocks, number_of_registers)
+}
+
+/// Returns the block that a jump into `block_index` ends up in, skipping over
+/// blocks that do nothing but jump elsewhere.
+fn final_jump_target(basic_blocks: &[BasicBlock], block_index: usize) -> usize {
+    let mut target = block_index;
+    // NB: A chain of jump-only blocks can loop back onto itself (`for (;;) {}`),
+    //     so give up after visiting every block once.
+    for _ in 0..basic_blocks.len() {
+        match basic_blocks[target].instructions.as_slice() {
+            [(Instruction::Jump { target: next }, _, _)] if next.basic_block_index() != target => {
+                target = next.basic_block_index();
+            }
+            _ => return target,
+        }
+    }
+    block_index
+}
+
+/// Retarget jumps into blocks that only contain a `Jump` to where that jump goes.
+///
+/// The skipped blocks can't throw, so which exception handler covers them
+/// doesn't matter. They become unreachable if nothing else jumps to them.
+fn thread_jumps(basic_blocks: &mut [BasicBlock]) {
+    let final_targets: Vec<usize> = (0..basic_blocks.len())
+        .map(|block_index| final_jump_target(basic_blocks, block_index))
+        .collect();
+
+    for block in basic_blocks.iter_mut() {
+        for (instruction, _, _) in &mut block.instructions {
+            instruction.visit_labels(&mut |label: &mut Label| {
+                label.0 = u32::try_from(final_targets[label.basic_block_index()]).expect("block index fits in u32");
+            });
+
+            // OPTIMIZATION: ToBoolean has no side effects, so a JumpIf whose
+            //               targets are now the same is an unconditional jump.
+            if let Instruction::JumpIf {
+                true_target,
+                false_target,
+                ..
+            } = instruction
+                && true_target.0 == false_target.0
+            {
+                *instruction = Instruction::Jump { target: *true_target };
+            }
+        }
+    }
+}
+
+/// Remove blocks that can't be reached from the entry block, neither by a
+/// jump nor as an exception handler, and renumber the remaining ones.
+fn remove_unreachable_blocks(basic_blocks: &mut Vec<BasicBlock>) {
+    if basic_blocks.is_empty() {
+        return;
+    }
+
+    let mut reachable = vec![false; basic_blocks.len()];
+    let mut worklist = vec![0usize];
+    reachable[0] = true;
+    while let Some(block_index) = worklist.pop() {
+        let block = &basic_blocks[block_index];
+        let mut successors: Vec<usize> = block.handler.map(Label::basic_block_index).into_iter().collect();
+        for (instruction, _, _) in &block.instructions {
+            let mut instruction = instruction.clone();
+            instruction.visit_labels(&mut |label: &mut Label| successors.push(label.basic_block_index()));
+        }
+        for successor in successors {
+            if !reachable[successor] {
+                reachable[successor] = true;
+                worklist.push(successor);
+            }
+        }
+    }
+
+    if reachable.iter().all(|is_reachable| *is_reachable) {
+        return;
+    }
+
+    let mut new_indices = vec![u32::MAX; basic_blocks.len()];
+    let mut next_index = 0u32;
+    for (block_index, is_reachable) in reachable.iter().enumerate() {
+        if *is_reachable {
+            new_indices[block_index] = next_index;
+            next_index += 1;
+        }
+    }
+
+    let mut block_index = 0;
+    basic_blocks.retain(|_| {
+        let keep = reachable[block_index];
+        block_index += 1;
+        keep
+    });
+
+    for block in basic_blocks.iter_mut() {
+        block.index = new_indices[block.index as usize];
+        if let Some(handler) = &mut block.handler {
+            handler.0 = new_indices[handler.basic_block_index()];
+        }
+        for (instruction, _, _) in &mut block.instructions {
+            instruction.visit_labels(&mut |label: &mut Label| label.0 = new_indices[label.basic_block_index()]);
+        }
+    }
+}
+
+fn is_user_register(operand: Operand) -> bool {
+    operand.is_register() && operand.index() >= Register::RESERVED_COUNT
+}
+
+/// Count how many operands mention each register.
+fn count_register_mentions(basic_blocks: &[BasicBlock], number_of_registers: u32) -> Vec<u32> {
+    let mut mentions = vec![0u32; number_of_registers as usize];
+    for block in basic_blocks {
+        for (instruction, _, _) in &block.instructions {
+            let mut instruction = instruction.clone();
+            instruction.visit_operands(&mut |operand: &mut Operand| {
+                if operand.is_register() {
+                    mentions[operand.index() as usize] += 1;
+                }
+            });
+        }
+    }
+    mentions
+}
+
+/// Remove `Mov`s into registers that nothing ever reads.
+///
+/// Operands don't say whether they are read or written, so a register only
+/// counts as unread when the `Mov` is the only instruction that mentions it.
+/// Removing one `Mov` can leave the register it copied from unread as well,
+/// so this repeats until nothing changes.
+fn remove_dead_moves(basic_blocks: &mut [BasicBlock], number_of_registers: u32) {
+    loop {
+        let mentions = count_register_mentions(basic_blocks, number_of_registers);
+        let mut removed_any = false;
+        for block in basic_blocks.iter_mut() {
+            block.instructions.retain(|(instruction, _, _)| {
+                let is_dead = matches!(instruction, Instruction::Mov { dst, .. } if is_user_register(*dst) && mentions[dst.index() as usize] == 1);
+                removed_any |= is_dead;
+                !is_dead
+            });
+        }
+        if !removed_any {
+            return;
+        }
+    }
+}
+
+/// Renumber the user registers that are still mentioned so that they are
+/// contiguous, which shrinks the register file of every call frame.
+fn compact_registers(basic_blocks: &mut [BasicBlock], number_of_registers: u32) -> u32 {
+    let mentions = count_register_mentions(basic_blocks, number_of_registers);
+
+    let mut new_indices: Vec<u32> = (0..number_of_registers).collect();
+    let mut next_register = Register::RESERVED_COUNT;
+    for register in Register::RESERVED_COUNT..number_of_registers {
+        if mentions[register as usize] != 0 {
+            new_indices[register as usize] = next_register;
+            next_register += 1;
+        }
+    }
+
+    if next_register == number_of_registers {
+        return number_of_registers;
+    }
+
+    for block in basic_blocks.iter_mut() {
+        for (instruction, _, _) in &mut block.instructions {
+            instruction.visit_operands(&mut |operand: &mut Operand| {
+                if operand.is_register() {
+                    *operand = Operand::register(Register(new_indices[operand.index() as usize]));
+                }
+            });
+        }
+    }
+
+    next_register
+}
+
+#[cfg(test)]
+mod tests {
+    use super::super::basic_block::SourceMapEntry;
+    use super::*;
+
+    const NO_SOURCE: SourceMapEntry = SourceMapEntry {
+        bytecode_offset: 0,
+        line: 0,
+        column: 0,
+    };
+
+    fn block(index: u32, instructions: Vec<Instruction>) -> BasicBlock {
+        let mut block = BasicBlock::new(index);
+        for instruction in instructions {
+            block.append(instruction, NO_SOURCE, false);
+        }
+        block
+    }
+
+    fn register(index: u32) -> Operand {
+        Operand::register(Register(index))
+    }
+
+    fn jump_targets(block: &BasicBlock) -> Vec<u32> {
+        let mut targets = Vec::new();
+        for (instruction, _, _) in &block.instructions {
+            let mut instruction = instruction.clone();
+            instruction.visit_labels(&mut |label: &mut Label| targets.push(label.0));
+        }
+        targets
+    }
+
+    #[test]
+    fn threads_jumps_through_jump_only_blocks() {
+        let mut blocks = vec![
+            block(
+                0,
+                vec![Instruction::JumpIf {
+                    condition: register(5),
+                    true_target: Label(1),
+                    false_target: Label(3),
+                }],
+            ),
+            block(1, vec![Instruction::Jump { target: Label(2) }]),
+            block(2, vec![Instruction::Jump { target: Label(3) }]),
+            block(3, vec![Instruction::End { value: register(5) }]),
+        ];
+
+        thread_jumps(&mut blocks);
+        assert!(matches!(
+            blocks[0].instructions[0].0,
+            Instruction::Jump { target: Label(3) }
+        ));
+
+        remove_unreachable_blocks(&mut blocks);
+        assert_eq!(blocks.len(), 2);
+        assert_eq!(jump_targets(&blocks[0]), vec![1]);
+        assert_eq!(blocks[1].index, 1);
+    }
+
+    #[test]
+    fn leaves_loops_of_jump_only_blocks_alone() {
+        let mut blocks = vec![
+            block(0, vec![Instruction::Jump { target: Label(1) }]),
+            block(1, vec![Instruction::Jump { target: Label(2) }]),
+            block(2, vec![Instruction::Jump { target: Label(1) }]),
+        ];
+
+        thread_jumps(&mut blocks);
+        remove_unreachable_blocks(&mut blocks);
+        assert_eq!(blocks.len(), 3);
+    }
+
+    #[test]
+    fn keeps_exception_handlers_reachable() {
+        let mut blocks = vec![
+            block(0, vec![Instruction::Jump { target: Label(2) }]),
+            block(1, vec![Instruction::End { value: register(5) }]),
+            block(2, vec![Instruction::End { value: register(1) }]),
+            block(3, vec![Instruction::End { value: register(6) }]),
+        ];
+        blocks[2].handler = Some(Label(3));
+
+        remove_unreachable_blocks(&mut blocks);
+        assert_eq!(blocks.len(), 3);
+        assert_eq!(jump_targets(&blocks[0]), vec![1]);
+        assert_eq!(blocks[1].handler.map(|label| label.0), Some(2));
+    }
+
+    #[test]
+    fn removes_unread_moves_and_compacts_registers() {
+        let mut blocks = vec![block(
+            0,
+            vec![
+                Instruction::Mov {
+                    dst: register(6),
+                    src: register(8),
+                },
+                Instruction::Mov {
+                    dst: register(7),
+                    src: register(6),
+                },
+                Instruction::Mov {
+                    dst: register(9),
+                    src: Operand::constant(0),
+                },
+                Instruction::Mov {
+                    dst: register(3),
+                    src: Operand::constant(0),
+                },
+                Instruction::End { value: register(9) },
+            ],
+        )];
+
+        let number_of_registers = optimize(&mut blocks, 10);
+        assert_eq!(number_of_registers, Register::RESERVED_COUNT + 1);
+        assert_eq!(blocks[0].instructions.len(), 3);
+        assert!(matches!(
+            blocks[0].instructions[0].0,
+            Instruction::Mov { dst, .. } if dst == register(5)
+        ));
+        assert!(matches!(
+            blocks[0].instructions[1].0,
+            Instruction::Mov { dst, .. } if dst == register(3)
+        ));
+        assert!(matches!(
+            blocks[0].instructions[2].0,
+            Instruction::End { value } if value == register(5)
+        ));
+    }
+}
@@ -736,6 +736,7 @@ fn compile_parsed_program_off_thread_impl(
                 let mut generator = new_module_async_generator(source_len, std::mem::take(&mut parsed.function_table));
                 generator.arena = arena_arc;
                 generator.eager_compile_direct_iifes = true;
+                generator.optimize_bytecode = function_precompile_mode == FunctionPrecompileMode::All;
                 let assembled = compile_module_as_async_to_bytecode(&parsed.program, parsed.scope_ref, &mut generator);
                 let declaration_functions = precompile_declaration_functions(
                     parsed.program_type,
@@ -757,6 +758,7 @@ fn compile_parsed_program_off_thread_impl(
                 );
                 generator.arena = arena_arc;
                 generator.eager_compile_direct_iifes = true;
+                generator.optimize_bytecode = function_precompile_mode == FunctionPrecompileMode::All;
                 generator.function_table = std::mem::take(&mut parsed.function_table);
                 let assembled = compile_program_body_to_bytecode(&mut generator, &parsed.program, parsed.scope_ref);
                 let declaration_functions = precompile_declaration_functions(
@@ -3182,6 +3184,7 @@ fn compile_function_payload_to_bytecode(
     generator.function_table = payload.function_table;
     generator.source_len = source_len;
     generator.enclosing_function_kind = function_data.kind;
+    generator.optimize_bytecode = precompile_mode == FunctionPrecompileMode::All;
 
     if let Some(scope_id) = body_scope {
         let arena_clone = generator.arena.clone();
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/SIMDExtras.h>
+#include <AK/Span.h>
+
+// These run for every sample that is played, so they process four samples at a time.
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace Audio {
+
+// Adds each sample of source onto the sample at the same index in destination.
+inline void add_samples(Span<float> destination, ReadonlySpan<float> source)
+{
+    using AK::SIMD::f32x4;
+
+    VERIFY(destination.size() == source.size());
+    auto* destination_data = destination.data();
+    auto const* source_data = source.data();
+
+    size_t index = 0;
+    for (; index + 4 <= source.size(); index += 4) {
+        auto sum = AK::SIMD::load_unaligned<f32x4>(destination_data + index) + AK::SIMD::load_unaligned<f32x4>(source_data + index);
+        AK::SIMD::store_unaligned(destination_data + index, sum);
+    }
+    for (; index < source.size(); ++index)
+        destination_data[index] += source_data[index];
+}
+
+// Writes the samples of a stereo pair of channels into destination as left/right pairs.
+inline void interleave_stereo(Span<float> destination, ReadonlySpan<float> left, ReadonlySpan<float> right)
+{
+    using AK::SIMD::f32x4;
+
+    VERIFY(left.size() == right.size());
+    VERIFY(destination.size() >= left.size() * 2);
+    auto* destination_data = destination.data();
+
+    size_t frame = 0;
+    for (; frame + 4 <= left.size(); frame += 4) {
+        auto left_samples = AK::SIMD::load_unaligned<f32x4>(left.data() + frame);
+        auto right_samples = AK::SIMD::load_unaligned<f32x4>(right.data() + frame);
+        f32x4 first_pairs = __builtin_shufflevector(left_samples, right_samples, 0, 4, 1, 5);
+        f32x4 second_pairs = __builtin_shufflevector(left_samples, right_samples, 2, 6, 3, 7);
+        AK::SIMD::store_unaligned(destination_data + (frame * 2), first_pairs);
+        AK::SIMD::store_unaligned(destination_data + (frame * 2) + 4, second_pairs);
+    }
+    for (; frame < left.size(); ++frame) {
+        destination_data[frame * 2] = left[frame];
+        destination_data[(frame * 2) + 1] = right[frame];
+    }
+}
+
+// Splits left/right pairs of samples from source into a stereo pair of channels.
+inline void deinterleave_stereo(Span<float> left, Span<float> right, ReadonlySpan<float> source)
+{
+    using AK::SIMD::f32x4;
+
+    VERIFY(left.size() == right.size());
+    VERIFY(source.size() >= left.size() * 2);
+    auto const* source_data = source.data();
+
+    size_t frame = 0;
+    for (; frame + 4 <= left.size(); frame += 4) {
+        auto first_pairs = AK::SIMD::load_unaligned<f32x4>(source_data + (frame * 2));
+        auto second_pairs = AK::SIMD::load_unaligned<f32x4>(source_data + (frame * 2) + 4);
+        f32x4 left_samples = __builtin_shufflevector(first_pairs, second_pairs, 0, 2, 4, 6);
+        f32x4 right_samples = __builtin_shufflevector(first_pairs, second_pairs, 1, 3, 5, 7);
+        AK::SIMD::store_unaligned(left.data() + frame, left_samples);
+        AK::SIMD::store_unaligned(right.data() + frame, right_samples);
+    }
+    for (; frame < left.size(); ++frame) {
+        left[frame] = source_data[frame * 2];
+        right[frame] = source_data[(frame * 2) + 1];
+    }
+}
+
+}
+
+#pragma GCC diagnostic pop
@@ -10,6 +10,7 @@
 #include <AK/FixedArray.h>
 #include <AK/Math.h>
 #include <AK/NumericLimits.h>
+#include <LibMedia/Audio/SampleKernels.h>
 #include <LibMedia/Audio/SampleSpecification.h>
 #include <LibMedia/AudioBlockTiming.h>
 
@@ -87,6 +88,10 @@ public:
             return 0;
 
         auto frames_to_copy = min(destination.size() / channels, available_frames - source_frame_offset);
+        if (channels == 2) {
+            Audio::interleave_stereo(destination, channel_data(0).slice(source_frame_offset, frames_to_copy), channel_data(1).slice(source_frame_offset, frames_to_copy));
+            return frames_to_copy * channels;
+        }
         for (size_t channel = 0; channel < channels; channel++) {
             auto source_channel = channel_data(channel).slice(source_frame_offset, frames_to_copy);
             for (size_t frame = 0; frame < frames_to_copy; frame++)
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibMedia/Containers/Matroska/KeyframeIndex.h>
+
+namespace Media::Matroska {
+
+void KeyframeIndex::add(u64 track_number, IndexEntry entry)
+{
+    Sync::MutexLocker locker(m_mutex);
+    auto& entries = m_entries.ensure(track_number);
+
+    // Blocks are mostly read in order, so the entry usually goes at the end.
+    if (entries.is_empty() || entries.last().timestamp < entry.timestamp) {
+        entries.append(entry);
+        return;
+    }
+
+    size_t low = 0;
+    size_t high = entries.size();
+    while (low < high) {
+        auto middle = low + ((high - low) / 2);
+        if (entries[middle].timestamp < entry.timestamp)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (entries[low].timestamp == entry.timestamp)
+        return;
+    entries.insert(low, entry);
+}
+
+Optional<IndexEntry> KeyframeIndex::find_at_or_before(u64 track_number, AK::Duration timestamp) const
+{
+    Sync::MutexLocker locker(m_mutex);
+    auto entries = m_entries.get(track_number);
+    if (!entries.has_value() || entries->is_empty() || entries->first().timestamp > timestamp)
+        return {};
+
+    size_t low = 0;
+    size_t high = entries->size();
+    while (high - low > 1) {
+        auto middle = low + ((high - low) / 2);
+        if (entries->at(middle).timestamp <= timestamp)
+            low = middle;
+        else
+            high = middle;
+    }
+    return entries->at(low);
+}
+
+}
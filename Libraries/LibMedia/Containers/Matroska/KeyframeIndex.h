@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibMedia/Containers/IndexEntry.h>
+#include <LibSync/Mutex.h>
+
+namespace Media::Matroska {
+
+// The clusters that sample iterators have found a track's keyframes in, for seeking in files without Cues. Entries
+// are added as the buffered ranges are scanned and as blocks are demuxed, so the index grows while the file downloads.
+// The index may be used from any thread.
+class KeyframeIndex final : public AtomicRefCounted<KeyframeIndex> {
+public:
+    // The position is that of the cluster containing the keyframe, relative to the segment's contents.
+    void add(u64 track_number, IndexEntry);
+    Optional<IndexEntry> find_at_or_before(u64 track_number, AK::Duration timestamp) const;
+
+private:
+    mutable Sync::Mutex m_mutex;
+
+    // The vectors are sorted by timestamp.
+    HashMap<u64, Vector<IndexEntry>> m_entries;
+};
+
+}
@@ -902,7 +902,7 @@ DecoderErrorOr<SampleIterator> Reader::create_sample_iterator_at_byte_position(N
         for (auto const& [number, track_entry] : m_tracks)
             track_contexts.set(number, TrackBlockContext::from_track_entry(*track_entry));
     }
-    return SampleIterator(cursor, track_number, move(track_contexts), m_segment_information.timestamp_scale(), m_segment_contents_position, cluster_position.value());
+    return SampleIterator(cursor, track_number, move(track_contexts), m_segment_information.timestamp_scale(), m_segment_contents_position, cluster_position.value(), m_keyframe_index);
 }
 
 static DecoderErrorOr<CueTrackPosition> parse_cue_track_position(Streamer& streamer)
@@ -1128,6 +1128,10 @@ DecoderErrorOr<SampleIterator> Reader::seek_to_random_access_point(SampleIterato
     if (cue_points.has_value()) {
         TRY(seek_to_cue_for_timestamp(iterator, timestamp, cue_points.value(), seek_target));
         VERIFY(iterator.last_timestamp().has_value());
+    } else if (auto indexed_keyframe = m_keyframe_index->find_at_or_before(track_number, timestamp); indexed_keyframe.has_value()) {
+        // Without Cues, jump to the latest keyframe we've come across so that only the rest of the way is scanned.
+        TRY(iterator.seek_to_cluster(indexed_keyframe->position));
+        VERIFY(iterator.last_timestamp().has_value());
     }
 
     if (!iterator.last_timestamp().has_value() || timestamp < iterator.last_timestamp().value()) {
@@ -18,6 +18,7 @@
 #include <LibMedia/TimeRanges.h>
 
 #include "Document.h"
+#include "KeyframeIndex.h"
 #include "SampleIterator.h"
 #include "Streamer.h"
 
@@ -99,6 +100,9 @@ private:
     // The vectors must be sorted by timestamp at all times.
     HashMap<u64, Vector<TrackCuePoint>> m_cues;
 
+    // Shared with all sample iterators, which fill it in for seeking in files without Cues.
+    NonnullRefPtr<KeyframeIndex> m_keyframe_index { adopt_ref(*new KeyframeIndex) };
+
     struct BufferedRange {
         size_t start { 0 };
         size_t end { 0 };
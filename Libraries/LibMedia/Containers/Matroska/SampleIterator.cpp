@@ -12,13 +12,14 @@
 
 namespace Media::Matroska {
 
-SampleIterator::SampleIterator(NonnullRefPtr<MediaStreamCursor> const& stream_cursor, Optional<u64> track_number, TrackBlockContexts&& track_contexts, u64 timestamp_scale, size_t segment_contents_position, size_t position)
+SampleIterator::SampleIterator(NonnullRefPtr<MediaStreamCursor> const& stream_cursor, Optional<u64> track_number, TrackBlockContexts&& track_contexts, u64 timestamp_scale, size_t segment_contents_position, size_t position, NonnullRefPtr<KeyframeIndex> keyframe_index)
     : m_stream_cursor(stream_cursor)
     , m_track_number(track_number)
     , m_track_block_contexts(move(track_contexts))
     , m_segment_timestamp_scale(timestamp_scale)
     , m_segment_contents_position(segment_contents_position)
     , m_position(position)
+    , m_keyframe_index(move(keyframe_index))
 {
 }
 
@@ -32,15 +33,12 @@ DecoderErrorOr<Block> SampleIterator::next_block()
     Optional<Block> block;
 
     while (true) {
-#if MATROSKA_TRACE_DEBUG
         auto element_position = streamer.position();
-#endif
         auto element_id = TRY(streamer.read_element_id());
-#if MATROSKA_TRACE_DEBUG
-        dbgln("Iterator found element with ID {:#010x} at offset {} within the segment.", element_id, element_position);
-#endif
+        dbgln_if(MATROSKA_TRACE_DEBUG, "Iterator found element with ID {:#010x} at offset {} within the segment.", element_id, element_position);
 
         auto maybe_set_block = [&](Block&& candidate_block) {
+            add_to_keyframe_index(candidate_block);
             if (m_track_number.has_value() && candidate_block.track_number() != m_track_number)
                 return;
             block = move(candidate_block);
@@ -48,7 +46,7 @@ DecoderErrorOr<Block> SampleIterator::next_block()
 
         if (element_id == CLUSTER_ELEMENT_ID) {
             dbgln_if(MATROSKA_DEBUG, "  Iterator is parsing new cluster.");
-            m_current_cluster = TRY(Reader::parse_cluster_element(streamer, m_segment_timestamp_scale));
+            set_current_cluster(TRY(Reader::parse_cluster_element(streamer, m_segment_timestamp_scale)), element_position - m_segment_contents_position);
         } else if (element_id == SIMPLE_BLOCK_ID) {
             if (!m_current_cluster.has_value()) {
                 dbgln("  Iterator encountered a simple block before parsing a Cluster.");
@@ -160,18 +158,51 @@ DecoderErrorOr<Vector<ByteBuffer>> SampleIterator::get_frames(Block block)
     return frames;
 }
 
-DecoderErrorOr<void> SampleIterator::seek_to_cue_point(TrackCuePoint const& cue_point, CuePointTarget target)
+void SampleIterator::set_current_cluster(Cluster cluster, size_t cluster_position)
+{
+    m_current_cluster = move(cluster);
+    m_current_cluster_position = cluster_position;
+    m_tracks_indexed_in_current_cluster.clear_with_capacity();
+}
+
+void SampleIterator::add_to_keyframe_index(Block const& block)
+{
+    // Indexing the first keyframe of each track in a cluster is enough to seek to that cluster and scan from there.
+    if (!block.only_keyframes() || !block.timestamp().has_value())
+        return;
+    if (m_tracks_indexed_in_current_cluster.set(block.track_number()) != HashSetResult::InsertedNewEntry)
+        return;
+    m_keyframe_index->add(block.track_number(), { .position = m_current_cluster_position, .timestamp = block.timestamp().value() });
+}
+
+DecoderErrorOr<Streamer> SampleIterator::read_cluster_at(size_t cluster_position)
 {
-    // This is a private function. The position getter can return optional, but the caller should already know that this track has a position.
-    auto const& cue_position = cue_point.position;
     Streamer streamer { m_stream_cursor };
-    TRY(streamer.seek_to_position(m_segment_contents_position + cue_position.cluster_position()));
+    TRY(streamer.seek_to_position(m_segment_contents_position + cluster_position));
 
     auto element_id = TRY(streamer.read_element_id());
     if (element_id != CLUSTER_ELEMENT_ID)
-        return DecoderError::corrupted("Cue point's cluster position didn't point to a cluster"sv);
+        return DecoderError::corrupted("Seek target didn't point to a cluster"sv);
+
+    set_current_cluster(TRY(Reader::parse_cluster_element(streamer, m_segment_timestamp_scale)), cluster_position);
+    return streamer;
+}
+
+DecoderErrorOr<void> SampleIterator::seek_to_cluster(size_t cluster_position)
+{
+    auto streamer = TRY(read_cluster_at(cluster_position));
+    dbgln_if(MATROSKA_DEBUG, "SampleIterator set to indexed cluster at timestamp {}ms", m_current_cluster->timestamp().to_milliseconds());
+
+    m_position = streamer.position();
+    m_last_timestamp = m_current_cluster->timestamp();
+    return {};
+}
 
-    m_current_cluster = TRY(Reader::parse_cluster_element(streamer, m_segment_timestamp_scale));
+DecoderErrorOr<void> SampleIterator::seek_to_cue_point(TrackCuePoint const& cue_point, CuePointTarget target)
+{
+    // This is a private function. The position getter can return optional, but the caller should already know that this track has a position.
+    auto const& cue_position = cue_point.position;
+    auto streamer = TRY(read_cluster_at(cue_position.cluster_position()));
     dbgln_if(MATROSKA_DEBUG, "SampleIterator set to cue point at timestamp {}ms", m_current_cluster->timestamp().to_milliseconds());
 
     if (target == CuePointTarget::Cluster) {
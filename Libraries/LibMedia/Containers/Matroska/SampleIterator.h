@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/HashTable.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
 #include <LibMedia/DecoderError.h>
@@ -14,6 +15,7 @@
 #include <LibMedia/Forward.h>
 
 #include "Document.h"
+#include "KeyframeIndex.h"
 
 namespace Media::Matroska {
 
@@ -46,9 +48,14 @@ public:
 private:
     friend class Reader;
 
-    SampleIterator(NonnullRefPtr<MediaStreamCursor> const& stream_cursor, Optional<u64> track_number, TrackBlockContexts&&, u64 timestamp_scale, size_t segment_contents_position, size_t position);
+    SampleIterator(NonnullRefPtr<MediaStreamCursor> const& stream_cursor, Optional<u64> track_number, TrackBlockContexts&&, u64 timestamp_scale, size_t segment_contents_position, size_t position, NonnullRefPtr<KeyframeIndex>);
 
     DecoderErrorOr<void> seek_to_cue_point(TrackCuePoint const& cue_point, CuePointTarget);
+    DecoderErrorOr<void> seek_to_cluster(size_t cluster_position);
+    DecoderErrorOr<Streamer> read_cluster_at(size_t cluster_position);
+
+    void set_current_cluster(Cluster, size_t cluster_position);
+    void add_to_keyframe_index(Block const&);
 
     NonnullRefPtr<MediaStreamCursor> m_stream_cursor;
     Optional<u64> m_track_number;
@@ -62,6 +69,10 @@ private:
     Optional<AK::Duration> m_last_timestamp;
 
     Optional<Cluster> m_current_cluster;
+    size_t m_current_cluster_position { 0 };
+
+    NonnullRefPtr<KeyframeIndex> m_keyframe_index;
+    HashTable<u64> m_tracks_indexed_in_current_cluster;
 };
 
 }
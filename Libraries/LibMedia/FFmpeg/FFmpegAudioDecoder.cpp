@@ -5,6 +5,7 @@
  */
 
 #include <LibCore/System.h>
+#include <LibMedia/Audio/SampleKernels.h>
 #include <LibMedia/AudioBlock.h>
 #include <LibMedia/FFmpeg/FFmpegHelpers.h>
 
@@ -152,6 +153,19 @@ static float float_sample_from_frame_data(u8** data, size_t plane, size_t index)
     return pointer[index];
 }
 
+template<typename T>
+static void convert_channel_samples(AVFrame const& frame, Span<float> destination, size_t channel, size_t channel_count, bool is_planar)
+{
+    size_t plane = is_planar ? channel : 0;
+    size_t first_index = is_planar ? 0 : channel;
+    size_t stride = is_planar ? 1 : channel_count;
+
+    // NB: The format is selected once per channel so that this loop can be vectorized.
+    auto* destination_data = destination.data();
+    for (size_t frame_index = 0; frame_index < destination.size(); ++frame_index)
+        destination_data[frame_index] = float_sample_from_frame_data<T>(frame.extended_data, plane, first_index + (frame_index * stride));
+}
+
 DecoderErrorOr<void> FFmpegAudioDecoder::write_next_block(AudioBlock& block)
 {
     auto result = avcodec_receive_frame(m_codec_context, m_frame);
@@ -204,35 +218,41 @@ DecoderErrorOr<void> FFmpegAudioDecoder::write_next_block(AudioBlock& block)
         else
             VERIFY(static_cast<size_t>(m_frame->linesize[0]) >= sample_count * sample_size);
 
+        // Most decoders produce float samples, which only need to be copied or split into their channels.
+        if (planar_format == AV_SAMPLE_FMT_FLTP && is_planar) {
+            for (size_t channel = 0; channel < channel_count; ++channel)
+                ReadonlyBytes { m_frame->extended_data[channel], frame_count * sizeof(float) }.copy_to(block.channel_data(channel).reinterpret<u8>());
+            return {};
+        }
+        if (planar_format == AV_SAMPLE_FMT_FLTP && channel_count == 2) {
+            auto samples = ReadonlySpan<float> { reinterpret_cast<float const*>(m_frame->extended_data[0]), sample_count };
+            Audio::deinterleave_stereo(block.channel_data(0), block.channel_data(1), samples);
+            return {};
+        }
+
         for (size_t channel = 0; channel < channel_count; ++channel) {
             auto channel_data = block.channel_data(channel);
-            for (size_t frame = 0; frame < frame_count; ++frame) {
-                size_t plane = 0;
-                size_t index_in_plane = (frame * channel_count) + channel;
-                if (is_planar) {
-                    plane = channel;
-                    index_in_plane = frame;
-                }
-
-                auto float_sample = [&] {
-                    switch (planar_format) {
-                    case AV_SAMPLE_FMT_U8P:
-                        return float_sample_from_frame_data<u8>(m_frame->extended_data, plane, index_in_plane);
-                    case AV_SAMPLE_FMT_S16P:
-                        return float_sample_from_frame_data<i16>(m_frame->extended_data, plane, index_in_plane);
-                    case AV_SAMPLE_FMT_S32P:
-                        return float_sample_from_frame_data<i32>(m_frame->extended_data, plane, index_in_plane);
-                    case AV_SAMPLE_FMT_FLTP:
-                        return float_sample_from_frame_data<float>(m_frame->extended_data, plane, index_in_plane);
-                    case AV_SAMPLE_FMT_DBLP:
-                        return float_sample_from_frame_data<double>(m_frame->extended_data, plane, index_in_plane);
-                    case AV_SAMPLE_FMT_S64P:
-                        return float_sample_from_frame_data<i64>(m_frame->extended_data, plane, index_in_plane);
-                    default:
-                        VERIFY_NOT_REACHED();
-                    }
-                }();
-                channel_data[frame] = float_sample;
+            switch (planar_format) {
+            case AV_SAMPLE_FMT_U8P:
+                convert_channel_samples<u8>(*m_frame, channel_data, channel, channel_count, is_planar);
+                break;
+            case AV_SAMPLE_FMT_S16P:
+                convert_channel_samples<i16>(*m_frame, channel_data, channel, channel_count, is_planar);
+                break;
+            case AV_SAMPLE_FMT_S32P:
+                convert_channel_samples<i32>(*m_frame, channel_data, channel, channel_count, is_planar);
+                break;
+            case AV_SAMPLE_FMT_FLTP:
+                convert_channel_samples<float>(*m_frame, channel_data, channel, channel_count, is_planar);
+                break;
+            case AV_SAMPLE_FMT_DBLP:
+                convert_channel_samples<double>(*m_frame, channel_data, channel, channel_count, is_planar);
+                break;
+            case AV_SAMPLE_FMT_S64P:
+                convert_channel_samples<i64>(*m_frame, channel_data, channel, channel_count, is_planar);
+                break;
+            default:
+                VERIFY_NOT_REACHED();
             }
         }
 
@@ -12,43 +12,134 @@
 #include "FFmpegHelpers.h"
 #include "FFmpegVideoDecoder.h"
 
+extern "C" {
+#include <libavutil/hwcontext.h>
+}
+
 namespace Media::FFmpeg {
 
-static AVPixelFormat negotiate_output_format(AVCodecContext*, AVPixelFormat const* formats)
+bool FFmpegVideoDecoder::s_hardware_acceleration_enabled = false;
+
+// The device types to try, in order of preference.
+#if defined(AK_OS_MACOS)
+static constexpr Array hardware_device_types { AV_HWDEVICE_TYPE_VIDEOTOOLBOX };
+#elif defined(AK_OS_WINDOWS)
+static constexpr Array hardware_device_types { AV_HWDEVICE_TYPE_D3D11VA };
+#elif defined(AK_OS_LINUX) || defined(AK_OS_BSD_GENERIC)
+static constexpr Array hardware_device_types { AV_HWDEVICE_TYPE_VAAPI, AV_HWDEVICE_TYPE_VULKAN };
+#else
+static constexpr Array<AVHWDeviceType, 0> hardware_device_types {};
+#endif
+
+static AVPixelFormat hardware_pixel_format(AVCodec const* codec, AVHWDeviceType device_type)
+{
+    for (int i = 0;; ++i) {
+        auto const* config = avcodec_get_hw_config(codec, i);
+        if (!config)
+            return AV_PIX_FMT_NONE;
+        if (config->device_type == device_type && (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) != 0)
+            return config->pix_fmt;
+    }
+}
+
+static AVPixelFormat hardware_pixel_format(AVCodecContext const* codec_context)
+{
+    if (!codec_context->hw_device_ctx)
+        return AV_PIX_FMT_NONE;
+    auto const* device_context = reinterpret_cast<AVHWDeviceContext const*>(codec_context->hw_device_ctx->data);
+    return hardware_pixel_format(codec_context->codec, device_context->type);
+}
+
+static void set_up_hardware_device(AVCodecContext* codec_context, AVCodec const* codec)
+{
+    for (auto device_type : hardware_device_types) {
+        if (hardware_pixel_format(codec, device_type) == AV_PIX_FMT_NONE)
+            continue;
+
+        AVBufferRef* device_context = nullptr;
+        if (av_hwdevice_ctx_create(&device_context, device_type, nullptr, nullptr, 0) < 0)
+            continue;
+
+        // NB: The codec context takes over this reference and releases it in avcodec_free_context().
+        codec_context->hw_device_ctx = device_context;
+        return;
+    }
+}
+
+static bool is_supported_planar_format(int format)
+{
+    switch (format) {
+    case AV_PIX_FMT_YUV420P:
+    case AV_PIX_FMT_YUV420P10:
+    case AV_PIX_FMT_YUV420P12:
+    case AV_PIX_FMT_YUV422P:
+    case AV_PIX_FMT_YUV422P10:
+    case AV_PIX_FMT_YUV422P12:
+    case AV_PIX_FMT_YUV444P:
+    case AV_PIX_FMT_YUV444P10:
+    case AV_PIX_FMT_YUV444P12:
+    case AV_PIX_FMT_YUVJ420P:
+    case AV_PIX_FMT_YUVJ422P:
+    case AV_PIX_FMT_YUVJ444P:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static AVPixelFormat negotiate_output_format(AVCodecContext* codec_context, AVPixelFormat const* formats)
 {
+    // NB: If the hardware can't decode this stream after all (e.g. an unsupported profile), FFmpeg removes its format
+    //     from the list and asks again, so we end up with a software format below.
+    if (auto hardware_format = hardware_pixel_format(codec_context); hardware_format != AV_PIX_FMT_NONE) {
+        for (auto const* format = formats; *format >= 0; ++format) {
+            if (*format == hardware_format)
+                return hardware_format;
+        }
+    }
+
     while (*formats >= 0) {
-        switch (*formats) {
-        case AV_PIX_FMT_YUV420P:
-        case AV_PIX_FMT_YUV420P10:
-        case AV_PIX_FMT_YUV420P12:
-        case AV_PIX_FMT_YUV422P:
-        case AV_PIX_FMT_YUV422P10:
-        case AV_PIX_FMT_YUV422P12:
-        case AV_PIX_FMT_YUV444P:
-        case AV_PIX_FMT_YUV444P10:
-        case AV_PIX_FMT_YUV444P12:
-        case AV_PIX_FMT_YUVJ420P:
-        case AV_PIX_FMT_YUVJ422P:
-        case AV_PIX_FMT_YUVJ444P:
+        if (is_supported_planar_format(*formats))
             return *formats;
-        default:
-            break;
-        }
         formats++;
     }
     return AV_PIX_FMT_NONE;
 }
 
-DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create(CodecID codec_id, ReadonlyBytes codec_initialization_data)
+// NV12 and P010 keep U and V interleaved in a single plane. This is what hardware decoders download frames as.
+static bool is_semi_planar_format(int format)
+{
+    return format == AV_PIX_FMT_NV12 || format == AV_PIX_FMT_P010;
+}
+
+// P010 stores its 10 bits in the high bits of each sample, so samples are shifted down to match YUV420P10.
+template<typename T>
+static void copy_semi_planar_frame(AVFrame const& frame, Gfx::YUVData& yuv_data, Gfx::Size<size_t> y_plane_size, Gfx::Size<size_t> uv_plane_size, u8 shift)
+{
+    auto* y = reinterpret_cast<T*>(yuv_data.y_data().data());
+    for (size_t row = 0; row < y_plane_size.height(); ++row) {
+        auto const* source = reinterpret_cast<T const*>(frame.data[0] + row * frame.linesize[0]);
+        for (size_t column = 0; column < y_plane_size.width(); ++column)
+            *y++ = source[column] >> shift;
+    }
+
+    auto* u = reinterpret_cast<T*>(yuv_data.u_data().data());
+    auto* v = reinterpret_cast<T*>(yuv_data.v_data().data());
+    for (size_t row = 0; row < uv_plane_size.height(); ++row) {
+        auto const* source = reinterpret_cast<T const*>(frame.data[1] + row * frame.linesize[1]);
+        for (size_t column = 0; column < uv_plane_size.width(); ++column) {
+            *u++ = source[column * 2] >> shift;
+            *v++ = source[column * 2 + 1] >> shift;
+        }
+    }
+}
+
+DecoderErrorOr<AVCodecContext*> FFmpegVideoDecoder::create_codec_context(CodecID codec_id, ReadonlyBytes codec_initialization_data, HardwareAcceleration hardware_acceleration)
 {
     AVCodecContext* codec_context = nullptr;
-    AVPacket* packet = nullptr;
-    AVFrame* frame = nullptr;
     ArmedScopeGuard memory_guard {
         [&] {
             avcodec_free_context(&codec_context);
-            av_packet_free(&packet);
-            av_frame_free(&frame);
         }
     };
 
@@ -65,6 +156,9 @@ DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create
     codec_context->time_base = { 1, 1'000'000 };
     codec_context->thread_count = static_cast<int>(min(Core::System::hardware_concurrency(), 4));
 
+    if (hardware_acceleration == HardwareAcceleration::Yes)
+        set_up_hardware_device(codec_context, codec);
+
     if (!codec_initialization_data.is_empty()) {
         if (codec_initialization_data.size() > NumericLimits<int>::max())
             return DecoderError::corrupted("Codec initialization data is too large"sv);
@@ -80,6 +174,35 @@ DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create
     if (avcodec_open2(codec_context, codec, nullptr) < 0)
         return DecoderError::format(DecoderErrorCategory::Unknown, "Unknown error occurred when opening FFmpeg codec {}", codec_id);
 
+    memory_guard.disarm();
+    return codec_context;
+}
+
+DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create(CodecID codec_id, ReadonlyBytes codec_initialization_data)
+{
+    AVCodecContext* codec_context = nullptr;
+    AVPacket* packet = nullptr;
+    AVFrame* frame = nullptr;
+    AVFrame* software_frame = nullptr;
+    ArmedScopeGuard memory_guard {
+        [&] {
+            avcodec_free_context(&codec_context);
+            av_packet_free(&packet);
+            av_frame_free(&frame);
+            av_frame_free(&software_frame);
+        }
+    };
+
+    if (s_hardware_acceleration_enabled) {
+        auto hardware_codec_context = create_codec_context(codec_id, codec_initialization_data, HardwareAcceleration::Yes);
+        if (!hardware_codec_context.is_error())
+            codec_context = hardware_codec_context.release_value();
+    }
+    if (!codec_context)
+        codec_context = TRY(create_codec_context(codec_id, codec_initialization_data, HardwareAcceleration::No));
+
+    auto initialization_data = DECODER_TRY_ALLOC(ByteBuffer::copy(codec_initialization_data));
+
     packet = av_packet_alloc();
     if (!packet)
         return DecoderError::with_description(DecoderErrorCategory::Memory, "Failed to allocate FFmpeg packet"sv);
@@ -88,14 +211,21 @@ DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create
     if (!frame)
         return DecoderError::with_description(DecoderErrorCategory::Memory, "Failed to allocate FFmpeg frame"sv);
 
+    software_frame = av_frame_alloc();
+    if (!software_frame)
+        return DecoderError::with_description(DecoderErrorCategory::Memory, "Failed to allocate FFmpeg frame"sv);
+
     memory_guard.disarm();
-    return DECODER_TRY_ALLOC(try_make<FFmpegVideoDecoder>(codec_context, packet, frame));
+    return DECODER_TRY_ALLOC(try_make<FFmpegVideoDecoder>(codec_id, move(initialization_data), codec_context, packet, frame, software_frame));
 }
 
-FFmpegVideoDecoder::FFmpegVideoDecoder(AVCodecContext* codec_context, AVPacket* packet, AVFrame* frame)
-    : m_codec_context(codec_context)
+FFmpegVideoDecoder::FFmpegVideoDecoder(CodecID codec_id, ByteBuffer codec_initialization_data, AVCodecContext* codec_context, AVPacket* packet, AVFrame* frame, AVFrame* software_frame)
+    : m_codec_id(codec_id)
+    , m_codec_initialization_data(move(codec_initialization_data))
+    , m_codec_context(codec_context)
     , m_packet(packet)
     , m_frame(frame)
+    , m_software_frame(software_frame)
 {
 }
 
@@ -103,9 +233,33 @@ FFmpegVideoDecoder::~FFmpegVideoDecoder()
 {
     av_packet_free(&m_packet);
     av_frame_free(&m_frame);
+    av_frame_free(&m_software_frame);
     avcodec_free_context(&m_codec_context);
 }
 
+bool FFmpegVideoDecoder::is_hardware_accelerated() const
+{
+    return m_codec_context->hw_device_ctx != nullptr;
+}
+
+// Once the hardware fails to decode a frame, the rest of the stream is decoded in software. Frames that refer to ones
+// the hardware decoder held on to may show artifacts until the next keyframe.
+void FFmpegVideoDecoder::fall_back_to_software_decoding()
+{
+    VERIFY(is_hardware_accelerated());
+
+    auto software_codec_context = create_codec_context(m_codec_id, m_codec_initialization_data, HardwareAcceleration::No);
+    if (software_codec_context.is_error()) {
+        dbgln("FFmpegVideoDecoder: Failed to fall back to software decoding: {}", software_codec_context.error().description());
+        return;
+    }
+
+    dbgln("FFmpegVideoDecoder: Hardware decoding of {} failed, falling back to software decoding", m_codec_id);
+    avcodec_free_context(&m_codec_context);
+    m_codec_context = software_codec_context.release_value();
+    m_frame_durations.clear();
+}
+
 DecoderErrorOr<void> FFmpegVideoDecoder::receive_coded_data(AK::Duration timestamp, AK::Duration duration, ReadonlyBytes coded_data, Optional<AK::Duration> decode_timestamp)
 {
     VERIFY(coded_data.size() < NumericLimits<int>::max());
@@ -118,6 +272,11 @@ DecoderErrorOr<void> FFmpegVideoDecoder::receive_coded_data(AK::Duration timesta
     auto packet_pts = m_packet->pts;
 
     auto result = avcodec_send_packet(m_codec_context, m_packet);
+    if (result < 0 && result != AVERROR(EAGAIN) && result != AVERROR_EOF && is_hardware_accelerated()) {
+        fall_back_to_software_decoding();
+        result = avcodec_send_packet(m_codec_context, m_packet);
+    }
+
     switch (result) {
     case 0:
         // Some FFmpeg decoders do not propagate packet duration to decoded frames, so
@@ -152,14 +311,35 @@ void FFmpegVideoDecoder::signal_end_of_stream()
 DecoderErrorOr<NonnullRefPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(CodingIndependentCodePoints const& container_cicp)
 {
     auto result = avcodec_receive_frame(m_codec_context, m_frame);
+    if (result < 0 && result != AVERROR(EAGAIN) && result != AVERROR_EOF && is_hardware_accelerated()) {
+        fall_back_to_software_decoding();
+        return DecoderError::with_description(DecoderErrorCategory::NeedsMoreInput, "FFmpeg decoder fell back to software decoding, send more input"sv);
+    }
 
     switch (result) {
     case 0: {
-        auto color_primaries = static_cast<ColorPrimaries>(m_frame->color_primaries);
-        auto transfer_characteristics = static_cast<TransferCharacteristics>(m_frame->color_trc);
-        auto matrix_coefficients = static_cast<MatrixCoefficients>(m_frame->colorspace);
+        // Frames decoded by the hardware are downloaded, since VideoFrame only holds YUV data in memory.
+        AVFrame* frame = m_frame;
+        if (m_frame->hw_frames_ctx) {
+            av_frame_unref(m_software_frame);
+            auto transfer_result = av_hwframe_transfer_data(m_software_frame, m_frame, 0);
+            if (transfer_result >= 0)
+                transfer_result = av_frame_copy_props(m_software_frame, m_frame);
+            if (transfer_result >= 0 && !is_supported_planar_format(m_software_frame->format) && !is_semi_planar_format(m_software_frame->format))
+                transfer_result = AVERROR(ENOSYS);
+            av_frame_unref(m_frame);
+            if (transfer_result < 0) {
+                fall_back_to_software_decoding();
+                return DecoderError::with_description(DecoderErrorCategory::NeedsMoreInput, "FFmpeg decoder fell back to software decoding, send more input"sv);
+            }
+            frame = m_software_frame;
+        }
+
+        auto color_primaries = static_cast<ColorPrimaries>(frame->color_primaries);
+        auto transfer_characteristics = static_cast<TransferCharacteristics>(frame->color_trc);
+        auto matrix_coefficients = static_cast<MatrixCoefficients>(frame->colorspace);
         auto color_range = [&] {
-            switch (m_frame->color_range) {
+            switch (frame->color_range) {
             case AVColorRange::AVCOL_RANGE_MPEG:
                 return VideoFullRangeFlag::Studio;
             case AVColorRange::AVCOL_RANGE_JPEG:
@@ -172,14 +352,16 @@ DecoderErrorOr<NonnullRefPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
         cicp.adopt_specified_values(container_cicp);
 
         size_t bit_depth = [&] {
-            switch (m_frame->format) {
+            switch (frame->format) {
             case AV_PIX_FMT_YUV420P:
             case AV_PIX_FMT_YUV422P:
             case AV_PIX_FMT_YUV444P:
             case AV_PIX_FMT_YUVJ420P:
             case AV_PIX_FMT_YUVJ422P:
             case AV_PIX_FMT_YUVJ444P:
+            case AV_PIX_FMT_NV12:
                 return 8;
+            case AV_PIX_FMT_P010:
             case AV_PIX_FMT_YUV420P10:
             case AV_PIX_FMT_YUV422P10:
             case AV_PIX_FMT_YUV444P10:
@@ -194,11 +376,13 @@ DecoderErrorOr<NonnullRefPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
         }();
 
         auto subsampling = [&]() -> Subsampling {
-            switch (m_frame->format) {
+            switch (frame->format) {
             case AV_PIX_FMT_YUV420P:
             case AV_PIX_FMT_YUV420P10:
             case AV_PIX_FMT_YUV420P12:
             case AV_PIX_FMT_YUVJ420P:
+            case AV_PIX_FMT_NV12:
+            case AV_PIX_FMT_P010:
                 return { true, true };
             case AV_PIX_FMT_YUV422P:
             case AV_PIX_FMT_YUV422P10:
@@ -215,16 +399,16 @@ DecoderErrorOr<NonnullRefPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
             }
         }();
 
-        auto size = Gfx::Size<u32> { m_frame->width, m_frame->height };
-        auto gfx_size = Gfx::IntSize { m_frame->width, m_frame->height };
+        auto size = Gfx::Size<u32> { frame->width, frame->height };
+        auto gfx_size = Gfx::IntSize { frame->width, frame->height };
 
-        auto timestamp = AK::Duration::from_microseconds(m_frame->pts);
-        auto duration = AK::Duration::from_microseconds(m_frame->duration);
+        auto timestamp = AK::Duration::from_microseconds(frame->pts);
+        auto duration = AK::Duration::from_microseconds(frame->duration);
         if (duration.is_zero()) {
-            if (auto packet_duration = m_frame_durations.take(m_frame->pts); packet_duration.has_value())
+            if (auto packet_duration = m_frame_durations.take(frame->pts); packet_duration.has_value())
                 duration = *packet_duration;
         } else {
-            m_frame_durations.remove(m_frame->pts);
+            m_frame_durations.remove(frame->pts);
         }
 
         auto yuv_data = DECODER_TRY_ALLOC(Gfx::YUVData::create(gfx_size, bit_depth, subsampling, cicp));
@@ -237,27 +421,42 @@ DecoderErrorOr<NonnullRefPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
 
         auto component_size = bit_depth <= 8 ? 1 : 2;
 
-        for (u32 plane = 0; plane < 3; plane++) {
-            VERIFY(m_frame->linesize[plane] != 0);
-            if (m_frame->linesize[plane] < 0)
+        if (is_semi_planar_format(frame->format)) {
+            if (frame->linesize[0] < 0 || frame->linesize[1] < 0)
                 return DecoderError::with_description(DecoderErrorCategory::NotImplemented, "Reversed scanlines are not supported"sv);
+            VERIFY(y_plane_size.width() * component_size <= static_cast<size_t>(frame->linesize[0]));
+            VERIFY(uv_plane_size.width() * 2 * component_size <= static_cast<size_t>(frame->linesize[1]));
 
-            auto plane_size = plane_sizes[plane];
-            auto const* source = m_frame->data[plane];
-            VERIFY(source != nullptr);
-            auto destination = buffers[plane];
-
-            auto output_line_size = plane_size.width() * component_size;
-            VERIFY(output_line_size <= static_cast<size_t>(m_frame->linesize[plane]));
-
-            auto* dest_ptr = destination.data();
-            for (size_t row = 0; row < plane_size.height(); row++) {
-                memcpy(dest_ptr, source, output_line_size);
-                source += m_frame->linesize[plane];
-                dest_ptr += output_line_size;
+            if (component_size == 1)
+                copy_semi_planar_frame<u8>(*frame, *yuv_data, y_plane_size, uv_plane_size, 0);
+            else
+                copy_semi_planar_frame<u16>(*frame, *yuv_data, y_plane_size, uv_plane_size, static_cast<u8>(16 - bit_depth));
+        } else {
+            for (u32 plane = 0; plane < 3; plane++) {
+                VERIFY(frame->linesize[plane] != 0);
+                if (frame->linesize[plane] < 0)
+                    return DecoderError::with_description(DecoderErrorCategory::NotImplemented, "Reversed scanlines are not supported"sv);
+
+                auto plane_size = plane_sizes[plane];
+                auto const* source = frame->data[plane];
+                VERIFY(source != nullptr);
+                auto destination = buffers[plane];
+
+                auto output_line_size = plane_size.width() * component_size;
+                VERIFY(output_line_size <= static_cast<size_t>(frame->linesize[plane]));
+
+                auto* dest_ptr = destination.data();
+                for (size_t row = 0; row < plane_size.height(); row++) {
+                    memcpy(dest_ptr, source, output_line_size);
+                    source += frame->linesize[plane];
+                    dest_ptr += output_line_size;
+                }
             }
         }
 
+        // NB: The frame is shared with the compositor as-is, so stop anyone from changing it from here on.
+        DECODER_TRY(DecoderErrorCategory::Unknown, yuv_data->seal());
+
         auto color_space = DECODER_TRY_ALLOC(Gfx::ColorSpace::from_cicp(cicp));
 
         return DECODER_TRY_ALLOC(try_make_ref_counted<VideoFrame>(timestamp, duration, size, bit_depth, move(color_space), move(yuv_data)));
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
 #include <LibMedia/CodecID.h>
 #include <LibMedia/Export.h>
@@ -18,7 +19,7 @@ namespace Media::FFmpeg {
 class MEDIA_API FFmpegVideoDecoder final : public VideoDecoder {
 public:
     static DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> try_create(CodecID, ReadonlyBytes codec_initialization_data);
-    FFmpegVideoDecoder(AVCodecContext* codec_context, AVPacket* packet, AVFrame* frame);
+    FFmpegVideoDecoder(CodecID, ByteBuffer codec_initialization_data, AVCodecContext* codec_context, AVPacket* packet, AVFrame* frame, AVFrame* software_frame);
     virtual ~FFmpegVideoDecoder() override;
 
     virtual DecoderErrorOr<void> receive_coded_data(AK::Duration timestamp, AK::Duration duration, ReadonlyBytes coded_data, Optional<AK::Duration> decode_timestamp = {}) override;
@@ -27,10 +28,28 @@ public:
 
     virtual void flush() override;
 
+    // Decoders created after this is enabled decode on the GPU through the platform's video API (VideoToolbox, D3D11VA,
+    // or VAAPI and then Vulkan), where FFmpeg supports it for the codec and profile. Anything else decodes in software.
+    static void set_hardware_acceleration_enabled(bool enabled) { s_hardware_acceleration_enabled = enabled; }
+    bool is_hardware_accelerated() const;
+
 private:
+    enum class HardwareAcceleration {
+        No,
+        Yes,
+    };
+    static DecoderErrorOr<AVCodecContext*> create_codec_context(CodecID, ReadonlyBytes codec_initialization_data, HardwareAcceleration);
+
+    void fall_back_to_software_decoding();
+
+    static bool s_hardware_acceleration_enabled;
+
+    CodecID m_codec_id;
+    ByteBuffer m_codec_initialization_data;
     AVCodecContext* m_codec_context;
     AVPacket* m_packet;
     AVFrame* m_frame;
+    AVFrame* m_software_frame;
     HashMap<i64, AK::Duration> m_frame_durations;
 };
 
@@ -238,6 +238,8 @@ void DecodedAudioProducer::ThreadData::pull(AudioBlock& into)
         return;
     }
     if (!m_queue.is_empty()) {
+        if (!into.is_empty() && m_recycled_blocks.size() < m_queue_max_size)
+            m_recycled_blocks.append(move(into));
         into = m_queue.dequeue();
         m_earliest_available_timestamp = into.media_time_end();
         wake();
@@ -246,6 +248,16 @@ void DecodedAudioProducer::ThreadData::pull(AudioBlock& into)
     into.clear();
 }
 
+AudioBlock DecodedAudioProducer::ThreadData::take_recycled_block()
+{
+    auto locker = take_lock();
+    if (m_recycled_blocks.is_empty())
+        return {};
+    auto block = m_recycled_blocks.take_last();
+    block.clear();
+    return block;
+}
+
 void DecodedAudioProducer::ThreadData::enter_halting_state(PipelineStatus status, Optional<DecoderError> error)
 {
     if (error.has_value() && error->category() == DecoderErrorCategory::Aborted)
@@ -298,6 +310,7 @@ bool DecodedAudioProducer::ThreadData::handle_auto_suspension()
     VERIFY(!m_auto_suspended);
 
     m_queue.clear();
+    m_recycled_blocks.clear();
     m_latest_available_timestamp = m_earliest_available_timestamp;
     m_decoder.clear();
     m_decoder_needs_keyframe_next_seek = true;
@@ -581,7 +594,7 @@ void DecodedAudioProducer::ThreadData::push_data_and_decode_a_block()
             }
         }
 
-        auto block = AudioBlock();
+        auto block = take_recycled_block();
         auto block_result = retrieve_next_block(block);
         if (block_result.is_error()) {
             if (block_result.error().category() == DecoderErrorCategory::NeedsMoreInput)
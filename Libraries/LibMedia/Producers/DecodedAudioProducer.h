@@ -11,6 +11,7 @@
 #include <AK/Optional.h>
 #include <AK/Queue.h>
 #include <AK/Time.h>
+#include <AK/Vector.h>
 #include <LibCore/Forward.h>
 #include <LibMedia/Audio/AudioConverter.h>
 #include <LibMedia/AudioBlock.h>
@@ -113,6 +114,7 @@ private:
         };
 
         void note_consumer_activity_while_locked() const;
+        AudioBlock take_recycled_block();
         void wait_for_queue_space_or_auto_suspend_while_locked();
 
         Core::EventLoop& m_main_thread_event_loop;
@@ -131,6 +133,9 @@ private:
 
         size_t m_queue_max_size { 8 };
         AudioQueue m_queue;
+        // Blocks that the consumer is done with, kept so that decoding can reuse their sample storage instead of
+        // allocating a new buffer for every block.
+        Vector<AudioBlock, 8> m_recycled_blocks;
         AK::Duration m_earliest_available_timestamp;
         AK::Duration m_latest_available_timestamp;
         BlockEndTimeHandler m_duration_change_handler;
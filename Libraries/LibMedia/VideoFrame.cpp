@@ -61,24 +61,12 @@ static bool video_full_range_flag_ipc_value_valid(Media::VideoFullRangeFlag vide
         || Media::video_full_range_flag_valid(video_full_range_flag);
 }
 
-static ErrorOr<Core::AnonymousBuffer> encode_yuv_data(Gfx::YUVData const& yuv_data)
-{
-    auto sizes = TRY(Gfx::YUVData::plane_sizes(yuv_data.size(), yuv_data.bit_depth(), yuv_data.subsampling()));
-    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(sizes.total));
-
-    auto bytes = Bytes { buffer.data<u8>(), buffer.size() };
-    yuv_data.y_data().copy_to(bytes.slice(0, sizes.y));
-    yuv_data.u_data().copy_to(bytes.slice(sizes.y, sizes.u));
-    yuv_data.v_data().copy_to(bytes.slice(sizes.y + sizes.u, sizes.v));
-    return buffer;
-}
-
 template<>
 ErrorOr<void> encode(Encoder& encoder, Media::VideoFrame const& frame)
 {
+    // NB: The decoder wrote the planes into shared memory, so only a handle to them is sent.
     auto const& yuv_data = frame.yuv_data();
-    auto yuv_data_buffer = TRY(encode_yuv_data(yuv_data));
-    TRY(encoder.encode(yuv_data_buffer));
+    TRY(encoder.encode(yuv_data.buffer()));
     TRY(encoder.encode(frame.color_space()));
     TRY(encoder.encode(frame.timestamp()));
     TRY(encoder.encode(frame.duration()));
@@ -105,6 +93,10 @@ ErrorOr<NonnullRefPtr<Media::VideoFrame const>> decode(Decoder& decoder)
     auto yuv_data_buffer = TRY(decoder.decode<Core::AnonymousBuffer>());
     if (!yuv_data_buffer.is_valid())
         return Error::from_string_literal("IPC: VideoFrame contained invalid YUV data");
+    // NB: The sender keeps its own handle to the planes, so unless they are sealed it could still write to them or
+    //     truncate them while we read them.
+    if (Core::AnonymousBuffer::supports_sealing && !yuv_data_buffer.is_sealed())
+        return Error::from_string_literal("IPC: VideoFrame YUV data is not sealed");
 
     auto color_space = TRY(decoder.decode<Gfx::ColorSpace>());
     auto timestamp = TRY(decoder.decode<AK::Duration>());
@@ -132,12 +124,7 @@ ErrorOr<NonnullRefPtr<Media::VideoFrame const>> decode(Decoder& decoder)
     if (yuv_data_buffer.size() != sizes.total)
         return Error::from_string_literal("IPC: VideoFrame contained invalid YUV data size");
 
-    auto bytes = yuv_data_buffer.bytes();
-    auto y_data = bytes.slice(0, sizes.y);
-    auto u_data = bytes.slice(sizes.y, sizes.u);
-    auto v_data = bytes.slice(sizes.y + sizes.u, sizes.v);
-
-    auto yuv_data = TRY(Gfx::YUVData::create_from_data(size, bit_depth, subsampling, cicp, y_data, u_data, v_data));
+    auto yuv_data = TRY(Gfx::YUVData::create_from_buffer(size, bit_depth, subsampling, cicp, move(yuv_data_buffer)));
     auto frame = TRY(try_make_ref_counted<Media::VideoFrame>(timestamp, duration, size.to_type<u32>(), bit_depth, move(color_space), move(yuv_data)));
     return NonnullRefPtr<Media::VideoFrame const> { *frame };
 }
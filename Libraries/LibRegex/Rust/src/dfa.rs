@@ -0,0 +1,796 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+//! Lazily built DFA for patterns the backtracking VM could take super-linear
+//! time on.
+//!
+//! The compiled program is turned into an NFA graph, and DFA states (ordered
+//! sets of NFA nodes) are built on demand while scanning the input. This gives
+//! linear-time matching for patterns without backreferences, lookarounds,
+//! counted repetition of groups or modifier groups.
+//!
+//! ECMAScript matching is leftmost-first rather than leftmost-longest, so the
+//! forward automaton keeps NFA threads in priority order and drops every lower
+//! priority thread once a higher priority one reaches `Match`. That finds the
+//! end of the match the backtracker would have produced. The start is then
+//! found by running the reversed NFA backwards from that end, keeping the
+//! left-most position at which the pattern still matches.
+//!
+//! Captures are not tracked. When they are needed, the backtracker is run
+//! anchored at the start the DFA found.
+//!
+//! States are cached with a fixed memory budget. When the budget is exhausted
+//! the cache is cleared, and if that keeps happening without making progress
+//! through the input, the search gives up so the caller can fall back to the
+//! backtracker.
+use crate::bytecode::*;
+use crate::vm;
+use crate::vm::Input;
+use std::collections::HashMap;
+use std::collections::HashSet;
+
+/// Upper bound on NFA nodes, after expanding simple loops.
+const MAX_NFA_NODES: usize = 4096;
+
+/// Upper bound on the number of copies a bounded simple loop is expanded into.
+const MAX_LOOP_EXPANSION: u32 = 256;
+
+/// Memory budget for the states and transitions of each direction.
+const CACHE_CAPACITY: usize = 512 * 1024;
+
+/// After the first cache clear in a search, give up unless at least this many
+/// code units were scanned per cached state since the previous clear.
+const MIN_CODE_UNITS_PER_STATE: usize = 10;
+
+/// Transitions for code units below this value are stored in a flat table.
+const ASCII_TRANSITION_COUNT: usize = 128;
+
+/// Transition table entries are a target state ID, plus these flags.
+const UNKNOWN_TRANSITION: u32 = u32::MAX;
+const MATCHED_BEFORE_FLAG: u32 = 1 << 31;
+const DEAD_FLAG: u32 = 1 << 30;
+const STATE_ID_MASK: u32 = DEAD_FLAG - 1;
+
+/// Result of a DFA search.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub(crate) enum SearchResult {
+    Match { start: usize, end: usize },
+    NoMatch,
+    /// The state cache kept overflowing; the caller must use the backtracker.
+    GaveUp,
+}
+
+/// Zero-width assertions, evaluated from the code units on either side of a position.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Look {
+    Start,
+    StartLine,
+    End,
+    EndLine,
+    WordBoundary,
+    NonWordBoundary,
+}
+
+/// What lies on one side of an input position, as far as assertions care.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+enum Neighbor {
+    InputBoundary,
+    LineTerminator,
+    Word,
+    Other,
+}
+
+impl Neighbor {
+    #[inline(always)]
+    fn of(code_unit: u16) -> Self {
+        let cp = code_unit as u32;
+        if vm::is_line_terminator(cp) {
+            Neighbor::LineTerminator
+        } else if vm::is_word_char(cp) {
+            Neighbor::Word
+        } else {
+            Neighbor::Other
+        }
+    }
+}
+
+impl Look {
+    fn holds(self, before: Neighbor, after: Neighbor) -> bool {
+        match self {
+            Look::Start => before == Neighbor::InputBoundary,
+            Look::StartLine => matches!(before, Neighbor::InputBoundary | Neighbor::LineTerminator),
+            Look::End => after == Neighbor::InputBoundary,
+            Look::EndLine => matches!(after, Neighbor::InputBoundary | Neighbor::LineTerminator),
+            Look::WordBoundary => (before == Neighbor::Word) != (after == Neighbor::Word),
+            Look::NonWordBoundary => (before == Neighbor::Word) == (after == Neighbor::Word),
+        }
+    }
+}
+
+/// How an edge takes part in rejecting zero-width loop iterations.
+///
+/// Loops whose body can match empty save the position when an iteration
+/// starts and reject the iteration if its end is at the same position. Within
+/// one epsilon closure no input has been consumed, so it is enough to know
+/// whether the iteration started in the current closure.
+#[derive(Debug, Clone, Copy)]
+enum Progress {
+    /// An iteration starts here.
+    Reset,
+    /// An iteration ends here; it must have consumed input. Also starts the next one.
+    Check,
+    /// Like `Check`, without starting another iteration. Used by the reversed NFA,
+    /// which meets the start of an iteration last.
+    Require,
+}
+
+#[derive(Debug, Clone, Copy)]
+enum Edge {
+    Epsilon(u32),
+    Look(Look, u32),
+    /// Consume one code unit accepted by the matcher at the given index.
+    Consume(u32, u32),
+    /// Zero-width iteration tracking for the loop at the given bit index.
+    Progress(Progress, u32, u32),
+}
+
+/// NFA graph. Each node's edges are listed in priority order.
+struct Nfa {
+    edges: Vec<Vec<Edge>>,
+    matchers: Vec<SimpleMatch>,
+    start: u32,
+    accept: u32,
+    has_looks: bool,
+}
+
+impl Nfa {
+    fn from_program(program: &Program) -> Option<Self> {
+        let instruction_count = program.instructions.len();
+
+        // Node `instruction_count` is where execution falls off the end of the
+        // program, and the node after it is the single accepting node.
+        let fell_off_end = instruction_count as u32;
+        let accept = fell_off_end + 1;
+        let mut nfa = Nfa {
+            edges: vec![Vec::new(); instruction_count + 2],
+            matchers: Vec::new(),
+            start: 0,
+            accept,
+            has_looks: false,
+        };
+
+        // Each loop that needs a zero-width check gets a bit in the closure's progress mask.
+        let mut progress_registers = Vec::new();
+        for instruction in &program.instructions {
+            if let Instruction::ProgressCheck { reg, .. } = instruction
+                && !progress_registers.contains(reg)
+            {
+                progress_registers.push(*reg);
+            }
+        }
+        if progress_registers.len() > u64::BITS as usize {
+            return None;
+        }
+        let progress_bit = |reg: u32| progress_registers.iter().position(|r| *r == reg).map(|bit| bit as u32);
+
+        for (pc, instruction) in program.instructions.iter().enumerate() {
+            let next = pc as u32 + 1;
+            let edges = match instruction {
+                Instruction::Char(c) => vec![nfa.consume(SimpleMatch::Char(*c), next)],
+                Instruction::CharNoCase(lo, hi) => vec![nfa.consume(SimpleMatch::CharNoCase(*lo, *hi), next)],
+                Instruction::AnyChar { dot_all } => vec![nfa.consume(SimpleMatch::AnyChar { dot_all: *dot_all }, next)],
+                Instruction::CharClass { ranges, negated } => vec![nfa.consume(
+                    SimpleMatch::CharClass {
+                        ranges: ranges.clone(),
+                        negated: *negated,
+                    },
+                    next,
+                )],
+                Instruction::BuiltinClass(class) => vec![nfa.consume(SimpleMatch::BuiltinClass(*class), next)],
+                Instruction::UnicodeProperty(data) => {
+                    vec![nfa.consume(SimpleMatch::UnicodeProperty(data.clone()), next)]
+                }
+                Instruction::Jump(target) => vec![Edge::Epsilon(*target)],
+                Instruction::Split { prefer, other } => vec![Edge::Epsilon(*prefer), Edge::Epsilon(*other)],
+                Instruction::Save(reg) => match progress_bit(*reg) {
+                    Some(bit) => vec![Edge::Progress(Progress::Reset, bit, next)],
+                    None => vec![Edge::Epsilon(next)],
+                },
+                Instruction::ProgressCheck { reg, .. } => {
+                    vec![Edge::Progress(Progress::Check, progress_bit(*reg)?, next)]
+                }
+                Instruction::ClearRegister(_) | Instruction::Nop => vec![Edge::Epsilon(next)],
+                Instruction::AssertStart { multiline } => {
+                    let look = if *multiline || program.multiline {
+                        Look::StartLine
+                    } else {
+                        Look::Start
+                    };
+                    vec![nfa.look(look, next)]
+                }
+                Instruction::AssertEnd { multiline } => {
+                    let look = if *multiline || program.multiline {
+                        Look::EndLine
+                    } else {
+                        Look::End
+                    };
+                    vec![nfa.look(look, next)]
+                }
+                Instruction::AssertWordBoundary => vec![nfa.look(Look::WordBoundary, next)],
+                Instruction::AssertNonWordBoundary => vec![nfa.look(Look::NonWordBoundary, next)],
+                Instruction::Match => vec![Edge::Epsilon(accept)],
+                Instruction::Fail => Vec::new(),
+                Instruction::GreedyLoop { matcher, min, max } => {
+                    vec![Edge::Epsilon(nfa.expand_loop(matcher, *min, *max, true, next)?)]
+                }
+                Instruction::LazyLoop { matcher, min, max } => {
+                    vec![Edge::Epsilon(nfa.expand_loop(matcher, *min, *max, false, next)?)]
+                }
+                Instruction::Backref(_)
+                | Instruction::BackrefNamed(_)
+                | Instruction::RepeatStart { .. }
+                | Instruction::RepeatCheck { .. }
+                | Instruction::LookStart { .. }
+                | Instruction::LookEnd
+                | Instruction::PushModifiers { .. }
+                | Instruction::PopModifiers
+                | Instruction::StringPropertyMatch { .. } => return None,
+            };
+            nfa.edges[pc] = edges;
+
+            if nfa.edges.len() > MAX_NFA_NODES {
+                return None;
+            }
+        }
+
+        let node_count = nfa.edges.len() as u32;
+        let targets_are_valid = nfa.edges.iter().flatten().all(|edge| match *edge {
+            Edge::Epsilon(target) | Edge::Look(_, target) | Edge::Consume(_, target) | Edge::Progress(_, _, target) => {
+                target < node_count
+            }
+        });
+        if !targets_are_valid {
+            return None;
+        }
+
+        Some(nfa)
+    }
+
+    fn consume(&mut self, matcher: SimpleMatch, next: u32) -> Edge {
+        let index = self.matchers.len() as u32;
+        self.matchers.push(matcher);
+        Edge::Consume(index, next)
+    }
+
+    fn look(&mut self, look: Look, next: u32) -> Edge {
+        self.has_looks = true;
+        Edge::Look(look, next)
+    }
+
+    fn add_node(&mut self) -> u32 {
+        self.edges.push(Vec::new());
+        self.edges.len() as u32 - 1
+    }
+
+    /// Expand `matcher{min,max}` into a chain of consuming nodes ending at `exit`,
+    /// and return the first node of the chain.
+    fn expand_loop(&mut self, matcher: &SimpleMatch, min: u32, max: Option<u32>, greedy: bool, exit: u32) -> Option<u32> {
+        let copies = max.unwrap_or(min.saturating_add(1));
+        if copies < min || copies > MAX_LOOP_EXPANSION {
+            return None;
+        }
+        if self.edges.len() + copies as usize * 2 + 1 > MAX_NFA_NODES {
+            return None;
+        }
+
+        let matcher_index = self.matchers.len() as u32;
+        self.matchers.push(matcher.clone());
+
+        let entry = self.add_node();
+        let mut current = entry;
+
+        for _ in 0..min {
+            let next = self.add_node();
+            self.edges[current as usize] = vec![Edge::Consume(matcher_index, next)];
+            current = next;
+        }
+
+        let choice = |consume: u32, greedy: bool| {
+            if greedy {
+                vec![Edge::Epsilon(consume), Edge::Epsilon(exit)]
+            } else {
+                vec![Edge::Epsilon(exit), Edge::Epsilon(consume)]
+            }
+        };
+
+        match max {
+            None => {
+                // `current` loops back onto itself through a single consuming node.
+                let consume = self.add_node();
+                self.edges[consume as usize] = vec![Edge::Consume(matcher_index, current)];
+                self.edges[current as usize] = choice(consume, greedy);
+            }
+            Some(max) => {
+                for _ in min..max {
+                    let consume = self.add_node();
+                    let next = self.add_node();
+                    self.edges[consume as usize] = vec![Edge::Consume(matcher_index, next)];
+                    self.edges[current as usize] = choice(consume, greedy);
+                    current = next;
+                }
+                self.edges[current as usize] = vec![Edge::Epsilon(exit)];
+            }
+        }
+
+        Some(entry)
+    }
+
+    /// Build the NFA that matches the reversed language, starting at this NFA's
+    /// accepting node and accepting at its start node.
+    fn reversed(&self) -> Self {
+        let mut edges = vec![Vec::new(); self.edges.len()];
+        for (from, node_edges) in self.edges.iter().enumerate() {
+            let from = from as u32;
+            for edge in node_edges {
+                match *edge {
+                    Edge::Epsilon(to) => edges[to as usize].push(Edge::Epsilon(from)),
+                    Edge::Look(look, to) => edges[to as usize].push(Edge::Look(look, from)),
+                    Edge::Consume(matcher, to) => edges[to as usize].push(Edge::Consume(matcher, from)),
+                    // Walking backwards, an iteration's end is met before its start.
+                    Edge::Progress(Progress::Reset, bit, to) => {
+                        edges[to as usize].push(Edge::Progress(Progress::Require, bit, from))
+                    }
+                    Edge::Progress(progress, bit, to) => edges[to as usize].push(Edge::Progress(progress, bit, from)),
+                }
+            }
+        }
+
+        Nfa {
+            edges,
+            matchers: self.matchers.clone(),
+            start: self.accept,
+            accept: self.start,
+            has_looks: self.has_looks,
+        }
+    }
+}
+
+#[derive(Clone, PartialEq, Eq, Hash)]
+struct StateKey {
+    /// NFA nodes whose epsilon closure has not been taken yet, in priority order.
+    threads: Box<[u32]>,
+    /// The code unit already scanned next to the current position. Always
+    /// `Other` for patterns without assertions, so that it doesn't split states.
+    neighbor: Neighbor,
+    /// Whether a new thread is started at the current position. Only set in the
+    /// forward direction until the first match is found.
+    searching: bool,
+}
+
+struct CachedState {
+    key: StateKey,
+    ascii_transitions: Box<[u32; ASCII_TRANSITION_COUNT]>,
+}
+
+#[derive(Default)]
+struct StateCache {
+    states: Vec<CachedState>,
+    ids: HashMap<StateKey, u32>,
+    /// Transitions on code units outside the flat table, keyed by (state, code unit).
+    wide_transitions: HashMap<(u32, u16), u32>,
+    memory_usage: usize,
+}
+
+impl StateCache {
+    fn clear(&mut self) {
+        self.states.clear();
+        self.ids.clear();
+        self.wide_transitions.clear();
+        self.memory_usage = 0;
+    }
+
+    fn intern(&mut self, key: StateKey) -> u32 {
+        if let Some(id) = self.ids.get(&key) {
+            return *id;
+        }
+        let id = self.states.len() as u32;
+        self.memory_usage += std::mem::size_of::<CachedState>()
+            + std::mem::size_of::<[u32; ASCII_TRANSITION_COUNT]>()
+            + 2 * (std::mem::size_of::<StateKey>() + key.threads.len() * std::mem::size_of::<u32>());
+        self.states.push(CachedState {
+            key: key.clone(),
+            ascii_transitions: Box::new([UNKNOWN_TRANSITION; ASCII_TRANSITION_COUNT]),
+        });
+        self.ids.insert(key, id);
+        id
+    }
+}
+
+/// Which way the automaton scans, and therefore which side of a position has
+/// already been seen.
+#[derive(Clone, Copy, PartialEq, Eq)]
+enum Direction {
+    Forward,
+    Reverse,
+}
+
+struct Automaton {
+    nfa: Nfa,
+    direction: Direction,
+    ignore_case: bool,
+    dot_all: bool,
+
+    cache: StateCache,
+    /// Code units scanned in the current search when the cache was last cleared.
+    last_clear_progress: Option<usize>,
+
+    // Scratch space for computing transitions.
+    stack: Vec<(u32, u64)>,
+    visit_marks: Vec<u32>,
+    /// Nodes visited while inside a loop iteration that hasn't consumed input yet.
+    visited_in_iteration: HashSet<(u32, u64)>,
+    visit_generation: u32,
+    consumers: Vec<u32>,
+    next_threads: Vec<u32>,
+}
+
+impl Automaton {
+    fn new(nfa: Nfa, direction: Direction, program: &Program) -> Self {
+        let node_count = nfa.edges.len();
+        Self {
+            nfa,
+            direction,
+            ignore_case: program.ignore_case,
+            dot_all: program.dot_all,
+            cache: StateCache::default(),
+            last_clear_progress: None,
+            stack: Vec::new(),
+            visit_marks: vec![0; node_count],
+            visited_in_iteration: HashSet::new(),
+            visit_generation: 0,
+            consumers: Vec::new(),
+            next_threads: Vec::new(),
+        }
+    }
+
+    fn begin_search(&mut self) {
+        self.last_clear_progress = None;
+    }
+
+    fn start_state(&mut self, neighbor: Neighbor) -> u32 {
+        let (threads, searching) = match self.direction {
+            // NB: The forward start thread is added by the closure while searching.
+            Direction::Forward => (Box::default(), true),
+            Direction::Reverse => (vec![self.nfa.start].into_boxed_slice(), false),
+        };
+        let neighbor = if self.nfa.has_looks { neighbor } else { Neighbor::Other };
+        self.cache.intern(StateKey {
+            threads,
+            neighbor,
+            searching,
+        })
+    }
+
+    /// Look up the transition out of `state` on `code_unit`, computing and caching it if needed.
+    #[inline(always)]
+    fn next(&mut self, state: u32, code_unit: u16, progress: usize) -> Result<u32, ()> {
+        let transition = if (code_unit as usize) < ASCII_TRANSITION_COUNT {
+            self.cache.states[state as usize].ascii_transitions[code_unit as usize]
+        } else {
+            self.cache
+                .wide_transitions
+                .get(&(state, code_unit))
+                .copied()
+                .unwrap_or(UNKNOWN_TRANSITION)
+        };
+        if transition != UNKNOWN_TRANSITION {
+            return Ok(transition);
+        }
+        self.compute_transition(state, code_unit, progress)
+    }
+
+    #[inline(never)]
+    fn compute_transition(&mut self, state: u32, code_unit: u16, progress: usize) -> Result<u32, ()> {
+        let key = self.cache.states[state as usize].key.clone();
+        let (before, after) = match self.direction {
+            Direction::Forward => (key.neighbor, Neighbor::of(code_unit)),
+            Direction::Reverse => (Neighbor::of(code_unit), key.neighbor),
+        };
+
+        let matched = self.closure(&key.threads, key.searching, before, after);
+
+        self.next_threads.clear();
+        self.visit_generation = self.visit_generation.wrapping_add(1);
+        if self.visit_generation == 0 {
+            self.visit_marks.fill(0);
+            self.visit_generation = 1;
+        }
+        for consumer in &self.consumers {
+            for edge in &self.nfa.edges[*consumer as usize] {
+                let Edge::Consume(matcher, target) = *edge else {
+                    continue;
+                };
+                if self.visit_marks[target as usize] == self.visit_generation {
+                    continue;
+                }
+                if !vm::match_simple_with_flags(
+                    code_unit as u32,
+                    &self.nfa.matchers[matcher as usize],
+                    self.ignore_case,
+                    self.dot_all,
+                    false,
+                    false,
+                ) {
+                    continue;
+                }
+                self.visit_marks[target as usize] = self.visit_generation;
+                self.next_threads.push(target);
+            }
+        }
+
+        // Once a thread has matched, every lower priority thread was dropped, including the one
+        // that starts new matches.
+        let searching = key.searching && !matched;
+        let next_key = StateKey {
+            threads: self.next_threads.as_slice().into(),
+            neighbor: if self.nfa.has_looks {
+                match self.direction {
+                    Direction::Forward => after,
+                    Direction::Reverse => before,
+                }
+            } else {
+                Neighbor::Other
+            },
+            searching,
+        };
+        let is_dead = next_key.threads.is_empty() && !searching;
+
+        let mut state = state;
+        if self.cache.memory_usage > CACHE_CAPACITY {
+            if let Some(last_clear_progress) = self.last_clear_progress {
+                let scanned = progress.saturating_sub(last_clear_progress);
+                if scanned < MIN_CODE_UNITS_PER_STATE * self.cache.states.len() {
+                    return Err(());
+                }
+            }
+            self.cache.clear();
+            self.last_clear_progress = Some(progress);
+            state = self.cache.intern(key);
+        }
+
+        let mut transition = self.cache.intern(next_key);
+        if matched {
+            transition |= MATCHED_BEFORE_FLAG;
+        }
+        if is_dead {
+            transition |= DEAD_FLAG;
+        }
+
+        if (code_unit as usize) < ASCII_TRANSITION_COUNT {
+            self.cache.states[state as usize].ascii_transitions[code_unit as usize] = transition;
+        } else {
+            self.cache.wide_transitions.insert((state, code_unit), transition);
+            self.cache.memory_usage += 4 * std::mem::size_of::<u32>();
+        }
+        Ok(transition)
+    }
+
+    /// Whether the state accepts at the edge of the input, where there is no code unit left to scan.
+    fn accepts_at_input_boundary(&mut self, state: u32) -> bool {
+        let key = self.cache.states[state as usize].key.clone();
+        let (before, after) = match self.direction {
+            Direction::Forward => (key.neighbor, Neighbor::InputBoundary),
+            Direction::Reverse => (Neighbor::InputBoundary, key.neighbor),
+        };
+        self.closure(&key.threads, key.searching, before, after)
+    }
+
+    /// Follow epsilon edges from every thread in priority order, collecting the
+    /// nodes that consume input into `consumers`. Returns whether the accepting
+    /// node was reached. In the forward direction, reaching it drops all lower
+    /// priority threads.
+    fn closure(&mut self, threads: &[u32], searching: bool, before: Neighbor, after: Neighbor) -> bool {
+        self.visit_generation = self.visit_generation.wrapping_add(1);
+        if self.visit_generation == 0 {
+            self.visit_marks.fill(0);
+            self.visit_generation = 1;
+        }
+        self.consumers.clear();
+        self.visited_in_iteration.clear();
+
+        let leftmost_first = self.direction == Direction::Forward;
+        let start = searching.then_some(self.nfa.start);
+        let mut matched = false;
+
+        for root in threads.iter().copied().chain(start) {
+            self.stack.clear();
+            self.stack.push((root, 0));
+
+            // NB: A node reached with a different set of zero-width iterations in progress may
+            //     still lead somewhere new, so those visits are tracked separately.
+            while let Some((node, progress_mask)) = self.stack.pop() {
+                if progress_mask == 0 {
+                    if self.visit_marks[node as usize] == self.visit_generation {
+                        continue;
+                    }
+                    self.visit_marks[node as usize] = self.visit_generation;
+                } else if !self.visited_in_iteration.insert((node, progress_mask)) {
+                    continue;
+                }
+
+                if node == self.nfa.accept {
+                    matched = true;
+                    if leftmost_first {
+                        return true;
+                    }
+                }
+
+                let mut consumes = false;
+                for edge in self.nfa.edges[node as usize].iter().rev() {
+                    match *edge {
+                        Edge::Epsilon(target) => self.stack.push((target, progress_mask)),
+                        Edge::Look(look, target) => {
+                            if look.holds(before, after) {
+                                self.stack.push((target, progress_mask));
+                            }
+                        }
+                        Edge::Progress(progress, bit, target) => {
+                            let bit = 1u64 << bit;
+                            match progress {
+                                Progress::Reset => self.stack.push((target, progress_mask | bit)),
+                                Progress::Check if progress_mask & bit == 0 => {
+                                    self.stack.push((target, progress_mask | bit))
+                                }
+                                Progress::Require if progress_mask & bit == 0 => {
+                                    self.stack.push((target, progress_mask))
+                                }
+                                Progress::Check | Progress::Require => {}
+                            }
+                        }
+                        Edge::Consume(..) => consumes = true,
+                    }
+                }
+                if consumes {
+                    self.consumers.push(node);
+                }
+            }
+        }
+
+        matched
+    }
+
+    /// Scan forward from `start` and return the end of the leftmost-first match.
+    /// If `earliest` is set, return as soon as any match is known to exist.
+    fn find_end<I: Input>(&mut self, input: I, start: usize, earliest: bool) -> Result<Option<usize>, ()> {
+        self.begin_search();
+
+        let before = if start == 0 {
+            Neighbor::InputBoundary
+        } else {
+            Neighbor::of(input.code_unit(start - 1))
+        };
+        let mut state = self.start_state(before);
+        let mut last_match = None;
+
+        let input_len = input.len();
+        let mut pos = start;
+        while pos < input_len {
+            let transition = self.next(state, input.code_unit(pos), pos - start)?;
+            if transition & MATCHED_BEFORE_FLAG != 0 {
+                last_match = Some(pos);
+                if earliest {
+                    return Ok(last_match);
+                }
+            }
+            if transition & DEAD_FLAG != 0 {
+                return Ok(last_match);
+            }
+            state = transition & STATE_ID_MASK;
+            pos += 1;
+        }
+
+        if self.accepts_at_input_boundary(state) {
+            last_match = Some(input_len);
+        }
+        Ok(last_match)
+    }
+
+    /// Scan backward from `end` (the end of a known match) and return the
+    /// left-most position not before `min_start` at which that match can start.
+    fn find_start<I: Input>(&mut self, input: I, min_start: usize, end: usize) -> Result<Option<usize>, ()> {
+        self.begin_search();
+
+        let after = if end == input.len() {
+            Neighbor::InputBoundary
+        } else {
+            Neighbor::of(input.code_unit(end))
+        };
+        let mut state = self.start_state(after);
+        let mut best = None;
+
+        let mut pos = end;
+        while pos > min_start {
+            let transition = self.next(state, input.code_unit(pos - 1), end - pos)?;
+            if transition & MATCHED_BEFORE_FLAG != 0 {
+                best = Some(pos);
+            }
+            if transition & DEAD_FLAG != 0 {
+                return Ok(best);
+            }
+            state = transition & STATE_ID_MASK;
+            pos -= 1;
+        }
+
+        // The code unit before `min_start` is not part of the match, but assertions may still look at it.
+        let accepts = if min_start == 0 {
+            self.accepts_at_input_boundary(state)
+        } else {
+            self.next(state, input.code_unit(min_start - 1), end - min_start)? & MATCHED_BEFORE_FLAG != 0
+        };
+        if accepts {
+            best = Some(min_start);
+        }
+        Ok(best)
+    }
+}
+
+/// A forward and a reverse lazy DFA for one program, each with its own state cache.
+pub(crate) struct LazyDfa {
+    forward: Automaton,
+    reverse: Automaton,
+}
+
+impl LazyDfa {
+    /// Build the automata for `program`, or return `None` if it uses features a DFA can't express.
+    pub(crate) fn new(program: &Program) -> Option<Self> {
+        // NB: In Unicode mode the DFA would have to step over surrogate pairs as single
+        //     characters, which the backtracker handles for now.
+        if program.unicode || program.unicode_sets {
+            return None;
+        }
+
+        let forward = Nfa::from_program(program)?;
+        let reverse = forward.reversed();
+        Some(Self {
+            forward: Automaton::new(forward, Direction::Forward, program),
+            reverse: Automaton::new(reverse, Direction::Reverse, program),
+        })
+    }
+
+    /// Find the leftmost-first match starting at or after `start`.
+    pub(crate) fn find<I: Input>(&mut self, input: I, start: usize) -> SearchResult {
+        if start > input.len() {
+            return SearchResult::NoMatch;
+        }
+
+        let end = match self.forward.find_end(input, start, false) {
+            Ok(Some(end)) => end,
+            Ok(None) => return SearchResult::NoMatch,
+            Err(()) => return SearchResult::GaveUp,
+        };
+
+        match self.reverse.find_start(input, start, end) {
+            Ok(Some(match_start)) => SearchResult::Match {
+                start: match_start,
+                end,
+            },
+            // NB: The forward scan proved a match ends here, so not finding its start would be a bug.
+            //     Let the backtracker decide rather than reporting a wrong result.
+            Ok(None) | Err(()) => SearchResult::GaveUp,
+        }
+    }
+
+    /// Whether there is any match starting at or after `start`, or `None` if the search gave up.
+    pub(crate) fn is_match<I: Input>(&mut self, input: I, start: usize) -> Option<bool> {
+        if start > input.len() {
+            return Some(false);
+        }
+        match self.forward.find_end(input, start, true) {
+            Ok(end) => Some(end.is_some()),
+            Err(()) => None,
+        }
+    }
+}
@@ -11,7 +11,9 @@ mod rust_allocator;
 pub mod ast;
 pub mod bytecode;
 pub mod compiler;
+pub mod dfa;
 pub mod ffi;
 pub mod parser;
 pub mod regex;
+pub mod scan;
 pub mod vm;
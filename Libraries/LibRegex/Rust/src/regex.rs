@@ -17,6 +17,7 @@ use crate::bytecode::Instruction;
 use crate::bytecode::NamedGroupEntry;
 use crate::bytecode::append_code_point_wtf16;
 use crate::compiler;
+use crate::dfa;
 use crate::parser;
 use crate::vm;
 use std::cell::RefCell;
@@ -35,6 +36,8 @@ pub struct Regex {
     /// Pre-computed u16 alternatives for fast literal alternation matching.
     /// Alternatives stay in source order to preserve leftmost-first semantics.
     literal_alt_u16: Option<Vec<Vec<u16>>>,
+    /// Lazy DFA used instead of the backtracker when the pattern allows it.
+    dfa: Option<RefCell<dfa::LazyDfa>>,
     /// Cached VM scratch space for reuse across exec calls.
     scratch: RefCell<vm::VmScratch>,
 }
@@ -61,6 +64,16 @@ impl Regex {
         let word_boundary_literal_u16 = extract_word_boundary_literal_u16(&parsed, flags);
         let literal_alt_u16 = extract_literal_alternatives_u16(&parsed, flags);
 
+        // Patterns served by a literal search, or that the backtracker already
+        // matches in linear time, don't need a DFA.
+        let has_literal_fast_path =
+            literal_u16.is_some() || word_boundary_literal_u16.is_some() || literal_alt_u16.is_some();
+        let dfa = if flags.sticky || has_literal_fast_path || hints.has_linear_fast_path() {
+            None
+        } else {
+            dfa::LazyDfa::new(&program).map(RefCell::new)
+        };
+
         Ok(Self {
             program,
             flags,
@@ -68,6 +81,7 @@ impl Regex {
             literal_u16,
             word_boundary_literal_u16,
             literal_alt_u16,
+            dfa,
             scratch: RefCell::new(vm::VmScratch::new()),
         })
     }
@@ -115,6 +129,27 @@ impl Regex {
             };
         }
         let scratch = &mut *self.scratch.borrow_mut();
+        if let Some(ref dfa) = self.dfa {
+            if vm::fails_literal_hints(input, start, &self.hints) {
+                return vm::VmResult::NoMatch;
+            }
+            match dfa.borrow_mut().find(input, start) {
+                dfa::SearchResult::Match { start, end } => {
+                    if self.program.capture_count == 0 {
+                        if out.len() >= 2 {
+                            out[0] = start as i32;
+                            out[1] = end as i32;
+                        }
+                        return vm::VmResult::Match;
+                    }
+                    // The DFA doesn't track captures, so let the backtracker
+                    // fill them in for the match it found.
+                    return vm::execute_anchored_into_with_scratch(&self.program, input, start, &self.hints, out, scratch);
+                }
+                dfa::SearchResult::NoMatch => return vm::VmResult::NoMatch,
+                dfa::SearchResult::GaveUp => {}
+            }
+        }
         vm::execute_into_with_scratch(&self.program, input, start, &self.hints, out, scratch)
     }
 
@@ -156,6 +191,16 @@ impl Regex {
                 vm::VmResult::NoMatch
             };
         }
+        if let Some(ref dfa) = self.dfa {
+            if vm::fails_literal_hints(input, start, &self.hints) {
+                return vm::VmResult::NoMatch;
+            }
+            match dfa.borrow_mut().is_match(input, start) {
+                Some(true) => return vm::VmResult::Match,
+                Some(false) => return vm::VmResult::NoMatch,
+                None => {}
+            }
+        }
         // Reuse cached scratch space for the VM. Only need group 0 for test().
         let mut out = [-1i32; 2];
         let scratch = &mut *self.scratch.borrow_mut();
@@ -183,12 +228,7 @@ impl Regex {
                 let mut pos = start;
                 let end = input.len() - needle_len + 1;
                 while pos < end {
-                    let next = if is_ascii_alpha(first) {
-                        find_ascii_case_insensitive_code_unit(input, pos, end, first)
-                    } else {
-                        input.find_code_unit(pos, end, first)
-                    };
-                    match next {
+                    match input.find_ascii_case_insensitive_code_unit(pos, end, first) {
                         Some(candidate_pos) => pos = candidate_pos,
                         None => return false,
                     }
@@ -224,31 +264,19 @@ impl Regex {
             return false;
         }
 
-        // Case-sensitive: use fast first-character scan + verify.
-        let first = needle[0];
+        // Case-sensitive: use a vectorized scan for the first and last code units, then verify.
         let needle_len = needle.len();
         if start + needle_len > input.len() {
             return false;
         }
-        let mut pos = start;
-        let end = input.len() - needle_len + 1;
-        while pos < end {
-            // Bulk scan for first character.
-            match input.find_code_unit(pos, end, first) {
-                Some(candidate_pos) => pos = candidate_pos,
-                None => return false,
-            }
-            // Verify rest of needle.
-            if input.matches_u16_at(pos, needle) {
-                if out.len() >= 2 {
-                    out[0] = pos as i32;
-                    out[1] = (pos + needle_len) as i32;
-                }
-                return true;
-            }
-            pos += 1;
+        let Some(pos) = input.find_literal(start, input.len() - needle_len + 1, needle) else {
+            return false;
+        };
+        if out.len() >= 2 {
+            out[0] = pos as i32;
+            out[1] = (pos + needle_len) as i32;
         }
-        false
+        true
     }
 
     /// Fast literal test (no captures needed).
@@ -306,7 +334,30 @@ impl Regex {
             return Self::literal_alt_search_ascii_ignore_case(input, start, alts, out);
         }
 
-        for pos in start..input.len() {
+        // With only a few distinct first code units, skip ahead to the next one with a
+        // vectorized scan instead of trying every alternative at every position.
+        let mut first_code_units = [0u16; 3];
+        let mut first_code_unit_count = 0;
+        for alt in alts {
+            if first_code_units[..first_code_unit_count].contains(&alt[0]) {
+                continue;
+            }
+            if first_code_unit_count == first_code_units.len() {
+                first_code_unit_count = 0;
+                break;
+            }
+            first_code_units[first_code_unit_count] = alt[0];
+            first_code_unit_count += 1;
+        }
+
+        let mut pos = start;
+        while pos < input.len() {
+            if first_code_unit_count > 0 {
+                match input.find_any_code_unit(pos, input.len(), &first_code_units[..first_code_unit_count]) {
+                    Some(candidate_pos) => pos = candidate_pos,
+                    None => return false,
+                }
+            }
             let first_ch = input.code_unit(pos);
             for alt in alts {
                 if alt[0] != first_ch {
@@ -324,6 +375,7 @@ impl Regex {
                     return true;
                 }
             }
+            pos += 1;
         }
         false
     }
@@ -556,15 +608,54 @@ impl Regex {
         if let Some(ref alts) = self.literal_alt_u16 {
             return Self::literal_alt_find_all(input, start, alts, &self.flags, result_buf);
         }
+        if let Some(ref dfa) = self.dfa {
+            return self.dfa_find_all(&mut dfa.borrow_mut(), input, start, result_buf);
+        }
         // Use the VM-internal find_all loop which reuses a single VM across matches.
         let scratch = &mut *self.scratch.borrow_mut();
         vm::find_all_with_scratch(&self.program, input, start, &self.hints, result_buf, scratch)
     }
-}
 
-#[inline(always)]
-fn is_ascii_alpha(ch: u16) -> bool {
-    matches!(ch, 0x41..=0x5A | 0x61..=0x7A)
+    /// Find all matches with the lazy DFA, handing the rest of the input to
+    /// the VM if the DFA gives up part way through.
+    fn dfa_find_all<I: vm::Input>(&self, dfa: &mut dfa::LazyDfa, input: I, start: usize, result_buf: &mut [i32]) -> i32 {
+        if vm::fails_literal_hints(input, start, &self.hints) {
+            return 0;
+        }
+
+        let capacity = result_buf.len();
+        let mut count = 0i32;
+        let mut pos = start;
+        loop {
+            if pos > input.len() {
+                break;
+            }
+            match dfa.find(input, pos) {
+                dfa::SearchResult::Match { start, end } => {
+                    let idx = count as usize * 2;
+                    if idx + 1 >= capacity {
+                        return -1;
+                    }
+                    result_buf[idx] = start as i32;
+                    result_buf[idx + 1] = end as i32;
+                    count += 1;
+                    pos = if end == start { end + 1 } else { end };
+                }
+                dfa::SearchResult::NoMatch => break,
+                dfa::SearchResult::GaveUp => {
+                    let scratch = &mut *self.scratch.borrow_mut();
+                    let remaining = &mut result_buf[count as usize * 2..];
+                    let remaining_count =
+                        vm::find_all_with_scratch(&self.program, input, pos, &self.hints, remaining, scratch);
+                    if remaining_count < 0 {
+                        return remaining_count;
+                    }
+                    return count + remaining_count;
+                }
+            }
+        }
+        count
+    }
 }
 
 #[inline(always)]
@@ -580,25 +671,6 @@ fn fold_ascii_for_compare(ch: u16) -> u16 {
     }
 }
 
-#[inline(always)]
-fn find_ascii_case_insensitive_code_unit<I: vm::Input>(
-    input: I,
-    start: usize,
-    end: usize,
-    needle: u16,
-) -> Option<usize> {
-    let folded_needle = fold_ascii_for_compare(needle);
-    let mut pos = start;
-    while pos < end {
-        let code_unit = input.code_unit(pos);
-        if code_unit <= 0x7F && fold_ascii_for_compare(code_unit) == folded_needle {
-            return Some(pos);
-        }
-        pos += 1;
-    }
-    None
-}
-
 #[inline(always)]
 fn find_ascii_case_insensitive_code_unit_in_set<I: vm::Input>(
     input: I,
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+//! Vectorized searches for the code units a match can start with.
+//!
+//! Global searches over long inputs spend most of their time looking for the
+//! next candidate start position. These helpers compare a whole vector of
+//! code units at once (SSE2 on x86-64, NEON on AArch64, both of which are
+//! always available on those targets) and fall back to scalar loops
+//! elsewhere and for the tail of the input.
+//!
+//! Literals are found by checking their first and last code units together,
+//! which rejects most false candidates without looking at the rest of the
+//! needle.
+
+/// A code unit type that the scanner can search through: `u8` for ASCII
+/// input and `u16` for WTF-16 input.
+pub(crate) trait CodeUnit: Copy + Eq {
+    fn from_u16(value: u16) -> Self;
+    fn to_u16(self) -> u16;
+}
+
+impl CodeUnit for u8 {
+    #[inline(always)]
+    fn from_u16(value: u16) -> Self {
+        value as u8
+    }
+
+    #[inline(always)]
+    fn to_u16(self) -> u16 {
+        self as u16
+    }
+}
+
+impl CodeUnit for u16 {
+    #[inline(always)]
+    fn from_u16(value: u16) -> Self {
+        value
+    }
+
+    #[inline(always)]
+    fn to_u16(self) -> u16 {
+        self
+    }
+}
+
+/// Find the first code unit equal to `needle`.
+#[inline(always)]
+pub(crate) fn find<T: Lanes>(haystack: &[T], needle: T) -> Option<usize> {
+    let splat = T::splat(needle);
+    search(haystack, 0, |block| unsafe { T::lanes_eq(T::load(block), splat) }, |pos| haystack[pos] == needle)
+}
+
+/// Find the first code unit equal to any of `needles`, which holds between one
+/// and three code units.
+#[inline(always)]
+pub(crate) fn find_any<T: Lanes>(haystack: &[T], needles: &[T]) -> Option<usize> {
+    match *needles {
+        [a] => find(haystack, a),
+        [a, b] => {
+            let (splat_a, splat_b) = (T::splat(a), T::splat(b));
+            search(
+                haystack,
+                0,
+                |block| unsafe {
+                    let chunk = T::load(block);
+                    T::lanes_or(T::lanes_eq(chunk, splat_a), T::lanes_eq(chunk, splat_b))
+                },
+                |pos| haystack[pos] == a || haystack[pos] == b,
+            )
+        }
+        [a, b, c] => {
+            let (splat_a, splat_b, splat_c) = (T::splat(a), T::splat(b), T::splat(c));
+            search(
+                haystack,
+                0,
+                |block| unsafe {
+                    let chunk = T::load(block);
+                    T::lanes_or(T::lanes_or(T::lanes_eq(chunk, splat_a), T::lanes_eq(chunk, splat_b)), T::lanes_eq(chunk, splat_c))
+                },
+                |pos| haystack[pos] == a || haystack[pos] == b || haystack[pos] == c,
+            )
+        }
+        _ => unreachable!("find_any() takes between one and three needles"),
+    }
+}
+
+/// Find the first code unit that matches the ASCII code unit `needle` when
+/// ignoring ASCII case.
+#[inline(always)]
+pub(crate) fn find_ascii_case_insensitive<T: Lanes>(haystack: &[T], needle: u16) -> Option<usize> {
+    debug_assert!(needle <= 0x7F);
+    if !matches!(needle, 0x41..=0x5A | 0x61..=0x7A) {
+        return find(haystack, T::from_u16(needle));
+    }
+
+    // Setting 0x20 maps ASCII upper case letters onto lower case ones, and can't turn
+    // anything above 0x7F into one.
+    let lower = needle | 0x20;
+    let (case_bit, splat) = (T::splat(T::from_u16(0x20)), T::splat(T::from_u16(lower)));
+    search(
+        haystack,
+        0,
+        |block| unsafe { T::lanes_eq(T::lanes_or(T::load(block), case_bit), splat) },
+        |pos| (haystack[pos].to_u16() | 0x20) == lower,
+    )
+}
+
+/// Find the first position before `end` at which `needle` occurs. The
+/// haystack must extend at least `needle.len() - 1` code units past `end`,
+/// and every code unit of `needle` must be representable as a `T`.
+#[inline(always)]
+pub(crate) fn find_literal<T: Lanes>(haystack: &[T], end: usize, needle: &[u16]) -> Option<usize> {
+    let [first, .., last] = *needle else {
+        return match *needle {
+            [only] => find(&haystack[..end], T::from_u16(only)),
+            _ => (end > 0).then_some(0),
+        };
+    };
+
+    let last_offset = needle.len() - 1;
+    let haystack = &haystack[..end + last_offset];
+    let (first, last) = (T::from_u16(first), T::from_u16(last));
+    let (splat_first, splat_last) = (T::splat(first), T::splat(last));
+    let mut pos = 0;
+    while pos < end {
+        let candidate = pos
+            + search(
+                &haystack[pos..],
+                last_offset,
+                |block| unsafe {
+                    T::lanes_and(T::lanes_eq(T::load(block), splat_first), T::lanes_eq(T::load(block.add(last_offset)), splat_last))
+                },
+                |offset| haystack[pos + offset] == first && haystack[pos + offset + last_offset] == last,
+            )?;
+        let middle = &haystack[candidate + 1..candidate + last_offset];
+        if middle.iter().zip(&needle[1..last_offset]).all(|(actual, expected)| actual.to_u16() == *expected) {
+            return Some(candidate);
+        }
+        pos = candidate + 1;
+    }
+    None
+}
+
+/// Scan `haystack` a vector at a time using `block_matches`, and finish the
+/// positions that don't fill a whole vector with `matches_at`. `reach` is how
+/// many code units past a position the checks look at.
+#[inline(always)]
+fn search<T: Lanes>(
+    haystack: &[T],
+    reach: usize,
+    block_matches: impl Fn(*const T) -> T::Vector,
+    matches_at: impl Fn(usize) -> bool,
+) -> Option<usize> {
+    let Some(end) = haystack.len().checked_sub(reach) else {
+        return None;
+    };
+
+    let mut pos = 0;
+    if T::LANES > 1 {
+        while pos + T::LANES <= end {
+            // SAFETY: `pos + T::LANES + reach` is within the haystack.
+            let mask = T::mask(block_matches(unsafe { haystack.as_ptr().add(pos) }));
+            if mask != 0 {
+                return Some(pos + (mask.trailing_zeros() / T::MASK_BITS_PER_LANE) as usize);
+            }
+            pos += T::LANES;
+        }
+    }
+
+    (pos..end).find(|&pos| matches_at(pos))
+}
+
+/// Vector operations over one register's worth of code units. `mask()` turns a
+/// comparison result into a bitmask with `MASK_BITS_PER_LANE` bits per lane,
+/// lowest lane first.
+pub(crate) trait Lanes: CodeUnit {
+    type Vector: Copy;
+    const LANES: usize;
+    const MASK_BITS_PER_LANE: u32;
+
+    /// # Safety
+    /// `ptr` must point to at least `LANES` readable code units.
+    unsafe fn load(ptr: *const Self) -> Self::Vector;
+    fn splat(value: Self) -> Self::Vector;
+    fn lanes_eq(a: Self::Vector, b: Self::Vector) -> Self::Vector;
+    fn lanes_or(a: Self::Vector, b: Self::Vector) -> Self::Vector;
+    fn lanes_and(a: Self::Vector, b: Self::Vector) -> Self::Vector;
+    fn mask(vector: Self::Vector) -> u64;
+}
+
+#[cfg(target_arch = "x86_64")]
+mod arch {
+    use super::Lanes;
+    use std::arch::x86_64::*;
+
+    // SAFETY: SSE2 is part of the x86-64 baseline.
+
+    impl Lanes for u8 {
+        type Vector = __m128i;
+        const LANES: usize = 16;
+        const MASK_BITS_PER_LANE: u32 = 1;
+
+        #[inline(always)]
+        unsafe fn load(ptr: *const Self) -> Self::Vector {
+            unsafe { _mm_loadu_si128(ptr.cast()) }
+        }
+
+        #[inline(always)]
+        fn splat(value: Self) -> Self::Vector {
+            unsafe { _mm_set1_epi8(value as i8) }
+        }
+
+        #[inline(always)]
+        fn lanes_eq(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { _mm_cmpeq_epi8(a, b) }
+        }
+
+        #[inline(always)]
+        fn lanes_or(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { _mm_or_si128(a, b) }
+        }
+
+        #[inline(always)]
+        fn lanes_and(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { _mm_and_si128(a, b) }
+        }
+
+        #[inline(always)]
+        fn mask(vector: Self::Vector) -> u64 {
+            unsafe { _mm_movemask_epi8(vector) as u32 as u64 }
+        }
+    }
+
+    impl Lanes for u16 {
+        type Vector = __m128i;
+        const LANES: usize = 8;
+        // There's no 16-bit movemask, so each lane contributes both of its bytes.
+        const MASK_BITS_PER_LANE: u32 = 2;
+
+        #[inline(always)]
+        unsafe fn load(ptr: *const Self) -> Self::Vector {
+            unsafe { _mm_loadu_si128(ptr.cast()) }
+        }
+
+        #[inline(always)]
+        fn splat(value: Self) -> Self::Vector {
+            unsafe { _mm_set1_epi16(value as i16) }
+        }
+
+        #[inline(always)]
+        fn lanes_eq(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { _mm_cmpeq_epi16(a, b) }
+        }
+
+        #[inline(always)]
+        fn lanes_or(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { _mm_or_si128(a, b) }
+        }
+
+        #[inline(always)]
+        fn lanes_and(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { _mm_and_si128(a, b) }
+        }
+
+        #[inline(always)]
+        fn mask(vector: Self::Vector) -> u64 {
+            unsafe { _mm_movemask_epi8(vector) as u32 as u64 }
+        }
+    }
+}
+
+#[cfg(target_arch = "aarch64")]
+mod arch {
+    use super::Lanes;
+    use std::arch::aarch64::*;
+
+    // SAFETY: NEON is part of the AArch64 baseline.
+
+    impl Lanes for u8 {
+        type Vector = uint8x16_t;
+        const LANES: usize = 16;
+        // NEON has no movemask; narrowing each 16-bit pair by 4 bits leaves a nibble per lane.
+        const MASK_BITS_PER_LANE: u32 = 4;
+
+        #[inline(always)]
+        unsafe fn load(ptr: *const Self) -> Self::Vector {
+            unsafe { vld1q_u8(ptr) }
+        }
+
+        #[inline(always)]
+        fn splat(value: Self) -> Self::Vector {
+            unsafe { vdupq_n_u8(value) }
+        }
+
+        #[inline(always)]
+        fn lanes_eq(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { vceqq_u8(a, b) }
+        }
+
+        #[inline(always)]
+        fn lanes_or(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { vorrq_u8(a, b) }
+        }
+
+        #[inline(always)]
+        fn lanes_and(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { vandq_u8(a, b) }
+        }
+
+        #[inline(always)]
+        fn mask(vector: Self::Vector) -> u64 {
+            unsafe { vget_lane_u64::<0>(vreinterpret_u64_u8(vshrn_n_u16::<4>(vreinterpretq_u16_u8(vector)))) }
+        }
+    }
+
+    impl Lanes for u16 {
+        type Vector = uint16x8_t;
+        const LANES: usize = 8;
+        const MASK_BITS_PER_LANE: u32 = 8;
+
+        #[inline(always)]
+        unsafe fn load(ptr: *const Self) -> Self::Vector {
+            unsafe { vld1q_u16(ptr) }
+        }
+
+        #[inline(always)]
+        fn splat(value: Self) -> Self::Vector {
+            unsafe { vdupq_n_u16(value) }
+        }
+
+        #[inline(always)]
+        fn lanes_eq(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { vceqq_u16(a, b) }
+        }
+
+        #[inline(always)]
+        fn lanes_or(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { vorrq_u16(a, b) }
+        }
+
+        #[inline(always)]
+        fn lanes_and(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+            unsafe { vandq_u16(a, b) }
+        }
+
+        #[inline(always)]
+        fn mask(vector: Self::Vector) -> u64 {
+            unsafe { vget_lane_u64::<0>(vreinterpret_u64_u8(vmovn_u16(vector))) }
+        }
+    }
+}
+
+#[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+mod arch {
+    use super::Lanes;
+
+    // Without a vector unit, every position goes through the scalar path in search().
+
+    macro_rules! scalar_lanes {
+        ($type:ty) => {
+            impl Lanes for $type {
+                type Vector = $type;
+                const LANES: usize = 1;
+                const MASK_BITS_PER_LANE: u32 = 1;
+
+                #[inline(always)]
+                unsafe fn load(ptr: *const Self) -> Self::Vector {
+                    unsafe { *ptr }
+                }
+
+                #[inline(always)]
+                fn splat(value: Self) -> Self::Vector {
+                    value
+                }
+
+                #[inline(always)]
+                fn lanes_eq(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+                    if a == b { <$type>::MAX } else { 0 }
+                }
+
+                #[inline(always)]
+                fn lanes_or(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+                    a | b
+                }
+
+                #[inline(always)]
+                fn lanes_and(a: Self::Vector, b: Self::Vector) -> Self::Vector {
+                    a & b
+                }
+
+                #[inline(always)]
+                fn mask(vector: Self::Vector) -> u64 {
+                    (vector != 0) as u64
+                }
+            }
+        };
+    }
+
+    scalar_lanes!(u8);
+    scalar_lanes!(u16);
+}
@@ -13,6 +13,7 @@
 //! - <https://tc39.es/ecma262/#sec-pattern-semantics>
 //! - <https://tc39.es/ecma262/#sec-regexpbuiltinexec>
 use crate::bytecode::*;
+use crate::scan;
 
 /// Maximum number of steps before aborting (prevents ReDoS).
 const MATCH_LIMIT: u64 = 10_000_000;
@@ -46,6 +47,35 @@ pub trait Input: Copy {
         None
     }
 
+    #[inline(always)]
+    fn find_any_code_unit(self, start: usize, end: usize, needles: &[u16]) -> Option<usize> {
+        (start..end).find(|&pos| needles.contains(&self.code_unit(pos)))
+    }
+
+    #[inline(always)]
+    fn find_ascii_case_insensitive_code_unit(self, start: usize, end: usize, needle: u16) -> Option<usize> {
+        let folded_needle = fold_ascii_for_compare(needle);
+        (start..end).find(|&pos| {
+            let code_unit = self.code_unit(pos);
+            code_unit <= 0x7F && fold_ascii_for_compare(code_unit) == folded_needle
+        })
+    }
+
+    /// Find the first position in `start..end` at which `needle` occurs. The
+    /// input must extend at least `needle.len() - 1` code units past `end`.
+    #[inline(always)]
+    fn find_literal(self, start: usize, end: usize, needle: &[u16]) -> Option<usize> {
+        let mut pos = start;
+        while pos < end {
+            pos = self.find_code_unit(pos, end, *needle.first()?)?;
+            if self.matches_u16_at(pos, needle) {
+                return Some(pos);
+            }
+            pos += 1;
+        }
+        None
+    }
+
     #[inline(always)]
     fn next_literal_start(self, start_pos: usize, ch16: u16) -> Option<usize> {
         self.find_code_unit(start_pos, self.len(), ch16)
@@ -99,8 +129,27 @@ impl Input for &[u16] {
 
     #[inline(always)]
     fn find_code_unit(self, start: usize, end: usize, ch16: u16) -> Option<usize> {
-        let offset = self.get(start..end)?.iter().position(|&c| c == ch16)?;
-        Some(start + offset)
+        Some(start + scan::find(self.get(start..end)?, ch16)?)
+    }
+
+    #[inline(always)]
+    fn find_any_code_unit(self, start: usize, end: usize, needles: &[u16]) -> Option<usize> {
+        Some(start + scan::find_any(self.get(start..end)?, needles)?)
+    }
+
+    #[inline(always)]
+    fn find_ascii_case_insensitive_code_unit(self, start: usize, end: usize, needle: u16) -> Option<usize> {
+        if needle > 0x7F {
+            return None;
+        }
+        Some(start + scan::find_ascii_case_insensitive(self.get(start..end)?, needle)?)
+    }
+
+    #[inline(always)]
+    fn find_literal(self, start: usize, end: usize, needle: &[u16]) -> Option<usize> {
+        let candidate_count = end.checked_sub(start)?;
+        let haystack = self.get(start..end + needle.len().saturating_sub(1))?;
+        Some(start + scan::find_literal(haystack, candidate_count, needle)?)
     }
 
     #[inline(always)]
@@ -132,12 +181,44 @@ impl Input for &[u8] {
 
     #[inline(always)]
     fn find_code_unit(self, start: usize, end: usize, ch16: u16) -> Option<usize> {
-        let byte = u8::try_from(ch16).ok()?;
-        if byte > 0x7F {
+        if ch16 > 0x7F {
             return None;
         }
-        let offset = self.get(start..end)?.iter().position(|&c| c == byte)?;
-        Some(start + offset)
+        Some(start + scan::find(self.get(start..end)?, ch16 as u8)?)
+    }
+
+    #[inline(always)]
+    fn find_any_code_unit(self, start: usize, end: usize, needles: &[u16]) -> Option<usize> {
+        let mut bytes = [0u8; 3];
+        let mut byte_count = 0;
+        for &needle in needles {
+            if needle <= 0x7F {
+                bytes[byte_count] = needle as u8;
+                byte_count += 1;
+            }
+        }
+        if byte_count == 0 {
+            return None;
+        }
+        Some(start + scan::find_any(self.get(start..end)?, &bytes[..byte_count])?)
+    }
+
+    #[inline(always)]
+    fn find_ascii_case_insensitive_code_unit(self, start: usize, end: usize, needle: u16) -> Option<usize> {
+        if needle > 0x7F {
+            return None;
+        }
+        Some(start + scan::find_ascii_case_insensitive(self.get(start..end)?, needle)?)
+    }
+
+    #[inline(always)]
+    fn find_literal(self, start: usize, end: usize, needle: &[u16]) -> Option<usize> {
+        if needle.iter().any(|&code_unit| code_unit > 0x7F) {
+            return None;
+        }
+        let candidate_count = end.checked_sub(start)?;
+        let haystack = self.get(start..end + needle.len().saturating_sub(1))?;
+        Some(start + scan::find_literal(haystack, candidate_count, needle)?)
     }
 
     #[inline(always)]
@@ -289,27 +370,11 @@ fn contains_u16_from<I: Input>(input: I, start: usize, needle: &[u16]) -> bool {
         return true;
     }
 
-    if needle.len() == 1 {
-        return input.find_code_unit(start, input.len(), needle[0]).is_some();
-    }
-
     if start + needle.len() > input.len() {
         return false;
     }
 
-    let mut pos = start;
-    let end = input.len() - needle.len() + 1;
-    while pos < end {
-        match input.find_code_unit(pos, end, needle[0]) {
-            Some(candidate_pos) => pos = candidate_pos,
-            None => return false,
-        }
-        if input.matches_u16_at(pos, needle) {
-            return true;
-        }
-        pos += 1;
-    }
-    false
+    input.find_literal(start, input.len() - needle.len() + 1, needle).is_some()
 }
 
 #[inline(always)]
@@ -331,19 +396,12 @@ fn contains_ascii_case_insensitive_u16_from<I: Input>(input: I, start: usize, ne
         return false;
     }
 
-    let folded_first = fold_ascii_for_compare(needle[0]);
     let mut pos = start;
     let end = input.len() - needle_len + 1;
     while pos < end {
-        while pos < end {
-            let code_unit = input.code_unit(pos);
-            if code_unit <= 0x7F && fold_ascii_for_compare(code_unit) == folded_first {
-                break;
-            }
-            pos += 1;
-        }
-        if pos >= end {
-            return false;
+        match input.find_ascii_case_insensitive_code_unit(pos, end, needle[0]) {
+            Some(candidate_pos) => pos = candidate_pos,
+            None => return false,
         }
         if matches_ascii_case_insensitive_u16_at(input, pos, needle) {
             return true;
@@ -891,6 +949,53 @@ fn match_simple_match(matcher: &SimpleMatch, cp: u32) -> bool {
     }
 }
 
+/// Match a single code point against a SimpleMatch under fixed flags, with the
+/// same semantics as the corresponding character-matching instruction.
+#[inline(always)]
+pub(crate) fn match_simple_with_flags(
+    cp: u32,
+    matcher: &SimpleMatch,
+    ignore_case: bool,
+    dot_all: bool,
+    unicode: bool,
+    unicode_sets: bool,
+) -> bool {
+    match matcher {
+        SimpleMatch::AnyChar { dot_all: matcher_dot_all } => *matcher_dot_all || dot_all || !is_line_terminator(cp),
+        SimpleMatch::Char(c) => {
+            if ignore_case {
+                case_fold_eq(cp, *c, unicode)
+            } else {
+                cp == *c
+            }
+        }
+        SimpleMatch::CharNoCase(lo, _hi) => case_fold_eq(cp, *lo, unicode),
+        SimpleMatch::CharClass { ranges, negated } => {
+            let in_class = match_char_class(cp, ranges, ignore_case, unicode, unicode_sets);
+            in_class != *negated
+        }
+        SimpleMatch::BuiltinClass(class) => match_builtin_class(cp, *class, ignore_case && unicode),
+        SimpleMatch::UnicodeProperty(data) => {
+            if ignore_case && unicode {
+                if data.negated && !unicode_sets {
+                    !match_unicode_property_all_case_equivalents(cp, &data.name, data.value.as_deref())
+                } else {
+                    let matched = match_unicode_property_case_insensitive(cp, &data.name, data.value.as_deref());
+                    if data.negated { !matched } else { matched }
+                }
+            } else {
+                let matched =
+                    match_unicode_property_resolved(cp, &data.name, data.value.as_deref(), data.resolved.as_ref());
+                matched != data.negated
+            }
+        }
+        SimpleMatch::Union(lhs, rhs) => {
+            match_simple_with_flags(cp, lhs, ignore_case, dot_all, unicode, unicode_sets)
+                || match_simple_with_flags(cp, rhs, ignore_case, dot_all, unicode, unicode_sets)
+        }
+    }
+}
+
 /// Decode a code point at a position, handling surrogate pairs in unicode mode.
 #[inline(always)]
 pub(crate) fn decode_code_point<I: Input>(unicode: bool, input: I, pos: usize) -> u32 {
@@ -989,6 +1094,21 @@ pub struct PatternHints {
     can_match_empty: bool,
 }
 
+impl PatternHints {
+    /// Whether the backtracker already runs in linear time for this pattern,
+    /// either because it is a single scanned matcher or because it is only
+    /// ever tried at the start of the input.
+    pub(crate) fn has_linear_fast_path(&self) -> bool {
+        self.simple_scan.is_some() || (self.starts_with_anchor && !self.anchor_multiline)
+    }
+}
+
+/// Whether a literal the pattern requires is missing from the input, so no
+/// match can start at or after `start`.
+pub(crate) fn fails_literal_hints<I: Input>(input: I, start: usize, hints: &PatternHints) -> bool {
+    fails_trailing_literal_hint(input, hints) || fails_required_literal_hint(input, start, hints)
+}
+
 pub(crate) struct RequiredLiteralHint {
     pub literal: Vec<u16>,
     pub ascii_case_insensitive: bool,
@@ -3014,48 +3134,14 @@ impl<'a, I: Input> Vm<'a, I> {
     /// Check if a code point matches a SimpleMatch.
     #[inline(always)]
     fn match_simple(&self, cp: u32, matcher: &SimpleMatch) -> bool {
-        match matcher {
-            SimpleMatch::AnyChar { dot_all } => {
-                let dot_all = *dot_all || self.modifiers.dot_all;
-                dot_all || !is_line_terminator(cp)
-            }
-            SimpleMatch::Char(c) => {
-                if self.modifiers.ignore_case {
-                    case_fold_eq(cp, *c, self.program.unicode)
-                } else {
-                    cp == *c
-                }
-            }
-            SimpleMatch::CharNoCase(lo, _hi) => case_fold_eq(cp, *lo, self.program.unicode),
-            SimpleMatch::CharClass { ranges, negated } => {
-                let in_class = match_char_class(
-                    cp,
-                    ranges,
-                    self.modifiers.ignore_case,
-                    self.program.unicode,
-                    self.program.unicode_sets,
-                );
-                in_class != *negated
-            }
-            SimpleMatch::BuiltinClass(class) => {
-                match_builtin_class(cp, *class, self.modifiers.ignore_case && self.program.unicode)
-            }
-            SimpleMatch::UnicodeProperty(data) => {
-                if self.modifiers.ignore_case && self.program.unicode {
-                    if data.negated && !self.program.unicode_sets {
-                        !match_unicode_property_all_case_equivalents(cp, &data.name, data.value.as_deref())
-                    } else {
-                        let matched = match_unicode_property_case_insensitive(cp, &data.name, data.value.as_deref());
-                        if data.negated { !matched } else { matched }
-                    }
-                } else {
-                    let matched =
-                        match_unicode_property_resolved(cp, &data.name, data.value.as_deref(), data.resolved.as_ref());
-                    matched != data.negated
-                }
-            }
-            SimpleMatch::Union(lhs, rhs) => self.match_simple(cp, lhs) || self.match_simple(cp, rhs),
-        }
+        match_simple_with_flags(
+            cp,
+            matcher,
+            self.modifiers.ignore_case,
+            self.modifiers.dot_all,
+            self.program.unicode,
+            self.program.unicode_sets,
+        )
     }
 
     /// Move position back by one character (handling surrogate pairs in unicode mode).
@@ -3449,7 +3535,7 @@ pub(crate) fn case_fold_eq(a: u32, b: u32, unicode_mode: bool) -> bool {
 }
 
 #[inline(always)]
-fn is_word_char(cp: u32) -> bool {
+pub(crate) fn is_word_char(cp: u32) -> bool {
     matches!(cp, 0x30..=0x39 | 0x41..=0x5A | 0x61..=0x7A | 0x5F)
 }
 
@@ -87,7 +87,14 @@ void Request::set_body_delivery_paused(bool paused)
 {
     m_body_delivery_paused = paused;
     if (m_internal_stream_data && m_internal_stream_data->read_notifier)
-        m_internal_stream_data->read_notifier->set_enabled(!m_body_delivery_paused);
+        m_internal_stream_data->read_notifier->set_enabled(should_read_body());
+}
+
+void Request::set_body_delivery_throttled(bool throttled)
+{
+    m_body_delivery_throttled = throttled;
+    if (m_internal_stream_data && m_internal_stream_data->read_notifier)
+        m_internal_stream_data->read_notifier->set_enabled(should_read_body());
 }
 
 void Request::resume_body_delivery()
@@ -136,7 +143,7 @@ void Request::attach_read_stream()
     m_fd_is_owned_by_read_stream = true;
     auto notifier = read_stream->notifier();
     notifier->on_activation = move(m_internal_stream_data->read_notifier->on_activation);
-    notifier->set_enabled(!m_body_delivery_paused);
+    notifier->set_enabled(should_read_body());
     m_internal_stream_data->read_notifier = notifier;
     m_internal_stream_data->read_stream = move(read_stream);
 }
@@ -261,6 +268,12 @@ void Request::did_receive_headers(Badge<RequestClient>, NonnullRefPtr<HTTP::Head
         on_headers_received(move(response_headers), response_code, reason_phrase, move(javascript_bytecode), javascript_bytecode_cache_vary_key, came_from_cache);
 }
 
+void Request::did_receive_early_hints(Badge<RequestClient>, NonnullRefPtr<HTTP::HeaderList> response_headers)
+{
+    if (on_early_hints_received)
+        on_early_hints_received(move(response_headers));
+}
+
 void Request::did_request_certificates(Badge<RequestClient>)
 {
     if (on_certificate_requested) {
@@ -302,7 +315,7 @@ void Request::set_up_internal_stream_data(DataReceived on_data_available)
     m_internal_stream_data = make<InternalStreamData>();
     m_internal_stream_data->on_data_available = move(on_data_available);
     m_internal_stream_data->read_notifier = Core::Notifier::construct(fd(), Core::Notifier::Type::Read);
-    m_internal_stream_data->read_notifier->set_enabled(!m_body_delivery_paused);
+    m_internal_stream_data->read_notifier->set_enabled(should_read_body());
     attach_read_stream();
 
     auto user_on_finish = move(on_finish);
@@ -371,6 +384,9 @@ void Request::set_up_internal_stream_data(DataReceived on_data_available)
                 }
                 *m_internal_stream_data->body_delivery_remaining_byte_count -= read_bytes.size();
             }
+
+            if (m_body_delivery_throttled)
+                break;
         } while (true);
 
         if (m_internal_stream_data->read_stream->is_eof())
@@ -95,6 +95,10 @@ public:
     void set_body_delivery_paused(bool);
     void resume_body_delivery();
     void resume_body_delivery_up_to(size_t);
+
+    // Stops reading the response body while its consumer catches up, independently of body delivery being paused.
+    // RequestServer stops reading from the network once the pipe between us is full.
+    void set_body_delivery_throttled(bool);
     void release_for_transfer();
     [[nodiscard]] bool has_file_backed_response_body() const;
 
@@ -117,8 +121,12 @@ public:
 
     Function<CertificateAndKey()> on_certificate_requested;
 
+    // Invoked with the headers of each 103 (Early Hints) interim response received before the final response.
+    Function<void(NonnullRefPtr<HTTP::HeaderList> response_headers)> on_early_hints_received;
+
     void did_finish(Badge<RequestClient>, u64 total_size, RequestTimingInfo const& timing_info, Optional<NetworkError> const& network_error);
     void did_receive_headers(Badge<RequestClient>, NonnullRefPtr<HTTP::HeaderList> response_headers, Optional<u32> response_code, Optional<String> const& reason_phrase, Optional<Core::ImmutableBytes> javascript_bytecode, Optional<u64> javascript_bytecode_cache_vary_key, CameFromCache came_from_cache);
+    void did_receive_early_hints(Badge<RequestClient>, NonnullRefPtr<HTTP::HeaderList> response_headers);
     void did_request_certificates(Badge<RequestClient>);
     void did_transfer(Badge<RequestClient>);
 
@@ -133,6 +141,7 @@ private:
     void attach_read_stream();
     void set_up_internal_stream_data(DataReceived on_data_available);
     void defer_teardown();
+    bool should_read_body() const { return !m_body_delivery_paused && !m_body_delivery_throttled; }
 
     WeakPtr<RequestClient> m_client;
     u64 m_request_id { 0 };
@@ -187,6 +196,7 @@ private:
     OwnPtr<InternalStreamData> m_internal_stream_data;
     Optional<NetworkError> m_body_delivery_error;
     bool m_body_delivery_paused { false };
+    bool m_body_delivery_throttled { false };
 };
 
 }
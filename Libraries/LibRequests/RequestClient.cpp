@@ -5,6 +5,7 @@
  */
 
 #include <AK/ScopeGuard.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Promise.h>
 #include <LibCore/System.h>
@@ -13,6 +14,8 @@
 
 namespace Requests {
 
+static constexpr size_t REQUEST_BODY_SHARED_MEMORY_THRESHOLD = 1 * MiB;
+
 static Optional<Core::ImmutableBytes> map_javascript_bytecode_file(int fd, u64 size)
 {
     ArmedScopeGuard close_fd = [fd] {
@@ -53,10 +56,19 @@ void RequestClient::die()
         promise->reject(Error::from_string_literal("RequestServer process died"));
 
     auto websockets = move(m_websockets);
+    auto shared_javascript_bytecode_retrievals = move(m_pending_shared_javascript_bytecode_retrievals);
+    auto decompressed_font_retrievals = move(m_pending_decompressed_font_retrievals);
 
     m_requests.clear();
     m_pending_cache_size_estimations.clear();
     m_websockets.clear();
+    m_pending_shared_javascript_bytecode_retrievals.clear();
+    m_pending_decompressed_font_retrievals.clear();
+
+    for (auto& [id, on_complete] : shared_javascript_bytecode_retrievals)
+        on_complete({});
+    for (auto& [id, on_complete] : decompressed_font_retrievals)
+        on_complete({});
 
     for (auto& [id, websocket] : websockets) {
         auto ready_state = websocket->ready_state();
@@ -77,12 +89,31 @@ void RequestClient::die()
     }
 }
 
-RefPtr<Request> RequestClient::start_request(ByteString const& method, URL::URL const& url, Optional<HTTP::HeaderList const&> request_headers, ReadonlyBytes request_body, HTTP::CacheMode cache_mode, HTTP::Cookie::IncludeCredentials include_credentials, Core::ProxyData const& proxy_data, KeepAliveForTransfer keep_alive_for_transfer)
+RefPtr<Request> RequestClient::start_request(ByteString const& method, URL::URL const& url, Optional<HTTP::HeaderList const&> request_headers, ReadonlyBytes request_body, HTTP::CacheMode cache_mode, HTTP::Cookie::IncludeCredentials include_credentials, Core::ProxyData const& proxy_data, KeepAliveForTransfer keep_alive_for_transfer, HTTP::Priority priority, Optional<ByteString> const& network_partition)
 {
     auto request_id = m_next_request_id++;
     auto headers = request_headers.map([](auto const& headers) { return headers.headers().span(); }).value_or({});
 
-    IPCProxy::async_start_request(request_id, method, url, headers, request_body, cache_mode, include_credentials, proxy_data, keep_alive_for_transfer == KeepAliveForTransfer::Yes);
+    // OPTIMIZATION: Large bodies (e.g. file uploads) are handed to RequestServer in shared memory, which it uploads from
+    //               directly, rather than being copied into the IPC message and then out of it again.
+    if (request_body.size() >= REQUEST_BODY_SHARED_MEMORY_THRESHOLD) {
+        auto buffer_or_error = [&]() -> ErrorOr<Core::AnonymousBuffer> {
+            auto buffer = TRY(Core::AnonymousBuffer::create_with_size(request_body.size()));
+            memcpy(buffer.data<void>(), request_body.data(), request_body.size());
+            // NB: RequestServer uploads straight from the mapping, so it must not be possible to shrink it underneath.
+            TRY(buffer.seal());
+            return buffer;
+        }();
+        if (!buffer_or_error.is_error()) {
+            IPCProxy::async_start_request_with_shared_body(request_id, method, url, headers, buffer_or_error.release_value(), cache_mode, include_credentials, proxy_data, priority, keep_alive_for_transfer == KeepAliveForTransfer::Yes, network_partition);
+        } else {
+            dbgln("RequestClient::start_request: failed to set up shared buffer for {} bytes: {}", request_body.size(), buffer_or_error.error());
+            IPCProxy::async_start_request(request_id, method, url, headers, request_body, cache_mode, include_credentials, proxy_data, priority, keep_alive_for_transfer == KeepAliveForTransfer::Yes, network_partition);
+        }
+    } else {
+        IPCProxy::async_start_request(request_id, method, url, headers, request_body, cache_mode, include_credentials, proxy_data, priority, keep_alive_for_transfer == KeepAliveForTransfer::Yes, network_partition);
+    }
+
     auto request = Request::create_from_id({}, *this, request_id);
     m_requests.set(request_id, request);
     return request;
@@ -118,6 +149,73 @@ ErrorOr<bool> RequestClient::create_synthetic_cache_entry(URL::URL const& url, B
     return IPCProxy::create_synthetic_cache_entry(url, method);
 }
 
+ErrorOr<void> RequestClient::store_shared_javascript_bytecode(StringView partition, ReadonlyBytes source_hash, ReadonlyBytes data)
+{
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(data.size()));
+    memcpy(buffer.data<void>(), data.data(), data.size());
+
+    async_store_shared_javascript_bytecode(partition, TRY(ByteBuffer::copy(source_hash)), move(buffer));
+    return {};
+}
+
+void RequestClient::retrieve_shared_javascript_bytecode(StringView partition, ReadonlyBytes source_hash, Function<void(Optional<Core::ImmutableBytes>)> on_complete)
+{
+    auto hash = ByteBuffer::copy(source_hash);
+    if (hash.is_error()) {
+        on_complete({});
+        return;
+    }
+
+    auto retrieval_id = m_next_shared_javascript_bytecode_retrieval_id++;
+    m_pending_shared_javascript_bytecode_retrievals.set(retrieval_id, move(on_complete));
+
+    async_retrieve_shared_javascript_bytecode(retrieval_id, partition, hash.release_value());
+}
+
+void RequestClient::retrieved_shared_javascript_bytecode(u64 retrieval_id, Optional<IPC::File> file, u64 size)
+{
+    auto on_complete = m_pending_shared_javascript_bytecode_retrievals.take(retrieval_id);
+    if (!on_complete.has_value())
+        return;
+
+    if (!file.has_value()) {
+        (*on_complete)({});
+        return;
+    }
+    (*on_complete)(map_javascript_bytecode_file(file->take_fd(), size));
+}
+
+ErrorOr<void> RequestClient::store_decompressed_font(StringView partition, ReadonlyBytes font_hash, ReadonlyBytes data)
+{
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(data.size()));
+    memcpy(buffer.data<void>(), data.data(), data.size());
+    // NB: RequestServer writes the font to disk straight from the mapping, so it must not be possible to shrink it underneath.
+    TRY(buffer.seal());
+
+    async_store_decompressed_font(partition, TRY(ByteBuffer::copy(font_hash)), move(buffer));
+    return {};
+}
+
+void RequestClient::retrieve_decompressed_font(StringView partition, ReadonlyBytes font_hash, Function<void(Optional<Core::AnonymousBuffer>)> on_complete)
+{
+    auto hash = ByteBuffer::copy(font_hash);
+    if (hash.is_error()) {
+        on_complete({});
+        return;
+    }
+
+    auto retrieval_id = m_next_decompressed_font_retrieval_id++;
+    m_pending_decompressed_font_retrievals.set(retrieval_id, move(on_complete));
+
+    async_retrieve_decompressed_font(retrieval_id, partition, hash.release_value());
+}
+
+void RequestClient::retrieved_decompressed_font(u64 retrieval_id, Optional<Core::AnonymousBuffer> data)
+{
+    if (auto on_complete = m_pending_decompressed_font_retrievals.take(retrieval_id); on_complete.has_value())
+        (*on_complete)(move(data));
+}
+
 bool RequestClient::stop_request(Badge<Request>, Request& request)
 {
     auto stopped_request = m_requests.take(request.id());
@@ -135,10 +233,10 @@ void RequestClient::release_request_for_transfer(Badge<Request>, Request& reques
     async_release_request_for_transfer(request.id());
 }
 
-void RequestClient::ensure_connection(URL::URL const& url, RequestServer::CacheLevel cache_level)
+void RequestClient::ensure_connection(URL::URL const& url, RequestServer::CacheLevel cache_level, Optional<ByteString> const& network_partition)
 {
     auto request_id = m_next_request_id++;
-    async_ensure_connection(request_id, url, cache_level);
+    async_ensure_connection(request_id, url, cache_level, network_partition);
 }
 
 bool RequestClient::set_certificate(Badge<Request>, Request& request, ByteString certificate, ByteString key)
@@ -222,6 +320,12 @@ void RequestClient::headers_became_available(u64 request_id, Vector<HTTP::Header
         warnln("Received headers for non-existent request {}", request_id);
 }
 
+void RequestClient::request_early_hints_received(u64 request_id, Vector<HTTP::Header> response_headers)
+{
+    if (auto request = m_requests.get(request_id); request.has_value())
+        (*request)->did_receive_early_hints({}, HTTP::HeaderList::create(move(response_headers)));
+}
+
 void RequestClient::request_transferred(u64 request_id)
 {
     auto request = m_requests.take(request_id);
@@ -262,10 +366,27 @@ void RequestClient::websocket_connected(u64 websocket_id)
         (*connection)->did_open({});
 }
 
-void RequestClient::websocket_received(u64 websocket_id, bool is_text, ByteBuffer data)
+void RequestClient::websocket_received(u64 websocket_id, Vector<WebSocket::Message> messages)
 {
     if (auto connection = m_websockets.get(websocket_id); connection.has_value())
-        (*connection)->did_receive({}, move(data), is_text);
+        (*connection)->did_receive({}, move(messages));
+}
+
+void RequestClient::websocket_received_shared(u64 websocket_id, bool is_text, Core::AnonymousBuffer data)
+{
+    auto connection = m_websockets.get(websocket_id);
+    if (!connection.has_value())
+        return;
+
+    auto byte_buffer_or_error = ByteBuffer::copy(data.bytes());
+    if (byte_buffer_or_error.is_error()) {
+        dbgln("websocket_received_shared: failed to copy {} bytes from shared buffer: {}", data.size(), byte_buffer_or_error.error());
+        return;
+    }
+
+    Vector<WebSocket::Message> messages;
+    messages.append({ byte_buffer_or_error.release_value(), is_text });
+    (*connection)->did_receive({}, move(messages));
 }
 
 void RequestClient::websocket_errored(u64 websocket_id, i32 message)
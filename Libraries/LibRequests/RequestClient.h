@@ -8,10 +8,12 @@
 
 #include <AK/HashMap.h>
 #include <LibCore/AnonymousBuffer.h>
+#include <LibCore/ImmutableBytes.h>
 #include <LibHTTP/Cache/CacheMode.h>
 #include <LibHTTP/Cache/Utilities.h>
 #include <LibHTTP/Cookie/IncludeCredentials.h>
 #include <LibHTTP/HeaderList.h>
+#include <LibHTTP/Priority.h>
 #include <LibIPC/ConnectionToServer.h>
 #include <LibRequests/CacheSizes.h>
 #include <LibRequests/CameFromCache.h>
@@ -42,11 +44,11 @@ public:
     explicit RequestClient(NonnullOwnPtr<IPC::Transport>);
     virtual ~RequestClient() override;
 
-    RefPtr<Request> start_request(ByteString const& method, URL::URL const&, Optional<HTTP::HeaderList const&> request_headers = {}, ReadonlyBytes request_body = {}, HTTP::CacheMode = HTTP::CacheMode::Default, HTTP::Cookie::IncludeCredentials = HTTP::Cookie::IncludeCredentials::Yes, Core::ProxyData const& = {}, KeepAliveForTransfer = KeepAliveForTransfer::No);
+    RefPtr<Request> start_request(ByteString const& method, URL::URL const&, Optional<HTTP::HeaderList const&> request_headers = {}, ReadonlyBytes request_body = {}, HTTP::CacheMode = HTTP::CacheMode::Default, HTTP::Cookie::IncludeCredentials = HTTP::Cookie::IncludeCredentials::Yes, Core::ProxyData const& = {}, KeepAliveForTransfer = KeepAliveForTransfer::No, HTTP::Priority = {}, Optional<ByteString> const& network_partition = {});
     RefPtr<Request> adopt_request(int source_client_id, u64 source_request_id);
     bool stop_request(Badge<Request>, Request&);
     void release_request_for_transfer(Badge<Request>, Request&);
-    void ensure_connection(URL::URL const&, RequestServer::CacheLevel);
+    void ensure_connection(URL::URL const&, RequestServer::CacheLevel, Optional<ByteString> const& network_partition = {});
     int request_server_client_id() const { return m_request_server_client_id; }
 
     bool set_certificate(Badge<Request>, Request&, ByteString, ByteString);
@@ -57,6 +59,10 @@ public:
     ErrorOr<bool> store_cache_associated_data(URL::URL const&, ByteString const& method, Optional<HTTP::HeaderList const&> request_headers, Optional<u64> vary_key, HTTP::CacheEntryAssociatedData, ReadonlyBytes);
     ErrorOr<Optional<Core::AnonymousBuffer>> retrieve_cache_associated_data(URL::URL const&, ByteString const& method, Optional<HTTP::HeaderList const&> request_headers, Optional<u64> vary_key, HTTP::CacheEntryAssociatedData);
     ErrorOr<bool> create_synthetic_cache_entry(URL::URL const&, ByteString const& method);
+    ErrorOr<void> store_shared_javascript_bytecode(StringView partition, ReadonlyBytes source_hash, ReadonlyBytes);
+    void retrieve_shared_javascript_bytecode(StringView partition, ReadonlyBytes source_hash, Function<void(Optional<Core::ImmutableBytes>)>);
+    ErrorOr<void> store_decompressed_font(StringView partition, ReadonlyBytes font_hash, ReadonlyBytes);
+    void retrieve_decompressed_font(StringView partition, ReadonlyBytes font_hash, Function<void(Optional<Core::AnonymousBuffer>)>);
 
     Function<String(URL::URL const&, RequestServer::IsPrivate)> on_retrieve_http_cookie;
     Function<void()> on_request_server_died;
@@ -70,13 +76,15 @@ private:
     virtual void request_finished(u64 request_id, u64, RequestTimingInfo, Optional<NetworkError>) override;
     virtual void headers_became_available(u64 request_id, Vector<HTTP::Header>, Optional<u32>, Optional<String>, Optional<IPC::File>, u64 javascript_bytecode_size, Optional<u64>, CameFromCache) override;
     virtual void request_transferred(u64 request_id) override;
+    virtual void request_early_hints_received(u64 request_id, Vector<HTTP::Header>) override;
 
     virtual void retrieve_http_cookie(int client_id, u64 request_id, RequestServer::RequestType request_type, URL::URL url, RequestServer::IsPrivate) override;
 
     virtual void certificate_requested(u64 request_id) override;
 
     virtual void websocket_connected(u64 websocket_id) override;
-    virtual void websocket_received(u64 websocket_id, bool, ByteBuffer) override;
+    virtual void websocket_received(u64 websocket_id, Vector<WebSocket::Message>) override;
+    virtual void websocket_received_shared(u64 websocket_id, bool, Core::AnonymousBuffer) override;
     virtual void websocket_errored(u64 websocket_id, i32) override;
     virtual void websocket_closed(u64 websocket_id, u16, ByteString, bool) override;
     virtual void websocket_ready_state_changed(u64 websocket_id, u32 ready_state) override;
@@ -84,6 +92,8 @@ private:
     virtual void websocket_certificate_requested(u64 websocket_id) override;
 
     virtual void estimated_cache_size(u64 cache_size_estimation_id, CacheSizes sizes) override;
+    virtual void retrieved_shared_javascript_bytecode(u64 retrieval_id, Optional<IPC::File>, u64 size) override;
+    virtual void retrieved_decompressed_font(u64 retrieval_id, Optional<Core::AnonymousBuffer>) override;
 
     HashMap<u64, RefPtr<Request>> m_requests;
     u64 m_next_request_id { 0 };
@@ -94,6 +104,12 @@ private:
 
     HashMap<u64, NonnullRefPtr<Core::Promise<CacheSizes>>> m_pending_cache_size_estimations;
     u64 m_next_cache_size_estimation_id { 0 };
+
+    HashMap<u64, Function<void(Optional<Core::ImmutableBytes>)>> m_pending_shared_javascript_bytecode_retrievals;
+    u64 m_next_shared_javascript_bytecode_retrieval_id { 0 };
+
+    HashMap<u64, Function<void(Optional<Core::AnonymousBuffer>)>> m_pending_decompressed_font_retrievals;
+    u64 m_next_decompressed_font_retrieval_id { 0 };
 };
 
 }
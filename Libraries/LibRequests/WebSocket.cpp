@@ -5,13 +5,13 @@
  */
 
 #include <LibCore/AnonymousBuffer.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
 #include <LibRequests/RequestClient.h>
 #include <LibRequests/WebSocket.h>
 
 namespace Requests {
 
-static constexpr size_t WEBSOCKET_SHARED_MEMORY_THRESHOLD = 16 * MiB;
-
 WebSocket::WebSocket(RequestClient& client, u64 websocket_id)
     : m_client(client)
     , m_websocket_id(websocket_id)
@@ -73,10 +73,10 @@ void WebSocket::did_open(Badge<RequestClient>)
         on_open();
 }
 
-void WebSocket::did_receive(Badge<RequestClient>, ByteBuffer data, bool is_text)
+void WebSocket::did_receive(Badge<RequestClient>, Vector<Message> messages)
 {
-    if (on_message)
-        on_message(WebSocket::Message { move(data), is_text });
+    if (on_messages)
+        on_messages(move(messages));
 }
 
 void WebSocket::did_error(Badge<RequestClient>, i32 error_code)
@@ -106,3 +106,25 @@ void WebSocket::detach_from_client(Badge<RequestClient>)
 }
 
 }
+
+namespace IPC {
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Requests::WebSocket::Message const& message)
+{
+    TRY(encoder.encode(message.data));
+    TRY(encoder.encode(message.is_text));
+
+    return {};
+}
+
+template<>
+ErrorOr<Requests::WebSocket::Message> decode(Decoder& decoder)
+{
+    auto data = TRY(decoder.decode<ByteBuffer>());
+    auto is_text = TRY(decoder.decode<bool>());
+
+    return Requests::WebSocket::Message { move(data), is_text };
+}
+
+}
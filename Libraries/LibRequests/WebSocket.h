@@ -11,12 +11,17 @@
 #include <AK/ByteString.h>
 #include <AK/Function.h>
 #include <AK/RefCounted.h>
+#include <AK/Vector.h>
 #include <AK/WeakPtr.h>
+#include <LibIPC/Forward.h>
 
 namespace Requests {
 
 class RequestClient;
 
+// Messages at least this large are passed between processes through shared memory rather than through the IPC socket.
+static constexpr size_t WEBSOCKET_SHARED_MEMORY_THRESHOLD = 16 * MiB;
+
 class WebSocket : public RefCounted<WebSocket> {
 public:
     struct CertificateAndKey {
@@ -60,13 +65,14 @@ public:
     void close(u16 code = 1005, ByteString reason = {});
 
     Function<void()> on_open;
-    Function<void(Message)> on_message;
+    // Messages that arrived together are delivered together, in the order they were received.
+    Function<void(Vector<Message>)> on_messages;
     Function<void(Error)> on_error;
     Function<void(u16 code, ByteString reason, bool was_clean)> on_close;
     Function<CertificateAndKey()> on_certificate_requested;
 
     void did_open(Badge<RequestClient>);
-    void did_receive(Badge<RequestClient>, ByteBuffer, bool);
+    void did_receive(Badge<RequestClient>, Vector<Message>);
     void did_error(Badge<RequestClient>, i32);
     void did_close(Badge<RequestClient>, u16, ByteString, bool);
     void did_request_certificates(Badge<RequestClient>);
@@ -82,3 +88,13 @@ private:
 };
 
 }
+
+namespace IPC {
+
+template<>
+ErrorOr<void> encode(Encoder&, Requests::WebSocket::Message const&);
+
+template<>
+ErrorOr<Requests::WebSocket::Message> decode(Decoder&);
+
+}
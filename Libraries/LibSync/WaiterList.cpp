@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/NeverDestroyed.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibSync/WaiterList.h>
+
+namespace Sync {
+
+namespace {
+
+// A thread blocked in wait() owns its waiter, while the waiters of wait_async() are owned by their list.
+struct Waiter {
+    ConditionVariable* condition { nullptr };
+    bool notified { false };
+
+    WaiterList::AsyncWaiterID async_id { 0 };
+    Function<void()> on_notified;
+};
+
+struct WaiterLists {
+    Mutex mutex;
+    HashMap<FlatPtr, Vector<Waiter*, 2>> lists;
+    WaiterList::AsyncWaiterID next_async_id { 1 };
+};
+
+}
+
+static WaiterLists& waiter_lists()
+{
+    static NeverDestroyed<WaiterLists> s_waiter_lists;
+    return *s_waiter_lists;
+}
+
+WaiterList::WaitResult WaiterList::wait(void const* address, Function<bool()> const& value_matches, Optional<AK::Duration> timeout)
+{
+    auto& state = waiter_lists();
+    auto key = reinterpret_cast<FlatPtr>(address);
+
+    MutexLocker locker(state.mutex);
+    if (!value_matches())
+        return WaitResult::NotEqual;
+
+    ConditionVariable condition { state.mutex };
+    Waiter waiter { .condition = &condition };
+    state.lists.ensure(key).append(&waiter);
+
+    auto deadline = timeout.map([](auto duration) { return MonotonicTime::now() + duration; });
+    while (!waiter.notified) {
+        if (!deadline.has_value()) {
+            condition.wait();
+            continue;
+        }
+        auto remaining = *deadline - MonotonicTime::now();
+        if (remaining <= AK::Duration::zero() || !condition.wait_for(remaining)) {
+            // A notify may have landed right as we timed out; it counted us as woken, so report that.
+            if (waiter.notified)
+                break;
+
+            auto it = state.lists.find(key);
+            VERIFY(it != state.lists.end());
+            it->value.remove_first_matching([&](auto* entry) { return entry == &waiter; });
+            if (it->value.is_empty())
+                state.lists.remove(it);
+            return WaitResult::TimedOut;
+        }
+    }
+    return WaitResult::Woken;
+}
+
+Optional<WaiterList::AsyncWaiterID> WaiterList::wait_async(void const* address, Function<bool()> const& value_matches, Function<void()> on_notified)
+{
+    auto& state = waiter_lists();
+    auto key = reinterpret_cast<FlatPtr>(address);
+
+    MutexLocker locker(state.mutex);
+    if (!value_matches())
+        return {};
+
+    auto id = state.next_async_id++;
+    state.lists.ensure(key).append(new Waiter { .async_id = id, .on_notified = move(on_notified) });
+    return id;
+}
+
+bool WaiterList::remove_async_waiter(void const* address, AsyncWaiterID id)
+{
+    auto& state = waiter_lists();
+    auto key = reinterpret_cast<FlatPtr>(address);
+
+    OwnPtr<Waiter> waiter;
+
+    MutexLocker locker(state.mutex);
+    auto it = state.lists.find(key);
+    if (it == state.lists.end())
+        return false;
+
+    auto index = it->value.find_first_index_if([&](auto* entry) { return entry->async_id == id; });
+    if (!index.has_value())
+        return false;
+
+    waiter = adopt_own(*it->value.take(*index));
+    if (it->value.is_empty())
+        state.lists.remove(it);
+    return true;
+}
+
+u32 WaiterList::notify(void const* address, u32 count)
+{
+    auto& state = waiter_lists();
+    auto key = reinterpret_cast<FlatPtr>(address);
+
+    Vector<NonnullOwnPtr<Waiter>> notified_async_waiters;
+    u32 woken = 0;
+
+    {
+        MutexLocker locker(state.mutex);
+        auto it = state.lists.find(key);
+        if (it == state.lists.end())
+            return 0;
+
+        auto& waiters = it->value;
+        while (woken < count && !waiters.is_empty()) {
+            auto* waiter = waiters.take_first();
+            if (waiter->condition) {
+                waiter->notified = true;
+                waiter->condition->signal();
+            } else {
+                notified_async_waiters.append(adopt_own(*waiter));
+            }
+            ++woken;
+        }
+        if (waiters.is_empty())
+            state.lists.remove(it);
+    }
+
+    // NB: The callbacks run without the lock held, so that they are free to wait or notify themselves.
+    for (auto& waiter : notified_async_waiters)
+        waiter->on_notified();
+    return woken;
+}
+
+}
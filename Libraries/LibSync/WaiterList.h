@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+#include <LibSync/Export.h>
+
+namespace Sync {
+
+// Process-wide FIFO wait queues keyed by memory address, in the spirit of ECMA-262's WaiterList records.
+// These back both Atomics.wait()/Atomics.notify() and WebAssembly's memory.atomic.wait/memory.atomic.notify,
+// so that a waiter blocked by one can be woken by the other as long as they agree on the address.
+class SYNC_API WaiterList {
+public:
+    enum class WaitResult : u8 {
+        Woken,
+        NotEqual,
+        TimedOut,
+    };
+
+    // Blocks the calling thread on `address` until notified or `timeout` elapses (forever if it's empty).
+    // `value_matches` is evaluated with the address's list locked, so a notify racing with the comparison can't be lost;
+    // if it returns false, this returns NotEqual without blocking.
+    static WaitResult wait(void const* address, Function<bool()> const& value_matches, Optional<AK::Duration> timeout);
+
+    using AsyncWaiterID = u64;
+
+    // Queues a waiter on `address` that doesn't block the calling thread, as Atomics.waitAsync() does. If `value_matches`
+    // returns false, nothing is queued and this returns an empty Optional. Otherwise `on_notified` is called once the
+    // waiter is notified, on the notifying thread and after the list has been unlocked again.
+    static Optional<AsyncWaiterID> wait_async(void const* address, Function<bool()> const& value_matches, Function<void()> on_notified);
+
+    // Removes an asynchronous waiter whose timeout has elapsed. Returns false if it has already been notified, in which
+    // case its `on_notified` is called instead.
+    static bool remove_async_waiter(void const* address, AsyncWaiterID);
+
+    // Wakes up to `count` waiters on `address`, oldest first, and returns how many were woken.
+    static u32 notify(void const* address, u32 count = NumericLimits<u32>::max());
+};
+
+}
@@ -7,6 +7,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/CharacterTypes.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf16StringBuilder.h>
 #include <AK/Utf8View.h>
@@ -25,6 +26,7 @@ public:
     }
 
     virtual ErrorOr<String> to_utf8(StringView input, IgnoreBOM, ErrorMode) override;
+    virtual ErrorOr<Utf16String> to_utf16(StringView input) override;
     virtual ErrorOr<size_t> length_in_utf16_code_units(StringView input) override;
 
 private:
@@ -37,12 +39,14 @@ class UTF8Decoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
     virtual ErrorOr<String> to_utf8(StringView, IgnoreBOM, ErrorMode) override;
+    virtual ErrorOr<Utf16String> to_utf16(StringView) override;
     virtual ErrorOr<size_t> length_in_utf16_code_units(StringView) override;
 };
 
 class UTF16BEDecoder final : public Decoder {
 public:
     virtual ErrorOr<String> to_utf8(StringView, IgnoreBOM, ErrorMode) override;
+    virtual ErrorOr<Utf16String> to_utf16(StringView) override;
     virtual ErrorOr<size_t> length_in_utf16_code_units(StringView) override;
 
 private:
@@ -52,6 +56,7 @@ private:
 class UTF16LEDecoder final : public Decoder {
 public:
     virtual ErrorOr<String> to_utf8(StringView, IgnoreBOM, ErrorMode) override;
+    virtual ErrorOr<Utf16String> to_utf16(StringView) override;
     virtual ErrorOr<size_t> length_in_utf16_code_units(StringView) override;
 
 private:
@@ -61,6 +66,8 @@ private:
 class Latin1Decoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+    virtual ErrorOr<String> to_utf8(StringView, IgnoreBOM, ErrorMode) override;
+    virtual ErrorOr<Utf16String> to_utf16(StringView) override;
     virtual ErrorOr<size_t> length_in_utf16_code_units(StringView) override;
 };
 
@@ -146,6 +153,23 @@ ErrorOr<String> rust_decode_to_utf8(StringView encoding, StringView input, Ignor
     return context.builder.to_string_without_validation();
 }
 
+ErrorOr<Utf16String> rust_decode_to_utf16(StringView encoding, StringView input, IgnoreBOM ignore_bom, ErrorMode error_mode)
+{
+    Utf16DecodeContext context { .builder = Utf16StringBuilder(input.length()) };
+    auto succeeded = FFI::textcodec_rust_decode_to_utf16(
+        reinterpret_cast<u8 const*>(encoding.characters_without_null_termination()),
+        encoding.length(),
+        reinterpret_cast<u8 const*>(input.characters_without_null_termination()),
+        input.length(),
+        ignore_bom == IgnoreBOM::No,
+        error_mode == ErrorMode::Fatal,
+        &context,
+        append_decoded_utf16);
+    if (!succeeded)
+        return Error::from_string_literal("Failed to decode input");
+    return context.builder.to_string();
+}
+
 ErrorOr<Utf16String> rust_streaming_decode_to_utf16(FFI::TextCodecRustStreamingDecoder* decoder, ReadonlyBytes input, bool last, ErrorMode error_mode)
 {
     Utf16DecodeContext context { .builder = Utf16StringBuilder(input.size()) };
@@ -173,9 +197,21 @@ ErrorOr<void> rust_process(StringView encoding, StringView input, IgnoreBOM igno
 ErrorOr<size_t> rust_length_in_utf16_code_units(StringView encoding, StringView input, IgnoreBOM ignore_bom)
 {
     auto utf8 = TRY(rust_decode_to_utf8(encoding, input, ignore_bom, ErrorMode::Replacement));
+
+    // NB: The decoder only produces valid UTF-8, so rather than decoding every code point, we can count one code unit
+    //     for each byte that starts a code point, plus one more for each code point that needs a surrogate pair.
     size_t length = 0;
-    for (auto code_point : Utf8View { utf8 })
-        length += code_point <= 0xffff ? 1 : 2;
+    for (auto byte : utf8.bytes())
+        length += static_cast<size_t>((byte & 0xc0) != 0x80) + static_cast<size_t>(byte >= 0xf0);
+    return length;
+}
+
+// Returns the length of the run of ASCII bytes the input starts with.
+size_t ascii_prefix_length(StringView input)
+{
+    size_t length = 0;
+    while (length < input.length() && is_ascii(input[length]))
+        ++length;
     return length;
 }
 
@@ -478,6 +514,11 @@ ErrorOr<String> RustDecoder::to_utf8(StringView input, IgnoreBOM ignore_bom, Err
     return rust_decode_to_utf8(m_encoding, input, ignore_bom, error_mode);
 }
 
+ErrorOr<Utf16String> RustDecoder::to_utf16(StringView input)
+{
+    return rust_decode_to_utf16(m_encoding, input, IgnoreBOM::Yes, ErrorMode::Replacement);
+}
+
 ErrorOr<size_t> RustDecoder::length_in_utf16_code_units(StringView input)
 {
     return rust_length_in_utf16_code_units(m_encoding, input, IgnoreBOM::Yes);
@@ -495,6 +536,16 @@ ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u3
     return {};
 }
 
+ErrorOr<String> Latin1Decoder::to_utf8(StringView input, IgnoreBOM, ErrorMode)
+{
+    return isomorphic_decode(input);
+}
+
+ErrorOr<Utf16String> Latin1Decoder::to_utf16(StringView input)
+{
+    return isomorphic_decode_to_utf16(input);
+}
+
 ErrorOr<size_t> Latin1Decoder::length_in_utf16_code_units(StringView input)
 {
     return input.length();
@@ -545,6 +596,11 @@ ErrorOr<String> UTF8Decoder::to_utf8(StringView input, IgnoreBOM ignore_bom, Err
     return rust_decode_to_utf8("UTF-8"sv, input, ignore_bom, error_mode);
 }
 
+ErrorOr<Utf16String> UTF8Decoder::to_utf16(StringView input)
+{
+    return rust_decode_to_utf16("UTF-8"sv, input, IgnoreBOM::Yes, ErrorMode::Replacement);
+}
+
 ErrorOr<size_t> UTF8Decoder::length_in_utf16_code_units(StringView input)
 {
     return rust_length_in_utf16_code_units("UTF-8"sv, input, IgnoreBOM::No);
@@ -560,6 +616,11 @@ ErrorOr<String> UTF16BEDecoder::to_utf8(StringView input, IgnoreBOM ignore_bom,
     return rust_decode_to_utf8("UTF-16BE"sv, input, ignore_bom, error_mode);
 }
 
+ErrorOr<Utf16String> UTF16BEDecoder::to_utf16(StringView input)
+{
+    return rust_decode_to_utf16("UTF-16BE"sv, input, IgnoreBOM::No, ErrorMode::Replacement);
+}
+
 ErrorOr<size_t> UTF16BEDecoder::length_in_utf16_code_units(StringView input)
 {
     return rust_length_in_utf16_code_units("UTF-16BE"sv, input, IgnoreBOM::No);
@@ -575,6 +636,11 @@ ErrorOr<String> UTF16LEDecoder::to_utf8(StringView input, IgnoreBOM ignore_bom,
     return rust_decode_to_utf8("UTF-16LE"sv, input, ignore_bom, error_mode);
 }
 
+ErrorOr<Utf16String> UTF16LEDecoder::to_utf16(StringView input)
+{
+    return rust_decode_to_utf16("UTF-16LE"sv, input, IgnoreBOM::No, ErrorMode::Replacement);
+}
+
 ErrorOr<size_t> UTF16LEDecoder::length_in_utf16_code_units(StringView input)
 {
     return rust_length_in_utf16_code_units("UTF-16LE"sv, input, IgnoreBOM::No);
@@ -586,10 +652,21 @@ String isomorphic_decode(StringView input)
     // To isomorphic decode a byte sequence input, return a string whose code point length is equal to input’s length
     // and whose code points have the same values as the values of input’s bytes, in the same order.
     // NB: This is essentially spec-speak for "Decode as ISO-8859-1 / Latin-1".
-    StringBuilder builder(input.length());
+    if (input.is_ascii())
+        return String::from_utf8_without_validation(input.bytes());
 
-    for (auto byte : input.bytes())
-        builder.append_code_point(byte);
+    // OPTIMIZATION: ASCII bytes are the same in UTF-8, so runs of them are appended all at once.
+    StringBuilder builder(input.length() * 2);
+
+    while (!input.is_empty()) {
+        auto ascii_length = ascii_prefix_length(input);
+        builder.append(input.substring_view(0, ascii_length));
+        if (ascii_length == input.length())
+            break;
+
+        builder.append_code_point(static_cast<u8>(input[ascii_length]));
+        input = input.substring_view(ascii_length + 1);
+    }
 
     return builder.to_string_without_validation();
 }
@@ -600,10 +677,21 @@ Utf16String isomorphic_decode_to_utf16(StringView input)
     // To isomorphic decode a byte sequence input, return a string whose code point length is equal to input’s length
     // and whose code points have the same values as the values of input’s bytes, in the same order.
     // NB: This is essentially spec-speak for "Decode as ISO-8859-1 / Latin-1".
+    if (input.is_ascii())
+        return Utf16String::from_ascii_without_validation(input.bytes());
+
+    // OPTIMIZATION: Runs of ASCII bytes are widened to UTF-16 all at once.
     Utf16StringBuilder builder(input.length());
 
-    for (auto byte : input.bytes())
-        builder.append_code_point(byte);
+    while (!input.is_empty()) {
+        auto ascii_length = ascii_prefix_length(input);
+        builder.append_ascii(input.substring_view(0, ascii_length));
+        if (ascii_length == input.length())
+            break;
+
+        builder.append_code_unit(static_cast<u8>(input[ascii_length]));
+        input = input.substring_view(ascii_length + 1);
+    }
 
     return builder.to_string();
 }
@@ -125,6 +125,61 @@ pub unsafe extern "C" fn textcodec_rust_decode_to_utf8(
     }
 }
 
+/// # Safety
+/// - `encoding_label`/`encoding_label_len` and `input`/`input_len` must be valid byte slices.
+/// - `on_utf16` must not retain `data` beyond the duration of the callback.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn textcodec_rust_decode_to_utf16(
+    encoding_label: *const u8,
+    encoding_label_len: usize,
+    input: *const u8,
+    input_len: usize,
+    remove_bom: bool,
+    fatal: bool,
+    ctx: *mut c_void,
+    on_utf16: FfiUtf16Fn,
+) -> bool {
+    unsafe {
+        abort_on_panic(|| {
+            let Some(label) = bytes_from_raw(encoding_label, encoding_label_len) else {
+                return false;
+            };
+            let Some(input) = bytes_from_raw(input, input_len) else {
+                return false;
+            };
+            let Some(encoding) = Encoding::for_label(label) else {
+                return false;
+            };
+
+            let mut decoder = if remove_bom {
+                encoding.new_decoder_with_bom_removal()
+            } else {
+                encoding.new_decoder_without_bom_handling()
+            };
+            let Some(output_capacity) = decoder.max_utf16_buffer_length(input.len()) else {
+                return false;
+            };
+            let mut output = vec![0u16; output_capacity];
+
+            let succeeded = if fatal {
+                let (result, _, written) = decoder.decode_to_utf16_without_replacement(input, &mut output, true);
+                output.truncate(written);
+                matches!(result, DecoderResult::InputEmpty)
+            } else {
+                let (result, _, written, _) = decoder.decode_to_utf16(input, &mut output, true);
+                output.truncate(written);
+                matches!(result, CoderResult::InputEmpty)
+            };
+            if !succeeded {
+                return false;
+            }
+
+            on_utf16(ctx, output.as_ptr(), output.len());
+            true
+        })
+    }
+}
+
 /// # Safety
 /// - `encoding_label`/`encoding_label_len` must be a valid byte slice.
 /// - The returned pointer must be freed with `textcodec_rust_streaming_decoder_free`.
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/TraceEvent.h>
 #include <LibThreading/Thread.h>
 
 namespace Threading {
@@ -96,6 +97,7 @@ void Thread::start()
 #else
                 pthread_setname_np(pthread_self(), thread_name.characters());
 #endif
+                Core::TraceEvents::set_current_thread_name(self->thread_name());
             }
 
             auto exit_code = self->m_action();
@@ -4,13 +4,23 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/NumericLimits.h>
+#include <AK/StdLibExtras.h>
+#include <LibCore/System.h>
 #include <LibThreading/ThreadPool.h>
 
-static constexpr size_t THREAD_COUNT = 4;
+static constexpr size_t MIN_THREAD_COUNT = 2;
+static constexpr size_t MAX_THREAD_COUNT = 16;
 static constexpr size_t THREAD_STACK_SIZE = 8 * MiB;
 
+// Chunks handed out per worker by parallel_for(), so uneven iterations still spread out evenly.
+static constexpr size_t PARALLEL_FOR_CHUNKS_PER_WORKER = 4;
+
 namespace Threading {
 
+static constexpr size_t not_a_worker = NumericLimits<size_t>::max();
+static thread_local size_t s_current_worker_index = not_a_worker;
+
 ThreadPool& ThreadPool::the()
 {
     static ThreadPool* instance = new ThreadPool;
@@ -19,37 +29,158 @@ ThreadPool& ThreadPool::the()
 
 ThreadPool::ThreadPool()
 {
-    for (size_t i = 0; i < THREAD_COUNT; ++i) {
+    auto thread_count = clamp(static_cast<size_t>(Core::System::hardware_concurrency()), MIN_THREAD_COUNT, MAX_THREAD_COUNT);
+
+    // All workers exist before any of them starts, as thieves walk the whole list.
+    m_workers.ensure_capacity(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+        m_workers.unchecked_append(make<Worker>());
+
+    for (size_t i = 0; i < thread_count; ++i) {
         auto name = ByteString::formatted("Pool/{}", i);
-        auto thread = Thread::construct(name, [this]() -> intptr_t {
-            return worker_thread_func();
+        auto thread = Thread::construct(name, [this, i]() -> intptr_t {
+            return worker_thread_func(i);
         });
         thread->set_stack_size(THREAD_STACK_SIZE);
         thread->start();
-        m_threads.append(move(thread));
+        m_workers[i]->thread = move(thread);
     }
 }
 
-intptr_t ThreadPool::worker_thread_func()
+intptr_t ThreadPool::worker_thread_func(size_t worker_index)
 {
+    s_current_worker_index = worker_index;
+
     while (true) {
-        Function<void()> work;
+        {
+            Sync::MutexLocker locker(m_mutex);
+            m_condition.wait_while([this] { return m_pending_task_count.load(AK::MemoryOrder::memory_order_relaxed) == 0; });
+        }
+
+        // Another worker may have claimed the task we were woken up for.
+        auto task = take_task(worker_index);
+        if (!task.has_value())
+            continue;
+        if (task->cancellation_token && task->cancellation_token->is_cancelled())
+            continue;
+
+        task->work();
+    }
+}
+
+Optional<ThreadPool::Task> ThreadPool::take_task(size_t worker_index)
+{
+    auto claim = [this](Task task) {
+        m_pending_task_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+        return task;
+    };
+
+    for (size_t priority = 0; priority < task_priority_count; ++priority) {
+        // Our own newest work first, it's the most likely to still be warm in the cache.
+        {
+            auto& worker = *m_workers[worker_index];
+            Sync::MutexLocker locker(worker.mutex);
+            if (!worker.deques[priority].is_empty())
+                return claim(worker.deques[priority].take_last());
+        }
 
         {
             Sync::MutexLocker locker(m_mutex);
-            m_condition.wait_while([this] { return m_work_queue.is_empty(); });
-            work = m_work_queue.dequeue();
+            if (!m_shared_queues[priority].is_empty())
+                return claim(m_shared_queues[priority].dequeue());
         }
 
-        work();
+        // Steal the oldest work from everyone else, starting with our neighbour so thieves spread out.
+        for (size_t offset = 1; offset < m_workers.size(); ++offset) {
+            auto& victim = *m_workers[(worker_index + offset) % m_workers.size()];
+            Sync::MutexLocker locker(victim.mutex);
+            if (!victim.deques[priority].is_empty())
+                return claim(victim.deques[priority].take_first());
+        }
     }
+
+    return {};
 }
 
-void ThreadPool::submit(Function<void()> work)
+void ThreadPool::submit(Function<void()> work, TaskPriority priority, RefPtr<CancellationToken> cancellation_token)
 {
+    Task task { move(work), move(cancellation_token) };
+    auto queue_index = to_underlying(priority);
+
+    // NB: The count must go up before the task is published, since another worker may claim it (and decrement the
+    //     count) as soon as it is in a deque.
+    m_pending_task_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+
+    bool submitted_by_worker = s_current_worker_index != not_a_worker;
+    if (submitted_by_worker) {
+        auto& worker = *m_workers[s_current_worker_index];
+        Sync::MutexLocker locker(worker.mutex);
+        worker.deques[queue_index].append(move(task));
+    }
+
     Sync::MutexLocker locker(m_mutex);
-    m_work_queue.enqueue(move(work));
+    if (!submitted_by_worker)
+        m_shared_queues[queue_index].enqueue(move(task));
     m_condition.signal();
 }
 
+namespace {
+
+struct ParallelForState final : public AtomicRefCounted<ParallelForState> {
+    ParallelForState(Function<void(size_t)> const& body, size_t count, size_t chunk_size)
+        : body(body)
+        , count(count)
+        , chunk_size(chunk_size)
+    {
+    }
+
+    // Only iterations that were claimed ever touch `body`, and the caller doesn't return before all of them have
+    // completed, so helpers that start late just find nothing left to do.
+    void run_chunks()
+    {
+        while (true) {
+            auto start = next_index.fetch_add(chunk_size, AK::MemoryOrder::memory_order_relaxed);
+            if (start >= count)
+                return;
+            auto end = min(start + chunk_size, count);
+            for (auto i = start; i < end; ++i)
+                body(i);
+
+            if (completed_count.fetch_add(end - start, AK::MemoryOrder::memory_order_acq_rel) + (end - start) == count) {
+                Sync::MutexLocker locker(mutex);
+                done.broadcast();
+            }
+        }
+    }
+
+    Function<void(size_t)> const& body;
+    size_t const count;
+    size_t const chunk_size;
+    Atomic<size_t> next_index { 0 };
+    Atomic<size_t> completed_count { 0 };
+    Sync::Mutex mutex;
+    Sync::ConditionVariable done { mutex };
+};
+
+}
+
+void ThreadPool::parallel_for(size_t count, Function<void(size_t)> const& body, TaskPriority priority)
+{
+    if (count == 0)
+        return;
+
+    auto chunk_size = ceil_div(count, min(count, worker_count() * PARALLEL_FOR_CHUNKS_PER_WORKER));
+    auto state = adopt_ref(*new ParallelForState(body, count, chunk_size));
+
+    // The calling thread takes the first chunk itself, so one helper fewer than there are chunks is enough.
+    auto helper_count = min(worker_count(), ceil_div(count, chunk_size) - 1);
+    for (size_t i = 0; i < helper_count; ++i)
+        submit([state] { state->run_chunks(); }, priority);
+
+    state->run_chunks();
+
+    Sync::MutexLocker locker(state->mutex);
+    state->done.wait_while([&] { return state->completed_count.load(AK::MemoryOrder::memory_order_acquire) < count; });
+}
+
 }
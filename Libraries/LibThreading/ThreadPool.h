@@ -6,8 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
 #include <AK/Function.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Queue.h>
+#include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibSync/ConditionVariable.h>
 #include <LibSync/Mutex.h>
@@ -15,21 +20,69 @@
 
 namespace Threading {
 
+// Work of a higher priority is always picked up before any work of a lower one.
+enum class TaskPriority : u8 {
+    UserBlocking, // Something on screen is waiting for the result, e.g. a parser-blocking script.
+    UserVisible,  // The result will be visible, but nothing is blocked on it.
+    Background,   // Nobody is waiting, e.g. optimizing compilation.
+};
+
+static constexpr size_t task_priority_count = 3;
+
+// Lets the submitter withdraw work: the pool drops cancelled work that hasn't started yet, and long-running work
+// can poll is_cancelled() to stop early.
+class CancellationToken final : public AtomicRefCounted<CancellationToken> {
+public:
+    static NonnullRefPtr<CancellationToken> create() { return adopt_ref(*new CancellationToken); }
+
+    void cancel() { m_cancelled.store(true, AK::MemoryOrder::memory_order_release); }
+    bool is_cancelled() const { return m_cancelled.load(AK::MemoryOrder::memory_order_acquire); }
+
+private:
+    CancellationToken() = default;
+
+    Atomic<bool> m_cancelled { false };
+};
+
+// One worker per core. Work submitted from outside the pool goes to a shared queue per priority; work submitted
+// by a worker goes to that worker's own deque, which it drains newest-first while idle workers steal oldest-first.
 class ThreadPool {
 public:
     static ThreadPool& the();
 
-    void submit(Function<void()>);
+    void submit(Function<void()>, TaskPriority = TaskPriority::UserVisible, RefPtr<CancellationToken> = {});
+
+    // Runs body(i) for every i in [0, count) across the pool and returns once all of them are done. The calling
+    // thread takes part, so this makes progress even while every worker is busy, and may be used from a worker.
+    void parallel_for(size_t count, Function<void(size_t)> const& body, TaskPriority = TaskPriority::UserVisible);
+
+    size_t worker_count() const { return m_workers.size(); }
 
 private:
+    struct Task {
+        Function<void()> work;
+        RefPtr<CancellationToken> cancellation_token;
+    };
+
+    struct Worker {
+        Sync::Mutex mutex;
+        Array<Vector<Task>, task_priority_count> deques;
+        RefPtr<Thread> thread;
+    };
+
     ThreadPool();
 
-    intptr_t worker_thread_func();
+    intptr_t worker_thread_func(size_t worker_index);
+    Optional<Task> take_task(size_t worker_index);
 
     Sync::Mutex m_mutex;
     Sync::ConditionVariable m_condition { m_mutex };
-    Queue<Function<void()>> m_work_queue;
-    Vector<NonnullRefPtr<Thread>> m_threads;
+    Array<Queue<Task>, task_priority_count> m_shared_queues;
+    // Incremented by submit() before it takes m_mutex, but submit() always signals m_condition with m_mutex held
+    // afterwards. A worker that saw a zero count under m_mutex is therefore already waiting when that signal arrives,
+    // so it can't miss the wakeup.
+    Atomic<size_t> m_pending_task_count { 0 };
+    Vector<NonnullOwnPtr<Worker>> m_workers;
 };
 
 }
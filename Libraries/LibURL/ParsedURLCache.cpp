@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibURL/ParsedURLCache.h>
+
+namespace URL {
+
+Optional<Optional<URL>> ParsedURLCache::get(Utf16View input, URL const& base_url, Utf16View encoding)
+{
+    if (!is_for(base_url, encoding))
+        return {};
+
+    if (auto it = m_results.find(input); it != m_results.end())
+        return it->value;
+
+    if (auto it = m_previous_generation_results.find(input); it != m_previous_generation_results.end()) {
+        auto key = it->key;
+        auto result = move(it->value);
+        m_previous_generation_results.remove(it);
+
+        add_to_current_generation(move(key), result);
+        return result;
+    }
+
+    return {};
+}
+
+void ParsedURLCache::set(Utf16View input, URL const& base_url, Utf16View encoding, Optional<URL> result)
+{
+    if (!is_for(base_url, encoding)) {
+        clear();
+        m_base_url = base_url;
+        m_encoding = Utf16String::from_utf16(encoding);
+    }
+
+    add_to_current_generation(Utf16String::from_utf16(input), move(result));
+}
+
+void ParsedURLCache::clear()
+{
+    m_results.clear();
+    m_previous_generation_results.clear();
+    m_base_url.clear();
+    m_encoding = {};
+}
+
+void ParsedURLCache::add_to_current_generation(Utf16String input, Optional<URL> result)
+{
+    if (m_results.size() >= max_entries_per_generation)
+        m_previous_generation_results = exchange(m_results, {});
+    m_results.set(move(input), move(result));
+}
+
+bool ParsedURLCache::is_for(URL const& base_url, Utf16View encoding) const
+{
+    // NB: Base URLs that are copies of the same URL share their components, which makes comparing them cheap.
+    return m_base_url.has_value() && *m_base_url == base_url && m_encoding == encoding;
+}
+
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Utf16String.h>
+#include <AK/Utf16View.h>
+#include <LibURL/URL.h>
+
+namespace URL {
+
+// Remembers the results of parsing URL strings relative to a base URL and an encoding, since documents tend to resolve
+// the same relative URLs over and over again. A hit hands out a copy of the parsed URL, which shares its components
+// with the cached one. The cache only holds results for one base URL and encoding at a time, and forgets everything
+// once either of them changes.
+//
+// Results are looked up in the current generation first, then in the previous one, out of which a hit moves them. Once
+// the current generation is full, it replaces the previous one. This approximates an LRU: only results that went unused
+// for a whole generation are dropped.
+class ParsedURLCache {
+public:
+    static constexpr size_t max_entries_per_generation = 512;
+
+    // Returns the cached result of parsing the input, which is an empty Optional if the input failed to parse.
+    Optional<Optional<URL>> get(Utf16View input, URL const& base_url, Utf16View encoding);
+    void set(Utf16View input, URL const& base_url, Utf16View encoding, Optional<URL> result);
+
+    void clear();
+
+private:
+    void add_to_current_generation(Utf16String input, Optional<URL> result);
+    bool is_for(URL const& base_url, Utf16View encoding) const;
+
+    HashMap<Utf16String, Optional<URL>> m_results;
+    HashMap<Utf16String, Optional<URL>> m_previous_generation_results;
+
+    Optional<URL> m_base_url;
+    Utf16String m_encoding;
+};
+
+}
@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
+#include <AK/CharacterTypes.h>
 #include <LibUnicode/ICU.h>
 #include <LibUnicode/IDNA.h>
 #include <LibUnicode/RustFFI.h>
@@ -13,9 +15,37 @@
 
 namespace Unicode::IDNA {
 
+// Host names are almost always made of ASCII letters, digits and hyphens, which ToASCII only has to lowercase with any
+// options. Anything that might need ToASCII's mapping or validation, such as a Punycode label, is left to ICU.
+static Optional<String> to_ascii_for_ascii_host_name(StringView domain_name)
+{
+    static constexpr size_t max_label_length = 63;
+    static constexpr size_t max_domain_name_length = 253;
+
+    if (domain_name.is_empty() || domain_name.length() > max_domain_name_length)
+        return {};
+
+    for (auto label : domain_name.split_view('.', SplitBehavior::KeepEmpty)) {
+        if (label.is_empty() || label.length() > max_label_length)
+            return {};
+        if (label.starts_with('-') || label.ends_with('-'))
+            return {};
+        if (label.length() >= 4 && label.substring_view(2, 2) == "--"sv)
+            return {};
+        if (!all_of(label, [](char ch) { return is_ascii_alphanumeric(ch) || ch == '-'; }))
+            return {};
+    }
+
+    return domain_name.to_ascii_lowercase_string();
+}
+
 // https://www.unicode.org/reports/tr46/#ToASCII
 ErrorOr<String> to_ascii(Utf8View domain_name, ToAsciiOptions const& options)
 {
+    // OPTIMIZATION: Skip creating an ICU IDNA instance for the common case.
+    if (auto result = to_ascii_for_ascii_host_name(domain_name.as_string()); result.has_value())
+        return result.release_value();
+
     u32 icu_options = 0;
 
     if (options.check_bidi == CheckBidi::Yes)
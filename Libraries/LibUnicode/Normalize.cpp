@@ -56,6 +56,10 @@ static icu::Normalizer2 const* normalizer_for_form(NormalizationForm form, UErro
 
 String normalize(StringView string, NormalizationForm form)
 {
+    // OPTIMIZATION: ASCII text is left as it is by every normalization form.
+    if (string.is_ascii())
+        return String::from_utf8_without_validation(string.bytes());
+
     UErrorCode status = U_ZERO_ERROR;
     auto const* normalizer = normalizer_for_form(form, status);
 
@@ -64,6 +68,12 @@ String normalize(StringView string, NormalizationForm form)
 
     VERIFY(normalizer);
 
+    // OPTIMIZATION: Most text is normalized already, which ICU can mostly tell from its quick check data without
+    //               building a normalized copy.
+    if (normalizer->isNormalizedUTF8(icu_string_piece(string), status) && icu_success(status))
+        return MUST(String::from_utf8(string));
+    status = U_ZERO_ERROR;
+
     StringBuilder builder { string.length() };
     icu::StringByteSink sink { &builder };
 
@@ -76,6 +86,10 @@ String normalize(StringView string, NormalizationForm form)
 
 Utf16String normalize(Utf16View string, NormalizationForm form)
 {
+    // OPTIMIZATION: ASCII text is left as it is by every normalization form.
+    if (string.is_ascii())
+        return Utf16String::from_utf16(string);
+
     UErrorCode status = U_ZERO_ERROR;
     auto const* normalizer = normalizer_for_form(form, status);
 
@@ -85,6 +99,11 @@ Utf16String normalize(Utf16View string, NormalizationForm form)
     VERIFY(normalizer);
 
     auto icu_input = icu_string(string);
+
+    // OPTIMIZATION: The quick check finds how much of the text is normalized for sure without building a normalized
+    //               copy, which for most text is all of it.
+    if (auto normalized_length = normalizer->spanQuickCheckYes(icu_input, status); icu_success(status) && normalized_length == icu_input.length())
+        return Utf16String::from_utf16(string);
     UErrorCode normalize_status = U_ZERO_ERROR;
     auto icu_output = normalizer->normalize(icu_input, normalize_status);
     if (icu_failure(normalize_status))
@@ -533,6 +533,153 @@ private:
     size_t m_current { 0 };
 };
 
+// Remembers the boundaries found by another segmenter as one bit per code unit, so that asking about the same text
+// again doesn't go back to that segmenter. Boundaries are looked up a block of code units at a time, the first time
+// anything in that block is asked about, so text that is never asked about is never segmented.
+class BoundaryCachingSegmenter : public Segmenter {
+public:
+    explicit BoundaryCachingSegmenter(NonnullOwnPtr<Segmenter> segmenter)
+        : Segmenter(segmenter->segmenter_granularity())
+        , m_segmenter(move(segmenter))
+    {
+    }
+
+    virtual ~BoundaryCachingSegmenter() override = default;
+
+    virtual NonnullOwnPtr<Segmenter> clone() const override
+    {
+        return make<BoundaryCachingSegmenter>(m_segmenter->clone());
+    }
+
+    virtual void set_segmented_text(String text) override
+    {
+        reset(text.byte_count());
+        m_segmenter->set_segmented_text(move(text));
+    }
+
+    virtual void set_segmented_text(Utf16View const& text) override
+    {
+        reset(text.length_in_code_units());
+        m_segmenter->set_segmented_text(text);
+    }
+
+    virtual void set_segmented_text_after_change(Utf16View const& text, size_t changed_offset) override
+    {
+        // NB: A boundary may depend on a few code units that follow it, so the boundaries in the block before the
+        //     changed one are looked up again as well.
+        auto kept_blocks = changed_offset / bits_per_block;
+        kept_blocks = kept_blocks > 0 ? kept_blocks - 1 : 0;
+
+        for (size_t block = kept_blocks; block < m_boundary_bits.size(); ++block) {
+            m_boundary_bits[block] = 0;
+            m_looked_up_blocks[block / bits_per_block] &= ~(static_cast<u64>(1) << (block % bits_per_block));
+        }
+
+        m_text_length = text.length_in_code_units();
+        m_current = 0;
+        m_boundary_bits.resize(ceil_div(m_text_length + 1, bits_per_block));
+        m_looked_up_blocks.resize(ceil_div(m_boundary_bits.size(), bits_per_block));
+        m_segmenter->set_segmented_text(text);
+    }
+
+    virtual size_t current_boundary() override
+    {
+        return m_current;
+    }
+
+    virtual Optional<size_t> previous_boundary(size_t index, Inclusive inclusive) override
+    {
+        if (inclusive == Inclusive::Yes && index <= m_text_length && is_boundary(index))
+            return m_current = index;
+        for (size_t i = min(index, m_text_length + 1); i > 0; --i) {
+            if (is_boundary(i - 1))
+                return m_current = i - 1;
+        }
+        return {};
+    }
+
+    virtual Optional<size_t> next_boundary(size_t index, Inclusive inclusive) override
+    {
+        if (inclusive == Inclusive::Yes && index <= m_text_length && is_boundary(index))
+            return m_current = index;
+        for (size_t i = index + 1; i <= m_text_length; ++i) {
+            if (is_boundary(i))
+                return m_current = i;
+        }
+        return {};
+    }
+
+    virtual void for_each_boundary(String text, SegmentationCallback callback) override
+    {
+        if (text.is_empty())
+            return;
+        set_segmented_text(move(text));
+        iterate(callback);
+    }
+
+    virtual void for_each_boundary(Utf16View const& text, SegmentationCallback callback) override
+    {
+        if (text.is_empty())
+            return;
+        set_segmented_text(text);
+        iterate(callback);
+    }
+
+    virtual bool is_current_boundary_word_like() const override
+    {
+        return m_segmenter->is_current_boundary_word_like();
+    }
+
+private:
+    static constexpr size_t bits_per_block = 64;
+
+    void reset(size_t text_length)
+    {
+        m_text_length = text_length;
+        m_current = 0;
+        m_boundary_bits.clear_with_capacity();
+        m_boundary_bits.resize(ceil_div(text_length + 1, bits_per_block));
+        m_looked_up_blocks.clear_with_capacity();
+        m_looked_up_blocks.resize(ceil_div(m_boundary_bits.size(), bits_per_block));
+    }
+
+    bool is_boundary(size_t index)
+    {
+        auto block = index / bits_per_block;
+        auto block_bit = static_cast<u64>(1) << (block % bits_per_block);
+        if (!(m_looked_up_blocks[block / bits_per_block] & block_bit)) {
+            look_up_block(block);
+            m_looked_up_blocks[block / bits_per_block] |= block_bit;
+        }
+        return m_boundary_bits[block] & (static_cast<u64>(1) << (index % bits_per_block));
+    }
+
+    void look_up_block(size_t block)
+    {
+        auto start = block * bits_per_block;
+        auto end = min(start + bits_per_block, m_text_length + 1);
+        for (auto boundary = m_segmenter->next_boundary(start, Inclusive::Yes); boundary.has_value() && *boundary < end; boundary = m_segmenter->next_boundary(*boundary))
+            m_boundary_bits[block] |= static_cast<u64>(1) << (*boundary % bits_per_block);
+    }
+
+    void iterate(SegmentationCallback& callback)
+    {
+        for (size_t i = 0; i <= m_text_length; ++i) {
+            if (!is_boundary(i))
+                continue;
+            m_current = i;
+            if (callback(i) == IterationDecision::Break)
+                return;
+        }
+    }
+
+    NonnullOwnPtr<Segmenter> m_segmenter;
+    size_t m_text_length { 0 };
+    size_t m_current { 0 };
+    Vector<u64> m_boundary_bits;
+    Vector<u64> m_looked_up_blocks;
+};
+
 class SegmenterImpl : public Segmenter {
 public:
     SegmenterImpl(NonnullOwnPtr<icu::BreakIterator> segmenter, SegmenterGranularity segmenter_granularity)
@@ -722,6 +869,11 @@ NonnullOwnPtr<Segmenter> Segmenter::create_for_ascii_grapheme(size_t length)
     return make<AsciiGraphemeSegmenter>(length);
 }
 
+NonnullOwnPtr<Segmenter> Segmenter::create_with_cached_boundaries(NonnullOwnPtr<Segmenter> segmenter)
+{
+    return make<BoundaryCachingSegmenter>(move(segmenter));
+}
+
 OwnPtr<Segmenter> Segmenter::try_create_for_ascii_line(Utf16View const& text)
 {
     if (!text.has_ascii_storage())
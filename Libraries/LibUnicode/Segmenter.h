@@ -32,6 +32,8 @@ public:
     static NonnullOwnPtr<Segmenter> create(Utf16View locale, SegmenterGranularity segmenter_granularity);
     static NonnullOwnPtr<Segmenter> create_for_ascii_grapheme(size_t length);
     static OwnPtr<Segmenter> try_create_for_ascii_line(Utf16View const&);
+    // Wraps a segmenter so that the boundaries it finds are remembered as bits, for text that is asked about repeatedly.
+    static NonnullOwnPtr<Segmenter> create_with_cached_boundaries(NonnullOwnPtr<Segmenter>);
     virtual ~Segmenter() = default;
 
     static bool should_continue_beyond_word(Utf16View const&);
@@ -43,6 +45,10 @@ public:
     virtual void set_segmented_text(String) = 0;
     virtual void set_segmented_text(Utf16View const&) = 0;
 
+    // Like set_segmented_text(), for text that is the same as the previous text up to the given offset. Segmenters that
+    // remember boundaries can then keep the ones found before that offset.
+    virtual void set_segmented_text_after_change(Utf16View const& text, size_t) { set_segmented_text(text); }
+
     virtual size_t current_boundary() = 0;
 
     enum class Inclusive {
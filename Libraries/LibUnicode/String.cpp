@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/CharacterTypes.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
 #include <LibUnicode/CharacterTypes.h>
@@ -37,6 +38,9 @@ static ResolvedLocale resolve_locale(Optional<StringView> const& locale)
 
 ErrorOr<String> String::to_lowercase(Optional<StringView> const& locale) const
 {
+    if (!locale.has_value() && is_ascii())
+        return to_ascii_lowercase();
+
     UErrorCode status = U_ZERO_ERROR;
 
     StringBuilder builder { bytes_as_string_view().length() };
@@ -53,6 +57,9 @@ ErrorOr<String> String::to_lowercase(Optional<StringView> const& locale) const
 
 ErrorOr<String> String::to_uppercase(Optional<StringView> const& locale) const
 {
+    if (!locale.has_value() && is_ascii())
+        return to_ascii_uppercase();
+
     UErrorCode status = U_ZERO_ERROR;
 
     StringBuilder builder { bytes_as_string_view().length() };
@@ -104,6 +111,13 @@ ErrorOr<String> String::to_fullwidth() const
 
 static ErrorOr<void> build_casefold_string(StringView string, StringBuilder& builder)
 {
+    // OPTIMIZATION: Case folding ASCII text is the same as lowercasing it, which doesn't need ICU.
+    if (string.is_ascii()) {
+        for (auto byte : string.bytes())
+            builder.append(static_cast<char>(to_ascii_lowercase(byte)));
+        return {};
+    }
+
     UErrorCode status = U_ZERO_ERROR;
 
     icu::StringByteSink sink { &builder };
@@ -17,7 +17,7 @@ namespace AK {
 
 Utf16String Utf16String::to_lowercase(Optional<Utf16View> const& locale) const
 {
-    if (has_ascii_storage() && !locale.has_value())
+    if (!locale.has_value() && is_ascii())
         return to_ascii_lowercase();
 
     Optional<Unicode::LocaleData&> locale_data;
@@ -32,7 +32,7 @@ Utf16String Utf16String::to_lowercase(Optional<Utf16View> const& locale) const
 
 Utf16String Utf16String::to_uppercase(Optional<Utf16View> const& locale) const
 {
-    if (has_ascii_storage() && !locale.has_value())
+    if (!locale.has_value() && is_ascii())
         return to_ascii_uppercase();
 
     Optional<Unicode::LocaleData&> locale_data;
@@ -65,6 +65,10 @@ Utf16String Utf16String::to_titlecase(Optional<Utf16View> const& locale, Trailin
 
 Utf16String Utf16String::to_casefold() const
 {
+    // NB: Case folding ASCII text is the same as lowercasing it.
+    if (is_ascii())
+        return to_ascii_lowercase();
+
     auto icu_string = Unicode::icu_string(*this);
     icu_string.foldCase();
 
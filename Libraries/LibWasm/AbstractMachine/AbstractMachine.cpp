@@ -6,7 +6,10 @@
 
 #include <AK/Checked.h>
 #include <AK/Enumerate.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
 #include <AK/NeverDestroyed.h>
+#include <AK/QuickSort.h>
 #include <AK/SaturatingMath.h>
 #include <LibGC/Heap.h>
 #include <LibSync/MutexProtected.h>
@@ -93,6 +96,188 @@ void dump_module_stats()
     });
 }
 
+static Atomic<bool> s_function_profiling_enabled { false };
+
+static auto& function_profiles()
+{
+    static NeverDestroyed<Sync::MutexProtected<Vector<NonnullRefPtr<FunctionProfile>>>> profiles;
+    return *profiles;
+}
+
+void set_function_profiling_enabled(bool enabled)
+{
+    s_function_profiling_enabled.store(enabled, AK::MemoryOrder::memory_order_relaxed);
+}
+
+bool function_profiling_enabled()
+{
+    return s_function_profiling_enabled.load(AK::MemoryOrder::memory_order_relaxed);
+}
+
+void register_function_profiles(Module& module, size_t imported_function_count)
+{
+    static Atomic<u32> s_next_module_id { 0 };
+    auto const module_id = s_next_module_id.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    auto const validated_at = MonotonicTime::now().nanoseconds();
+
+    function_profiles().with_locked([&](auto& profiles) {
+        auto function_index = imported_function_count;
+        for (auto& entry : module.code_section().functions()) {
+            auto& compiled = entry.func().body().compiled_instructions;
+            auto profile = adopt_ref(*new FunctionProfile);
+            profile->module_id = module_id;
+            profile->function_index = static_cast<u32>(function_index++);
+            profile->native_eligible = compiled.cranelift_eligible;
+            profile->validated_at_ns = validated_at;
+            compiled.profile = profile;
+            profiles.append(move(profile));
+        }
+    });
+}
+
+namespace {
+
+struct FunctionProfileSnapshot {
+    u32 module_id { 0 };
+    u32 function_index { 0 };
+    bool native_eligible { false };
+    u64 interpreted_calls { 0 };
+    u64 native_calls { 0 };
+    u64 tier_up_entries { 0 };
+    u64 interpreted_instructions { 0 };
+    i64 validated_at_ns { 0 };
+    i64 first_interpreted_call_at_ns { 0 };
+    i64 native_installed_at_ns { 0 };
+
+    bool is_native() const { return native_installed_at_ns != 0; }
+
+    // Time spent waiting in the interpreter for native code, counted from the first interpreted call.
+    // Functions that were native before they were ever called didn't wait at all.
+    Optional<AK::Duration> time_to_native() const
+    {
+        if (!is_native())
+            return {};
+        if (first_interpreted_call_at_ns == 0 || native_installed_at_ns < first_interpreted_call_at_ns)
+            return AK::Duration::zero();
+        return AK::Duration::from_nanoseconds(native_installed_at_ns - first_interpreted_call_at_ns);
+    }
+};
+
+}
+
+static Vector<FunctionProfileSnapshot> snapshot_function_profiles()
+{
+    Vector<FunctionProfileSnapshot> snapshots;
+    function_profiles().with_locked([&](auto& profiles) {
+        snapshots.ensure_capacity(profiles.size());
+        for (auto const& profile : profiles) {
+            auto load = [](auto const& field) { return AK::atomic_load(&field, AK::MemoryOrder::memory_order_relaxed); };
+            snapshots.unchecked_append({
+                .module_id = profile->module_id,
+                .function_index = profile->function_index,
+                .native_eligible = profile->native_eligible,
+                .interpreted_calls = load(profile->interpreted_calls),
+                .native_calls = load(profile->native_calls),
+                .tier_up_entries = load(profile->tier_up_entries),
+                .interpreted_instructions = load(profile->interpreted_instructions),
+                .validated_at_ns = profile->validated_at_ns,
+                .first_interpreted_call_at_ns = load(profile->first_interpreted_call_at_ns),
+                .native_installed_at_ns = load(profile->native_installed_at_ns),
+            });
+        }
+    });
+    return snapshots;
+}
+
+void dump_function_profiles()
+{
+    auto snapshots = snapshot_function_profiles();
+    snapshots.remove_all_matching([](auto const& snapshot) { return snapshot.interpreted_calls == 0 && snapshot.native_calls == 0; });
+    if (snapshots.is_empty()) {
+        warnln("wasm-profile: no profiled functions were called");
+        return;
+    }
+
+    // Hottest interpreted functions first, those are the ones worth looking at when tuning tier-up.
+    quick_sort(snapshots, [](auto const& a, auto const& b) {
+        if (a.interpreted_instructions != b.interpreted_instructions)
+            return a.interpreted_instructions > b.interpreted_instructions;
+        return a.interpreted_calls + a.native_calls > b.interpreted_calls + b.native_calls;
+    });
+
+    warnln("wasm-profile: {} function(s) called", snapshots.size());
+    warnln("wasm-profile:   module   func   interp calls   native calls  tier-ups  interp insns  tier         ttn ms");
+    for (auto const& s : snapshots) {
+        StringView tier = s.is_native() ? "native"sv : (s.native_eligible ? "interpreted"sv : "ineligible"sv);
+        auto time_to_native = s.time_to_native();
+        warnln("wasm-profile:   {:>6}  {:>5}  {:>13}  {:>13}  {:>8}  {:>12}  {:<11}  {:>6}",
+            s.module_id,
+            s.function_index,
+            s.interpreted_calls,
+            s.native_calls,
+            s.tier_up_entries,
+            s.interpreted_instructions,
+            tier,
+            time_to_native.has_value() ? ByteString::number(time_to_native->to_milliseconds()) : ByteString("-"sv));
+    }
+}
+
+JsonObject function_profiles_as_json()
+{
+    auto to_microseconds = [](i64 nanoseconds) { return nanoseconds / 1000; };
+
+    JsonArray trace_events;
+    JsonArray functions;
+    for (auto const& s : snapshot_function_profiles()) {
+        auto name = ByteString::formatted("function {}", s.function_index);
+
+        JsonObject function;
+        function.set("module"sv, s.module_id);
+        function.set("function"sv, s.function_index);
+        function.set("native_eligible"sv, s.native_eligible);
+        function.set("native"sv, s.is_native());
+        function.set("interpreted_calls"sv, s.interpreted_calls);
+        function.set("native_calls"sv, s.native_calls);
+        function.set("tier_up_entries"sv, s.tier_up_entries);
+        function.set("interpreted_instructions"sv, s.interpreted_instructions);
+        if (auto time_to_native = s.time_to_native(); time_to_native.has_value())
+            function.set("time_to_native_us"sv, time_to_native->to_microseconds());
+        if (s.is_native())
+            function.set("install_after_validation_us"sv, to_microseconds(s.native_installed_at_ns - s.validated_at_ns));
+        functions.must_append(move(function));
+
+        // One track per module; a span for the time a function ran interpreted before getting native code,
+        // and an instant event when the native code was installed.
+        if (s.first_interpreted_call_at_ns != 0 && s.native_installed_at_ns > s.first_interpreted_call_at_ns) {
+            JsonObject event;
+            event.set("name"sv, ByteString::formatted("{} interpreted", name));
+            event.set("cat"sv, "wasm"sv);
+            event.set("ph"sv, "X"sv);
+            event.set("ts"sv, to_microseconds(s.first_interpreted_call_at_ns));
+            event.set("dur"sv, to_microseconds(s.native_installed_at_ns - s.first_interpreted_call_at_ns));
+            event.set("pid"sv, 0);
+            event.set("tid"sv, s.module_id);
+            trace_events.must_append(move(event));
+        }
+        if (s.is_native()) {
+            JsonObject event;
+            event.set("name"sv, ByteString::formatted("{} native", name));
+            event.set("cat"sv, "wasm"sv);
+            event.set("ph"sv, "i"sv);
+            event.set("s"sv, "t"sv);
+            event.set("ts"sv, to_microseconds(s.native_installed_at_ns));
+            event.set("pid"sv, 0);
+            event.set("tid"sv, s.module_id);
+            trace_events.must_append(move(event));
+        }
+    }
+
+    JsonObject result;
+    result.set("traceEvents"sv, move(trace_events));
+    result.set("functions"sv, move(functions));
+    return result;
+}
+
 GC_DEFINE_ALLOCATOR(StructInstance);
 GC_DEFINE_ALLOCATOR(ArrayInstance);
 
@@ -476,7 +661,7 @@ bool MemoryInstance::grow(size_t size_to_grow, GrowType grow_type, InhibitGrowCa
         successful_grow_hook();
 
     if (grow_type == GrowType::Yes)
-        m_type = MemoryType { Limits(m_type.limits().address_type(), m_type.limits().min() + size_to_grow / Constants::page_size, m_type.limits().max()) };
+        m_type = MemoryType { Limits(m_type.limits().address_type(), m_type.limits().min() + size_to_grow / Constants::page_size, m_type.limits().max(), m_type.limits().is_shared()) };
 
     return true;
 }
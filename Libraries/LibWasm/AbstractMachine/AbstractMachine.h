@@ -846,6 +846,10 @@ public:
     GC::Heap& heap() { return *m_heap; }
     void set_heap(GC::Heap& heap) { m_heap = &heap; }
 
+    // Whether the agent running this store's code may block, i.e. its [[CanBlock]]. memory.atomic.wait traps otherwise.
+    bool can_block() const { return m_can_block; }
+    void set_can_block(bool can_block) { m_can_block = can_block; }
+
     void register_configuration(Badge<Configuration>, Configuration& configuration) { m_active_configurations.set(&configuration); }
     void unregister_configuration(Badge<Configuration>, Configuration& configuration) { m_active_configurations.remove(&configuration); }
     auto& active_configurations() const { return m_active_configurations; }
@@ -867,6 +871,7 @@ private:
 
     GC::Heap* m_heap { nullptr };
     HashTable<Configuration*> m_active_configurations;
+    bool m_can_block { true };
 };
 
 class Label {
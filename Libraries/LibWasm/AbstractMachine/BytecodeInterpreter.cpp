@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/Bitmap.h>
 #include <AK/ByteReader.h>
 #include <AK/Debug.h>
@@ -21,6 +22,7 @@
 #include <AK/Time.h>
 #include <AK/TypeCasts.h>
 #include <LibCore/File.h>
+#include <LibSync/WaiterList.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
@@ -354,6 +356,37 @@ static ALWAYS_INLINE u64 memory_base_address(MemoryInstance const& memory, Value
     return base;
 }
 
+// Proposal 'threads': read-modify-write operations, each returning the value read from memory.
+struct AtomicAdd {
+    template<typename T>
+    T operator()(T* pointer, T operand) const { return AK::atomic_fetch_add(pointer, operand); }
+};
+
+struct AtomicSubtract {
+    template<typename T>
+    T operator()(T* pointer, T operand) const { return AK::atomic_fetch_sub(pointer, operand); }
+};
+
+struct AtomicAnd {
+    template<typename T>
+    T operator()(T* pointer, T operand) const { return AK::atomic_fetch_and(pointer, operand); }
+};
+
+struct AtomicOr {
+    template<typename T>
+    T operator()(T* pointer, T operand) const { return AK::atomic_fetch_or(pointer, operand); }
+};
+
+struct AtomicXor {
+    template<typename T>
+    T operator()(T* pointer, T operand) const { return AK::atomic_fetch_xor(pointer, operand); }
+};
+
+struct AtomicExchange {
+    template<typename T>
+    T operator()(T* pointer, T operand) const { return AK::atomic_exchange(pointer, operand); }
+};
+
 #define TRAP_IF_NOT(x, ...)                                                                    \
     do {                                                                                       \
         if (trap_if_not(x, #x##sv __VA_OPT__(, ) __VA_ARGS__)) {                               \
@@ -432,11 +465,23 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
         }
     }
     if (native_entry != 0) {
+        if (auto* profile = expression.compiled_instructions.profile.ptr()) [[unlikely]]
+            note_profiled_native_call(*profile);
         (void)run_native_entry(configuration);
         goto done;
     }
+    if (expression.compiled_instructions.cranelift_eligible)
+        note_interpreter_hit(expression.compiled_instructions);
     {
         auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
+        if (auto* profile = expression.compiled_instructions.profile.ptr()) [[unlikely]] {
+            note_profiled_interpreted_call(*profile);
+            // Direct threading has nowhere to count dispatches, so profiled functions take the switch loop instead.
+            if (!expression.compiled_instructions.dispatches.is_empty() && !should_limit_instruction_count) {
+                interpret_impl<true, false, false, true>(configuration, expression);
+                goto done;
+            }
+        }
         if (!expression.compiled_instructions.dispatches.is_empty()) {
             if (expression.compiled_instructions.direct) {
                 if (should_limit_instruction_count) {
@@ -1850,6 +1895,24 @@ HANDLE_INSTRUCTION(synthetic_i64_storelocal)
     TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
 }
 
+HANDLE_INSTRUCTION(synthetic_i32_loadlocal)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.load_local_and_push<i32, i32, source_address_mix>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(synthetic_i64_loadlocal)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.load_local_and_push<i64, i64, source_address_mix>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
 HANDLE_INSTRUCTION(synthetic_i64_add2local)
 {
     LOG_INSN;
@@ -2002,8 +2065,11 @@ HANDLE_INSTRUCTION(synthetic_tier_up)
         // If we have native code for this block, jump into it.
         // The code is set up such that the target checkpoint is recovered from short_ip and nothing else needs to be passed as the stack is empty and all live state is in the shared locals.
         auto const handler = bit_cast<Outcome (*)(HANDLER_PARAMS(DECOMPOSE_PARAMS_TYPE_ONLY))>(native_entry);
+        if (ci.profile) [[unlikely]]
+            note_profiled_tier_up_entry(*ci.profile);
         return handler(interpreter, configuration, cc[short_ip.current_ip_value].instruction, short_ip, cc, addresses_ptr);
     }
+    note_interpreter_hit(ci);
     TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
 }
 
@@ -6337,189 +6403,830 @@ HANDLE_INSTRUCTION(i31_get_u)
 
 #undef GC_TRAP_IF
 
-bool BytecodeInterpreter::trap_if_insufficient_native_stack_space(size_t minimum_native_stack_space_to_keep_free)
+HANDLE_INSTRUCTION(memory_atomic_notify)
 {
-    return trap_if_not(m_stack_info.size_free() >= minimum_native_stack_space_to_keep_free, Constants::stack_exhaustion_message);
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_notify(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
 }
 
-template<u64 opcode, bool HasDynamicInsnLimit, typename Continue, SourceAddressMix mix, typename... Args>
-constexpr static auto handle_instruction(Args&&... a)
+HANDLE_INSTRUCTION(memory_atomic_wait32)
 {
-    return InstructionHandler<opcode>::template operator()<HasDynamicInsnLimit, Continue, mix>(forward<Args>(a)...);
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_wait<i32>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
 }
 
-template<bool HasCompiledList, bool HasDynamicInsnLimit, bool HaveDirectThreadingInfo>
-FLATTEN void BytecodeInterpreter::interpret_impl(Configuration& configuration, Expression const& expression)
+HANDLE_INSTRUCTION(memory_atomic_wait64)
 {
-    auto& instructions = expression.instructions();
-    u64 executed_instructions = 0;
-    ShortenedIP short_ip { .current_ip_value = static_cast<u32>(configuration.ip()) };
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_wait<i64>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
 
-    auto cc = expression.compiled_instructions.dispatches.data();
-    auto addresses_ptr = expression.compiled_instructions.src_dst_mappings.data();
+HANDLE_INSTRUCTION(atomic_fence)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    AK::atomic_thread_fence(AK::memory_order_seq_cst);
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
 
-    if constexpr (HaveDirectThreadingInfo) {
-        static_assert(HasCompiledList, "Direct threading requires a compiled instruction list");
-        auto const instruction = cc[short_ip.current_ip_value].instruction;
-        auto const handler = bit_cast<Outcome (*)(HANDLER_PARAMS(DECOMPOSE_PARAMS_TYPE_ONLY))>(cc[short_ip.current_ip_value].handler_ptr);
-        handler(*this, configuration, instruction, short_ip, cc, addresses_ptr);
-        return;
-    }
+HANDLE_INSTRUCTION(i32_atomic_load)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_load_and_push<u32, i32>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
 
-    while (true) {
-        if constexpr (HasDynamicInsnLimit) {
-            if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {
-                m_trap = Trap::from_string("Exceeded maximum allowed number of instructions");
-                return;
-            }
-        }
-        // bounds checked by loop condition.
-        auto const instruction = HasCompiledList
-            ? cc[short_ip.current_ip_value].instruction
-            : &instructions.data()[short_ip.current_ip_value];
-        auto const opcode = (HasCompiledList && !HaveDirectThreadingInfo
-                ? cc[short_ip.current_ip_value].instruction_opcode
-                : instruction->opcode())
-                                .value();
+HANDLE_INSTRUCTION(i64_atomic_load)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_load_and_push<u64, i64>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
 
-#define RUN_NEXT_INSTRUCTION()       \
-    {                                \
-        ++short_ip.current_ip_value; \
-        break;                       \
-    }
+HANDLE_INSTRUCTION(i32_atomic_load8_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_load_and_push<u8, i32>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
 
-#define HANDLE_INSTRUCTION_NEW(name, ...)                                                                                                                                                \
-    case Instructions::name.value(): {                                                                                                                                                   \
-        auto outcome = handle_instruction<Instructions::name.value(), HasDynamicInsnLimit, Skip, SourceAddressMix::Any>(*this, configuration, instruction, short_ip, cc, addresses_ptr); \
-        if (outcome == Outcome::Return)                                                                                                                                                  \
-            return;                                                                                                                                                                      \
-        short_ip.current_ip_value = to_underlying(outcome);                                                                                                                              \
-        if constexpr (first_is_one_of(Instructions::name, Instructions::return_call, Instructions::return_call_indirect, Instructions::return_call_ref)) {                               \
-            cc = configuration.frame().expression().compiled_instructions.dispatches.data();                                                                                             \
-            addresses_ptr = configuration.frame().expression().compiled_instructions.src_dst_mappings.data();                                                                            \
-        }                                                                                                                                                                                \
-        RUN_NEXT_INSTRUCTION();                                                                                                                                                          \
-    }
+HANDLE_INSTRUCTION(i32_atomic_load16_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_load_and_push<u16, i32>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
 
-        dbgln_if(WASM_TRACE_DEBUG, "Executing instruction {} at current_ip_value {}", instruction_name(instruction->opcode()), short_ip.current_ip_value);
-        if ((opcode & Instructions::SyntheticInstructionBase.value()) != Instructions::SyntheticInstructionBase.value())
-            __builtin_prefetch(&instruction->arguments(), /* read */ 0, /* low temporal locality */ 1);
+HANDLE_INSTRUCTION(i64_atomic_load8_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_load_and_push<u8, i64>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
 
-        switch (opcode) {
-            ENUMERATE_WASM_OPCODES(HANDLE_INSTRUCTION_NEW)
-        default:
-            dbgln("Bad opcode {} in insn {} (ip {})", opcode, instruction_name(instruction->opcode()), short_ip.current_ip_value);
-            VERIFY_NOT_REACHED();
-        }
-    }
+HANDLE_INSTRUCTION(i64_atomic_load16_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_load_and_push<u16, i64>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
 }
 
-template<bool NeedsStackAdjustment>
-InstructionPointer BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index, InstructionPointer current_ip, bool actually_branching)
+HANDLE_INSTRUCTION(i64_atomic_load32_u)
 {
-    dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
-    auto& label_stack = configuration.label_stack();
-    label_stack.unsafe_shrink(actually_branching ? label_stack.size() - index.value() : label_stack.size());
-    auto const& label = configuration.label_stack().unsafe_last();
-    dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label.continuation().value(), label.arity());
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_load_and_push<u32, i64>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
 
-    if constexpr (NeedsStackAdjustment) {
-        if (actually_branching)
-            configuration.value_stack().remove(label.stack_height(), configuration.value_stack().size() - label.stack_height() - label.arity());
-    }
-    return actually_branching ? label.continuation().value() - 1 : current_ip;
+HANDLE_INSTRUCTION(i32_atomic_store)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_pop_and_store<i32, u32>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
 }
 
-// https://webassembly.github.io/spec/core/exec/instructions.html#xref-syntax-instructions-syntax-instr-control-mathsf-throw-ref
-Optional<InstructionPointer> BytecodeInterpreter::unwind_to_throw_handler(Configuration& configuration, ExceptionAddress exception_address)
+HANDLE_INSTRUCTION(i64_atomic_store)
 {
-    auto& exception = *configuration.store().get(exception_address);
-    auto& label_stack = configuration.label_stack();
-    auto& frame = configuration.frame();
-    auto const frame_label_index = frame.label_index();
-    for (size_t label_index = label_stack.size(); label_index > frame_label_index + 1;) {
-        --label_index;
-        auto const& label = label_stack.data()[label_index];
-        auto const* try_table_instruction = label.try_table_instruction();
-        if (!try_table_instruction)
-            continue;
-        auto& args = try_table_instruction->arguments().unsafe_get<Instruction::TryTableArgs>();
-        for (auto& catch_ : args.catches()) {
-            // catch x l / catch_ref x l match if exns[a].tag = z.module.tags[x];
-            // catch_all l / catch_all_ref l match any exception.
-            if (auto tag_index = catch_.matching_tag_index(); tag_index.has_value()) {
-                if (frame.module().tags()[tag_index->value()] != exception.tag())
-                    continue;
-            }
-            // Matched: the handler and its label should be removed, and the exception's fields (plus the exnref for the _ref forms) replace them...
-            auto& value_stack = configuration.value_stack();
-            value_stack.shrink(label.stack_height(), true);
-            if (catch_.matching_tag_index().has_value()) {
-                value_stack.ensure_capacity(value_stack.size() + exception.params().size());
-                for (auto& field : exception.params())
-                    value_stack.unchecked_append(field);
-            }
-            if (catch_.is_ref())
-                value_stack.append(Value(Reference { Reference::Exception { exception_address } }));
-            label_stack.unsafe_shrink(label_index);
-            // ...followed by (br l), with l relative to the context outside the try_table.
-            label_stack.unsafe_shrink(label_stack.size() - catch_.target_label().value());
-            auto const& target = label_stack.unsafe_last();
-            value_stack.remove(target.stack_height(), value_stack.size() - target.stack_height() - target.arity());
-            return target.continuation();
-        }
-    }
-    // No handler in this frame matched; drop its labels (the frame is being unwound) so that a re-dispatch in the calling frame only ever sees that frame's own (still active) handlers.
-    label_stack.shrink(frame_label_index, true);
-    return {};
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_pop_and_store<i64, u64>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
 }
 
-template<typename ReadType, typename PushType, SourceAddressMix mix>
-bool BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+HANDLE_INSTRUCTION(i32_atomic_store8)
 {
-    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
-    auto& address = configuration.frame().module().memories().data()[arg.memory_index.value()];
-    auto memory = configuration.store().unsafe_get(address);
-    auto& entry = configuration.source_value<mix>(0, addresses.sources); // bounds checked by verifier.
-    auto base = memory_base_address(*memory, entry);
-    Checked<u64> end_address { base };
-    end_address += arg.offset;
-    end_address += sizeof(ReadType);
-    u64 instance_address = base + arg.offset;
-    dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    if (end_address.has_overflow() || end_address.value() > memory->size()) {
-        m_trap = Trap::from_string("Memory access out of bounds");
-        dbgln_if(WASM_TRACE_DEBUG, "LibWasm: load_and_push - Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + sizeof(ReadType), memory->size());
-        return true;
-    }
-    entry = Value(static_cast<PushType>(read_value<ReadType>({ memory->data().offset_pointer(instance_address), sizeof(ReadType) })));
-    dbgln_if(WASM_TRACE_DEBUG, "  loaded value: {}", entry.value());
-    return false;
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_pop_and_store<i32, u8>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
 }
 
-template<typename TDst, typename TSrc>
-ALWAYS_INLINE static TDst convert_vector(TSrc v)
+HANDLE_INSTRUCTION(i32_atomic_store16)
 {
-    return __builtin_convertvector(v, TDst);
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_pop_and_store<i32, u16>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
 }
 
-template<size_t M, size_t N, template<typename> typename SetSign>
-bool BytecodeInterpreter::load_and_push_mxn(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+HANDLE_INSTRUCTION(i64_atomic_store8)
 {
-    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
-    auto& address = configuration.frame().module().memories().data()[arg.memory_index.value()];
-    auto memory = configuration.store().unsafe_get(address);
-    auto& entry = configuration.source_value<SourceAddressMix::Any>(0, addresses.sources); // bounds checked by verifier.
-    auto base = memory_base_address(*memory, entry);
-    Checked<u64> end_address { base };
-    end_address += arg.offset;
-    end_address += M * N / 8;
-    u64 instance_address = base + arg.offset;
-    dbgln_if(WASM_TRACE_DEBUG, "vec-load({} : {}) -> stack", instance_address, M * N / 8);
-    if (end_address.has_overflow() || end_address.value() > memory->size()) {
-        m_trap = Trap::from_string("Memory access out of bounds");
-        return true;
-    }
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_pop_and_store<i64, u8>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_store16)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_pop_and_store<i64, u16>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_store32)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_pop_and_store<i64, u32>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw_add)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u32, AtomicAdd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw_add)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u64, AtomicAdd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw8_add_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u8, AtomicAdd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw16_add_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u16, AtomicAdd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw8_add_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u8, AtomicAdd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw16_add_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u16, AtomicAdd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw32_add_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u32, AtomicAdd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw_sub)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u32, AtomicSubtract>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw_sub)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u64, AtomicSubtract>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw8_sub_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u8, AtomicSubtract>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw16_sub_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u16, AtomicSubtract>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw8_sub_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u8, AtomicSubtract>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw16_sub_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u16, AtomicSubtract>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw32_sub_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u32, AtomicSubtract>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw_and)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u32, AtomicAnd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw_and)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u64, AtomicAnd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw8_and_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u8, AtomicAnd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw16_and_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u16, AtomicAnd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw8_and_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u8, AtomicAnd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw16_and_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u16, AtomicAnd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw32_and_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u32, AtomicAnd>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw_or)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u32, AtomicOr>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw_or)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u64, AtomicOr>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw8_or_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u8, AtomicOr>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw16_or_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u16, AtomicOr>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw8_or_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u8, AtomicOr>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw16_or_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u16, AtomicOr>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw32_or_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u32, AtomicOr>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw_xor)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u32, AtomicXor>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw_xor)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u64, AtomicXor>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw8_xor_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u8, AtomicXor>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw16_xor_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u16, AtomicXor>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw8_xor_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u8, AtomicXor>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw16_xor_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u16, AtomicXor>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw32_xor_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u32, AtomicXor>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw_xchg)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u32, AtomicExchange>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw_xchg)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u64, AtomicExchange>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw8_xchg_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u8, AtomicExchange>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw16_xchg_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i32, u16, AtomicExchange>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw8_xchg_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u8, AtomicExchange>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw16_xchg_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u16, AtomicExchange>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw32_xchg_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_read_modify_write<i64, u32, AtomicExchange>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw_cmpxchg)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_compare_exchange<i32, u32>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw_cmpxchg)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_compare_exchange<i64, u64>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw8_cmpxchg_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_compare_exchange<i32, u8>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i32_atomic_rmw16_cmpxchg_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_compare_exchange<i32, u16>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw8_cmpxchg_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_compare_exchange<i64, u8>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw16_cmpxchg_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_compare_exchange<i64, u16>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(i64_atomic_rmw32_cmpxchg_u)
+{
+    LOG_INSN;
+    LOAD_ADDRESSES();
+    if (interpreter.atomic_compare_exchange<i64, u32>(configuration, *instruction, addresses))
+        return Outcome::Return;
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+bool BytecodeInterpreter::trap_if_insufficient_native_stack_space(size_t minimum_native_stack_space_to_keep_free)
+{
+    return trap_if_not(m_stack_info.size_free() >= minimum_native_stack_space_to_keep_free, Constants::stack_exhaustion_message);
+}
+
+template<u64 opcode, bool HasDynamicInsnLimit, typename Continue, SourceAddressMix mix, typename... Args>
+constexpr static auto handle_instruction(Args&&... a)
+{
+    return InstructionHandler<opcode>::template operator()<HasDynamicInsnLimit, Continue, mix>(forward<Args>(a)...);
+}
+
+template<bool HasCompiledList, bool HasDynamicInsnLimit, bool HaveDirectThreadingInfo, bool CountsInstructions>
+FLATTEN void BytecodeInterpreter::interpret_impl(Configuration& configuration, Expression const& expression)
+{
+    auto& instructions = expression.instructions();
+    u64 executed_instructions = 0;
+    ShortenedIP short_ip { .current_ip_value = static_cast<u32>(configuration.ip()) };
+
+    // Tail calls replace the frame without leaving this loop, so the count is flushed per frame.
+    constexpr bool counts_instructions = HasDynamicInsnLimit || CountsInstructions;
+    [[maybe_unused]] auto* profile = expression.compiled_instructions.profile.ptr();
+    u64 profiled_instructions_start = 0;
+    auto flush_profiled_instructions = [&] {
+        if constexpr (counts_instructions) {
+            if (profile)
+                note_profiled_interpreted_instructions(*profile, executed_instructions - profiled_instructions_start);
+            profiled_instructions_start = executed_instructions;
+        }
+    };
+    ScopeGuard flush_profiled_instructions_on_exit = [&] { flush_profiled_instructions(); };
+
+    auto cc = expression.compiled_instructions.dispatches.data();
+    auto addresses_ptr = expression.compiled_instructions.src_dst_mappings.data();
+
+    if constexpr (HaveDirectThreadingInfo) {
+        static_assert(HasCompiledList, "Direct threading requires a compiled instruction list");
+        auto const instruction = cc[short_ip.current_ip_value].instruction;
+        auto const handler = bit_cast<Outcome (*)(HANDLER_PARAMS(DECOMPOSE_PARAMS_TYPE_ONLY))>(cc[short_ip.current_ip_value].handler_ptr);
+        handler(*this, configuration, instruction, short_ip, cc, addresses_ptr);
+        return;
+    }
+
+    while (true) {
+        if constexpr (HasDynamicInsnLimit) {
+            if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {
+                m_trap = Trap::from_string("Exceeded maximum allowed number of instructions");
+                return;
+            }
+        } else if constexpr (CountsInstructions) {
+            ++executed_instructions;
+        }
+        // bounds checked by loop condition.
+        auto const instruction = HasCompiledList
+            ? cc[short_ip.current_ip_value].instruction
+            : &instructions.data()[short_ip.current_ip_value];
+        auto const opcode = (HasCompiledList && !HaveDirectThreadingInfo
+                ? cc[short_ip.current_ip_value].instruction_opcode
+                : instruction->opcode())
+                                .value();
+
+#define RUN_NEXT_INSTRUCTION()       \
+    {                                \
+        ++short_ip.current_ip_value; \
+        break;                       \
+    }
+
+#define HANDLE_INSTRUCTION_NEW(name, ...)                                                                                                                                                \
+    case Instructions::name.value(): {                                                                                                                                                   \
+        auto outcome = handle_instruction<Instructions::name.value(), HasDynamicInsnLimit, Skip, SourceAddressMix::Any>(*this, configuration, instruction, short_ip, cc, addresses_ptr); \
+        if (outcome == Outcome::Return)                                                                                                                                                  \
+            return;                                                                                                                                                                      \
+        short_ip.current_ip_value = to_underlying(outcome);                                                                                                                              \
+        if constexpr (first_is_one_of(Instructions::name, Instructions::return_call, Instructions::return_call_indirect, Instructions::return_call_ref)) {                               \
+            cc = configuration.frame().expression().compiled_instructions.dispatches.data();                                                                                             \
+            addresses_ptr = configuration.frame().expression().compiled_instructions.src_dst_mappings.data();                                                                            \
+            if constexpr (counts_instructions) {                                                                                                                                         \
+                flush_profiled_instructions();                                                                                                                                           \
+                profile = configuration.frame().expression().compiled_instructions.profile.ptr();                                                                                        \
+            }                                                                                                                                                                            \
+        }                                                                                                                                                                                \
+        RUN_NEXT_INSTRUCTION();                                                                                                                                                          \
+    }
+
+        dbgln_if(WASM_TRACE_DEBUG, "Executing instruction {} at current_ip_value {}", instruction_name(instruction->opcode()), short_ip.current_ip_value);
+        if ((opcode & Instructions::SyntheticInstructionBase.value()) != Instructions::SyntheticInstructionBase.value())
+            __builtin_prefetch(&instruction->arguments(), /* read */ 0, /* low temporal locality */ 1);
+
+        switch (opcode) {
+            ENUMERATE_WASM_OPCODES(HANDLE_INSTRUCTION_NEW)
+        default:
+            dbgln("Bad opcode {} in insn {} (ip {})", opcode, instruction_name(instruction->opcode()), short_ip.current_ip_value);
+            VERIFY_NOT_REACHED();
+        }
+    }
+}
+
+template<bool NeedsStackAdjustment>
+InstructionPointer BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index, InstructionPointer current_ip, bool actually_branching)
+{
+    dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
+    auto& label_stack = configuration.label_stack();
+    label_stack.unsafe_shrink(actually_branching ? label_stack.size() - index.value() : label_stack.size());
+    auto const& label = configuration.label_stack().unsafe_last();
+    dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label.continuation().value(), label.arity());
+
+    if constexpr (NeedsStackAdjustment) {
+        if (actually_branching)
+            configuration.value_stack().remove(label.stack_height(), configuration.value_stack().size() - label.stack_height() - label.arity());
+    }
+    return actually_branching ? label.continuation().value() - 1 : current_ip;
+}
+
+// https://webassembly.github.io/spec/core/exec/instructions.html#xref-syntax-instructions-syntax-instr-control-mathsf-throw-ref
+Optional<InstructionPointer> BytecodeInterpreter::unwind_to_throw_handler(Configuration& configuration, ExceptionAddress exception_address)
+{
+    auto& exception = *configuration.store().get(exception_address);
+    auto& label_stack = configuration.label_stack();
+    auto& frame = configuration.frame();
+    auto const frame_label_index = frame.label_index();
+    for (size_t label_index = label_stack.size(); label_index > frame_label_index + 1;) {
+        --label_index;
+        auto const& label = label_stack.data()[label_index];
+        auto const* try_table_instruction = label.try_table_instruction();
+        if (!try_table_instruction)
+            continue;
+        auto& args = try_table_instruction->arguments().unsafe_get<Instruction::TryTableArgs>();
+        for (auto& catch_ : args.catches()) {
+            // catch x l / catch_ref x l match if exns[a].tag = z.module.tags[x];
+            // catch_all l / catch_all_ref l match any exception.
+            if (auto tag_index = catch_.matching_tag_index(); tag_index.has_value()) {
+                if (frame.module().tags()[tag_index->value()] != exception.tag())
+                    continue;
+            }
+            // Matched: the handler and its label should be removed, and the exception's fields (plus the exnref for the _ref forms) replace them...
+            auto& value_stack = configuration.value_stack();
+            value_stack.shrink(label.stack_height(), true);
+            if (catch_.matching_tag_index().has_value()) {
+                value_stack.ensure_capacity(value_stack.size() + exception.params().size());
+                for (auto& field : exception.params())
+                    value_stack.unchecked_append(field);
+            }
+            if (catch_.is_ref())
+                value_stack.append(Value(Reference { Reference::Exception { exception_address } }));
+            label_stack.unsafe_shrink(label_index);
+            // ...followed by (br l), with l relative to the context outside the try_table.
+            label_stack.unsafe_shrink(label_stack.size() - catch_.target_label().value());
+            auto const& target = label_stack.unsafe_last();
+            value_stack.remove(target.stack_height(), value_stack.size() - target.stack_height() - target.arity());
+            return target.continuation();
+        }
+    }
+    // No handler in this frame matched; drop its labels (the frame is being unwound) so that a re-dispatch in the calling frame only ever sees that frame's own (still active) handlers.
+    label_stack.shrink(frame_label_index, true);
+    return {};
+}
+
+template<typename ReadType, typename PushType, SourceAddressMix mix>
+bool BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+{
+    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
+    auto& address = configuration.frame().module().memories().data()[arg.memory_index.value()];
+    auto memory = configuration.store().unsafe_get(address);
+    auto& entry = configuration.source_value<mix>(0, addresses.sources); // bounds checked by verifier.
+    auto base = memory_base_address(*memory, entry);
+    Checked<u64> end_address { base };
+    end_address += arg.offset;
+    end_address += sizeof(ReadType);
+    u64 instance_address = base + arg.offset;
+    dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
+    if (end_address.has_overflow() || end_address.value() > memory->size()) {
+        m_trap = Trap::from_string("Memory access out of bounds");
+        dbgln_if(WASM_TRACE_DEBUG, "LibWasm: load_and_push - Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + sizeof(ReadType), memory->size());
+        return true;
+    }
+    entry = Value(static_cast<PushType>(read_value<ReadType>({ memory->data().offset_pointer(instance_address), sizeof(ReadType) })));
+    dbgln_if(WASM_TRACE_DEBUG, "  loaded value: {}", entry.value());
+    return false;
+}
+
+template<typename ReadType, typename PushType, SourceAddressMix mix>
+bool BytecodeInterpreter::load_local_and_push(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+{
+    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
+    auto& address = configuration.frame().module().memories().data()[arg.memory_index.value()];
+    auto memory = configuration.store().unsafe_get(address);
+    auto base = memory_base_address(*memory, configuration.local(instruction.local_index()));
+    Checked<u64> end_address { base };
+    end_address += arg.offset;
+    end_address += sizeof(ReadType);
+    u64 instance_address = base + arg.offset;
+    dbgln_if(WASM_TRACE_DEBUG, "load(local {} -> {} : {}) -> stack", instruction.local_index().value(), instance_address, sizeof(ReadType));
+    if (end_address.has_overflow() || end_address.value() > memory->size()) {
+        m_trap = Trap::from_string("Memory access out of bounds");
+        return true;
+    }
+    configuration.push_to_destination<mix>(Value(static_cast<PushType>(read_value<ReadType>({ memory->data().offset_pointer(instance_address), sizeof(ReadType) }))), addresses.destination);
+    return false;
+}
+
+template<typename TDst, typename TSrc>
+ALWAYS_INLINE static TDst convert_vector(TSrc v)
+{
+    return __builtin_convertvector(v, TDst);
+}
+
+template<size_t M, size_t N, template<typename> typename SetSign>
+bool BytecodeInterpreter::load_and_push_mxn(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+{
+    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
+    auto& address = configuration.frame().module().memories().data()[arg.memory_index.value()];
+    auto memory = configuration.store().unsafe_get(address);
+    auto& entry = configuration.source_value<SourceAddressMix::Any>(0, addresses.sources); // bounds checked by verifier.
+    auto base = memory_base_address(*memory, entry);
+    Checked<u64> end_address { base };
+    end_address += arg.offset;
+    end_address += M * N / 8;
+    u64 instance_address = base + arg.offset;
+    dbgln_if(WASM_TRACE_DEBUG, "vec-load({} : {}) -> stack", instance_address, M * N / 8);
+    if (end_address.has_overflow() || end_address.value() > memory->size()) {
+        m_trap = Trap::from_string("Memory access out of bounds");
+        return true;
+    }
     auto const* data = memory->data().offset_pointer(instance_address);
     using V64 = NativeVectorType<M, N, SetSign>;
     using V128 = NativeVectorType<M * 2, N, SetSign>;
@@ -6821,6 +7528,151 @@ bool BytecodeInterpreter::pop_and_store_lane_n(Configuration& configuration, Ins
     return store_to_memory(configuration, memarg_and_lane.memory, { src, N / 8 }, base);
 }
 
+template<typename T>
+T* BytecodeInterpreter::atomic_access_pointer(Configuration& configuration, Instruction::MemoryArgument const& arg, Value const& base_value)
+{
+    auto const& address = configuration.frame().module().memories().data()[arg.memory_index.value()];
+    auto memory = configuration.store().unsafe_get(address);
+    Checked<u64> effective_address { memory_base_address(*memory, base_value) };
+    effective_address += arg.offset;
+    Checked<u64> end_address { effective_address };
+    end_address += sizeof(T);
+    if (end_address.has_overflow() || end_address.value() > memory->size()) {
+        m_trap = Trap::from_string("Memory access out of bounds");
+        return nullptr;
+    }
+    // Proposal 'threads': unlike regular accesses, atomic accesses trap when they are not naturally aligned.
+    if (effective_address.value() % sizeof(T) != 0) {
+        m_trap = Trap::from_string("Unaligned atomic memory access");
+        return nullptr;
+    }
+    dbgln_if(WASM_TRACE_DEBUG, "atomic access({} : {})", effective_address.value(), sizeof(T));
+    return bit_cast<T*>(memory->data().offset_pointer(effective_address.value()));
+}
+
+template<typename ReadT, typename PushT>
+bool BytecodeInterpreter::atomic_load_and_push(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+{
+    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
+    auto& entry = configuration.source_value<SourceAddressMix::Any>(0, addresses.sources); // bounds checked by verifier.
+    auto* pointer = atomic_access_pointer<ReadT>(configuration, arg, entry);
+    if (!pointer)
+        return true;
+    entry = Value(static_cast<PushT>(AK::atomic_load(pointer)));
+    return false;
+}
+
+template<typename PopT, typename StoreT>
+bool BytecodeInterpreter::atomic_pop_and_store(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+{
+    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
+    // bounds checked by verifier.
+    auto value = static_cast<StoreT>(configuration.take_source<SourceAddressMix::Any>(0, addresses.sources).template to<PopT>());
+    auto base = configuration.take_source<SourceAddressMix::Any>(1, addresses.sources);
+    auto* pointer = atomic_access_pointer<StoreT>(configuration, arg, base);
+    if (!pointer)
+        return true;
+    AK::atomic_store(pointer, value);
+    return false;
+}
+
+template<typename PopT, typename StoreT, typename Operation>
+bool BytecodeInterpreter::atomic_read_modify_write(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+{
+    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
+    // bounds checked by verifier.
+    auto operand = static_cast<StoreT>(configuration.take_source<SourceAddressMix::Any>(0, addresses.sources).template to<PopT>());
+    auto& slot = configuration.source_value<SourceAddressMix::Any>(1, addresses.sources);
+    auto* pointer = atomic_access_pointer<StoreT>(configuration, arg, slot);
+    if (!pointer)
+        return true;
+    // Narrow accesses zero-extend the value read back to the operand type.
+    slot = Value(static_cast<PopT>(Operation {}(pointer, operand)));
+    return false;
+}
+
+template<typename PopT, typename StoreT>
+bool BytecodeInterpreter::atomic_compare_exchange(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+{
+    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
+    // bounds checked by verifier.
+    auto replacement = static_cast<StoreT>(configuration.take_source<SourceAddressMix::Any>(0, addresses.sources).template to<PopT>());
+    auto expected = static_cast<StoreT>(configuration.take_source<SourceAddressMix::Any>(1, addresses.sources).template to<PopT>());
+    auto& slot = configuration.source_value<SourceAddressMix::Any>(2, addresses.sources);
+    auto* pointer = atomic_access_pointer<StoreT>(configuration, arg, slot);
+    if (!pointer)
+        return true;
+    // On failure, `expected` is updated to the value that was read; either way it holds the loaded value.
+    (void)AK::atomic_compare_exchange_strong(pointer, expected, replacement);
+    slot = Value(static_cast<PopT>(expected));
+    return false;
+}
+
+template<typename T>
+bool BytecodeInterpreter::atomic_wait(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+{
+    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
+    // bounds checked by verifier.
+    auto timeout = configuration.take_source<SourceAddressMix::Any>(0, addresses.sources).template to<i64>();
+    auto expected = configuration.take_source<SourceAddressMix::Any>(1, addresses.sources).template to<T>();
+    auto& slot = configuration.source_value<SourceAddressMix::Any>(2, addresses.sources);
+    auto* pointer = atomic_access_pointer<T>(configuration, arg, slot);
+    if (!pointer)
+        return true;
+
+    auto const& address = configuration.frame().module().memories().data()[arg.memory_index.value()];
+    if (!configuration.store().unsafe_get(address)->type().is_shared()) {
+        m_trap = Trap::from_string("Atomic wait on non-shared memory");
+        return true;
+    }
+
+    if (!configuration.store().can_block()) {
+        m_trap = Trap::from_string("Atomic wait is not allowed in this agent");
+        return true;
+    }
+
+    // A negative timeout waits forever, otherwise it is given in nanoseconds.
+    Optional<AK::Duration> duration;
+    if (timeout >= 0)
+        duration = AK::Duration::from_nanoseconds(timeout);
+
+    auto result = Sync::WaiterList::wait(pointer, [pointer, expected] { return AK::atomic_load(pointer) == expected; }, duration);
+    dbgln_if(WASM_TRACE_DEBUG, "memory.atomic.wait({}) -> {}", expected, to_underlying(result));
+    switch (result) {
+    case Sync::WaiterList::WaitResult::Woken:
+        slot = Value(static_cast<i32>(0));
+        break;
+    case Sync::WaiterList::WaitResult::NotEqual:
+        slot = Value(static_cast<i32>(1));
+        break;
+    case Sync::WaiterList::WaitResult::TimedOut:
+        slot = Value(static_cast<i32>(2));
+        break;
+    }
+    return false;
+}
+
+bool BytecodeInterpreter::atomic_notify(Configuration& configuration, Instruction const& instruction, SourcesAndDestination const& addresses)
+{
+    auto& arg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
+    // bounds checked by verifier.
+    auto count = static_cast<u32>(configuration.take_source<SourceAddressMix::Any>(0, addresses.sources).template to<i32>());
+    auto& slot = configuration.source_value<SourceAddressMix::Any>(1, addresses.sources);
+    auto* pointer = atomic_access_pointer<u32>(configuration, arg, slot);
+    if (!pointer)
+        return true;
+
+    // Nothing can be waiting on a non-shared memory.
+    auto const& address = configuration.frame().module().memories().data()[arg.memory_index.value()];
+    if (!configuration.store().unsafe_get(address)->type().is_shared()) {
+        slot = Value(static_cast<i32>(0));
+        return false;
+    }
+
+    slot = Value(static_cast<i32>(Sync::WaiterList::notify(pointer, count)));
+    return false;
+}
+
 bool BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction::MemoryArgument const& arg, ReadonlyBytes data, Value const& base_value)
 {
     auto const& address = configuration.frame().module().memories().data()[arg.memory_index.value()];
@@ -6967,6 +7819,13 @@ CompiledInstructions try_compile_instructions(Expression const& expression, Span
             // we can't zero reference-typed locals without potentially dropping a live reference, so reject those callees.
             if (local.type().is_reference())
                 return nullptr;
+            // Inlined locals are typed as plain scalars in the caller's cranelift frame.
+            if (local.type().kind() == ValueType::V128)
+                return nullptr;
+        }
+        for (auto const& parameter : functions[func_index].parameters()) {
+            if (parameter.kind() == ValueType::V128)
+                return nullptr;
         }
         for (auto& gi : callee->body().instructions()) {
             if (first_is_one_of(gi.opcode(),
@@ -7188,6 +8047,28 @@ CompiledInstructions try_compile_instructions(Expression const& expression, Span
                     local_index_0,
                     instruction.arguments());
 
+                set_default_dispatch(extra_instruction);
+                pattern_state = InsnPatternState::Nothing;
+                continue;
+            } else if (instruction.opcode() == Instructions::i32_load) {
+                // `local.get a; i32.load m` -> `i32.loadlocal a m`.
+                set_default_dispatch(nop, result.dispatches.size() - 1);
+                auto& extra_instruction = append_extra_instruction(
+                    Instructions::synthetic_i32_loadlocal,
+                    local_index_0,
+                    instruction.arguments());
+
+                set_default_dispatch(extra_instruction);
+                pattern_state = InsnPatternState::Nothing;
+                continue;
+            } else if (instruction.opcode() == Instructions::i64_load) {
+                // `local.get a; i64.load m` -> `i64.loadlocal a m`.
+                set_default_dispatch(nop, result.dispatches.size() - 1);
+                auto& extra_instruction = append_extra_instruction(
+                    Instructions::synthetic_i64_loadlocal,
+                    local_index_0,
+                    instruction.arguments());
+
                 set_default_dispatch(extra_instruction);
                 pattern_state = InsnPatternState::Nothing;
                 continue;
@@ -7331,6 +8212,30 @@ CompiledInstructions try_compile_instructions(Expression const& expression, Span
                 pattern_state = InsnPatternState::Nothing;
                 continue;
             }
+            if (instruction.opcode() == Instructions::i32_load) {
+                // `local.get a; i32.load m` -> `i32.loadlocal a m`.
+                set_default_dispatch(nop, result.dispatches.size() - 1);
+                auto& extra_instruction = append_extra_instruction(
+                    Instructions::synthetic_i32_loadlocal,
+                    local_index_1,
+                    instruction.arguments());
+
+                set_default_dispatch(extra_instruction);
+                pattern_state = InsnPatternState::Nothing;
+                continue;
+            }
+            if (instruction.opcode() == Instructions::i64_load) {
+                // `local.get a; i64.load m` -> `i64.loadlocal a m`.
+                set_default_dispatch(nop, result.dispatches.size() - 1);
+                auto& extra_instruction = append_extra_instruction(
+                    Instructions::synthetic_i64_loadlocal,
+                    local_index_1,
+                    instruction.arguments());
+
+                set_default_dispatch(extra_instruction);
+                pattern_state = InsnPatternState::Nothing;
+                continue;
+            }
             if (instruction.opcode() == Instructions::i32_const) {
                 swap(local_index_0, local_index_1);
                 i32_const_value = instruction.arguments().get<i32>();
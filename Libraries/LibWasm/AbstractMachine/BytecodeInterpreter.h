@@ -71,7 +71,8 @@ struct WASM_API BytecodeInterpreter final : public Interpreter {
         UsingStack,
     };
 
-    template<bool HasCompiledList, bool HasDynamicInsnLimit, bool HaveDirectThreadingInfo>
+    // CountsInstructions attributes executed dispatches to each frame's FunctionProfile; HasDynamicInsnLimit counts them anyway.
+    template<bool HasCompiledList, bool HasDynamicInsnLimit, bool HaveDirectThreadingInfo, bool CountsInstructions = false>
     void interpret_impl(Configuration&, Expression const&);
 
     template<bool NeedsStackAdjustment>
@@ -79,6 +80,8 @@ struct WASM_API BytecodeInterpreter final : public Interpreter {
     Optional<InstructionPointer> unwind_to_throw_handler(Configuration&, ExceptionAddress);
     template<typename ReadT, typename PushT, SourceAddressMix>
     bool load_and_push(Configuration&, Instruction const&, SourcesAndDestination const&);
+    template<typename ReadT, typename PushT, SourceAddressMix>
+    bool load_local_and_push(Configuration&, Instruction const&, SourcesAndDestination const&);
     template<typename PopT, typename StoreT>
     bool pop_and_store(Configuration&, Instruction const&, SourcesAndDestination const&);
     template<typename StoreT>
@@ -100,6 +103,19 @@ struct WASM_API BytecodeInterpreter final : public Interpreter {
     template<typename M, template<typename> typename SetSign, typename VectorType = Native128ByteVectorOf<M, SetSign>>
     VectorType pop_vector(Configuration&, size_t source, SourcesAndDestination const&);
     bool store_to_memory(Configuration&, Instruction::MemoryArgument const&, ReadonlyBytes data, Value const& base);
+    template<typename T>
+    T* atomic_access_pointer(Configuration&, Instruction::MemoryArgument const&, Value const& base);
+    template<typename ReadT, typename PushT>
+    bool atomic_load_and_push(Configuration&, Instruction const&, SourcesAndDestination const&);
+    template<typename PopT, typename StoreT>
+    bool atomic_pop_and_store(Configuration&, Instruction const&, SourcesAndDestination const&);
+    template<typename PopT, typename StoreT, typename Operation>
+    bool atomic_read_modify_write(Configuration&, Instruction const&, SourcesAndDestination const&);
+    template<typename PopT, typename StoreT>
+    bool atomic_compare_exchange(Configuration&, Instruction const&, SourcesAndDestination const&);
+    template<typename T>
+    bool atomic_wait(Configuration&, Instruction const&, SourcesAndDestination const&);
+    bool atomic_notify(Configuration&, Instruction const&, SourcesAndDestination const&);
     Outcome call_address(Configuration&, FunctionAddress, SourcesAndDestination const&, CallAddressSource = CallAddressSource::DirectCall, CallType = CallType::UsingStack);
     Outcome run_compiled_function_direct(Configuration&);
     Outcome run_native_entry(Configuration&);
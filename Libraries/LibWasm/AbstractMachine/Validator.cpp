@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/GenericShorthands.h>
 #include <AK/HashTable.h>
 #include <AK/SourceLocation.h>
@@ -164,6 +165,9 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
     for (auto& entry : module.code_section().functions())
         module.set_minimum_call_record_allocation_size(max(entry.func().body().compiled_instructions.max_call_rec_size, module.minimum_call_record_allocation_size()));
 
+    if (function_profiling_enabled())
+        register_function_profiles(module, m_context.imported_function_count);
+
     module.set_validation_status(Module::ValidationStatus::Valid, {});
     return {};
 }
@@ -496,6 +500,10 @@ ErrorOr<void, ValidationError> Validator::validate(TableType const& type)
 
 ErrorOr<void, ValidationError> Validator::validate(MemoryType const& type)
 {
+    // Proposal 'threads': shared memories must declare a maximum size.
+    if (type.is_shared() && !type.limits().max().has_value())
+        return Errors::invalid("shared memory limits (maximum required)"sv);
+
     u64 bound = type.limits().address_type() == AddressType::I64 ? 1ull << 48 : Constants::wasm32_max_pages;
     return validate(type.limits(), bound);
 }
@@ -5066,95 +5074,975 @@ VALIDATE_INSTRUCTION(i31_get_u)
     return {};
 }
 
-VALIDATE_INSTRUCTION(synthetic_end_expression)
+VALIDATE_INSTRUCTION(memory_atomic_notify)
 {
-    is_constant = true;
-    return {}; // Always valid.
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
 }
 
-ErrorOr<void, ValidationError> Validator::validate(Instruction const& instruction, Stack& stack, bool& is_constant)
+VALIDATE_INSTRUCTION(memory_atomic_wait32)
 {
-    switch (instruction.opcode().value()) {
-#define M(name, integer_value, ...)                                              \
-    case Instructions::name.value():                                             \
-        dbgln_if(WASM_VALIDATOR_DEBUG, "checking {}, stack = {}", #name, stack); \
-        return validate_instruction<integer_value>(instruction, stack, is_constant);
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
 
-        ENUMERATE_WASM_OPCODES(M)
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
 
-#undef M
-    default:
-        is_constant = false;
-        return Errors::invalid(ByteString::formatted("instruction opcode ({:#x})", instruction.opcode().value()));
-    }
+    TRY((stack.take<ValueType::I64>()));
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
 }
 
-ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Expression const& expression, Vector<ValueType> const& result_types, Span<CodeSection::Func const* const> callee_bodies, size_t current_function_index)
+VALIDATE_INSTRUCTION(memory_atomic_wait64)
 {
-    if (m_frames.is_empty())
-        m_frames.empend(FunctionType { {}, result_types }, FrameKind::Function, (size_t)0);
-    auto stack = Stack(m_frames, m_context.type_context());
-    bool is_constant_expression = true;
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
 
-    for (auto& instruction : expression.instructions()) {
-        bool is_constant = false;
-        TRY(validate(instruction, stack, is_constant));
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i64)));
 
-        is_constant_expression &= is_constant;
-    }
+    TRY((stack.take<ValueType::I64>()));
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
 
-    auto expected_result_types = result_types;
-    while (!expected_result_types.is_empty())
-        TRY(stack.take(expected_result_types.take_last()));
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
 
-    for (auto& type : result_types)
-        stack.append(type);
-    m_frames.take_last();
+VALIDATE_INSTRUCTION(atomic_fence)
+{
+    return {};
+}
 
-    expression.set_stack_usage_hint(stack.max_known_size());
-    expression.set_frame_usage_hint(m_max_frame_size);
+VALIDATE_INSTRUCTION(i32_atomic_load)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
 
-    VERIFY(m_frames.is_empty());
-    m_max_frame_size = 0;
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
 
-    // Now that we're in happy land, try to compile the expression down to a list of labels to help dispatch.
-    expression.compiled_instructions = try_compile_instructions(expression, m_context.functions.span(), callee_bodies, current_function_index, m_context.locals.size(), m_context.imported_function_count);
+    TRY((take_memory_address(stack, memory, arg)));
 
-    if (expression.compiled_instructions.direct && !is_constant_expression) {
-        bool has_unsupported_types = false;
-        for (auto& type : m_context.locals) {
-            if (type.is_reference() || type.kind() == ValueType::V128) {
-                has_unsupported_types = true;
-                break;
-            }
-        }
-        if (!has_unsupported_types) {
-            for (auto& type : result_types) {
-                if (type.is_reference() || type.kind() == ValueType::V128) {
-                    has_unsupported_types = true;
-                    break;
-                }
-            }
-        }
-        // Also skip 64-bit addressing (cranelift truncates base to u32).
-        if (!has_unsupported_types) {
-            for (auto& mem : m_context.memories) {
-                if (mem.limits().address_type() == AddressType::I64) {
-                    has_unsupported_types = true;
-                    break;
-                }
-            }
-        }
-        // Also skip if any call targets a function with multi-value returns.
-        if (!has_unsupported_types) {
-            for (auto& insn : expression.instructions()) {
-                if (insn.opcode() == Instructions::call) {
-                    auto func_idx = insn.arguments().get<FunctionIndex>().value();
-                    if (func_idx < m_context.functions.size() && m_context.functions[func_idx].results().size() > 1) {
-                        has_unsupported_types = true;
-                        break;
-                    }
-                }
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_load)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i64)));
+
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_load8_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_load16_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_load8_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_load16_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_load32_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 32 / 8));
+
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_store)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_store)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i64)));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_store8)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_store16)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_store8)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_store16)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_store32)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 32 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw_add)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw_add)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i64)));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw8_add_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw16_add_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw8_add_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw16_add_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw32_add_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 32 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw_sub)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw_sub)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i64)));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw8_sub_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw16_sub_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw8_sub_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw16_sub_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw32_sub_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 32 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw_and)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw_and)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i64)));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw8_and_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw16_and_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw8_and_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw16_and_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw32_and_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 32 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw_or)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw_or)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i64)));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw8_or_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw16_or_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw8_or_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw16_or_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw32_or_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 32 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw_xor)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw_xor)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i64)));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw8_xor_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw16_xor_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw8_xor_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw16_xor_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw32_xor_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 32 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw_xchg)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw_xchg)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i64)));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw8_xchg_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw16_xchg_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw8_xchg_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw16_xchg_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw32_xchg_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 32 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw_cmpxchg)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i32)));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw_cmpxchg)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, sizeof(i64)));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw8_cmpxchg_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32_atomic_rmw16_cmpxchg_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I32>()));
+    TRY((stack.take<ValueType::I32>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw8_cmpxchg_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 8 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw16_cmpxchg_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 16 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64_atomic_rmw32_cmpxchg_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+
+    auto memory = TRY(validate_atomic_memory_argument(arg, 32 / 8));
+
+    TRY((stack.take<ValueType::I64>()));
+    TRY((stack.take<ValueType::I64>()));
+    TRY((take_memory_address(stack, memory, arg)));
+
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(synthetic_end_expression)
+{
+    is_constant = true;
+    return {}; // Always valid.
+}
+
+ErrorOr<void, ValidationError> Validator::validate(Instruction const& instruction, Stack& stack, bool& is_constant)
+{
+    switch (instruction.opcode().value()) {
+#define M(name, integer_value, ...)                                              \
+    case Instructions::name.value():                                             \
+        dbgln_if(WASM_VALIDATOR_DEBUG, "checking {}, stack = {}", #name, stack); \
+        return validate_instruction<integer_value>(instruction, stack, is_constant);
+
+        ENUMERATE_WASM_OPCODES(M)
+
+#undef M
+    default:
+        is_constant = false;
+        return Errors::invalid(ByteString::formatted("instruction opcode ({:#x})", instruction.opcode().value()));
+    }
+}
+
+ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Expression const& expression, Vector<ValueType> const& result_types, Span<CodeSection::Func const* const> callee_bodies, size_t current_function_index)
+{
+    if (m_frames.is_empty())
+        m_frames.empend(FunctionType { {}, result_types }, FrameKind::Function, (size_t)0);
+    auto stack = Stack(m_frames, m_context.type_context());
+    bool is_constant_expression = true;
+
+    for (auto& instruction : expression.instructions()) {
+        bool is_constant = false;
+        TRY(validate(instruction, stack, is_constant));
+
+        is_constant_expression &= is_constant;
+    }
+
+    auto expected_result_types = result_types;
+    while (!expected_result_types.is_empty())
+        TRY(stack.take(expected_result_types.take_last()));
+
+    for (auto& type : result_types)
+        stack.append(type);
+    m_frames.take_last();
+
+    expression.set_stack_usage_hint(stack.max_known_size());
+    expression.set_frame_usage_hint(m_max_frame_size);
+
+    VERIFY(m_frames.is_empty());
+    m_max_frame_size = 0;
+
+    // Now that we're in happy land, try to compile the expression down to a list of labels to help dispatch.
+    expression.compiled_instructions = try_compile_instructions(expression, m_context.functions.span(), callee_bodies, current_function_index, m_context.locals.size(), m_context.imported_function_count);
+
+    if (expression.compiled_instructions.direct && !is_constant_expression) {
+        bool has_unsupported_types = false;
+        for (auto& type : m_context.locals) {
+            if (type.is_reference()) {
+                has_unsupported_types = true;
+                break;
+            }
+        }
+        if (!has_unsupported_types) {
+            for (auto& type : result_types) {
+                if (type.is_reference() || type.kind() == ValueType::V128) {
+                    has_unsupported_types = true;
+                    break;
+                }
+            }
+        }
+        // Also skip 64-bit addressing (cranelift truncates base to u32).
+        if (!has_unsupported_types) {
+            for (auto& mem : m_context.memories) {
+                if (mem.limits().address_type() == AddressType::I64) {
+                    has_unsupported_types = true;
+                    break;
+                }
+            }
+        }
+        // Also skip if any call targets a function with multi-value returns.
+        if (!has_unsupported_types) {
+            for (auto& insn : expression.instructions()) {
+                if (insn.opcode() == Instructions::call) {
+                    auto func_idx = insn.arguments().get<FunctionIndex>().value();
+                    if (func_idx < m_context.functions.size() && m_context.functions[func_idx].results().size() > 1) {
+                        has_unsupported_types = true;
+                        break;
+                    }
+                }
+            }
+        }
+        // Also skip vectors crossing calls or globals, cranelift only moves 64 bits through those.
+        if (!has_unsupported_types) {
+            auto involves_v128 = [](FunctionType const& function_type) {
+                auto is_v128 = [](ValueType const& type) { return type.kind() == ValueType::V128; };
+                return any_of(function_type.parameters(), is_v128) || any_of(function_type.results(), is_v128);
+            };
+            for (auto& insn : expression.instructions()) {
+                auto opcode = insn.opcode();
+                if (opcode == Instructions::call) {
+                    auto func_idx = insn.arguments().get<FunctionIndex>().value();
+                    has_unsupported_types = func_idx < m_context.functions.size() && involves_v128(m_context.functions[func_idx]);
+                } else if (opcode == Instructions::call_indirect) {
+                    auto type_idx = insn.arguments().get<Instruction::IndirectCallArgs>().type.value();
+                    has_unsupported_types = type_idx < m_context.types.size() && m_context.types[type_idx].is_function() && involves_v128(m_context.types[type_idx].function());
+                } else if (opcode == Instructions::global_get || opcode == Instructions::global_set) {
+                    auto global_idx = insn.arguments().get<GlobalIndex>().value();
+                    has_unsupported_types = global_idx < m_context.globals.size() && m_context.globals[global_idx].type().kind() == ValueType::V128;
+                }
+                if (has_unsupported_types)
+                    break;
             }
         }
         // Also skip multi-value return functions.
@@ -354,6 +354,17 @@ public:
         return {};
     }
 
+    // Proposal 'threads': atomic accesses must declare exactly their natural alignment.
+    ErrorOr<MemoryType, ValidationError> validate_atomic_memory_argument(Instruction::MemoryArgument const& arg, size_t access_size) const
+    {
+        auto memory = TRY(validate(arg.memory_index));
+        if (arg.align > 64)
+            return Errors::out_of_bounds("memory op alignment value"sv, arg.align, 0, 64);
+        if ((1ull << arg.align) != access_size)
+            return Errors::invalid("atomic memory op alignment"sv, access_size, 1ull << arg.align);
+        return memory;
+    }
+
 private:
     explicit Validator(Context context)
         : m_context(move(context))
@@ -9,6 +9,7 @@
 #include <AK/LexicalPath.h>
 #include <AK/NeverDestroyed.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <CraneliftFFI.h>
 #include <LibCore/Process.h>
@@ -82,6 +83,9 @@ static constexpr size_t oop_code_region_min_size = 256 * KiB;
 static constexpr size_t oop_code_bytes_per_insn = 256;
 static constexpr size_t oop_reloc_region_min_size = 64 * KiB;
 static constexpr size_t oop_reloc_bytes_per_insn = 128;
+// Functions that already ran in the interpreter are compiled in a separate, smaller batch ahead of
+// everything else, so that they get installed without waiting for the rest of the module.
+static constexpr size_t oop_hot_batch_max_functions = 64;
 
 static size_t align_up(size_t value, size_t alignment)
 {
@@ -97,13 +101,14 @@ struct BatchInput {
     CompiledInstructions* target;
     u32 num_locals;
     u32 num_params;
+    u32 hit_count { 0 }; // Snapshot of the target's interpreter_hit_count, taken when the batch is flushed.
 };
 
 // Disk-cache blob format. Stable: cached files name format_version + layout_hash so
 // any rebuild that changes those will simply miss the cache rather than try to
 // execute incompatible bytes.
 constexpr u64 cache_blob_magic = 0x4354494A4D534157ULL; // "WASMJITC" little-endian
-constexpr u32 cache_blob_format_version = 9;
+constexpr u32 cache_blob_format_version = 12;
 
 struct CacheBlobHeader {
     u64 magic;
@@ -185,7 +190,8 @@ static u64 compute_layout_hash(RuntimeHelpers const& h)
 static_assert(offsetof(RuntimeHelpers, call_function) == 0);
 static_assert(offsetof(RuntimeHelpers, memory_fill) == sizeof(size_t) * 30);
 static_assert(offsetof(RuntimeHelpers, primitive_storage_cage_base) == sizeof(size_t) * 31);
-static_assert(HELPER_COUNT == 32);
+static_assert(offsetof(RuntimeHelpers, memory_base) == sizeof(size_t) * 32);
+static_assert(HELPER_COUNT == 33);
 
 static bool apply_helper_relocs(u8* code_bytes, size_t code_size, HelperReloc const* relocs, size_t reloc_count, RuntimeHelpers const& helpers)
 {
@@ -275,6 +281,8 @@ static bool install_compiled_function(CompiledInstructions& target, ReadonlyByte
     target.cranelift_traps = handle->traps.data();
     target.cranelift_trap_count = handle->traps.size();
     target.cranelift_compiled = true;
+    if (target.profile)
+        note_profiled_native_install(*target.profile);
     publish_cranelift_entry(target, bit_cast<FlatPtr>(func_ptr));
     return true;
 }
@@ -288,6 +296,8 @@ static ALWAYS_INLINE i32 wasm_cl_run_compiled(BytecodeInterpreter& interpreter,
     BytecodeInterpreter::CallFrameHandle handle { interpreter, config };
     config.set_frame_lightweight(*entry.module, callee_locals, *entry.expression, entry.arity);
     config.ip() = 0;
+    if (auto* profile = entry.expression->compiled_instructions.profile.ptr()) [[unlikely]]
+        note_profiled_native_call(*profile);
 
     interpreter.clear_trap();
     using HandlerFn = Outcome (*)(BytecodeInterpreter&, Configuration&, Instruction const*, u32, Dispatch const*, SourcesAndDestination const*);
@@ -364,8 +374,8 @@ static ALWAYS_INLINE i32 wasm_cl_finish_call(BytecodeInterpreter& interpreter, C
     for (size_t i = 0; i < arg_count; i++)
         args_vec.unchecked_append(args[i]);
 
-    // direct-threaded interpreter path:
-    if (auto* wasm_function = instance->get_pointer<WasmFunction>(); wasm_function && !config.should_limit_instruction_count() && wasm_function->code().func().body().compiled_instructions.direct) {
+    // direct-threaded interpreter path (profiled functions go through interpret() below, which counts their instructions):
+    if (auto* wasm_function = instance->get_pointer<WasmFunction>(); wasm_function && !config.should_limit_instruction_count() && wasm_function->code().func().body().compiled_instructions.direct && !wasm_function->code().func().body().compiled_instructions.profile) {
         BytecodeInterpreter::CallFrameHandle handle { interpreter, config };
         if (auto prepare_result = config.prepare_wasm_call(*wasm_function, args_vec); prepare_result.is_error()) {
             interpreter.set_trap(prepare_result.release_error());
@@ -614,6 +624,16 @@ i32 wasm_cl_memory_store64(void* interp_ptr, void* config_ptr, i32 mem_idx, i64
     return 0;
 }
 
+// memory32 storage always reserves the full 4GiB + offset span plus a guard, and grows in place,
+// so the base stays valid for the whole call and out-of-bounds accesses fault instead of needing checks.
+u8* wasm_cl_memory_base(void* config_ptr, i32 mem_idx);
+u8* wasm_cl_memory_base(void* config_ptr, i32 mem_idx)
+{
+    auto* memory = wasm_cl_get_memory(config_ptr, mem_idx);
+    VERIFY(memory->type().limits().address_type() == AddressType::I32);
+    return memory->data().data();
+}
+
 i64 wasm_cl_memory_size(void* config_ptr, i32 mem_idx);
 i64 wasm_cl_memory_size(void* config_ptr, i32 mem_idx)
 {
@@ -968,6 +988,7 @@ static RuntimeHelpers make_runtime_helpers()
         .memory_copy = bit_cast<uintptr_t>(&wasm_cl_memory_copy),
         .memory_fill = bit_cast<uintptr_t>(&wasm_cl_memory_fill),
         .primitive_storage_cage_base = bit_cast<uintptr_t>(&js_primitive_storage_cage_base),
+        .memory_base = bit_cast<uintptr_t>(&wasm_cl_memory_base),
         .regs_offset = static_cast<u32>(offsetof(Configuration, regs)),
         .value_size = static_cast<u32>(sizeof(Value)),
         .locals_base_offset = static_cast<u32>(Configuration::locals_base_offset()),
@@ -1063,10 +1084,42 @@ static CraneliftInsn serialize_insn(Dispatch const& dispatch, SourcesAndDestinat
         auto const& mem_arg = args.get<Instruction::MemoryArgument>();
         out.imm1 = static_cast<i64>(mem_arg.offset);
         out.imm3 = static_cast<u32>(mem_arg.memory_index.value());
+    } else if (opc >= Instructions::memory_atomic_notify.value() && opc <= Instructions::i64_atomic_rmw32_cmpxchg_u.value()
+        && opc != Instructions::atomic_fence.value()) {
+        auto const& mem_arg = args.get<Instruction::MemoryArgument>();
+        out.imm1 = static_cast<i64>(mem_arg.offset);
+        out.imm3 = static_cast<u32>(mem_arg.memory_index.value());
     } else if (opc == Instructions::memory_size.value()
         || opc == Instructions::memory_grow.value()) {
         auto const& mem_idx_arg = args.get<Instruction::MemoryIndexArgument>();
         out.imm1 = static_cast<i64>(mem_idx_arg.memory_index.value());
+    } else if ((opc >= Instructions::v128_load.value() && opc <= Instructions::v128_store.value())
+        || opc == Instructions::v128_load32_zero.value()
+        || opc == Instructions::v128_load64_zero.value()) {
+        auto const& mem_arg = args.get<Instruction::MemoryArgument>();
+        out.imm1 = static_cast<i64>(mem_arg.offset);
+        out.imm3 = static_cast<u32>(mem_arg.memory_index.value());
+    } else if (opc >= Instructions::v128_load8_lane.value() && opc <= Instructions::v128_store64_lane.value()) {
+        auto const& lane_arg = args.get<Instruction::MemoryAndLaneArgument>();
+        out.imm1 = static_cast<i64>(lane_arg.memory.offset);
+        out.imm2 = static_cast<i64>(lane_arg.lane);
+        out.imm3 = static_cast<u32>(lane_arg.memory.memory_index.value());
+    } else if (opc == Instructions::v128_const.value()) {
+        auto const& value = args.get<u128>();
+        out.imm1 = static_cast<i64>(value.low());
+        out.imm2 = static_cast<i64>(value.high());
+    } else if (opc == Instructions::i8x16_shuffle.value()) {
+        // Lanes are packed little-endian, lanes 0-7 in imm1 and 8-15 in imm2.
+        auto const& shuffle_args = args.get<Instruction::ShuffleArgument>();
+        for (size_t i = 0; i < 16; ++i) {
+            auto const encoded = static_cast<u64>(shuffle_args.lanes[i]) << ((i % 8) * 8);
+            if (i < 8)
+                out.imm1 |= static_cast<i64>(encoded);
+            else
+                out.imm2 |= static_cast<i64>(encoded);
+        }
+    } else if (opc >= Instructions::i8x16_extract_lane_s.value() && opc <= Instructions::f64x2_replace_lane.value()) {
+        out.imm1 = static_cast<i64>(args.get<Instruction::LaneIndex>().lane);
     }
 
     auto is_syn = [opc](OpCode op) { return opc == op.value(); };
@@ -1095,7 +1148,8 @@ static CraneliftInsn serialize_insn(Dispatch const& dispatch, SourcesAndDestinat
         } else if (is_syn(Instructions::synthetic_i64_addconstlocal) || is_syn(Instructions::synthetic_i64_andconstlocal)) {
             out.imm1 = args.get<i64>();
             out.imm2 = static_cast<i64>(insn->local_index().value());
-        } else if (is_syn(Instructions::synthetic_i32_storelocal) || is_syn(Instructions::synthetic_i64_storelocal)) {
+        } else if (is_syn(Instructions::synthetic_i32_storelocal) || is_syn(Instructions::synthetic_i64_storelocal)
+            || is_syn(Instructions::synthetic_i32_loadlocal) || is_syn(Instructions::synthetic_i64_loadlocal)) {
             auto const& mem_arg = args.get<Instruction::MemoryArgument>();
             out.imm1 = static_cast<i64>(mem_arg.offset);
             out.imm2 = static_cast<i64>(insn->local_index().value());
@@ -1502,10 +1556,36 @@ bool try_cranelift_compile(CompiledInstructions& compiled, u32 result_arity)
 
 void flush_cranelift_batch()
 {
-    if (cranelift_cache_state().pending_batch.is_empty())
+    auto& batch = cranelift_cache_state().pending_batch;
+    if (batch.is_empty())
         return;
-    try_cranelift_compile_batch(cranelift_cache_state().pending_batch);
-    cranelift_cache_state().pending_batch.clear();
+
+    // The compiler hands out functions to its worker threads in batch order, so put the hottest ones
+    // first, and otherwise the largest ones first so that no thread is left with a big function at the end.
+    size_t hot_count = 0;
+    for (auto& entry : batch) {
+        entry.hit_count = AK::atomic_load(&entry.target->interpreter_hit_count, AK::MemoryOrder::memory_order_relaxed);
+        if (entry.hit_count != 0)
+            ++hot_count;
+    }
+    quick_sort(batch, [](BatchInput const& a, BatchInput const& b) {
+        if (a.hit_count != b.hit_count)
+            return a.hit_count > b.hit_count;
+        return a.insns.size() > b.insns.size();
+    });
+
+    hot_count = min(hot_count, oop_hot_batch_max_functions);
+    if (hot_count != 0 && hot_count < batch.size()) {
+        Vector<BatchInput> hot_batch;
+        hot_batch.ensure_capacity(hot_count);
+        for (size_t i = 0; i < hot_count; ++i)
+            hot_batch.unchecked_append(move(batch[i]));
+        batch.remove(0, hot_count);
+        try_cranelift_compile_batch(hot_batch);
+    }
+
+    try_cranelift_compile_batch(batch);
+    batch.clear();
 }
 
 void discard_cranelift_batch()
@@ -290,10 +290,12 @@ ParseResult<Limits> Limits::parse(ConstrainedStream& stream)
     auto flag = TRY_READ(stream, u8, ParseError::ExpectedKindTag);
 
     // Proposal 'memory64': flags 0/1 refer to 32-bit limits, flags 4/5 refer to 64-bit limits.
-    if (flag & ~0b00000101)
+    // Proposal 'threads': flag bit 1 marks the limits as shared.
+    if (flag & ~0b00000111)
         return with_eof_check(stream, ParseError::InvalidTag);
 
     auto address_type = (flag & 0b00000100) ? AddressType::I64 : AddressType::I32;
+    auto is_shared = (flag & 0b00000010) != 0;
 
     auto min_or_error = stream.read_value<LEB128<u64>>();
     if (min_or_error.is_error())
@@ -308,7 +310,7 @@ ParseResult<Limits> Limits::parse(ConstrainedStream& stream)
         max = value_or_error.release_value();
     }
 
-    return Limits { address_type, min, move(max) };
+    return Limits { address_type, min, move(max), is_shared };
 }
 
 ParseResult<MemoryType> MemoryType::parse(ConstrainedStream& stream)
@@ -325,6 +327,8 @@ ParseResult<TableType> TableType::parse(ConstrainedStream& stream)
     if (!type_result.is_reference())
         return ParseError::InvalidType;
     auto limits_result = TRY(Limits::parse(stream));
+    if (limits_result.is_shared())
+        return with_eof_check(stream, ParseError::InvalidTag);
     return TableType { type_result, limits_result };
 }
 
@@ -739,7 +743,8 @@ ParseResult<Instruction> Instruction::parse(ConstrainedStream& stream)
         return Instruction { opcode };
     case 0xfb:
     case 0xfc:
-    case 0xfd: {
+    case 0xfd:
+    case 0xfe: {
         // These are multibyte instructions.
         auto selector = TRY_READ(stream, LEB128<u32>, ParseError::InvalidInput);
         if (selector > 0xffffff)
@@ -1226,6 +1231,94 @@ ParseResult<Instruction> Instruction::parse(ConstrainedStream& stream)
         case Instructions::i32x4_relaxed_dot_i8x16_i7x16_add_s.value():
             // op
             return Instruction { full_opcode };
+        case Instructions::memory_atomic_notify.value():
+        case Instructions::memory_atomic_wait32.value():
+        case Instructions::memory_atomic_wait64.value():
+        case Instructions::i32_atomic_load.value():
+        case Instructions::i64_atomic_load.value():
+        case Instructions::i32_atomic_load8_u.value():
+        case Instructions::i32_atomic_load16_u.value():
+        case Instructions::i64_atomic_load8_u.value():
+        case Instructions::i64_atomic_load16_u.value():
+        case Instructions::i64_atomic_load32_u.value():
+        case Instructions::i32_atomic_store.value():
+        case Instructions::i64_atomic_store.value():
+        case Instructions::i32_atomic_store8.value():
+        case Instructions::i32_atomic_store16.value():
+        case Instructions::i64_atomic_store8.value():
+        case Instructions::i64_atomic_store16.value():
+        case Instructions::i64_atomic_store32.value():
+        case Instructions::i32_atomic_rmw_add.value():
+        case Instructions::i64_atomic_rmw_add.value():
+        case Instructions::i32_atomic_rmw8_add_u.value():
+        case Instructions::i32_atomic_rmw16_add_u.value():
+        case Instructions::i64_atomic_rmw8_add_u.value():
+        case Instructions::i64_atomic_rmw16_add_u.value():
+        case Instructions::i64_atomic_rmw32_add_u.value():
+        case Instructions::i32_atomic_rmw_sub.value():
+        case Instructions::i64_atomic_rmw_sub.value():
+        case Instructions::i32_atomic_rmw8_sub_u.value():
+        case Instructions::i32_atomic_rmw16_sub_u.value():
+        case Instructions::i64_atomic_rmw8_sub_u.value():
+        case Instructions::i64_atomic_rmw16_sub_u.value():
+        case Instructions::i64_atomic_rmw32_sub_u.value():
+        case Instructions::i32_atomic_rmw_and.value():
+        case Instructions::i64_atomic_rmw_and.value():
+        case Instructions::i32_atomic_rmw8_and_u.value():
+        case Instructions::i32_atomic_rmw16_and_u.value():
+        case Instructions::i64_atomic_rmw8_and_u.value():
+        case Instructions::i64_atomic_rmw16_and_u.value():
+        case Instructions::i64_atomic_rmw32_and_u.value():
+        case Instructions::i32_atomic_rmw_or.value():
+        case Instructions::i64_atomic_rmw_or.value():
+        case Instructions::i32_atomic_rmw8_or_u.value():
+        case Instructions::i32_atomic_rmw16_or_u.value():
+        case Instructions::i64_atomic_rmw8_or_u.value():
+        case Instructions::i64_atomic_rmw16_or_u.value():
+        case Instructions::i64_atomic_rmw32_or_u.value():
+        case Instructions::i32_atomic_rmw_xor.value():
+        case Instructions::i64_atomic_rmw_xor.value():
+        case Instructions::i32_atomic_rmw8_xor_u.value():
+        case Instructions::i32_atomic_rmw16_xor_u.value():
+        case Instructions::i64_atomic_rmw8_xor_u.value():
+        case Instructions::i64_atomic_rmw16_xor_u.value():
+        case Instructions::i64_atomic_rmw32_xor_u.value():
+        case Instructions::i32_atomic_rmw_xchg.value():
+        case Instructions::i64_atomic_rmw_xchg.value():
+        case Instructions::i32_atomic_rmw8_xchg_u.value():
+        case Instructions::i32_atomic_rmw16_xchg_u.value():
+        case Instructions::i64_atomic_rmw8_xchg_u.value():
+        case Instructions::i64_atomic_rmw16_xchg_u.value():
+        case Instructions::i64_atomic_rmw32_xchg_u.value():
+        case Instructions::i32_atomic_rmw_cmpxchg.value():
+        case Instructions::i64_atomic_rmw_cmpxchg.value():
+        case Instructions::i32_atomic_rmw8_cmpxchg_u.value():
+        case Instructions::i32_atomic_rmw16_cmpxchg_u.value():
+        case Instructions::i64_atomic_rmw8_cmpxchg_u.value():
+        case Instructions::i64_atomic_rmw16_cmpxchg_u.value():
+        case Instructions::i64_atomic_rmw32_cmpxchg_u.value(): {
+            // Proposal 'threads': op (align [multi-memory memindex] offset)
+            u32 align = TRY_READ(stream, LEB128<u32>, ParseError::InvalidInput);
+
+            // Proposal "multi-memory", if bit 6 of alignment is set, then a memory index follows the alignment.
+            auto memory_index = 0;
+            if ((align & 0x40) != 0) {
+                align &= ~0x40;
+                memory_index = TRY_READ(stream, LEB128<u32>, ParseError::InvalidInput);
+            }
+
+            // Proposal 'memory64': memarg offsets are u64 instead of u32.
+            auto offset = TRY_READ(stream, LEB128<u64>, ParseError::InvalidInput);
+
+            return Instruction { full_opcode, MemoryArgument { align, offset, MemoryIndex(memory_index) } };
+        }
+        case Instructions::atomic_fence.value(): {
+            // Proposal 'threads': op 0x00
+            auto reserved = TRY_READ(stream, u8, ParseError::InvalidInput);
+            if (reserved != 0)
+                return ParseError::InvalidImmediate;
+            return Instruction { full_opcode };
+        }
         default:
             return ParseError::UnknownInstruction;
         }
@@ -1752,6 +1845,68 @@ ParseResult<SectionId> SectionId::parse(Stream& stream)
     }
 }
 
+static ParseResult<void> note_section_kind(SectionId section_id, u32& seen_section_kinds)
+{
+    if (section_id.kind() == SectionId::SectionIdKind::Custom)
+        return {};
+    auto kind_bit = 1u << to_underlying(section_id.kind());
+    if (seen_section_kinds & kind_bit)
+        return ParseError::DuplicateSection;
+    seen_section_kinds |= kind_bit;
+    return {};
+}
+
+static ParseResult<void> parse_section_contents(Module& module, SectionId section_id, ConstrainedStream& section_stream)
+{
+    switch (section_id.kind()) {
+    case SectionId::SectionIdKind::Custom:
+        module.custom_sections().append(TRY(CustomSection::parse(section_stream)));
+        break;
+    case SectionId::SectionIdKind::Type:
+        module.type_section() = TRY(TypeSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Import:
+        module.import_section() = TRY(ImportSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Function:
+        module.function_section() = TRY(FunctionSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Table:
+        module.table_section() = TRY(TableSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Memory:
+        module.memory_section() = TRY(MemorySection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Global:
+        module.global_section() = TRY(GlobalSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Export:
+        module.export_section() = TRY(ExportSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Start:
+        module.start_section() = TRY(StartSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Element:
+        module.element_section() = TRY(ElementSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Code:
+        module.code_section() = TRY(CodeSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Data:
+        module.data_section() = TRY(DataSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::DataCount:
+        module.data_count_section() = TRY(DataCountSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Tag:
+        module.tag_section() = TRY(TagSection::parse(section_stream));
+        break;
+    default:
+        return ParseError::InvalidIndex;
+    }
+    return {};
+}
+
 ParseResult<NonnullRefPtr<Module>> Module::parse(Stream& stream)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("Module"sv);
@@ -1776,59 +1931,9 @@ ParseResult<NonnullRefPtr<Module>> Module::parse(Stream& stream)
         size_t section_size = TRY_READ(stream, LEB128<u32>, ParseError::ExpectedSize);
         auto section_stream = ConstrainedStream { MaybeOwned<Stream>(stream), section_size };
 
-        if (section_id.kind() != SectionId::SectionIdKind::Custom) {
-            auto kind_bit = 1u << to_underlying(section_id.kind());
-            if (seen_section_kinds & kind_bit)
-                return ParseError::DuplicateSection;
-            seen_section_kinds |= kind_bit;
-        }
+        TRY(note_section_kind(section_id, seen_section_kinds));
+        TRY(parse_section_contents(module, section_id, section_stream));
 
-        switch (section_id.kind()) {
-        case SectionId::SectionIdKind::Custom:
-            module.custom_sections().append(TRY(CustomSection::parse(section_stream)));
-            break;
-        case SectionId::SectionIdKind::Type:
-            module.type_section() = TRY(TypeSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Import:
-            module.import_section() = TRY(ImportSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Function:
-            module.function_section() = TRY(FunctionSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Table:
-            module.table_section() = TRY(TableSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Memory:
-            module.memory_section() = TRY(MemorySection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Global:
-            module.global_section() = TRY(GlobalSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Export:
-            module.export_section() = TRY(ExportSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Start:
-            module.start_section() = TRY(StartSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Element:
-            module.element_section() = TRY(ElementSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Code:
-            module.code_section() = TRY(CodeSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Data:
-            module.data_section() = TRY(DataSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::DataCount:
-            module.data_count_section() = TRY(DataCountSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Tag:
-            module.tag_section() = TRY(TagSection::parse(section_stream));
-            break;
-        default:
-            return ParseError::InvalidIndex;
-        }
         if (!section_id.can_appear_after(last_section_id))
             return ParseError::SectionOutOfOrder;
         // Custom sections don't participate in ordering.
@@ -1847,6 +1952,200 @@ void Module::preprocess()
 {
 }
 
+// Reads a LEB128<u32> off the front of `bytes`, returning an empty Optional if `bytes` ends before the value does.
+static ParseResult<Optional<u32>> read_streamed_u32(ReadonlyBytes bytes, size_t& consumed, ParseError error)
+{
+    static constexpr size_t max_u32_leb128_length = 5;
+    for (size_t i = 0; i < min(bytes.size(), max_u32_leb128_length); ++i) {
+        if (bytes[i] & 0x80)
+            continue;
+        FixedMemoryStream stream { bytes.slice(0, i + 1) };
+        auto value = stream.read_value<LEB128<u32>>();
+        if (value.is_error())
+            return error;
+        consumed = i + 1;
+        return Optional<u32> { value.release_value() };
+    }
+    if (bytes.size() < max_u32_leb128_length)
+        return Optional<u32> {};
+    return error;
+}
+
+StreamingModuleParser::StreamingModuleParser()
+    : m_module(make_ref_counted<Module>())
+{
+}
+
+ParseError StreamingModuleParser::fail(ParseError error)
+{
+    m_state = State::Failed;
+    m_error = error;
+    m_buffer.clear();
+    m_buffer_offset = 0;
+    return error;
+}
+
+ParseResult<void> StreamingModuleParser::append(ReadonlyBytes bytes)
+{
+    if (m_state == State::Failed)
+        return m_error;
+    VERIFY(m_state != State::Finished);
+
+    m_total_size += bytes.size();
+    if (m_buffer.try_append(bytes).is_error())
+        return fail(ParseError::OutOfMemory);
+
+    if (auto result = parse_available_bytes(); result.is_error())
+        return fail(result.error());
+
+    // Drop what has been consumed, but only once it's at least half the buffer so that a large section arriving in
+    // many small chunks isn't repeatedly shifted down.
+    if (m_buffer_offset == m_buffer.size()) {
+        m_buffer.clear();
+        m_buffer_offset = 0;
+    } else if (m_buffer_offset >= m_buffer.size() / 2) {
+        auto remaining = ByteBuffer::copy(available_bytes());
+        if (remaining.is_error())
+            return fail(ParseError::OutOfMemory);
+        m_buffer = remaining.release_value();
+        m_buffer_offset = 0;
+    }
+    return {};
+}
+
+ParseResult<void> StreamingModuleParser::parse_available_bytes()
+{
+    while (TRY(parse_next())) { }
+    return {};
+}
+
+// Parses the next complete unit (header, section, or code entry) out of the buffer, returning false if more bytes are needed.
+ParseResult<bool> StreamingModuleParser::parse_next()
+{
+    auto bytes = available_bytes();
+
+    switch (m_state) {
+    case State::Header: {
+        if (bytes.size() >= 4 && bytes.slice(0, 4) != Module::wasm_magic.span())
+            return ParseError::InvalidModuleMagic;
+        if (bytes.size() < 8)
+            return false;
+        if (bytes.slice(4, 4) != Module::wasm_version.span())
+            return ParseError::InvalidModuleVersion;
+        m_buffer_offset += 8;
+        m_state = State::SectionHeader;
+        return true;
+    }
+    case State::SectionHeader: {
+        if (bytes.is_empty())
+            return false;
+        FixedMemoryStream id_stream { bytes.slice(0, 1) };
+        auto section_id = TRY(SectionId::parse(id_stream));
+        size_t size_length = 0;
+        auto section_size = TRY(read_streamed_u32(bytes.slice(1), size_length, ParseError::ExpectedSize));
+        if (!section_size.has_value())
+            return false;
+        m_buffer_offset += 1 + size_length;
+
+        TRY(note_section_kind(section_id, m_seen_section_kinds));
+        // Ordering is checked up front here (rather than after parsing, as Module::parse() does) so a misplaced section fails before it has downloaded.
+        if (!section_id.can_appear_after(m_last_section_kind))
+            return ParseError::SectionOutOfOrder;
+        if (section_id.kind() != SectionId::SectionIdKind::Custom)
+            m_last_section_kind = section_id.kind();
+
+        m_section_id = section_id;
+        m_section_size = *section_size;
+        m_section_remaining = *section_size;
+        m_state = section_id.kind() == SectionId::SectionIdKind::Code ? State::CodeSectionCount : State::SectionContents;
+        return true;
+    }
+    case State::SectionContents: {
+        if (bytes.size() < m_section_size)
+            return false;
+        FixedMemoryStream stream { bytes.slice(0, m_section_size) };
+        auto section_stream = ConstrainedStream { MaybeOwned<Stream>(stream), m_section_size };
+        TRY(parse_section_contents(*m_module, *m_section_id, section_stream));
+        if (section_stream.remaining() != 0)
+            return ParseError::SectionSizeMismatch;
+        m_buffer_offset += m_section_size;
+        m_state = State::SectionHeader;
+        return true;
+    }
+    case State::CodeSectionCount: {
+        if (m_section_remaining == 0)
+            return ParseError::ExpectedSize;
+        size_t count_length = 0;
+        auto count = TRY(read_streamed_u32(bytes.slice(0, min(bytes.size(), m_section_remaining)), count_length, ParseError::ExpectedSize));
+        if (!count.has_value()) {
+            if (bytes.size() >= m_section_remaining)
+                return ParseError::UnexpectedEof;
+            return false;
+        }
+        m_buffer_offset += count_length;
+        m_section_remaining -= count_length;
+        m_remaining_functions = *count;
+        // Every entry takes at least one byte, so don't let a bogus count reserve more than the section could hold.
+        m_functions.ensure_capacity(min<size_t>(*count, m_section_remaining));
+        m_state = State::CodeSectionEntry;
+        return true;
+    }
+    case State::CodeSectionEntry: {
+        if (m_remaining_functions == 0) {
+            if (m_section_remaining != 0)
+                return ParseError::SectionSizeMismatch;
+            m_module->code_section() = CodeSection { move(m_functions) };
+            m_functions = {};
+            m_state = State::SectionHeader;
+            return true;
+        }
+        if (m_section_remaining == 0)
+            return ParseError::UnexpectedEof;
+
+        size_t size_length = 0;
+        auto entry_size = TRY(read_streamed_u32(bytes.slice(0, min(bytes.size(), m_section_remaining)), size_length, ParseError::InvalidSize));
+        if (!entry_size.has_value()) {
+            if (bytes.size() >= m_section_remaining)
+                return ParseError::UnexpectedEof;
+            return false;
+        }
+        auto entry_length = size_length + *entry_size;
+        if (entry_length > m_section_remaining)
+            return ParseError::UnexpectedEof;
+        if (bytes.size() < entry_length)
+            return false;
+
+        FixedMemoryStream stream { bytes.slice(0, entry_length) };
+        auto entry_stream = ConstrainedStream { MaybeOwned<Stream>(stream), entry_length };
+        m_functions.append(TRY(CodeSection::Code::parse(entry_stream)));
+        m_buffer_offset += entry_length;
+        m_section_remaining -= entry_length;
+        --m_remaining_functions;
+        return true;
+    }
+    case State::Failed:
+    case State::Finished:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ParseResult<NonnullRefPtr<Module>> StreamingModuleParser::finish()
+{
+    if (m_state == State::Failed)
+        return m_error;
+    VERIFY(m_state != State::Finished);
+
+    // Anything other than a clean section boundary means the input ended partway through the module.
+    if (m_state != State::SectionHeader || !available_bytes().is_empty())
+        return fail(ParseError::UnexpectedEof);
+
+    m_state = State::Finished;
+    m_buffer.clear();
+    m_module->preprocess();
+    return m_module;
+}
+
 ByteString parse_error_to_byte_string(ParseError error)
 {
     switch (error) {
@@ -550,7 +550,7 @@ void Printer::print(Wasm::Instruction const& instruction)
             [&](Vector<ValueType> const&) { print("(types...)"); },
             [&](auto const& value) { print("(const {})", value); });
 
-        if (first_is_one_of(instruction.opcode(), Instructions::local_get, Instructions::local_set, Instructions::local_tee, Instructions::synthetic_argument_get, Instructions::synthetic_local_seti32_const, Instructions::synthetic_i32_storelocal))
+        if (first_is_one_of(instruction.opcode(), Instructions::local_get, Instructions::local_set, Instructions::local_tee, Instructions::synthetic_argument_get, Instructions::synthetic_local_seti32_const, Instructions::synthetic_i32_storelocal, Instructions::synthetic_i32_loadlocal, Instructions::synthetic_i64_loadlocal))
             print(" (local index {})", instruction.local_index().value());
 
         print(")\n");
@@ -583,6 +583,8 @@ void Printer::print(Wasm::Limits const& limits)
         print(" max={}", limits.max().value());
     else
         print(" unbounded");
+    if (limits.is_shared())
+        print(" shared");
     print(")\n");
 }
 
@@ -1370,6 +1372,73 @@ HashMap<Wasm::OpCode, ByteString>& Wasm::Names::instruction_names = *new HashMap
     { Instructions::ref_i31, "ref.i31" },
     { Instructions::i31_get_s, "i31.get_s" },
     { Instructions::i31_get_u, "i31.get_u" },
+    { Instructions::memory_atomic_notify, "memory.atomic.notify" },
+    { Instructions::memory_atomic_wait32, "memory.atomic.wait32" },
+    { Instructions::memory_atomic_wait64, "memory.atomic.wait64" },
+    { Instructions::atomic_fence, "atomic.fence" },
+    { Instructions::i32_atomic_load, "i32.atomic.load" },
+    { Instructions::i64_atomic_load, "i64.atomic.load" },
+    { Instructions::i32_atomic_load8_u, "i32.atomic.load8_u" },
+    { Instructions::i32_atomic_load16_u, "i32.atomic.load16_u" },
+    { Instructions::i64_atomic_load8_u, "i64.atomic.load8_u" },
+    { Instructions::i64_atomic_load16_u, "i64.atomic.load16_u" },
+    { Instructions::i64_atomic_load32_u, "i64.atomic.load32_u" },
+    { Instructions::i32_atomic_store, "i32.atomic.store" },
+    { Instructions::i64_atomic_store, "i64.atomic.store" },
+    { Instructions::i32_atomic_store8, "i32.atomic.store8" },
+    { Instructions::i32_atomic_store16, "i32.atomic.store16" },
+    { Instructions::i64_atomic_store8, "i64.atomic.store8" },
+    { Instructions::i64_atomic_store16, "i64.atomic.store16" },
+    { Instructions::i64_atomic_store32, "i64.atomic.store32" },
+    { Instructions::i32_atomic_rmw_add, "i32.atomic.rmw.add" },
+    { Instructions::i64_atomic_rmw_add, "i64.atomic.rmw.add" },
+    { Instructions::i32_atomic_rmw8_add_u, "i32.atomic.rmw8.add_u" },
+    { Instructions::i32_atomic_rmw16_add_u, "i32.atomic.rmw16.add_u" },
+    { Instructions::i64_atomic_rmw8_add_u, "i64.atomic.rmw8.add_u" },
+    { Instructions::i64_atomic_rmw16_add_u, "i64.atomic.rmw16.add_u" },
+    { Instructions::i64_atomic_rmw32_add_u, "i64.atomic.rmw32.add_u" },
+    { Instructions::i32_atomic_rmw_sub, "i32.atomic.rmw.sub" },
+    { Instructions::i64_atomic_rmw_sub, "i64.atomic.rmw.sub" },
+    { Instructions::i32_atomic_rmw8_sub_u, "i32.atomic.rmw8.sub_u" },
+    { Instructions::i32_atomic_rmw16_sub_u, "i32.atomic.rmw16.sub_u" },
+    { Instructions::i64_atomic_rmw8_sub_u, "i64.atomic.rmw8.sub_u" },
+    { Instructions::i64_atomic_rmw16_sub_u, "i64.atomic.rmw16.sub_u" },
+    { Instructions::i64_atomic_rmw32_sub_u, "i64.atomic.rmw32.sub_u" },
+    { Instructions::i32_atomic_rmw_and, "i32.atomic.rmw.and" },
+    { Instructions::i64_atomic_rmw_and, "i64.atomic.rmw.and" },
+    { Instructions::i32_atomic_rmw8_and_u, "i32.atomic.rmw8.and_u" },
+    { Instructions::i32_atomic_rmw16_and_u, "i32.atomic.rmw16.and_u" },
+    { Instructions::i64_atomic_rmw8_and_u, "i64.atomic.rmw8.and_u" },
+    { Instructions::i64_atomic_rmw16_and_u, "i64.atomic.rmw16.and_u" },
+    { Instructions::i64_atomic_rmw32_and_u, "i64.atomic.rmw32.and_u" },
+    { Instructions::i32_atomic_rmw_or, "i32.atomic.rmw.or" },
+    { Instructions::i64_atomic_rmw_or, "i64.atomic.rmw.or" },
+    { Instructions::i32_atomic_rmw8_or_u, "i32.atomic.rmw8.or_u" },
+    { Instructions::i32_atomic_rmw16_or_u, "i32.atomic.rmw16.or_u" },
+    { Instructions::i64_atomic_rmw8_or_u, "i64.atomic.rmw8.or_u" },
+    { Instructions::i64_atomic_rmw16_or_u, "i64.atomic.rmw16.or_u" },
+    { Instructions::i64_atomic_rmw32_or_u, "i64.atomic.rmw32.or_u" },
+    { Instructions::i32_atomic_rmw_xor, "i32.atomic.rmw.xor" },
+    { Instructions::i64_atomic_rmw_xor, "i64.atomic.rmw.xor" },
+    { Instructions::i32_atomic_rmw8_xor_u, "i32.atomic.rmw8.xor_u" },
+    { Instructions::i32_atomic_rmw16_xor_u, "i32.atomic.rmw16.xor_u" },
+    { Instructions::i64_atomic_rmw8_xor_u, "i64.atomic.rmw8.xor_u" },
+    { Instructions::i64_atomic_rmw16_xor_u, "i64.atomic.rmw16.xor_u" },
+    { Instructions::i64_atomic_rmw32_xor_u, "i64.atomic.rmw32.xor_u" },
+    { Instructions::i32_atomic_rmw_xchg, "i32.atomic.rmw.xchg" },
+    { Instructions::i64_atomic_rmw_xchg, "i64.atomic.rmw.xchg" },
+    { Instructions::i32_atomic_rmw8_xchg_u, "i32.atomic.rmw8.xchg_u" },
+    { Instructions::i32_atomic_rmw16_xchg_u, "i32.atomic.rmw16.xchg_u" },
+    { Instructions::i64_atomic_rmw8_xchg_u, "i64.atomic.rmw8.xchg_u" },
+    { Instructions::i64_atomic_rmw16_xchg_u, "i64.atomic.rmw16.xchg_u" },
+    { Instructions::i64_atomic_rmw32_xchg_u, "i64.atomic.rmw32.xchg_u" },
+    { Instructions::i32_atomic_rmw_cmpxchg, "i32.atomic.rmw.cmpxchg" },
+    { Instructions::i64_atomic_rmw_cmpxchg, "i64.atomic.rmw.cmpxchg" },
+    { Instructions::i32_atomic_rmw8_cmpxchg_u, "i32.atomic.rmw8.cmpxchg_u" },
+    { Instructions::i32_atomic_rmw16_cmpxchg_u, "i32.atomic.rmw16.cmpxchg_u" },
+    { Instructions::i64_atomic_rmw8_cmpxchg_u, "i64.atomic.rmw8.cmpxchg_u" },
+    { Instructions::i64_atomic_rmw16_cmpxchg_u, "i64.atomic.rmw16.cmpxchg_u" },
+    { Instructions::i64_atomic_rmw32_cmpxchg_u, "i64.atomic.rmw32.cmpxchg_u" },
     { Instructions::structured_else, "synthetic:else" },
     { Instructions::structured_end, "synthetic:end" },
     { Instructions::synthetic_i32_add2local, "synthetic:i32.add2local" },
@@ -1377,6 +1446,8 @@ HashMap<Wasm::OpCode, ByteString>& Wasm::Names::instruction_names = *new HashMap
     { Instructions::synthetic_i32_andconstlocal, "synthetic:i32.and_const_local" },
     { Instructions::synthetic_i32_storelocal, "synthetic:i32.store_local" },
     { Instructions::synthetic_i64_storelocal, "synthetic:i64.store_local" },
+    { Instructions::synthetic_i32_loadlocal, "synthetic:i32.load_local" },
+    { Instructions::synthetic_i64_loadlocal, "synthetic:i64.load_local" },
     { Instructions::synthetic_local_seti32_const, "synthetic:local.set_i32_const" },
     { Instructions::synthetic_call_00, "synthetic:call.00" },
     { Instructions::synthetic_call_01, "synthetic:call.01" },
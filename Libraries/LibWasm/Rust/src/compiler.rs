@@ -15,7 +15,10 @@ use cranelift_codegen::Context;
 use cranelift_codegen::FinalizedRelocTarget;
 use cranelift_codegen::binemit::Reloc;
 use cranelift_codegen::ir::AbiParam;
+use cranelift_codegen::ir::AtomicRmwOp;
 use cranelift_codegen::ir::Block;
+use cranelift_codegen::ir::ConstantData;
+use cranelift_codegen::ir::Endianness;
 use cranelift_codegen::ir::ExtFuncData;
 use cranelift_codegen::ir::ExternalName;
 use cranelift_codegen::ir::Function;
@@ -24,8 +27,10 @@ use cranelift_codegen::ir::MemFlags;
 use cranelift_codegen::ir::Signature;
 use cranelift_codegen::ir::StackSlotData;
 use cranelift_codegen::ir::StackSlotKind;
+use cranelift_codegen::ir::Type;
 use cranelift_codegen::ir::UserExternalName;
 use cranelift_codegen::ir::UserFuncName;
+use cranelift_codegen::ir::Value;
 use cranelift_codegen::ir::condcodes::FloatCC;
 use cranelift_codegen::ir::condcodes::IntCC;
 use cranelift_codegen::ir::immediates::Ieee32;
@@ -48,14 +53,19 @@ mod op {
 const REG_COUNT: usize = 8;
 const STACK_MARKER: u8 = 8;
 const CALLREC_BASE: u8 = 9;
+/// Non-default memories whose base address is loaded up front in the prologue.
+const MAX_HOISTED_MEMORY_BASES: usize = 4;
 
 /// The `Int` bank is always defined.
 /// The `F64` bank is trusted only until the next control-flow merge, where it may be undefined on an incoming edge.
+/// The same goes for `F32` and `V128`; functions that use vectors also keep the high half of every slot in the `Int`
+/// bank, so a vector can always be rebuilt from it.
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 enum Bank {
     Int,
     F32,
     F64,
+    V128,
 }
 
 /// Control flow frame tracking for structured control flow.
@@ -112,6 +122,9 @@ impl CraneliftCompiler {
             // single-return calls. We handle it via flush_vstack_to_real before the call.
         }
 
+        const V128_KIND: u8 = 4;
+        let uses_v128 = local_types.contains(&V128_KIND) || insns.iter().any(|insn| Self::is_simd(insn.opcode));
+
         let mut flag_builder = settings::builder();
         flag_builder.set("opt_level", "speed").unwrap();
         flag_builder.set("is_pic", "false").unwrap();
@@ -202,6 +215,7 @@ impl CraneliftCompiler {
             mem_load_sig:      i32 fn(ptr, ptr, i32, i64, ptr);
             mem_store_sig:     i32 fn(ptr, ptr, i32, i64, i64);
             cage_base_sig:     i64 fn();
+            mem_base_sig:      ptr fn(ptr, i32);
             mem_size_sig:      i64 fn(ptr, i32);
             mem_grow_sig:      i32 fn(ptr, i32, i32);
             read_global_sig:   i64 fn(ptr, i32);
@@ -259,6 +273,7 @@ impl CraneliftCompiler {
         let h_memory_copy = decl_helper!(memory_copy_sig, HelperId::memory_copy);
         let h_memory_fill = decl_helper!(memory_fill_sig, HelperId::memory_fill);
         let h_primitive_storage_cage_base = decl_helper!(cage_base_sig, HelperId::primitive_storage_cage_base);
+        let h_mem_base = decl_helper!(mem_base_sig, HelperId::memory_base);
         let locals_base_offset = helpers.locals_base_offset as i32;
         let default_memory_offset = helpers.default_memory_offset as i32;
         let memory_instance_data_offset = helpers.memory_instance_data_offset as i32;
@@ -314,6 +329,11 @@ impl CraneliftCompiler {
                     | op::I64_STORE32
                     | op::SYNTHETIC_I32_STORELOCAL
                     | op::SYNTHETIC_I64_STORELOCAL
+                    | op::SYNTHETIC_I32_LOADLOCAL
+                    | op::SYNTHETIC_I64_LOADLOCAL
+                    | op::V128_LOAD..=op::V128_STORE
+                    | op::V128_LOAD8_LANE..=op::V128_LOAD64_ZERO
+                    | op::I32_ATOMIC_LOAD..=op::I64_ATOMIC_RMW32_CMPXCHG_U
             ) && mem_idx == 0
         });
         // The base address is stable for the whole call: memory32 storage reserves its maximum
@@ -343,6 +363,60 @@ impl CraneliftCompiler {
             builder.def_var(default_memory_base_var, zero);
         }
 
+        // Other memories are guarded the same way, so scalar accesses to them skip the bounds-checking
+        // helpers too; their bases are fetched once here. Past a handful of distinct memories the extra
+        // prologue calls stop paying for themselves, and the remaining ones keep using the helpers.
+        let mut guarded_memory_indices: Vec<u32> = insns
+            .iter()
+            .filter(|insn| {
+                matches!(
+                    insn.opcode,
+                    op::I32_LOAD
+                        | op::I64_LOAD
+                        | op::F32_LOAD
+                        | op::F64_LOAD
+                        | op::I32_LOAD8_S
+                        | op::I32_LOAD8_U
+                        | op::I32_LOAD16_S
+                        | op::I32_LOAD16_U
+                        | op::I64_LOAD8_S
+                        | op::I64_LOAD8_U
+                        | op::I64_LOAD16_S
+                        | op::I64_LOAD16_U
+                        | op::I64_LOAD32_S
+                        | op::I64_LOAD32_U
+                        | op::I32_STORE
+                        | op::I64_STORE
+                        | op::F32_STORE
+                        | op::F64_STORE
+                        | op::I32_STORE8
+                        | op::I32_STORE16
+                        | op::I64_STORE8
+                        | op::I64_STORE16
+                        | op::I64_STORE32
+                        | op::SYNTHETIC_I32_STORELOCAL
+                        | op::SYNTHETIC_I64_STORELOCAL
+                        | op::SYNTHETIC_I32_LOADLOCAL
+                        | op::SYNTHETIC_I64_LOADLOCAL
+                )
+            })
+            .map(|insn| insn.imm3 & 0x7fff_ffff)
+            .filter(|&mem_idx| mem_idx != 0)
+            .collect();
+        guarded_memory_indices.sort_unstable();
+        guarded_memory_indices.dedup();
+        guarded_memory_indices.truncate(MAX_HOISTED_MEMORY_BASES);
+        let guarded_memory_bases: Vec<(u32, Value)> = guarded_memory_indices
+            .into_iter()
+            .map(|mem_idx| {
+                let config = builder.use_var(config_var);
+                let index = builder.ins().iconst(types::I32, i64::from(mem_idx));
+                let callee = builder.ins().func_addr(ptr_type, h_mem_base);
+                let call = builder.ins().call_indirect(mem_base_sig, callee, &[config, index]);
+                (mem_idx, builder.inst_results(call)[0])
+            })
+            .collect();
+
         let mut control_stack: Vec<ControlFrame> = Vec::new();
 
         // Virtual stack, to avoid touching the interpreter-side stack as much as possible.
@@ -401,6 +475,40 @@ impl CraneliftCompiler {
                 v
             })
             .collect();
+        // The high half of a slot is always zero unless the function uses vectors, so only track it in that case.
+        let hi_var_count = if uses_v128 { REG_COUNT + max_stack_depth } else { 0 };
+        let hi_vars: Vec<Variable> = (0..hi_var_count)
+            .map(|_| {
+                let v = Variable::from_u32(next_var_id);
+                next_var_id += 1;
+                builder.declare_var(v, types::I64);
+                v
+            })
+            .collect();
+        let (reg_vars_hi, stack_vars_hi) = hi_vars.split_at(if uses_v128 { REG_COUNT } else { 0 });
+        let v128_vars: Vec<Variable> = (0..hi_var_count)
+            .map(|_| {
+                let v = Variable::from_u32(next_var_id);
+                next_var_id += 1;
+                builder.declare_var(v, types::I64X2);
+                v
+            })
+            .collect();
+        let (reg_vars_v128, stack_vars_v128) = v128_vars.split_at(if uses_v128 { REG_COUNT } else { 0 });
+        for (i, var) in reg_vars_hi.iter().enumerate() {
+            let offset = regs_offset + (i as i32) * value_size + 8;
+            let val = builder
+                .ins()
+                .load(types::I64, MemFlags::trusted(), configuration_val, offset);
+            builder.def_var(*var, val);
+        }
+        for var in stack_vars_hi {
+            let zero = builder.ins().iconst(types::I64, 0);
+            builder.def_var(*var, zero);
+        }
+        // Vector bitcasts that change the lane count need an explicit byte order.
+        let vector_bitcast_flags = MemFlags::new().with_endianness(Endianness::Little);
+
         let mut reg_ty = [Bank::Int; REG_COUNT];
         let mut stack_ty = vec![Bank::Int; max_stack_depth];
 
@@ -414,6 +522,9 @@ impl CraneliftCompiler {
         let local_is_f32: Vec<bool> = (0..num_locals)
             .map(|i| local_types.get(i).copied() == Some(F32_KIND))
             .collect();
+        let local_is_v128: Vec<bool> = (0..num_locals)
+            .map(|i| local_types.get(i).copied() == Some(V128_KIND))
+            .collect();
 
         // Promoting wasm locals to SSA variables keeps them in registers, which is a win only
         // as long as they actually fit. Functions with more locals than the machine has usable
@@ -445,6 +556,8 @@ impl CraneliftCompiler {
                 types::F64
             } else if local_is_f32[i] {
                 types::F32
+            } else if local_is_v128[i] {
+                types::I64X2
             } else {
                 types::I64
             };
@@ -455,20 +568,26 @@ impl CraneliftCompiler {
         macro_rules! emit_stack_push {
             ($builder:expr, $val:expr) => {{
                 let v = $val;
+                let zero_tag = $builder.ins().iconst(types::I64, 0);
+                emit_stack_push!($builder, v, zero_tag)
+            }};
+            ($builder:expr, $val:expr, $hi:expr) => {{
+                let v = $val;
+                let hi = $hi;
                 let cfg = $builder.use_var(config_var);
                 let top = $builder
                     .ins()
                     .load(ptr_type, MemFlags::trusted(), cfg, value_stack_top_offset);
                 $builder.ins().store(MemFlags::trusted(), v, top, 0);
-                let zero_tag = $builder.ins().iconst(types::I64, 0);
-                $builder.ins().store(MemFlags::trusted(), zero_tag, top, 8);
+                $builder.ins().store(MemFlags::trusted(), hi, top, 8);
                 let new_top = $builder.ins().iadd_imm(top, i64::from(value_size));
                 $builder
                     .ins()
                     .store(MemFlags::trusted(), new_top, cfg, value_stack_top_offset);
             }};
         }
-        macro_rules! emit_stack_pop {
+        // Pops the top of the real value stack, and returns the address of the popped value.
+        macro_rules! emit_stack_pop_address {
             ($builder:expr) => {{
                 let cfg = $builder.use_var(config_var);
                 let top = $builder
@@ -478,7 +597,13 @@ impl CraneliftCompiler {
                 $builder
                     .ins()
                     .store(MemFlags::trusted(), new_top, cfg, value_stack_top_offset);
-                $builder.ins().load(types::I64, MemFlags::trusted(), new_top, 0)
+                new_top
+            }};
+        }
+        macro_rules! emit_stack_pop {
+            ($builder:expr) => {{
+                let address = emit_stack_pop_address!($builder);
+                $builder.ins().load(types::I64, MemFlags::trusted(), address, 0)
             }};
         }
         macro_rules! emit_stack_size {
@@ -540,9 +665,12 @@ impl CraneliftCompiler {
                         let val = $builder.use_var(stack_vars[i]);
                         let offset = (i as i32) * value_size;
                         $builder.ins().store(MemFlags::trusted(), val, top, offset);
-                        $builder
-                            .ins()
-                            .store(MemFlags::trusted(), zero_tag, top, offset + 8);
+                        let hi = if uses_v128 {
+                            $builder.use_var(stack_vars_hi[i])
+                        } else {
+                            zero_tag
+                        };
+                        $builder.ins().store(MemFlags::trusted(), hi, top, offset + 8);
                     }
                     let new_top = $builder.ins().iadd_imm(top, i64::from(sp as i32 * value_size));
                     $builder
@@ -566,9 +694,12 @@ impl CraneliftCompiler {
                         let val = $builder.use_var(stack_vars[sp - n + i]);
                         let offset = (i as i32) * value_size;
                         $builder.ins().store(MemFlags::trusted(), val, top, offset);
-                        $builder
-                            .ins()
-                            .store(MemFlags::trusted(), zero_tag, top, offset + 8);
+                        let hi = if uses_v128 {
+                            $builder.use_var(stack_vars_hi[sp - n + i])
+                        } else {
+                            zero_tag
+                        };
+                        $builder.ins().store(MemFlags::trusted(), hi, top, offset + 8);
                     }
                     let new_top = $builder.ins().iadd_imm(top, i64::from(n as i32 * value_size));
                     $builder
@@ -578,17 +709,28 @@ impl CraneliftCompiler {
             }};
         }
 
+        macro_rules! clear_hi {
+            ($builder:expr, $hi_vars:expr, $index:expr) => {{
+                if uses_v128 {
+                    let zero = $builder.ins().iconst(types::I64, 0);
+                    $builder.def_var($hi_vars[$index], zero);
+                }
+            }};
+        }
+
         macro_rules! write_dst {
             ($builder:expr, $dst:expr, $val:expr) => {{
                 let dst = $dst;
                 let val = $val;
                 if dst < STACK_MARKER {
                     $builder.def_var(reg_vars[dst as usize], val);
+                    clear_hi!($builder, reg_vars_hi, dst as usize);
                     reg_ty[dst as usize] = Bank::Int;
                     dirty_regs[dst as usize] = true;
                 } else if dst == STACK_MARKER {
                     if max_stack_depth > 0 {
                         $builder.def_var(stack_vars[sp], val);
+                        clear_hi!($builder, stack_vars_hi, sp);
                         stack_ty[sp] = Bank::Int;
                         sp += 1;
                     } else {
@@ -647,12 +789,14 @@ impl CraneliftCompiler {
                 if dst < STACK_MARKER {
                     $builder.def_var(reg_vars_f64[dst as usize], val);
                     $builder.def_var(reg_vars[dst as usize], bits);
+                    clear_hi!($builder, reg_vars_hi, dst as usize);
                     reg_ty[dst as usize] = Bank::F64;
                     dirty_regs[dst as usize] = true;
                 } else if dst == STACK_MARKER {
                     if max_stack_depth > 0 {
                         $builder.def_var(stack_vars_f64[sp], val);
                         $builder.def_var(stack_vars[sp], bits);
+                        clear_hi!($builder, stack_vars_hi, sp);
                         stack_ty[sp] = Bank::F64;
                         sp += 1;
                     } else {
@@ -718,12 +862,14 @@ impl CraneliftCompiler {
                 if dst < STACK_MARKER {
                     $builder.def_var(reg_vars_f32[dst as usize], val);
                     $builder.def_var(reg_vars[dst as usize], bits);
+                    clear_hi!($builder, reg_vars_hi, dst as usize);
                     reg_ty[dst as usize] = Bank::F32;
                     dirty_regs[dst as usize] = true;
                 } else if dst == STACK_MARKER {
                     if max_stack_depth > 0 {
                         $builder.def_var(stack_vars_f32[sp], val);
                         $builder.def_var(stack_vars[sp], bits);
+                        clear_hi!($builder, stack_vars_hi, sp);
                         stack_ty[sp] = Bank::F32;
                         sp += 1;
                     } else {
@@ -740,6 +886,117 @@ impl CraneliftCompiler {
             }};
         }
 
+        macro_rules! v128_const {
+            ($builder:expr, $bytes:expr) => {{
+                let bytes: [u8; 16] = $bytes;
+                let constant = $builder.func.dfg.constants.insert(ConstantData::from(&bytes[..]));
+                $builder.ins().vconst(types::I64X2, constant)
+            }};
+        }
+        macro_rules! v128_cast {
+            ($builder:expr, $ty:expr, $val:expr) => {{
+                let v = $val;
+                if $builder.func.dfg.value_type(v) == $ty {
+                    v
+                } else {
+                    $builder.ins().bitcast($ty, vector_bitcast_flags, v)
+                }
+            }};
+        }
+        macro_rules! v128_from_halves {
+            ($builder:expr, $lo:expr, $hi:expr) => {{
+                let (lo, hi) = ($lo, $hi);
+                let vector = $builder.ins().scalar_to_vector(types::I64X2, lo);
+                $builder.ins().insertlane(vector, hi, 1)
+            }};
+        }
+
+        // Vectors are kept as i64x2; use v128_cast to view them with a different lane type.
+        macro_rules! read_src_v128 {
+            ($builder:expr, $src:expr) => {{
+                let src = $src;
+                if src < STACK_MARKER {
+                    if reg_ty[src as usize] == Bank::V128 {
+                        $builder.use_var(reg_vars_v128[src as usize])
+                    } else {
+                        let lo = $builder.use_var(reg_vars[src as usize]);
+                        let hi = $builder.use_var(reg_vars_hi[src as usize]);
+                        v128_from_halves!($builder, lo, hi)
+                    }
+                } else if src == STACK_MARKER {
+                    if max_stack_depth > 0 && sp > 0 {
+                        sp -= 1;
+                        if stack_ty[sp] == Bank::V128 {
+                            $builder.use_var(stack_vars_v128[sp])
+                        } else {
+                            let lo = $builder.use_var(stack_vars[sp]);
+                            let hi = $builder.use_var(stack_vars_hi[sp]);
+                            v128_from_halves!($builder, lo, hi)
+                        }
+                    } else {
+                        let address = emit_stack_pop_address!($builder);
+                        $builder.ins().load(types::I64X2, MemFlags::trusted(), address, 0)
+                    }
+                } else {
+                    // Call records only ever hold scalars, see the validator.
+                    let lo = read_src!($builder, src);
+                    let hi = $builder.ins().iconst(types::I64, 0);
+                    v128_from_halves!($builder, lo, hi)
+                }
+            }};
+        }
+
+        macro_rules! write_dst_v128 {
+            ($builder:expr, $dst:expr, $val:expr) => {{
+                let dst = $dst;
+                let val = v128_cast!($builder, types::I64X2, $val);
+                let lo = $builder.ins().extractlane(val, 0);
+                let hi = $builder.ins().extractlane(val, 1);
+                if dst < STACK_MARKER {
+                    $builder.def_var(reg_vars_v128[dst as usize], val);
+                    $builder.def_var(reg_vars[dst as usize], lo);
+                    $builder.def_var(reg_vars_hi[dst as usize], hi);
+                    reg_ty[dst as usize] = Bank::V128;
+                    dirty_regs[dst as usize] = true;
+                } else if dst == STACK_MARKER {
+                    if max_stack_depth > 0 {
+                        $builder.def_var(stack_vars_v128[sp], val);
+                        $builder.def_var(stack_vars[sp], lo);
+                        $builder.def_var(stack_vars_hi[sp], hi);
+                        stack_ty[sp] = Bank::V128;
+                        sp += 1;
+                    } else {
+                        emit_stack_push!($builder, lo, hi);
+                    }
+                } else {
+                    write_dst!($builder, dst, lo);
+                }
+            }};
+        }
+
+        // Moves the result on top of the virtual stack to `entry`, for branches with a result.
+        macro_rules! move_vstack_result {
+            ($builder:expr, $entry:expr) => {{
+                let entry = $entry;
+                if sp > 0 {
+                    let result = $builder.use_var(stack_vars[sp - 1]);
+                    $builder.def_var(stack_vars[entry], result);
+                    if uses_v128 {
+                        let result_hi = $builder.use_var(stack_vars_hi[sp - 1]);
+                        $builder.def_var(stack_vars_hi[entry], result_hi);
+                    }
+                } else {
+                    let address = emit_stack_pop_address!($builder);
+                    let result = $builder.ins().load(types::I64, MemFlags::trusted(), address, 0);
+                    $builder.def_var(stack_vars[entry], result);
+                    if uses_v128 {
+                        let result_hi = $builder.ins().load(types::I64, MemFlags::trusted(), address, 8);
+                        $builder.def_var(stack_vars_hi[entry], result_hi);
+                    }
+                }
+            }};
+        }
+
         macro_rules! reset_banks {
             () => {{
                 for t in reg_ty.iter_mut() {
@@ -856,6 +1113,78 @@ impl CraneliftCompiler {
             }};
         }
 
+        macro_rules! v128_unop {
+            ($builder:expr, $insn:expr, $ty:expr, $op:ident) => {{
+                let src = read_src_v128!($builder, $insn.sources[0]);
+                let src = v128_cast!($builder, $ty, src);
+                let result = $builder.ins().$op(src);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        macro_rules! v128_binop {
+            ($builder:expr, $insn:expr, $ty:expr, $op:ident) => {{
+                let rhs = read_src_v128!($builder, $insn.sources[0]);
+                let lhs = read_src_v128!($builder, $insn.sources[1]);
+                let rhs = v128_cast!($builder, $ty, rhs);
+                let lhs = v128_cast!($builder, $ty, lhs);
+                let result = $builder.ins().$op(lhs, rhs);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        macro_rules! v128_icmp {
+            ($builder:expr, $insn:expr, $ty:expr, $cc:expr) => {{
+                let rhs = read_src_v128!($builder, $insn.sources[0]);
+                let lhs = read_src_v128!($builder, $insn.sources[1]);
+                let rhs = v128_cast!($builder, $ty, rhs);
+                let lhs = v128_cast!($builder, $ty, lhs);
+                let result = $builder.ins().icmp($cc, lhs, rhs);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        macro_rules! v128_fcmp {
+            ($builder:expr, $insn:expr, $ty:expr, $cc:expr) => {{
+                let rhs = read_src_v128!($builder, $insn.sources[0]);
+                let lhs = read_src_v128!($builder, $insn.sources[1]);
+                let rhs = v128_cast!($builder, $ty, rhs);
+                let lhs = v128_cast!($builder, $ty, lhs);
+                let result = $builder.ins().fcmp($cc, lhs, rhs);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        // The shift amount is taken modulo the lane width.
+        macro_rules! v128_shift {
+            ($builder:expr, $insn:expr, $ty:expr, $op:ident) => {{
+                let amount_raw = read_src!($builder, $insn.sources[0]);
+                let src = read_src_v128!($builder, $insn.sources[1]);
+                let src = v128_cast!($builder, $ty, src);
+                let amount = $builder.ins().ireduce(types::I32, amount_raw);
+                let amount = $builder.ins().band_imm(amount, i64::from($ty.lane_bits() - 1));
+                let result = $builder.ins().$op(src, amount);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        // Widens both halves of the source and operates on them pairwise (extadd_pairwise, dot).
+        macro_rules! v128_widen_pairwise {
+            ($builder:expr, $ty:expr, $low:ident, $high:ident, $lhs:expr) => {{
+                let lhs = v128_cast!($builder, $ty, $lhs);
+                let low = $builder.ins().$low(lhs);
+                let high = $builder.ins().$high(lhs);
+                $builder.ins().iadd_pairwise(low, high)
+            }};
+        }
+        macro_rules! v128_extmul {
+            ($builder:expr, $insn:expr, $ty:expr, $widen:ident) => {{
+                let rhs = read_src_v128!($builder, $insn.sources[0]);
+                let lhs = read_src_v128!($builder, $insn.sources[1]);
+                let rhs = v128_cast!($builder, $ty, rhs);
+                let lhs = v128_cast!($builder, $ty, lhs);
+                let rhs = $builder.ins().$widen(rhs);
+                let lhs = $builder.ins().$widen(lhs);
+                let result = $builder.ins().imul(lhs, rhs);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+
         macro_rules! read_local_inline {
             ($builder:expr, $idx_imm:expr) => {{
                 let idx = ($idx_imm) as usize;
@@ -968,10 +1297,42 @@ impl CraneliftCompiler {
                 }
             }};
         }
+        // Vector locals are always accessed through these, whether or not they are promoted.
+        macro_rules! read_local_v128 {
+            ($builder:expr, $idx_imm:expr) => {{
+                let idx = ($idx_imm) as usize;
+                if idx < local_vars.len() {
+                    $builder.use_var(local_vars[idx])
+                } else {
+                    let lb = $builder.use_var(locals_base_var);
+                    $builder
+                        .ins()
+                        .load(types::I64X2, MemFlags::trusted(), lb, (idx as i32) * value_size)
+                }
+            }};
+        }
+        macro_rules! write_local_v128 {
+            ($builder:expr, $idx_imm:expr, $val:expr) => {{
+                let idx = ($idx_imm) as usize;
+                let v = $val;
+                if idx < local_vars.len() {
+                    $builder.def_var(local_vars[idx], v);
+                    dirty_locals[idx] = true;
+                } else {
+                    let lb = $builder.use_var(locals_base_var);
+                    $builder
+                        .ins()
+                        .store(MemFlags::trusted(), v, lb, (idx as i32) * value_size);
+                }
+            }};
+        }
         macro_rules! local_get {
             ($builder:expr, $idx_imm:expr, $dst:expr) => {{
                 let idx = ($idx_imm) as usize;
-                if idx < local_vars.len() && local_is_f64[idx] {
+                if local_is_v128.get(idx) == Some(&true) {
+                    let result = read_local_v128!($builder, $idx_imm);
+                    write_dst_v128!($builder, $dst, result);
+                } else if idx < local_vars.len() && local_is_f64[idx] {
                     let result = read_local_f64!($builder, $idx_imm);
                     write_dst_f64!($builder, $dst, result);
                 } else if idx < local_vars.len() && local_is_f32[idx] {
@@ -986,7 +1347,10 @@ impl CraneliftCompiler {
         macro_rules! local_set {
             ($builder:expr, $idx_imm:expr, $src:expr) => {{
                 let idx = ($idx_imm) as usize;
-                if idx < local_vars.len() && local_is_f64[idx] {
+                if local_is_v128.get(idx) == Some(&true) {
+                    let val = read_src_v128!($builder, $src);
+                    write_local_v128!($builder, $idx_imm, val);
+                } else if idx < local_vars.len() && local_is_f64[idx] {
                     let val = read_src_f64!($builder, $src);
                     write_local_f64!($builder, $idx_imm, val);
                 } else if idx < local_vars.len() && local_is_f32[idx] {
@@ -1007,13 +1371,17 @@ impl CraneliftCompiler {
                             continue;
                         }
                         let v = $builder.use_var(local_vars[i]);
+                        let offset = (i as i32) * value_size;
+                        if local_is_v128[i] {
+                            $builder.ins().store(MemFlags::trusted(), v, lb, offset);
+                            continue;
+                        }
                         let stored = if local_is_f32[i] {
                             let bits32 = $builder.ins().bitcast(types::I32, MemFlags::new(), v);
                             $builder.ins().sextend(types::I64, bits32)
                         } else {
                             v
                         };
-                        let offset = (i as i32) * value_size;
                         $builder.ins().store(MemFlags::trusted(), stored, lb, offset);
                         let zero = $builder.ins().iconst(types::I64, 0);
                         $builder.ins().store(MemFlags::trusted(), zero, lb, offset + 8);
@@ -1064,15 +1432,48 @@ impl CraneliftCompiler {
         }
         // No bounds checks: the memory reserves the full base (u32) + offset (u32) span, so any
         // out-of-bounds access faults on an uncommitted page and unwinds as a wasm trap.
-        macro_rules! inline_default_memory_address {
-            ($builder:expr, $addr:expr) => {{
-                let memory_base = $builder.use_var(default_memory_base_var);
+        macro_rules! guarded_memory_address {
+            ($builder:expr, $memory_base:expr, $addr:expr) => {{
                 let addr_offset = if ptr_type == types::I64 {
                     $addr
                 } else {
                     $builder.ins().ireduce(ptr_type, $addr)
                 };
-                $builder.ins().iadd(memory_base, addr_offset)
+                $builder.ins().iadd($memory_base, addr_offset)
+            }};
+        }
+        macro_rules! inline_default_memory_address {
+            ($builder:expr, $addr:expr) => {{
+                let memory_base = $builder.use_var(default_memory_base_var);
+                guarded_memory_address!($builder, memory_base, $addr)
+            }};
+        }
+        // The inline base of `mem_idx`, if it has one; otherwise accesses go through the checking helpers.
+        macro_rules! guarded_memory_base {
+            ($builder:expr, $mem_idx:expr) => {{
+                if $mem_idx == 0 {
+                    Some($builder.use_var(default_memory_base_var))
+                } else {
+                    guarded_memory_bases
+                        .iter()
+                        .find(|(index, _)| *index == $mem_idx)
+                        .map(|&(_, memory_base)| memory_base)
+                }
+            }};
+        }
+
+        // SIMD memory accesses are only lowered for the default memory; functions that use vectors
+        // with any other memory stay in the interpreter.
+        macro_rules! v128_memory_address {
+            ($builder:expr, $insn:expr, $base_raw:expr) => {{
+                if $insn.imm3 & 0x7fff_ffff != 0 {
+                    return Err("SIMD access to a non-default memory");
+                }
+                let base_u32 = $builder.ins().ireduce(types::I32, $base_raw);
+                let base_u64 = $builder.ins().uextend(types::I64, base_u32);
+                let offset = $builder.ins().iconst(types::I64, $insn.imm1);
+                let addr = $builder.ins().iadd(base_u64, offset);
+                inline_default_memory_address!($builder, addr)
             }};
         }
 
@@ -1097,6 +1498,8 @@ impl CraneliftCompiler {
                                 types::F64
                             } else if local_is_f32[i] {
                                 types::F32
+                            } else if local_is_v128[i] {
+                                types::I64X2
                             } else {
                                 types::I64
                             };
@@ -1109,6 +1512,9 @@ impl CraneliftCompiler {
                         } else if local_is_f32[i] {
                             let zero = $builder.ins().f32const(0.0);
                             $builder.def_var(*var, zero);
+                        } else if local_is_v128[i] {
+                            let zero = v128_const!($builder, [0; 16]);
+                            $builder.def_var(*var, zero);
                         } else {
                             let zero = $builder.ins().iconst(types::I64, 0);
                             $builder.def_var(*var, zero);
@@ -1126,6 +1532,8 @@ impl CraneliftCompiler {
                             types::F64
                         } else if local_is_f32[i] {
                             types::F32
+                        } else if local_is_v128[i] {
+                            types::I64X2
                         } else {
                             types::I64
                         };
@@ -1180,6 +1588,7 @@ impl CraneliftCompiler {
                     Self::sync_regs_to_config(
                         &mut builder,
                         &reg_vars,
+                        reg_vars_hi,
                         config_var,
                         regs_offset,
                         value_size,
@@ -1363,12 +1772,7 @@ impl CraneliftCompiler {
                         if max_stack_depth > 0 {
                             // vstack enabled: move top arity values to entry position.
                             if arity > 0 {
-                                let result = if sp > 0 {
-                                    builder.use_var(stack_vars[sp - 1])
-                                } else {
-                                    emit_stack_pop!(builder)
-                                };
-                                builder.def_var(stack_vars[entry], result);
+                                move_vstack_result!(builder, entry);
                             }
                         } else {
                             // vstack disabled: trim the real value stack down to the target label's entry depth + arity, preserving the top arity values.
@@ -1440,8 +1844,7 @@ impl CraneliftCompiler {
                             builder.switch_to_block(taken_block);
                             builder.seal_block(taken_block);
                             if arity > 0 {
-                                let result = builder.use_var(stack_vars[sp - 1]);
-                                builder.def_var(stack_vars[entry], result);
+                                move_vstack_result!(builder, entry);
                             }
                             // Note: we don't change sp here since fallthrough needs the original sp.
                             builder.ins().jump(target, &[]);
@@ -1504,7 +1907,11 @@ impl CraneliftCompiler {
                 }
                 op::LOCAL_TEE | op::SYNTHETIC_ARGUMENT_TEE => {
                     let idx = insn.imm1 as usize;
-                    if idx < local_vars.len() && local_is_f64[idx] {
+                    if local_is_v128.get(idx) == Some(&true) {
+                        let val = read_src_v128!(builder, insn.sources[0]);
+                        write_local_v128!(builder, insn.imm1, val);
+                        write_dst_v128!(builder, insn.destination, val);
+                    } else if idx < local_vars.len() && local_is_f64[idx] {
                         let val = read_src_f64!(builder, insn.sources[0]);
                         write_local_f64!(builder, insn.imm1, val);
                         write_dst_f64!(builder, insn.destination, val);
@@ -1528,8 +1935,13 @@ impl CraneliftCompiler {
                     local_set!(builder, local_idx, insn.sources[0]);
                 }
                 op::SYNTHETIC_LOCAL_COPY => {
-                    let val = read_local_inline!(builder, insn.imm1);
-                    write_local_inline!(builder, insn.imm2, val);
+                    if local_is_v128.get(insn.imm1 as usize) == Some(&true) {
+                        let val = read_local_v128!(builder, insn.imm1);
+                        write_local_v128!(builder, insn.imm2, val);
+                    } else {
+                        let val = read_local_inline!(builder, insn.imm1);
+                        write_local_inline!(builder, insn.imm2, val);
+                    }
                 }
 
                 op::GLOBAL_GET => {
@@ -1559,6 +1971,15 @@ impl CraneliftCompiler {
                     // No need to do anything if it's not on the real stack.
                 }
 
+                op::SELECT | op::SELECT_TYPED if uses_v128 => {
+                    // The operands may be vectors, so select both halves.
+                    let cond_raw = read_src!(builder, insn.sources[0]);
+                    let rhs = read_src_v128!(builder, insn.sources[1]);
+                    let lhs = read_src_v128!(builder, insn.sources[2]);
+                    let cond = builder.ins().icmp_imm(IntCC::NotEqual, cond_raw, 0);
+                    let result = builder.ins().select(cond, lhs, rhs);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
                 op::SELECT | op::SELECT_TYPED => {
                     let cond_raw = read_src!(builder, insn.sources[0]);
                     let rhs = read_src!(builder, insn.sources[1]);
@@ -1607,12 +2028,7 @@ impl CraneliftCompiler {
                             };
                             let entry = frame.stack_depth_at_entry as usize;
                             if max_stack_depth > 0 && arity > 0 {
-                                let result = if sp > 0 {
-                                    builder.use_var(stack_vars[sp - 1])
-                                } else {
-                                    emit_stack_pop!(builder)
-                                };
-                                builder.def_var(stack_vars[entry], result);
+                                move_vstack_result!(builder, entry);
                             } else if max_stack_depth == 0 {
                                 let entry_depth_var = frame
                                     .entry_real_depth_var
@@ -1993,17 +2409,30 @@ impl CraneliftCompiler {
                 | op::I64_LOAD16_S
                 | op::I64_LOAD16_U
                 | op::I64_LOAD32_S
-                | op::I64_LOAD32_U => {
-                    // addr = base (from source reg as u32) + offset.
-                    let base_raw = read_src!(builder, insn.sources[0]);
+                | op::I64_LOAD32_U
+                | op::SYNTHETIC_I32_LOADLOCAL
+                | op::SYNTHETIC_I64_LOADLOCAL => {
+                    // addr = base (from source reg, or from a local for the fused loads, as u32) + offset.
+                    let loads_base_from_local =
+                        matches!(opc, op::SYNTHETIC_I32_LOADLOCAL | op::SYNTHETIC_I64_LOADLOCAL);
+                    let opc = match opc {
+                        op::SYNTHETIC_I32_LOADLOCAL => op::I32_LOAD,
+                        op::SYNTHETIC_I64_LOADLOCAL => op::I64_LOAD,
+                        _ => opc,
+                    };
+                    let base_raw = if loads_base_from_local {
+                        read_local_inline!(builder, insn.imm2)
+                    } else {
+                        read_src!(builder, insn.sources[0])
+                    };
                     let base_u32 = builder.ins().ireduce(types::I32, base_raw);
                     let base_u64 = builder.ins().uextend(types::I64, base_u32);
                     let offset = builder.ins().iconst(types::I64, insn.imm1);
                     let addr = builder.ins().iadd(base_u64, offset);
 
                     let mem_idx = insn.imm3 & 0x7fff_ffff;
-                    if mem_idx == 0 {
-                        let address = inline_default_memory_address!(builder, addr);
+                    if let Some(memory_base) = guarded_memory_base!(builder, mem_idx) {
+                        let address = guarded_memory_address!(builder, memory_base, addr);
                         if opc == op::F64_LOAD {
                             let result = builder.ins().load(types::F64, wasm_memory_flags, address, 0);
                             write_dst_f64!(builder, insn.destination, result);
@@ -2091,7 +2520,8 @@ impl CraneliftCompiler {
                 | op::I64_STORE16
                 | op::I64_STORE32 => {
                     let mem_idx = insn.imm3 & 0x7fff_ffff;
-                    let is_f32_inline = opc == op::F32_STORE && mem_idx == 0;
+                    let inline_memory_base = guarded_memory_base!(builder, mem_idx);
+                    let is_f32_inline = opc == op::F32_STORE && inline_memory_base.is_some();
                     let val = if is_f32_inline {
                         read_src_f32!(builder, insn.sources[0])
                     } else {
@@ -2103,7 +2533,7 @@ impl CraneliftCompiler {
                     let offset = builder.ins().iconst(types::I64, insn.imm1);
                     let addr = builder.ins().iadd(base_u64, offset);
 
-                    if mem_idx == 0 {
+                    if let Some(memory_base) = inline_memory_base {
                         let access_size = match opc {
                             op::I32_STORE8 | op::I64_STORE8 => 1,
                             op::I32_STORE16 | op::I64_STORE16 => 2,
@@ -2111,7 +2541,7 @@ impl CraneliftCompiler {
                             op::I64_STORE | op::F64_STORE => 8,
                             _ => unreachable!(),
                         };
-                        let address = inline_default_memory_address!(builder, addr);
+                        let address = guarded_memory_address!(builder, memory_base, addr);
                         let value = if is_f32_inline {
                             val
                         } else {
@@ -2150,6 +2580,111 @@ impl CraneliftCompiler {
                     }
                 }
 
+                op::ATOMIC_FENCE => {
+                    builder.ins().fence();
+                }
+
+                op::I32_ATOMIC_LOAD..=op::I64_ATOMIC_RMW32_CMPXCHG_U => {
+                    // Atomics are only lowered for the default memory; functions that use them with any other
+                    // memory stay in the interpreter.
+                    if insn.imm3 & 0x7fff_ffff != 0 {
+                        return Err("atomic access to a non-default memory");
+                    }
+                    let access_type = Self::atomic_access_type(opc);
+                    let address_source = match opc {
+                        op::I32_ATOMIC_LOAD..=op::I64_ATOMIC_LOAD32_U => 0,
+                        op::I32_ATOMIC_RMW_CMPXCHG..=op::I64_ATOMIC_RMW32_CMPXCHG_U => 2,
+                        _ => 1,
+                    };
+                    let base_raw = read_src!(builder, insn.sources[address_source]);
+                    let base_u32 = builder.ins().ireduce(types::I32, base_raw);
+                    let base_u64 = builder.ins().uextend(types::I64, base_u32);
+                    let offset = builder.ins().iconst(types::I64, insn.imm1);
+                    let addr = builder.ins().iadd(base_u64, offset);
+
+                    // Unlike regular accesses, atomic accesses trap when they are not naturally aligned.
+                    let access_size = i64::from(access_type.bytes());
+                    if access_size > 1 {
+                        let misalignment = builder.ins().band_imm(addr, access_size - 1);
+                        let misaligned = builder.create_block();
+                        let cont = builder.create_block();
+                        builder.ins().brif(misalignment, misaligned, &[], cont, &[]);
+                        builder.switch_to_block(misaligned);
+                        builder.seal_block(misaligned);
+                        Self::sync_regs_to_config(
+                            &mut builder,
+                            &reg_vars,
+                            reg_vars_hi,
+                            config_var,
+                            regs_offset,
+                            value_size,
+                            &dirty_regs,
+                        );
+                        flush_locals!(builder);
+                        set_trap!(builder, "Unaligned atomic memory access");
+                        builder.ins().jump(trap_block, &[]);
+                        builder.switch_to_block(cont);
+                        builder.seal_block(cont);
+                    }
+
+                    let address = inline_default_memory_address!(builder, addr);
+                    macro_rules! read_operand {
+                        ($source:expr) => {{
+                            let value = read_src!(builder, insn.sources[$source]);
+                            if access_type == types::I64 {
+                                value
+                            } else {
+                                builder.ins().ireduce(access_type, value)
+                            }
+                        }};
+                    }
+                    let result = match opc {
+                        op::I32_ATOMIC_LOAD..=op::I64_ATOMIC_LOAD32_U => {
+                            Some(builder.ins().atomic_load(access_type, wasm_memory_flags, address))
+                        }
+                        op::I32_ATOMIC_STORE..=op::I64_ATOMIC_STORE32 => {
+                            let value = read_operand!(0);
+                            builder.ins().atomic_store(wasm_memory_flags, value, address);
+                            None
+                        }
+                        op::I32_ATOMIC_RMW_CMPXCHG..=op::I64_ATOMIC_RMW32_CMPXCHG_U => {
+                            let replacement = read_operand!(0);
+                            let expected = read_operand!(1);
+                            Some(
+                                builder
+                                    .ins()
+                                    .atomic_cas(wasm_memory_flags, address, expected, replacement),
+                            )
+                        }
+                        _ => {
+                            let operation = match opc {
+                                op::I32_ATOMIC_RMW_ADD..=op::I64_ATOMIC_RMW32_ADD_U => AtomicRmwOp::Add,
+                                op::I32_ATOMIC_RMW_SUB..=op::I64_ATOMIC_RMW32_SUB_U => AtomicRmwOp::Sub,
+                                op::I32_ATOMIC_RMW_AND..=op::I64_ATOMIC_RMW32_AND_U => AtomicRmwOp::And,
+                                op::I32_ATOMIC_RMW_OR..=op::I64_ATOMIC_RMW32_OR_U => AtomicRmwOp::Or,
+                                op::I32_ATOMIC_RMW_XOR..=op::I64_ATOMIC_RMW32_XOR_U => AtomicRmwOp::Xor,
+                                op::I32_ATOMIC_RMW_XCHG..=op::I64_ATOMIC_RMW32_XCHG_U => AtomicRmwOp::Xchg,
+                                _ => unreachable!(),
+                            };
+                            let operand = read_operand!(0);
+                            Some(
+                                builder
+                                    .ins()
+                                    .atomic_rmw(access_type, wasm_memory_flags, operation, address, operand),
+                            )
+                        }
+                    };
+                    // Narrow accesses zero-extend the value read back to the operand type.
+                    if let Some(result) = result {
+                        let result = if access_type == types::I64 {
+                            result
+                        } else {
+                            builder.ins().uextend(types::I64, result)
+                        };
+                        write_dst!(builder, insn.destination, result);
+                    }
+                }
+
                 op::MEMORY_SIZE => {
                     let mem_idx = builder.ins().iconst(types::I32, insn.imm1);
                     let _xv_config_var = builder.use_var(config_var);
@@ -2415,8 +2950,8 @@ impl CraneliftCompiler {
                     let addr = builder.ins().iadd(base_u64, offset);
 
                     let mem_idx = insn.imm3 & 0x7fff_ffff;
-                    if mem_idx == 0 {
-                        let address = inline_default_memory_address!(builder, addr);
+                    if let Some(memory_base) = guarded_memory_base!(builder, mem_idx) {
+                        let address = guarded_memory_address!(builder, memory_base, addr);
                         let value = if opc == op::SYNTHETIC_I32_STORELOCAL {
                             builder.ins().ireduce(types::I32, val)
                         } else {
@@ -2447,6 +2982,539 @@ impl CraneliftCompiler {
                     }
                 }
 
+                op::V128_LOAD
+                | op::V128_LOAD8X8_S
+                | op::V128_LOAD8X8_U
+                | op::V128_LOAD16X4_S
+                | op::V128_LOAD16X4_U
+                | op::V128_LOAD32X2_S
+                | op::V128_LOAD32X2_U
+                | op::V128_LOAD8_SPLAT
+                | op::V128_LOAD16_SPLAT
+                | op::V128_LOAD32_SPLAT
+                | op::V128_LOAD64_SPLAT
+                | op::V128_LOAD32_ZERO
+                | op::V128_LOAD64_ZERO => {
+                    let base_raw = read_src!(builder, insn.sources[0]);
+                    let address = v128_memory_address!(builder, insn, base_raw);
+                    let flags = wasm_memory_flags;
+                    let result = match opc {
+                        op::V128_LOAD => builder.ins().load(types::I64X2, flags, address, 0),
+                        op::V128_LOAD8X8_S => builder.ins().sload8x8(flags, address, 0),
+                        op::V128_LOAD8X8_U => builder.ins().uload8x8(flags, address, 0),
+                        op::V128_LOAD16X4_S => builder.ins().sload16x4(flags, address, 0),
+                        op::V128_LOAD16X4_U => builder.ins().uload16x4(flags, address, 0),
+                        op::V128_LOAD32X2_S => builder.ins().sload32x2(flags, address, 0),
+                        op::V128_LOAD32X2_U => builder.ins().uload32x2(flags, address, 0),
+                        op::V128_LOAD8_SPLAT => {
+                            let value = builder.ins().load(types::I8, flags, address, 0);
+                            builder.ins().splat(types::I8X16, value)
+                        }
+                        op::V128_LOAD16_SPLAT => {
+                            let value = builder.ins().load(types::I16, flags, address, 0);
+                            builder.ins().splat(types::I16X8, value)
+                        }
+                        op::V128_LOAD32_SPLAT => {
+                            let value = builder.ins().load(types::I32, flags, address, 0);
+                            builder.ins().splat(types::I32X4, value)
+                        }
+                        op::V128_LOAD64_SPLAT => {
+                            let value = builder.ins().load(types::I64, flags, address, 0);
+                            builder.ins().splat(types::I64X2, value)
+                        }
+                        op::V128_LOAD32_ZERO => {
+                            let value = builder.ins().load(types::I32, flags, address, 0);
+                            builder.ins().scalar_to_vector(types::I32X4, value)
+                        }
+                        op::V128_LOAD64_ZERO => {
+                            let value = builder.ins().load(types::I64, flags, address, 0);
+                            builder.ins().scalar_to_vector(types::I64X2, value)
+                        }
+                        _ => unreachable!(),
+                    };
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+
+                op::V128_STORE => {
+                    let value = read_src_v128!(builder, insn.sources[0]);
+                    let base_raw = read_src!(builder, insn.sources[1]);
+                    let address = v128_memory_address!(builder, insn, base_raw);
+                    builder.ins().store(wasm_memory_flags, value, address, 0);
+                }
+
+                op::V128_LOAD8_LANE | op::V128_LOAD16_LANE | op::V128_LOAD32_LANE | op::V128_LOAD64_LANE => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let base_raw = read_src!(builder, insn.sources[1]);
+                    let address = v128_memory_address!(builder, insn, base_raw);
+                    let (vector_ty, lane_ty) = match opc {
+                        op::V128_LOAD8_LANE => (types::I8X16, types::I8),
+                        op::V128_LOAD16_LANE => (types::I16X8, types::I16),
+                        op::V128_LOAD32_LANE => (types::I32X4, types::I32),
+                        op::V128_LOAD64_LANE => (types::I64X2, types::I64),
+                        _ => unreachable!(),
+                    };
+                    let vector = v128_cast!(builder, vector_ty, vector);
+                    let value = builder.ins().load(lane_ty, wasm_memory_flags, address, 0);
+                    let result = builder.ins().insertlane(vector, value, insn.imm2 as u8);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+
+                op::V128_STORE8_LANE | op::V128_STORE16_LANE | op::V128_STORE32_LANE | op::V128_STORE64_LANE => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let base_raw = read_src!(builder, insn.sources[1]);
+                    let address = v128_memory_address!(builder, insn, base_raw);
+                    let vector_ty = match opc {
+                        op::V128_STORE8_LANE => types::I8X16,
+                        op::V128_STORE16_LANE => types::I16X8,
+                        op::V128_STORE32_LANE => types::I32X4,
+                        op::V128_STORE64_LANE => types::I64X2,
+                        _ => unreachable!(),
+                    };
+                    let vector = v128_cast!(builder, vector_ty, vector);
+                    let value = builder.ins().extractlane(vector, insn.imm2 as u8);
+                    builder.ins().store(wasm_memory_flags, value, address, 0);
+                }
+
+                op::V128_CONST => {
+                    let mut bytes = [0u8; 16];
+                    bytes[..8].copy_from_slice(&insn.imm1.to_le_bytes());
+                    bytes[8..].copy_from_slice(&insn.imm2.to_le_bytes());
+                    let result = v128_const!(builder, bytes);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+
+                op::I8X16_SHUFFLE => {
+                    let rhs = read_src_v128!(builder, insn.sources[0]);
+                    let lhs = read_src_v128!(builder, insn.sources[1]);
+                    let rhs = v128_cast!(builder, types::I8X16, rhs);
+                    let lhs = v128_cast!(builder, types::I8X16, lhs);
+                    let mut lanes = [0u8; 16];
+                    lanes[..8].copy_from_slice(&insn.imm1.to_le_bytes());
+                    lanes[8..].copy_from_slice(&insn.imm2.to_le_bytes());
+                    let mask = builder.func.dfg.immediates.push(ConstantData::from(&lanes[..]));
+                    let result = builder.ins().shuffle(lhs, rhs, mask);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::I8X16_SWIZZLE => v128_binop!(builder, insn, types::I8X16, swizzle),
+
+                op::I8X16_SPLAT | op::I16X8_SPLAT | op::I32X4_SPLAT | op::I64X2_SPLAT => {
+                    let value = read_src!(builder, insn.sources[0]);
+                    let (vector_ty, lane_ty) = match opc {
+                        op::I8X16_SPLAT => (types::I8X16, types::I8),
+                        op::I16X8_SPLAT => (types::I16X8, types::I16),
+                        op::I32X4_SPLAT => (types::I32X4, types::I32),
+                        op::I64X2_SPLAT => (types::I64X2, types::I64),
+                        _ => unreachable!(),
+                    };
+                    let value = if lane_ty == types::I64 {
+                        value
+                    } else {
+                        builder.ins().ireduce(lane_ty, value)
+                    };
+                    let result = builder.ins().splat(vector_ty, value);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F32X4_SPLAT => {
+                    let value = read_src_f32!(builder, insn.sources[0]);
+                    let result = builder.ins().splat(types::F32X4, value);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F64X2_SPLAT => {
+                    let value = read_src_f64!(builder, insn.sources[0]);
+                    let result = builder.ins().splat(types::F64X2, value);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+
+                op::I8X16_EXTRACT_LANE_S
+                | op::I8X16_EXTRACT_LANE_U
+                | op::I16X8_EXTRACT_LANE_S
+                | op::I16X8_EXTRACT_LANE_U
+                | op::I32X4_EXTRACT_LANE
+                | op::I64X2_EXTRACT_LANE => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector_ty = match opc {
+                        op::I8X16_EXTRACT_LANE_S | op::I8X16_EXTRACT_LANE_U => types::I8X16,
+                        op::I16X8_EXTRACT_LANE_S | op::I16X8_EXTRACT_LANE_U => types::I16X8,
+                        op::I32X4_EXTRACT_LANE => types::I32X4,
+                        op::I64X2_EXTRACT_LANE => types::I64X2,
+                        _ => unreachable!(),
+                    };
+                    let vector = v128_cast!(builder, vector_ty, vector);
+                    let lane = builder.ins().extractlane(vector, insn.imm1 as u8);
+                    let result = match opc {
+                        op::I8X16_EXTRACT_LANE_U | op::I16X8_EXTRACT_LANE_U => builder.ins().uextend(types::I64, lane),
+                        op::I64X2_EXTRACT_LANE => lane,
+                        _ => builder.ins().sextend(types::I64, lane),
+                    };
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::F32X4_EXTRACT_LANE => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector = v128_cast!(builder, types::F32X4, vector);
+                    let result = builder.ins().extractlane(vector, insn.imm1 as u8);
+                    write_dst_f32!(builder, insn.destination, result);
+                }
+                op::F64X2_EXTRACT_LANE => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector = v128_cast!(builder, types::F64X2, vector);
+                    let result = builder.ins().extractlane(vector, insn.imm1 as u8);
+                    write_dst_f64!(builder, insn.destination, result);
+                }
+
+                op::I8X16_REPLACE_LANE | op::I16X8_REPLACE_LANE | op::I32X4_REPLACE_LANE | op::I64X2_REPLACE_LANE => {
+                    let value = read_src!(builder, insn.sources[0]);
+                    let vector = read_src_v128!(builder, insn.sources[1]);
+                    let (vector_ty, lane_ty) = match opc {
+                        op::I8X16_REPLACE_LANE => (types::I8X16, types::I8),
+                        op::I16X8_REPLACE_LANE => (types::I16X8, types::I16),
+                        op::I32X4_REPLACE_LANE => (types::I32X4, types::I32),
+                        op::I64X2_REPLACE_LANE => (types::I64X2, types::I64),
+                        _ => unreachable!(),
+                    };
+                    let value = if lane_ty == types::I64 {
+                        value
+                    } else {
+                        builder.ins().ireduce(lane_ty, value)
+                    };
+                    let vector = v128_cast!(builder, vector_ty, vector);
+                    let result = builder.ins().insertlane(vector, value, insn.imm1 as u8);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F32X4_REPLACE_LANE => {
+                    let value = read_src_f32!(builder, insn.sources[0]);
+                    let vector = read_src_v128!(builder, insn.sources[1]);
+                    let vector = v128_cast!(builder, types::F32X4, vector);
+                    let result = builder.ins().insertlane(vector, value, insn.imm1 as u8);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F64X2_REPLACE_LANE => {
+                    let value = read_src_f64!(builder, insn.sources[0]);
+                    let vector = read_src_v128!(builder, insn.sources[1]);
+                    let vector = v128_cast!(builder, types::F64X2, vector);
+                    let result = builder.ins().insertlane(vector, value, insn.imm1 as u8);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+
+                op::I8X16_EQ => v128_icmp!(builder, insn, types::I8X16, IntCC::Equal),
+                op::I8X16_NE => v128_icmp!(builder, insn, types::I8X16, IntCC::NotEqual),
+                op::I8X16_LT_S => v128_icmp!(builder, insn, types::I8X16, IntCC::SignedLessThan),
+                op::I8X16_LT_U => v128_icmp!(builder, insn, types::I8X16, IntCC::UnsignedLessThan),
+                op::I8X16_GT_S => v128_icmp!(builder, insn, types::I8X16, IntCC::SignedGreaterThan),
+                op::I8X16_GT_U => v128_icmp!(builder, insn, types::I8X16, IntCC::UnsignedGreaterThan),
+                op::I8X16_LE_S => v128_icmp!(builder, insn, types::I8X16, IntCC::SignedLessThanOrEqual),
+                op::I8X16_LE_U => v128_icmp!(builder, insn, types::I8X16, IntCC::UnsignedLessThanOrEqual),
+                op::I8X16_GE_S => v128_icmp!(builder, insn, types::I8X16, IntCC::SignedGreaterThanOrEqual),
+                op::I8X16_GE_U => v128_icmp!(builder, insn, types::I8X16, IntCC::UnsignedGreaterThanOrEqual),
+                op::I16X8_EQ => v128_icmp!(builder, insn, types::I16X8, IntCC::Equal),
+                op::I16X8_NE => v128_icmp!(builder, insn, types::I16X8, IntCC::NotEqual),
+                op::I16X8_LT_S => v128_icmp!(builder, insn, types::I16X8, IntCC::SignedLessThan),
+                op::I16X8_LT_U => v128_icmp!(builder, insn, types::I16X8, IntCC::UnsignedLessThan),
+                op::I16X8_GT_S => v128_icmp!(builder, insn, types::I16X8, IntCC::SignedGreaterThan),
+                op::I16X8_GT_U => v128_icmp!(builder, insn, types::I16X8, IntCC::UnsignedGreaterThan),
+                op::I16X8_LE_S => v128_icmp!(builder, insn, types::I16X8, IntCC::SignedLessThanOrEqual),
+                op::I16X8_LE_U => v128_icmp!(builder, insn, types::I16X8, IntCC::UnsignedLessThanOrEqual),
+                op::I16X8_GE_S => v128_icmp!(builder, insn, types::I16X8, IntCC::SignedGreaterThanOrEqual),
+                op::I16X8_GE_U => v128_icmp!(builder, insn, types::I16X8, IntCC::UnsignedGreaterThanOrEqual),
+                op::I32X4_EQ => v128_icmp!(builder, insn, types::I32X4, IntCC::Equal),
+                op::I32X4_NE => v128_icmp!(builder, insn, types::I32X4, IntCC::NotEqual),
+                op::I32X4_LT_S => v128_icmp!(builder, insn, types::I32X4, IntCC::SignedLessThan),
+                op::I32X4_LT_U => v128_icmp!(builder, insn, types::I32X4, IntCC::UnsignedLessThan),
+                op::I32X4_GT_S => v128_icmp!(builder, insn, types::I32X4, IntCC::SignedGreaterThan),
+                op::I32X4_GT_U => v128_icmp!(builder, insn, types::I32X4, IntCC::UnsignedGreaterThan),
+                op::I32X4_LE_S => v128_icmp!(builder, insn, types::I32X4, IntCC::SignedLessThanOrEqual),
+                op::I32X4_LE_U => v128_icmp!(builder, insn, types::I32X4, IntCC::UnsignedLessThanOrEqual),
+                op::I32X4_GE_S => v128_icmp!(builder, insn, types::I32X4, IntCC::SignedGreaterThanOrEqual),
+                op::I32X4_GE_U => v128_icmp!(builder, insn, types::I32X4, IntCC::UnsignedGreaterThanOrEqual),
+                op::I64X2_EQ => v128_icmp!(builder, insn, types::I64X2, IntCC::Equal),
+                op::I64X2_NE => v128_icmp!(builder, insn, types::I64X2, IntCC::NotEqual),
+                op::I64X2_LT_S => v128_icmp!(builder, insn, types::I64X2, IntCC::SignedLessThan),
+                op::I64X2_GT_S => v128_icmp!(builder, insn, types::I64X2, IntCC::SignedGreaterThan),
+                op::I64X2_LE_S => v128_icmp!(builder, insn, types::I64X2, IntCC::SignedLessThanOrEqual),
+                op::I64X2_GE_S => v128_icmp!(builder, insn, types::I64X2, IntCC::SignedGreaterThanOrEqual),
+                op::F32X4_EQ => v128_fcmp!(builder, insn, types::F32X4, FloatCC::Equal),
+                op::F32X4_NE => v128_fcmp!(builder, insn, types::F32X4, FloatCC::NotEqual),
+                op::F32X4_LT => v128_fcmp!(builder, insn, types::F32X4, FloatCC::LessThan),
+                op::F32X4_GT => v128_fcmp!(builder, insn, types::F32X4, FloatCC::GreaterThan),
+                op::F32X4_LE => v128_fcmp!(builder, insn, types::F32X4, FloatCC::LessThanOrEqual),
+                op::F32X4_GE => v128_fcmp!(builder, insn, types::F32X4, FloatCC::GreaterThanOrEqual),
+                op::F64X2_EQ => v128_fcmp!(builder, insn, types::F64X2, FloatCC::Equal),
+                op::F64X2_NE => v128_fcmp!(builder, insn, types::F64X2, FloatCC::NotEqual),
+                op::F64X2_LT => v128_fcmp!(builder, insn, types::F64X2, FloatCC::LessThan),
+                op::F64X2_GT => v128_fcmp!(builder, insn, types::F64X2, FloatCC::GreaterThan),
+                op::F64X2_LE => v128_fcmp!(builder, insn, types::F64X2, FloatCC::LessThanOrEqual),
+                op::F64X2_GE => v128_fcmp!(builder, insn, types::F64X2, FloatCC::GreaterThanOrEqual),
+
+                op::V128_NOT => v128_unop!(builder, insn, types::I64X2, bnot),
+                op::V128_AND => v128_binop!(builder, insn, types::I64X2, band),
+                op::V128_ANDNOT => v128_binop!(builder, insn, types::I64X2, band_not),
+                op::V128_OR => v128_binop!(builder, insn, types::I64X2, bor),
+                op::V128_XOR => v128_binop!(builder, insn, types::I64X2, bxor),
+                op::V128_BITSELECT => {
+                    let mask = read_src_v128!(builder, insn.sources[0]);
+                    let if_false = read_src_v128!(builder, insn.sources[1]);
+                    let if_true = read_src_v128!(builder, insn.sources[2]);
+                    let result = builder.ins().bitselect(mask, if_true, if_false);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::V128_ANY_TRUE => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let any = builder.ins().vany_true(vector);
+                    let result = builder.ins().uextend(types::I64, any);
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::I8X16_ALL_TRUE | op::I16X8_ALL_TRUE | op::I32X4_ALL_TRUE | op::I64X2_ALL_TRUE => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector_ty = match opc {
+                        op::I8X16_ALL_TRUE => types::I8X16,
+                        op::I16X8_ALL_TRUE => types::I16X8,
+                        op::I32X4_ALL_TRUE => types::I32X4,
+                        op::I64X2_ALL_TRUE => types::I64X2,
+                        _ => unreachable!(),
+                    };
+                    let vector = v128_cast!(builder, vector_ty, vector);
+                    let all = builder.ins().vall_true(vector);
+                    let result = builder.ins().uextend(types::I64, all);
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::I8X16_BITMASK | op::I16X8_BITMASK | op::I32X4_BITMASK | op::I64X2_BITMASK => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector_ty = match opc {
+                        op::I8X16_BITMASK => types::I8X16,
+                        op::I16X8_BITMASK => types::I16X8,
+                        op::I32X4_BITMASK => types::I32X4,
+                        op::I64X2_BITMASK => types::I64X2,
+                        _ => unreachable!(),
+                    };
+                    let vector = v128_cast!(builder, vector_ty, vector);
+                    let mask = builder.ins().vhigh_bits(types::I32, vector);
+                    let result = builder.ins().uextend(types::I64, mask);
+                    write_dst!(builder, insn.destination, result);
+                }
+
+                op::I8X16_ABS => v128_unop!(builder, insn, types::I8X16, iabs),
+                op::I8X16_NEG => v128_unop!(builder, insn, types::I8X16, ineg),
+                op::I8X16_POPCNT => v128_unop!(builder, insn, types::I8X16, popcnt),
+                op::I8X16_NARROW_I16X8_S => v128_binop!(builder, insn, types::I16X8, snarrow),
+                op::I8X16_NARROW_I16X8_U => v128_binop!(builder, insn, types::I16X8, unarrow),
+                op::I8X16_SHL => v128_shift!(builder, insn, types::I8X16, ishl),
+                op::I8X16_SHR_S => v128_shift!(builder, insn, types::I8X16, sshr),
+                op::I8X16_SHR_U => v128_shift!(builder, insn, types::I8X16, ushr),
+                op::I8X16_ADD => v128_binop!(builder, insn, types::I8X16, iadd),
+                op::I8X16_ADD_SAT_S => v128_binop!(builder, insn, types::I8X16, sadd_sat),
+                op::I8X16_ADD_SAT_U => v128_binop!(builder, insn, types::I8X16, uadd_sat),
+                op::I8X16_SUB => v128_binop!(builder, insn, types::I8X16, isub),
+                op::I8X16_SUB_SAT_S => v128_binop!(builder, insn, types::I8X16, ssub_sat),
+                op::I8X16_SUB_SAT_U => v128_binop!(builder, insn, types::I8X16, usub_sat),
+                op::I8X16_MIN_S => v128_binop!(builder, insn, types::I8X16, smin),
+                op::I8X16_MIN_U => v128_binop!(builder, insn, types::I8X16, umin),
+                op::I8X16_MAX_S => v128_binop!(builder, insn, types::I8X16, smax),
+                op::I8X16_MAX_U => v128_binop!(builder, insn, types::I8X16, umax),
+                op::I8X16_AVGR_U => v128_binop!(builder, insn, types::I8X16, avg_round),
+
+                op::I16X8_EXTADD_PAIRWISE_I8X16_S
+                | op::I16X8_EXTADD_PAIRWISE_I8X16_U
+                | op::I32X4_EXTADD_PAIRWISE_I16X8_S
+                | op::I32X4_EXTADD_PAIRWISE_I16X8_U => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let result = match opc {
+                        op::I16X8_EXTADD_PAIRWISE_I8X16_S => {
+                            v128_widen_pairwise!(builder, types::I8X16, swiden_low, swiden_high, vector)
+                        }
+                        op::I16X8_EXTADD_PAIRWISE_I8X16_U => {
+                            v128_widen_pairwise!(builder, types::I8X16, uwiden_low, uwiden_high, vector)
+                        }
+                        op::I32X4_EXTADD_PAIRWISE_I16X8_S => {
+                            v128_widen_pairwise!(builder, types::I16X8, swiden_low, swiden_high, vector)
+                        }
+                        op::I32X4_EXTADD_PAIRWISE_I16X8_U => {
+                            v128_widen_pairwise!(builder, types::I16X8, uwiden_low, uwiden_high, vector)
+                        }
+                        _ => unreachable!(),
+                    };
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+
+                op::I16X8_ABS => v128_unop!(builder, insn, types::I16X8, iabs),
+                op::I16X8_NEG => v128_unop!(builder, insn, types::I16X8, ineg),
+                op::I16X8_Q15MULR_SAT_S => v128_binop!(builder, insn, types::I16X8, sqmul_round_sat),
+                op::I16X8_NARROW_I32X4_S => v128_binop!(builder, insn, types::I32X4, snarrow),
+                op::I16X8_NARROW_I32X4_U => v128_binop!(builder, insn, types::I32X4, unarrow),
+                op::I16X8_EXTEND_LOW_I8X16_S => v128_unop!(builder, insn, types::I8X16, swiden_low),
+                op::I16X8_EXTEND_HIGH_I8X16_S => v128_unop!(builder, insn, types::I8X16, swiden_high),
+                op::I16X8_EXTEND_LOW_I8X16_U => v128_unop!(builder, insn, types::I8X16, uwiden_low),
+                op::I16X8_EXTEND_HIGH_I8X16_U => v128_unop!(builder, insn, types::I8X16, uwiden_high),
+                op::I16X8_SHL => v128_shift!(builder, insn, types::I16X8, ishl),
+                op::I16X8_SHR_S => v128_shift!(builder, insn, types::I16X8, sshr),
+                op::I16X8_SHR_U => v128_shift!(builder, insn, types::I16X8, ushr),
+                op::I16X8_ADD => v128_binop!(builder, insn, types::I16X8, iadd),
+                op::I16X8_ADD_SAT_S => v128_binop!(builder, insn, types::I16X8, sadd_sat),
+                op::I16X8_ADD_SAT_U => v128_binop!(builder, insn, types::I16X8, uadd_sat),
+                op::I16X8_SUB => v128_binop!(builder, insn, types::I16X8, isub),
+                op::I16X8_SUB_SAT_S => v128_binop!(builder, insn, types::I16X8, ssub_sat),
+                op::I16X8_SUB_SAT_U => v128_binop!(builder, insn, types::I16X8, usub_sat),
+                op::I16X8_MUL => v128_binop!(builder, insn, types::I16X8, imul),
+                op::I16X8_MIN_S => v128_binop!(builder, insn, types::I16X8, smin),
+                op::I16X8_MIN_U => v128_binop!(builder, insn, types::I16X8, umin),
+                op::I16X8_MAX_S => v128_binop!(builder, insn, types::I16X8, smax),
+                op::I16X8_MAX_U => v128_binop!(builder, insn, types::I16X8, umax),
+                op::I16X8_AVGR_U => v128_binop!(builder, insn, types::I16X8, avg_round),
+                op::I16X8_EXTMUL_LOW_I8X16_S => v128_extmul!(builder, insn, types::I8X16, swiden_low),
+                op::I16X8_EXTMUL_HIGH_I8X16_S => v128_extmul!(builder, insn, types::I8X16, swiden_high),
+                op::I16X8_EXTMUL_LOW_I8X16_U => v128_extmul!(builder, insn, types::I8X16, uwiden_low),
+                op::I16X8_EXTMUL_HIGH_I8X16_U => v128_extmul!(builder, insn, types::I8X16, uwiden_high),
+
+                op::I32X4_ABS => v128_unop!(builder, insn, types::I32X4, iabs),
+                op::I32X4_NEG => v128_unop!(builder, insn, types::I32X4, ineg),
+                op::I32X4_EXTEND_LOW_I16X8_S => v128_unop!(builder, insn, types::I16X8, swiden_low),
+                op::I32X4_EXTEND_HIGH_I16X8_S => v128_unop!(builder, insn, types::I16X8, swiden_high),
+                op::I32X4_EXTEND_LOW_I16X8_U => v128_unop!(builder, insn, types::I16X8, uwiden_low),
+                op::I32X4_EXTEND_HIGH_I16X8_U => v128_unop!(builder, insn, types::I16X8, uwiden_high),
+                op::I32X4_SHL => v128_shift!(builder, insn, types::I32X4, ishl),
+                op::I32X4_SHR_S => v128_shift!(builder, insn, types::I32X4, sshr),
+                op::I32X4_SHR_U => v128_shift!(builder, insn, types::I32X4, ushr),
+                op::I32X4_ADD => v128_binop!(builder, insn, types::I32X4, iadd),
+                op::I32X4_SUB => v128_binop!(builder, insn, types::I32X4, isub),
+                op::I32X4_MUL => v128_binop!(builder, insn, types::I32X4, imul),
+                op::I32X4_MIN_S => v128_binop!(builder, insn, types::I32X4, smin),
+                op::I32X4_MIN_U => v128_binop!(builder, insn, types::I32X4, umin),
+                op::I32X4_MAX_S => v128_binop!(builder, insn, types::I32X4, smax),
+                op::I32X4_MAX_U => v128_binop!(builder, insn, types::I32X4, umax),
+                op::I32X4_DOT_I16X8_S => {
+                    let rhs = read_src_v128!(builder, insn.sources[0]);
+                    let lhs = read_src_v128!(builder, insn.sources[1]);
+                    let rhs = v128_cast!(builder, types::I16X8, rhs);
+                    let lhs = v128_cast!(builder, types::I16X8, lhs);
+                    let lhs_low = builder.ins().swiden_low(lhs);
+                    let rhs_low = builder.ins().swiden_low(rhs);
+                    let low = builder.ins().imul(lhs_low, rhs_low);
+                    let lhs_high = builder.ins().swiden_high(lhs);
+                    let rhs_high = builder.ins().swiden_high(rhs);
+                    let high = builder.ins().imul(lhs_high, rhs_high);
+                    let result = builder.ins().iadd_pairwise(low, high);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::I32X4_EXTMUL_LOW_I16X8_S => v128_extmul!(builder, insn, types::I16X8, swiden_low),
+                op::I32X4_EXTMUL_HIGH_I16X8_S => v128_extmul!(builder, insn, types::I16X8, swiden_high),
+                op::I32X4_EXTMUL_LOW_I16X8_U => v128_extmul!(builder, insn, types::I16X8, uwiden_low),
+                op::I32X4_EXTMUL_HIGH_I16X8_U => v128_extmul!(builder, insn, types::I16X8, uwiden_high),
+
+                op::I64X2_ABS => v128_unop!(builder, insn, types::I64X2, iabs),
+                op::I64X2_NEG => v128_unop!(builder, insn, types::I64X2, ineg),
+                op::I64X2_EXTEND_LOW_I32X4_S => v128_unop!(builder, insn, types::I32X4, swiden_low),
+                op::I64X2_EXTEND_HIGH_I32X4_S => v128_unop!(builder, insn, types::I32X4, swiden_high),
+                op::I64X2_EXTEND_LOW_I32X4_U => v128_unop!(builder, insn, types::I32X4, uwiden_low),
+                op::I64X2_EXTEND_HIGH_I32X4_U => v128_unop!(builder, insn, types::I32X4, uwiden_high),
+                op::I64X2_SHL => v128_shift!(builder, insn, types::I64X2, ishl),
+                op::I64X2_SHR_S => v128_shift!(builder, insn, types::I64X2, sshr),
+                op::I64X2_SHR_U => v128_shift!(builder, insn, types::I64X2, ushr),
+                op::I64X2_ADD => v128_binop!(builder, insn, types::I64X2, iadd),
+                op::I64X2_SUB => v128_binop!(builder, insn, types::I64X2, isub),
+                op::I64X2_MUL => v128_binop!(builder, insn, types::I64X2, imul),
+                op::I64X2_EXTMUL_LOW_I32X4_S => v128_extmul!(builder, insn, types::I32X4, swiden_low),
+                op::I64X2_EXTMUL_HIGH_I32X4_S => v128_extmul!(builder, insn, types::I32X4, swiden_high),
+                op::I64X2_EXTMUL_LOW_I32X4_U => v128_extmul!(builder, insn, types::I32X4, uwiden_low),
+                op::I64X2_EXTMUL_HIGH_I32X4_U => v128_extmul!(builder, insn, types::I32X4, uwiden_high),
+
+                op::F32X4_CEIL => v128_unop!(builder, insn, types::F32X4, ceil),
+                op::F32X4_FLOOR => v128_unop!(builder, insn, types::F32X4, floor),
+                op::F32X4_TRUNC => v128_unop!(builder, insn, types::F32X4, trunc),
+                op::F32X4_NEAREST => v128_unop!(builder, insn, types::F32X4, nearest),
+                op::F32X4_ABS => v128_unop!(builder, insn, types::F32X4, fabs),
+                op::F32X4_NEG => v128_unop!(builder, insn, types::F32X4, fneg),
+                op::F32X4_SQRT => v128_unop!(builder, insn, types::F32X4, sqrt),
+                op::F32X4_ADD => v128_binop!(builder, insn, types::F32X4, fadd),
+                op::F32X4_SUB => v128_binop!(builder, insn, types::F32X4, fsub),
+                op::F32X4_MUL => v128_binop!(builder, insn, types::F32X4, fmul),
+                op::F32X4_DIV => v128_binop!(builder, insn, types::F32X4, fdiv),
+                op::F32X4_MIN => v128_binop!(builder, insn, types::F32X4, fmin),
+                op::F32X4_MAX => v128_binop!(builder, insn, types::F32X4, fmax),
+                op::F64X2_CEIL => v128_unop!(builder, insn, types::F64X2, ceil),
+                op::F64X2_FLOOR => v128_unop!(builder, insn, types::F64X2, floor),
+                op::F64X2_TRUNC => v128_unop!(builder, insn, types::F64X2, trunc),
+                op::F64X2_NEAREST => v128_unop!(builder, insn, types::F64X2, nearest),
+                op::F64X2_ABS => v128_unop!(builder, insn, types::F64X2, fabs),
+                op::F64X2_NEG => v128_unop!(builder, insn, types::F64X2, fneg),
+                op::F64X2_SQRT => v128_unop!(builder, insn, types::F64X2, sqrt),
+                op::F64X2_ADD => v128_binop!(builder, insn, types::F64X2, fadd),
+                op::F64X2_SUB => v128_binop!(builder, insn, types::F64X2, fsub),
+                op::F64X2_MUL => v128_binop!(builder, insn, types::F64X2, fmul),
+                op::F64X2_DIV => v128_binop!(builder, insn, types::F64X2, fdiv),
+                op::F64X2_MIN => v128_binop!(builder, insn, types::F64X2, fmin),
+                op::F64X2_MAX => v128_binop!(builder, insn, types::F64X2, fmax),
+
+                op::F32X4_PMIN | op::F32X4_PMAX | op::F64X2_PMIN | op::F64X2_PMAX => {
+                    // pmin(a, b) = b < a ? b : a, pmax(a, b) = a < b ? b : a, lane-wise and without NaN fixups.
+                    let rhs = read_src_v128!(builder, insn.sources[0]);
+                    let lhs = read_src_v128!(builder, insn.sources[1]);
+                    let vector_ty = match opc {
+                        op::F32X4_PMIN | op::F32X4_PMAX => types::F32X4,
+                        _ => types::F64X2,
+                    };
+                    let rhs = v128_cast!(builder, vector_ty, rhs);
+                    let lhs = v128_cast!(builder, vector_ty, lhs);
+                    let mask = match opc {
+                        op::F32X4_PMIN | op::F64X2_PMIN => builder.ins().fcmp(FloatCC::LessThan, rhs, lhs),
+                        _ => builder.ins().fcmp(FloatCC::LessThan, lhs, rhs),
+                    };
+                    let mask = v128_cast!(builder, vector_ty, mask);
+                    let result = builder.ins().bitselect(mask, rhs, lhs);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+
+                op::I32X4_TRUNC_SAT_F32X4_S => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector = v128_cast!(builder, types::F32X4, vector);
+                    let result = builder.ins().fcvt_to_sint_sat(types::I32X4, vector);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::I32X4_TRUNC_SAT_F32X4_U => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector = v128_cast!(builder, types::F32X4, vector);
+                    let result = builder.ins().fcvt_to_uint_sat(types::I32X4, vector);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F32X4_CONVERT_I32X4_S => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector = v128_cast!(builder, types::I32X4, vector);
+                    let result = builder.ins().fcvt_from_sint(types::F32X4, vector);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F32X4_CONVERT_I32X4_U => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector = v128_cast!(builder, types::I32X4, vector);
+                    let result = builder.ins().fcvt_from_uint(types::F32X4, vector);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::I32X4_TRUNC_SAT_F64X2_S_ZERO | op::I32X4_TRUNC_SAT_F64X2_U_ZERO => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector = v128_cast!(builder, types::F64X2, vector);
+                    let zero = v128_const!(builder, [0; 16]);
+                    let result = if opc == op::I32X4_TRUNC_SAT_F64X2_S_ZERO {
+                        let wide = builder.ins().fcvt_to_sint_sat(types::I64X2, vector);
+                        builder.ins().snarrow(wide, zero)
+                    } else {
+                        let wide = builder.ins().fcvt_to_uint_sat(types::I64X2, vector);
+                        builder.ins().uunarrow(wide, zero)
+                    };
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F64X2_CONVERT_LOW_I32X4_S => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector = v128_cast!(builder, types::I32X4, vector);
+                    let wide = builder.ins().swiden_low(vector);
+                    let result = builder.ins().fcvt_from_sint(types::F64X2, wide);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F64X2_CONVERT_LOW_I32X4_U => {
+                    let vector = read_src_v128!(builder, insn.sources[0]);
+                    let vector = v128_cast!(builder, types::I32X4, vector);
+                    let wide = builder.ins().uwiden_low(vector);
+                    let result = builder.ins().fcvt_from_uint(types::F64X2, wide);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F32X4_DEMOTE_F64X2_ZERO => v128_unop!(builder, insn, types::F64X2, fvdemote),
+                op::F64X2_PROMOTE_LOW_F32X4 => v128_unop!(builder, insn, types::F32X4, fvpromote_low),
+
                 op::SYNTHETIC_TIER_UP => {
                     if let Some(tail) = tier_up_dispatch_tail {
                         let header = control_stack
@@ -2509,6 +3577,7 @@ impl CraneliftCompiler {
         Self::sync_regs_to_config(
             &mut builder,
             &reg_vars,
+            reg_vars_hi,
             config_var,
             regs_offset,
             value_size,
@@ -2625,6 +3694,8 @@ impl CraneliftCompiler {
                 | op::SYNTHETIC_CALL_00..=op::SYNTHETIC_CALL_31
                 | op::SYNTHETIC_I32_ADD2LOCAL..=op::SYNTHETIC_I32_ANDCONSTLOCAL
                 | op::SYNTHETIC_I32_STORELOCAL
+                | op::SYNTHETIC_I32_LOADLOCAL
+                | op::SYNTHETIC_I64_LOADLOCAL
                 | op::SYNTHETIC_LOCAL_SETI32_CONST
                 | op::SYNTHETIC_CALL_WITH_RECORD_0
                 | op::SYNTHETIC_CALL_WITH_RECORD_1
@@ -2635,12 +3706,36 @@ impl CraneliftCompiler {
                 | op::SYNTHETIC_I64_ADD2LOCAL..=op::SYNTHETIC_LOCAL_SETI64_CONST
                 | op::SYNTHETIC_BR_TABLE_CONT
                 | op::SYNTHETIC_TIER_UP
-        )
+        ) || Self::is_simd(opc)
+            || Self::is_atomic(opc)
+    }
+
+    // memory.atomic.wait and memory.atomic.notify block or wake other agents, and stay in the interpreter.
+    fn is_atomic(opcode: u64) -> bool {
+        opcode == op::ATOMIC_FENCE || (op::I32_ATOMIC_LOAD..=op::I64_ATOMIC_RMW32_CMPXCHG_U).contains(&opcode)
+    }
+
+    // Atomic loads, stores and read-modify-writes come in groups of seven, ordered by access width:
+    // i32, i64, i32 8-bit, i32 16-bit, i64 8-bit, i64 16-bit and i64 32-bit.
+    fn atomic_access_type(opcode: u64) -> Type {
+        match (opcode - op::I32_ATOMIC_LOAD) % 7 {
+            0 | 6 => types::I32,
+            1 => types::I64,
+            2 | 4 => types::I8,
+            3 | 5 => types::I16,
+            _ => unreachable!(),
+        }
+    }
+
+    // Relaxed SIMD is not lowered yet, and stays in the interpreter.
+    fn is_simd(opcode: u64) -> bool {
+        (op::V128_LOAD..=op::F64X2_CONVERT_LOW_I32X4_U).contains(&opcode)
     }
 
     fn sync_regs_to_config(
         builder: &mut FunctionBuilder,
         reg_vars: &[Variable; REG_COUNT],
+        reg_vars_hi: &[Variable],
         config_var: Variable,
         regs_offset: i32,
         value_size: i32,
@@ -2654,8 +3749,12 @@ impl CraneliftCompiler {
             let val = builder.use_var(reg_vars[i]);
             let offset = regs_offset + (i as i32) * value_size;
             builder.ins().store(MemFlags::trusted(), val, config, offset);
-            let zero = builder.ins().iconst(types::I64, 0);
-            builder.ins().store(MemFlags::trusted(), zero, config, offset + 8);
+            // Without vectors, the high half is always zero and isn't tracked.
+            let hi = match reg_vars_hi.get(i) {
+                Some(var) => builder.use_var(*var),
+                None => builder.ins().iconst(types::I64, 0),
+            };
+            builder.ins().store(MemFlags::trusted(), hi, config, offset + 8);
         }
     }
 }
@@ -0,0 +1,455 @@
+function compiledExports(names) {
+    const module = parseWebAssemblyModule(readBinaryWasmFile("Fixtures/Modules/cranelift-simd.wasm"));
+    const addresses = names.map(name => module.getExport(name));
+    const eligible = addresses.map(address => isCraneliftEligible(address));
+
+    if (!eligible.some(isEligible => isEligible)) return null;
+
+    for (const isEligible of eligible) expect(isEligible).toBe(true);
+    for (const address of addresses) expect(isCraneliftCompiled(address)).toBe(true);
+
+    const loadI32 = module.getExport("load_i32");
+    const exports = Object.fromEntries(names.map((name, i) => [name, addresses[i]]));
+    return {
+        invoke: (name, ...args) => module.invoke(exports[name], ...args),
+        // Runs a function that stores its vector at address 0, and reads the vector back as lanes of LaneArray.
+        lanes: (LaneArray, name, ...args) => {
+            module.invoke(exports[name], ...args);
+            const words = new Int32Array(4);
+            for (let i = 0; i < 4; ++i) words[i] = module.invoke(loadI32, i * 4);
+            return Array.from(new LaneArray(words.buffer));
+        },
+    };
+}
+
+test("compiled integer lane arithmetic", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "i8x16.add", "i8x16.sub", "i8x16.add_sat_s", "i8x16.add_sat_u", "i8x16.sub_sat_s", "i8x16.sub_sat_u",
+        "i8x16.min_s", "i8x16.min_u", "i8x16.max_s", "i8x16.max_u", "i8x16.avgr_u", "i8x16.abs", "i8x16.neg",
+        "i8x16.popcnt", "i16x8.add", "i16x8.sub", "i16x8.mul", "i16x8.add_sat_s", "i16x8.sub_sat_u", "i16x8.min_s",
+        "i16x8.max_u", "i16x8.avgr_u", "i16x8.q15mulr_sat_s", "i16x8.abs", "i16x8.neg", "i16x8.extadd_pairwise_i8x16_s",
+        "i16x8.extadd_pairwise_i8x16_u", "i32x4.add", "i32x4.sub", "i32x4.mul", "i32x4.min_s", "i32x4.min_u",
+        "i32x4.max_s", "i32x4.max_u", "i32x4.dot_i16x8_s", "i32x4.abs", "i32x4.neg", "i32x4.extadd_pairwise_i16x8_s",
+        "i32x4.extadd_pairwise_i16x8_u", "i64x2.add", "i64x2.sub", "i64x2.mul", "i64x2.abs", "i64x2.neg",
+    ]);
+    if (!simd) return;
+
+    expect(simd.lanes(Int8Array, "i8x16.add")).toEqual([
+        3, 1, -1, -9, -56, 0, -128, 127, 0, 0, 0, 14, -126, 126, 17, 1,
+    ]);
+    expect(simd.lanes(Int8Array, "i8x16.sub")).toEqual([
+        -1, -5, 7, 1, 0, 56, 126, -127, 0, 10, -12, 0, -30, 30, -1, -19,
+    ]);
+    expect(simd.lanes(Int8Array, "i8x16.add_sat_s")).toEqual([
+        3, 1, -1, -9, 127, 0, 127, -128, 0, 0, 0, 14, 127, -128, 17, 1,
+    ]);
+    expect(simd.lanes(Uint8Array, "i8x16.add_sat_u")).toEqual([
+        3, 255, 255, 255, 200, 255, 128, 255, 0, 255, 255, 14, 130, 255, 17, 255,
+    ]);
+    expect(simd.lanes(Int8Array, "i8x16.sub_sat_s")).toEqual([
+        -1, -5, 7, 1, 0, -128, 126, -127, 0, 10, -12, 0, -30, 30, -1, -19,
+    ]);
+    expect(simd.lanes(Uint8Array, "i8x16.sub_sat_u")).toEqual([
+        0, 251, 0, 1, 0, 56, 126, 0, 0, 0, 244, 0, 0, 30, 0, 237,
+    ]);
+    expect(simd.lanes(Int8Array, "i8x16.min_s")).toEqual([
+        1, -2, -4, -5, 100, -100, 1, -128, 0, -5, -6, 7, 50, -80, 8, -9,
+    ]);
+    expect(simd.lanes(Uint8Array, "i8x16.min_u")).toEqual([1, 3, 3, 251, 100, 100, 1, 128, 0, 5, 6, 7, 50, 176, 8, 10]);
+    expect(simd.lanes(Int8Array, "i8x16.max_s")).toEqual([2, 3, 3, -4, 100, 100, 127, -1, 0, 5, 6, 7, 80, -50, 9, 10]);
+    expect(simd.lanes(Uint8Array, "i8x16.max_u")).toEqual([
+        2, 254, 252, 252, 100, 156, 127, 255, 0, 251, 250, 7, 80, 206, 9, 247,
+    ]);
+    expect(simd.lanes(Uint8Array, "i8x16.avgr_u")).toEqual([
+        2, 129, 128, 252, 100, 128, 64, 192, 0, 128, 128, 7, 65, 191, 9, 129,
+    ]);
+    expect(simd.lanes(Int8Array, "i8x16.abs")).toEqual([1, 2, 3, 4, 100, 100, 127, -128, 0, 5, 6, 7, 50, 50, 8, 9]);
+    expect(simd.lanes(Int8Array, "i8x16.neg")).toEqual([
+        -1, 2, -3, 4, -100, 100, -127, -128, 0, -5, 6, -7, -50, 50, -8, 9,
+    ]);
+    expect(simd.lanes(Int8Array, "i8x16.popcnt")).toEqual([1, 7, 2, 6, 3, 4, 7, 1, 0, 2, 6, 3, 3, 5, 1, 7]);
+    expect(simd.lanes(Int16Array, "i16x8.add")).toEqual([259, -2049, 200, 32640, 0, 3840, 32386, 273]);
+    expect(simd.lanes(Int16Array, "i16x8.sub")).toEqual([-1281, 7, 14336, -32386, 2560, 244, 7650, -4865]);
+    expect(simd.lanes(Int16Array, "i16x8.mul")).toEqual([-254, 1012, 10000, 383, 0, 1500, -12384, -184]);
+    expect(simd.lanes(Int16Array, "i16x8.add_sat_s")).toEqual([259, -2049, 200, -32768, 0, 3840, -32768, 273]);
+    expect(simd.lanes(Uint16Array, "i16x8.sub_sat_u")).toEqual([64255, 7, 14336, 0, 0, 244, 7650, 60671]);
+    expect(simd.lanes(Int16Array, "i16x8.min_s")).toEqual([-511, -1028, -25500, -32641, -1280, 1798, -20400, -2296]);
+    expect(simd.lanes(Uint16Array, "i16x8.max_u")).toEqual([65025, 64515, 40036, 65281, 64256, 2042, 52786, 63240]);
+    expect(simd.lanes(Uint16Array, "i16x8.avgr_u")).toEqual([32898, 64512, 32868, 49088, 32768, 1920, 48961, 32905]);
+    expect(simd.lanes(Int16Array, "i16x8.q15mulr_sat_s")).toEqual([-12, 32, -20000, 254, -50, 112, 7938, -180]);
+    expect(simd.lanes(Int16Array, "i16x8.abs")).toEqual([511, 1021, 25500, 32641, 1280, 2042, 12750, 2296]);
+    expect(simd.lanes(Int16Array, "i16x8.neg")).toEqual([511, 1021, 25500, 32641, -1280, -2042, 12750, 2296]);
+    expect(simd.lanes(Int16Array, "i16x8.extadd_pairwise_i8x16_s")).toEqual([-1, -1, 0, -1, 5, 1, 0, -1]);
+    expect(simd.lanes(Int16Array, "i16x8.extadd_pairwise_i8x16_u")).toEqual([255, 255, 256, 255, 5, 257, 256, 255]);
+    expect(simd.lanes(Int32Array, "i32x4.add")).toEqual([-134217469, 2139160776, 251723776, 17989250]);
+    expect(simd.lanes(Int32Array, "i32x4.sub")).toEqual([523007, -2122434560, 15927808, -318824990]);
+    expect(simd.lanes(Int32Array, "i32x4.mul")).toEqual([134086402, 1129588496, 1088880640, 1950666656]);
+    expect(simd.lanes(Int32Array, "i32x4.min_s")).toEqual([-67370238, -2139120540, 117897984, -150417870]);
+    expect(simd.lanes(Uint32Array, "i32x4.min_u")).toEqual([4227597058, 2155846756, 117897984, 168407120]);
+    expect(simd.lanes(Int32Array, "i32x4.max_s")).toEqual([-66847231, -16685980, 133825792, 168407120]);
+    expect(simd.lanes(Uint32Array, "i32x4.max_u")).toEqual([4228120065, 4278281316, 133825792, 4144549426]);
+    expect(simd.lanes(Int32Array, "i32x4.dot_i16x8_s")).toEqual([656118, -647026545, 2033116, 254201576]);
+    expect(simd.lanes(Int32Array, "i32x4.abs")).toEqual([66847231, 2139120540, 133825792, 150417870]);
+    expect(simd.lanes(Int32Array, "i32x4.neg")).toEqual([66847231, 2139120540, -133825792, 150417870]);
+    expect(simd.lanes(Int32Array, "i32x4.extadd_pairwise_i16x8_s")).toEqual([-1532, -58141, 3322, -15046]);
+    expect(simd.lanes(Int32Array, "i32x4.extadd_pairwise_i16x8_u")).toEqual([129540, 72931, 3322, 116026]);
+    expect(simd.lanes(BigInt64Array, "i64x2.add")).toEqual([9187625582261698819n, 77263240681291776n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.sub")).toEqual([-9115787023099626753n, -1369342905181599232n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.mul")).toEqual([8366845997845708546n, 7214946722179907584n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.abs")).toEqual([9187452757273739775n, 646039832250153728n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.neg")).toEqual([9187452757273739775n, 646039832250153728n]);
+});
+
+test("compiled lane shifts mask the shift count", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "i8x16.shl", "i8x16.shr_s", "i8x16.shr_u", "i8x16.shr_s_wide", "i16x8.shl", "i16x8.shr_s", "i16x8.shr_u",
+        "i16x8.shr_s_wide", "i32x4.shl", "i32x4.shr_s", "i32x4.shr_u", "i32x4.shr_s_wide", "i64x2.shl", "i64x2.shr_s",
+        "i64x2.shr_u", "i64x2.shr_s_wide",
+    ]);
+    if (!simd) return;
+
+    expect(simd.lanes(Int8Array, "i8x16.shl")).toEqual([
+        8, -16, 24, -32, 32, -32, -8, 0, 0, 40, -48, 56, -112, 112, 64, -72,
+    ]);
+    expect(simd.lanes(Int8Array, "i8x16.shr_s")).toEqual([0, -1, 0, -1, 12, -13, 15, -16, 0, 0, -1, 0, 6, -7, 1, -2]);
+    expect(simd.lanes(Int8Array, "i8x16.shr_u")).toEqual([0, 31, 0, 31, 12, 19, 15, 16, 0, 0, 31, 0, 6, 25, 1, 30]);
+    expect(simd.lanes(Int8Array, "i8x16.shr_s_wide")).toEqual([
+        0, -1, 0, -1, 12, -13, 15, -16, 0, 0, -1, 0, 6, -7, 1, -2,
+    ]);
+    expect(simd.lanes(Int16Array, "i16x8.shl")).toEqual([-16352, -32672, -29568, 4064, -24576, -192, -14784, -7936]);
+    expect(simd.lanes(Int16Array, "i16x8.shr_s")).toEqual([-16, -32, -797, -1021, 40, 63, -399, -72]);
+    expect(simd.lanes(Int16Array, "i16x8.shr_u")).toEqual([2032, 2016, 1251, 1027, 40, 63, 1649, 1976]);
+    expect(simd.lanes(Int16Array, "i16x8.shr_s_wide")).toEqual([-32, -64, -1594, -2041, 80, 127, -797, -144]);
+    expect(simd.lanes(Int32Array, "i32x4.shl")).toEqual([33489024, 1070477824, -50167808, -2073618176]);
+    expect(simd.lanes(Int32Array, "i32x4.shr_s")).toEqual([-522244, -16711880, 1045514, -1175140]);
+    expect(simd.lanes(Int32Array, "i32x4.shr_u")).toEqual([33032188, 16842552, 1045514, 32379292]);
+    expect(simd.lanes(Int32Array, "i32x4.shr_s_wide")).toEqual([-33423616, -1069560270, 66912896, -75208935]);
+    expect(simd.lanes(BigInt64Array, "i64x2.shl")).toEqual([-56072928219102720n, 1268999214693220352n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.shr_s")).toEqual([-17944243666550273n, -1261796547363582n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.shr_u")).toEqual([18084553352413695n, 34767000471600386n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.shr_s_wide")).toEqual([-1148431594659217472n, -80754979031269216n]);
+});
+
+test("compiled bitwise vector operations", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "v128.not", "v128.and", "v128.andnot", "v128.or", "v128.xor", "v128.bitselect",
+    ]);
+    if (!simd) return;
+
+    expect(simd.lanes(Uint8Array, "v128.not")).toEqual([
+        254, 1, 252, 3, 155, 99, 128, 127, 255, 250, 5, 248, 205, 49, 247, 8,
+    ]);
+    expect(simd.lanes(Uint8Array, "v128.and")).toEqual([0, 2, 0, 248, 100, 4, 1, 128, 0, 1, 2, 7, 16, 128, 8, 2]);
+    expect(simd.lanes(Uint8Array, "v128.andnot")).toEqual([1, 252, 3, 4, 0, 152, 126, 0, 0, 4, 248, 0, 34, 78, 0, 245]);
+    expect(simd.lanes(Uint8Array, "v128.or")).toEqual([
+        3, 255, 255, 255, 100, 252, 127, 255, 0, 255, 254, 7, 114, 254, 9, 255,
+    ]);
+    expect(simd.lanes(Uint8Array, "v128.xor")).toEqual([
+        3, 253, 255, 7, 0, 248, 126, 127, 0, 254, 252, 0, 98, 126, 1, 253,
+    ]);
+    expect(simd.lanes(Uint8Array, "v128.bitselect")).toEqual([
+        1, 3, 12, 252, 100, 52, 127, 255, 0, 5, 58, 7, 80, 176, 8, 247,
+    ]);
+});
+
+test("compiled lane comparisons", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "i8x16.eq", "i8x16.ne", "i8x16.lt_s", "i8x16.lt_u", "i8x16.gt_s", "i8x16.gt_u", "i8x16.le_s", "i8x16.le_u",
+        "i8x16.ge_s", "i8x16.ge_u", "i16x8.eq", "i16x8.ne", "i16x8.lt_s", "i16x8.lt_u", "i16x8.gt_s", "i16x8.gt_u",
+        "i16x8.le_s", "i16x8.le_u", "i16x8.ge_s", "i16x8.ge_u", "i32x4.eq", "i32x4.ne", "i32x4.lt_s", "i32x4.lt_u",
+        "i32x4.gt_s", "i32x4.gt_u", "i32x4.le_s", "i32x4.le_u", "i32x4.ge_s", "i32x4.ge_u", "i64x2.eq", "i64x2.ne",
+        "i64x2.lt_s", "i64x2.gt_s", "i64x2.le_s", "i64x2.ge_s", "f32x4.eq", "f32x4.ne", "f32x4.lt", "f32x4.gt",
+        "f32x4.le", "f32x4.ge", "f64x2.eq", "f64x2.ne", "f64x2.lt", "f64x2.gt", "f64x2.le", "f64x2.ge",
+    ]);
+    if (!simd) return;
+
+    expect(simd.lanes(Int8Array, "i8x16.eq")).toEqual([0, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, -1, 0, 0, 0, 0]);
+    expect(simd.lanes(Int8Array, "i8x16.ne")).toEqual([-1, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, 0, -1, -1, -1, -1]);
+    expect(simd.lanes(Int8Array, "i8x16.lt_s")).toEqual([-1, -1, 0, 0, 0, -1, 0, -1, 0, 0, -1, 0, -1, 0, -1, -1]);
+    expect(simd.lanes(Int8Array, "i8x16.lt_u")).toEqual([-1, 0, -1, 0, 0, 0, 0, -1, 0, -1, 0, 0, -1, 0, -1, 0]);
+    expect(simd.lanes(Int8Array, "i8x16.gt_s")).toEqual([0, 0, -1, -1, 0, 0, -1, 0, 0, -1, 0, 0, 0, -1, 0, 0]);
+    expect(simd.lanes(Int8Array, "i8x16.gt_u")).toEqual([0, -1, 0, -1, 0, -1, -1, 0, 0, 0, -1, 0, 0, -1, 0, -1]);
+    expect(simd.lanes(Int8Array, "i8x16.le_s")).toEqual([-1, -1, 0, 0, -1, -1, 0, -1, -1, 0, -1, -1, -1, 0, -1, -1]);
+    expect(simd.lanes(Int8Array, "i8x16.le_u")).toEqual([-1, 0, -1, 0, -1, 0, 0, -1, -1, -1, 0, -1, -1, 0, -1, 0]);
+    expect(simd.lanes(Int8Array, "i8x16.ge_s")).toEqual([0, 0, -1, -1, -1, 0, -1, 0, -1, -1, 0, -1, 0, -1, 0, 0]);
+    expect(simd.lanes(Int8Array, "i8x16.ge_u")).toEqual([0, -1, 0, -1, -1, -1, -1, 0, -1, 0, -1, -1, 0, -1, 0, -1]);
+    expect(simd.lanes(Int16Array, "i16x8.eq")).toEqual([0, 0, 0, 0, 0, 0, 0, 0]);
+    expect(simd.lanes(Int16Array, "i16x8.ne")).toEqual([-1, -1, -1, -1, -1, -1, -1, -1]);
+    expect(simd.lanes(Int16Array, "i16x8.lt_s")).toEqual([-1, 0, -1, -1, 0, 0, 0, -1]);
+    expect(simd.lanes(Int16Array, "i16x8.lt_u")).toEqual([0, 0, 0, -1, -1, 0, 0, 0]);
+    expect(simd.lanes(Int16Array, "i16x8.gt_s")).toEqual([0, -1, 0, 0, -1, -1, -1, 0]);
+    expect(simd.lanes(Int16Array, "i16x8.gt_u")).toEqual([-1, -1, -1, 0, 0, -1, -1, -1]);
+    expect(simd.lanes(Int16Array, "i16x8.le_s")).toEqual([-1, 0, -1, -1, 0, 0, 0, -1]);
+    expect(simd.lanes(Int16Array, "i16x8.le_u")).toEqual([0, 0, 0, -1, -1, 0, 0, 0]);
+    expect(simd.lanes(Int16Array, "i16x8.ge_s")).toEqual([0, -1, 0, 0, -1, -1, -1, 0]);
+    expect(simd.lanes(Int16Array, "i16x8.ge_u")).toEqual([-1, -1, -1, 0, 0, -1, -1, -1]);
+    expect(simd.lanes(Int32Array, "i32x4.eq")).toEqual([0, 0, 0, 0]);
+    expect(simd.lanes(Int32Array, "i32x4.ne")).toEqual([-1, -1, -1, -1]);
+    expect(simd.lanes(Int32Array, "i32x4.lt_s")).toEqual([0, -1, 0, -1]);
+    expect(simd.lanes(Int32Array, "i32x4.lt_u")).toEqual([0, -1, 0, 0]);
+    expect(simd.lanes(Int32Array, "i32x4.gt_s")).toEqual([-1, 0, -1, 0]);
+    expect(simd.lanes(Int32Array, "i32x4.gt_u")).toEqual([-1, 0, -1, -1]);
+    expect(simd.lanes(Int32Array, "i32x4.le_s")).toEqual([0, -1, 0, -1]);
+    expect(simd.lanes(Int32Array, "i32x4.le_u")).toEqual([0, -1, 0, 0]);
+    expect(simd.lanes(Int32Array, "i32x4.ge_s")).toEqual([-1, 0, -1, 0]);
+    expect(simd.lanes(Int32Array, "i32x4.ge_u")).toEqual([-1, 0, -1, -1]);
+    expect(simd.lanes(BigInt64Array, "i64x2.eq")).toEqual([0n, 0n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.ne")).toEqual([-1n, -1n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.lt_s")).toEqual([-1n, -1n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.gt_s")).toEqual([0n, 0n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.le_s")).toEqual([-1n, -1n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.ge_s")).toEqual([0n, 0n]);
+    expect(simd.lanes(Int32Array, "f32x4.eq")).toEqual([0, 0, 0, 0]);
+    expect(simd.lanes(Int32Array, "f32x4.ne")).toEqual([-1, -1, -1, -1]);
+    expect(simd.lanes(Int32Array, "f32x4.lt")).toEqual([0, -1, 0, 0]);
+    expect(simd.lanes(Int32Array, "f32x4.gt")).toEqual([-1, 0, -1, -1]);
+    expect(simd.lanes(Int32Array, "f32x4.le")).toEqual([0, -1, 0, 0]);
+    expect(simd.lanes(Int32Array, "f32x4.ge")).toEqual([-1, 0, -1, -1]);
+    expect(simd.lanes(BigInt64Array, "f64x2.eq")).toEqual([0n, 0n]);
+    expect(simd.lanes(BigInt64Array, "f64x2.ne")).toEqual([-1n, -1n]);
+    expect(simd.lanes(BigInt64Array, "f64x2.lt")).toEqual([0n, -1n]);
+    expect(simd.lanes(BigInt64Array, "f64x2.gt")).toEqual([-1n, 0n]);
+    expect(simd.lanes(BigInt64Array, "f64x2.le")).toEqual([0n, -1n]);
+    expect(simd.lanes(BigInt64Array, "f64x2.ge")).toEqual([-1n, 0n]);
+});
+
+test("compiled vector reductions to a scalar", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "v128.any_true", "v128.any_true_zero", "i8x16.all_true", "i8x16.all_true_b", "i8x16.bitmask", "i16x8.all_true",
+        "i16x8.all_true_b", "i16x8.bitmask", "i32x4.all_true", "i32x4.all_true_b", "i32x4.bitmask", "i64x2.all_true",
+        "i64x2.all_true_b", "i64x2.bitmask",
+    ]);
+    if (!simd) return;
+
+    expect(simd.invoke("v128.any_true")).toBe(1);
+    expect(simd.invoke("v128.any_true_zero")).toBe(0);
+    expect(simd.invoke("i8x16.all_true")).toBe(0);
+    expect(simd.invoke("i8x16.all_true_b")).toBe(0);
+    expect(simd.invoke("i8x16.bitmask")).toBe(42154);
+    expect(simd.invoke("i16x8.all_true")).toBe(1);
+    expect(simd.invoke("i16x8.all_true_b")).toBe(1);
+    expect(simd.invoke("i16x8.bitmask")).toBe(207);
+    expect(simd.invoke("i32x4.all_true")).toBe(1);
+    expect(simd.invoke("i32x4.all_true_b")).toBe(1);
+    expect(simd.invoke("i32x4.bitmask")).toBe(11);
+    expect(simd.invoke("i64x2.all_true")).toBe(1);
+    expect(simd.invoke("i64x2.all_true_b")).toBe(1);
+    expect(simd.invoke("i64x2.bitmask")).toBe(3);
+});
+
+test("compiled float lane arithmetic", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "f32x4.add", "f32x4.sub", "f32x4.mul", "f32x4.div", "f32x4.min", "f32x4.max", "f32x4.pmin", "f32x4.pmax",
+        "f32x4.abs", "f32x4.neg", "f32x4.sqrt", "f32x4.ceil", "f32x4.floor", "f32x4.trunc", "f32x4.nearest",
+        "f64x2.add", "f64x2.sub", "f64x2.mul", "f64x2.div", "f64x2.min", "f64x2.max", "f64x2.pmin", "f64x2.pmax",
+        "f64x2.abs", "f64x2.neg", "f64x2.sqrt", "f64x2.ceil", "f64x2.floor", "f64x2.trunc", "f64x2.nearest",
+    ]);
+    if (!simd) return;
+
+    expect(simd.lanes(Float32Array, "f32x4.add")).toEqual([2, 0.75, 3, -1.25]);
+    expect(simd.lanes(Float32Array, "f32x4.sub")).toEqual([1, -5.25, 5, 0.25]);
+    expect(simd.lanes(Float32Array, "f32x4.mul")).toEqual([0.75, -6.75, -4, 0.375]);
+    expect(simd.lanes(Float32Array, "f32x4.div")).toEqual([3, -0.75, -4, 0.6666666865348816]);
+    expect(simd.lanes(Float32Array, "f32x4.min")).toEqual([0.5, -2.25, -1, -0.75]);
+    expect(simd.lanes(Float32Array, "f32x4.max")).toEqual([1.5, 3, 4, -0.5]);
+    expect(simd.lanes(Float32Array, "f32x4.pmin")).toEqual([0.5, -2.25, -1, -0.75]);
+    expect(simd.lanes(Float32Array, "f32x4.pmax")).toEqual([1.5, 3, 4, -0.5]);
+    expect(simd.lanes(Float32Array, "f32x4.abs")).toEqual([1.5, 2.25, 4, 0.5]);
+    expect(simd.lanes(Float32Array, "f32x4.neg")).toEqual([-1.5, 2.25, -4, 0.5]);
+    expect(simd.lanes(Float32Array, "f32x4.sqrt")).toEqual([2, 1.5, 0.5, 100]);
+    expect(simd.lanes(Float32Array, "f32x4.ceil")).toEqual([2, -2, 3, -0]);
+    expect(simd.lanes(Float32Array, "f32x4.floor")).toEqual([1, -3, 2, -1]);
+    expect(simd.lanes(Float32Array, "f32x4.trunc")).toEqual([1, -2, 2, -0]);
+    expect(simd.lanes(Float32Array, "f32x4.nearest")).toEqual([2, -2, 2, -0]);
+    expect(simd.lanes(Float64Array, "f64x2.add")).toEqual([1.25, 5.5]);
+    expect(simd.lanes(Float64Array, "f64x2.sub")).toEqual([3.75, -12.5]);
+    expect(simd.lanes(Float64Array, "f64x2.mul")).toEqual([-3.125, -31.5]);
+    expect(simd.lanes(Float64Array, "f64x2.div")).toEqual([-2, -0.3888888888888889]);
+    expect(simd.lanes(Float64Array, "f64x2.min")).toEqual([-1.25, -3.5]);
+    expect(simd.lanes(Float64Array, "f64x2.max")).toEqual([2.5, 9]);
+    expect(simd.lanes(Float64Array, "f64x2.pmin")).toEqual([-1.25, -3.5]);
+    expect(simd.lanes(Float64Array, "f64x2.pmax")).toEqual([2.5, 9]);
+    expect(simd.lanes(Float64Array, "f64x2.abs")).toEqual([2.5, 3.5]);
+    expect(simd.lanes(Float64Array, "f64x2.neg")).toEqual([-2.5, 3.5]);
+    expect(simd.lanes(Float64Array, "f64x2.sqrt")).toEqual([2.5, 0.25]);
+    expect(simd.lanes(Float64Array, "f64x2.ceil")).toEqual([-1, 3]);
+    expect(simd.lanes(Float64Array, "f64x2.floor")).toEqual([-2, 2]);
+    expect(simd.lanes(Float64Array, "f64x2.trunc")).toEqual([-1, 2]);
+    expect(simd.lanes(Float64Array, "f64x2.nearest")).toEqual([-2, 3]);
+});
+
+test("compiled conversions between integer and float lanes", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "i32x4.trunc_sat_f32x4_s", "i32x4.trunc_sat_f32x4_u", "f32x4.convert_i32x4_s", "f32x4.convert_i32x4_u",
+        "i32x4.trunc_sat_f64x2_s_zero", "i32x4.trunc_sat_f64x2_u_zero", "f64x2.convert_low_i32x4_s",
+        "f64x2.convert_low_i32x4_u", "f32x4.demote_f64x2_zero", "f64x2.promote_low_f32x4",
+    ]);
+    if (!simd) return;
+
+    expect(simd.lanes(Int32Array, "i32x4.trunc_sat_f32x4_s")).toEqual([-1, 2147483647, -2147483648, 7]);
+    expect(simd.lanes(Uint32Array, "i32x4.trunc_sat_f32x4_u")).toEqual([0, 3000000000, 0, 7]);
+    expect(simd.lanes(Float32Array, "f32x4.convert_i32x4_s")).toEqual([-66847232, -2139120512, 133825792, -150417872]);
+    expect(simd.lanes(Float32Array, "f32x4.convert_i32x4_u")).toEqual([4228120064, 2155846656, 133825792, 4144549376]);
+    expect(simd.lanes(Int32Array, "i32x4.trunc_sat_f64x2_s_zero")).toEqual([-1, 9, 0, 0]);
+    expect(simd.lanes(Uint32Array, "i32x4.trunc_sat_f64x2_u_zero")).toEqual([0, 9, 0, 0]);
+    expect(simd.lanes(Float64Array, "f64x2.convert_low_i32x4_s")).toEqual([-66847231, -2139120540]);
+    expect(simd.lanes(Float64Array, "f64x2.convert_low_i32x4_u")).toEqual([4228120065, 2155846756]);
+    expect(simd.lanes(Float32Array, "f32x4.demote_f64x2_zero")).toEqual([2.5, -3.5, 0, 0]);
+    expect(simd.lanes(Float64Array, "f64x2.promote_low_f32x4")).toEqual([1.5, -2.25]);
+});
+
+test("compiled widening and narrowing lane operations", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "i16x8.extend_low_i8x16_s", "i16x8.extend_low_i8x16_u", "i16x8.extend_high_i8x16_s",
+        "i16x8.extend_high_i8x16_u", "i16x8.extmul_low_i8x16_s", "i16x8.extmul_low_i8x16_u",
+        "i16x8.extmul_high_i8x16_s", "i16x8.extmul_high_i8x16_u", "i32x4.extend_low_i16x8_s",
+        "i32x4.extend_low_i16x8_u", "i32x4.extend_high_i16x8_s", "i32x4.extend_high_i16x8_u",
+        "i32x4.extmul_low_i16x8_s", "i32x4.extmul_low_i16x8_u", "i32x4.extmul_high_i16x8_s",
+        "i32x4.extmul_high_i16x8_u", "i64x2.extend_low_i32x4_s", "i64x2.extend_low_i32x4_u",
+        "i64x2.extend_high_i32x4_s", "i64x2.extend_high_i32x4_u", "i64x2.extmul_low_i32x4_s",
+        "i64x2.extmul_low_i32x4_u", "i64x2.extmul_high_i32x4_s", "i64x2.extmul_high_i32x4_u", "i8x16.narrow_i16x8_s",
+        "i8x16.narrow_i16x8_u", "i16x8.narrow_i32x4_s", "i16x8.narrow_i32x4_u",
+    ]);
+    if (!simd) return;
+
+    expect(simd.lanes(Int16Array, "i16x8.extend_low_i8x16_s")).toEqual([1, -2, 3, -4, 100, -100, 127, -128]);
+    expect(simd.lanes(Int16Array, "i16x8.extend_low_i8x16_u")).toEqual([1, 254, 3, 252, 100, 156, 127, 128]);
+    expect(simd.lanes(Int16Array, "i16x8.extend_high_i8x16_s")).toEqual([0, 5, -6, 7, 50, -50, 8, -9]);
+    expect(simd.lanes(Int16Array, "i16x8.extend_high_i8x16_u")).toEqual([0, 5, 250, 7, 50, 206, 8, 247]);
+    expect(simd.lanes(Int16Array, "i16x8.extmul_low_i8x16_s")).toEqual([2, -6, -12, 20, 10000, -10000, 127, 128]);
+    expect(simd.lanes(Int16Array, "i16x8.extmul_low_i8x16_u")).toEqual([2, 762, 756, -2284, 10000, 15600, 127, 32640]);
+    expect(simd.lanes(Int16Array, "i16x8.extmul_high_i8x16_s")).toEqual([0, -25, -36, 49, 4000, 4000, 72, -90]);
+    expect(simd.lanes(Int16Array, "i16x8.extmul_high_i8x16_u")).toEqual([0, 1255, 1500, 49, 4000, -29280, 72, 2470]);
+    expect(simd.lanes(Int32Array, "i32x4.extend_low_i16x8_s")).toEqual([-511, -1021, -25500, -32641]);
+    expect(simd.lanes(Int32Array, "i32x4.extend_low_i16x8_u")).toEqual([65025, 64515, 40036, 32895]);
+    expect(simd.lanes(Int32Array, "i32x4.extend_high_i16x8_s")).toEqual([1280, 2042, -12750, -2296]);
+    expect(simd.lanes(Int32Array, "i32x4.extend_high_i16x8_u")).toEqual([1280, 2042, 52786, 63240]);
+    expect(simd.lanes(Int32Array, "i32x4.extmul_low_i16x8_s")).toEqual([-393470, 1049588, -655350000, 8323455]);
+    expect(simd.lanes(Int32Array, "i32x4.extmul_low_i16x8_u")).toEqual([50069250, -133233676, 1028925200, 2147418495]);
+    expect(simd.lanes(Int32Array, "i32x4.extmul_high_i16x8_s")).toEqual([-1638400, 3671516, 260100000, -5898424]);
+    expect(simd.lanes(Int32Array, "i32x4.extmul_high_i16x8_u")).toEqual([82247680, 3671516, -1912418400, 162463560]);
+    expect(simd.lanes(BigInt64Array, "i64x2.extend_low_i32x4_s")).toEqual([-66847231n, -2139120540n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.extend_low_i32x4_u")).toEqual([4228120065n, 2155846756n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.extend_high_i32x4_s")).toEqual([133825792n, -150417870n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.extend_high_i32x4_u")).toEqual([133825792n, 4144549426n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.extmul_low_i32x4_s")).toEqual([4503513862110978n, 35693322548029200n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.extmul_low_i32x4_u")).toEqual([-571956126044782846n, 9223318896354010896n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.extmul_high_i32x4_s")).toEqual([15777791084003328n, -25331440283234400n]);
+    expect(simd.lanes(BigInt64Array, "i64x2.extmul_high_i32x4_u")).toEqual([15777791084003328n, 697971632530313120n]);
+    expect(simd.lanes(Int8Array, "i8x16.narrow_i16x8_s")).toEqual([
+        -128, -128, -128, -128, 127, 127, -128, -128, 127, -128, 127, -128, -128, 127, -128, 127,
+    ]);
+    expect(simd.lanes(Uint8Array, "i8x16.narrow_i16x8_u")).toEqual([
+        0, 0, 0, 0, 255, 255, 0, 0, 255, 0, 255, 0, 0, 255, 0, 255,
+    ]);
+    expect(simd.lanes(Int16Array, "i16x8.narrow_i32x4_s")).toEqual([
+        -32768, -32768, 32767, -32768, -32768, -32768, 32767, 32767,
+    ]);
+    expect(simd.lanes(Uint16Array, "i16x8.narrow_i32x4_u")).toEqual([0, 0, 65535, 0, 0, 0, 65535, 65535]);
+});
+
+test("compiled constants, shuffles, splats and lane accesses", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "v128.const", "i8x16.shuffle", "i8x16.swizzle", "i8x16.splat", "i16x8.splat", "i32x4.splat", "i64x2.splat",
+        "f32x4.splat", "f64x2.splat", "i8x16.extract_lane_s", "i8x16.extract_lane_u", "i16x8.extract_lane_s",
+        "i16x8.extract_lane_u", "i32x4.extract_lane", "i64x2.extract_lane", "f32x4.extract_lane", "f64x2.extract_lane",
+    ]);
+    if (!simd) return;
+
+    expect(simd.lanes(Uint8Array, "v128.const")).toEqual([0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15]);
+    expect(simd.lanes(Int8Array, "i8x16.shuffle")).toEqual([
+        1, 3, 3, -5, 100, 100, 127, -1, 10, 9, -80, 80, -9, 8, -50, 50,
+    ]);
+    expect(simd.lanes(Int8Array, "i8x16.swizzle")).toEqual([
+        -9, 8, -50, 50, -4, 3, -2, 1, 0, 0, 100, -100, 127, -128, 0, 0,
+    ]);
+    expect(simd.lanes(Int8Array, "i8x16.splat", 0x17f)).toEqual([
+        127, 127, 127, -128, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+    ]);
+    expect(simd.lanes(Int16Array, "i16x8.splat", -3)).toEqual([-3, -3, -3, -3, -3, -3, -3, 4660]);
+    expect(simd.lanes(Int32Array, "i32x4.splat", 0x12345678)).toEqual([305419896, -7, 305419896, 305419896]);
+    expect(simd.lanes(BigInt64Array, "i64x2.splat", 0x123456789abcdef0n)).toEqual([
+        -1099511627776n, 1311768467463790320n,
+    ]);
+    expect(simd.lanes(Float32Array, "f32x4.splat")).toEqual([1.5, 1.5, -8, 1.5]);
+    expect(simd.lanes(Float64Array, "f64x2.splat")).toEqual([-2.5, 0.125]);
+    expect(simd.invoke("i8x16.extract_lane_s")).toBe(-128);
+    expect(simd.invoke("i8x16.extract_lane_u")).toBe(128);
+    expect(simd.invoke("i16x8.extract_lane_s")).toBe(-32641);
+    expect(simd.invoke("i16x8.extract_lane_u")).toBe(32895);
+    expect(simd.invoke("i32x4.extract_lane")).toBe(133825792);
+    expect(simd.invoke("i64x2.extract_lane")).toBe(-646039832250153728n);
+    expect(simd.lanes(Float32Array, "f32x4.extract_lane")).toEqual([-2.25, 0, 0, 0]);
+    expect(simd.lanes(Float64Array, "f64x2.extract_lane")).toEqual([-3.5, 0]);
+});
+
+test("compiled vector loads and stores on the default memory", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "v128.load8x8_s", "v128.load8x8_u", "v128.load16x4_s", "v128.load16x4_u", "v128.load32x2_s", "v128.load32x2_u",
+        "v128.load8_splat", "v128.load16_splat", "v128.load32_splat", "v128.load64_splat", "v128.load32_zero",
+        "v128.load64_zero", "v128.load_offset", "v128.load8_lane", "v128.load16_lane", "v128.load32_lane",
+        "v128.load64_lane", "v128.store8_lane", "v128.store16_lane", "v128.store32_lane", "v128.store64_lane",
+        "v128.load_at", "v128.store_at",
+    ]);
+    if (!simd) return;
+
+    expect(simd.lanes(Int16Array, "v128.load8x8_s")).toEqual([100, -100, 127, -128, 0, 5, -6, 7]);
+    expect(simd.lanes(Int16Array, "v128.load8x8_u")).toEqual([100, 156, 127, 128, 0, 5, 250, 7]);
+    expect(simd.lanes(Int32Array, "v128.load16x4_s")).toEqual([-25500, -32641, 1280, 2042]);
+    expect(simd.lanes(Int32Array, "v128.load16x4_u")).toEqual([40036, 32895, 1280, 2042]);
+    expect(simd.lanes(BigInt64Array, "v128.load32x2_s")).toEqual([-2139120540n, 133825792n]);
+    expect(simd.lanes(BigInt64Array, "v128.load32x2_u")).toEqual([2155846756n, 133825792n]);
+    expect(simd.lanes(Int8Array, "v128.load8_splat")).toEqual([
+        127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+    ]);
+    expect(simd.lanes(Int16Array, "v128.load16_splat")).toEqual([
+        -32641, -32641, -32641, -32641, -32641, -32641, -32641, -32641,
+    ]);
+    expect(simd.lanes(Int32Array, "v128.load32_splat")).toEqual([83918975, 83918975, 83918975, 83918975]);
+    expect(simd.lanes(BigInt64Array, "v128.load64_splat")).toEqual([-3588797182653726593n, -3588797182653726593n]);
+    expect(simd.lanes(Int32Array, "v128.load32_zero")).toEqual([-2139120540, 0, 0, 0]);
+    expect(simd.lanes(BigInt64Array, "v128.load64_zero")).toEqual([-646039832250153728n, 0n]);
+    expect(simd.lanes(Int8Array, "v128.load_offset")).toEqual([
+        2, 3, -4, -5, 100, 100, 1, -1, 0, -5, 6, 7, 80, -80, 9, 10,
+    ]);
+    expect(simd.lanes(Int8Array, "v128.load8_lane")).toEqual([
+        1, -2, 3, -4, 100, 2, 127, -128, 0, 5, -6, 7, 50, -50, 8, -9,
+    ]);
+    expect(simd.lanes(Int16Array, "v128.load16_lane")).toEqual([-511, -1021, -25500, 770, 1280, 2042, -12750, -2296]);
+    expect(simd.lanes(Int32Array, "v128.load32_lane")).toEqual([-66847231, -2139120540, -67370238, -150417870]);
+    expect(simd.lanes(BigInt64Array, "v128.load64_lane")).toEqual([-9187452757273739775n, -71665734174113022n]);
+    expect(simd.lanes(Int8Array, "v128.store8_lane")).toEqual([127, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0]);
+    expect(simd.lanes(Int16Array, "v128.store16_lane")).toEqual([2042, 0, 0, 0, 0, 0, 0, 0]);
+    expect(simd.lanes(Int32Array, "v128.store32_lane")).toEqual([-150417870, 0, 0, 0]);
+    expect(simd.lanes(BigInt64Array, "v128.store64_lane")).toEqual([-646039832250153728n, 0n]);
+
+    expect(simd.invoke("v128.load_at", 65520)).toBe(0);
+    expect(() => simd.invoke("v128.load_at", 65521)).toThrowWithMessage(
+        TypeError,
+        "Execution trapped: Memory access out of bounds"
+    );
+    expect(() => simd.invoke("v128.store_at", 65521)).toThrowWithMessage(
+        TypeError,
+        "Execution trapped: Memory access out of bounds"
+    );
+});
+
+test("compiled vector locals live across a loop", () => {
+    // prettier-ignore
+    const simd = compiledExports([
+        "v128.local_loop",
+    ]);
+    if (!simd) return;
+
+    expect(simd.lanes(Int32Array, "v128.local_loop")).toEqual([-267388924, 33452432, 535303168, -601671480]);
+});
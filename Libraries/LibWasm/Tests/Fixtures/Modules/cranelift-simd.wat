@@ -0,0 +1,1700 @@
+(module
+  ;; Functions that produce a vector store it at address 0, where load_i32 reads it back one word at a time.
+  (memory 1)
+
+  ;; i8x16 input a: 1 -2 3 -4 100 -100 127 -128 0 5 -6 7 50 -50 8 -9
+  (data (i32.const 16) "\01\fe\03\fc\64\9c\7f\80\00\05\fa\07\32\ce\08\f7")
+  ;; i8x16 input b: 2 3 -4 -5 100 100 1 -1 0 -5 6 7 80 -80 9 10
+  (data (i32.const 32) "\02\03\fc\fb\64\64\01\ff\00\fb\06\07\50\b0\09\0a")
+  ;; f32x4 input a: 1.5 -2.25 4 -0.5
+  (data (i32.const 48) "\00\00\c0\3f\00\00\10\c0\00\00\80\40\00\00\00\bf")
+  ;; f32x4 input b: 0.5 3 -1 -0.75
+  (data (i32.const 64) "\00\00\00\3f\00\00\40\40\00\00\80\bf\00\00\40\bf")
+  ;; f64x2 input a: 2.5 -3.5
+  (data (i32.const 80) "\00\00\00\00\00\00\04\40\00\00\00\00\00\00\0c\c0")
+  ;; f64x2 input b: -1.25 9
+  (data (i32.const 96) "\00\00\00\00\00\00\f4\bf\00\00\00\00\00\00\22\40")
+  ;; i8x16.swizzle indices: 15 14 13 12 3 2 1 0 16 255 4 5 6 7 8 128
+  (data (i32.const 112) "\0f\0e\0d\0c\03\02\01\00\10\ff\04\05\06\07\08\80")
+  ;; v128.bitselect mask: 255 0 240 15 170 85 255 0 0 255 60 195 1 128 255 255
+  (data (i32.const 128) "\ff\00\f0\0f\aa\55\ff\00\00\ff\3c\c3\01\80\ff\ff")
+  ;; f32x4 sqrt input: 4 2.25 0.25 10000
+  (data (i32.const 144) "\00\00\80\40\00\00\10\40\00\00\80\3e\00\40\1c\46")
+  ;; f64x2 sqrt input: 6.25 0.0625
+  (data (i32.const 160) "\00\00\00\00\00\00\19\40\00\00\00\00\00\00\b0\3f")
+  ;; f32x4 rounding input: 1.5 -2.5 2.5 -0.4
+  (data (i32.const 176) "\00\00\c0\3f\00\00\20\c0\00\00\20\40\cd\cc\cc\be")
+  ;; f64x2 rounding input: -1.5 2.7
+  (data (i32.const 192) "\00\00\00\00\00\00\f8\bf\9a\99\99\99\99\99\05\40")
+  ;; f32x4 truncation input: -1.5 3000000000.0 -3000000000.0 7.9
+  (data (i32.const 208) "\00\00\c0\bf\5e\d0\32\4f\5e\d0\32\cf\cd\cc\fc\40")
+
+  (func (export "i8x16.add")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.add
+    v128.store)
+  (func (export "i8x16.sub")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.sub
+    v128.store)
+  (func (export "i8x16.add_sat_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.add_sat_s
+    v128.store)
+  (func (export "i8x16.add_sat_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.add_sat_u
+    v128.store)
+  (func (export "i8x16.sub_sat_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.sub_sat_s
+    v128.store)
+  (func (export "i8x16.sub_sat_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.sub_sat_u
+    v128.store)
+  (func (export "i8x16.min_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.min_s
+    v128.store)
+  (func (export "i8x16.min_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.min_u
+    v128.store)
+  (func (export "i8x16.max_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.max_s
+    v128.store)
+  (func (export "i8x16.max_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.max_u
+    v128.store)
+  (func (export "i8x16.avgr_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.avgr_u
+    v128.store)
+  (func (export "i8x16.abs")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i8x16.abs
+    v128.store)
+  (func (export "i8x16.neg")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i8x16.neg
+    v128.store)
+  (func (export "i8x16.popcnt")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i8x16.popcnt
+    v128.store)
+  (func (export "i16x8.add")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.add
+    v128.store)
+  (func (export "i16x8.sub")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.sub
+    v128.store)
+  (func (export "i16x8.mul")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.mul
+    v128.store)
+  (func (export "i16x8.add_sat_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.add_sat_s
+    v128.store)
+  (func (export "i16x8.sub_sat_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.sub_sat_u
+    v128.store)
+  (func (export "i16x8.min_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.min_s
+    v128.store)
+  (func (export "i16x8.max_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.max_u
+    v128.store)
+  (func (export "i16x8.avgr_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.avgr_u
+    v128.store)
+  (func (export "i16x8.q15mulr_sat_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.q15mulr_sat_s
+    v128.store)
+  (func (export "i16x8.abs")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i16x8.abs
+    v128.store)
+  (func (export "i16x8.neg")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i16x8.neg
+    v128.store)
+  (func (export "i16x8.extadd_pairwise_i8x16_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i16x8.extadd_pairwise_i8x16_s
+    v128.store)
+  (func (export "i16x8.extadd_pairwise_i8x16_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i16x8.extadd_pairwise_i8x16_u
+    v128.store)
+  (func (export "i32x4.add")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.add
+    v128.store)
+  (func (export "i32x4.sub")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.sub
+    v128.store)
+  (func (export "i32x4.mul")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.mul
+    v128.store)
+  (func (export "i32x4.min_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.min_s
+    v128.store)
+  (func (export "i32x4.min_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.min_u
+    v128.store)
+  (func (export "i32x4.max_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.max_s
+    v128.store)
+  (func (export "i32x4.max_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.max_u
+    v128.store)
+  (func (export "i32x4.dot_i16x8_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.dot_i16x8_s
+    v128.store)
+  (func (export "i32x4.abs")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32x4.abs
+    v128.store)
+  (func (export "i32x4.neg")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32x4.neg
+    v128.store)
+  (func (export "i32x4.extadd_pairwise_i16x8_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32x4.extadd_pairwise_i16x8_s
+    v128.store)
+  (func (export "i32x4.extadd_pairwise_i16x8_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32x4.extadd_pairwise_i16x8_u
+    v128.store)
+  (func (export "i64x2.add")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.add
+    v128.store)
+  (func (export "i64x2.sub")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.sub
+    v128.store)
+  (func (export "i64x2.mul")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.mul
+    v128.store)
+  (func (export "i64x2.abs")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i64x2.abs
+    v128.store)
+  (func (export "i64x2.neg")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i64x2.neg
+    v128.store)
+
+  (func (export "i8x16.shl")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 3
+    i8x16.shl
+    v128.store)
+  (func (export "i8x16.shr_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 3
+    i8x16.shr_s
+    v128.store)
+  (func (export "i8x16.shr_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 3
+    i8x16.shr_u
+    v128.store)
+  (func (export "i8x16.shr_s_wide")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 11
+    i8x16.shr_s
+    v128.store)
+  (func (export "i16x8.shl")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 5
+    i16x8.shl
+    v128.store)
+  (func (export "i16x8.shr_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 5
+    i16x8.shr_s
+    v128.store)
+  (func (export "i16x8.shr_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 5
+    i16x8.shr_u
+    v128.store)
+  (func (export "i16x8.shr_s_wide")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 20
+    i16x8.shr_s
+    v128.store)
+  (func (export "i32x4.shl")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 7
+    i32x4.shl
+    v128.store)
+  (func (export "i32x4.shr_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 7
+    i32x4.shr_s
+    v128.store)
+  (func (export "i32x4.shr_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 7
+    i32x4.shr_u
+    v128.store)
+  (func (export "i32x4.shr_s_wide")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 33
+    i32x4.shr_s
+    v128.store)
+  (func (export "i64x2.shl")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 9
+    i64x2.shl
+    v128.store)
+  (func (export "i64x2.shr_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 9
+    i64x2.shr_s
+    v128.store)
+  (func (export "i64x2.shr_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 9
+    i64x2.shr_u
+    v128.store)
+  (func (export "i64x2.shr_s_wide")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 67
+    i64x2.shr_s
+    v128.store)
+
+  (func (export "v128.not")
+    i32.const 0
+    i32.const 16
+    v128.load
+    v128.not
+    v128.store)
+  (func (export "v128.and")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    v128.and
+    v128.store)
+  (func (export "v128.andnot")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    v128.andnot
+    v128.store)
+  (func (export "v128.or")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    v128.or
+    v128.store)
+  (func (export "v128.xor")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    v128.xor
+    v128.store)
+  (func (export "v128.bitselect")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32.const 128
+    v128.load
+    v128.bitselect
+    v128.store)
+
+  (func (export "i8x16.eq")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.eq
+    v128.store)
+  (func (export "i8x16.ne")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.ne
+    v128.store)
+  (func (export "i8x16.lt_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.lt_s
+    v128.store)
+  (func (export "i8x16.lt_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.lt_u
+    v128.store)
+  (func (export "i8x16.gt_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.gt_s
+    v128.store)
+  (func (export "i8x16.gt_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.gt_u
+    v128.store)
+  (func (export "i8x16.le_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.le_s
+    v128.store)
+  (func (export "i8x16.le_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.le_u
+    v128.store)
+  (func (export "i8x16.ge_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.ge_s
+    v128.store)
+  (func (export "i8x16.ge_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.ge_u
+    v128.store)
+  (func (export "i16x8.eq")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.eq
+    v128.store)
+  (func (export "i16x8.ne")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.ne
+    v128.store)
+  (func (export "i16x8.lt_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.lt_s
+    v128.store)
+  (func (export "i16x8.lt_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.lt_u
+    v128.store)
+  (func (export "i16x8.gt_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.gt_s
+    v128.store)
+  (func (export "i16x8.gt_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.gt_u
+    v128.store)
+  (func (export "i16x8.le_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.le_s
+    v128.store)
+  (func (export "i16x8.le_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.le_u
+    v128.store)
+  (func (export "i16x8.ge_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.ge_s
+    v128.store)
+  (func (export "i16x8.ge_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.ge_u
+    v128.store)
+  (func (export "i32x4.eq")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.eq
+    v128.store)
+  (func (export "i32x4.ne")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.ne
+    v128.store)
+  (func (export "i32x4.lt_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.lt_s
+    v128.store)
+  (func (export "i32x4.lt_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.lt_u
+    v128.store)
+  (func (export "i32x4.gt_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.gt_s
+    v128.store)
+  (func (export "i32x4.gt_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.gt_u
+    v128.store)
+  (func (export "i32x4.le_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.le_s
+    v128.store)
+  (func (export "i32x4.le_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.le_u
+    v128.store)
+  (func (export "i32x4.ge_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.ge_s
+    v128.store)
+  (func (export "i32x4.ge_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.ge_u
+    v128.store)
+  (func (export "i64x2.eq")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.eq
+    v128.store)
+  (func (export "i64x2.ne")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.ne
+    v128.store)
+  (func (export "i64x2.lt_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.lt_s
+    v128.store)
+  (func (export "i64x2.gt_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.gt_s
+    v128.store)
+  (func (export "i64x2.le_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.le_s
+    v128.store)
+  (func (export "i64x2.ge_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.ge_s
+    v128.store)
+  (func (export "f32x4.eq")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.eq
+    v128.store)
+  (func (export "f32x4.ne")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.ne
+    v128.store)
+  (func (export "f32x4.lt")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.lt
+    v128.store)
+  (func (export "f32x4.gt")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.gt
+    v128.store)
+  (func (export "f32x4.le")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.le
+    v128.store)
+  (func (export "f32x4.ge")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.ge
+    v128.store)
+  (func (export "f64x2.eq")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.eq
+    v128.store)
+  (func (export "f64x2.ne")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.ne
+    v128.store)
+  (func (export "f64x2.lt")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.lt
+    v128.store)
+  (func (export "f64x2.gt")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.gt
+    v128.store)
+  (func (export "f64x2.le")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.le
+    v128.store)
+  (func (export "f64x2.ge")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.ge
+    v128.store)
+
+  (func (export "v128.any_true") (result i32)
+    i32.const 16
+    v128.load
+    v128.any_true)
+  (func (export "v128.any_true_zero") (result i32)
+    i32.const 1024
+    v128.load
+    v128.any_true)
+  (func (export "i8x16.all_true") (result i32)
+    i32.const 16
+    v128.load
+    i8x16.all_true)
+  (func (export "i8x16.all_true_b") (result i32)
+    i32.const 32
+    v128.load
+    i8x16.all_true)
+  (func (export "i8x16.bitmask") (result i32)
+    i32.const 16
+    v128.load
+    i8x16.bitmask)
+  (func (export "i16x8.all_true") (result i32)
+    i32.const 16
+    v128.load
+    i16x8.all_true)
+  (func (export "i16x8.all_true_b") (result i32)
+    i32.const 32
+    v128.load
+    i16x8.all_true)
+  (func (export "i16x8.bitmask") (result i32)
+    i32.const 16
+    v128.load
+    i16x8.bitmask)
+  (func (export "i32x4.all_true") (result i32)
+    i32.const 16
+    v128.load
+    i32x4.all_true)
+  (func (export "i32x4.all_true_b") (result i32)
+    i32.const 32
+    v128.load
+    i32x4.all_true)
+  (func (export "i32x4.bitmask") (result i32)
+    i32.const 16
+    v128.load
+    i32x4.bitmask)
+  (func (export "i64x2.all_true") (result i32)
+    i32.const 16
+    v128.load
+    i64x2.all_true)
+  (func (export "i64x2.all_true_b") (result i32)
+    i32.const 32
+    v128.load
+    i64x2.all_true)
+  (func (export "i64x2.bitmask") (result i32)
+    i32.const 16
+    v128.load
+    i64x2.bitmask)
+
+  (func (export "f32x4.add")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.add
+    v128.store)
+  (func (export "f32x4.sub")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.sub
+    v128.store)
+  (func (export "f32x4.mul")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.mul
+    v128.store)
+  (func (export "f32x4.div")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.div
+    v128.store)
+  (func (export "f32x4.min")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.min
+    v128.store)
+  (func (export "f32x4.max")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.max
+    v128.store)
+  (func (export "f32x4.pmin")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.pmin
+    v128.store)
+  (func (export "f32x4.pmax")
+    i32.const 0
+    i32.const 48
+    v128.load
+    i32.const 64
+    v128.load
+    f32x4.pmax
+    v128.store)
+  (func (export "f32x4.abs")
+    i32.const 0
+    i32.const 48
+    v128.load
+    f32x4.abs
+    v128.store)
+  (func (export "f32x4.neg")
+    i32.const 0
+    i32.const 48
+    v128.load
+    f32x4.neg
+    v128.store)
+  (func (export "f32x4.sqrt")
+    i32.const 0
+    i32.const 144
+    v128.load
+    f32x4.sqrt
+    v128.store)
+  (func (export "f32x4.ceil")
+    i32.const 0
+    i32.const 176
+    v128.load
+    f32x4.ceil
+    v128.store)
+  (func (export "f32x4.floor")
+    i32.const 0
+    i32.const 176
+    v128.load
+    f32x4.floor
+    v128.store)
+  (func (export "f32x4.trunc")
+    i32.const 0
+    i32.const 176
+    v128.load
+    f32x4.trunc
+    v128.store)
+  (func (export "f32x4.nearest")
+    i32.const 0
+    i32.const 176
+    v128.load
+    f32x4.nearest
+    v128.store)
+  (func (export "f64x2.add")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.add
+    v128.store)
+  (func (export "f64x2.sub")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.sub
+    v128.store)
+  (func (export "f64x2.mul")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.mul
+    v128.store)
+  (func (export "f64x2.div")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.div
+    v128.store)
+  (func (export "f64x2.min")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.min
+    v128.store)
+  (func (export "f64x2.max")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.max
+    v128.store)
+  (func (export "f64x2.pmin")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.pmin
+    v128.store)
+  (func (export "f64x2.pmax")
+    i32.const 0
+    i32.const 80
+    v128.load
+    i32.const 96
+    v128.load
+    f64x2.pmax
+    v128.store)
+  (func (export "f64x2.abs")
+    i32.const 0
+    i32.const 80
+    v128.load
+    f64x2.abs
+    v128.store)
+  (func (export "f64x2.neg")
+    i32.const 0
+    i32.const 80
+    v128.load
+    f64x2.neg
+    v128.store)
+  (func (export "f64x2.sqrt")
+    i32.const 0
+    i32.const 160
+    v128.load
+    f64x2.sqrt
+    v128.store)
+  (func (export "f64x2.ceil")
+    i32.const 0
+    i32.const 192
+    v128.load
+    f64x2.ceil
+    v128.store)
+  (func (export "f64x2.floor")
+    i32.const 0
+    i32.const 192
+    v128.load
+    f64x2.floor
+    v128.store)
+  (func (export "f64x2.trunc")
+    i32.const 0
+    i32.const 192
+    v128.load
+    f64x2.trunc
+    v128.store)
+  (func (export "f64x2.nearest")
+    i32.const 0
+    i32.const 192
+    v128.load
+    f64x2.nearest
+    v128.store)
+
+  (func (export "i32x4.trunc_sat_f32x4_s")
+    i32.const 0
+    i32.const 208
+    v128.load
+    i32x4.trunc_sat_f32x4_s
+    v128.store)
+  (func (export "i32x4.trunc_sat_f32x4_u")
+    i32.const 0
+    i32.const 208
+    v128.load
+    i32x4.trunc_sat_f32x4_u
+    v128.store)
+  (func (export "f32x4.convert_i32x4_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    f32x4.convert_i32x4_s
+    v128.store)
+  (func (export "f32x4.convert_i32x4_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    f32x4.convert_i32x4_u
+    v128.store)
+  (func (export "i32x4.trunc_sat_f64x2_s_zero")
+    i32.const 0
+    i32.const 96
+    v128.load
+    i32x4.trunc_sat_f64x2_s_zero
+    v128.store)
+  (func (export "i32x4.trunc_sat_f64x2_u_zero")
+    i32.const 0
+    i32.const 96
+    v128.load
+    i32x4.trunc_sat_f64x2_u_zero
+    v128.store)
+  (func (export "f64x2.convert_low_i32x4_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    f64x2.convert_low_i32x4_s
+    v128.store)
+  (func (export "f64x2.convert_low_i32x4_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    f64x2.convert_low_i32x4_u
+    v128.store)
+  (func (export "f32x4.demote_f64x2_zero")
+    i32.const 0
+    i32.const 80
+    v128.load
+    f32x4.demote_f64x2_zero
+    v128.store)
+  (func (export "f64x2.promote_low_f32x4")
+    i32.const 0
+    i32.const 48
+    v128.load
+    f64x2.promote_low_f32x4
+    v128.store)
+
+  (func (export "i16x8.extend_low_i8x16_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i16x8.extend_low_i8x16_s
+    v128.store)
+  (func (export "i16x8.extend_low_i8x16_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i16x8.extend_low_i8x16_u
+    v128.store)
+  (func (export "i16x8.extend_high_i8x16_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i16x8.extend_high_i8x16_s
+    v128.store)
+  (func (export "i16x8.extend_high_i8x16_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i16x8.extend_high_i8x16_u
+    v128.store)
+  (func (export "i16x8.extmul_low_i8x16_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.extmul_low_i8x16_s
+    v128.store)
+  (func (export "i16x8.extmul_low_i8x16_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.extmul_low_i8x16_u
+    v128.store)
+  (func (export "i16x8.extmul_high_i8x16_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.extmul_high_i8x16_s
+    v128.store)
+  (func (export "i16x8.extmul_high_i8x16_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.extmul_high_i8x16_u
+    v128.store)
+  (func (export "i32x4.extend_low_i16x8_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32x4.extend_low_i16x8_s
+    v128.store)
+  (func (export "i32x4.extend_low_i16x8_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32x4.extend_low_i16x8_u
+    v128.store)
+  (func (export "i32x4.extend_high_i16x8_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32x4.extend_high_i16x8_s
+    v128.store)
+  (func (export "i32x4.extend_high_i16x8_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32x4.extend_high_i16x8_u
+    v128.store)
+  (func (export "i32x4.extmul_low_i16x8_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.extmul_low_i16x8_s
+    v128.store)
+  (func (export "i32x4.extmul_low_i16x8_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.extmul_low_i16x8_u
+    v128.store)
+  (func (export "i32x4.extmul_high_i16x8_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.extmul_high_i16x8_s
+    v128.store)
+  (func (export "i32x4.extmul_high_i16x8_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i32x4.extmul_high_i16x8_u
+    v128.store)
+  (func (export "i64x2.extend_low_i32x4_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i64x2.extend_low_i32x4_s
+    v128.store)
+  (func (export "i64x2.extend_low_i32x4_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i64x2.extend_low_i32x4_u
+    v128.store)
+  (func (export "i64x2.extend_high_i32x4_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i64x2.extend_high_i32x4_s
+    v128.store)
+  (func (export "i64x2.extend_high_i32x4_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i64x2.extend_high_i32x4_u
+    v128.store)
+  (func (export "i64x2.extmul_low_i32x4_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.extmul_low_i32x4_s
+    v128.store)
+  (func (export "i64x2.extmul_low_i32x4_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.extmul_low_i32x4_u
+    v128.store)
+  (func (export "i64x2.extmul_high_i32x4_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.extmul_high_i32x4_s
+    v128.store)
+  (func (export "i64x2.extmul_high_i32x4_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i64x2.extmul_high_i32x4_u
+    v128.store)
+  (func (export "i8x16.narrow_i16x8_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.narrow_i16x8_s
+    v128.store)
+  (func (export "i8x16.narrow_i16x8_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.narrow_i16x8_u
+    v128.store)
+  (func (export "i16x8.narrow_i32x4_s")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.narrow_i32x4_s
+    v128.store)
+  (func (export "i16x8.narrow_i32x4_u")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i16x8.narrow_i32x4_u
+    v128.store)
+
+  (func (export "v128.const")
+    i32.const 0
+    v128.const i32x4 0x03020100 0x07060504 0x0b0a0908 0x0f0e0d0c
+    v128.store)
+  (func (export "i8x16.shuffle")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 32
+    v128.load
+    i8x16.shuffle 0 17 2 19 4 21 6 23 31 30 29 28 15 14 13 12
+    v128.store)
+  (func (export "i8x16.swizzle")
+    i32.const 0
+    i32.const 16
+    v128.load
+    i32.const 112
+    v128.load
+    i8x16.swizzle
+    v128.store)
+  (func (export "i8x16.splat") (param i32)
+    i32.const 0
+    local.get 0
+    i8x16.splat
+    i32.const -128
+    i8x16.replace_lane 3
+    v128.store)
+  (func (export "i16x8.splat") (param i32)
+    i32.const 0
+    local.get 0
+    i16x8.splat
+    i32.const 0x1234
+    i16x8.replace_lane 7
+    v128.store)
+  (func (export "i32x4.splat") (param i32)
+    i32.const 0
+    local.get 0
+    i32x4.splat
+    i32.const -7
+    i32x4.replace_lane 1
+    v128.store)
+  (func (export "i64x2.splat") (param i64)
+    i32.const 0
+    local.get 0
+    i64x2.splat
+    i64.const -1099511627776
+    i64x2.replace_lane 0
+    v128.store)
+  (func (export "f32x4.splat")
+    i32.const 0
+    f32.const 1.5
+    f32x4.splat
+    f32.const -8
+    f32x4.replace_lane 2
+    v128.store)
+  (func (export "f64x2.splat")
+    i32.const 0
+    f64.const -2.5
+    f64x2.splat
+    f64.const 0.125
+    f64x2.replace_lane 1
+    v128.store)
+  (func (export "i8x16.extract_lane_s") (result i32)
+    i32.const 16
+    v128.load
+    i8x16.extract_lane_s 7)
+  (func (export "i8x16.extract_lane_u") (result i32)
+    i32.const 16
+    v128.load
+    i8x16.extract_lane_u 7)
+  (func (export "i16x8.extract_lane_s") (result i32)
+    i32.const 16
+    v128.load
+    i16x8.extract_lane_s 3)
+  (func (export "i16x8.extract_lane_u") (result i32)
+    i32.const 16
+    v128.load
+    i16x8.extract_lane_u 3)
+  (func (export "i32x4.extract_lane") (result i32)
+    i32.const 16
+    v128.load
+    i32x4.extract_lane 2)
+  (func (export "i64x2.extract_lane") (result i64)
+    i32.const 16
+    v128.load
+    i64x2.extract_lane 1)
+  (func (export "f32x4.extract_lane")
+    i32.const 0
+    v128.const i64x2 0 0
+    v128.store
+    i32.const 0
+    i32.const 48
+    v128.load
+    f32x4.extract_lane 1
+    f32.store)
+  (func (export "f64x2.extract_lane")
+    i32.const 0
+    v128.const i64x2 0 0
+    v128.store
+    i32.const 0
+    i32.const 80
+    v128.load
+    f64x2.extract_lane 1
+    f64.store)
+
+  (func (export "v128.load8x8_s")
+    i32.const 0
+    i32.const 20
+    v128.load8x8_s
+    v128.store)
+  (func (export "v128.load8x8_u")
+    i32.const 0
+    i32.const 20
+    v128.load8x8_u
+    v128.store)
+  (func (export "v128.load16x4_s")
+    i32.const 0
+    i32.const 20
+    v128.load16x4_s
+    v128.store)
+  (func (export "v128.load16x4_u")
+    i32.const 0
+    i32.const 20
+    v128.load16x4_u
+    v128.store)
+  (func (export "v128.load32x2_s")
+    i32.const 0
+    i32.const 20
+    v128.load32x2_s
+    v128.store)
+  (func (export "v128.load32x2_u")
+    i32.const 0
+    i32.const 20
+    v128.load32x2_u
+    v128.store)
+  (func (export "v128.load8_splat")
+    i32.const 0
+    i32.const 22
+    v128.load8_splat
+    v128.store)
+  (func (export "v128.load16_splat")
+    i32.const 0
+    i32.const 22
+    v128.load16_splat
+    v128.store)
+  (func (export "v128.load32_splat")
+    i32.const 0
+    i32.const 22
+    v128.load32_splat
+    v128.store)
+  (func (export "v128.load64_splat")
+    i32.const 0
+    i32.const 22
+    v128.load64_splat
+    v128.store)
+  (func (export "v128.load32_zero")
+    i32.const 0
+    i32.const 20
+    v128.load32_zero
+    v128.store)
+  (func (export "v128.load64_zero")
+    i32.const 0
+    i32.const 24
+    v128.load64_zero
+    v128.store)
+  (func (export "v128.load_offset")
+    i32.const 0
+    i32.const 4
+    v128.load offset=28
+    v128.store)
+  (func (export "v128.load8_lane")
+    i32.const 0
+    i32.const 32
+    i32.const 16
+    v128.load
+    v128.load8_lane 5
+    v128.store)
+  (func (export "v128.load16_lane")
+    i32.const 0
+    i32.const 32
+    i32.const 16
+    v128.load
+    v128.load16_lane 3
+    v128.store)
+  (func (export "v128.load32_lane")
+    i32.const 0
+    i32.const 32
+    i32.const 16
+    v128.load
+    v128.load32_lane 2
+    v128.store)
+  (func (export "v128.load64_lane")
+    i32.const 0
+    i32.const 32
+    i32.const 16
+    v128.load
+    v128.load64_lane 1
+    v128.store)
+  (func (export "v128.store8_lane")
+    i32.const 0
+    v128.const i64x2 0 0
+    v128.store
+    i32.const 0
+    i32.const 16
+    v128.load
+    v128.store8_lane 6)
+  (func (export "v128.store16_lane")
+    i32.const 0
+    v128.const i64x2 0 0
+    v128.store
+    i32.const 0
+    i32.const 16
+    v128.load
+    v128.store16_lane 5)
+  (func (export "v128.store32_lane")
+    i32.const 0
+    v128.const i64x2 0 0
+    v128.store
+    i32.const 0
+    i32.const 16
+    v128.load
+    v128.store32_lane 3)
+  (func (export "v128.store64_lane")
+    i32.const 0
+    v128.const i64x2 0 0
+    v128.store
+    i32.const 0
+    i32.const 16
+    v128.load
+    v128.store64_lane 1)
+  (func (export "v128.load_at") (param i32) (result i32)
+    local.get 0
+    v128.load
+    i32x4.extract_lane 0)
+  (func (export "v128.store_at") (param i32)
+    local.get 0
+    i32.const 16
+    v128.load
+    v128.store)
+
+  (func (export "v128.local_loop") (local i32 v128)
+    i32.const 4
+    local.set 0
+    loop
+      local.get 1
+      i32.const 16
+      v128.load
+      i32x4.add
+      local.set 1
+      local.get 0
+      i32.const 1
+      i32.sub
+      local.tee 0
+      br_if 0
+    end
+    i32.const 0
+    local.get 1
+    v128.store)
+
+  (func (export "load_i32") (param i32) (result i32)
+    local.get 0
+    i32.load)
+)
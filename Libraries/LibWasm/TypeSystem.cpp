@@ -509,6 +509,8 @@ bool matches_memory_type(MemoryType const& memory_type1, MemoryType const& memor
 {
     if (memory_type1.limits().address_type() != memory_type2.limits().address_type())
         return false;
+    if (memory_type1.is_shared() != memory_type2.is_shared())
+        return false;
     return matches_limits(memory_type1.limits(), memory_type2.limits());
 }
 
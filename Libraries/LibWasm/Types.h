@@ -8,6 +8,7 @@
 
 #include <AK/AtomicRefCounted.h>
 #include <AK/Badge.h>
+#include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
 #include <AK/DistinctNumeric.h>
 #include <AK/FixedArray.h>
@@ -16,6 +17,7 @@
 #include <AK/NumericLimits.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
+#include <AK/RefPtr.h>
 #include <AK/Result.h>
 #include <AK/String.h>
 #include <AK/Time.h>
@@ -432,10 +434,11 @@ enum class AddressType : u8 {
 // https://webassembly.github.io/spec/core/bikeshed/#limits%E2%91%A5
 class Limits {
 public:
-    explicit Limits(AddressType address_type, u64 min, Optional<u64> max = {})
+    explicit Limits(AddressType address_type, u64 min, Optional<u64> max = {}, bool is_shared = false)
         : m_address_type(address_type)
         , m_min(min)
         , m_max(move(max))
+        , m_is_shared(is_shared)
     {
     }
 
@@ -446,11 +449,13 @@ public:
     auto address_type() const { return m_address_type; }
     auto min() const { return m_min; }
     auto& max() const { return m_max; }
+    bool is_shared() const { return m_is_shared; }
     bool is_subset_of(Limits other) const
     {
         return m_min >= other.min()
             && (!other.max().has_value() || (m_max.has_value() && *m_max <= *other.max()))
-            && m_address_type == other.m_address_type;
+            && m_address_type == other.m_address_type
+            && m_is_shared == other.m_is_shared;
     }
 
     static ParseResult<Limits> parse(ConstrainedStream& stream);
@@ -459,6 +464,7 @@ private:
     AddressType m_address_type { AddressType::I32 };
     u64 m_min { 0 };
     Optional<u64> m_max;
+    bool m_is_shared { false };
 };
 
 // https://webassembly.github.io/spec/core/bikeshed/#memory-types%E2%91%A4
@@ -470,6 +476,7 @@ public:
     }
 
     auto& limits() const { return m_limits; }
+    bool is_shared() const { return m_limits.is_shared(); }
 
     static ParseResult<MemoryType> parse(ConstrainedStream& stream);
 
@@ -982,6 +989,22 @@ struct CraneliftTrap {
 };
 static_assert(sizeof(CraneliftTrap) == 8);
 
+// Per-function execution counters, only attached to functions validated while function profiling is enabled
+// (see set_function_profiling_enabled()). Shared with the profile registry so they outlive the module.
+// All counters are updated with relaxed atomics from whichever thread runs or installs the function.
+struct FunctionProfile : public AtomicRefCounted<FunctionProfile> {
+    u32 module_id { 0 };
+    u32 function_index { 0 };
+    bool native_eligible { false };       // cleared the Cranelift checks during validation; otherwise it only ever runs interpreted.
+    u64 interpreted_calls { 0 };          // calls that ran in the BytecodeInterpreter.
+    u64 native_calls { 0 };               // calls that entered the function's native code.
+    u64 tier_up_entries { 0 };            // tier-up checkpoints that switched a running interpreted call to native code.
+    u64 interpreted_instructions { 0 };   // dispatches executed by the interpreter on behalf of this function.
+    i64 validated_at_ns { 0 };            // MonotonicTime::nanoseconds() of each event, or 0 if it has not happened.
+    i64 first_interpreted_call_at_ns { 0 };
+    i64 native_installed_at_ns { 0 };
+};
+
 struct CompiledInstructions {
     Vector<Dispatch> dispatches;
     Vector<SourcesAndDestination> src_dst_mappings;
@@ -1005,11 +1028,13 @@ struct CompiledInstructions {
     size_t cranelift_trap_count = 0;
     size_t max_call_arg_count = 0;
     size_t max_call_rec_size = 0;
+    RefPtr<FunctionProfile> profile; // Null unless function profiling was enabled when this function was validated.
 
     u32 cranelift_result_arity = 0;   // result count to hand to try_cranelift_compile(); only meaningful when cranelift_eligible.
     u32 cranelift_local_count = 0;    // total locals (params + declared + inlined); lets Cranelift promote locals to SSA instead of memory. Only meaningful when cranelift_eligible.
     u32 cranelift_param_count = 0;    // leading locals that are parameters; the compiled entry block zero-initializes everything past them. Only meaningful when cranelift_eligible.
     u32 cranelift_inlined_locals = 0; // extra locals appended for inlined callee bodies (see try_compile_instructions); the frame is grown by this much in both interpreter and JIT paths.
+    mutable u32 interpreter_hit_count = 0; // calls and tier-up checkpoint hits while interpreted; the background compile uses it to compile hot functions first.
 
     bool direct = false;                  // true if all dispatches contain handler_ptr, otherwise false and all contain instruction_opcode.
     bool cranelift_eligible = false;      // true if this expression cleared the Cranelift type/shape checks during validation.
@@ -1030,6 +1055,41 @@ inline void publish_cranelift_entry(CompiledInstructions& ci, FlatPtr entry)
     AK::atomic_store(&ci.cranelift_entry, entry, AK::MemoryOrder::memory_order_release);
 }
 
+// Racy by design: the count only ranks functions for compilation, so a lost update is harmless,
+// but a locked increment on every interpreted call or loop iteration would not be.
+inline void note_interpreter_hit(CompiledInstructions const& ci)
+{
+    auto hits = AK::atomic_load(&ci.interpreter_hit_count, AK::MemoryOrder::memory_order_relaxed);
+    if (hits != NumericLimits<u32>::max())
+        AK::atomic_store(&ci.interpreter_hit_count, hits + 1, AK::MemoryOrder::memory_order_relaxed);
+}
+
+inline void note_profiled_interpreted_call(FunctionProfile& profile)
+{
+    if (AK::atomic_fetch_add(&profile.interpreted_calls, static_cast<u64>(1), AK::MemoryOrder::memory_order_relaxed) == 0)
+        AK::atomic_store(&profile.first_interpreted_call_at_ns, MonotonicTime::now().nanoseconds(), AK::MemoryOrder::memory_order_relaxed);
+}
+
+inline void note_profiled_native_call(FunctionProfile& profile)
+{
+    AK::atomic_fetch_add(&profile.native_calls, static_cast<u64>(1), AK::MemoryOrder::memory_order_relaxed);
+}
+
+inline void note_profiled_tier_up_entry(FunctionProfile& profile)
+{
+    AK::atomic_fetch_add(&profile.tier_up_entries, static_cast<u64>(1), AK::MemoryOrder::memory_order_relaxed);
+}
+
+inline void note_profiled_interpreted_instructions(FunctionProfile& profile, u64 count)
+{
+    AK::atomic_fetch_add(&profile.interpreted_instructions, count, AK::MemoryOrder::memory_order_relaxed);
+}
+
+inline void note_profiled_native_install(FunctionProfile& profile)
+{
+    AK::atomic_store(&profile.native_installed_at_ns, MonotonicTime::now().nanoseconds(), AK::MemoryOrder::memory_order_relaxed);
+}
+
 template<Enum auto... Vs>
 consteval auto as_ordered()
 {
@@ -1761,6 +1821,8 @@ public:
     void set_canonical_types(Vector<DefinedType const*> types) { m_canonical_types = move(types); }
 
 private:
+    friend class StreamingModuleParser;
+
     void set_validation_status(ValidationStatus status) { m_validation_status = status; }
     void preprocess();
 
@@ -1792,6 +1854,51 @@ private:
     size_t m_minimum_call_record_allocation_size { 0 };
 };
 
+// Parses a module from bytes that arrive in arbitrarily sized chunks (e.g. a response body being downloaded).
+// Each section is parsed as soon as it has fully arrived; the code section is parsed per function body, so only
+// a single partial entry is ever buffered. Produces the same Module (and errors) as Module::parse().
+class WASM_API StreamingModuleParser {
+public:
+    StreamingModuleParser();
+
+    ParseResult<void> append(ReadonlyBytes);
+    ParseResult<NonnullRefPtr<Module>> finish();
+
+    size_t total_size() const { return m_total_size; }
+
+private:
+    enum class State : u8 {
+        Header,
+        SectionHeader,
+        SectionContents,
+        CodeSectionCount,
+        CodeSectionEntry,
+        Failed,
+        Finished,
+    };
+
+    ParseResult<void> parse_available_bytes();
+    ParseResult<bool> parse_next();
+    ParseError fail(ParseError);
+
+    ReadonlyBytes available_bytes() const { return m_buffer.bytes().slice(m_buffer_offset); }
+
+    State m_state { State::Header };
+    ParseError m_error { ParseError::UnexpectedEof };
+    ByteBuffer m_buffer;
+    size_t m_buffer_offset { 0 };
+    size_t m_total_size { 0 };
+
+    NonnullRefPtr<Module> m_module;
+    SectionId::SectionIdKind m_last_section_kind { SectionId::SectionIdKind::Custom };
+    u32 m_seen_section_kinds { 0 };
+    Optional<SectionId> m_section_id;
+    size_t m_section_size { 0 };
+    size_t m_section_remaining { 0 };
+    u32 m_remaining_functions { 0 };
+    Vector<CodeSection::Code> m_functions;
+};
+
 CompiledInstructions try_compile_instructions(Expression const&, Span<FunctionType const> functions, Span<CodeSection::Func const* const> callee_bodies = {}, size_t current_function_index = 0, size_t caller_local_count = 0, size_t imported_function_count = 0);
 ErrorOr<void, ValidationError> ensure_cranelift_compiled(Module&);
 WASM_API void start_cranelift_compilation(Module&);
@@ -1804,6 +1911,17 @@ void compile_module_to_native(Module&);
 WASM_API void record_module_stats(ModuleStats);
 WASM_API void dump_module_stats();
 
+// Function-level execution profiling. Only modules validated while it is enabled are profiled; their
+// functions get a FunctionProfile that keeps counting for as long as they run, and stays in the registry
+// after the module is gone so end-of-run reports still see it.
+WASM_API void set_function_profiling_enabled(bool);
+WASM_API bool function_profiling_enabled();
+void register_function_profiles(Module&, size_t imported_function_count);
+WASM_API void dump_function_profiles();
+// Chrome trace-event format: `traceEvents` holds one complete event per function covering the time it ran
+// interpreted before its native code got installed, `functions` holds the raw counters.
+WASM_API JsonObject function_profiles_as_json();
+
 // Cranelift disk-cache plumbing. Validator drives these around CodeSection validation:
 //   1. set_cranelift_active_function_index() before each function so cache-hit installs
 //      and post-compile capture know which function they're talking about.
@@ -9,9 +9,12 @@
 #include <AK/Utf16StringBuilder.h>
 #include <LibJS/Runtime/Iterator.h>
 #include <LibWeb/Animations/Animation.h>
+#include <LibWeb/Animations/DocumentTimeline.h>
 #include <LibWeb/Animations/KeyframeEffect.h>
 #include <LibWeb/Animations/PseudoElementParsing.h>
+#include <LibWeb/Animations/ScrollTimeline.h>
 #include <LibWeb/Bindings/KeyframeEffect.h>
+#include <LibWeb/CSS/CSSAnimation.h>
 #include <LibWeb/CSS/ComputedProperties.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/PropertyID.h>
@@ -20,7 +23,10 @@
 #include <LibWeb/DOM/AbstractElement.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/Layout/Node.h>
+#include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/AccumulatedVisualContext.h>
 #include <LibWeb/Painting/Paintable.h>
+#include <LibWeb/Painting/ViewportPaintable.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
 
 namespace Web::Animations {
@@ -626,6 +632,39 @@ void KeyframeEffect::generate_initial_and_final_frames(RefPtr<KeyFrameSet> keyfr
     }
 }
 
+KeyframeEffect::KeyFrameSet::PropertyTracks const& KeyframeEffect::KeyFrameSet::property_tracks(CSS::LogicalAliasMappingContext const& logical_alias_mapping_context) const
+{
+    if (m_property_tracks.has_value()
+        && m_property_tracks->logical_alias_mapping_context.writing_mode == logical_alias_mapping_context.writing_mode
+        && m_property_tracks->logical_alias_mapping_context.direction == logical_alias_mapping_context.direction)
+        return *m_property_tracks;
+
+    PropertyTracks tracks { .logical_alias_mapping_context = logical_alias_mapping_context, .ordered_keyframes = {}, .keyframes_specifying_property = {} };
+    tracks.ordered_keyframes.ensure_capacity(keyframes_by_key.size());
+    for (auto it = keyframes_by_key.begin(); it != keyframes_by_key.end(); ++it) {
+        auto keyframe_index = tracks.ordered_keyframes.size();
+        auto add_physical_longhand = [&](CSS::PropertyID longhand_id) {
+            auto physical_longhand_id = CSS::map_logical_alias_to_physical_property(longhand_id, logical_alias_mapping_context);
+            auto& specifying_keyframes = tracks.keyframes_specifying_property.ensure(physical_longhand_id);
+            if (specifying_keyframes.is_empty() || specifying_keyframes.last() != keyframe_index)
+                specifying_keyframes.append(keyframe_index);
+        };
+        for (auto const& [property_id, value] : it->properties) {
+            value.visit(
+                [&](UseInitial) { add_physical_longhand(property_id); },
+                [&](NonnullRefPtr<CSS::StyleValue const> const& keyframe_value) {
+                    CSS::StyleComputer::for_each_property_expanding_shorthands(property_id, *keyframe_value, [&](CSS::PropertyID longhand_id, CSS::StyleValue const&) {
+                        add_physical_longhand(longhand_id);
+                    });
+                });
+        }
+        tracks.ordered_keyframes.append({ static_cast<i64>(it.key()), &*it });
+    }
+
+    m_property_tracks = move(tracks);
+    return *m_property_tracks;
+}
+
 // https://www.w3.org/TR/web-animations-1/#animation-composite-order
 int KeyframeEffect::composite_order(GC::Ref<KeyframeEffect> a, GC::Ref<KeyframeEffect> b)
 {
@@ -998,6 +1037,239 @@ void KeyframeEffect::update_computed_properties_for_style(AnimationUpdateContext
     style_computer.collect_animation_into(abstract_element, *this, *element_data.target_style);
 }
 
+static constexpr double compositor_animation_samples_per_second = 60.0;
+static constexpr size_t minimum_compositor_animation_samples = 8;
+static constexpr size_t maximum_compositor_animation_samples = 240;
+static constexpr double compositor_animation_device_pixels_per_scroll_sample = 4.0;
+
+static bool easing_may_step(CSS::EasingFunction const& easing)
+{
+    return easing.has<CSS::StepsEasingFunction>();
+}
+
+static bool easing_may_step(Variant<Empty, CSS::EasingFunction, NonnullRefPtr<CSS::StyleValue const>> const& easing)
+{
+    return easing.visit(
+        [](Empty) { return false; },
+        [](CSS::EasingFunction const& easing) { return easing_may_step(easing); },
+        [](NonnullRefPtr<CSS::StyleValue const> const& value) {
+            // NB: Anything that still needs resolving could turn out to be a step function.
+            if (!value->is_easing() && !value->is_keyword())
+                return true;
+            return easing_may_step(CSS::EasingFunction::from_style_value(*value));
+        });
+}
+
+static bool compositor_animation_values_match(Compositor::CompositorAnimation const& animation, Painting::VisualContextData const& data, double local_time)
+{
+    static constexpr float tolerance = 0.01f;
+    auto matches = [](float a, float b) { return fabsf(a - b) <= tolerance * max(1.0f, fabsf(b)); };
+
+    if (auto const* effects = data.get_pointer<Painting::EffectsData>()) {
+        auto sampled = *effects;
+        animation.apply_to(sampled, local_time);
+        return matches(sampled.opacity, effects->opacity);
+    }
+
+    auto const& transform = data.get<Painting::TransformData>();
+    auto sampled = transform;
+    animation.apply_to(sampled, local_time);
+    for (size_t row = 0; row < 4; ++row) {
+        for (size_t column = 0; column < 4; ++column) {
+            if (!matches(sampled.matrix[row, column], transform.matrix[row, column]))
+                return false;
+        }
+    }
+    return true;
+}
+
+Optional<Compositor::CompositorAnimation> KeyframeEffect::compositor_animation()
+{
+    auto not_eligible = [this]() -> Optional<Compositor::CompositorAnimation> {
+        m_compositor_animation.clear();
+        return {};
+    };
+
+    auto animation = associated_animation();
+    if (!animation || !m_target_element || !m_target_element->is_connected() || pseudo_element_type().has_value() || !m_key_frame_set)
+        return not_eligible();
+    if (animation->play_state() != Bindings::AnimationPlayState::Running || animation->pending() || animation->playback_rate() == 0)
+        return not_eligible();
+    if (!animation->timeline())
+        return not_eligible();
+    auto const* scroll_timeline = as_if<ScrollTimeline>(*animation->timeline());
+    if (!scroll_timeline && !is<DocumentTimeline>(*animation->timeline()))
+        return not_eligible();
+
+    // NB: Scroll timelines measure time in percent of the scroll range, and everything else in milliseconds.
+    auto time_type = scroll_timeline ? TimeValue::Type::Percentage : TimeValue::Type::Milliseconds;
+    if (m_iteration_duration.type != time_type || m_iteration_duration.value <= 0 || m_start_delay.type != time_type || m_end_delay.type != time_type)
+        return not_eligible();
+
+    auto local_time = this->local_time();
+    if (!local_time.has_value() || local_time->type != time_type)
+        return not_eligible();
+
+    if (m_target_properties.size() != 1)
+        return not_eligible();
+    auto property_id = *m_target_properties.begin();
+    if (property_id != CSS::PropertyID::Opacity && property_id != CSS::PropertyID::Transform)
+        return not_eligible();
+    auto property = property_id == CSS::PropertyID::Opacity ? Compositor::CompositorAnimation::Property::Opacity : Compositor::CompositorAnimation::Property::Transform;
+
+    // The samples only account for this effect, so nothing else may animate the same property on the same target.
+    for (auto const& other_animation : m_target_element->associated_animations()) {
+        if (other_animation == animation || !other_animation->effect())
+            continue;
+        if (other_animation->effect()->target() == m_target_element.ptr() && other_animation->effect()->target_properties().contains(property_id))
+            return not_eligible();
+    }
+
+    auto& document = m_target_element->document();
+    auto viewport_paintable = document.paintable();
+    auto paintable_box = m_target_element->paintable_box();
+    auto computed_values = DOM::AbstractElement { *m_target_element }.computed_values();
+    if (!viewport_paintable || !viewport_paintable->has_visual_context_tree() || !paintable_box || !computed_values)
+        return not_eligible();
+
+    auto const& visual_context_tree = viewport_paintable->visual_context_tree();
+    Optional<Painting::VisualContextIndex> node_index;
+    for (auto index = paintable_box->visual_context_nodes_begin(); index < min(paintable_box->visual_context_nodes_end(), visual_context_tree.nodes().size()); ++index) {
+        auto const& data = visual_context_tree.nodes()[index].data;
+        if ((property == Compositor::CompositorAnimation::Property::Opacity && data.has<Painting::EffectsData>())
+            || (property == Compositor::CompositorAnimation::Property::Transform && data.has<Painting::TransformData>())) {
+            node_index = Painting::VisualContextIndex { index };
+            break;
+        }
+    }
+    if (!node_index.has_value())
+        return not_eligible();
+
+    auto pixel_ratio = document.page().client().device_pixels_per_css_pixel();
+
+    Optional<Compositor::CompositorAnimation::ScrollTimelineSource> scroll_timeline_source;
+    if (scroll_timeline) {
+        auto scroll_source = scroll_timeline->scroll_source();
+        auto current_time = scroll_timeline->current_time();
+        if (!scroll_source.has_value() || !current_time.has_value())
+            return not_eligible();
+        auto scroll_node_index = scroll_source->scroll_container->own_scroll_node_index();
+        if (scroll_node_index.value() == 0 || scroll_node_index.value() >= visual_context_tree.nodes().size() || !visual_context_tree.node_at(scroll_node_index).data.has<Painting::ScrollData>())
+            return not_eligible();
+        scroll_timeline_source = Compositor::CompositorAnimation::ScrollTimelineSource {
+            .scroll_node_index = scroll_node_index,
+            .is_vertical = scroll_source->is_vertical,
+            .scroll_range = static_cast<float>(scroll_source->max_scroll_offset * pixel_ratio),
+            .current_time = current_time->value,
+        };
+    }
+
+    auto fill_mode = m_fill_mode == Bindings::FillMode::Auto ? Bindings::FillMode::None : m_fill_mode;
+    auto direction = [&] {
+        switch (m_playback_direction) {
+        case Bindings::PlaybackDirection::Normal:
+            return Compositor::CompositorAnimation::Direction::Normal;
+        case Bindings::PlaybackDirection::Reverse:
+            return Compositor::CompositorAnimation::Direction::Reverse;
+        case Bindings::PlaybackDirection::Alternate:
+            return Compositor::CompositorAnimation::Direction::Alternate;
+        case Bindings::PlaybackDirection::AlternateReverse:
+            return Compositor::CompositorAnimation::Direction::AlternateReverse;
+        }
+        VERIFY_NOT_REACHED();
+    }();
+
+    Compositor::CompositorAnimation timing {
+        .node_index = *node_index,
+        .property = property,
+        .local_time = local_time->value,
+        .playback_rate = animation->playback_rate(),
+        .start_delay = m_start_delay.value,
+        .end_delay = m_end_delay.value,
+        .iteration_duration = m_iteration_duration.value,
+        .iteration_start = m_iteration_start,
+        .iteration_count = m_iteration_count,
+        .direction = direction,
+        .fills_backwards = fill_mode == Bindings::FillMode::Backwards || fill_mode == Bindings::FillMode::Both,
+        .fills_forwards = fill_mode == Bindings::FillMode::Forwards || fill_mode == Bindings::FillMode::Both,
+        .scroll_timeline = scroll_timeline_source,
+    };
+
+    auto has_same_timing = [&](Compositor::CompositorAnimation const& other) {
+        return other.node_index == timing.node_index
+            && other.property == timing.property
+            && other.playback_rate == timing.playback_rate
+            && other.start_delay == timing.start_delay
+            && other.end_delay == timing.end_delay
+            && other.iteration_duration == timing.iteration_duration
+            && other.iteration_start == timing.iteration_start
+            && other.iteration_count == timing.iteration_count
+            && other.direction == timing.direction
+            && other.fills_backwards == timing.fills_backwards
+            && other.fills_forwards == timing.fills_forwards
+            && other.scroll_timeline.has_value() == timing.scroll_timeline.has_value()
+            && (!other.scroll_timeline.has_value()
+                || (other.scroll_timeline->scroll_node_index == timing.scroll_timeline->scroll_node_index
+                    && other.scroll_timeline->is_vertical == timing.scroll_timeline->is_vertical
+                    && other.scroll_timeline->scroll_range == timing.scroll_timeline->scroll_range));
+    };
+
+    // Keep the baked samples for as long as they reproduce what the main thread itself just computed for this frame,
+    // which catches changes to the keyframes, the underlying style and the box alike.
+    if (m_compositor_animation.has_value()
+        && m_compositor_animation_tree_version == visual_context_tree.version()
+        && has_same_timing(*m_compositor_animation)
+        && compositor_animation_values_match(*m_compositor_animation, visual_context_tree.node_at(*node_index).data, local_time->value)) {
+        m_compositor_animation->local_time = local_time->value;
+        if (scroll_timeline_source.has_value())
+            m_compositor_animation->scroll_timeline->current_time = scroll_timeline_source->current_time;
+        return m_compositor_animation;
+    }
+
+    bool interpolates_between_samples = !easing_may_step(m_timing_function);
+    if (animation->is_css_animation() && easing_may_step(static_cast<CSS::CSSAnimation const&>(*animation).default_easing()))
+        interpolates_between_samples = false;
+    for (auto const& keyframe : m_key_frame_set->keyframes_by_key) {
+        if (easing_may_step(keyframe.easing))
+            interpolates_between_samples = false;
+    }
+    timing.interpolates_between_samples = interpolates_between_samples;
+
+    auto& style_computer = document.style_computer();
+    auto style = style_computer.reconstruct_computed_properties(*computed_values);
+    style->reset_non_inherited_animated_properties({});
+
+    auto record_sample = [&] {
+        if (property == Compositor::CompositorAnimation::Property::Opacity) {
+            timing.opacity_samples.append(style->opacity());
+            return;
+        }
+        auto transformations = CSS::ComputedProperties::transformations_for_style_value(style->property(CSS::PropertyID::Transform));
+        timing.transform_samples.append(Painting::compute_transform_with_transformations(*paintable_box, *computed_values, transformations, pixel_ratio).matrix);
+    };
+
+    // NB: A scroll-driven iteration lasts for as long as it takes to scroll across its share of the scroll range.
+    auto ideal_sample_count = scroll_timeline_source.has_value()
+        ? scroll_timeline_source->scroll_range * m_iteration_duration.value / 100.0 / compositor_animation_device_pixels_per_scroll_sample
+        : m_iteration_duration.value / 1000.0 * compositor_animation_samples_per_second;
+    auto sample_count = clamp(static_cast<size_t>(ceil(ideal_sample_count)), minimum_compositor_animation_samples, maximum_compositor_animation_samples) + 1;
+    for (size_t i = 0; i < sample_count; ++i) {
+        auto directed_progress = static_cast<double>(i) / static_cast<double>(sample_count - 1);
+        style_computer.collect_animation_into_at_progress(DOM::AbstractElement { *m_target_element }, *this, *style, m_timing_function.evaluate_at(directed_progress, false));
+        record_sample();
+        style->reset_non_inherited_animated_properties({});
+    }
+
+    // The last sample is the value without this effect.
+    record_sample();
+
+    static u64 s_next_compositor_animation_id = 1;
+    timing.id = s_next_compositor_animation_id++;
+    m_compositor_animation = move(timing);
+    m_compositor_animation_tree_version = visual_context_tree.version();
+    return m_compositor_animation;
+}
+
 Bindings::CompositeOperation css_animation_composition_to_bindings_composite_operation(CSS::AnimationComposition composition)
 {
     switch (composition) {
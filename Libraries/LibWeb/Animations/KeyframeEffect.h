@@ -11,8 +11,10 @@
 #include <LibWeb/Animations/AnimationEffect.h>
 #include <LibWeb/Bindings/KeyframeEffect.h>
 #include <LibWeb/Bindings/PlatformObject.h>
+#include <LibWeb/CSS/PropertyID.h>
 #include <LibWeb/CSS/Selector.h>
 #include <LibWeb/CSS/StyleValues/StyleValue.h>
+#include <LibWeb/Compositor/CompositorAnimation.h>
 
 namespace Web::Animations {
 
@@ -67,6 +69,24 @@ public:
             Variant<Empty, CSS::EasingFunction, NonnullRefPtr<CSS::StyleValue const>> easing {};
         };
         RedBlackTree<u64, ResolvedKeyFrame> keyframes_by_key;
+
+        struct OrderedKeyFrame {
+            i64 key { 0 };
+            ResolvedKeyFrame const* frame { nullptr };
+        };
+        // The keyframes in ascending key order, along with the indices of the keyframes that specify each animated
+        // physical longhand, so that every property can find its own interval between keyframes.
+        struct PropertyTracks {
+            CSS::LogicalAliasMappingContext logical_alias_mapping_context;
+            Vector<OrderedKeyFrame> ordered_keyframes;
+            HashMap<CSS::PropertyID, Vector<size_t>> keyframes_specifying_property;
+        };
+        // NB: A set can't change once it has been built, and the tracks depend on nothing else but the writing mode and
+        //     direction, so they are computed on first use and then shared by every effect animating with this set.
+        PropertyTracks const& property_tracks(CSS::LogicalAliasMappingContext const&) const;
+
+    private:
+        mutable Optional<PropertyTracks> m_property_tracks;
     };
     static void generate_initial_and_final_frames(RefPtr<KeyFrameSet>, HashTable<CSS::PropertyID> const& animated_properties);
 
@@ -111,6 +131,10 @@ public:
     virtual void update_computed_properties(AnimationUpdateContext&) override;
     void update_computed_properties_for_style(AnimationUpdateContext&, DOM::AbstractElement);
 
+    // Returns this effect baked for the compositor to sample by itself, if it only animates the opacity or transform
+    // of a box that already has the matching visual context node. Samples are reused until they stop matching.
+    Optional<Compositor::CompositorAnimation> compositor_animation();
+
 private:
     KeyframeEffect(JS::Realm&);
     virtual ~KeyframeEffect() override = default;
@@ -136,6 +160,9 @@ private:
     Vector<GC::Ref<JS::Object>> m_keyframe_objects_cache {};
 
     RefPtr<KeyFrameSet const> m_key_frame_set {};
+
+    Optional<Compositor::CompositorAnimation> m_compositor_animation;
+    u64 m_compositor_animation_tree_version { 0 };
 };
 
 }
@@ -124,6 +124,8 @@ static ComputedScrollAxis computed_scroll_axis(Bindings::ScrollAxis axis, CSS::W
 struct ScrollOffsetData {
     double scroll_offset;
     double max_scroll_offset;
+    RefPtr<Painting::Paintable const> paintable_box;
+    bool is_vertical;
 };
 static Optional<ScrollOffsetData> compute_scroll_offset_data(Variant<GC::Ptr<DOM::Element const>, GC::Ptr<DOM::Document>> propagated_source, Bindings::ScrollAxis axis)
 {
@@ -155,6 +157,21 @@ static Optional<ScrollOffsetData> compute_scroll_offset_data(Variant<GC::Ptr<DOM
         .max_scroll_offset = computed_axis.is_vertical
             ? scrollable_overflow_rect.height().to_double() - paintable_box->content_height().to_double()
             : scrollable_overflow_rect.width().to_double() - paintable_box->content_width().to_double(),
+        .paintable_box = paintable_box,
+        .is_vertical = computed_axis.is_vertical,
+    };
+}
+
+Optional<ScrollTimeline::ScrollSource> ScrollTimeline::scroll_source() const
+{
+    auto scroll_offset_data = compute_scroll_offset_data(get_propagated_source(), m_axis);
+    if (!scroll_offset_data.has_value() || scroll_offset_data->max_scroll_offset == 0)
+        return {};
+
+    return ScrollSource {
+        .scroll_container = move(scroll_offset_data->paintable_box),
+        .is_vertical = scroll_offset_data->is_vertical,
+        .max_scroll_offset = scroll_offset_data->max_scroll_offset,
     };
 }
 
@@ -40,6 +40,15 @@ public:
     bool is_stale() const;
     virtual void update_current_time(double timestamp) override;
 
+    // The scroll container whose scroll offset drives this timeline, so the timeline can be followed without the main
+    // thread. Empty whenever the timeline is inactive.
+    struct ScrollSource {
+        RefPtr<Painting::Paintable const> scroll_container;
+        bool is_vertical { true };
+        double max_scroll_offset { 0 };
+    };
+    Optional<ScrollSource> scroll_source() const;
+
     virtual bool is_progress_based() const override { return true; }
     virtual bool can_convert_a_timeline_time_to_an_origin_relative_time() const override { return false; }
 
@@ -8,6 +8,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Math.h>
 #include <AK/NeverDestroyed.h>
 #include <LibCore/AnonymousBuffer.h>
 #include <LibGC/CellAllocator.h>
@@ -52,6 +53,7 @@
 #include <LibWeb/HTML/Scripting/WindowEnvironmentSettingsObject.h>
 #include <LibWeb/HTML/Scripting/WorkerAgent.h>
 #include <LibWeb/HTML/Window.h>
+#include <LibWeb/HTML/WindowOrWorkerGlobalScope.h>
 #include <LibWeb/HTML/WindowProxy.h>
 #include <LibWeb/HTML/WorkletGlobalScope.h>
 #include <LibWeb/Page/Page.h>
@@ -355,6 +357,41 @@ void initialize_main_thread_vm(AgentType type)
         }));
     };
 
+    // HostEnqueueGenericJob(job, realm), https://html.spec.whatwg.org/multipage/webappapis.html#hostenqueuegenericjob
+    main_thread_vm_ptr()->host_enqueue_generic_job = [](GC::Ref<GC::Function<void()>> job, JS::Realm& realm) {
+        // 1. Let global be realm's global object.
+        auto& global = realm.global_object();
+
+        // 2. Queue a global task on the JavaScript engine task source given global to perform job().
+        HTML::queue_global_task(HTML::Task::Source::JavaScriptEngine, global, GC::create_function(main_thread_vm_ptr()->heap(), [&realm, job] {
+            HTML::TemporaryExecutionContext context { realm };
+            job->function()();
+        }));
+    };
+
+    // HostEnqueueTimeoutJob(job, realm, milliseconds), https://html.spec.whatwg.org/multipage/webappapis.html#hostenqueuetimeoutjob
+    main_thread_vm_ptr()->host_enqueue_timeout_job = [](GC::Ref<GC::Function<void()>> job, JS::Realm& realm, double milliseconds) {
+        // 1. Let global be realm's global object.
+        auto& global = realm.global_object();
+
+        // FIXME: Worklet global scopes have no timers, so a timeout job queued in one never runs.
+        auto* window_or_worker = as_if<HTML::WindowOrWorkerGlobalScopeMixin>(global);
+        if (!window_or_worker)
+            return;
+
+        // 2. Let timeoutStep be a job that queues a global task on the JavaScript engine task source given global to perform job().
+        // NB: The timer's steps aren't visited by the GC, so they keep the job alive through a root.
+        auto timeout_step = [&realm, &global, job = GC::make_root(job)] {
+            HTML::queue_global_task(HTML::Task::Source::JavaScriptEngine, global, GC::create_function(realm.heap(), [&realm, job] {
+                HTML::TemporaryExecutionContext context { realm };
+                job->function()();
+            }));
+        };
+
+        // 3. Run steps after a timeout given global, "JavaScript", milliseconds, and timeoutStep.
+        window_or_worker->run_steps_after_a_timeout(AK::clamp_to<i32>(milliseconds), move(timeout_step));
+    };
+
     main_thread_vm_ptr()->host_promise_job_queue_is_empty = []() -> bool {
         return HTML::main_thread_event_loop().microtask_queue_empty();
     };
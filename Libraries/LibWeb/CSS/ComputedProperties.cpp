@@ -1663,7 +1663,8 @@ ComputedProperties::Builder::Builder()
 ComputedProperties::Builder::Builder(ComputedProperties const& style)
     : Builder()
 {
-    m_data->property_values = style.data().property_values;
+    m_data->inherited_property_values = style.data().inherited_property_values;
+    m_data->noninherited_property_values = style.data().noninherited_property_values;
     m_data->property_important = style.data().property_important;
     m_data->property_inherited = style.data().property_inherited;
     m_data->display_before_box_type_transformation = style.data().display_before_box_type_transformation;
@@ -1923,7 +1924,7 @@ void ComputedProperties::Builder::set_property_without_modifying_flags(PropertyI
 {
     VERIFY(id >= first_longhand_property_id && id <= last_longhand_property_id);
 
-    data().property_values[to_underlying(id) - to_underlying(first_longhand_property_id)] = move(value);
+    data().mutable_property_value(id) = move(value);
 
     if (property_affects_computed_font_list(id))
         style().clear_computed_font_list_cache();
@@ -1933,7 +1934,7 @@ void ComputedProperties::Builder::revert_property(PropertyID id, ComputedPropert
 {
     VERIFY(id >= first_longhand_property_id && id <= last_longhand_property_id);
 
-    data().property_values[to_underlying(id) - to_underlying(first_longhand_property_id)] = style_for_revert.data().property_values[to_underlying(id) - to_underlying(first_longhand_property_id)];
+    data().mutable_property_value(id) = style_for_revert.data().property_value(id);
     set_property_important(id, style_for_revert.is_property_important(id) ? Important::Yes : Important::No);
     set_property_inherited(id, style_for_revert.is_property_inherited(id) ? Inherited::Yes : Inherited::No);
 
@@ -2024,7 +2025,7 @@ StyleValue const& ComputedProperties::property(PropertyID property_id, WithAnima
     }
 
     // By the time we call this method, the property should have been assigned
-    return *data().property_values[to_underlying(property_id) - to_underlying(first_longhand_property_id)];
+    return *data().property_value(property_id);
 }
 
 Variant<LengthPercentage, NormalGap> ComputedProperties::gap_value(PropertyID id) const
@@ -2870,9 +2871,15 @@ Positioning ComputedProperties::position() const
 
 bool ComputedProperties::operator==(ComputedProperties const& other) const
 {
-    for (size_t i = 0; i < data().property_values.size(); ++i) {
-        auto const& my_style = data().property_values[i];
-        auto const& other_style = other.data().property_values[i];
+    bool inherited_values_are_shared = data().inherited_property_values.ptr() == other.data().inherited_property_values.ptr();
+    bool noninherited_values_are_shared = data().noninherited_property_values.ptr() == other.data().noninherited_property_values.ptr();
+
+    for (size_t i = 0; i < number_of_longhand_properties; ++i) {
+        if (i < inherited_longhand_count ? inherited_values_are_shared : noninherited_values_are_shared)
+            continue;
+        auto property_id = static_cast<PropertyID>(i + to_underlying(first_longhand_property_id));
+        auto const& my_style = data().property_value(property_id);
+        auto const& other_style = other.data().property_value(property_id);
         if (!my_style) {
             if (other_style)
                 return false;
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/CopyOnWrite.h>
 #include <AK/FixedBitmap.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
@@ -138,9 +139,10 @@ public:
     template<typename Callback>
     inline void for_each_property(Callback callback) const
     {
-        for (size_t i = 0; i < m_data->property_values.size(); ++i) {
-            if (m_data->property_values[i])
-                callback(static_cast<PropertyID>(i + to_underlying(first_longhand_property_id)), *m_data->property_values[i]);
+        for (size_t i = 0; i < number_of_longhand_properties; ++i) {
+            auto property_id = static_cast<PropertyID>(i + to_underlying(first_longhand_property_id));
+            if (auto const& value = m_data->property_value(property_id))
+                callback(property_id, *value);
         }
     }
 
@@ -354,11 +356,47 @@ private:
 
     NonnullRefPtr<ComputedProperties> copy_without_animations() const;
 
+    template<size_t Count>
+    class PropertyValueGroup final : public RefCounted<PropertyValueGroup<Count>> {
+    public:
+        NonnullRefPtr<PropertyValueGroup> clone() const
+        {
+            auto clone = adopt_ref(*new PropertyValueGroup);
+            clone->values = values;
+            return clone;
+        }
+
+        Array<RefPtr<StyleValue const>, Count> values;
+    };
+
+    static constexpr size_t inherited_longhand_count = to_underlying(last_inherited_property_id) - to_underlying(first_longhand_property_id) + 1;
+    static constexpr size_t noninherited_longhand_count = number_of_longhand_properties - inherited_longhand_count;
+
     class Data final : public RefCounted<Data> {
     public:
         Data() = default;
 
-        Array<RefPtr<StyleValue const>, number_of_longhand_properties> property_values;
+        RefPtr<StyleValue const> const& property_value(PropertyID property_id) const
+        {
+            size_t index = to_underlying(property_id) - to_underlying(first_longhand_property_id);
+            if (index < inherited_longhand_count)
+                return inherited_property_values.value().values[index];
+            return noninherited_property_values.value().values[index - inherited_longhand_count];
+        }
+
+        RefPtr<StyleValue const>& mutable_property_value(PropertyID property_id)
+        {
+            size_t index = to_underlying(property_id) - to_underlying(first_longhand_property_id);
+            if (index < inherited_longhand_count)
+                return inherited_property_values.mutable_value().values[index];
+            return noninherited_property_values.mutable_value().values[index - inherited_longhand_count];
+        }
+
+        // Inherited and non-inherited values live in separately shared groups, so a copy of a style (e.g. for
+        // recomputing inherited style) only duplicates the group it actually writes to.
+        AK::CopyOnWrite<PropertyValueGroup<inherited_longhand_count>> inherited_property_values;
+        AK::CopyOnWrite<PropertyValueGroup<noninherited_longhand_count>> noninherited_property_values;
+
         AK::FixedBitmap<number_of_longhand_properties> property_important { false };
         AK::FixedBitmap<number_of_longhand_properties> property_inherited { false };
 
@@ -31,6 +31,7 @@
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/MIME.h>
+#include <LibWeb/Fetch/Infrastructure/NetworkPartitionKey.h>
 #include <LibWeb/Fetch/Response.h>
 #include <LibWeb/MimeSniff/Resource.h>
 #include <LibWeb/Platform/FontPlugin.h>
@@ -40,6 +41,32 @@ namespace Web::CSS {
 GC_DEFINE_ALLOCATOR(FontComputer);
 GC_DEFINE_ALLOCATOR(FontLoader);
 
+static unsigned computed_font_cache_key_hash(StyleValue const& font_family, CSSPixels font_size, int font_slope, double font_weight, Percentage const& font_width, FontOpticalSizing font_optical_sizing, HashMap<Utf16FlyString, double> const& font_variation_settings, FontFeatureData const& font_feature_data)
+{
+    unsigned hash = 0;
+    for (auto const& family_value : font_family.as_value_list().values()) {
+        if (family_value->is_keyword())
+            hash = pair_int_hash(hash, to_underlying(family_value->as_keyword().keyword()));
+        else
+            hash = pair_int_hash(hash, string_from_style_value(family_value).hash());
+    }
+
+    hash = pair_int_hash(hash, to_underlying(font_optical_sizing));
+    hash = pair_int_hash(hash, Traits<CSSPixels>::hash(font_size));
+    hash = pair_int_hash(hash, font_slope);
+    hash = pair_int_hash(hash, Traits<double>::hash(font_weight));
+    hash = pair_int_hash(hash, Traits<double>::hash(font_width.value()));
+
+    // NB: Equal maps don't necessarily iterate in the same order, so the axes are combined order-independently.
+    unsigned variations_hash = 0;
+    for (auto const& [variation_name, variation_value] : font_variation_settings)
+        variations_hash ^= pair_int_hash(variation_name.hash(), Traits<double>::hash(variation_value));
+    hash = pair_int_hash(hash, variations_hash);
+    hash = pair_int_hash(hash, Traits<FontFeatureData>::hash(font_feature_data));
+
+    return hash;
+}
+
 }
 
 namespace AK {
@@ -53,24 +80,7 @@ template<>
 struct Traits<Web::CSS::ComputedFontCacheKey> : public DefaultTraits<Web::CSS::ComputedFontCacheKey> {
     static unsigned hash(Web::CSS::ComputedFontCacheKey const& key)
     {
-        unsigned hash = 0;
-        for (auto const& family_value : key.font_family->as_value_list().values()) {
-            if (family_value->is_keyword())
-                hash = pair_int_hash(hash, to_underlying(family_value->as_keyword().keyword()));
-            else
-                hash = string_from_style_value(family_value).hash();
-        }
-
-        hash = pair_int_hash(hash, to_underlying(key.font_optical_sizing));
-        hash = pair_int_hash(hash, Traits<Web::CSSPixels>::hash(key.font_size));
-        hash = pair_int_hash(hash, key.font_slope);
-        hash = pair_int_hash(hash, Traits<double>::hash(key.font_weight));
-        hash = pair_int_hash(hash, Traits<double>::hash(key.font_width.value()));
-        for (auto const& [variation_name, variation_value] : key.font_variation_settings)
-            hash = pair_int_hash(hash, pair_int_hash(variation_name.hash(), Traits<double>::hash(variation_value)));
-        hash = pair_int_hash(hash, Traits<Web::CSS::FontFeatureData>::hash(key.font_feature_data));
-
-        return hash;
+        return Web::CSS::computed_font_cache_key_hash(*key.font_family, key.font_size, key.font_slope, key.font_weight, key.font_width, key.font_optical_sizing, key.font_variation_settings, key.font_feature_data);
     }
 };
 
@@ -173,8 +183,9 @@ void FontLoader::start_loading_next_url()
                 return;
             }
 
+            auto cache_partition = Fetch::Infrastructure::determine_the_network_partition_key(*loader->m_rule_or_declaration.environment_settings_object).serialized_top_level_site();
             auto loader_handle = GC::make_root(GC::Ref(*loader));
-            prepare_vector_font_data_off_thread(move(bytes), [loader = move(loader_handle)](auto prepared_font_data) mutable {
+            prepare_vector_font_data_off_thread(move(bytes), mime_type_essence, move(cache_partition), [loader = move(loader_handle)](auto prepared_font_data) mutable {
                 if (prepared_font_data.is_error()) {
                     // NB: If we have other sources available, try the next one.
                     if (loader->m_urls.is_empty()) {
@@ -501,20 +512,37 @@ HashMap<FontFeatureValueKey, Vector<u32>> const& FontComputer::font_feature_valu
 
 NonnullRefPtr<Gfx::FontCascadeList const> FontComputer::compute_font_for_style_values(StyleValue const& font_family, CSSPixels const& font_size, int font_slope, double font_weight, Percentage const& font_width, FontOpticalSizing font_optical_sizing, HashMap<Utf16FlyString, double> const& font_variation_settings, FontFeatureData const& font_feature_data) const
 {
-    ComputedFontCacheKey cache_key {
-        .font_family = font_family,
-        .font_optical_sizing = font_optical_sizing,
-        .font_size = font_size,
-        .font_slope = font_slope,
-        .font_weight = font_weight,
-        .font_width = font_width,
-        .font_variation_settings = font_variation_settings,
-        .font_feature_data = font_feature_data,
-    };
-
-    return m_computed_font_cache.ensure(cache_key, [&]() {
-        return compute_font_for_style_values_impl(font_family, font_size, font_slope, font_weight, font_width, font_optical_sizing, font_variation_settings, font_feature_data);
+    // OPTIMIZATION: Most lookups hit, so compare against the arguments directly. The key, which owns copies of the
+    //               variation and feature maps, is only built when a new entry has to be added.
+    auto hash = computed_font_cache_key_hash(font_family, font_size, font_slope, font_weight, font_width, font_optical_sizing, font_variation_settings, font_feature_data);
+    auto it = m_computed_font_cache.find(hash, [&](auto const& entry) {
+        auto const& key = entry.key;
+        return key.font_size == font_size
+            && key.font_slope == font_slope
+            && key.font_weight == font_weight
+            && key.font_width == font_width
+            && key.font_optical_sizing == font_optical_sizing
+            && key.font_family->equals(font_family)
+            && key.font_variation_settings == font_variation_settings
+            && key.font_feature_data == font_feature_data;
     });
+    if (it != m_computed_font_cache.end())
+        return it->value;
+
+    auto font_list = compute_font_for_style_values_impl(font_family, font_size, font_slope, font_weight, font_width, font_optical_sizing, font_variation_settings, font_feature_data);
+    m_computed_font_cache.set(
+        ComputedFontCacheKey {
+            .font_family = font_family,
+            .font_optical_sizing = font_optical_sizing,
+            .font_size = font_size,
+            .font_slope = font_slope,
+            .font_weight = font_weight,
+            .font_width = font_width,
+            .font_variation_settings = font_variation_settings,
+            .font_feature_data = font_feature_data,
+        },
+        font_list);
+    return font_list;
 }
 
 NonnullRefPtr<Gfx::FontCascadeList const> FontComputer::compute_font_for_style_values_impl(StyleValue const& font_family, CSSPixels const& font_size, int slope, double font_weight, Percentage const& font_width, FontOpticalSizing font_optical_sizing, HashMap<Utf16FlyString, double> const& font_variation_settings, FontFeatureData const& font_feature_data) const
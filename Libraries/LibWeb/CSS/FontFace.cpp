@@ -31,6 +31,8 @@
 #include <LibWeb/CSS/StyleValues/StyleValueList.h>
 #include <LibWeb/CSS/StyleValues/UnicodeRangeStyleValue.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/Fetch/Infrastructure/NetworkPartitionKey.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
@@ -91,7 +93,7 @@ static int compute_width(StyleValue const& value)
     return static_cast<int>(StyleComputer::compute_font_width(value)->as_percentage().raw_value());
 }
 
-static NonnullRefPtr<Core::Promise<NonnullRefPtr<Gfx::Typeface const>>> load_vector_font([[maybe_unused]] JS::Realm& realm, ByteBuffer data)
+static NonnullRefPtr<Core::Promise<NonnullRefPtr<Gfx::Typeface const>>> load_vector_font(JS::Realm& realm, ByteBuffer data)
 {
     auto promise = Core::Promise<NonnullRefPtr<Gfx::Typeface const>>::construct();
 
@@ -106,7 +108,8 @@ static NonnullRefPtr<Core::Promise<NonnullRefPtr<Gfx::Typeface const>>> load_vec
         return promise;
     }
 
-    prepare_vector_font_data_off_thread(move(data), [promise](auto prepared_font_data) {
+    auto cache_partition = Fetch::Infrastructure::determine_the_network_partition_key(HTML::principal_realm_settings_object(realm)).serialized_top_level_site();
+    prepare_vector_font_data_off_thread(move(data), {}, move(cache_partition), [promise](auto prepared_font_data) {
         if (prepared_font_data.is_error()) {
             promise->reject(prepared_font_data.release_error());
             return;
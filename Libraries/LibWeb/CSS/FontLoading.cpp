@@ -6,23 +6,44 @@
 
 #include <AK/Endian.h>
 #include <LibCore/EventLoop.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibGfx/Font/WOFF/Loader.h>
 #include <LibGfx/Font/WOFF2/Loader.h>
+#include <LibRequests/RequestClient.h>
 #include <LibThreading/ThreadPool.h>
 #include <LibWeb/CSS/FontLoading.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 
 namespace Web::CSS {
 
+static constexpr u32 woff_signature = 0x774F4646;
 static constexpr u32 woff2_signature = 0x774F4632;
 
-bool requires_off_thread_vector_font_preparation(ByteBuffer const& data, Optional<ByteString> const& mime_type_essence)
+enum class CompressedFontFormat {
+    WOFF,
+    WOFF2,
+};
+
+static Optional<CompressedFontFormat> compressed_font_format(ReadonlyBytes data, Optional<ByteString> const& mime_type_essence)
 {
+    // INTEROP: font/x-woff is a legacy alias that remains in use on the web.
+    if (mime_type_essence == "font/woff"sv || mime_type_essence == "application/font-woff"sv || mime_type_essence == "font/x-woff"sv)
+        return CompressedFontFormat::WOFF;
     if (mime_type_essence == "font/woff2"sv || mime_type_essence == "application/font-woff2"sv)
-        return true;
+        return CompressedFontFormat::WOFF2;
     if (data.size() < sizeof(u32))
-        return false;
+        return {};
     auto signature = *bit_cast<BigEndian<u32> const*>(data.data());
-    return signature == woff2_signature;
+    if (signature == woff_signature)
+        return CompressedFontFormat::WOFF;
+    if (signature == woff2_signature)
+        return CompressedFontFormat::WOFF2;
+    return {};
+}
+
+bool requires_off_thread_vector_font_preparation(ByteBuffer const& data, Optional<ByteString> const& mime_type_essence)
+{
+    return compressed_font_format(data, mime_type_essence).has_value();
 }
 
 ErrorOr<NonnullRefPtr<Gfx::Typeface const>> try_load_vector_font(ByteBuffer const& data, Optional<ByteString> const& mime_type_essence)
@@ -59,20 +80,73 @@ ErrorOr<NonnullRefPtr<Gfx::Typeface const>> try_load_vector_font(ByteBuffer cons
     return Error::from_string_literal("Automatic format detection failed");
 }
 
-void prepare_vector_font_data_off_thread(ByteBuffer data, Function<void(ErrorOr<Core::AnonymousBuffer>)>&& on_complete)
+struct DecompressedFontCacheKey {
+    ByteString partition;
+    ::Crypto::Hash::SHA256::DigestType font_hash;
+};
+
+using PreparedFontDataCallback = Function<void(ErrorOr<Core::AnonymousBuffer>)>;
+
+static bool can_use_decompressed_font_cache()
+{
+    return ResourceLoader::is_initialized() && ResourceLoader::the().request_client();
+}
+
+static void decompress_font_off_thread(ByteBuffer data, CompressedFontFormat format, Optional<DecompressedFontCacheKey> cache_key, PreparedFontDataCallback* callback, Core::EventLoop& origin_event_loop)
+{
+    Threading::ThreadPool::the().submit(
+        [data = move(data), format, cache_key = move(cache_key), callback, &origin_event_loop]() mutable {
+            auto result = format == CompressedFontFormat::WOFF ? WOFF::convert_to_ttf(data) : WOFF2::convert_to_ttf(data);
+
+            origin_event_loop.deferred_invoke([callback, cache_key = move(cache_key), result = move(result)]() mutable {
+                if (cache_key.has_value() && !result.is_error() && can_use_decompressed_font_cache())
+                    (void)ResourceLoader::the().request_client()->store_decompressed_font(cache_key->partition, cache_key->font_hash.bytes(), result.value().bytes());
+                (*callback)(move(result));
+                delete callback;
+            });
+        });
+}
+
+void prepare_vector_font_data_off_thread(ByteBuffer data, Optional<ByteString> const& mime_type_essence, Optional<ByteString> cache_partition, PreparedFontDataCallback&& on_complete)
 {
     // Keep the callback on the origin thread so any GC roots it captures are
     // also destroyed there.
-    auto* callback = new Function<void(ErrorOr<Core::AnonymousBuffer>)>(move(on_complete));
+    auto* callback = new PreparedFontDataCallback(move(on_complete));
     auto& origin_event_loop = Core::EventLoop::current();
 
+    auto format = compressed_font_format(data, mime_type_essence).value_or(CompressedFontFormat::WOFF2);
+
+    if (!cache_partition.has_value() || !can_use_decompressed_font_cache()) {
+        decompress_font_off_thread(move(data), format, {}, callback, origin_event_loop);
+        return;
+    }
+
+    // OPTIMIZATION: RequestServer keeps the fonts we decompressed before, keyed by a hash of the compressed bytes and
+    //               partitioned by top-level site. The hash is computed on the thread pool, and the lookup is
+    //               asynchronous, so that neither blocks the main thread.
     Threading::ThreadPool::the().submit(
-        [data = move(data), callback, &origin_event_loop]() mutable {
-            auto result = WOFF2::convert_to_ttf(data);
+        [data = move(data), format, partition = cache_partition.release_value(), callback, &origin_event_loop]() mutable {
+            auto font_hash = ::Crypto::Hash::SHA256::hash(data.data(), data.size());
 
-            origin_event_loop.deferred_invoke([callback, result = move(result)]() mutable {
-                (*callback)(move(result));
-                delete callback;
+            origin_event_loop.deferred_invoke([data = move(data), format, cache_key = DecompressedFontCacheKey { move(partition), font_hash }, callback, &origin_event_loop]() mutable {
+                if (!can_use_decompressed_font_cache()) {
+                    decompress_font_off_thread(move(data), format, {}, callback, origin_event_loop);
+                    return;
+                }
+
+                // NB: The key is moved into the completion callback, so the arguments to look it up with are copied first.
+                auto lookup_partition = cache_key.partition;
+                auto lookup_font_hash = cache_key.font_hash;
+
+                ResourceLoader::the().request_client()->retrieve_decompressed_font(lookup_partition, lookup_font_hash.bytes(), [data = move(data), format, cache_key = move(cache_key), callback, &origin_event_loop](Optional<Core::AnonymousBuffer> cached_font_data) mutable {
+                    if (!cached_font_data.has_value()) {
+                        decompress_font_off_thread(move(data), format, move(cache_key), callback, origin_event_loop);
+                        return;
+                    }
+
+                    (*callback)(cached_font_data.release_value());
+                    delete callback;
+                });
             });
         });
 }
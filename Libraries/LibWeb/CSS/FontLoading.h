@@ -17,6 +17,8 @@ namespace Web::CSS {
 
 bool requires_off_thread_vector_font_preparation(ByteBuffer const&, Optional<ByteString> const& mime_type_essence = {});
 ErrorOr<NonnullRefPtr<Gfx::Typeface const>> try_load_vector_font(ByteBuffer const&, Optional<ByteString> const& mime_type_essence = {});
-void prepare_vector_font_data_off_thread(ByteBuffer, Function<void(ErrorOr<Core::AnonymousBuffer>)>&&);
+// Decompressed fonts are cached in RequestServer when a cache partition (the serialized top-level site the font is
+// loaded for) is given.
+void prepare_vector_font_data_off_thread(ByteBuffer, Optional<ByteString> const& mime_type_essence, Optional<ByteString> cache_partition, Function<void(ErrorOr<Core::AnonymousBuffer>)>&&);
 
 }
@@ -209,7 +209,7 @@ double Length::container_relative_length_to_px_without_rounding(ResolutionContex
         }
 
         auto& subject = *context.subject_element;
-        const_cast<DOM::Element&>(subject).set_style_depends_on_size_container_query();
+        const_cast<DOM::Element&>(subject).set_style_depends_on_container_relative_length();
 
         auto query_container = get_or_compute_query_container_for_axis(context, physical_axis);
         if (!query_container) {
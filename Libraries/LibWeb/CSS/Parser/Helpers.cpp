@@ -69,7 +69,7 @@ GC::Ref<CSS::CSSStyleSheet> parse_css_stylesheet(CSS::Parser::ParsingParams cons
         style_sheet->set_source_text({});
         return style_sheet;
     }
-    auto style_sheet = CSS::Parser::Parser::create(context, css).parse_as_css_stylesheet(location, move(media_list));
+    auto style_sheet = CSS::Parser::Parser::parse_as_css_stylesheet_with_shared_rules(context, css, move(location), move(media_list));
     style_sheet->set_source_text(Utf16String::from_utf16(css));
     return style_sheet;
 }
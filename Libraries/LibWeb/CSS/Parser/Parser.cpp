@@ -13,6 +13,8 @@
  */
 
 #include <AK/Debug.h>
+#include <LibCore/EventLoop.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibURL/Parser.h>
 #include <LibWeb/CSS/CSSFontFeatureValuesRule.h>
 #include <LibWeb/CSS/CSSFunctionDeclarations.h>
@@ -26,6 +28,7 @@
 #include <LibWeb/CSS/Parser/ArbitrarySubstitutionFunctions.h>
 #include <LibWeb/CSS/Parser/ErrorReporter.h>
 #include <LibWeb/CSS/Parser/Parser.h>
+#include <LibWeb/CSS/Parser/RustTokenizer.h>
 #include <LibWeb/CSS/PropertyName.h>
 #include <LibWeb/CSS/PropertyNameAndID.h>
 #include <LibWeb/CSS/Sizing.h>
@@ -199,6 +202,97 @@ GC::Ref<CSS::CSSStyleSheet> Parser::parse_as_css_stylesheet(Optional<::URL::URL>
     return CSSStyleSheet::create(realm(), rule_list, *media_list, move(location));
 }
 
+// The rules consumed from the most recently parsed style sheet sources. Consuming rules only depends on the source
+// text, while converting them into CSSOM rules depends on the document, so documents in the same process that load
+// the same style sheet (e.g. same-site iframes sharing a <link>) only have to do the latter.
+struct SharedStyleSheetRules {
+    u32 source_hash { 0 };
+    Utf16String source;
+    Vector<Rule> rules;
+};
+
+static constexpr size_t max_shared_style_sheet_rules = 16;
+
+static Vector<NonnullOwnPtr<SharedStyleSheetRules>>& shared_style_sheet_rules()
+{
+    static auto& entries = *new Vector<NonnullOwnPtr<SharedStyleSheetRules>>;
+    return entries;
+}
+
+// Moves the entry for the given source to the front, keeping the entries in most recently used order.
+static bool find_shared_style_sheet_rules(Utf16View source, u32 source_hash)
+{
+    auto& entries = shared_style_sheet_rules();
+    auto index = entries.find_first_index_if([&](auto const& entry) {
+        return entry->source_hash == source_hash && entry->source.utf16_view() == source;
+    });
+    if (!index.has_value())
+        return false;
+    if (*index != 0)
+        entries.prepend(entries.take(*index));
+    return true;
+}
+
+static void add_shared_style_sheet_rules(Utf16View source, u32 source_hash, Vector<Rule> rules)
+{
+    auto& entries = shared_style_sheet_rules();
+    if (entries.size() == max_shared_style_sheet_rules)
+        entries.take_last();
+    entries.prepend(make<SharedStyleSheetRules>(source_hash, Utf16String::from_utf16(source), move(rules)));
+}
+
+GC::Ref<CSS::CSSStyleSheet> Parser::parse_as_css_stylesheet_with_shared_rules(ParsingParams const& context, Utf16View input, Optional<::URL::URL> location, GC::Ptr<MediaList> media_list)
+{
+    // Nested rule contexts change how rules are consumed, so only top-level style sheets can share them.
+    if (!context.rule_context.is_empty())
+        return Parser::create(context, input).parse_as_css_stylesheet(move(location), move(media_list));
+
+    auto source_hash = input.hash();
+    if (!find_shared_style_sheet_rules(input, source_hash)) {
+        auto parser = Parser::create(context, input);
+        auto parsed_style_sheet = parser.parse_a_stylesheet(parser.m_token_stream, {});
+        add_shared_style_sheet_rules(input, source_hash, move(parsed_style_sheet.rules));
+    }
+
+    Parser parser { context, {} };
+    auto rule_list = CSSRuleList::create(parser.realm(), parser.convert_rules(shared_style_sheet_rules().first()->rules));
+    if (!media_list)
+        media_list = MediaList::create(parser.realm(), {});
+    return CSSStyleSheet::create(parser.realm(), rule_list, *media_list, move(location));
+}
+
+void Parser::prepare_shared_rules_off_thread(Utf16String source, Function<void()> on_complete)
+{
+    struct PendingTokenization {
+        Utf16String source;
+        Function<void()> on_complete;
+    };
+
+    // The source stays alive on the main thread while the worker reads it, and only the main thread touches its
+    // reference count.
+    auto* pending = new PendingTokenization { move(source), move(on_complete) };
+    auto source_view = pending->source.utf16_view();
+
+    auto& main_thread_event_loop = Core::EventLoop::current();
+
+    Threading::ThreadPool::the().submit([source_view, pending, &main_thread_event_loop]() {
+        auto owned_tokens = RustTokenizer::tokenize_without_interning(source_view);
+        main_thread_event_loop.deferred_invoke([owned_tokens = move(owned_tokens), pending]() {
+            // Interning the token text and consuming the rules both touch main-thread-only state, so they happen here.
+            auto source_view = pending->source.utf16_view();
+            auto source_hash = source_view.hash();
+            if (!find_shared_style_sheet_rules(source_view, source_hash)) {
+                Parser parser { ParsingParams {}, owned_tokens.to_tokens() };
+                auto parsed_style_sheet = parser.parse_a_stylesheet(parser.m_token_stream, {});
+                add_shared_style_sheet_rules(source_view, source_hash, move(parsed_style_sheet.rules));
+            }
+            pending->on_complete();
+            delete pending;
+        });
+    },
+        Threading::TaskPriority::UserBlocking);
+}
+
 RefPtr<Supports> Parser::parse_as_supports()
 {
     return parse_a_supports(m_token_stream);
@@ -2383,6 +2477,11 @@ NonnullRefPtr<StyleValue const> Parser::parse_as_sizes_attribute(DOM::Element co
     if (!element.has_attribute(HTML::AttributeNames::sizes))
         return LengthStyleValue::create(Length(100, LengthUnit::Vw));
 
+    return parse_as_sizes_attribute(img);
+}
+
+NonnullRefPtr<StyleValue const> Parser::parse_as_sizes_attribute(HTML::HTMLImageElement const* img)
+{
     // 1. Let unparsed sizes list be the result of parsing a comma-separated list of component values
     //    from the value of element's sizes attribute (or the empty string, if the attribute is absent).
     // NOTE: The sizes attribute has already been tokenized into m_token_stream by this point.
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/Function.h>
 #include <AK/NonnullRawPtr.h>
 #include <AK/RefPtr.h>
 #include <AK/Utf16String.h>
@@ -140,6 +141,11 @@ public:
 
     GC::RootVector<GC::Ref<CSSRule>> convert_rules(Vector<Rule> const& raw_rules);
     GC::Ref<CSS::CSSStyleSheet> parse_as_css_stylesheet(Optional<::URL::URL> location, GC::Ptr<MediaList> = {});
+    // Like parse_as_css_stylesheet(), but reuses the rules consumed from identical source text earlier in this process.
+    static GC::Ref<CSS::CSSStyleSheet> parse_as_css_stylesheet_with_shared_rules(ParsingParams const&, Utf16View input, Optional<::URL::URL> location, GC::Ptr<MediaList> = {});
+    // Tokenizes the source on the thread pool, then consumes its rules on the main thread, so that a following
+    // parse_as_css_stylesheet_with_shared_rules() for the same source only has to turn them into CSS rules.
+    static void prepare_shared_rules_off_thread(Utf16String source, Function<void()> on_complete);
 
     struct PropertiesAndCustomProperties {
         Vector<StyleProperty> properties;
@@ -186,6 +192,8 @@ public:
     static NonnullRefPtr<StyleValue const> resolve_unresolved_style_value(ParsingParams const&, AbstractOrHypotheticalElement, ArbitrarySubstitutionReplacementContext const&, PropertyNameAndID const&, UnresolvedStyleValue const&, Optional<GuardedSubstitutionContexts&> = {});
 
     [[nodiscard]] NonnullRefPtr<StyleValue const> parse_as_sizes_attribute(DOM::Element const& element, HTML::HTMLImageElement const* img = nullptr);
+    // For a sizes attribute that is known to be present, but not (yet) on an element.
+    [[nodiscard]] NonnullRefPtr<StyleValue const> parse_as_sizes_attribute(HTML::HTMLImageElement const* img);
 
     enum class DisallowTopLevelCurlyBlocks : u8 {
         No,
@@ -19,43 +19,15 @@ namespace Web::CSS::Parser {
 // U+FFFD REPLACEMENT CHARACTER (�)
 static constexpr u32 REPLACEMENT_CHARACTER = 0xFFFD;
 
-static String decode_and_filter_code_points(StringView input, StringView encoding, TokenizerInput tokenizer_input)
+// https://www.w3.org/TR/css-syntax-3/#css-filter-code-points
+template<typename CodePoints>
+static String filter_code_points(CodePoints const& code_points, size_t length_hint)
 {
-    // https://www.w3.org/TR/css-syntax-3/#css-filter-code-points
-    auto standardized_encoding = TextCodec::get_standardized_encoding(encoding);
-    VERIFY(standardized_encoding.has_value());
-    auto decoder = TextCodec::decoder_for(encoding);
-    VERIFY(decoder.has_value());
-
-    auto decoded_input = [&] {
-        if (tokenizer_input == TokenizerInput::DecodedText) {
-            VERIFY(Utf8View { input }.validate());
-            return String::from_utf8_without_validation(input.bytes());
-        }
-        if (standardized_encoding->equals_ignoring_ascii_case("utf-8"sv) && Utf8View { input }.validate(AllowLonelySurrogates::No)) {
-            if (input.bytes().starts_with({ { 0xef, 0xbb, 0xbf } }))
-                input = input.substring_view(3);
-            return String::from_utf8_without_validation(input.bytes());
-        }
-        return MUST(decoder->to_utf8(input, TextCodec::IgnoreBOM::No, TextCodec::ErrorMode::Replacement));
-    }();
-
-    // OPTIMIZATION: If the input doesn't contain any filterable characters, we can skip the filtering
-    bool const contains_filterable = [&] {
-        for (auto code_point : decoded_input.code_points()) {
-            if (code_point == '\r' || code_point == '\f' || code_point == 0x00 || is_unicode_surrogate(code_point))
-                return true;
-        }
-        return false;
-    }();
-    if (!contains_filterable)
-        return decoded_input;
-
-    StringBuilder builder { input.length() };
+    StringBuilder builder { length_hint };
     bool last_was_carriage_return = false;
 
     // To filter code points from a stream of (unfiltered) code points input:
-    for (auto code_point : decoded_input.code_points()) {
+    for (auto code_point : code_points) {
         // Replace any U+000D CARRIAGE RETURN (CR) code points,
         // U+000C FORM FEED (FF) code points,
         // or pairs of U+000D CARRIAGE RETURN (CR) followed by U+000A LINE FEED (LF)
@@ -90,6 +62,40 @@ static String decode_and_filter_code_points(StringView input, StringView encodin
     return builder.to_string_without_validation();
 }
 
+static String decode_and_filter_code_points(StringView input, StringView encoding, TokenizerInput tokenizer_input)
+{
+    auto standardized_encoding = TextCodec::get_standardized_encoding(encoding);
+    VERIFY(standardized_encoding.has_value());
+    auto decoder = TextCodec::decoder_for(encoding);
+    VERIFY(decoder.has_value());
+
+    auto decoded_input = [&] {
+        if (tokenizer_input == TokenizerInput::DecodedText) {
+            VERIFY(Utf8View { input }.validate());
+            return String::from_utf8_without_validation(input.bytes());
+        }
+        if (standardized_encoding->equals_ignoring_ascii_case("utf-8"sv) && Utf8View { input }.validate(AllowLonelySurrogates::No)) {
+            if (input.bytes().starts_with({ { 0xef, 0xbb, 0xbf } }))
+                input = input.substring_view(3);
+            return String::from_utf8_without_validation(input.bytes());
+        }
+        return MUST(decoder->to_utf8(input, TextCodec::IgnoreBOM::No, TextCodec::ErrorMode::Replacement));
+    }();
+
+    // OPTIMIZATION: If the input doesn't contain any filterable characters, we can skip the filtering
+    bool const contains_filterable = [&] {
+        for (auto code_point : decoded_input.code_points()) {
+            if (code_point == '\r' || code_point == '\f' || code_point == 0x00 || is_unicode_surrogate(code_point))
+                return true;
+        }
+        return false;
+    }();
+    if (!contains_filterable)
+        return decoded_input;
+
+    return filter_code_points(decoded_input.code_points(), input.length());
+}
+
 static Number::Type css_number_type_from_ffi(FFI::CssNumberType number_type)
 {
     switch (number_type) {
@@ -262,4 +268,68 @@ Vector<Token> RustTokenizer::tokenize(StringView input, StringView encoding, Tok
     return move(context.tokens);
 }
 
+RustTokenizer::OwnedTokens RustTokenizer::tokenize_without_interning(Utf16View input)
+{
+    OwnedTokens owned_tokens;
+    owned_tokens.m_filtered_input = filter_code_points(input, input.length_in_code_units());
+    auto filtered_input_bytes = owned_tokens.m_filtered_input.bytes();
+    owned_tokens.m_entries.ensure_capacity((filtered_input_bytes.size() / 2) + 1);
+    owned_tokens.m_values.ensure_capacity(filtered_input_bytes.size());
+    FFI::rust_css_tokenize(
+        filtered_input_bytes.data(),
+        filtered_input_bytes.size(),
+        &owned_tokens,
+        [](void* raw_context, FFI::CssToken const* ffi_token) {
+            auto& owned_tokens = *static_cast<OwnedTokens*>(raw_context);
+            // The original source text always points into the filtered input, so only its offset needs keeping.
+            auto original_source_start = static_cast<size_t>(ffi_token->original_source_ptr - owned_tokens.m_filtered_input.bytes().data());
+            auto value_start = owned_tokens.m_values.size();
+            owned_tokens.m_values.append(reinterpret_cast<char16_t const*>(ffi_token->value_ptr), ffi_token->value_len);
+            owned_tokens.m_entries.append({
+                .token_type = static_cast<u8>(ffi_token->token_type),
+                .hash_type = static_cast<u8>(ffi_token->hash_type),
+                .number_type = static_cast<u8>(ffi_token->number_type),
+                .delim = ffi_token->delim,
+                .number_value = ffi_token->number_value,
+                .value_start = value_start,
+                .value_length = ffi_token->value_len,
+                .original_source_start = original_source_start,
+                .original_source_length = ffi_token->original_source_len,
+                .start_line = ffi_token->start_line,
+                .start_column = ffi_token->start_column,
+                .end_line = ffi_token->end_line,
+                .end_column = ffi_token->end_column,
+            });
+        });
+
+    return owned_tokens;
+}
+
+Vector<Token> RustTokenizer::OwnedTokens::to_tokens() const
+{
+    auto filtered_input_bytes = m_filtered_input.bytes();
+
+    Vector<Token> tokens;
+    tokens.ensure_capacity(m_entries.size());
+    for (auto const& entry : m_entries) {
+        FFI::CssToken ffi_token {
+            .token_type = static_cast<FFI::CssTokenType>(entry.token_type),
+            .hash_type = static_cast<FFI::CssHashType>(entry.hash_type),
+            .number_type = static_cast<FFI::CssNumberType>(entry.number_type),
+            .number_value = entry.number_value,
+            .delim = entry.delim,
+            .value_ptr = reinterpret_cast<u16 const*>(m_values.data() + entry.value_start),
+            .value_len = entry.value_length,
+            .original_source_ptr = filtered_input_bytes.data() + entry.original_source_start,
+            .original_source_len = entry.original_source_length,
+            .start_line = entry.start_line,
+            .start_column = entry.start_column,
+            .end_line = entry.end_line,
+            .end_column = entry.end_column,
+        };
+        tokens.unchecked_append(token_from_ffi(ffi_token));
+    }
+    return tokens;
+}
+
 }
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/String.h>
 #include <AK/StringView.h>
+#include <AK/Utf16View.h>
 #include <AK/Vector.h>
 #include <LibWeb/CSS/Parser/Token.h>
 #include <LibWeb/CSS/Parser/Tokenizer.h>
@@ -22,8 +24,42 @@ namespace Web::CSS::Parser {
 
 class WEB_API RustTokenizer {
 public:
+    // Tokens whose text still lives in buffers owned by this list rather than in interned strings. Interning is only
+    // safe on the main thread, so this lets the tokenizing itself happen on any thread.
+    class OwnedTokens {
+    public:
+        // Must be called on the main thread.
+        Vector<Token> to_tokens() const;
+
+    private:
+        friend class RustTokenizer;
+
+        struct Entry {
+            u8 token_type { 0 };
+            u8 hash_type { 0 };
+            u8 number_type { 0 };
+            u32 delim { 0 };
+            double number_value { 0 };
+            size_t value_start { 0 };
+            size_t value_length { 0 };
+            size_t original_source_start { 0 };
+            size_t original_source_length { 0 };
+            size_t start_line { 0 };
+            size_t start_column { 0 };
+            size_t end_line { 0 };
+            size_t end_column { 0 };
+        };
+
+        String m_filtered_input;
+        Vector<char16_t> m_values;
+        Vector<Entry> m_entries;
+    };
+
     static Vector<Token> tokenize(StringView input, StringView encoding, TokenizerInput = TokenizerInput::DecodedText);
 
+    // Safe to call from any thread.
+    static OwnedTokens tokenize_without_interning(Utf16View input);
+
 private:
     static Token token_from_ffi(FFI::CssToken const&);
 };
@@ -44,6 +44,8 @@ public:
             m_bits[i] |= other.m_bits[i];
     }
 
+    bool operator==(PseudoClassBitmap const&) const = default;
+
 private:
     Array<u64, word_count> m_bits {};
 };
@@ -6,6 +6,7 @@
  */
 
 #include "Selector.h"
+#include <AK/AnyOf.h>
 #include <AK/GenericShorthands.h>
 #include <AK/NeverDestroyed.h>
 #include <LibWeb/CSS/AncestorFilter.h>
@@ -32,6 +33,27 @@ static bool component_value_contains_nesting_selector(Parser::ComponentValue con
     return false;
 }
 
+// Pseudo-classes whose matching computes or caches something on first use, like an element's directionality or
+// language, its validity or a copy of its document's URL, rather than only reading the DOM.
+static constexpr Array main_thread_only_pseudo_classes {
+    PseudoClass::Default,
+    PseudoClass::Dir,
+    PseudoClass::EvenLessGoodValue,
+    PseudoClass::HighValue,
+    PseudoClass::Invalid,
+    PseudoClass::Lang,
+    PseudoClass::LocalLink,
+    PseudoClass::LowValue,
+    PseudoClass::OptimalValue,
+    PseudoClass::PlaceholderShown,
+    PseudoClass::ReadOnly,
+    PseudoClass::ReadWrite,
+    PseudoClass::SuboptimalValue,
+    PseudoClass::UserInvalid,
+    PseudoClass::UserValid,
+    PseudoClass::Valid,
+};
+
 Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     : m_compound_selectors(move(compound_selectors))
 {
@@ -85,6 +107,11 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
 
     collect_ancestor_hashes();
 
+    m_can_be_matched_off_main_thread = !m_contains_the_nesting_selector
+        && !m_contains_slotted_pseudo_element
+        && !m_contains_part_pseudo_element
+        && !any_of(main_thread_only_pseudo_classes, [&](auto pseudo_class) { return m_contained_pseudo_classes.get(pseudo_class); });
+
     m_rust_selector = compile_selector_for_matching(*this);
     VERIFY(m_rust_selector);
     m_target_pseudo_element = pseudo_element_from_ffi(SelectorFFI::rust_selector_target_pseudo_element(m_rust_selector));
@@ -269,6 +269,9 @@ public:
     bool is_slotted() const { return m_contains_slotted_pseudo_element; }
     bool has_part_pseudo_element() const { return m_contains_part_pseudo_element; }
 
+    // Whether matching only reads the DOM, so that it may happen on another thread while the main thread waits.
+    bool can_be_matched_off_main_thread() const { return m_can_be_matched_off_main_thread; }
+
     SelectorFFI::RustSelector const& rust_selector() const
     {
         VERIFY(m_rust_selector);
@@ -285,6 +288,7 @@ private:
     bool m_contains_the_nesting_selector { false };
     bool m_contains_slotted_pseudo_element { false };
     bool m_contains_part_pseudo_element { false };
+    bool m_can_be_matched_off_main_thread { false };
 
     PseudoClassBitmap m_contained_pseudo_classes;
 
@@ -81,6 +81,14 @@ static bool is_excluded_attribute_for_has_filter(Utf16FlyString const& name)
         || name == "style"sv;
 }
 
+static void mark_in_has_scope(MatchContext const& match_context, DOM::Element const& element)
+{
+    if (auto* deferred = match_context.deferred_involvement_metadata)
+        deferred->record(DeferredInvolvementMetadata::Kind::InHasScope, element, match_context.subject);
+    else
+        const_cast<DOM::Element&>(element).set_in_has_scope(true);
+}
+
 static void add_element_identifier_hashes(HasFastRejectFilter& filter, DOM::Element const& element, MatchContext const& context)
 {
     filter.add(salted_tag_name_hash(element.local_name()));
@@ -96,7 +104,7 @@ static void add_element_identifier_hashes(HasFastRejectFilter& filter, DOM::Elem
     });
 
     if (context.inside_has_argument_match && context.collect_per_element_selector_involvement_metadata)
-        const_cast<DOM::Element&>(element).set_in_has_scope(true);
+        mark_in_has_scope(context, element);
 }
 
 static void populate_has_fast_reject_filter(HasFastRejectFilter& filter, DOM::Element const& anchor, HasFastRejectFilterTraversalType traversal_type, MatchContext const& context)
@@ -1059,19 +1067,8 @@ extern "C" CSS::SelectorFFI::ElementAndShadowHost selector_ffi_part_parent(void*
     return {};
 }
 
-static void note_structural_pseudo_class_match_attempt(MatchContext& match_context, DOM::Element& element)
-{
-    if (&element != match_context.subject)
-        element.set_affected_by_structural_pseudo_class_in_non_subject_position();
-}
-
-extern "C" void selector_ffi_note_structural_pseudo_class(void* context, void const* element, u8 pseudo_class_value)
+static void apply_structural_pseudo_class_involvement(DOM::Element& target, GC::Ptr<DOM::Element const> subject, CSS::PseudoClass pseudo_class)
 {
-    auto& match_context = rust_match_context(context);
-    if (!match_context.collect_per_element_selector_involvement_metadata)
-        return;
-    auto& target = const_cast<DOM::Element&>(ffi_element(element));
-    auto pseudo_class = static_cast<CSS::PseudoClass>(pseudo_class_value);
     switch (pseudo_class) {
     case CSS::PseudoClass::FirstChild:
         target.set_affected_by_first_child_pseudo_class(true);
@@ -1100,27 +1097,20 @@ extern "C" void selector_ffi_note_structural_pseudo_class(void* context, void co
     default:
         VERIFY_NOT_REACHED();
     }
-    note_structural_pseudo_class_match_attempt(match_context, target);
+    if (&target != subject)
+        target.set_affected_by_structural_pseudo_class_in_non_subject_position();
 }
 
-extern "C" void selector_ffi_note_has_pseudo_class(void* context, void const* element)
+static void apply_has_pseudo_class_involvement(DOM::Element& target, GC::Ptr<DOM::Element const> subject)
 {
-    auto& match_context = rust_match_context(context);
-    if (!match_context.collect_per_element_selector_involvement_metadata)
-        return;
-    auto& target = const_cast<DOM::Element&>(ffi_element(element));
-    if (&target == match_context.subject)
+    if (&target == subject)
         target.set_affected_by_has_pseudo_class_in_subject_position(true);
     else
         target.set_affected_by_has_pseudo_class_in_non_subject_position();
 }
 
-extern "C" void selector_ffi_note_sibling_combinator(void* context, void const* element, Combinator combinator, size_t sibling_invalidation_distance)
+static void apply_sibling_combinator_involvement(DOM::Element& target, GC::Ptr<DOM::Element const> subject, Combinator combinator, size_t sibling_invalidation_distance)
 {
-    auto& match_context = rust_match_context(context);
-    if (!match_context.collect_per_element_selector_involvement_metadata)
-        return;
-    auto& target = const_cast<DOM::Element&>(ffi_element(element));
     if (combinator == Combinator::NextSibling) {
         target.set_affected_by_direct_sibling_combinator(true);
         target.set_sibling_invalidation_distance(max(sibling_invalidation_distance, target.sibling_invalidation_distance()));
@@ -1128,15 +1118,105 @@ extern "C" void selector_ffi_note_sibling_combinator(void* context, void const*
         VERIFY(combinator == Combinator::SubsequentSibling);
         target.set_affected_by_indirect_sibling_combinator(true);
     }
-    if (&target != match_context.subject)
+    if (&target != subject)
         target.set_affected_by_sibling_combinator_in_non_subject_position();
 }
 
+static void apply_has_sibling_combinator_element_involvement(DOM::Element& target)
+{
+    target.set_in_has_scope(true);
+    target.set_in_subtree_of_has_pseudo_class_relative_selector_with_sibling_combinator(true);
+}
+
+void DeferredInvolvementMetadata::apply(DOM::Document& document)
+{
+    for (auto const& record : m_records) {
+        auto& target = const_cast<DOM::Element&>(*record.element);
+        switch (record.kind) {
+        case Kind::StructuralPseudoClass:
+            apply_structural_pseudo_class_involvement(target, record.subject, static_cast<CSS::PseudoClass>(record.pseudo_class));
+            break;
+        case Kind::HasPseudoClass:
+            apply_has_pseudo_class_involvement(target, record.subject);
+            break;
+        case Kind::NextSiblingCombinator:
+            apply_sibling_combinator_involvement(target, record.subject, Combinator::NextSibling, record.sibling_invalidation_distance);
+            break;
+        case Kind::SubsequentSiblingCombinator:
+            apply_sibling_combinator_involvement(target, record.subject, Combinator::SubsequentSibling, record.sibling_invalidation_distance);
+            break;
+        case Kind::HasSiblingCombinatorAnchor:
+            target.set_affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator(true);
+            break;
+        case Kind::HasSiblingCombinatorElement:
+            apply_has_sibling_combinator_element_involvement(target);
+            break;
+        case Kind::InHasScope:
+            target.set_in_has_scope(true);
+            break;
+        }
+    }
+    m_records.clear();
+
+    auto& counters = document.style_invalidation_counters();
+    counters.has_match_invocations += exchange(has_match_invocations, 0);
+    counters.has_result_cache_hits += exchange(has_result_cache_hits, 0);
+    counters.has_result_cache_misses += exchange(has_result_cache_misses, 0);
+    counters.rules_tried += exchange(rules_tried, 0);
+    counters.rules_matched += exchange(rules_matched, 0);
+}
+
+extern "C" void selector_ffi_note_structural_pseudo_class(void* context, void const* element, u8 pseudo_class_value)
+{
+    auto& match_context = rust_match_context(context);
+    if (!match_context.collect_per_element_selector_involvement_metadata)
+        return;
+    auto const& target = ffi_element(element);
+    if (auto* deferred = match_context.deferred_involvement_metadata) {
+        deferred->record(DeferredInvolvementMetadata::Kind::StructuralPseudoClass, target, match_context.subject, pseudo_class_value);
+        return;
+    }
+    apply_structural_pseudo_class_involvement(const_cast<DOM::Element&>(target), match_context.subject, static_cast<CSS::PseudoClass>(pseudo_class_value));
+}
+
+extern "C" void selector_ffi_note_has_pseudo_class(void* context, void const* element)
+{
+    auto& match_context = rust_match_context(context);
+    if (!match_context.collect_per_element_selector_involvement_metadata)
+        return;
+    auto const& target = ffi_element(element);
+    if (auto* deferred = match_context.deferred_involvement_metadata) {
+        deferred->record(DeferredInvolvementMetadata::Kind::HasPseudoClass, target, match_context.subject);
+        return;
+    }
+    apply_has_pseudo_class_involvement(const_cast<DOM::Element&>(target), match_context.subject);
+}
+
+extern "C" void selector_ffi_note_sibling_combinator(void* context, void const* element, Combinator combinator, size_t sibling_invalidation_distance)
+{
+    auto& match_context = rust_match_context(context);
+    if (!match_context.collect_per_element_selector_involvement_metadata)
+        return;
+    auto const& target = ffi_element(element);
+    if (auto* deferred = match_context.deferred_involvement_metadata) {
+        VERIFY(combinator == Combinator::NextSibling || combinator == Combinator::SubsequentSibling);
+        auto kind = combinator == Combinator::NextSibling ? DeferredInvolvementMetadata::Kind::NextSiblingCombinator : DeferredInvolvementMetadata::Kind::SubsequentSiblingCombinator;
+        deferred->record(kind, target, match_context.subject, 0, sibling_invalidation_distance);
+        return;
+    }
+    apply_sibling_combinator_involvement(const_cast<DOM::Element&>(target), match_context.subject, combinator, sibling_invalidation_distance);
+}
+
 extern "C" void selector_ffi_note_has_sibling_combinator_anchor(void* context, void const* anchor)
 {
     auto& match_context = rust_match_context(context);
-    if (match_context.collect_per_element_selector_involvement_metadata)
-        const_cast<DOM::Element&>(ffi_element(anchor)).set_affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator(true);
+    if (!match_context.collect_per_element_selector_involvement_metadata)
+        return;
+    if (auto* deferred = match_context.deferred_involvement_metadata) {
+        deferred->record(DeferredInvolvementMetadata::Kind::HasSiblingCombinatorAnchor, ffi_element(anchor), match_context.subject);
+        return;
+    }
+    const_cast<DOM::Element&>(ffi_element(anchor)).set_affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator(true);
 }
 
 extern "C" void selector_ffi_note_has_sibling_combinator_element(void* context, void const* element)
@@ -1144,9 +1224,12 @@ extern "C" void selector_ffi_note_has_sibling_combinator_element(void* context,
     auto& match_context = rust_match_context(context);
     if (!match_context.collect_per_element_selector_involvement_metadata)
         return;
-    auto& target = const_cast<DOM::Element&>(ffi_element(element));
-    target.set_in_has_scope(true);
-    target.set_in_subtree_of_has_pseudo_class_relative_selector_with_sibling_combinator(true);
+    auto const& target = ffi_element(element);
+    if (auto* deferred = match_context.deferred_involvement_metadata) {
+        deferred->record(DeferredInvolvementMetadata::Kind::HasSiblingCombinatorElement, target, match_context.subject);
+        return;
+    }
+    apply_has_sibling_combinator_element_involvement(const_cast<DOM::Element&>(target));
 }
 
 extern "C" void selector_ffi_note_has_scope_element(void* context, void const* element)
@@ -1154,7 +1237,7 @@ extern "C" void selector_ffi_note_has_scope_element(void* context, void const* e
     auto& match_context = rust_match_context(context);
     if (match_context.inside_has_argument_match
         && match_context.collect_per_element_selector_involvement_metadata)
-        const_cast<DOM::Element&>(ffi_element(element)).set_in_has_scope(true);
+        mark_in_has_scope(match_context, ffi_element(element));
 }
 
 extern "C" void selector_ffi_set_inside_has_argument(void* context, bool value)
@@ -1165,16 +1248,19 @@ extern "C" void selector_ffi_set_inside_has_argument(void* context, bool value)
 extern "C" HasCacheResult selector_ffi_has_cache_get(void* context, u64 selector_id, void const* anchor)
 {
     auto& match_context = rust_match_context(context);
+    // NB: Off the main thread, the document's counters belong to the main thread, so count into the deferred
+    //     metadata instead.
+    auto* deferred = match_context.deferred_involvement_metadata;
     auto& counters = ffi_element(anchor).document().style_invalidation_counters();
-    ++counters.has_match_invocations;
+    ++(deferred ? deferred->has_match_invocations : counters.has_match_invocations);
     if (!match_context.has_result_cache)
         return HasCacheResult::NotCached;
     auto cached = match_context.has_result_cache->get({ selector_id, &ffi_element(anchor) });
     if (!cached.has_value()) {
-        ++counters.has_result_cache_misses;
+        ++(deferred ? deferred->has_result_cache_misses : counters.has_result_cache_misses);
         return HasCacheResult::NotCached;
     }
-    ++counters.has_result_cache_hits;
+    ++(deferred ? deferred->has_result_cache_hits : counters.has_result_cache_hits);
     return cached.value() == HasMatchResult::Matched ? HasCacheResult::Matched : HasCacheResult::NotMatched;
 }
 
@@ -76,6 +76,47 @@ struct HasFastRejectFilter {
 
 using HasFastRejectFilterCache = HashMap<HasFastRejectFilterKey, HasFastRejectFilter, HasFastRejectFilterKeyTraits>;
 
+// Matching records on the elements it visits how they are involved in selectors, so that later DOM changes know what
+// to invalidate. Matching off the main thread must not write to the DOM, so it logs those records here instead, for
+// the main thread to apply once matching is done.
+class DeferredInvolvementMetadata {
+public:
+    enum class Kind : u8 {
+        StructuralPseudoClass,
+        HasPseudoClass,
+        NextSiblingCombinator,
+        SubsequentSiblingCombinator,
+        HasSiblingCombinatorAnchor,
+        HasSiblingCombinatorElement,
+        InHasScope,
+    };
+
+    void record(Kind kind, DOM::Element const& element, GC::Ptr<DOM::Element const> subject, u8 pseudo_class = 0, size_t sibling_invalidation_distance = 0)
+    {
+        m_records.append({ kind, pseudo_class, element, subject, sibling_invalidation_distance });
+    }
+
+    void apply(DOM::Document&);
+
+    // The document's style invalidation counters that matching bumps, summed up here in the meantime.
+    u64 has_match_invocations { 0 };
+    u64 has_result_cache_hits { 0 };
+    u64 has_result_cache_misses { 0 };
+    u64 rules_tried { 0 };
+    u64 rules_matched { 0 };
+
+private:
+    struct Record {
+        Kind kind;
+        u8 pseudo_class { 0 };
+        GC::Ref<DOM::Element const> element;
+        GC::Ptr<DOM::Element const> subject;
+        size_t sibling_invalidation_distance { 0 };
+    };
+
+    Vector<Record> m_records;
+};
+
 struct MatchContext {
     GC::Ptr<CSS::CSSStyleSheet const> style_sheet_for_rule {};
     GC::Ptr<DOM::Element const> subject {};
@@ -89,6 +130,8 @@ struct MatchContext {
     bool inside_has_argument_match { false };
     HasResultCache* has_result_cache { nullptr };
     HasFastRejectFilterCache* has_fast_reject_filter_cache { nullptr };
+    // Set when matching off the main thread, which then records involvement metadata here instead of on the DOM.
+    DeferredInvolvementMetadata* deferred_involvement_metadata { nullptr };
 };
 
 bool matches(CSS::Selector const&, DOM::AbstractElement const&, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context, GC::Ptr<DOM::ParentNode const> scope = {});
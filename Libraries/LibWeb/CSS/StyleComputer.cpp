@@ -24,6 +24,7 @@
 #include <AK/QuickSort.h>
 #include <AK/Utf8View.h>
 #include <LibGfx/Font/FontDatabase.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWeb/Animations/AnimationEffect.h>
 #include <LibWeb/Animations/DocumentTimeline.h>
 #include <LibWeb/Bindings/PrincipalHostDefined.h>
@@ -92,6 +93,7 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ShadowRoot.h>
+#include <LibWeb/DOM/Text.h>
 #include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
@@ -159,7 +161,6 @@ StyleComputer::StyleComputer(DOM::Document& document)
     , m_default_font_metrics(16, Platform::FontPlugin::the().default_font(16)->pixel_metrics(), InitialValues::line_height())
     , m_root_element_font_metrics(m_default_font_metrics)
 {
-    m_ancestor_filter = make<CountingBloomFilter<u8, 14>>();
 }
 
 StyleComputer::~StyleComputer() = default;
@@ -168,10 +169,10 @@ void StyleComputer::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_document);
-    if (m_has_result_cache)
-        visitor.visit(*m_has_result_cache);
-    if (m_has_fast_reject_filter_cache)
-        visitor.visit(*m_has_fast_reject_filter_cache);
+    if (m_matching_state.has_result_cache)
+        visitor.visit(*m_matching_state.has_result_cache);
+    if (m_matching_state.has_fast_reject_filter_cache)
+        visitor.visit(*m_matching_state.has_fast_reject_filter_cache);
 
     if (m_cached_font_computation_context.has_value())
         m_cached_font_computation_context->visit_edges(visitor);
@@ -180,8 +181,16 @@ void StyleComputer::visit_edges(Visitor& visitor)
     if (m_cached_generic_computation_context.has_value())
         m_cached_generic_computation_context->visit_edges(visitor);
 
-    for (auto& rule : m_rules_to_run_scratch)
+    for (auto& rule : m_matching_state.rules_to_run)
         rule.visit_edges(visitor);
+
+    for (auto& [element, rule_set] : m_prematched_rule_sets) {
+        visitor.visit(element);
+        rule_set.visit_edges(visitor);
+    }
+
+    for (auto& candidate : m_style_sharing_candidates)
+        visitor.visit(candidate.element);
 }
 
 template<size_t length>
@@ -220,7 +229,7 @@ RuleCache const* StyleComputer::rule_cache_for_cascade_origin(CascadeOrigin casc
         case CascadeOrigin::User:
             return &rule_cache.user_rule_cache;
         case CascadeOrigin::UserAgent:
-            return &rule_cache.user_agent_rule_cache;
+            return &rule_cache.user_agent_rule_cache->rule_caches;
         default:
             VERIFY_NOT_REACHED();
         }
@@ -569,7 +578,7 @@ static bool should_reject_with_parent_filter(DOM::AbstractElement abstract_eleme
     return !parent_filter_may_contain_all(*parent, required_hashes);
 }
 
-Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_from_context(DOM::AbstractElement abstract_element, CascadeOrigin cascade_origin, GC::Ptr<DOM::ShadowRoot const> context_shadow_root, Optional<Utf16FlyString const> qualified_layer_name, u64* matching_pseudo_element_styles) const
+Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_from_context(DOM::AbstractElement abstract_element, MatchingState& state, CascadeOrigin cascade_origin, GC::Ptr<DOM::ShadowRoot const> context_shadow_root, Optional<Utf16FlyString const> qualified_layer_name, u64* matching_pseudo_element_styles) const
 {
     auto const& root_node = abstract_element.element().root();
     auto shadow_root = as_if<DOM::ShadowRoot>(root_node);
@@ -582,7 +591,7 @@ Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_
     else if (shadow_root)
         shadow_host = shadow_root->host();
 
-    auto& rules_to_run = m_rules_to_run_scratch;
+    auto& rules_to_run = state.rules_to_run;
     VERIFY(rules_to_run.is_empty());
     ScopeGuard clear_rules_to_run = [&] {
         rules_to_run.clear_with_capacity();
@@ -594,13 +603,13 @@ Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_
     // duplicate suppression stays an indexed load/store in the hot path.
     u64 multi_bucket_rule_generation = 0;
     auto next_multi_bucket_rule_generation = [&]() {
-        ++m_multi_bucket_rule_generation;
-        if (m_multi_bucket_rule_generation == 0) {
-            for (auto& generation : m_seen_multi_bucket_rule_generations)
+        ++state.multi_bucket_rule_generation;
+        if (state.multi_bucket_rule_generation == 0) {
+            for (auto& generation : state.seen_multi_bucket_rule_generations)
                 generation = 0;
-            ++m_multi_bucket_rule_generation;
+            ++state.multi_bucket_rule_generation;
         }
-        return m_multi_bucket_rule_generation;
+        return state.multi_bucket_rule_generation;
     };
     auto was_multi_bucket_rule_seen = [&](MatchingRule const& rule) {
         if (rule.multi_bucket_rule_index == 0)
@@ -610,11 +619,11 @@ Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_
             multi_bucket_rule_generation = next_multi_bucket_rule_generation();
 
         auto const index = static_cast<size_t>(rule.multi_bucket_rule_index - 1);
-        if (m_seen_multi_bucket_rule_generations.size() <= index)
-            m_seen_multi_bucket_rule_generations.resize(index + 1);
-        if (m_seen_multi_bucket_rule_generations[index] == multi_bucket_rule_generation)
+        if (state.seen_multi_bucket_rule_generations.size() <= index)
+            state.seen_multi_bucket_rule_generations.resize(index + 1);
+        if (state.seen_multi_bucket_rule_generations[index] == multi_bucket_rule_generation)
             return true;
-        m_seen_multi_bucket_rule_generations[index] = multi_bucket_rule_generation;
+        state.seen_multi_bucket_rule_generations[index] = multi_bucket_rule_generation;
         return false;
     };
 
@@ -640,6 +649,14 @@ Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_
         if (!rule_is_relevant_for_current_scope)
             return;
 
+        // NB: Container queries and @scope look at other elements' layout and scopes, and some selectors compute what
+        //     they match on first use, which only the main thread may do.
+        if (state.deferred_involvement_metadata
+            && (rule_to_run.container_rule || rule_to_run.scope_rule || !rule_to_run.selector.can_be_matched_off_main_thread())) {
+            state.needs_main_thread = true;
+            return;
+        }
+
         if (rule_to_run.container_rule
             && !rule_to_run.container_rule->contains_size_feature()
             && !rule_to_run.container_rule->contains_style_feature()
@@ -647,7 +664,7 @@ Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_
             return;
 
         auto const& selector = rule_to_run.selector;
-        if (selector.can_use_ancestor_filter() && should_reject_with_ancestor_filter(selector))
+        if (selector.can_use_ancestor_filter() && should_reject_with_ancestor_filter(*state.ancestor_filter, selector))
             return;
         if (should_reject_with_parent_filter(abstract_element, selector))
             return;
@@ -698,7 +715,7 @@ Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_
 
     auto add_rules_from_cache = [&](RuleCache const& rule_cache, GC::Ptr<DOM::ShadowRoot const> rule_root) {
         multi_bucket_rule_generation = next_multi_bucket_rule_generation();
-        Function<bool(u32)> may_contain_ancestor_hash = [&](u32 hash) { return m_ancestor_filter->may_contain(hash); };
+        Function<bool(u32)> may_contain_ancestor_hash = [&](u32 hash) { return state.ancestor_filter->may_contain(hash); };
         rule_cache.for_each_matching_rules(abstract_element, may_contain_ancestor_hash, [&](auto const& matching_rules) {
             add_rules_to_run(matching_rules, rule_root);
             return IterationDecision::Continue;
@@ -765,6 +782,13 @@ Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_
     Vector<ScopedMatchingRule> matching_rules;
     matching_rules.ensure_capacity(rules_to_run.size());
 
+    // NB: The document's counters are only written to on the main thread.
+    auto* deferred_involvement_metadata = state.deferred_involvement_metadata;
+    if (deferred_involvement_metadata)
+        deferred_involvement_metadata->rules_tried += rules_to_run.size();
+    else
+        abstract_element.document().style_invalidation_counters().rules_tried += rules_to_run.size();
+
     for (auto rule_to_run : rules_to_run) {
         // NOTE: When matching an element that is itself a shadow host against a rule from
         //       outside its own shadow root, we must not use the element as the shadow host
@@ -788,8 +812,9 @@ Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_
             .subject = abstract_element.element(),
             .rule_shadow_root = rule_root,
             .collect_per_element_selector_involvement_metadata = true,
-            .has_result_cache = m_has_result_cache.ptr(),
-            .has_fast_reject_filter_cache = m_has_fast_reject_filter_cache.ptr(),
+            .has_result_cache = state.has_result_cache.ptr(),
+            .has_fast_reject_filter_cache = state.has_fast_reject_filter_cache.ptr(),
+            .deferred_involvement_metadata = deferred_involvement_metadata,
         };
         if (!abstract_element.pseudo_element().has_value() && matching_pseudo_element_styles) {
             if (auto pseudo_element = selector.target_pseudo_element(); pseudo_element.has_value()) {
@@ -818,7 +843,10 @@ Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_
             if (contains_size_feature || contains_style_feature) {
                 rule.container_rule->mark_element_style_dependencies(abstract_element);
 
-                if (!rule.container_rule->matches(abstract_element))
+                auto const matches = rule.container_rule->matches(abstract_element);
+                if (contains_size_feature)
+                    abstract_element.element().record_size_container_query_result(abstract_element.pseudo_element(), *rule.container_rule, matches);
+                if (!matches)
                     continue;
             }
         }
@@ -827,6 +855,10 @@ Vector<StyleComputer::ScopedMatchingRule> StyleComputer::collect_matching_rules_
         matching_rules.append(rule_to_run);
     }
 
+    if (deferred_involvement_metadata)
+        deferred_involvement_metadata->rules_matched += matching_rules.size();
+    else
+        abstract_element.document().style_invalidation_counters().rules_matched += matching_rules.size();
     return matching_rules;
 }
 
@@ -912,13 +944,18 @@ void StyleComputer::collect_animation_into(DOM::AbstractElement abstract_element
     collect_animation_into(abstract_element, effect, computed_properties, nullptr);
 }
 
-void StyleComputer::collect_animation_into(DOM::AbstractElement abstract_element, GC::Ref<Animations::KeyframeEffect> effect, ComputedProperties& computed_properties, ComputedProperties::Builder* builder) const
+void StyleComputer::collect_animation_into_at_progress(DOM::AbstractElement abstract_element, GC::Ref<Animations::KeyframeEffect> effect, ComputedProperties& computed_properties, double transformed_progress) const
+{
+    collect_animation_into(abstract_element, effect, computed_properties, nullptr, transformed_progress);
+}
+
+void StyleComputer::collect_animation_into(DOM::AbstractElement abstract_element, GC::Ref<Animations::KeyframeEffect> effect, ComputedProperties& computed_properties, ComputedProperties::Builder* builder, Optional<double> transformed_progress) const
 {
     auto animation = effect->associated_animation();
     if (!animation)
         return;
 
-    auto output_progress = effect->transformed_progress();
+    auto output_progress = transformed_progress.has_value() ? transformed_progress : effect->transformed_progress();
     if (!output_progress.has_value())
         return;
 
@@ -940,35 +977,12 @@ void StyleComputer::collect_animation_into(DOM::AbstractElement abstract_element
 
     // Each property is animated using its property-specific keyframes, so two properties in the same animation may be
     // interpolated across different intervals.
-    // Collect the keyframes in ascending offset order, and index for each physical longhand the keyframes that specify
-    // it, so that the interval endpoints can be found separately for every property.
-    LogicalAliasMappingContext const logical_alias_mapping_context { computed_properties.writing_mode(), computed_properties.direction() };
-    struct KeyframeInfo {
-        i64 key { 0 };
-        Animations::KeyframeEffect::KeyFrameSet::ResolvedKeyFrame const* frame { nullptr };
-    };
-    Vector<KeyframeInfo> ordered_keyframes;
-    ordered_keyframes.ensure_capacity(keyframes.size());
-    HashMap<PropertyID, Vector<size_t>> keyframes_specifying_property;
-    for (auto it = keyframes.begin(); it != keyframes.end(); ++it) {
-        auto keyframe_index = ordered_keyframes.size();
-        auto add_physical_longhand = [&](PropertyID longhand_id) {
-            auto physical_longhand_id = map_logical_alias_to_physical_property(longhand_id, logical_alias_mapping_context);
-            auto& specifying_keyframes = keyframes_specifying_property.ensure(physical_longhand_id);
-            if (specifying_keyframes.is_empty() || specifying_keyframes.last() != keyframe_index)
-                specifying_keyframes.append(keyframe_index);
-        };
-        for (auto const& [property_id, value] : it->properties) {
-            value.visit(
-                [&](Animations::KeyframeEffect::KeyFrameSet::UseInitial) { add_physical_longhand(property_id); },
-                [&](NonnullRefPtr<StyleValue const> const& keyframe_value) {
-                    for_each_property_expanding_shorthands(property_id, *keyframe_value, [&](PropertyID longhand_id, StyleValue const&) {
-                        add_physical_longhand(longhand_id);
-                    });
-                });
-        }
-        ordered_keyframes.append({ static_cast<i64>(it.key()), &*it });
-    }
+    // OPTIMIZATION: The keyframes in ascending offset order, and for each physical longhand the keyframes that specify
+    //               it, are cached on the keyframe set. This runs on every animation frame (and for every sample baked
+    //               for the compositor), and elements running the same @keyframes share a single keyframe set.
+    auto const& property_tracks = effect->key_frame_set()->property_tracks({ computed_properties.writing_mode(), computed_properties.direction() });
+    auto const& ordered_keyframes = property_tracks.ordered_keyframes;
+    auto const& keyframes_specifying_property = property_tracks.keyframes_specifying_property;
 
     // https://drafts.csswg.org/css-animations-1/#animation-timing-function
     // Apply the per-keyframe easing to the interval progress. The easing on a keyframe applies to the
@@ -1385,6 +1399,28 @@ static void collect_dimension_attribute(Vector<StyleProperty>& properties, DOM::
     properties.append({ .property_id = property_id, .value = parsed_value.release_nonnull() });
 }
 
+static bool value_is_list_containing_a_single_time_of_zero_seconds(StyleValue const& value)
+{
+    if (!value.is_value_list())
+        return false;
+
+    auto const& value_list = value.as_value_list().values();
+
+    if (value_list.size() != 1)
+        return false;
+
+    if (!value_list[0]->is_time())
+        return false;
+
+    return value_list[0]->as_time().time().to_seconds() == 0;
+}
+
+static bool style_has_zero_combined_transition_duration(ComputedProperties const& style)
+{
+    return value_is_list_containing_a_single_time_of_zero_seconds(style.property(PropertyID::TransitionDelay))
+        && value_is_list_containing_a_single_time_of_zero_seconds(style.property(PropertyID::TransitionDuration));
+}
+
 static void compute_transitioned_properties(ComputedProperties const& style, DOM::AbstractElement abstract_element)
 {
     // FIXME: For now we don't bother registering transitions on the first computation since they can't run (because
@@ -1397,24 +1433,6 @@ static void compute_transitioned_properties(ComputedProperties const& style, DOM
 
     element.clear_registered_transitions(pseudo_element);
 
-    auto const& delay = style.property(PropertyID::TransitionDelay);
-    auto const& duration = style.property(PropertyID::TransitionDuration);
-
-    auto const value_is_list_containing_a_single_time_of_zero_seconds = [](StyleValue const& value) -> bool {
-        if (!value.is_value_list())
-            return false;
-
-        auto const& value_list = value.as_value_list().values();
-
-        if (value_list.size() != 1)
-            return false;
-
-        if (!value_list[0]->is_time())
-            return false;
-
-        return value_list[0]->as_time().time().to_seconds() == 0;
-    };
-
     // OPTIMIZATION: Registered transitions with a "combined duration" of less than or equal to 0s are equivalent to not
     //               having a transition registered at all, except in the case that we already have an associated
     //               transition for that property, so we can skip registering them. This implementation intentionally
@@ -1422,12 +1440,8 @@ static void compute_transitioned_properties(ComputedProperties const& style, DOM
     //               transitions, negative delays, etc) since it covers the common (initial property values) case and
     //               the other cases are rare enough that the cost of identifying them would likely more than offset any
     //               gains.
-    if (
-        element.property_ids_with_existing_transitions(pseudo_element).is_empty()
-        && value_is_list_containing_a_single_time_of_zero_seconds(delay)
-        && value_is_list_containing_a_single_time_of_zero_seconds(duration)) {
+    if (element.property_ids_with_existing_transitions(pseudo_element).is_empty() && style_has_zero_combined_transition_duration(style))
         return;
-    }
 
     element.add_transitioned_properties(pseudo_element, style.transitions());
 }
@@ -1664,6 +1678,17 @@ void StyleComputer::start_needed_transitions(ComputedValues const& previous_styl
 }
 
 StyleComputer::MatchingRuleSet StyleComputer::build_matching_rule_set(DOM::AbstractElement abstract_element, bool& did_match_any_pseudo_element_rules, ComputeStyleMode mode) const
+{
+    if (mode == ComputeStyleMode::Normal && !abstract_element.pseudo_element().has_value() && !m_prematched_rule_sets.is_empty()) {
+        if (auto matching_rule_set = m_prematched_rule_sets.take(&abstract_element.element()); matching_rule_set.has_value()) {
+            ++document().style_invalidation_counters().prematched_rule_set_uses;
+            return matching_rule_set.release_value();
+        }
+    }
+    return build_matching_rule_set(abstract_element, did_match_any_pseudo_element_rules, mode, m_matching_state);
+}
+
+StyleComputer::MatchingRuleSet StyleComputer::build_matching_rule_set(DOM::AbstractElement abstract_element, bool& did_match_any_pseudo_element_rules, ComputeStyleMode mode, MatchingState& state) const
 {
     MatchingRuleSet matching_rule_set;
     u64* matching_pseudo_element_styles = nullptr;
@@ -1720,12 +1745,12 @@ StyleComputer::MatchingRuleSet StyleComputer::build_matching_rule_set(DOM::Abstr
             };
 
             for (auto const& layer_name : context_rule_cache.qualified_layer_names_in_order) {
-                auto layer_rules = collect_matching_rules_from_context(abstract_element, CascadeOrigin::Author, shadow_root, layer_name, matching_pseudo_element_styles);
+                auto layer_rules = collect_matching_rules_from_context(abstract_element, state, CascadeOrigin::Author, shadow_root, layer_name, matching_pseudo_element_styles);
                 sort_matching_rules(layer_rules);
                 context.author_rules.append({ layer_name, layer_rules });
             }
 
-            auto unlayered_author_rules = collect_matching_rules_from_context(abstract_element, CascadeOrigin::Author, shadow_root, {}, matching_pseudo_element_styles);
+            auto unlayered_author_rules = collect_matching_rules_from_context(abstract_element, state, CascadeOrigin::Author, shadow_root, {}, matching_pseudo_element_styles);
             sort_matching_rules(unlayered_author_rules);
             context.author_rules.append({ {}, unlayered_author_rules });
 
@@ -1736,9 +1761,9 @@ StyleComputer::MatchingRuleSet StyleComputer::build_matching_rule_set(DOM::Abstr
     };
 
     // First, we collect all the CSS rules whose selectors match `element`:
-    matching_rule_set.user_agent_rules = collect_matching_rules_from_context(abstract_element, CascadeOrigin::UserAgent, nullptr, {}, matching_pseudo_element_styles);
+    matching_rule_set.user_agent_rules = collect_matching_rules_from_context(abstract_element, state, CascadeOrigin::UserAgent, nullptr, {}, matching_pseudo_element_styles);
     sort_matching_rules(matching_rule_set.user_agent_rules);
-    matching_rule_set.user_rules = collect_matching_rules_from_context(abstract_element, CascadeOrigin::User, nullptr, {}, matching_pseudo_element_styles);
+    matching_rule_set.user_rules = collect_matching_rules_from_context(abstract_element, state, CascadeOrigin::User, nullptr, {}, matching_pseudo_element_styles);
     sort_matching_rules(matching_rule_set.user_rules);
     matching_rule_set.author_contexts = collect_author_contexts();
 
@@ -2193,9 +2218,91 @@ JsonArray StyleComputer::collect_devtools_applied_style_rules(DOM::AbstractEleme
 }
 
 // https://www.w3.org/TR/css-cascade/#cascading
+Vector<FlatPtr> StyleComputer::compute_cascade_cache_key(DOM::AbstractElement abstract_element, MatchingRuleSet const& matching_rule_set, RefPtr<CustomPropertyData const> const& inherited_custom_property_data) const
+{
+    // Given the same declaration blocks in the same order, the cascade only looks at the element for the custom
+    // properties it inherits and which pseudo-element it is styling. Matched rules live in the rule caches and
+    // know their own layer, so the rule pointers and the shape of the context and layer lists stand in for the
+    // blocks themselves.
+    Vector<FlatPtr> key;
+    key.append(abstract_element.pseudo_element().has_value() ? to_underlying(*abstract_element.pseudo_element()) + 1 : 0);
+    key.append(bit_cast<FlatPtr>(inherited_custom_property_data.ptr()));
+
+    auto append_rules = [&](Vector<ScopedMatchingRule> const& rules) {
+        key.append(rules.size());
+        for (auto const& match : rules) {
+            key.append(bit_cast<FlatPtr>(match.rule));
+            key.append(bit_cast<FlatPtr>(match.shadow_root.ptr()));
+        }
+    };
+
+    append_rules(matching_rule_set.user_agent_rules);
+    append_rules(matching_rule_set.user_rules);
+    key.append(matching_rule_set.author_contexts.size());
+    for (auto const& author_context : matching_rule_set.author_contexts) {
+        key.append(bit_cast<FlatPtr>(author_context.shadow_root.ptr()));
+        key.append(author_context.author_rules.size());
+        for (auto const& layer : author_context.author_rules)
+            append_rules(layer.rules);
+    }
+
+    return key;
+}
+
+static u32 cascade_cache_key_hash(Vector<FlatPtr> const& key)
+{
+    u32 hash = 0;
+    for (auto value : key)
+        hash = pair_int_hash(hash, ptr_hash(value));
+    return hash;
+}
+
 // https://drafts.csswg.org/css-cascade-5/#layering
 NonnullRefPtr<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::AbstractElement abstract_element, MatchingRuleSet const& matching_rule_set, IncludeInlineStyle include_inline_style) const
 {
+    // Author presentational hints
+    // The spec calls this a special "Author presentational hint origin":
+    // "For the purpose of cascading this author presentational hint origin is treated as an independent origin;
+    // however for the purpose of the revert keyword (but not for the revert-layer keyword) it is considered
+    // part of the author origin."
+    // https://drafts.csswg.org/css-cascade-5/#author-presentational-hint-origin
+    Vector<StyleProperty> presentational_hint_properties;
+    if (!abstract_element.pseudo_element().has_value()) {
+        auto& element = abstract_element.element();
+        element.apply_presentational_hints(presentational_hint_properties);
+        if (element.supports_dimension_attributes()) {
+            auto const& dimension_source = is<HTML::HTMLImageElement>(element)
+                ? static_cast<HTML::HTMLImageElement const&>(element).dimension_attribute_source()
+                : element;
+            collect_dimension_attribute(presentational_hint_properties, dimension_source, HTML::AttributeNames::width, CSS::PropertyID::Width);
+            collect_dimension_attribute(presentational_hint_properties, dimension_source, HTML::AttributeNames::height, CSS::PropertyID::Height);
+        }
+    }
+
+    // OPTIMIZATION: Elements that matched the same rules, and have no declarations of their own, cascade to the same
+    //               result. Reuse it, along with the custom property data it produced.
+    RefPtr<CustomPropertyData const> inherited_custom_property_data;
+    if (auto inherit_from = abstract_element.element_to_inherit_style_from(); inherit_from.has_value())
+        inherited_custom_property_data = inheritable_custom_property_data(*inherit_from);
+
+    Optional<Vector<FlatPtr>> cache_key;
+    GC::Ptr<CSSStyleProperties const> inline_style = include_inline_style == IncludeInlineStyle::Yes ? abstract_element.inline_style() : nullptr;
+    if (presentational_hint_properties.is_empty() && (!inline_style || (inline_style->properties().is_empty() && inline_style->custom_properties().is_empty())))
+        cache_key = compute_cascade_cache_key(abstract_element, matching_rule_set, inherited_custom_property_data);
+
+    auto& counters = document().style_invalidation_counters();
+    Optional<u32> cache_key_hash;
+    if (cache_key.has_value()) {
+        cache_key_hash = cascade_cache_key_hash(*cache_key);
+        if (auto it = m_cascade_cache.find(*cache_key_hash); it != m_cascade_cache.end() && it->value.key == *cache_key) {
+            ++counters.cascade_cache_hits;
+            if (it->value.did_set_custom_properties)
+                abstract_element.set_custom_property_data(it->value.custom_property_data);
+            return it->value.cascaded_properties;
+        }
+        ++counters.cascade_cache_misses;
+    }
+
     auto cascaded_properties = CascadedProperties::create();
 
     auto element_context_shadow_root = as_if<DOM::ShadowRoot>(abstract_element.element().root());
@@ -2281,26 +2388,8 @@ NonnullRefPtr<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Ab
         add_block(declaration.properties(), nullptr, CascadeOrigin::User, 0, 0, false, false, {}, &declaration, match.shadow_root);
     }
 
-    // Author presentational hints
-    // The spec calls this a special "Author presentational hint origin":
-    // "For the purpose of cascading this author presentational hint origin is treated as an independent origin;
-    // however for the purpose of the revert keyword (but not for the revert-layer keyword) it is considered
-    // part of the author origin."
-    // https://drafts.csswg.org/css-cascade-5/#author-presentational-hint-origin
-    Vector<StyleProperty> presentational_hint_properties;
-    if (!abstract_element.pseudo_element().has_value()) {
-        auto& element = abstract_element.element();
-        element.apply_presentational_hints(presentational_hint_properties);
-        if (element.supports_dimension_attributes()) {
-            auto const& dimension_source = is<HTML::HTMLImageElement>(element)
-                ? static_cast<HTML::HTMLImageElement const&>(element).dimension_attribute_source()
-                : element;
-            collect_dimension_attribute(presentational_hint_properties, dimension_source, HTML::AttributeNames::width, CSS::PropertyID::Width);
-            collect_dimension_attribute(presentational_hint_properties, dimension_source, HTML::AttributeNames::height, CSS::PropertyID::Height);
-        }
-        if (!presentational_hint_properties.is_empty())
-            add_block(presentational_hint_properties, nullptr, CascadeOrigin::AuthorPresentationalHint, 0, 0, false, false, {}, nullptr, nullptr);
-    }
+    if (!presentational_hint_properties.is_empty())
+        add_block(presentational_hint_properties, nullptr, CascadeOrigin::AuthorPresentationalHint, 0, 0, false, false, {}, nullptr, nullptr);
 
     for (u32 context_index = 0; context_index < matching_rule_set.author_contexts.size(); ++context_index) {
         auto const& author_context = matching_rule_set.author_contexts[context_index];
@@ -2319,7 +2408,7 @@ NonnullRefPtr<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Ab
             //     internally to style element-reference pseudo-elements and sometimes contains disallowed
             //     properties (e.g. input::placeholder has height set); authors can't set inline style on
             //     pseudo-elements so this doesn't cause any spec compliance issues.
-            if (auto const inline_style = abstract_element.inline_style())
+            if (inline_style)
                 add_block(inline_style->properties(), &inline_style->custom_properties(), CascadeOrigin::Author, context_index, 0, true, true, {}, inline_style, nullptr);
         }
     }
@@ -2338,6 +2427,8 @@ NonnullRefPtr<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Ab
         DOM::AbstractElement& abstract_element;
         Vector<BlockSource> const& block_sources;
         Vector<NonnullRefPtr<StyleValue const>> pinned_values;
+        bool depends_on_element { false };
+        bool did_set_custom_properties { false };
     } bulk_context {
         .cascaded_properties = *cascaded_properties,
         .abstract_element = abstract_element,
@@ -2351,6 +2442,7 @@ NonnullRefPtr<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Ab
         .context = &bulk_context,
         .resolve_unresolved = [](void* context, u16 property_id, void const* shell) -> ComputedValuesFFI::FfiResolvedStyleValue {
             auto& bulk_context = *static_cast<BulkCascadeContext*>(context);
+            bulk_context.depends_on_element = true;
             auto resolved = Parser::Parser::resolve_unresolved_style_value(
                 Parser::ParsingParams { bulk_context.abstract_element.document() },
                 bulk_context.abstract_element,
@@ -2366,6 +2458,7 @@ NonnullRefPtr<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Ab
         },
         .parse_substituted = [](void* context, u16 property_id, u8 const* source, size_t source_length) -> ComputedValuesFFI::FfiResolvedStyleValue {
             auto& bulk_context = *static_cast<BulkCascadeContext*>(context);
+            bulk_context.depends_on_element = true;
             bulk_context.abstract_element.element().set_style_uses_var_css_function();
             auto parsed = parse_css_value(
                 Parser::ParsingParams { bulk_context.abstract_element.document() },
@@ -2403,6 +2496,7 @@ NonnullRefPtr<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Ab
             } },
         .set_custom_properties = [](void* context, ComputedValuesFFI::FfiCascadedCustomProperty const* properties, size_t count) -> void const* {
             auto& bulk_context = *static_cast<BulkCascadeContext*>(context);
+            bulk_context.did_set_custom_properties = true;
             OrderedHashMap<Utf16FlyString, StyleProperty> cascaded_all;
             cascaded_all.ensure_capacity(count);
             for (size_t i = 0; i < count; ++i) {
@@ -2465,6 +2559,20 @@ NonnullRefPtr<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Ab
     for (auto custom_property_name_raw : leaked_custom_property_names)
         Utf16FlyString::unref_raw(custom_property_name_raw);
 
+    // Values resolved against this element, such as var() and attr() substitutions, aren't valid for anyone else.
+    if (cache_key.has_value() && !bulk_context.depends_on_element) {
+        static constexpr size_t max_cascade_cache_entries = 1024;
+        if (m_cascade_cache.size() >= max_cascade_cache_entries)
+            m_cascade_cache.clear_with_capacity();
+        CascadeCacheEntry entry {
+            .key = cache_key.release_value(),
+            .cascaded_properties = cascaded_properties,
+            .did_set_custom_properties = bulk_context.did_set_custom_properties,
+            .custom_property_data = bulk_context.did_set_custom_properties ? abstract_element.custom_property_data() : nullptr,
+        };
+        m_cascade_cache.set(*cache_key_hash, move(entry));
+    }
+
     // Transition declarations [css-transitions-1]
     // Note that we have to do these after finishing computing the style,
     // so they're not done here, but as the final step in compute_properties()
@@ -2964,11 +3072,211 @@ NonnullRefPtr<ComputedValues const> StyleComputer::create_document_style() const
     return computed_values;
 }
 
+static bool own_custom_properties_differ(RefPtr<CustomPropertyData const> const& old_data, RefPtr<CustomPropertyData const> const& new_data)
+{
+    if (old_data.ptr() == new_data.ptr())
+        return false;
+    static NeverDestroyed<OrderedHashMap<Utf16FlyString, StyleProperty>> empty_own_values;
+    auto const& old_own = old_data ? old_data->own_values() : *empty_own_values;
+    auto const& new_own = new_data ? new_data->own_values() : *empty_own_values;
+    return old_own != new_own;
+}
+
+static bool matches_subject_pseudo_class_bucket(PseudoClass, DOM::Element const&);
+
+// Style sharing lets siblings with identical markup reuse one ComputedProperties instead of each running rule matching
+// and the cascade, which adds up for long lists, table cells and repeated cards. Sharing is limited to a few plain
+// element types whose state pseudo-classes are all covered by the sharing state below; form controls, media elements
+// and the like can match rules for reasons the cache can't see.
+static bool element_type_may_share_style(DOM::Element const& element)
+{
+    return element.is_html_div_element()
+        || element.is_html_span_element()
+        || element.is_html_li_element()
+        || element.is_html_table_row_element()
+        || element.is_html_table_cell_element()
+        || element.is_html_anchor_element();
+}
+
+// The state pseudo-classes that can match differently on elements with identical attributes and the same parent.
+static constexpr Array style_sharing_state_pseudo_classes {
+    PseudoClass::Active,
+    PseudoClass::AnyLink,
+    PseudoClass::Checked,
+    PseudoClass::Disabled,
+    PseudoClass::Enabled,
+    PseudoClass::Focus,
+    PseudoClass::FocusVisible,
+    PseudoClass::FocusWithin,
+    PseudoClass::Fullscreen,
+    PseudoClass::Hover,
+    PseudoClass::Link,
+    PseudoClass::LocalLink,
+    PseudoClass::PlaceholderShown,
+    PseudoClass::Target,
+    PseudoClass::Unchecked,
+    PseudoClass::Visited,
+};
+
+static bool matches_empty_pseudo_class(DOM::Element const& element)
+{
+    if (element.first_child_of_type<DOM::Element>())
+        return false;
+    bool has_nonempty_text_child = false;
+    element.for_each_child_of_type<DOM::Text>([&](auto const& text) {
+        if (!text.data().is_empty()) {
+            has_nonempty_text_child = true;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    return !has_nonempty_text_child;
+}
+
+static bool have_identical_attributes(DOM::Element const& element, DOM::Element const& other)
+{
+    if (element.attribute_list_size() != other.attribute_list_size())
+        return false;
+    bool identical = true;
+    element.for_each_attribute([&](DOM::Attr const& attribute) {
+        if (!identical)
+            return;
+        auto other_value = other.get_attribute_ns(attribute.namespace_uri(), attribute.local_name());
+        if (!other_value.has_value() || *other_value != attribute.value())
+            identical = false;
+    });
+    return identical;
+}
+
+Optional<PseudoClassBitmap> StyleComputer::style_sharing_state_if_eligible(DOM::AbstractElement abstract_element, StyleScope const& style_scope) const
+{
+    if (abstract_element.pseudo_element().has_value())
+        return {};
+
+    auto const& element = abstract_element.element();
+    if (!element_type_may_share_style(element))
+        return {};
+
+    // Elements in shadow trees, shadow hosts and slotted elements match rules from more than one scope.
+    auto parent = element.parent_element();
+    if (!parent || !parent->computed_values() || !element.root().is_document())
+        return {};
+    if (element.shadow_root() || element.assigned_slot_internal())
+        return {};
+
+    // Popovers have a showing state no selector-visible attribute reflects.
+    if (element.inline_style() || element.has_attribute(HTML::AttributeNames::popover))
+        return {};
+
+    // Animations and transitions are per element, and are started or updated while computing its style.
+    if (element.has_associated_animations() || element.has_css_defined_animations() || !element.property_ids_with_existing_transitions({}).is_empty())
+        return {};
+
+    style_scope.build_rule_cache_if_needed();
+    auto const& insights = style_scope.rule_cache().selector_insights;
+
+    PseudoClassBitmap state;
+    for (auto pseudo_class : style_sharing_state_pseudo_classes) {
+        if (insights.pseudo_classes.get(pseudo_class))
+            state.set(pseudo_class, matches_subject_pseudo_class_bucket(pseudo_class, element));
+    }
+    // A dir=auto element takes its directionality from its own text.
+    if (insights.pseudo_classes.get(PseudoClass::Dir))
+        state.set(PseudoClass::Dir, element.directionality() == DOM::Element::Directionality::Rtl);
+    if (insights.pseudo_classes.get(PseudoClass::Empty))
+        state.set(PseudoClass::Empty, matches_empty_pseudo_class(element));
+    return state;
+}
+
+RefPtr<ComputedProperties> StyleComputer::find_shared_style(DOM::AbstractElement abstract_element, PseudoClassBitmap const& state, Optional<bool&> did_change_custom_properties) const
+{
+    auto& element = abstract_element.element();
+    auto parent = element.parent_element();
+    auto& counters = document().style_invalidation_counters();
+
+    // With the same parent, tag, attributes and state, the candidate saw the same ancestors and matched its selectors
+    // against the same inputs, so it matched the same rules and inherited the same values.
+    for (auto const& candidate : m_style_sharing_candidates) {
+        if (candidate.element->parent_element() != parent || candidate.parent_style.ptr() != parent->computed_values().ptr())
+            continue;
+        if (candidate.element->local_name() != element.local_name() || candidate.element->namespace_uri() != element.namespace_uri())
+            continue;
+        if (candidate.state != state || !have_identical_attributes(element, *candidate.element))
+            continue;
+
+        ++counters.style_sharing_cache_hits;
+        element.set_needs_style_update(false);
+
+        auto old_custom_property_data = abstract_element.custom_property_data();
+        abstract_element.set_custom_property_data(DOM::AbstractElement { candidate.element }.custom_property_data());
+        if (did_change_custom_properties.has_value() && own_custom_properties_differ(old_custom_property_data, abstract_element.custom_property_data()))
+            *did_change_custom_properties = true;
+
+        element.copy_style_dependencies_from(*candidate.element);
+        compute_transitioned_properties(*candidate.properties, abstract_element);
+        return candidate.properties;
+    }
+
+    ++counters.style_sharing_cache_misses;
+    return {};
+}
+
+void StyleComputer::remember_style_for_sharing(DOM::AbstractElement abstract_element, PseudoClassBitmap const& state, NonnullRefPtr<ComputedProperties> computed_properties) const
+{
+    static constexpr size_t max_style_sharing_candidates = 8;
+
+    auto& element = abstract_element.element();
+
+    // Matching flags the element when a rule depends on its position among its siblings or on its descendants,
+    // which siblings with identical markup don't have in common.
+    if (element.affected_by_forward_structural_changes()
+        || element.affected_by_backward_structural_changes()
+        || element.affected_by_structural_pseudo_class_in_non_subject_position()
+        || element.affected_by_sibling_combinator_in_non_subject_position()
+        || element.affected_by_has_pseudo_class_in_subject_position()
+        || element.affected_by_has_pseudo_class_in_non_subject_position()
+        || element.affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator()
+        || element.in_subtree_of_has_pseudo_class_relative_selector_with_sibling_combinator()
+        || element.style_uses_tree_counting_function())
+        return;
+
+    if (element.has_associated_animations() || !computed_properties->animations(abstract_element).is_empty() || !style_has_zero_combined_transition_duration(*computed_properties))
+        return;
+
+    if (m_style_sharing_candidates.size() == max_style_sharing_candidates)
+        m_style_sharing_candidates.take_last();
+    m_style_sharing_candidates.prepend(StyleSharingCandidate {
+        .element = element,
+        .parent_style = *element.parent_element()->computed_values(),
+        .state = state,
+        .properties = move(computed_properties),
+    });
+}
+
+void StyleComputer::reset_style_sharing_cache()
+{
+    m_style_sharing_candidates.clear_with_capacity();
+}
+
+void StyleComputer::reset_cascade_cache()
+{
+    m_cascade_cache.clear_with_capacity();
+}
+
 NonnullRefPtr<ComputedValues const> StyleComputer::compute_style(DOM::AbstractElement abstract_element, Optional<bool&> did_change_custom_properties) const
 {
     auto& style_scope = abstract_element.style_scope();
+
+    auto style_sharing_state = style_sharing_state_if_eligible(abstract_element, style_scope);
+    if (style_sharing_state.has_value()) {
+        if (auto shared_properties = find_shared_style(abstract_element, *style_sharing_state, did_change_custom_properties))
+            return build_computed_values(*shared_properties, abstract_element, style_scope);
+    }
+
     auto computed_properties = compute_style_impl(abstract_element, ComputeStyleMode::Normal, did_change_custom_properties, style_scope, IncludeInlineStyle::Yes);
     VERIFY(computed_properties);
+    if (style_sharing_state.has_value())
+        remember_style_for_sharing(abstract_element, *style_sharing_state, *computed_properties);
     return build_computed_values(*computed_properties, abstract_element, style_scope);
 }
 
@@ -3169,16 +3477,8 @@ RefPtr<ComputedProperties> StyleComputer::compute_style_impl(DOM::AbstractElemen
 
     auto computed_properties = compute_properties(abstract_element, cascaded_properties, matching_rule_set.matching_pseudo_element_styles);
 
-    if (did_change_custom_properties.has_value()) {
-        auto new_custom_property_data = abstract_element.custom_property_data();
-        if (old_custom_property_data.ptr() != new_custom_property_data.ptr()) {
-            static NeverDestroyed<OrderedHashMap<Utf16FlyString, StyleProperty>> empty_own_values;
-            auto const& old_own = old_custom_property_data ? old_custom_property_data->own_values() : *empty_own_values;
-            auto const& new_own = new_custom_property_data ? new_custom_property_data->own_values() : *empty_own_values;
-            if (old_own != new_own)
-                *did_change_custom_properties = true;
-        }
-    }
+    if (did_change_custom_properties.has_value() && own_custom_properties_differ(old_custom_property_data, abstract_element.custom_property_data()))
+        *did_change_custom_properties = true;
 
     return computed_properties;
 }
@@ -4647,36 +4947,125 @@ NonnullRefPtr<StyleValue const> StyleComputer::compute_math_depth(NonnullRefPtr<
 
 void StyleComputer::reset_ancestor_filter()
 {
-    m_ancestor_filter->clear();
+    m_matching_state.ancestor_filter->clear();
 }
 
 void StyleComputer::reset_has_result_cache()
 {
-    if (!m_has_result_cache)
-        m_has_result_cache = make<SelectorMatching::HasResultCache>();
+    if (!m_matching_state.has_result_cache)
+        m_matching_state.has_result_cache = make<SelectorMatching::HasResultCache>();
     else
-        m_has_result_cache->clear();
+        m_matching_state.has_result_cache->clear();
 
-    if (!m_has_fast_reject_filter_cache)
-        m_has_fast_reject_filter_cache = make<SelectorMatching::HasFastRejectFilterCache>();
+    if (!m_matching_state.has_fast_reject_filter_cache)
+        m_matching_state.has_fast_reject_filter_cache = make<SelectorMatching::HasFastRejectFilterCache>();
     else
-        m_has_fast_reject_filter_cache->clear();
+        m_matching_state.has_fast_reject_filter_cache->clear();
 }
 
 void StyleComputer::push_ancestor(DOM::Element const& element)
 {
     for_each_element_hash(element, [&](u32 hash) {
-        m_ancestor_filter->increment(hash);
+        m_matching_state.ancestor_filter->increment(hash);
     });
 }
 
 void StyleComputer::pop_ancestor(DOM::Element const& element)
 {
     for_each_element_hash(element, [&](u32 hash) {
-        m_ancestor_filter->decrement(hash);
+        m_matching_state.ancestor_filter->decrement(hash);
     });
 }
 
+// Shadow hosts and slotted elements also match rules from shadow trees, whose caches are built lazily, so the main
+// thread matches them itself.
+static bool element_can_be_matched_off_main_thread(DOM::Element const& element)
+{
+    return !element.is_shadow_host() && !element.assigned_slot_internal();
+}
+
+bool StyleComputer::can_match_rules_in_parallel() const
+{
+    // NB: Even the rule buckets of these pseudo-classes copy strings that aren't safe to share between threads.
+    auto const& insights = document().style_scope().rule_cache().selector_insights;
+    return !insights.pseudo_classes.get(PseudoClass::LocalLink) && !insights.pseudo_classes.get(PseudoClass::PlaceholderShown);
+}
+
+void StyleComputer::match_rules_in_parallel(ReadonlySpan<GC::Ref<DOM::Element>> elements_in_tree_order)
+{
+    static constexpr size_t elements_per_batch = 256;
+
+    if (elements_in_tree_order.is_empty())
+        return;
+
+    // NB: The rule caches are built on first use, which has to happen here rather than on whichever thread gets there
+    //     first.
+    document().style_scope().build_rule_cache_if_needed();
+
+    struct Batch {
+        Vector<GC::Ref<DOM::Element const>> elements;
+        Vector<MatchingRuleSet> matching_rule_sets;
+        SelectorMatching::DeferredInvolvementMetadata deferred_involvement_metadata;
+    };
+    Vector<Batch> batches;
+    batches.resize(ceil_div(elements_in_tree_order.size(), elements_per_batch));
+
+    auto match_batch = [&](size_t batch_index) {
+        auto& batch = batches[batch_index];
+        auto first_element_index = batch_index * elements_per_batch;
+        auto elements = elements_in_tree_order.slice(first_element_index, min(elements_per_batch, elements_in_tree_order.size() - first_element_index));
+
+        MatchingState state;
+        state.has_result_cache = make<SelectorMatching::HasResultCache>();
+        state.has_fast_reject_filter_cache = make<SelectorMatching::HasFastRejectFilterCache>();
+        state.deferred_involvement_metadata = &batch.deferred_involvement_metadata;
+
+        // The batch starts somewhere in the middle of the tree, so the ancestor filter starts out with the ancestors
+        // of its first element, and then follows the walk in tree order like the serial style update does.
+        Vector<DOM::Element const*, 32> ancestors;
+        for (auto const* ancestor = elements.first()->parent_element(); ancestor; ancestor = ancestor->parent_element())
+            ancestors.append(ancestor);
+        ancestors.reverse();
+        auto add_to_ancestor_filter = [&](DOM::Element const& ancestor) {
+            for_each_element_hash(ancestor, [&](u32 hash) { state.ancestor_filter->increment(hash); });
+        };
+        for (auto const* ancestor : ancestors)
+            add_to_ancestor_filter(*ancestor);
+
+        for (auto const& element : elements) {
+            auto const* parent = element->parent_element();
+            while (!ancestors.is_empty() && ancestors.last() != parent) {
+                for_each_element_hash(*ancestors.take_last(), [&](u32 hash) { state.ancestor_filter->decrement(hash); });
+            }
+
+            if (element_can_be_matched_off_main_thread(*element)) {
+                state.needs_main_thread = false;
+                bool did_match_any_pseudo_element_rules = false;
+                auto matching_rule_set = build_matching_rule_set(DOM::AbstractElement { *element }, did_match_any_pseudo_element_rules, ComputeStyleMode::Normal, state);
+                if (!state.needs_main_thread) {
+                    batch.elements.append(element);
+                    batch.matching_rule_sets.append(move(matching_rule_set));
+                }
+            }
+
+            add_to_ancestor_filter(*element);
+            ancestors.append(element.ptr());
+        }
+    };
+    Threading::ThreadPool::the().parallel_for(batches.size(), match_batch, Threading::TaskPriority::UserBlocking);
+
+    for (auto& batch : batches) {
+        batch.deferred_involvement_metadata.apply(document());
+        for (size_t i = 0; i < batch.elements.size(); ++i)
+            m_prematched_rule_sets.set(batch.elements[i], move(batch.matching_rule_sets[i]));
+    }
+}
+
+void StyleComputer::reset_prematched_rules()
+{
+    m_prematched_rule_sets.clear();
+}
+
 template<typename RuleBuckets>
 static void add_rule_to_simplified_selector_bucket(RuleBuckets& rule_buckets, MatchingRule const& matching_rule, SimplifiedSelectorForBucketing const& bucket)
 {
@@ -4978,4 +5367,19 @@ void StyleComputer::ScopedMatchingRule::visit_edges(GC::Cell::Visitor& visitor)
     visitor.visit(scope_root);
 }
 
+void StyleComputer::MatchingRuleSet::visit_edges(GC::Cell::Visitor& visitor)
+{
+    for (auto& rule : user_agent_rules)
+        rule.visit_edges(visitor);
+    for (auto& rule : user_rules)
+        rule.visit_edges(visitor);
+    for (auto& context : author_contexts) {
+        visitor.visit(context.shadow_root);
+        for (auto& layer : context.author_rules) {
+            for (auto& rule : layer.rules)
+                rule.visit_edges(visitor);
+        }
+    }
+}
+
 }
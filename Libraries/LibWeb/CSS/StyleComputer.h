@@ -100,9 +100,17 @@ public:
 
     void reset_ancestor_filter();
     void reset_has_result_cache();
+    void reset_style_sharing_cache();
+    void reset_cascade_cache();
     void push_ancestor(DOM::Element const&);
     void pop_ancestor(DOM::Element const&);
 
+    // Matches the rules of the given elements on the thread pool, so that the next computation of each one's style
+    // only has to cascade them. The elements must be in tree order, and must not be in a shadow tree.
+    [[nodiscard]] bool can_match_rules_in_parallel() const;
+    void match_rules_in_parallel(ReadonlySpan<GC::Ref<DOM::Element>> elements_in_tree_order);
+    void reset_prematched_rules();
+
     [[nodiscard]] NonnullRefPtr<ComputedValues const> create_document_style() const;
 
     [[nodiscard]] NonnullRefPtr<ComputedValues const> compute_style(DOM::AbstractElement, Optional<bool&> did_change_custom_properties = {}) const;
@@ -134,13 +142,15 @@ public:
 
     void collect_animation_into(DOM::AbstractElement, GC::Ref<Animations::KeyframeEffect> animation, ComputedProperties&) const;
     void collect_animation_into(DOM::AbstractElement, GC::Ref<Animations::KeyframeEffect> animation, ComputedProperties::Builder&) const;
+    // Applies the effect as if its transformed progress was the given one, rather than the one at its current time.
+    void collect_animation_into_at_progress(DOM::AbstractElement, GC::Ref<Animations::KeyframeEffect> animation, ComputedProperties&, double transformed_progress) const;
 
     [[nodiscard]] NonnullRefPtr<ComputedProperties> compute_properties(DOM::AbstractElement, CascadedProperties&, u64 matching_pseudo_element_styles) const;
 
     void compute_property_values(ComputedProperties::Builder&, Optional<DOM::AbstractElement>) const;
     void process_animation_definitions(ComputedProperties const& computed_properties, CascadedProperties const&, DOM::AbstractElement& abstract_element) const;
 
-    [[nodiscard]] inline bool should_reject_with_ancestor_filter(Selector const&) const;
+    [[nodiscard]] static bool should_reject_with_ancestor_filter(CountingBloomFilter<u8, 14> const&, Selector const&);
 
     NonnullRefPtr<StyleValue const> compute_value_of_custom_property(ComputedProperties const*, AbstractOrHypotheticalElement const&, Utf16FlyString const& name, Optional<Parser::GuardedSubstitutionContexts&> = {}) const;
     ComputationContext fallback_computation_context_for_custom_property(AbstractOrHypotheticalElement const&) const;
@@ -189,13 +199,57 @@ private:
         Vector<ScopedMatchingRule> user_rules;
         Vector<ContextMatchingRules> author_contexts;
         u64 matching_pseudo_element_styles { 0 };
+
+        void visit_edges(GC::Cell::Visitor&);
+    };
+
+    // Everything that matching an element against the rule caches writes to. The main thread has its own, and every
+    // batch of match_rules_in_parallel() brings another, so that no two threads ever share one.
+    struct MatchingState {
+        MatchingState()
+            : ancestor_filter(make<CountingBloomFilter<u8, 14>>())
+        {
+        }
+
+        NonnullOwnPtr<CountingBloomFilter<u8, 14>> ancestor_filter;
+        Vector<ScopedMatchingRule> rules_to_run;
+        Vector<u64> seen_multi_bucket_rule_generations;
+        u64 multi_bucket_rule_generation { 0 };
+        OwnPtr<SelectorMatching::HasResultCache> has_result_cache;
+        OwnPtr<SelectorMatching::HasFastRejectFilterCache> has_fast_reject_filter_cache;
+
+        // Only set off the main thread, where matching must not write to the DOM.
+        SelectorMatching::DeferredInvolvementMetadata* deferred_involvement_metadata { nullptr };
+        // Set off the main thread when a rule can't be matched there. The main thread then matches the element itself.
+        bool needs_main_thread { false };
     };
 
     [[nodiscard]] MatchingRuleSet build_matching_rule_set(DOM::AbstractElement, bool& did_match_any_pseudo_element_rules, ComputeStyleMode) const;
+    [[nodiscard]] MatchingRuleSet build_matching_rule_set(DOM::AbstractElement, bool& did_match_any_pseudo_element_rules, ComputeStyleMode, MatchingState&) const;
+
+    struct StyleSharingCandidate {
+        GC::Ref<DOM::Element> element;
+        NonnullRefPtr<ComputedValues const> parent_style;
+        PseudoClassBitmap state;
+        NonnullRefPtr<ComputedProperties> properties;
+    };
+
+    [[nodiscard]] Optional<PseudoClassBitmap> style_sharing_state_if_eligible(DOM::AbstractElement, StyleScope const&) const;
+    [[nodiscard]] RefPtr<ComputedProperties> find_shared_style(DOM::AbstractElement, PseudoClassBitmap const& state, Optional<bool&> did_change_custom_properties) const;
+    void remember_style_for_sharing(DOM::AbstractElement, PseudoClassBitmap const& state, NonnullRefPtr<ComputedProperties>) const;
+
+    struct CascadeCacheEntry {
+        Vector<FlatPtr> key;
+        NonnullRefPtr<CascadedProperties> cascaded_properties;
+        bool did_set_custom_properties { false };
+        RefPtr<CustomPropertyData const> custom_property_data;
+    };
+
+    [[nodiscard]] Vector<FlatPtr> compute_cascade_cache_key(DOM::AbstractElement, MatchingRuleSet const&, RefPtr<CustomPropertyData const> const& inherited_custom_property_data) const;
 
     [[nodiscard]] RefPtr<ComputedProperties> compute_style_impl(DOM::AbstractElement, ComputeStyleMode, Optional<bool&> did_change_custom_properties, StyleScope const&, IncludeInlineStyle) const;
     [[nodiscard]] NonnullRefPtr<CascadedProperties> compute_cascaded_values(DOM::AbstractElement, MatchingRuleSet const&, IncludeInlineStyle) const;
-    void collect_animation_into(DOM::AbstractElement, GC::Ref<Animations::KeyframeEffect> animation, ComputedProperties&, ComputedProperties::Builder*) const;
+    void collect_animation_into(DOM::AbstractElement, GC::Ref<Animations::KeyframeEffect> animation, ComputedProperties&, ComputedProperties::Builder*, Optional<double> transformed_progress = {}) const;
     void compute_custom_properties(ComputedProperties&, DOM::AbstractElement) const;
     void start_needed_transitions(ComputedValues const& old_style, ComputedProperties::Builder& new_style, DOM::AbstractElement) const;
     void resolve_effective_overflow_values(ComputedProperties::Builder&) const;
@@ -205,7 +259,7 @@ private:
 
     [[nodiscard]] Length::FontMetrics calculate_root_element_font_metrics(ComputedProperties const&) const;
 
-    [[nodiscard]] Vector<ScopedMatchingRule> collect_matching_rules_from_context(DOM::AbstractElement, CascadeOrigin, GC::Ptr<DOM::ShadowRoot const>, Optional<Utf16FlyString const> qualified_layer_name = {}, u64* matching_pseudo_element_styles = nullptr) const;
+    [[nodiscard]] Vector<ScopedMatchingRule> collect_matching_rules_from_context(DOM::AbstractElement, MatchingState&, CascadeOrigin, GC::Ptr<DOM::ShadowRoot const>, Optional<Utf16FlyString const> qualified_layer_name = {}, u64* matching_pseudo_element_styles = nullptr) const;
 
     GC::Ref<DOM::Document> m_document;
 
@@ -234,21 +288,26 @@ private:
 
     CSSPixelRect m_viewport_rect;
 
-    mutable Vector<ScopedMatchingRule> m_rules_to_run_scratch;
-    mutable Vector<u64> m_seen_multi_bucket_rule_generations;
-    mutable u64 m_multi_bucket_rule_generation { 0 };
+    mutable MatchingState m_matching_state;
+
+    // Rule sets that match_rules_in_parallel() matched ahead of time, each taken by the next computation of its
+    // element's style. Only valid for one style update pass, like the cascade cache.
+    mutable HashMap<GC::Ptr<DOM::Element const>, MatchingRuleSet> m_prematched_rule_sets;
+
+    // Most recently computed styles that later siblings may reuse, newest first. Only valid for one style update pass.
+    mutable Vector<StyleSharingCandidate, 8> m_style_sharing_candidates;
 
-    OwnPtr<CountingBloomFilter<u8, 14>> m_ancestor_filter;
-    OwnPtr<SelectorMatching::HasResultCache> m_has_result_cache;
-    OwnPtr<SelectorMatching::HasFastRejectFilterCache> m_has_fast_reject_filter_cache;
+    // Cascade results of elements that matched the same rules, keyed by a hash of the matched rule list. Only valid
+    // for one style update pass, as rule cache rebuilds may reuse the addresses of matched rules.
+    mutable HashMap<u32, CascadeCacheEntry> m_cascade_cache;
 };
 
-inline bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
+inline bool StyleComputer::should_reject_with_ancestor_filter(CountingBloomFilter<u8, 14> const& ancestor_filter, Selector const& selector)
 {
     for (u32 hash : selector.ancestor_hashes()) {
         if (hash == 0)
             break;
-        if (!m_ancestor_filter->may_contain(hash))
+        if (!ancestor_filter.may_contain(hash))
             return true;
     }
     return false;
@@ -325,10 +325,11 @@ RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::Property
         return RequiredInvalidationAfterStyleChange::full();
     }
 
-    // NOTE: If the text-transform property changes, it may affect layout. Furthermore, since the
-    //       Layout::TextNode caches the post-transform text, we have to update the layout tree.
+    // OPTIMIZATION: A text-transform change doesn't change which boxes are generated, so the existing layout nodes are
+    //               restyled in place. Layout::TextNode keys its post-transform text on its parent's text-transform,
+    //               so it picks up the new value by itself during the following relayout.
     if (property_id == CSS::PropertyID::TextTransform) {
-        invalidation.ensure_at_least(InvalidationLevel::RebuildLayoutTree);
+        invalidation.ensure_at_least(InvalidationLevel::Relayout);
         return invalidation;
     }
 
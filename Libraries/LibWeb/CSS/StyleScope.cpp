@@ -60,7 +60,8 @@ void StyleRuleCache::visit_edges(GC::Cell::Visitor& visitor)
     }
     author_rule_cache.visit_edges(visitor);
     user_rule_cache.visit_edges(visitor);
-    user_agent_rule_cache.visit_edges(visitor);
+    // NB: The shared user-agent rule cache only refers to the user-agent style sheets, which are rooted for the
+    //     lifetime of the process.
 }
 
 void StyleCache::visit_edges(GC::Cell::Visitor& visitor)
@@ -287,23 +288,32 @@ void StyleScope::build_rule_cache()
 
     ++document().style_invalidation_counters().scope_rule_cache_builds;
 
+    // Cached cascade results are keyed by the addresses of rules in the old cache.
+    document().style_computer().reset_cascade_cache();
+
     style_cache.rule_cache = make<StyleRuleCache>();
     populate_rule_cache(*style_cache.rule_cache);
 }
 
+// Pseudo-classes whose state changes are invalidated by looking up the rules that mention them.
+static constexpr Array pseudo_classes_with_rule_cache {
+    PseudoClass::Hover,
+    PseudoClass::Active,
+    PseudoClass::Focus,
+    PseudoClass::FocusWithin,
+    PseudoClass::FocusVisible,
+    PseudoClass::Has,
+    PseudoClass::Target,
+};
+
 void StyleScope::populate_rule_cache(StyleRuleCache& rule_cache)
 {
     build_user_style_sheet_if_needed();
 
     build_qualified_layer_names_cache(rule_cache);
 
-    rule_cache.pseudo_class_rule_cache[to_underlying(PseudoClass::Hover)] = make<RuleCache>();
-    rule_cache.pseudo_class_rule_cache[to_underlying(PseudoClass::Active)] = make<RuleCache>();
-    rule_cache.pseudo_class_rule_cache[to_underlying(PseudoClass::Focus)] = make<RuleCache>();
-    rule_cache.pseudo_class_rule_cache[to_underlying(PseudoClass::FocusWithin)] = make<RuleCache>();
-    rule_cache.pseudo_class_rule_cache[to_underlying(PseudoClass::FocusVisible)] = make<RuleCache>();
-    rule_cache.pseudo_class_rule_cache[to_underlying(PseudoClass::Has)] = make<RuleCache>();
-    rule_cache.pseudo_class_rule_cache[to_underlying(PseudoClass::Target)] = make<RuleCache>();
+    for (auto pseudo_class : pseudo_classes_with_rule_cache)
+        rule_cache.pseudo_class_rule_cache[to_underlying(pseudo_class)] = make<RuleCache>();
 
     make_rule_cache_for_cascade_origin(CascadeOrigin::Author, rule_cache);
     make_rule_cache_for_cascade_origin(CascadeOrigin::User, rule_cache);
@@ -614,29 +624,84 @@ void StyleScope::for_each_stylesheet(CascadeOrigin cascade_origin, Function<void
     }
 }
 
+static void collect_condition_results(CSSRuleList const& rule_list, Vector<bool>& condition_results)
+{
+    for (auto const& rule : rule_list) {
+        if (rule->type() == CSSRule::Type::Media || rule->type() == CSSRule::Type::Supports)
+            condition_results.append(as<CSSConditionRule>(*rule).condition_matches());
+        if (auto const* grouping_rule = as_if<CSSGroupingRule>(*rule))
+            collect_condition_results(grouping_rule->css_rules(), condition_results);
+    }
+}
+
+SharedUserAgentRuleCache const& StyleScope::shared_user_agent_rule_cache()
+{
+    static auto& shared_caches = *new Vector<NonnullOwnPtr<SharedUserAgentRuleCache>>;
+
+    auto in_quirks_mode = document().in_quirks_mode();
+    Vector<bool> condition_results;
+    for_each_user_agent_stylesheet(in_quirks_mode, [&](CSSStyleSheet& sheet, auto const&) {
+        condition_results.append(sheet.media()->matches());
+        collect_condition_results(sheet.rules(), condition_results);
+    });
+
+    for (auto const& shared_cache : shared_caches) {
+        if (shared_cache->in_quirks_mode == in_quirks_mode && shared_cache->condition_results == condition_results)
+            return *shared_cache;
+    }
+
+    auto shared_cache = make<SharedUserAgentRuleCache>();
+    shared_cache->in_quirks_mode = in_quirks_mode;
+    shared_cache->condition_results = move(condition_results);
+    collect_rules_for_cascade_origin(CascadeOrigin::UserAgent, shared_cache->rule_caches, shared_cache->selector_insights, shared_cache->has_size_container_queries, [&](PseudoClass pseudo_class, MatchingRule const& rule, bool contains_root_pseudo_class) {
+        shared_cache->pseudo_class_rules.append({ pseudo_class, rule, contains_root_pseudo_class });
+    });
+    shared_caches.append(move(shared_cache));
+    return *shared_caches.last();
+}
+
 void StyleScope::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin, StyleRuleCache& rule_cache)
 {
-    GC::ConservativeVector<MatchingRule> matching_rules;
+    auto add_pseudo_class_rule = [&](PseudoClass pseudo_class, MatchingRule const& rule, bool contains_root_pseudo_class) {
+        // For pseudo class rule caches we intentionally pass no pseudo-element, because we don't want to bucket pseudo class rules by pseudo-element type.
+        rule_cache.pseudo_class_rule_cache[to_underlying(pseudo_class)]->add_rule(rule, {}, contains_root_pseudo_class, SubjectPseudoClassBuckets::No, AncestorHashBuckets::No);
+    };
+
+    switch (cascade_origin) {
+    case CascadeOrigin::Author:
+        collect_rules_for_cascade_origin(cascade_origin, rule_cache.author_rule_cache, rule_cache.selector_insights, rule_cache.has_size_container_queries, add_pseudo_class_rule);
+        break;
+    case CascadeOrigin::User:
+        collect_rules_for_cascade_origin(cascade_origin, rule_cache.user_rule_cache, rule_cache.selector_insights, rule_cache.has_size_container_queries, add_pseudo_class_rule);
+        break;
+    case CascadeOrigin::UserAgent: {
+        // OPTIMIZATION: Every document and shadow root matches against the same user-agent rules, so only the few
+        //               rules that go into this scope's pseudo-class rule caches are added here.
+        auto const& shared_cache = shared_user_agent_rule_cache();
+        rule_cache.user_agent_rule_cache = &shared_cache;
+        rule_cache.selector_insights.has_has_selectors |= shared_cache.selector_insights.has_has_selectors;
+        rule_cache.selector_insights.has_has_selectors_with_relative_selector_that_has_sibling_combinator |= shared_cache.selector_insights.has_has_selectors_with_relative_selector_that_has_sibling_combinator;
+        rule_cache.selector_insights.has_local_link_selectors |= shared_cache.selector_insights.has_local_link_selectors;
+        rule_cache.selector_insights.pseudo_classes |= shared_cache.selector_insights.pseudo_classes;
+        rule_cache.has_size_container_queries |= shared_cache.has_size_container_queries;
+        for (auto const& pseudo_class_rule : shared_cache.pseudo_class_rules)
+            add_pseudo_class_rule(pseudo_class_rule.pseudo_class, pseudo_class_rule.rule, pseudo_class_rule.contains_root_pseudo_class);
+        break;
+    }
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void StyleScope::collect_rules_for_cascade_origin(CascadeOrigin cascade_origin, RuleCaches& rule_caches, SelectorInsights& selector_insights, bool& has_size_container_queries, Function<void(PseudoClass, MatchingRule const&, bool contains_root_pseudo_class)> const& add_pseudo_class_rule)
+{
     size_t style_sheet_index = 0;
     for_each_stylesheet(cascade_origin, [&](auto& sheet) {
-        auto& rule_caches = [&] -> RuleCaches& {
-            switch (cascade_origin) {
-            case CascadeOrigin::Author:
-                return rule_cache.author_rule_cache;
-            case CascadeOrigin::User:
-                return rule_cache.user_rule_cache;
-            case CascadeOrigin::UserAgent:
-                return rule_cache.user_agent_rule_cache;
-            default:
-                VERIFY_NOT_REACHED();
-            }
-        }();
-
         size_t rule_index = 0;
         Vector<GC::Ptr<CSSContainerRule const>> container_rule_stack;
         for_each_style_producing_rule_for_style_cache(sheet, container_rule_stack, nullptr, [&](auto const& rule, auto const& current_style_sheet, auto container_rule, auto scope_rule) {
             if (container_rule && container_rule->contains_size_feature())
-                rule_cache.has_size_container_queries = true;
+                has_size_container_queries = true;
 
             SelectorList const& absolutized_selectors = [&]() -> SelectorList const& {
                 if (rule.type() == CSSRule::Type::Style)
@@ -647,7 +712,7 @@ void StyleScope::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin
             }();
 
             if (scope_rule)
-                collect_scope_boundary_selector_insights(*scope_rule, rule_cache.selector_insights);
+                collect_scope_boundary_selector_insights(*scope_rule, selector_insights);
 
             for (size_t selector_index = 0; selector_index < absolutized_selectors.size(); ++selector_index) {
                 auto const& selector = *absolutized_selectors[selector_index];
@@ -671,7 +736,7 @@ void StyleScope::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin
                 auto const& qualified_layer_name = matching_rule.qualified_layer_name();
                 auto& matching_rule_cache = qualified_layer_name.is_empty() ? rule_caches.main : *rule_caches.by_layer.ensure(qualified_layer_name, [] { return make<RuleCache>(); });
 
-                collect_selector_insights(selector, rule_cache.selector_insights);
+                collect_selector_insights(selector, selector_insights);
 
                 bool contains_root_pseudo_class = false;
                 for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
@@ -683,15 +748,9 @@ void StyleScope::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin
                     }
                 }
 
-                for (size_t i = 0; i < to_underlying(PseudoClass::__Count); ++i) {
-                    auto pseudo_class = static_cast<PseudoClass>(i);
-                    // If we're not building a rule cache for this pseudo class, just ignore it.
-                    if (!rule_cache.pseudo_class_rule_cache[i])
-                        continue;
-                    if (selector.contains_pseudo_class(pseudo_class)) {
-                        // For pseudo class rule caches we intentionally pass no pseudo-element, because we don't want to bucket pseudo class rules by pseudo-element type.
-                        rule_cache.pseudo_class_rule_cache[i]->add_rule(matching_rule, {}, contains_root_pseudo_class, SubjectPseudoClassBuckets::No, AncestorHashBuckets::No);
-                    }
+                for (auto pseudo_class : pseudo_classes_with_rule_cache) {
+                    if (selector.contains_pseudo_class(pseudo_class))
+                        add_pseudo_class_rule(pseudo_class, matching_rule, contains_root_pseudo_class);
                 }
 
                 matching_rule_cache.add_rule(matching_rule, selector.target_pseudo_element(), contains_root_pseudo_class, SubjectPseudoClassBuckets::Yes, AncestorHashBuckets::Yes);
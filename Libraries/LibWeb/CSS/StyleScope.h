@@ -109,6 +109,24 @@ struct RuleCaches {
     void visit_edges(GC::Cell::Visitor&);
 };
 
+// The rules from the user-agent style sheets only depend on the quirks mode and on which of the sheets' conditions
+// match, so their buckets are built once per process for each combination and shared by every scope that uses it.
+struct SharedUserAgentRuleCache {
+    struct PseudoClassRule {
+        PseudoClass pseudo_class;
+        MatchingRule rule;
+        bool contains_root_pseudo_class { false };
+    };
+
+    bool in_quirks_mode { false };
+    Vector<bool> condition_results;
+
+    RuleCaches rule_caches;
+    SelectorInsights selector_insights;
+    Vector<PseudoClassRule> pseudo_class_rules;
+    bool has_size_container_queries { false };
+};
+
 struct StyleRuleCache {
     StyleRuleCache();
 
@@ -117,7 +135,7 @@ struct StyleRuleCache {
     Array<OwnPtr<RuleCache>, to_underlying(PseudoClass::__Count)> pseudo_class_rule_cache;
     RuleCaches author_rule_cache;
     RuleCaches user_rule_cache;
-    RuleCaches user_agent_rule_cache;
+    SharedUserAgentRuleCache const* user_agent_rule_cache { nullptr };
     bool has_size_container_queries { false };
 
     void visit_edges(GC::Cell::Visitor&);
@@ -185,7 +203,7 @@ public:
 
     RuleCaches const& author_rule_cache() const { return rule_cache().author_rule_cache; }
     RuleCaches const& user_rule_cache() const { return rule_cache().user_rule_cache; }
-    RuleCaches const& user_agent_rule_cache() const { return rule_cache().user_agent_rule_cache; }
+    RuleCaches const& user_agent_rule_cache() const { return rule_cache().user_agent_rule_cache->rule_caches; }
 
     [[nodiscard]] StyleRuleCache const& rule_cache() const;
     [[nodiscard]] StyleInvalidationData const& style_invalidation_data() const;
@@ -202,6 +220,8 @@ public:
     void build_user_style_sheet_if_needed();
 
     void make_rule_cache_for_cascade_origin(CascadeOrigin, StyleRuleCache&);
+    void collect_rules_for_cascade_origin(CascadeOrigin, RuleCaches&, SelectorInsights&, bool& has_size_container_queries, Function<void(PseudoClass, MatchingRule const&, bool contains_root_pseudo_class)> const& add_pseudo_class_rule);
+    [[nodiscard]] SharedUserAgentRuleCache const& shared_user_agent_rule_cache();
     void build_style_invalidation_data_for_cascade_origin(CascadeOrigin, StyleInvalidationData&);
 
     void build_rule_cache();
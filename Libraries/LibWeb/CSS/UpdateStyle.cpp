@@ -5,6 +5,7 @@
  */
 
 #include <AK/ScopeGuard.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGC/ConservativeVector.h>
 #include <LibGC/RootVector.h>
 #include <LibWeb/CSS/ComputedProperties.h>
@@ -361,6 +362,37 @@ static void push_style_update_frame_for_child(GC::ConservativeVector<StyleUpdate
 // The pending :has() flush is triggered by a document-level flag rather than the style invalidator queue, so
 // update_style() and the targeted path in update_style_for_element() have to consume it the same way. Keep that
 // in one place so the two paths cannot drift apart.
+// Below this, handing the elements to other threads costs more than matching them here.
+static constexpr size_t minimum_element_count_for_parallel_rule_matching = 4096;
+
+// When every element is about to be restyled, selector matching (usually the bulk of style computation) is done for
+// all of them on the thread pool first, and the traversal only cascades the matched rules. The cascade stays on the
+// main thread, as it starts transitions and animations, and applies invalidation to the DOM as it goes.
+static void match_rules_in_parallel_if_worthwhile(DOM::Document& document)
+{
+    auto* document_element = document.document_element();
+    if (!document_element)
+        return;
+    if (!document.needs_full_style_update() && !document_element->entire_subtree_needs_style_update())
+        return;
+
+    auto& style_computer = document.style_computer();
+    if (!style_computer.can_match_rules_in_parallel())
+        return;
+
+    // NB: Only elements of the document tree are matched, as shadow trees have rule caches of their own.
+    GC::ConservativeVector<GC::Ref<DOM::Element>> elements;
+    document_element->for_each_in_inclusive_subtree_of_type<DOM::Element>([&](DOM::Element& element) {
+        elements.append(element);
+        return TraversalDecision::Continue;
+    });
+    if (elements.size() < minimum_element_count_for_parallel_rule_matching)
+        return;
+
+    TRACE_EVENT(Style, "CSS::match_rules_in_parallel"sv);
+    style_computer.match_rules_in_parallel(elements);
+}
+
 static void flush_pending_has_invalidations(DOM::Document& document)
 {
     if (document.consume_needs_invalidation_of_elements_affected_by_has())
@@ -395,6 +427,8 @@ void update_style(DOM::Document& document)
     if (document.created_for_appropriate_template_contents())
         return;
 
+    TRACE_EVENT(Style, "CSS::update_style"sv);
+
     if (document.needs_media_rule_evaluation())
         document.evaluate_media_rules_for_style_update();
 
@@ -405,20 +439,28 @@ void update_style(DOM::Document& document)
 
     document.build_registered_properties_cache_for_style_update();
 
+    match_rules_in_parallel_if_worthwhile(document);
+
     RequiredInvalidationAfterStyleChange invalidation;
     constexpr size_t max_style_update_passes = 8;
     for (size_t style_update_pass = 0; style_update_pass < max_style_update_passes; ++style_update_pass) {
         document.style_computer().reset_has_result_cache();
+        document.style_computer().reset_style_sharing_cache();
+        document.style_computer().reset_cascade_cache();
         document.style_computer().reset_ancestor_filter();
 
         invalidation |= update_style_iteratively(document, document.style_computer(), false, false, false, false);
         document.set_needs_full_style_update(false);
+        // NB: The rules were matched for the DOM as it was before this pass, which the pass may have changed.
+        document.style_computer().reset_prematched_rules();
 
         if (!document.style_invalidator().has_pending_invalidations() && !document.needs_style_update() && !document.child_needs_style_update())
             break;
 
         document.style_invalidator().invalidate(document);
     }
+    document.style_computer().reset_style_sharing_cache();
+    document.style_computer().reset_cascade_cache();
 
     apply_document_style_invalidation_after_style_change(document, invalidation);
     document.update_animated_style_if_needed();
@@ -570,6 +612,8 @@ ComputedValues const* update_style_for_element(DOM::Document& document, DOM::Abs
     }
 
     document.style_computer().reset_has_result_cache();
+    document.style_computer().reset_style_sharing_cache();
+    document.style_computer().reset_cascade_cache();
 
     // Re-cascading the inheritance chain requires the style computer's ancestor filter to reflect each recomputed
     // element's DOM ancestors, so that descendant-combinator selectors match correctly. The filter is empty at this
@@ -632,6 +676,8 @@ void update_style_for_subtree_including_display_none(DOM::Document& document, DO
     VERIFY(&update_root->document() == &document);
 
     document.style_computer().reset_has_result_cache();
+    document.style_computer().reset_style_sharing_cache();
+    document.style_computer().reset_cascade_cache();
 
     auto& style_computer = document.style_computer();
     ScopedStyleComputerAncestorChain scoped_ancestor_chain { style_computer, *update_root };
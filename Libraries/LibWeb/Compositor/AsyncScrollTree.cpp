@@ -8,9 +8,89 @@
 #include <LibWeb/Painting/DisplayList.h>
 
 #include <AK/Debug.h>
+#include <AK/NumericLimits.h>
+#include <math.h>
 
 namespace Web::Compositor {
 
+static constexpr float wheel_target_grid_cell_size = 256;
+static constexpr i64 max_wheel_target_grid_cells_per_target = 64;
+
+static Optional<i32> wheel_target_grid_cell_for(float offset)
+{
+    auto cell = floorf(offset / wheel_target_grid_cell_size);
+    // NB: This also rejects NaN.
+    if (!(cell >= static_cast<float>(NumericLimits<i32>::min()) && cell <= static_cast<float>(NumericLimits<i32>::max())))
+        return {};
+    return static_cast<i32>(cell);
+}
+
+static u64 wheel_target_grid_cell_key(i32 x, i32 y)
+{
+    return (static_cast<u64>(static_cast<u32>(x)) << 32) | static_cast<u32>(y);
+}
+
+void WheelTargetGrid::clear()
+{
+    m_cells.clear();
+    m_unbucketed_targets.clear();
+}
+
+void WheelTargetGrid::insert(size_t target_index, Gfx::FloatRect const& viewport_rect)
+{
+    auto min_x = wheel_target_grid_cell_for(viewport_rect.left());
+    auto max_x = wheel_target_grid_cell_for(viewport_rect.right());
+    auto min_y = wheel_target_grid_cell_for(viewport_rect.top());
+    auto max_y = wheel_target_grid_cell_for(viewport_rect.bottom());
+    if (viewport_rect.is_empty() || !min_x.has_value() || !max_x.has_value() || !min_y.has_value() || !max_y.has_value()) {
+        m_unbucketed_targets.append(target_index);
+        return;
+    }
+
+    auto column_count = static_cast<i64>(*max_x) - *min_x + 1;
+    auto row_count = static_cast<i64>(*max_y) - *min_y + 1;
+    if (column_count * row_count > max_wheel_target_grid_cells_per_target) {
+        m_unbucketed_targets.append(target_index);
+        return;
+    }
+
+    for (auto y = *min_y; y <= *max_y; ++y) {
+        for (auto x = *min_x; x <= *max_x; ++x)
+            m_cells.ensure(wheel_target_grid_cell_key(x, y)).append(target_index);
+    }
+}
+
+ReadonlySpan<size_t> WheelTargetGrid::targets_in_cell_at(Gfx::FloatPoint position) const
+{
+    auto x = wheel_target_grid_cell_for(position.x());
+    auto y = wheel_target_grid_cell_for(position.y());
+    if (!x.has_value() || !y.has_value())
+        return {};
+    auto cell = m_cells.find(wheel_target_grid_cell_key(*x, *y));
+    if (cell == m_cells.end())
+        return {};
+    return cell->value.span();
+}
+
+// Finds the last inserted target that contains the position, among the targets the grid has around it.
+template<typename Callback>
+static Optional<size_t> find_last_wheel_target_at(WheelTargetGrid const& grid, Gfx::FloatPoint position, Callback contains_position)
+{
+    Optional<size_t> last_target_index;
+    for (auto targets : { grid.unbucketed_targets(), grid.targets_in_cell_at(position) }) {
+        for (size_t i = targets.size(); i > 0; --i) {
+            auto target_index = targets[i - 1];
+            if (last_target_index.has_value() && target_index < *last_target_index)
+                break;
+            if (contains_position(target_index)) {
+                last_target_index = target_index;
+                break;
+            }
+        }
+    }
+    return last_target_index;
+}
+
 void AsyncScrollTree::set_state(AsyncScrollingState&& state)
 {
     m_scroll_nodes = move(state.scroll_nodes);
@@ -19,10 +99,7 @@ void AsyncScrollTree::set_state(AsyncScrollingState&& state)
     m_main_thread_wheel_event_regions = move(state.main_thread_wheel_event_regions);
     m_blocking_wheel_event_regions = move(state.blocking_wheel_event_regions);
     m_has_blocking_wheel_event_region_covering_viewport = state.has_blocking_wheel_event_region_covering_viewport;
-    m_cached_wheel_hit_test_targets.clear();
-    m_cached_main_thread_wheel_event_targets.clear();
-    m_cached_blocking_wheel_event_targets.clear();
-    m_visual_context_tree = nullptr;
+    clear_cached_wheel_targets();
 }
 
 AsyncScrollNode const* AsyncScrollTree::scroll_node_for_id(AsyncScrollNodeID node_id) const
@@ -262,10 +339,7 @@ Vector<AsyncScrollOffset> AsyncScrollTree::apply_scroll_delta(AsyncScrollNodeID
 
 void AsyncScrollTree::rebuild_wheel_hit_test_targets(RefPtr<Painting::DisplayList const> const& display_list, Painting::AccumulatedVisualContextTree const* visual_context_tree, Painting::ScrollStateSnapshot const& scroll_state_snapshot)
 {
-    m_cached_wheel_hit_test_targets.clear();
-    m_cached_main_thread_wheel_event_targets.clear();
-    m_cached_blocking_wheel_event_targets.clear();
-    m_visual_context_tree = nullptr;
+    clear_cached_wheel_targets();
     m_scroll_state_snapshot = scroll_state_snapshot;
     if (!display_list || !visual_context_tree)
         return;
@@ -282,6 +356,7 @@ void AsyncScrollTree::rebuild_wheel_hit_test_targets(RefPtr<Painting::DisplayLis
             .corner_radii = target.corner_radii,
             .viewport_rect = visual_context_tree->transform_rect_to_viewport(target.visual_context_index, target.rect, scroll_state_snapshot),
         });
+        m_cached_wheel_hit_test_target_grid.insert(m_cached_wheel_hit_test_targets.size() - 1, m_cached_wheel_hit_test_targets.last().viewport_rect);
     }
 
     m_cached_main_thread_wheel_event_targets.ensure_capacity(m_main_thread_wheel_event_regions.size());
@@ -291,6 +366,7 @@ void AsyncScrollTree::rebuild_wheel_hit_test_targets(RefPtr<Painting::DisplayLis
             .rect = region.rect,
             .viewport_rect = visual_context_tree->transform_rect_to_viewport(region.visual_context_index, region.rect, scroll_state_snapshot),
         });
+        m_cached_main_thread_wheel_event_target_grid.insert(m_cached_main_thread_wheel_event_targets.size() - 1, m_cached_main_thread_wheel_event_targets.last().viewport_rect);
     }
 
     for (auto const& region : m_blocking_wheel_event_regions) {
@@ -299,14 +375,23 @@ void AsyncScrollTree::rebuild_wheel_hit_test_targets(RefPtr<Painting::DisplayLis
             .rect = region.rect,
             .viewport_rect = visual_context_tree->transform_rect_to_viewport(region.visual_context_index, region.rect, scroll_state_snapshot),
         });
+        m_cached_blocking_wheel_event_target_grid.insert(m_cached_blocking_wheel_event_targets.size() - 1, m_cached_blocking_wheel_event_targets.last().viewport_rect);
     }
 }
 
 void AsyncScrollTree::clear_wheel_hit_test_targets()
+{
+    clear_cached_wheel_targets();
+}
+
+void AsyncScrollTree::clear_cached_wheel_targets()
 {
     m_cached_wheel_hit_test_targets.clear();
     m_cached_main_thread_wheel_event_targets.clear();
     m_cached_blocking_wheel_event_targets.clear();
+    m_cached_wheel_hit_test_target_grid.clear();
+    m_cached_main_thread_wheel_event_target_grid.clear();
+    m_cached_blocking_wheel_event_target_grid.clear();
     m_visual_context_tree = nullptr;
 }
 
@@ -350,31 +435,29 @@ WheelHitTestResult AsyncScrollTree::hit_test_scroll_node_for_wheel(Gfx::FloatPoi
     if (m_has_blocking_wheel_event_region_covering_viewport)
         return { {}, false, true };
 
-    for (auto const& target : m_cached_main_thread_wheel_event_targets) {
+    auto region_contains_position = [&](auto const& target) {
         if (!target.viewport_rect.contains(position))
-            continue;
-
+            return false;
         auto position_in_context = m_visual_context_tree->transform_point_for_hit_test(target.visual_context_index, position, m_scroll_state_snapshot);
-        if (position_in_context.has_value() && target.rect.contains(*position_in_context))
-            return { {}, true };
-    }
+        return position_in_context.has_value() && target.rect.contains(*position_in_context);
+    };
 
-    for (auto const& target : m_cached_blocking_wheel_event_targets) {
-        if (!target.viewport_rect.contains(position))
-            continue;
+    if (find_last_wheel_target_at(m_cached_main_thread_wheel_event_target_grid, position, [&](size_t index) { return region_contains_position(m_cached_main_thread_wheel_event_targets[index]); }).has_value())
+        return { {}, true };
 
-        auto position_in_context = m_visual_context_tree->transform_point_for_hit_test(target.visual_context_index, position, m_scroll_state_snapshot);
-        if (position_in_context.has_value() && target.rect.contains(*position_in_context))
-            return { {}, false, true };
-    }
+    if (find_last_wheel_target_at(m_cached_blocking_wheel_event_target_grid, position, [&](size_t index) { return region_contains_position(m_cached_blocking_wheel_event_targets[index]); }).has_value())
+        return { {}, false, true };
 
-    for (auto const& target : m_cached_wheel_hit_test_targets.in_reverse()) {
+    // Later targets are painted on top of earlier ones.
+    auto topmost_target_index = find_last_wheel_target_at(m_cached_wheel_hit_test_target_grid, position, [&](size_t index) {
+        auto const& target = m_cached_wheel_hit_test_targets[index];
         if (!target.viewport_rect.contains(position))
-            continue;
-
+            return false;
         auto position_in_context = m_visual_context_tree->transform_point_for_hit_test(target.visual_context_index, position, m_scroll_state_snapshot);
-        if (!position_in_context.has_value() || !wheel_hit_test_target_contains_point(target, *position_in_context))
-            continue;
+        return position_in_context.has_value() && wheel_hit_test_target_contains_point(target, *position_in_context);
+    });
+    if (topmost_target_index.has_value()) {
+        auto const& target = m_cached_wheel_hit_test_targets[*topmost_target_index];
         if (!target.target_node_id.has_value())
             return {};
         return hit_test_result_for_scroll_node(*target.target_node_id, delta);
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/Optional.h>
 #include <AK/RefPtr.h>
+#include <AK/Span.h>
 #include <AK/Vector.h>
 #include <LibGfx/CornerRadii.h>
 #include <LibGfx/Point.h>
@@ -47,6 +49,22 @@ struct CachedBlockingWheelEventTarget {
     Gfx::FloatRect viewport_rect;
 };
 
+// Uniform grid over the viewport rects of cached targets, so a wheel event only tests the targets around its position
+// instead of every target on the page. Targets that are too large for the grid are always tested.
+class WheelTargetGrid {
+public:
+    void clear();
+    void insert(size_t target_index, Gfx::FloatRect const& viewport_rect);
+
+    // Both in the order the targets were inserted.
+    ReadonlySpan<size_t> targets_in_cell_at(Gfx::FloatPoint) const;
+    ReadonlySpan<size_t> unbucketed_targets() const { return m_unbucketed_targets.span(); }
+
+private:
+    HashMap<u64, Vector<size_t>> m_cells;
+    Vector<size_t> m_unbucketed_targets;
+};
+
 // Mutable compositor-side copy of AsyncScrollingState. Current scroll offsets live in ScrollStateSnapshot; this tree
 // owns scroll node geometry and derived hit-test targets.
 class WEB_API AsyncScrollTree {
@@ -78,6 +96,7 @@ private:
     Gfx::FloatPoint cumulative_device_sticky_offset_for_node(Painting::VisualContextIndex, Painting::ScrollStateSnapshot const&) const;
     Gfx::FloatPoint apply_scroll_delta_to_node(AsyncScrollNode const&, Gfx::FloatPoint delta, Painting::ScrollStateSnapshot&);
     void update_sticky_offsets(Painting::ScrollStateSnapshot&) const;
+    void clear_cached_wheel_targets();
 
     Vector<AsyncScrollNode> m_scroll_nodes;
     Vector<AsyncStickyArea> m_sticky_areas;
@@ -87,6 +106,9 @@ private:
     Vector<BlockingWheelEventRegion> m_blocking_wheel_event_regions;
     Vector<CachedMainThreadWheelEventTarget> m_cached_main_thread_wheel_event_targets;
     Vector<CachedBlockingWheelEventTarget> m_cached_blocking_wheel_event_targets;
+    WheelTargetGrid m_cached_wheel_hit_test_target_grid;
+    WheelTargetGrid m_cached_main_thread_wheel_event_target_grid;
+    WheelTargetGrid m_cached_blocking_wheel_event_target_grid;
     Painting::AccumulatedVisualContextTree const* m_visual_context_tree { nullptr };
     Painting::ScrollStateSnapshot m_scroll_state_snapshot;
     bool m_has_blocking_wheel_event_region_covering_viewport { false };
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/StdLibExtras.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibWeb/Compositor/CompositorAnimation.h>
+#include <LibWeb/Painting/AccumulatedVisualContext.h>
+
+namespace Web::Compositor {
+
+// NB: This mirrors the time-based subset of the timing model in Animations::AnimationEffect, as the compositor has no
+//     access to the effect itself. Only effects on a document or scroll timeline with a non-zero iteration duration
+//     get here.
+
+double CompositorAnimation::local_time_after(AK::Duration elapsed) const
+{
+    return local_time + elapsed.to_seconds_f64() * 1000.0 * playback_rate;
+}
+
+// https://drafts.csswg.org/scroll-animations-1/#scroll-timeline-progress
+double CompositorAnimation::local_time_at_scroll_offset(Gfx::FloatPoint device_scroll_offset) const
+{
+    VERIFY(scroll_timeline.has_value());
+    auto scroll_offset = scroll_timeline->is_vertical ? device_scroll_offset.y() : device_scroll_offset.x();
+    auto current_time = static_cast<double>(scroll_offset) / static_cast<double>(scroll_timeline->scroll_range) * 100.0;
+    return local_time + (current_time - scroll_timeline->current_time) * playback_rate;
+}
+
+// https://www.w3.org/TR/web-animations-1/#active-duration
+double CompositorAnimation::active_duration() const
+{
+    if (iteration_duration == 0 || iteration_count == 0)
+        return 0;
+    return iteration_duration * iteration_count;
+}
+
+bool CompositorAnimation::is_finished_at(double local_time) const
+{
+    auto active_duration = this->active_duration();
+    auto end_time = max(start_delay + active_duration + end_delay, 0.0);
+
+    // Once the effect is past its active interval in the direction of playback, its value can no longer change.
+    if (playback_rate < 0)
+        return local_time <= max(min(start_delay, end_time), 0.0);
+    return local_time >= max(min(start_delay + active_duration, end_time), 0.0);
+}
+
+// https://www.w3.org/TR/web-animations-1/#directed-progress
+Optional<double> CompositorAnimation::directed_progress_at(double local_time) const
+{
+    if (iteration_duration <= 0)
+        return {};
+
+    auto active_duration = this->active_duration();
+    auto end_time = max(start_delay + active_duration + end_delay, 0.0);
+    auto before_active_boundary_time = max(min(start_delay, end_time), 0.0);
+    auto after_active_boundary_time = max(min(start_delay + active_duration, end_time), 0.0);
+    auto going_backwards = playback_rate < 0;
+
+    // https://www.w3.org/TR/web-animations-1/#animation-effect-phases-and-states
+    auto is_in_before_phase = local_time < before_active_boundary_time || (going_backwards && local_time == before_active_boundary_time);
+    auto is_in_after_phase = !is_in_before_phase && (local_time > after_active_boundary_time || (!going_backwards && local_time == after_active_boundary_time));
+
+    // https://www.w3.org/TR/web-animations-1/#calculating-the-active-time
+    double active_time;
+    if (is_in_before_phase) {
+        if (!fills_backwards)
+            return {};
+        active_time = max(local_time - start_delay, 0.0);
+    } else if (is_in_after_phase) {
+        if (!fills_forwards)
+            return {};
+        active_time = max(min(local_time - start_delay, active_duration), 0.0);
+    } else {
+        active_time = local_time - start_delay;
+    }
+
+    // https://www.w3.org/TR/web-animations-1/#overall-progress
+    auto overall_progress = active_time / iteration_duration + iteration_start;
+
+    // https://www.w3.org/TR/web-animations-1/#simple-iteration-progress
+    auto simple_iteration_progress = isinf(overall_progress) ? fmod(iteration_start, 1.0) : fmod(overall_progress, 1.0);
+    if (simple_iteration_progress == 0.0 && !is_in_before_phase && active_time == active_duration && iteration_count != 0.0)
+        simple_iteration_progress = 1.0;
+
+    // https://www.w3.org/TR/web-animations-1/#current-iteration
+    double current_iteration;
+    if (is_in_after_phase && isinf(iteration_count))
+        current_iteration = iteration_count;
+    else if (simple_iteration_progress == 1.0)
+        current_iteration = floor(overall_progress) - 1.0;
+    else
+        current_iteration = floor(overall_progress);
+
+    bool current_direction_is_forwards = true;
+    switch (direction) {
+    case Direction::Normal:
+        break;
+    case Direction::Reverse:
+        current_direction_is_forwards = false;
+        break;
+    case Direction::Alternate:
+    case Direction::AlternateReverse: {
+        auto d = current_iteration;
+        if (direction == Direction::AlternateReverse)
+            d += 1.0;
+        current_direction_is_forwards = isinf(d) || fmod(d, 2.0) == 0.0;
+        break;
+    }
+    }
+
+    if (current_direction_is_forwards)
+        return simple_iteration_progress;
+    return 1.0 - simple_iteration_progress;
+}
+
+CompositorAnimation::SamplePosition CompositorAnimation::sample_position_at(double local_time, size_t sample_count) const
+{
+    // The last sample is the value without the effect.
+    VERIFY(sample_count >= 3);
+    auto directed_progress = directed_progress_at(local_time);
+    if (!directed_progress.has_value())
+        return { sample_count - 1, 0 };
+
+    auto last_progress_sample = sample_count - 2;
+    auto position = clamp(*directed_progress, 0.0, 1.0) * static_cast<double>(last_progress_sample);
+    auto index = min(static_cast<size_t>(position), last_progress_sample - 1);
+    if (!interpolates_between_samples) {
+        if (position >= static_cast<double>(last_progress_sample))
+            return { last_progress_sample, 0 };
+        return { index, 0 };
+    }
+    return { index, static_cast<float>(position - static_cast<double>(index)) };
+}
+
+void CompositorAnimation::apply_to(Painting::EffectsData& effects, double local_time) const
+{
+    VERIFY(property == Property::Opacity);
+    auto [index, weight] = sample_position_at(local_time, opacity_samples.size());
+    auto opacity = opacity_samples[index];
+    if (weight > 0)
+        opacity += (opacity_samples[index + 1] - opacity) * weight;
+    effects.opacity = opacity;
+}
+
+void CompositorAnimation::apply_to(Painting::TransformData& transform, double local_time) const
+{
+    VERIFY(property == Property::Transform);
+    auto [index, weight] = sample_position_at(local_time, transform_samples.size());
+    auto matrix = transform_samples[index];
+    if (weight > 0) {
+        // NB: Samples are close enough together that blending the matrices component-wise stays visually
+        //     indistinguishable from decomposing and interpolating them.
+        auto const& next = transform_samples[index + 1];
+        for (size_t row = 0; row < 4; ++row) {
+            for (size_t column = 0; column < 4; ++column)
+                matrix[row, column] += (next[row, column] - matrix[row, column]) * weight;
+        }
+    }
+    transform.matrix = matrix;
+}
+
+}
+
+namespace IPC {
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::Compositor::CompositorAnimation const& animation)
+{
+    TRY(encoder.encode(animation.id));
+    TRY(encoder.encode(animation.node_index));
+    TRY(encoder.encode(animation.property));
+    TRY(encoder.encode(animation.local_time));
+    TRY(encoder.encode(animation.playback_rate));
+    TRY(encoder.encode(animation.start_delay));
+    TRY(encoder.encode(animation.end_delay));
+    TRY(encoder.encode(animation.iteration_duration));
+    TRY(encoder.encode(animation.iteration_start));
+    TRY(encoder.encode(animation.iteration_count));
+    TRY(encoder.encode(animation.direction));
+    TRY(encoder.encode(animation.fills_backwards));
+    TRY(encoder.encode(animation.fills_forwards));
+    TRY(encoder.encode(animation.interpolates_between_samples));
+    TRY(encoder.encode(animation.opacity_samples));
+    TRY(encoder.encode(animation.transform_samples));
+    TRY(encoder.encode(animation.scroll_timeline.has_value()));
+    if (animation.scroll_timeline.has_value()) {
+        TRY(encoder.encode(animation.scroll_timeline->scroll_node_index));
+        TRY(encoder.encode(animation.scroll_timeline->is_vertical));
+        TRY(encoder.encode(animation.scroll_timeline->scroll_range));
+        TRY(encoder.encode(animation.scroll_timeline->current_time));
+    }
+    return {};
+}
+
+template<>
+ErrorOr<Web::Compositor::CompositorAnimation> decode(Decoder& decoder)
+{
+    Web::Compositor::CompositorAnimation animation {
+        .id = TRY(decoder.decode<u64>()),
+        .node_index = TRY(decoder.decode<Web::Painting::VisualContextIndex>()),
+        .property = TRY(decoder.decode<Web::Compositor::CompositorAnimation::Property>()),
+        .local_time = TRY(decoder.decode<double>()),
+        .playback_rate = TRY(decoder.decode<double>()),
+        .start_delay = TRY(decoder.decode<double>()),
+        .end_delay = TRY(decoder.decode<double>()),
+        .iteration_duration = TRY(decoder.decode<double>()),
+        .iteration_start = TRY(decoder.decode<double>()),
+        .iteration_count = TRY(decoder.decode<double>()),
+        .direction = TRY(decoder.decode<Web::Compositor::CompositorAnimation::Direction>()),
+        .fills_backwards = TRY(decoder.decode<bool>()),
+        .fills_forwards = TRY(decoder.decode<bool>()),
+        .interpolates_between_samples = TRY(decoder.decode<bool>()),
+        .opacity_samples = TRY(decoder.decode<Vector<float>>()),
+        .transform_samples = TRY(decoder.decode<Vector<Gfx::FloatMatrix4x4>>()),
+    };
+
+    if (TRY(decoder.decode<bool>())) {
+        animation.scroll_timeline = Web::Compositor::CompositorAnimation::ScrollTimelineSource {
+            .scroll_node_index = TRY(decoder.decode<Web::Painting::VisualContextIndex>()),
+            .is_vertical = TRY(decoder.decode<bool>()),
+            .scroll_range = TRY(decoder.decode<float>()),
+            .current_time = TRY(decoder.decode<double>()),
+        };
+        if (!(animation.scroll_timeline->scroll_range > 0) || isinf(animation.scroll_timeline->scroll_range))
+            return Error::from_string_literal("Compositor animation on a scroll timeline needs a positive scroll range");
+    }
+
+    auto samples_size = animation.property == Web::Compositor::CompositorAnimation::Property::Opacity
+        ? animation.opacity_samples.size()
+        : animation.transform_samples.size();
+    if (samples_size < 3)
+        return Error::from_string_literal("Compositor animation needs at least two samples and the underlying value");
+    return animation;
+}
+
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibGfx/Matrix4x4.h>
+#include <LibGfx/Point.h>
+#include <LibIPC/Forward.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/Painting/VisualContextIndex.h>
+
+namespace Web::Painting {
+
+struct TransformData;
+struct EffectsData;
+
+}
+
+namespace Web::Compositor {
+
+// An opacity or transform animation that the compositor samples on every vsync by itself, so it keeps running at the
+// display's refresh rate while the main thread is busy. The main thread bakes the keyframes (including all easing)
+// into evenly spaced samples over one iteration; the compositor only needs the effect's timing to pick a sample.
+// Animations on a scroll timeline are sampled whenever the compositor scrolls instead, so they stay in step with
+// async scrolling.
+struct WEB_API CompositorAnimation {
+    enum class Property : u8 {
+        Opacity,
+        Transform,
+    };
+
+    enum class Direction : u8 {
+        Normal,
+        Reverse,
+        Alternate,
+        AlternateReverse,
+    };
+
+    // Changes whenever the main thread bakes new samples, so unchanged animations are not sent again.
+    u64 id { 0 };
+    Painting::VisualContextIndex node_index;
+    Property property { Property::Opacity };
+
+    // All times are in milliseconds, or in percent of the timeline for scroll timelines. The local time is the
+    // effect's local time when the animation was sent.
+    double local_time { 0 };
+    double playback_rate { 1 };
+    double start_delay { 0 };
+    double end_delay { 0 };
+    double iteration_duration { 0 };
+    double iteration_start { 0 };
+    double iteration_count { 1 };
+    Direction direction { Direction::Normal };
+    bool fills_backwards { false };
+    bool fills_forwards { false };
+
+    // Step timing functions must not be smoothed over, so their samples are held instead.
+    bool interpolates_between_samples { true };
+
+    // Samples of the animated value at evenly spaced directed progress values in [0, 1], followed by the value without
+    // the effect, which applies whenever the effect has no active time.
+    Vector<float> opacity_samples;
+    Vector<Gfx::FloatMatrix4x4> transform_samples;
+
+    struct ScrollTimelineSource {
+        Painting::VisualContextIndex scroll_node_index;
+        bool is_vertical { true };
+        // The device pixels that the scroll node scrolls between 0% and 100% of the timeline.
+        float scroll_range { 0 };
+        // The timeline's current time when the animation was sent, in percent.
+        double current_time { 0 };
+    };
+    Optional<ScrollTimelineSource> scroll_timeline;
+
+    double local_time_after(AK::Duration elapsed) const;
+    double local_time_at_scroll_offset(Gfx::FloatPoint device_scroll_offset) const;
+    bool is_finished_at(double local_time) const;
+
+    void apply_to(Painting::EffectsData&, double local_time) const;
+    void apply_to(Painting::TransformData&, double local_time) const;
+
+private:
+    double active_duration() const;
+    Optional<double> directed_progress_at(double local_time) const;
+
+    struct SamplePosition {
+        size_t index { 0 };
+        float weight { 0 };
+    };
+    SamplePosition sample_position_at(double local_time, size_t sample_count) const;
+};
+
+}
+
+namespace IPC {
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::Compositor::CompositorAnimation const&);
+template<>
+WEB_API ErrorOr<Web::Compositor::CompositorAnimation> decode(Decoder&);
+
+}
@@ -45,6 +45,11 @@ void CompositorContextHandle::update_visual_context_tree(Painting::AccumulatedVi
     m_host.update_visual_context_tree(m_context_id, move(visual_context_tree));
 }
 
+void CompositorContextHandle::update_compositor_animations(u64 visual_context_tree_version, Vector<CompositorAnimation> animations)
+{
+    m_host.update_compositor_animations(m_context_id, visual_context_tree_version, move(animations));
+}
+
 void CompositorContextHandle::update_video_frame(Painting::VideoFrameResourceId frame_id, NonnullRefPtr<Media::VideoFrame const> frame)
 {
     m_host.update_video_frame(m_context_id, frame_id, move(frame));
@@ -91,10 +96,10 @@ void CompositorContextHandle::viewport_size_updated(Gfx::IntSize viewport_size,
     m_host.viewport_size_updated(m_context_id, viewport_size, window_resize_in_progress);
 }
 
-void CompositorContextHandle::present_frame(Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect)
+void CompositorContextHandle::present_frame(Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect, FrameTiming const& frame_timing)
 {
     m_host.flush_canvas_2d_stream();
-    m_host.present_frame(m_context_id, viewport_rect, damage_rect);
+    m_host.present_frame(m_context_id, viewport_rect, damage_rect, frame_timing);
 }
 
 void CompositorContextHandle::request_screenshot(NonnullRefPtr<Gfx::PaintingSurface> target_surface, Function<void()>&& callback)
@@ -15,6 +15,8 @@
 #include <LibGfx/Rect.h>
 #include <LibGfx/Size.h>
 #include <LibMedia/Forward.h>
+#include <LibWeb/Compositor/CompositorAnimation.h>
+#include <LibWeb/Compositor/FrameTiming.h>
 #include <LibWeb/Compositor/Types.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/Forward.h>
@@ -37,6 +39,7 @@ public:
 
     void update_display_list(NonnullRefPtr<Painting::DisplayList>, Painting::AccumulatedVisualContextTree, Painting::DisplayListResourceTransaction&&, Painting::ScrollStateSnapshot&&);
     void update_visual_context_tree(Painting::AccumulatedVisualContextTree);
+    void update_compositor_animations(u64 visual_context_tree_version, Vector<CompositorAnimation>);
     void update_video_frame(Painting::VideoFrameResourceId, NonnullRefPtr<Media::VideoFrame const>);
     void clear_video_frame(Painting::VideoFrameResourceId);
     void update_scroll_state(Painting::ScrollStateSnapshot&&);
@@ -47,7 +50,7 @@ public:
     void cancel_smooth_scroll(AsyncScrollNodeStableID);
     PendingAsyncScrollUpdates take_pending_async_scroll_updates();
     void viewport_size_updated(Gfx::IntSize, WindowResizingInProgress);
-    void present_frame(Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect);
+    void present_frame(Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect, FrameTiming const&);
     void request_screenshot(NonnullRefPtr<Gfx::PaintingSurface>, Function<void()>&& callback);
 
 private:
@@ -81,6 +84,7 @@ public:
 
     virtual void update_display_list(CompositorContextId, NonnullRefPtr<Painting::DisplayList>, Painting::AccumulatedVisualContextTree, Painting::DisplayListResourceTransaction&&, Painting::ScrollStateSnapshot&&) = 0;
     virtual void update_visual_context_tree(CompositorContextId, Painting::AccumulatedVisualContextTree) = 0;
+    virtual void update_compositor_animations(CompositorContextId, u64 visual_context_tree_version, Vector<CompositorAnimation>) = 0;
     virtual void update_video_frame(CompositorContextId, Painting::VideoFrameResourceId, NonnullRefPtr<Media::VideoFrame const>) = 0;
     virtual void clear_video_frame(CompositorContextId, Painting::VideoFrameResourceId) = 0;
     virtual void update_scroll_state(CompositorContextId, Painting::ScrollStateSnapshot&&) = 0;
@@ -92,9 +96,13 @@ public:
     virtual void cancel_smooth_scroll(CompositorContextId, AsyncScrollNodeStableID) = 0;
     virtual PendingAsyncScrollUpdates take_pending_async_scroll_updates(CompositorContextId) = 0;
     virtual void viewport_size_updated(CompositorContextId, Gfx::IntSize, WindowResizingInProgress) = 0;
-    virtual void present_frame(CompositorContextId, Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect) = 0;
+    virtual void present_frame(CompositorContextId, Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect, FrameTiming const&) = 0;
     virtual void request_screenshot(CompositorContextId, NonnullRefPtr<Gfx::PaintingSurface>, Function<void()>&& callback) = 0;
 
+    // Calls the callback on the compositor's next vsync tick for a display with the given refresh rate. Returns false if
+    // there is no compositor to ask, in which case the callback is never called.
+    virtual bool request_vsync_tick(double refresh_rate, Function<void()>&& callback) = 0;
+
 protected:
     CompositorHost();
 
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/QuickSort.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+#include <LibWeb/Compositor/FrameScheduler.h>
+#include <LibWeb/Compositor/FrameTiming.h>
+
+namespace Web::Compositor {
+
+// Extra lead time on top of the predicted cost, for timer slop and the compositor picking up the frame.
+static constexpr i64 safety_margin_ns = 1'000'000;
+
+// The vsync phase drifts away from the last tick we heard about, so only line up with ticks that are this recent.
+static constexpr i64 vsync_phase_expiry_ns = 250'000'000;
+
+// Frames are only ever paced down to half rate once this many recent frames have been measured.
+static constexpr size_t minimum_samples_for_half_rate = 8;
+
+FrameScheduler::FrameScheduler(double refresh_rate)
+{
+    set_refresh_rate(refresh_rate);
+}
+
+void FrameScheduler::set_refresh_rate(double refresh_rate)
+{
+    if (refresh_rate != refresh_rate || refresh_rate <= 0 || refresh_rate >= AK::Infinity<double>)
+        refresh_rate = 60.0;
+    m_refresh_interval_ns = max<i64>(1, static_cast<i64>(1'000'000'000.0 / refresh_rate));
+    update_half_rate();
+}
+
+void FrameScheduler::did_finish_frame(FrameTiming const& frame_timing)
+{
+    auto const& rendering_opportunity = frame_timing.stage(FrameTimingStage::RenderingOpportunity);
+    auto const& ipc_send = frame_timing.stage(FrameTimingStage::IPCSend);
+    if (rendering_opportunity.has_value() && ipc_send.has_value())
+        m_main_thread_costs.enqueue(ipc_send.end_ns() - rendering_opportunity.start_ns);
+
+    if (auto const& vsync_tick = frame_timing.stage(FrameTimingStage::VSyncTick); vsync_tick.has_value())
+        m_last_vsync_ns = max(m_last_vsync_ns.value_or(vsync_tick.start_ns), vsync_tick.start_ns);
+
+    update_half_rate();
+}
+
+void FrameScheduler::did_finish_frames(FrameTimeline const& timeline, CompositorContextId context_id)
+{
+    auto const& recent_frames = timeline.recent_frames();
+    auto finished_frame_count = timeline.finished_frame_count();
+    auto new_frame_count = min<u64>(finished_frame_count - m_seen_finished_frame_count, recent_frames.size());
+    m_seen_finished_frame_count = finished_frame_count;
+
+    for (size_t i = recent_frames.size() - new_frame_count; i < recent_frames.size(); ++i) {
+        auto const& frame_timing = recent_frames.at(i);
+        if (frame_timing.context_id == context_id)
+            did_finish_frame(frame_timing);
+    }
+}
+
+MonotonicTime FrameScheduler::schedule_rendering_update(MonotonicTime now)
+{
+    auto now_ns = now.nanoseconds();
+    auto frame_interval_ns = m_refresh_interval_ns * (m_is_running_at_half_rate ? 2 : 1);
+    auto lead_time_ns = predicted_main_thread_cost_ns() + safety_margin_ns;
+
+    i64 start_ns = now_ns;
+    if (m_last_vsync_ns.has_value() && now_ns - *m_last_vsync_ns < vsync_phase_expiry_ns) {
+        // Aim at the first vsync the frame can still make, at most one per frame interval, and on the same phase as
+        // the last vsync the compositor picked a frame up on. At half rate, that means every other vsync.
+        auto earliest_target_ns = now_ns + lead_time_ns;
+        if (m_last_targeted_vsync_ns.has_value())
+            earliest_target_ns = max(earliest_target_ns, *m_last_targeted_vsync_ns + frame_interval_ns);
+        auto intervals_until_target = max<i64>(0, ceil_div(earliest_target_ns - *m_last_vsync_ns, frame_interval_ns));
+        auto target_ns = *m_last_vsync_ns + intervals_until_target * frame_interval_ns;
+        m_last_targeted_vsync_ns = target_ns;
+        start_ns = target_ns - lead_time_ns;
+    } else {
+        // Without a recent vsync to line up with, just keep the updates a frame interval apart.
+        m_last_targeted_vsync_ns.clear();
+        if (m_last_rendering_update_ns.has_value())
+            start_ns = *m_last_rendering_update_ns + frame_interval_ns;
+    }
+
+    start_ns = max(start_ns, now_ns);
+    m_last_rendering_update_ns = start_ns;
+    return now + AK::Duration::from_nanoseconds(start_ns - now_ns);
+}
+
+i64 FrameScheduler::predicted_main_thread_cost_ns() const
+{
+    if (m_main_thread_costs.is_empty())
+        return 0;
+
+    // The 75th percentile follows a sustained change in cost within a few frames, without every single slow frame
+    // (e.g. one with a garbage collection in it) pushing the following ones earlier.
+    Vector<i64, main_thread_cost_history_size> costs;
+    for (auto cost : m_main_thread_costs)
+        costs.unchecked_append(cost);
+    quick_sort(costs);
+    return costs[costs.size() * 3 / 4];
+}
+
+void FrameScheduler::update_half_rate()
+{
+    auto predicted_cost_ns = predicted_main_thread_cost_ns();
+    if (!m_is_running_at_half_rate) {
+        if (m_main_thread_costs.size() >= minimum_samples_for_half_rate && predicted_cost_ns > m_refresh_interval_ns)
+            m_is_running_at_half_rate = true;
+        return;
+    }
+
+    // Only go back to the full rate once there is some headroom, so we don't flip between the two on every frame.
+    if (predicted_cost_ns < m_refresh_interval_ns * 3 / 4)
+        m_is_running_at_half_rate = false;
+}
+
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/CircularQueue.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+#include <LibWeb/Compositor/Types.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::Compositor {
+
+// Decides when WebContent starts its next rendering update. The cost of the main thread's part of a frame is predicted
+// from the most recently finished frames, so that the update starts early enough for the frame to reach the compositor
+// before the vsync it is aimed at. If the main thread can't keep up with the display, frames are paced to every other
+// vsync instead of juddering between one and two refresh intervals.
+class WEB_API FrameScheduler {
+public:
+    explicit FrameScheduler(double refresh_rate);
+
+    void set_refresh_rate(double refresh_rate);
+    AK::Duration refresh_interval() const { return AK::Duration::from_nanoseconds(m_refresh_interval_ns); }
+
+    void did_finish_frame(FrameTiming const&);
+
+    // Feeds the frames of the given compositor context that finished since the last call.
+    void did_finish_frames(FrameTimeline const&, CompositorContextId);
+
+    // Returns when the next rendering update should start, at the earliest now.
+    MonotonicTime schedule_rendering_update(MonotonicTime now);
+
+    AK::Duration predicted_main_thread_cost() const { return AK::Duration::from_nanoseconds(predicted_main_thread_cost_ns()); }
+    bool is_running_at_half_rate() const { return m_is_running_at_half_rate; }
+
+private:
+    i64 predicted_main_thread_cost_ns() const;
+    void update_half_rate();
+
+    static constexpr size_t main_thread_cost_history_size = 16;
+
+    i64 m_refresh_interval_ns { 0 };
+    CircularQueue<i64, main_thread_cost_history_size> m_main_thread_costs;
+    Optional<i64> m_last_vsync_ns;
+    Optional<i64> m_last_targeted_vsync_ns;
+    Optional<i64> m_last_rendering_update_ns;
+    u64 m_seen_finished_frame_count { 0 };
+    bool m_is_running_at_half_rate { false };
+};
+
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibWeb/Compositor/FrameTiming.h>
+
+namespace Web::Compositor {
+
+StringView frame_timing_stage_name(FrameTimingStage stage)
+{
+    switch (stage) {
+    case FrameTimingStage::RenderingOpportunity:
+        return "rendering-opportunity"sv;
+    case FrameTimingStage::Style:
+        return "style"sv;
+    case FrameTimingStage::Layout:
+        return "layout"sv;
+    case FrameTimingStage::PaintRecording:
+        return "paint-recording"sv;
+    case FrameTimingStage::IPCSend:
+        return "ipc-send"sv;
+    case FrameTimingStage::CompositorReceive:
+        return "compositor-receive"sv;
+    case FrameTimingStage::ResourceTransaction:
+        return "resource-transaction"sv;
+    case FrameTimingStage::VSyncTick:
+        return "vsync-tick"sv;
+    case FrameTimingStage::Raster:
+        return "raster"sv;
+    case FrameTimingStage::Present:
+        return "present"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void FrameTiming::record(FrameTimingStage stage, MonotonicTime start, MonotonicTime end)
+{
+    record(stage, Stage { start.nanoseconds(), (end - start).to_nanoseconds() });
+}
+
+void FrameTiming::record(FrameTimingStage stage, Stage timing)
+{
+    auto& recorded_stage = stages[to_underlying(stage)];
+    if (!recorded_stage.has_value())
+        recorded_stage.start_ns = timing.start_ns;
+    recorded_stage.duration_ns += timing.duration_ns;
+}
+
+bool FrameTiming::missed_deadline(AK::Duration refresh_interval) const
+{
+    auto interval_ns = refresh_interval.to_nanoseconds();
+
+    auto const& rendering_opportunity = stage(FrameTimingStage::RenderingOpportunity);
+    auto const& ipc_send = stage(FrameTimingStage::IPCSend);
+    if (rendering_opportunity.has_value() && ipc_send.has_value() && ipc_send.end_ns() - rendering_opportunity.start_ns > interval_ns)
+        return true;
+
+    auto const& vsync_tick = stage(FrameTimingStage::VSyncTick);
+    auto const& present = stage(FrameTimingStage::Present);
+    return vsync_tick.has_value() && present.has_value() && present.end_ns() - vsync_tick.start_ns > interval_ns;
+}
+
+FrameTimeline& FrameTimeline::the()
+{
+    static FrameTimeline timeline;
+    return timeline;
+}
+
+void FrameTimeline::did_finish_frame(FrameTiming const& frame_timing)
+{
+    m_recent_frames.enqueue(frame_timing);
+    if (!frame_timing.was_dropped) {
+        ++m_presented_frame_count;
+        return;
+    }
+
+    ++m_dropped_frame_count;
+    if (on_dropped_frame)
+        on_dropped_frame(m_dropped_frame_count);
+}
+
+String FrameTimeline::to_trace_event_json() const
+{
+    // Each process gets its own track, with a row per compositor context.
+    constexpr u64 web_content_track = 1;
+    constexpr u64 compositor_track = 2;
+
+    JsonArray events;
+    auto add_track_name = [&](u64 track, StringView name) {
+        JsonObject args;
+        args.set("name"sv, name);
+
+        JsonObject event;
+        event.set("name"sv, "process_name"sv);
+        event.set("ph"sv, "M"sv);
+        event.set("pid"sv, track);
+        event.set("args"sv, move(args));
+        events.must_append(move(event));
+    };
+    add_track_name(web_content_track, "WebContent"sv);
+    add_track_name(compositor_track, "Compositor"sv);
+
+    for (auto const& frame_timing : m_recent_frames) {
+        for (size_t i = 0; i < frame_timing_stage_count; ++i) {
+            auto stage = static_cast<FrameTimingStage>(i);
+            auto const& timing = frame_timing.stage(stage);
+            if (!timing.has_value())
+                continue;
+
+            JsonObject args;
+            args.set("frame_id"sv, frame_timing.frame_id);
+            args.set("dropped"sv, frame_timing.was_dropped);
+
+            JsonObject event;
+            event.set("name"sv, frame_timing_stage_name(stage));
+            event.set("cat"sv, "frame"sv);
+            event.set("ph"sv, "X"sv);
+            event.set("ts"sv, static_cast<double>(timing.start_ns) / 1000.0);
+            event.set("dur"sv, static_cast<double>(timing.duration_ns) / 1000.0);
+            event.set("pid"sv, stage < FrameTimingStage::CompositorReceive ? web_content_track : compositor_track);
+            event.set("tid"sv, frame_timing.context_id.value());
+            event.set("args"sv, move(args));
+            events.must_append(move(event));
+        }
+    }
+
+    JsonObject trace;
+    trace.set("traceEvents"sv, move(events));
+    trace.set("displayTimeUnit"sv, "ms"sv);
+    return trace.serialized();
+}
+
+}
+
+namespace IPC {
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::Compositor::FrameTiming const& frame_timing)
+{
+    TRY(encoder.encode(frame_timing.frame_id));
+    TRY(encoder.encode(frame_timing.context_id));
+    for (auto const& stage : frame_timing.stages) {
+        TRY(encoder.encode(stage.start_ns));
+        TRY(encoder.encode(stage.duration_ns));
+    }
+    TRY(encoder.encode(frame_timing.was_dropped));
+    return {};
+}
+
+template<>
+ErrorOr<Web::Compositor::FrameTiming> decode(Decoder& decoder)
+{
+    Web::Compositor::FrameTiming frame_timing;
+    frame_timing.frame_id = TRY(decoder.decode<u64>());
+    frame_timing.context_id = TRY(decoder.decode<Web::Compositor::CompositorContextId>());
+    for (auto& stage : frame_timing.stages) {
+        stage.start_ns = TRY(decoder.decode<i64>());
+        stage.duration_ns = TRY(decoder.decode<i64>());
+    }
+    frame_timing.was_dropped = TRY(decoder.decode<bool>());
+    return frame_timing;
+}
+
+}
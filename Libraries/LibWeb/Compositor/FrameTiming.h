@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/CircularQueue.h>
+#include <AK/Function.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+#include <LibIPC/Forward.h>
+#include <LibWeb/Compositor/Types.h>
+#include <LibWeb/Export.h>
+
+namespace Web::Compositor {
+
+// The stages a frame goes through on its way from a rendering opportunity in WebContent to the screen, in order.
+enum class FrameTimingStage : u8 {
+    // WebContent
+    RenderingOpportunity,
+    Style,
+    Layout,
+    PaintRecording,
+    IPCSend,
+    // Compositor
+    CompositorReceive,
+    ResourceTransaction,
+    VSyncTick,
+    Raster,
+    Present,
+};
+
+static constexpr size_t frame_timing_stage_count = to_underlying(FrameTimingStage::Present) + 1;
+
+WEB_API StringView frame_timing_stage_name(FrameTimingStage);
+
+// The timing of a single frame, filled in by WebContent and then completed by the compositor. Timestamps are in
+// nanoseconds of the monotonic clock, which both processes share.
+struct WEB_API FrameTiming {
+    struct Stage {
+        i64 start_ns { 0 };
+        i64 duration_ns { 0 };
+
+        bool has_value() const { return start_ns != 0; }
+        i64 end_ns() const { return start_ns + duration_ns; }
+    };
+
+    u64 frame_id { 0 };
+    CompositorContextId context_id;
+    Array<Stage, frame_timing_stage_count> stages {};
+
+    // Set by the compositor if a newer frame replaced this one before it was presented, or if it reached the screen
+    // later than a single refresh interval allows (see missed_deadline()).
+    bool was_dropped { false };
+
+    Stage const& stage(FrameTimingStage stage) const { return stages[to_underlying(stage)]; }
+
+    // A stage that runs several times in a frame keeps its first start time and the sum of its durations.
+    void record(FrameTimingStage, MonotonicTime start, MonotonicTime end);
+    void record(FrameTimingStage stage, MonotonicTime time) { record(stage, time, time); }
+    void record(FrameTimingStage, Stage);
+
+    // WebContent has to send a frame within one refresh interval of its rendering opportunity, and the compositor has
+    // to present it within one refresh interval of the vsync tick it was picked up on.
+    bool missed_deadline(AK::Duration refresh_interval) const;
+};
+
+// The most recent frames of this process, for the frame timeline in Internals and the trace file in the Debug menu.
+class WEB_API FrameTimeline {
+    AK_MAKE_NONCOPYABLE(FrameTimeline);
+    AK_MAKE_NONMOVABLE(FrameTimeline);
+
+public:
+    static FrameTimeline& the();
+
+    u64 allocate_frame_id() { return ++m_last_frame_id; }
+    void did_finish_frame(FrameTiming const&);
+
+    static constexpr size_t max_recorded_frames = 600;
+    CircularQueue<FrameTiming, max_recorded_frames> const& recent_frames() const { return m_recent_frames; }
+    u64 presented_frame_count() const { return m_presented_frame_count; }
+    u64 dropped_frame_count() const { return m_dropped_frame_count; }
+    u64 finished_frame_count() const { return m_presented_frame_count + m_dropped_frame_count; }
+
+    // The recent frames in the Trace Event Format, which Perfetto and chrome://tracing can load.
+    String to_trace_event_json() const;
+
+    Function<void(u64 dropped_frame_count)> on_dropped_frame;
+
+private:
+    FrameTimeline() = default;
+
+    CircularQueue<FrameTiming, max_recorded_frames> m_recent_frames;
+    u64 m_last_frame_id { 0 };
+    u64 m_presented_frame_count { 0 };
+    u64 m_dropped_frame_count { 0 };
+};
+
+}
+
+namespace IPC {
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::Compositor::FrameTiming const&);
+template<>
+WEB_API ErrorOr<Web::Compositor::FrameTiming> decode(Decoder&);
+
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibGC/Root.h>
+#include <LibJS/Runtime/Realm.h>
+#include <LibThreading/ThreadPool.h>
+#include <LibWeb/Compression/CodecWork.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
+
+namespace Web::Compression {
+
+static GC::Ref<WebIDL::Promise> create_promise_for_outcome(JS::Realm& realm, WebIDL::ExceptionOr<void> outcome)
+{
+    if (outcome.is_exception())
+        return WebIDL::create_rejected_promise_from_exception(realm, outcome.release_error());
+    return WebIDL::create_resolved_promise(realm, JS::js_undefined());
+}
+
+GC::Ref<WebIDL::Promise> perform_codec_work(JS::Realm& realm, size_t input_size, CodecWork work, GC::Ref<CodecWorkSteps> steps)
+{
+    if (input_size < OFF_THREAD_CODEC_WORK_THRESHOLD)
+        return create_promise_for_outcome(realm, steps->function()(work()));
+
+    auto promise = WebIDL::create_promise(realm);
+
+    auto on_complete = GC::create_function(realm.heap(), [&realm, promise, steps](ErrorOr<ByteBuffer> result) {
+        HTML::queue_global_task(HTML::Task::Source::Unspecified, realm.global_object(), GC::create_function(realm.heap(), [&realm, promise, steps, result = move(result)]() mutable {
+            HTML::TemporaryExecutionContext context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+
+            if (auto outcome = steps->function()(move(result)); outcome.is_exception())
+                WebIDL::reject_promise_with_exception(realm, promise, outcome.release_error());
+            else
+                WebIDL::resolve_promise(realm, promise, JS::js_undefined());
+        }));
+    });
+
+    // NB: The steps continue on this thread, which holds the GC root so that it's only ever touched here.
+    auto* on_complete_root = new GC::Root { GC::make_root(on_complete) };
+
+    auto& origin_event_loop = Core::EventLoop::current();
+    Threading::ThreadPool::the().submit([work = move(work), on_complete_root, &origin_event_loop]() mutable {
+        auto result = work();
+
+        origin_event_loop.deferred_invoke([on_complete_root, result = move(result)]() mutable {
+            (*on_complete_root)->function()(move(result));
+            delete on_complete_root;
+        });
+    });
+
+    return promise;
+}
+
+}
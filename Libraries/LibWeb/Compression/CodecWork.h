@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Error.h>
+#include <AK/Function.h>
+#include <LibGC/Function.h>
+#include <LibJS/Forward.h>
+#include <LibWeb/WebIDL/ExceptionOr.h>
+#include <LibWeb/WebIDL/Promise.h>
+
+namespace Web::Compression {
+
+// Compressing or decompressing this much input can take long enough to noticeably hold up the event loop, so the work
+// is done on the thread pool instead. Smaller inputs aren't worth the trip.
+static constexpr size_t OFF_THREAD_CODEC_WORK_THRESHOLD = 64 * KiB;
+
+using CodecWork = Function<ErrorOr<ByteBuffer>()>;
+using CodecWorkSteps = GC::Function<WebIDL::ExceptionOr<void>(ErrorOr<ByteBuffer>)>;
+
+// Performs the codec work on the given amount of input, and then runs the steps with its result on this thread. The
+// returned promise settles with the outcome of the steps.
+// NB: A transform stream doesn't hand its transformer anything else until the promise for the last chunk has settled,
+//     so a stream's codec is never used by more than one thread at a time, and its writable side applies backpressure
+//     meanwhile.
+GC::Ref<WebIDL::Promise> perform_codec_work(JS::Realm&, size_t input_size, CodecWork, GC::Ref<CodecWorkSteps>);
+
+}
@@ -14,6 +14,7 @@
 #include <LibJS/Runtime/TypedArray.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Compression/CodecWork.h>
 #include <LibWeb/Compression/CompressionStream.h>
 #include <LibWeb/Streams/TransformStream.h>
 #include <LibWeb/Streams/TransformStreamOperations.h>
@@ -55,15 +56,7 @@ WebIDL::ExceptionOr<GC::Ref<CompressionStream>> CompressionStream::construct_imp
     // 3. Let transformAlgorithm be an algorithm which takes a chunk argument and runs the compress and enqueue a chunk
     //    algorithm with this and chunk.
     auto transform_algorithm = GC::create_function(realm.heap(), [stream](JS::Value chunk) -> GC::Ref<WebIDL::Promise> {
-        auto& realm = stream->realm();
-        auto& vm = realm.vm();
-
-        if (auto result = stream->compress_and_enqueue_chunk(chunk); result.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(vm, result.exception());
-            return WebIDL::create_rejected_promise(realm, throw_completion.release_value());
-        }
-
-        return WebIDL::create_resolved_promise(realm, JS::js_undefined());
+        return stream->compress_and_enqueue_chunk(chunk);
     });
 
     // 4. Let flushAlgorithm be an algorithm which takes no argument and runs the compress flush and enqueue algorithm with this.
@@ -108,19 +101,34 @@ void CompressionStream::visit_edges(JS::Cell::Visitor& visitor)
 }
 
 // https://compression.spec.whatwg.org/#compress-and-enqueue-a-chunk
-WebIDL::ExceptionOr<void> CompressionStream::compress_and_enqueue_chunk(JS::Value chunk)
+GC::Ref<WebIDL::Promise> CompressionStream::compress_and_enqueue_chunk(JS::Value chunk)
 {
     auto& realm = this->realm();
 
     // 1. If chunk is not a BufferSource type, then throw a TypeError.
     if (!WebIDL::is_buffer_source_type(chunk))
-        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "Chunk is not a BufferSource type"_utf16 };
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "Chunk is not a BufferSource type"_utf16 });
+
+    auto chunk_buffer = WebIDL::get_buffer_source_copy(chunk.as_object());
+    if (chunk_buffer.is_error())
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, Utf16String::formatted("Unable to compress chunk: {}", chunk_buffer.error()) });
+
+    auto chunk_size = chunk_buffer.value().size();
 
     // 2. Let buffer be the result of compressing chunk with cs's format and context.
-    auto maybe_buffer = [&]() -> ErrorOr<ByteBuffer> {
-        auto chunk_buffer = TRY(WebIDL::get_buffer_source_copy(chunk.as_object()));
+    auto work = [this, chunk_buffer = chunk_buffer.release_value()] {
         return compress(chunk_buffer, Finish::No);
-    }();
+    };
+
+    return perform_codec_work(realm, chunk_size, move(work), GC::create_function(realm.heap(), [this](ErrorOr<ByteBuffer> maybe_buffer) {
+        return enqueue_compressed_chunk(move(maybe_buffer));
+    }));
+}
+
+WebIDL::ExceptionOr<void> CompressionStream::enqueue_compressed_chunk(ErrorOr<ByteBuffer> maybe_buffer)
+{
+    auto& realm = this->realm();
+
     if (maybe_buffer.is_error())
         return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, Utf16String::formatted("Unable to compress chunk: {}", maybe_buffer.error()) };
 
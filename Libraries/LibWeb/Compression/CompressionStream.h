@@ -16,6 +16,7 @@
 #include <LibWeb/Bindings/PlatformObject.h>
 #include <LibWeb/Streams/GenericTransformStream.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
+#include <LibWeb/WebIDL/Promise.h>
 
 namespace Web::Compression {
 
@@ -42,7 +43,8 @@ private:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
-    WebIDL::ExceptionOr<void> compress_and_enqueue_chunk(JS::Value);
+    GC::Ref<WebIDL::Promise> compress_and_enqueue_chunk(JS::Value);
+    WebIDL::ExceptionOr<void> enqueue_compressed_chunk(ErrorOr<ByteBuffer>);
     WebIDL::ExceptionOr<void> compress_flush_and_enqueue();
 
     enum class Finish {
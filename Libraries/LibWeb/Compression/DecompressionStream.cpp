@@ -13,8 +13,8 @@
 #include <LibJS/Runtime/Realm.h>
 #include <LibJS/Runtime/TypedArray.h>
 #include <LibWeb/Bindings/DecompressionStream.h>
-#include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Compression/CodecWork.h>
 #include <LibWeb/Compression/DecompressionStream.h>
 #include <LibWeb/Streams/TransformStream.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
@@ -55,28 +55,12 @@ WebIDL::ExceptionOr<GC::Ref<DecompressionStream>> DecompressionStream::construct
     // 3. Let transformAlgorithm be an algorithm which takes a chunk argument and runs the decompress and enqueue a chunk
     //    algorithm with this and chunk.
     auto transform_algorithm = GC::create_function(realm.heap(), [stream](JS::Value chunk) -> GC::Ref<WebIDL::Promise> {
-        auto& realm = stream->realm();
-        auto& vm = realm.vm();
-
-        if (auto result = stream->decompress_and_enqueue_chunk(chunk); result.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(vm, result.exception());
-            return WebIDL::create_rejected_promise(realm, throw_completion.release_value());
-        }
-
-        return WebIDL::create_resolved_promise(realm, JS::js_undefined());
+        return stream->decompress_and_enqueue_chunk(chunk);
     });
 
     // 4. Let flushAlgorithm be an algorithm which takes no argument and runs the decompress flush and enqueue algorithm with this.
     auto flush_algorithm = GC::create_function(realm.heap(), [stream]() -> GC::Ref<WebIDL::Promise> {
-        auto& realm = stream->realm();
-        auto& vm = realm.vm();
-
-        if (auto result = stream->decompress_flush_and_enqueue(); result.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(vm, result.exception());
-            return WebIDL::create_rejected_promise(realm, throw_completion.release_value());
-        }
-
-        return WebIDL::create_resolved_promise(realm, JS::js_undefined());
+        return stream->decompress_flush_and_enqueue();
     });
 
     // 6. Set up this's transform with transformAlgorithm set to transformAlgorithm and flushAlgorithm set to flushAlgorithm.
@@ -108,26 +92,41 @@ void DecompressionStream::visit_edges(JS::Cell::Visitor& visitor)
 }
 
 // https://compression.spec.whatwg.org/#decompress-and-enqueue-a-chunk
-WebIDL::ExceptionOr<void> DecompressionStream::decompress_and_enqueue_chunk(JS::Value chunk)
+GC::Ref<WebIDL::Promise> DecompressionStream::decompress_and_enqueue_chunk(JS::Value chunk)
 {
     auto& realm = this->realm();
 
     // 1. If chunk is not a BufferSource type, then throw a TypeError.
     if (!WebIDL::is_buffer_source_type(chunk))
-        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "Chunk is not a BufferSource type"_utf16 };
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "Chunk is not a BufferSource type"_utf16 });
+
+    auto chunk_buffer = WebIDL::get_buffer_source_copy(chunk.as_object());
+    if (chunk_buffer.is_error())
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, Utf16String::formatted("Unable to decompress chunk: {}", chunk_buffer.error()) });
+
+    auto chunk_size = chunk_buffer.value().size();
 
     // 2. Let buffer be the result of decompressing chunk with ds's format and context. If this results in an error,
     //    then throw a TypeError.
-    auto maybe_buffer = [&]() -> ErrorOr<ByteBuffer> {
-        auto chunk_buffer = TRY(WebIDL::get_buffer_source_copy(chunk.as_object()));
-        TRY(m_input_stream->write_until_depleted(move(chunk_buffer)));
+    auto work = [this, chunk_buffer = chunk_buffer.release_value()]() -> ErrorOr<ByteBuffer> {
+        TRY(m_input_stream->write_until_depleted(chunk_buffer));
 
         auto decompressed = TRY(ByteBuffer::create_uninitialized(4096));
         auto size = TRY(m_decompressor.visit([&](auto const& decompressor) -> ErrorOr<size_t> {
             return TRY(decompressor->read_some(decompressed.bytes())).size();
         }));
         return decompressed.slice(0, size);
-    }();
+    };
+
+    return perform_codec_work(realm, chunk_size, move(work), GC::create_function(realm.heap(), [this](ErrorOr<ByteBuffer> maybe_buffer) {
+        return enqueue_decompressed_chunk(move(maybe_buffer));
+    }));
+}
+
+WebIDL::ExceptionOr<void> DecompressionStream::enqueue_decompressed_chunk(ErrorOr<ByteBuffer> maybe_buffer)
+{
+    auto& realm = this->realm();
+
     if (maybe_buffer.is_error())
         return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, Utf16String::formatted("Unable to decompress chunk: {}", maybe_buffer.error()) };
 
@@ -147,14 +146,29 @@ WebIDL::ExceptionOr<void> DecompressionStream::decompress_and_enqueue_chunk(JS::
 }
 
 // https://compression.spec.whatwg.org/#decompress-flush-and-enqueue
-WebIDL::ExceptionOr<void> DecompressionStream::decompress_flush_and_enqueue()
+GC::Ref<WebIDL::Promise> DecompressionStream::decompress_flush_and_enqueue()
 {
     auto& realm = this->realm();
 
+    // NB: Only a small part of each chunk is decompressed right away, so most of the input may still be left to do.
+    auto remaining_input_size = m_input_stream->used_buffer_size();
+
     // 1. Let buffer be the result of decompressing an empty input with ds's format and context, with the finish flag.
-    auto maybe_buffer = m_decompressor.visit([&](auto const& decompressor) -> ErrorOr<ByteBuffer> {
-        return TRY(decompressor->read_until_eof());
-    });
+    auto work = [this]() -> ErrorOr<ByteBuffer> {
+        return m_decompressor.visit([&](auto const& decompressor) -> ErrorOr<ByteBuffer> {
+            return TRY(decompressor->read_until_eof());
+        });
+    };
+
+    return perform_codec_work(realm, remaining_input_size, move(work), GC::create_function(realm.heap(), [this](ErrorOr<ByteBuffer> maybe_buffer) {
+        return enqueue_decompressed_flush(move(maybe_buffer));
+    }));
+}
+
+WebIDL::ExceptionOr<void> DecompressionStream::enqueue_decompressed_flush(ErrorOr<ByteBuffer> maybe_buffer)
+{
+    auto& realm = this->realm();
+
     if (maybe_buffer.is_error())
         return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, Utf16String::formatted("Unable to decompress flush: {}", maybe_buffer.error()) };
 
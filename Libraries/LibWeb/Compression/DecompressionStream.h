@@ -42,8 +42,11 @@ private:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
-    WebIDL::ExceptionOr<void> decompress_and_enqueue_chunk(JS::Value);
-    WebIDL::ExceptionOr<void> decompress_flush_and_enqueue();
+    GC::Ref<WebIDL::Promise> decompress_and_enqueue_chunk(JS::Value);
+    WebIDL::ExceptionOr<void> enqueue_decompressed_chunk(ErrorOr<ByteBuffer>);
+
+    GC::Ref<WebIDL::Promise> decompress_flush_and_enqueue();
+    WebIDL::ExceptionOr<void> enqueue_decompressed_flush(ErrorOr<ByteBuffer>);
 
     Decompressor m_decompressor;
     NonnullOwnPtr<AllocatingMemoryStream> m_input_stream;
@@ -3832,7 +3832,7 @@ WebIDL::ExceptionOr<GC::Ref<CryptoKey>> HKDF::import_key(AlgorithmParams const&,
 }
 
 // https://w3c.github.io/webcrypto/#sha-operations-digest
-WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> SHA::digest(AlgorithmParams const& algorithm, ByteBuffer const& data)
+WebIDL::ExceptionOr<OffThreadOperation> SHA::prepare_digest(AlgorithmParams const& algorithm, ByteBuffer data)
 {
     auto& algorithm_name = algorithm.name;
 
@@ -3855,15 +3855,17 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> SHA::digest(AlgorithmParams const&
         return WebIDL::NotSupportedError::create(m_realm, Utf16String::formatted("Invalid hash function '{}'", algorithm_name));
     }
 
-    ::Crypto::Hash::Manager hash { hash_kind };
-    hash.update(data);
+    return OffThreadOperation { [hash_kind, data = move(data)] -> OffThreadOperationResult {
+        ::Crypto::Hash::Manager hash { hash_kind };
+        hash.update(data);
 
-    auto digest = hash.digest();
-    auto result_buffer = ByteBuffer::copy(digest.immutable_data(), hash.digest_size());
-    if (result_buffer.is_error())
-        return WebIDL::OperationError::create(m_realm, "Failed to create result buffer"_utf16);
+        auto digest = hash.digest();
+        auto result_buffer = ByteBuffer::copy(digest.immutable_data(), hash.digest_size());
+        if (result_buffer.is_error())
+            return "Failed to create result buffer"_utf16;
 
-    return JS::ArrayBuffer::create(m_realm, result_buffer.release_value());
+        return result_buffer.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#ecdsa-operations-generate-key
@@ -6914,7 +6916,7 @@ WebIDL::ExceptionOr<JS::Value> ED448::verify(AlgorithmParams const& params, GC::
 }
 
 // https://w3c.github.io/webcrypto/#hkdf-operations-derive-bits
-WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> HKDF::derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length_optional)
+WebIDL::ExceptionOr<OffThreadOperation> HKDF::prepare_derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length_optional)
 {
     auto& realm = *m_realm;
     auto const& normalized_algorithm = static_cast<HKDFParams const&>(params);
@@ -6939,7 +6941,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> HKDF::derive_bits(AlgorithmParams
 
     // Note: Check for zero length early because our implementation doesn't support it.
     if (*length_optional == 0) {
-        return TRY(JS::ArrayBuffer::create(realm, static_cast<size_t>(0)));
+        return OffThreadOperation { [] -> OffThreadOperationResult { return ByteBuffer {}; } };
     }
 
     auto const& hash_algorithm = TRY(normalized_algorithm.hash.name(realm.vm()));
@@ -6955,15 +6957,17 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> HKDF::derive_bits(AlgorithmParams
         return WebIDL::NotSupportedError::create(m_realm, Utf16String::formatted("Invalid hash function '{}'", hash_algorithm));
     }());
 
-    ::Crypto::Hash::HKDF hkdf(hash_kind);
-    auto maybe_result = hkdf.derive_key(Optional<ReadonlyBytes>(normalized_algorithm.salt), key_derivation_key, normalized_algorithm.info, *length_optional / 8);
+    return OffThreadOperation { [hash_kind, key_derivation_key = move(key_derivation_key), salt = normalized_algorithm.salt, info = normalized_algorithm.info, length = *length_optional] -> OffThreadOperationResult {
+        ::Crypto::Hash::HKDF hkdf(hash_kind);
+        auto maybe_result = hkdf.derive_key(Optional<ReadonlyBytes>(salt), key_derivation_key, info, length / 8);
 
-    // 4. If the key derivation operation fails, then throw an OperationError.
-    if (maybe_result.is_error())
-        return WebIDL::OperationError::create(realm, "Failed to derive key"_utf16);
+        // 4. If the key derivation operation fails, then throw an OperationError.
+        if (maybe_result.is_error())
+            return "Failed to derive key"_utf16;
 
-    // 5. Return result
-    return JS::ArrayBuffer::create(realm, maybe_result.release_value());
+        // 5. Return result
+        return maybe_result.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#hkdf-operations-get-key-length
@@ -6974,7 +6978,7 @@ WebIDL::ExceptionOr<JS::Value> HKDF::get_key_length(AlgorithmParams const&)
 }
 
 // https://w3c.github.io/webcrypto/#pbkdf2-operations-derive-bits
-WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> PBKDF2::derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length_optional)
+WebIDL::ExceptionOr<OffThreadOperation> PBKDF2::prepare_derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length_optional)
 {
     auto& realm = *m_realm;
     auto const& normalized_algorithm = static_cast<PBKDF2Params const&>(params);
@@ -7013,15 +7017,17 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> PBKDF2::derive_bits(AlgorithmParam
         return WebIDL::NotSupportedError::create(m_realm, Utf16String::formatted("Invalid hash function '{}'", hash_algorithm));
     }());
 
-    ::Crypto::Hash::PBKDF2 pbkdf2(hash_kind);
-    auto maybe_result = pbkdf2.derive_key(password, salt, iterations, derived_key_length_bytes);
+    return OffThreadOperation { [hash_kind, password = move(password), salt = move(salt), iterations, derived_key_length_bytes] -> OffThreadOperationResult {
+        ::Crypto::Hash::PBKDF2 pbkdf2(hash_kind);
+        auto maybe_result = pbkdf2.derive_key(password, salt, iterations, derived_key_length_bytes);
 
-    // 5. If the key derivation operation fails, then throw an OperationError.
-    if (maybe_result.is_error())
-        return WebIDL::OperationError::create(realm, "Failed to derive key"_utf16);
+        // 5. If the key derivation operation fails, then throw an OperationError.
+        if (maybe_result.is_error())
+            return "Failed to derive key"_utf16;
 
-    // 6. Return result
-    return JS::ArrayBuffer::create(realm, maybe_result.release_value());
+        // 6. Return result
+        return maybe_result.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#pbkdf2-operations-get-key-length
@@ -9706,7 +9712,7 @@ WebIDL::ExceptionOr<GC::Ref<CryptoKey>> Argon2::import_key(AlgorithmParams const
 }
 
 // https://wicg.github.io/webcrypto-modern-algos/#argon2-operations-derive-bits
-WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> Argon2::derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length)
+WebIDL::ExceptionOr<OffThreadOperation> Argon2::prepare_derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length)
 {
     auto const& normalized_algorithm = static_cast<Argon2Params const&>(params);
     // 1. If length is null, or is less than 32 (4*8), then throw an OperationError.
@@ -9729,28 +9735,28 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> Argon2::derive_bits(AlgorithmParam
     if (normalized_algorithm.passes == 0)
         return WebIDL::OperationError::create(m_realm, "Invalid passes"_utf16);
 
-    auto const algorithm = [&]() {
+    auto const type = [&]() {
         // 6 => If the name member of normalizedAlgorithm is a case-sensitive string match for "Argon2d":
         //      Let type be 0.
         if (normalized_algorithm.name == "Argon2d"sv)
-            return ::Crypto::Hash::Argon2(::Crypto::Hash::Argon2Type::Argon2d);
+            return ::Crypto::Hash::Argon2Type::Argon2d;
         //   => If the name member of normalizedAlgorithm is a case-sensitive string match for "Argon2i":
         //      Let type be 1.
         if (normalized_algorithm.name == "Argon2i"sv)
-            return ::Crypto::Hash::Argon2(::Crypto::Hash::Argon2Type::Argon2i);
+            return ::Crypto::Hash::Argon2Type::Argon2i;
         //   => If the name member of normalizedAlgorithm is a case-sensitive string match for "Argon2id":
         //      Let type be 2.
         if (normalized_algorithm.name == "Argon2id"sv)
-            return ::Crypto::Hash::Argon2(::Crypto::Hash::Argon2Type::Argon2id);
+            return ::Crypto::Hash::Argon2Type::Argon2id;
 
         VERIFY_NOT_REACHED();
     }();
 
     // 7. Let secretValue be the secretValue member of normalizedAlgorithm, if present.
-    auto const& secret_value = normalized_algorithm.secret_value;
+    auto secret_value = normalized_algorithm.secret_value;
 
     // 8. Let associatedData be the associatedData member of normalizedAlgorithm, if present.
-    auto const& associated_data = normalized_algorithm.associated_data;
+    auto associated_data = normalized_algorithm.associated_data;
 
     // 9. Let result be the result of performing the Argon2 function defined in Section 3 of [RFC9106] using the
     //    password represented by [[handle]] internal slot of key as the message, P, the nonce attribute of
@@ -9759,23 +9765,27 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> Argon2::derive_bits(AlgorithmParam
     //    value of the passes attribute of normalizedAlgorithm as the number of passes, t, 0x13 as the version number,
     //    v, secretValue (if present) as the secret value, K, associatedData (if present) as the associated data, X, type
     //    as the type, y, and length divided by 8 as the tag length, T.
+    // NB: The Argon2 implementation runs its lanes on as many threads as the degree of parallelism asks for.
     VERIFY(key->handle().has<ByteBuffer>());
-    auto const maybe_result = algorithm.derive_key(
-        key->handle().get<ByteBuffer>(),
-        normalized_algorithm.nonce,
-        normalized_algorithm.parallelism,
-        normalized_algorithm.memory,
-        normalized_algorithm.passes,
-        0x13,
-        secret_value.map([](auto const& value) { return value.span(); }),
-        associated_data.map([](auto const& value) { return value.span(); }),
-        length.value() / 8);
-
-    // 10. If the key derivation operation fails, then throw an OperationError.
-    if (maybe_result.is_error())
-        return WebIDL::OperationError::create(m_realm, Utf16String::formatted("Hashing function failed: {}", maybe_result.error()));
+    return OffThreadOperation { [type, password = key->handle().get<ByteBuffer>(), nonce = normalized_algorithm.nonce, parallelism = normalized_algorithm.parallelism, memory = normalized_algorithm.memory, passes = normalized_algorithm.passes, secret_value = move(secret_value), associated_data = move(associated_data), tag_length = length.value() / 8] -> OffThreadOperationResult {
+        ::Crypto::Hash::Argon2 algorithm { type };
+        auto maybe_result = algorithm.derive_key(
+            password,
+            nonce,
+            parallelism,
+            memory,
+            passes,
+            0x13,
+            secret_value.map([](auto const& value) { return value.span(); }),
+            associated_data.map([](auto const& value) { return value.span(); }),
+            tag_length);
+
+        // 10. If the key derivation operation fails, then throw an OperationError.
+        if (maybe_result.is_error())
+            return Utf16String::formatted("Hashing function failed: {}", maybe_result.error());
 
-    return JS::ArrayBuffer::create(m_realm, maybe_result.value());
+        return maybe_result.release_value();
+    } };
 }
 
 // https://wicg.github.io/webcrypto-modern-algos/#argon2-operations-get-key-length
@@ -9786,46 +9796,49 @@ WebIDL::ExceptionOr<JS::Value> Argon2::get_key_length(AlgorithmParams const&)
 }
 
 // https://wicg.github.io/webcrypto-modern-algos/#cshake-operations-digest
-WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> CShake::digest(AlgorithmParams const& params, ByteBuffer const& data)
+WebIDL::ExceptionOr<OffThreadOperation> CShake::prepare_digest(AlgorithmParams const& params, ByteBuffer data)
 {
     auto const& normalized_algorithm = static_cast<CShakeParams const&>(params);
 
     // 1. Let outputLength be the outputLength member of normalizedAlgorithm.
-    auto const& output_length = normalized_algorithm.output_length;
+    auto output_length = normalized_algorithm.output_length;
 
     // 2. Let functionName be the functionName member of normalizedAlgorithm if present or the empty octet string otherwise.
-    auto const& function_name = normalized_algorithm.function_name;
+    auto function_name = normalized_algorithm.function_name;
 
     // 3. Let customization be the customization member of normalizedAlgorithm if present or the empty octet string otherwise.
-    auto const& customization = normalized_algorithm.customization;
+    auto customization = normalized_algorithm.customization;
 
-    auto const algorithm = [&]() {
+    auto const kind = [&]() {
         // 4. If the name member of normalizedAlgorithm is a case-sensitive string match for "cSHAKE128":
         if (normalized_algorithm.name == "cSHAKE128"sv)
-            return ::Crypto::Hash::SHAKE(::Crypto::Hash::SHAKEKind::CSHAKE128);
+            return ::Crypto::Hash::SHAKEKind::CSHAKE128;
         // 4. If the name member of normalizedAlgorithm is a case-sensitive string match for "cSHAKE256":
         if (normalized_algorithm.name == "cSHAKE256"sv)
-            return ::Crypto::Hash::SHAKE(::Crypto::Hash::SHAKEKind::CSHAKE256);
+            return ::Crypto::Hash::SHAKEKind::CSHAKE256;
         VERIFY_NOT_REACHED();
     }();
 
-    // 4. Let result be the result of performing the cSHAKE128/cSHAKE256 function defined in Section 3 of [NIST-SP800-185]
-    // using message as the X input parameter,
-    // outputLength as the L input parameter,
-    // functionName as the N input parameter,
-    // and customization as the S input parameter.
-    auto maybe_result = algorithm.digest(
-        data,
-        output_length,
-        customization.map([](auto const& value) { return value.span(); }),
-        function_name.map([](auto const& value) { return value.span(); }));
-
-    // 5. If performing the operation results in an error, then throw an OperationError.
-    if (maybe_result.is_error())
-        return WebIDL::OperationError::create(m_realm, Utf16String::formatted("Hash function failed: {}", maybe_result.error()));
+    return OffThreadOperation { [kind, output_length, function_name = move(function_name), customization = move(customization), data = move(data)] -> OffThreadOperationResult {
+        // 4. Let result be the result of performing the cSHAKE128/cSHAKE256 function defined in Section 3 of [NIST-SP800-185]
+        // using message as the X input parameter,
+        // outputLength as the L input parameter,
+        // functionName as the N input parameter,
+        // and customization as the S input parameter.
+        ::Crypto::Hash::SHAKE algorithm { kind };
+        auto maybe_result = algorithm.digest(
+            data,
+            output_length,
+            customization.map([](auto const& value) { return value.span(); }),
+            function_name.map([](auto const& value) { return value.span(); }));
+
+        // 5. If performing the operation results in an error, then throw an OperationError.
+        if (maybe_result.is_error())
+            return Utf16String::formatted("Hash function failed: {}", maybe_result.error());
 
-    // 6. Return result.
-    return JS::ArrayBuffer::create(m_realm, maybe_result.release_value());
+        // 6. Return result.
+        return maybe_result.release_value();
+    } };
 }
 
 AeadParams::~AeadParams() = default;
@@ -9,10 +9,12 @@
 #include <AK/ByteBuffer.h>
 #include <AK/NeverDestroyed.h>
 #include <AK/QuickSort.h>
+#include <LibCore/EventLoop.h>
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/JSONObject.h>
 #include <LibJS/Runtime/ValueInlines.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/SubtleCrypto.h>
@@ -32,6 +34,24 @@ static void normalize_key_usages(Vector<Bindings::KeyUsage>& key_usages)
     quick_sort(key_usages);
 }
 
+// OPTIMIZATION: Hashing a large message or stretching a password can take long enough to noticeably hold up the event
+//               loop, so that part of the work happens on the thread pool instead.
+static void perform_on_the_thread_pool(OffThreadOperation operation, GC::Ref<GC::Function<void(OffThreadOperationResult)>> on_complete)
+{
+    // NB: The steps continue on this thread, which holds the GC root so that it's only ever touched here.
+    auto* on_complete_root = new GC::Root { GC::make_root(on_complete) };
+
+    auto& origin_event_loop = Core::EventLoop::current();
+    Threading::ThreadPool::the().submit([operation = move(operation), on_complete_root, &origin_event_loop]() mutable {
+        auto result = operation();
+
+        origin_event_loop.deferred_invoke([on_complete_root, result = move(result)]() mutable {
+            (*on_complete_root)->function()(move(result));
+            delete on_complete_root;
+        });
+    });
+}
+
 static JsonWebKey to_internal_json_web_key(Bindings::JsonWebKey bindings_jwk)
 {
     JsonWebKey jwk;
@@ -356,7 +376,7 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::digest(AlgorithmIdentifier const& algorit
     auto promise = WebIDL::create_promise(realm);
 
     // 7. Return promise and perform the remaining steps in parallel.
-    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, &global, &heap, algorithm_object = normalized_algorithm.release_value(), promise, data_buffer = move(data_buffer)]() -> void {
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, &global, &heap, algorithm_object = normalized_algorithm.release_value(), promise, data_buffer = move(data_buffer)]() mutable -> void {
         HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::No);
 
         // 8. If the following steps or referenced procedures say to throw an error, queue a global task on the
@@ -369,20 +389,32 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::digest(AlgorithmIdentifier const& algorit
         };
 
         // 9. Let digest be the result of performing the digest operation specified by normalizedAlgorithm using algorithm, with data as message.
-        auto digest = algorithm_object.methods->digest(*algorithm_object.parameter, data_buffer);
+        auto digest_operation = algorithm_object.methods->prepare_digest(*algorithm_object.parameter, move(data_buffer));
 
-        if (digest.is_exception()) {
-            throw_in_this_context(Bindings::exception_to_throw_completion(realm.vm(), digest.release_error()).release_value());
+        if (digest_operation.is_exception()) {
+            throw_in_this_context(Bindings::exception_to_throw_completion(realm.vm(), digest_operation.release_error()).release_value());
             return;
         }
 
-        // 10. Queue a global task on the crypto task source, given realm's global object, to perform the remaining steps.
-        HTML::queue_global_task(HTML::Task::Source::Crypto, global, GC::create_function(heap, [&realm, promise, digest_bytes = digest.release_value()] {
-            HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+        perform_on_the_thread_pool(digest_operation.release_value(), GC::create_function(heap, [&realm, &global, &heap, promise](OffThreadOperationResult digest) {
+            if (digest.is_error()) {
+                HTML::queue_global_task(HTML::Task::Source::Crypto, global, GC::create_function(heap, [&realm, promise, message = digest.release_error()] {
+                    HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+                    WebIDL::reject_promise(realm, promise, WebIDL::OperationError::create(realm, message));
+                }));
+                return;
+            }
+
+            // 10. Queue a global task on the crypto task source, given realm's global object, to perform the remaining steps.
+            HTML::queue_global_task(HTML::Task::Source::Crypto, global, GC::create_function(heap, [&realm, promise, digest_bytes = digest.release_value()] mutable {
+                HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+
+                // 11. Let result be the result of creating an ArrayBuffer in realm, containing digest.
+                auto result = JS::ArrayBuffer::create(realm, move(digest_bytes));
 
-            // 11. Let result be the result of creating an ArrayBuffer in realm, containing digest.
-            // 12. Resolve promise with result.
-            WebIDL::resolve_promise(realm, promise, digest_bytes);
+                // 12. Resolve promise with result.
+                WebIDL::resolve_promise(realm, promise, result);
+            }));
         }));
     }));
 
@@ -774,6 +806,26 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::derive_bits(AlgorithmIdentifier algorithm
         }
 
         // 9. Let result be the result of creating an ArrayBuffer containing the result of performing the derive bits operation specified by normalizedAlgorithm using baseKey, algorithm and length.
+        auto operation = normalized_algorithm.methods->prepare_derive_bits(*normalized_algorithm.parameter, base_key, length_optional);
+        if (operation.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), operation.release_error()).release_value());
+            return;
+        }
+
+        if (operation.value()) {
+            perform_on_the_thread_pool(operation.release_value(), GC::create_function(realm.heap(), [&realm, promise](OffThreadOperationResult result) {
+                HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+                if (result.is_error()) {
+                    WebIDL::reject_promise(realm, promise, WebIDL::OperationError::create(realm, result.error()));
+                    return;
+                }
+
+                // 10. Resolve promise with result.
+                WebIDL::resolve_promise(realm, promise, JS::ArrayBuffer::create(realm, result.release_value()));
+            }));
+            return;
+        }
+
         auto result = normalized_algorithm.methods->derive_bits(*normalized_algorithm.parameter, base_key, length_optional);
         if (result.is_error()) {
             WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result.release_error()).release_value());
@@ -854,37 +906,58 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::derive_key(AlgorithmIdentifier algorithm,
             length = maybe_length.value();
         }
 
+        // NB: The remaining steps continue once the secret is known, which may be on a later turn of the event loop.
+        auto import_secret = GC::create_function(realm.heap(), [&realm, promise, normalized_derived_key_algorithm_import = move(normalized_derived_key_algorithm_import), extractable, key_usages = move(key_usages)](ByteBuffer secret_bytes) mutable {
+            // 15. Let result be the result of performing the import key operation specified by normalizedDerivedKeyAlgorithmImport using "raw" as format, secret as keyData, derivedKeyType as algorithm and using extractable and usages.
+            auto result_or_error = normalized_derived_key_algorithm_import.methods->import_key(*normalized_derived_key_algorithm_import.parameter, Bindings::KeyFormat::Raw, move(secret_bytes), extractable, key_usages);
+            if (result_or_error.is_error()) {
+                WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result_or_error.release_error()).release_value());
+                return;
+            }
+            auto result = result_or_error.release_value();
+
+            // 16. If the [[type]] internal slot of result is "secret" or "private" and usages is empty, then throw a SyntaxError.
+            if ((result->type() == Bindings::KeyType::Secret || result->type() == Bindings::KeyType::Private) && key_usages.is_empty()) {
+                WebIDL::reject_promise(realm, promise, WebIDL::SyntaxError::create(realm, "usages must not be empty"_utf16));
+                return;
+            }
+
+            // 17. Set the [[extractable]] internal slot of result to extractable.
+            result->set_extractable(extractable);
+
+            // 18. Set the [[usages]] internal slot of result to the normalized value of usages.
+            normalize_key_usages(key_usages);
+            result->set_usages(key_usages);
+
+            // 19. Resolve promise with result.
+            WebIDL::resolve_promise(realm, promise, result);
+        });
+
         // 14. Let secret be the result of performing the derive bits operation specified by normalizedAlgorithm using key, algorithm and length.
-        auto secret = normalized_algorithm.methods->derive_bits(*normalized_algorithm.parameter, base_key, length);
-        if (secret.is_error()) {
-            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), secret.release_error()).release_value());
+        auto secret_operation = normalized_algorithm.methods->prepare_derive_bits(*normalized_algorithm.parameter, base_key, length);
+        if (secret_operation.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), secret_operation.release_error()).release_value());
             return;
         }
 
-        // 15. Let result be the result of performing the import key operation specified by normalizedDerivedKeyAlgorithmImport using "raw" as format, secret as keyData, derivedKeyType as algorithm and using extractable and usages.
-        auto secret_bytes = MUST(secret.release_value()->copy_to_byte_buffer());
-        auto result_or_error = normalized_derived_key_algorithm_import.methods->import_key(*normalized_derived_key_algorithm_import.parameter, Bindings::KeyFormat::Raw, move(secret_bytes), extractable, key_usages);
-        if (result_or_error.is_error()) {
-            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result_or_error.release_error()).release_value());
+        if (secret_operation.value()) {
+            perform_on_the_thread_pool(secret_operation.release_value(), GC::create_function(realm.heap(), [&realm, promise, import_secret](OffThreadOperationResult secret) {
+                HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+                if (secret.is_error()) {
+                    WebIDL::reject_promise(realm, promise, WebIDL::OperationError::create(realm, secret.error()));
+                    return;
+                }
+                import_secret->function()(secret.release_value());
+            }));
             return;
         }
-        auto result = result_or_error.release_value();
 
-        // 16. If the [[type]] internal slot of result is "secret" or "private" and usages is empty, then throw a SyntaxError.
-        if ((result->type() == Bindings::KeyType::Secret || result->type() == Bindings::KeyType::Private) && key_usages.is_empty()) {
-            WebIDL::reject_promise(realm, promise, WebIDL::SyntaxError::create(realm, "usages must not be empty"_utf16));
+        auto secret = normalized_algorithm.methods->derive_bits(*normalized_algorithm.parameter, base_key, length);
+        if (secret.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), secret.release_error()).release_value());
             return;
         }
-
-        // 17. Set the [[extractable]] internal slot of result to extractable.
-        result->set_extractable(extractable);
-
-        // 18. Set the [[usages]] internal slot of result to the normalized value of usages.
-        normalize_key_usages(key_usages);
-        result->set_usages(key_usages);
-
-        // 19. Resolve promise with result.
-        WebIDL::resolve_promise(realm, promise, result);
+        import_secret->function()(MUST(secret.release_value()->copy_to_byte_buffer()));
     }));
 
     return promise;
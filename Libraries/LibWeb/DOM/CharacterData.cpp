@@ -53,6 +53,11 @@ void CharacterData::set_data(Utf16View const& data)
     MUST(replace_data(0, this->length_in_utf16_code_units(), data));
 }
 
+void CharacterData::set_data(Utf16String const& data)
+{
+    MUST(replace_data(0, this->length_in_utf16_code_units(), data.utf16_view(), data));
+}
+
 // https://dom.spec.whatwg.org/#concept-cd-substring
 WebIDL::ExceptionOr<Utf16String> CharacterData::substring_data(size_t offset, size_t count) const
 {
@@ -68,12 +73,22 @@ WebIDL::ExceptionOr<Utf16String> CharacterData::substring_data(size_t offset, si
     if (offset + count > length)
         return Utf16String::from_utf16(m_data.substring_view(offset));
 
+    // OPTIMIZATION: The whole of our data can be shared rather than copied.
+    if (offset == 0 && count == length)
+        return m_data;
+
     // 4. Return a string whose value is the code units from the offsetth code unit to the offset+countth code unit in node’s data.
     return Utf16String::from_utf16(m_data.substring_view(offset, count));
 }
 
 // https://dom.spec.whatwg.org/#concept-cd-replace
 WebIDL::ExceptionOr<void> CharacterData::replace_data(size_t offset, size_t count, Utf16View const& data)
+{
+    return replace_data(offset, count, data, {});
+}
+
+// https://dom.spec.whatwg.org/#concept-cd-replace
+WebIDL::ExceptionOr<void> CharacterData::replace_data(size_t offset, size_t count, Utf16View const& data, Optional<Utf16String const&> data_string)
 {
     // NB: Mutations during a recorded editing command must go through the Editing proxy functions.
     if (auto history = document().editing_history_if_exists())
@@ -93,16 +108,23 @@ WebIDL::ExceptionOr<void> CharacterData::replace_data(size_t offset, size_t coun
     // 5. Insert data into node’s data after offset code units.
     // 6. Let delete offset be offset + data’s length.
     // 7. Starting from delete offset code units, remove count code units from node’s data.
-    auto before_data = m_data.substring_view(0, offset);
-    auto after_data = m_data.substring_view(offset + count);
+    auto old_data = m_data;
 
-    Utf16StringBuilder full_data(before_data.length_in_code_units() + data.length_in_code_units() + after_data.length_in_code_units());
-    full_data.append(before_data);
-    full_data.append(data);
-    full_data.append(after_data);
+    // OPTIMIZATION: When all of our data is replaced with a string the caller already owns (e.g. one coming from JS),
+    //               share its storage instead of copying it.
+    if (data_string.has_value() && offset == 0 && count == length) {
+        m_data = *data_string;
+    } else {
+        auto before_data = m_data.substring_view(0, offset);
+        auto after_data = m_data.substring_view(offset + count);
 
-    auto old_data = m_data;
-    m_data = full_data.to_string();
+        Utf16StringBuilder full_data(before_data.length_in_code_units() + data.length_in_code_units() + after_data.length_in_code_units());
+        full_data.append(before_data);
+        full_data.append(data);
+        full_data.append(after_data);
+
+        m_data = full_data.to_string();
+    }
 
     // 4. Queue a mutation record of "characterData" for node with null, null, node’s data, « », « », null, and null.
     // NOTE: We do this later so that the mutation observer may notify UI clients of this node's new value.
@@ -180,13 +202,14 @@ WebIDL::ExceptionOr<void> CharacterData::replace_data(size_t offset, size_t coun
 
     document().bump_character_data_version();
 
+    // NB: Nothing before the offset has changed, so the segmenters can keep the boundaries they found there.
     if (m_grapheme_segmenter)
-        m_grapheme_segmenter->set_segmented_text(m_data);
+        m_grapheme_segmenter->set_segmented_text_after_change(m_data, offset);
     // The line segmenter may be the ASCII fast-path variant, which only accepts a subset of inputs; let the
     // lazy getter re-pick the implementation against the new data.
     m_line_segmenter = nullptr;
     if (m_word_segmenter)
-        m_word_segmenter->set_segmented_text(m_data);
+        m_word_segmenter->set_segmented_text_after_change(m_data, offset);
 
     CSS::Invalidation::invalidate_style_after_text_directionality_change(*this);
 
@@ -217,7 +240,8 @@ WebIDL::ExceptionOr<void> CharacterData::delete_data(size_t offset, size_t count
 Unicode::Segmenter& CharacterData::grapheme_segmenter() const
 {
     if (!m_grapheme_segmenter) {
-        m_grapheme_segmenter = document().grapheme_segmenter().clone();
+        // OPTIMIZATION: Editing asks about the boundaries around the caret over and over, so they are remembered.
+        m_grapheme_segmenter = Unicode::Segmenter::create_with_cached_boundaries(document().grapheme_segmenter().clone());
         m_grapheme_segmenter->set_segmented_text(m_data);
     }
 
@@ -241,7 +265,7 @@ Unicode::Segmenter& CharacterData::line_segmenter() const
 Unicode::Segmenter& CharacterData::word_segmenter() const
 {
     if (!m_word_segmenter) {
-        m_word_segmenter = document().word_segmenter().clone();
+        m_word_segmenter = Unicode::Segmenter::create_with_cached_boundaries(document().word_segmenter().clone());
         m_word_segmenter->set_segmented_text(m_data);
     }
 
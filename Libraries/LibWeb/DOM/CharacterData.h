@@ -29,6 +29,7 @@ public:
 
     Utf16String const& data() const { return m_data; }
     void set_data(Utf16View const&);
+    void set_data(Utf16String const&);
 
     unsigned length_in_utf16_code_units() const { return m_data.length_in_code_units(); }
 
@@ -50,6 +51,8 @@ protected:
 private:
     virtual size_t external_memory_size() const override;
 
+    WebIDL::ExceptionOr<void> replace_data(size_t offset_in_utf16_code_units, size_t count_in_utf16_code_units, Utf16View const&, Optional<Utf16String const&> data_string);
+
     Utf16String m_data;
 
     mutable OwnPtr<Unicode::Segmenter> m_grapheme_segmenter;
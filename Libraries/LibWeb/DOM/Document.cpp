@@ -11,6 +11,7 @@
  */
 
 #include <AK/Bitmap.h>
+#include <AK/BumpArena.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/GenericLexer.h>
@@ -24,6 +25,7 @@
 #include <AK/Utf16View.h>
 #include <AK/Utf8View.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGC/RootVector.h>
 #include <LibGC/Timer.h>
 #include <LibHTTP/Cookie/Cookie.h>
@@ -41,6 +43,7 @@
 #include <LibWeb/Animations/AnimationPlaybackEvent.h>
 #include <LibWeb/Animations/AnimationTimeline.h>
 #include <LibWeb/Animations/DocumentTimeline.h>
+#include <LibWeb/Animations/KeyframeEffect.h>
 #include <LibWeb/Animations/TimeValue.h>
 #include <LibWeb/Bindings/Document.h>
 #include <LibWeb/Bindings/IntersectionObserver.h>
@@ -97,6 +100,7 @@
 #include <LibWeb/DOM/EditingHostManager.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ElementByIdMap.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/HTMLCollection.h>
@@ -119,6 +123,7 @@
 #include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
 #include <LibWeb/FileAPI/BlobURLStore.h>
 #include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/BackForwardCache.h>
 #include <LibWeb/HTML/BeforeUnloadEvent.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/BrowsingContextGroup.h>
@@ -248,7 +253,7 @@ static Optional<u64> s_style_invalidation_counter_dump_interval;
 static void dump_style_invalidation_counters(Document const& document)
 {
     auto const& counters = document.style_invalidation_counters();
-    dbgln("Style invalidation counters for {}: styleInvalidations={}, fullStyleInvalidations={}, elementStyleRecomputations={}, elementStyleNoopRecomputations={}, elementInheritedStyleRecomputations={}, elementInheritedStyleNoopRecomputations={}, previousSiblingInvalidationWalkVisits={}, mediaRuleEvaluations={}, hasAncestorWalkInvocations={}, hasAncestorWalkVisits={}, hasAncestorSiblingElementChecks={}, hasInvalidationMetadataCandidates={}, hasMatchInvocations={}, hasResultCacheHits={}, hasResultCacheMisses={}",
+    dbgln("Style invalidation counters for {}: styleInvalidations={}, fullStyleInvalidations={}, elementStyleRecomputations={}, elementStyleNoopRecomputations={}, elementInheritedStyleRecomputations={}, elementInheritedStyleNoopRecomputations={}, previousSiblingInvalidationWalkVisits={}, mediaRuleEvaluations={}, hasAncestorWalkInvocations={}, hasAncestorWalkVisits={}, hasAncestorSiblingElementChecks={}, hasInvalidationMetadataCandidates={}, hasMatchInvocations={}, hasResultCacheHits={}, hasResultCacheMisses={}, rulesTried={}, rulesMatched={}",
         document.url().to_string(),
         counters.style_invalidations,
         counters.full_style_invalidations,
@@ -264,7 +269,9 @@ static void dump_style_invalidation_counters(Document const& document)
         counters.has_invalidation_metadata_candidates,
         counters.has_match_invocations,
         counters.has_result_cache_hits,
-        counters.has_result_cache_misses);
+        counters.has_result_cache_misses,
+        counters.rules_tried,
+        counters.rules_matched);
 }
 
 // https://html.spec.whatwg.org/multipage/origin.html#obtain-browsing-context-navigation
@@ -538,10 +545,13 @@ WebIDL::ExceptionOr<GC::Ref<Document>> Document::create_and_initialize(Type type
         document->shared_declarative_refresh_steps(value, nullptr);
     }
 
-    // FIXME: 18. If navigationParams's commit early hints is not null, then call navigationParams's commit early hints
-    //        with document.
+    // 18. If navigationParams's commit early hints is not null, then call navigationParams's commit early hints with
+    //     document.
+    if (navigation_params.commit_early_hints)
+        navigation_params.commit_early_hints->function()(document);
 
-    // FIXME: 19. Process link headers given document, navigationParams's response, and "pre-media".
+    // 19. Process link headers given document, navigationParams's response, and "pre-media".
+    HTML::HTMLLinkElement::process_link_headers(document, *navigation_params.response, HTML::HTMLLinkElement::LinkHeaderPhase::PreMedia);
 
     // FIXME: 20. If navigationParams's navigable is a top-level traversable, then process the `Speculation-Rules`
     //        header given document and navigationParams's response .
@@ -1720,8 +1730,16 @@ Optional<URL::URL> Document::encoding_parse_url(Utf16View url) const
     // 4. Let baseURL be environment's base URL, if environment is a Document object; otherwise environment's API base URL.
     auto base_url = this->base_url();
 
+    // OPTIMIZATION: Documents resolve the same URLs against the same base URL many times over, so the results are
+    //               cached. Blob URLs are not, since the blob URL entry they resolve to may be revoked in the meantime.
+    if (auto cached_url = m_parsed_url_cache.get(url, base_url, encoding); cached_url.has_value())
+        return cached_url.release_value();
+
     // 5. Return the result of applying the URL parser to url, with baseURL and encoding.
-    return DOMURL::parse(url, base_url, encoding.utf16_view());
+    auto parsed_url = DOMURL::parse(url, base_url, encoding.utf16_view());
+    if (!parsed_url.has_value() || parsed_url->scheme() != "blob"sv)
+        m_parsed_url_cache.set(url, base_url, encoding, parsed_url);
+    return parsed_url;
 }
 
 // https://html.spec.whatwg.org/multipage/urls-and-fetching.html#encoding-parsing-and-serializing-a-url
@@ -2162,6 +2180,8 @@ void Document::update_layout(UpdateLayoutReason reason)
         if (m_created_for_appropriate_template_contents)
             return;
 
+        TRACE_EVENT(Layout, "DOM::Document::update_layout"sv);
+
         auto needs_layout_tree_rebuild = !m_layout_root || needs_layout_tree_update() || child_needs_layout_tree_update() || needs_full_layout_tree_update();
 
         switch (try_partial_relayout(move(registered_partial_relayout_roots), needs_layout_tree_rebuild, should_collect_devtools_layout_data)) {
@@ -2287,7 +2307,9 @@ void Document::update_layout(UpdateLayoutReason reason)
                     continue;
 
                 query_container->for_each_shadow_including_descendant([](Node& node) {
-                    if (auto* element = as_if<Element>(node); element && element->style_depends_on_size_container_query())
+                    if (auto* element = as_if<Element>(node); element
+                        && element->style_depends_on_size_container_query()
+                        && element->size_container_query_results_changed())
                         element->set_needs_style_update(true);
 
                     return TraversalDecision::Continue;
@@ -2308,6 +2330,9 @@ void Document::update_layout(UpdateLayoutReason reason)
             break;
     }
 
+    // The layout passes above are done with their arenas, so let go of any chunks a big pass left cached.
+    BumpArena::trim_thread_cache();
+
     VERIFY(layout_is_up_to_date());
 }
 
@@ -2587,6 +2612,7 @@ void Document::update_paint_and_hit_testing_properties_if_needed()
 {
     // NB: Called during paint property resolution.
     if (m_needs_accumulated_visual_contexts_update) {
+        page().did_change_rendering_geometry();
         m_needs_accumulated_visual_contexts_update = false;
         m_paintable_boxes_needing_visual_context_value_update.clear_with_capacity();
         if (auto paintable = this->unsafe_paintable()) {
@@ -2595,6 +2621,7 @@ void Document::update_paint_and_hit_testing_properties_if_needed()
             paintable->assign_accumulated_visual_contexts();
         }
     } else if (!m_paintable_boxes_needing_visual_context_value_update.is_empty()) {
+        page().did_change_rendering_geometry();
         auto paintable_boxes = move(m_paintable_boxes_needing_visual_context_value_update);
         if (auto paintable = this->unsafe_paintable()) {
             for (auto const& weak_paintable_box : paintable_boxes) {
@@ -5492,7 +5519,10 @@ void Document::run_unloading_cleanup_steps()
     //         making LibJS notify us of that would undoubtedly be very costly to performance. All other browsers also
     //         opt not to follow the spec exactly in regards to this, instead letting the connection stay open until
     //         GC collects it. However, we need to be proactive about this when navigating for the sake of test-web.
-    window.close_all_idb_connections();
+    //         A document whose connections were closed can't be reactivated, as it would find them unexpectedly closed.
+    auto closed_any_idb_connections = window.close_all_idb_connections();
+    if (closed_any_idb_connections == HTML::WindowOrWorkerGlobalScopeMixin::ClosedAnyIDBConnections::Yes)
+        make_unsalvageable("indexeddb"_utf16);
 
     FileAPI::run_unloading_cleanup_steps(*this);
     fully_exit_fullscreen();
@@ -5795,7 +5825,7 @@ void Document::unload(GC::Ptr<Document>)
 
     // 5. Let intendToStoreInBfcache be true if the user agent intends to keep oldDocument alive in a session history
     //    entry, such that it can later be used for history traversal.
-    auto intend_to_store_in_bfcache = false;
+    auto intend_to_store_in_bfcache = HTML::BackForwardCache::the().can_store(*this);
 
     // 6. Let eventLoop be oldDocument's relevant agent's event loop.
     auto& event_loop = *HTML::relevant_agent(*this).event_loop;
@@ -5846,7 +5876,10 @@ void Document::unload(GC::Ptr<Document>)
 
     // FIXME: 15. Set oldDocument's suspension time to the current high resolution time given document's relevant global object.
 
-    // FIXME: 16. Set oldDocument's suspended timer handles to the result of getting the keys for the map of active timers.
+    // 16. Set oldDocument's suspended timer handles to the result of getting the keys for the map of active timers.
+    // NB: Only the timers that are still waiting to fire are stopped and recorded; see suspend_active_timers().
+    if (m_salvageable)
+        m_suspended_timer_handles = as<HTML::Window>(relevant_global_object(*this)).suspend_active_timers();
 
     // FIXME: 17. Set oldDocument's has been scrolled by the user to false.
 
@@ -5857,6 +5890,10 @@ void Document::unload(GC::Ptr<Document>)
     // 19. If oldDocument's salvageable state is false, then destroy oldDocument.
     if (!m_salvageable)
         destroy();
+    // AD-HOC: Session history entries only refer to their document by ID, so hand the document to the back/forward
+    //         cache to keep it alive for history traversal.
+    else
+        HTML::BackForwardCache::the().store(*this);
 
     // 20. Decrease oldDocument's unload counter by 1.
     m_unload_counter -= 1;
@@ -6164,6 +6201,7 @@ void Document::register_intersection_observer(Badge<IntersectionObserver::Inters
 {
     VERIFY(!m_intersection_observers.contains(observer));
     m_intersection_observers.set(observer);
+    m_intersection_observations_need_update = true;
 }
 
 void Document::unregister_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserver& observer)
@@ -6327,6 +6365,13 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
 
     update_paint_and_hit_testing_properties_if_needed();
 
+    // OPTIMIZATION: Nothing moved since the intersections were last computed, so none of them can have changed.
+    auto rendering_geometry_generation = page().rendering_geometry_generation();
+    if (!m_intersection_observations_need_update && m_rendering_geometry_generation_of_last_intersection_observations == rendering_geometry_generation)
+        return;
+    m_intersection_observations_need_update = false;
+    m_rendering_geometry_generation_of_last_intersection_observations = rendering_geometry_generation;
+
     for (auto& observer : intersection_observers) {
         // 1. Let rootBounds be observer’s root intersection rectangle.
         auto root_bounds = observer->root_intersection_rectangle();
@@ -6364,6 +6409,9 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
             // NOTE: Check if target has a layout node is not in the spec but required to match other browsers.
             // AD-HOC: A target whose document was excluded from this rendering update has stale layout; treat it as
             //         not intersecting like other engines instead of reading its geometry.
+            // NB: The target's geometry will be measured once its layout is up to date again.
+            if (!target->document().layout_is_up_to_date())
+                m_intersection_observations_need_update = true;
             if (target->document().layout_is_up_to_date() && target->layout_node() && (is_implicit_root || &target->document() == &intersection_root_node->document()) && !(root_is_element && !target->is_descendant_of(*intersection_root_node))) {
                 // 4. Set targetRect to the DOMRectReadOnly obtained by getting the bounding box for target.
                 target_rect = target->bounding_client_rect_assuming_layout_clean();
@@ -6864,7 +6912,59 @@ void Document::update_for_history_step_application(NonnullRefPtr<HTML::SessionHi
     // NOTE: This is for bfcache restoration
     if (!documents_entry_changed && !do_not_reactivate) {
         // FIXME: 1. Assert: entriesForNavigationAPI is given.
-        // FIXME: 2. Reactivate document given entry and entriesForNavigationAPI.
+        // 2. Reactivate document given entry and entriesForNavigationAPI.
+        reactivate(entry);
+    }
+}
+
+// https://html.spec.whatwg.org/multipage/browsing-the-web.html#reactivate-a-document
+void Document::reactivate(HTML::SessionHistoryEntry const& reactivated_entry)
+{
+    // FIXME: 1. For each formControl of form controls in document with an autofill field name of "off", invoke the reset
+    //           algorithm for formControl.
+
+    // 2. If document's suspended timer handles is not empty:
+    if (!m_suspended_timer_handles.is_empty()) {
+        // FIXME: 1. Assert: document's suspension time is not zero.
+        // FIXME: 2. Let suspendDuration be the current high resolution time given document's relevant global object
+        //           minus document's suspension time.
+        // 3. Let activeTimers be document's relevant global object's map of active timers.
+        // 4. For each handle in document's suspended timer handles, if activeTimers[handle] exists, then increase
+        //    activeTimers[handle] by suspendDuration.
+        // NB: Our timers were stopped when the document was unloaded, so we start them again instead, each waiting only
+        //     for the time it had left when it was stopped.
+        as<HTML::Window>(HTML::relevant_global_object(*this)).resume_suspended_timers(m_suspended_timer_handles);
+        m_suspended_timer_handles.clear();
+    }
+
+    // FIXME: 3. Update the navigation API entries for reactivation given document's relevant global object's navigation
+    //           API, entriesForNavigationAPI, and reactivatedEntry.
+
+    // 4. If document's current document readiness is "complete", and document's page showing is false:
+    if (m_readiness == HTML::DocumentReadyState::Complete && !m_page_showing) {
+        // 1. Set document's page showing to true.
+        m_page_showing = true;
+
+        // FIXME: 2. Set document's has been revealed to false.
+
+        // 3. Update the visibility state of document to "visible".
+        update_the_visibility_state(HTML::VisibilityState::Visible);
+
+        // AD-HOC: The viewport's scroll offset is kept by the navigable rather than by the document, so it has to be
+        //         restored from the entry like it would be for a newly-created document.
+        if (auto navigable = this->navigable())
+            navigable->restore_persisted_state_from_session_history_entry(reactivated_entry);
+
+        // 4. Fire a page transition event named pageshow at document's relevant global object with true.
+        as<HTML::Window>(HTML::relevant_global_object(*this)).fire_a_page_transition_event(HTML::EventNames::pageshow, true);
+
+        // AD-HOC: The UI has already seen the title and load state of the document we navigated away from, so tell it
+        //         about this document's again.
+        if (auto navigable = this->navigable(); navigable && navigable->is_top_level_traversable()) {
+            auto& client = navigable->traversable_navigable()->page().client();
+            client.page_did_change_title(title());
+            client.page_did_finish_loading(m_navigation_id, url());
+        }
     }
 }
 
@@ -6940,6 +7040,16 @@ void Document::prune_image_resource_caches()
     static constexpr size_t decoded_image_resource_cache_limit = 8 * MiB;
     static constexpr size_t decoded_image_resource_cache_count_limit = 96;
 
+    prune_image_resource_caches_to_limits(decoded_image_resource_cache_limit, decoded_image_resource_cache_count_limit);
+}
+
+void Document::purge_image_resource_caches()
+{
+    prune_image_resource_caches_to_limits(0, 0);
+}
+
+void Document::prune_image_resource_caches_to_limits(size_t decoded_image_resource_cache_limit, size_t decoded_image_resource_cache_count_limit)
+{
     auto is_used_by_css_image_resource = [&](URL::URL const& url, HTML::SharedResourceRequest const& request) {
         auto* css_image_resource = this->css_image_resource(url);
         return css_image_resource && css_image_resource->decoded_image_data() == request.image_data();
@@ -7126,6 +7236,19 @@ void Document::update_animations_and_send_events(double timestamp)
     }
 }
 
+Vector<Compositor::CompositorAnimation> Document::compositor_animations()
+{
+    Vector<Compositor::CompositorAnimation> compositor_animations;
+    for (auto& animation : m_associated_animations) {
+        auto* effect = as_if<Animations::KeyframeEffect>(animation.effect().ptr());
+        if (!effect)
+            continue;
+        if (auto compositor_animation = effect->compositor_animation(); compositor_animation.has_value())
+            compositor_animations.append(compositor_animation.release_value());
+    }
+    return compositor_animations;
+}
+
 // https://www.w3.org/TR/web-animations-1/#remove-replaced-animations
 void Document::remove_replaced_animations()
 {
@@ -8136,6 +8259,9 @@ GC::Ptr<HTML::HTMLElement> Document::topmost_auto_or_hint_popover()
 
 void Document::set_needs_to_refresh_scroll_state(bool b)
 {
+    if (b)
+        page().did_change_rendering_geometry();
+
     // NB: Propagating scroll state invalidation.
     if (auto paintable = this->unsafe_paintable())
         paintable->set_needs_to_refresh_scroll_state(b);
@@ -8756,6 +8882,8 @@ void Document::set_navigable(GC::Ptr<HTML::LocalNavigable> navigable)
 
 void Document::set_needs_repaint(InvalidateDisplayList should_invalidate_display_list)
 {
+    page().did_change_rendering_geometry();
+
     auto navigable = this->navigable();
 
     if (should_invalidate_display_list == InvalidateDisplayList::Yes) {
@@ -8851,6 +8979,7 @@ void Document::schedule_scrollable_overflow_recalculation(Element& element)
 
 void Document::set_needs_to_record_display_list()
 {
+    page().did_change_rendering_geometry();
     m_hit_test_display_list = nullptr;
     if (auto navigable = this->navigable())
         navigable->set_needs_to_record_display_list();
@@ -8858,6 +8987,8 @@ void Document::set_needs_to_record_display_list()
 
 RefPtr<Painting::DisplayList> Document::record_display_list(HTML::PaintConfig config, Painting::DisplayListResourceStorage& resource_storage, Painting::PaintCommandCacheMode cache_mode)
 {
+    TRACE_EVENT(Paint, "DOM::Document::record_display_list"sv);
+
     update_paint_and_hit_testing_properties_if_needed();
     VERIFY(paintable());
 
@@ -9436,6 +9567,13 @@ ElementByIdMap& Document::element_by_id() const
     return *m_element_by_id;
 }
 
+ElementIndex& Document::element_index() const
+{
+    if (!m_element_index)
+        m_element_index = make<ElementIndex>();
+    return *m_element_index;
+}
+
 Utf16String Document::dump_display_list()
 {
     update_layout(UpdateLayoutReason::DumpDisplayList);
@@ -9946,4 +10084,11 @@ QuerySelectorResultCache& Document::query_selector_result_cache()
     return *m_query_selector_result_cache;
 }
 
+XPath::MirroredTree& Document::xpath_mirrored_tree_for(Node const& root) const
+{
+    if (!m_xpath_mirrored_tree || !m_xpath_mirrored_tree->is_current_for(root))
+        m_xpath_mirrored_tree = XPath::MirroredTree::create(root);
+    return *m_xpath_mirrored_tree;
+}
+
 }
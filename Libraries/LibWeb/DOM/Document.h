@@ -27,6 +27,7 @@
 #include <LibGC/WeakHashSet.h>
 #include <LibJS/Forward.h>
 #include <LibURL/Origin.h>
+#include <LibURL/ParsedURLCache.h>
 #include <LibURL/URL.h>
 #include <LibUnicode/Forward.h>
 #include <LibWeb/Bindings/NavigationType.h>
@@ -141,6 +142,7 @@ enum class InvalidateLayoutTreeReason {
     X(InspectDevToolsLayoutData)             \
     X(InputCaretRect)                        \
     X(InternalsHitTest)                      \
+    X(InternalsMeasureRenderingUpdate)       \
     X(MediaQueryListMatches)                 \
     X(NavigableSelectedText)                 \
     X(NavigableViewportScroll)               \
@@ -888,6 +890,7 @@ public:
     // https://html.spec.whatwg.org/multipage/interaction.html#set-the-initial-visibility-state
     void set_initial_visibility_state(HTML::VisibilityState);
 
+    bool salvageable() const { return m_salvageable; }
     void set_salvageable(bool value) { m_salvageable = value; }
 
     void make_unsalvageable(Utf16View reason);
@@ -905,6 +908,7 @@ public:
 
     void register_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserver&);
     void unregister_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserver&);
+    void did_add_intersection_observation_target(Badge<IntersectionObserver::IntersectionObserver>) { m_intersection_observations_need_update = true; }
 
     void register_resize_observer(Badge<ResizeObserver::ResizeObserver>, ResizeObserver::ResizeObserver&);
     void unregister_resize_observer(Badge<ResizeObserver::ResizeObserver>, ResizeObserver::ResizeObserver&);
@@ -925,6 +929,7 @@ public:
     GC::Ref<HTML::SourceSnapshotParams> snapshot_source_snapshot_params() const;
 
     void update_for_history_step_application(NonnullRefPtr<HTML::SessionHistoryEntry>, bool do_not_reactivate, size_t script_history_length, size_t script_history_index, Optional<Bindings::NavigationType> navigation_type, Optional<Vector<NonnullRefPtr<HTML::SessionHistoryEntry>>> entries_for_navigation_api = {}, RefPtr<HTML::SessionHistoryEntry> previous_entry_for_activation = {}, bool update_navigation_api = true);
+    void reactivate(HTML::SessionHistoryEntry const&);
 
     HashMap<URL::URL, GC::Ptr<HTML::SharedResourceRequest>>& shared_resource_requests();
     HashMap<URL::URL, GC::Ptr<HTML::SharedResourceRequest>> const& shared_resource_requests() const;
@@ -933,6 +938,8 @@ public:
     CSS::ImageStyleValueResource& create_css_image_resource(GC::Ref<HTML::SharedResourceRequest>);
     void remove_css_image_resource_if_unused(URL::URL const&);
     void prune_image_resource_caches();
+    // Drops every decoded image that isn't currently in use, e.g. when the system is low on memory.
+    void purge_image_resource_caches();
 
     void restore_the_history_object_state(NonnullRefPtr<HTML::SessionHistoryEntry> entry);
 
@@ -956,6 +963,7 @@ public:
     void remove_replaced_animations();
 
     WebIDL::ExceptionOr<Vector<GC::Ref<Animations::Animation>>> get_animations();
+    Vector<Compositor::CompositorAnimation> compositor_animations();
     HashTable<GC::Ref<Animations::AnimationTimeline>> const& associated_animation_timelines() const { return m_associated_animation_timelines; }
 
     bool ready_to_run_scripts() const { return m_ready_to_run_scripts; }
@@ -1037,6 +1045,13 @@ public:
         u64 element_style_noop_recomputations { 0 };
         u64 element_inherited_style_recomputations { 0 };
         u64 element_inherited_style_noop_recomputations { 0 };
+        u64 style_sharing_cache_hits { 0 };
+        u64 style_sharing_cache_misses { 0 };
+        u64 cascade_cache_hits { 0 };
+        u64 cascade_cache_misses { 0 };
+        u64 prematched_rule_set_uses { 0 };
+        u64 rules_tried { 0 };
+        u64 rules_matched { 0 };
         u64 previous_sibling_invalidation_walk_visits { 0 };
         u64 descendant_slot_invalidation_subtree_scans { 0 };
         u64 media_rule_evaluations { 0 };
@@ -1265,6 +1280,12 @@ public:
     void remove_render_blocking_element(GC::Ref<Element>);
 
     ElementByIdMap& element_by_id() const;
+    ElementIndex& element_index() const;
+
+    // Records that a node in this document got an event listener for the given type. This is never undone, so a
+    // false return from may_have_node_event_listener() proves that no node in this document listens for that type.
+    void did_add_node_event_listener(Utf16FlyString const& type) { m_node_event_listener_types.set(type); }
+    bool may_have_node_event_listener(Utf16FlyString const& type) const { return m_node_event_listener_types.contains(type); }
 
     // https://fullscreen.spec.whatwg.org/#run-the-fullscreen-steps
     void run_fullscreen_steps();
@@ -1315,6 +1336,10 @@ public:
     RefPtr<SelectorQuery const> selector_query_for(Utf16View) const;
     QuerySelectorResultCache& query_selector_result_cache();
 
+    // Returns the copy of the subtree that XPath expressions are evaluated against, which is only rebuilt once the
+    // subtree has changed.
+    XPath::MirroredTree& xpath_mirrored_tree_for(Node const& root) const;
+
     GC::Ptr<HTML::CustomElementRegistry> custom_element_registry() const;
     void set_custom_element_registry(GC::Ptr<HTML::CustomElementRegistry> custom_element_registry) { m_custom_element_registry = custom_element_registry; }
     GC::Ptr<HTML::CustomElementRegistry> effective_global_custom_element_registry() const;
@@ -1352,6 +1377,8 @@ private:
     void tear_down_layout_tree();
     void process_pending_top_layer_layout_changes();
 
+    void prune_image_resource_caches_to_limits(size_t decoded_image_size_limit, size_t decoded_image_count_limit);
+
     void update_active_element();
     void collect_paintable_boxes_with_auto_content_visibility();
     bool needs_style_update_after_layout();
@@ -1418,6 +1445,8 @@ private:
     GC::Ptr<HTML::BrowsingContext> m_browsing_context;
     URL::URL m_url;
     mutable OwnPtr<ElementByIdMap> m_element_by_id;
+    mutable OwnPtr<ElementIndex> m_element_index;
+    HashTable<Utf16FlyString> m_node_event_listener_types;
 
     GC::Ptr<HTML::Window> m_window;
 
@@ -1532,6 +1561,9 @@ private:
     // https://html.spec.whatwg.org/multipage/browsing-the-web.html#concept-document-salvageable
     bool m_salvageable { true };
 
+    // https://html.spec.whatwg.org/multipage/dom.html#suspended-timer-handles
+    Vector<i32> m_suspended_timer_handles;
+
     // https://html.spec.whatwg.org/multipage/document-lifecycle.html#page-showing
     bool m_page_showing { false };
 
@@ -1593,6 +1625,9 @@ private:
     // https://html.spec.whatwg.org/multipage/dom.html#concept-document-about-base-url
     Optional<URL::URL> m_about_base_url;
 
+    // The results of encoding-parsing URLs relative to this document.
+    mutable URL::ParsedURLCache m_parsed_url_cache;
+
     // https://html.spec.whatwg.org/multipage/dom.html#concept-document-coop
     HTML::OpenerPolicy m_opener_policy;
 
@@ -1666,6 +1701,11 @@ private:
     // Each document has an IntersectionObserverTaskQueued flag which is initialized to false.
     bool m_intersection_observer_task_queued { false };
 
+    // NB: The intersections only need to be computed again when a target was added, or the geometry of the page changed
+    //     since they were last computed.
+    bool m_intersection_observations_need_update { true };
+    Optional<u64> m_rendering_geometry_generation_of_last_intersection_observations;
+
     // https://html.spec.whatwg.org/multipage/urls-and-fetching.html#lazy-load-intersection-observer
     // Each Document has a lazy load intersection observer, initially set to null but can be set to an IntersectionObserver instance.
     GC::Ptr<IntersectionObserver::IntersectionObserver> m_lazy_load_intersection_observer;
@@ -1862,6 +1902,8 @@ private:
     // Cache of querySelectorAll results, validated lazily against dom_tree_version/character_data_version.
     OwnPtr<QuerySelectorResultCache> m_query_selector_result_cache;
 
+    mutable OwnPtr<XPath::MirroredTree> m_xpath_mirrored_tree;
+
     // https://fullscreen.spec.whatwg.org/#list-of-pending-fullscreen-events
     Vector<PendingFullscreenEvent> m_pending_fullscreen_events;
 
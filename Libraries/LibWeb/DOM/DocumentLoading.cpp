@@ -23,6 +23,7 @@
 #include <LibWeb/Fetch/Infrastructure/HTTP/MIME.h>
 #include <LibWeb/Fetch/Response.h>
 #include <LibWeb/HTML/HTMLHeadElement.h>
+#include <LibWeb/HTML/HTMLLinkElement.h>
 #include <LibWeb/HTML/LocalNavigable.h>
 #include <LibWeb/HTML/NavigationParams.h>
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
@@ -34,6 +35,7 @@
 #include <LibWeb/MimeSniff/Resource.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
+#include <LibWeb/XML/IncrementalXMLDocumentParser.h>
 #include <LibWeb/XML/XMLDocumentBuilder.h>
 #include <LibXML/Parser/Parser.h>
 
@@ -45,7 +47,7 @@ static Utf16FlyString utf16_fly_string_from_mime_type_essence(MimeSniff::MimeTyp
 }
 
 // Replaces a document's content with a simple error message.
-static void convert_to_xml_error_document(DOM::Document& document, Utf16String error_string)
+void convert_to_xml_error_document(DOM::Document& document, Utf16String error_string)
 {
     auto html_element = MUST(DOM::create_element(document, HTML::TagNames::html, Namespace::HTML));
     auto body_element = MUST(DOM::create_element(document, HTML::TagNames::body, Namespace::HTML));
@@ -149,6 +151,7 @@ static WebIDL::ExceptionOr<GC::Ref<DOM::Document>> load_html_document(HTML::Navi
         auto body = GC::Ref { *navigation_params.response->body() };
         auto parser = HTML::IncrementalDocumentParser::create(document, body, navigation_params.response->url().value(), Fetch::Infrastructure::extract_mime_type(navigation_params.response->header_list()));
         parser->set_allow_declarative_shadow_roots(HTML::HTMLParser::AllowDeclarativeShadowRoots::Yes);
+        parser->set_link_header_response(*navigation_params.response);
         parser->start();
     }
 
@@ -192,51 +195,8 @@ static WebIDL::ExceptionOr<GC::Ref<DOM::Document>> load_xml_document(HTML::Navig
     if (auto maybe_encoding = type.parameters().get("charset"sv); maybe_encoding.has_value())
         content_encoding = *maybe_encoding;
 
-    auto process_body = GC::create_function(document->heap(), [document, url = navigation_params.response->url().value(), content_encoding = move(content_encoding), mime = type](ByteBuffer data) {
-        Optional<TextCodec::Decoder&> decoder;
-        // The actual HTTP headers and other metadata, not the headers as mutated or implied by the algorithms given in this specification,
-        // are the ones that must be used when determining the character encoding according to the rules given in the above specifications.
-        if (content_encoding.has_value())
-            decoder = TextCodec::decoder_for(content_encoding->bytes_as_string_view());
-        if (!decoder.has_value()) {
-            // https://www.w3.org/TR/xml/#charencoding
-            // [...] it is a fatal error [...] for an entity which begins with neither a Byte Order Mark nor an encoding
-            // declaration to use an encoding other than UTF-8.
-            auto bom_encoding = HTML::run_bom_sniff(data);
-            decoder = TextCodec::decoder_for(bom_encoding.value_or("UTF-8"));
-        }
-        VERIFY(decoder.has_value());
-        // Well-formed XML documents contain only properly encoded characters
-        auto source = decoder->to_utf8(data, TextCodec::IgnoreBOM::No, TextCodec::ErrorMode::Fatal);
-        if (source.is_error()) {
-            // FIXME: Insert error message into the document.
-            dbgln("Failed to decode XML document: {}", source.error());
-            convert_to_xml_error_document(document, Utf16String::formatted("Failed to decode XML document: {}", source.error()));
-            return;
-        }
-        auto run_xml_parser = [document, source_string = source.release_value()] {
-            XML::Parser parser(source_string, { .preserve_cdata = true, .preserve_comments = true, .resolve_named_html_entity = resolve_named_html_entity });
-            XMLDocumentBuilder builder { document };
-            auto result = parser.parse_with_listener(builder);
-            if (result.is_error()) {
-                // FIXME: Insert error message into the document.
-                dbgln("Failed to parse XML document: {}", result.error());
-                convert_to_xml_error_document(document, Utf16String::formatted("Failed to parse XML document: {}", result.error()));
-            }
-        };
-        if (document->ready_to_run_scripts()) {
-            run_xml_parser();
-        } else {
-            document->set_deferred_parser_start(GC::create_function(document->heap(), move(run_xml_parser)));
-        }
-    });
-
-    auto process_body_error = GC::create_function(document->heap(), [](JS::Value) {
-        dbgln("FIXME: Load html page with an error if read of body failed.");
-    });
-
-    auto& realm = document->realm();
-    navigation_params.response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
+    auto parser = IncrementalXMLDocumentParser::create(document, *navigation_params.response->body(), move(content_encoding));
+    parser->start();
 
     return document;
 }
@@ -396,7 +356,8 @@ static WebIDL::ExceptionOr<GC::Ref<DOM::Document>> load_media_document(HTML::Nav
         VERIFY_NOT_REACHED();
     }
 
-    // FIXME: 7. Process link headers given document, navigationParams's response, and "media".
+    // 7. Process link headers given document, navigationParams's response, and "media".
+    HTML::HTMLLinkElement::process_link_headers(document, *navigation_params.response, HTML::HTMLLinkElement::LinkHeaderPhase::Media);
 
     // 8. Act as if the user agent had stopped parsing document.
     // FIXME: We should not need to force the media file to load before saying that parsing has completed!
@@ -14,6 +14,7 @@
 
 namespace Web {
 
+void convert_to_xml_error_document(DOM::Document&, Utf16String error_string);
 bool build_xml_document(DOM::Document& document, ByteBuffer const& data, Optional<StringView> content_encoding);
 GC::Ptr<DOM::Document> load_document(HTML::NavigationParams const& navigation_params, ReadonlyBytes sniff_bytes);
 bool can_load_document_with_type(MimeSniff::MimeType const&);
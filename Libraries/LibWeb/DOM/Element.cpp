@@ -28,6 +28,7 @@
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/CSSAnimation.h>
+#include <LibWeb/CSS/CSSContainerRule.h>
 #include <LibWeb/CSS/CSSStyleProperties.h>
 #include <LibWeb/CSS/ComputedProperties.h>
 #include <LibWeb/CSS/CountersSet.h>
@@ -59,6 +60,7 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/DocumentFragment.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/NamedNodeMap.h>
@@ -149,6 +151,11 @@ namespace Web::DOM {
 
 GC_DEFINE_ALLOCATOR(Element);
 
+// Every element in the document pays for Element's own fields, so keep state that most elements never use in RareData.
+// NB: This bounds only what Element adds on top of its bases, so that growing a base class doesn't trip it.
+static_assert(sizeof(Element) <= sizeof(ParentNode) + sizeof(ChildNode<Element>) + sizeof(NonDocumentTypeChildNode<Element>)
+    + sizeof(SlottableMixin) + sizeof(ARIA::ARIAMixin) + sizeof(Animations::Animatable) + 320);
+
 static void invalidate_content_blocker_style_if_needed(Element& element)
 {
     if (!element.is_connected())
@@ -219,23 +226,24 @@ void Element::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_inline_style);
     visitor.visit(m_class_list);
     visitor.visit(m_shadow_root);
-    visitor.visit(m_part_list);
     visitor.visit(m_custom_element_registry);
-    visitor.visit(m_custom_element_definition);
-    visitor.visit(m_custom_state_set);
-    visitor.visit(m_computed_style_map_cache);
     visitor.visit(m_attribute_style_map);
+    if (m_rare_data) {
+        visitor.visit(m_rare_data->part_list);
+        visitor.visit(m_rare_data->custom_element_definition);
+        visitor.visit(m_rare_data->custom_state_set);
+        visitor.visit(m_rare_data->computed_style_map_cache);
+        visitor.visit(m_rare_data->registered_intersection_observers);
+    }
     if (m_pseudo_element_data) {
         for (auto& pseudo_element : *m_pseudo_element_data) {
             visitor.visit(pseudo_element.value);
         }
     }
-    if (m_registered_intersection_observers) {
-        for (auto& observer : *m_registered_intersection_observers)
-            visitor.visit(observer);
-    }
     if (m_counters_set)
         m_counters_set->visit_edges(visitor);
+    for (auto& result : m_size_container_query_results)
+        visitor.visit(result.rule);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-getattribute
@@ -1095,7 +1103,7 @@ void Element::run_attribute_change_steps(Utf16FlyString const& local_name, Optio
             if (local_name == HTML::AttributeNames::id || local_name == HTML::AttributeNames::class_)
                 invalidate_content_blocker_style_if_needed(*this);
         }
-        document().bump_dom_tree_version();
+        bump_dom_tree_version_for_subtree();
     }
 }
 
@@ -1310,6 +1318,8 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style(bool& did_cha
     m_style_uses_inherit_css_function = false;
     m_style_depends_on_size_container_query = false;
     m_style_depends_on_style_container_query = false;
+    m_style_depends_on_container_relative_length = false;
+    m_size_container_query_results.clear_with_capacity();
     m_affected_by_has_pseudo_class_in_subject_position = false;
     m_affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator = false;
     m_affected_by_direct_sibling_combinator = false;
@@ -1455,6 +1465,28 @@ void Element::invalidate_descendant_styles_depending_on_style_container_query()
     });
 }
 
+void Element::record_size_container_query_result(Optional<CSS::PseudoElement> pseudo_element, CSS::CSSContainerRule const& rule, bool matched)
+{
+    // Every style rule nested in the same @container asks the same question, so only remember the answer once.
+    for (auto const& result : m_size_container_query_results) {
+        if (result.rule.ptr() == &rule && result.pseudo_element == pseudo_element)
+            return;
+    }
+    m_size_container_query_results.append({ rule, pseudo_element, matched });
+}
+
+bool Element::size_container_query_results_changed() const
+{
+    if (m_style_depends_on_container_relative_length)
+        return true;
+
+    for (auto const& result : m_size_container_query_results) {
+        if (result.rule->matches(AbstractElement { *this, result.pseudo_element }) != result.matched)
+            return true;
+    }
+    return false;
+}
+
 CSS::RequiredInvalidationAfterStyleChange Element::recompute_inherited_style(ScheduleAnimationUpdate schedule_animation_update)
 {
     auto& counters = document().style_invalidation_counters();
@@ -1568,9 +1600,10 @@ GC::Ref<DOMTokenList> Element::part_list()
 {
     // The part attribute’s getter must return a DOMTokenList object whose associated element is the context object and
     // whose associated attribute’s local name is part.
-    if (!m_part_list)
-        m_part_list = DOMTokenList::create(*this, HTML::AttributeNames::part);
-    return *m_part_list;
+    auto& rare_data = ensure_rare_data();
+    if (!rare_data.part_list)
+        rare_data.part_list = DOMTokenList::create(*this, HTML::AttributeNames::part);
+    return *rare_data.part_list;
 }
 
 // https://dom.spec.whatwg.org/#valid-shadow-host-name
@@ -1598,10 +1631,10 @@ WebIDL::ExceptionOr<void> Element::attach_a_shadow_root(Bindings::ShadowRootMode
         return WebIDL::NotSupportedError::create(realm(), "Element's local name is not a valid shadow host name"_utf16);
 
     // 3. If element’s local name is a valid custom element name, or element’s is value is not null:
-    if (HTML::is_valid_custom_element_name(local_name()) || m_is_value.has_value()) {
+    if (HTML::is_valid_custom_element_name(local_name()) || is_value().has_value()) {
         // 1. Let definition be the result of looking up a custom element definition given element’s custom element
         //    registry, its namespace, its local name, and its is value.
-        auto definition = HTML::look_up_a_custom_element_definition(custom_element_registry(), namespace_uri(), local_name(), m_is_value);
+        auto definition = HTML::look_up_a_custom_element_definition(custom_element_registry(), namespace_uri(), local_name(), is_value());
 
         // 2. If definition is non-null and definition’s disable shadow is true, then throw a "NotSupportedError"
         //    DOMException.
@@ -2168,6 +2201,8 @@ void Element::inserted()
 {
     Base::inserted();
 
+    update_element_index_membership();
+
     if (is_connected()) {
         if (m_id.has_value())
             document().element_with_id_was_added({}, *this);
@@ -2192,6 +2227,11 @@ void Element::removed_from(IsSubtreeRoot is_subtree_root, Node* old_ancestor, No
     if (m_id.has_value() && is<ShadowRoot>(old_root))
         static_cast<ShadowRoot&>(old_root).element_by_id().remove(*m_id, *this);
 
+    if (m_is_in_element_index) {
+        m_is_in_element_index = false;
+        document().element_index().remove(*this);
+    }
+
     if (old_root.is_connected()) {
         if (m_id.has_value())
             document().element_with_id_was_removed({}, *this);
@@ -2225,6 +2265,28 @@ void Element::removed_from(IsSubtreeRoot is_subtree_root, Node* old_ancestor, No
 void Element::moved_from(IsSubtreeRoot is_subtree_root, GC::Ptr<Node> old_ancestor)
 {
     Base::moved_from(is_subtree_root, old_ancestor);
+
+    // NB: A move can take this subtree into or out of a shadow tree, and it changes where the subtree's elements are
+    //     in tree order relative to every other indexed element.
+    bool was_in_element_index = m_is_in_element_index;
+    update_element_index_membership();
+    if (is_subtree_root == IsSubtreeRoot::Yes && (was_in_element_index || m_is_in_element_index))
+        document().element_index().tree_order_changed();
+}
+
+void Element::update_element_index_membership()
+{
+    auto const* parent = this->parent();
+    bool should_be_in_element_index = parent
+        && (parent->is_document() || (parent->is_element() && static_cast<Element const&>(*parent).m_is_in_element_index));
+    if (should_be_in_element_index == m_is_in_element_index)
+        return;
+
+    m_is_in_element_index = should_be_in_element_index;
+    if (should_be_in_element_index)
+        document().element_index().add(*this);
+    else
+        document().element_index().remove(*this);
 }
 
 void Element::children_changed(ChildrenChangedMetadata const& metadata)
@@ -3748,7 +3810,7 @@ void Element::enqueue_a_custom_element_upgrade_reaction(HTML::CustomElementDefin
 void Element::enqueue_a_custom_element_callback_reaction(Utf16FlyString const& callback_name, GC::RootVector<JS::Value> arguments)
 {
     // 1. Let definition be element's custom element definition.
-    auto& definition = m_custom_element_definition;
+    auto definition = custom_element_definition();
 
     // 2. Let callback be the value of the entry in definition's lifecycle callbacks with key callbackName.
     GC::Ptr<Web::WebIDL::CallbackType> callback;
@@ -3822,7 +3884,7 @@ JS::ThrowCompletionOr<void> Element::upgrade_element(GC::Ref<HTML::CustomElement
         return {};
 
     // 2. Set element's custom element definition to definition.
-    m_custom_element_definition = custom_element_definition;
+    ensure_rare_data().custom_element_definition = custom_element_definition;
 
     // 3. Set element's custom element state to "failed".
     set_custom_element_state(CustomElementState::Failed);
@@ -3894,11 +3956,11 @@ JS::ThrowCompletionOr<void> Element::upgrade_element(GC::Ref<HTML::CustomElement
     // Finally, if the above steps threw an exception, then:
     if (maybe_exception.is_throw_completion()) {
         // 1. Set element's custom element definition to null.
-        m_custom_element_definition = nullptr;
+        m_rare_data->custom_element_definition = nullptr;
 
         // 2. Empty element's custom element reaction queue.
-        if (m_custom_element_reaction_queue)
-            m_custom_element_reaction_queue->clear();
+        if (m_rare_data->custom_element_reaction_queue)
+            m_rare_data->custom_element_reaction_queue->clear();
 
         // 3. Rethrow the exception (thus terminating this algorithm).
         return maybe_exception.release_error();
@@ -3963,10 +4025,10 @@ void Element::setup_custom_element_from_constructor(HTML::CustomElementDefinitio
     set_custom_element_state(CustomElementState::Custom);
 
     // 7.7. Set element's custom element definition to definition.
-    m_custom_element_definition = custom_element_definition;
+    ensure_rare_data().custom_element_definition = custom_element_definition;
 
     // 7.8. Set element's is value to is value.
-    m_is_value = is_value;
+    set_is_value(is_value);
 }
 
 void Element::set_prefix(Optional<Utf16FlyString> value)
@@ -4417,11 +4479,9 @@ bool Element::check_visibility(Optional<Bindings::CheckVisibilityOptions> option
 
     // 5. If the contentVisibilityAuto dictionary member of options is true and an ancestor of this in the flat tree
     //    skips its contents due to content-visibility: auto, return false.
-    // FIXME: Currently we do not skip any content if content-visibility is auto: https://drafts.csswg.org/css-contain-2/#proximity-to-the-viewport
-    auto const skipped_contents_due_to_content_visibility_auto = false;
-    if (options->content_visibility_auto && skipped_contents_due_to_content_visibility_auto) {
+    if (options->content_visibility_auto) {
         for (auto* element = flat_tree_parent_element(); element; element = element->flat_tree_parent_element()) {
-            if (element->computed_values()->content_visibility() == CSS::ContentVisibility::Auto)
+            if (element->computed_values()->content_visibility() == CSS::ContentVisibility::Auto && element->skips_its_contents())
                 return false;
         }
     }
@@ -4443,8 +4503,10 @@ void Element::determine_proximity_to_the_viewport()
     // viewport soon. A margin of 50% is suggested as a reasonable default.
     viewport_rect.inflate(viewport_rect.width(), viewport_rect.height());
     // FIXME: We don't have paint containment or the overflow clip edge yet, so this is just using the absolute rect for now.
-    if (paintable_box()->absolute_rect().intersects(viewport_rect))
+    if (paintable_box()->absolute_rect().intersects(viewport_rect)) {
         m_proximity_to_the_viewport = ProximityToTheViewport::CloseToTheViewport;
+        return;
+    }
 
     // FIXME: If a filter (see [FILTER-EFFECTS-1]) with non local effects includes the element as part of its input, the user
     //        agent should also treat the element as relevant to the user when the filter’s output can affect the rendering
@@ -4649,16 +4711,14 @@ bool Element::id_reference_exists(Utf16View id_reference) const
 
 void Element::register_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, GC::Ref<IntersectionObserver::IntersectionObserver> observer)
 {
-    if (!m_registered_intersection_observers)
-        m_registered_intersection_observers = make<Vector<GC::Ref<IntersectionObserver::IntersectionObserver>>>();
-    m_registered_intersection_observers->append(observer);
+    ensure_rare_data().registered_intersection_observers.append(observer);
 }
 
 void Element::unregister_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, GC::Ref<IntersectionObserver::IntersectionObserver> observer)
 {
-    if (!m_registered_intersection_observers)
+    if (!m_rare_data)
         return;
-    m_registered_intersection_observers->remove_first_matching([&observer](GC::Ref<IntersectionObserver::IntersectionObserver> const& entry) {
+    m_rare_data->registered_intersection_observers.remove_first_matching([&observer](GC::Ref<IntersectionObserver::IntersectionObserver> const& entry) {
         return entry == observer;
     });
 }
@@ -5003,6 +5063,10 @@ void Element::attribute_changed(Utf16FlyString const& local_name, Optional<Utf16
         if (is_connected())
             document().element_name_changed({}, *this);
     } else if (local_name == HTML::AttributeNames::class_) {
+        Vector<Utf16FlyString> old_classes;
+        if (m_is_in_element_index)
+            old_classes = move(m_classes);
+
         if (value_or_empty.is_empty()) {
             m_classes.clear();
         } else {
@@ -5012,6 +5076,9 @@ void Element::attribute_changed(Utf16FlyString const& local_name, Optional<Utf16
                 return IterationDecision::Continue;
             });
         }
+
+        if (m_is_in_element_index)
+            document().element_index().class_names_changed(*this, old_classes);
         if (m_class_list)
             m_class_list->associated_attribute_changed(value_or_empty);
     } else if (local_name == HTML::AttributeNames::style) {
@@ -5041,12 +5108,14 @@ void Element::attribute_changed(Utf16FlyString const& local_name, Optional<Utf16
         else
             CSS::Invalidation::invalidate_style_after_language_change(*this);
     } else if (local_name == HTML::AttributeNames::part) {
-        m_parts.clear();
+        if (m_rare_data)
+            m_rare_data->parts.clear();
         if (!value_or_empty.is_empty()) {
             auto new_parts = value_or_empty;
+            auto& parts = ensure_rare_data().parts;
             auto append_part = [&](Utf16View new_part) {
-                if (!m_parts.contains_slow(new_part))
-                    m_parts.append(Utf16FlyString::from_utf16(new_part));
+                if (!parts.contains_slow(new_part))
+                    parts.append(Utf16FlyString::from_utf16(new_part));
             };
             size_t start = 0;
             for (size_t i = 0; i <= new_parts.length_in_code_units(); ++i) {
@@ -5057,8 +5126,8 @@ void Element::attribute_changed(Utf16FlyString const& local_name, Optional<Utf16
                 start = i + 1;
             }
         }
-        if (m_part_list)
-            m_part_list->associated_attribute_changed(value_or_empty);
+        if (m_rare_data && m_rare_data->part_list)
+            m_rare_data->part_list->associated_attribute_changed(value_or_empty);
         CSS::Invalidation::invalidate_style_after_part_attribute_change(*this);
     } else if (local_name == HTML::AttributeNames::exportparts) {
         CSS::Invalidation::invalidate_style_after_exportparts_attribute_change(*this);
@@ -5089,16 +5158,40 @@ void Element::attribute_changed(Utf16FlyString const& local_name, Optional<Utf16
 
 auto Element::ensure_custom_element_reaction_queue() -> CustomElementReactionQueue&
 {
-    if (!m_custom_element_reaction_queue)
-        m_custom_element_reaction_queue = make<CustomElementReactionQueue>();
-    return *m_custom_element_reaction_queue;
+    auto& rare_data = ensure_rare_data();
+    if (!rare_data.custom_element_reaction_queue)
+        rare_data.custom_element_reaction_queue = make<CustomElementReactionQueue>();
+    return *rare_data.custom_element_reaction_queue;
 }
 
 HTML::CustomStateSet& Element::ensure_custom_state_set()
 {
-    if (!m_custom_state_set)
-        m_custom_state_set = HTML::CustomStateSet::create(realm(), *this);
-    return *m_custom_state_set;
+    auto& rare_data = ensure_rare_data();
+    if (!rare_data.custom_state_set)
+        rare_data.custom_state_set = HTML::CustomStateSet::create(realm(), *this);
+    return *rare_data.custom_state_set;
+}
+
+auto Element::ensure_rare_data() -> RareData&
+{
+    if (!m_rare_data)
+        m_rare_data = make<RareData>();
+    return *m_rare_data;
+}
+
+Optional<Utf16FlyString> const& Element::is_value() const
+{
+    static Optional<Utf16FlyString> const no_is_value;
+    if (!m_rare_data)
+        return no_is_value;
+    return m_rare_data->is_value;
+}
+
+void Element::set_is_value(Optional<Utf16FlyString> const& is)
+{
+    if (!is.has_value() && !m_rare_data)
+        return;
+    ensure_rare_data().is_value = is;
 }
 
 CSS::StyleSheetList& Element::document_or_shadow_root_style_sheets()
@@ -5485,12 +5578,13 @@ GC::Ref<CSS::StylePropertyMapReadOnly> Element::computed_style_map()
     //
     // NOTE: In practice, since the values are "hidden" behind a .get() method call, UAs can delay computing anything
     //    until a given property is actually requested.
-    if (m_computed_style_map_cache == nullptr) {
-        m_computed_style_map_cache = CSS::StylePropertyMapReadOnly::create_computed_style(realm(), AbstractElement { *this });
+    auto& rare_data = ensure_rare_data();
+    if (rare_data.computed_style_map_cache == nullptr) {
+        rare_data.computed_style_map_cache = CSS::StylePropertyMapReadOnly::create_computed_style(realm(), AbstractElement { *this });
     }
 
     // 2. Return this’s [[computedStyleMapCache]] internal slot.
-    return *m_computed_style_map_cache;
+    return *rare_data.computed_style_map_cache;
 }
 
 double Element::ensure_css_random_base_value(CSS::RandomCachingKey const& random_caching_key)
@@ -5500,7 +5594,7 @@ double Element::ensure_css_random_base_value(CSS::RandomCachingKey const& random
     if (!random_caching_key.element_id.has_value())
         return document().ensure_element_shared_css_random_base_value(random_caching_key);
 
-    return m_element_specific_css_random_base_value_cache.ensure(random_caching_key, []() {
+    return ensure_rare_data().element_specific_css_random_base_value_cache.ensure(random_caching_key, []() {
         static XorShift128PlusRNG random_number_generator;
         return random_number_generator.get();
     });
@@ -179,7 +179,12 @@ public:
 
     GC::Ref<DOMTokenList> class_list();
     GC::Ref<DOMTokenList> part_list();
-    ReadonlySpan<Utf16FlyString> part_names() const { return m_parts; }
+    ReadonlySpan<Utf16FlyString> part_names() const
+    {
+        if (!m_rare_data)
+            return {};
+        return m_rare_data->parts;
+    }
 
     WebIDL::ExceptionOr<GC::Ref<ShadowRoot>> attach_shadow(Bindings::ShadowRootInit const&);
     WebIDL::ExceptionOr<void> attach_a_shadow_root(Bindings::ShadowRootMode mode, bool clonable, bool serializable, bool delegates_focus, Bindings::SlotAssignmentMode slot_assignment, GC::Ptr<HTML::CustomElementRegistry> registry);
@@ -203,6 +208,10 @@ public:
     bool has_class(Utf16FlyString const&, CaseSensitivity = CaseSensitivity::CaseSensitive) const;
     Vector<Utf16FlyString> const& class_names() const { return m_classes; }
 
+    // Whether this element is in its document's ElementIndex, i.e. in the document tree rather than in a shadow tree
+    // or a disconnected subtree.
+    bool is_in_element_index() const { return m_is_in_element_index; }
+
     // https://html.spec.whatwg.org/multipage/embedded-content-other.html#dimension-attributes
     virtual bool supports_dimension_attributes() const { return false; }
 
@@ -363,6 +372,29 @@ public:
     void set_style_depends_on_size_container_query() { m_style_depends_on_size_container_query = true; }
     bool style_depends_on_style_container_query() const { return m_style_depends_on_style_container_query; }
     void set_style_depends_on_style_container_query() { m_style_depends_on_style_container_query = true; }
+    // Container-relative lengths follow every change in the container's size, unlike queries which only flip at their
+    // thresholds.
+    void set_style_depends_on_container_relative_length()
+    {
+        m_style_depends_on_size_container_query = true;
+        m_style_depends_on_container_relative_length = true;
+    }
+    void record_size_container_query_result(Optional<CSS::PseudoElement>, CSS::CSSContainerRule const&, bool matched);
+    bool size_container_query_results_changed() const;
+
+    // For an element that reuses the style computed for a sibling which matched exactly the same rules.
+    void copy_style_dependencies_from(Element const& other)
+    {
+        m_style_uses_attr_css_function = other.m_style_uses_attr_css_function;
+        m_style_uses_var_css_function = other.m_style_uses_var_css_function;
+        m_style_uses_if_css_function = other.m_style_uses_if_css_function;
+        m_style_uses_inherit_css_function = other.m_style_uses_inherit_css_function;
+        m_style_depends_on_size_container_query = other.m_style_depends_on_size_container_query;
+        m_style_depends_on_style_container_query = other.m_style_depends_on_style_container_query;
+        m_style_depends_on_container_relative_length = other.m_style_depends_on_container_relative_length;
+        m_size_container_query_results = other.m_size_container_query_results;
+    }
+
     void invalidate_descendant_styles_depending_on_style_container_query();
 
     bool child_style_uses_tree_counting_function() const { return m_child_style_uses_tree_counting_function; }
@@ -464,11 +496,11 @@ public:
     void enqueue_a_custom_element_callback_reaction(Utf16FlyString const& callback_name, GC::RootVector<JS::Value> arguments);
 
     using CustomElementReactionQueue = Vector<Variant<CustomElementUpgradeReaction, CustomElementCallbackReaction>>;
-    CustomElementReactionQueue* custom_element_reaction_queue() { return m_custom_element_reaction_queue; }
-    CustomElementReactionQueue const* custom_element_reaction_queue() const { return m_custom_element_reaction_queue; }
+    CustomElementReactionQueue* custom_element_reaction_queue() { return m_rare_data ? m_rare_data->custom_element_reaction_queue.ptr() : nullptr; }
+    CustomElementReactionQueue const* custom_element_reaction_queue() const { return m_rare_data ? m_rare_data->custom_element_reaction_queue.ptr() : nullptr; }
     CustomElementReactionQueue& ensure_custom_element_reaction_queue();
 
-    GC::Ptr<HTML::CustomStateSet const> custom_state_set() const { return m_custom_state_set; }
+    GC::Ptr<HTML::CustomStateSet const> custom_state_set() const { return m_rare_data ? m_rare_data->custom_state_set : nullptr; }
     HTML::CustomStateSet& ensure_custom_state_set();
 
     JS::ThrowCompletionOr<void> upgrade_element(GC::Ref<HTML::CustomElementDefinition> custom_element_definition);
@@ -477,8 +509,8 @@ public:
     bool is_defined() const;
     bool is_custom() const;
 
-    Optional<Utf16FlyString> const& is_value() const { return m_is_value; }
-    void set_is_value(Optional<Utf16FlyString> const& is) { m_is_value = is; }
+    Optional<Utf16FlyString> const& is_value() const;
+    void set_is_value(Optional<Utf16FlyString> const& is);
 
     void set_custom_element_state(CustomElementState);
     void setup_custom_element_from_constructor(HTML::CustomElementDefinition& custom_element_definition, Optional<Utf16FlyString> const& is_value);
@@ -688,7 +720,7 @@ protected:
     virtual bool id_reference_exists(Utf16View) const override;
 
     CustomElementState custom_element_state() const { return m_custom_element_state; }
-    GC::Ptr<HTML::CustomElementDefinition> custom_element_definition() const { return m_custom_element_definition; }
+    GC::Ptr<HTML::CustomElementDefinition> custom_element_definition() const { return m_rare_data ? m_rare_data->custom_element_definition : nullptr; }
 
     void play_or_cancel_animations_after_display_property_change();
     void clear_element_reference_pseudo_elements();
@@ -697,6 +729,7 @@ private:
     Utf16FlyString make_html_uppercased_qualified_name() const;
 
     void exit_fullscreen_on_element_removal();
+    void update_element_index_membership();
     CSS::RequiredInvalidationAfterStyleChange recompute_pseudo_element_styles(bool& did_change_custom_properties, bool had_list_marker, CSS::ComputedValues const* old_originating_style);
     void apply_computed_style_to_layout_node_if_needed(CSS::RequiredInvalidationAfterStyleChange const&);
     void set_in_display_none_subtree_on_descendant_styles();
@@ -727,7 +760,6 @@ private:
     GC::Ptr<CSS::StylePropertyMap> m_attribute_style_map;
     GC::Ptr<DOMTokenList> m_class_list;
     GC::Ptr<ShadowRoot> m_shadow_root;
-    GC::Ptr<DOMTokenList> m_part_list;
 
     RefPtr<CSS::ComputedValues const> m_computed_values;
     RefPtr<CSS::CustomPropertyData const> m_custom_property_data;
@@ -741,41 +773,60 @@ private:
     Optional<CSS::PseudoElement> m_associated_shadow_host_pseudo_element;
 
     Vector<Utf16FlyString> m_classes;
-    Vector<Utf16FlyString> m_parts;
     Optional<Dir> m_dir;
 
     Optional<Utf16FlyString> m_id;
     Optional<Utf16FlyString> m_name;
 
-    // https://html.spec.whatwg.org/multipage/custom-elements.html#custom-element-reaction-queue
-    // All elements have an associated custom element reaction queue, initially empty. Each item in the custom element reaction queue is of one of two types:
-    // NOTE: See the structs at the top of this header.
-    OwnPtr<CustomElementReactionQueue> m_custom_element_reaction_queue;
-
     // https://dom.spec.whatwg.org/#element-custom-element-registry
     GC::Ptr<HTML::CustomElementRegistry> m_custom_element_registry;
 
-    // https://dom.spec.whatwg.org/#concept-element-custom-element-definition
-    GC::Ptr<HTML::CustomElementDefinition> m_custom_element_definition;
+    // State that stays empty for the vast majority of elements, allocated the first time any of it is needed.
+    struct RareData {
+        GC::Ptr<DOMTokenList> part_list;
+        Vector<Utf16FlyString> parts;
+
+        // https://html.spec.whatwg.org/multipage/custom-elements.html#custom-element-reaction-queue
+        // All elements have an associated custom element reaction queue, initially empty. Each item in the custom element reaction queue is of one of two types:
+        // NOTE: See the structs at the top of this header.
+        OwnPtr<CustomElementReactionQueue> custom_element_reaction_queue;
+
+        // https://dom.spec.whatwg.org/#concept-element-custom-element-definition
+        GC::Ptr<HTML::CustomElementDefinition> custom_element_definition;
+
+        // https://dom.spec.whatwg.org/#concept-element-is-value
+        Optional<Utf16FlyString> is_value;
 
-    // https://dom.spec.whatwg.org/#concept-element-is-value
-    Optional<Utf16FlyString> m_is_value;
+        // https://html.spec.whatwg.org/multipage/custom-elements.html#states-set
+        GC::Ptr<HTML::CustomStateSet> custom_state_set;
 
-    // https://html.spec.whatwg.org/multipage/custom-elements.html#states-set
-    GC::Ptr<HTML::CustomStateSet> m_custom_state_set;
+        // https://www.w3.org/TR/intersection-observer/#dom-element-registeredintersectionobservers-slot
+        // Element objects have an internal [[RegisteredIntersectionObservers]] slot, which is initialized to an empty list.
+        Vector<GC::Ref<IntersectionObserver::IntersectionObserver>> registered_intersection_observers;
 
-    // https://www.w3.org/TR/intersection-observer/#dom-element-registeredintersectionobservers-slot
-    // Element objects have an internal [[RegisteredIntersectionObservers]] slot, which is initialized to an empty list.
-    OwnPtr<Vector<GC::Ref<IntersectionObserver::IntersectionObserver>>> m_registered_intersection_observers;
+        // https://drafts.css-houdini.org/css-typed-om-1/#dom-element-computedstylemapcache-slot
+        // Every Element has a [[computedStyleMapCache]] internal slot, initially set to null, which caches the result of
+        // the computedStyleMap() method when it is first called.
+        GC::Ptr<CSS::StylePropertyMapReadOnly> computed_style_map_cache;
 
-    // https://drafts.css-houdini.org/css-typed-om-1/#dom-element-computedstylemapcache-slot
-    // Every Element has a [[computedStyleMapCache]] internal slot, initially set to null, which caches the result of
-    // the computedStyleMap() method when it is first called.
-    GC::Ptr<CSS::StylePropertyMapReadOnly> m_computed_style_map_cache;
+        // https://drafts.csswg.org/css-values-5/#random-caching
+        HashMap<CSS::RandomCachingKey, double> element_specific_css_random_base_value_cache;
+    };
+    RareData& ensure_rare_data();
+    OwnPtr<RareData> m_rare_data;
 
     CSSPixelPoint m_scroll_offset;
     Vector<Utf16FlyString, 1> m_removed_attributes_for_style_invalidation;
 
+    // The outcome of each @container rule with size features that was evaluated for this element or one of its
+    // pseudo-elements during the last style computation, so a query container resize only restyles us if one flips.
+    struct SizeContainerQueryResult {
+        GC::Ref<CSS::CSSContainerRule const> rule;
+        Optional<CSS::PseudoElement> pseudo_element;
+        bool matched { false };
+    };
+    Vector<SizeContainerQueryResult> m_size_container_query_results;
+
     bool m_is_being_activated : 1 { false };
     bool m_in_top_layer : 1 { false };
     bool m_rendered_in_top_layer : 1 { false };
@@ -786,6 +837,7 @@ private:
     bool m_style_uses_inherit_css_function : 1 { false };
     bool m_style_depends_on_size_container_query : 1 { false };
     bool m_style_depends_on_style_container_query : 1 { false };
+    bool m_style_depends_on_container_relative_length : 1 { false };
     bool m_child_style_uses_tree_counting_function : 1 { false };
     bool m_affected_by_has_pseudo_class_in_subject_position : 1 { false };
     bool m_affected_by_has_pseudo_class_in_non_subject_position : 1 { false };
@@ -801,6 +853,7 @@ private:
     bool m_in_subtree_of_has_pseudo_class_relative_selector_with_sibling_combinator : 1 { false };
     bool m_in_has_scope : 1 { false };
     bool m_fullscreen_flag : 1 { false };
+    bool m_is_in_element_index : 1 { false };
 
     size_t m_sibling_invalidation_distance { 0 };
 
@@ -828,9 +881,6 @@ private:
     bool m_captured_in_a_view_transition { false };
 
     bool m_is_contained_in_list_subtree { false };
-
-    // https://drafts.csswg.org/css-values-5/#random-caching
-    HashMap<CSS::RandomCachingKey, double> m_element_specific_css_random_base_value_cache;
 };
 
 template<>
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementIndex.h>
+
+namespace Web::DOM {
+
+void ElementIndex::add_to(HashMap<Utf16FlyString, Entry>& map, Utf16FlyString const& key, Element& element)
+{
+    auto& entry = map.ensure(key, [] { return Entry {}; });
+    if (entry.elements.set(&element) == HashSetResult::InsertedNewEntry)
+        entry.elements_in_tree_order_is_valid = false;
+}
+
+void ElementIndex::remove_from(HashMap<Utf16FlyString, Entry>& map, Utf16FlyString const& key, Element& element)
+{
+    auto it = map.find(key);
+    if (it == map.end())
+        return;
+    auto& entry = it->value;
+
+    if (!entry.elements.remove(&element))
+        return;
+
+    if (entry.elements.is_empty()) {
+        map.remove(it);
+        return;
+    }
+    entry.elements_in_tree_order_is_valid = false;
+}
+
+void ElementIndex::add(Element& element)
+{
+    add_to(m_lowercased_local_names, element.lowercased_local_name(), element);
+    for (auto const& class_name : element.class_names())
+        add_to(m_class_names, class_name, element);
+}
+
+void ElementIndex::remove(Element& element)
+{
+    remove_from(m_lowercased_local_names, element.lowercased_local_name(), element);
+    for (auto const& class_name : element.class_names())
+        remove_from(m_class_names, class_name, element);
+}
+
+void ElementIndex::class_names_changed(Element& element, Vector<Utf16FlyString> const& old_class_names)
+{
+    auto const& new_class_names = element.class_names();
+    for (auto const& class_name : old_class_names) {
+        if (!new_class_names.contains_slow(class_name))
+            remove_from(m_class_names, class_name, element);
+    }
+    for (auto const& class_name : new_class_names)
+        add_to(m_class_names, class_name, element);
+}
+
+bool ElementIndex::covers_descendants_of(ParentNode const& root)
+{
+    if (is<Document>(root))
+        return true;
+    if (auto const* element = as_if<Element>(root))
+        return element->is_in_element_index();
+    return false;
+}
+
+Vector<GC::RawPtr<Element>> const& ElementIndex::elements_in_tree_order(Document const& document, HashMap<Utf16FlyString, Entry>& map, Utf16FlyString const& key) const
+{
+    static Vector<GC::RawPtr<Element>> const no_elements;
+
+    auto it = map.find(key);
+    if (it == map.end())
+        return no_elements;
+    auto& entry = it->value;
+
+    if (entry.elements_in_tree_order_is_valid && entry.tree_order_version == m_tree_order_version)
+        return entry.elements_in_tree_order;
+
+    // NB: Sorting by Node::compare_document_position() walks ancestor chains and sibling lists for every
+    //     comparison, so a single tree walk that stops after the last indexed element is cheaper in practice.
+    entry.elements_in_tree_order.clear_with_capacity();
+    entry.elements_in_tree_order.ensure_capacity(entry.elements.size());
+    document.for_each_in_subtree_of_type<Element>([&](auto const& element) {
+        if (entry.elements.contains(const_cast<Element*>(&element))) {
+            entry.elements_in_tree_order.unchecked_append(const_cast<Element*>(&element));
+            if (entry.elements_in_tree_order.size() == entry.elements.size())
+                return TraversalDecision::Break;
+        }
+        return TraversalDecision::Continue;
+    });
+    VERIFY(entry.elements_in_tree_order.size() == entry.elements.size());
+
+    entry.elements_in_tree_order_is_valid = true;
+    entry.tree_order_version = m_tree_order_version;
+    return entry.elements_in_tree_order;
+}
+
+Vector<GC::RawPtr<Element>> const& ElementIndex::elements_with_class_name(Document const& document, Utf16FlyString const& class_name) const
+{
+    return elements_in_tree_order(document, m_class_names, class_name);
+}
+
+Vector<GC::RawPtr<Element>> const& ElementIndex::elements_with_lowercased_local_name(Document const& document, Utf16FlyString const& lowercased_local_name) const
+{
+    return elements_in_tree_order(document, m_lowercased_local_names, lowercased_local_name);
+}
+
+}
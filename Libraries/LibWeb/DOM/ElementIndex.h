@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Utf16FlyString.h>
+#include <AK/Vector.h>
+#include <LibGC/Ptr.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::DOM {
+
+// Maps class names and lowercased local names to the elements in a document's tree that have them, so that
+// getElementsByClassName() and querySelector(All) can start from the matching elements instead of walking the
+// whole tree. Elements in shadow trees are not indexed.
+class ElementIndex {
+public:
+    void add(Element&);
+    void remove(Element&);
+    void class_names_changed(Element&, Vector<Utf16FlyString> const& old_class_names);
+
+    // Moving a subtree within the document changes the relative order of indexed elements without adding or
+    // removing any of them.
+    void tree_order_changed() { ++m_tree_order_version; }
+
+    // Whether every element visited by root.for_each_in_subtree_of_type<Element>() is in this index.
+    static bool covers_descendants_of(ParentNode const& root);
+
+    // NB: Checking that an indexed element is inside an element root walks its ancestor chain, so with more candidates
+    //     than this it's likely cheaper to walk the root's subtree instead.
+    static constexpr size_t MAX_CANDIDATES_FOR_ELEMENT_ROOT = 256;
+
+    // NB: The returned elements are in tree order. The list is only valid until the DOM is next mutated.
+    Vector<GC::RawPtr<Element>> const& elements_with_class_name(Document const&, Utf16FlyString const&) const;
+    Vector<GC::RawPtr<Element>> const& elements_with_lowercased_local_name(Document const&, Utf16FlyString const&) const;
+
+private:
+    struct Entry {
+        // Raw pointers are safe here: elements are removed from the index as soon as they leave the document tree,
+        // so every indexed element is kept alive by the document.
+        HashTable<GC::RawPtr<Element>> elements;
+
+        // Rebuilt lazily whenever elements are added or removed, or the tree order changes.
+        Vector<GC::RawPtr<Element>> elements_in_tree_order;
+        bool elements_in_tree_order_is_valid { false };
+        u64 tree_order_version { 0 };
+    };
+
+    static void add_to(HashMap<Utf16FlyString, Entry>&, Utf16FlyString const&, Element&);
+    static void remove_from(HashMap<Utf16FlyString, Entry>&, Utf16FlyString const&, Element&);
+    Vector<GC::RawPtr<Element>> const& elements_in_tree_order(Document const&, HashMap<Utf16FlyString, Entry>&, Utf16FlyString const&) const;
+
+    mutable HashMap<Utf16FlyString, Entry> m_class_names;
+    mutable HashMap<Utf16FlyString, Entry> m_lowercased_local_names;
+    u64 m_tree_order_version { 0 };
+};
+
+}
@@ -237,6 +237,17 @@ static void update_needs_beforeunload_check(EventTarget& event_target, DOMEventL
         traversable->page().update_needs_beforeunload_check();
 }
 
+static u64 event_listener_type_filter_bit(Utf16FlyString const& type)
+{
+    return 1ull << (type.hash() % 64);
+}
+
+static void note_event_listener_type_added(EventTarget& event_target, DOMEventListener const& listener)
+{
+    if (auto* node = as_if<Node>(event_target))
+        node->document().did_add_node_event_listener(listener.type);
+}
+
 // https://dom.spec.whatwg.org/#dom-eventtarget-addeventlistener
 void EventTarget::add_event_listener(Utf16FlyString const& type, IDLEventListener* callback, Variant<Bindings::AddEventListenerOptions, bool> const& options)
 {
@@ -292,6 +303,8 @@ void EventTarget::add_an_event_listener(DOMEventListener& listener)
     });
     if (it == event_listener_list.end()) {
         event_listener_list.append(listener);
+        m_data->event_listener_type_filter |= event_listener_type_filter_bit(listener.type);
+        note_event_listener_type_added(*this, listener);
         invalidate_compositor_wheel_event_listener_state(*this, listener);
         update_needs_beforeunload_check(*this, listener);
     }
@@ -348,6 +361,9 @@ void EventTarget::remove_an_event_listener(DOMEventListener& listener)
     VERIFY(m_data);
     auto did_remove = m_data->event_listener_list.remove_first_matching([&](auto& entry) { return entry.ptr() == &listener; });
     if (did_remove) {
+        m_data->event_listener_type_filter = 0;
+        for (auto const& entry : m_data->event_listener_list)
+            m_data->event_listener_type_filter |= event_listener_type_filter_bit(entry->type);
         invalidate_compositor_wheel_event_listener_state(*this, listener);
         update_needs_beforeunload_check(*this, listener);
     }
@@ -950,7 +966,9 @@ bool EventTarget::dispatch_event(Event& event)
 
 bool EventTarget::has_event_listener(Utf16FlyString const& type) const
 {
-    return m_data && m_data->event_listener_list.contains([&type](auto listener) { return listener->type == type; });
+    if (!m_data || !(m_data->event_listener_type_filter & event_listener_type_filter_bit(type)))
+        return false;
+    return m_data->event_listener_list.contains([&type](auto listener) { return listener->type == type; });
 }
 
 bool EventTarget::has_blocking_wheel_event_listener() const
@@ -80,6 +80,10 @@ private:
     struct Data {
         Vector<GC::Ref<DOMEventListener>> event_listener_list;
 
+        // One bit per hash bucket of the types in event_listener_list, so most has_event_listener() queries for types
+        // nobody listens to don't have to compare against every listener.
+        u64 event_listener_type_filter { 0 };
+
         // https://html.spec.whatwg.org/multipage/webappapis.html#event-handler-map
         // Spec Note: The order of the entries of event handler map could be arbitrary. It is not observable through any algorithms that operate on the map.
         HashMap<Utf16FlyString, GC::Ref<HTML::EventHandler>> event_handler_map;
@@ -10,6 +10,7 @@
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/ParentNode.h>
 #include <LibWeb/Namespace.h>
@@ -95,15 +96,37 @@ void HTMLCollection::update_name_to_element_mappings_if_needed() const
     }
 }
 
+// Returns the elements in the document's ElementIndex that the filter can accept, in tree order, or null if the
+// collection has to walk its root's subtree instead.
+Vector<GC::RawPtr<Element>> const* HTMLCollection::candidates_from_element_index() const
+{
+    if (m_scope != Scope::Descendants || !m_indexed_class_name.has_value() || !ElementIndex::covers_descendants_of(*m_root))
+        return nullptr;
+
+    auto& document = m_root->document();
+    auto const& candidates = document.element_index().elements_with_class_name(document, *m_indexed_class_name);
+    if (!is<Document>(*m_root) && candidates.size() > ElementIndex::MAX_CANDIDATES_FOR_ELEMENT_ROOT)
+        return nullptr;
+    return &candidates;
+}
+
 void HTMLCollection::update_cache_if_needed() const
 {
-    // Nothing to do, the DOM hasn't updated since we last built the cache.
-    if (m_cached_dom_tree_version == root()->document().dom_tree_version())
+    // Nothing to do, the root's subtree hasn't updated since we last built the cache.
+    // NB: Mutations elsewhere in the document can't change which elements we contain, so we don't look at
+    //     Document::dom_tree_version() here.
+    if (m_cached_dom_tree_version == root()->subtree_dom_tree_version())
         return;
 
     m_cached_elements.clear();
     m_cached_name_to_element_mappings = nullptr;
-    if (m_scope == Scope::Descendants) {
+    if (auto const* candidates = candidates_from_element_index()) {
+        bool root_is_document = is<Document>(*m_root);
+        for (auto const& element : *candidates) {
+            if ((root_is_document || element->is_descendant_of(*m_root)) && m_filter(*element))
+                m_cached_elements.append(element);
+        }
+    } else if (m_scope == Scope::Descendants) {
         m_root->for_each_in_subtree_of_type<Element>([&](auto& element) {
             if (m_filter(element))
                 m_cached_elements.append(element);
@@ -123,7 +146,7 @@ void HTMLCollection::update_cache_if_needed() const
         });
     }
 
-    m_cached_dom_tree_version = root()->document().dom_tree_version();
+    m_cached_dom_tree_version = root()->subtree_dom_tree_version();
 }
 
 GC::RootVector<GC::Ref<Element>> HTMLCollection::collect_matching_elements() const
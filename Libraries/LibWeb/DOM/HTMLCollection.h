@@ -43,6 +43,10 @@ public:
 
     GC::RootVector<GC::Ref<Element>> collect_matching_elements() const;
 
+    // Lets the collection start from the document's ElementIndex instead of walking its root's subtree.
+    // NB: The filter must only accept elements that have this exact class name.
+    void set_indexed_class_name(Utf16FlyString class_name) { m_indexed_class_name = move(class_name); }
+
     virtual Optional<JS::Value> item_value(size_t index) const override;
     virtual JS::Value named_item_value(Utf16FlyString const& name) const override;
     virtual Vector<Utf16FlyString> supported_property_names() const override;
@@ -63,6 +67,7 @@ private:
 
     void update_cache_if_needed() const;
     void update_name_to_element_mappings_if_needed() const;
+    Vector<GC::RawPtr<Element>> const* candidates_from_element_index() const;
 
     mutable u64 m_cached_dom_tree_version { 0 };
     mutable Vector<GC::RawPtr<Element>> m_cached_elements;
@@ -73,6 +78,7 @@ private:
     Function<bool(Element const&, Element const&)> m_sort;
 
     Scope m_scope { Scope::Descendants };
+    Optional<Utf16FlyString> m_indexed_class_name;
 };
 
 }
@@ -5,33 +5,39 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibJS/Runtime/ExternalMemory.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/MutationRecord.h>
 #include <LibWeb/DOM/MutationRecord.h>
 #include <LibWeb/DOM/Node.h>
 #include <LibWeb/DOM/NodeList.h>
+#include <LibWeb/DOM/StaticNodeList.h>
 
 namespace Web::DOM {
 
 GC_DEFINE_ALLOCATOR(MutationRecord);
 
-GC::Ref<MutationRecord> MutationRecord::create(JS::Realm& realm, Utf16FlyString const& type, Node const& target, NodeList& added_nodes, NodeList& removed_nodes, Node* previous_sibling, Node* next_sibling, Optional<Utf16FlyString> const& attribute_name, Optional<Utf16FlyString> const& attribute_namespace, Optional<Utf16String> const& old_value)
+GC::Ref<MutationRecord> MutationRecord::create(JS::Realm& realm, Utf16FlyString const& type, Node const& target, ReadonlySpan<GC::Root<Node>> added_nodes, ReadonlySpan<GC::Root<Node>> removed_nodes, Node* previous_sibling, Node* next_sibling, Optional<Utf16FlyString> const& attribute_name, Optional<Utf16FlyString> const& attribute_namespace, Optional<Utf16String> const& old_value)
 {
     return realm.create<MutationRecord>(realm, type, target, added_nodes, removed_nodes, previous_sibling, next_sibling, attribute_name, attribute_namespace, old_value);
 }
 
-MutationRecord::MutationRecord(JS::Realm& realm, Utf16FlyString const& type, Node const& target, NodeList& added_nodes, NodeList& removed_nodes, Node* previous_sibling, Node* next_sibling, Optional<Utf16FlyString> const& attribute_name, Optional<Utf16FlyString> const& attribute_namespace, Optional<Utf16String> const& old_value)
+MutationRecord::MutationRecord(JS::Realm& realm, Utf16FlyString const& type, Node const& target, ReadonlySpan<GC::Root<Node>> added_nodes, ReadonlySpan<GC::Root<Node>> removed_nodes, Node* previous_sibling, Node* next_sibling, Optional<Utf16FlyString> const& attribute_name, Optional<Utf16FlyString> const& attribute_namespace, Optional<Utf16String> const& old_value)
     : PlatformObject(realm)
     , m_type(type)
     , m_target(GC::make_root(target))
-    , m_added_nodes(added_nodes)
-    , m_removed_nodes(removed_nodes)
     , m_previous_sibling(GC::make_root(previous_sibling))
     , m_next_sibling(GC::make_root(next_sibling))
     , m_attribute_name(attribute_name)
     , m_attribute_namespace(attribute_namespace)
     , m_old_value(old_value)
 {
+    m_added_nodes.ensure_capacity(added_nodes.size());
+    for (auto const& node : added_nodes)
+        m_added_nodes.unchecked_append(*node);
+    m_removed_nodes.ensure_capacity(removed_nodes.size());
+    for (auto const& node : removed_nodes)
+        m_removed_nodes.unchecked_append(*node);
 }
 
 MutationRecord::~MutationRecord() = default;
@@ -48,8 +54,40 @@ void MutationRecord::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_target);
     visitor.visit(m_added_nodes);
     visitor.visit(m_removed_nodes);
+    visitor.visit(m_added_nodes_list);
+    visitor.visit(m_removed_nodes_list);
     visitor.visit(m_previous_sibling);
     visitor.visit(m_next_sibling);
 }
 
+size_t MutationRecord::external_memory_size() const
+{
+    return Base::external_memory_size() + JS::vector_external_memory_size(m_added_nodes) + JS::vector_external_memory_size(m_removed_nodes);
+}
+
+static GC::Ref<NodeList> create_node_list(JS::Realm& realm, Vector<GC::Ref<Node>> const& nodes)
+{
+    Vector<GC::Root<Node>> roots;
+    roots.ensure_capacity(nodes.size());
+    for (auto node : nodes)
+        roots.unchecked_append(node);
+    return StaticNodeList::create(realm, move(roots));
+}
+
+// https://dom.spec.whatwg.org/#dom-mutationrecord-addednodes
+NodeList const* MutationRecord::added_nodes() const
+{
+    if (!m_added_nodes_list)
+        m_added_nodes_list = create_node_list(realm(), m_added_nodes);
+    return m_added_nodes_list;
+}
+
+// https://dom.spec.whatwg.org/#dom-mutationrecord-removednodes
+NodeList const* MutationRecord::removed_nodes() const
+{
+    if (!m_removed_nodes_list)
+        m_removed_nodes_list = create_node_list(realm(), m_removed_nodes);
+    return m_removed_nodes_list;
+}
+
 }
@@ -8,6 +8,8 @@
 
 #include <AK/Utf16FlyString.h>
 #include <AK/Utf16String.h>
+#include <AK/Vector.h>
+#include <LibGC/Root.h>
 #include <LibWeb/Bindings/PlatformObject.h>
 
 namespace Web::DOM {
@@ -18,14 +20,14 @@ class MutationRecord : public Bindings::PlatformObject {
     GC_DECLARE_ALLOCATOR(MutationRecord);
 
 public:
-    [[nodiscard]] static GC::Ref<MutationRecord> create(JS::Realm&, Utf16FlyString const& type, Node const& target, NodeList& added_nodes, NodeList& removed_nodes, Node* previous_sibling, Node* next_sibling, Optional<Utf16FlyString> const& attribute_name, Optional<Utf16FlyString> const& attribute_namespace, Optional<Utf16String> const& old_value);
+    [[nodiscard]] static GC::Ref<MutationRecord> create(JS::Realm&, Utf16FlyString const& type, Node const& target, ReadonlySpan<GC::Root<Node>> added_nodes, ReadonlySpan<GC::Root<Node>> removed_nodes, Node* previous_sibling, Node* next_sibling, Optional<Utf16FlyString> const& attribute_name, Optional<Utf16FlyString> const& attribute_namespace, Optional<Utf16String> const& old_value);
 
     virtual ~MutationRecord() override;
 
     Utf16FlyString const& type() const { return m_type; }
     Node const* target() const { return m_target; }
-    NodeList const* added_nodes() const { return m_added_nodes; }
-    NodeList const* removed_nodes() const { return m_removed_nodes; }
+    NodeList const* added_nodes() const;
+    NodeList const* removed_nodes() const;
     Node const* previous_sibling() const { return m_previous_sibling; }
     Node const* next_sibling() const { return m_next_sibling; }
     Optional<Utf16String> attribute_name() const
@@ -39,15 +41,22 @@ public:
     Optional<Utf16String> const& old_value() const { return m_old_value; }
 
 private:
-    MutationRecord(JS::Realm& realm, Utf16FlyString const& type, Node const& target, NodeList& added_nodes, NodeList& removed_nodes, Node* previous_sibling, Node* next_sibling, Optional<Utf16FlyString> const& attribute_name, Optional<Utf16FlyString> const& attribute_namespace, Optional<Utf16String> const& old_value);
+    MutationRecord(JS::Realm& realm, Utf16FlyString const& type, Node const& target, ReadonlySpan<GC::Root<Node>> added_nodes, ReadonlySpan<GC::Root<Node>> removed_nodes, Node* previous_sibling, Node* next_sibling, Optional<Utf16FlyString> const& attribute_name, Optional<Utf16FlyString> const& attribute_namespace, Optional<Utf16String> const& old_value);
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual size_t external_memory_size() const override;
 
     Utf16FlyString m_type;
     GC::Ptr<Node const> m_target;
-    GC::Ptr<NodeList> m_added_nodes;
-    GC::Ptr<NodeList> m_removed_nodes;
+
+    // NB: Most records are for attribute or character data changes, whose node lists are always empty, and few
+    //     callbacks look at the node lists of the rest. So we only create the NodeList objects when they're asked for.
+    Vector<GC::Ref<Node>> m_added_nodes;
+    Vector<GC::Ref<Node>> m_removed_nodes;
+    mutable GC::Ptr<NodeList> m_added_nodes_list;
+    mutable GC::Ptr<NodeList> m_removed_nodes_list;
+
     GC::Ptr<Node> m_previous_sibling;
     GC::Ptr<Node> m_next_sibling;
     Optional<Utf16FlyString> m_attribute_name;
@@ -112,6 +112,17 @@ Node* Node::from_unique_id(UniqueNodeID unique_id)
     return node_directory().get(unique_id);
 }
 
+static u64 s_next_subtree_dom_tree_version = 1;
+
+void Node::bump_dom_tree_version_for_subtree()
+{
+    document().bump_dom_tree_version();
+
+    auto version = s_next_subtree_dom_tree_version++;
+    for (auto* node = this; node; node = node->parent())
+        node->m_subtree_dom_tree_version = version;
+}
+
 Node::Node(JS::Realm& realm, Document& document, NodeType type)
     : EventTarget(realm)
     , m_document(&document)
@@ -295,12 +306,18 @@ WebIDL::ExceptionOr<void> Node::set_text_content(Optional<Utf16String> const& ma
         if (!first_child() && content.is_empty()) {
             return {};
         }
-        string_replace_all(content);
+        if (maybe_content.has_value())
+            string_replace_all(*maybe_content);
+        else
+            string_replace_all(content);
     }
 
     // If CharacterData, replace data with node this, offset 0, count this’s length, and data the given value.
     else if (auto* character_data = as_if<CharacterData>(*this)) {
-        TRY(character_data->replace_data(0, character_data->length_in_utf16_code_units(), content));
+        if (maybe_content.has_value())
+            character_data->set_data(*maybe_content);
+        else
+            character_data->set_data(content);
     }
 
     // If Attr, set an existing attribute value with this and the given value.
@@ -315,7 +332,7 @@ WebIDL::ExceptionOr<void> Node::set_text_content(Optional<Utf16String> const& ma
         set_needs_layout_tree_update(true, SetNeedsLayoutTreeUpdateReason::NodeSetTextContent);
     }
 
-    document().bump_dom_tree_version();
+    bump_dom_tree_version_for_subtree();
     return {};
 }
 
@@ -464,7 +481,10 @@ WebIDL::ExceptionOr<void> Node::set_node_value(Optional<Utf16String> const& mayb
         TRY(attr->set_value(value));
     } else if (auto* character_data = as_if<CharacterData>(this)) {
         // If CharacterData, replace data with node this, offset 0, count this’s length, and data the given value.
-        character_data->set_data(value);
+        if (maybe_value.has_value())
+            character_data->set_data(*maybe_value);
+        else
+            character_data->set_data(value);
     }
 
     // Otherwise, do nothing.
@@ -898,7 +918,7 @@ void Node::insert_before(GC::Ref<Node> node, GC::Ptr<Node> child, bool suppress_
     //       an ordinal value (default from constructor).
     // FIXME: This will not work if the child or the parent is not an element. Is insert_before even possible in this situation?
 
-    document().bump_dom_tree_version();
+    bump_dom_tree_version_for_subtree();
 }
 
 // https://dom.spec.whatwg.org/#concept-node-pre-insert
@@ -1129,7 +1149,7 @@ void Node::remove(bool suppress_observers)
     ChildrenChangedMetadata metadata { ChildrenChangedMetadata::Type::Removal, *this };
     parent->children_changed(metadata);
 
-    document().bump_dom_tree_version();
+    parent->bump_dom_tree_version_for_subtree();
 }
 
 // https://dom.spec.whatwg.org/#concept-node-replace
@@ -1455,7 +1475,8 @@ WebIDL::ExceptionOr<void> Node::move_node(Node& new_parent, Node* child)
     // 26. Queue a tree mutation record for newParent with « node », « », newPreviousSibling, and child.
     new_parent.queue_tree_mutation_record({ *this }, {}, new_previous_sibling, child);
 
-    document().bump_dom_tree_version();
+    old_parent->bump_dom_tree_version_for_subtree();
+    new_parent.bump_dom_tree_version_for_subtree();
 
     return {};
 }
@@ -1638,6 +1659,11 @@ void Node::set_document(Document& document)
     bool const descendants_need_style_update = child_needs_style_update();
     m_document = &document;
 
+    if (has_event_listeners()) {
+        for (auto const& listener : event_listener_list())
+            document.did_add_node_event_listener(listener->type);
+    }
+
     if (auto* animatable = as_if<Animations::Animatable>(*this))
         animatable->on_document_changed(old_document, document);
 
@@ -3011,14 +3037,11 @@ void Node::queue_mutation_record(Utf16FlyString const& type, Optional<Utf16FlySt
     if (interested_observers.is_empty() && !page.listen_for_dom_mutations())
         return;
 
-    auto added_nodes_list = StaticNodeList::create(realm(), move(added_nodes));
-    auto removed_nodes_list = StaticNodeList::create(realm(), move(removed_nodes));
-
     // 4. For each observer → mappedOldValue of interestedObservers:
     for (auto& [observer, mapped_old_value] : interested_observers) {
         // 1. Let record be a new MutationRecord object with its type set to type, target set to target, attributeName set to name, attributeNamespace set to namespace, oldValue set to mappedOldValue,
         //    addedNodes set to addedNodes, removedNodes set to removedNodes, previousSibling set to previousSibling, and nextSibling set to nextSibling.
-        auto record = MutationRecord::create(realm(), type, *this, added_nodes_list, removed_nodes_list, previous_sibling, next_sibling, attribute_name, attribute_namespace, mapped_old_value);
+        auto record = MutationRecord::create(realm(), type, *this, added_nodes, removed_nodes, previous_sibling, next_sibling, attribute_name, attribute_namespace, mapped_old_value);
 
         // 2. Enqueue record to observer’s record queue.
         observer->enqueue_record({}, move(record));
@@ -3031,8 +3054,11 @@ void Node::queue_mutation_record(Utf16FlyString const& type, Optional<Utf16FlySt
     Bindings::queue_mutation_observer_microtask();
 
     // AD-HOC: Notify the UI if it is interested in DOM mutations (i.e. for DevTools).
-    if (page.listen_for_dom_mutations())
+    if (page.listen_for_dom_mutations()) {
+        auto added_nodes_list = StaticNodeList::create(realm(), move(added_nodes));
+        auto removed_nodes_list = StaticNodeList::create(realm(), move(removed_nodes));
         page.client().page_did_mutate_dom(type, *this, added_nodes_list, removed_nodes_list, previous_sibling, next_sibling, attribute_name);
+    }
 }
 
 // https://dom.spec.whatwg.org/#queue-a-tree-mutation-record
@@ -3659,9 +3685,13 @@ bool Node::has_inclusive_ancestor_with_display_none_ignoring_animations() const
 
 bool Node::has_inclusive_ancestor_with_event_listener(Utf16FlyString const& type) const
 {
-    for (auto const* ancestor = this; ancestor; ancestor = ancestor->parent_or_shadow_host()) {
-        if (ancestor->has_event_listener(type))
-            return true;
+    // OPTIMIZATION: Nodes only ever get listeners for types their document has recorded, so we can usually skip
+    //               walking the ancestor chain altogether.
+    if (document().may_have_node_event_listener(type)) {
+        for (auto const* ancestor = this; ancestor; ancestor = ancestor->parent_or_shadow_host()) {
+            if (ancestor->has_event_listener(type))
+                return true;
+        }
     }
     if (auto window = document().window())
         return window->has_event_listener(type);
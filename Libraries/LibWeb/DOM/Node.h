@@ -436,6 +436,11 @@ public:
     [[nodiscard]] UniqueNodeID unique_id() const { return m_unique_id; }
     static Node* from_unique_id(UniqueNodeID);
 
+    // AD-HOC: Like Document::dom_tree_version(), but only changes when this node or one of its descendants is mutated.
+    //         Values come from a process-wide counter, so they stay comparable when a subtree moves between documents.
+    u64 subtree_dom_tree_version() const { return m_subtree_dom_tree_version; }
+    void bump_dom_tree_version_for_subtree();
+
     WebIDL::ExceptionOr<Utf16String> serialize_fragment(HTML::RequireWellFormed, FragmentSerializationMode = FragmentSerializationMode::Inner) const;
 
     WebIDL::ExceptionOr<void> unsafely_set_html(Variant<GC::Ref<Element>, GC::Ref<DocumentFragment>>, Utf16View);
@@ -552,6 +557,7 @@ protected:
     bool m_inside_blocking_wheel_event_handler { false };
 
     UniqueNodeID m_unique_id;
+    u64 m_subtree_dom_tree_version { 0 };
 
     // https://dom.spec.whatwg.org/#registered-observer-list
     // "Nodes have a strong reference to registered observers in their registered observer list." https://dom.spec.whatwg.org/#garbage-collection
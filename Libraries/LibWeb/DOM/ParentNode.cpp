@@ -247,13 +247,22 @@ GC::Ref<HTMLCollection> ParentNode::get_elements_by_class_name(Utf16View class_n
     if (token_start.has_value())
         append_class_name(class_names.substring_view(*token_start));
 
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [list_of_class_names = move(list_of_class_names), quirks_mode = document().in_quirks_mode()](Element const& element) {
+    // NB: Class names match case-insensitively in quirks mode, but the element index is keyed by the exact class name.
+    Optional<Utf16FlyString> indexed_class_name;
+    auto quirks_mode = document().in_quirks_mode();
+    if (!quirks_mode && !list_of_class_names.is_empty())
+        indexed_class_name = Utf16FlyString { list_of_class_names.first() };
+
+    auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [list_of_class_names = move(list_of_class_names), quirks_mode](Element const& element) {
         for (auto& name : list_of_class_names) {
             if (!element.has_class(name.utf16_view(), quirks_mode ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive))
                 return false;
         }
         return !list_of_class_names.is_empty();
     });
+    if (indexed_class_name.has_value())
+        collection->set_indexed_class_name(indexed_class_name.release_value());
+    return collection;
 }
 
 GC::Ptr<Element> ParentNode::get_element_by_id(Utf16View id) const
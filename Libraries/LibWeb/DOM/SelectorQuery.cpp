@@ -8,6 +8,7 @@
 #include <LibWeb/CSS/SelectorMatching.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/ParentNode.h>
 #include <LibWeb/DOM/SelectorQuery.h>
 #include <LibWeb/DOM/StaticNodeList.h>
@@ -74,6 +75,50 @@ SelectorQuery::SelectorQuery(CSS::SelectorList&& selectors)
         if (!m_is_result_cacheable)
             break;
     }
+
+    if (m_selectors.size() == 1) {
+        for (auto const& simple_selector : m_selectors.first()->compound_selectors().last().simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Class) {
+                m_indexed_class_name = simple_selector.class_name();
+                break;
+            }
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::TagName && !m_indexed_lowercased_local_name.has_value())
+                m_indexed_lowercased_local_name = simple_selector.qualified_name().name.lowercase_name;
+        }
+    }
+}
+
+bool SelectorQuery::matches(Element& element, ParentNode& root) const
+{
+    for (auto const& selector : m_selectors) {
+        SelectorMatching::MatchContext context;
+        if (SelectorMatching::matches(selector, element, nullptr, context, root))
+            return true;
+    }
+    return false;
+}
+
+// Returns the elements in the document's ElementIndex that every match must be among, in tree order, or null if the
+// query has to walk root's subtree instead. Candidates may lie outside root's subtree; callers must check.
+Vector<GC::RawPtr<Element>> const* SelectorQuery::candidates_from_element_index(ParentNode const& root) const
+{
+    if (!ElementIndex::covers_descendants_of(root))
+        return nullptr;
+
+    auto& document = root.document();
+    Vector<GC::RawPtr<Element>> const* candidates = nullptr;
+
+    // NB: Class names match case-insensitively in quirks mode, but the index is keyed by the exact class name.
+    if (m_indexed_class_name.has_value() && !document.in_quirks_mode())
+        candidates = &document.element_index().elements_with_class_name(document, *m_indexed_class_name);
+    else if (m_indexed_lowercased_local_name.has_value())
+        candidates = &document.element_index().elements_with_lowercased_local_name(document, *m_indexed_lowercased_local_name);
+    else
+        return nullptr;
+
+    if (!is<Document>(root) && candidates->size() > ElementIndex::MAX_CANDIDATES_FOR_ELEMENT_ROOT)
+        return nullptr;
+    return candidates;
 }
 
 // https://dom.spec.whatwg.org/#scope-match-a-selectors-string
@@ -87,15 +132,21 @@ GC::Ptr<Element> SelectorQuery::query_first(ParentNode& root) const
             return cached_elements->is_empty() ? nullptr : cached_elements->first().ptr();
     }
 
+    if (auto const* candidates = candidates_from_element_index(root)) {
+        bool root_is_document = is<Document>(root);
+        for (auto const& candidate : *candidates) {
+            if ((root_is_document || candidate->is_descendant_of(root)) && matches(*candidate, root))
+                return candidate;
+        }
+        return nullptr;
+    }
+
     GC::Ptr<Element> result;
     // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
     root.for_each_in_subtree_of_type<Element>([&](auto& element) {
-        for (auto const& selector : m_selectors) {
-            SelectorMatching::MatchContext context;
-            if (SelectorMatching::matches(selector, element, nullptr, context, root)) {
-                result = &element;
-                return TraversalDecision::Break;
-            }
+        if (matches(element, root)) {
+            result = &element;
+            return TraversalDecision::Break;
         }
         return TraversalDecision::Continue;
     });
@@ -123,17 +174,20 @@ GC::Ref<NodeList> SelectorQuery::query_all(ParentNode& root) const
     }
 
     Vector<GC::RawPtr<Element>> elements;
-    // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
-    root.for_each_in_subtree_of_type<Element>([&](auto& element) {
-        for (auto const& selector : m_selectors) {
-            SelectorMatching::MatchContext context;
-            if (SelectorMatching::matches(selector, element, nullptr, context, root)) {
-                elements.append(element);
-                break;
-            }
+    if (auto const* candidates = candidates_from_element_index(root)) {
+        bool root_is_document = is<Document>(root);
+        for (auto const& candidate : *candidates) {
+            if ((root_is_document || candidate->is_descendant_of(root)) && matches(*candidate, root))
+                elements.append(candidate);
         }
-        return TraversalDecision::Continue;
-    });
+    } else {
+        // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
+        root.for_each_in_subtree_of_type<Element>([&](auto& element) {
+            if (matches(element, root))
+                elements.append(element);
+            return TraversalDecision::Continue;
+        });
+    }
 
     auto node_list = create_node_list(root.realm(), elements);
     if (m_is_result_cacheable)
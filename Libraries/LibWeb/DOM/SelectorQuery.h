@@ -36,8 +36,16 @@ public:
 private:
     explicit SelectorQuery(CSS::SelectorList&&);
 
+    bool matches(Element&, ParentNode& root) const;
+    Vector<GC::RawPtr<Element>> const* candidates_from_element_index(ParentNode const& root) const;
+
     CSS::SelectorList m_selectors;
 
+    // A class name or lowercased local name that every matching element must have, taken from the rightmost compound
+    // selector when the list has a single selector. Queries can then start from the document's ElementIndex.
+    Optional<Utf16FlyString> m_indexed_class_name;
+    Optional<Utf16FlyString> m_indexed_lowercased_local_name;
+
     // Whether matching can only change when the document's dom_tree_version (plus character_data_version, see below)
     // changes. Queries with selectors that depend on other state (:hover, :checked, :target, etc) are not cacheable.
     bool m_is_result_cacheable { false };
@@ -22,6 +22,9 @@ namespace Web::Fetch::Fetching {
 
 GC_DEFINE_ALLOCATOR(FetchedDataReceiver);
 
+// Once this much of the body is waiting in the stream's queue for its consumer, we stop reading from the network.
+static constexpr double maximum_queued_body_size = 1 * MiB;
+
 FetchedDataReceiver::FetchedDataReceiver(GC::Ref<Infrastructure::FetchParams const> fetch_params, GC::Ref<Streams::ReadableStream> stream, RefPtr<HTTP::MemoryCache> http_cache)
     : m_fetch_params(fetch_params)
     , m_stream(stream)
@@ -114,8 +117,30 @@ void FetchedDataReceiver::handle_network_data(Requests::ResponseData data, Netwo
     // 7. Append bytes to buffer.
     enqueue_into_stream(bytes);
 
-    // FIXME: 8. If the size of buffer is larger than an upper limit chosen by the user agent, ask the user agent
-    //           to suspend the ongoing fetch.
+    // 8. If the size of buffer is larger than an upper limit chosen by the user agent, ask the user agent to suspend
+    //    the ongoing fetch.
+    // NB: Bytes are pulled into stream as soon as they arrive, so stream's queue is what holds on to them.
+    if (!m_network_suspended && m_network_request && m_stream->is_readable()) {
+        auto& controller = m_stream->controller()->get<GC::Ref<Streams::ReadableByteStreamController>>();
+        if (controller->queue_total_size() > maximum_queued_body_size) {
+            m_network_suspended = true;
+            m_network_request->set_body_delivery_throttled(true);
+        }
+    }
+}
+
+// https://fetch.spec.whatwg.org/#ref-for-in-parallel④
+void FetchedDataReceiver::handle_pull()
+{
+    // 1. If the size of buffer is smaller than a lower limit chosen by the user agent and the ongoing fetch is
+    //    suspended, resume the fetch.
+    // NB: The stream only calls its pull algorithm once its queue has been drained.
+    if (!m_network_suspended)
+        return;
+
+    m_network_suspended = false;
+    if (m_network_request)
+        m_network_request->set_body_delivery_throttled(false);
 }
 
 void FetchedDataReceiver::set_cached_response_body(Core::ImmutableBytes body)
@@ -132,8 +157,7 @@ void FetchedDataReceiver::set_cached_response_body(Core::ImmutableBytes body)
 // https://fetch.spec.whatwg.org/#ref-for-in-parallel④
 void FetchedDataReceiver::enqueue_into_stream(ReadonlyBytes bytes)
 {
-    // FIXME: 1. If the size of buffer is smaller than a lower limit chosen by the user agent and the ongoing fetch
-    //           is suspended, resume the fetch.
+    // NB: Step 1 is implemented by handle_pull().
 
     if (!m_stream->is_readable())
         return;
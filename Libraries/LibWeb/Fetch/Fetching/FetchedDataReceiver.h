@@ -35,6 +35,9 @@ public:
     void handle_network_data(Requests::ResponseData, NetworkState);
     void set_cached_response_body(Core::ImmutableBytes);
 
+    void set_network_request(Requests::Request& network_request) { m_network_request = network_request; }
+    void handle_pull();
+
 private:
     FetchedDataReceiver(GC::Ref<Infrastructure::FetchParams const>, GC::Ref<Streams::ReadableStream>, RefPtr<HTTP::MemoryCache>);
 
@@ -61,6 +64,11 @@ private:
     bool m_cache_body_replaces_network_buffer { false };
 
     bool m_network_complete { false };
+
+    // https://fetch.spec.whatwg.org/#ref-for-in-parallel⑤
+    // Set while the ongoing fetch is suspended because stream's queue grew beyond our upper limit.
+    WeakPtr<Requests::Request> m_network_request;
+    bool m_network_suspended { false };
 };
 
 }
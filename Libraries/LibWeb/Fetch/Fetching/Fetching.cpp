@@ -115,6 +115,16 @@ public:
         m_cache.clear();
     }
 
+    HTTPMemoryCacheSize size() const
+    {
+        HTTPMemoryCacheSize size;
+        for (auto const& it : m_cache) {
+            ++size.partition_count;
+            size.bytes += it.value->statistics().size;
+        }
+        return size;
+    }
+
 private:
     HashMap<Infrastructure::NetworkPartitionKey, NonnullRefPtr<HTTP::MemoryCache>> m_cache;
 };
@@ -133,12 +143,12 @@ static RefPtr<HTTP::MemoryCache> determine_the_http_cache_partition(Infrastructu
     return HTTPCache::the().get(key.value());
 }
 
-static GC::Ptr<Infrastructure::Response> select_response_from_cache(JS::Realm& realm, HTTP::MemoryCache& http_cache, Infrastructure::Request const& request)
+static GC::Ptr<Infrastructure::Response> select_response_from_cache(JS::Realm& realm, HTTP::MemoryCache& http_cache, Infrastructure::Request const& request, HTTP::MemoryCache::RevalidationType* revalidation_type)
 {
     if (!g_http_memory_cache_enabled)
         return {};
 
-    auto cache_entry = http_cache.open_entry(request.current_url(), request.method(), request.header_list(), request.cache_mode());
+    auto cache_entry = http_cache.open_entry(request.current_url(), request.method(), request.header_list(), request.cache_mode(), revalidation_type);
     if (!cache_entry.has_value())
         return {};
 
@@ -153,7 +163,9 @@ static GC::Ptr<Infrastructure::Response> select_response_from_cache(JS::Realm& r
     response->set_javascript_bytecode_cache_vary_key(cache_entry->javascript_bytecode_cache_vary_key);
     response->set_javascript_bytecode_cache_memory_cache_request_headers(HTTP::HeaderList::create(cache_entry->request_headers->headers()));
 
-    auto [response_body, _] = safely_extract_body(realm, cache_entry->response_body.bytes());
+    // NB: The body shares the cache entry's bytes, so consumers of the whole body (e.g. script fetches) read them
+    //     without a copy.
+    auto [response_body, _] = safely_extract_body(realm, cache_entry->response_body);
     response->set_body(response_body);
 
     return response;
@@ -170,6 +182,61 @@ static void store_response_in_cache(HTTP::MemoryCache& http_cache, Infrastructur
     http_cache.create_entry(request.current_url(), request.method(), request.header_list(), request.request_time(), response.status(), response.status_message(), response.header_list(), response.javascript_bytecode_cache(), response.javascript_bytecode_cache_vary_key());
 }
 
+// https://fetch.spec.whatwg.org/#request-internal-priority
+static Infrastructure::Request::InternalPriority compute_internal_priority(Infrastructure::Request const& request)
+{
+    using Destination = Infrastructure::Request::Destination;
+
+    Infrastructure::Request::InternalPriority priority;
+
+    // NB: Documents and the resources that block rendering go first. Images and media render progressively, so they
+    //     are marked incremental and go after everything that does not.
+    if (auto destination = request.destination(); destination.has_value()) {
+        switch (*destination) {
+        case Destination::Document:
+        case Destination::Frame:
+        case Destination::IFrame:
+            priority = { .urgency = 0, .incremental = true };
+            break;
+        case Destination::Style:
+        case Destination::Font:
+            priority = { .urgency = 1 };
+            break;
+        case Destination::Script:
+            priority = { .urgency = 2 };
+            break;
+        case Destination::Image:
+            priority = { .urgency = 4, .incremental = true };
+            break;
+        case Destination::Audio:
+        case Destination::Track:
+        case Destination::Video:
+            priority = { .urgency = 5, .incremental = true };
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (request.render_blocking())
+        priority.urgency = min(priority.urgency, static_cast<u8>(1));
+
+    switch (request.priority()) {
+    case Infrastructure::Request::Priority::High:
+        if (priority.urgency > 0)
+            --priority.urgency;
+        break;
+    case Infrastructure::Request::Priority::Low:
+        if (priority.urgency < HTTP::Priority::LOWEST_URGENCY)
+            ++priority.urgency;
+        break;
+    case Infrastructure::Request::Priority::Auto:
+        break;
+    }
+
+    return priority;
+}
+
 // https://fetch.spec.whatwg.org/#concept-fetch
 GC::Ref<Infrastructure::FetchController> fetch(JS::Realm& realm, Infrastructure::Request& request, Infrastructure::FetchAlgorithms const& algorithms, UseParallelQueue use_parallel_queue)
 {
@@ -341,6 +408,8 @@ GC::Ref<Infrastructure::FetchController> fetch(JS::Realm& realm, Infrastructure:
     //     implementation-defined object.
     // NOTE: The user-agent-defined object could encompass stream weight and dependency for HTTP/2, and equivalent
     //       information used to prioritize dispatch and processing of HTTP/1 fetches.
+    if (!request.internal_priority().has_value())
+        request.set_internal_priority(compute_internal_priority(request));
 
     // 14. If request is a subresource request, then:
     if (request.is_subresource_request()) {
@@ -1892,12 +1961,39 @@ GC::Ref<PendingResponse> http_network_or_cache_fetch(JS::Realm& realm, Infrastru
             //    validation, as per the "Constructing Responses from Caches" chapter of HTTP Caching [HTTP-CACHING],
             //    if any.
             // NOTE: As mandated by HTTP, this still takes the `Vary` header into account.
-            stored_response = select_response_from_cache(realm, *http_cache, *http_request);
+            // NB: A stale-while-revalidate response is only selected if we are able to revalidate it below, and the
+            //     cache only asks one request at a time to do so.
+            auto revalidation_type = HTTP::MemoryCache::RevalidationType::None;
+            auto can_revalidate_in_background = http_request->cache_mode() == HTTP::CacheMode::Default && http_request->client();
+            stored_response = select_response_from_cache(realm, *http_cache, *http_request, can_revalidate_in_background ? &revalidation_type : nullptr);
 
             // 2. If storedResponse is non-null, then:
             if (stored_response) {
                 // 1. If cache mode is "default", storedResponse is a stale-while-revalidate response, and httpRequest’s
                 //    client is non-null, then:
+                if (revalidation_type == HTTP::MemoryCache::RevalidationType::StaleWhileRevalidate) {
+                    // 1. Set response to storedResponse.
+                    // 2. Set response’s cache state to "local".
+                    // NB: These steps are shared with fresh responses below.
+
+                    // 3. Let revalidateRequest be a clone of request.
+                    auto revalidate_request = request->clone(realm);
+
+                    // 4. Set revalidateRequest’s cache mode set to "no-cache".
+                    revalidate_request->set_cache_mode(HTTP::CacheMode::NoCache);
+
+                    // 5. Set revalidateRequest’s prevent no-cache cache-control header modification flag.
+                    revalidate_request->set_prevent_no_cache_cache_control_header_modification(true);
+
+                    // 6. Set revalidateRequest’s service-workers mode set to "none".
+                    revalidate_request->set_service_workers_mode(Infrastructure::Request::ServiceWorkersMode::None);
+
+                    // 7. In parallel, run main fetch given a new fetch params whose request is revalidateRequest.
+                    // NB: We run the full fetch algorithm, which sets up the new fetch params' task destination and timing
+                    //     info for us. Its response replaces storedResponse in the cache once it has been received.
+                    (void)fetch(realm, *revalidate_request, *Infrastructure::FetchAlgorithms::create(vm, {}));
+                }
+
                 // 2. Otherwise:
                 //     1. If storedResponse is a stale response, then set the revalidatingFlag.
                 //     2. If the revalidatingFlag is set and httpRequest’s cache mode is neither "force-cache" nor
@@ -1908,7 +2004,8 @@ GC::Ref<PendingResponse> http_network_or_cache_fetch(JS::Realm& realm, Infrastru
                 //            `Last-Modified`'s value) to httpRequest’s header list.
                 //     3. Otherwise, set response to storedResponse and set response’s cache state to "local".
 
-                // NB: We only cache fresh responses in WebContent. Revalidation is handled by RequestServer.
+                // NB: We only cache fresh and stale-while-revalidate responses in WebContent. Revalidation is otherwise
+                //     handled by RequestServer.
                 response = stored_response;
                 response->set_cache_state(Infrastructure::Response::CacheState::Local);
             }
@@ -2202,8 +2299,12 @@ GC::Ref<PendingResponse> nonstandard_resource_loader_file_or_http_network_fetch(
     load_request.set_referrer_policy(request->referrer_policy());
     load_request.set_is_navigation_request(request->is_navigation_request());
     load_request.set_priority(request->priority());
+    load_request.set_internal_priority(request->internal_priority().value_or({}));
     load_request.set_source_url(content_blocker_source_url_for_request(*request));
 
+    if (auto partition_key = Infrastructure::determine_the_network_partition_key(*request); partition_key.has_value())
+        load_request.set_network_partition(partition_key->serialized_top_level_site());
+
     if (auto const* body = request->body().get_pointer<GC::Ref<Infrastructure::Body>>()) {
         (*body)->source().visit(
             [&](ByteBuffer const& byte_buffer) {
@@ -2240,10 +2341,11 @@ GC::Ref<PendingResponse> nonstandard_resource_loader_file_or_http_network_fetch(
     auto fetched_data_receiver = realm.create<FetchedDataReceiver>(fetch_params, stream, move(http_cache));
 
     // 11. Let pullAlgorithm be the following steps:
-    auto pull_algorithm = GC::create_function(realm.heap(), [&realm]() {
+    auto pull_algorithm = GC::create_function(realm.heap(), [&realm, fetched_data_receiver]() {
         // 1. Let promise be a new promise.
         // 2. Run the following steps in parallel:
         // NOTE: This is handled by FetchedDataReceiver, which pushes bytes into the controller as they arrive.
+        fetched_data_receiver->handle_pull();
 
         // 3. Return promise.
         return WebIDL::create_resolved_promise(realm, JS::js_undefined());
@@ -2338,6 +2440,29 @@ GC::Ref<PendingResponse> nonstandard_resource_loader_file_or_http_network_fetch(
     auto network_request = ResourceLoader::the().load(load_request, on_headers_received, on_data_received, on_cached_body_available, on_complete, keep_alive_for_transfer);
     if (network_request && request->destination() == Infrastructure::Request::Destination::Document)
         network_request->set_body_delivery_paused(true);
+    if (network_request)
+        fetched_data_receiver->set_network_request(*network_request);
+
+    // https://fetch.spec.whatwg.org/#http-network-fetch
+    // If response's status is 103 and fetchParams's process early hints response is non-null, then queue a fetch task
+    // to run fetchParams's process early hints response, with response.
+    if (network_request && fetch_params.algorithms()->process_early_hints_response()) {
+        auto on_early_hints_received = GC::create_function(vm.heap(), [&vm, fetch_params = GC::Ref { fetch_params }, request](NonnullRefPtr<HTTP::HeaderList> response_headers) {
+            auto response = Infrastructure::Response::create(vm);
+            response->set_status(103);
+            response->set_url_list({ request->current_url() });
+            for (auto const& [name, value] : response_headers->headers())
+                response->header_list()->append({ name, value });
+
+            Infrastructure::queue_fetch_task(fetch_params->controller(), fetch_params->task_destination(), GC::create_function(vm.heap(), [fetch_params, response] {
+                fetch_params->algorithms()->process_early_hints_response()(response);
+            }));
+        });
+
+        network_request->on_early_hints_received = [on_early_hints_received = GC::make_root(on_early_hints_received)](NonnullRefPtr<HTTP::HeaderList> response_headers) {
+            on_early_hints_received->function()(move(response_headers));
+        };
+    }
     fetch_params.controller()->set_pending_request(network_request);
 
     return pending_response;
@@ -2668,6 +2793,11 @@ void clear_http_memory_cache()
     HTTPCache::the().clear_cache();
 }
 
+HTTPMemoryCacheSize http_memory_cache_size()
+{
+    return HTTPCache::the().size();
+}
+
 void update_javascript_bytecode_cache_in_http_memory_cache(Infrastructure::NetworkPartitionKey const& partition_key, URL::URL const& url, ByteString const& method, HTTP::HeaderList const& request_headers, u64 vary_key, Core::ImmutableBytes javascript_bytecode_cache)
 {
     if (!g_http_memory_cache_enabled)
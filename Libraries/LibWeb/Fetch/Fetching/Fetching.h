@@ -63,6 +63,12 @@ void append_fetch_metadata_headers_for_request(Infrastructure::Request&);
 WEB_API void set_http_memory_cache_enabled(bool enabled);
 WEB_API bool http_memory_cache_enabled();
 WEB_API void clear_http_memory_cache();
+
+struct HTTPMemoryCacheSize {
+    u64 bytes { 0 };
+    size_t partition_count { 0 };
+};
+WEB_API HTTPMemoryCacheSize http_memory_cache_size();
 void update_javascript_bytecode_cache_in_http_memory_cache(Infrastructure::NetworkPartitionKey const&, URL::URL const&, ByteString const& method, HTTP::HeaderList const& request_headers, u64 vary_key, Core::ImmutableBytes);
 
 }
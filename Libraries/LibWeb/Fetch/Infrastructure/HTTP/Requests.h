@@ -21,6 +21,7 @@
 #include <LibGC/Ptr.h>
 #include <LibHTTP/Cache/CacheMode.h>
 #include <LibHTTP/HeaderList.h>
+#include <LibHTTP/Priority.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibURL/Origin.h>
@@ -155,8 +156,9 @@ public:
         Auto
     };
 
-    // Members are implementation-defined
-    struct InternalPriority { };
+    // NB: Requests are prioritized with the HTTP extensible priority scheme (RFC 9218), which RequestServer signals to
+    //     servers that support it.
+    using InternalPriority = HTTP::Priority;
 
     using BodyType = Variant<Empty, ByteBuffer, GC::Ref<Body>>;
     using OriginType = Variant<Origin, URL::Origin>;
@@ -215,6 +217,9 @@ public:
     [[nodiscard]] Priority const& priority() const { return m_priority; }
     void set_priority(Priority priority) { m_priority = priority; }
 
+    [[nodiscard]] Optional<InternalPriority> const& internal_priority() const { return m_internal_priority; }
+    void set_internal_priority(Optional<InternalPriority> internal_priority) { m_internal_priority = internal_priority; }
+
     [[nodiscard]] OriginType const& origin() const { return m_origin; }
     void set_origin(OriginType origin) { m_origin = move(origin); }
 
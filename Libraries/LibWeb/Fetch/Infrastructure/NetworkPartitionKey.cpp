@@ -4,11 +4,19 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibURL/Site.h>
 #include <LibWeb/Fetch/Infrastructure/NetworkPartitionKey.h>
 #include <LibWeb/Fetch/Request.h>
 
 namespace Web::Fetch::Infrastructure {
 
+Optional<ByteString> NetworkPartitionKey::serialized_top_level_site() const
+{
+    if (top_level_origin.is_opaque())
+        return {};
+    return URL::Site::obtain(top_level_origin).serialize().to_byte_string();
+}
+
 // https://fetch.spec.whatwg.org/#determine-the-network-partition-key
 NetworkPartitionKey determine_the_network_partition_key(HTML::Environment const& environment)
 {
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
 #include <LibURL/Origin.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/Forward.h>
@@ -19,6 +21,10 @@ struct NetworkPartitionKey {
     //     This is the document origin in other browsers
     void* second_key = nullptr;
 
+    // Caches that are shared with other processes are partitioned by this, so that whether an entry exists cannot be
+    // used to tell which other sites have been visited. Opaque top-level origins have no site to partition by.
+    Optional<ByteString> serialized_top_level_site() const;
+
     bool operator==(NetworkPartitionKey const&) const = default;
 };
 
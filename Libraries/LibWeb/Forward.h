@@ -43,8 +43,12 @@ AK_TYPEDEF_DISTINCT_NUMERIC_GENERAL(i64, UniqueNodeID, Comparison, Increment, Ca
 
 namespace Web::Compositor {
 
+struct CompositorAnimation;
 class CompositorContextHandle;
 class CompositorHost;
+class FrameScheduler;
+class FrameTimeline;
+struct FrameTiming;
 
 }
 
@@ -58,6 +62,7 @@ class ChromeWidget;
 class CanvasSurfaceRegistry;
 class DevicePixelConverter;
 class DisplayList;
+struct DisplayListDelta;
 class DisplayListPlayerSkia;
 class DisplayListRecorder;
 class DisplayListResourceStorage;
@@ -558,6 +563,7 @@ class DOMTokenList;
 class EditingHostManager;
 class Element;
 class ElementByIdMap;
+class ElementIndex;
 class Event;
 class EventHandler;
 class EventTarget;
@@ -708,6 +714,7 @@ class AnimationFrameCallbackDriver;
 class AudioTrack;
 class AudioTrackList;
 class AutoplaySettings;
+class BackForwardCache;
 class BarProp;
 class BeforeUnloadEvent;
 class BroadcastChannel;
@@ -1182,6 +1189,7 @@ struct PullIntoDescriptor;
 
 namespace Web::StorageAPI {
 
+class LocalStorageArea;
 class NavigatorStorage;
 class StorageBottle;
 class StorageBucket;
@@ -1189,6 +1197,7 @@ class StorageManager;
 class StorageShed;
 class StorageShelf;
 
+struct LocalStorageAreaSnapshot;
 struct StorageEndpoint;
 
 }
@@ -1450,6 +1459,8 @@ class TrustedTypePolicyFactory;
 
 namespace Web::XPath {
 
+class CompiledExpression;
+class MirroredTree;
 class XPathEvaluator;
 class XPathExpression;
 class XPathNSResolver;
@@ -74,8 +74,8 @@ GC::Ref<AnimatedBitmapDecodedImageData> AnimatedBitmapDecodedImageData::create(
         session_id, frame_count, loop_count, size, move(color_space), move(durations), animation_timer, document_observer);
 
     // Place initial bitmaps into the buffer pool.
-    for (u32 i = 0; i < initial_bitmaps.size(); ++i) {
-        auto& slot = data->m_buffer_slots[i % BUFFER_POOL_SIZE];
+    for (u32 i = 0; i < min(initial_bitmaps.size(), data->m_buffer_pool_capacity); ++i) {
+        auto& slot = data->m_buffer_slots[i];
         slot.frame_index = i;
         slot.frame = Gfx::DecodedImageFrame { *initial_bitmaps[i], data->m_color_space };
         slot.generation = ++data->m_write_generation;
@@ -106,6 +106,7 @@ AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(
     , m_size(size)
     , m_color_space(move(color_space))
     , m_durations(move(durations))
+    , m_buffer_pool_capacity(buffer_pool_capacity_for_frame_size(size))
     , m_animation_timer(animation_timer)
 {
     m_animation_timer->on_timeout = GC::create_function(vm().heap(), [weak_this = GC::Weak { *this }] {
@@ -160,6 +161,9 @@ void AnimatedBitmapDecodedImageData::start_animation()
     VERIFY(m_current_frame_index == 0 && m_loops_completed == 0);
 
     m_animation_timer->start(frame_duration(0));
+
+    // Only the first frame is decoded up front, so start filling the pool while it is being shown.
+    maybe_request_more_frames(m_current_frame_index);
 }
 
 void AnimatedBitmapDecodedImageData::stop_animation()
@@ -185,9 +189,18 @@ void AnimatedBitmapDecodedImageData::advance_animation()
     notify_clients_did_update();
 }
 
+u32 AnimatedBitmapDecodedImageData::buffer_pool_capacity_for_frame_size(Gfx::IntSize size)
+{
+    // Decoded frames are 32-bit BGRA bitmaps.
+    auto frame_size_in_bytes = static_cast<size_t>(max(size.width(), 1)) * static_cast<size_t>(max(size.height(), 1)) * sizeof(u32);
+    auto capacity = BUFFER_POOL_MEMORY_LIMIT / frame_size_in_bytes;
+    return static_cast<u32>(clamp(capacity, MIN_BUFFER_POOL_SIZE, BUFFER_POOL_SIZE));
+}
+
 AnimatedBitmapDecodedImageData::BufferSlot const* AnimatedBitmapDecodedImageData::find_slot(u32 frame_index) const
 {
-    for (auto const& slot : m_buffer_slots) {
+    for (u32 i = 0; i < m_buffer_pool_capacity; ++i) {
+        auto const& slot = m_buffer_slots[i];
         if (slot.frame_index == frame_index && slot.frame.has_value())
             return &slot;
     }
@@ -197,7 +210,8 @@ AnimatedBitmapDecodedImageData::BufferSlot const* AnimatedBitmapDecodedImageData
 AnimatedBitmapDecodedImageData::BufferSlot& AnimatedBitmapDecodedImageData::evict_oldest_slot()
 {
     BufferSlot* oldest = &m_buffer_slots[0];
-    for (auto& slot : m_buffer_slots) {
+    for (u32 i = 0; i < m_buffer_pool_capacity; ++i) {
+        auto& slot = m_buffer_slots[i];
         if (slot.generation < oldest->generation)
             oldest = &slot;
     }
@@ -294,7 +308,7 @@ void AnimatedBitmapDecodedImageData::maybe_request_more_frames(size_t current_fr
 
     // Count how many frames ahead of current are in the pool.
     u32 frames_ahead = 0;
-    for (u32 offset = 1; offset <= BUFFER_POOL_SIZE; ++offset) {
+    for (u32 offset = 1; offset <= m_buffer_pool_capacity; ++offset) {
         u32 future_index = (current_frame_index + offset) % m_frame_count;
         if (find_slot(future_index))
             ++frames_ahead;
@@ -304,12 +318,12 @@ void AnimatedBitmapDecodedImageData::maybe_request_more_frames(size_t current_fr
 
     // Request more when buffer is less than half full, giving the decoder
     // time to respond while we still have frames to display.
-    if (frames_ahead >= REQUEST_BATCH_SIZE)
+    if (frames_ahead >= request_batch_size())
         return;
 
     // Determine which frame to request from.
     u32 request_start = (current_frame_index + frames_ahead + 1) % m_frame_count;
-    u32 request_count = REQUEST_BATCH_SIZE;
+    u32 request_count = request_batch_size();
 
     m_request_in_flight = true;
     m_last_requested_start_frame = request_start;
@@ -59,8 +59,11 @@ public:
 private:
     static HashMap<i64, GC::RawPtr<AnimatedBitmapDecodedImageData>>& session_registry();
 
+    // Decoded frames are kept in a small pool that is refilled just in time, rather than keeping every frame around.
+    // Large frames get fewer slots, so that the pool stays within its memory limit.
     static constexpr u32 BUFFER_POOL_SIZE = 8;
-    static constexpr u32 REQUEST_BATCH_SIZE = 4;
+    static constexpr u32 MIN_BUFFER_POOL_SIZE = 2;
+    static constexpr size_t BUFFER_POOL_MEMORY_LIMIT = 32 * MiB;
 
     struct BufferSlot {
         Optional<u32> frame_index;
@@ -90,6 +93,9 @@ private:
     int frame_duration(size_t frame_index) const;
     Optional<Gfx::DecodedImageFrame> frame(size_t frame_index, Gfx::IntSize = {}) const;
 
+    static u32 buffer_pool_capacity_for_frame_size(Gfx::IntSize);
+    u32 request_batch_size() const { return max(1u, m_buffer_pool_capacity / 2); }
+
     BufferSlot const* find_slot(u32 frame_index) const;
     BufferSlot& evict_oldest_slot();
     void maybe_request_more_frames(size_t current_frame_index);
@@ -102,6 +108,7 @@ private:
     Vector<u32> m_durations;
 
     Array<BufferSlot, BUFFER_POOL_SIZE> m_buffer_slots;
+    u32 m_buffer_pool_capacity { BUFFER_POOL_SIZE };
     mutable Optional<Gfx::DecodedImageFrame> m_last_displayed_frame;
     u64 m_write_generation { 0 };
     bool m_request_in_flight { false };
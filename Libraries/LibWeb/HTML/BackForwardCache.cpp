@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/BackForwardCache.h>
+#include <LibWeb/HTML/DocumentReadyState.h>
+#include <LibWeb/HTML/DocumentState.h>
+#include <LibWeb/HTML/EventNames.h>
+#include <LibWeb/HTML/LocalTraversableNavigable.h>
+#include <LibWeb/HTML/SessionHistoryEntry.h>
+#include <LibWeb/HTML/Window.h>
+
+namespace Web::HTML {
+
+BackForwardCache& BackForwardCache::the()
+{
+    static auto& cache = *new BackForwardCache;
+    return cache;
+}
+
+BackForwardCache::BackForwardCache() = default;
+
+template<typename Callback>
+void BackForwardCache::evict_matching(Callback callback)
+{
+    // NB: Destroying a document can run arbitrary cleanup steps, so the entries are removed before any of them is.
+    Vector<GC::Root<DOM::Document>> evicted_documents;
+    m_entries.remove_all_matching([&](Entry& entry) {
+        if (!callback(entry))
+            return false;
+        evicted_documents.append(move(entry.document));
+        return true;
+    });
+
+    for (auto& document : evicted_documents)
+        document->destroy();
+}
+
+bool BackForwardCache::can_store(DOM::Document const& document) const
+{
+    // NB: Only top-level documents without any child navigables are cached, so that nested session histories never
+    //     have to be kept in sync with a reactivated document.
+    auto navigable = document.navigable();
+    if (!navigable || !navigable->is_top_level_traversable())
+        return false;
+    if (!navigable->child_navigables().is_empty())
+        return false;
+
+    if (document.is_initial_about_blank())
+        return false;
+    if (!document.url().scheme().is_one_of("http"sv, "https"sv, "file"sv))
+        return false;
+
+    // NB: Documents that are still loading would have to resume loading when reactivated.
+    if (document.readiness() != DocumentReadyState::Complete)
+        return false;
+
+    auto const& window = as<Window>(relevant_global_object(document));
+
+    // NB: A document with unload handlers expects them to run when it's navigated away from, which they would not if
+    //     the document were kept alive.
+    if (window.has_event_listener(EventNames::unload))
+        return false;
+
+    // NB: An open event source keeps receiving messages that the document could not handle until it's reactivated.
+    if (window.has_open_event_sources())
+        return false;
+
+    return true;
+}
+
+void BackForwardCache::store(DOM::Document& document)
+{
+    VERIFY(document.salvageable());
+
+    auto traversable = document.navigable()->traversable_navigable();
+    VERIFY(traversable);
+
+    // NB: Documents whose entries have since been replaced (e.g. by a reload) can no longer be traversed to.
+    evict_documents_not_in_session_history_of(*traversable);
+
+    m_entries.append({ document, *traversable });
+
+    while (m_entries.size() > maximum_document_count) {
+        auto entry = m_entries.take_first();
+        entry.document->destroy();
+    }
+}
+
+GC::Ptr<DOM::Document> BackForwardCache::take(UniqueNodeID document_id, LocalTraversableNavigable const& traversable, SessionHistoryEntry const& entry)
+{
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto& cached_entry = m_entries[i];
+        if (cached_entry.document->unique_id() != document_id || cached_entry.traversable.ptr() != &traversable)
+            continue;
+
+        // NB: The document can only be reactivated for the entry it was unloaded from.
+        if (cached_entry.document->latest_entry().ptr() != &entry)
+            return nullptr;
+
+        GC::Ptr<DOM::Document> document = cached_entry.document.ptr();
+        m_entries.remove(i);
+        return document;
+    }
+
+    return nullptr;
+}
+
+void BackForwardCache::evict_documents_for(LocalTraversableNavigable const& traversable)
+{
+    evict_matching([&](Entry const& entry) {
+        return !entry.traversable || entry.traversable.ptr() == &traversable;
+    });
+}
+
+void BackForwardCache::evict_documents_not_in_session_history_of(LocalTraversableNavigable const& traversable)
+{
+    evict_matching([&](Entry const& entry) {
+        if (!entry.traversable)
+            return true;
+        if (entry.traversable.ptr() != &traversable)
+            return false;
+
+        auto document_id = entry.document->unique_id();
+        return !any_of(traversable.session_history_entries(), [&](auto const& history_entry) {
+            return history_entry->document_state()->document_id() == document_id;
+        });
+    });
+}
+
+void BackForwardCache::evict_all()
+{
+    evict_matching([](Entry const&) { return true; });
+}
+
+}
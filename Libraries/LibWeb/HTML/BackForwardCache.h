@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Vector.h>
+#include <LibGC/Root.h>
+#include <LibGC/Weak.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// Keeps unloaded documents alive so that history traversal can reactivate them instead of fetching and parsing them
+// again. Session history entries only refer to their document by ID, so the cache is what keeps a salvageable
+// document alive once it has been unloaded. There is one cache per WebContent process, which bounds how many such
+// documents the process holds on to at once.
+// https://html.spec.whatwg.org/multipage/document-lifecycle.html#unloading-documents
+class WEB_API BackForwardCache {
+public:
+    static BackForwardCache& the();
+
+    // NB: A cached document retains its whole DOM, layout-independent style state, and JavaScript heap, which we have
+    //     no cheap way of measuring. The budget is therefore expressed as a number of documents.
+    static constexpr size_t maximum_document_count = 4;
+
+    // Whether document, which is still the active document of its navigable, may be kept alive after being unloaded.
+    bool can_store(DOM::Document const&) const;
+
+    void store(DOM::Document&);
+    GC::Ptr<DOM::Document> take(UniqueNodeID, LocalTraversableNavigable const&, SessionHistoryEntry const&);
+
+    void evict_documents_for(LocalTraversableNavigable const&);
+    void evict_documents_not_in_session_history_of(LocalTraversableNavigable const&);
+    void evict_all();
+
+    size_t document_count() const { return m_entries.size(); }
+
+private:
+    BackForwardCache();
+
+    struct Entry {
+        GC::Root<DOM::Document> document;
+        GC::Weak<LocalTraversableNavigable> traversable;
+    };
+
+    template<typename Callback>
+    void evict_matching(Callback);
+
+    // Ordered from least to most recently stored.
+    Vector<Entry> m_entries;
+};
+
+}
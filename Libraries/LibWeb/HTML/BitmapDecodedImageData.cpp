@@ -5,65 +5,144 @@
  */
 
 #include <LibGC/Heap.h>
+#include <LibGC/Weak.h>
 #include <LibGfx/Bitmap.h>
 #include <LibJS/Runtime/ExternalMemory.h>
 #include <LibJS/Runtime/Realm.h>
 #include <LibWeb/CSS/ComputedValues.h>
 #include <LibWeb/HTML/BitmapDecodedImageData.h>
+#include <LibWeb/HTML/DiscardableImageCache.h>
 #include <LibWeb/Painting/DisplayListRecorder.h>
 #include <LibWeb/Painting/DisplayListRecordingContext.h>
+#include <LibWeb/Platform/ImageCodecPlugin.h>
 
 namespace Web::HTML {
 
 GC_DEFINE_ALLOCATOR(BitmapDecodedImageData);
 
-GC::Ref<BitmapDecodedImageData> BitmapDecodedImageData::create(JS::Realm& realm, Gfx::DecodedImageFrame&& frame)
+GC::Ref<BitmapDecodedImageData> BitmapDecodedImageData::create(JS::Realm& realm, Gfx::DecodedImageFrame&& frame, ByteBuffer encoded_data, Optional<ByteString> decode_cache_partition)
 {
-    return realm.create<BitmapDecodedImageData>(move(frame));
+    return realm.create<BitmapDecodedImageData>(move(frame), move(encoded_data), move(decode_cache_partition));
 }
 
-BitmapDecodedImageData::BitmapDecodedImageData(Gfx::DecodedImageFrame&& frame)
+BitmapDecodedImageData::BitmapDecodedImageData(Gfx::DecodedImageFrame&& frame, ByteBuffer encoded_data, Optional<ByteString> decode_cache_partition)
     : m_frame(move(frame))
+    , m_size(m_frame->size())
+    , m_encoded_data(move(encoded_data))
+    , m_decode_cache_partition(move(decode_cache_partition))
 {
+    if (!m_encoded_data.is_empty())
+        DiscardableImageCache::the().did_decode(*this);
 }
 
-BitmapDecodedImageData::~BitmapDecodedImageData() = default;
+BitmapDecodedImageData::~BitmapDecodedImageData()
+{
+    DiscardableImageCache::the().remove(*this);
+}
 
 size_t BitmapDecodedImageData::external_memory_size() const
 {
-    return m_frame.bitmap().data_size();
+    auto size = m_encoded_data.size();
+    if (m_frame.has_value())
+        size += m_frame->bitmap().data_size();
+    return size;
 }
 
-Optional<Gfx::DecodedImageFrame> BitmapDecodedImageData::current_frame(Gfx::IntSize) const
+Optional<Gfx::DecodedImageFrame> BitmapDecodedImageData::use_frame() const
 {
+    // NB: Keeping track of whether the pixels are in use doesn't change what the image is, so it's allowed from the
+    //     const getters.
+    auto& self = const_cast<BitmapDecodedImageData&>(*this);
+
+    // NB: Only images that script can't read are discarded, and one that script starts reading is decoded again right
+    //     away, see on_client_registered(). Painting picks the image up once its clients are told that it's back.
+    if (!m_frame.has_value()) {
+        self.decode_again();
+        return {};
+    }
+
+    DiscardableImageCache::the().did_use(self);
     return m_frame;
 }
 
+void BitmapDecodedImageData::on_client_registered()
+{
+    // An element that script can read the pixels through started using an image that was discarded while nothing else
+    // could. Bring it back right away, as it won't be discarded again.
+    if (!m_frame.has_value() && has_clients_that_expose_pixels_to_script())
+        decode_again();
+}
+
+void BitmapDecodedImageData::discard_frame()
+{
+    VERIFY(!m_encoded_data.is_empty());
+    m_frame.clear();
+    m_has_been_discarded = true;
+}
+
+void BitmapDecodedImageData::decode_again()
+{
+    if (m_is_decoding_again)
+        return;
+    m_is_decoding_again = true;
+
+    auto on_decoded = [weak_this = GC::Weak { *this }](Platform::DecodedImage& result) -> ErrorOr<void> {
+        auto self = weak_this.ptr();
+        if (!self)
+            return {};
+        self->m_is_decoding_again = false;
+
+        if (result.frames.size() != 1 || !result.frames[0].bitmap)
+            return Error::from_string_literal("Image decoded to a different number of frames");
+
+        self->m_frame = Gfx::DecodedImageFrame { *result.frames[0].bitmap, move(result.color_space) };
+        DiscardableImageCache::the().did_decode(*self);
+        self->notify_clients_did_update();
+        return {};
+    };
+    auto on_failed = [weak_this = GC::Weak { *this }](Error& error) {
+        dbgln("BitmapDecodedImageData: Failed to decode discarded image again: {}", error);
+        if (auto self = weak_this.ptr())
+            self->m_is_decoding_again = false;
+    };
+
+    (void)Platform::ImageCodecPlugin::the().decode_image(m_encoded_data.bytes(), move(on_decoded), move(on_failed), m_decode_cache_partition);
+}
+
+Optional<Gfx::DecodedImageFrame> BitmapDecodedImageData::current_frame(Gfx::IntSize) const
+{
+    return use_frame();
+}
+
 Optional<Gfx::DecodedImageFrame> BitmapDecodedImageData::default_frame(Gfx::IntSize) const
 {
-    return m_frame;
+    return use_frame();
 }
 
 Optional<CSSPixels> BitmapDecodedImageData::intrinsic_width() const
 {
-    return m_frame.width();
+    return m_size.width();
 }
 
 Optional<CSSPixels> BitmapDecodedImageData::intrinsic_height() const
 {
-    return m_frame.height();
+    return m_size.height();
 }
 
 Optional<CSSPixelFraction> BitmapDecodedImageData::intrinsic_aspect_ratio() const
 {
-    return CSSPixels(m_frame.width()) / CSSPixels(m_frame.height());
+    return CSSPixels(m_size.width()) / CSSPixels(m_size.height());
 }
 
 void BitmapDecodedImageData::paint(DisplayListRecordingContext& context, Gfx::IntRect dst_rect, CSS::ImageRendering image_rendering) const
 {
-    auto scaling_mode = CSS::to_gfx_scaling_mode(image_rendering, m_frame.size(), dst_rect.size());
+    auto frame = use_frame();
+    if (!frame.has_value())
+        return;
+
+    auto scaling_mode = CSS::to_gfx_scaling_mode(image_rendering, frame->size(), dst_rect.size());
 
-    context.display_list_recorder().draw_scaled_decoded_image_frame(dst_rect, m_frame, scaling_mode);
+    context.display_list_recorder().draw_scaled_decoded_image_frame(dst_rect, *frame, scaling_mode);
 }
 
 }
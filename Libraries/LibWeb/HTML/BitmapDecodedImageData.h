@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/IntrusiveList.h>
+#include <AK/Time.h>
 #include <LibGfx/DecodedImageFrame.h>
 #include <LibGfx/Forward.h>
 #include <LibWeb/HTML/DecodedImageData.h>
@@ -17,7 +21,9 @@ class BitmapDecodedImageData final : public DecodedImageData {
     GC_DECLARE_ALLOCATOR(BitmapDecodedImageData);
 
 public:
-    static GC::Ref<BitmapDecodedImageData> create(JS::Realm&, Gfx::DecodedImageFrame&& frame);
+    // If encoded_data is given, the decoded bitmap may be discarded while it's unused, and decoded again from the
+    // encoded data once it's needed, with the same decode cache partition as before. See DiscardableImageCache.
+    static GC::Ref<BitmapDecodedImageData> create(JS::Realm&, Gfx::DecodedImageFrame&& frame, ByteBuffer encoded_data = {}, Optional<ByteString> decode_cache_partition = {});
     virtual ~BitmapDecodedImageData() override;
 
     virtual Optional<Gfx::DecodedImageFrame> default_frame(Gfx::IntSize = {}) const override;
@@ -30,11 +36,26 @@ public:
     virtual void paint(DisplayListRecordingContext&, Gfx::IntRect dst_rect, CSS::ImageRendering) const override;
 
 private:
-    BitmapDecodedImageData(Gfx::DecodedImageFrame&& frame);
+    friend class DiscardableImageCache;
+
+    BitmapDecodedImageData(Gfx::DecodedImageFrame&& frame, ByteBuffer encoded_data, Optional<ByteString> decode_cache_partition);
 
     virtual size_t external_memory_size() const override;
+    virtual void on_client_registered() override;
+
+    Optional<Gfx::DecodedImageFrame> use_frame() const;
+    void discard_frame();
+    void decode_again();
+
+    Optional<Gfx::DecodedImageFrame> m_frame;
+    Gfx::IntSize m_size;
 
-    Gfx::DecodedImageFrame m_frame;
+    ByteBuffer m_encoded_data;
+    Optional<ByteString> m_decode_cache_partition;
+    bool m_has_been_discarded { false };
+    bool m_is_decoding_again { false };
+    MonotonicTime m_last_used_time { MonotonicTime::now() };
+    IntrusiveListNode<BitmapDecodedImageData> m_discardable_image_cache_list_node;
 };
 
 }
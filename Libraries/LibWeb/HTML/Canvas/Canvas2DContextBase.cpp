@@ -17,7 +17,6 @@
 #include <LibGfx/CanvasCommandList.h>
 #include <LibGfx/CompositingAndBlendingOperator.h>
 #include <LibGfx/DecodedImageFrame.h>
-#include <LibGfx/Painter.h>
 #include <LibGfx/PaintingSurface.h>
 #include <LibGfx/Rect.h>
 #include <LibJS/Runtime/ExternalMemory.h>
@@ -719,23 +718,19 @@ WebIDL::ExceptionOr<GC::Ptr<ImageData>> Canvas2DContextBase::get_image_data(int
     if (source_rect_intersected.is_empty())
         return image_data;
 
-    // NOTE: If reading back from the Compositor fails (no backing storage or no connection),
-    //       it's like copying only transparent black pixels (which is a no-op).
-    auto pixels = read_pixels(source_rect_intersected);
-    if (!pixels)
-        return image_data;
-    auto const snapshot = Gfx::DecodedImageFrame { *pixels };
-
     // 6. Set the pixel values of imageData to be the pixels of this's output bitmap in the area specified by the source rectangle in the bitmap's coordinate space units, converted from this's color space to imageData's colorSpace using 'relative-colorimetric' rendering intent.
     // NOTE: Internally we must use premultiplied alpha, but ImageData should hold unpremultiplied alpha. This conversion
     //       might result in a loss of precision, but is according to spec.
     //       See: https://html.spec.whatwg.org/multipage/canvas.html#premultiplied-alpha-and-the-2d-rendering-context
+    // NOTE: The Compositor converts the pixels while reading them back, so they only need to be copied into place here.
+    //       If reading back fails (no backing storage or no connection), it's like copying only transparent black
+    //       pixels (which is a no-op).
     auto image_data_bitmap = TRY_OR_THROW_OOM(realm().vm(), image_data->bitmap());
-    VERIFY(snapshot.bitmap().alpha_type() == Gfx::AlphaType::Premultiplied);
     VERIFY(image_data_bitmap->alpha_type() == Gfx::AlphaType::Unpremultiplied);
-
-    auto painter = Gfx::Painter::create(*image_data_bitmap);
-    painter->draw_bitmap(image_data_bitmap->rect().to_type<float>(), snapshot, snapshot.rect(), Gfx::ScalingMode::NearestNeighbor, {}, 1, Gfx::CompositingAndBlendingOperator::SourceOver);
+    if (has_backing_storage()) {
+        m_transport->flush_shared_stream();
+        (void)m_transport->read_back_unpremultiplied_pixels(source_rect_intersected, *image_data_bitmap, source_rect_intersected.location() - source_rect.location());
+    }
 
     // 7. Set the pixels values of imageData for areas of the source rectangle that are outside of the output bitmap to transparent black.
     // NOTE: No-op, already done during creation.
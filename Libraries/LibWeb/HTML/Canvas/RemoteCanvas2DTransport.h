@@ -28,6 +28,10 @@ public:
     virtual void flush_shared_stream() = 0;
 
     virtual RefPtr<Gfx::Bitmap> read_back_pixels(Gfx::IntRect const&) = 0;
+
+    // Copies the pixels inside the rect into an unpremultiplied RGBA bitmap, such as the one backing an ImageData,
+    // with the top left pixel of the rect ending up at destination_position.
+    virtual bool read_back_unpremultiplied_pixels(Gfx::IntRect const&, Gfx::Bitmap& destination, Gfx::IntPoint destination_position) = 0;
 };
 
 }
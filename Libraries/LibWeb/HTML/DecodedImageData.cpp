@@ -33,6 +33,15 @@ void DecodedImageData::Client::unregister_with_decoded_image_data_if_needed()
 
 DecodedImageData::DecodedImageData() = default;
 
+bool DecodedImageData::has_clients_that_expose_pixels_to_script() const
+{
+    for (auto* client : m_clients) {
+        if (client->exposes_pixels_to_script())
+            return true;
+    }
+    return false;
+}
+
 DecodedImageData::~DecodedImageData() = default;
 
 Optional<Painting::DisplayListResource> DecodedImageData::record_display_list(Gfx::IntSize, Painting::DisplayListResourceStorage&) const
@@ -29,6 +29,10 @@ public:
         virtual GC::Ptr<DecodedImageData> decoded_image_data() const = 0;
         virtual void decoded_image_data_did_update() = 0;
 
+        // Whether script can read the pixels through this client synchronously, like CanvasRenderingContext2D.drawImage()
+        // does. Images with such clients are never discarded, see DiscardableImageCache.
+        virtual bool exposes_pixels_to_script() const { return false; }
+
     protected:
         void register_with_decoded_image_data_if_needed();
         void unregister_with_decoded_image_data_if_needed();
@@ -52,6 +56,7 @@ public:
     virtual Optional<CSSPixelFraction> intrinsic_aspect_ratio() const = 0;
 
     bool has_clients() const { return !m_clients.is_empty(); }
+    bool has_clients_that_expose_pixels_to_script() const;
 
 protected:
     DecodedImageData();
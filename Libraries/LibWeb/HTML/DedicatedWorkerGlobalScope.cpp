@@ -5,9 +5,11 @@
  */
 
 #include <AK/Math.h>
+#include <LibGC/Weak.h>
 #include <LibWeb/Bindings/DedicatedWorkerExposedInterfaces.h>
 #include <LibWeb/Bindings/DedicatedWorkerGlobalScope.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Compositor/CompositorHost.h>
 #include <LibWeb/HTML/AnimationFrameCallbackDriver.h>
 #include <LibWeb/HTML/DedicatedWorkerGlobalScope.h>
 #include <LibWeb/HTML/EventHandler.h>
@@ -126,21 +128,41 @@ bool DedicatedWorkerGlobalScope::has_animation_frame_callbacks() const
 // The processing model only updates a dedicated worker's rendering when "the user agent
 // believes that it would benefit from having its rendering updated at this time", and notes
 // that "a user agent can determine the rate of rendering in the dedicated worker". Worker
-// event loops have no document-driven rendering, so a single-shot timer paced at the
-// rendering rate of the spawning page (communicated when the worker was started) provides
-// the rendering opportunities while animation frame callbacks or uncommitted
-// OffscreenCanvas frames are pending.
+// event loops have no document-driven rendering, so the rendering opportunities while
+// animation frame callbacks or uncommitted OffscreenCanvas frames are pending come from the
+// compositor's vsync ticks, which the worker's OffscreenCanvas frames are presented on too.
+// Without a compositor, a single-shot timer paced at the rendering rate of the spawning page
+// (communicated when the worker was started) provides them instead.
 // FIXME: The rate is fixed at worker start; propagate display rate changes to running workers.
 void DedicatedWorkerGlobalScope::schedule_rendering_update()
 {
+    if (m_is_waiting_for_vsync_tick)
+        return;
+    if (m_rendering_update_timer && m_rendering_update_timer->is_active())
+        return;
+
+    auto refresh_rate = max(1.0, page()->client().maximum_frames_per_second());
+
+    page()->ensure_compositor_host();
+    if (auto* compositor_host = page()->client().compositor_host()) {
+        auto did_request_vsync_tick = compositor_host->request_vsync_tick(refresh_rate, [weak_this = GC::Weak<DedicatedWorkerGlobalScope> { *this }] {
+            if (!weak_this)
+                return;
+            weak_this->m_is_waiting_for_vsync_tick = false;
+            weak_this->run_rendering_update();
+        });
+        if (did_request_vsync_tick) {
+            m_is_waiting_for_vsync_tick = true;
+            return;
+        }
+    }
+
     if (!m_rendering_update_timer) {
         m_rendering_update_timer = Platform::Timer::create_single_shot(heap(), 0, GC::create_function(heap(), [this] {
             run_rendering_update();
         }));
     }
-    if (m_rendering_update_timer->is_active())
-        return;
-    auto interval_ms = static_cast<int>(AK::ceil(1000.0 / max(1.0, page()->client().maximum_frames_per_second())));
+    auto interval_ms = static_cast<int>(AK::ceil(1000.0 / refresh_rate));
     m_rendering_update_timer->start(interval_ms);
 }
 
@@ -59,6 +59,7 @@ private:
 
     GC::Ptr<AnimationFrameCallbackDriver> m_animation_frame_callback_driver;
     GC::Ptr<Platform::Timer> m_rendering_update_timer;
+    bool m_is_waiting_for_vsync_tick { false };
 };
 
 }
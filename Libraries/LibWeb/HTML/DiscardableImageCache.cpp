@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibWeb/HTML/DiscardableImageCache.h>
+
+namespace Web::HTML {
+
+DiscardableImageCache& DiscardableImageCache::the()
+{
+    static DiscardableImageCache cache;
+    return cache;
+}
+
+void DiscardableImageCache::did_decode(BitmapDecodedImageData& image)
+{
+    VERIFY(!image.m_discardable_image_cache_list_node.is_in_list());
+    VERIFY(image.m_frame.has_value());
+
+    if (image.m_has_been_discarded)
+        ++m_redecoded_image_count;
+
+    image.m_last_used_time = MonotonicTime::now();
+    m_images.append(image);
+    m_decoded_size_in_bytes += image.m_frame->bitmap().data_size();
+    ++m_decoded_image_count;
+
+    discard_until_size_is_at_most(maximum_decoded_size_in_bytes, minimum_unused_time);
+}
+
+void DiscardableImageCache::did_use(BitmapDecodedImageData& image)
+{
+    if (!image.m_discardable_image_cache_list_node.is_in_list())
+        return;
+
+    image.m_last_used_time = MonotonicTime::now();
+    m_images.remove(image);
+    m_images.append(image);
+}
+
+void DiscardableImageCache::remove(BitmapDecodedImageData& image)
+{
+    if (!image.m_discardable_image_cache_list_node.is_in_list())
+        return;
+
+    m_images.remove(image);
+    m_decoded_size_in_bytes -= image.m_frame->bitmap().data_size();
+    --m_decoded_image_count;
+}
+
+void DiscardableImageCache::did_update_rendering()
+{
+    if (m_decoded_size_in_bytes > maximum_decoded_size_in_bytes)
+        discard_until_size_is_at_most(maximum_decoded_size_in_bytes, minimum_unused_time);
+}
+
+void DiscardableImageCache::did_receive_memory_pressure(Core::MemoryPressureLevel level)
+{
+    switch (level) {
+    case Core::MemoryPressureLevel::Normal:
+        break;
+    case Core::MemoryPressureLevel::Warning:
+        discard_until_size_is_at_most(m_decoded_size_in_bytes / 2, minimum_unused_time);
+        break;
+    case Core::MemoryPressureLevel::Critical:
+        discard_until_size_is_at_most(0, {});
+        break;
+    }
+}
+
+DiscardableImageCache::Statistics DiscardableImageCache::statistics() const
+{
+    return {
+        .decoded_size_in_bytes = m_decoded_size_in_bytes,
+        .decoded_image_count = m_decoded_image_count,
+        .discarded_image_count = m_discarded_image_count,
+        .redecoded_image_count = m_redecoded_image_count,
+    };
+}
+
+void DiscardableImageCache::discard_until_size_is_at_most(size_t size_in_bytes, AK::Duration minimum_unused_time)
+{
+    auto now = MonotonicTime::now();
+
+    for (auto it = m_images.begin(); it != m_images.end() && m_decoded_size_in_bytes > size_in_bytes;) {
+        auto& image = *it;
+        ++it;
+
+        // The list is ordered by use, so every image after this one was used recently as well.
+        if (now - image.m_last_used_time < minimum_unused_time)
+            break;
+
+        // NB: Display lists and other users of the pixels hold references to the bitmap. Dropping ours wouldn't free
+        //     any memory, and the next paint would be missing the image until it's decoded again.
+        if (image.m_frame->bitmap().ref_count() > 1)
+            continue;
+
+        // NB: Script expects the pixels of these right away, e.g. from CanvasRenderingContext2D.drawImage(), so they
+        //     have to stay decoded until those clients let go of them.
+        if (image.has_clients_that_expose_pixels_to_script())
+            continue;
+
+        remove(image);
+        image.discard_frame();
+        ++m_discarded_image_count;
+    }
+}
+
+}
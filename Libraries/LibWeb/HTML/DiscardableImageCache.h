@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/IntrusiveList.h>
+#include <AK/Time.h>
+#include <LibCore/MemoryPressureNotifier.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/HTML/BitmapDecodedImageData.h>
+
+namespace Web::HTML {
+
+// Keeps the decoded pixels of bitmap images under a budget for the whole WebContent process. Once the budget is
+// exceeded, the least recently used images that nothing else is holding on to drop their bitmap, and decode it again
+// from their encoded data when it's needed next. Images that script can read the pixels of through an element, such
+// as an <img> passed to CanvasRenderingContext2D.drawImage(), are never discarded.
+class WEB_API DiscardableImageCache {
+public:
+    static DiscardableImageCache& the();
+
+    static constexpr size_t maximum_decoded_size_in_bytes = 256 * MiB;
+
+    // Images that were used more recently than this are never discarded, so that whatever is being shown right now
+    // doesn't have to be decoded again after every rendering update.
+    static constexpr AK::Duration minimum_unused_time = AK::Duration::from_seconds(5);
+
+    void did_decode(BitmapDecodedImageData&);
+    void did_use(BitmapDecodedImageData&);
+    void remove(BitmapDecodedImageData&);
+
+    void did_update_rendering();
+    void did_receive_memory_pressure(Core::MemoryPressureLevel);
+
+    struct Statistics {
+        size_t decoded_size_in_bytes { 0 };
+        size_t decoded_image_count { 0 };
+        u64 discarded_image_count { 0 };
+        u64 redecoded_image_count { 0 };
+    };
+    Statistics statistics() const;
+
+private:
+    DiscardableImageCache() = default;
+
+    void discard_until_size_is_at_most(size_t size_in_bytes, AK::Duration minimum_unused_time);
+
+    // Ordered from least to most recently used. Only images that currently hold a bitmap are in the list.
+    IntrusiveList<&BitmapDecodedImageData::m_discardable_image_cache_list_node> m_images;
+    size_t m_decoded_size_in_bytes { 0 };
+    size_t m_decoded_image_count { 0 };
+    u64 m_discarded_image_count { 0 };
+    u64 m_redecoded_image_count { 0 };
+};
+
+}
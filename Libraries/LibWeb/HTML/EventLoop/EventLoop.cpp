@@ -8,6 +8,7 @@
 #include <AK/Debug.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/TraceEvent.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Animations/ScrollTimeline.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -16,6 +17,7 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/HTML/BrowsingContext.h>
+#include <LibWeb/HTML/DiscardableImageCache.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/HTMLMediaElement.h>
 #include <LibWeb/HTML/LocalTraversableNavigable.h>
@@ -133,6 +135,8 @@ void EventLoop::process()
 
     // 2. If the event loop has a task queue with at least one runnable task, then:
     if (m_task_queue->has_runnable_tasks()) {
+        TRACE_EVENT(EventLoop, "HTML::EventLoop::process task"sv);
+
         // 1. Let taskQueue be one such task queue, chosen in an implementation-defined manner.
         auto task_queue = m_task_queue;
 
@@ -306,6 +310,19 @@ void EventLoop::process_input_events() const
     }
 }
 
+// NB: Style is updated ahead of update_layout(), which would otherwise do it itself, so the frame timeline can tell
+//     the two apart.
+static void update_style_and_layout(DOM::Document& document, Compositor::FrameTiming& frame_timing)
+{
+    auto style_start = MonotonicTime::now();
+    if (auto navigable = document.navigable(); navigable && navigable->active_document() == &document)
+        document.update_style();
+    auto layout_start = MonotonicTime::now();
+    document.update_layout(DOM::UpdateLayoutReason::HTMLEventLoopRenderingUpdate);
+    frame_timing.record(Compositor::FrameTimingStage::Style, style_start, layout_start);
+    frame_timing.record(Compositor::FrameTimingStage::Layout, layout_start, MonotonicTime::now());
+}
+
 // https://html.spec.whatwg.org/multipage/webappapis.html#update-the-rendering
 void EventLoop::update_the_rendering()
 {
@@ -314,6 +331,10 @@ void EventLoop::update_the_rendering()
     ScopeGuard const guard = [this] {
         m_running_rendering_task = false;
     };
+    TRACE_EVENT(EventLoop, "HTML::EventLoop::update_the_rendering"sv);
+
+    m_rendering_update_frame_timing = {};
+    m_rendering_update_frame_timing.record(Compositor::FrameTimingStage::RenderingOpportunity, MonotonicTime::now());
 
     process_input_events();
 
@@ -420,7 +441,7 @@ void EventLoop::update_the_rendering()
         while (true) {
             // 1. Recalculate styles and update layout for doc.
             // NOTE: Recalculation of styles is handled by update_layout()
-            document->update_layout(DOM::UpdateLayoutReason::HTMLEventLoopRenderingUpdate);
+            update_style_and_layout(*document, m_rendering_update_frame_timing);
 
             // AD-HOC: Script that ran earlier in this rendering update may have spun the event loop (e.g. with a
             //         synchronous XHR) and run tasks that stopped document from being actively rendered, for example
@@ -453,6 +474,13 @@ void EventLoop::update_the_rendering()
                     if (check_for_initial_determination && element.is_relevant_to_the_user()) {
                         had_initial_visible_content_visibility_determination = true;
                     }
+
+                    // NB: Contents that are skipped are not painted or hit tested, so repaint when that flips.
+                    auto skips_its_contents = !paintable_box->layout_node().is_replaced_box() && !element.is_relevant_to_the_user();
+                    if (paintable_box->skips_its_contents() != skips_its_contents) {
+                        paintable_box->set_skips_its_contents(skips_its_contents);
+                        paintable_box->set_needs_repaint();
+                    }
                 }
             }
 
@@ -510,7 +538,7 @@ void EventLoop::update_the_rendering()
         }
 
         if (requires_style_and_layout_update)
-            document->update_layout(DOM::UpdateLayoutReason::HTMLEventLoopRenderingUpdate);
+            update_style_and_layout(*document, m_rendering_update_frame_timing);
     }
 
     // FIXME: 17. For each doc of docs, if the focused area of doc is not a focusable area, then run the focusing steps for doc's viewport, and set doc's relevant global object's navigation API's focus changed during ongoing navigation to false.
@@ -524,7 +552,7 @@ void EventLoop::update_the_rendering()
     for (auto& document : docs) {
         // NB: Layout may have been invalidated by previous steps (e.g. view transitions at step 18).
         //     Re-run layout here since intersection observations need up-to-date geometry.
-        document->update_layout(DOM::UpdateLayoutReason::HTMLEventLoopRenderingUpdate);
+        update_style_and_layout(*document, m_rendering_update_frame_timing);
 
         auto now = HighResolutionTime::relative_high_resolution_time(frame_timestamp, relevant_global_object(*document));
         document->run_the_update_intersection_observations_steps(now);
@@ -553,7 +581,7 @@ void EventLoop::update_the_rendering()
         if (navigable->is_svg_page())
             continue;
         if (auto document = navigable->active_document())
-            document->update_layout(DOM::UpdateLayoutReason::HTMLEventLoopRenderingUpdate);
+            update_style_and_layout(*document, m_rendering_update_frame_timing);
         navigable->paint_next_frame();
         if (navigable->is_traversable()) {
             auto traversable = navigable->traversable_navigable();
@@ -566,6 +594,10 @@ void EventLoop::update_the_rendering()
         document->process_top_layer_removals();
     }
 
+    // AD-HOC: Display lists that were just replaced no longer hold on to the images they painted, so now is when
+    //         those images can be discarded.
+    DiscardableImageCache::the().did_update_rendering();
+
     for (auto& document : docs) {
         // https://drafts.csswg.org/css-font-loading/#fontfaceset-pending-on-the-environment
         // A FontFaceSet is pending on the environment if any of the following are true:
@@ -665,6 +697,8 @@ void EventLoop::perform_a_microtask_checkpoint()
     VERIFY(vm().execution_context_stack().is_empty());
     VERIFY(!vm().has_running_execution_context());
 
+    TRACE_EVENT(EventLoop, "HTML::EventLoop::perform_a_microtask_checkpoint"sv);
+
     // 2. Set the event loop's performing a microtask checkpoint to true.
     m_performing_a_microtask_checkpoint = true;
 
@@ -816,6 +850,7 @@ double EventLoop::compute_deadline() const
     auto deadline = m_last_idle_period_start_time + 50;
     // 2. Let hasPendingRenders be false.
     auto has_pending_renders = false;
+    double refresh_rate = 0;
     // 3. For each windowInSameLoop of the same-loop windows for this event loop:
     for (auto& window : same_loop_windows()) {
         // 1. If windowInSameLoop's map of animation frame callbacks is not empty,
@@ -823,14 +858,18 @@ double EventLoop::compute_deadline() const
         //    set hasPendingRenders to true.
         if (window->has_animation_frame_callbacks())
             has_pending_renders = true;
+        if (auto navigable = window->navigable(); navigable && navigable->needs_repaint() && navigable->has_a_rendering_opportunity())
+            has_pending_renders = true;
+        refresh_rate = max(refresh_rate, window->page().client().maximum_frames_per_second());
         // FIXME: 2. Let timerCallbackEstimates be the result of getting the values of windowInSameLoop's map of active timers.
         // FIXME: 3. For each timeoutDeadline of timerCallbackEstimates, if timeoutDeadline is less than deadline, set deadline to timeoutDeadline.
     }
     // 4. If hasPendingRenders is true, then:
     if (has_pending_renders) {
         // 1. Let nextRenderDeadline be this event loop's last render opportunity time plus (1000 divided by the current refresh rate).
-        // FIXME: Hardcoded to 60Hz
-        auto next_render_deadline = m_last_render_opportunity_time + (1000.0 / 60.0);
+        if (refresh_rate <= 0)
+            refresh_rate = 60.0;
+        auto next_render_deadline = m_last_render_opportunity_time + (1000.0 / refresh_rate);
         // 2. If nextRenderDeadline is less than deadline, then return nextRenderDeadline.
         if (next_render_deadline < deadline)
             return next_render_deadline;
@@ -13,6 +13,7 @@
 #include <LibGC/Ptr.h>
 #include <LibGC/Weak.h>
 #include <LibJS/Forward.h>
+#include <LibWeb/Compositor/FrameTiming.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/HTML/EventLoop/TaskQueue.h>
 #include <LibWeb/HighResolutionTime/DOMHighResTimeStamp.h>
@@ -97,6 +98,9 @@ public:
 
     bool running_rendering_task() const { return m_running_rendering_task; }
 
+    // The timing of the running rendering update, which every frame painted by it starts out with.
+    Compositor::FrameTiming const& rendering_update_frame_timing() const { return m_rendering_update_frame_timing; }
+
 private:
     explicit EventLoop(Type);
 
@@ -142,6 +146,7 @@ private:
     bool m_execution_paused { false };
 
     bool m_running_rendering_task { false };
+    Compositor::FrameTiming m_rendering_update_frame_timing;
 
     GC::Ptr<GC::Function<void()>> m_rendering_task_function;
 };
@@ -24,6 +24,8 @@ void TaskQueue::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_event_loop);
+    for (auto& task : m_prioritized_tasks)
+        visitor.visit(task);
     for (auto& task : m_tasks)
         visitor.visit(task);
     for (auto& task : m_idle_tasks)
@@ -31,6 +33,22 @@ void TaskQueue::visit_edges(Visitor& visitor)
     visitor.visit(m_last_added_task);
 }
 
+// NB: User interaction and rendering are what the user is waiting for, so a flood of tasks from other sources (such as
+//     posted messages or networking) shouldn't delay them. Tasks from the same source still run in order.
+static bool is_prioritized_task_source(Task::Source source)
+{
+    return source == Task::Source::UserInteraction || source == Task::Source::Rendering;
+}
+
+Task::Queue& TaskQueue::queue_for_task(Task const& task)
+{
+    if (task.source() == Task::Source::IdleTask)
+        return m_idle_tasks;
+    if (is_prioritized_task_source(task.source()))
+        return m_prioritized_tasks;
+    return m_tasks;
+}
+
 void TaskQueue::add(GC::Ref<Task> task)
 {
     // AD-HOC: Don't enqueue tasks for temporary (inert) documents used for fragment parsing.
@@ -39,10 +57,7 @@ void TaskQueue::add(GC::Ref<Task> task)
         return;
 
     m_last_added_task = task.ptr();
-    if (task->source() == Task::Source::IdleTask)
-        m_idle_tasks.append(*task);
-    else
-        m_tasks.append(*task);
+    queue_for_task(*task).append(*task);
     m_event_loop->schedule();
 }
 
@@ -57,25 +72,26 @@ GC::Ptr<Task> TaskQueue::dequeue()
         return task;
     };
 
+    if (auto task = take_task(m_prioritized_tasks))
+        return task;
     if (auto task = take_task(m_tasks))
         return task;
     return take_task(m_idle_tasks);
 }
 
-GC::Ptr<Task> TaskQueue::take_first_runnable()
+bool TaskQueue::is_task_ready_to_run(Task const& task) const
 {
-    if (m_event_loop->execution_paused())
-        return nullptr;
+    if (m_event_loop->running_rendering_task() && task.source() == Task::Source::Rendering)
+        return false;
+    return task.is_runnable();
+}
 
-    for (auto it = m_tasks.begin(); it != m_tasks.end();) {
+GC::Ptr<Task> TaskQueue::take_first_runnable_from(Task::Queue& tasks, Function<bool(HTML::Task const&)> const& filter)
+{
+    for (auto it = tasks.begin(); it != tasks.end();) {
         auto& task = *it;
 
-        if (m_event_loop->running_rendering_task() && task.source() == Task::Source::Rendering) {
-            ++it;
-            continue;
-        }
-
-        if (task.is_runnable()) {
+        if (is_task_ready_to_run(task) && (!filter || filter(task))) {
             if (m_last_added_task == &task)
                 m_last_added_task = {};
             it.erase();
@@ -91,27 +107,29 @@ GC::Ptr<Task> TaskQueue::take_first_runnable()
 
         ++it;
     }
+    return nullptr;
+}
 
-    for (auto it = m_idle_tasks.begin(); it != m_idle_tasks.end();) {
-        auto& task = *it;
-
-        if (task.is_runnable()) {
-            if (m_last_added_task == &task)
-                m_last_added_task = {};
-            it.erase();
-            return &task;
-        }
+GC::Ptr<Task> TaskQueue::take_first_runnable()
+{
+    if (m_event_loop->execution_paused())
+        return nullptr;
 
-        if (task.is_permanently_unrunnable()) {
-            if (m_last_added_task == &task)
-                m_last_added_task = {};
-            it.erase();
-            continue;
+    // NB: Every so often, other tasks get to go first, so that they can't be starved by a steady stream of prioritized
+    //     tasks.
+    if (m_prioritized_tasks_run_in_a_row < max_prioritized_tasks_in_a_row) {
+        if (auto task = take_first_runnable_from(m_prioritized_tasks)) {
+            ++m_prioritized_tasks_run_in_a_row;
+            return task;
         }
-
-        ++it;
     }
-    return nullptr;
+
+    m_prioritized_tasks_run_in_a_row = 0;
+    if (auto task = take_first_runnable_from(m_tasks))
+        return task;
+    if (auto task = take_first_runnable_from(m_prioritized_tasks))
+        return task;
+    return take_first_runnable_from(m_idle_tasks);
 }
 
 bool TaskQueue::has_runnable_tasks() const
@@ -119,16 +137,11 @@ bool TaskQueue::has_runnable_tasks() const
     if (m_event_loop->execution_paused())
         return false;
 
-    for (auto& task : m_tasks) {
-        if (m_event_loop->running_rendering_task() && task.source() == Task::Source::Rendering)
-            continue;
-        if (task.is_runnable())
-            return true;
-    }
-
-    for (auto& task : m_idle_tasks) {
-        if (task.is_runnable())
-            return true;
+    for (auto const* tasks : { &m_prioritized_tasks, &m_tasks, &m_idle_tasks }) {
+        for (auto const& task : *tasks) {
+            if (is_task_ready_to_run(task))
+                return true;
+        }
     }
     return false;
 }
@@ -147,52 +160,17 @@ void TaskQueue::remove_tasks_matching(Function<bool(HTML::Task const&)> filter)
             it.erase();
         }
     };
+    remove_matching_tasks(m_prioritized_tasks);
     remove_matching_tasks(m_tasks);
     remove_matching_tasks(m_idle_tasks);
 }
 
 GC::Ptr<Task> TaskQueue::take_first_runnable_matching(Function<bool(HTML::Task const&)> filter)
 {
-    for (auto it = m_tasks.begin(); it != m_tasks.end();) {
-        auto& task = *it;
-
-        if (task.is_runnable() && filter(task)) {
-            if (m_last_added_task == &task)
-                m_last_added_task = {};
-            it.erase();
-            return &task;
-        }
-
-        if (task.is_permanently_unrunnable()) {
-            if (m_last_added_task == &task)
-                m_last_added_task = {};
-            it.erase();
-            continue;
-        }
-
-        ++it;
-    }
-
-    for (auto it = m_idle_tasks.begin(); it != m_idle_tasks.end();) {
-        auto& task = *it;
-
-        if (task.is_runnable() && filter(task)) {
-            if (m_last_added_task == &task)
-                m_last_added_task = {};
-            it.erase();
-            return &task;
-        }
-
-        if (task.is_permanently_unrunnable()) {
-            if (m_last_added_task == &task)
-                m_last_added_task = {};
-            it.erase();
-            continue;
-        }
-
-        ++it;
+    for (auto* tasks : { &m_prioritized_tasks, &m_tasks, &m_idle_tasks }) {
+        if (auto task = take_first_runnable_from(*tasks, filter))
+            return task;
     }
-
     return nullptr;
 }
 
@@ -203,7 +181,7 @@ Task const* TaskQueue::last_added_task() const
 
 bool TaskQueue::has_rendering_tasks() const
 {
-    for (auto const& task : m_tasks) {
+    for (auto const& task : m_prioritized_tasks) {
         if (task.source() == Task::Source::Rendering)
             return true;
     }
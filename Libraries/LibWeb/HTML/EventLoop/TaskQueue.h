@@ -19,7 +19,7 @@ public:
     explicit TaskQueue(HTML::EventLoop&);
     virtual ~TaskQueue() override;
 
-    bool is_empty() const { return m_tasks.is_empty() && m_idle_tasks.is_empty(); }
+    bool is_empty() const { return m_prioritized_tasks.is_empty() && m_tasks.is_empty() && m_idle_tasks.is_empty(); }
 
     bool has_runnable_tasks() const;
     bool has_rendering_tasks() const;
@@ -36,13 +36,21 @@ public:
     Task const* last_added_task() const;
 
 private:
+    static constexpr size_t max_prioritized_tasks_in_a_row = 8;
+
     virtual void visit_edges(Visitor&) override;
 
+    Task::Queue& queue_for_task(Task const&);
+    bool is_task_ready_to_run(Task const&) const;
+    GC::Ptr<Task> take_first_runnable_from(Task::Queue&, Function<bool(HTML::Task const&)> const& filter = {});
+
     GC::Ref<HTML::EventLoop> m_event_loop;
 
+    Task::Queue m_prioritized_tasks;
     Task::Queue m_tasks;
     Task::Queue m_idle_tasks;
     GC::Ptr<HTML::Task const> m_last_added_task;
+    size_t m_prioritized_tasks_run_in_a_row { 0 };
 };
 
 }
@@ -6,9 +6,11 @@
 
 #include <AK/Base64.h>
 #include <AK/Checked.h>
+#include <LibCore/EventLoop.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/CanvasCommandList.h>
 #include <LibGfx/SharedImage.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/HTMLCanvasElement.h>
 #include <LibWeb/CSS/ComputedProperties.h>
@@ -28,7 +30,6 @@
 #include <LibWeb/Infra/SerializedURL.h>
 #include <LibWeb/Layout/CanvasBox.h>
 #include <LibWeb/Page/Page.h>
-#include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/Platform/FontPlugin.h>
 #include <LibWeb/WebGL/WebGL2RenderingContext.h>
 #include <LibWeb/WebGL/WebGLContextProxy.h>
@@ -390,32 +391,43 @@ WebIDL::ExceptionOr<void> HTMLCanvasElement::to_blob(GC::Ref<WebIDL::CallbackTyp
 
     Optional<double> quality = js_quality.has_value() && js_quality->is_number() ? js_quality->as_double() : Optional<double>();
 
-    // 4. Run these steps in parallel:
-    auto type_string = Utf16String::from_utf16(type);
-    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(heap(), [this, callback, bitmap_result, type = move(type_string), quality] {
-        // 1. If result is non-null, then set result to a serialization of result as a file with type and quality if given.
-        Optional<SerializeBitmapResult> file_result;
-        if (bitmap_result) {
-            if (auto result = serialize_bitmap(*bitmap_result, type, quality); !result.is_error())
-                file_result = result.release_value();
-        }
-
+    // NB: The encoder continues on the origin thread. It holds the GC roots, so that they're only ever touched there.
+    auto* on_serialized = new Function<void(Optional<SerializeBitmapResult>)>([canvas = GC::make_root(*this), callback = GC::make_root(callback)](Optional<SerializeBitmapResult> file_result) {
         // 2. Queue an element task on the canvas blob serialization task source given the canvas element to run these steps:
-        queue_an_element_task(Task::Source::CanvasBlobSerializationTask, [this, callback, file_result = move(file_result)] {
-            auto maybe_error = Bindings::throw_dom_exception_if_needed(vm(), [&]() -> WebIDL::ExceptionOr<void> {
+        canvas->queue_an_element_task(Task::Source::CanvasBlobSerializationTask, [canvas = GC::Ref { *canvas }, callback = GC::Ref { *callback }, file_result = move(file_result)] {
+            auto& realm = canvas->realm();
+            auto maybe_error = Bindings::throw_dom_exception_if_needed(canvas->vm(), [&]() -> WebIDL::ExceptionOr<void> {
                 // 1. If result is non-null, then set result to a new Blob object, created in the relevant realm of this canvas element, representing result. [FILEAPI]
                 GC::Ptr<FileAPI::Blob> blob_result;
                 if (file_result.has_value())
-                    blob_result = FileAPI::Blob::create(realm(), file_result->buffer, serialized_bitmap_mime_type_to_utf16_view(file_result->mime_type));
+                    blob_result = FileAPI::Blob::create(realm, file_result->buffer, serialized_bitmap_mime_type_to_utf16_view(file_result->mime_type));
 
                 // 2. Invoke callback with « result » and "report".
                 TRY(WebIDL::invoke_callback(*callback, {}, WebIDL::ExceptionBehavior::Report, { { blob_result } }));
                 return {};
             });
             if (maybe_error.is_throw_completion())
-                report_exception(maybe_error.throw_completion(), realm());
+                report_exception(maybe_error.throw_completion(), realm);
+        });
+    });
+
+    // 4. Run these steps in parallel:
+    // OPTIMIZATION: Encoding a large canvas can take seconds, so it happens on the thread pool instead of blocking the
+    //               event loop.
+    auto& origin_event_loop = Core::EventLoop::current();
+    Threading::ThreadPool::the().submit([bitmap_result = move(bitmap_result), type = Utf16String::from_utf16(type), quality, on_serialized, &origin_event_loop]() mutable {
+        // 1. If result is non-null, then set result to a serialization of result as a file with type and quality if given.
+        Optional<SerializeBitmapResult> file_result;
+        if (bitmap_result) {
+            if (auto result = serialize_bitmap(*bitmap_result, type, quality); !result.is_error())
+                file_result = result.release_value();
+        }
+
+        origin_event_loop.deferred_invoke([on_serialized, file_result = move(file_result)]() mutable {
+            (*on_serialized)(move(file_result));
+            delete on_serialized;
         });
-    }));
+    });
     return {};
 }
 
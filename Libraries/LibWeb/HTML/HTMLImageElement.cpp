@@ -992,6 +992,10 @@ void HTMLImageElement::add_callbacks_to_image_request(GC::Ref<ImageRequest> imag
 
                 VERIFY(image_request->shared_resource_request());
                 auto image_data = image_request->shared_resource_request()->image_data();
+
+                // NB: The current request may have been showing a partially decoded image until now.
+                if (image_request == m_current_request)
+                    unregister_with_decoded_image_data_if_needed();
                 image_request->set_image_data(image_data);
 
                 ListOfAvailableImages::Key key;
@@ -1071,6 +1075,30 @@ void HTMLImageElement::add_callbacks_to_image_request(GC::Ref<ImageRequest> imag
                 dispatch_event(DOM::Event::create(realm(), HTML::EventNames::error));
 
             m_load_event_delayer.clear();
+        },
+        [this, image_request] {
+            if (!document().is_fully_active() || image_request->was_aborted())
+                return;
+
+            // NB: Each task that is queued by the networking task source while the image is being fetched, if image
+            //     request is the current request, must update the presentation of the image appropriately (e.g., if
+            //     the image is a progressive JPEG, each packet can improve the resolution of the image).
+            if (image_request != m_current_request || image_request->state() == ImageRequest::State::CompletelyAvailable)
+                return;
+
+            auto partial_image_data = image_request->shared_resource_request()->partial_image_data();
+            if (!partial_image_data)
+                return;
+
+            unregister_with_decoded_image_data_if_needed();
+            image_request->set_image_data(partial_image_data);
+            register_with_decoded_image_data_if_needed();
+
+            // https://html.spec.whatwg.org/multipage/images.html#img-req-state
+            // Partially available: The user agent has obtained some of the image data.
+            image_request->set_state(ImageRequest::State::PartiallyAvailable);
+
+            set_needs_layout_update_or_repaint_after_image_data_change(*this, DOM::SetNeedsLayoutReason::HTMLImageElementUpdateTheImageData);
         });
 }
 
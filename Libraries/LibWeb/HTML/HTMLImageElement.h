@@ -143,6 +143,7 @@ private:
     void add_callbacks_to_image_request(GC::Ref<ImageRequest>, bool maybe_omit_events, Utf16View url_string, Utf16View previous_url);
 
     virtual void decoded_image_data_did_update() override { set_needs_repaint(); }
+    virtual bool exposes_pixels_to_script() const override { return true; }
 
     Optional<DOM::DocumentLoadEventDelayer> m_load_event_delayer;
 
@@ -7,11 +7,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Debug.h>
 #include <LibCore/ImmutableBytes.h>
+#include <LibGC/RootVector.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/DecodedImageFrame.h>
+#include <LibHTTP/Link.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Bindings/HTMLLinkElement.h>
@@ -30,10 +33,12 @@
 #include <LibWeb/Fetch/Infrastructure/HTTP/MIME.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/Fetch/Infrastructure/NetworkPartitionKey.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/EventNames.h>
 #include <LibWeb/HTML/HTMLLinkElement.h>
 #include <LibWeb/HTML/LocalTraversableNavigable.h>
+#include <LibWeb/HTML/PolicyContainers.h>
 #include <LibWeb/HTML/PotentialCORSRequest.h>
 #include <LibWeb/Infra/CharacterTypes.h>
 #include <LibWeb/Loader/ResourceLoader.h>
@@ -45,6 +50,9 @@ namespace Web::HTML {
 
 GC_DEFINE_ALLOCATOR(HTMLLinkElement);
 
+// Below this, the round trip through the thread pool costs more than tokenizing on the main thread.
+static constexpr size_t off_thread_style_sheet_tokenization_threshold = 64 * KiB;
+
 HTMLLinkElement::HTMLLinkElement(DOM::Document& document, DOM::QualifiedName qualified_name)
     : HTMLElement(document, move(qualified_name))
 {
@@ -389,7 +397,7 @@ GC::Ptr<Fetch::Infrastructure::Request> HTMLLinkElement::create_link_request(HTM
         return nullptr;
 
     // 5. Let request be the result of creating a potential-CORS request given url, options's destination, and options's crossorigin.
-    auto request = create_potential_CORS_request(vm(), *url, options.destination, options.crossorigin);
+    auto request = create_potential_CORS_request(options.environment->realm().vm(), *url, options.destination, options.crossorigin);
 
     // 6. Set request's policy container to options's policy container.
     request->set_policy_container(GC::Ref { *options.policy_container });
@@ -423,6 +431,13 @@ void HTMLLinkElement::fetch_and_process_linked_resource()
         document().remove_from_script_blocking_style_sheet_set(*this);
     }
 
+    // NB: A style sheet that is still being tokenized off-thread keeps blocking scripts and rendering, and delays the
+    //     load event. Its callback ignores superseded fetches, so release all of that here before the new fetch runs.
+    if (m_has_pending_off_thread_style_sheet) {
+        m_has_pending_off_thread_style_sheet = false;
+        finish_processing_stylesheet_resource();
+    }
+
     if (m_relationship & ~(Relationship::DNSPrefetch | Relationship::Preconnect | Relationship::Preload))
         default_fetch_and_process_linked_resource(fetch_generation);
     else if (m_relationship & Relationship::Preload)
@@ -557,7 +572,7 @@ void HTMLLinkElement::fetch_and_process_linked_preload_resource()
     // 6. Preload options, with the following steps given a response response:
     GC::Weak weak_this { *this };
     auto fetch_generation = m_current_fetch_generation;
-    preload(options, [weak_this, fetch_generation](Fetch::Infrastructure::Response& response) {
+    m_fetch_controller = preload(options, [weak_this, fetch_generation](Fetch::Infrastructure::Response& response) {
         // 1. If response is a network error, fire an event named error at el. Otherwise, fire an event named load at el.
         if (auto link_element = weak_this.ptr()) {
             if (fetch_generation != link_element->m_current_fetch_generation)
@@ -641,7 +656,9 @@ void HTMLLinkElement::preconnect(LinkProcessingOptions const& options)
     if (!url->scheme().is_one_of("http"sv, "https"sv))
         return;
 
-    // FIXME: 5. Let partitionKey be the result of determining the network partition key given options's environment.
+    // 5. Let partitionKey be the result of determining the network partition key given options's environment.
+    auto partition_key = Fetch::Infrastructure::determine_the_network_partition_key(*options.environment);
+
     // FIXME: 6. Let useCredentials be true.
     // FIXME: 7. If options's crossorigin is Anonymous and options's origin does not have the same origin as url's origin,
     //           then set useCredentials to false.
@@ -651,7 +668,7 @@ void HTMLLinkElement::preconnect(LinkProcessingOptions const& options)
     if (!ResourceLoader::is_initialized())
         return;
     auto source_url = options.document ? options.document->fallback_base_url() : options.environment->api_base_url();
-    ResourceLoader::the().preconnect(*url, source_url);
+    ResourceLoader::the().preconnect(*url, source_url, partition_key.serialized_top_level_site());
 }
 
 // https://html.spec.whatwg.org/multipage/links.html#match-preload-type
@@ -708,26 +725,26 @@ static bool type_matches_destination(Utf16View type, Optional<Fetch::Infrastruct
 }
 
 // https://html.spec.whatwg.org/multipage/links.html#preload
-void HTMLLinkElement::preload(LinkProcessingOptions& options, Function<void(Fetch::Infrastructure::Response&)> process_response)
+GC::Ptr<Fetch::Infrastructure::FetchController> HTMLLinkElement::preload(LinkProcessingOptions& options, Function<void(Fetch::Infrastructure::Response&)> process_response)
 {
-    auto& realm = this->realm();
+    auto& realm = options.environment->realm();
     auto& vm = realm.vm();
 
     // 1. If options's type doesn't match options's destination, then return.
     if (!type_matches_destination(options.type, options.destination))
-        return;
+        return nullptr;
 
     // FIXME: 2. If options's destination is "image" and options's source set is not null, then set options's href to the
     //           result of selecting an image source from options's source set.
     if (options.href.is_empty())
-        return;
+        return nullptr;
 
     // 3. Let request be the result of creating a link request given options.
     auto request = create_link_request(options);
 
     // 4. If request is null, then return.
     if (!request)
-        return;
+        return nullptr;
 
     // FIXME: 5. Let unsafeEndTime be 0.
 
@@ -783,8 +800,8 @@ void HTMLLinkElement::preload(LinkProcessingOptions& options, Function<void(Fetc
             process_response(response);
     };
 
-    m_fetch_controller = Fetch::Fetching::fetch(realm, *request, Fetch::Infrastructure::FetchAlgorithms::create(vm, move(fetch_algorithms_input)));
-    controller_holder->set_controller(*m_fetch_controller);
+    auto controller = Fetch::Fetching::fetch(realm, *request, Fetch::Infrastructure::FetchAlgorithms::create(vm, move(fetch_algorithms_input)));
+    controller_holder->set_controller(controller);
 
     // 12. Let commit be the following steps given a Document document:
     auto commit = GC::Function<void(DOM::Document&)>::create(realm.heap(), [entry, report_timing, key = move(key)](DOM::Document& document) {
@@ -802,6 +819,214 @@ void HTMLLinkElement::preload(LinkProcessingOptions& options, Function<void(Fetc
         options.on_document_ready = commit;
     else
         commit->function()(*options.document);
+
+    return controller;
+}
+
+// https://html.spec.whatwg.org/multipage/semantics.html#apply-link-options-from-parsed-header-attributes
+bool HTMLLinkElement::apply_link_options_from_parsed_header_attributes(LinkProcessingOptions& options, HTTP::Link const& link)
+{
+    // For each name → value of attributes:
+    for (auto const& [name, raw_value] : link.target_attributes) {
+        auto value = TextCodec::isomorphic_decode_to_utf16(raw_value);
+
+        // 1. If name is "as", then set options's destination to the result of translating value. If the result is
+        //    null, then return false.
+        if (name == "as"sv) {
+            auto destination = translate_a_preload_destination(value.utf16_view());
+            if (destination.has<Empty>())
+                return false;
+            options.destination = destination.get<Optional<Fetch::Infrastructure::Request::Destination>>();
+        }
+        // 2. If name is "crossorigin", then set options's crossorigin to the CORS settings attribute state that
+        //    corresponds to value.
+        else if (name == "crossorigin"sv) {
+            options.crossorigin = cors_setting_attribute_from_keyword(value.utf16_view());
+        }
+        // 3. If name is "integrity", then set options's integrity to value.
+        else if (name == "integrity"sv) {
+            options.integrity = move(value);
+        }
+        // 4. If name is "referrerpolicy", then set options's referrer policy to the referrer policy that corresponds
+        //    to value.
+        else if (name == "referrerpolicy"sv) {
+            options.referrer_policy = ReferrerPolicy::from_string(value).value_or(ReferrerPolicy::ReferrerPolicy::EmptyString);
+        }
+        // 5. If name is "nonce", then set options's cryptographic nonce metadata to value.
+        else if (name == "nonce"sv) {
+            options.cryptographic_nonce_metadata = move(value);
+        }
+        // 6. If name is "type", then set options's type to value.
+        else if (name == "type"sv) {
+            options.type = move(value);
+        }
+        // 7. If name is "fetchpriority", then set options's fetch priority to the fetch priority attribute state that
+        //    corresponds to value.
+        else if (name == "fetchpriority"sv) {
+            options.fetch_priority = Fetch::Infrastructure::request_priority_from_string(value).value_or(Fetch::Infrastructure::Request::Priority::Auto);
+        }
+        // FIXME: 8. If name is "imagesrcset" or "imagesizes", update options's source set.
+    }
+
+    // 9. Return true.
+    return true;
+}
+
+// https://html.spec.whatwg.org/multipage/semantics.html#process-link-headers
+void HTMLLinkElement::process_link_headers(DOM::Document& document, Fetch::Infrastructure::Response const& response, LinkHeaderPhase phase)
+{
+    auto link_header = response.header_list()->get("Link"sv);
+    if (!link_header.has_value())
+        return;
+
+    // 1. Let links be the result of parsing Link headers from response.
+    auto links = HTTP::parse_link_field_value(*link_header);
+
+    // 2. For each linkObject in links:
+    for (auto const& link : links) {
+        // 1. Let rel be linkObject["relation_type"].
+        auto const& rel = link.relation_type;
+        if (!rel.is_one_of("preload"sv, "preconnect"sv))
+            continue;
+
+        // 2. Let attribs be linkObject["target_attributes"].
+        // 3. Let expectedPhase be "media" if either "srcset", "imagesrcset", or "media" exist in attribs; otherwise
+        //    "pre-media".
+        auto media = link.target_attribute("media"sv);
+        auto expected_phase = media.has_value() || link.target_attribute("srcset"sv).has_value() || link.target_attribute("imagesrcset"sv).has_value()
+            ? LinkHeaderPhase::Media
+            : LinkHeaderPhase::PreMedia;
+
+        // 4. If expectedPhase is not phase, then continue.
+        if (expected_phase != phase)
+            continue;
+
+        // 5. If attribs["media"] exists and attribs["media"] does not match the environment, then continue.
+        if (media.has_value()) {
+            auto media_queries = parse_media_query_list(CSS::Parser::ParsingParams { document }, TextCodec::isomorphic_decode_to_utf16(*media));
+            if (!media_queries.is_empty() && !any_of(media_queries, [&](auto& media_query) { return media_query->evaluate(document); }))
+                continue;
+        }
+
+        // 6. Let options be a new link processing options with
+        auto options = document.realm().create<LinkProcessingOptions>(
+            CORSSettingAttribute::NoCORS,
+            ReferrerPolicy::ReferrerPolicy::EmptyString,
+            // base URL
+            //     doc's URL
+            document.url(),
+            // origin
+            //     doc's origin
+            document.origin(),
+            // environment
+            //     doc's relevant settings object
+            document.relevant_settings_object(),
+            // policy container
+            //     doc's policy container
+            document.policy_container(),
+            // document
+            //     doc
+            document,
+            Utf16String {},
+            Fetch::Infrastructure::Request::Priority::Auto);
+
+        // href
+        //     linkObject["target_uri"]
+        options->href = TextCodec::isomorphic_decode_to_utf16(link.target);
+
+        // 7. Apply link options from parsed header attributes to options given attribs.
+        if (!apply_link_options_from_parsed_header_attributes(*options, link))
+            continue;
+
+        // FIXME: 8. If attribs["imagesrcset"] exists and attribs["imagesizes"] exists, then set options's source set to
+        //           the result of creating a source set given linkObject["target_uri"], attribs["imagesrcset"],
+        //           attribs["imagesizes"], and null.
+
+        // 9. Run the process a link header steps for rel given options.
+        // https://html.spec.whatwg.org/multipage/links.html#link-type-preconnect:process-a-link-header
+        if (rel == "preconnect"sv) {
+            preconnect(options);
+            continue;
+        }
+
+        // https://html.spec.whatwg.org/multipage/links.html#link-type-preload:process-a-link-header
+        (void)preload(options);
+    }
+}
+
+// https://html.spec.whatwg.org/multipage/semantics.html#process-early-hint-headers
+GC::Ref<GC::Function<void(DOM::Document&)>> HTMLLinkElement::process_early_hint_headers(GC::Heap& heap, Fetch::Infrastructure::Response const& response, GC::Ptr<Environment> reserved_environment)
+{
+    // 1. Let earlyPolicyContainer be the result of creating a policy container from a fetch response given response
+    //    and reservedEnvironment.
+    auto early_policy_container = create_a_policy_container_from_a_fetch_response(heap, response, reserved_environment);
+
+    // 2. Let links be the result of parsing Link headers from response's header list.
+    Vector<HTTP::Link> links;
+    if (auto link_header = response.header_list()->get("Link"sv); link_header.has_value())
+        links = HTTP::parse_link_field_value(*link_header);
+
+    // AD-HOC: The spec preloads each hint right away on behalf of reservedEnvironment. That is not an environment
+    //         settings object until the navigation commits, and fetching on behalf of the outgoing document instead
+    //         would use its origin, cookies and policies, and abort the preload if that document goes away. So the
+    //         remaining steps run once the new document exists, with its environment settings object. That is still
+    //         before its body is parsed.
+    auto response_url = response.url().value_or({});
+
+    // 5. Return the following substeps given Document doc:
+    return GC::create_function(heap, [early_policy_container, links = move(links), response_url = move(response_url)](DOM::Document& document) {
+        auto& realm = document.realm();
+
+        // 4. For each linkObject in links:
+        for (auto const& link : links) {
+            // AD-HOC: The spec only preloads early hints, but preconnecting as well is what servers sending
+            //         `rel=preconnect` in 103 responses expect, and what other engines do.
+            if (!link.relation_type.is_one_of("preload"sv, "preconnect"sv))
+                continue;
+
+            // 1. Let options be a new link processing options with
+            auto options = realm.create<LinkProcessingOptions>(
+                CORSSettingAttribute::NoCORS,
+                ReferrerPolicy::ReferrerPolicy::EmptyString,
+                // base URL
+                //     response's URL
+                response_url,
+                // origin
+                //     response's URL's origin
+                response_url.origin(),
+                // environment
+                //     reservedEnvironment
+                document.relevant_settings_object(),
+                // policy container
+                //     earlyPolicyContainer
+                early_policy_container,
+                // NB: Setting the document up front commits each preload to it directly, as the substeps below would.
+                document,
+                Utf16String {},
+                Fetch::Infrastructure::Request::Priority::Auto);
+
+            // href
+            //     linkObject["target_uri"]
+            options->href = TextCodec::isomorphic_decode_to_utf16(link.target);
+
+            // initiator
+            //     "early-hint"
+            options->initiator = Fetch::Infrastructure::Request::InitiatorType::EarlyHint;
+
+            // 2. Let attribs be linkObject["target_attributes"].
+            // 3. Apply link options from parsed header attributes to options given attribs.
+            if (!apply_link_options_from_parsed_header_attributes(*options, link))
+                continue;
+
+            if (link.relation_type == "preconnect"sv) {
+                preconnect(options);
+                continue;
+            }
+
+            // 4. Preload options.
+            (void)preload(options);
+        }
+    });
 }
 
 // https://html.spec.whatwg.org/multipage/semantics.html#process-the-linked-resource
@@ -903,22 +1128,31 @@ void HTMLLinkElement::process_stylesheet_resource(bool success, Fetch::Infrastru
             dispatch_event(*DOM::Event::create(realm(), HTML::EventNames::error));
         } else {
             VERIFY(!response.url_list().is_empty());
-            auto media = attribute(HTML::AttributeNames::media);
-            auto media_value = media.has_value() ? media->utf16_view() : u""sv;
-            auto title = in_a_document_tree() ? attribute(HTML::AttributeNames::title) : Optional<Utf16String> {};
-            m_loaded_style_sheet = document_or_shadow_root_style_sheets().create_a_css_style_sheet(
-                maybe_decoded_string.release_value(),
-                this,
-                media_value,
-                title.has_value() ? title.release_value() : Utf16String {},
-                (m_relationship & Relationship::Alternate && !m_explicitly_enabled) ? CSS::StyleSheetList::Alternate::Yes : CSS::StyleSheetList::Alternate::No,
-                CSS::StyleSheetList::OriginClean::Yes,
-                response.url_list().first(),
-                nullptr,
-                nullptr);
-
-            // 2. Fire an event named load at el.
-            dispatch_event(*DOM::Event::create(realm(), HTML::EventNames::load));
+            auto decoded_string = maybe_decoded_string.release_value();
+
+            // OPTIMIZATION: Tokenizing a large style sheet takes long enough to cause jank, so do that on the thread
+            //               pool and pick the remaining steps back up once only the cheap main-thread work is left.
+            if (decoded_string.length_in_code_units() >= off_thread_style_sheet_tokenization_threshold) {
+                GC::Weak weak_this { *this };
+                auto fetch_generation = m_current_fetch_generation;
+                m_has_pending_off_thread_style_sheet = true;
+                CSS::Parser::Parser::prepare_shared_rules_off_thread(decoded_string,
+                    [weak_this, fetch_generation, decoded_string, location = response.url_list().first()] {
+                        auto link_element = weak_this.ptr();
+                        if (!link_element || fetch_generation != link_element->m_current_fetch_generation)
+                            return;
+                        link_element->m_has_pending_off_thread_style_sheet = false;
+                        if (!link_element->document().is_fully_active()) {
+                            link_element->finish_processing_stylesheet_resource();
+                            return;
+                        }
+                        link_element->create_and_load_style_sheet(decoded_string, location);
+                        link_element->finish_processing_stylesheet_resource();
+                    });
+                return;
+            }
+
+            create_and_load_style_sheet(decoded_string, response.url_list().first());
         }
     }
     // 5. Otherwise, fire an event named error at el.
@@ -926,6 +1160,31 @@ void HTMLLinkElement::process_stylesheet_resource(bool success, Fetch::Infrastru
         dispatch_event(*DOM::Event::create(realm(), HTML::EventNames::error));
     }
 
+    finish_processing_stylesheet_resource();
+}
+
+void HTMLLinkElement::create_and_load_style_sheet(Utf16View css_text, URL::URL const& location)
+{
+    auto media = attribute(HTML::AttributeNames::media);
+    auto media_value = media.has_value() ? media->utf16_view() : u""sv;
+    auto title = in_a_document_tree() ? attribute(HTML::AttributeNames::title) : Optional<Utf16String> {};
+    m_loaded_style_sheet = document_or_shadow_root_style_sheets().create_a_css_style_sheet(
+        css_text,
+        this,
+        media_value,
+        title.has_value() ? title.release_value() : Utf16String {},
+        (m_relationship & Relationship::Alternate && !m_explicitly_enabled) ? CSS::StyleSheetList::Alternate::Yes : CSS::StyleSheetList::Alternate::No,
+        CSS::StyleSheetList::OriginClean::Yes,
+        location,
+        nullptr,
+        nullptr);
+
+    // 2. Fire an event named load at el.
+    dispatch_event(*DOM::Event::create(realm(), HTML::EventNames::load));
+}
+
+void HTMLLinkElement::finish_processing_stylesheet_resource()
+{
     // 6. If el contributes a script-blocking style sheet, then:
     if (contributes_a_script_blocking_style_sheet()) {
         // 1. Assert: el's node document's script-blocking style sheet set contains el.
@@ -984,7 +1243,8 @@ static NonnullRefPtr<Core::Promise<NonnullRefPtr<Gfx::Bitmap const>>> decode_fav
         return {};
     };
 
-    (void)Platform::ImageCodecPlugin::the().decode_image(favicon_data, move(on_successful_decode), move(on_failed_decode));
+    auto decode_cache_partition = Fetch::Infrastructure::determine_the_network_partition_key(document->relevant_settings_object()).serialized_top_level_site();
+    (void)Platform::ImageCodecPlugin::the().decode_image(favicon_data, move(on_successful_decode), move(on_failed_decode), move(decode_cache_partition));
 
     return promise;
 }
@@ -11,6 +11,7 @@
 
 #include <AK/Function.h>
 #include <AK/Utf16View.h>
+#include <LibHTTP/Forward.h>
 #include <LibWeb/DOM/DocumentLoadEventDelayer.h>
 #include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
@@ -61,6 +62,13 @@ public:
     };
     void finished_loading_critical_style_subresources(AnyFailed);
 
+    enum class LinkHeaderPhase : u8 {
+        PreMedia,
+        Media,
+    };
+    static void process_link_headers(DOM::Document&, Fetch::Infrastructure::Response const&, LinkHeaderPhase);
+    static GC::Ref<GC::Function<void(DOM::Document&)>> process_early_hint_headers(GC::Heap&, Fetch::Infrastructure::Response const&, GC::Ptr<Environment> reserved_environment);
+
 private:
     // https://html.spec.whatwg.org/multipage/semantics.html#link-processing-options
     struct LinkProcessingOptions final : public JS::Cell {
@@ -155,7 +163,8 @@ private:
     virtual bool is_implicitly_potentially_render_blocking() const override;
 
     GC::Ref<LinkProcessingOptions> create_link_options();
-    GC::Ptr<Fetch::Infrastructure::Request> create_link_request(LinkProcessingOptions const&);
+    static GC::Ptr<Fetch::Infrastructure::Request> create_link_request(LinkProcessingOptions const&);
+    static bool apply_link_options_from_parsed_header_attributes(LinkProcessingOptions&, HTTP::Link const&);
 
     void fetch_and_process_linked_resource();
     void default_fetch_and_process_linked_resource(u64 fetch_generation);
@@ -167,12 +176,14 @@ private:
     bool icon_linked_resource_fetch_setup_steps(Fetch::Infrastructure::Request&);
     bool stylesheet_linked_resource_fetch_setup_steps(Fetch::Infrastructure::Request&);
 
-    void preconnect(LinkProcessingOptions const&);
-    void preload(LinkProcessingOptions&, Function<void(Fetch::Infrastructure::Response&)> process_response = {});
+    static void preconnect(LinkProcessingOptions const&);
+    static GC::Ptr<Fetch::Infrastructure::FetchController> preload(LinkProcessingOptions&, Function<void(Fetch::Infrastructure::Response&)> process_response = {});
 
     void process_linked_resource(bool success, Fetch::Infrastructure::Response const&, Core::ImmutableBytes const*);
     void process_icon_resource(bool success, Fetch::Infrastructure::Response const&, ByteBuffer);
     void process_stylesheet_resource(bool success, Fetch::Infrastructure::Response const&, ReadonlyBytes);
+    void create_and_load_style_sheet(Utf16View css_text, URL::URL const& location);
+    void finish_processing_stylesheet_resource();
 
     bool should_fetch_and_process_resource_type() const;
 
@@ -202,6 +213,7 @@ private:
     GC::Ptr<DOM::DOMTokenList> m_sizes;
     unsigned m_relationship { 0 };
     u64 m_current_fetch_generation { 0 };
+    bool m_has_pending_off_thread_style_sheet { false };
 
     // https://html.spec.whatwg.org/multipage/semantics.html#explicitly-enabled
     bool m_explicitly_enabled { false };
@@ -2739,8 +2739,7 @@ void HTMLMediaElement::update_audio_play_state()
         return;
 
     m_is_playing_audio = is_playing_audio;
-    document().page().client().page_did_change_audio_play_state(
-        m_is_playing_audio ? AudioPlayState::Playing : AudioPlayState::Paused);
+    document().page().did_change_audio_play_state({}, m_is_playing_audio ? AudioPlayState::Playing : AudioPlayState::Paused);
 }
 
 void HTMLMediaElement::set_show_poster(bool show_poster)
@@ -22,6 +22,7 @@
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/Fetch/Infrastructure/NetworkPartitionKey.h>
 #include <LibWeb/HTML/AudioTrackList.h>
 #include <LibWeb/HTML/HTMLVideoElement.h>
 #include <LibWeb/HTML/VideoTrack.h>
@@ -283,7 +284,8 @@ WebIDL::ExceptionOr<void> HTMLVideoElement::determine_element_poster_frame(Optio
                     if (!weak_self)
                         return;
                     finalize(*weak_self, nullptr);
-                });
+                },
+                Fetch::Infrastructure::determine_the_network_partition_key(weak_self->document().relevant_settings_object()).serialized_top_level_site());
         });
 
         VERIFY(response->body());
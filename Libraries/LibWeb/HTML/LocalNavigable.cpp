@@ -49,6 +49,7 @@
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLIFrameElement.h>
 #include <LibWeb/HTML/HTMLInputElement.h>
+#include <LibWeb/HTML/HTMLLinkElement.h>
 #include <LibWeb/HTML/HTMLParagraphElement.h>
 #include <LibWeb/HTML/History.h>
 #include <LibWeb/HTML/HistoryHandlingBehavior.h>
@@ -1699,7 +1700,14 @@ static void perform_navigation_params_fetch(JS::Realm& realm, GC::Ref<Navigation
     //    with processEarlyHintsResponse set to processEarlyHintsResponse as defined below, processResponse
     //    set to processResponse as defined below, and useParallelQueue set to true.
     if (!state_holder->fetch_controller) {
-        // FIXME: Let processEarlyHintsResponse be the following algorithm given a response earlyResponse:
+        // Let processEarlyHintsResponse be the following algorithm given a response earlyResponse:
+        auto process_early_hints_response = [state_holder](GC::Ref<Fetch::Infrastructure::Response> early_response) {
+            // 1. If commitEarlyHints is null, then set commitEarlyHints to the result of processing early hint headers
+            //    given earlyResponse and request's reserved client.
+            if (state_holder->commit_early_hints)
+                return;
+            state_holder->commit_early_hints = HTMLLinkElement::process_early_hint_headers(state_holder->navigable->heap(), early_response, state_holder->request->reserved_client());
+        };
 
         // Let processResponse be the following algorithm given a response fetchedResponse:
         auto process_response = [state_holder](GC::Ref<Fetch::Infrastructure::Response> fetch_response) {
@@ -1716,7 +1724,7 @@ static void perform_navigation_params_fetch(JS::Realm& realm, GC::Ref<Navigation
                 {
                     .process_request_body_chunk_length = {},
                     .process_request_end_of_body = {},
-                    .process_early_hints_response = {},
+                    .process_early_hints_response = move(process_early_hints_response),
                     .process_response = move(process_response),
                     .process_response_end_of_body = {},
                     .process_response_consume_body = {},
@@ -4340,7 +4348,10 @@ bool LocalNavigable::has_a_rendering_opportunity() const
     // or whether its active document's visibility state is "visible".
     // Rendering opportunities typically occur at regular intervals.
 
-    // FIXME: Return `false` here if we're an inactive browser tab.
+    // NB: Hidden documents, such as those in background tabs, aren't presented, so they don't get to render until they
+    //     become visible again.
+    if (auto document = active_document(); document && document->hidden())
+        return false;
     return true;
 }
 
@@ -4693,6 +4704,14 @@ void LocalNavigable::destroy_compositor_context()
     m_compositor_context.clear();
 }
 
+size_t LocalNavigable::display_list_byte_size() const
+{
+    auto byte_size = m_display_list_resource_storage.display_list_command_byte_size();
+    if (m_compositor_display_list)
+        byte_size += m_compositor_display_list->command_byte_size();
+    return byte_size;
+}
+
 void LocalNavigable::repaint_after_compositor_process_reconnect()
 {
     resolve_all_pending_async_scroll_operations();
@@ -4744,7 +4763,7 @@ void LocalNavigable::set_should_show_caret_hit_test_debug_overlay(bool value)
         child_navigable->set_should_show_caret_hit_test_debug_overlay(value);
 }
 
-bool LocalNavigable::record_display_list_and_scroll_state(PaintConfig paint_config, Gfx::IntRect* damage_rect)
+bool LocalNavigable::record_display_list_and_scroll_state(PaintConfig paint_config, Gfx::IntRect* damage_rect, Compositor::FrameTiming* frame_timing)
 {
     if (!has_compositor_context())
         return false;
@@ -4765,9 +4784,12 @@ bool LocalNavigable::record_display_list_and_scroll_state(PaintConfig paint_conf
     Painting::DisplayListResourceTransaction resource_transaction;
     Optional<Painting::AccumulatedVisualContextTree> visual_context_tree;
     if (should_record_display_list) {
+        auto paint_recording_start = MonotonicTime::now();
         display_list = document->record_display_list(paint_config, m_display_list_resource_storage, Painting::PaintCommandCacheMode::ReadWrite);
         if (!display_list)
             return false;
+        if (frame_timing)
+            frame_timing->record(Compositor::FrameTimingStage::PaintRecording, paint_recording_start, MonotonicTime::now());
         auto recorded_document_paintable = document->paintable();
         VERIFY(recorded_document_paintable);
         visual_context_tree = recorded_document_paintable->visual_context_tree();
@@ -4794,6 +4816,7 @@ bool LocalNavigable::record_display_list_and_scroll_state(PaintConfig paint_conf
     Gfx::IntRect surface_rect { {}, viewport_rect.size() };
     if (damage_rect)
         *damage_rect = surface_rect;
+    auto ipc_send_start = MonotonicTime::now();
     if (should_record_display_list) {
         if (damage_rect
             && m_compositor_display_list
@@ -4831,6 +4854,22 @@ bool LocalNavigable::record_display_list_and_scroll_state(PaintConfig paint_conf
         }
         compositor_context().update_scroll_state(move(scroll_state_snapshot));
     }
+    if (frame_timing)
+        frame_timing->record(Compositor::FrameTimingStage::IPCSend, ipc_send_start, MonotonicTime::now());
+
+    // Opacity and transform animations are also handed to the compositor, which keeps sampling them at the display's
+    // refresh rate even while this thread is busy. Unchanged samples are not sent again.
+    auto compositor_animations = document->compositor_animations();
+    auto compositor_animations_visual_context_tree_version = document_paintable->visual_context_tree().version();
+    Vector<u64> compositor_animation_ids;
+    compositor_animation_ids.ensure_capacity(compositor_animations.size());
+    for (auto const& compositor_animation : compositor_animations)
+        compositor_animation_ids.unchecked_append(compositor_animation.id);
+    if (compositor_animation_ids != m_compositor_animation_ids || compositor_animations_visual_context_tree_version != m_compositor_animations_visual_context_tree_version) {
+        compositor_context().update_compositor_animations(compositor_animations_visual_context_tree_version, move(compositor_animations));
+        m_compositor_animation_ids = move(compositor_animation_ids);
+        m_compositor_animations_visual_context_tree_version = compositor_animations_visual_context_tree_version;
+    }
     return true;
 }
 
@@ -4856,11 +4895,15 @@ void LocalNavigable::paint_next_frame()
 
     m_needs_repaint = false;
 
+    auto frame_timing = main_thread_event_loop().rendering_update_frame_timing();
+    frame_timing.frame_id = Compositor::FrameTimeline::the().allocate_frame_id();
+    frame_timing.context_id = compositor_context().id();
+
     Gfx::IntRect damage_rect;
-    if (!record_display_list_and_scroll_state(paint_config, &damage_rect))
+    if (!record_display_list_and_scroll_state(paint_config, &damage_rect, &frame_timing))
         return;
     viewport_rect = page().css_to_device_rect(this->viewport_rect()).to_type<int>();
-    compositor_context().present_frame(viewport_rect, damage_rect);
+    compositor_context().present_frame(viewport_rect, damage_rect, move(frame_timing));
 }
 
 void LocalNavigable::render_screenshot(Gfx::PaintingSurface& painting_surface, PaintConfig paint_config, Function<void()>&& callback)
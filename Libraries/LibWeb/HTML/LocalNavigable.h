@@ -281,11 +281,13 @@ public:
     bool has_pending_navigations() const { return !m_pending_navigations.is_empty(); }
     void clear_pending_navigations() { m_pending_navigations.clear(); }
 
-    bool record_display_list_and_scroll_state(PaintConfig, Gfx::IntRect* damage_rect = nullptr);
+    bool record_display_list_and_scroll_state(PaintConfig, Gfx::IntRect* damage_rect = nullptr, Compositor::FrameTiming* = nullptr);
     void paint_next_frame();
     void render_screenshot(Gfx::PaintingSurface&, PaintConfig, Function<void()>&& callback);
     Painting::DisplayListResourceStorage& display_list_resource_storage() { return m_display_list_resource_storage; }
     Painting::DisplayListResourceStorage const& display_list_resource_storage() const { return m_display_list_resource_storage; }
+    // The commands of the display list last sent to the compositor, and of the nested display lists it refers to.
+    size_t display_list_byte_size() const;
 
     bool needs_repaint() const { return m_needs_repaint; }
     void set_needs_repaint() { m_needs_repaint = true; }
@@ -437,6 +439,8 @@ private:
     RefPtr<Painting::DisplayList> m_compositor_display_list;
     Optional<Painting::AccumulatedVisualContextTree> m_compositor_visual_context_tree;
     Optional<Painting::ScrollStateSnapshot> m_compositor_scroll_state_snapshot;
+    Vector<u64> m_compositor_animation_ids;
+    u64 m_compositor_animations_visual_context_tree_version { 0 };
     Painting::DisplayListResourceStorage m_display_list_resource_storage;
     Painting::DisplayListResourceSet m_compositor_display_list_resources;
     OwnPtr<Compositor::CompositorContextHandle> m_compositor_context;
@@ -17,6 +17,7 @@
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/Geolocation/GeolocationCoordinates.h>
+#include <LibWeb/HTML/BackForwardCache.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/BrowsingContextGroup.h>
 #include <LibWeb/HTML/DocumentState.h>
@@ -1158,6 +1159,21 @@ void ApplyHistoryStepState::start()
             bool needs_population = !m_pending_document
                 && (target_entry->document_state()->document_id() != navigable->active_document_id()
                     || target_entry->document_state()->reload_pending());
+
+            // AD-HOC: targetEntry's document is only non-null here if the back/forward cache kept it alive, in which
+            //         case it's reactivated instead of being populated again.
+            if (needs_population && !target_entry->document_state()->reload_pending()) {
+                if (auto document_id = target_entry->document_state()->document_id(); document_id.has_value() && navigable->is_top_level_traversable()) {
+                    if (auto cached_document = BackForwardCache::the().take(*document_id, *m_traversable, *target_entry)) {
+                        auto output = heap().allocate<PopulateSessionHistoryEntryDocumentOutput>();
+                        output->document = cached_document;
+                        output->save_extra_document_state = false;
+                        after_document_populated->function()(output);
+                        return;
+                    }
+                }
+            }
+
             if (needs_population) {
                 if (target_entry->document_state()->reload_pending() && navigable->is_top_level_traversable())
                     navigable->page().client().page_did_start_loading({}, target_entry->url(), Empty {}, false);
@@ -2135,6 +2151,9 @@ void LocalTraversableNavigable::clear_the_forward_session_history()
             }
         }
     }
+
+    // NB: Documents kept alive for the removed entries can never be traversed to again.
+    BackForwardCache::the().evict_documents_not_in_session_history_of(*this);
 }
 
 bool LocalTraversableNavigable::can_go_back() const
@@ -2512,7 +2531,8 @@ void LocalTraversableNavigable::destroy_top_level_traversable()
     auto browsing_context = active_browsing_context();
 
     // 2. For each historyEntry in traversable's session history entries:
-    // NOTE: Without bfcache, only the active document is alive, so we only need to destroy it.
+    // NOTE: Only the active document and the documents kept alive by the back/forward cache are alive.
+    BackForwardCache::the().evict_documents_for(*this);
     if (active_document())
         active_document()->destroy_a_document_and_its_descendants();
 
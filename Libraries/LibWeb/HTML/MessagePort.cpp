@@ -360,7 +360,7 @@ void MessagePort::drain_transport()
 
     auto schedule_shutdown = m_transport->read_as_many_messages_as_possible_without_blocking([this](auto&& raw_message) {
         FixedMemoryStream stream { raw_message.bytes.bytes() };
-        IPC::Decoder decoder { stream, raw_message.attachments };
+        IPC::Decoder decoder { stream, raw_message.attachments, raw_message.bytes };
 
         m_pending_incoming_messages.append(MUST(decoder.decode<SerializedTransferRecord>()));
     });
@@ -46,6 +46,7 @@
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
+#include <LibWeb/HTML/Parser/SimpleHTMLFragmentParser.h>
 #include <LibWeb/HTML/Parser/ParserScriptingMode.h>
 #include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
@@ -195,6 +196,12 @@ void HTMLParser::initialize(JS::Realm& realm)
     Base::initialize(realm);
 }
 
+NonnullOwnPtr<SpeculativeHTMLTokenizer> HTMLParser::create_speculative_tokenizer()
+{
+    auto* tokenizer = rust_html_speculative_tokenizer_create(m_tokenizer.ffi_handle({}), m_rust_parser, m_scripting_mode != ParserScriptingMode::Disabled);
+    return make<SpeculativeHTMLTokenizer>(tokenizer);
+}
+
 void HTMLParser::run(HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point)
 {
     m_stop_parsing = false;
@@ -1074,6 +1081,12 @@ WebIDL::ExceptionOr<GC::Ref<DOM::DocumentFragment>> HTMLParser::parse_html_fragm
     // 3. Assert: context is non-null.
     VERIFY(context);
 
+    // OPTIMIZATION: Most fragments only contain plain text and simple elements, whose tree construction we can do
+    //               without setting up a temporary document and a full parser.
+    auto target_node = target.visit([](auto node) -> GC::Ref<DOM::Node> { return node; });
+    if (auto fragment = try_parse_simple_html_fragment(*context, target_node, input))
+        return *fragment;
+
     // 4. Let document be a Document node whose type is "html".
     auto temp_document = DOM::Document::create(context->realm());
     temp_document->set_document_type(DOM::Document::Type::HTML);
@@ -1148,8 +1161,6 @@ WebIDL::ExceptionOr<GC::Ref<DOM::DocumentFragment>> HTMLParser::parse_html_fragm
         // Leave the tokenizer in the data state.
     }
 
-    auto target_node = target.visit([](auto node) -> GC::Ref<DOM::Node> { return node; });
-
     // 12. Let root be the result of creating an element given document, "html", the HTML namespace, null, null, false,
     //     and the result of looking up a custom element registry given target.
     auto root_registry = look_up_a_custom_element_registry(target_node);
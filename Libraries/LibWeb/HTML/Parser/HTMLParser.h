@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Utf16String.h>
 #include <AK/Utf16View.h>
 #include <LibGfx/Color.h>
@@ -78,6 +79,9 @@ public:
 
     HTMLTokenizer& tokenizer() { return m_tokenizer; }
 
+    // Creates a tokenizer that runs ahead of ours from its current state, guessing the state switches we will make.
+    NonnullOwnPtr<SpeculativeHTMLTokenizer> create_speculative_tokenizer();
+
     void set_allow_declarative_shadow_roots(AllowDeclarativeShadowRoots allow) { m_allow_declarative_shadow_roots = allow; }
 
     void configure_element_created_by_rust_parser(DOM::Element&);
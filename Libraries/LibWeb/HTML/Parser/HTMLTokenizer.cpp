@@ -229,6 +229,11 @@ void HTMLTokenizer::append_to_input_stream(Utf16View input)
     rust_html_tokenizer_append_input(m_tokenizer, code_points.data(), code_points.size());
 }
 
+void HTMLTokenizer::append_speculated_tokens(SpeculatedHTMLTokens tokens)
+{
+    rust_html_tokenizer_append_speculated_tokens(m_tokenizer, tokens.leak_ffi_handle());
+}
+
 void HTMLTokenizer::close_input_stream()
 {
     m_input_stream_closed = true;
@@ -289,4 +294,44 @@ void HTMLTokenizer::switch_to(State new_state)
     rust_html_tokenizer_switch_state(m_tokenizer, static_cast<uint8_t>(new_state));
 }
 
+SpeculatedHTMLTokens& SpeculatedHTMLTokens::operator=(SpeculatedHTMLTokens&& other)
+{
+    if (this != &other) {
+        rust_html_speculated_token_batch_destroy(m_batch);
+        m_batch = exchange(other.m_batch, nullptr);
+    }
+    return *this;
+}
+
+SpeculatedHTMLTokens::~SpeculatedHTMLTokens()
+{
+    rust_html_speculated_token_batch_destroy(m_batch);
+}
+
+SpeculativeHTMLTokenizer::SpeculativeHTMLTokenizer(RustFfiSpeculativeTokenizerHandle* tokenizer)
+    : m_tokenizer(tokenizer)
+{
+    VERIFY(m_tokenizer);
+}
+
+SpeculativeHTMLTokenizer::~SpeculativeHTMLTokenizer()
+{
+    rust_html_speculative_tokenizer_destroy(m_tokenizer);
+}
+
+SpeculatedHTMLTokens SpeculativeHTMLTokenizer::tokenize(Utf16View input, bool is_end_of_input)
+{
+    if (input.has_ascii_storage()) {
+        auto bytes = input.bytes();
+        return SpeculatedHTMLTokens { rust_html_speculative_tokenizer_tokenize(m_tokenizer, bytes.data(), bytes.size(), is_end_of_input) };
+    }
+    auto code_units = input.utf16_span();
+    return SpeculatedHTMLTokens { rust_html_speculative_tokenizer_tokenize_utf16(m_tokenizer, reinterpret_cast<u16 const*>(code_units.data()), code_units.size(), is_end_of_input) };
+}
+
+bool SpeculativeHTMLTokenizer::is_current_for(HTMLTokenizer const& tokenizer) const
+{
+    return rust_html_speculative_tokenizer_is_current(m_tokenizer, tokenizer.ffi_handle());
+}
+
 }
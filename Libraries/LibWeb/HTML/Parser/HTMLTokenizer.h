@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Noncopyable.h>
 #include <AK/Types.h>
 #include <AK/Utf16String.h>
 #include <AK/Utf16View.h>
@@ -14,10 +15,13 @@
 #include <LibWeb/HTML/Parser/HTMLToken.h>
 
 struct RustFfiTokenizerHandle;
+struct RustFfiSpeculativeTokenizerHandle;
+struct RustFfiSpeculatedTokenBatchHandle;
 
 namespace Web::HTML {
 
 class HTMLParser;
+class SpeculatedHTMLTokens;
 
 #define ENUMERATE_TOKENIZER_STATES                                        \
     __ENUMERATE_TOKENIZER_STATE(Data)                                     \
@@ -127,6 +131,9 @@ public:
     Utf16String unparsed_input() const;
 
     void append_to_input_stream(Utf16View input);
+    // Appends the input a speculative tokenizer has tokenized ahead of us, and hands out its tokens for as long as
+    // the tree builder agrees with the state switches it guessed.
+    void append_speculated_tokens(SpeculatedHTMLTokens);
     void close_input_stream();
     bool is_input_stream_closed() const { return m_input_stream_closed; }
     void insert_input_at_insertion_point(Utf16View input);
@@ -146,6 +153,7 @@ public:
 
     void parser_did_run(Badge<HTMLParser>);
     RustFfiTokenizerHandle* ffi_handle(Badge<HTMLParser>) { return m_tokenizer; }
+    RustFfiTokenizerHandle const* ffi_handle() const { return m_tokenizer; }
 
 private:
     static char const* state_name(State state)
@@ -167,4 +175,47 @@ private:
     RustFfiTokenizerHandle* m_tokenizer { nullptr };
 };
 
+// The tokens a speculative tokenizer produced for one chunk of input, along with that input.
+class WEB_API SpeculatedHTMLTokens {
+    AK_MAKE_NONCOPYABLE(SpeculatedHTMLTokens);
+
+public:
+    explicit SpeculatedHTMLTokens(RustFfiSpeculatedTokenBatchHandle* batch)
+        : m_batch(batch)
+    {
+    }
+    SpeculatedHTMLTokens(SpeculatedHTMLTokens&& other)
+        : m_batch(exchange(other.m_batch, nullptr))
+    {
+    }
+    SpeculatedHTMLTokens& operator=(SpeculatedHTMLTokens&&);
+    ~SpeculatedHTMLTokens();
+
+    RustFfiSpeculatedTokenBatchHandle* leak_ffi_handle() { return exchange(m_batch, nullptr); }
+
+private:
+    RustFfiSpeculatedTokenBatchHandle* m_batch { nullptr };
+};
+
+// Tokenizes input ahead of an HTMLTokenizer, starting out from its state at the time of creation and guessing the state
+// switches its tree builder will make. Unlike HTMLTokenizer, this may be used off the main thread, as long as only one
+// thread uses it at a time.
+class WEB_API SpeculativeHTMLTokenizer {
+    AK_MAKE_NONCOPYABLE(SpeculativeHTMLTokenizer);
+    AK_MAKE_NONMOVABLE(SpeculativeHTMLTokenizer);
+
+public:
+    explicit SpeculativeHTMLTokenizer(RustFfiSpeculativeTokenizerHandle*);
+    ~SpeculativeHTMLTokenizer();
+
+    SpeculatedHTMLTokens tokenize(Utf16View input, bool is_end_of_input);
+
+    // Whether the given tokenizer still accepts our tokens. Once it has rolled back or switched to a newer speculative
+    // tokenizer, our tokens will never line up with its state again.
+    bool is_current_for(HTMLTokenizer const&) const;
+
+private:
+    RustFfiSpeculativeTokenizerHandle* m_tokenizer { nullptr };
+};
+
 }
@@ -6,11 +6,17 @@
 
 #include <AK/Debug.h>
 #include <AK/StringView.h>
+#include <AK/Utf16StringBuilder.h>
+#include <LibCore/EventLoop.h>
 #include <LibGC/Function.h>
+#include <LibGC/Root.h>
 #include <LibJS/Runtime/Value.h>
 #include <LibTextCodec/Decoder.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/HTML/HTMLLinkElement.h>
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Parser/IncrementalDocumentParser.h>
@@ -42,6 +48,7 @@ void IncrementalDocumentParser::visit_edges(Cell::Visitor& visitor)
     Base::visit_edges(visitor);
     visitor.visit(m_document);
     visitor.visit(m_body);
+    visitor.visit(m_link_header_response);
     visitor.visit(m_parser);
 }
 
@@ -123,12 +130,6 @@ bool IncrementalDocumentParser::should_continue() const
     return m_parser && !m_parser->aborted() && m_document->parser() == m_parser;
 }
 
-void IncrementalDocumentParser::append_decoded(Utf16View decoded)
-{
-    m_source.append(decoded);
-    m_parser->tokenizer().append_to_input_stream(decoded);
-}
-
 void IncrementalDocumentParser::process_body_chunk(ByteBuffer bytes)
 {
     if (!should_continue())
@@ -138,9 +139,10 @@ void IncrementalDocumentParser::process_body_chunk(ByteBuffer bytes)
     // Each task that the networking task source places on the task queue while fetching runs must
     // fill the parser's input byte stream with the fetched bytes and cause the HTML parser to
     // perform the appropriate processing of the input stream.
-    auto decoded = m_decoder->to_utf16(bytes.bytes()).release_value_but_fixme_should_propagate_errors();
-    append_decoded(decoded);
-    pump();
+    // OPTIMIZATION: The bytes are decoded and tokenized on a background thread first, and the parser then processes
+    //               them once they reach its input stream in did_tokenize_input().
+    m_pending_bytes.append(bytes.bytes());
+    tokenize_pending_input();
 }
 
 void IncrementalDocumentParser::process_end_of_body()
@@ -148,13 +150,86 @@ void IncrementalDocumentParser::process_end_of_body()
     if (!should_continue())
         return;
 
-    auto decoded = m_decoder->finish_to_utf16().release_value_but_fixme_should_propagate_errors();
-    append_decoded(decoded);
+    m_received_end_of_body = true;
+    tokenize_pending_input();
+}
 
-    // https://html.spec.whatwg.org/multipage/document-lifecycle.html#read-html
-    // When no more bytes are available, have the parser process the implied EOF character.
-    m_document->set_source(m_source.to_string());
-    m_parser->tokenizer().close_input_stream();
+void IncrementalDocumentParser::tokenize_pending_input()
+{
+    if (m_is_tokenizing_in_background || !should_continue())
+        return;
+    if (m_pending_bytes.is_empty() && !m_received_end_of_body)
+        return;
+
+    // NB: Once our tokenizer has rolled back, or document.write() has inserted input into it, the speculative
+    //     tokenizer's tokens no longer line up with it. Start a new one from wherever our tokenizer is now.
+    if (!m_speculative_tokenizer || !m_speculative_tokenizer->is_current_for(m_parser->tokenizer()))
+        m_speculative_tokenizer = m_parser->create_speculative_tokenizer();
+
+    struct PendingTokenization {
+        GC::Root<IncrementalDocumentParser> parser;
+        ByteBuffer bytes;
+        bool is_end_of_body { false };
+        NonnullOwnPtr<TextCodec::StreamingDecoder> decoder;
+        NonnullOwnPtr<SpeculativeHTMLTokenizer> tokenizer;
+        Utf16String decoded;
+        Optional<SpeculatedHTMLTokens> tokens;
+    };
+
+    // The decoder and the speculative tokenizer belong to the background thread until the chunk comes back. The root
+    // is only created and destroyed on the main thread.
+    auto* pending = new PendingTokenization {
+        .parser = GC::make_root(*this),
+        .bytes = move(m_pending_bytes),
+        .is_end_of_body = exchange(m_received_end_of_body, false),
+        .decoder = m_decoder.release_nonnull(),
+        .tokenizer = m_speculative_tokenizer.release_nonnull(),
+        .decoded = {},
+        .tokens = {},
+    };
+    m_is_tokenizing_in_background = true;
+
+    auto& main_thread_event_loop = Core::EventLoop::current();
+
+    Threading::ThreadPool::the().submit([pending, &main_thread_event_loop]() {
+        auto decoded = pending->decoder->to_utf16(pending->bytes.bytes()).release_value_but_fixme_should_propagate_errors();
+        if (pending->is_end_of_body) {
+            Utf16StringBuilder builder;
+            builder.append(decoded.utf16_view());
+            builder.append(pending->decoder->finish_to_utf16().release_value_but_fixme_should_propagate_errors().utf16_view());
+            decoded = builder.to_string();
+        }
+        pending->tokens = pending->tokenizer->tokenize(decoded.utf16_view(), pending->is_end_of_body);
+        pending->decoded = move(decoded);
+
+        main_thread_event_loop.deferred_invoke([pending]() {
+            pending->parser->did_tokenize_input(move(pending->decoder), move(pending->tokenizer), move(pending->decoded), pending->tokens.release_value(), pending->is_end_of_body);
+            delete pending;
+        });
+    },
+        Threading::TaskPriority::UserBlocking);
+}
+
+void IncrementalDocumentParser::did_tokenize_input(NonnullOwnPtr<TextCodec::StreamingDecoder> decoder, NonnullOwnPtr<SpeculativeHTMLTokenizer> tokenizer, Utf16String decoded, SpeculatedHTMLTokens tokens, bool is_end_of_body)
+{
+    m_is_tokenizing_in_background = false;
+    m_decoder = move(decoder);
+    m_speculative_tokenizer = move(tokenizer);
+
+    if (!should_continue())
+        return;
+
+    m_source.append(decoded.utf16_view());
+    m_parser->tokenizer().append_speculated_tokens(move(tokens));
+
+    if (is_end_of_body) {
+        // https://html.spec.whatwg.org/multipage/document-lifecycle.html#read-html
+        // When no more bytes are available, have the parser process the implied EOF character.
+        m_document->set_source(m_source.to_string());
+        m_parser->tokenizer().close_input_stream();
+    }
+
+    tokenize_pending_input();
     pump();
 }
 
@@ -188,9 +263,9 @@ void IncrementalDocumentParser::pump()
     if (m_parser->stopped())
         return;
 
-    // FIXME: Process link headers (read-html step 3, third paragraph) after the first parser pass.
     if (m_parser->tokenizer().is_input_stream_closed()) {
         m_parser->run_until_completion();
+        process_media_link_headers();
         return;
     }
 
@@ -198,6 +273,17 @@ void IncrementalDocumentParser::pump()
         return;
 
     m_parser->run();
+    process_media_link_headers();
+}
+
+void IncrementalDocumentParser::process_media_link_headers()
+{
+    // https://html.spec.whatwg.org/multipage/document-lifecycle.html#read-html
+    // The first task that the networking task source places on the task queue while fetching runs must process link
+    // headers given document, navigationParams's response, and "media", after the task has been processed by the HTML
+    // parser.
+    if (auto response = exchange(m_link_header_response, nullptr))
+        HTMLLinkElement::process_link_headers(m_document, *response, HTMLLinkElement::LinkHeaderPhase::Media);
 }
 
 }
@@ -30,6 +30,7 @@ public:
 
     void start();
     void set_allow_declarative_shadow_roots(HTMLParser::AllowDeclarativeShadowRoots);
+    void set_link_header_response(GC::Ref<Fetch::Infrastructure::Response const> response) { m_link_header_response = response; }
 
 private:
     IncrementalDocumentParser(GC::Ref<DOM::Document>, GC::Ref<Fetch::Infrastructure::Body>, URL::URL, Optional<MimeSniff::MimeType>);
@@ -42,10 +43,12 @@ private:
     void process_end_of_body();
     void process_body_error(JS::Value);
 
-    void append_decoded(Utf16View);
+    void tokenize_pending_input();
+    void did_tokenize_input(NonnullOwnPtr<TextCodec::StreamingDecoder>, NonnullOwnPtr<SpeculativeHTMLTokenizer>, Utf16String decoded, SpeculatedHTMLTokens, bool is_end_of_body);
     void pump();
     void register_deferred_start();
     bool should_continue() const;
+    void process_media_link_headers();
 
     GC::Ref<DOM::Document> m_document;
     GC::Ref<Fetch::Infrastructure::Body> m_body;
@@ -53,9 +56,19 @@ private:
     Optional<MimeSniff::MimeType> m_mime_type;
     HTMLParser::AllowDeclarativeShadowRoots m_allow_declarative_shadow_roots { HTMLParser::AllowDeclarativeShadowRoots::Yes };
 
+    // Cleared once its Link headers have been processed after the first parser pass.
+    GC::Ptr<Fetch::Infrastructure::Response const> m_link_header_response;
+
     GC::Ptr<HTMLParser> m_parser;
     OwnPtr<TextCodec::StreamingDecoder> m_decoder;
 
+    // Body bytes are decoded and tokenized on a background thread, ahead of the tree builder, one chunk at a time.
+    // Whatever arrives while a chunk is being tokenized waits here for the next one.
+    ByteBuffer m_pending_bytes;
+    bool m_received_end_of_body { false };
+    bool m_is_tokenizing_in_background { false };
+    OwnPtr<SpeculativeHTMLTokenizer> m_speculative_tokenizer;
+
     Utf16StringBuilder m_source;
 };
 
@@ -27,6 +27,7 @@ enum SearchState {
 /// rejected character (returns false), call `code_points()` to get the longest
 /// match found so far, and `overconsumed_code_points()` to know how many
 /// characters were consumed past the longest match.
+#[derive(Clone)]
 pub struct NamedCharacterReferenceMatcher {
     search_state: SearchState,
     last_matched_unique_index: u16,
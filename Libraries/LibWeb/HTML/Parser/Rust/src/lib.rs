@@ -8,6 +8,8 @@ pub mod entities;
 pub mod interned_names;
 pub mod parser;
 pub mod preload_scanner;
+pub mod speculative_tokenizer;
+pub mod subresource_scanner;
 pub mod token;
 pub mod tokenizer;
 
@@ -210,6 +212,13 @@ fn decode_utf8_to_u32(bytes: &[u8]) -> Vec<u32> {
     out
 }
 
+/// Decode UTF-16 code units to UTF-32 code points, replacing unpaired surrogates with U+FFFD.
+fn decode_utf16_to_u32(code_units: &[u16]) -> Vec<u32> {
+    std::char::decode_utf16(code_units.iter().copied())
+        .map(|result| result.map_or(std::char::REPLACEMENT_CHARACTER as u32, |code_point| code_point as u32))
+        .collect()
+}
+
 fn make_handle(tokenizer: HtmlTokenizer) -> *mut RustFfiTokenizerHandle {
     let handle = Box::new(RustFfiTokenizerHandle {
         tokenizer,
@@ -352,6 +352,16 @@ impl ParserState {
         }
     }
 
+    fn adjusted_current_node(&self) -> Option<&StackNode> {
+        // The adjusted current node is the context element if the parser was created as part of the HTML fragment parsing
+        // algorithm and the stack of open elements has only one element in it (fragment case); otherwise, the adjusted
+        // current node is the current node.
+        if self.parsing_fragment && self.stack_of_open_elements.len() == 1 {
+            return self.context_element.as_ref();
+        }
+        self.stack_of_open_elements.last()
+    }
+
     // https://html.spec.whatwg.org/multipage/parsing.html#parsing-html-fragments
     fn begin_fragment(&mut self, fragment_context: FragmentParsingContext) {
         let context_namespace = fragment_context.context_element.namespace_;
@@ -3028,16 +3038,6 @@ impl TreeBuilder {
     }
 
     // https://html.spec.whatwg.org/multipage/parsing.html#adjusted-current-node
-    fn adjusted_current_node(&self) -> Option<&StackNode> {
-        // The adjusted current node is the context element if the parser was created as part of the HTML fragment parsing
-        // algorithm and the stack of open elements has only one element in it (fragment case); otherwise, the adjusted
-        // current node is the current node.
-        if self.parsing_fragment && self.stack_of_open_elements.len() == 1 {
-            return self.context_element.as_ref();
-        }
-        self.stack_of_open_elements.last()
-    }
-
     // https://html.spec.whatwg.org/multipage/parsing.html#insert-an-html-element
     fn insert_html_element_named(&mut self, name: &str) -> usize {
         // To insert an HTML element given a token token: insert a foreign element given token, the HTML namespace, and false.
@@ -4837,7 +4837,7 @@ fn is_scope_boundary(node: &StackNode) -> bool {
         || (node.namespace_ == RustFfiHtmlNamespace::MathMl && node.local_name == "annotation-xml")
 }
 
-fn is_foreign_content_breakout_token(token: &Token) -> bool {
+pub(crate) fn is_foreign_content_breakout_token(token: &Token) -> bool {
     // -> A start tag whose tag name is one of: "b", "big", "blockquote", "body", "br", "center", "code", "dd", "div", "dl", "dt", "em", "embed", "h1", "h2", "h3", "h4", "h5", "h6", "head", "hr", "i", "img", "li", "listing", "menu", "meta", "nobr", "ol", "p", "pre", "ruby", "s", "small", "span", "strong", "strike", "sub", "sup", "table", "tt", "u", "ul", "var"
     if token.is_start_tag_one_of(&[
         "b",
@@ -5241,6 +5241,16 @@ pub unsafe extern "C" fn rust_html_parser_begin_fragment(
     });
 }
 
+impl RustFfiHtmlParserHandle {
+    /// Whether the adjusted current node is in a foreign namespace, which is when the tokenizer may produce CDATA
+    /// sections.
+    pub(crate) fn is_in_foreign_content(&self) -> bool {
+        self.state
+            .adjusted_current_node()
+            .is_some_and(|node| node.namespace_ != RustFfiHtmlNamespace::Html)
+    }
+}
+
 /// Run the Rust HTML parser.
 ///
 /// Returns `ExecuteScript` when tree construction reaches a parser-blocking script
@@ -5,6 +5,7 @@
  */
 
 use crate::decode_utf8_to_u32;
+use crate::decode_utf16_to_u32;
 use crate::token::Attribute;
 use crate::token::Token;
 use crate::token::TokenPayload;
@@ -38,6 +39,14 @@ pub enum RustFfiPreloadScannerCorsSetting {
     UseCredentials = 2,
 }
 
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+pub enum RustFfiPreloadScannerFetchPriority {
+    Auto = 0,
+    High = 1,
+    Low = 2,
+}
+
 #[repr(C)]
 pub struct RustFfiPreloadScannerEntry {
     pub action: RustFfiPreloadScannerAction,
@@ -45,6 +54,15 @@ pub struct RustFfiPreloadScannerEntry {
     pub url_len: usize,
     pub destination: RustFfiPreloadScannerDestination,
     pub cors_setting: RustFfiPreloadScannerCorsSetting,
+    pub fetch_priority: RustFfiPreloadScannerFetchPriority,
+    /// Whether the resource is a module script, whose static imports can be fetched speculatively as well.
+    pub is_module_script: bool,
+    /// The srcset and sizes attributes of an image, which the caller selects the URL to fetch from, using its viewport
+    /// and device pixel ratio. The URL above is the image's default source, and may be empty.
+    pub srcset_ptr: *const u8,
+    pub srcset_len: usize,
+    pub sizes_ptr: *const u8,
+    pub sizes_len: usize,
 }
 
 /// Scan pending parser input for resources the speculative HTML parser can fetch.
@@ -120,12 +138,6 @@ fn scan_code_points(code_points: Vec<u32>, callback: &mut impl FnMut(&RustFfiPre
     }
 }
 
-fn decode_utf16_to_u32(code_units: &[u16]) -> Vec<u32> {
-    std::char::decode_utf16(code_units.iter().copied())
-        .map(|result| result.map_or(std::char::REPLACEMENT_CHARACTER as u32, |code_point| code_point as u32))
-        .collect()
-}
-
 fn process_start_tag(
     token: &Token,
     template_depth: &mut u64,
@@ -178,13 +190,12 @@ fn process_base(attributes: &[Attribute], callback: &mut impl FnMut(&RustFfiPrel
         return true;
     }
 
-    emit_entry(
-        callback,
+    PreloadEntry::new(
         RustFfiPreloadScannerAction::Base,
         href,
         RustFfiPreloadScannerDestination::None,
-        RustFfiPreloadScannerCorsSetting::NoCors,
     )
+    .emit(callback)
 }
 
 fn process_script(attributes: &[Attribute], callback: &mut impl FnMut(&RustFfiPreloadScannerEntry) -> bool) -> bool {
@@ -195,13 +206,14 @@ fn process_script(attributes: &[Attribute], callback: &mut impl FnMut(&RustFfiPr
         return true;
     }
 
-    emit_entry(
-        callback,
-        RustFfiPreloadScannerAction::Fetch,
-        src,
-        RustFfiPreloadScannerDestination::Script,
-        cors_setting_from_attribute(attributes),
-    )
+    let is_module_script =
+        attribute_value(attributes, b"type").is_some_and(|type_| type_.eq_ignore_ascii_case("module"));
+    let mut entry = PreloadEntry::fetch(src, RustFfiPreloadScannerDestination::Script, attributes);
+    if is_module_script {
+        entry.cors_setting = module_script_cors_setting_from_attribute(attributes);
+        entry.is_module_script = true;
+    }
+    entry.emit(callback)
 }
 
 fn process_link(attributes: &[Attribute], callback: &mut impl FnMut(&RustFfiPreloadScannerEntry) -> bool) -> bool {
@@ -216,58 +228,102 @@ fn process_link(attributes: &[Attribute], callback: &mut impl FnMut(&RustFfiPrel
         return true;
     };
 
-    let destination = if rel_contains_keyword(rel.as_bytes(), b"stylesheet") {
-        RustFfiPreloadScannerDestination::Style
+    let mut entry = if rel_contains_keyword(rel.as_bytes(), b"stylesheet") {
+        PreloadEntry::fetch(href, RustFfiPreloadScannerDestination::Style, attributes)
     } else if rel_contains_keyword(rel.as_bytes(), b"preload") {
         let Some(destination) = translate_preload_destination(attribute_value(attributes, b"as")) else {
             return true;
         };
-        destination
+        PreloadEntry::fetch(href, destination, attributes)
+    } else if rel_contains_keyword(rel.as_bytes(), b"modulepreload") {
+        // https://html.spec.whatwg.org/multipage/links.html#link-type-modulepreload
+        // The as attribute defaults to "script", and the other script-like destinations are not fetched as scripts.
+        if attribute_value(attributes, b"as").is_some_and(|destination| !destination.eq_ignore_ascii_case("script")) {
+            return true;
+        }
+        let mut entry = PreloadEntry::fetch(href, RustFfiPreloadScannerDestination::Script, attributes);
+        entry.cors_setting = module_script_cors_setting_from_attribute(attributes);
+        entry.is_module_script = true;
+        entry
     } else {
         return true;
     };
 
-    emit_entry(
-        callback,
-        RustFfiPreloadScannerAction::Fetch,
-        href,
-        destination,
-        cors_setting_from_attribute(attributes),
-    )
+    // Render-blocking stylesheets hold up the first paint, so they go ahead of everything else we discover.
+    if entry.destination == RustFfiPreloadScannerDestination::Style
+        && entry.fetch_priority == RustFfiPreloadScannerFetchPriority::Auto
+    {
+        entry.fetch_priority = RustFfiPreloadScannerFetchPriority::High;
+    }
+    entry.emit(callback)
 }
 
 fn process_img(attributes: &[Attribute], callback: &mut impl FnMut(&RustFfiPreloadScannerEntry) -> bool) -> bool {
-    let Some(src) = attribute_value(attributes, b"src") else {
-        return true;
-    };
-    if src.is_empty() {
+    let src = attribute_value(attributes, b"src").unwrap_or_default();
+    let srcset = attribute_value(attributes, b"srcset").unwrap_or_default();
+    if src.is_empty() && srcset.is_empty() {
         return true;
     }
 
-    emit_entry(
-        callback,
-        RustFfiPreloadScannerAction::Fetch,
-        src,
-        RustFfiPreloadScannerDestination::Image,
-        cors_setting_from_attribute(attributes),
-    )
+    let mut entry = PreloadEntry::fetch(src, RustFfiPreloadScannerDestination::Image, attributes);
+    entry.srcset = srcset;
+    entry.sizes = attribute_value(attributes, b"sizes").unwrap_or_default();
+    entry.emit(callback)
 }
 
-fn emit_entry(
-    callback: &mut impl FnMut(&RustFfiPreloadScannerEntry) -> bool,
-    action: RustFfiPreloadScannerAction,
-    url: &str,
-    destination: RustFfiPreloadScannerDestination,
-    cors_setting: RustFfiPreloadScannerCorsSetting,
-) -> bool {
-    let entry = RustFfiPreloadScannerEntry {
-        action,
-        url_ptr: url.as_ptr(),
-        url_len: url.len(),
-        destination,
-        cors_setting,
-    };
-    callback(&entry)
+/// A resource to report to the caller, whose strings borrow from the token it was found in.
+pub(crate) struct PreloadEntry<'a> {
+    pub(crate) action: RustFfiPreloadScannerAction,
+    pub(crate) url: &'a str,
+    pub(crate) destination: RustFfiPreloadScannerDestination,
+    pub(crate) cors_setting: RustFfiPreloadScannerCorsSetting,
+    pub(crate) fetch_priority: RustFfiPreloadScannerFetchPriority,
+    pub(crate) is_module_script: bool,
+    pub(crate) srcset: &'a str,
+    pub(crate) sizes: &'a str,
+}
+
+impl<'a> PreloadEntry<'a> {
+    pub(crate) fn new(
+        action: RustFfiPreloadScannerAction,
+        url: &'a str,
+        destination: RustFfiPreloadScannerDestination,
+    ) -> Self {
+        Self {
+            action,
+            url,
+            destination,
+            cors_setting: RustFfiPreloadScannerCorsSetting::NoCors,
+            fetch_priority: RustFfiPreloadScannerFetchPriority::Auto,
+            is_module_script: false,
+            srcset: "",
+            sizes: "",
+        }
+    }
+
+    fn fetch(url: &'a str, destination: RustFfiPreloadScannerDestination, attributes: &[Attribute]) -> Self {
+        let mut entry = Self::new(RustFfiPreloadScannerAction::Fetch, url, destination);
+        entry.cors_setting = cors_setting_from_attribute(attributes);
+        entry.fetch_priority = fetch_priority_from_attribute(attributes);
+        entry
+    }
+
+    pub(crate) fn emit(&self, callback: &mut impl FnMut(&RustFfiPreloadScannerEntry) -> bool) -> bool {
+        let entry = RustFfiPreloadScannerEntry {
+            action: self.action,
+            url_ptr: self.url.as_ptr(),
+            url_len: self.url.len(),
+            destination: self.destination,
+            cors_setting: self.cors_setting,
+            fetch_priority: self.fetch_priority,
+            is_module_script: self.is_module_script,
+            srcset_ptr: self.srcset.as_ptr(),
+            srcset_len: self.srcset.len(),
+            sizes_ptr: self.sizes.as_ptr(),
+            sizes_len: self.sizes.len(),
+        };
+        callback(&entry)
+    }
 }
 
 fn attribute_value<'a>(attributes: &'a [Attribute], name: &[u8]) -> Option<&'a str> {
@@ -306,6 +362,30 @@ fn cors_setting_from_attribute(attributes: &[Attribute]) -> RustFfiPreloadScanne
     }
 }
 
+// https://html.spec.whatwg.org/multipage/urls-and-fetching.html#cors-settings-attributes
+// Module scripts are always fetched in CORS mode, so a missing attribute means "anonymous" for them.
+fn module_script_cors_setting_from_attribute(attributes: &[Attribute]) -> RustFfiPreloadScannerCorsSetting {
+    match cors_setting_from_attribute(attributes) {
+        RustFfiPreloadScannerCorsSetting::NoCors => RustFfiPreloadScannerCorsSetting::Anonymous,
+        cors_setting => cors_setting,
+    }
+}
+
+// https://html.spec.whatwg.org/multipage/urls-and-fetching.html#fetch-priority-attributes
+fn fetch_priority_from_attribute(attributes: &[Attribute]) -> RustFfiPreloadScannerFetchPriority {
+    let Some(fetch_priority) = attribute_value(attributes, b"fetchpriority") else {
+        return RustFfiPreloadScannerFetchPriority::Auto;
+    };
+
+    if fetch_priority.eq_ignore_ascii_case("high") {
+        RustFfiPreloadScannerFetchPriority::High
+    } else if fetch_priority.eq_ignore_ascii_case("low") {
+        RustFfiPreloadScannerFetchPriority::Low
+    } else {
+        RustFfiPreloadScannerFetchPriority::Auto
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -483,4 +563,81 @@ mod tests {
             ]
         );
     }
+
+    #[test]
+    fn reports_module_scripts_image_candidates_and_fetch_priorities() {
+        let mut entries = Vec::new();
+        scan(
+            br#"
+                <link rel="modulepreload" href="./module.js">
+                <link rel="modulepreload" as="worker" href="./worker.js">
+                <script type="module" src="./main.js" crossorigin="use-credentials"></script>
+                <link rel="stylesheet" href="./style.css">
+                <img srcset="./small.png 1x, ./large.png 2x" sizes="50vw" fetchpriority="high">
+                <img src="./lazy.png" fetchpriority="LOW">
+            "#,
+            |entry| {
+                let string = |ptr: *const u8, len: usize| unsafe {
+                    std::str::from_utf8(std::slice::from_raw_parts(ptr, len))
+                        .unwrap()
+                        .to_string()
+                };
+                entries.push((
+                    string(entry.url_ptr, entry.url_len),
+                    entry.cors_setting,
+                    entry.fetch_priority,
+                    entry.is_module_script,
+                    string(entry.srcset_ptr, entry.srcset_len),
+                    string(entry.sizes_ptr, entry.sizes_len),
+                ));
+                true
+            },
+        );
+
+        assert_eq!(
+            entries,
+            vec![
+                (
+                    "./module.js".to_string(),
+                    RustFfiPreloadScannerCorsSetting::Anonymous,
+                    RustFfiPreloadScannerFetchPriority::Auto,
+                    true,
+                    String::new(),
+                    String::new(),
+                ),
+                (
+                    "./main.js".to_string(),
+                    RustFfiPreloadScannerCorsSetting::UseCredentials,
+                    RustFfiPreloadScannerFetchPriority::Auto,
+                    true,
+                    String::new(),
+                    String::new(),
+                ),
+                (
+                    "./style.css".to_string(),
+                    RustFfiPreloadScannerCorsSetting::NoCors,
+                    RustFfiPreloadScannerFetchPriority::High,
+                    false,
+                    String::new(),
+                    String::new(),
+                ),
+                (
+                    String::new(),
+                    RustFfiPreloadScannerCorsSetting::NoCors,
+                    RustFfiPreloadScannerFetchPriority::High,
+                    false,
+                    "./small.png 1x, ./large.png 2x".to_string(),
+                    "50vw".to_string(),
+                ),
+                (
+                    "./lazy.png".to_string(),
+                    RustFfiPreloadScannerCorsSetting::NoCors,
+                    RustFfiPreloadScannerFetchPriority::Low,
+                    false,
+                    String::new(),
+                    String::new(),
+                ),
+            ]
+        );
+    }
 }
@@ -0,0 +1,595 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+//! Tokenization ahead of the tree builder.
+//!
+//! A speculative tokenizer starts out as a copy of a document's tokenizer, and tokenizes the input that arrives after
+//! that on a background thread. The tree builder can't run there, so it guesses what the tree builder will do that
+//! affects the tokenizer: which state it switches to after start tags like <script> or <textarea>, and whether CDATA
+//! sections are allowed. The batches of tokens it produces are handed back to the document's tokenizer, which gives
+//! them to the tree builder one at a time and checks each guess against what the tree builder actually does. As soon
+//! as a guess turns out to be wrong, or document.write() inserts input, the remaining tokens are thrown away and the
+//! document's tokenizer carries on by itself from right after the last token it handed out.
+
+use crate::RustFfiTokenizerHandle;
+use crate::decode_utf8_to_u32;
+use crate::decode_utf16_to_u32;
+use crate::parser::RustFfiHtmlParserHandle;
+use crate::parser::is_foreign_content_breakout_token;
+use crate::token::Token;
+use crate::token::TokenType;
+use crate::tokenizer::HtmlTokenizer;
+use crate::tokenizer::State;
+use crate::tokenizer::TokenizerCheckpoint;
+use std::collections::VecDeque;
+use std::ptr;
+
+// Character tokens don't get a checkpoint each, so getting to the state right after one means replaying the character
+// tokens since the last checkpoint. This bounds how many of them that can be.
+const MAX_TOKENS_BETWEEN_CHECKPOINTS: usize = 256;
+
+struct SpeculatedToken {
+    token: Token,
+    // The value of cdata_allowed the token was produced with, if the tokenizer looked at it.
+    cdata_allowed: Option<bool>,
+    // The state the tree builder was guessed to switch the tokenizer to after this token.
+    switched_to: Option<State>,
+    // The tokenizer state right after this token, before any switch.
+    checkpoint: Option<Box<TokenizerCheckpoint>>,
+}
+
+/// A batch of tokens produced by a speculative tokenizer, along with the input it was given to produce them.
+pub struct SpeculatedTokenBatch {
+    generation: u64,
+    code_points: Vec<u32>,
+    tokens: VecDeque<SpeculatedToken>,
+    // The state the speculative tokenizer was left in once it ran out of input.
+    end: Box<TokenizerCheckpoint>,
+}
+
+/// The speculated tokens that a tokenizer hands out instead of tokenizing its input itself.
+#[derive(Default)]
+pub(crate) struct Speculation {
+    tokens: VecDeque<SpeculatedToken>,
+    end: Option<Box<TokenizerCheckpoint>>,
+    // The cdata_allowed values of the tokens handed out since the last checkpoint was restored, which the tokenizer
+    // has to tokenize again to get to its actual state.
+    replay: Vec<bool>,
+    // The switch the tree builder is expected to make after the token that was handed out last.
+    expected_switch: Option<State>,
+}
+
+impl HtmlTokenizer {
+    fn start_speculation(&mut self) -> HtmlTokenizer {
+        self.abandon_speculation();
+        let copy = self.copy_for_speculation();
+        self.speculation = Some(Box::default());
+        self.speculation_generation += 1;
+        copy
+    }
+
+    /// Append the input of a speculated batch, and its tokens unless the speculation they belong to was abandoned.
+    pub(crate) fn append_speculated_tokens(&mut self, batch: SpeculatedTokenBatch) {
+        self.append_input(&batch.code_points);
+        if batch.generation != self.speculation_generation {
+            return;
+        }
+        let Some(speculation) = self.speculation.as_mut() else {
+            return;
+        };
+        speculation.tokens.extend(batch.tokens);
+        speculation.end = Some(batch.end);
+    }
+
+    pub(crate) fn next_speculated_token(
+        &mut self,
+        stop_at_insertion_point: bool,
+        cdata_allowed: bool,
+    ) -> Option<Token> {
+        let must_stop_at_insertion_point = stop_at_insertion_point && self.is_insertion_point_defined();
+        let speculation = self.speculation.as_mut()?;
+
+        // The tree builder didn't make the switch we guessed it would after the last token. Speculation also doesn't
+        // know where the insertion point is, so it can't be used by a parser that has to stop there.
+        if speculation.expected_switch.is_some() || must_stop_at_insertion_point {
+            self.abandon_speculation();
+            return None;
+        }
+
+        let Some(next) = speculation.tokens.front() else {
+            if let Some(end) = speculation.end.take() {
+                speculation.replay.clear();
+                self.restore_checkpoint(*end);
+            }
+            return None;
+        };
+
+        if next
+            .cdata_allowed
+            .is_some_and(|speculated_cdata_allowed| speculated_cdata_allowed != cdata_allowed)
+        {
+            self.abandon_speculation();
+            return None;
+        }
+
+        let speculated = speculation.tokens.pop_front()?;
+        speculation.expected_switch = speculated.switched_to;
+        match speculated.checkpoint {
+            Some(checkpoint) => {
+                speculation.replay.clear();
+                self.restore_checkpoint(*checkpoint);
+            }
+            None => speculation.replay.push(speculated.cdata_allowed.unwrap_or(false)),
+        }
+        Some(speculated.token)
+    }
+
+    /// Returns whether the tree builder made the switch we guessed it would after the last token.
+    pub(crate) fn confirm_speculated_switch(&mut self, state: State) -> bool {
+        self.speculation
+            .as_mut()
+            .is_some_and(|speculation| speculation.expected_switch.take() == Some(state))
+    }
+
+    /// Bring the tokenizer to the state right after the last token it handed out.
+    pub(crate) fn sync_speculation(&mut self) {
+        let Some(speculation) = self.speculation.as_mut() else {
+            return;
+        };
+        if speculation.replay.is_empty() {
+            return;
+        }
+
+        let mut replay = std::mem::take(&mut speculation.replay);
+        for cdata_allowed in replay.drain(..) {
+            let token = self.next_token_from_input(false, cdata_allowed);
+            debug_assert!(token.is_some());
+        }
+        if let Some(speculation) = self.speculation.as_mut() {
+            speculation.replay = replay;
+        }
+    }
+
+    /// Throw away the remaining speculated tokens, and carry on from right after the last token that was handed out.
+    pub(crate) fn abandon_speculation(&mut self) {
+        if self.speculation.is_none() {
+            return;
+        }
+        self.sync_speculation();
+        self.speculation = None;
+        self.speculation_generation += 1;
+    }
+}
+
+/// Tokenizes ahead of the tree builder, see the module documentation.
+pub struct SpeculativeTokenizer {
+    tokenizer: HtmlTokenizer,
+    generation: u64,
+    scripting_enabled: bool,
+    foreign_content_depth: u64,
+    tokens_since_checkpoint: usize,
+}
+
+impl SpeculativeTokenizer {
+    /// Start speculating ahead of `tokenizer`, from its current state.
+    pub fn new(tokenizer: &mut HtmlTokenizer, in_foreign_content: bool, scripting_enabled: bool) -> Self {
+        let speculative_tokenizer = tokenizer.start_speculation();
+        Self {
+            tokenizer: speculative_tokenizer,
+            generation: tokenizer.speculation_generation,
+            scripting_enabled,
+            foreign_content_depth: u64::from(in_foreign_content),
+            tokens_since_checkpoint: 0,
+        }
+    }
+
+    /// Whether `tokenizer` still accepts the tokens of this speculative tokenizer.
+    pub fn is_current_for(&self, tokenizer: &HtmlTokenizer) -> bool {
+        tokenizer.speculation.is_some() && tokenizer.speculation_generation == self.generation
+    }
+
+    /// Tokenize as much as possible after appending `code_points` to the input.
+    pub fn tokenize(&mut self, code_points: Vec<u32>, is_end_of_input: bool) -> SpeculatedTokenBatch {
+        self.tokenizer.append_input(&code_points);
+        if is_end_of_input {
+            self.tokenizer.set_input_stream_closed(true);
+        }
+
+        let mut tokens = VecDeque::new();
+        loop {
+            let cdata_allowed = self.foreign_content_depth > 0;
+            self.tokenizer.cdata_allowed_was_checked = false;
+            let Some(token) = self.tokenizer.next_token(false, cdata_allowed) else {
+                break;
+            };
+            let cdata_allowed = self.tokenizer.cdata_allowed_was_checked.then_some(cdata_allowed);
+
+            self.tokens_since_checkpoint += 1;
+            let checkpoint = if token.token_type != TokenType::Character
+                || self.tokens_since_checkpoint >= MAX_TOKENS_BETWEEN_CHECKPOINTS
+            {
+                self.tokens_since_checkpoint = 0;
+                Some(Box::new(self.tokenizer.checkpoint()))
+            } else {
+                None
+            };
+
+            let switched_to = self.guess_tree_builder_switch(&token);
+            if let Some(state) = switched_to {
+                self.tokenizer.switch_to(state);
+            }
+
+            let is_eof = token.token_type == TokenType::EndOfFile;
+            tokens.push_back(SpeculatedToken {
+                token,
+                cdata_allowed,
+                switched_to,
+                checkpoint,
+            });
+            if is_eof {
+                break;
+            }
+        }
+
+        let end = Box::new(self.tokenizer.checkpoint());
+        self.tokenizer.discard_consumed_input();
+        SpeculatedTokenBatch {
+            generation: self.generation,
+            code_points,
+            tokens,
+            end,
+        }
+    }
+
+    // Guess the state the tree builder switches the tokenizer to after a token, assuming ordinary markup: raw text
+    // elements always get their content tokenized as such, except in foreign content.
+    fn guess_tree_builder_switch(&mut self, token: &Token) -> Option<State> {
+        if self.foreign_content_depth > 0 && is_foreign_content_breakout_token(token) {
+            self.foreign_content_depth = 0;
+        }
+
+        match token.token_type {
+            TokenType::StartTag => {}
+            TokenType::EndTag => {
+                if self.foreign_content_depth > 0 && matches!(token.tag_name(), "svg" | "math") {
+                    self.foreign_content_depth -= 1;
+                }
+                return None;
+            }
+            _ => return None,
+        }
+
+        let tag_name = token.tag_name();
+        if matches!(tag_name, "svg" | "math") {
+            if !token.is_self_closing() {
+                self.foreign_content_depth += 1;
+            }
+            return None;
+        }
+        if self.foreign_content_depth > 0 {
+            return None;
+        }
+
+        match tag_name {
+            "script" => Some(State::ScriptData),
+            "style" | "xmp" | "iframe" | "noembed" | "noframes" => Some(State::RAWTEXT),
+            "noscript" if self.scripting_enabled => Some(State::RAWTEXT),
+            "title" | "textarea" => Some(State::RCDATA),
+            "plaintext" => Some(State::PLAINTEXT),
+            _ => None,
+        }
+    }
+}
+
+/// Opaque handle for a speculative tokenizer, passed across the FFI boundary.
+pub struct RustFfiSpeculativeTokenizerHandle {
+    tokenizer: SpeculativeTokenizer,
+}
+
+/// Opaque handle for a batch of speculated tokens, passed across the FFI boundary.
+pub struct RustFfiSpeculatedTokenBatchHandle {
+    batch: SpeculatedTokenBatch,
+}
+
+/// Start speculating ahead of a tokenizer, from its current state.
+///
+/// # Safety
+/// `tokenizer` must be a valid pointer from `rust_html_tokenizer_create`, and `parser` a valid
+/// pointer from `rust_html_parser_create` for the parser that runs on `tokenizer`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_html_speculative_tokenizer_create(
+    tokenizer: *mut RustFfiTokenizerHandle,
+    parser: *const RustFfiHtmlParserHandle,
+    scripting_enabled: bool,
+) -> *mut RustFfiSpeculativeTokenizerHandle {
+    if tokenizer.is_null() || parser.is_null() {
+        return ptr::null_mut();
+    }
+    let tokenizer = unsafe { &mut (*tokenizer).tokenizer };
+    let parser = unsafe { &*parser };
+    let handle = Box::new(RustFfiSpeculativeTokenizerHandle {
+        tokenizer: SpeculativeTokenizer::new(tokenizer, parser.is_in_foreign_content(), scripting_enabled),
+    });
+    Box::into_raw(handle)
+}
+
+/// Return whether a tokenizer still accepts the tokens of a speculative tokenizer.
+///
+/// # Safety
+/// `handle` must be a valid pointer from `rust_html_speculative_tokenizer_create`,
+/// and `tokenizer` a valid pointer from `rust_html_tokenizer_create`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_html_speculative_tokenizer_is_current(
+    handle: *const RustFfiSpeculativeTokenizerHandle,
+    tokenizer: *const RustFfiTokenizerHandle,
+) -> bool {
+    if handle.is_null() || tokenizer.is_null() {
+        return false;
+    }
+    let handle = unsafe { &*handle };
+    let tokenizer = unsafe { &(*tokenizer).tokenizer };
+    handle.tokenizer.is_current_for(tokenizer)
+}
+
+/// Append UTF-8 input to a speculative tokenizer, and tokenize as much of it as possible.
+/// This may be called on any thread, as long as only one thread uses the handle at a time.
+///
+/// # Safety
+/// `handle` must be a valid pointer from `rust_html_speculative_tokenizer_create`.
+/// `input` must point to `input_len` valid UTF-8 bytes.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_html_speculative_tokenizer_tokenize(
+    handle: *mut RustFfiSpeculativeTokenizerHandle,
+    input: *const u8,
+    input_len: usize,
+    is_end_of_input: bool,
+) -> *mut RustFfiSpeculatedTokenBatchHandle {
+    if handle.is_null() {
+        return ptr::null_mut();
+    }
+    let input = if input.is_null() || input_len == 0 {
+        &[]
+    } else {
+        unsafe { std::slice::from_raw_parts(input, input_len) }
+    };
+    let handle = unsafe { &mut *handle };
+    let batch = handle.tokenizer.tokenize(decode_utf8_to_u32(input), is_end_of_input);
+    Box::into_raw(Box::new(RustFfiSpeculatedTokenBatchHandle { batch }))
+}
+
+/// Append UTF-16 input to a speculative tokenizer, and tokenize as much of it as possible.
+/// This may be called on any thread, as long as only one thread uses the handle at a time.
+///
+/// # Safety
+/// `handle` must be a valid pointer from `rust_html_speculative_tokenizer_create`.
+/// `input` must point to `input_len` UTF-16 code units.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_html_speculative_tokenizer_tokenize_utf16(
+    handle: *mut RustFfiSpeculativeTokenizerHandle,
+    input: *const u16,
+    input_len: usize,
+    is_end_of_input: bool,
+) -> *mut RustFfiSpeculatedTokenBatchHandle {
+    if handle.is_null() {
+        return ptr::null_mut();
+    }
+    let input = if input.is_null() || input_len == 0 {
+        &[]
+    } else {
+        unsafe { std::slice::from_raw_parts(input, input_len) }
+    };
+    let handle = unsafe { &mut *handle };
+    let batch = handle.tokenizer.tokenize(decode_utf16_to_u32(input), is_end_of_input);
+    Box::into_raw(Box::new(RustFfiSpeculatedTokenBatchHandle { batch }))
+}
+
+/// Destroy a speculative tokenizer.
+///
+/// # Safety
+/// `handle` must be a valid pointer from `rust_html_speculative_tokenizer_create`,
+/// and must not be used after this call.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_html_speculative_tokenizer_destroy(handle: *mut RustFfiSpeculativeTokenizerHandle) {
+    if !handle.is_null() {
+        drop(unsafe { Box::from_raw(handle) });
+    }
+}
+
+/// Append the input of a speculated batch to a tokenizer, along with its tokens if the tokenizer still accepts them.
+/// This takes ownership of the batch.
+///
+/// # Safety
+/// `tokenizer` must be a valid pointer from `rust_html_tokenizer_create`, and `batch` a valid
+/// pointer from `rust_html_speculative_tokenizer_tokenize`, which must not be used after this call.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_html_tokenizer_append_speculated_tokens(
+    tokenizer: *mut RustFfiTokenizerHandle,
+    batch: *mut RustFfiSpeculatedTokenBatchHandle,
+) {
+    if batch.is_null() {
+        return;
+    }
+    let batch = unsafe { Box::from_raw(batch) };
+    if tokenizer.is_null() {
+        return;
+    }
+    let tokenizer = unsafe { &mut (*tokenizer).tokenizer };
+    tokenizer.append_speculated_tokens(batch.batch);
+}
+
+/// Destroy a batch of speculated tokens without appending it to a tokenizer.
+///
+/// # Safety
+/// `batch` must be a valid pointer from `rust_html_speculative_tokenizer_tokenize`,
+/// and must not be used after this call.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_html_speculated_token_batch_destroy(batch: *mut RustFfiSpeculatedTokenBatchHandle) {
+    if !batch.is_null() {
+        drop(unsafe { Box::from_raw(batch) });
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::token::TokenPayload;
+
+    fn code_points(input: &str) -> Vec<u32> {
+        input.chars().map(|ch| ch as u32).collect()
+    }
+
+    fn describe(token: &Token) -> String {
+        match token.token_type {
+            TokenType::Character => char::from_u32(token.code_point).unwrap().to_string(),
+            TokenType::StartTag => format!("<{}>", token.tag_name()),
+            TokenType::EndTag => format!("</{}>", token.tag_name()),
+            TokenType::Comment => match &token.payload {
+                TokenPayload::Comment(data) => format!("<!--{data}-->"),
+                _ => unreachable!(),
+            },
+            TokenType::EndOfFile => "EOF".to_string(),
+            _ => format!("{:?}", token.token_type),
+        }
+    }
+
+    // A stand-in for the tree builder, which switches the tokenizer after the given start tags.
+    fn run_tree_builder(tokenizer: &mut HtmlTokenizer, switches: &[(&str, State)], output: &mut Vec<String>) {
+        while let Some(token) = tokenizer.next_token(false, false) {
+            output.push(describe(&token));
+            if token.token_type == TokenType::StartTag
+                && let Some((_, state)) = switches.iter().find(|(name, _)| *name == token.tag_name())
+            {
+                tokenizer.switch_to(*state);
+            }
+            if token.token_type == TokenType::EndOfFile {
+                break;
+            }
+        }
+        tokenizer.parser_did_run();
+    }
+
+    fn tokenize_directly(chunks: &[&str], switches: &[(&str, State)]) -> Vec<String> {
+        let mut tokenizer = HtmlTokenizer::new(Vec::new());
+        tokenizer.set_input_stream_closed(false);
+        let mut output = Vec::new();
+        for chunk in chunks {
+            tokenizer.append_input(&code_points(chunk));
+            run_tree_builder(&mut tokenizer, switches, &mut output);
+        }
+        tokenizer.set_input_stream_closed(true);
+        run_tree_builder(&mut tokenizer, switches, &mut output);
+        output
+    }
+
+    // Returns the tokens, and how many times the speculation had to be rolled back.
+    fn tokenize_speculatively(chunks: &[&str], switches: &[(&str, State)]) -> (Vec<String>, usize) {
+        let mut tokenizer = HtmlTokenizer::new(Vec::new());
+        tokenizer.set_input_stream_closed(false);
+        let mut speculative_tokenizer = SpeculativeTokenizer::new(&mut tokenizer, false, true);
+        let mut output = Vec::new();
+        let mut rollbacks = 0;
+        for (i, chunk) in chunks.iter().enumerate() {
+            if !speculative_tokenizer.is_current_for(&tokenizer) {
+                rollbacks += 1;
+                speculative_tokenizer = SpeculativeTokenizer::new(&mut tokenizer, false, true);
+            }
+            let is_end_of_input = i == chunks.len() - 1;
+            let batch = speculative_tokenizer.tokenize(code_points(chunk), is_end_of_input);
+            tokenizer.append_speculated_tokens(batch);
+            if is_end_of_input {
+                tokenizer.set_input_stream_closed(true);
+            }
+            run_tree_builder(&mut tokenizer, switches, &mut output);
+        }
+        if !speculative_tokenizer.is_current_for(&tokenizer) {
+            rollbacks += 1;
+        }
+        (output, rollbacks)
+    }
+
+    const HTML_SWITCHES: &[(&str, State)] = &[
+        ("script", State::ScriptData),
+        ("style", State::RAWTEXT),
+        ("title", State::RCDATA),
+        ("textarea", State::RCDATA),
+    ];
+
+    #[test]
+    fn speculated_tokens_match_tokenizing_directly() {
+        let chunks = [
+            "<!DOCTYPE html><title>a &am",
+            "p; b</title><scr",
+            "ipt>if (a < b) {}</script><p class=x>text",
+            " more</p><style>p { }</style><textarea>&lt;</textarea>",
+        ];
+        let expected = tokenize_directly(&chunks, HTML_SWITCHES);
+        assert_eq!(tokenize_speculatively(&chunks, HTML_SWITCHES), (expected, 0));
+    }
+
+    #[test]
+    fn rolls_back_when_the_tree_builder_does_not_switch_states() {
+        // The tree builder doesn't switch to the script data state, so the markup in the script is tokenized as tags.
+        let chunks = ["<script><b>x</b></script>", "<p>"];
+        let switches = &[];
+        let expected = tokenize_directly(&chunks, switches);
+        assert!(expected.contains(&"<b>".to_string()));
+        assert_eq!(tokenize_speculatively(&chunks, switches), (expected, 1));
+    }
+
+    #[test]
+    fn rolls_back_when_the_tree_builder_switches_states_unexpectedly() {
+        let chunks = ["<p><em>a<b>x</b>", "</em></p>"];
+        let switches = &[("em", State::RAWTEXT)];
+        let expected = tokenize_directly(&chunks, switches);
+        assert_eq!(tokenize_speculatively(&chunks, switches), (expected, 1));
+    }
+
+    #[test]
+    fn rolls_back_when_input_is_inserted() {
+        let mut tokenizer = HtmlTokenizer::new(Vec::new());
+        tokenizer.set_input_stream_closed(false);
+        let mut speculative_tokenizer = SpeculativeTokenizer::new(&mut tokenizer, false, true);
+        let batch = speculative_tokenizer.tokenize(code_points("<p>ab<i>c</i>"), true);
+        tokenizer.append_speculated_tokens(batch);
+        tokenizer.set_input_stream_closed(true);
+
+        let mut output = Vec::new();
+        for _ in 0..2 {
+            output.push(describe(&tokenizer.next_token(false, false).unwrap()));
+        }
+
+        // This is what document.write() does.
+        tokenizer.store_insertion_point();
+        tokenizer.update_insertion_point();
+        tokenizer.insert_input_at_insertion_point(&code_points("<hr>"));
+        assert!(!speculative_tokenizer.is_current_for(&tokenizer));
+        while let Some(token) = tokenizer.next_token(true, false) {
+            output.push(describe(&token));
+        }
+        tokenizer.restore_insertion_point();
+
+        while let Some(token) = tokenizer.next_token(false, false) {
+            output.push(describe(&token));
+            if token.token_type == TokenType::EndOfFile {
+                break;
+            }
+        }
+        assert_eq!(output, ["<p>", "a", "<hr>", "b", "<i>", "c", "</i>", "EOF"]);
+    }
+
+    #[test]
+    fn rolls_back_when_cdata_sections_are_allowed_unexpectedly() {
+        let mut tokenizer = HtmlTokenizer::new(Vec::new());
+        tokenizer.set_input_stream_closed(false);
+        let mut speculative_tokenizer = SpeculativeTokenizer::new(&mut tokenizer, false, true);
+        let batch = speculative_tokenizer.tokenize(code_points("<![CDATA[x]]>"), true);
+        tokenizer.append_speculated_tokens(batch);
+
+        let token = tokenizer.next_token(false, true).unwrap();
+        assert_eq!(describe(&token), "x");
+        assert!(!speculative_tokenizer.is_current_for(&tokenizer));
+    }
+}
@@ -0,0 +1,778 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+//! Scanners for the subresources of resources the preload scanner found, so that they can be fetched speculatively
+//! as well: the @import rules and used font faces of a stylesheet, and the static imports of a module script.
+//!
+//! Neither of these has to be exact. Anything they get wrong is simply fetched by the real parser later on, so they
+//! only understand enough of CSS and JavaScript to skip over comments, strings and (most) regular expressions.
+
+use crate::preload_scanner::PreloadEntry;
+use crate::preload_scanner::RustFfiPreloadScannerAction;
+use crate::preload_scanner::RustFfiPreloadScannerCorsSetting;
+use crate::preload_scanner::RustFfiPreloadScannerDestination;
+use crate::preload_scanner::RustFfiPreloadScannerEntry;
+use crate::preload_scanner::RustFfiPreloadScannerFetchPriority;
+use std::collections::HashSet;
+use std::ffi::c_void;
+
+/// Scan a fetched stylesheet for the stylesheets it imports and the font faces its rules use.
+/// URLs are reported as written, and must be resolved against the stylesheet's URL.
+///
+/// # Safety
+/// `input` must point to `input_len` bytes. `callback` must not retain pointers from the provided entry beyond the
+/// callback invocation.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_html_preload_scanner_scan_stylesheet(
+    input: *const u8,
+    input_len: usize,
+    ctx: *mut c_void,
+    callback: unsafe extern "C" fn(ctx: *mut c_void, entry: *const RustFfiPreloadScannerEntry) -> bool,
+) {
+    let input = if input.is_null() || input_len == 0 {
+        &[]
+    } else {
+        unsafe { std::slice::from_raw_parts(input, input_len) }
+    };
+
+    scan_stylesheet(input, |entry| unsafe { callback(ctx, &raw const *entry) });
+}
+
+/// Scan a fetched module script for the modules it statically imports.
+/// Specifiers are reported as written, and must be resolved against the module script's URL.
+///
+/// # Safety
+/// `input` must point to `input_len` bytes. `callback` must not retain pointers from the provided entry beyond the
+/// callback invocation.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_html_preload_scanner_scan_module_script(
+    input: *const u8,
+    input_len: usize,
+    ctx: *mut c_void,
+    callback: unsafe extern "C" fn(ctx: *mut c_void, entry: *const RustFfiPreloadScannerEntry) -> bool,
+) {
+    let input = if input.is_null() || input_len == 0 {
+        &[]
+    } else {
+        unsafe { std::slice::from_raw_parts(input, input_len) }
+    };
+
+    scan_module_script(input, |entry| unsafe { callback(ctx, &raw const *entry) });
+}
+
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+enum CssToken<'a> {
+    Ident(&'a str),
+    AtKeyword(&'a str),
+    Function(&'a str),
+    String(&'a str),
+    Url(&'a str),
+    Colon,
+    Semicolon,
+    Comma,
+    OpenCurly,
+    CloseCurly,
+    CloseParen,
+    Other,
+}
+
+/// Splits CSS into the tokens the stylesheet scanner looks at. Escapes are left as written.
+#[derive(Clone)]
+struct CssTokenizer<'a> {
+    input: &'a str,
+    position: usize,
+}
+
+impl<'a> CssTokenizer<'a> {
+    fn new(input: &'a str) -> Self {
+        Self { input, position: 0 }
+    }
+
+    fn peek_byte(&self, offset: usize) -> Option<u8> {
+        self.input.as_bytes().get(self.position + offset).copied()
+    }
+
+    fn skip_whitespace_and_comments(&mut self) {
+        loop {
+            match self.peek_byte(0) {
+                Some(byte) if byte.is_ascii_whitespace() => self.position += 1,
+                Some(b'/') if self.peek_byte(1) == Some(b'*') => {
+                    self.position = match self.input[self.position + 2..].find("*/") {
+                        Some(end) => self.position + 2 + end + 2,
+                        None => self.input.len(),
+                    };
+                }
+                _ => return,
+            }
+        }
+    }
+
+    fn starts_number(&self) -> bool {
+        let is_digit = |offset| self.peek_byte(offset).is_some_and(|byte: u8| byte.is_ascii_digit());
+        match self.peek_byte(0) {
+            Some(b'0'..=b'9') => true,
+            Some(b'.') => is_digit(1),
+            Some(b'+' | b'-') => is_digit(1) || (self.peek_byte(1) == Some(b'.') && is_digit(2)),
+            _ => false,
+        }
+    }
+
+    fn consume_name(&mut self) -> &'a str {
+        let start = self.position;
+        while let Some(byte) = self.peek_byte(0) {
+            if byte == b'\\' {
+                self.position += 2.min(self.input.len() - self.position);
+                // An escaped non-ASCII code point ends somewhere in the middle of its bytes.
+                while !self.input.is_char_boundary(self.position) {
+                    self.position += 1;
+                }
+            } else if is_css_name_byte(byte) {
+                self.position += 1;
+            } else {
+                break;
+            }
+        }
+        &self.input[start..self.position]
+    }
+
+    fn consume_string(&mut self, quote: u8) -> &'a str {
+        self.position += 1;
+        let start = self.position;
+        while let Some(byte) = self.peek_byte(0) {
+            if byte == quote || byte == b'\n' {
+                let string = &self.input[start..self.position];
+                self.position += 1;
+                return string;
+            }
+            self.position += if byte == b'\\' { 2 } else { 1 };
+        }
+        self.position = self.input.len();
+        &self.input[start..]
+    }
+
+    fn consume_unquoted_url(&mut self) -> &'a str {
+        let start = self.position;
+        let end = self.input[start..]
+            .find(')')
+            .map_or(self.input.len(), |end| start + end);
+        self.position = (end + 1).min(self.input.len());
+        self.input[start..end].trim_end_matches(|c: char| c.is_ascii_whitespace())
+    }
+}
+
+impl<'a> Iterator for CssTokenizer<'a> {
+    type Item = CssToken<'a>;
+
+    fn next(&mut self) -> Option<CssToken<'a>> {
+        self.skip_whitespace_and_comments();
+        let byte = self.peek_byte(0)?;
+        let token = match byte {
+            b'"' | b'\'' => CssToken::String(self.consume_string(byte)),
+            _ if self.starts_number() => {
+                self.position += 1;
+                while self
+                    .peek_byte(0)
+                    .is_some_and(|byte| byte.is_ascii_digit() || byte == b'.')
+                {
+                    self.position += 1;
+                }
+                if self.peek_byte(0) == Some(b'%') {
+                    self.position += 1;
+                } else if self.peek_byte(0).is_some_and(is_css_name_start_byte) {
+                    self.consume_name();
+                }
+                CssToken::Other
+            }
+            b'@' if self.peek_byte(1).is_some_and(is_css_name_start_byte) => {
+                self.position += 1;
+                CssToken::AtKeyword(self.consume_name())
+            }
+            _ if is_css_name_start_byte(byte) => {
+                let name = self.consume_name();
+                if self.peek_byte(0) != Some(b'(') {
+                    return Some(CssToken::Ident(name));
+                }
+                self.position += 1;
+                if !name.eq_ignore_ascii_case("url") {
+                    return Some(CssToken::Function(name));
+                }
+                self.skip_whitespace_and_comments();
+                match self.peek_byte(0) {
+                    Some(b'"' | b'\'') => CssToken::Function(name),
+                    _ => CssToken::Url(self.consume_unquoted_url()),
+                }
+            }
+            _ => {
+                self.position += 1;
+                match byte {
+                    b':' => CssToken::Colon,
+                    b';' => CssToken::Semicolon,
+                    b',' => CssToken::Comma,
+                    b'{' => CssToken::OpenCurly,
+                    b'}' => CssToken::CloseCurly,
+                    b')' => CssToken::CloseParen,
+                    _ => CssToken::Other,
+                }
+            }
+        };
+        Some(token)
+    }
+}
+
+fn is_css_name_start_byte(byte: u8) -> bool {
+    byte.is_ascii_alphabetic() || byte == b'_' || byte == b'-' || byte == b'\\' || byte >= 0x80
+}
+
+fn is_css_name_byte(byte: u8) -> bool {
+    is_css_name_start_byte(byte) || byte.is_ascii_digit()
+}
+
+/// Consumes the URL of a url() or a string, once its first token has been consumed.
+fn consume_css_url<'a>(token: CssToken<'a>, tokens: &mut CssTokenizer<'a>) -> Option<&'a str> {
+    match token {
+        CssToken::Url(url) | CssToken::String(url) => Some(url),
+        CssToken::Function(name) if name.eq_ignore_ascii_case("url") => match tokens.next()? {
+            CssToken::String(url) => Some(url),
+            _ => None,
+        },
+        _ => None,
+    }
+}
+
+/// Consumes the value of a declaration, up to but not including the token that ends it.
+fn consume_css_declaration_value<'a>(tokens: &mut CssTokenizer<'a>) -> Vec<CssToken<'a>> {
+    let mut value = Vec::new();
+    loop {
+        let mut lookahead = tokens.clone();
+        match lookahead.next() {
+            None | Some(CssToken::Semicolon | CssToken::OpenCurly | CssToken::CloseCurly) => return value,
+            Some(token) => {
+                value.push(token);
+                *tokens = lookahead;
+            }
+        }
+    }
+}
+
+/// Returns the (lowercased) family names in the value of a font-family or font declaration. Together with the other
+/// identifiers of a font shorthand, but those will not match any font face.
+fn css_font_family_names(value: &[CssToken]) -> Vec<String> {
+    let mut names = Vec::new();
+    let mut current_name = String::new();
+    for token in value {
+        match token {
+            CssToken::Ident(ident) => {
+                if !current_name.is_empty() {
+                    current_name.push(' ');
+                }
+                current_name.push_str(&ident.to_ascii_lowercase());
+                continue;
+            }
+            CssToken::String(string) => names.push(string.to_ascii_lowercase()),
+            _ => {}
+        }
+        if !current_name.is_empty() {
+            names.push(std::mem::take(&mut current_name));
+        }
+    }
+    if !current_name.is_empty() {
+        names.push(current_name);
+    }
+    names
+}
+
+/// Returns the first URL in the value of a src descriptor whose format we can load, or that doesn't say.
+fn css_font_face_source_url<'a>(value: &[CssToken<'a>]) -> Option<&'a str> {
+    let mut url = None;
+    let mut is_supported = true;
+    let mut tokens = value.iter().copied().peekable();
+    while let Some(token) = tokens.next() {
+        match token {
+            CssToken::Url(source) if url.is_none() => url = Some(source),
+            CssToken::Function(name) if name.eq_ignore_ascii_case("url") && url.is_none() => {
+                if let Some(CssToken::String(source)) = tokens.next() {
+                    url = Some(source);
+                }
+            }
+            CssToken::Function(name) if name.eq_ignore_ascii_case("format") => {
+                if let Some(CssToken::String(format) | CssToken::Ident(format)) = tokens.next() {
+                    is_supported = ["woff2", "woff", "truetype", "opentype"]
+                        .iter()
+                        .any(|supported| format.eq_ignore_ascii_case(supported));
+                }
+            }
+            CssToken::Comma => {
+                if let Some(url) = url.filter(|_| is_supported) {
+                    return Some(url);
+                }
+                url = None;
+                is_supported = true;
+            }
+            _ => {}
+        }
+    }
+    url.filter(|_| is_supported)
+}
+
+pub(crate) fn scan_stylesheet(input: &[u8], mut callback: impl FnMut(&RustFfiPreloadScannerEntry) -> bool) {
+    let input = String::from_utf8_lossy(input);
+    let mut tokens = CssTokenizer::new(&input);
+
+    // https://drafts.csswg.org/css-cascade-5/#at-import
+    // Any @import rules must precede all other valid at-rules and style rules in a style sheet (ignoring @charset and
+    // @layer statement rules).
+    let mut may_import = true;
+    let mut depth: usize = 0;
+    let mut font_faces: Vec<(String, &str)> = Vec::new();
+    let mut used_font_families: HashSet<String> = HashSet::new();
+
+    while let Some(token) = tokens.next() {
+        match token {
+            CssToken::AtKeyword(name) if name.eq_ignore_ascii_case("import") && may_import && depth == 0 => {
+                if let Some(url) = tokens.next().and_then(|token| consume_css_url(token, &mut tokens)) {
+                    let mut entry = PreloadEntry::new(
+                        RustFfiPreloadScannerAction::Fetch,
+                        url,
+                        RustFfiPreloadScannerDestination::Style,
+                    );
+                    entry.fetch_priority = RustFfiPreloadScannerFetchPriority::High;
+                    if !url.is_empty() && !entry.emit(&mut callback) {
+                        return;
+                    }
+                }
+            }
+            CssToken::AtKeyword(name) if name.eq_ignore_ascii_case("font-face") => {
+                may_import = false;
+                if tokens.next() != Some(CssToken::OpenCurly) {
+                    continue;
+                }
+                let mut family = None;
+                let mut url = None;
+                loop {
+                    match tokens.next() {
+                        None | Some(CssToken::CloseCurly) => break,
+                        Some(CssToken::Ident(descriptor)) if tokens.clone().next() == Some(CssToken::Colon) => {
+                            tokens.next();
+                            let value = consume_css_declaration_value(&mut tokens);
+                            if descriptor.eq_ignore_ascii_case("font-family") {
+                                family = css_font_family_names(&value).into_iter().next();
+                            } else if descriptor.eq_ignore_ascii_case("src") {
+                                url = css_font_face_source_url(&value);
+                            }
+                        }
+                        Some(_) => {}
+                    }
+                }
+                if let (Some(family), Some(url)) = (family, url) {
+                    font_faces.push((family, url));
+                }
+            }
+            CssToken::Ident(property)
+                if depth > 0
+                    && (property.eq_ignore_ascii_case("font-family") || property.eq_ignore_ascii_case("font"))
+                    && tokens.clone().next() == Some(CssToken::Colon) =>
+            {
+                tokens.next();
+                let value = consume_css_declaration_value(&mut tokens);
+                used_font_families.extend(css_font_family_names(&value));
+            }
+            CssToken::OpenCurly => {
+                may_import = false;
+                depth += 1;
+            }
+            CssToken::CloseCurly => depth = depth.saturating_sub(1),
+            _ => {}
+        }
+    }
+
+    // Only the font faces the stylesheet's own rules use are worth fetching early. The others may well never be used.
+    for (family, url) in font_faces {
+        if url.is_empty() || !used_font_families.contains(&family) {
+            continue;
+        }
+        let mut entry = PreloadEntry::new(
+            RustFfiPreloadScannerAction::Fetch,
+            url,
+            RustFfiPreloadScannerDestination::Font,
+        );
+        // https://drafts.csswg.org/css-fonts-4/#font-fetching-requirements
+        // Fonts are always fetched in CORS mode, with the credentials of "anonymous".
+        entry.cors_setting = RustFfiPreloadScannerCorsSetting::Anonymous;
+        entry.fetch_priority = RustFfiPreloadScannerFetchPriority::High;
+        if !entry.emit(&mut callback) {
+            return;
+        }
+    }
+}
+
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+enum JsToken<'a> {
+    Ident(&'a str),
+    String(&'a str),
+    Punctuator(u8),
+    Other,
+}
+
+/// Splits JavaScript into the tokens the module script scanner looks at. Whether a `/` starts a regular expression
+/// literal is guessed from the token before it.
+#[derive(Clone)]
+struct JsTokenizer<'a> {
+    input: &'a str,
+    position: usize,
+    regex_allowed: bool,
+}
+
+impl<'a> JsTokenizer<'a> {
+    fn new(input: &'a str) -> Self {
+        Self {
+            input,
+            position: 0,
+            regex_allowed: true,
+        }
+    }
+
+    fn peek_byte(&self, offset: usize) -> Option<u8> {
+        self.input.as_bytes().get(self.position + offset).copied()
+    }
+
+    fn skip_to(&mut self, pattern: &str) {
+        self.position = match self.input[self.position..].find(pattern) {
+            Some(end) => self.position + end + pattern.len(),
+            None => self.input.len(),
+        };
+    }
+
+    fn skip_whitespace_and_comments(&mut self) {
+        loop {
+            match (self.peek_byte(0), self.peek_byte(1)) {
+                (Some(byte), _) if byte.is_ascii_whitespace() => self.position += 1,
+                (Some(b'/'), Some(b'/')) => self.skip_to("\n"),
+                (Some(b'/'), Some(b'*')) => {
+                    self.position += 2;
+                    self.skip_to("*/");
+                }
+                _ => return,
+            }
+        }
+    }
+
+    fn consume_string(&mut self, quote: u8) -> &'a str {
+        self.position += 1;
+        let start = self.position;
+        while let Some(byte) = self.peek_byte(0) {
+            if byte == quote || byte == b'\n' {
+                let string = &self.input[start..self.position];
+                self.position += 1;
+                return string;
+            }
+            self.position += if byte == b'\\' { 2 } else { 1 };
+        }
+        self.position = self.input.len();
+        &self.input[start..]
+    }
+
+    fn skip_template(&mut self) {
+        self.position += 1;
+        while let Some(byte) = self.peek_byte(0) {
+            match byte {
+                b'\\' => self.position += 2,
+                b'`' => {
+                    self.position += 1;
+                    return;
+                }
+                b'$' if self.peek_byte(1) == Some(b'{') => {
+                    self.position += 2;
+                    self.regex_allowed = true;
+                    let mut depth: usize = 0;
+                    for token in self.by_ref() {
+                        match token {
+                            JsToken::Punctuator(b'{') => depth += 1,
+                            JsToken::Punctuator(b'}') if depth == 0 => break,
+                            JsToken::Punctuator(b'}') => depth -= 1,
+                            _ => {}
+                        }
+                    }
+                }
+                _ => self.position += 1,
+            }
+        }
+        self.position = self.input.len();
+    }
+
+    fn skip_regular_expression(&mut self) {
+        self.position += 1;
+        let mut in_class = false;
+        while let Some(byte) = self.peek_byte(0) {
+            self.position += 1;
+            match byte {
+                b'\\' => self.position += 1,
+                b'[' => in_class = true,
+                b']' => in_class = false,
+                b'/' if !in_class => break,
+                b'\n' => return,
+                _ => {}
+            }
+        }
+        while self.peek_byte(0).is_some_and(is_js_identifier_byte) {
+            self.position += 1;
+        }
+    }
+}
+
+impl<'a> Iterator for JsTokenizer<'a> {
+    type Item = JsToken<'a>;
+
+    fn next(&mut self) -> Option<JsToken<'a>> {
+        self.skip_whitespace_and_comments();
+        self.position = self.position.min(self.input.len());
+        let byte = self.peek_byte(0)?;
+        let token = match byte {
+            b'"' | b'\'' => JsToken::String(self.consume_string(byte)),
+            b'`' => {
+                self.skip_template();
+                JsToken::Other
+            }
+            b'/' if self.regex_allowed => {
+                self.skip_regular_expression();
+                JsToken::Other
+            }
+            _ if is_js_identifier_byte(byte) => {
+                let start = self.position;
+                while self.peek_byte(0).is_some_and(is_js_identifier_byte) {
+                    self.position += 1;
+                }
+                let ident = &self.input[start..self.position];
+                // Keywords after which an expression (and so a regular expression) can start.
+                self.regex_allowed = matches!(
+                    ident,
+                    "return"
+                        | "typeof"
+                        | "instanceof"
+                        | "in"
+                        | "of"
+                        | "new"
+                        | "delete"
+                        | "void"
+                        | "throw"
+                        | "case"
+                        | "do"
+                        | "else"
+                        | "yield"
+                        | "await"
+                );
+                return Some(JsToken::Ident(ident));
+            }
+            _ if byte.is_ascii_punctuation() => {
+                self.position += 1;
+                JsToken::Punctuator(byte)
+            }
+            _ => {
+                self.position += 1;
+                JsToken::Other
+            }
+        };
+        self.position = self.position.min(self.input.len());
+        self.regex_allowed = !matches!(token, JsToken::String(_) | JsToken::Punctuator(b')' | b']' | b'}'));
+        Some(token)
+    }
+}
+
+fn is_js_identifier_byte(byte: u8) -> bool {
+    byte.is_ascii_alphanumeric() || byte == b'_' || byte == b'$' || byte >= 0x80
+}
+
+/// Returns the module specifier of an import or export declaration, once its first keyword has been consumed.
+fn consume_js_module_specifier<'a>(tokens: &mut JsTokenizer<'a>, is_import: bool) -> Option<&'a str> {
+    let mut lookahead = tokens.clone();
+    match lookahead.next()? {
+        // import "module";
+        JsToken::String(specifier) if is_import => {
+            *tokens = lookahead;
+            return Some(specifier);
+        }
+        // import(...) and import.meta are expressions, not declarations.
+        JsToken::Punctuator(b'(' | b'.') if is_import => return None,
+        JsToken::Ident(_) | JsToken::Punctuator(b'{' | b'*') if is_import => {}
+        // Only `export { ... } from` and `export * from` re-export another module.
+        JsToken::Punctuator(b'{' | b'*') => {}
+        _ => return None,
+    }
+
+    // import x, { y as z } from "module";
+    while let Some(token) = tokens.next() {
+        match token {
+            JsToken::Ident("from") => {
+                let mut lookahead = tokens.clone();
+                if let Some(JsToken::String(specifier)) = lookahead.next() {
+                    *tokens = lookahead;
+                    return Some(specifier);
+                }
+            }
+            JsToken::Ident(_) | JsToken::String(_) | JsToken::Punctuator(b'{' | b'}' | b'*' | b',') => {}
+            _ => return None,
+        }
+    }
+    None
+}
+
+pub(crate) fn scan_module_script(input: &[u8], mut callback: impl FnMut(&RustFfiPreloadScannerEntry) -> bool) {
+    let input = String::from_utf8_lossy(input);
+    let mut tokens = JsTokenizer::new(&input);
+    let mut previous_token = None;
+
+    while let Some(token) = tokens.next() {
+        let is_member_access = previous_token == Some(JsToken::Punctuator(b'.'));
+        previous_token = Some(token);
+
+        let is_import = match token {
+            JsToken::Ident("import") if !is_member_access => true,
+            JsToken::Ident("export") if !is_member_access => false,
+            _ => continue,
+        };
+        let Some(specifier) = consume_js_module_specifier(&mut tokens, is_import) else {
+            continue;
+        };
+        previous_token = None;
+        if specifier.is_empty() {
+            continue;
+        }
+
+        // https://html.spec.whatwg.org/multipage/webappapis.html#fetch-a-single-module-script
+        // Imported modules are fetched in CORS mode, with the same credentials mode as the module importing them.
+        // FIXME: Propagate the importing module's credentials mode, rather than assuming "same-origin".
+        let mut entry = PreloadEntry::new(
+            RustFfiPreloadScannerAction::Fetch,
+            specifier,
+            RustFfiPreloadScannerDestination::Script,
+        );
+        entry.cors_setting = RustFfiPreloadScannerCorsSetting::Anonymous;
+        entry.is_module_script = true;
+        if !entry.emit(&mut callback) {
+            return;
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn collect(
+        scan: fn(&[u8], &mut dyn FnMut(&RustFfiPreloadScannerEntry) -> bool),
+        input: &str,
+    ) -> Vec<(String, RustFfiPreloadScannerDestination)> {
+        let mut entries = Vec::new();
+        scan(input.as_bytes(), &mut |entry| {
+            let url = unsafe { std::slice::from_raw_parts(entry.url_ptr, entry.url_len) };
+            entries.push((std::str::from_utf8(url).unwrap().to_string(), entry.destination));
+            true
+        });
+        entries
+    }
+
+    fn collect_stylesheet(input: &str) -> Vec<(String, RustFfiPreloadScannerDestination)> {
+        collect(|input, callback| scan_stylesheet(input, callback), input)
+    }
+
+    fn collect_module_script(input: &str) -> Vec<String> {
+        collect(|input, callback| scan_module_script(input, callback), input)
+            .into_iter()
+            .map(|(url, destination)| {
+                assert_eq!(destination, RustFfiPreloadScannerDestination::Script);
+                url
+            })
+            .collect()
+    }
+
+    #[test]
+    fn finds_stylesheet_imports_before_other_rules() {
+        let entries = collect_stylesheet(
+            r#"
+                @charset "utf-8";
+                /* @import "commented-out.css"; */
+                @import "quoted.css";
+                @import url(unquoted.css) screen;
+                @import url( "function.css" ) layer(base);
+                body { color: red; }
+                @import "too-late.css";
+            "#,
+        );
+
+        assert_eq!(
+            entries,
+            vec![
+                ("quoted.css".to_string(), RustFfiPreloadScannerDestination::Style),
+                ("unquoted.css".to_string(), RustFfiPreloadScannerDestination::Style),
+                ("function.css".to_string(), RustFfiPreloadScannerDestination::Style),
+            ]
+        );
+    }
+
+    #[test]
+    fn finds_only_font_faces_used_by_the_stylesheet() {
+        let entries = collect_stylesheet(
+            r#"
+                @font-face {
+                    font-family: "Used Font";
+                    src: local("Used Font"), url(used.eot) format("embedded-opentype"), url("used.woff2") format("woff2"), url(used.ttf);
+                }
+                @font-face { font-family: Shorthand Font; src: url(shorthand.woff); }
+                @font-face { font-family: unused; src: url(unused.woff2); }
+                @media (min-width: 100px) {
+                    h1 { font-family: 'used font', serif; }
+                }
+                p { font: italic bold 12px/1.5 Shorthand   Font, sans-serif; margin: -2px; }
+                font:hover { color: red; }
+            "#,
+        );
+
+        assert_eq!(
+            entries,
+            vec![
+                ("used.woff2".to_string(), RustFfiPreloadScannerDestination::Font),
+                ("shorthand.woff".to_string(), RustFfiPreloadScannerDestination::Font),
+            ]
+        );
+    }
+
+    #[test]
+    fn finds_static_imports_of_module_scripts() {
+        let specifiers = collect_module_script(
+            r#"
+                import "./side-effect.js";
+                import defaultExport, { a as b, c } from './named.js';
+                import * as namespace from "../namespace.js";
+                export { d } from "/re-export.js";
+                export * from "https://example.com/star.js";
+                import json from "./data.json" with { type: "json" };
+                // import "./commented-out.js";
+                /* export * from "./commented-out.js"; */
+                const string = "import './in-a-string.js'";
+                const template = `${"import './in-a-template.js'"} import './in-a-template.js'`;
+                const regex = /import "\.\/in-a-regex.js"/;
+                const ratio = 1 / 2; import "./after-a-division.js";
+                const lazy = import("./dynamic.js");
+                console.log(import.meta.url);
+                object.import("./member.js");
+                export const from = "./not-a-re-export.js";
+                export default function () { return "./not-a-re-export.js"; }
+            "#,
+        );
+
+        assert_eq!(
+            specifiers,
+            vec![
+                "./side-effect.js",
+                "./named.js",
+                "../namespace.js",
+                "/re-export.js",
+                "https://example.com/star.js",
+                "./data.json",
+                "./after-a-division.js",
+            ]
+        );
+    }
+}
@@ -7,6 +7,7 @@
 use std::collections::VecDeque;
 
 use crate::entities::NamedCharacterReferenceMatcher;
+use crate::speculative_tokenizer::Speculation;
 use crate::token::Attribute;
 use crate::token::DoctypeData;
 use crate::token::Position;
@@ -231,6 +232,38 @@ pub struct HtmlTokenizer {
     input_stream_closed: bool,
     stop_at_insertion_point: bool,
     cdata_allowed: bool,
+    // Set whenever the tokenizer looks at `cdata_allowed`, so that the speculative tokenizer knows which of its tokens
+    // depend on it.
+    pub(crate) cdata_allowed_was_checked: bool,
+    entity_matcher: NamedCharacterReferenceMatcher,
+    // Number of code points that have been discarded from the front of `input`, so that offsets into the input stream
+    // mean the same thing in tokenizers that discarded different amounts of it.
+    input_base: usize,
+    // Tokens produced ahead of the tree builder by a speculative tokenizer, see speculative_tokenizer.rs.
+    pub(crate) speculation: Option<Box<Speculation>>,
+    pub(crate) speculation_generation: u64,
+}
+
+/// A snapshot of the part of the tokenizer state that changes as it consumes input, taken between two tokens.
+/// Offsets are into the whole input stream, so a snapshot taken by a speculative tokenizer can be restored into
+/// the tokenizer it was started from.
+#[derive(Clone)]
+pub(crate) struct TokenizerCheckpoint {
+    state: State,
+    return_state: State,
+    offset: usize,
+    prev_offset: usize,
+    current_token: Token,
+    current_builder: String,
+    queued_tokens: VecDeque<Token>,
+    temporary_buffer: Vec<u32>,
+    character_reference_code: u32,
+    last_emitted_start_tag_name: Option<String>,
+    // next_token() drops everything but the most recent source position before it starts on a token.
+    position: Position,
+    current_line: u64,
+    current_column: u64,
+    has_emitted_eof: bool,
     entity_matcher: NamedCharacterReferenceMatcher,
 }
 
@@ -358,15 +391,94 @@ impl HtmlTokenizer {
             input_stream_closed: true,
             stop_at_insertion_point: false,
             cdata_allowed: false,
+            cdata_allowed_was_checked: false,
             entity_matcher: NamedCharacterReferenceMatcher::new(),
+            input_base: 0,
+            speculation: None,
+            speculation_generation: 0,
         }
     }
 
     /// Set the tokenizer state.
     pub fn switch_to(&mut self, state: State) {
+        if self.speculation.is_some() && !self.confirm_speculated_switch(state) {
+            self.abandon_speculation();
+        }
         self.state = state;
     }
 
+    // -- Checkpoints --
+
+    pub(crate) fn checkpoint(&self) -> TokenizerCheckpoint {
+        TokenizerCheckpoint {
+            state: self.state,
+            return_state: self.return_state,
+            offset: self.input_base + self.current_offset,
+            prev_offset: self.input_base + self.prev_offset,
+            current_token: self.current_token.clone(),
+            current_builder: self.current_builder.clone(),
+            queued_tokens: self.queued_tokens.clone(),
+            temporary_buffer: self.temporary_buffer.clone(),
+            character_reference_code: self.character_reference_code,
+            last_emitted_start_tag_name: self.last_emitted_start_tag_name.clone(),
+            position: *self.source_positions.last().unwrap_or(&Position::default()),
+            current_line: self.current_line,
+            current_column: self.current_column,
+            has_emitted_eof: self.has_emitted_eof,
+            entity_matcher: self.entity_matcher.clone(),
+        }
+    }
+
+    pub(crate) fn restore_checkpoint(&mut self, checkpoint: TokenizerCheckpoint) {
+        debug_assert!(checkpoint.offset >= self.input_base && checkpoint.offset - self.input_base <= self.input.len());
+        self.state = checkpoint.state;
+        self.return_state = checkpoint.return_state;
+        self.current_offset = checkpoint.offset - self.input_base;
+        self.prev_offset = checkpoint.prev_offset.saturating_sub(self.input_base);
+        self.current_token = checkpoint.current_token;
+        self.current_builder = checkpoint.current_builder;
+        self.queued_tokens = checkpoint.queued_tokens;
+        self.temporary_buffer = checkpoint.temporary_buffer;
+        self.character_reference_code = checkpoint.character_reference_code;
+        self.last_emitted_start_tag_name = checkpoint.last_emitted_start_tag_name;
+        self.source_positions.clear();
+        self.source_positions.push(checkpoint.position);
+        self.current_line = checkpoint.current_line;
+        self.current_column = checkpoint.current_column;
+        self.has_emitted_eof = checkpoint.has_emitted_eof;
+        self.entity_matcher = checkpoint.entity_matcher;
+    }
+
+    /// Create a tokenizer for the input that this one has not consumed yet, in the same state as this one.
+    pub(crate) fn copy_for_speculation(&mut self) -> HtmlTokenizer {
+        self.sync_speculation();
+
+        // Keep the previous code point, so that the copy can reconsume it.
+        let start = self.prev_offset.min(self.current_offset);
+        let mut copy = HtmlTokenizer::new(self.input[start..].to_vec());
+        copy.input_base = self.input_base + start;
+        copy.input_stream_closed = self.input_stream_closed;
+        copy.restore_checkpoint(self.checkpoint());
+        copy
+    }
+
+    /// Discard the input that has been consumed, if nothing can still refer back to it.
+    pub(crate) fn discard_consumed_input(&mut self) {
+        if !self.can_discard_consumed_input() {
+            return;
+        }
+
+        self.input_base += self.input.len();
+        self.input = Vec::new();
+        self.current_offset = 0;
+        self.prev_offset = 0;
+        let last_position = *self.source_positions.last().unwrap_or(&Position::default());
+        self.source_positions.clear();
+        self.source_positions.push(last_position);
+        self.current_line = last_position.line;
+        self.current_column = last_position.column;
+    }
+
     // -- Insertion point management --
 
     pub fn store_insertion_point(&mut self) {
@@ -378,6 +490,7 @@ impl HtmlTokenizer {
     }
 
     pub fn update_insertion_point(&mut self) {
+        self.sync_speculation();
         self.insertion_point = Some(self.current_offset);
     }
 
@@ -389,7 +502,8 @@ impl HtmlTokenizer {
         self.insertion_point.is_some()
     }
 
-    pub fn is_insertion_point_reached(&self) -> bool {
+    pub fn is_insertion_point_reached(&mut self) -> bool {
+        self.sync_speculation();
         self.insertion_point
             .is_some_and(|insertion_point| self.current_offset >= insertion_point)
     }
@@ -399,6 +513,9 @@ impl HtmlTokenizer {
     }
 
     pub fn insert_input_at_insertion_point(&mut self, code_points: &[u32]) {
+        if self.insertion_point.is_some() && !code_points.is_empty() {
+            self.abandon_speculation();
+        }
         if let Some(ip) = self.insertion_point {
             let ip = ip.min(self.input.len());
             self.input.splice(ip..ip, code_points.iter().copied());
@@ -413,7 +530,8 @@ impl HtmlTokenizer {
         }
     }
 
-    pub fn unparsed_input(&self) -> String {
+    pub fn unparsed_input(&mut self) -> String {
+        self.sync_speculation();
         let mut output = String::new();
         for code_point in self.input[self.current_offset..].iter().copied() {
             push_code_point(&mut output, code_point);
@@ -438,18 +556,8 @@ impl HtmlTokenizer {
     }
 
     pub fn parser_did_run(&mut self) {
-        if !self.can_discard_consumed_input() {
-            return;
-        }
-
-        self.input = Vec::new();
-        self.current_offset = 0;
-        self.prev_offset = 0;
-        let last_position = *self.source_positions.last().unwrap_or(&Position::default());
-        self.source_positions.clear();
-        self.source_positions.push(last_position);
-        self.current_line = last_position.line;
-        self.current_column = last_position.column;
+        self.sync_speculation();
+        self.discard_consumed_input();
     }
 
     pub fn insert_eof(&mut self) {
@@ -461,6 +569,7 @@ impl HtmlTokenizer {
     }
 
     pub fn abort(&mut self) {
+        self.abandon_speculation();
         self.aborted = true;
     }
 
@@ -551,7 +660,7 @@ impl HtmlTokenizer {
     /// Returns None if the slow path is required.
     #[inline(always)]
     pub fn try_fast_data_char(&mut self) -> Option<(u32, Position)> {
-        if self.aborted {
+        if self.aborted || self.speculation.is_some() {
             return None;
         }
         if self.state as u8 != State::Data as u8 {
@@ -846,6 +955,28 @@ impl HtmlTokenizer {
 
     /// Get the next token from the tokenizer.
     pub fn next_token(&mut self, stop_at_insertion_point: bool, cdata_allowed: bool) -> Option<Token> {
+        if self.speculation.is_none() {
+            return self.next_token_from_input(stop_at_insertion_point, cdata_allowed);
+        }
+
+        if let Some(token) = self.next_speculated_token(stop_at_insertion_point, cdata_allowed) {
+            return Some(token);
+        }
+
+        // We have caught up with the speculative tokenizer. Its next batch starts out in the state we're in now, so it
+        // only lines up with us for as long as we don't produce any tokens of our own.
+        let token = self.next_token_from_input(stop_at_insertion_point, cdata_allowed);
+        if token.is_some() {
+            self.abandon_speculation();
+        }
+        token
+    }
+
+    pub(crate) fn next_token_from_input(
+        &mut self,
+        stop_at_insertion_point: bool,
+        cdata_allowed: bool,
+    ) -> Option<Token> {
         self.stop_at_insertion_point = stop_at_insertion_point;
         self.cdata_allowed = cdata_allowed;
 
@@ -1505,6 +1636,7 @@ impl HtmlTokenizer {
                     }
                     match self.consume_next_if_match_exact("[CDATA[") {
                         Some(true) => {
+                            self.cdata_allowed_was_checked = true;
                             if self.cdata_allowed {
                                 self.state = State::CDATASection;
                             } else {
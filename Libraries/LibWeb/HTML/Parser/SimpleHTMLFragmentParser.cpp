@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Utf16StringBuilder.h>
+#include <LibWeb/DOM/Attr.h>
+#include <LibWeb/DOM/Comment.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/DocumentFragment.h>
+#include <LibWeb/DOM/ElementFactory.h>
+#include <LibWeb/DOM/Text.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/CustomElements/CustomElementRegistry.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/Parser/SimpleHTMLFragmentParser.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Namespace.h>
+
+namespace Web::HTML {
+
+// Context elements for which the fragment parsing algorithm leaves the tokenizer in the data state and resets the
+// insertion mode to "in body".
+static bool is_supported_context_element(DOM::Element const& context)
+{
+    if (context.namespace_uri() != Namespace::HTML)
+        return false;
+    return !context.local_name().is_one_of(
+        TagNames::title, TagNames::textarea, TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed,
+        TagNames::noframes, TagNames::script, TagNames::noscript, TagNames::plaintext, TagNames::html, TagNames::head,
+        TagNames::frameset, TagNames::template_, TagNames::table, TagNames::caption, TagNames::colgroup, TagNames::col,
+        TagNames::tbody, TagNames::thead, TagNames::tfoot, TagNames::tr, TagNames::td, TagNames::th, TagNames::select,
+        TagNames::optgroup, TagNames::option);
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#parsing-main-inbody
+// Start tags handled by "any other start tag", which only reconstructs the (empty) list of active formatting elements
+// and inserts an HTML element.
+static bool is_ordinary_phrasing_element(Utf16FlyString const& tag_name)
+{
+    return tag_name.is_one_of(
+        TagNames::abbr, TagNames::bdi, TagNames::bdo, TagNames::cite, TagNames::data, TagNames::del, TagNames::dfn,
+        TagNames::ins, TagNames::kbd, TagNames::label, TagNames::mark, TagNames::q, TagNames::samp, TagNames::span,
+        TagNames::sub, TagNames::sup, TagNames::time, TagNames::var);
+}
+
+// Start tags that close a p element in button scope before inserting an HTML element.
+static bool is_block_element_closing_paragraphs(Utf16FlyString const& tag_name)
+{
+    return tag_name.is_one_of(
+        TagNames::address, TagNames::article, TagNames::aside, TagNames::blockquote, TagNames::center, TagNames::details,
+        TagNames::dialog, TagNames::dir, TagNames::div, TagNames::dl, TagNames::figcaption, TagNames::figure,
+        TagNames::footer, TagNames::header, TagNames::hgroup, TagNames::main, TagNames::menu, TagNames::nav,
+        TagNames::ol, TagNames::p, TagNames::search, TagNames::section, TagNames::summary, TagNames::ul);
+}
+
+static bool is_heading_element(Utf16FlyString const& tag_name)
+{
+    return tag_name.is_one_of(TagNames::h1, TagNames::h2, TagNames::h3, TagNames::h4, TagNames::h5, TagNames::h6);
+}
+
+GC::Ptr<DOM::DocumentFragment> try_parse_simple_html_fragment(DOM::Element& context, DOM::Node& target, Utf16View markup)
+{
+    if (!is_supported_context_element(context))
+        return nullptr;
+
+    auto& document = target.document();
+    auto& realm = context.realm();
+    auto fragment = realm.create<DOM::DocumentFragment>(document);
+
+    // NB: The full parser's stack of open elements also holds the root html element, below these. Nodes inserted while
+    //     only that root is open go into the fragment.
+    Vector<GC::Ref<DOM::Element>> open_elements;
+    size_t open_paragraph_count = 0;
+
+    auto current_node = [&]() -> DOM::Node& {
+        if (open_elements.is_empty())
+            return *fragment;
+        return *open_elements.last();
+    };
+
+    auto current_node_is_one_of = [&](auto... tag_names) {
+        return !open_elements.is_empty() && open_elements.last()->local_name().is_one_of(tag_names...);
+    };
+
+    Utf16StringBuilder pending_text;
+    auto flush_pending_text = [&] {
+        if (pending_text.is_empty())
+            return;
+        auto text = realm.create<DOM::Text>(document, pending_text.to_string());
+        pending_text.clear();
+        MUST(current_node().append_child(text));
+    };
+
+    auto insert_html_element = [&](HTMLToken const& token) -> GC::Ref<DOM::Element> {
+        flush_pending_text();
+
+        // https://html.spec.whatwg.org/multipage/parsing.html#create-an-element-for-the-token
+        auto& intended_parent = current_node();
+        auto registry = look_up_a_custom_element_registry(intended_parent);
+        auto element = MUST(DOM::create_element(document, token.tag_name(), Namespace::HTML, {}, {}, false, registry));
+        token.for_each_attribute([&](auto const& attribute) {
+            DOM::QualifiedName qualified_name { attribute.local_name, attribute.prefix, attribute.namespace_ };
+            element->append_attribute(realm.create<DOM::Attr>(document, move(qualified_name), attribute.value, element));
+            return IterationDecision::Continue;
+        });
+
+        MUST(intended_parent.append_child(element));
+        return element;
+    };
+
+    HTMLTokenizer tokenizer { markup };
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+
+        if (token->is_character()) {
+            // NB: U+0000 NULL characters are dropped with a parse error in the "in body" insertion mode.
+            if (token->code_point() == 0)
+                return nullptr;
+            pending_text.append_code_point(token->code_point());
+            continue;
+        }
+
+        if (token->is_comment()) {
+            flush_pending_text();
+            MUST(current_node().append_child(realm.create<DOM::Comment>(document, token->comment())));
+            continue;
+        }
+
+        if (token->is_start_tag()) {
+            auto const& tag_name = token->tag_name();
+
+            // NB: Duplicate attributes are recorded on the element through a parser-only badge, and an "is"
+            //     attribute may name a customized built-in element.
+            if (token->had_duplicate_attribute() || token->has_attribute(AttributeNames::is))
+                return nullptr;
+
+            if (is_ordinary_phrasing_element(tag_name)) {
+                open_elements.append(insert_html_element(*token));
+                continue;
+            }
+
+            if (tag_name.is_one_of(TagNames::br, TagNames::wbr)) {
+                (void)insert_html_element(*token);
+                continue;
+            }
+
+            // Everything below closes a p element in button scope first, which may pop other elements too.
+            if (open_paragraph_count > 0)
+                return nullptr;
+
+            if (is_block_element_closing_paragraphs(tag_name)) {
+                if (tag_name == TagNames::p)
+                    ++open_paragraph_count;
+                open_elements.append(insert_html_element(*token));
+                continue;
+            }
+
+            if (is_heading_element(tag_name)) {
+                // NB: A heading directly inside another heading pops it.
+                if (current_node_is_one_of(TagNames::h1, TagNames::h2, TagNames::h3, TagNames::h4, TagNames::h5, TagNames::h6))
+                    return nullptr;
+                open_elements.append(insert_html_element(*token));
+                continue;
+            }
+
+            if (tag_name == TagNames::hr) {
+                (void)insert_html_element(*token);
+                continue;
+            }
+
+            // NB: An li (or dd/dt) start tag closes any such element that's open above the nearest special element.
+            //     Directly inside a list, the list itself is that special element, so nothing is closed.
+            if ((tag_name == TagNames::li && current_node_is_one_of(TagNames::ul, TagNames::ol, TagNames::menu))
+                || (tag_name.is_one_of(TagNames::dd, TagNames::dt) && current_node_is_one_of(TagNames::dl))) {
+                open_elements.append(insert_html_element(*token));
+                continue;
+            }
+
+            return nullptr;
+        }
+
+        if (token->is_end_tag()) {
+            // NB: An end tag for the current node pops just that node, since none of the elements we open have
+            //     implied end tags that need generating first. Anything else needs the full algorithm.
+            if (open_elements.is_empty() || open_elements.last()->local_name() != token->tag_name())
+                return nullptr;
+            flush_pending_text();
+            if (open_elements.take_last()->local_name() == TagNames::p)
+                --open_paragraph_count;
+            continue;
+        }
+
+        // DOCTYPE tokens are ignored in the "in body" insertion mode, but they're too rare to bother with.
+        return nullptr;
+    }
+
+    // NB: Elements left open at the end of the input have no end tag steps to run in the "in body" insertion mode.
+    flush_pending_text();
+    return fragment;
+}
+
+}
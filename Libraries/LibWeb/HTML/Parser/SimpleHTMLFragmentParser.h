@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Utf16View.h>
+#include <LibGC/Ptr.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// Parses markup that only uses elements whose tree construction in the "in body" insertion mode amounts to inserting
+// or popping them, building nodes directly into a new DocumentFragment whose node document is target's. This covers
+// most markup assigned to innerHTML by templating code, without setting up a temporary document and a full parser.
+//
+// Returns null as soon as the markup needs anything else (scripts, tables, foreign content, formatting elements,
+// implied end tags, custom elements, ...), in which case the caller must run the full fragment parsing algorithm.
+GC::Ptr<DOM::DocumentFragment> try_parse_simple_html_fragment(DOM::Element& context, DOM::Node& target, Utf16View markup);
+
+}
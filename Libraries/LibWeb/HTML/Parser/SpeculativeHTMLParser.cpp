@@ -12,10 +12,15 @@
 #include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Statuses.h>
 #include <LibWeb/HTML/CORSSettingAttribute.h>
 #include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
 #include <LibWeb/HTML/PotentialCORSRequest.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/HTML/Scripting/Fetching.h>
+#include <LibWeb/HTML/SourceSet.h>
+#include <LibWeb/HTML/Window.h>
 #include <LibWeb/HTMLTokenizerRustFFI.h>
 
 namespace Web::HTML {
@@ -108,13 +113,90 @@ CORSSettingAttribute cors_setting_from_preload_scanner(RustFfiPreloadScannerCors
     VERIFY_NOT_REACHED();
 }
 
-void issue_speculative_fetch(JS::Realm& realm, DOM::Document& document, URL::URL url, Optional<Fetch::Infrastructure::Request::Destination> destination, CORSSettingAttribute cors_setting)
+Fetch::Infrastructure::Request::Priority priority_from_preload_scanner(RustFfiPreloadScannerFetchPriority fetch_priority)
+{
+    switch (fetch_priority) {
+    case RustFfiPreloadScannerFetchPriority::Auto:
+        return Fetch::Infrastructure::Request::Priority::Auto;
+    case RustFfiPreloadScannerFetchPriority::High:
+        return Fetch::Infrastructure::Request::Priority::High;
+    case RustFfiPreloadScannerFetchPriority::Low:
+        return Fetch::Infrastructure::Request::Priority::Low;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// The subresources of a fetched resource that can be fetched speculatively as well, once it has arrived.
+enum class SubresourceScan {
+    None,
+    Stylesheet,
+    ModuleScript,
+};
+
+void speculatively_fetch(DOM::Document&, URL::URL, RustFfiPreloadScannerEntry const&);
+
+void scan_fetched_resource(DOM::Document& document, URL::URL const& response_url, SubresourceScan scan, ReadonlyBytes body)
+{
+    struct Context {
+        DOM::Document& document;
+        URL::URL const& response_url;
+    };
+    Context context { document, response_url };
+
+    auto scanner_callback = [](void* raw_context, RustFfiPreloadScannerEntry const* entry) -> bool {
+        auto& context = *static_cast<Context*>(raw_context);
+        auto url_string = ffi_string_view(entry->url_ptr, entry->url_len);
+
+        Optional<URL::URL> url;
+        if (entry->is_module_script) {
+            // NB: Bare specifiers can only be resolved with the import map, which the speculative HTML parser doesn't
+            //     know about, so we leave those to the real module loader.
+            url = resolve_url_like_module_specifier(Utf16String::from_utf8(url_string), context.response_url);
+        } else {
+            url = context.response_url.complete_url(url_string);
+        }
+        if (url.has_value())
+            speculatively_fetch(context.document, url.release_value(), *entry);
+        return true;
+    };
+
+    switch (scan) {
+    case SubresourceScan::None:
+        break;
+    case SubresourceScan::Stylesheet:
+        rust_html_preload_scanner_scan_stylesheet(body.data(), body.size(), &context, scanner_callback);
+        break;
+    case SubresourceScan::ModuleScript:
+        rust_html_preload_scanner_scan_module_script(body.data(), body.size(), &context, scanner_callback);
+        break;
+    }
+}
+
+void issue_speculative_fetch(JS::Realm& realm, DOM::Document& document, URL::URL url, Optional<Fetch::Infrastructure::Request::Destination> destination, CORSSettingAttribute cors_setting, Fetch::Infrastructure::Request::Priority priority, SubresourceScan scan)
 {
     auto& vm = realm.vm();
     auto request = create_potential_CORS_request(vm, url, destination, cors_setting);
     request->set_client(&document.relevant_settings_object());
+    request->set_priority(priority);
 
     Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
+    if (scan != SubresourceScan::None) {
+        // OPTIMIZATION: Stylesheets and module scripts only reveal what they depend on once they have arrived. Scan
+        //               them right away, rather than waiting for the real parser to get to them.
+        fetch_algorithms_input.process_response_consume_body = [document = GC::Ref { document }, scan](GC::Ref<Fetch::Infrastructure::Response> response, Fetch::Infrastructure::FetchAlgorithms::BodyBytes body_bytes) {
+            // FIXME: If the response is CORS cross-origin, we must use its internal response to query any of its data. See:
+            //        https://github.com/whatwg/html/issues/9355
+            response = response->unsafe_response();
+
+            auto const* bytes = body_bytes.get_pointer<Core::ImmutableBytes>();
+            if (!bytes || !Fetch::Infrastructure::is_ok_status(response->status()))
+                return;
+            auto response_url = response->url();
+            if (!response_url.has_value())
+                return;
+            scan_fetched_resource(document, *response_url, scan, bytes->bytes());
+        };
+    }
     auto algorithms = Fetch::Infrastructure::FetchAlgorithms::create(vm, move(fetch_algorithms_input));
 
     // The fetch stays alive via ResourceLoader's GC::Root callbacks for the duration of the
@@ -122,12 +204,32 @@ void issue_speculative_fetch(JS::Realm& realm, DOM::Document& document, URL::URL
     (void)Fetch::Fetching::fetch(realm, request, algorithms);
 }
 
+void speculatively_fetch(DOM::Document& document, URL::URL url, RustFfiPreloadScannerEntry const& entry)
+{
+    // 3. Otherwise, if url is already in the list of speculative fetch URLs, then do nothing.
+    if (document.has_speculative_fetch_url(url))
+        return;
+
+    // 4. Otherwise, fetch url as if the element was processed normally, and add url to the list of
+    //    speculative fetch URLs.
+    document.add_speculative_fetch_url(url);
+
+    auto scan = SubresourceScan::None;
+    if (entry.destination == RustFfiPreloadScannerDestination::Style)
+        scan = SubresourceScan::Stylesheet;
+    else if (entry.is_module_script)
+        scan = SubresourceScan::ModuleScript;
+
+    issue_speculative_fetch(document.realm(), document, move(url), destination_from_preload_scanner(entry.destination), cors_setting_from_preload_scanner(entry.cors_setting), priority_from_preload_scanner(entry.fetch_priority), scan);
+}
+
 }
 
 void SpeculativeHTMLParser::process_preload_scanner_entry(RustFfiPreloadScannerEntry const& entry)
 {
     auto url_string = ffi_string_view(entry.url_ptr, entry.url_len);
-    if (url_string.is_empty())
+    auto srcset = ffi_string_view(entry.srcset_ptr, entry.srcset_len);
+    if (url_string.is_empty() && srcset.is_empty())
         return;
 
     // https://html.spec.whatwg.org/multipage/parsing.html#speculative-fetch
@@ -150,6 +252,24 @@ void SpeculativeHTMLParser::process_preload_scanner_entry(RustFfiPreloadScannerE
 
     // 2. Let url be the URL that element would fetch if it was processed normally. If there is no such
     //    URL or if it is the empty string, then do nothing.
+    // NB: An img element with a srcset attribute selects the URL it fetches from its source set, using the viewport
+    //     and device pixel ratio the document has right now.
+    String selected_source;
+    if (!srcset.is_empty()) {
+        auto sizes = ffi_string_view(entry.sizes_ptr, entry.sizes_len);
+        auto source_set = SourceSet::create(*m_document, Utf16String::from_utf8(url_string), Utf16String::from_utf8(srcset), Utf16String::from_utf8(sizes));
+        if (source_set.is_empty())
+            return;
+
+        auto device_pixel_ratio = 1.0;
+        if (auto window = m_document->window())
+            device_pixel_ratio = window->device_pixel_ratio();
+        selected_source = source_set.select_an_image_source(device_pixel_ratio).source.url.to_utf8();
+        url_string = selected_source;
+    }
+    if (url_string.is_empty())
+        return;
+
     // We resolve URLs against the speculative parser's tracked base_url (which may have been updated
     // by an earlier speculative <base href>); this is why we use complete_url here rather than
     // document.encoding_parse_url, which would resolve against the document's base instead.
@@ -157,14 +277,7 @@ void SpeculativeHTMLParser::process_preload_scanner_entry(RustFfiPreloadScannerE
     if (!url.has_value())
         return;
 
-    // 3. Otherwise, if url is already in the list of speculative fetch URLs, then do nothing.
-    if (m_document->has_speculative_fetch_url(*url))
-        return;
-
-    // 4. Otherwise, fetch url as if the element was processed normally, and add url to the list of
-    //    speculative fetch URLs.
-    m_document->add_speculative_fetch_url(*url);
-    issue_speculative_fetch(m_document->realm(), *m_document, *url, destination_from_preload_scanner(entry.destination), cors_setting_from_preload_scanner(entry.cors_setting));
+    speculatively_fetch(*m_document, url.release_value(), entry);
 }
 
 }
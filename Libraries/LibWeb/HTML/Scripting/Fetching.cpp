@@ -173,6 +173,28 @@ static Optional<BytecodeCacheContext> bytecode_cache_context_for_request(Fetch::
     };
 }
 
+// RequestServer's store of bytecode keyed by source hash is partitioned by top-level site, so that whether a script's
+// bytecode is already in the store cannot be used to tell which other sites have loaded it.
+static Optional<ByteString> shared_bytecode_cache_partition_for(Optional<BytecodeCacheContext> const& cache_context)
+{
+    if (!cache_context.has_value() || !cache_context->memory_cache_partition_key.has_value())
+        return {};
+    return cache_context->memory_cache_partition_key->serialized_top_level_site();
+}
+
+// Without a per-URL sidecar, fall back to RequestServer's store of bytecode keyed by source hash. This catches identical
+// scripts served from another URL, e.g. the same library bundle at a versioned CDN path. The blob embeds the source
+// hash and the bytecode format version, so a stale or mismatched blob is rejected when it is decoded.
+// NB: The lookup is asynchronous so that the main thread does not wait on RequestServer's disk for every script.
+static void retrieve_shared_bytecode_cache(ByteString const& partition, BytecodeCacheSourceHash const& source_hash, Function<void(Optional<Core::ImmutableBytes>)> on_complete)
+{
+    if (!ResourceLoader::is_initialized() || !ResourceLoader::the().request_client()) {
+        on_complete({});
+        return;
+    }
+    ResourceLoader::the().request_client()->retrieve_shared_javascript_bytecode(partition, source_hash.bytes(), move(on_complete));
+}
+
 // Schedule a fresh, fully off-thread compile of the script source for the purpose of producing a bytecode cache blob.
 // The execution path has already received its (latency-trimmed) compile artifact and is running, so this work happens
 // entirely on a background thread and never blocks the main thread on cache generation.
@@ -197,6 +219,8 @@ static void schedule_bytecode_cache_generation(NonnullRefPtr<JS::SourceCode cons
             if (!ResourceLoader::is_initialized() || !ResourceLoader::the().request_client())
                 return;
             (void)ResourceLoader::the().request_client()->store_cache_associated_data(cache_context.url, cache_context.method, *cache_context.request_headers, cache_context.vary_key, HTTP::CacheEntryAssociatedData::JavaScriptBytecode, immutable_blob.bytes());
+            if (auto partition = shared_bytecode_cache_partition_for(cache_context); partition.has_value())
+                (void)ResourceLoader::the().request_client()->store_shared_javascript_bytecode(*partition, source_hash.bytes(), immutable_blob.bytes());
             if (cache_context.memory_cache_partition_key.has_value() && cache_context.memory_cache_request_headers)
                 Fetch::Fetching::update_javascript_bytecode_cache_in_http_memory_cache(*cache_context.memory_cache_partition_key, cache_context.url, cache_context.method, *cache_context.memory_cache_request_headers, cache_context.vary_key, immutable_blob);
         });
@@ -222,23 +246,49 @@ static void schedule_bytecode_cache_generation(NonnullRefPtr<JS::SourceCode cons
             (*callback)(move(blob), source_hash);
             delete callback;
         });
-    });
+    },
+        Threading::TaskPriority::Background);
+}
+
+Vector<size_t> select_functions_for_speculative_compile(ReadonlySpan<size_t> source_lengths_in_code_units)
+{
+    Vector<size_t> selected_functions;
+    size_t remaining_code_units = speculative_compile_code_unit_budget;
+
+    // NB: Functions that don't fit are skipped rather than ending the selection, so that the small functions after a
+    //     large one still get compiled.
+    for (size_t i = 0; i < source_lengths_in_code_units.size(); ++i) {
+        if (source_lengths_in_code_units[i] > remaining_code_units)
+            continue;
+        remaining_code_units -= source_lengths_in_code_units[i];
+        selected_functions.append(i);
+    }
+    return selected_functions;
 }
 
 static void compile_remaining_functions_off_thread(JS::Bytecode::Executable& executable, NonnullRefPtr<JS::SourceCode const> source_code)
 {
-    Vector<GC::Root<JS::SharedFunctionInstanceData>> shared_data_roots;
-    Vector<void*> function_asts;
+    Vector<JS::SharedFunctionInstanceData*> uncompiled_functions;
+    Vector<size_t> uncompiled_function_source_lengths;
 
     for (auto& shared_data : executable.shared_function_data) {
         if (!shared_data || shared_data->m_executable || !shared_data->m_rust_function_ast)
             continue;
+        uncompiled_functions.append(shared_data.ptr());
+        uncompiled_function_source_lengths.append(shared_data->m_source_text_length);
+    }
 
-        auto* cloned_ast = JS::RustIntegration::clone_function_ast(shared_data->m_rust_function_ast);
+    Vector<GC::Root<JS::SharedFunctionInstanceData>> shared_data_roots;
+    Vector<void*> function_asts;
+
+    for (auto index : select_functions_for_speculative_compile(uncompiled_function_source_lengths)) {
+        auto& shared_data = *uncompiled_functions[index];
+
+        auto* cloned_ast = JS::RustIntegration::clone_function_ast(shared_data.m_rust_function_ast);
         if (!cloned_ast)
             continue;
 
-        shared_data_roots.append(GC::make_root(*shared_data));
+        shared_data_roots.append(GC::make_root(shared_data));
         function_asts.append(cloned_ast);
     }
 
@@ -286,7 +336,8 @@ static void compile_remaining_functions_off_thread(JS::Bytecode::Executable& exe
             (*callback)(move(compiled_functions));
             delete callback;
         });
-    });
+    },
+        Threading::TaskPriority::Background);
 }
 
 static void compile_remaining_module_functions_off_thread(ModuleScript& module_script, NonnullRefPtr<JS::SourceCode const> source_code)
@@ -334,7 +385,8 @@ static void prepare_bytecode_cache_off_thread(Core::ImmutableBytes bytecode, JS:
             delete preparation;
             perform_a_microtask_checkpoint();
         });
-    });
+    },
+        Threading::TaskPriority::UserBlocking);
 }
 
 // Submit parsing and top-level bytecode generation to the thread pool, then bounce back to the main thread via
@@ -375,7 +427,8 @@ static void compile_off_thread(NonnullRefPtr<JS::SourceCode const> source_code,
             //         scripts would stall because their promise chains never resolve.
             perform_a_microtask_checkpoint();
         });
-    });
+    },
+        Threading::TaskPriority::UserBlocking);
 }
 
 GC_DEFINE_ALLOCATOR(FetchContext);
@@ -673,6 +726,142 @@ Utf16String resolve_a_module_integrity_metadata(URL::URL const& url, Environment
     return map.integrity().get(url).value_or(""_utf16);
 }
 
+// Creates a classic script from the body of a response, compiling it off the main thread. The bytecode cache is used
+// instead of compiling when valid.
+static void create_classic_script_off_thread(URL::URL response_url, Core::ImmutableBytes source_byte_storage, StringView source_encoding, TextCodec::Decoder& fallback_decoder, EnvironmentSettingsObject& settings_object, ClassicScript::MutedErrors muted_errors, OnFetchScriptComplete on_complete, Optional<Core::ImmutableBytes> bytecode, Optional<BytecodeCacheContext> bytecode_cache_context, Optional<BytecodeCacheSourceHash> source_hash)
+{
+    auto on_complete_root = GC::make_root(on_complete);
+    auto settings_root = GC::make_root(settings_object);
+    auto response_url_string = response_url.to_byte_string();
+    auto source_bytes = source_byte_storage.bytes();
+    Optional<NonnullRefPtr<JS::SourceCode const>> source_code;
+
+    // Warm-cache fast path: we have a bytecode cache blob for the source. Decode and validate it off-thread, then try to
+    // materialize a script straight from the validated cached bytecode without parsing or compiling.
+    if (bytecode.has_value()) {
+        auto source_length = TextCodec::convert_input_to_utf16_length_using_given_decoder_unless_there_is_a_byte_order_mark(fallback_decoder, StringView { source_bytes }).release_value_but_fixme_should_propagate_errors();
+        prepare_bytecode_cache_off_thread(*bytecode, JS::RustIntegration::ProgramType::Script, source_length, *source_hash,
+            [response_url = move(response_url), response_url_string = move(response_url_string),
+                source_byte_storage = move(source_byte_storage),
+                bytecode_cache_context = move(bytecode_cache_context),
+                source_hash = move(source_hash),
+                source_encoding = ByteString { source_encoding },
+                source_length,
+                muted_errors, on_complete_root = move(on_complete_root),
+                settings_root = move(settings_root)](auto bytecode_cache) mutable {
+                Optional<NonnullRefPtr<JS::SourceCode const>> source_code;
+                if (bytecode_cache) {
+                    source_code = JS::SourceCode::create(
+                        utf16_string_from_url_ascii(response_url_string.view()),
+                        source_length,
+                        source_encoding,
+                        source_byte_storage);
+                    auto script = ClassicScript::create_from_bytecode_cache(response_url_string, *source_code, *settings_root, response_url, bytecode_cache.release_nonnull(), muted_errors);
+                    if (script->parse_error().is_null()) {
+                        on_complete_root->function()(script);
+                        return;
+                    }
+                    source_code = {};
+                }
+
+                if (!source_code.has_value()) {
+                    auto fallback_decoder = TextCodec::decoder_for(source_encoding.view());
+                    VERIFY(fallback_decoder.has_value());
+                    source_code = JS::SourceCode::create(
+                        utf16_string_from_url_ascii(response_url_string.view()),
+                        decode_source_text_to_utf16(*fallback_decoder, source_byte_storage.bytes()).release_value_but_fixme_should_propagate_errors());
+                }
+
+                compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Script, 1,
+                    [response_url = move(response_url), response_url_string = move(response_url_string),
+                        bytecode_cache_context = move(bytecode_cache_context),
+                        source_hash = move(source_hash),
+                        muted_errors, on_complete_root = move(on_complete_root),
+                        settings_root = move(settings_root)](auto result, auto source_code) mutable {
+                        auto source_code_for_cache = source_code;
+                        auto should_generate_bytecode_cache = result.compiled && bytecode_cache_context.has_value();
+                        auto script = result.compiled
+                            ? ClassicScript::create_from_pre_compiled(move(response_url_string), move(source_code), *settings_root, move(response_url), result.compiled, muted_errors)
+                            : ClassicScript::create_from_pre_parsed(move(response_url_string), move(source_code), *settings_root, move(response_url), result.parsed, muted_errors);
+                        BytecodeCacheInstallTarget install_target;
+                        if (auto* script_record = script->script_record()) {
+                            install_target.script = *script_record;
+                            if (!should_generate_bytecode_cache) {
+                                if (auto* executable = script_record->cached_executable())
+                                    compile_remaining_functions_off_thread(*executable, source_code_for_cache);
+                            }
+                        }
+                        on_complete_root->function()(script);
+                        if (should_generate_bytecode_cache) {
+                            install_target.begin_generation();
+                            VERIFY(source_hash.has_value());
+                            schedule_bytecode_cache_generation(move(source_code_for_cache), JS::RustIntegration::ProgramType::Script, 1, bytecode_cache_context.release_value(), move(install_target), source_hash.release_value());
+                        }
+                    });
+            });
+        return;
+    }
+
+    if (!source_code.has_value()) {
+        source_code = JS::SourceCode::create(
+            utf16_string_from_url_ascii(response_url_string.view()),
+            decode_source_text_to_utf16(fallback_decoder, source_bytes).release_value_but_fixme_should_propagate_errors());
+    }
+
+    compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Script, 1,
+        [response_url = move(response_url), response_url_string = move(response_url_string),
+            bytecode_cache_context = move(bytecode_cache_context),
+            source_hash = move(source_hash),
+            muted_errors, on_complete_root = move(on_complete_root),
+            settings_root = move(settings_root)](auto result, auto source_code) mutable {
+            auto source_code_for_cache = source_code;
+            auto should_generate_bytecode_cache = result.compiled && bytecode_cache_context.has_value();
+            auto script = result.compiled
+                ? ClassicScript::create_from_pre_compiled(move(response_url_string), move(source_code), *settings_root, move(response_url), result.compiled, muted_errors)
+                : ClassicScript::create_from_pre_parsed(move(response_url_string), move(source_code), *settings_root, move(response_url), result.parsed, muted_errors);
+            BytecodeCacheInstallTarget install_target;
+            if (auto* script_record = script->script_record()) {
+                install_target.script = *script_record;
+                if (!should_generate_bytecode_cache) {
+                    if (auto* executable = script_record->cached_executable())
+                        compile_remaining_functions_off_thread(*executable, source_code_for_cache);
+                }
+            }
+            on_complete_root->function()(script);
+            if (should_generate_bytecode_cache) {
+                install_target.begin_generation();
+                VERIFY(source_hash.has_value());
+                schedule_bytecode_cache_generation(move(source_code_for_cache), JS::RustIntegration::ProgramType::Script, 1, bytecode_cache_context.release_value(), move(install_target), source_hash.release_value());
+            }
+        });
+}
+
+// Creates a classic script from the body of a response, using the bytecode cache that came with the response or, failing
+// that, the one that RequestServer has for the same source.
+static void create_classic_script_off_thread(Fetch::Infrastructure::Request const& request, Fetch::Infrastructure::Response const& response, URL::URL response_url, Core::ImmutableBytes source_byte_storage, StringView source_encoding, TextCodec::Decoder& fallback_decoder, EnvironmentSettingsObject& settings_object, ClassicScript::MutedErrors muted_errors, OnFetchScriptComplete on_complete)
+{
+    auto bytecode = response.javascript_bytecode_cache();
+    auto bytecode_cache_context = bytecode_cache_context_for_request(request, response, response_url);
+    Optional<BytecodeCacheSourceHash> source_hash;
+    if (bytecode.has_value() || bytecode_cache_context.has_value())
+        source_hash = bytecode_cache_source_hash(source_byte_storage.bytes(), source_encoding);
+
+    auto shared_bytecode_cache_partition = bytecode.has_value() ? Optional<ByteString> {} : shared_bytecode_cache_partition_for(bytecode_cache_context);
+    if (!shared_bytecode_cache_partition.has_value()) {
+        create_classic_script_off_thread(move(response_url), move(source_byte_storage), source_encoding, fallback_decoder, settings_object, muted_errors, on_complete, move(bytecode), move(bytecode_cache_context), move(source_hash));
+        return;
+    }
+
+    auto shared_bytecode_source_hash = *source_hash;
+    retrieve_shared_bytecode_cache(shared_bytecode_cache_partition.release_value(), shared_bytecode_source_hash,
+        [response_url = move(response_url), source_byte_storage = move(source_byte_storage), source_encoding = ByteString { source_encoding },
+            fallback_decoder = &fallback_decoder, settings_root = GC::make_root(settings_object), muted_errors,
+            on_complete_root = GC::make_root(on_complete), bytecode_cache_context = move(bytecode_cache_context),
+            source_hash = move(source_hash)](Optional<Core::ImmutableBytes> bytecode) mutable {
+            create_classic_script_off_thread(move(response_url), move(source_byte_storage), source_encoding, *fallback_decoder, *settings_root, muted_errors, *on_complete_root, move(bytecode), move(bytecode_cache_context), move(source_hash));
+        });
+}
+
 // https://html.spec.whatwg.org/multipage/webappapis.html#fetch-a-classic-script
 void fetch_classic_script(GC::Ref<HTMLScriptElement> element, URL::URL const& url, EnvironmentSettingsObject& settings_object, ScriptFetchOptions options, CORSSettingAttribute cors_setting, Utf16String character_encoding, OnFetchScriptComplete on_complete)
 {
@@ -728,118 +917,7 @@ void fetch_classic_script(GC::Ref<HTMLScriptElement> element, URL::URL const& ur
         //    options, and muted errors.
         // FIXME: Pass options.
         auto response_url = response->url().value_or({});
-
-        auto on_complete_root = GC::make_root(on_complete);
-        auto settings_root = GC::make_root(settings_object);
-        auto response_url_string = response_url.to_byte_string();
-        auto source_byte_storage = body_bytes.template get<Core::ImmutableBytes>();
-        auto source_bytes = source_byte_storage.bytes();
-        auto const& bytecode = response->javascript_bytecode_cache();
-        Optional<NonnullRefPtr<JS::SourceCode const>> source_code;
-        auto bytecode_cache_context = bytecode_cache_context_for_request(*request, *response, response_url);
-        Optional<BytecodeCacheSourceHash> source_hash;
-        if (bytecode.has_value() || bytecode_cache_context.has_value())
-            source_hash = bytecode_cache_source_hash(source_bytes, extracted_character_encoding);
-
-        // Warm-cache fast path: a sidecar arrived with the response. Decode and validate it off-thread, then try to
-        // materialize a script straight from the validated cached bytecode without parsing or compiling.
-        if (bytecode.has_value()) {
-            auto source_encoding = ByteString { extracted_character_encoding };
-            auto source_length = TextCodec::convert_input_to_utf16_length_using_given_decoder_unless_there_is_a_byte_order_mark(*fallback_decoder, StringView { source_bytes }).release_value_but_fixme_should_propagate_errors();
-            prepare_bytecode_cache_off_thread(*bytecode, JS::RustIntegration::ProgramType::Script, source_length, *source_hash,
-                [response_url = move(response_url), response_url_string = move(response_url_string),
-                    source_byte_storage = move(source_byte_storage),
-                    bytecode_cache_context = move(bytecode_cache_context),
-                    source_hash = move(source_hash),
-                    source_encoding = move(source_encoding),
-                    source_length,
-                    muted_errors, on_complete_root = move(on_complete_root),
-                    settings_root = move(settings_root)](auto bytecode_cache) mutable {
-                    Optional<NonnullRefPtr<JS::SourceCode const>> source_code;
-                    if (bytecode_cache) {
-                        source_code = JS::SourceCode::create(
-                            utf16_string_from_url_ascii(response_url_string.view()),
-                            source_length,
-                            source_encoding,
-                            source_byte_storage);
-                        auto script = ClassicScript::create_from_bytecode_cache(response_url_string, *source_code, *settings_root, response_url, bytecode_cache.release_nonnull(), muted_errors);
-                        if (script->parse_error().is_null()) {
-                            on_complete_root->function()(script);
-                            return;
-                        }
-                        source_code = {};
-                    }
-
-                    if (!source_code.has_value()) {
-                        auto fallback_decoder = TextCodec::decoder_for(source_encoding.view());
-                        VERIFY(fallback_decoder.has_value());
-                        source_code = JS::SourceCode::create(
-                            utf16_string_from_url_ascii(response_url_string.view()),
-                            decode_source_text_to_utf16(*fallback_decoder, source_byte_storage.bytes()).release_value_but_fixme_should_propagate_errors());
-                    }
-
-                    compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Script, 1,
-                        [response_url = move(response_url), response_url_string = move(response_url_string),
-                            bytecode_cache_context = move(bytecode_cache_context),
-                            source_hash = move(source_hash),
-                            muted_errors, on_complete_root = move(on_complete_root),
-                            settings_root = move(settings_root)](auto result, auto source_code) mutable {
-                            auto source_code_for_cache = source_code;
-                            auto should_generate_bytecode_cache = result.compiled && bytecode_cache_context.has_value();
-                            auto script = result.compiled
-                                ? ClassicScript::create_from_pre_compiled(move(response_url_string), move(source_code), *settings_root, move(response_url), result.compiled, muted_errors)
-                                : ClassicScript::create_from_pre_parsed(move(response_url_string), move(source_code), *settings_root, move(response_url), result.parsed, muted_errors);
-                            BytecodeCacheInstallTarget install_target;
-                            if (auto* script_record = script->script_record()) {
-                                install_target.script = *script_record;
-                                if (!should_generate_bytecode_cache) {
-                                    if (auto* executable = script_record->cached_executable())
-                                        compile_remaining_functions_off_thread(*executable, source_code_for_cache);
-                                }
-                            }
-                            on_complete_root->function()(script);
-                            if (should_generate_bytecode_cache) {
-                                install_target.begin_generation();
-                                VERIFY(source_hash.has_value());
-                                schedule_bytecode_cache_generation(move(source_code_for_cache), JS::RustIntegration::ProgramType::Script, 1, bytecode_cache_context.release_value(), move(install_target), source_hash.release_value());
-                            }
-                        });
-                });
-            return;
-        }
-
-        if (!source_code.has_value()) {
-            source_code = JS::SourceCode::create(
-                utf16_string_from_url_ascii(response_url_string.view()),
-                decode_source_text_to_utf16(*fallback_decoder, source_bytes).release_value_but_fixme_should_propagate_errors());
-        }
-
-        compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Script, 1,
-            [response_url = move(response_url), response_url_string = move(response_url_string),
-                bytecode_cache_context = move(bytecode_cache_context),
-                source_hash = move(source_hash),
-                muted_errors, on_complete_root = move(on_complete_root),
-                settings_root = move(settings_root)](auto result, auto source_code) mutable {
-                auto source_code_for_cache = source_code;
-                auto should_generate_bytecode_cache = result.compiled && bytecode_cache_context.has_value();
-                auto script = result.compiled
-                    ? ClassicScript::create_from_pre_compiled(move(response_url_string), move(source_code), *settings_root, move(response_url), result.compiled, muted_errors)
-                    : ClassicScript::create_from_pre_parsed(move(response_url_string), move(source_code), *settings_root, move(response_url), result.parsed, muted_errors);
-                BytecodeCacheInstallTarget install_target;
-                if (auto* script_record = script->script_record()) {
-                    install_target.script = *script_record;
-                    if (!should_generate_bytecode_cache) {
-                        if (auto* executable = script_record->cached_executable())
-                            compile_remaining_functions_off_thread(*executable, source_code_for_cache);
-                    }
-                }
-                on_complete_root->function()(script);
-                if (should_generate_bytecode_cache) {
-                    install_target.begin_generation();
-                    VERIFY(source_hash.has_value());
-                    schedule_bytecode_cache_generation(move(source_code_for_cache), JS::RustIntegration::ProgramType::Script, 1, bytecode_cache_context.release_value(), move(install_target), source_hash.release_value());
-                }
-            });
+        create_classic_script_off_thread(*request, *response, move(response_url), body_bytes.template get<Core::ImmutableBytes>(), extracted_character_encoding, *fallback_decoder, settings_object, muted_errors, on_complete);
     };
 
     Fetch::Fetching::fetch(element->realm(), request, Fetch::Infrastructure::FetchAlgorithms::create(vm, move(fetch_algorithms_input)));
@@ -864,7 +942,7 @@ WebIDL::ExceptionOr<void> fetch_classic_worker_script(URL::URL const& url, Envir
     request->set_parser_metadata(Fetch::Infrastructure::Request::ParserMetadata::NotParserInserted);
     request->set_use_url_credentials(true);
 
-    auto process_response_consume_body = [&settings_object, on_complete = move(on_complete)](auto response, auto body_bytes) {
+    auto process_response_consume_body = [request, &settings_object, on_complete = move(on_complete)](auto response, auto body_bytes) {
         // 1. Set response to response's unsafe response.
         response = response->unsafe_response();
 
@@ -897,15 +975,14 @@ WebIDL::ExceptionOr<void> fetch_classic_worker_script(URL::URL const& url, Envir
         // 4. Let sourceText be the result of UTF-8 decoding bodyBytes.
         auto decoder = TextCodec::decoder_for("UTF-8"sv);
         VERIFY(decoder.has_value());
-        auto source_text = decode_source_text_to_utf16(*decoder, body_bytes_view(body_bytes)).release_value_but_fixme_should_propagate_errors();
 
         // 5. Let script be the result of creating a classic script using sourceText, settingsObject,
         //    response's URL, and the default classic script fetch options.
-        auto response_url = response->url().value_or({});
-        auto script = ClassicScript::create(response_url.to_byte_string(), source_text, settings_object, response_url);
-
         // 6. Run onComplete given script.
-        on_complete->function()(script);
+        // NB: Like script elements, workers compile off the main thread and reuse the bytecode cache, so that workers
+        //     created with the same script skip compiling it again.
+        auto response_url = response->url().value_or({});
+        create_classic_script_off_thread(*request, *response, move(response_url), body_bytes.template get<Core::ImmutableBytes>(), "UTF-8"sv, *decoder, settings_object, ClassicScript::MutedErrors::No, on_complete);
     };
 
     // 2. If performFetch was given, run performFetch with request, true, and with processResponseConsumeBody as defined below.
@@ -1060,6 +1137,125 @@ Fetch::Infrastructure::Request::Destination fetch_destination_from_module_type(F
     return default_destination;
 }
 
+// Creates a JavaScript module script from the body of a response, compiling it off the main thread. The bytecode cache
+// is used instead of compiling when valid.
+static void create_javascript_module_script_off_thread(URL::URL url, URL::URL response_url, Utf16String module_type_string, Core::ImmutableBytes source_byte_storage, EnvironmentSettingsObject& settings_object, OnFetchScriptComplete on_complete, Optional<Core::ImmutableBytes> bytecode, Optional<BytecodeCacheContext> bytecode_cache_context, Optional<BytecodeCacheSourceHash> source_hash)
+{
+    auto decoder = TextCodec::decoder_for("UTF-8"sv);
+    VERIFY(decoder.has_value());
+    auto on_complete_root = GC::make_root(on_complete);
+    auto settings_root = GC::make_root(settings_object);
+    auto url_string = url.to_byte_string();
+    auto source_bytes = source_byte_storage.bytes();
+    Optional<NonnullRefPtr<JS::SourceCode const>> source_code;
+
+    if (bytecode.has_value()) {
+        auto source_length = TextCodec::convert_input_to_utf16_length_using_given_decoder_unless_there_is_a_byte_order_mark(*decoder, StringView { source_bytes }).release_value_but_fixme_should_propagate_errors();
+        prepare_bytecode_cache_off_thread(*bytecode, JS::RustIntegration::ProgramType::Module, source_length, *source_hash,
+            [url = move(url), url_string = move(url_string), response_url = move(response_url),
+                module_type_string = move(module_type_string),
+                source_byte_storage = move(source_byte_storage),
+                bytecode_cache_context = move(bytecode_cache_context),
+                source_hash = move(source_hash),
+                source_length,
+                on_complete_root = move(on_complete_root),
+                settings_root = move(settings_root)](auto bytecode_cache) mutable {
+                Optional<NonnullRefPtr<JS::SourceCode const>> source_code;
+                if (bytecode_cache) {
+                    source_code = JS::SourceCode::create(
+                        utf16_string_from_url_ascii(url_string.view()),
+                        source_length,
+                        "UTF-8"sv,
+                        source_byte_storage);
+                    auto module_script = ModuleScript::create_from_bytecode_cache(url_string, *source_code, *settings_root, response_url, bytecode_cache.release_nonnull()).release_value_but_fixme_should_propagate_errors();
+                    if (module_script && module_script->parse_error().is_null()) {
+                        settings_root->module_map().set(url, module_type_string, { ModuleMap::EntryType::ModuleScript, module_script });
+                        on_complete_root->function()(module_script);
+                        return;
+                    }
+                    source_code = {};
+                }
+
+                if (!source_code.has_value()) {
+                    auto fallback_decoder = TextCodec::decoder_for("UTF-8"sv);
+                    VERIFY(fallback_decoder.has_value());
+                    source_code = JS::SourceCode::create(
+                        utf16_string_from_url_ascii(url_string.view()),
+                        decode_source_text_to_utf16(*fallback_decoder, source_byte_storage.bytes()).release_value_but_fixme_should_propagate_errors());
+                }
+
+                compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Module, 0,
+                    [url = move(url), url_string = move(url_string), response_url = move(response_url),
+                        module_type_string = move(module_type_string),
+                        bytecode_cache_context = move(bytecode_cache_context),
+                        source_hash = move(source_hash),
+                        on_complete_root = move(on_complete_root),
+                        settings_root = move(settings_root)](auto result, auto source_code) mutable {
+                        auto source_code_for_cache = source_code;
+                        auto should_generate_bytecode_cache = result.compiled && bytecode_cache_context.has_value();
+                        auto module_script = result.compiled
+                            ? ModuleScript::create_from_pre_compiled(url_string, move(source_code), *settings_root, move(response_url), result.compiled).release_value_but_fixme_should_propagate_errors()
+                            : ModuleScript::create_from_pre_parsed(url_string, move(source_code), *settings_root, move(response_url), result.parsed).release_value_but_fixme_should_propagate_errors();
+                        BytecodeCacheInstallTarget install_target;
+                        if (module_script) {
+                            module_script->record().visit(
+                                [](Empty) {},
+                                [&](GC::Ref<JS::SourceTextModule> module) { install_target.module = module; },
+                                [](GC::Ref<JS::SyntheticModule>) {},
+                                [](GC::Ref<WebAssembly::WebAssemblyModule>) {});
+                            if (!should_generate_bytecode_cache)
+                                compile_remaining_module_functions_off_thread(*module_script, source_code_for_cache);
+                        }
+                        settings_root->module_map().set(url, module_type_string, { ModuleMap::EntryType::ModuleScript, module_script });
+                        on_complete_root->function()(module_script);
+                        if (should_generate_bytecode_cache) {
+                            install_target.begin_generation();
+                            VERIFY(source_hash.has_value());
+                            schedule_bytecode_cache_generation(move(source_code_for_cache), JS::RustIntegration::ProgramType::Module, 0, bytecode_cache_context.release_value(), move(install_target), source_hash.release_value());
+                        }
+                    });
+            });
+        return;
+    }
+
+    if (!source_code.has_value()) {
+        source_code = JS::SourceCode::create(
+            utf16_string_from_url_ascii(url_string.view()),
+            decode_source_text_to_utf16(*decoder, source_bytes).release_value_but_fixme_should_propagate_errors());
+    }
+
+    compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Module, 0,
+        [url = move(url), url_string = move(url_string), response_url = move(response_url),
+            module_type_string = move(module_type_string),
+            bytecode_cache_context = move(bytecode_cache_context),
+            source_hash = move(source_hash),
+            on_complete_root = move(on_complete_root),
+            settings_root = move(settings_root)](auto result, auto source_code) mutable {
+            auto source_code_for_cache = source_code;
+            auto should_generate_bytecode_cache = result.compiled && bytecode_cache_context.has_value();
+            auto module_script = result.compiled
+                ? ModuleScript::create_from_pre_compiled(url_string, move(source_code), *settings_root, move(response_url), result.compiled).release_value_but_fixme_should_propagate_errors()
+                : ModuleScript::create_from_pre_parsed(url_string, move(source_code), *settings_root, move(response_url), result.parsed).release_value_but_fixme_should_propagate_errors();
+            BytecodeCacheInstallTarget install_target;
+            if (module_script) {
+                module_script->record().visit(
+                    [](Empty) {},
+                    [&](GC::Ref<JS::SourceTextModule> module) { install_target.module = module; },
+                    [](GC::Ref<JS::SyntheticModule>) {},
+                    [](GC::Ref<WebAssembly::WebAssemblyModule>) {});
+                if (!should_generate_bytecode_cache)
+                    compile_remaining_module_functions_off_thread(*module_script, source_code_for_cache);
+            }
+            settings_root->module_map().set(url, module_type_string, { ModuleMap::EntryType::ModuleScript, module_script });
+            on_complete_root->function()(module_script);
+            if (should_generate_bytecode_cache) {
+                install_target.begin_generation();
+                VERIFY(source_hash.has_value());
+                schedule_bytecode_cache_generation(move(source_code_for_cache), JS::RustIntegration::ProgramType::Module, 0, bytecode_cache_context.release_value(), move(install_target), source_hash.release_value());
+            }
+        });
+}
+
 // https://html.spec.whatwg.org/multipage/webappapis.html#fetch-a-single-module-script
 void fetch_single_module_script(JS::Realm& realm,
     URL::URL const& url,
@@ -1173,125 +1369,26 @@ void fetch_single_module_script(JS::Realm& realm,
             //    and options.
             // FIXME: Pass options.
             if (mime_type.has_value() && mime_type->is_javascript() && module_type == "javascript-or-wasm"sv) {
-                auto decoder = TextCodec::decoder_for("UTF-8"sv);
-                VERIFY(decoder.has_value());
-                auto on_complete_root = GC::make_root(on_complete);
-                auto settings_root = GC::make_root(settings_object);
-                auto url_string = url.to_byte_string();
                 auto response_url = response->url().value_or({});
-                auto module_type_string = module_type;
                 auto source_byte_storage = body_bytes.get<Core::ImmutableBytes>();
-                auto source_bytes = source_byte_storage.bytes();
-                auto const& bytecode = internal_response->javascript_bytecode_cache();
-                Optional<NonnullRefPtr<JS::SourceCode const>> source_code;
+                auto bytecode = internal_response->javascript_bytecode_cache();
                 auto bytecode_cache_context = bytecode_cache_context_for_request(*request, *internal_response, response_url);
                 Optional<BytecodeCacheSourceHash> source_hash;
                 if (bytecode.has_value() || bytecode_cache_context.has_value())
-                    source_hash = bytecode_cache_source_hash(source_bytes, "UTF-8"sv);
-                if (bytecode.has_value()) {
-                    auto source_length = TextCodec::convert_input_to_utf16_length_using_given_decoder_unless_there_is_a_byte_order_mark(*decoder, StringView { source_bytes }).release_value_but_fixme_should_propagate_errors();
-                    prepare_bytecode_cache_off_thread(*bytecode, JS::RustIntegration::ProgramType::Module, source_length, *source_hash,
-                        [url = move(url), url_string = move(url_string), response_url = move(response_url),
-                            module_type_string = move(module_type_string),
-                            source_byte_storage = move(source_byte_storage),
-                            bytecode_cache_context = move(bytecode_cache_context),
-                            source_hash = move(source_hash),
-                            source_length,
-                            on_complete_root = move(on_complete_root),
-                            settings_root = move(settings_root)](auto bytecode_cache) mutable {
-                            Optional<NonnullRefPtr<JS::SourceCode const>> source_code;
-                            if (bytecode_cache) {
-                                source_code = JS::SourceCode::create(
-                                    utf16_string_from_url_ascii(url_string.view()),
-                                    source_length,
-                                    "UTF-8"sv,
-                                    source_byte_storage);
-                                auto module_script = ModuleScript::create_from_bytecode_cache(url_string, *source_code, *settings_root, response_url, bytecode_cache.release_nonnull()).release_value_but_fixme_should_propagate_errors();
-                                if (module_script && module_script->parse_error().is_null()) {
-                                    settings_root->module_map().set(url, module_type_string, { ModuleMap::EntryType::ModuleScript, module_script });
-                                    on_complete_root->function()(module_script);
-                                    return;
-                                }
-                                source_code = {};
-                            }
+                    source_hash = bytecode_cache_source_hash(source_byte_storage.bytes(), "UTF-8"sv);
 
-                            if (!source_code.has_value()) {
-                                auto fallback_decoder = TextCodec::decoder_for("UTF-8"sv);
-                                VERIFY(fallback_decoder.has_value());
-                                source_code = JS::SourceCode::create(
-                                    utf16_string_from_url_ascii(url_string.view()),
-                                    decode_source_text_to_utf16(*fallback_decoder, source_byte_storage.bytes()).release_value_but_fixme_should_propagate_errors());
-                            }
-
-                            compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Module, 0,
-                                [url = move(url), url_string = move(url_string), response_url = move(response_url),
-                                    module_type_string = move(module_type_string),
-                                    bytecode_cache_context = move(bytecode_cache_context),
-                                    source_hash = move(source_hash),
-                                    on_complete_root = move(on_complete_root),
-                                    settings_root = move(settings_root)](auto result, auto source_code) mutable {
-                                    auto source_code_for_cache = source_code;
-                                    auto should_generate_bytecode_cache = result.compiled && bytecode_cache_context.has_value();
-                                    auto module_script = result.compiled
-                                        ? ModuleScript::create_from_pre_compiled(url_string, move(source_code), *settings_root, move(response_url), result.compiled).release_value_but_fixme_should_propagate_errors()
-                                        : ModuleScript::create_from_pre_parsed(url_string, move(source_code), *settings_root, move(response_url), result.parsed).release_value_but_fixme_should_propagate_errors();
-                                    BytecodeCacheInstallTarget install_target;
-                                    if (module_script) {
-                                        module_script->record().visit(
-                                            [](Empty) {},
-                                            [&](GC::Ref<JS::SourceTextModule> module) { install_target.module = module; },
-                                            [](GC::Ref<JS::SyntheticModule>) {},
-                                            [](GC::Ref<WebAssembly::WebAssemblyModule>) {});
-                                        if (!should_generate_bytecode_cache)
-                                            compile_remaining_module_functions_off_thread(*module_script, source_code_for_cache);
-                                    }
-                                    settings_root->module_map().set(url, module_type_string, { ModuleMap::EntryType::ModuleScript, module_script });
-                                    on_complete_root->function()(module_script);
-                                    if (should_generate_bytecode_cache) {
-                                        install_target.begin_generation();
-                                        VERIFY(source_hash.has_value());
-                                        schedule_bytecode_cache_generation(move(source_code_for_cache), JS::RustIntegration::ProgramType::Module, 0, bytecode_cache_context.release_value(), move(install_target), source_hash.release_value());
-                                    }
-                                });
-                        });
+                auto shared_bytecode_cache_partition = bytecode.has_value() ? Optional<ByteString> {} : shared_bytecode_cache_partition_for(bytecode_cache_context);
+                if (!shared_bytecode_cache_partition.has_value()) {
+                    create_javascript_module_script_off_thread(url, move(response_url), module_type, move(source_byte_storage), settings_object, on_complete, move(bytecode), move(bytecode_cache_context), move(source_hash));
                     return;
                 }
 
-                if (!source_code.has_value()) {
-                    source_code = JS::SourceCode::create(
-                        utf16_string_from_url_ascii(url_string.view()),
-                        decode_source_text_to_utf16(*decoder, source_bytes).release_value_but_fixme_should_propagate_errors());
-                }
-
-                compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Module, 0,
-                    [url = move(url), url_string = move(url_string), response_url = move(response_url),
-                        module_type_string = move(module_type_string),
-                        bytecode_cache_context = move(bytecode_cache_context),
-                        source_hash = move(source_hash),
-                        on_complete_root = move(on_complete_root),
-                        settings_root = move(settings_root)](auto result, auto source_code) mutable {
-                        auto source_code_for_cache = source_code;
-                        auto should_generate_bytecode_cache = result.compiled && bytecode_cache_context.has_value();
-                        auto module_script = result.compiled
-                            ? ModuleScript::create_from_pre_compiled(url_string, move(source_code), *settings_root, move(response_url), result.compiled).release_value_but_fixme_should_propagate_errors()
-                            : ModuleScript::create_from_pre_parsed(url_string, move(source_code), *settings_root, move(response_url), result.parsed).release_value_but_fixme_should_propagate_errors();
-                        BytecodeCacheInstallTarget install_target;
-                        if (module_script) {
-                            module_script->record().visit(
-                                [](Empty) {},
-                                [&](GC::Ref<JS::SourceTextModule> module) { install_target.module = module; },
-                                [](GC::Ref<JS::SyntheticModule>) {},
-                                [](GC::Ref<WebAssembly::WebAssemblyModule>) {});
-                            if (!should_generate_bytecode_cache)
-                                compile_remaining_module_functions_off_thread(*module_script, source_code_for_cache);
-                        }
-                        settings_root->module_map().set(url, module_type_string, { ModuleMap::EntryType::ModuleScript, module_script });
-                        on_complete_root->function()(module_script);
-                        if (should_generate_bytecode_cache) {
-                            install_target.begin_generation();
-                            VERIFY(source_hash.has_value());
-                            schedule_bytecode_cache_generation(move(source_code_for_cache), JS::RustIntegration::ProgramType::Module, 0, bytecode_cache_context.release_value(), move(install_target), source_hash.release_value());
-                        }
+                auto shared_bytecode_source_hash = *source_hash;
+                retrieve_shared_bytecode_cache(shared_bytecode_cache_partition.release_value(), shared_bytecode_source_hash,
+                    [url, response_url = move(response_url), module_type, source_byte_storage = move(source_byte_storage),
+                        settings_root = GC::make_root(settings_object), on_complete_root = GC::make_root(on_complete),
+                        bytecode_cache_context = move(bytecode_cache_context), source_hash = move(source_hash)](Optional<Core::ImmutableBytes> bytecode) mutable {
+                        create_javascript_module_script_off_thread(move(url), move(response_url), move(module_type), move(source_byte_storage), *settings_root, *on_complete_root, move(bytecode), move(bytecode_cache_context), move(source_hash));
                     });
                 return;
             }
@@ -105,4 +105,13 @@ Fetch::Infrastructure::Request::Destination fetch_destination_from_module_type(F
 
 void fetch_single_module_script(JS::Realm&, URL::URL const&, EnvironmentSettingsObject& fetch_client, Fetch::Infrastructure::Request::Destination, ScriptFetchOptions const&, EnvironmentSettingsObject&, Web::Fetch::Infrastructure::Request::ReferrerType const&, Optional<JS::ModuleRequest> const&, TopLevelModule, PerformTheFetchHook, OnFetchScriptComplete callback);
 
+// Speculatively compiling every inner function of a large bundle spends time and memory on code that may never run, so
+// only this many UTF-16 code units of function source are compiled ahead of time per executable. Anything over the
+// budget keeps its AST and is compiled on its first call instead.
+constexpr size_t speculative_compile_code_unit_budget = 256 * 1024;
+
+// Given the source lengths of the inner functions of an executable that are still uncompiled, in order, returns the
+// indices of those that are compiled ahead of time.
+WEB_API Vector<size_t> select_functions_for_speculative_compile(ReadonlySpan<size_t> source_lengths_in_code_units);
+
 }
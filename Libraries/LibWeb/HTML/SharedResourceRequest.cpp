@@ -16,6 +16,7 @@
 #include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Statuses.h>
+#include <LibWeb/Fetch/Infrastructure/NetworkPartitionKey.h>
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
 #include <LibWeb/HTML/BitmapDecodedImageData.h>
 #include <LibWeb/HTML/DecodedImageData.h>
@@ -31,6 +32,9 @@ GC_DEFINE_ALLOCATOR(SharedResourceRequest);
 
 static u64 s_next_memory_cache_touch_serial;
 
+// Smaller images are decoded once all of their data has arrived; showing them early isn't worth decoding them twice.
+static constexpr size_t INCREMENTAL_DECODE_THRESHOLD = 64 * KiB;
+
 GC::Ref<SharedResourceRequest> SharedResourceRequest::get_or_create(JS::Realm& realm, GC::Ref<Page> page, URL::URL const& url)
 {
     auto document = Bindings::principal_host_defined_environment_settings_object(realm).responsible_document();
@@ -62,7 +66,9 @@ void SharedResourceRequest::finalize()
     m_callbacks.clear();
     m_load_event_delayer.clear();
     m_image_data = nullptr;
+    m_partial_image_data = nullptr;
     m_fetch_controller = nullptr;
+    end_incremental_decode();
 
     if (m_document) {
         auto& shared_resource_requests = m_document->shared_resource_requests();
@@ -82,8 +88,10 @@ void SharedResourceRequest::visit_edges(JS::Cell::Visitor& visitor)
     for (auto& callback : m_callbacks) {
         visitor.visit(callback.on_finish);
         visitor.visit(callback.on_fail);
+        visitor.visit(callback.on_partial_image);
     }
     visitor.visit(m_image_data);
+    visitor.visit(m_partial_image_data);
 }
 
 GC::Ptr<DecodedImageData> SharedResourceRequest::image_data() const
@@ -136,17 +144,6 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
         //        https://github.com/whatwg/html/issues/9355
         response = response->unsafe_response();
 
-        auto process_body = GC::create_function(self->heap(), [weak_this, request, response, image_data_is_cors_cross_origin](ByteBuffer data) {
-            auto self = weak_this.ptr();
-            if (!self)
-                return;
-
-            auto extracted_mime_type = Fetch::Infrastructure::extract_mime_type(response->header_list());
-            auto const is_svg_image = extracted_mime_type.has_value()
-                ? extracted_mime_type.value().essence() == "image/svg+xml"sv
-                : request->url().basename().ends_with(".svg"sv);
-            self->handle_successful_fetch(request->url(), is_svg_image ? IsSVGImage::Yes : IsSVGImage::No, move(data), image_data_is_cors_cross_origin);
-        });
         auto process_body_error = GC::create_function(self->heap(), [weak_this](JS::Value) {
             auto self = weak_this.ptr();
             if (!self)
@@ -161,7 +158,42 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
             return;
         }
 
-        response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
+        auto extracted_mime_type = Fetch::Infrastructure::extract_mime_type(response->header_list());
+        auto const is_svg_image = extracted_mime_type.has_value()
+            ? extracted_mime_type.value().essence() == "image/svg+xml"sv
+            : request->url().basename().ends_with(".svg"sv);
+
+        if (is_svg_image) {
+            auto process_body = GC::create_function(self->heap(), [weak_this, request, image_data_is_cors_cross_origin](ByteBuffer data) {
+                auto self = weak_this.ptr();
+                if (!self)
+                    return;
+
+                self->handle_successful_fetch(request->url(), IsSVGImage::Yes, move(data), image_data_is_cors_cross_origin);
+            });
+
+            response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
+            return;
+        }
+
+        // NB: Raster images are read as their data arrives, so that large ones can be shown before they have loaded.
+        auto process_body_chunk = GC::create_function(self->heap(), [weak_this](ByteBuffer chunk) {
+            auto self = weak_this.ptr();
+            if (!self)
+                return;
+
+            self->process_image_body_chunk(move(chunk));
+        });
+        auto process_end_of_body = GC::create_function(self->heap(), [weak_this, request, image_data_is_cors_cross_origin] {
+            auto self = weak_this.ptr();
+            if (!self)
+                return;
+
+            self->end_incremental_decode();
+            self->handle_successful_fetch(request->url(), IsSVGImage::No, move(self->m_received_data), image_data_is_cors_cross_origin);
+        });
+
+        response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { realm.global_object() });
     };
 
     m_state = State::Fetching;
@@ -175,7 +207,7 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
     set_fetch_controller(fetch_controller);
 }
 
-void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial_image)
 {
     if (m_state == State::Finished) {
         if (on_finish)
@@ -194,10 +226,58 @@ void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<v
         callbacks.on_finish = GC::create_function(vm().heap(), move(on_finish));
     if (on_fail)
         callbacks.on_fail = GC::create_function(vm().heap(), move(on_fail));
+    if (on_partial_image)
+        callbacks.on_partial_image = GC::create_function(vm().heap(), move(on_partial_image));
 
     m_callbacks.append(move(callbacks));
 }
 
+void SharedResourceRequest::process_image_body_chunk(ByteBuffer chunk)
+{
+    m_received_data.append(chunk);
+    ++m_received_chunk_count;
+
+    if (m_incremental_decode_id.has_value()) {
+        Platform::ImageCodecPlugin::the().append_incremental_decode_data(*m_incremental_decode_id, chunk);
+        return;
+    }
+
+    // NB: A body that arrives in a single chunk, e.g. from the cache, is complete by the time it could be shown.
+    if (m_received_chunk_count > 1 && m_received_data.size() >= INCREMENTAL_DECODE_THRESHOLD)
+        start_incremental_decode();
+}
+
+void SharedResourceRequest::start_incremental_decode()
+{
+    GC::Weak weak_this { *this };
+    m_incremental_decode_id = Platform::ImageCodecPlugin::the().start_incremental_decode([weak_this](NonnullRefPtr<Gfx::Bitmap> bitmap) {
+        if (auto self = weak_this.ptr())
+            self->handle_partial_image(move(bitmap));
+    });
+
+    if (m_incremental_decode_id.has_value())
+        Platform::ImageCodecPlugin::the().append_incremental_decode_data(*m_incremental_decode_id, m_received_data);
+}
+
+void SharedResourceRequest::end_incremental_decode()
+{
+    if (auto decode_id = m_incremental_decode_id.take(); decode_id.has_value())
+        Platform::ImageCodecPlugin::the().end_incremental_decode(*decode_id);
+}
+
+void SharedResourceRequest::handle_partial_image(NonnullRefPtr<Gfx::Bitmap> bitmap)
+{
+    if (m_state != State::Fetching || !m_document)
+        return;
+
+    // FIXME: Apply the image's color profile, which is only known once it has been decoded in full.
+    m_partial_image_data = BitmapDecodedImageData::create(m_document->realm(), { *bitmap });
+    for (auto& callback : m_callbacks) {
+        if (callback.on_partial_image)
+            callback.on_partial_image->function()();
+    }
+}
+
 void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string, IsSVGImage is_svg_image, ByteBuffer data, bool image_data_is_cors_cross_origin)
 {
     // AD-HOC: At this point, things gets very ad-hoc.
@@ -215,7 +295,9 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
         return;
     }
 
-    auto handle_successful_bitmap_decode = [strong_this = GC::Root(*this), image_data_is_cors_cross_origin](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+    auto decode_cache_partition = Fetch::Infrastructure::determine_the_network_partition_key(m_document->relevant_settings_object()).serialized_top_level_site();
+
+    auto handle_successful_bitmap_decode = [strong_this = GC::Root(*this), image_data_is_cors_cross_origin, encoded_data = data, decode_cache_partition](Web::Platform::DecodedImage& result) mutable -> ErrorOr<void> {
         if (result.session_id != 0) {
             // Streaming animated decode: create AnimatedBitmapDecodedImageData.
             Vector<NonnullRefPtr<Gfx::Bitmap>> initial_bitmaps;
@@ -240,7 +322,7 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
             // Non animated decode: create a single framed BitmapDecodedImageData.
             VERIFY(result.frames.size() == 1);
 
-            strong_this->m_image_data = BitmapDecodedImageData::create(strong_this->m_document->realm(), { *result.frames[0].bitmap, result.color_space });
+            strong_this->m_image_data = BitmapDecodedImageData::create(strong_this->m_document->realm(), { *result.frames[0].bitmap, result.color_space }, move(encoded_data), move(decode_cache_partition));
         }
         strong_this->m_image_data->set_is_cors_cross_origin(image_data_is_cors_cross_origin);
         strong_this->handle_successful_resource_load();
@@ -251,7 +333,7 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
         strong_this->handle_failed_fetch();
     };
 
-    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode));
+    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode), move(decode_cache_partition));
 }
 
 void SharedResourceRequest::handle_failed_fetch()
@@ -259,6 +341,9 @@ void SharedResourceRequest::handle_failed_fetch()
     m_state = State::Failed;
     m_load_event_delayer.clear();
     m_fetch_controller = nullptr;
+    m_received_data.clear();
+    m_partial_image_data = nullptr;
+    end_incremental_decode();
     for (auto& callback : m_callbacks) {
         if (callback.on_fail)
             callback.on_fail->function()();
@@ -271,6 +356,7 @@ void SharedResourceRequest::handle_successful_resource_load()
     m_state = State::Finished;
     m_load_event_delayer.clear();
     m_fetch_controller = nullptr;
+    m_partial_image_data = nullptr;
     for (auto& callback : m_callbacks) {
         if (callback.on_finish)
             callback.on_finish->function()();
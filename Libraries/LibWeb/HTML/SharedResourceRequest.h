@@ -29,6 +29,9 @@ public:
     URL::URL const& url() const { return m_url; }
 
     [[nodiscard]] GC::Ptr<DecodedImageData> image_data() const;
+
+    // The image as far as it has been decoded while its data is still arriving.
+    [[nodiscard]] GC::Ptr<DecodedImageData> partial_image_data() const { return m_partial_image_data; }
     [[nodiscard]] bool can_be_pruned_from_memory_cache() const;
     [[nodiscard]] u64 cache_touch_serial() const { return m_cache_touch_serial; }
     void touch_memory_cache_entry();
@@ -38,7 +41,7 @@ public:
 
     void fetch_resource(JS::Realm&, GC::Ref<Fetch::Infrastructure::Request>);
 
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial_image = {});
 
     bool is_fetching() const;
     bool needs_fetching() const;
@@ -55,6 +58,10 @@ private:
     };
 
     void handle_successful_fetch(URL::URL const&, IsSVGImage, ByteBuffer data, bool image_data_is_cors_cross_origin);
+    void process_image_body_chunk(ByteBuffer);
+    void start_incremental_decode();
+    void end_incremental_decode();
+    void handle_partial_image(NonnullRefPtr<Gfx::Bitmap>);
     void handle_failed_fetch();
     void handle_successful_resource_load();
 
@@ -72,11 +79,18 @@ private:
     struct Callbacks {
         GC::Ptr<GC::Function<void()>> on_finish;
         GC::Ptr<GC::Function<void()>> on_fail;
+        GC::Ptr<GC::Function<void()>> on_partial_image;
     };
     Vector<Callbacks> m_callbacks;
 
     URL::URL m_url;
     GC::Ptr<DecodedImageData> m_image_data;
+
+    // The body of a raster image as it arrives, which is decoded incrementally once it's large enough.
+    ByteBuffer m_received_data;
+    size_t m_received_chunk_count { 0 };
+    Optional<i64> m_incremental_decode_id;
+    GC::Ptr<DecodedImageData> m_partial_image_data;
     GC::Ptr<Fetch::Infrastructure::FetchController> m_fetch_controller;
     u64 m_cache_touch_serial { 0 };
 
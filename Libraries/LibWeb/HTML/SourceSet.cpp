@@ -10,6 +10,7 @@
 #include <AK/Utf16StringBuilder.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/Parser/Parser.h>
+#include <LibWeb/CSS/StyleValues/LengthStyleValue.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/SourceSet.h>
 #include <LibWeb/Infra/CharacterTypes.h>
@@ -351,8 +352,19 @@ NonnullRefPtr<CSS::StyleValue const> parse_a_sizes_attribute(DOM::Element const&
     return css_parser.parse_as_sizes_attribute(element, img);
 }
 
+// https://html.spec.whatwg.org/multipage/images.html#parse-a-sizes-attribute
+NonnullRefPtr<CSS::StyleValue const> parse_a_sizes_attribute(DOM::Document const& document, Utf16View sizes)
+{
+    // AD-HOC: Like for an element without a sizes attribute, an empty one always results in 100vw.
+    if (sizes.is_empty())
+        return CSS::LengthStyleValue::create(CSS::Length(100, CSS::LengthUnit::Vw));
+
+    auto css_parser = CSS::Parser::Parser::create(CSS::Parser::ParsingParams { document }, sizes);
+    return css_parser.parse_as_sizes_attribute(nullptr);
+}
+
 // https://html.spec.whatwg.org/multipage/images.html#create-a-source-set
-SourceSet SourceSet::create(DOM::Element const& element, Utf16View default_source, Utf16View srcset, Utf16View sizes, HTML::HTMLImageElement const* img)
+static SourceSet create_a_source_set(DOM::Document const& document, Utf16View default_source, Utf16View srcset, NonnullRefPtr<CSS::StyleValue const> source_size)
 {
     // When asked to create a source set given a string default source, a string srcset, a string sizes, and an element or null img:
 
@@ -364,7 +376,8 @@ SourceSet SourceSet::create(DOM::Element const& element, Utf16View default_sourc
         source_set = parse_a_srcset_attribute(srcset);
 
     // 3. Set source set's source size to the result of parsing sizes with img.
-    source_set.m_source_size = parse_a_sizes_attribute(element, sizes, img);
+    // NB: The callers have already parsed sizes, as that depends on whether there is an element.
+    source_set.m_source_size = move(source_size);
 
     // 4. If default source is not the empty string and source set does not contain an image source
     //    with a pixel density descriptor value of 1, and no image source with a width descriptor,
@@ -385,14 +398,29 @@ SourceSet SourceSet::create(DOM::Element const& element, Utf16View default_sourc
     }
 
     // 5. Normalize the source densities of source set.
-    source_set.normalize_source_densities(element);
+    source_set.normalize_source_densities(document);
 
     // 6. Return source set.
     return source_set;
 }
 
+SourceSet SourceSet::create(DOM::Element const& element, Utf16View default_source, Utf16View srcset, Utf16View sizes, HTML::HTMLImageElement const* img)
+{
+    return create_a_source_set(element.document(), default_source, srcset, parse_a_sizes_attribute(element, sizes, img));
+}
+
+SourceSet SourceSet::create(DOM::Document const& document, Utf16View default_source, Utf16View srcset, Utf16View sizes)
+{
+    return create_a_source_set(document, default_source, srcset, parse_a_sizes_attribute(document, sizes));
+}
+
 // https://html.spec.whatwg.org/multipage/images.html#normalise-the-source-densities
 void SourceSet::normalize_source_densities(DOM::Element const& element)
+{
+    normalize_source_densities(element.document());
+}
+
+void SourceSet::normalize_source_densities(DOM::Document const& document)
 {
     // 1. Let source size be source set's source size.
 
@@ -403,7 +431,7 @@ void SourceSet::normalize_source_densities(DOM::Element const& element)
     // https://drafts.csswg.org/mediaqueries/#units
     // Relative length units in media queries are based on the initial value, which means that units are never based on
     // results of declarations.
-    auto const& length_resolution_context = CSS::Length::ResolutionContext::for_document(element.document());
+    auto const& length_resolution_context = CSS::Length::ResolutionContext::for_document(document);
 
     auto source_size = CSS::Length::from_style_value(m_source_size->absolutized({ length_resolution_context }), {}).absolute_length_to_px();
 
@@ -36,6 +36,8 @@ struct ImageSourceAndPixelDensity {
 // https://html.spec.whatwg.org/multipage/images.html#source-set
 struct SourceSet {
     static SourceSet create(DOM::Element const& element, Utf16View default_source, Utf16View srcset, Utf16View sizes, HTML::HTMLImageElement const* img = nullptr);
+    // For an img element that doesn't exist yet, such as one the speculative HTML parser has found.
+    static SourceSet create(DOM::Document const&, Utf16View default_source, Utf16View srcset, Utf16View sizes);
 
     [[nodiscard]] bool is_empty() const;
 
@@ -44,6 +46,7 @@ struct SourceSet {
 
     // https://html.spec.whatwg.org/multipage/images.html#normalise-the-source-densities
     void normalize_source_densities(DOM::Element const&);
+    void normalize_source_densities(DOM::Document const&);
 
     SourceSet();
 
@@ -53,5 +56,6 @@ struct SourceSet {
 
 SourceSet parse_a_srcset_attribute(Utf16View);
 [[nodiscard]] NonnullRefPtr<CSS::StyleValue const> parse_a_sizes_attribute(DOM::Element const& element, Utf16View sizes, HTML::HTMLImageElement const* img = nullptr);
+[[nodiscard]] NonnullRefPtr<CSS::StyleValue const> parse_a_sizes_attribute(DOM::Document const&, Utf16View sizes);
 
 }
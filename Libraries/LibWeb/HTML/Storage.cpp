@@ -209,7 +209,7 @@ void Storage::broadcast(Optional<Utf16View> key, Optional<Utf16View> old_value,
         auto storage_endpoint = type() == Type::Local
             ? StorageAPI::StorageEndpointType::LocalStorage
             : StorageAPI::StorageEndpointType::SessionStorage;
-        this_document.page().client().page_did_broadcast_storage_change(storage_endpoint, this_document.url().serialize(), optional_utf16_string(key), optional_utf16_string(old_value), optional_utf16_string(new_value));
+        this_document.page().client().page_did_broadcast_storage_change(storage_endpoint, storage_key->to_string(), this_document.url().serialize(), optional_utf16_string(key), optional_utf16_string(old_value), optional_utf16_string(new_value));
     }
 
     // 2. Let url be the serialization of thisDocument's URL.
@@ -284,6 +284,38 @@ void Storage::broadcast(Optional<Utf16View> key, Optional<Utf16View> old_value,
     }
 }
 
+// NB: This runs the remaining steps of broadcast for every Storage object in this process, as the document that changed
+//     the storage lives in another one.
+void Storage::broadcast_local_storage_change_from_other_process(String const& storage_key, String const& url, Optional<Utf16String> const& key, Optional<Utf16String> const& old_value, Optional<Utf16String> const& new_value)
+{
+    auto event_url = Utf16String::from_utf8(url);
+
+    Window::for_each_active([&](auto& window) {
+        // NB: Windows of other storage keys are skipped before obtaining their storage, so that their storage areas
+        //     aren't loaded for nothing.
+        auto window_storage_key = StorageAPI::obtain_a_storage_key(relevant_settings_object(window));
+        if (!window_storage_key.has_value() || window_storage_key->to_string() != storage_key)
+            return IterationDecision::Continue;
+
+        auto remote_storage = obtain_storage_for_window(window, Type::Local);
+        if (!remote_storage)
+            return IterationDecision::Continue;
+
+        queue_global_task(Task::Source::DOMManipulation, window, GC::create_function(window.heap(), [key, old_value, new_value, event_url, storage = GC::Ref { *remote_storage }] {
+            auto& realm = storage->realm();
+
+            Bindings::StorageEventInit init;
+            init.key = key;
+            init.old_value = old_value;
+            init.new_value = new_value;
+            init.url = event_url;
+            init.storage_area = storage;
+            as<Window>(relevant_global_object(storage)).dispatch_event(StorageEvent::create(realm, EventNames::storage, init));
+        }));
+        return IterationDecision::Continue;
+    });
+}
+
 Vector<Utf16FlyString> Storage::supported_property_names() const
 {
     // The supported property names on a Storage object storage are the result of running get the keys on storage's map.
@@ -41,6 +41,9 @@ public:
     void clear();
     Type type() const { return m_type; }
 
+    // Fires storage events for a change that a document in another process made to the local storage of a storage key.
+    static void broadcast_local_storage_change_from_other_process(String const& storage_key, String const& url, Optional<Utf16String> const& key, Optional<Utf16String> const& old_value, Optional<Utf16String> const& new_value);
+
     void dump() const;
 
 private:
@@ -1158,6 +1158,29 @@ static WebIDL::ExceptionOr<void> serialize_viewed_array_buffer(JS::VM& vm, Struc
     return {};
 }
 
+// Whether the own properties of object can be serialized by walking its packed indexed elements and its shape, rather
+// than going through EnumerableOwnProperties(), HasOwnProperty() and [[Get]] for each key. That is the case when none of
+// object's own properties can run code when read.
+static bool own_properties_can_be_read_directly(JS::Object const& object)
+{
+    if (!object.eligible_for_own_property_enumeration_fast_path()
+        || object.has_intrinsic_accessors()
+        || object.may_interfere_with_indexed_property_access()
+        || object.indexed_storage_kind() > JS::IndexedStorageKind::Packed
+        || object.shape().is_dictionary())
+        return false;
+
+    bool has_accessors = false;
+    object.shape().for_each_property_in_insertion_order([&](auto const& property_key, auto const& metadata) {
+        if (property_key.is_string() && metadata.attributes.is_enumerable() && object.get_direct(metadata.offset).is_accessor()) {
+            has_accessors = true;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    return !has_accessors;
+}
+
 // Serializing and deserializing are each two passes:
 // 1. Fill up the memory with all the values, but without translating references
 // 2. Translate all the references into the appropriate form
@@ -1449,6 +1472,14 @@ public:
                 TRY(serializable->serialization_steps(serialized, m_for_storage, m_memory));
             }
 
+            // OPTIMIZATION: Plain objects and packed arrays make up most of what gets posted between windows and workers.
+            //               Read their properties straight out of storage instead of creating a JS string for every key
+            //               and looking each of them up again.
+            else if (own_properties_can_be_read_directly(object)) {
+                TRY(serialize_own_properties_directly(object));
+                encode(ValueTag::EndObject);
+            }
+
             // 4. Otherwise, for each key in ! EnumerableOwnProperties(value, key):
             else {
                 for (auto key : MUST(object.enumerable_own_property_names(JS::Object::PropertyKind::Key))) {
@@ -1476,6 +1507,59 @@ public:
     }
 
 private:
+    // Equivalent to step 26.4 of StructuredSerializeInternal for objects where own_properties_can_be_read_directly() is true.
+    WebIDL::ExceptionOr<void> serialize_own_properties_directly(JS::Object& object)
+    {
+        // NB: Serializing a property value can run arbitrary code (e.g. getters on objects further down the graph), which
+        //     may change this object. Its keys are snapshotted up front just like EnumerableOwnProperties() would, but
+        //     once the layout they were read from is gone, we fall back to HasOwnProperty() and [[Get]] for the rest.
+        GC::Ref<JS::Shape> shape = object.shape();
+        u32 indexed_size = object.indexed_array_like_size();
+
+        struct NamedProperty {
+            JS::PropertyKey key;
+            u32 offset { 0 };
+        };
+        Vector<NamedProperty> named_properties;
+        named_properties.ensure_capacity(shape->property_count());
+        shape->for_each_property_in_insertion_order([&](auto const& property_key, auto const& metadata) {
+            if (property_key.is_string() && metadata.attributes.is_enumerable())
+                named_properties.unchecked_append({ property_key, metadata.offset });
+        });
+
+        auto serialize_property = [&](JS::PropertyKey const& property_key, Optional<JS::Value> direct_value) -> WebIDL::ExceptionOr<void> {
+            JS::Value input_value;
+            if (direct_value.has_value()) {
+                input_value = *direct_value;
+            } else {
+                if (!MUST(object.has_own_property(property_key)))
+                    return {};
+                input_value = TRY(object.internal_get(property_key, JS::Value { &object }));
+            }
+            TRY(structured_serialize_internal(m_vm, m_serialized, input_value, m_for_storage, m_memory));
+            encode(property_key.to_utf16_string());
+            return {};
+        };
+
+        for (u32 index = 0; index < indexed_size; ++index) {
+            Optional<JS::Value> direct_value;
+            if (object.indexed_storage_kind() == JS::IndexedStorageKind::Packed && index < object.indexed_array_like_size()) {
+                if (auto element = object.indexed_get(index); element.has_value() && !element->value.is_accessor())
+                    direct_value = element->value;
+            }
+            TRY(serialize_property(JS::PropertyKey { index }, direct_value));
+        }
+
+        for (auto const& property : named_properties) {
+            Optional<JS::Value> direct_value;
+            if (&object.shape() == shape.ptr())
+                direct_value = object.get_direct(property.offset);
+            TRY(serialize_property(property.key, direct_value));
+        }
+
+        return {};
+    }
+
     template<typename T>
     void encode(T const& value)
     {
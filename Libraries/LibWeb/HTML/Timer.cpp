@@ -19,20 +19,34 @@ GC::Ref<Timer> Timer::create(JS::Object& window_or_worker_global_scope, i32 mill
 }
 
 Timer::Timer(JS::Object& window_or_worker_global_scope, i32 milliseconds, Function<void()> callback, i32 id, Repeating repeating)
-    : m_window_or_worker_global_scope(window_or_worker_global_scope)
+    : m_callback(move(callback))
+    , m_armed_at(MonotonicTime::now())
+    , m_window_or_worker_global_scope(window_or_worker_global_scope)
     , m_id(id)
 {
+    auto on_timeout = [this] {
+        // NB: A repeating timer has already been armed again for its next firing by now.
+        if (m_timer->is_active())
+            did_arm();
+        m_callback();
+    };
     if (repeating == Repeating::Yes)
-        m_timer = Core::Timer::create_repeating(milliseconds, move(callback));
+        m_timer = Core::Timer::create_repeating(milliseconds, move(on_timeout));
     else
-        m_timer = Core::Timer::create_single_shot(milliseconds, move(callback));
+        m_timer = Core::Timer::create_single_shot(milliseconds, move(on_timeout));
 }
 
 void Timer::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_window_or_worker_global_scope);
-    visitor.visit_possible_values(m_timer->on_timeout.raw_capture_range());
+    visitor.visit_possible_values(m_callback.raw_capture_range());
+}
+
+void Timer::did_arm()
+{
+    m_armed_at = MonotonicTime::now();
+    m_armed_milliseconds = m_timer->interval();
 }
 
 void Timer::finalize()
@@ -43,7 +57,10 @@ void Timer::finalize()
 
 void Timer::start()
 {
+    if (m_timer->is_active())
+        return;
     m_timer->start();
+    did_arm();
 }
 
 void Timer::stop()
@@ -51,15 +68,48 @@ void Timer::stop()
     m_timer->stop();
 }
 
+bool Timer::is_active() const
+{
+    return m_timer->is_active();
+}
+
+void Timer::suspend()
+{
+    if (!m_timer->is_active())
+        return;
+    auto elapsed_milliseconds = (MonotonicTime::now() - m_armed_at).to_milliseconds();
+    m_remaining_milliseconds_when_suspended = static_cast<i32>(clamp(m_armed_milliseconds - elapsed_milliseconds, 0, m_armed_milliseconds));
+    m_timer->stop();
+}
+
+void Timer::resume()
+{
+    if (m_timer->is_active())
+        return;
+
+    auto interval = m_timer->interval();
+    auto remaining_milliseconds = m_remaining_milliseconds_when_suspended.value_or(interval);
+    m_remaining_milliseconds_when_suspended.clear();
+
+    m_timer->start(remaining_milliseconds);
+    did_arm();
+
+    // NB: Core::Timer re-arms a repeating timer with a changed interval the next time it fires.
+    if (!m_timer->is_single_shot())
+        m_timer->set_interval(interval);
+}
+
 void Timer::set_callback(Function<void()> callback)
 {
-    m_timer->on_timeout = move(callback);
+    m_callback = move(callback);
 }
 
 void Timer::set_interval(i32 milliseconds)
 {
-    if (m_timer->interval() != milliseconds)
+    if (m_timer->interval() != milliseconds) {
         m_timer->restart(milliseconds);
+        did_arm();
+    }
 }
 
 }
@@ -8,6 +8,7 @@
 
 #include <AK/Forward.h>
 #include <AK/Function.h>
+#include <AK/Time.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Forward.h>
 #include <LibGC/Function.h>
@@ -33,6 +34,13 @@ public:
 
     void start();
     void stop();
+    bool is_active() const;
+
+    // Stops the timer, remembering how much of its current wait it had left.
+    void suspend();
+    // Starts a suspended timer again, waiting only for what it had left. A repeating timer goes back to its full
+    // interval after that.
+    void resume();
 
     void set_callback(Function<void()>);
     void set_interval(i32 milliseconds);
@@ -43,7 +51,13 @@ private:
     virtual void visit_edges(Cell::Visitor&) override;
     virtual void finalize() override;
 
+    void did_arm();
+
     RefPtr<Core::Timer> m_timer;
+    Function<void()> m_callback;
+    MonotonicTime m_armed_at;
+    i32 m_armed_milliseconds { 0 };
+    Optional<i32> m_remaining_milliseconds_when_suspended;
     GC::Ref<JS::Object> m_window_or_worker_global_scope;
     i32 m_id { 0 };
 };
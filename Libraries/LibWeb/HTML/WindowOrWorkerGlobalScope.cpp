@@ -7,6 +7,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/NumericLimits.h>
 #include <AK/QuickSort.h>
 #include <AK/String.h>
@@ -369,7 +370,7 @@ GC::Ref<WebIDL::Promise> WindowOrWorkerGlobalScopeMixin::create_image_bitmap_imp
                     return {};
                 };
 
-                (void)Web::Platform::ImageCodecPlugin::the().decode_image(image_data, move(on_successful_decode), move(on_failed_decode));
+                (void)Web::Platform::ImageCodecPlugin::the().decode_image(image_data, move(on_successful_decode), move(on_failed_decode), {});
             }));
         },
         // -> ImageData
@@ -565,6 +566,40 @@ void WindowOrWorkerGlobalScopeMixin::clear_map_of_active_timers()
     m_timer_nesting_levels.clear();
 }
 
+Vector<i32> WindowOrWorkerGlobalScopeMixin::suspend_active_timers()
+{
+    Vector<i32> timer_keys;
+    for (auto& it : m_timers) {
+        if (!it.value->is_active())
+            continue;
+        it.value->suspend();
+        timer_keys.append(it.key);
+    }
+    return timer_keys;
+}
+
+void WindowOrWorkerGlobalScopeMixin::resume_suspended_timers(Vector<i32> const& timer_keys)
+{
+    for (auto timer_key : timer_keys) {
+        if (auto timer = m_timers.get(timer_key); timer.has_value())
+            timer.value()->resume();
+    }
+}
+
+// The timers of hidden pages that aren't playing audio are woken up together, at most once per this many milliseconds.
+static constexpr i64 background_timer_alignment_ms = 1000;
+
+static i32 timeout_with_background_throttling(JS::Object& global, i32 timeout)
+{
+    auto* window = as_if<Window>(global);
+    if (!window || !window->associated_document().hidden() || window->page().is_playing_audio())
+        return timeout;
+
+    auto now = MonotonicTime::now().milliseconds();
+    auto wake_up_time = ceil_div(now + timeout, background_timer_alignment_ms) * background_timer_alignment_ms;
+    return static_cast<i32>(min(wake_up_time - now, static_cast<i64>(NumericLimits<i32>::max())));
+}
+
 // https://html.spec.whatwg.org/multipage/timers-and-user-prompts.html#timer-initialisation-steps
 // With no active script fix from https://github.com/whatwg/html/pull/9712
 i32 WindowOrWorkerGlobalScopeMixin::run_timer_initialization_steps(TimerHandler handler, i32 timeout, GC::RootVector<JS::Value> arguments, Repeat repeat, Optional<i32> previous_id)
@@ -712,7 +747,9 @@ i32 WindowOrWorkerGlobalScopeMixin::run_timer_initialization_steps(TimerHandler
     // 13. Set uniqueHandle to the result of running steps after a timeout given global, "setTimeout/setInterval",
     //     timeout, and completionStep.
     //     FIXME: run_steps_after_a_timeout() needs to be updated to return a unique internal value that can be used here.
-    run_steps_after_a_timeout_impl(timeout, move(completion_step), id, repeat);
+    // NB: Running steps after a timeout may optionally wait longer than the timeout, which lets us throttle the timers
+    //     of background pages.
+    run_steps_after_a_timeout_impl(timeout_with_background_throttling(this_impl(), timeout), move(completion_step), id, repeat);
 
     // FIXME: 14. Set global's map of setTimeout and setInterval IDs[id] to uniqueHandle.
 
@@ -1089,16 +1126,27 @@ void WindowOrWorkerGlobalScopeMixin::forcibly_close_all_event_sources()
         event_source->forcibly_close();
 }
 
-void WindowOrWorkerGlobalScopeMixin::close_all_idb_connections()
+bool WindowOrWorkerGlobalScopeMixin::has_open_event_sources() const
 {
+    return any_of(m_registered_event_sources, [](auto const& event_source) {
+        return event_source->ready_state() != EventSource::ReadyState::Closed;
+    });
+}
+
+WindowOrWorkerGlobalScopeMixin::ClosedAnyIDBConnections WindowOrWorkerGlobalScopeMixin::close_all_idb_connections()
+{
+    auto closed_any_connections = ClosedAnyIDBConnections::No;
     IndexedDB::Database::for_each_database([&](IndexedDB::Database& database) {
         for (auto& connection : database.associated_connections_as_root_vector()) {
             if (connection->close_pending())
                 continue;
-            if (&as<WindowOrWorkerGlobalScopeMixin>(relevant_global_object(*connection)) == this)
+            if (&as<WindowOrWorkerGlobalScopeMixin>(relevant_global_object(*connection)) == this) {
                 IndexedDB::close_a_database_connection(connection);
+                closed_any_connections = ClosedAnyIDBConnections::Yes;
+            }
         }
     });
+    return closed_any_connections;
 }
 
 void WindowOrWorkerGlobalScopeMixin::register_web_socket(Badge<WebSockets::WebSocket>, GC::Ref<WebSockets::WebSocket> web_socket)
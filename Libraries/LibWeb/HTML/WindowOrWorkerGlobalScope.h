@@ -50,6 +50,11 @@ public:
     void clear_interval(i32);
     void clear_map_of_active_timers();
 
+    // NB: Our timers are backed by Core::Timers that keep running while the associated Document is not fully active,
+    //     so timers are stopped explicitly when a Document is kept alive for history traversal.
+    Vector<i32> suspend_active_timers();
+    void resume_suspended_timers(Vector<i32> const& timer_keys);
+
     enum class CheckIfPerformanceBufferIsFull {
         No,
         Yes,
@@ -75,8 +80,13 @@ public:
     void register_event_source(Badge<EventSource>, GC::Ref<EventSource>);
     void unregister_event_source(Badge<EventSource>, GC::Ref<EventSource>);
     void forcibly_close_all_event_sources();
+    bool has_open_event_sources() const;
 
-    void close_all_idb_connections();
+    enum class ClosedAnyIDBConnections {
+        No,
+        Yes,
+    };
+    ClosedAnyIDBConnections close_all_idb_connections();
 
     void register_web_socket(Badge<WebSockets::WebSocket>, GC::Ref<WebSockets::WebSocket>);
     void unregister_web_socket(Badge<WebSockets::WebSocket>, GC::Ref<WebSockets::WebSocket>);
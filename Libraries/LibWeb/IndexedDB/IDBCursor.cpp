@@ -392,7 +392,10 @@ WebIDL::ExceptionOr<GC::Ref<IDBRequest>> IDBCursor::update(JS::Value value)
     // NOTE: this is 'realm' above
 
     // 8. Let clone be a clone of value in targetRealm during transaction. Rethrow any exceptions.
-    auto clone = TRY(clone_in_realm(realm, value, transaction));
+    // OPTIMIZATION: The serialization the clone was made from is stored, rather than serializing the clone again when
+    //               the operation runs.
+    HTML::StorageSerializationRecord serialized_clone;
+    auto clone = TRY(clone_in_realm(realm, value, transaction, &serialized_clone));
 
     // 9. If this’s effective object store uses in-line keys, then:
     auto effective_object_store = this->effective_object_store();
@@ -413,9 +416,9 @@ WebIDL::ExceptionOr<GC::Ref<IDBRequest>> IDBCursor::update(JS::Value value)
     }
 
     // 10. Let operation be an algorithm to run store a record into an object store with this’s effective object store, clone, this’s effective key, and false.
-    auto operation = GC::Function<WebIDL::ExceptionOr<JS::Value>()>::create(realm.heap(), [this, &realm, clone] -> WebIDL::ExceptionOr<JS::Value> {
+    auto operation = GC::Function<WebIDL::ExceptionOr<JS::Value>()>::create(realm.heap(), [this, &realm, clone, serialized_clone = move(serialized_clone)] mutable -> WebIDL::ExceptionOr<JS::Value> {
         HTML::TemporaryExecutionContext context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
-        auto optional_key = TRY(store_a_record_into_an_object_store(realm, *this->effective_object_store(), clone, this->effective_key(), false));
+        auto optional_key = TRY(store_a_record_into_an_object_store(realm, *this->effective_object_store(), clone, this->effective_key(), false, move(serialized_clone)));
 
         if (!optional_key || optional_key->is_invalid())
             return JS::js_undefined();
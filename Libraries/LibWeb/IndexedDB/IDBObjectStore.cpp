@@ -320,7 +320,10 @@ WebIDL::ExceptionOr<GC::Ref<IDBRequest>> IDBObjectStore::add_or_put(GC::Ref<IDBO
     auto& target_realm = realm;
 
     // 10. Let clone be a clone of value in targetRealm during transaction. Rethrow any exceptions.
-    auto clone = TRY(clone_in_realm(target_realm, value, transaction));
+    // OPTIMIZATION: The serialization the clone was made from is stored, rather than serializing the clone again when
+    //               the operation runs.
+    HTML::StorageSerializationRecord serialized_clone;
+    auto clone = TRY(clone_in_realm(target_realm, value, transaction, &serialized_clone));
 
     // 11. If store uses in-line keys, then:
     if (store.uses_inline_keys()) {
@@ -350,9 +353,9 @@ WebIDL::ExceptionOr<GC::Ref<IDBRequest>> IDBObjectStore::add_or_put(GC::Ref<IDBO
     }
 
     // 12. Let operation be an algorithm to run store a record into an object store with store, clone, key, and no-overwrite flag.
-    auto operation = GC::Function<WebIDL::ExceptionOr<JS::Value>()>::create(realm.heap(), [&realm, &store, clone, key_value, no_overwrite] -> WebIDL::ExceptionOr<JS::Value> {
+    auto operation = GC::Function<WebIDL::ExceptionOr<JS::Value>()>::create(realm.heap(), [&realm, &store, clone, serialized_clone = move(serialized_clone), key_value, no_overwrite] mutable -> WebIDL::ExceptionOr<JS::Value> {
         HTML::TemporaryExecutionContext context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
-        auto optional_key = TRY(store_a_record_into_an_object_store(realm, store, clone, key_value, no_overwrite));
+        auto optional_key = TRY(store_a_record_into_an_object_store(realm, store, clone, key_value, no_overwrite, move(serialized_clone)));
 
         if (!optional_key || optional_key->is_invalid())
             return JS::js_undefined();
@@ -36,6 +36,7 @@
 #include <LibWeb/IndexedDB/Internal/Database.h>
 #include <LibWeb/IndexedDB/Internal/Index.h>
 #include <LibWeb/IndexedDB/Internal/Key.h>
+#include <LibWeb/IndexedDB/Internal/RecordRange.h>
 #include <LibWeb/Infra/Strings.h>
 #include <LibWeb/StorageAPI/StorageKey.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
@@ -923,7 +924,9 @@ void commit_a_transaction(JS::Realm& realm, GC::Ref<IDBTransaction> transaction)
 }
 
 // https://w3c.github.io/IndexedDB/#clone
-WebIDL::ExceptionOr<JS::Value> clone_in_realm(JS::Realm& target_realm, JS::Value value, GC::Ref<IDBTransaction> transaction)
+// NB: If serialized is given, it receives the serialization the clone was made from. It can be stored in place of
+//     serializing the clone again, for as long as the clone isn't modified.
+WebIDL::ExceptionOr<JS::Value> clone_in_realm(JS::Realm& target_realm, JS::Value value, GC::Ref<IDBTransaction> transaction, HTML::StorageSerializationRecord* serialized)
 {
     auto& vm = target_realm.vm();
 
@@ -939,10 +942,13 @@ WebIDL::ExceptionOr<JS::Value> clone_in_realm(JS::Realm& target_realm, JS::Value
     ScopeGuard reset_state([&] { transaction->set_state(IDBTransaction::TransactionState::Active); });
 
     // 3. Let serialized be ? StructuredSerializeForStorage(value).
-    auto serialized = TRY(HTML::structured_serialize_for_storage(vm, value));
+    auto serialized_value = TRY(HTML::structured_serialize_for_storage(vm, value));
 
     // 4. Let clone be ? StructuredDeserialize(serialized, targetRealm).
-    auto clone = TRY(HTML::structured_deserialize(vm, serialized, target_realm));
+    auto clone = TRY(HTML::structured_deserialize(vm, serialized_value, target_realm));
+
+    if (serialized)
+        *serialized = move(serialized_value);
 
     // 5. Set transaction’s state to active.
     // NB: This is handled by the scope guard after step 2.
@@ -1461,7 +1467,8 @@ JS::Value delete_records_from_an_object_store(GC::Ref<ObjectStore> store, GC::Re
 }
 
 // https://w3c.github.io/IndexedDB/#store-a-record-into-an-object-store
-WebIDL::ExceptionOr<GC::Ptr<Key>> store_a_record_into_an_object_store(JS::Realm& realm, GC::Ref<ObjectStore> store, JS::Value value, GC::Ptr<Key> key, bool no_overwrite)
+// NB: serialized_value may be given if value is a clone that was made from it, so that it isn't serialized again.
+WebIDL::ExceptionOr<GC::Ptr<Key>> store_a_record_into_an_object_store(JS::Realm& realm, GC::Ref<ObjectStore> store, JS::Value value, GC::Ptr<Key> key, bool no_overwrite, Optional<HTML::StorageSerializationRecord> serialized_value)
 {
     // 1. If store uses a key generator, then:
     if (store->uses_a_key_generator()) {
@@ -1477,8 +1484,12 @@ WebIDL::ExceptionOr<GC::Ptr<Key>> store_a_record_into_an_object_store(JS::Realm&
             key = Key::create_number(realm, static_cast<double>(maybe_key.value()));
 
             // 3. If store also uses in-line keys, then run inject a key into a value using a key path with value, key and store’s key path.
-            if (store->uses_inline_keys())
+            if (store->uses_inline_keys()) {
                 inject_a_key_into_a_value_using_a_key_path(realm, value, GC::Ref(*key), store->key_path().value());
+
+                // NB: The value doesn't match its serialization anymore.
+                serialized_value.clear();
+            }
         }
 
         // 2. Otherwise, run possibly update the key generator for store with key.
@@ -1501,7 +1512,9 @@ WebIDL::ExceptionOr<GC::Ptr<Key>> store_a_record_into_an_object_store(JS::Realm&
 
     // 4. Store a record in store containing key as its key and ! StructuredSerializeForStorage(value) as its value.
     //    The record is stored in the object store’s list of records such that the list is sorted according to the key of the records in ascending order.
-    ObjectStoreRecord record { *key, make<HTML::StorageSerializationRecord>(MUST(HTML::structured_serialize_for_storage(realm.vm(), value))) };
+    if (!serialized_value.has_value())
+        serialized_value = MUST(HTML::structured_serialize_for_storage(realm.vm(), value));
+    ObjectStoreRecord record { *key, make<HTML::StorageSerializationRecord>(serialized_value.release_value()) };
     store->store_a_record(move(record));
 
     // 5. For each index which references store:
@@ -1660,12 +1673,13 @@ WebIDL::ExceptionOr<GC::Ptr<IDBCursor>> iterate_a_cursor(JS::Realm& realm, GC::R
         VERIFY(source.has<GC::Ref<Index>>() && direction_is_next_or_prev);
 
     // 4. Let records be the list of records in source.
-    Variant<ReadonlySpan<ObjectStoreRecord>, ReadonlySpan<IndexRecord>> records = source.visit(
-        [](GC::Ref<ObjectStore> object_store) -> Variant<ReadonlySpan<ObjectStoreRecord>, ReadonlySpan<IndexRecord>> {
-            return object_store->records();
+    using Records = Variant<RecordList<ObjectStoreRecord> const*, RecordList<IndexRecord> const*>;
+    Records records = source.visit(
+        [](GC::Ref<ObjectStore> object_store) -> Records {
+            return &object_store->records();
         },
-        [](GC::Ref<Index> index) -> Variant<ReadonlySpan<ObjectStoreRecord>, ReadonlySpan<IndexRecord>> {
-            return index->records();
+        [](GC::Ref<Index> index) -> Records {
+            return &index->records();
         });
 
     // 5. Let range be cursor’s range.
@@ -1680,193 +1694,192 @@ WebIDL::ExceptionOr<GC::Ptr<IDBCursor>> iterate_a_cursor(JS::Realm& realm, GC::R
     // 8. If count is not given, let count be 1.
     // NOTE: This is handled by the default parameter
 
-    auto next_requirements = [&](Variant<ObjectStoreRecord, IndexRecord> const& record) -> bool {
+    auto next_requirements = [&]<typename Record>(Record const& record) -> bool {
         // * If key is defined:
         if (key) {
             // * The record’s key is greater than or equal to key.
-            if (!record.visit([&](auto const& inner_record) {
-                    return Key::greater_than_or_equal(inner_record.key, *key);
-                }))
+            if (!Key::greater_than_or_equal(record.key, *key))
                 return false;
         }
 
         // * If primaryKey is defined:
-        if (primary_key) {
-            auto const& inner_record = record.get<IndexRecord>();
-
-            // * If the record’s key is equal to key:
-            if (Key::equals(inner_record.key, *key)) {
-                // * The record’s value is greater than or equal to primaryKey
-                if (!Key::greater_than_or_equal(inner_record.value, *primary_key))
-                    return false;
-            }
-            // * Else:
-            else {
-                // * The record’s key is greater than key.
-                if (!Key::greater_than(inner_record.key, *key))
-                    return false;
+        // NB: primaryKey is only given for indexes.
+        if constexpr (IsSame<Record, IndexRecord>) {
+            if (primary_key) {
+                // * If the record’s key is equal to key:
+                if (Key::equals(record.key, *key)) {
+                    // * The record’s value is greater than or equal to primaryKey
+                    if (!Key::greater_than_or_equal(record.value, *primary_key))
+                        return false;
+                }
+                // * Else:
+                else {
+                    // * The record’s key is greater than key.
+                    if (!Key::greater_than(record.key, *key))
+                        return false;
+                }
             }
         }
 
         // * If position is defined and source is an object store:
-        if (position && source.has<GC::Ref<ObjectStore>>()) {
-            auto const& inner_record = record.get<ObjectStoreRecord>();
-
-            // * The record’s key is greater than position.
-            if (!Key::greater_than(inner_record.key, *position))
-                return false;
+        if constexpr (IsSame<Record, ObjectStoreRecord>) {
+            if (position) {
+                // * The record’s key is greater than position.
+                if (!Key::greater_than(record.key, *position))
+                    return false;
+            }
         }
 
         // * If position is defined and source is an index:
-        if (position && source.has<GC::Ref<Index>>()) {
-            auto const& inner_record = record.get<IndexRecord>();
-
-            // * If the record’s key is equal to position:
-            if (Key::equals(inner_record.key, *position)) {
-                // * The record’s value is greater than object store position
-                if (!Key::greater_than(inner_record.value, *object_store_position))
-                    return false;
-            }
-            // * Else:
-            else {
-                // * The record’s key is greater than position.
-                if (!Key::greater_than(inner_record.key, *position))
-                    return false;
+        if constexpr (IsSame<Record, IndexRecord>) {
+            if (position) {
+                // * If the record’s key is equal to position:
+                if (Key::equals(record.key, *position)) {
+                    // * The record’s value is greater than object store position
+                    if (!Key::greater_than(record.value, *object_store_position))
+                        return false;
+                }
+                // * Else:
+                else {
+                    // * The record’s key is greater than position.
+                    if (!Key::greater_than(record.key, *position))
+                        return false;
+                }
             }
         }
 
         // * The record’s key is in range.
-        return record.visit(
-            [&](auto const& inner_record) {
-                return range->is_in_range(inner_record.key);
-            });
+        return range->is_in_range(record.key);
     };
 
-    auto next_unique_requirements = [&](Variant<ObjectStoreRecord, IndexRecord> const& record) -> bool {
+    auto next_unique_requirements = [&]<typename Record>(Record const& record) -> bool {
         // * If key is defined:
         if (key) {
             // * The record’s key is greater than or equal to key.
-            if (!record.visit([&](auto const& inner_record) {
-                    return Key::greater_than_or_equal(inner_record.key, *key);
-                }))
+            if (!Key::greater_than_or_equal(record.key, *key))
                 return false;
         }
 
         // * If position is defined:
         if (position) {
             // * The record’s key is greater than position.
-            if (!record.visit([&](auto const& inner_record) {
-                    return Key::greater_than(inner_record.key, *position);
-                }))
+            if (!Key::greater_than(record.key, *position))
                 return false;
         }
 
         // * The record’s key is in range.
-        return record.visit(
-            [&](auto const& inner_record) {
-                return range->is_in_range(inner_record.key);
-            });
+        return range->is_in_range(record.key);
     };
 
-    auto prev_requirements = [&](Variant<ObjectStoreRecord, IndexRecord> const& record) -> bool {
+    auto prev_requirements = [&]<typename Record>(Record const& record) -> bool {
         // * If key is defined:
         if (key) {
             // * The record’s key is less than or equal to key.
-            if (!record.visit([&](auto const& inner_record) {
-                    return Key::less_than_or_equal(inner_record.key, *key);
-                }))
+            if (!Key::less_than_or_equal(record.key, *key))
                 return false;
         }
 
         // * If primaryKey is defined:
-        if (primary_key) {
-            auto const& inner_record = record.get<IndexRecord>();
-
-            // * If the record’s key is equal to key:
-            if (Key::equals(inner_record.key, *key)) {
-                // * The record’s value is less than or equal to primaryKey
-                if (!Key::less_than_or_equal(inner_record.value, *primary_key))
-                    return false;
-            }
-            // * Else:
-            else {
-                // * The record’s key is less than key.
-                if (!Key::less_than(inner_record.key, *key))
-                    return false;
+        // NB: primaryKey is only given for indexes.
+        if constexpr (IsSame<Record, IndexRecord>) {
+            if (primary_key) {
+                // * If the record’s key is equal to key:
+                if (Key::equals(record.key, *key)) {
+                    // * The record’s value is less than or equal to primaryKey
+                    if (!Key::less_than_or_equal(record.value, *primary_key))
+                        return false;
+                }
+                // * Else:
+                else {
+                    // * The record’s key is less than key.
+                    if (!Key::less_than(record.key, *key))
+                        return false;
+                }
             }
         }
 
         // * If position is defined and source is an object store:
-        if (position && source.has<GC::Ref<ObjectStore>>()) {
-            auto const& inner_record = record.get<ObjectStoreRecord>();
-
-            // * The record’s key is less than position.
-            if (!Key::less_than(inner_record.key, *position))
-                return false;
+        if constexpr (IsSame<Record, ObjectStoreRecord>) {
+            if (position) {
+                // * The record’s key is less than position.
+                if (!Key::less_than(record.key, *position))
+                    return false;
+            }
         }
 
         // * If position is defined and source is an index:
-        if (position && source.has<GC::Ref<Index>>()) {
-            auto const& inner_record = record.get<IndexRecord>();
-
-            // * If the record’s key is equal to position:
-            if (Key::equals(inner_record.key, *position)) {
-                // * The record’s value is less than object store position
-                if (!Key::less_than(inner_record.value, *object_store_position))
-                    return false;
-            }
-            // Else:
-            else {
-                // * The record’s key is less than position.
-                if (!Key::less_than(inner_record.key, *position))
-                    return false;
+        if constexpr (IsSame<Record, IndexRecord>) {
+            if (position) {
+                // * If the record’s key is equal to position:
+                if (Key::equals(record.key, *position)) {
+                    // * The record’s value is less than object store position
+                    if (!Key::less_than(record.value, *object_store_position))
+                        return false;
+                }
+                // Else:
+                else {
+                    // * The record’s key is less than position.
+                    if (!Key::less_than(record.key, *position))
+                        return false;
+                }
             }
         }
 
         // * The record’s key is in range.
-        return record.visit(
-            [&](auto const& inner_record) {
-                return range->is_in_range(inner_record.key);
-            });
+        return range->is_in_range(record.key);
     };
 
-    auto prev_unique_requirements = [&](Variant<ObjectStoreRecord, IndexRecord> const& record) -> bool {
+    auto prev_unique_requirements = [&]<typename Record>(Record const& record) -> bool {
         // * If key is defined:
         if (key) {
             // * The record’s key is less than or equal to key.
-            if (!record.visit([&](auto const& inner_record) {
-                    return Key::less_than_or_equal(inner_record.key, *key);
-                }))
+            if (!Key::less_than_or_equal(record.key, *key))
                 return false;
         }
 
         //* If position is defined:
         if (position) {
             // * The record’s key is less than position.
-            if (!record.visit([&](auto const& inner_record) {
-                    return Key::less_than(inner_record.key, *position);
-                }))
+            if (!Key::less_than(record.key, *position))
                 return false;
         }
 
         // * The record’s key is in range.
-        return record.visit(
-            [&](auto const& inner_record) {
-                return range->is_in_range(inner_record.key);
-            });
+        return range->is_in_range(record.key);
+    };
+
+    // OPTIMIZATION: The records are sorted by key, so a record with a key below key, position or the lower bound of
+    //               range can't be found going forward, and one with a key above them can't be found going backward.
+    //               Binary searches find where to start, instead of checking every record from the other end.
+    auto first_index_not_below_bounds = [&](auto const& content) {
+        size_t start = 0;
+        for (auto bound : { key, position, range->lower_key() }) {
+            if (bound)
+                start = max(start, first_record_index_with_key_at_or_after(content, *bound, false));
+        }
+        return start;
+    };
+    auto first_index_above_bounds = [&](auto const& content) {
+        size_t end = content.size();
+        for (auto bound : { key, position, range->upper_key() }) {
+            if (bound)
+                end = min(end, first_record_index_with_key_after(content, *bound, false));
+        }
+        return end;
     };
 
     // 9. While count is greater than 0:
-    Variant<Empty, ObjectStoreRecord, IndexRecord> found_record;
+    using FoundRecord = Variant<Empty, ObjectStoreRecord const*, IndexRecord const*>;
+    FoundRecord found_record;
     while (count > 0) {
         // 1. Switch on direction:
         switch (direction) {
         case Bindings::IDBCursorDirection::Next: {
             // Let found record be the first record in records which satisfy all of the following requirements:
-            found_record = records.visit([&](auto content) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
-                auto value = content.first_matching(next_requirements);
+            found_record = records.visit([&](auto const* content) -> FoundRecord {
+                auto value = content->first_matching(first_index_not_below_bounds(*content), next_requirements);
                 if (value.has_value())
-                    return *value;
+                    return &*value;
 
                 return Empty {};
             });
@@ -1874,10 +1887,10 @@ WebIDL::ExceptionOr<GC::Ptr<IDBCursor>> iterate_a_cursor(JS::Realm& realm, GC::R
         }
         case Bindings::IDBCursorDirection::Nextunique: {
             // Let found record be the first record in records which satisfy all of the following requirements:
-            found_record = records.visit([&](auto content) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
-                auto value = content.first_matching(next_unique_requirements);
+            found_record = records.visit([&](auto const* content) -> FoundRecord {
+                auto value = content->first_matching(first_index_not_below_bounds(*content), next_unique_requirements);
                 if (value.has_value())
-                    return *value;
+                    return &*value;
 
                 return Empty {};
             });
@@ -1885,10 +1898,10 @@ WebIDL::ExceptionOr<GC::Ptr<IDBCursor>> iterate_a_cursor(JS::Realm& realm, GC::R
         }
         case Bindings::IDBCursorDirection::Prev: {
             // Let found record be the last record in records which satisfy all of the following requirements:
-            found_record = records.visit([&](auto content) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
-                auto value = content.last_matching(prev_requirements);
+            found_record = records.visit([&](auto const* content) -> FoundRecord {
+                auto value = content->last_matching(first_index_above_bounds(*content), prev_requirements);
                 if (value.has_value())
-                    return *value;
+                    return &*value;
 
                 return Empty {};
             });
@@ -1897,10 +1910,10 @@ WebIDL::ExceptionOr<GC::Ptr<IDBCursor>> iterate_a_cursor(JS::Realm& realm, GC::R
 
         case Bindings::IDBCursorDirection::Prevunique: {
             // Let temp record be the last record in records which satisfy all of the following requirements:
-            auto temp_record = records.visit([&](auto content) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
-                auto value = content.last_matching(prev_unique_requirements);
+            auto temp_record = records.visit([&](auto const* content) -> FoundRecord {
+                auto value = content->last_matching(first_index_above_bounds(*content), prev_unique_requirements);
                 if (value.has_value())
-                    return *value;
+                    return &*value;
 
                 return Empty {};
             });
@@ -1909,14 +1922,15 @@ WebIDL::ExceptionOr<GC::Ptr<IDBCursor>> iterate_a_cursor(JS::Realm& realm, GC::R
             if (!temp_record.has<Empty>()) {
                 auto temp_record_key = temp_record.visit(
                     [](Empty) -> GC::Ref<Key> { VERIFY_NOT_REACHED(); },
-                    [](auto const& record) { return record.key; });
+                    [](auto const* record) { return record->key; });
 
-                found_record = records.visit([&](auto content) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
-                    auto value = content.first_matching([&](auto const& content_record) {
+                found_record = records.visit([&](auto const* content) -> FoundRecord {
+                    auto start = first_record_index_with_key_at_or_after(*content, temp_record_key, false);
+                    auto value = content->first_matching(start, [&](auto const& content_record) {
                         return Key::equals(content_record.key, temp_record_key);
                     });
                     if (value.has_value())
-                        return *value;
+                        return &*value;
 
                     return Empty {};
                 });
@@ -1946,11 +1960,11 @@ WebIDL::ExceptionOr<GC::Ptr<IDBCursor>> iterate_a_cursor(JS::Realm& realm, GC::R
         // 3. Let position be found record’s key.
         position = found_record.visit(
             [](Empty) -> GC::Ref<Key> { VERIFY_NOT_REACHED(); },
-            [](auto val) { return val.key; });
+            [](auto const* record) { return record->key; });
 
         // 4. If source is an index, let object store position be found record’s value.
         if (source.has<GC::Ref<Index>>())
-            object_store_position = found_record.get<IndexRecord>().value;
+            object_store_position = found_record.get<IndexRecord const*>()->value;
 
         // 5. Decrease count by 1.
         count--;
@@ -1966,7 +1980,7 @@ WebIDL::ExceptionOr<GC::Ptr<IDBCursor>> iterate_a_cursor(JS::Realm& realm, GC::R
     // 12. Set cursor’s key to found record’s key.
     cursor->set_key(found_record.visit(
         [](Empty) -> GC::Ref<Key> { VERIFY_NOT_REACHED(); },
-        [](auto val) { return val.key; }));
+        [](auto const* record) { return record->key; }));
 
     // 13. If cursor’s key only flag is false, then:
     if (!cursor->key_only()) {
@@ -1974,10 +1988,10 @@ WebIDL::ExceptionOr<GC::Ptr<IDBCursor>> iterate_a_cursor(JS::Realm& realm, GC::R
         // 1. Let serialized be found record’s value if source is an object store, or found record’s referenced value otherwise.
         auto const& serialized = source.visit(
             [&](GC::Ref<ObjectStore>) -> HTML::StorageSerializationRecord const& {
-                return *found_record.get<ObjectStoreRecord>().value;
+                return *found_record.get<ObjectStoreRecord const*>()->value;
             },
             [&](GC::Ref<Index> index) -> HTML::StorageSerializationRecord const& {
-                return index->referenced_value(found_record.get<IndexRecord>());
+                return index->referenced_value(*found_record.get<IndexRecord const*>());
             });
 
         // 2. Set cursor’s value to ! StructuredDeserialize(serialized, targetRealm)
@@ -2059,7 +2073,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::Array>> retrieve_multiple_items_from_an_object_s
         count = OptionalNone();
 
     // 2. Let records an empty list.
-    GC::ConservativeVector<ObjectStoreRecord> records;
+    Vector<ObjectStoreRecord const&> records;
 
     // 3. If direction is "next" or "nextunique", set records to the first count of store’s list of records whose key is in range.
     if (direction == Bindings::IDBCursorDirection::Next || direction == Bindings::IDBCursorDirection::Nextunique) {
@@ -2199,7 +2213,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::Array>> retrieve_multiple_referenced_values_from
         auto& record = records[i];
 
         // 1. Let serialized be record’s referenced value.
-        auto serialized = index->referenced_value(record);
+        auto const& serialized = index->referenced_value(record);
 
         // 2. Let entry be ! StructuredDeserialize(serialized, targetRealm).
         auto entry = TRY(deserialize_a_stored_record(realm, serialized));
@@ -2325,7 +2339,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::Array>> retrieve_multiple_items_from_an_index(JS
         count = OptionalNone();
 
     // 2. Let records be a an empty list.
-    GC::ConservativeVector<IndexRecord> records;
+    Vector<IndexRecord const&> records;
 
     // 3. Switching on direction:
     switch (direction) {
@@ -2406,9 +2420,16 @@ WebIDL::ExceptionOr<GC::Ref<JS::Array>> retrieve_multiple_items_from_an_index(JS
                 continue;
 
             // 4. Else prepend |range records[i]| to records.
-            records.prepend(range_records[i]);
+            // NB: The records are appended and put in reverse order afterwards, since prepending each of them would
+            //     move all of the others every time.
+            records.append(range_records[i]);
         }
 
+        Vector<IndexRecord const&> reversed_records;
+        reversed_records.ensure_capacity(records.size());
+        for (size_t j = records.size(); j > 0; --j)
+            reversed_records.append(records[j - 1]);
+        records = move(reversed_records);
         break;
     }
     }
@@ -2433,7 +2454,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::Array>> retrieve_multiple_items_from_an_index(JS
         // "value"
         case RecordKind::Value: {
             // 1. Let serialized be record’s referenced value.
-            auto serialized = index->referenced_value(record);
+            auto const& serialized = index->referenced_value(record);
 
             // 2. Let value be ! StructuredDeserialize(serialized, targetRealm).
             auto value = TRY(deserialize_a_stored_record(target_realm, serialized));
@@ -2452,7 +2473,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::Array>> retrieve_multiple_items_from_an_index(JS
             auto key = record.value;
 
             // 3. Let serialized be record’s referenced value.
-            auto serialized = index->referenced_value(record);
+            auto const& serialized = index->referenced_value(record);
 
             // 4. Let value be ! StructuredDeserialize(serialized, targetRealm).
             auto value = TRY(deserialize_a_stored_record(target_realm, serialized));
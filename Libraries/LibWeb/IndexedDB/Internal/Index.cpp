@@ -81,7 +81,7 @@ HTML::StorageSerializationRecord const& Index::referenced_value(IndexRecord cons
 
 void Index::clear_records()
 {
-    auto deleted = move(m_records);
+    auto deleted = m_records.take_all();
     if (auto log = m_object_store->mutation_log(); log && !deleted.is_empty())
         log->note_index_records_deleted(*this, move(deleted));
 }
@@ -94,10 +94,11 @@ Optional<IndexRecord&> Index::first_in_range(GC::Ref<IDBKeyRange> range)
     return m_records[record_range.start];
 }
 
-GC::ConservativeVector<IndexRecord> Index::first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
+Vector<IndexRecord const&> Index::first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
 {
-    GC::ConservativeVector<IndexRecord> records;
     auto record_range = record_range_for_key_range(m_records, range);
+    Vector<IndexRecord const&> records;
+    records.ensure_capacity(min<size_t>(record_range.end - record_range.start, count.value_or(NumericLimits<WebIDL::UnsignedLong>::max())));
     for (size_t i = record_range.start; i < record_range.end; ++i) {
         records.append(m_records[i]);
 
@@ -108,10 +109,11 @@ GC::ConservativeVector<IndexRecord> Index::first_n_in_range(GC::Ref<IDBKeyRange>
     return records;
 }
 
-GC::ConservativeVector<IndexRecord> Index::last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
+Vector<IndexRecord const&> Index::last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
 {
-    GC::ConservativeVector<IndexRecord> records;
     auto record_range = record_range_for_key_range(m_records, range);
+    Vector<IndexRecord const&> records;
+    records.ensure_capacity(min<size_t>(record_range.end - record_range.start, count.value_or(NumericLimits<WebIDL::UnsignedLong>::max())));
     for (size_t i = record_range.end; i > record_range.start;) {
         --i;
         records.append(m_records[i]);
@@ -154,16 +156,12 @@ void Index::remove_records_with_value_in_range(GC::Ref<IDBKeyRange> range)
 {
     auto log = m_object_store->mutation_log();
     Vector<IndexRecord> removed_records;
-    for (size_t i = 0; i < m_records.size();) {
-        auto const& record = m_records[i];
-        if (range->is_in_range(record.value)) {
-            auto removed_record = m_records.take(i);
+    m_records.remove_all_matching(
+        [&](auto const& record) { return range->is_in_range(record.value); },
+        [&](auto removed_record) {
             if (log)
-                removed_records.append(removed_record);
-            continue;
-        }
-        i++;
-    }
+                removed_records.append(move(removed_record));
+        });
     if (!removed_records.is_empty())
         log->note_index_records_deleted(*this, move(removed_records));
 }
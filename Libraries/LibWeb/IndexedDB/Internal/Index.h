@@ -12,6 +12,7 @@
 #include <LibJS/Runtime/Realm.h>
 #include <LibWeb/IndexedDB/IDBRecord.h>
 #include <LibWeb/IndexedDB/Internal/ObjectStore.h>
+#include <LibWeb/IndexedDB/Internal/RecordList.h>
 
 namespace Web::IndexedDB {
 
@@ -31,7 +32,7 @@ public:
     [[nodiscard]] bool unique() const { return m_unique; }
     [[nodiscard]] bool multi_entry() const { return m_multi_entry; }
     [[nodiscard]] GC::Ref<ObjectStore> object_store() const { return m_object_store; }
-    [[nodiscard]] AK::ReadonlySpan<IndexRecord> records() const { return m_records; }
+    [[nodiscard]] RecordList<IndexRecord> const& records() const { return m_records; }
     [[nodiscard]] KeyPath const& key_path() const { return m_key_path; }
 
     [[nodiscard]] bool is_deleted() const { return m_deleted; }
@@ -40,8 +41,9 @@ public:
     [[nodiscard]] bool has_record_with_key(GC::Ref<Key> key);
     void clear_records();
     Optional<IndexRecord&> first_in_range(GC::Ref<IDBKeyRange> range);
-    GC::ConservativeVector<IndexRecord> first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
-    GC::ConservativeVector<IndexRecord> last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
+    // NB: The records are returned by reference, and are only valid until the list of records is changed.
+    Vector<IndexRecord const&> first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
+    Vector<IndexRecord const&> last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
     u64 count_records_in_range(GC::Ref<IDBKeyRange> range);
     void store_a_record(IndexRecord const& record);
     void remove_record(IndexRecord const& record);
@@ -59,7 +61,7 @@ private:
     GC::Ref<ObjectStore> m_object_store;
 
     // The index has a list of records which hold the data stored in the index.
-    Vector<IndexRecord> m_records;
+    RecordList<IndexRecord> m_records;
 
     // An index has a name, which is a name. At any one time, the name is unique within index’s referenced object store.
     Utf16String m_name;
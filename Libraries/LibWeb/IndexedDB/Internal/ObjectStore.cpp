@@ -125,9 +125,9 @@ Optional<ObjectStoreRecord&> ObjectStore::first_in_range(GC::Ref<IDBKeyRange> ra
 
 void ObjectStore::clear_records()
 {
-    auto deleted_records = move(m_records);
+    auto deleted_records = m_records.take_all();
     if (m_mutation_log && !deleted_records.is_empty())
-        m_mutation_log->note_records_deleted(deleted_records);
+        m_mutation_log->note_records_deleted(move(deleted_records));
 }
 
 // https://w3c.github.io/IndexedDB/#generate-a-key
@@ -179,10 +179,11 @@ void ObjectStore::possibly_update_the_key_generator(GC::Ref<Key> key)
     }
 }
 
-GC::ConservativeVector<ObjectStoreRecord> ObjectStore::first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
+Vector<ObjectStoreRecord const&> ObjectStore::first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
 {
-    GC::ConservativeVector<ObjectStoreRecord> records;
     auto record_range = record_range_for_key_range(m_records, range);
+    Vector<ObjectStoreRecord const&> records;
+    records.ensure_capacity(min<size_t>(record_range.end - record_range.start, count.value_or(NumericLimits<WebIDL::UnsignedLong>::max())));
     for (size_t i = record_range.start; i < record_range.end; ++i) {
         records.append(m_records[i]);
 
@@ -193,10 +194,11 @@ GC::ConservativeVector<ObjectStoreRecord> ObjectStore::first_n_in_range(GC::Ref<
     return records;
 }
 
-GC::ConservativeVector<ObjectStoreRecord> ObjectStore::last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
+Vector<ObjectStoreRecord const&> ObjectStore::last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
 {
-    GC::ConservativeVector<ObjectStoreRecord> records;
     auto record_range = record_range_for_key_range(m_records, range);
+    Vector<ObjectStoreRecord const&> records;
+    records.ensure_capacity(min<size_t>(record_range.end - record_range.start, count.value_or(NumericLimits<WebIDL::UnsignedLong>::max())));
     for (size_t i = record_range.end; i > record_range.start;) {
         --i;
         records.append(m_records[i]);
@@ -20,6 +20,7 @@
 #include <LibWeb/IndexedDB/Internal/Index.h>
 #include <LibWeb/IndexedDB/Internal/KeyGenerator.h>
 #include <LibWeb/IndexedDB/Internal/MutationLog.h>
+#include <LibWeb/IndexedDB/Internal/RecordList.h>
 
 namespace Web::IndexedDB {
 
@@ -47,7 +48,7 @@ public:
     void set_deleted(bool deleted) { m_deleted = deleted; }
 
     GC::Ref<Database> database() const { return m_database; }
-    ReadonlySpan<ObjectStoreRecord> records() const { return m_records; }
+    RecordList<ObjectStoreRecord> const& records() const { return m_records; }
 
     void remove_records_in_range(GC::Ref<IDBKeyRange> range);
     bool has_record_with_key(GC::Ref<Key> key);
@@ -56,8 +57,9 @@ public:
     u64 count_records_in_range(GC::Ref<IDBKeyRange> range);
     Optional<ObjectStoreRecord&> first_in_range(GC::Ref<IDBKeyRange> range);
     void clear_records();
-    GC::ConservativeVector<ObjectStoreRecord> first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
-    GC::ConservativeVector<ObjectStoreRecord> last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
+    // NB: The records are returned by reference, and are only valid until the list of records is changed.
+    Vector<ObjectStoreRecord const&> first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
+    Vector<ObjectStoreRecord const&> last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
 
     // https://w3c.github.io/IndexedDB/#generate-a-key
     ErrorOr<u64> generate_a_key();
@@ -92,7 +94,7 @@ private:
     Optional<KeyGenerator> m_key_generator;
 
     // An object store has a list of records
-    Vector<ObjectStoreRecord> m_records;
+    RecordList<ObjectStoreRecord> m_records;
 
     bool m_deleted { false };
 
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+
+namespace Web::IndexedDB {
+
+// A list of records that is split into pages of bounded size, like the leaves of a B+ tree. Inserting or removing a
+// record in the middle of the list only moves the records of one page, rather than every record that follows. A record
+// is found by its position in the list with a binary search over the positions at which the pages start.
+template<typename Record>
+class RecordList {
+public:
+    static constexpr size_t MAXIMUM_PAGE_SIZE = 512;
+
+    template<typename ListType, typename ValueType>
+    class IteratorBase {
+    public:
+        ValueType& operator*() const { return m_list->m_pages[m_page_index][m_offset]; }
+        ValueType* operator->() const { return &**this; }
+
+        IteratorBase& operator++()
+        {
+            if (++m_offset == m_list->m_pages[m_page_index].size()) {
+                ++m_page_index;
+                m_offset = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(IteratorBase const&) const = default;
+
+    private:
+        friend class RecordList;
+
+        IteratorBase(ListType& list, size_t page_index)
+            : m_list(&list)
+            , m_page_index(page_index)
+        {
+        }
+
+        ListType* m_list { nullptr };
+        size_t m_page_index { 0 };
+        size_t m_offset { 0 };
+    };
+
+    using Iterator = IteratorBase<RecordList, Record>;
+    using ConstIterator = IteratorBase<RecordList const, Record const>;
+
+    RecordList() = default;
+    RecordList(RecordList&&) = default;
+    RecordList& operator=(RecordList&&) = default;
+
+    size_t size() const { return m_size; }
+    bool is_empty() const { return m_size == 0; }
+
+    Record& operator[](size_t index)
+    {
+        auto [page_index, offset] = locate(index);
+        return m_pages[page_index][offset];
+    }
+
+    Record const& operator[](size_t index) const
+    {
+        auto [page_index, offset] = locate(index);
+        return m_pages[page_index][offset];
+    }
+
+    Record const& last() const { return m_pages.last().last(); }
+
+    Iterator begin() { return { *this, 0 }; }
+    Iterator end() { return { *this, m_pages.size() }; }
+    ConstIterator begin() const { return { *this, 0 }; }
+    ConstIterator end() const { return { *this, m_pages.size() }; }
+
+    void append(Record record)
+    {
+        if (m_pages.is_empty() || m_pages.last().size() >= MAXIMUM_PAGE_SIZE) {
+            m_page_starts.append(m_size);
+            m_pages.append({});
+        }
+        m_pages.last().append(move(record));
+        ++m_size;
+    }
+
+    void insert(size_t index, Record record)
+    {
+        VERIFY(index <= m_size);
+        if (index == m_size) {
+            append(move(record));
+            return;
+        }
+
+        auto [page_index, offset] = locate(index);
+        auto& page = m_pages[page_index];
+        page.insert(offset, move(record));
+        ++m_size;
+
+        for (size_t i = page_index + 1; i < m_page_starts.size(); ++i)
+            ++m_page_starts[i];
+
+        if (page.size() > MAXIMUM_PAGE_SIZE)
+            split_page(page_index);
+    }
+
+    Record take(size_t index)
+    {
+        auto [page_index, offset] = locate(index);
+        auto record = m_pages[page_index].take(offset);
+        --m_size;
+        did_remove_records_from(page_index);
+        return record;
+    }
+
+    void remove(size_t index, size_t count = 1)
+    {
+        VERIFY(index + count <= m_size);
+        if (count == 0)
+            return;
+
+        auto [page_index, offset] = locate(index);
+        m_size -= count;
+
+        for (size_t i = page_index; count > 0; ++i) {
+            auto& page = m_pages[i];
+            auto removed_count = min(count, page.size() - offset);
+            page.remove(offset, removed_count);
+            count -= removed_count;
+            offset = 0;
+        }
+        did_remove_records_from(page_index);
+    }
+
+    // Removes every record that matches the predicate in one pass, handing each of them to the callback in order.
+    template<typename Predicate, typename Callback>
+    void remove_all_matching(Predicate predicate, Callback on_removed)
+    {
+        size_t removed_count = 0;
+        for (auto& page : m_pages) {
+            page.remove_all_matching([&](auto& record) {
+                if (!predicate(record))
+                    return false;
+                on_removed(move(record));
+                ++removed_count;
+                return true;
+            });
+        }
+
+        if (removed_count == 0)
+            return;
+        m_size -= removed_count;
+        did_remove_records_from(0);
+    }
+
+    Vector<Record> take_all()
+    {
+        Vector<Record> records;
+        records.ensure_capacity(m_size);
+        for (auto& page : m_pages) {
+            for (auto& record : page)
+                records.unchecked_append(move(record));
+        }
+        clear();
+        return records;
+    }
+
+    void clear()
+    {
+        m_pages.clear();
+        m_page_starts.clear();
+        m_size = 0;
+    }
+
+    // Returns the first record at or after the given position that matches the predicate.
+    template<typename Predicate>
+    Optional<Record const&> first_matching(size_t start, Predicate predicate) const
+    {
+        if (start >= m_size)
+            return {};
+
+        auto [page_index, offset] = locate(start);
+        for (; page_index < m_pages.size(); ++page_index, offset = 0) {
+            auto const& page = m_pages[page_index];
+            for (; offset < page.size(); ++offset) {
+                if (predicate(page[offset]))
+                    return page[offset];
+            }
+        }
+        return {};
+    }
+
+    // Returns the last record before the given position that matches the predicate.
+    template<typename Predicate>
+    Optional<Record const&> last_matching(size_t end, Predicate predicate) const
+    {
+        for (size_t index = min(end, m_size); index > 0;) {
+            auto [page_index, offset] = locate(index - 1);
+            auto const& page = m_pages[page_index];
+            for (size_t i = offset + 1; i > 0; --i) {
+                if (predicate(page[i - 1]))
+                    return page[i - 1];
+            }
+            index = m_page_starts[page_index];
+        }
+        return {};
+    }
+
+private:
+    struct Location {
+        size_t page_index { 0 };
+        size_t offset { 0 };
+    };
+
+    Location locate(size_t index) const
+    {
+        VERIFY(index < m_size);
+
+        // Find the last page that starts at or before the index.
+        size_t low = 0;
+        size_t high = m_page_starts.size();
+        while (high - low > 1) {
+            size_t middle = low + (high - low) / 2;
+            if (m_page_starts[middle] <= index)
+                low = middle;
+            else
+                high = middle;
+        }
+        return { low, index - m_page_starts[low] };
+    }
+
+    void split_page(size_t page_index)
+    {
+        auto& page = m_pages[page_index];
+        auto split_offset = page.size() / 2;
+
+        Vector<Record> new_page;
+        new_page.ensure_capacity(page.size() - split_offset);
+        for (size_t i = split_offset; i < page.size(); ++i)
+            new_page.unchecked_append(move(page[i]));
+        page.shrink(split_offset);
+
+        m_pages.insert(page_index + 1, move(new_page));
+        m_page_starts.insert(page_index + 1, m_page_starts[page_index] + split_offset);
+    }
+
+    // NB: Records were only removed from the given page onwards, so the pages before it are still where they were.
+    void did_remove_records_from(size_t page_index)
+    {
+        m_pages.remove_all_matching([](auto const& page) { return page.is_empty(); });
+        m_page_starts.resize(m_pages.size());
+
+        for (size_t i = page_index; i < m_pages.size(); ++i)
+            m_page_starts[i] = i == 0 ? 0 : m_page_starts[i - 1] + m_pages[i - 1].size();
+    }
+
+    Vector<Vector<Record>> m_pages;
+    Vector<size_t> m_page_starts;
+    size_t m_size { 0 };
+};
+
+}
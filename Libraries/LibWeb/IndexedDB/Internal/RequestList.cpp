@@ -21,10 +21,10 @@ void RequestList::maybe_process_next_request()
     if (m_blocked)
         return;
 
-    while (!m_entries.is_empty() && !m_entries.first().request)
-        m_entries.remove(0);
+    drop_removed_entries_at_front();
 
-    for (auto& [request, steps] : m_entries) {
+    for (size_t i = m_first_entry_index; i < m_entries.size(); ++i) {
+        auto& [request, steps] = m_entries[i];
         if (!request)
             continue;
         if (request->processed())
@@ -49,14 +49,34 @@ void RequestList::on_request_processed()
 
 void RequestList::remove(GC::Ref<IDBRequest> request)
 {
-    m_entries.remove_first_matching([&request](auto const& entry) {
-        return entry.request.ptr() == request.ptr();
-    });
+    for (size_t i = m_first_entry_index; i < m_entries.size(); ++i) {
+        if (m_entries[i].request.ptr() != request.ptr())
+            continue;
+
+        if (i == m_first_entry_index) {
+            m_entries[i] = {};
+            drop_removed_entries_at_front();
+        } else {
+            m_entries.remove(i);
+        }
+        return;
+    }
+}
+
+void RequestList::drop_removed_entries_at_front()
+{
+    while (m_first_entry_index < m_entries.size() && !m_entries[m_first_entry_index].request)
+        ++m_first_entry_index;
+
+    if (m_first_entry_index * 2 >= m_entries.size()) {
+        m_entries.remove(0, m_first_entry_index);
+        m_first_entry_index = 0;
+    }
 }
 
 bool RequestList::is_empty() const
 {
-    return m_entries.is_empty();
+    return m_first_entry_index == m_entries.size();
 }
 
 void RequestList::set_on_all_processed(GC::Ref<GC::Function<void()>> callback)
@@ -75,10 +95,11 @@ void RequestList::check_all_processed()
     if (!m_on_all_processed)
         return;
 
-    m_entries.remove_all_matching([](auto const& entry) { return !entry.request; });
+    drop_removed_entries_at_front();
 
-    for (auto const& entry : m_entries) {
-        if (!entry.request->processed())
+    for (size_t i = m_first_entry_index; i < m_entries.size(); ++i) {
+        auto const& entry = m_entries[i];
+        if (entry.request && !entry.request->processed())
             return;
     }
 
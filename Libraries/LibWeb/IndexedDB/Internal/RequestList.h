@@ -42,6 +42,12 @@ private:
         GC::Root<GC::Function<void()>> steps;
     };
 
+    void drop_removed_entries_at_front();
+
+    // NB: Requests are removed from the front of the list as they finish, which would move every request behind them
+    //     each time. Instead, entries before this index have been removed, and are only dropped from the vector once
+    //     they make up half of it.
+    size_t m_first_entry_index { 0 };
     Vector<Entry> m_entries;
     GC::Root<GC::Function<void()>> m_on_all_processed;
     bool m_blocked { false };
@@ -67,7 +73,7 @@ public:
         size_t m_index;
     };
 
-    RequestIterator begin() const { return { m_entries, 0 }; }
+    RequestIterator begin() const { return { m_entries, m_first_entry_index }; }
     RequestIterator end() const { return { m_entries, m_entries.size() }; }
 };
 
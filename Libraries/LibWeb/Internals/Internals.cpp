@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/NumericLimits.h>
 #include <AK/Utf16String.h>
@@ -12,6 +13,7 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/TimeZone.h>
 #include <LibGfx/Cursor.h>
+#include <LibGfx/Font/Font.h>
 #include <LibHTTP/HSTS/ParsedHSTSPolicy.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Date.h>
@@ -19,6 +21,7 @@
 #include <LibJS/Runtime/Reference.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibURL/Parser.h>
+#include <LibWasm/Types.h>
 #include <LibWeb/ARIA/AriaData.h>
 #include <LibWeb/ARIA/StateAndProperties.h>
 #include <LibWeb/Bindings/Internals.h>
@@ -29,6 +32,7 @@
 #include <LibWeb/CSS/PreferredColorScheme.h>
 #include <LibWeb/Compositor/AsyncScrollTree.h>
 #include <LibWeb/Compositor/AsyncScrollingState.h>
+#include <LibWeb/Compositor/FrameTiming.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/EventTarget.h>
@@ -778,6 +782,23 @@ Utf16String Internals::dump_gc_graph()
     return dump_string_to_utf16(Bindings::main_thread_vm().heap().dump_graph().serialized());
 }
 
+Utf16String Internals::dump_gc_statistics()
+{
+    return dump_string_to_utf16(Bindings::main_thread_vm().heap().dump_collection_statistics().serialized());
+}
+
+bool Internals::set_wasm_function_profiling_enabled(bool enabled)
+{
+    auto was_enabled = Wasm::function_profiling_enabled();
+    Wasm::set_function_profiling_enabled(enabled);
+    return was_enabled;
+}
+
+Utf16String Internals::dump_wasm_function_profile()
+{
+    return dump_string_to_utf16(Wasm::function_profiles_as_json().serialized());
+}
+
 Utf16String Internals::dump_session_history()
 {
     auto& document = window().associated_document();
@@ -947,6 +968,11 @@ JS::Object* Internals::get_style_invalidation_counters()
     object->define_direct_property("elementStyleNoopRecomputations"_utf16_fly_string, JS::Value(counters.element_style_noop_recomputations), JS::default_attributes);
     object->define_direct_property("elementInheritedStyleRecomputations"_utf16_fly_string, JS::Value(counters.element_inherited_style_recomputations), JS::default_attributes);
     object->define_direct_property("elementInheritedStyleNoopRecomputations"_utf16_fly_string, JS::Value(counters.element_inherited_style_noop_recomputations), JS::default_attributes);
+    object->define_direct_property("styleSharingCacheHits"_utf16_fly_string, JS::Value(counters.style_sharing_cache_hits), JS::default_attributes);
+    object->define_direct_property("styleSharingCacheMisses"_utf16_fly_string, JS::Value(counters.style_sharing_cache_misses), JS::default_attributes);
+    object->define_direct_property("cascadeCacheHits"_utf16_fly_string, JS::Value(counters.cascade_cache_hits), JS::default_attributes);
+    object->define_direct_property("cascadeCacheMisses"_utf16_fly_string, JS::Value(counters.cascade_cache_misses), JS::default_attributes);
+    object->define_direct_property("prematchedRuleSetUses"_utf16_fly_string, JS::Value(counters.prematched_rule_set_uses), JS::default_attributes);
     object->define_direct_property("previousSiblingInvalidationWalkVisits"_utf16_fly_string, JS::Value(counters.previous_sibling_invalidation_walk_visits), JS::default_attributes);
     object->define_direct_property("descendantSlotInvalidationSubtreeScans"_utf16_fly_string, JS::Value(counters.descendant_slot_invalidation_subtree_scans), JS::default_attributes);
     object->define_direct_property("mediaRuleEvaluations"_utf16_fly_string, JS::Value(counters.media_rule_evaluations), JS::default_attributes);
@@ -963,6 +989,25 @@ void Internals::reset_style_invalidation_counters()
     window().associated_document().reset_style_invalidation_counters();
 }
 
+JS::Object* Internals::rule_matching_stats()
+{
+    auto const& counters = window().associated_document().style_invalidation_counters();
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("rulesTried"_utf16_fly_string, JS::Value(counters.rules_tried), JS::default_attributes);
+    object->define_direct_property("rulesMatched"_utf16_fly_string, JS::Value(counters.rules_matched), JS::default_attributes);
+    return object;
+}
+
+JS::Object* Internals::shaping_cache_stats()
+{
+    auto statistics = Gfx::Font::shaping_cache_statistics();
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("hits"_utf16_fly_string, JS::Value(static_cast<double>(statistics.hit_count)), JS::default_attributes);
+    object->define_direct_property("misses"_utf16_fly_string, JS::Value(static_cast<double>(statistics.miss_count)), JS::default_attributes);
+    object->define_direct_property("entries"_utf16_fly_string, JS::Value(static_cast<double>(statistics.entry_count)), JS::default_attributes);
+    return object;
+}
+
 JS::Object* Internals::layout_tree_build_stats()
 {
     auto object = JS::Object::create(realm(), nullptr);
@@ -1025,6 +1070,72 @@ void Internals::update_style()
     window().associated_document().update_style();
 }
 
+JS::Object* Internals::measure_rendering_update()
+{
+    auto& document = window().associated_document();
+    auto milliseconds_since = [](MonotonicTime start) {
+        return (MonotonicTime::now() - start).to_nanoseconds() / 1'000'000.0;
+    };
+
+    auto style_start = MonotonicTime::now();
+    document.update_style();
+    auto style_time = milliseconds_since(style_start);
+
+    auto layout_start = MonotonicTime::now();
+    document.update_layout(DOM::UpdateLayoutReason::InternalsMeasureRenderingUpdate);
+    auto layout_time = milliseconds_since(layout_start);
+
+    double paint_time = 0;
+    if (document.paintable()) {
+        auto paint_start = MonotonicTime::now();
+        (void)document.record_display_list(HTML::PaintConfig {}, document.navigable()->display_list_resource_storage(), Painting::PaintCommandCacheMode::ReadOnly);
+        paint_time = milliseconds_since(paint_start);
+    }
+
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("style"_utf16_fly_string, JS::Value(style_time), JS::default_attributes);
+    object->define_direct_property("layout"_utf16_fly_string, JS::Value(layout_time), JS::default_attributes);
+    object->define_direct_property("paint"_utf16_fly_string, JS::Value(paint_time), JS::default_attributes);
+    return object;
+}
+
+JS::Object* Internals::frame_timeline()
+{
+    auto const& timeline = Compositor::FrameTimeline::the();
+    auto to_milliseconds = [](i64 nanoseconds) {
+        return JS::Value(static_cast<double>(nanoseconds) / 1'000'000.0);
+    };
+
+    auto frames = MUST(JS::Array::create(realm(), timeline.recent_frames().size()));
+    size_t frame_index = 0;
+    for (auto const& frame_timing : timeline.recent_frames()) {
+        auto stages = JS::Object::create(realm(), nullptr);
+        for (size_t i = 0; i < Compositor::frame_timing_stage_count; ++i) {
+            auto stage = static_cast<Compositor::FrameTimingStage>(i);
+            auto const& timing = frame_timing.stage(stage);
+            if (!timing.has_value())
+                continue;
+            auto stage_object = JS::Object::create(realm(), nullptr);
+            stage_object->define_direct_property("start"_utf16_fly_string, to_milliseconds(timing.start_ns), JS::default_attributes);
+            stage_object->define_direct_property("duration"_utf16_fly_string, to_milliseconds(timing.duration_ns), JS::default_attributes);
+            stages->define_direct_property(Utf16FlyString::from_utf8(Compositor::frame_timing_stage_name(stage)), stage_object, JS::default_attributes);
+        }
+
+        auto frame = JS::Object::create(realm(), nullptr);
+        frame->define_direct_property("frameId"_utf16_fly_string, JS::Value(static_cast<double>(frame_timing.frame_id)), JS::default_attributes);
+        frame->define_direct_property("contextId"_utf16_fly_string, JS::Value(static_cast<double>(frame_timing.context_id.value())), JS::default_attributes);
+        frame->define_direct_property("wasDropped"_utf16_fly_string, JS::Value(frame_timing.was_dropped), JS::default_attributes);
+        frame->define_direct_property("stages"_utf16_fly_string, stages, JS::default_attributes);
+        MUST(frames->create_data_property_or_throw(frame_index++, frame));
+    }
+
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("presentedFrameCount"_utf16_fly_string, JS::Value(static_cast<double>(timeline.presented_frame_count())), JS::default_attributes);
+    object->define_direct_property("droppedFrameCount"_utf16_fly_string, JS::Value(static_cast<double>(timeline.dropped_frame_count())), JS::default_attributes);
+    object->define_direct_property("frames"_utf16_fly_string, frames, JS::default_attributes);
+    return object;
+}
+
 void Internals::set_preferred_color_scheme(Utf16String const& color_scheme)
 {
     auto preferred_color_scheme = CSS::preferred_color_scheme_from_string(color_scheme.utf16_view());
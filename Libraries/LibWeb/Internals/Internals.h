@@ -125,6 +125,9 @@ public:
     Utf16String dump_paintable_tree(GC::Ref<DOM::Node>);
     Utf16String dump_stacking_context_tree();
     Utf16String dump_gc_graph();
+    Utf16String dump_gc_statistics();
+    bool set_wasm_function_profiling_enabled(bool enabled);
+    Utf16String dump_wasm_function_profile();
     Utf16String dump_session_history();
     Utf16String dump_ui_process_session_history();
     Utf16String dump_site_isolation_process_tree();
@@ -148,12 +151,16 @@ public:
 
     JS::Object* get_style_invalidation_counters();
     void reset_style_invalidation_counters();
+    JS::Object* rule_matching_stats();
+    JS::Object* shaping_cache_stats();
     JS::Object* layout_tree_build_stats();
     JS::Object* computed_values_stats();
     JS::Object* style_ffi_counters();
     void reset_style_ffi_counters();
     JS::Object* style_group_sharing_info(DOM::Element&);
     void update_style();
+    JS::Object* measure_rendering_update();
+    JS::Object* frame_timeline();
     void set_preferred_color_scheme(Utf16String const& color_scheme);
     void set_page_focus(bool has_focus);
     Utf16String canvas_color_scheme();
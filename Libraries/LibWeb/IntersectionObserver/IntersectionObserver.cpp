@@ -157,6 +157,7 @@ void IntersectionObserver::observe(DOM::Element& target)
         .previous_is_intersecting = false,
     });
 
+    m_document->did_add_intersection_observation_target({});
     m_document->page().client().request_frame();
 }
 
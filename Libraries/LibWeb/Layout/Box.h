@@ -11,6 +11,7 @@
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/CSS/Sizing.h>
 #include <LibWeb/Export.h>
+#include <LibWeb/Layout/AvailableSpace.h>
 #include <LibWeb/Layout/Node.h>
 
 namespace Web::Layout {
@@ -36,11 +37,22 @@ struct IntrinsicSizeCacheKey {
     bool operator==(IntrinsicSizeCacheKey const&) const = default;
 };
 
+// Block size measurements that lay out the box in a throwaway state at a given inner available space.
+struct MeasuredBlockSizeCacheKey {
+    AvailableSpace inner_available_space;
+    IntrinsicSizeCacheKey constraints;
+    LayoutMode layout_mode;
+
+    bool operator==(MeasuredBlockSizeCacheKey const&) const = default;
+};
+
 struct IntrinsicSizes {
     HashMap<IntrinsicSizeCacheKey, CSSPixels> min_content_inline_size;
     HashMap<IntrinsicSizeCacheKey, CSSPixels> max_content_inline_size;
     HashMap<IntrinsicSizeCacheKey, CSSPixels> min_content_block_size;
     HashMap<IntrinsicSizeCacheKey, CSSPixels> max_content_block_size;
+    HashMap<MeasuredBlockSizeCacheKey, CSSPixels> automatic_content_block_size;
+    HashMap<MeasuredBlockSizeCacheKey, CSSPixels> table_box_block_size_inside_table_wrapper;
 };
 
 class WEB_API Box : public NodeWithStyleAndBoxModelMetrics {
@@ -148,4 +160,23 @@ struct Traits<Web::Layout::IntrinsicSizeCacheKey> : public DefaultTraits<Web::La
     }
 };
 
+template<>
+struct Traits<Web::Layout::MeasuredBlockSizeCacheKey> : public DefaultTraits<Web::Layout::MeasuredBlockSizeCacheKey> {
+    static unsigned hash(Web::Layout::MeasuredBlockSizeCacheKey const& key)
+    {
+        auto available_size_hash = [](Web::Layout::AvailableSize const& size) -> unsigned {
+            if (size.is_definite())
+                return pair_int_hash(1u, Traits<Web::CSSPixels>::hash(size.to_px_or_zero()));
+            if (size.is_min_content())
+                return 2;
+            if (size.is_max_content())
+                return 3;
+            return 0;
+        };
+        auto hash = pair_int_hash(available_size_hash(key.inner_available_space.inline_size), available_size_hash(key.inner_available_space.block_size));
+        hash = pair_int_hash(hash, Traits<Web::Layout::IntrinsicSizeCacheKey>::hash(key.constraints));
+        return pair_int_hash(hash, to_underlying(key.layout_mode));
+    }
+};
+
 }
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibGfx/TextLayout.h>
+#include <LibUnicode/Bidi.h>
 #include <LibWeb/CSS/ComputedProperties.h>
 #include <LibWeb/CSS/PropertyNameAndID.h>
 #include <LibWeb/CSS/StyleValues/AnchorStyleValue.h>
@@ -37,6 +39,9 @@
 
 namespace Web::Layout {
 
+// NB: Below this many texts, handing the shaping to the thread pool costs more than it saves.
+static constexpr size_t minimum_text_count_for_parallel_shaping = 256;
+
 enum class SizeDimension {
     Inline,
     Block,
@@ -593,6 +598,64 @@ OwnPtr<FormattingContext> FormattingContext::layout_inside(Box const& child_box,
     return independent_formatting_context;
 }
 
+// NB: InlineLevelIterator picks the direction mode for a whole inline formatting context, which isn't known until the
+//     context is laid out. Looking only at the text and its ancestors agrees with it unless some other text in the
+//     same context needs bidi processing, in which case layout chunks the text again and the shapes made ahead of it
+//     go unused. That costs time but never changes layout.
+static TextNode::TextDirectionMode text_direction_mode_ahead_of_layout(TextNode const& text_node)
+{
+    auto const* containing_block = text_node.containing_block();
+    if (!containing_block || containing_block->computed_values().direction() == CSS::Direction::Rtl)
+        return TextNode::TextDirectionMode::PerCodePoint;
+
+    for (auto const* ancestor = text_node.parent(); ancestor && ancestor != containing_block; ancestor = ancestor->parent()) {
+        if (ancestor->computed_values().direction() == CSS::Direction::Rtl || ancestor->computed_values().unicode_bidi() != CSS::UnicodeBidi::Normal)
+            return TextNode::TextDirectionMode::PerCodePoint;
+    }
+
+    if (Unicode::may_require_bidi_processing(text_node.text_for_rendering()))
+        return TextNode::TextDirectionMode::PerCodePoint;
+    return TextNode::TextDirectionMode::UnidirectionalLeftToRight;
+}
+
+static void append_texts_to_shape(TextNode const& text_node, Vector<Gfx::TextToShape>& texts)
+{
+    auto const& computed_values = text_node.parent()->computed_values();
+
+    // NB: This chunks the text the way InlineLevelIterator::enter_text_node() does, so that layout finds the chunks
+    //     cached on the text node.
+    bool do_wrap_lines = computed_values.text_wrap_mode() == CSS::TextWrapMode::Wrap;
+    bool do_respect_linebreaks = first_is_one_of(computed_values.white_space_collapse(), CSS::WhiteSpaceCollapse::Preserve, CSS::WhiteSpaceCollapse::PreserveBreaks, CSS::WhiteSpaceCollapse::BreakSpaces);
+    auto const& chunks = text_node.chunks_for_layout(do_wrap_lines, do_respect_linebreaks, text_direction_mode_ahead_of_layout(text_node));
+
+    auto letter_spacing = computed_values.letter_spacing().to_float();
+    for (auto const& chunk : chunks.chunks) {
+        // NB: Layout cuts leading tabs off before shaping, doesn't shape forced breaks, and takes the direction of
+        //     context-dependent text from the chunks around it, so none of these are shaped as they are here.
+        if (chunk.has_breaking_tab || (do_respect_linebreaks && chunk.has_breaking_newline) || chunk.text_type == Gfx::GlyphRun::TextType::ContextDependent)
+            continue;
+        texts.append({ .text = chunk.view, .font = chunk.font, .letter_spacing = letter_spacing, .text_type = chunk.text_type });
+    }
+}
+
+// OPTIMIZATION: Shaping is most of the work of laying out text-heavy grid items and table cells, and unlike the rest
+//               of layout it doesn't touch the layout state or the layout tree. So the text of all the boxes is shaped
+//               on the thread pool up front, and laying them out one by one then finds every shape in the cache.
+void FormattingContext::shape_text_ahead_of_layout(ReadonlySpan<Box const*> boxes)
+{
+    Vector<Gfx::TextToShape> texts;
+    for (auto const* box : boxes) {
+        box->for_each_in_subtree_of_type<TextNode>([&](TextNode const& text_node) {
+            append_texts_to_shape(text_node, texts);
+            return TraversalDecision::Continue;
+        });
+    }
+
+    if (texts.size() < minimum_text_count_for_parallel_shaping)
+        return;
+    Gfx::prime_shaping_caches(texts);
+}
+
 CSSPixels FormattingContext::greatest_child_inline_size(Box const& box) const
 {
     CSSPixels max_inline_size = 0;
@@ -764,13 +827,38 @@ CSSPixels FormattingContext::compute_automatic_block_size_for_block_formatting_c
     return max(CSSPixels(0.0f), bottom.value_or(0) - top.value_or(0));
 }
 
+static IntrinsicSizeCacheKey intrinsic_size_cache_key(ContainingBlockConstraints const& containing_block_constraints)
+{
+    return {
+        .measured_at_inline_size = {},
+        .percentage_basis_inline_size = containing_block_constraints.percentage_basis_inline_size,
+        .percentage_basis_block_size = containing_block_constraints.percentage_basis_block_size,
+        .quirks_mode_percentage_basis_block_size = containing_block_constraints.quirks_mode_percentage_basis_block_size,
+    };
+}
+
 CSSPixels FormattingContext::measure_automatic_content_block_size(Box const& box, AvailableSpace const& inner_available_space, ContainingBlockConstraints const& containing_block_constraints)
 {
+    // OPTIMIZATION: The measurement lays out the whole subtree, right before the real layout of the same subtree
+    //               does it again. Without the cache, nested boxes that all get measured like this would double
+    //               the work at each level.
+    MeasuredBlockSizeCacheKey cache_key {
+        .inner_available_space = inner_available_space,
+        .constraints = intrinsic_size_cache_key(containing_block_constraints),
+        .layout_mode = m_layout_mode,
+    };
+    auto& cache = box.cached_intrinsic_sizes().automatic_content_block_size;
+    if (auto cached_value = cache.get(cache_key); cached_value.has_value())
+        return cached_value.value();
+
     LayoutState throwaway_state(box, LayoutState::Purpose::Measurement);
     throwaway_state.create(box, containing_block_constraints.percentage_basis_inline_size, containing_block_constraints.percentage_basis_block_size);
     auto measuring_context = create_independent_formatting_context_if_needed(throwaway_state, m_layout_mode, box, this);
     measuring_context->run(LayoutInput { inner_available_space, containing_block_constraints });
-    return measuring_context->automatic_content_block_size();
+
+    auto automatic_content_block_size = measuring_context->automatic_content_block_size();
+    cache.set(cache_key, automatic_content_block_size);
+    return automatic_content_block_size;
 }
 
 void FormattingContext::make_button_content_box_definite(Box const& box, AvailableSpace const& available_space, ContainingBlockConstraints const& containing_block_constraints, Optional<CSSPixels> measured_content_block_size)
@@ -895,24 +983,35 @@ CSSPixels FormattingContext::compute_table_box_block_size_inside_table_wrapper(B
     // table-wrapper can't have borders or paddings but it might have margin taken from table-root.
     auto available_block_size = containing_block_block_size - margin_top - margin_bottom;
 
-    LayoutState throwaway_state(box, LayoutState::Purpose::Measurement);
-    throwaway_state.create(box, table_wrapper_constraints.percentage_basis_inline_size, table_wrapper_constraints.percentage_basis_block_size);
-
-    auto context = create_independent_formatting_context_if_needed(throwaway_state, LayoutMode::IntrinsicSizing, box, this);
-    VERIFY(context);
-    context->run(LayoutInput { m_state.get(box).available_inner_space_or_constraints_from(available_space), table_wrapper_constraints });
+    auto inner_available_space = m_state.get(box).available_inner_space_or_constraints_from(available_space);
+    MeasuredBlockSizeCacheKey cache_key {
+        .inner_available_space = inner_available_space,
+        .constraints = intrinsic_size_cache_key(table_wrapper_constraints),
+        .layout_mode = LayoutMode::IntrinsicSizing,
+    };
+    auto& cache = box.cached_intrinsic_sizes().table_box_block_size_inside_table_wrapper;
+    auto table_used_block_size = cache.get(cache_key).value_or_lazy_evaluated([&] {
+        LayoutState throwaway_state(box, LayoutState::Purpose::Measurement);
+        throwaway_state.create(box, table_wrapper_constraints.percentage_basis_inline_size, table_wrapper_constraints.percentage_basis_block_size);
+
+        auto context = create_independent_formatting_context_if_needed(throwaway_state, LayoutMode::IntrinsicSizing, box, this);
+        VERIFY(context);
+        context->run(LayoutInput { inner_available_space, table_wrapper_constraints });
+
+        Optional<Box const&> table_box;
+        box.for_each_in_subtree_of_type<Box>([&](Box const& child_box) {
+            if (child_box.display().is_table_inside()) {
+                table_box = child_box;
+                return TraversalDecision::Break;
+            }
+            return TraversalDecision::Continue;
+        });
+        VERIFY(table_box.has_value());
 
-    Optional<Box const&> table_box;
-    box.for_each_in_subtree_of_type<Box>([&](Box const& child_box) {
-        if (child_box.display().is_table_inside()) {
-            table_box = child_box;
-            return TraversalDecision::Break;
-        }
-        return TraversalDecision::Continue;
+        auto used_block_size = throwaway_state.get(*table_box).border_box_block_size();
+        cache.set(cache_key, used_block_size);
+        return used_block_size;
     });
-    VERIFY(table_box.has_value());
-
-    auto table_used_block_size = throwaway_state.get(*table_box).border_box_block_size();
     return available_space.block_size.is_definite() ? min(table_used_block_size, available_block_size) : table_used_block_size;
 }
 
@@ -2804,16 +2903,6 @@ CSSPixels FormattingContext::calculate_fit_content_block_size(Layout::Box const&
     return calculate_max_content_block_size(box, available_space.inline_size.to_px_or_zero(), containing_block_constraints);
 }
 
-static IntrinsicSizeCacheKey intrinsic_size_cache_key(ContainingBlockConstraints const& containing_block_constraints)
-{
-    return {
-        .measured_at_inline_size = {},
-        .percentage_basis_inline_size = containing_block_constraints.percentage_basis_inline_size,
-        .percentage_basis_block_size = containing_block_constraints.percentage_basis_block_size,
-        .quirks_mode_percentage_basis_block_size = containing_block_constraints.quirks_mode_percentage_basis_block_size,
-    };
-}
-
 CSSPixels FormattingContext::calculate_min_content_inline_size(Layout::Box const& box, ContainingBlockConstraints const& containing_block_constraints) const
 {
     if (box.is_replaced_box()) {
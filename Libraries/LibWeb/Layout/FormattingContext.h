@@ -205,6 +205,8 @@ protected:
 
     OwnPtr<FormattingContext> layout_inside(Box const&, LayoutMode, LayoutInput const&);
 
+    static void shape_text_ahead_of_layout(ReadonlySpan<Box const*>);
+
     struct SpaceUsedByFloats {
         CSSPixels left { 0 };
         CSSPixels right { 0 };
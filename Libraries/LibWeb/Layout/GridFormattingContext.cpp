@@ -30,6 +30,9 @@ static Utf16FlyString make_implicit_grid_line_name(Utf16View name, StringView su
 // is placed outside this limit, its grid area must be clamped to within this limited grid.
 static constexpr i32 MAX_GRID_LINE_NUMBER = 10000;
 
+// NB: Smaller grids aren't worth walking for text to shape ahead of layout.
+static constexpr size_t minimum_grid_item_count_for_shaping_ahead_of_layout = 64;
+
 static i32 clamp_grid_line(i32 value)
 {
     return clamp(value, -MAX_GRID_LINE_NUMBER, MAX_GRID_LINE_NUMBER);
@@ -2858,6 +2861,14 @@ void GridFormattingContext::run(LayoutInput const& layout_input)
 
     place_grid_items();
 
+    if (m_grid_items.size() >= minimum_grid_item_count_for_shaping_ahead_of_layout) {
+        Vector<Box const*> grid_item_boxes;
+        grid_item_boxes.ensure_capacity(m_grid_items.size());
+        for (auto const& grid_item : m_grid_items)
+            grid_item_boxes.unchecked_append(&grid_item.box);
+        shape_text_ahead_of_layout(grid_item_boxes);
+    }
+
     initialize_grid_tracks_for_columns_and_rows();
 
     collapse_auto_fit_tracks_if_needed(GridDimension::Column);
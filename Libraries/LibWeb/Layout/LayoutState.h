@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include <AK/BumpAllocator.h>
+#include <AK/BumpArena.h>
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <AK/kmalloc.h>
@@ -34,6 +34,8 @@ class AvailableSpace;
 // flat vector pre-allocated for the entire tree wastes memory, while
 // a hash map pays hashing overhead on every access. Page tables give
 // O(1) lookup without hashing, allocating pages only on first write.
+// Pages and entries all come from one arena, whose chunks are recycled
+// from one layout pass to the next instead of going back to malloc.
 template<typename T>
 class PagedStore {
     static constexpr u32 PageBits = 4;
@@ -49,6 +51,11 @@ class PagedStore {
 public:
     PagedStore() = default;
 
+    ~PagedStore()
+    {
+        for_each([](T& entry) { entry.~T(); });
+    }
+
     PagedStore(PagedStore const&) = delete;
     PagedStore& operator=(PagedStore const&) = delete;
     PagedStore(PagedStore&&) = delete;
@@ -77,11 +84,10 @@ public:
             m_pages.resize(page_index + 1);
         auto& page = m_pages[page_index];
         if (!page)
-            page = make<Page>();
+            page = m_arena.make<Page>();
         auto& entry = page->entries[index & PageMask];
         VERIFY(!entry);
-        entry = m_allocator.allocate();
-        VERIFY(entry);
+        entry = m_arena.make<T>();
         return *entry;
     }
 
@@ -99,10 +105,9 @@ public:
     }
 
 private:
-    static constexpr size_t BumpAllocatorChunkSize = 4 * KiB;
-
-    Vector<OwnPtr<Page>> m_pages;
-    UniformBumpAllocator<T, false, BumpAllocatorChunkSize> m_allocator;
+    // Declared first so that it outlives everything pointing into it.
+    BumpArena m_arena;
+    Vector<Page*> m_pages;
 };
 
 struct LayoutState {
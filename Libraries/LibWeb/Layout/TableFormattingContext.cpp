@@ -16,6 +16,9 @@
 
 namespace Web::Layout {
 
+// NB: Smaller tables aren't worth walking for text to shape ahead of layout.
+static constexpr size_t minimum_cell_count_for_shaping_ahead_of_layout = 64;
+
 TableFormattingContext::TableFormattingContext(LayoutState& state, LayoutMode layout_mode, Box const& root, FormattingContext* parent)
     : FormattingContext(Type::Table, layout_mode, state, root, parent)
 {
@@ -126,6 +129,21 @@ void TableFormattingContext::compute_constrainedness()
     }
 }
 
+template<>
+bool TableFormattingContext::cell_contributes_to_measures<TableFormattingContext::Row>(TableFormattingContext::Cell const&) const
+{
+    return true;
+}
+
+template<>
+bool TableFormattingContext::cell_contributes_to_measures<TableFormattingContext::Column>(TableFormattingContext::Cell const& cell) const
+{
+    // https://drafts.csswg.org/css-tables-3/#computing-column-measures
+    // For the purpose of measuring a column when laid out in fixed mode, only cells which originate in the first row of
+    // the table (after reordering the header and footer) will be considered, if any.
+    return cell.row_index == 0 || !use_fixed_mode_layout();
+}
+
 void TableFormattingContext::compute_cell_measures(RowMeasurement row_measurement)
 {
     // Implements https://www.w3.org/TR/css-tables-3/#computing-cell-measures.
@@ -135,6 +153,13 @@ void TableFormattingContext::compute_cell_measures(RowMeasurement row_measuremen
     compute_constrainedness();
 
     for (auto& cell : m_cells) {
+        // OPTIMIZATION: In fixed mode only cells of the first row contribute to the column measures, and row measurement is
+        //               deferred until after the first row layout pass, so the measures of every other cell go unused.
+        if (!cell_contributes_to_measures<Column>(cell)) {
+            VERIFY(row_measurement == RowMeasurement::Skip);
+            continue;
+        }
+
         auto const& computed_values = cell.box.computed_values();
         CSSPixels padding_block_start = computed_values.padding().top().to_px_or_zero(containing_block_block_size);
         CSSPixels padding_block_end = computed_values.padding().bottom().to_px_or_zero(containing_block_block_size);
@@ -290,7 +315,7 @@ void TableFormattingContext::initialize_table_measures<TableFormattingContext::C
     // https://www.w3.org/TR/css-tables-3/#min-content-width-of-a-column-based-on-cells-of-span-up-to-1
     // https://www.w3.org/TR/css-tables-3/#max-content-width-of-a-column-based-on-cells-of-span-up-to-1
     for (auto& cell : m_cells) {
-        if (cell.column_span == 1 && (cell.row_index == 0 || !use_fixed_mode_layout())) {
+        if (cell.column_span == 1 && cell_contributes_to_measures<Column>(cell)) {
             m_columns[cell.column_index].min_size = max(m_columns[cell.column_index].min_size, cell.outer_min_inline_size);
             m_columns[cell.column_index].max_size = max(m_columns[cell.column_index].max_size, cell.outer_max_inline_size);
         }
@@ -317,7 +342,7 @@ void TableFormattingContext::compute_intrinsic_percentage(size_t max_cell_span)
         // https://www.w3.org/TR/css-tables-3/#intrinsic-percentage-width-of-a-column-based-on-cells-of-span-up-to-n-n--1
         for (auto& cell : m_cells) {
             auto cell_span_value = cell_span<RowOrColumn>(cell);
-            if (cell_span_value != current_span) {
+            if (cell_span_value != current_span || !cell_contributes_to_measures<RowOrColumn>(cell)) {
                 continue;
             }
             auto cell_start_rc_index = cell_index<RowOrColumn>(cell);
@@ -402,7 +427,7 @@ void TableFormattingContext::compute_table_measures()
         cell_max_contributions_by_rc_index.resize(rows_or_columns.size());
         for (auto& cell : m_cells) {
             auto cell_span_value = cell_span<RowOrColumn>(cell);
-            if (cell_span_value == current_span) {
+            if (cell_span_value == current_span && cell_contributes_to_measures<RowOrColumn>(cell)) {
                 // Define the baseline max-content size as the sum of the max-content sizes based on cells of span up to N-1 of all columns that the cell spans.
                 auto cell_start_rc_index = cell_index<RowOrColumn>(cell);
                 auto cell_end_rc_index = cell_start_rc_index + cell_span_value;
@@ -617,7 +642,7 @@ void TableFormattingContext::compute_table_inline_size()
         if (!m_available_space->inline_size.is_intrinsic_sizing_constraint()) {
             for (auto& cell : m_cells) {
                 auto const& cell_inline_size = cell.box.computed_values().width();
-                if (cell_inline_size.is_percentage()) {
+                if (cell_inline_size.is_percentage() && cell_contributes_to_measures<Column>(cell)) {
                     CSSPixels adjusted_used_inline_size = undistributable_space;
                     if (cell_inline_size.percentage().value() != 0)
                         adjusted_used_inline_size += CSSPixels::nearest_value_for(ceil(100 / cell_inline_size.percentage().value() * cell.outer_max_inline_size));
@@ -1758,6 +1783,14 @@ void TableFormattingContext::run_until_inline_size_calculation(LayoutInput const
     // Determine the number of rows/columns the table requires.
     finish_grid_initialization(TableGrid::calculate_row_column_grid(context_box(), m_cells, m_rows));
 
+    if (m_cells.size() >= minimum_cell_count_for_shaping_ahead_of_layout) {
+        Vector<Box const*> cell_boxes;
+        cell_boxes.ensure_capacity(m_cells.size());
+        for (auto const& cell : m_cells)
+            cell_boxes.unchecked_append(&cell.box);
+        shape_text_ahead_of_layout(cell_boxes);
+    }
+
     // The containing block of every internal table box and caption is the table wrapper;
     // the table's own input carries the wrapper's constraints, and participant percentages
     // resolve against those. Percentage block sizes of participants only resolve once the table
@@ -2017,6 +2050,8 @@ void TableFormattingContext::initialize_intrinsic_percentages_from_cells()
     auto& rows_or_columns = table_rows_or_columns<RowOrColumn>();
 
     for (auto& cell : m_cells) {
+        if (!cell_contributes_to_measures<RowOrColumn>(cell))
+            continue;
         auto cell_span_value = cell_span<RowOrColumn>(cell);
         auto cell_start_rc_index = cell_index<RowOrColumn>(cell);
         auto cell_end_rc_index = cell_start_rc_index + cell_span_value;
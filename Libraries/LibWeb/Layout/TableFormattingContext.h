@@ -130,6 +130,9 @@ private:
     template<class RowOrColumn>
     static CSSPixels cell_max_size(Cell const& cell);
 
+    template<class RowOrColumn>
+    bool cell_contributes_to_measures(Cell const& cell) const;
+
     template<class RowOrColumn>
     static double cell_percentage_contribution(Cell const& cell);
 
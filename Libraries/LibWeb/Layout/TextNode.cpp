@@ -360,9 +360,20 @@ TextNode::TextForRenderingCacheKey TextNode::create_text_for_rendering_cache_key
 
 void TextNode::invalidate_text_for_rendering()
 {
+    stash_chunk_cache_for_reuse();
     m_text_dependent_cache = {};
 }
 
+void TextNode::stash_chunk_cache_for_reuse() const
+{
+    if (!m_text_dependent_cache.has_value() || !m_text_dependent_cache->chunk_cache.has_value())
+        return;
+    m_stale_chunk_cache = StaleChunkCache {
+        .text_for_rendering = move(m_text_dependent_cache->text_for_rendering),
+        .entry = m_text_dependent_cache->chunk_cache.release_value(),
+    };
+}
+
 Utf16String const& TextNode::text_for_rendering() const
 {
     return ensure_text_dependent_cache().text_for_rendering;
@@ -373,6 +384,7 @@ TextNode::TextDependentCache const& TextNode::ensure_text_dependent_cache() cons
     auto key = create_text_for_rendering_cache_key();
     if (!m_text_dependent_cache.has_value() || m_text_dependent_cache->key != key) {
         auto text_for_rendering = compute_text_for_rendering(key);
+        stash_chunk_cache_for_reuse();
         m_text_dependent_cache = TextDependentCache {
             .key = move(key),
             .text_for_rendering = move(text_for_rendering),
@@ -496,7 +508,9 @@ Unicode::Segmenter& TextNode::line_segmenter() const
         if (auto ascii = Unicode::Segmenter::try_create_for_ascii_line(text.utf16_view())) {
             cache.line_segmenter = ascii.release_nonnull();
         } else {
-            cache.line_segmenter = document().line_segmenter().clone();
+            // OPTIMIZATION: Chunking asks whether every grapheme sits on a line break opportunity, and does so again
+            //               whenever the text is rechunked. Remember ICU's answers as bits instead of asking again.
+            cache.line_segmenter = Unicode::Segmenter::create_with_cached_boundaries(document().line_segmenter().clone());
             cache.line_segmenter->set_segmented_text(text);
         }
     }
@@ -524,6 +538,53 @@ TextNode::ChunkList const& TextNode::chunks_for_layout(bool should_wrap_lines, b
 
     TextNode::ChunkIterator chunk_iterator { *this, text_direction_mode, should_wrap_lines, should_respect_linebreaks };
     Vector<TextNode::Chunk> chunks;
+
+    // OPTIMIZATION: Editing text changes none of the chunks well ahead of the edit, so when the text was chunked the
+    //               same way before it changed, take those chunks over and only resume chunking shortly before the
+    //               edit. Typing into a long text node then no longer re-segments and re-chunks all of it.
+    if (auto stale_chunk_cache = exchange(m_stale_chunk_cache, {}); stale_chunk_cache.has_value() && stale_chunk_cache->entry.key == key) {
+        auto const& text = cache.text_for_rendering;
+        auto const& stale_text = stale_chunk_cache->text_for_rendering;
+        auto const& stale_chunks = stale_chunk_cache->entry.chunk_list.chunks;
+
+        size_t common_prefix_length = 0;
+        auto max_common_prefix_length = min(text.length_in_code_units(), stale_text.length_in_code_units());
+        while (common_prefix_length < max_common_prefix_length && text.code_unit_at(common_prefix_length) == stale_text.code_unit_at(common_prefix_length))
+            ++common_prefix_length;
+
+        // NB: Whitespace only takes over the font of the text before it; otherwise its font depends on the text after
+        //     it, which may be what changed.
+        size_t reusable_chunk_count = 0;
+        RefPtr<Gfx::Font const> last_non_whitespace_font;
+        for (auto const& chunk : stale_chunks) {
+            if (chunk.start + chunk.length >= common_prefix_length)
+                break;
+            if (chunk.is_all_whitespace && chunk.font.ptr() != last_non_whitespace_font.ptr())
+                break;
+            if (!chunk.is_all_whitespace)
+                last_non_whitespace_font = chunk.font;
+            ++reusable_chunk_count;
+        }
+
+        // NB: Line break opportunities and grapheme clusters can depend on the code points that follow, so the last
+        //     chunk ahead of the edit is always chunked again. We resume where the first chunk we don't reuse starts.
+        if (reusable_chunk_count > 0)
+            --reusable_chunk_count;
+
+        if (reusable_chunk_count > 0) {
+            chunks.ensure_capacity(reusable_chunk_count);
+            last_non_whitespace_font = nullptr;
+            for (size_t i = 0; i < reusable_chunk_count; ++i) {
+                auto chunk = stale_chunks[i];
+                chunk.view = text.utf16_view().substring_view(chunk.start, chunk.length);
+                if (!chunk.is_all_whitespace)
+                    last_non_whitespace_font = chunk.font;
+                chunks.unchecked_append(move(chunk));
+            }
+            chunk_iterator.resume_at(stale_chunks[reusable_chunk_count].start, move(last_non_whitespace_font));
+        }
+    }
+
     while (true) {
         auto chunk = chunk_iterator.next();
         if (!chunk.has_value())
@@ -672,6 +733,14 @@ TextNode::Chunk TextNode::ChunkIterator::create_empty_chunk()
     };
 }
 
+void TextNode::ChunkIterator::resume_at(size_t index, RefPtr<Gfx::Font const> last_non_whitespace_font)
+{
+    VERIFY(m_peek_queue.is_empty());
+    VERIFY(index <= m_view.length_in_code_units());
+    m_current_index = index;
+    m_last_non_whitespace_font = move(last_non_whitespace_font);
+}
+
 bool TextNode::ChunkIterator::is_at_line_break_opportunity() const
 {
     auto has_break_all_class = [](u32 code_point) {
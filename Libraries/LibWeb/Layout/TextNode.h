@@ -72,6 +72,10 @@ public:
 
         Chunk create_empty_chunk();
 
+        // Continues chunking at a chunk boundary of a previous chunking of the same text, with the state the
+        // iterator had when it got there.
+        void resume_at(size_t index, RefPtr<Gfx::Font const> last_non_whitespace_font);
+
     private:
         Optional<Chunk> next_without_peek();
         Optional<Chunk> try_commit_chunk(size_t start, size_t end, bool has_breaking_newline, bool has_breaking_tab, bool can_break_after, Gfx::Font const&, Gfx::GlyphRun::TextType) const;
@@ -158,11 +162,20 @@ private:
         mutable Optional<ChunkCacheEntry> chunk_cache;
     };
 
+    // The chunks of the text for rendering before it last changed, kept until the next chunking so the chunks ahead
+    // of the change can be reused. The chunk views point into the old text, so it's kept alive along with them.
+    struct StaleChunkCache {
+        Utf16String text_for_rendering;
+        ChunkCacheEntry entry;
+    };
+
     TextForRenderingCacheKey create_text_for_rendering_cache_key() const;
     Utf16String compute_text_for_rendering(TextForRenderingCacheKey const&) const;
     TextDependentCache const& ensure_text_dependent_cache() const;
+    void stash_chunk_cache_for_reuse() const;
 
     mutable Optional<TextDependentCache> m_text_dependent_cache;
+    mutable Optional<StaleChunkCache> m_stale_chunk_cache;
 };
 
 class GeneratedTextNode final : public TextNode {
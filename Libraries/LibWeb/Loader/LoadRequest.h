@@ -61,9 +61,16 @@ public:
     Fetch::Infrastructure::Request::Priority priority() const { return m_priority; }
     void set_priority(Fetch::Infrastructure::Request::Priority priority) { m_priority = priority; }
 
+    HTTP::Priority const& internal_priority() const { return m_internal_priority; }
+    void set_internal_priority(HTTP::Priority internal_priority) { m_internal_priority = internal_priority; }
+
     Optional<URL::URL> const& source_url() const { return m_source_url; }
     void set_source_url(URL::URL source_url) { m_source_url = move(source_url); }
 
+    // The serialized top-level site of the request's network partition key, if it has one.
+    Optional<ByteString> const& network_partition() const { return m_network_partition; }
+    void set_network_partition(Optional<ByteString> network_partition) { m_network_partition = move(network_partition); }
+
     void start_timer() { m_load_timer.start(); }
     AK::Duration load_time() const { return m_load_timer.elapsed_time(); }
 
@@ -87,7 +94,9 @@ private:
     ReferrerPolicy::ReferrerPolicy m_referrer_policy { ReferrerPolicy::DEFAULT_REFERRER_POLICY };
     bool m_is_navigation_request { false };
     Fetch::Infrastructure::Request::Priority m_priority { Fetch::Infrastructure::Request::Priority::Auto };
+    HTTP::Priority m_internal_priority;
     Optional<URL::URL> m_source_url;
+    Optional<ByteString> m_network_partition;
 };
 
 }
@@ -93,7 +93,7 @@ void ResourceLoader::prefetch_dns(URL::URL const& url, URL::URL const& source_ur
         m_request_client->ensure_connection(url, RequestServer::CacheLevel::ResolveOnly);
 }
 
-void ResourceLoader::preconnect(URL::URL const& url, URL::URL const& source_url)
+void ResourceLoader::preconnect(URL::URL const& url, URL::URL const& source_url, Optional<ByteString> const& network_partition)
 {
     if (url.scheme().is_one_of("file"sv, "data"sv))
         return;
@@ -105,7 +105,7 @@ void ResourceLoader::preconnect(URL::URL const& url, URL::URL const& source_url)
 
     // FIXME: We could put this request in a queue until the client connection is re-established.
     if (m_request_client)
-        m_request_client->ensure_connection(url, RequestServer::CacheLevel::CreateConnection);
+        m_request_client->ensure_connection(url, RequestServer::CacheLevel::CreateConnection, network_partition);
 }
 
 static ByteString sanitized_url_for_logging(URL::URL const& url)
@@ -510,7 +510,7 @@ RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest cons
         return nullptr;
     }
 
-    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), request.headers(), request.body(), request.cache_mode(), request.include_credentials(), proxy, keep_alive_for_transfer);
+    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), request.headers(), request.body(), request.cache_mode(), request.include_credentials(), proxy, keep_alive_for_transfer, request.internal_priority(), request.network_partition());
     if (!protocol_request) {
         log_failure(request, "Failed to initiate load"sv);
         return nullptr;
@@ -45,7 +45,7 @@ public:
     RefPtr<Requests::RequestClient>& request_client() { return m_request_client; }
 
     void prefetch_dns(URL::URL const&, URL::URL const& source_url);
-    void preconnect(URL::URL const&, URL::URL const& source_url);
+    void preconnect(URL::URL const&, URL::URL const& source_url, Optional<ByteString> const& network_partition);
 
     Function<void()> on_load_counter_change;
 
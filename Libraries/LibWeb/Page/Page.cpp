@@ -789,6 +789,21 @@ void Page::unregister_media_element(Badge<HTML::HTMLMediaElement>, UniqueNodeID
     });
 }
 
+void Page::did_change_audio_play_state(Badge<HTML::HTMLMediaElement>, HTML::AudioPlayState play_state)
+{
+    switch (play_state) {
+    case HTML::AudioPlayState::Paused:
+        VERIFY(m_number_of_media_elements_playing_audio > 0);
+        --m_number_of_media_elements_playing_audio;
+        break;
+    case HTML::AudioPlayState::Playing:
+        ++m_number_of_media_elements_playing_audio;
+        break;
+    }
+
+    client().page_did_change_audio_play_state(play_state);
+}
+
 template<typename Callback>
 void Page::for_each_media_element(Callback&& callback)
 {
@@ -137,12 +137,30 @@ static bool computed_values_have_transform(CSS::ComputedValues const& computed_v
         || !computed_values.scale().is_null();
 }
 
+static bool will_change_property(CSS::ComputedValues const& computed_values, CSS::PropertyID property_id)
+{
+    auto const& will_change = computed_values.will_change();
+    return !will_change.is_auto() && will_change.has_property(property_id);
+}
+
+static bool will_change_transform(CSS::ComputedValues const& computed_values)
+{
+    return will_change_property(computed_values, CSS::PropertyID::Transform)
+        || will_change_property(computed_values, CSS::PropertyID::Translate)
+        || will_change_property(computed_values, CSS::PropertyID::Rotate)
+        || will_change_property(computed_values, CSS::PropertyID::Scale);
+}
+
 // https://drafts.csswg.org/css-transforms-2/#ctm
 Optional<TransformData> compute_transform(Paintable const& paintable_box, CSS::ComputedValues const& computed_values, double pixel_ratio)
 {
     if (!computed_values_have_transform(computed_values) || !paintable_box.layout_node().is_transformable())
         return {};
+    return compute_transform_with_transformations(paintable_box, computed_values, computed_values.transformations(), pixel_ratio);
+}
 
+TransformData compute_transform_with_transformations(Paintable const& paintable_box, CSS::ComputedValues const& computed_values, ReadonlySpan<NonnullRefPtr<CSS::TransformationStyleValue const>> transformations, double pixel_ratio)
+{
     // The transformation matrix is computed from the transform, transform-origin, translate, rotate, scale, and
     // offset properties as follows:
     auto reference_box = paintable_box.transform_reference_box();
@@ -170,7 +188,7 @@ Optional<TransformData> compute_transform(Paintable const& paintable_box, CSS::C
     // FIXME: 6. Translate and rotate by the transform specified by offset.
 
     // 7. Multiply by each of the transform functions in transform from left to right.
-    for (auto const& transform : computed_values.transformations())
+    for (auto const& transform : transformations)
         matrix = matrix * transform->to_matrix(paintable_box);
 
     // 8. Translate by the negated computed X, Y and Z values of transform-origin.
@@ -189,6 +207,17 @@ Optional<TransformData> compute_transform(Paintable const& paintable_box, CSS::C
     return TransformData { scale_matrix_for_device_pixels(matrix, scale), device_origin };
 }
 
+// A box that will change its transform gets a transform node even while it has none, so that transforming it later
+// only updates the node's value instead of changing the shape of the tree.
+static Optional<TransformData> compute_transform_node_data(Paintable const& paintable_box, CSS::ComputedValues const& computed_values, double pixel_ratio)
+{
+    if (auto transform = compute_transform(paintable_box, computed_values, pixel_ratio); transform.has_value())
+        return transform;
+    if (will_change_transform(computed_values) && paintable_box.layout_node().is_transformable())
+        return TransformData { Gfx::FloatMatrix4x4::identity(), {} };
+    return {};
+}
+
 // https://drafts.csswg.org/css-transforms-2/#perspective-matrix
 static Optional<Gfx::FloatMatrix4x4> compute_perspective_matrix(Paintable const& paintable_box, CSS::ComputedValues const& computed_values)
 {
@@ -485,20 +514,29 @@ AccumulatedVisualContextTree build_accumulated_visual_context_tree(ViewportPaint
 
         auto const& computed_values = layout_node.computed_values();
 
-        if (auto effects = compute_effects_data(paintable_box, computed_values, pixel_ratio); effects.has_value())
+        // Boxes that will change their transform or opacity become layers: Their innermost transform or effects node
+        // is the layer root, so both are applied when compositing the layer instead of being baked into its raster.
+        bool promotes_to_layer = will_change_transform(computed_values) || will_change_property(computed_values, CSS::PropertyID::Opacity);
+        Optional<VisualContextIndex> layer_root_index;
+
+        if (auto effects = compute_effects_data(paintable_box, computed_values, pixel_ratio); effects.has_value()) {
             append_to_own_and_positioned_descendant_contexts(effects.value());
+            if (promotes_to_layer)
+                layer_root_index = own_state;
+        }
 
-        if (computed_values_have_transform(computed_values)) {
-            if (auto transform_data = compute_transform(paintable_box, computed_values, pixel_ratio); transform_data.has_value()) {
-                paintable_box.set_has_non_invertible_css_transform(!transform_data->matrix.is_invertible());
-                own_state = append_node(own_state, *transform_data);
-            } else {
-                paintable_box.set_has_non_invertible_css_transform(false);
-            }
+        if (auto transform_data = compute_transform_node_data(paintable_box, computed_values, pixel_ratio); transform_data.has_value()) {
+            paintable_box.set_has_non_invertible_css_transform(!transform_data->matrix.is_invertible());
+            own_state = append_node(own_state, *transform_data);
+            if (promotes_to_layer)
+                layer_root_index = own_state;
         } else {
             paintable_box.set_has_non_invertible_css_transform(false);
         }
 
+        if (layer_root_index.has_value())
+            visual_context_tree.node_at(*layer_root_index).is_layer_root = true;
+
         if (computed_values.clip().is_rect()) {
             if (auto css_clip = compute_css_clip_data(paintable_box, computed_values, converter); css_clip.has_value())
                 append_to_own_and_positioned_descendant_contexts(css_clip.value());
@@ -712,7 +750,7 @@ bool update_accumulated_visual_context_values(ViewportPaintable& viewport_painta
     auto const& computed_values = paintable_box.computed_values();
 
     auto effects = compute_effects_data(paintable_box, computed_values, pixel_ratio);
-    auto transform = compute_transform(paintable_box, computed_values, pixel_ratio);
+    auto transform = compute_transform_node_data(paintable_box, computed_values, pixel_ratio);
     auto perspective = compute_perspective_data(paintable_box, computed_values, static_cast<float>(pixel_ratio));
 
     paintable_box.set_has_non_invertible_css_transform(transform.has_value() && !transform->matrix.is_invertible());
@@ -1225,6 +1263,7 @@ ErrorOr<void> encode(Encoder& encoder, Web::Painting::AccumulatedVisualContextNo
     TRY(encoder.encode(node.parent_index));
     TRY(encoder.encode(node.depth));
     TRY(encoder.encode(node.has_empty_effective_clip));
+    TRY(encoder.encode(node.is_layer_root));
     return {};
 }
 
@@ -1236,6 +1275,7 @@ ErrorOr<Web::Painting::AccumulatedVisualContextNode> decode(Decoder& decoder)
         .parent_index = TRY(decoder.decode<Web::Painting::VisualContextIndex>()),
         .depth = TRY(decoder.decode<size_t>()),
         .has_empty_effective_clip = TRY(decoder.decode<bool>()),
+        .is_layer_root = TRY(decoder.decode<bool>()),
     };
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/DistinctNumeric.h>
+#include <AK/NonnullRefPtr.h>
 #include <AK/Variant.h>
 #include <AK/Vector.h>
 #include <LibGfx/CompositingAndBlendingOperator.h>
@@ -26,6 +27,7 @@
 namespace Web::CSS {
 
 class ComputedValues;
+class TransformationStyleValue;
 
 }
 
@@ -116,12 +118,17 @@ struct AnchorScrollShift {
 using VisualContextData = Variant<ScrollData, ClipData, TransformData, PerspectiveData, ClipPathData, EffectsData, ScrollCompensation, AnchorScrollShift, MaskData>;
 
 Optional<TransformData> compute_transform(Paintable const&, CSS::ComputedValues const&, double pixel_ratio);
+// Like compute_transform(), but with the given transform functions in place of the computed value of `transform`.
+TransformData compute_transform_with_transformations(Paintable const&, CSS::ComputedValues const&, ReadonlySpan<NonnullRefPtr<CSS::TransformationStyleValue const>>, double pixel_ratio);
 
 struct AccumulatedVisualContextNode {
     VisualContextData data;
     VisualContextIndex parent_index {};
     size_t depth { 0 };
     bool has_empty_effective_clip { false };
+    // The content below this node is rasterized once and composited with the node's current transform and effects,
+    // instead of being replayed on every frame. Set for boxes that will change their transform or opacity.
+    bool is_layer_root { false };
 };
 
 class AccumulatedVisualContextTree {
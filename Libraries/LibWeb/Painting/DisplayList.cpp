@@ -4,9 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/Atomic.h>
 #include <AK/NumericLimits.h>
 #include <AK/TemporaryChange.h>
+#include <LibGfx/AffineTransform.h>
 #include <LibGfx/PaintingSurface.h>
 #include <LibIPC/Decoder.h>
 #include <LibIPC/Encoder.h>
@@ -139,6 +141,7 @@ void DisplayListPlayer::execute_display_list_into_surface(DisplayList const& dis
     TemporaryChange surface_change { m_surface, RefPtr<Gfx::PaintingSurface> { target_surface } };
     TemporaryChange display_list_change { m_active_display_list, &display_list };
     TemporaryChange visual_context_tree_change { m_active_visual_context_tree, &visual_context_tree };
+    TemporaryChange layer_root_change { m_rasterizing_layer_root, Optional<VisualContextIndex> {} };
     VERIFY(m_resource_storage);
     ScrollStateSnapshot scroll_state_snapshot;
     execute_impl(display_list, scroll_state_snapshot);
@@ -153,10 +156,186 @@ void DisplayListPlayer::execute_nested_display_list(
     VERIFY(display_list.compatible_visual_context_tree_version() == visual_context_tree.version());
     TemporaryChange display_list_change { m_active_display_list, &display_list };
     TemporaryChange visual_context_tree_change { m_active_visual_context_tree, &visual_context_tree };
+    TemporaryChange layer_root_change { m_rasterizing_layer_root, Optional<VisualContextIndex> {} };
     VERIFY(m_resource_storage);
     execute_impl(display_list, scroll_state_snapshot, command_bytes);
 }
 
+void DisplayListPlayer::execute_layer_content_into_surface(LayerContent const& layer_content, Gfx::PaintingSurface& target_surface)
+{
+    TemporaryChange surface_change { m_surface, RefPtr<Gfx::PaintingSurface> { target_surface } };
+    TemporaryChange layer_root_change { m_rasterizing_layer_root, Optional<VisualContextIndex> { layer_content.root } };
+    // NB: Layer content never contains scroll nodes below its root, and the root's own position is applied when
+    //     compositing the raster, so the content does not depend on any scroll offset.
+    ScrollStateSnapshot scroll_state_snapshot;
+    execute_impl(active_display_list(), scroll_state_snapshot, layer_content.command_bytes);
+}
+
+static bool is_2d_affine_transform(Gfx::FloatMatrix4x4 const& matrix)
+{
+    return matrix[0, 2] == 0 && matrix[1, 2] == 0 && matrix[2, 0] == 0 && matrix[2, 1] == 0
+        && matrix[2, 2] == 1 && matrix[2, 3] == 0
+        && matrix[3, 0] == 0 && matrix[3, 1] == 0 && matrix[3, 2] == 0 && matrix[3, 3] == 1;
+}
+
+static void append_layer_content_state(Vector<float>& content_state, VisualContextData const& data)
+{
+    data.visit(
+        [&](ClipData const& clip) {
+            auto rect = clip.rect.to_type<int>();
+            for (auto value : { rect.x(), rect.y(), rect.width(), rect.height() })
+                content_state.append(static_cast<float>(value));
+            for (auto const& corner : { clip.corner_radii.top_left, clip.corner_radii.top_right, clip.corner_radii.bottom_right, clip.corner_radii.bottom_left }) {
+                content_state.append(static_cast<float>(corner.horizontal_radius));
+                content_state.append(static_cast<float>(corner.vertical_radius));
+            }
+        },
+        [&](TransformData const& transform) {
+            for (size_t row = 0; row < 4; ++row) {
+                for (size_t column = 0; column < 4; ++column)
+                    content_state.append(transform.matrix[row, column]);
+            }
+            content_state.append(transform.origin.x());
+            content_state.append(transform.origin.y());
+        },
+        [&](EffectsData const& effects) {
+            content_state.append(effects.opacity);
+        },
+        [](auto const&) { VERIFY_NOT_REACHED(); });
+}
+
+// Finds the runs of commands below layer roots whose raster can be composited in place of replaying them. That is only
+// equivalent when the pixels of the run depend on nothing outside of it: The nodes between the root and the commands
+// must be 2D transforms, clips, or plain opacity, the run must not read what was painted underneath it or draw live
+// content, and it must leave the canvas state as it found it.
+Vector<DisplayListPlayer::LayerContent> DisplayListPlayer::find_layer_contents(DisplayList const& display_list, ReadonlyBytes commands) const
+{
+    Vector<LayerContent> layer_contents;
+    auto const& nodes = active_visual_context_tree().nodes();
+    if (!any_of(nodes, [](auto const& node) { return node.is_layer_root; }))
+        return layer_contents;
+
+    // The outermost layer root every node is at or below, and the transform from the node's space to the root's.
+    struct NodeLayerInfo {
+        Optional<VisualContextIndex> root;
+        bool is_cacheable { true };
+        Gfx::AffineTransform to_root;
+    };
+    Vector<NodeLayerInfo> node_infos;
+    node_infos.ensure_capacity(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto const& node = nodes[i];
+        if (i == 0 || !node_infos[node.parent_index.value()].root.has_value()) {
+            node_infos.unchecked_append({ .root = node.is_layer_root ? Optional<VisualContextIndex> { VisualContextIndex { i } } : Optional<VisualContextIndex> {}, .is_cacheable = true, .to_root = {} });
+            continue;
+        }
+        auto info = node_infos[node.parent_index.value()];
+        node.data.visit(
+            [&](TransformData const& transform) {
+                if (!is_2d_affine_transform(transform.matrix)) {
+                    info.is_cacheable = false;
+                    return;
+                }
+                info.to_root.translate(transform.origin).multiply(Gfx::extract_2d_affine_transform(transform.matrix)).translate(-transform.origin);
+            },
+            [&](ClipData const&) {},
+            [&](EffectsData const& effects) {
+                if (effects.blend_mode != Gfx::CompositingAndBlendingOperator::Normal || effects.gfx_filter.has_value())
+                    info.is_cacheable = false;
+            },
+            [&](auto const&) { info.is_cacheable = false; });
+        node_infos.unchecked_append(move(info));
+    }
+
+    auto const* display_list_commands = display_list.command_bytes().data();
+    Optional<LayerContent> run;
+    Vector<VisualContextIndex> run_content_nodes;
+    Vector<u32> node_run_stamps;
+    node_run_stamps.resize(nodes.size());
+    u32 run_stamp = 0;
+    bool run_is_cacheable = false;
+    size_t run_save_depth = 0;
+    size_t run_end_offset = 0;
+
+    auto close_run = [&] {
+        if (!run.has_value())
+            return;
+        if (run_is_cacheable && run_save_depth == 0 && !run->bounding_rect.is_empty()) {
+            auto start = static_cast<size_t>(display_list_commands + run->command_offset - commands.data());
+            run->command_bytes = commands.slice(start, run_end_offset - run->command_offset);
+            for (auto index : run_content_nodes)
+                append_layer_content_state(run->content_state, nodes[index.value()].data);
+            // Antialiased edges of transformed content can reach into the pixels around its bounds.
+            run->bounding_rect.inflate(2, 2);
+            layer_contents.append(run.release_value());
+        }
+        run.clear();
+    };
+
+    DisplayList::for_each_command_header(commands, [&](DisplayListCommandHeader const& header, ReadonlyBytes payload) {
+        if (display_list_command_is_compositor_metadata(header.type))
+            return;
+
+        auto command_offset = static_cast<size_t>(payload.data() - sizeof(DisplayListCommandHeader) - display_list_commands);
+        auto const& info = node_infos[header.context_index.value()];
+        auto root = header.context_geometry_only ? Optional<VisualContextIndex> {} : info.root;
+        if (!run.has_value() || !root.has_value() || run->root != *root) {
+            close_run();
+            if (!root.has_value())
+                return;
+            run = LayerContent { .root = *root, .command_offset = command_offset, .command_bytes = {}, .bounding_rect = {}, .content_state = {} };
+            run_content_nodes.clear_with_capacity();
+            ++run_stamp;
+            run_is_cacheable = true;
+            run_save_depth = 0;
+        }
+        run_end_offset = command_offset + sizeof(DisplayListCommandHeader) + header.payload_size;
+        if (!run_is_cacheable)
+            return;
+        if (!info.is_cacheable) {
+            run_is_cacheable = false;
+            return;
+        }
+
+        for (auto index = header.context_index; index != run->root; index = nodes[index.value()].parent_index) {
+            if (exchange(node_run_stamps[index.value()], run_stamp) == run_stamp)
+                break;
+            run_content_nodes.append(index);
+        }
+
+        if (header.has_bounding_rect && !header.is_clip) {
+            auto rect_in_root_space = info.to_root.map(header.bounding_rect);
+            run->bounding_rect = run->bounding_rect.is_empty() ? rect_in_root_space : run->bounding_rect.united(rect_in_root_space);
+        }
+
+        visit_display_list_command(header.type, payload, [&](auto const& command) {
+            using Command = RemoveCVReference<decltype(command)>;
+            if constexpr (IsSame<Command, Save> || IsSame<Command, SaveLayer>) {
+                ++run_save_depth;
+            } else if constexpr (IsSame<Command, ApplyEffects>) {
+                if (command.compositing_and_blending_operator != Gfx::CompositingAndBlendingOperator::Normal || command.has_filter)
+                    run_is_cacheable = false;
+                ++run_save_depth;
+            } else if constexpr (IsSame<Command, Restore>) {
+                if (run_save_depth == 0)
+                    run_is_cacheable = false;
+                else
+                    --run_save_depth;
+            } else if constexpr (IsSame<Command, ApplyBackdropFilter> || IsSame<Command, DrawVideoFrame> || IsSame<Command, DrawCanvas> || IsSame<Command, DrawCompositedContext> || IsSame<Command, PaintScrollBar>) {
+                run_is_cacheable = false;
+            } else if constexpr (IsSame<Command, PaintNestedDisplayList>) {
+                if (!resource_storage().has_display_list(command.display_list_id) || resource_storage().display_list_requires_direct_replay(command.display_list_id))
+                    run_is_cacheable = false;
+            } else if (!header.has_bounding_rect || (header.is_clip && run_save_depth == 0)) {
+                // Content without bounds could paint anywhere, and a clip outside of any save would leak out of the run.
+                run_is_cacheable = false;
+            }
+        });
+    });
+    close_run();
+    return layer_contents;
+}
+
 void DisplayListPlayer::execute_impl(DisplayList const& display_list, ScrollStateSnapshot const& scroll_state)
 {
     execute_impl(display_list, scroll_state, display_list.command_bytes());
@@ -197,6 +376,14 @@ void DisplayListPlayer::execute_impl(
     auto const replay_base_matrix = canvas_matrix();
     for (size_t i = 0; i < nodes.size(); ++i) {
         auto const& node = nodes[i];
+        if (m_rasterizing_layer_root == VisualContextIndex { i }) {
+            // Layer content is rasterized in its root's space, which then coincides with the surface's, without the
+            // frames of the root and its ancestors. These are applied when compositing the raster instead.
+            transform_palette.unchecked_append(replay_base_matrix);
+            nearest_spatial_node.unchecked_append(VisualContextIndex { i });
+            nearest_frame_node.unchecked_append(VISUAL_VIEWPORT_NODE_INDEX);
+            continue;
+        }
         auto append_spatial = [&](Gfx::FloatMatrix4x4 const& local_matrix) {
             auto const& parent_matrix = i == 0 ? replay_base_matrix : transform_palette[node.parent_index.value()];
             transform_palette.unchecked_append(parent_matrix * local_matrix);
@@ -385,10 +572,34 @@ void DisplayListPlayer::execute_impl(
         return SwitchResult::Switched;
     };
 
+    // Layer content is not looked for while rasterizing layer content, as it is only ever found at the outermost root.
+    auto layer_contents = m_rasterizing_layer_root.has_value() ? Vector<LayerContent> {} : find_layer_contents(display_list, commands);
+    size_t next_layer_content_index = 0;
+    size_t end_of_painted_layer_content = 0;
+
     DisplayList::for_each_command_header(commands, [&](DisplayListCommandHeader const& header, ReadonlyBytes payload) {
         if (display_list_command_is_compositor_metadata(header.type))
             return;
 
+        if (!layer_contents.is_empty()) {
+            auto command_offset = static_cast<size_t>(payload.data() - sizeof(DisplayListCommandHeader) - display_list.command_bytes().data());
+            if (command_offset < end_of_painted_layer_content)
+                return;
+            if (next_layer_content_index < layer_contents.size() && layer_contents[next_layer_content_index].command_offset == command_offset) {
+                auto const& layer_content = layer_contents[next_layer_content_index++];
+                auto end_of_layer_content = layer_content.command_offset + layer_content.command_bytes.size();
+                if (switch_to_context(layer_content.root, false, layer_content.bounding_rect) == SwitchResult::CulledByEffect) {
+                    end_of_painted_layer_content = end_of_layer_content;
+                    return;
+                }
+                ensure_ctm_space(layer_content.root);
+                if (would_be_fully_clipped_by_painter(layer_content.bounding_rect) || paint_layer_content(layer_content)) {
+                    end_of_painted_layer_content = end_of_layer_content;
+                    return;
+                }
+            }
+        }
+
         auto bounding_rect = header.has_bounding_rect
             ? Optional<Gfx::IntRect>(header.bounding_rect)
             : Optional<Gfx::IntRect> {};
@@ -443,6 +654,52 @@ void DisplayListPlayer::execute_impl(
     m_replay_palette_storage = move(palette_storage);
 }
 
+DisplayListDelta DisplayListDelta::create(DisplayList const& base, DisplayList const& display_list)
+{
+    auto base_bytes = base.command_bytes();
+    auto bytes = display_list.command_bytes();
+    auto max_common_size = min(base_bytes.size(), bytes.size());
+
+    size_t common_prefix_size = 0;
+    while (common_prefix_size < max_common_size && base_bytes[common_prefix_size] == bytes[common_prefix_size])
+        ++common_prefix_size;
+
+    size_t common_suffix_size = 0;
+    while (common_prefix_size + common_suffix_size < max_common_size
+        && base_bytes[base_bytes.size() - common_suffix_size - 1] == bytes[bytes.size() - common_suffix_size - 1])
+        ++common_suffix_size;
+
+    return DisplayListDelta {
+        .base_display_list_id = base.id(),
+        .display_list_id = display_list.id(),
+        .common_prefix_size = common_prefix_size,
+        .common_suffix_size = common_suffix_size,
+        .changed_command_bytes = MUST(ByteBuffer::copy(bytes.slice(common_prefix_size, bytes.size() - common_prefix_size - common_suffix_size))),
+        .compatible_visual_context_tree_version = display_list.compatible_visual_context_tree_version(),
+        .surface_clear_color = display_list.surface_clear_color(),
+        .async_scrolling_metadata = display_list.async_scrolling_metadata(),
+        .mask_display_lists = display_list.mask_display_lists(),
+    };
+}
+
+ErrorOr<NonnullRefPtr<DisplayList>> DisplayListDelta::apply_to(DisplayList const& base) const
+{
+    if (base.id() != base_display_list_id)
+        return Error::from_string_literal("Display list delta is based on a different display list");
+
+    auto base_bytes = base.command_bytes();
+    if (common_prefix_size > base_bytes.size() || common_suffix_size > base_bytes.size() - common_prefix_size)
+        return Error::from_string_literal("Display list delta keeps more command bytes than the base display list has");
+
+    auto command_bytes = TRY(ByteBuffer::create_uninitialized(common_prefix_size + changed_command_bytes.size() + common_suffix_size));
+    base_bytes.slice(0, common_prefix_size).copy_to(command_bytes.span());
+    changed_command_bytes.span().copy_to(command_bytes.span().slice(common_prefix_size));
+    base_bytes.slice(base_bytes.size() - common_suffix_size).copy_to(command_bytes.span().slice(common_prefix_size + changed_command_bytes.size()));
+
+    auto mask_display_lists = this->mask_display_lists;
+    return adopt_ref(*new DisplayList(compatible_visual_context_tree_version, display_list_id, move(command_bytes), surface_clear_color, async_scrolling_metadata, move(mask_display_lists)));
+}
+
 }
 
 namespace IPC {
@@ -498,4 +755,35 @@ ErrorOr<NonnullRefPtr<Web::Painting::DisplayList>> decode(Decoder& decoder)
     return adopt_ref(*new Web::Painting::DisplayList(compatible_visual_context_tree_version, id, move(command_bytes), surface_clear_color, move(async_scrolling_metadata), move(mask_display_lists)));
 }
 
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::Painting::DisplayListDelta const& delta)
+{
+    TRY(encoder.encode(delta.base_display_list_id));
+    TRY(encoder.encode(delta.display_list_id));
+    TRY(encoder.encode(delta.common_prefix_size));
+    TRY(encoder.encode(delta.common_suffix_size));
+    TRY(encoder.encode(delta.changed_command_bytes));
+    TRY(encoder.encode(delta.compatible_visual_context_tree_version));
+    TRY(encoder.encode(delta.surface_clear_color));
+    TRY(encoder.encode(delta.async_scrolling_metadata));
+    TRY(encoder.encode(delta.mask_display_lists));
+    return {};
+}
+
+template<>
+ErrorOr<Web::Painting::DisplayListDelta> decode(Decoder& decoder)
+{
+    return Web::Painting::DisplayListDelta {
+        .base_display_list_id = TRY(decoder.decode<u64>()),
+        .display_list_id = TRY(decoder.decode<u64>()),
+        .common_prefix_size = TRY(decoder.decode<u64>()),
+        .common_suffix_size = TRY(decoder.decode<u64>()),
+        .changed_command_bytes = TRY(decoder.decode<ByteBuffer>()),
+        .compatible_visual_context_tree_version = TRY(decoder.decode<u64>()),
+        .surface_clear_color = TRY(decoder.decode<Optional<Gfx::Color>>()),
+        .async_scrolling_metadata = TRY(decoder.decode<Optional<Web::Painting::DisplayList::AsyncScrollingMetadata>>()),
+        .mask_display_lists = TRY(decoder.decode<HashMap<Web::Painting::VisualContextIndex, Web::Painting::DisplayListResourceId>>()),
+    };
+}
+
 }
@@ -61,6 +61,19 @@ protected:
     void execute_display_list_into_surface(DisplayList const&, AccumulatedVisualContextTree const&, Gfx::PaintingSurface&);
     void execute_nested_display_list(DisplayList const&, AccumulatedVisualContextTree const&, ScrollStateSnapshot const&, ReadonlyBytes command_bytes);
 
+    // A run of consecutive commands below a layer root (see AccumulatedVisualContextNode::is_layer_root) that can be
+    // rasterized in the root's space and composited with the root's current transform and effects.
+    struct LayerContent {
+        VisualContextIndex root;
+        // Offset of the first command into the display list's command bytes, which identifies the run.
+        size_t command_offset { 0 };
+        ReadonlyBytes command_bytes;
+        Gfx::IntRect bounding_rect;
+        // The values of the nodes between the root and the commands, which a raster of the run is only valid for.
+        Vector<float> content_state;
+    };
+    void execute_layer_content_into_surface(LayerContent const&, Gfx::PaintingSurface&);
+
 private:
 #define DECLARE_PLAY_COMMAND(command_type, player_method) \
     virtual void play_command(command_type const&) = 0;
@@ -73,12 +86,20 @@ private:
 
     virtual void add_clip_path(Gfx::Path const&, Gfx::WindingRule) = 0;
 
+    // Paints the layer content with the canvas in the root's space and the root's frames applied. Returns false if the
+    // commands have to be replayed instead.
+    virtual bool paint_layer_content(LayerContent const&) { return false; }
+
+    Vector<LayerContent> find_layer_contents(DisplayList const&, ReadonlyBytes command_bytes) const;
+
     DisplayList const* m_active_display_list { nullptr };
     AccumulatedVisualContextTree const* m_active_visual_context_tree { nullptr };
     DisplayListResourceStorage const* m_resource_storage { nullptr };
     CanvasSurfaceRegistry const* m_canvas_surface_registry { nullptr };
     RefPtr<Gfx::PaintingSurface> m_surface;
     ReadonlyBytes m_current_command_payload;
+    // While rasterizing layer content, the root is replayed as if it was the root of the tree.
+    Optional<VisualContextIndex> m_rasterizing_layer_root;
 
     // Scratch for the per-replay transform palette, retained so steady-state replays reuse warm
     // capacity; execute_impl moves it out for the duration of a replay, letting re-entrant nested
@@ -194,12 +215,32 @@ private:
     Optional<AsyncScrollingMetadata> m_async_scrolling_metadata;
     HashMap<VisualContextIndex, DisplayListResourceId> m_mask_display_lists;
 
+    friend struct DisplayListDelta;
+
     template<typename T>
     friend ErrorOr<void> IPC::encode(IPC::Encoder&, T const&);
     template<typename T>
     friend ErrorOr<T> IPC::decode(IPC::Decoder&);
 };
 
+// A display list expressed as a change to an earlier one that the receiver already has. Consecutive display lists of
+// a page tend to share almost all of their commands (e.g. when only a caret blinks), so only the command bytes between
+// their common prefix and common suffix are sent.
+struct WEB_API DisplayListDelta {
+    static DisplayListDelta create(DisplayList const& base, DisplayList const&);
+    ErrorOr<NonnullRefPtr<DisplayList>> apply_to(DisplayList const& base) const;
+
+    u64 base_display_list_id { 0 };
+    u64 display_list_id { 0 };
+    u64 common_prefix_size { 0 };
+    u64 common_suffix_size { 0 };
+    ByteBuffer changed_command_bytes;
+    u64 compatible_visual_context_tree_version { 0 };
+    Optional<Gfx::Color> surface_clear_color;
+    Optional<DisplayList::AsyncScrollingMetadata> async_scrolling_metadata;
+    HashMap<VisualContextIndex, DisplayListResourceId> mask_display_lists;
+};
+
 }
 
 namespace IPC {
@@ -216,4 +257,9 @@ WEB_API ErrorOr<void> encode(Encoder&, NonnullRefPtr<Web::Painting::DisplayList>
 template<>
 WEB_API ErrorOr<NonnullRefPtr<Web::Painting::DisplayList>> decode(Decoder&);
 
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::Painting::DisplayListDelta const&);
+template<>
+WEB_API ErrorOr<Web::Painting::DisplayListDelta> decode(Decoder&);
+
 }
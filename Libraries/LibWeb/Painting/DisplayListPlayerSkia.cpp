@@ -65,9 +65,29 @@ void DisplayListPlayerSkia::execute(
     ScrollStateSnapshot const& scroll_state_snapshot,
     RefPtr<Gfx::PaintingSurface> surface,
     CanvasSurfaceRegistry const* canvas_surface_registry,
-    CompositedContextResolver const* composited_context_resolver)
+    CompositedContextResolver const* composited_context_resolver,
+    Optional<Gfx::IntSize> backdrop_filter_cache_viewport_size)
 {
     TemporaryChange composited_context_resolver_change { m_composited_context_resolver, composited_context_resolver };
+
+    Optional<BackdropFilterCacheState> backdrop_filter_cache_state;
+    if (backdrop_filter_cache_viewport_size.has_value() && surface) {
+        // NB: The viewport may be painted into a surface that only covers its damage, with the canvas translated
+        //     accordingly. Anything other than a whole pixel translation would keep cached results from lining up.
+        auto const& canvas = surface->canvas();
+        auto matrix = canvas.getTotalMatrix();
+        if (matrix.isTranslate() && SkScalarIsInt(matrix.getTranslateX()) && SkScalarIsInt(matrix.getTranslateY())) {
+            auto painted_rect = canvas.getDeviceClipBounds();
+            backdrop_filter_cache_state = BackdropFilterCacheState {
+                .surface = surface.ptr(),
+                .viewport_rect = { static_cast<int>(matrix.getTranslateX()), static_cast<int>(matrix.getTranslateY()), backdrop_filter_cache_viewport_size->width(), backdrop_filter_cache_viewport_size->height() },
+                .painted_rect = { painted_rect.x(), painted_rect.y(), painted_rect.width(), painted_rect.height() },
+            };
+        }
+    }
+    TemporaryChange backdrop_filter_cache_state_change { m_backdrop_filter_cache_state, backdrop_filter_cache_state };
+    m_layer_save_counts.clear_with_capacity();
+
     DisplayListPlayer::execute(
         display_list,
         visual_context_tree,
@@ -185,26 +205,35 @@ void DisplayListPlayerSkia::paint_scrollbar(Gfx::PaintingSurface& surface, Paint
 
 void DisplayListPlayerSkia::play_command(DrawGlyphRun const& command)
 {
-    auto const& font = resource_storage().font(command.font_id);
-    auto glyphs = inline_objects<DisplayListGlyph>(command.glyphs);
-    if (glyphs.is_empty())
+    auto glyph_bytes = inline_data(command.glyphs);
+    if (glyph_bytes.is_empty())
         return;
 
-    auto sk_font = font.skia_font(command.scale);
-    SkTextBlobBuilder builder;
-    auto const& run = builder.allocRunPos(sk_font, glyphs.size());
+    // OPTIMIZATION: Glyph runs are recorded again on every paint, but a run of the same glyphs in the same font keeps
+    //               producing the same blob. Reusing the blob keeps its unique ID stable, which lets Ganesh find the
+    //               run's glyphs and vertices in its text blob cache instead of regenerating them on every frame.
+    auto blob = resource_storage().cached_text_blob(command.font_id, command.scale, glyph_bytes);
+    if (!blob) {
+        auto const& font = resource_storage().font(command.font_id);
+        auto glyphs = inline_objects<DisplayListGlyph>(command.glyphs);
+
+        auto sk_font = font.skia_font(command.scale);
+        SkTextBlobBuilder builder;
+        auto const& run = builder.allocRunPos(sk_font, glyphs.size());
+
+        auto font_ascent = font.pixel_metrics().ascent;
+        for (size_t i = 0; i < glyphs.size(); ++i) {
+            run.glyphs[i] = glyphs[i].glyph_id;
+            run.pos[i * 2] = glyphs[i].position.x() * command.scale;
+            run.pos[i * 2 + 1] = (glyphs[i].position.y() + font_ascent) * command.scale;
+        }
 
-    auto font_ascent = font.pixel_metrics().ascent;
-    for (size_t i = 0; i < glyphs.size(); ++i) {
-        run.glyphs[i] = glyphs[i].glyph_id;
-        run.pos[i * 2] = glyphs[i].position.x() * command.scale;
-        run.pos[i * 2 + 1] = (glyphs[i].position.y() + font_ascent) * command.scale;
+        blob = builder.make();
+        if (!blob)
+            return;
+        resource_storage().set_cached_text_blob(command.font_id, command.scale, glyph_bytes, blob);
     }
 
-    auto blob = builder.make();
-    if (!blob)
-        return;
-
     SkPaint paint;
     paint.setColor(to_skia_color(command.color));
 
@@ -321,18 +350,53 @@ void DisplayListPlayerSkia::play_command(DrawVideoFrame const& command)
     canvas.drawImageRect(image.get(), src_rect, dst_rect, to_skia_sampling_options(command.scaling_mode), &paint, SkCanvas::kStrict_SrcRectConstraint);
 }
 
+static Gfx::IntSize device_size_of_image_frame(SkCanvas const& canvas, Gfx::IntSize frame_size, SkRect const& src_rect, SkRect const& dst_rect)
+{
+    if (src_rect.isEmpty())
+        return frame_size;
+    auto device_rect = canvas.getTotalMatrix().mapRect(dst_rect);
+    auto width = ceilf(device_rect.width() * frame_size.width() / src_rect.width());
+    auto height = ceilf(device_rect.height() * frame_size.height() / src_rect.height());
+    return {
+        clamp(static_cast<int>(min(width, static_cast<float>(frame_size.width()))), 1, frame_size.width()),
+        clamp(static_cast<int>(min(height, static_cast<float>(frame_size.height()))), 1, frame_size.height()),
+    };
+}
+
+// Maps a rect in the coordinates of the decoded frame to those of the (possibly downscaled) image it's drawn from.
+static SkRect frame_rect_to_image_rect(SkRect const& rect, Gfx::IntSize frame_size, SkImage const& image)
+{
+    auto scale_x = static_cast<float>(image.width()) / frame_size.width();
+    auto scale_y = static_cast<float>(image.height()) / frame_size.height();
+    return SkRect::MakeXYWH(rect.x() * scale_x, rect.y() * scale_y, rect.width() * scale_x, rect.height() * scale_y);
+}
+
+sk_sp<SkImage> DisplayListPlayerSkia::skia_image_for_image_frame(ImageFrameResourceId frame_id, Gfx::ScalingMode scaling_mode, SkRect const& src_rect, SkRect const& dst_rect)
+{
+    // OPTIMIZATION: A frame that ends up much smaller on screen than its natural size is drawn from a mip level close
+    //               to its device size, so we neither resample the full resolution frame on every draw nor upload it
+    //               to the GPU at all. Only smooth downscaling asks for mipmaps; other modes keep the exact pixels.
+    if (scaling_mode != Gfx::ScalingMode::BilinearMipmap)
+        return resource_storage().skia_image_for_image_frame(frame_id, m_skia_backend_context);
+    auto frame_size = resource_storage().image_frame(frame_id).size();
+    auto device_size = device_size_of_image_frame(surface().canvas(), frame_size, src_rect, dst_rect);
+    return resource_storage().skia_image_for_image_frame(frame_id, m_skia_backend_context, device_size);
+}
+
 void DisplayListPlayerSkia::play_command(DrawScaledDecodedImageFrame const& command)
 {
-    auto image = resource_storage().skia_image_for_image_frame(command.frame_id, m_skia_backend_context);
+    auto frame_size = resource_storage().image_frame(command.frame_id).size();
+    auto dst_rect = to_skia_rect(command.dst_rect);
+    auto frame_src_rect = command.src_rect.has_value() ? to_skia_rect(command.src_rect.value()) : SkRect::MakeIWH(frame_size.width(), frame_size.height());
+    auto image = skia_image_for_image_frame(command.frame_id, command.scaling_mode, frame_src_rect, dst_rect);
     if (!image)
         return;
 
-    auto dst_rect = to_skia_rect(command.dst_rect);
+    auto src_rect = frame_rect_to_image_rect(frame_src_rect, frame_size, *image);
     auto& canvas = surface().canvas();
     SkPaint paint;
     paint.setAntiAlias(true);
     if (command.isolated_backdrop_color.has_value()) {
-        auto src_rect = command.src_rect.value_or(Gfx::FloatRect { 0, 0, static_cast<float>(image->width()), static_cast<float>(image->height()) });
         SkMatrix matrix;
         matrix.setScale(dst_rect.width() / src_rect.width(), dst_rect.height() / src_rect.height());
         matrix.postTranslate(dst_rect.x() - src_rect.x() * dst_rect.width() / src_rect.width(), dst_rect.y() - src_rect.y() * dst_rect.height() / src_rect.height());
@@ -347,7 +411,6 @@ void DisplayListPlayerSkia::play_command(DrawScaledDecodedImageFrame const& comm
     if (command.isolated_backdrop_color.has_value()) {
         canvas.drawRect(dst_rect, paint);
     } else if (command.src_rect.has_value()) {
-        auto src_rect = to_skia_rect(command.src_rect.value());
         canvas.drawImageRect(image.get(), src_rect, dst_rect, to_skia_sampling_options(command.scaling_mode), &paint, SkCanvas::kStrict_SrcRectConstraint);
     } else {
         canvas.drawImageRect(image.get(), dst_rect, to_skia_sampling_options(command.scaling_mode), &paint);
@@ -357,15 +420,14 @@ void DisplayListPlayerSkia::play_command(DrawScaledDecodedImageFrame const& comm
 
 void DisplayListPlayerSkia::play_command(DrawRepeatedDecodedImageFrame const& command)
 {
-    auto const& frame = resource_storage().image_frame(command.frame_id);
-    auto image = resource_storage().skia_image_for_image_frame(command.frame_id, m_skia_backend_context);
+    auto frame_size = resource_storage().image_frame(command.frame_id).size();
+    auto dst_rect = command.dst_rect.to_type<float>();
+    auto image = skia_image_for_image_frame(command.frame_id, command.scaling_mode, SkRect::MakeIWH(frame_size.width(), frame_size.height()), to_skia_rect(dst_rect));
     if (!image)
         return;
 
     SkMatrix matrix;
-    auto dst_rect = command.dst_rect.to_type<float>();
-    auto src_size = frame.size().to_type<float>();
-    matrix.setScale(dst_rect.width() / src_size.width(), dst_rect.height() / src_size.height());
+    matrix.setScale(dst_rect.width() / image->width(), dst_rect.height() / image->height());
     matrix.postTranslate(dst_rect.x(), dst_rect.y());
     auto sampling_options = to_skia_sampling_options(command.scaling_mode);
 
@@ -408,7 +470,8 @@ static void paint_repeated_image(SkCanvas& canvas, SkImage& image, Gfx::IntRect
 
 void DisplayListPlayerSkia::play_command(DrawTiledDecodedImageFrame const& command)
 {
-    auto image = resource_storage().skia_image_for_image_frame(command.frame_id, m_skia_backend_context);
+    auto frame_size = resource_storage().image_frame(command.frame_id).size();
+    auto image = skia_image_for_image_frame(command.frame_id, command.scaling_mode, to_skia_rect(command.src_rect), to_skia_rect(command.tile_rect));
     if (!image)
         return;
 
@@ -426,7 +489,7 @@ void DisplayListPlayerSkia::play_command(DrawTiledDecodedImageFrame const& comma
     tile_paint.setAntiAlias(true);
     tile_canvas->drawImageRect(
         image.get(),
-        to_skia_rect(command.src_rect),
+        frame_rect_to_image_rect(to_skia_rect(command.src_rect), frame_size, *image),
         SkRect::MakeWH(command.src_rect.width(), command.src_rect.height()),
         sampling_options,
         &tile_paint,
@@ -518,6 +581,7 @@ void DisplayListPlayerSkia::play_command(Save const&)
 void DisplayListPlayerSkia::play_command(SaveLayer const&)
 {
     auto& canvas = surface().canvas();
+    m_layer_save_counts.append(canvas.getSaveCount());
     canvas.saveLayer(nullptr, nullptr);
 }
 
@@ -965,11 +1029,85 @@ void DisplayListPlayerSkia::play_command(ApplyBackdropFilter const& command)
             return resource_storage().image_frame(ImageFrameResourceId { image_id });
         });
         auto image_filter = to_skia_image_filter(filter);
+        if (image_filter && paint_cached_backdrop_filter_result(command, *image_filter))
+            return;
         canvas.saveLayer(SkCanvas::SaveLayerRec(nullptr, nullptr, image_filter.get(), 0));
         canvas.restore();
     }
 }
 
+// OPTIMIZATION: Blurring the backdrop of a frosted glass header is one of the most expensive things a frame can do,
+//               and the result only changes when something is painted below the header. Results are kept in the
+//               resource storage until damage to their backdrop is reported, and reused for every repaint of the
+//               header in between, e.g. when the back buffer is brought up to date with earlier frames' damage.
+bool DisplayListPlayerSkia::paint_cached_backdrop_filter_result(ApplyBackdropFilter const& command, SkImageFilter const& image_filter)
+{
+    if (!m_backdrop_filter_cache_state.has_value() || m_backdrop_filter_cache_state->surface != &surface())
+        return false;
+    auto& canvas = surface().canvas();
+    auto matrix = canvas.getTotalMatrix();
+    if (!matrix.isTranslate() || !SkScalarIsInt(matrix.getTranslateX()) || !SkScalarIsInt(matrix.getTranslateY()))
+        return false;
+    // NB: Inside a layer, the backdrop is the layer's content, which isn't in the surface yet.
+    if (is_painting_into_layer())
+        return false;
+
+    auto const& cache_state = *m_backdrop_filter_cache_state;
+    auto translation = Gfx::IntPoint { static_cast<int>(matrix.getTranslateX()), static_cast<int>(matrix.getTranslateY()) };
+    auto rect = command.backdrop_region.translated(translation).intersected(cache_state.viewport_rect);
+    if (rect.is_empty())
+        return false;
+
+    auto to_viewport_rect = [&](Gfx::IntRect const& surface_rect) {
+        return surface_rect.translated(-cache_state.viewport_rect.location());
+    };
+    // The result already has the filtered backdrop composited over the original one, so it replaces what's there.
+    auto paint_result = [&](SkImage const& image) {
+        SkPaint paint;
+        paint.setBlendMode(SkBlendMode::kSrc);
+        canvas.save();
+        canvas.resetMatrix();
+        canvas.drawImage(&image, rect.x(), rect.y(), SkSamplingOptions {}, &paint);
+        canvas.restore();
+    };
+
+    auto filter_data = inline_data(command.backdrop_filter_data);
+    if (auto image = resource_storage().cached_backdrop_filter_result(filter_data, to_viewport_rect(rect), m_skia_backend_context)) {
+        paint_result(*image);
+        return true;
+    }
+
+    // A result can only be reused if everything the filter reads within the viewport was painted by this replay.
+    auto sk_input_rect = image_filter.filterBounds(SkIRect::MakeXYWH(rect.x(), rect.y(), rect.width(), rect.height()), SkMatrix::I(), SkImageFilter::kReverse_MapDirection);
+    auto input_rect = Gfx::IntRect { sk_input_rect.x(), sk_input_rect.y(), sk_input_rect.width(), sk_input_rect.height() }.intersected(cache_state.viewport_rect);
+    if (!cache_state.painted_rect.contains(input_rect))
+        return false;
+
+    // Filter a copy of the backdrop in a surface of its own, which ends at the viewport's edges just like the surface
+    // painted into. That way the filter sees exactly what it would see when applied in place.
+    auto backdrop = surface().sk_surface().makeImageSnapshot(SkIRect::MakeXYWH(input_rect.x(), input_rect.y(), input_rect.width(), input_rect.height()));
+    if (!backdrop)
+        return false;
+    auto filter_surface = Gfx::PaintingSurface::create_with_size(input_rect.size(), Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, m_skia_backend_context);
+    auto& filter_canvas = filter_surface->canvas();
+    SkPaint backdrop_paint;
+    backdrop_paint.setBlendMode(SkBlendMode::kSrc);
+    filter_canvas.drawImage(backdrop.get(), 0, 0, SkSamplingOptions {}, &backdrop_paint);
+    auto rect_in_filter_surface = rect.translated(-input_rect.location());
+    filter_canvas.save();
+    filter_canvas.clipIRect(SkIRect::MakeXYWH(rect_in_filter_surface.x(), rect_in_filter_surface.y(), rect_in_filter_surface.width(), rect_in_filter_surface.height()));
+    filter_canvas.saveLayer(SkCanvas::SaveLayerRec(nullptr, nullptr, &image_filter, 0));
+    filter_canvas.restore();
+    filter_canvas.restore();
+    auto image = filter_surface->sk_surface().makeImageSnapshot(SkIRect::MakeXYWH(rect_in_filter_surface.x(), rect_in_filter_surface.y(), rect_in_filter_surface.width(), rect_in_filter_surface.height()));
+    if (!image)
+        return false;
+
+    paint_result(*image);
+    resource_storage().set_cached_backdrop_filter_result(filter_data, to_viewport_rect(rect), to_viewport_rect(input_rect), m_skia_backend_context, move(image));
+    return true;
+}
+
 void DisplayListPlayerSkia::play_command(DrawRect const& command)
 {
     auto const& rect = command.rect;
@@ -1127,6 +1265,47 @@ void DisplayListPlayerSkia::play_command(PaintNestedDisplayList const& command)
     canvas.restore();
 }
 
+// OPTIMIZATION: Layer content is replayed with identical commands on every frame that only changes the transform or
+//               effects of its root, e.g. every frame of a compositor animation. Rasterize it once in the root's space
+//               and composite the raster with the root's current state instead.
+bool DisplayListPlayerSkia::paint_layer_content(LayerContent const& layer_content)
+{
+    auto const& bounding_rect = layer_content.bounding_rect;
+    constexpr size_t max_layer_raster_bytes = 64 * MiB;
+    constexpr int max_layer_raster_dimension = 8192;
+    if (bounding_rect.width() > max_layer_raster_dimension || bounding_rect.height() > max_layer_raster_dimension
+        || static_cast<size_t>(bounding_rect.width()) * bounding_rect.height() * 4 > max_layer_raster_bytes)
+        return false;
+
+    auto const& display_list = active_display_list();
+    bool should_rasterize = false;
+    auto image = resource_storage().cached_layer_raster(display_list.id(), layer_content.command_offset, bounding_rect, layer_content.content_state, m_skia_backend_context, should_rasterize);
+    if (!image && should_rasterize) {
+        auto offscreen_surface = Gfx::PaintingSurface::create_with_size(
+            bounding_rect.size(), Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, m_skia_backend_context);
+        offscreen_surface->canvas().clear(SK_ColorTRANSPARENT);
+        offscreen_surface->canvas().translate(-bounding_rect.x(), -bounding_rect.y());
+        execute_layer_content_into_surface(layer_content, *offscreen_surface);
+        offscreen_surface->canvas().resetMatrix();
+        image = offscreen_surface->sk_surface().makeImageSnapshot();
+        if (image)
+            resource_storage().set_cached_layer_raster(display_list.id(), layer_content.command_offset, image);
+    }
+    if (!image)
+        return false;
+
+    // The raster is pixel-identical to replaying the content as long as the root's space is translated by whole
+    // pixels from the surface's; otherwise it is resampled like any transformed image.
+    auto& canvas = surface().canvas();
+    auto total_matrix = canvas.getTotalMatrix();
+    bool is_integer_translation = total_matrix.isTranslate()
+        && total_matrix.getTranslateX() == SkScalarFloorToScalar(total_matrix.getTranslateX())
+        && total_matrix.getTranslateY() == SkScalarFloorToScalar(total_matrix.getTranslateY());
+    auto sampling = is_integer_translation ? SkSamplingOptions() : SkSamplingOptions(SkFilterMode::kLinear);
+    canvas.drawImage(image.get(), bounding_rect.x(), bounding_rect.y(), sampling);
+    return true;
+}
+
 void DisplayListPlayerSkia::play_command(CompositorScrollNode const&)
 {
 }
@@ -1190,9 +1369,19 @@ void DisplayListPlayerSkia::play_command(ApplyEffects const& command, Gfx::Filte
     if (command.has_mask_kind && command.mask_kind == Gfx::MaskKind::Luminance)
         paint.setColorFilter(SkLumaColorFilter::Make());
 
+    m_layer_save_counts.append(canvas.getSaveCount());
     canvas.saveLayer(nullptr, &paint);
 }
 
+bool DisplayListPlayerSkia::is_painting_into_layer()
+{
+    // NB: Layers are popped by plain restores, so forget the ones that the canvas has already been restored past.
+    auto save_count = surface().canvas().getSaveCount();
+    while (!m_layer_save_counts.is_empty() && m_layer_save_counts.last() >= save_count)
+        m_layer_save_counts.take_last();
+    return !m_layer_save_counts.is_empty();
+}
+
 void DisplayListPlayerSkia::set_matrix(Gfx::FloatMatrix4x4 const& matrix)
 {
     surface().canvas().setMatrix(to_skia_matrix4x4(matrix));
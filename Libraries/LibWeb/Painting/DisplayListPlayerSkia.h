@@ -15,7 +15,13 @@
 #include <LibWeb/Painting/DisplayListRecorder.h>
 
 class GrDirectContext;
+class SkImage;
+class SkImageFilter;
 class SkPaint;
+struct SkRect;
+
+template<typename T>
+class sk_sp;
 
 namespace Web::Painting {
 
@@ -35,7 +41,8 @@ public:
         ScrollStateSnapshot const&,
         RefPtr<Gfx::PaintingSurface>,
         CanvasSurfaceRegistry const*,
-        CompositedContextResolver const*);
+        CompositedContextResolver const*,
+        Optional<Gfx::IntSize> backdrop_filter_cache_viewport_size = {});
 
     void flush(Gfx::PaintingSurface&) override;
     void flush_async(Gfx::PaintingSurface&, Function<void()>&&);
@@ -53,6 +60,11 @@ private:
     void add_clip_path(Gfx::Path const&, Gfx::WindingRule) override;
 
     bool would_be_fully_clipped_by_painter(Gfx::IntRect) const override;
+    bool paint_layer_content(LayerContent const&) override;
+
+    sk_sp<SkImage> skia_image_for_image_frame(ImageFrameResourceId, Gfx::ScalingMode, SkRect const& src_rect, SkRect const& dst_rect);
+    bool paint_cached_backdrop_filter_result(ApplyBackdropFilter const&, SkImageFilter const&);
+    bool is_painting_into_layer();
 
     SkPaint paint_style_to_skia_paint(DisplayListPaintStyle const&, Gfx::FloatRect const& bounding_rect);
     Gfx::Path path_from_data(DisplayListDataSpan) const;
@@ -61,6 +73,18 @@ private:
 
     RefPtr<Gfx::SkiaBackendContext> m_skia_backend_context;
     CompositedContextResolver const* m_composited_context_resolver { nullptr };
+
+    // Backdrop filter results are only reused in a replay into a surface that is painted for a frame of the viewport,
+    // and only for backdrops inside the part of it that the replay paints anew.
+    struct BackdropFilterCacheState {
+        Gfx::PaintingSurface const* surface { nullptr };
+        // The viewport's rect on the surface, whose origin maps surface coordinates back to viewport coordinates.
+        Gfx::IntRect viewport_rect;
+        Gfx::IntRect painted_rect;
+    };
+    Optional<BackdropFilterCacheState> m_backdrop_filter_cache_state;
+    // The save counts of the canvas before each layer that commands are currently painted into.
+    Vector<int> m_layer_save_counts;
 };
 
 }
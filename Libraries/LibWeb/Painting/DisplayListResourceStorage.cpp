@@ -4,6 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
+#include <AK/Array.h>
+#include <AK/BitCast.h>
+#include <AK/HashFunctions.h>
+#include <AK/StringHash.h>
 #include <LibGfx/Filter.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/SkiaBackendContext.h>
@@ -13,20 +18,37 @@
 #include <LibWeb/Painting/DisplayListResourceStorage.h>
 
 #include <core/SkImage.h>
+#include <core/SkTextBlob.h>
 #include <gpu/ganesh/GrDirectContext.h>
 #include <gpu/ganesh/SkImageGanesh.h>
 
 namespace Web::Painting {
 
+// A frame shown much smaller than its natural size is drawn from a copy downscaled by a power of two, like a mip
+// level. Eight levels take even a 16384px wide image down to 64px.
+static constexpr size_t max_image_frame_mip_levels = 8;
+
 struct DisplayListStoredImageFrameResource {
     explicit DisplayListStoredImageFrameResource(Gfx::DecodedImageFrame frame)
         : frame(move(frame))
     {
     }
 
+    struct MipLevel {
+        explicit MipLevel(NonnullRefPtr<Gfx::Bitmap const> bitmap)
+            : bitmap(move(bitmap))
+        {
+        }
+
+        NonnullRefPtr<Gfx::Bitmap const> bitmap;
+        sk_sp<SkImage> skia_image;
+        RefPtr<Gfx::SkiaBackendContext> skia_backend_context;
+    };
+
     Gfx::DecodedImageFrame frame;
     mutable sk_sp<SkImage> skia_image;
     mutable RefPtr<Gfx::SkiaBackendContext> skia_backend_context;
+    mutable Array<OwnPtr<MipLevel>, max_image_frame_mip_levels> mip_levels;
 };
 
 struct DisplayListCachedSkiaImageResource {
@@ -75,9 +97,68 @@ struct DisplayListCachedNestedRasterResource {
     Vector<Raster> rasters;
 };
 
-static sk_sp<SkImage> create_skia_image(Gfx::DecodedImageFrame const& frame, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context)
+struct DisplayListCachedLayerRasterResource {
+    Gfx::IntRect bounding_rect;
+    Vector<float> content_state;
+    RefPtr<Gfx::SkiaBackendContext> skia_backend_context;
+    sk_sp<SkImage> image;
+    MonotonicTime last_used { MonotonicTime::now() };
+    bool was_painted { false };
+
+    size_t byte_size() const { return image ? static_cast<size_t>(bounding_rect.width()) * bounding_rect.height() * 4 : 0; }
+};
+
+struct DisplayListCachedTextBlobResource {
+    DisplayListCachedTextBlobResource(FontResourceId font_id, float scale, ByteBuffer glyphs, sk_sp<SkTextBlob> blob)
+        : font_id(font_id)
+        , scale(scale)
+        , glyphs(move(glyphs))
+        , blob(move(blob))
+    {
+    }
+
+    FontResourceId font_id;
+    float scale { 1.0f };
+    ByteBuffer glyphs;
+    sk_sp<SkTextBlob> blob;
+    MonotonicTime last_used { MonotonicTime::now() };
+};
+
+static u32 text_blob_cache_key(FontResourceId font_id, float scale, ReadonlyBytes glyphs)
+{
+    auto font_and_scale_hash = pair_int_hash(static_cast<u32>(font_id.value()), bit_cast<u32>(scale));
+    return string_hash(reinterpret_cast<char const*>(glyphs.data()), glyphs.size(), font_and_scale_hash);
+}
+
+struct DisplayListCachedBackdropFilterResultResource {
+    DisplayListCachedBackdropFilterResultResource(ByteBuffer filter_data, Gfx::IntRect rect, Gfx::IntRect input_rect, RefPtr<Gfx::SkiaBackendContext> skia_backend_context, sk_sp<SkImage> image)
+        : filter_data(move(filter_data))
+        , rect(rect)
+        , input_rect(input_rect)
+        , skia_backend_context(move(skia_backend_context))
+        , image(move(image))
+    {
+    }
+
+    ByteBuffer filter_data;
+    Gfx::IntRect rect;
+    Gfx::IntRect input_rect;
+    RefPtr<Gfx::SkiaBackendContext> skia_backend_context;
+    sk_sp<SkImage> image;
+    MonotonicTime last_used { MonotonicTime::now() };
+
+    size_t byte_size() const { return static_cast<size_t>(rect.width()) * rect.height() * 4; }
+};
+
+static u32 backdrop_filter_result_cache_key(ReadonlyBytes filter_data, Gfx::IntRect rect)
+{
+    auto rect_hash = pair_int_hash(pair_int_hash(rect.x(), rect.y()), pair_int_hash(rect.width(), rect.height()));
+    return string_hash(reinterpret_cast<char const*>(filter_data.data()), filter_data.size(), rect_hash);
+}
+
+static sk_sp<SkImage> create_skia_image(Gfx::Bitmap const& bitmap, Gfx::ColorSpace const& color_space, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context)
 {
-    auto raster_image = Gfx::sk_image_from_bitmap(frame.bitmap(), frame.color_space());
+    auto raster_image = Gfx::sk_image_from_bitmap(bitmap, color_space);
     auto* gr_context = skia_backend_context ? skia_backend_context->sk_context() : nullptr;
     if (!gr_context)
         return raster_image;
@@ -93,11 +174,47 @@ static sk_sp<SkImage> skia_image_for_stored_image_frame(DisplayListStoredImageFr
     if (resource.skia_image && resource.skia_backend_context.ptr() == skia_backend_context.ptr())
         return resource.skia_image;
 
-    resource.skia_image = create_skia_image(resource.frame, skia_backend_context);
+    resource.skia_image = create_skia_image(resource.frame.bitmap(), resource.frame.color_space(), skia_backend_context);
     resource.skia_backend_context = skia_backend_context;
     return resource.skia_image;
 }
 
+static Gfx::IntSize image_frame_mip_level_size(Gfx::IntSize size, size_t level)
+{
+    return { max(1, ceil_div(size.width(), 1 << level)), max(1, ceil_div(size.height(), 1 << level)) };
+}
+
+static sk_sp<SkImage> skia_image_for_stored_image_frame(DisplayListStoredImageFrameResource const& resource, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context, Gfx::IntSize size)
+{
+    // Pick the smallest level that still covers the requested size, so that it's only ever scaled down further.
+    size_t level = 0;
+    while (level < max_image_frame_mip_levels) {
+        auto next_level_size = image_frame_mip_level_size(resource.frame.size(), level + 1);
+        if (next_level_size == image_frame_mip_level_size(resource.frame.size(), level))
+            break;
+        if (next_level_size.width() < size.width() || next_level_size.height() < size.height())
+            break;
+        ++level;
+    }
+    if (level == 0)
+        return skia_image_for_stored_image_frame(resource, skia_backend_context);
+
+    auto& mip_level = resource.mip_levels[level - 1];
+    if (!mip_level) {
+        auto level_size = image_frame_mip_level_size(resource.frame.size(), level);
+        auto bitmap = resource.frame.bitmap().scaled(level_size.width(), level_size.height(), Gfx::ScalingMode::BilinearMipmap);
+        if (bitmap.is_error())
+            return skia_image_for_stored_image_frame(resource, skia_backend_context);
+        mip_level = make<DisplayListStoredImageFrameResource::MipLevel>(bitmap.release_value());
+    }
+
+    if (!mip_level->skia_image || mip_level->skia_backend_context.ptr() != skia_backend_context.ptr()) {
+        mip_level->skia_image = create_skia_image(*mip_level->bitmap, resource.frame.color_space(), skia_backend_context);
+        mip_level->skia_backend_context = skia_backend_context;
+    }
+    return mip_level->skia_image;
+}
+
 bool DisplayListResourceSet::is_empty() const
 {
     return fonts.is_empty()
@@ -180,11 +297,15 @@ DisplayListResourceId DisplayListResourceStorage::add_display_list(DisplayListRe
 void DisplayListResourceStorage::set_font(FontResourceId id, NonnullRefPtr<Gfx::Font const> font)
 {
     m_fonts.set(id.value(), move(font));
+    m_cached_text_blobs.remove_all_matching([&](auto, auto const& resource) { return resource->font_id == id; });
 }
 
 void DisplayListResourceStorage::set_image_frame(ImageFrameResourceId id, Gfx::DecodedImageFrame frame)
 {
     m_image_frames.set(id.value(), make<DisplayListStoredImageFrameResource>(move(frame)));
+    // NB: Animated images update their frames in place, and layer content and backdrop filters can draw them.
+    m_display_list_cached_layer_rasters.clear();
+    m_cached_backdrop_filter_results.clear();
 }
 
 Gfx::DecodedImageFrame const& DisplayListResourceStorage::image_frame(ImageFrameResourceId id) const
@@ -197,6 +318,11 @@ sk_sp<SkImage> DisplayListResourceStorage::skia_image_for_image_frame(ImageFrame
     return skia_image_for_stored_image_frame(*m_image_frames.get(id.value()).value(), skia_backend_context);
 }
 
+sk_sp<SkImage> DisplayListResourceStorage::skia_image_for_image_frame(ImageFrameResourceId id, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context, Gfx::IntSize size) const
+{
+    return skia_image_for_stored_image_frame(*m_image_frames.get(id.value()).value(), skia_backend_context, size);
+}
+
 sk_sp<SkImage> DisplayListResourceStorage::cached_skia_image_for_display_list(DisplayListResourceId id, Gfx::IntSize tile_size, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context) const
 {
     auto cached_image = m_display_list_cached_skia_images.find(id.value());
@@ -296,6 +422,163 @@ bool DisplayListResourceStorage::should_cache_nested_display_list_raster(Display
     return !nested_display_list_requires_direct_replay(id, visited_display_lists);
 }
 
+sk_sp<SkTextBlob> DisplayListResourceStorage::cached_text_blob(FontResourceId font_id, float scale, ReadonlyBytes glyphs) const
+{
+    auto cached_blob = m_cached_text_blobs.find(text_blob_cache_key(font_id, scale, glyphs));
+    if (cached_blob == m_cached_text_blobs.end())
+        return nullptr;
+
+    auto& resource = *cached_blob->value;
+    if (resource.font_id != font_id || resource.scale != scale || resource.glyphs.span() != glyphs)
+        return nullptr;
+    resource.last_used = MonotonicTime::now();
+    return resource.blob;
+}
+
+void DisplayListResourceStorage::set_cached_text_blob(FontResourceId font_id, float scale, ReadonlyBytes glyphs, sk_sp<SkTextBlob> blob) const
+{
+    VERIFY(blob);
+
+    // Blobs of text that was painted recently are kept, so a page with more text on screen than the cache holds
+    // builds the blobs of the overflow on every paint instead of thrashing the whole cache.
+    constexpr size_t max_cached_text_blobs = 32768;
+    if (m_cached_text_blobs.size() >= max_cached_text_blobs) {
+        auto now = MonotonicTime::now();
+        m_cached_text_blobs.remove_all_matching([&](auto, auto const& resource) {
+            return now - resource->last_used >= AK::Duration::from_seconds(1);
+        });
+        if (m_cached_text_blobs.size() >= max_cached_text_blobs)
+            return;
+    }
+
+    auto glyph_bytes = ByteBuffer::copy(glyphs);
+    if (glyph_bytes.is_error())
+        return;
+    m_cached_text_blobs.set(text_blob_cache_key(font_id, scale, glyphs), make<DisplayListCachedTextBlobResource>(font_id, scale, glyph_bytes.release_value(), move(blob)));
+}
+
+bool DisplayListResourceStorage::display_list_requires_direct_replay(DisplayListResourceId id) const
+{
+    HashTable<u64> visited_display_lists;
+    return nested_display_list_requires_direct_replay(id, visited_display_lists);
+}
+
+sk_sp<SkImage> DisplayListResourceStorage::cached_layer_raster(u64 display_list_id, size_t command_offset, Gfx::IntRect bounding_rect, ReadonlySpan<float> content_state, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context, bool& should_rasterize) const
+{
+    should_rasterize = false;
+    auto now = MonotonicTime::now();
+
+    // Every recording gets a new id, so the rasters of the layers of earlier recordings are dropped once they are
+    // no longer painted.
+    if (!m_display_list_cached_layer_rasters.contains(display_list_id)) {
+        m_display_list_cached_layer_rasters.remove_all_matching([&](auto, auto const& rasters) {
+            return all_of(rasters, [&](auto const& it) { return now - it.value->last_used >= AK::Duration::from_milliseconds(250); });
+        });
+    }
+
+    auto& rasters = m_display_list_cached_layer_rasters.ensure(display_list_id);
+    auto& resource = *rasters.ensure(command_offset, [] { return make<DisplayListCachedLayerRasterResource>(); });
+    auto was_painted_with_same_state = resource.was_painted
+        && resource.bounding_rect == bounding_rect
+        && resource.content_state.span() == content_state
+        && resource.skia_backend_context.ptr() == skia_backend_context.ptr();
+    resource.last_used = now;
+    resource.was_painted = true;
+    if (was_painted_with_same_state && resource.image)
+        return resource.image;
+
+    // Content that changes on every paint would waste a rasterization per paint, so only content that was painted
+    // with the same state before is rasterized.
+    should_rasterize = was_painted_with_same_state;
+    if (!was_painted_with_same_state) {
+        resource.bounding_rect = bounding_rect;
+        resource.content_state.clear_with_capacity();
+        resource.content_state.append(content_state.data(), content_state.size());
+        resource.skia_backend_context = skia_backend_context;
+        resource.image = nullptr;
+    }
+    return nullptr;
+}
+
+void DisplayListResourceStorage::set_cached_layer_raster(u64 display_list_id, size_t command_offset, sk_sp<SkImage> image) const
+{
+    VERIFY(image);
+    auto& resource = *m_display_list_cached_layer_rasters.get(display_list_id)->get(command_offset).value();
+
+    // Like nested display list rasters, rasters of layers that are still painted are never evicted for new ones.
+    constexpr size_t max_layer_raster_cache_bytes = 256 * MiB;
+    auto total_bytes = static_cast<size_t>(resource.bounding_rect.width()) * resource.bounding_rect.height() * 4;
+    for (auto const& rasters : m_display_list_cached_layer_rasters) {
+        for (auto const& it : rasters.value)
+            total_bytes += it.value->byte_size();
+    }
+    if (total_bytes > max_layer_raster_cache_bytes) {
+        auto now = MonotonicTime::now();
+        for (auto& rasters : m_display_list_cached_layer_rasters) {
+            for (auto& it : rasters.value) {
+                if (!it.value->image || now - it.value->last_used < AK::Duration::from_milliseconds(250))
+                    continue;
+                total_bytes -= it.value->byte_size();
+                it.value->image = nullptr;
+            }
+        }
+        if (total_bytes > max_layer_raster_cache_bytes)
+            return;
+    }
+
+    resource.image = move(image);
+}
+
+sk_sp<SkImage> DisplayListResourceStorage::cached_backdrop_filter_result(ReadonlyBytes filter_data, Gfx::IntRect rect, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context) const
+{
+    auto cached_result = m_cached_backdrop_filter_results.find(backdrop_filter_result_cache_key(filter_data, rect));
+    if (cached_result == m_cached_backdrop_filter_results.end())
+        return nullptr;
+
+    auto& resource = *cached_result->value;
+    if (resource.rect != rect || resource.filter_data.span() != filter_data || resource.skia_backend_context.ptr() != skia_backend_context.ptr())
+        return nullptr;
+    resource.last_used = MonotonicTime::now();
+    return resource.image;
+}
+
+void DisplayListResourceStorage::set_cached_backdrop_filter_result(ReadonlyBytes filter_data, Gfx::IntRect rect, Gfx::IntRect input_rect, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context, sk_sp<SkImage> image) const
+{
+    VERIFY(image);
+    auto key = backdrop_filter_result_cache_key(filter_data, rect);
+
+    // Like layer rasters, results that are still painted are never evicted for new ones.
+    constexpr size_t max_backdrop_filter_result_cache_bytes = 64 * MiB;
+    auto total_bytes = static_cast<size_t>(rect.width()) * rect.height() * 4;
+    for (auto const& it : m_cached_backdrop_filter_results) {
+        if (it.key != key)
+            total_bytes += it.value->byte_size();
+    }
+    if (total_bytes > max_backdrop_filter_result_cache_bytes) {
+        auto now = MonotonicTime::now();
+        m_cached_backdrop_filter_results.remove_all_matching([&](auto, auto const& resource) {
+            if (now - resource->last_used < AK::Duration::from_milliseconds(250))
+                return false;
+            total_bytes -= resource->byte_size();
+            return true;
+        });
+        if (total_bytes > max_backdrop_filter_result_cache_bytes)
+            return;
+    }
+
+    auto filter_bytes = ByteBuffer::copy(filter_data);
+    if (filter_bytes.is_error())
+        return;
+    m_cached_backdrop_filter_results.set(key, make<DisplayListCachedBackdropFilterResultResource>(filter_bytes.release_value(), rect, input_rect, skia_backend_context, move(image)));
+}
+
+void DisplayListResourceStorage::invalidate_cached_backdrop_filter_results(Gfx::IntRect damage_rect)
+{
+    m_cached_backdrop_filter_results.remove_all_matching([&](auto, auto const& resource) {
+        return resource->input_rect.intersects(damage_rect);
+    });
+}
+
 // Determines whether reusing a rasterization of the display list can produce different pixels than replaying it
 // in place on every frame. That is the case when a destination-reading operation (a non-normal blend mode or a
 // backdrop filter) can see canvas content painted before the display list began, or when the list draws live
@@ -506,6 +789,11 @@ void DisplayListResourceStorage::apply_transaction(DisplayListResourceTransactio
 
     for (auto id : transaction.font_ids_to_remove)
         m_fonts.remove(id.value());
+    if (!transaction.font_ids_to_remove.is_empty()) {
+        m_cached_text_blobs.remove_all_matching([&](auto, auto const& resource) {
+            return transaction.font_ids_to_remove.contains_slow(resource->font_id);
+        });
+    }
     for (auto id : transaction.image_frame_ids_to_remove)
         m_image_frames.remove(id.value());
     for (auto id : transaction.video_frame_ids_to_remove)
@@ -518,11 +806,22 @@ void DisplayListResourceStorage::apply_transaction(DisplayListResourceTransactio
         m_display_list_cached_nested_rasters.remove(id.value());
 }
 
+size_t DisplayListResourceStorage::display_list_command_byte_size() const
+{
+    size_t byte_size = 0;
+    for (auto const& it : m_display_lists)
+        byte_size += it.value.display_list->command_byte_size();
+    return byte_size;
+}
+
 void DisplayListResourceStorage::retain_only(DisplayListResourceSet const& resource_set)
 {
     m_fonts.remove_all_matching([&](auto id, auto const&) {
         return !resource_set.fonts.contains(FontResourceId { id });
     });
+    m_cached_text_blobs.remove_all_matching([&](auto, auto const& resource) {
+        return !resource_set.fonts.contains(resource->font_id);
+    });
     m_image_frames.remove_all_matching([&](auto id, auto const&) {
         return !resource_set.image_frames.contains(ImageFrameResourceId { id });
     });
@@ -25,6 +25,7 @@
 #include <LibWeb/Painting/DisplayListResourceIds.h>
 
 class SkImage;
+class SkTextBlob;
 
 template<typename T>
 class sk_sp;
@@ -59,6 +60,9 @@ struct DisplayListVideoFrameResource {
 struct DisplayListStoredImageFrameResource;
 struct DisplayListCachedSkiaImageResource;
 struct DisplayListCachedNestedRasterResource;
+struct DisplayListCachedLayerRasterResource;
+struct DisplayListCachedTextBlobResource;
+struct DisplayListCachedBackdropFilterResultResource;
 
 struct DisplayListResource {
     DisplayListResource(NonnullRefPtr<DisplayList>, AccumulatedVisualContextTree);
@@ -109,15 +113,32 @@ public:
     Gfx::Font const& font(FontResourceId id) const { return *m_fonts.get(id.value()).value(); }
     Gfx::DecodedImageFrame const& image_frame(ImageFrameResourceId) const;
     sk_sp<SkImage> skia_image_for_image_frame(ImageFrameResourceId, RefPtr<Gfx::SkiaBackendContext> const&) const;
+    // Returns the frame downscaled by the largest power of two that keeps it at least `size` in device pixels.
+    sk_sp<SkImage> skia_image_for_image_frame(ImageFrameResourceId, RefPtr<Gfx::SkiaBackendContext> const&, Gfx::IntSize size) const;
     sk_sp<SkImage> cached_skia_image_for_display_list(DisplayListResourceId, Gfx::IntSize, RefPtr<Gfx::SkiaBackendContext> const&) const;
     void set_cached_skia_image_for_display_list(DisplayListResourceId, Gfx::IntSize, RefPtr<Gfx::SkiaBackendContext> const&, sk_sp<SkImage>) const;
     sk_sp<SkImage> cached_nested_display_list_raster(DisplayListResourceId, RefPtr<Gfx::SkiaBackendContext> const&, Gfx::IntRect visible_rect_in_list_space, Gfx::IntRect& raster_rect_in_list_space) const;
     void add_cached_nested_display_list_raster(DisplayListResourceId, RefPtr<Gfx::SkiaBackendContext> const&, Gfx::IntRect rect_in_list_space, sk_sp<SkImage>) const;
     bool should_cache_nested_display_list_raster(DisplayListResourceId) const;
+    bool display_list_requires_direct_replay(DisplayListResourceId) const;
+    // Text blobs of glyph runs, keyed by their font, scale and glyphs, which stay the same across recordings.
+    sk_sp<SkTextBlob> cached_text_blob(FontResourceId, float scale, ReadonlyBytes glyphs) const;
+    void set_cached_text_blob(FontResourceId, float scale, ReadonlyBytes glyphs, sk_sp<SkTextBlob>) const;
+    // Rasters of layer content (see DisplayListPlayer::LayerContent), keyed by the display list and the offset of the
+    // content's first command. A raster is only returned for the bounds and content state it was made with, and
+    // should_rasterize is set once the content is painted for the second time in a row with the same state.
+    sk_sp<SkImage> cached_layer_raster(u64 display_list_id, size_t command_offset, Gfx::IntRect bounding_rect, ReadonlySpan<float> content_state, RefPtr<Gfx::SkiaBackendContext> const&, bool& should_rasterize) const;
+    void set_cached_layer_raster(u64 display_list_id, size_t command_offset, sk_sp<SkImage>) const;
+    // Results of backdrop filters painted over a rect of the viewport, keyed by the serialized filter and the rect. A
+    // result stays valid until damage to the backdrop it was computed from is reported.
+    sk_sp<SkImage> cached_backdrop_filter_result(ReadonlyBytes filter_data, Gfx::IntRect rect, RefPtr<Gfx::SkiaBackendContext> const&) const;
+    void set_cached_backdrop_filter_result(ReadonlyBytes filter_data, Gfx::IntRect rect, Gfx::IntRect input_rect, RefPtr<Gfx::SkiaBackendContext> const&, sk_sp<SkImage>) const;
+    void invalidate_cached_backdrop_filter_results(Gfx::IntRect damage_rect);
     RefPtr<Media::VideoFrame const> video_frame(VideoFrameResourceId id) const { return m_video_frames.get(id.value()).value(); }
     DisplayListResource const& display_list_resource(DisplayListResourceId id) const { return m_display_lists.get(id.value()).value(); }
     DisplayList const& display_list(DisplayListResourceId id) const { return *display_list_resource(id).display_list; }
     AccumulatedVisualContextTree const& display_list_visual_context_tree(DisplayListResourceId id) const { return display_list_resource(id).visual_context_tree; }
+    size_t display_list_command_byte_size() const;
 
 private:
     void collect_referenced_resources(ReadonlyBytes command_bytes, DisplayListResourceSet&) const;
@@ -131,6 +152,9 @@ private:
     HashMap<u64, DisplayListResource> m_display_lists;
     mutable HashMap<u64, NonnullOwnPtr<DisplayListCachedSkiaImageResource>> m_display_list_cached_skia_images;
     mutable HashMap<u64, NonnullOwnPtr<DisplayListCachedNestedRasterResource>> m_display_list_cached_nested_rasters;
+    mutable HashMap<u64, HashMap<size_t, NonnullOwnPtr<DisplayListCachedLayerRasterResource>>> m_display_list_cached_layer_rasters;
+    mutable HashMap<u32, NonnullOwnPtr<DisplayListCachedTextBlobResource>> m_cached_text_blobs;
+    mutable HashMap<u32, NonnullOwnPtr<DisplayListCachedBackdropFilterResultResource>> m_cached_backdrop_filter_results;
 };
 
 }
@@ -538,7 +538,11 @@ static void invalidate_descendant_styles_for_container_query_size_change(Paintab
 
     if (auto* element = as_if<DOM::Element>(paintable_box.dom_node().ptr())) {
         element->for_each_shadow_including_descendant([](DOM::Node& node) {
-            if (auto* descendant_element = as_if<DOM::Element>(node); descendant_element && descendant_element->style_depends_on_size_container_query())
+            // OPTIMIZATION: Only restyle descendants for which the resize actually flipped a container query, or
+            //               which use container-relative lengths.
+            if (auto* descendant_element = as_if<DOM::Element>(node); descendant_element
+                && descendant_element->style_depends_on_size_container_query()
+                && descendant_element->size_container_query_results_changed())
                 descendant_element->set_needs_style_update(true);
             return TraversalDecision::Continue;
         });
@@ -280,6 +280,12 @@ public:
     [[nodiscard]] bool has_non_invertible_css_transform() const { return m_has_non_invertible_css_transform; }
     void set_has_non_invertible_css_transform(bool value) { m_has_non_invertible_css_transform = value; }
 
+    // https://drafts.csswg.org/css-contain-2/#skips-its-contents
+    // Set while a content-visibility: auto element is not relevant to the user. Its box is still laid out and painted,
+    // but its contents are neither painted nor hit tested.
+    [[nodiscard]] bool skips_its_contents() const { return m_skips_its_contents; }
+    void set_skips_its_contents(bool value) { m_skips_its_contents = value; }
+
     [[nodiscard]] bool overflow_property_applies() const;
 
     [[nodiscard]] Optional<CSSPixelRect> scrollable_overflow_rect() const
@@ -540,6 +546,7 @@ private:
     RefPtr<Scrollbar> m_vertical_scrollbar;
     RefPtr<ResizeHandle> m_resize_handle;
     bool m_has_non_invertible_css_transform { false };
+    bool m_skips_its_contents { false };
 
     OwnPtr<StickyInsets> m_sticky_insets;
 
@@ -27,6 +27,18 @@ void SVGPathPaintable::reset_for_relayout()
 {
     SVGGraphicsPaintable::reset_for_relayout();
     m_computed_path.clear();
+    m_device_pixel_path.clear();
+}
+
+Gfx::Path const& SVGPathPaintable::device_pixel_path(Gfx::AffineTransform const& paint_transform, Gfx::FloatPoint offset) const
+{
+    if (m_device_pixel_path.has_value() && m_device_pixel_path->paint_transform == paint_transform && m_device_pixel_path->offset == offset)
+        return m_device_pixel_path->path;
+
+    auto path = computed_path()->copy_transformed(paint_transform);
+    path.offset(offset);
+    m_device_pixel_path = DevicePixelPath { paint_transform, offset, move(path) };
+    return m_device_pixel_path->path;
 }
 
 Optional<CSSPixelRect> SVGPathPaintable::clip_path_geometry_bounds(Gfx::AffineTransform const& additional_transform) const
@@ -82,8 +94,7 @@ void SVGPathPaintable::paint(DisplayListRecordingContext& context, PaintPhase ph
     auto maybe_view_box = svg_node->dom_node().view_box();
 
     auto paint_transform = computed_transforms().svg_to_device_pixels_transform(context);
-    auto path = computed_path()->copy_transformed(paint_transform);
-    path.offset(offset);
+    auto const& path = device_pixel_path(paint_transform, offset);
 
     auto svg_viewport = [&] {
         if (maybe_view_box.has_value())
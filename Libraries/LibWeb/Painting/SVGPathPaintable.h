@@ -28,6 +28,7 @@ public:
     void set_computed_path(Gfx::Path path)
     {
         m_computed_path = move(path);
+        m_device_pixel_path.clear();
     }
 
     Optional<Gfx::Path> const& computed_path() const { return m_computed_path; }
@@ -41,6 +42,16 @@ protected:
 
 private:
     virtual bool is_svg_path_paintable() const final { return true; }
+
+    Gfx::Path const& device_pixel_path(Gfx::AffineTransform const& paint_transform, Gfx::FloatPoint offset) const;
+
+    // OPTIMIZATION: Repaints that don't move or scale the path reuse its transformed copy.
+    struct DevicePixelPath {
+        Gfx::AffineTransform paint_transform;
+        Gfx::FloatPoint offset;
+        Gfx::Path path;
+    };
+    mutable Optional<DevicePixelPath> m_device_pixel_path;
 };
 
 template<>
@@ -372,6 +372,18 @@ void StackingContext::paint_internal(DisplayListRecordingContext& context) const
         return;
     }
 
+    // https://drafts.csswg.org/css-contain-2/#skips-its-contents
+    // The element's contents are not painted, but the element itself still is. As the element has paint containment,
+    // all of its contents, including positioned and stacking context descendants, are painted from here.
+    if (paintable_box().skips_its_contents()) {
+        paint_node(paintable_box(), context, PaintPhase::Background);
+        paint_node(paintable_box(), context, PaintPhase::Border);
+        paint_node(paintable_box(), context, PaintPhase::Outline);
+        if (context.should_paint_overlay())
+            paint_node(paintable_box(), context, PaintPhase::Overlay);
+        return;
+    }
+
     // For a more elaborate description of the algorithm, see CSS 2.1 Appendix E
     // Draw the background and borders for the context root (steps 1, 2)
     paint_node(paintable_box(), context, PaintPhase::Background);
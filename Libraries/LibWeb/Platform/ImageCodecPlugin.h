@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibCore/Promise.h>
@@ -39,7 +41,16 @@ public:
 
     virtual ~ImageCodecPlugin();
 
-    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+    // If a cache partition is given, the decoded pixels may be shared with other processes that decode the same data
+    // for the same partition, and must not be written to. Pages pass their top-level site, see
+    // Fetch::Infrastructure::NetworkPartitionKey::serialized_top_level_site().
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, Optional<ByteString> cache_partition) = 0;
+
+    // Decodes an image while its data is still arriving, calling on_partial_image with what has been decoded so far.
+    // Once all of the data has arrived, it's decoded with decode_image() as usual, and the incremental decode is ended.
+    virtual Optional<i64> start_incremental_decode(ESCAPING Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image) = 0;
+    virtual void append_incremental_decode_data(i64 decode_id, ReadonlyBytes) = 0;
+    virtual void end_incremental_decode(i64 decode_id) = 0;
 
     virtual void request_animation_frames(i64 session_id, u32 start_frame_index, u32 count) = 0;
     virtual void stop_animation_decode(i64 session_id) = 0;
@@ -6,7 +6,9 @@
 
 #include <LibGC/Heap.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/Paintable.h>
 #include <LibWeb/ResizeObserver/ResizeObservation.h>
 
@@ -41,15 +43,23 @@ bool ResizeObservation::is_active()
     if (!m_target)
         return false;
 
+    // OPTIMIZATION: Skip measuring the target if nothing moved since it was last found inactive.
+    auto rendering_geometry_generation = m_target->document().page().rendering_geometry_generation();
+    if (m_rendering_geometry_generation_when_inactive == rendering_geometry_generation)
+        return false;
+
     // 1. Set currentSize by calculate box size given target and observedBox.
     auto current_size = ResizeObserverSize::compute_box_size(*m_target, m_observed_box);
 
     // 2. Return true if currentSize is not equal to the first entry in this.lastReportedSizes.
     VERIFY(!m_last_reported_sizes.is_empty());
-    if (!m_last_reported_sizes.first()->equals(current_size))
+    if (!m_last_reported_sizes.first()->equals(current_size)) {
+        m_rendering_geometry_generation_when_inactive.clear();
         return true;
+    }
 
     // 3. Return false.
+    m_rendering_geometry_generation_when_inactive = rendering_geometry_generation;
     return false;
 }
 
@@ -25,7 +25,11 @@ public:
     GC::Ptr<DOM::Element> target() const { return m_target.ptr(); }
     Bindings::ResizeObserverBoxOptions observed_box() const { return m_observed_box; }
 
-    Vector<GC::Ref<ResizeObserverSize>>& last_reported_sizes() { return m_last_reported_sizes; }
+    Vector<GC::Ref<ResizeObserverSize>>& last_reported_sizes()
+    {
+        m_rendering_geometry_generation_when_inactive.clear();
+        return m_last_reported_sizes;
+    }
 
     explicit ResizeObservation(JS::Realm& realm, DOM::Element& target, Bindings::ResizeObserverBoxOptions observed_box);
 
@@ -36,6 +40,10 @@ private:
     GC::Weak<DOM::Element> m_target;
     Bindings::ResizeObserverBoxOptions m_observed_box;
     Vector<GC::Ref<ResizeObserverSize>> m_last_reported_sizes;
+
+    // NB: The box size can only change along with the geometry of the page, so an observation that was found inactive
+    //     stays inactive until then.
+    Optional<u64> m_rendering_geometry_generation_when_inactive;
 };
 
 }
@@ -57,6 +57,7 @@ private:
 
     virtual RefPtr<Layout::Node> create_layout_node(NonnullRefPtr<CSS::ComputedValues const>) override;
     virtual void decoded_image_data_did_update() override { set_needs_repaint(); }
+    virtual bool exposes_pixels_to_script() const override { return true; }
 
     Optional<NumberPercentage> m_x;
     Optional<NumberPercentage> m_y;
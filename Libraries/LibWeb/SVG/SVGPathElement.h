@@ -28,6 +28,9 @@ private:
     virtual void initialize(JS::Realm&) override;
 
     Path m_path {};
+
+    // OPTIMIZATION: The path only depends on the d attribute, so it is built once rather than on every layout.
+    Optional<Gfx::Path> m_gfx_path;
 };
 
 }
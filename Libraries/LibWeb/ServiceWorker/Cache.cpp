@@ -821,15 +821,11 @@ WebIDL::ExceptionOr<bool> Cache::batch_cache_operations(GC::Ref<GC::HeapVector<G
     auto cache = m_request_response_list;
 
     // 2. Let backupCache be a new request response list that is a copy of cache.
+    // OPTIMIZATION: The substeps below only add items to cache and remove items from it, they never modify the items
+    //               themselves. So rather than cloning every request and response in the cache, including teeing their
+    //               bodies, only the list of items is copied.
     auto backup_cache = realm.heap().allocate<RequestResponseList>();
-
-    for (auto request_response : cache->elements()) {
-        auto backup_request = request_response->request->clone(realm);
-        auto backup_response = request_response->response->clone(realm);
-
-        auto backup_request_response = realm.heap().allocate<RequestResponse>(backup_request, backup_response);
-        backup_cache->elements().append(backup_request_response);
-    }
+    backup_cache->elements() = cache->elements();
 
     // 3. Let addedItems be an empty list.
     auto added_items = realm.heap().allocate<RequestResponseList>();
@@ -922,7 +918,8 @@ WebIDL::ExceptionOr<bool> Cache::batch_cache_operations(GC::Ref<GC::HeapVector<G
         // 1. Remove all the items from the relevant request response list.
         // 2. For each requestResponse of backupCache:
         //     1. Append requestResponse to the relevant request response list.
-        m_request_response_list = backup_cache;
+        // NB: The list is restored in place, as it's shared with the name to cache map and other Cache objects.
+        cache->elements() = move(backup_cache->elements());
 
         // 3. Throw the exception.
         return result.release_error();
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NonnullOwnPtr.h>
+#include <LibWeb/Page/Page.h>
+#include <LibWeb/StorageAPI/LocalStorageArea.h>
+
+namespace Web::StorageAPI {
+
+using LocalStorageAreaMap = HashMap<String, NonnullOwnPtr<LocalStorageArea>>;
+
+static Array<LocalStorageAreaMap, to_underlying(StorageEndpointType::Count)>& local_storage_areas()
+{
+    static Array<LocalStorageAreaMap, to_underlying(StorageEndpointType::Count)> areas;
+    return areas;
+}
+
+static size_t storage_quota_size(Utf16View string)
+{
+    auto utf8_string = MUST(string.to_utf8());
+    return utf8_string.bytes().size();
+}
+
+LocalStorageArea* LocalStorageArea::ensure(Page& page, StorageEndpointType endpoint_type, String const& storage_key)
+{
+    auto& areas = local_storage_areas()[to_underlying(endpoint_type)];
+    if (auto it = areas.find(storage_key); it != areas.end())
+        return it->value.ptr();
+
+    auto snapshot = page.client().page_did_request_storage_area(endpoint_type, storage_key);
+    if (!snapshot.has_value())
+        return nullptr;
+
+    auto area = adopt_own(*new LocalStorageArea(endpoint_type, storage_key, snapshot.release_value()));
+    auto* area_ptr = area.ptr();
+    areas.set(storage_key, move(area));
+    return area_ptr;
+}
+
+void LocalStorageArea::did_change_item(StorageEndpointType endpoint_type, String const& storage_key, Optional<Utf16String> const& key, Optional<Utf16String> const& value, u64 version, bool is_own_change)
+{
+    // NB: Nothing in this process has used the storage area since it was last loaded, so it'll be up to date whenever
+    //     something does.
+    auto area = local_storage_areas()[to_underlying(endpoint_type)].get(storage_key);
+    if (!area.has_value())
+        return;
+
+    // The change was already included when the storage area was loaded.
+    if (version <= (*area)->m_version)
+        return;
+
+    (*area)->m_version = version;
+    (*area)->apply_change(key, value, is_own_change);
+}
+
+void LocalStorageArea::invalidate_all()
+{
+    for (auto& areas : local_storage_areas())
+        areas.clear();
+}
+
+LocalStorageArea::LocalStorageArea(StorageEndpointType endpoint_type, String storage_key, LocalStorageAreaSnapshot snapshot)
+    : m_endpoint_type(endpoint_type)
+    , m_storage_key(move(storage_key))
+    , m_version(snapshot.version)
+{
+    VERIFY(snapshot.keys.size() == snapshot.values.size());
+
+    m_items.ensure_capacity(snapshot.keys.size());
+    for (size_t i = 0; i < snapshot.keys.size(); ++i)
+        set_item(move(snapshot.keys[i]), move(snapshot.values[i]));
+}
+
+Optional<Utf16String> LocalStorageArea::get(Utf16View key) const
+{
+    if (auto item = m_items.get(key); item.has_value())
+        return item->value;
+    return OptionalNone {};
+}
+
+WebView::StorageSetResult LocalStorageArea::set(Page& page, Utf16View key, Utf16View value, Optional<u64> quota)
+{
+    auto old_value = get(key);
+
+    // NB: The browser process checks the quota again, but failing here lets the caller throw right away.
+    if (quota.has_value()) {
+        size_t old_size = 0;
+        if (auto item = m_items.get(key); item.has_value())
+            old_size = item->quota_size;
+
+        auto new_size = storage_quota_size(key) + storage_quota_size(value);
+        if (m_quota_size - old_size + new_size > quota.value())
+            return WebView::StorageOperationError::QuotaExceededError;
+    }
+
+    auto key_string = Utf16String::from_utf16(key);
+    auto value_string = Utf16String::from_utf16(value);
+
+    ++m_pending_write_counts.ensure(key_string);
+    page.client().page_did_set_storage_item(m_endpoint_type, m_storage_key, key_string, value_string);
+
+    set_item(move(key_string), move(value_string));
+    return old_value;
+}
+
+void LocalStorageArea::remove(Page& page, Utf16View key)
+{
+    auto key_string = Utf16String::from_utf16(key);
+
+    ++m_pending_write_counts.ensure(key_string);
+    page.client().page_did_remove_storage_item(m_endpoint_type, m_storage_key, key_string);
+
+    remove_item(key);
+}
+
+void LocalStorageArea::clear(Page& page)
+{
+    ++m_pending_clear_count;
+    page.client().page_did_clear_storage(m_endpoint_type, m_storage_key);
+
+    m_items.clear();
+    m_quota_size = 0;
+}
+
+void LocalStorageArea::apply_change(Optional<Utf16String> const& key, Optional<Utf16String> const& value, bool is_own_change)
+{
+    if (is_own_change) {
+        if (!key.has_value()) {
+            VERIFY(m_pending_clear_count > 0);
+            --m_pending_clear_count;
+            return;
+        }
+
+        auto it = m_pending_write_counts.find(*key);
+        VERIFY(it != m_pending_write_counts.end());
+        if (--it->value != 0)
+            return;
+        m_pending_write_counts.remove(it);
+
+        // Writes that were followed by a clear of our own don't matter anymore.
+        if (m_pending_clear_count != 0)
+            return;
+
+        // NB: This is usually the value we stored ourselves, unless another process changed the item in the meantime or
+        //     the browser process found the storage key to be over its quota.
+        if (value.has_value())
+            set_item(*key, *value);
+        else
+            remove_item(*key);
+        return;
+    }
+
+    // Our own clear was made after this change, so its effect is gone already.
+    if (m_pending_clear_count != 0)
+        return;
+
+    if (!key.has_value()) {
+        m_items.remove_all_matching([&](auto const& item_key, auto const&) {
+            return !m_pending_write_counts.contains(item_key);
+        });
+        m_quota_size = 0;
+        for (auto const& [item_key, item] : m_items)
+            m_quota_size += item.quota_size;
+        return;
+    }
+
+    if (m_pending_write_counts.contains(*key))
+        return;
+
+    if (value.has_value())
+        set_item(*key, *value);
+    else
+        remove_item(*key);
+}
+
+void LocalStorageArea::set_item(Utf16String key, Utf16String value)
+{
+    auto quota_size = storage_quota_size(key) + storage_quota_size(value);
+    m_quota_size += quota_size;
+
+    // NB: Items keep their position when their value changes.
+    if (auto it = m_items.find(key); it != m_items.end()) {
+        m_quota_size -= it->value.quota_size;
+        it->value = { move(value), quota_size };
+        return;
+    }
+    m_items.set(move(key), { move(value), quota_size });
+}
+
+void LocalStorageArea::remove_item(Utf16View key)
+{
+    if (auto it = m_items.find(key); it != m_items.end()) {
+        m_quota_size -= it->value.quota_size;
+        m_items.remove(it);
+    }
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/String.h>
+#include <AK/Utf16String.h>
+#include <AK/Utf16View.h>
+#include <AK/Vector.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/StorageAPI/StorageEndpoint.h>
+#include <LibWebView/StorageSetResult.h>
+
+namespace Web::StorageAPI {
+
+// The items of a storage area as the browser process had them after the change with the given version.
+struct LocalStorageAreaSnapshot {
+    Vector<Utf16String> keys;
+    Vector<Utf16String> values;
+    u64 version { 0 };
+};
+
+// A copy of the local storage the browser process keeps for one storage key, shared by every document in this process
+// that uses it. Reads are served from the copy. Writes are applied to it right away and posted to the browser process
+// without waiting for a reply, which then tells every process that has a copy about them.
+class WEB_API LocalStorageArea {
+    AK_MAKE_NONCOPYABLE(LocalStorageArea);
+    AK_MAKE_NONMOVABLE(LocalStorageArea);
+
+public:
+    // Returns null if the page has no browser process to load the storage area from.
+    static LocalStorageArea* ensure(Page&, StorageEndpointType, String const& storage_key);
+
+    // The browser process changed an item, or cleared the storage area if the key is missing. It increments the version
+    // on each change, so that changes that were made before a copy was loaded are recognized.
+    static void did_change_item(StorageEndpointType, String const& storage_key, Optional<Utf16String> const& key, Optional<Utf16String> const& value, u64 version, bool is_own_change);
+
+    // The browser process made changes that it didn't tell us about, so every copy has to be loaded again.
+    static void invalidate_all();
+
+    size_t size() const { return m_items.size(); }
+    Vector<Utf16String> keys() const { return m_items.keys(); }
+    Optional<Utf16String> get(Utf16View) const;
+
+    WebView::StorageSetResult set(Page&, Utf16View key, Utf16View value, Optional<u64> quota);
+    void remove(Page&, Utf16View key);
+    void clear(Page&);
+
+private:
+    LocalStorageArea(StorageEndpointType, String storage_key, LocalStorageAreaSnapshot);
+
+    void apply_change(Optional<Utf16String> const& key, Optional<Utf16String> const& value, bool is_own_change);
+    void set_item(Utf16String key, Utf16String value);
+    void remove_item(Utf16View key);
+
+    struct Item {
+        Utf16String value;
+        // Bytes this item contributes toward the storage key's quota: Its key plus its value.
+        size_t quota_size { 0 };
+    };
+
+    StorageEndpointType m_endpoint_type;
+    String m_storage_key;
+
+    OrderedHashMap<Utf16String, Item> m_items;
+    size_t m_quota_size { 0 };
+    u64 m_version { 0 };
+
+    // Our own writes that the browser process hasn't reported back yet. Other processes' changes to these items were
+    // made before ours, so they're ignored, and the browser process's value is adopted once the last write comes back.
+    HashMap<Utf16String, size_t> m_pending_write_counts;
+    size_t m_pending_clear_count { 0 };
+};
+
+}
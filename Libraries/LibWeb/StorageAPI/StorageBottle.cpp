@@ -9,6 +9,7 @@
 #include <LibWeb/HTML/LocalTraversableNavigable.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Window.h>
+#include <LibWeb/StorageAPI/LocalStorageArea.h>
 #include <LibWeb/StorageAPI/StorageBottle.h>
 #include <LibWeb/StorageAPI/StorageEndpoint.h>
 #include <LibWeb/StorageAPI/StorageShed.h>
@@ -111,34 +112,51 @@ void LocalStorageBottle::visit_edges(GC::Cell::Visitor& visitor)
     visitor.visit(m_page);
 }
 
+// NB: The storage area is looked up on every use rather than kept around, as it's dropped whenever the browser process
+//     made changes that have to be loaded again.
+LocalStorageArea* LocalStorageBottle::area() const
+{
+    return LocalStorageArea::ensure(m_page, m_endpoint_type, m_storage_key);
+}
+
 size_t LocalStorageBottle::size() const
 {
-    return m_page->client().page_did_request_storage_keys(m_endpoint_type, m_storage_key.to_string()).size();
+    if (auto* area = this->area())
+        return area->size();
+    return 0;
 }
 
 Vector<Utf16String> LocalStorageBottle::keys() const
 {
-    return m_page->client().page_did_request_storage_keys(m_endpoint_type, m_storage_key.to_string());
+    if (auto* area = this->area())
+        return area->keys();
+    return {};
 }
 
 Optional<Utf16String> LocalStorageBottle::get(Utf16View key) const
 {
-    return m_page->client().page_did_request_storage_item(m_endpoint_type, m_storage_key.to_string(), Utf16String::from_utf16(key));
+    if (auto* area = this->area())
+        return area->get(key);
+    return {};
 }
 
 StorageSetResult LocalStorageBottle::set(Utf16View key, Utf16View value)
 {
-    return m_page->client().page_did_set_storage_item(m_endpoint_type, m_storage_key.to_string(), Utf16String::from_utf16(key), Utf16String::from_utf16(value));
+    if (auto* area = this->area())
+        return area->set(m_page, key, value, m_quota);
+    return WebView::StorageOperationError::QuotaExceededError;
 }
 
 void LocalStorageBottle::clear()
 {
-    m_page->client().page_did_clear_storage(m_endpoint_type, m_storage_key.to_string());
+    if (auto* area = this->area())
+        area->clear(m_page);
 }
 
 void LocalStorageBottle::remove(Utf16View key)
 {
-    m_page->client().page_did_remove_storage_item(m_endpoint_type, m_storage_key.to_string(), Utf16String::from_utf16(key));
+    if (auto* area = this->area())
+        area->remove(m_page, key);
 }
 
 size_t SessionStorageBottle::size() const
@@ -77,13 +77,15 @@ private:
         : StorageBottle(quota)
         , m_page(move(page))
         , m_endpoint_type(endpoint_type)
-        , m_storage_key(move(key))
+        , m_storage_key(key.to_string())
     {
     }
 
+    LocalStorageArea* area() const;
+
     GC::Ref<Page> m_page;
     StorageEndpointType m_endpoint_type;
-    StorageKey m_storage_key;
+    String m_storage_key;
 };
 
 class SessionStorageBottle final : public StorageBottle {
@@ -87,6 +87,29 @@ ReadableStreamPipeTo::ReadableStreamPipeTo(
         check_for_error_and_close_states();
         return JS::js_undefined();
     }))
+    , m_read_request(heap().allocate<ReadableStreamPipeToReadRequest>(
+          GC::create_function(heap(), [this](JS::Value chunk) {
+              m_unwritten_chunks.append(chunk);
+
+              if (check_for_error_and_close_states())
+                  return;
+
+              HTML::queue_a_microtask(nullptr, m_write_chunk_and_continue);
+          }),
+          GC::create_function(heap(), [this]() {
+              if (!check_for_error_and_close_states())
+                  finish();
+          }),
+          m_on_shutdown))
+    , m_write_chunk_and_continue(GC::create_function(heap(), [this]() {
+        HTML::TemporaryExecutionContext execution_context { m_realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+        write_chunk();
+        process();
+    }))
+    , m_on_ready(GC::create_function(heap(), [this](JS::Value) -> WebIDL::ExceptionOr<JS::Value> {
+        read_chunk();
+        return JS::js_undefined();
+    }))
     , m_prevent_close(prevent_close)
     , m_prevent_abort(prevent_abort)
     , m_prevent_cancel(prevent_cancel)
@@ -112,6 +135,9 @@ void ReadableStreamPipeTo::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_last_write_promise);
     visitor.visit(m_unwritten_chunks);
     visitor.visit(m_on_shutdown);
+    visitor.visit(m_read_request);
+    visitor.visit(m_write_chunk_and_continue);
+    visitor.visit(m_on_ready);
 }
 
 void ReadableStreamPipeTo::process()
@@ -126,13 +152,8 @@ void ReadableStreamPipeTo::process()
         return;
     }
 
-    auto when_ready = GC::create_function(m_realm->heap(), [this](JS::Value) -> WebIDL::ExceptionOr<JS::Value> {
-        read_chunk();
-        return JS::js_undefined();
-    });
-
     if (ready_promise)
-        WebIDL::react_to_promise(*ready_promise, when_ready, m_on_shutdown);
+        WebIDL::react_to_promise(*ready_promise, m_on_ready, m_on_shutdown);
 }
 
 void ReadableStreamPipeTo::set_abort_signal(GC::Ref<DOM::AbortSignal> signal, DOM::AbortSignal::AbortSignal::AbortAlgorithmID signal_id)
@@ -220,26 +241,7 @@ void ReadableStreamPipeTo::read_chunk()
     if (check_for_error_and_close_states())
         return;
 
-    auto on_chunk = GC::create_function(heap(), [this](JS::Value chunk) {
-        m_unwritten_chunks.append(chunk);
-
-        if (check_for_error_and_close_states())
-            return;
-
-        HTML::queue_a_microtask(nullptr, GC::create_function(m_realm->heap(), [this]() {
-            HTML::TemporaryExecutionContext execution_context { m_realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
-            write_chunk();
-            process();
-        }));
-    });
-
-    auto on_complete = GC::create_function(heap(), [this]() {
-        if (!check_for_error_and_close_states())
-            finish();
-    });
-
-    auto read_request = heap().allocate<ReadableStreamPipeToReadRequest>(on_chunk, on_complete, *m_on_shutdown);
-    readable_stream_default_reader_read(m_reader, read_request);
+    readable_stream_default_reader_read(m_reader, m_read_request);
 }
 
 void ReadableStreamPipeTo::write_chunk()
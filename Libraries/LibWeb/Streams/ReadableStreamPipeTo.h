@@ -15,6 +15,8 @@
 
 namespace Web::Streams::Detail {
 
+class ReadableStreamPipeToReadRequest;
+
 // https://streams.spec.whatwg.org/#ref-for-in-parallel
 class ReadableStreamPipeTo final : public JS::Cell {
     GC_CELL(ReadableStreamPipeTo, JS::Cell);
@@ -73,6 +75,12 @@ private:
 
     GC::Ref<WebIDL::ReactionSteps> m_on_shutdown;
 
+    // NB: Only one chunk is read at a time, so the steps that move a chunk along are created once and reused for every
+    //     chunk, rather than being allocated for every read.
+    GC::Ref<ReadableStreamPipeToReadRequest> m_read_request;
+    GC::Ref<GC::Function<void()>> m_write_chunk_and_continue;
+    GC::Ref<WebIDL::ReactionSteps> m_on_ready;
+
     bool m_prevent_close { false };
     bool m_prevent_abort { false };
     bool m_prevent_cancel { false };
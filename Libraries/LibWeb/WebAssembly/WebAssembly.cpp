@@ -14,6 +14,7 @@
 #include <LibCore/EventLoop.h>
 #include <LibCrypto/Hash/SHA2.h>
 #include <LibHTTP/Cache/Utilities.h>
+#include <LibJS/Runtime/Agent.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -31,6 +32,7 @@
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/Response.h>
 #include <LibWeb/ContentSecurityPolicy/BlockingAlgorithms.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/MIME.h>
 #include <LibWeb/Fetch/Infrastructure/URL.h>
 #include <LibWeb/Fetch/Response.h>
@@ -66,7 +68,12 @@ static GC::WeakHashMap<JS::Object, NonnullOwnPtr<WebAssemblyCache>>& caches()
 
 WebAssemblyCache& get_cache(JS::Realm& realm)
 {
-    return *caches().ensure(realm.global_object(), [] { return make<WebAssemblyCache>(); });
+    return *caches().ensure(realm.global_object(), [&] {
+        auto cache = make<WebAssemblyCache>();
+        // NB: Agents that cannot block, such as a window's, must not be able to wait in memory.atomic.wait either.
+        cache->abstract_machine().store().set_can_block(JS::agent_can_suspend(realm.vm()));
+        return cache;
+    });
 }
 
 }
@@ -447,89 +454,147 @@ JS::ThrowCompletionOr<NonnullRefPtr<Wasm::ModuleInstance>> instantiate_module(JS
     return instance_result.release_value();
 }
 
-// https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
-// https://webassembly.github.io/content-security-policy/js-api/#compile-a-webassembly-module
-JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
+// Content-keyed disk cache: slot the module into the HTTP side-data shelf under a synthetic wasm-cache://<hex> URL derived from the hash of its bytes.
+static Optional<Wasm::CompileCacheConfig> compile_cache_config_for(::Crypto::Hash::SHA256::DigestType const& digest)
 {
-    TRY(host_ensure_can_compile_wasm_bytes(vm));
+    StringBuilder hex_builder;
+    for (auto byte : digest.bytes())
+        hex_builder.appendff("{:02x}", byte);
+    auto synthetic_url = URL::Parser::basic_parse(ByteString::formatted("wasm-cache://{}", hex_builder.to_byte_string()));
+    if (!synthetic_url.has_value())
+        return {};
+
+    auto method = "GET"_string.to_byte_string();
+    (void)ResourceLoader::the().request_client()->create_synthetic_cache_entry(*synthetic_url, method);
+
+    Wasm::CompileCacheConfig config;
+    __builtin_memcpy(config.wasm_hash.data(), digest.bytes().data(), 32);
+
+    auto retrieve_result = ResourceLoader::the().request_client()->retrieve_cache_associated_data(
+        *synthetic_url, method, OptionalNone {}, 0u,
+        HTTP::CacheEntryAssociatedData::WebAssemblyCompiledCode);
+    if (!retrieve_result.is_error()) {
+        if (auto buf = retrieve_result.release_value(); buf.has_value()) {
+            // Copy into an owned buffer: compilation may run on another thread long after the AnonymousBuffer here goes away.
+            if (auto copy = ByteBuffer::copy(buf->bytes()); !copy.is_error())
+                config.existing_blob = copy.release_value();
+        }
+    }
 
-    Wasm::ModuleStats stats;
-    stats.input_size_bytes = data.size();
+    config.on_compiled = [url = *synthetic_url, method = move(method), event_loop_weak = Core::EventLoop::current_weak()](ByteBuffer blob) mutable {
+        auto origin = event_loop_weak->take();
+        if (!origin)
+            return;
+        origin->deferred_invoke([url = move(url), method = move(method), blob = move(blob)]() mutable {
+            if (!ResourceLoader::is_initialized() || !ResourceLoader::the().request_client())
+                return;
+            (void)ResourceLoader::the().request_client()->store_cache_associated_data(
+                url, method, OptionalNone {}, 0u,
+                HTTP::CacheEntryAssociatedData::WebAssemblyCompiledCode, blob.bytes());
+        });
+    };
+    return config;
+}
 
-    auto parse_start = MonotonicTime::now();
-    FixedMemoryStream stream { data.bytes() };
-    auto module_result = Wasm::Module::parse(stream);
-    stats.parse_time = MonotonicTime::now() - parse_start;
-    if (module_result.is_error()) {
-        return vm.throw_completion<CompileError>(Wasm::parse_error_to_byte_string(module_result.error()));
-    }
+static bool can_use_compile_cache()
+{
+    return ResourceLoader::is_initialized() && ResourceLoader::the().request_client();
+}
 
-    // Content-keyed disk cache: hash the wasm bytes, slot into the HTTP side-data shelf under a synthetic wasm-cache://<hex> URL
+// The part of compiling a WebAssembly module that follows parsing: validate, then kick off native compilation in the background.
+static JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> validate_parsed_webassembly_module(JS::VM& vm, NonnullRefPtr<Wasm::Module> module, Wasm::ModuleStats stats, Optional<::Crypto::Hash::SHA256::DigestType> const& digest)
+{
     Optional<Wasm::CompileCacheConfig> wasm_cache_config;
-    if (ResourceLoader::is_initialized() && ResourceLoader::the().request_client()) {
-        auto digest = ::Crypto::Hash::SHA256::hash(data.data(), data.size());
-        __builtin_memcpy(stats.wasm_hash.data(), digest.bytes().data(), 32);
-
-        StringBuilder hex_builder;
-        for (auto byte : digest.bytes())
-            hex_builder.appendff("{:02x}", byte);
-        auto synthetic_url = URL::Parser::basic_parse(ByteString::formatted("wasm-cache://{}", hex_builder.to_byte_string()));
-        if (synthetic_url.has_value()) {
-            auto method = "GET"_string.to_byte_string();
-            (void)ResourceLoader::the().request_client()->create_synthetic_cache_entry(*synthetic_url, method);
-
-            Wasm::CompileCacheConfig config;
-            __builtin_memcpy(config.wasm_hash.data(), digest.bytes().data(), 32);
-
-            auto retrieve_result = ResourceLoader::the().request_client()->retrieve_cache_associated_data(
-                *synthetic_url, method, OptionalNone {}, 0u,
-                HTTP::CacheEntryAssociatedData::WebAssemblyCompiledCode);
-            if (!retrieve_result.is_error()) {
-                if (auto buf = retrieve_result.release_value(); buf.has_value()) {
-                    // Copy into an owned buffer: compilation may run on another thread long after the AnonymousBuffer here goes away.
-                    if (auto copy = ByteBuffer::copy(buf->bytes()); !copy.is_error())
-                        config.existing_blob = copy.release_value();
-                }
-            }
-
-            config.on_compiled = [url = *synthetic_url, method = move(method), event_loop_weak = Core::EventLoop::current_weak()](ByteBuffer blob) mutable {
-                auto origin = event_loop_weak->take();
-                if (!origin)
-                    return;
-                origin->deferred_invoke([url = move(url), method = move(method), blob = move(blob)]() mutable {
-                    if (!ResourceLoader::is_initialized() || !ResourceLoader::the().request_client())
-                        return;
-                    (void)ResourceLoader::the().request_client()->store_cache_associated_data(
-                        url, method, OptionalNone {}, 0u,
-                        HTTP::CacheEntryAssociatedData::WebAssemblyCompiledCode, blob.bytes());
-                });
-            };
-            wasm_cache_config = move(config);
-        }
+    if (digest.has_value()) {
+        __builtin_memcpy(stats.wasm_hash.data(), digest->bytes().data(), 32);
+        wasm_cache_config = compile_cache_config_for(*digest);
     }
 
     constexpr auto compile_to_native = Wasm::CompileToNative::No;
 
     auto& cache = get_cache(*vm.current_realm());
     auto validate_start = MonotonicTime::now();
-    auto validation_result = cache.abstract_machine().validate(module_result.value(), {}, compile_to_native);
+    auto validation_result = cache.abstract_machine().validate(*module, {}, compile_to_native);
     stats.validate_time = MonotonicTime::now() - validate_start;
 
     if (validation_result.is_error()) {
         return vm.throw_completion<CompileError>(validation_result.error().error_string);
     }
 
-    auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_result.release_value());
+    auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(move(module));
     cache.add_compiled_module(compiled_module);
     if (wasm_cache_config.has_value())
         compiled_module->module->set_cranelift_cache_config(wasm_cache_config.release_value());
     compiled_module->module->set_compile_stats(move(stats));
     Threading::ThreadPool::the().submit([module = NonnullRefPtr { compiled_module->module }] {
         Wasm::start_cranelift_compilation(*module);
-    });
+    },
+        Threading::TaskPriority::Background);
     return compiled_module;
 }
 
+// https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
+// https://webassembly.github.io/content-security-policy/js-api/#compile-a-webassembly-module
+JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
+{
+    TRY(host_ensure_can_compile_wasm_bytes(vm));
+
+    Wasm::ModuleStats stats;
+    stats.input_size_bytes = data.size();
+
+    auto parse_start = MonotonicTime::now();
+    FixedMemoryStream stream { data.bytes() };
+    auto module_result = Wasm::Module::parse(stream);
+    stats.parse_time = MonotonicTime::now() - parse_start;
+    if (module_result.is_error()) {
+        return vm.throw_completion<CompileError>(Wasm::parse_error_to_byte_string(module_result.error()));
+    }
+
+    Optional<::Crypto::Hash::SHA256::DigestType> digest;
+    if (can_use_compile_cache())
+        digest = ::Crypto::Hash::SHA256::hash(data.data(), data.size());
+
+    return validate_parsed_webassembly_module(vm, module_result.release_value(), move(stats), digest);
+}
+
+// State for a response body that's being parsed as it downloads; see compile_potential_webassembly_response().
+struct StreamingCompilation : public RefCounted<StreamingCompilation> {
+    Wasm::StreamingModuleParser parser;
+    NonnullOwnPtr<::Crypto::Hash::SHA256> hasher { ::Crypto::Hash::SHA256::create() };
+    Wasm::ModuleStats stats;
+
+    void append(ReadonlyBytes bytes)
+    {
+        hasher->update(bytes);
+        auto parse_start = MonotonicTime::now();
+        // Errors are remembered by the parser and reported by finish().
+        (void)parser.append(bytes);
+        stats.parse_time += MonotonicTime::now() - parse_start;
+    }
+};
+
+// Like compile_a_webassembly_module(), but for bytes that were already fed to a StreamingModuleParser as they downloaded.
+static JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_streamed_webassembly_module(JS::VM& vm, StreamingCompilation& compilation)
+{
+    TRY(host_ensure_can_compile_wasm_bytes(vm));
+
+    auto stats = move(compilation.stats);
+    stats.input_size_bytes = compilation.parser.total_size();
+
+    auto parse_start = MonotonicTime::now();
+    auto module_result = compilation.parser.finish();
+    stats.parse_time += MonotonicTime::now() - parse_start;
+    if (module_result.is_error()) {
+        return vm.throw_completion<CompileError>(Wasm::parse_error_to_byte_string(module_result.error()));
+    }
+
+    Optional<::Crypto::Hash::SHA256::DigestType> digest;
+    if (can_use_compile_cache())
+        digest = compilation.hasher->digest();
+
+    return validate_parsed_webassembly_module(vm, module_result.release_value(), move(stats), digest);
+}
+
 // https://webassembly.github.io/spec/js-api/#HostResizeArrayBuffer
 JS::ThrowCompletionOr<JS::HandledByHost> host_resize_array_buffer(JS::VM& vm, JS::ArrayBuffer& buffer, size_t new_length)
 {
@@ -950,6 +1015,30 @@ JS::ThrowCompletionOr<void> host_ensure_can_compile_wasm_bytes(JS::VM& vm)
 
 }
 
+// https://webassembly.github.io/spec/js-api/#asynchronously-compile-a-webassembly-module, step 2.2
+static void queue_a_task_to_settle_compilation(JS::VM& vm, JS::Realm& realm, GC::Ref<WebIDL::Promise> promise, JS::ThrowCompletionOr<NonnullRefPtr<Detail::CompiledWebAssemblyModule>> module_or_error, HTML::Task::Source task_source)
+{
+    HTML::queue_a_task(task_source, nullptr, nullptr, GC::create_function(vm.heap(), [&realm, promise, module_or_error = move(module_or_error)]() mutable {
+        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+        auto& realm = HTML::relevant_realm(*promise->promise());
+
+        // 1. If module is error, reject promise with a CompileError exception.
+        if (module_or_error.is_error()) {
+            WebIDL::reject_promise(realm, promise, module_or_error.error_value());
+        }
+
+        // 2. Otherwise,
+        else {
+            // 1. Construct a WebAssembly module object from module and bytes, and let moduleObject be the result.
+            // FIXME: Save bytes to the Module instance instead of moving into compile_a_webassembly_module
+            auto module_object = realm.create<Module>(realm, module_or_error.release_value());
+
+            // 2. Resolve promise with moduleObject.
+            WebIDL::resolve_promise(realm, promise, module_object);
+        }
+    }));
+}
+
 // https://webassembly.github.io/spec/js-api/#asynchronously-compile-a-webassembly-module
 GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM& vm, ByteBuffer bytes, HTML::Task::Source task_source)
 {
@@ -965,25 +1054,7 @@ GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM& vm, B
         auto module_or_error = Detail::compile_a_webassembly_module(vm, move(bytes));
 
         // 2. Queue a task to perform the following steps. If taskSource was provided, queue the task on that task source.
-        HTML::queue_a_task(task_source, nullptr, nullptr, GC::create_function(vm.heap(), [&realm, promise, module_or_error = move(module_or_error)]() mutable {
-            HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
-            auto& realm = HTML::relevant_realm(*promise->promise());
-
-            // 1. If module is error, reject promise with a CompileError exception.
-            if (module_or_error.is_error()) {
-                WebIDL::reject_promise(realm, promise, module_or_error.error_value());
-            }
-
-            // 2. Otherwise,
-            else {
-                // 1. Construct a WebAssembly module object from module and bytes, and let moduleObject be the result.
-                // FIXME: Save bytes to the Module instance instead of moving into compile_a_webassembly_module
-                auto module_object = realm.create<Module>(realm, module_or_error.release_value());
-
-                // 2. Resolve promise with moduleObject.
-                WebIDL::resolve_promise(realm, promise, module_object);
-            }
-        }));
+        queue_a_task_to_settle_compilation(vm, realm, promise, move(module_or_error), task_source);
     }));
 
     // 3. Return promise.
@@ -1147,42 +1218,41 @@ GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM& vm, GC::
         }
 
         // 8. Consume response’s body as an ArrayBuffer, and let bodyPromise be the result.
-        auto body_promise_or_error = response_object->array_buffer();
-        if (body_promise_or_error.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(realm.vm(), body_promise_or_error.release_error());
-            WebIDL::reject_promise(realm, return_value, throw_completion.value());
+        // OPTIMIZATION: Rather than waiting for the whole body, read it incrementally and feed each chunk to a streaming
+        //               module parser, so that parsing overlaps the download. Validation and native compilation start once
+        //               the body is complete, exactly as asynchronously compiling stableBytes would.
+        if (response_object->is_unusable()) {
+            WebIDL::reject_promise(realm, return_value, vm.throw_completion<JS::TypeError>("Body is unusable"_utf16).value());
             return JS::js_undefined();
         }
-        auto body_promise = body_promise_or_error.release_value();
+
+        auto compilation = make_ref_counted<Detail::StreamingCompilation>();
+        auto process_body_chunk = GC::create_function(vm.heap(), [compilation](ByteBuffer chunk) {
+            compilation->append(chunk.bytes());
+        });
 
         // 9. Upon fulfillment of bodyPromise with value bodyArrayBuffer:
-        auto body_fulfillment_steps = GC::create_function(vm.heap(), [&vm, return_value](JS::Value body_array_buffer) -> WebIDL::ExceptionOr<JS::Value> {
+        auto process_end_of_body = GC::create_function(vm.heap(), [&vm, &realm, return_value, compilation]() {
             // 1. Let stableBytes be a copy of the bytes held by the buffer bodyArrayBuffer.
-            VERIFY(body_array_buffer.is_object());
-            auto stable_bytes = WebIDL::get_buffer_source_copy(body_array_buffer.as_object());
-            if (stable_bytes.is_error()) {
-                VERIFY(stable_bytes.error().code() == ENOMEM);
-                WebIDL::reject_promise(HTML::relevant_realm(*return_value->promise()), return_value, vm.throw_completion<JS::InternalError>(vm.error_message(JS::VM::ErrorMessage::OutOfMemory)).value());
-                return JS::js_undefined();
-            }
+            // NOTE: The bytes were handed to compilation's parser as they arrived, so there's nothing left to copy.
 
             // 2. Asynchronously compile the WebAssembly module stableBytes using the networking task source and resolve returnValue with the result.
-            auto result = asynchronously_compile_webassembly_module(vm, stable_bytes.release_value(), HTML::Task::Source::Networking);
-
-            // Need to manually convert WebIDL promise to an ECMAScript value here to resolve
-            WebIDL::resolve_promise(HTML::relevant_realm(*return_value->promise()), return_value, result->promise());
-
-            return JS::js_undefined();
+            HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+            auto module_or_error = Detail::compile_a_streamed_webassembly_module(vm, *compilation);
+            queue_a_task_to_settle_compilation(vm, realm, return_value, move(module_or_error), HTML::Task::Source::Networking);
         });
 
         // 10. Upon rejection of bodyPromise with reason reason:
-        auto body_rejection_steps = GC::create_function(vm.heap(), [return_value](JS::Value reason) -> WebIDL::ExceptionOr<JS::Value> {
+        auto process_body_error = GC::create_function(vm.heap(), [&realm, return_value](JS::Value reason) {
             // 1. Reject returnValue with reason.
-            WebIDL::reject_promise(HTML::relevant_realm(*return_value->promise()), return_value, reason);
-            return JS::js_undefined();
+            HTML::TemporaryExecutionContext context(realm);
+            WebIDL::reject_promise(realm, return_value, reason);
         });
 
-        WebIDL::react_to_promise(body_promise, body_fulfillment_steps, body_rejection_steps);
+        if (auto body = response->body())
+            body->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { HTML::relevant_global_object(*response_object) });
+        else
+            process_end_of_body->function()();
 
         return JS::js_undefined();
     });
@@ -7,6 +7,7 @@
 
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/WebAudio/AudioNode.h>
+#include <LibWeb/WebAudio/AudioParam.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
 
 namespace Web::WebAudio {
@@ -113,6 +114,7 @@ WebIDL::ExceptionOr<void> AudioNode::connect(GC::Ref<AudioParam> destination_par
 
     // Connect node's output to destination_param.
     m_param_connections.append(param_connection);
+    destination_param->input_connections({}).append({ *this, output });
 
     return {};
 }
@@ -129,6 +131,11 @@ void AudioNode::disconnect()
         });
     }
 
+    for (auto const& connection : m_param_connections) {
+        connection.destination_param->input_connections({}).remove_all_matching([&](AudioParamInputConnection const& input_connection) {
+            return input_connection.source_node.ptr() == this;
+        });
+    }
     m_param_connections.clear();
 }
 
@@ -154,7 +161,14 @@ WebIDL::ExceptionOr<void> AudioNode::disconnect(WebIDL::UnsignedLong output)
     });
 
     m_param_connections.remove_all_matching([&](AudioParamConnection& connection) {
-        return connection.output == output;
+        if (connection.output != output)
+            return false;
+
+        connection.destination_param->input_connections({}).remove_all_matching([&](AudioParamInputConnection const& input_connection) {
+            return input_connection.source_node.ptr() == this && input_connection.output == output;
+        });
+
+        return true;
     });
 
     return {};
@@ -258,6 +272,9 @@ WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioParam> destination_
     m_param_connections.remove_all_matching([&](AudioParamConnection& connection) {
         return connection.destination_param == destination_param;
     });
+    destination_param->input_connections({}).remove_all_matching([&](AudioParamInputConnection const& input_connection) {
+        return input_connection.source_node.ptr() == this;
+    });
 
     // If there is no connection to the destinationParam, an InvalidAccessError exception MUST be thrown.
     if (m_param_connections.size() == before) {
@@ -280,6 +297,9 @@ WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioParam> destination_
     m_param_connections.remove_all_matching([&](AudioParamConnection& connection) {
         return connection.destination_param == destination_param && connection.output == output;
     });
+    destination_param->input_connections({}).remove_all_matching([&](AudioParamInputConnection const& input_connection) {
+        return input_connection.source_node.ptr() == this && input_connection.output == output;
+    });
 
     // If there is no connection to the destinationParam, an InvalidAccessError exception MUST be thrown.
     if (m_param_connections.size() == before) {
@@ -82,6 +82,8 @@ public:
 
     NodeID node_id() const { return m_node_id; }
 
+    Vector<AudioNodeConnection> const& input_connections() const { return m_input_connections; }
+
 protected:
     AudioNode(JS::Realm&, GC::Ref<BaseAudioContext>, WebIDL::UnsignedLong channel_count = 2);
 
@@ -6,15 +6,25 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/Optional.h>
 #include <AK/Variant.h>
 #include <AK/Vector.h>
 #include <LibJS/Forward.h>
 #include <LibWeb/Bindings/AudioParam.h>
 #include <LibWeb/Bindings/PlatformObject.h>
+#include <LibWeb/WebAudio/AudioParamTimeline.h>
+#include <LibWeb/WebIDL/Types.h>
 
 namespace Web::WebAudio {
 
+struct AudioParamInputConnection {
+    GC::Ref<AudioNode> source_node;
+    WebIDL::UnsignedLong output;
+
+    bool operator==(AudioParamInputConnection const& other) const = default;
+};
+
 // https://webaudio.github.io/web-audio-api/#AudioParam
 class AudioParam final : public Bindings::PlatformObject {
     WEB_PLATFORM_OBJECT(AudioParam, Bindings::PlatformObject);
@@ -41,7 +51,7 @@ public:
     WebIDL::ExceptionOr<void> set_automation_rate(Bindings::AutomationRate);
 
     // https://webaudio.github.io/web-audio-api/#dom-audioparam-defaultvalue
-    float default_value() const { return m_default_value; }
+    float default_value() const { return m_timeline.default_value; }
 
     // https://webaudio.github.io/web-audio-api/#dom-audioparam-minvalue
     float min_value() const { return m_min_value; }
@@ -57,74 +67,26 @@ public:
     WebIDL::ExceptionOr<GC::Ref<AudioParam>> cancel_scheduled_values(double cancel_time);
     WebIDL::ExceptionOr<GC::Ref<AudioParam>> cancel_and_hold_at_time(double cancel_time);
 
-private:
-    struct SetValue {
-        float value { 0 };
-    };
-
-    struct RampStart {
-        size_t set_target_event_id { 0 };
-        double time { 0 };
-        float value { 0 };
-    };
-
-    struct LinearRamp {
-        float value { 0 };
-        Optional<RampStart> start;
-    };
-
-    struct ExponentialRamp {
-        float value { 0 };
-        Optional<RampStart> start;
-    };
+    AudioParamTimeline const& timeline() const { return m_timeline; }
 
-    struct SetTarget {
-        float target { 0 };
-        float time_constant { 0 };
-    };
-
-    struct SetValueCurve {
-        Vector<float> values;
-        double duration { 0 };
-    };
+    // Connections from AudioNode outputs into this AudioParam.
+    Vector<AudioParamInputConnection> const& input_connections() const { return m_input_connections; }
+    Vector<AudioParamInputConnection>& input_connections(Badge<AudioNode>) { return m_input_connections; }
 
-    struct Hold {
-        float value { 0 };
-    };
-
-    using Parameterization = Variant<SetValue, LinearRamp, ExponentialRamp, SetTarget, SetValueCurve, Hold>;
-
-    struct AutomationEvent {
-        double time { 0 };
-        Parameterization parameterization;
-        size_t id { 0 };
-    };
-
-    struct ParameterizationCache {
-        Optional<size_t> event_index {};
-        Optional<double> minimum_time {};
-        Optional<double> maximum_time {};
-        float starting_value { 0 };
-
-        bool contains(double time) const
-        {
-            return (!minimum_time.has_value() || time >= *minimum_time)
-                && (!maximum_time.has_value() || time < *maximum_time);
-        }
-    };
+private:
+    using SetValue = AudioParamTimeline::SetValue;
+    using RampStart = AudioParamTimeline::RampStart;
+    using LinearRamp = AudioParamTimeline::LinearRamp;
+    using ExponentialRamp = AudioParamTimeline::ExponentialRamp;
+    using SetTarget = AudioParamTimeline::SetTarget;
+    using SetValueCurve = AudioParamTimeline::SetValueCurve;
+    using Hold = AudioParamTimeline::Hold;
+    using AutomationEvent = AudioParamTimeline::AutomationEvent;
 
     AudioParam(JS::Realm&, GC::Ref<BaseAudioContext>, float default_value, float min_value, float max_value, Bindings::AutomationRate, FixedAutomationRate = FixedAutomationRate::No);
 
-    // https://webaudio.github.io/web-audio-api/#dfn-automation-event
-    size_t first_event_index_after(double) const;
-
     Optional<RampStart> ramp_start_for_insertion_index(size_t) const;
 
-    float event_value_at_time(size_t event_index, double time) const;
-
-    // https://webaudio.github.io/web-audio-api/#computedvalue
-    ParameterizationCache const& parameterization_cache_for_time(double) const;
-
     // https://webaudio.github.io/web-audio-api/#dfn-automation-event
     WebIDL::ExceptionOr<void> insert_event(AutomationEvent);
 
@@ -133,8 +95,6 @@ private:
     // https://webaudio.github.io/web-audio-api/#dom-audioparam-current-value-slot
     float m_current_value {}; //  [[current value]]
 
-    float m_default_value {};
-
     float m_min_value {};
     float m_max_value {};
 
@@ -143,10 +103,10 @@ private:
     FixedAutomationRate m_fixed_automation_rate { FixedAutomationRate::No };
 
     // https://webaudio.github.io/web-audio-api/#dfn-automation-event
-    Vector<AutomationEvent> m_automation_events;
+    AudioParamTimeline m_timeline;
     size_t m_next_event_id { 0 };
 
-    mutable Optional<ParameterizationCache> m_parameterization_cache;
+    Vector<AudioParamInputConnection> m_input_connections;
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
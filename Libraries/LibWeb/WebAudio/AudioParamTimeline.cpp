@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024, Shannon Booth <shannon@serenityos.org>
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BinarySearch.h>
+#include <AK/Math.h>
+#include <LibWeb/WebAudio/AudioParamTimeline.h>
+
+namespace Web::WebAudio {
+
+// https://webaudio.github.io/web-audio-api/#computedvalue
+float AudioParamTimeline::intrinsic_value_at_time(double time) const
+{
+    // paramIntrinsicValue will be calculated at each time, which is either the value set directly to the value
+    // attribute, or, if there are any automation events with times before or at this time, the value as calculated from
+    // these events.
+    auto const& cache = parameterization_cache_for_time(time);
+    if (!cache.event_index.has_value())
+        return cache.starting_value;
+
+    auto const& event = events[*cache.event_index];
+    return event.parameterization.visit(
+        [](OneOf<SetValue, Hold> auto const& parameterization) {
+            return parameterization.value;
+        },
+        [&](LinearRamp const& linear_ramp) {
+            if (time >= event.time)
+                return linear_ramp.value;
+
+            VERIFY(cache.minimum_time.has_value());
+            auto progress = static_cast<float>((time - *cache.minimum_time) / (event.time - *cache.minimum_time));
+            return cache.starting_value + (linear_ramp.value - cache.starting_value) * progress;
+        },
+        [&](ExponentialRamp const& exponential_ramp) {
+            if (time >= event.time)
+                return exponential_ramp.value;
+
+            if (cache.starting_value == 0
+                || (cache.starting_value < 0 && exponential_ramp.value > 0)
+                || (cache.starting_value > 0 && exponential_ramp.value < 0))
+                return cache.starting_value;
+
+            VERIFY(cache.minimum_time.has_value());
+            auto progress = static_cast<float>((time - *cache.minimum_time) / (event.time - *cache.minimum_time));
+            return cache.starting_value * static_cast<float>(pow(exponential_ramp.value / cache.starting_value, progress));
+        },
+        [&](SetTarget const& set_target) -> float {
+            if (set_target.time_constant == 0)
+                return set_target.target;
+            return set_target.target + (cache.starting_value - set_target.target) * static_cast<float>(exp(-(time - event.time) / set_target.time_constant));
+        },
+        [&](SetValueCurve const&) {
+            return event_value_at_time(*cache.event_index, time);
+        });
+}
+
+// https://webaudio.github.io/web-audio-api/#dfn-automation-event
+size_t AudioParamTimeline::first_event_index_after(double time) const
+{
+    return AK::lower_bound_index(events, time, [](auto const& event, double time) {
+        return event.time <= time ? -1 : 1;
+    });
+}
+
+float AudioParamTimeline::event_value_at_time(size_t event_index, double time) const
+{
+    auto first_event_index = event_index;
+    while (first_event_index > 0 && events[first_event_index].parameterization.has<SetTarget>())
+        --first_event_index;
+
+    auto value = default_value;
+    for (auto current_event_index = first_event_index; current_event_index <= event_index; ++current_event_index) {
+        auto const& event = events[current_event_index];
+        auto evaluation_time = current_event_index == event_index ? time : events[current_event_index + 1].time;
+        value = event.parameterization.visit(
+            [](OneOf<SetValue, LinearRamp, ExponentialRamp, Hold> auto const& parameterization) {
+                return parameterization.value;
+            },
+            [&](SetTarget const& set_target) -> float {
+                if (set_target.time_constant == 0)
+                    return set_target.target;
+                return set_target.target + (value - set_target.target) * static_cast<float>(exp(-(evaluation_time - event.time) / set_target.time_constant));
+            },
+            [&](SetValueCurve const& set_value_curve) {
+                if (evaluation_time >= event.time + set_value_curve.duration)
+                    return set_value_curve.values.last();
+
+                auto curve_position = (set_value_curve.values.size() - 1) * (evaluation_time - event.time) / set_value_curve.duration;
+                // NB: Floating-point rounding can push curve_position to size() - 1 even though evaluation_time is
+                //     still strictly less than the curve's end time, so value_index is clamped to keep value_index + 1 in bounds.
+                auto value_index = min(static_cast<size_t>(floor(curve_position)), set_value_curve.values.size() - 2);
+                auto interpolation_factor = static_cast<float>(curve_position - value_index);
+                return set_value_curve.values[value_index]
+                    + (set_value_curve.values[value_index + 1] - set_value_curve.values[value_index]) * interpolation_factor;
+            });
+    }
+    return value;
+}
+
+AudioParamTimeline::ParameterizationCache const& AudioParamTimeline::parameterization_cache_for_time(double time) const
+{
+    if (parameterization_cache.has_value() && parameterization_cache->contains(time))
+        return *parameterization_cache;
+
+    auto event_index = first_event_index_after(time);
+    if (event_index == 0) {
+        parameterization_cache = {
+            .maximum_time = events.is_empty() ? Optional<double> {} : events.first().time,
+            .starting_value = default_value,
+        };
+        return *parameterization_cache;
+    }
+
+    // A following ramp parameterization owns the interval before its event time. Other parameterizations fall through
+    // to caching the preceding event below.
+    if (event_index < events.size()) {
+        auto cache = events[event_index].parameterization.visit(
+            [](OneOf<SetValue, SetTarget, SetValueCurve, Hold> auto const&) -> Optional<ParameterizationCache> {
+                return {};
+            },
+            [&](OneOf<LinearRamp, ExponentialRamp> auto const& ramp) -> Optional<ParameterizationCache> {
+                auto const& previous_event = events[event_index - 1];
+                double minimum_time;
+                float starting_value;
+                if (ramp.start.has_value() && ramp.start->set_target_event_id == previous_event.id) {
+                    minimum_time = ramp.start->time;
+                    starting_value = ramp.start->value;
+                } else {
+                    minimum_time = previous_event.parameterization.visit(
+                        [&](SetValueCurve const& set_value_curve) {
+                            return previous_event.time + set_value_curve.duration;
+                        },
+                        [&](auto const&) {
+                            return previous_event.time;
+                        });
+                    starting_value = event_value_at_time(event_index - 1, minimum_time);
+                }
+                // NB: A ramp rewritten by cancelAndHoldAtTime() can end before a preceding value curve's original end.
+                //     In that case, the curve owns the interval before the ramp endpoint.
+                if (time < minimum_time || minimum_time >= events[event_index].time)
+                    return {};
+                return ParameterizationCache {
+                    .event_index = event_index,
+                    .minimum_time = minimum_time,
+                    .maximum_time = events[event_index].time,
+                    .starting_value = starting_value,
+                };
+            });
+        if (cache.has_value()) {
+            parameterization_cache = cache.release_value();
+            return *parameterization_cache;
+        }
+    }
+
+    auto selected_event_index = event_index - 1;
+    auto const& selected_event = events[selected_event_index];
+    Optional<double> maximum_time;
+    if (event_index < events.size()) {
+        auto const& next_event = events[event_index];
+        maximum_time = next_event.parameterization.visit(
+            [&](OneOf<LinearRamp, ExponentialRamp> auto const& ramp) {
+                if (ramp.start.has_value() && ramp.start->set_target_event_id == selected_event.id)
+                    return ramp.start->time;
+                return next_event.time;
+            },
+            [&](auto const&) {
+                return next_event.time;
+            });
+    }
+    parameterization_cache = {
+        .event_index = selected_event_index,
+        .minimum_time = selected_event.time,
+        .maximum_time = maximum_time,
+        .starting_value = event_value_at_time(selected_event_index, selected_event.time),
+    };
+    return *parameterization_cache;
+}
+
+}
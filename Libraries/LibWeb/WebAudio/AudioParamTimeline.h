@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024, Shannon Booth <shannon@serenityos.org>
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+
+namespace Web::WebAudio {
+
+// https://webaudio.github.io/web-audio-api/#dfn-automation-event
+// NB: The automation events of an AudioParam, and how its intrinsic value follows from them. This holds no GC
+//     references, so the rendering thread can evaluate a copy of it while the control thread keeps scheduling events.
+struct AudioParamTimeline {
+    struct SetValue {
+        float value { 0 };
+    };
+
+    struct RampStart {
+        size_t set_target_event_id { 0 };
+        double time { 0 };
+        float value { 0 };
+    };
+
+    struct LinearRamp {
+        float value { 0 };
+        Optional<RampStart> start;
+    };
+
+    struct ExponentialRamp {
+        float value { 0 };
+        Optional<RampStart> start;
+    };
+
+    struct SetTarget {
+        float target { 0 };
+        float time_constant { 0 };
+    };
+
+    struct SetValueCurve {
+        Vector<float> values;
+        double duration { 0 };
+    };
+
+    struct Hold {
+        float value { 0 };
+    };
+
+    using Parameterization = Variant<SetValue, LinearRamp, ExponentialRamp, SetTarget, SetValueCurve, Hold>;
+
+    struct AutomationEvent {
+        double time { 0 };
+        Parameterization parameterization;
+        size_t id { 0 };
+    };
+
+    struct ParameterizationCache {
+        Optional<size_t> event_index {};
+        Optional<double> minimum_time {};
+        Optional<double> maximum_time {};
+        float starting_value { 0 };
+
+        bool contains(double time) const
+        {
+            return (!minimum_time.has_value() || time >= *minimum_time)
+                && (!maximum_time.has_value() || time < *maximum_time);
+        }
+    };
+
+    // https://webaudio.github.io/web-audio-api/#computedvalue
+    float intrinsic_value_at_time(double) const;
+
+    // https://webaudio.github.io/web-audio-api/#dfn-automation-event
+    size_t first_event_index_after(double) const;
+
+    float event_value_at_time(size_t event_index, double time) const;
+
+    // https://webaudio.github.io/web-audio-api/#computedvalue
+    ParameterizationCache const& parameterization_cache_for_time(double) const;
+
+    float default_value { 0 };
+    Vector<AutomationEvent> events;
+
+    mutable Optional<ParameterizationCache> parameterization_cache;
+};
+
+}
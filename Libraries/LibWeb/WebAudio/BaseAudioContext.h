@@ -100,6 +100,8 @@ protected:
 
     void queue_a_media_element_task(GC::Ref<GC::Function<void()>>);
 
+    ControlMessageQueue& control_message_queue() { return *m_control_message_queue; }
+
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Optional.h>
 #include <AK/Variant.h>
 #include <LibWeb/WebAudio/Types.h>
 
@@ -14,6 +15,10 @@ namespace Web::WebAudio {
 struct StartSource {
     NodeID node_id { 0 };
     double when { 0.0 };
+
+    // Only used by AudioBufferSourceNode.
+    double offset { 0.0 };
+    Optional<double> duration;
 };
 
 struct StopSource {
@@ -7,16 +7,49 @@
 #include <LibWeb/WebAudio/ControlMessageQueue.h>
 namespace Web::WebAudio {
 
+ControlMessageQueue::~ControlMessageQueue()
+{
+    auto* node = m_head.exchange(nullptr, AK::MemoryOrder::memory_order_acquire);
+    while (node) {
+        auto* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
 void ControlMessageQueue::enqueue(ControlMessage message)
 {
-    Sync::MutexLocker locker(m_mutex);
-    m_messages.append(move(message));
+    auto* node = new Node { .message = move(message) };
+    auto* head = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!m_head.compare_exchange_strong(head, node, AK::MemoryOrder::memory_order_release));
 }
 
 Vector<ControlMessage> ControlMessageQueue::drain()
 {
-    Sync::MutexLocker locker(m_mutex);
-    return move(m_messages);
+    auto* node = m_head.exchange(nullptr, AK::MemoryOrder::memory_order_acquire);
+
+    // The list is in last-in-first-out order, so it's reversed to hand out the messages in the order they were sent.
+    Node* oldest = nullptr;
+    size_t count = 0;
+    while (node) {
+        auto* next = node->next;
+        node->next = oldest;
+        oldest = node;
+        node = next;
+        ++count;
+    }
+
+    Vector<ControlMessage> messages;
+    messages.ensure_capacity(count);
+    while (oldest) {
+        auto* next = oldest->next;
+        messages.unchecked_append(move(oldest->message));
+        delete oldest;
+        oldest = next;
+    }
+    return messages;
 }
 
 }
@@ -6,23 +6,36 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
 #include <AK/Vector.h>
-#include <LibSync/Mutex.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/WebAudio/ControlMessage.h>
 
 namespace Web::WebAudio {
 
 // https://webaudio.github.io/web-audio-api/#control-message-queue
+// NB: The rendering thread must never wait for the control thread, so messages are pushed onto a lock-free list that
+//     the rendering thread takes over as a whole.
 class WEB_API ControlMessageQueue {
+    AK_MAKE_NONCOPYABLE(ControlMessageQueue);
+    AK_MAKE_NONMOVABLE(ControlMessageQueue);
 
 public:
+    ControlMessageQueue() = default;
+    ~ControlMessageQueue();
+
     void enqueue(ControlMessage);   // Called by the control thread.
     Vector<ControlMessage> drain(); // Called by the rendering thread.
 
 private:
-    mutable Sync::Mutex m_mutex;
-    Vector<ControlMessage> m_messages;
+    struct Node {
+        ControlMessage message;
+        Node* next { nullptr };
+    };
+
+    // The most recently enqueued message, linked to the ones enqueued before it.
+    Atomic<Node*> m_head { nullptr };
 };
 
 }
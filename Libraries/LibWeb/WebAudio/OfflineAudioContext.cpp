@@ -5,6 +5,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/EventLoop.h>
+#include <LibJS/Runtime/TypedArray.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/OfflineAudioCompletionEvent.h>
 #include <LibWeb/DOM/Document.h>
@@ -17,6 +20,7 @@
 #include <LibWeb/WebAudio/AudioDestinationNode.h>
 #include <LibWeb/WebAudio/OfflineAudioCompletionEvent.h>
 #include <LibWeb/WebAudio/OfflineAudioContext.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
 
 namespace Web::WebAudio {
 
@@ -129,9 +133,58 @@ WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> OfflineAudioContext::start_renderi
 void OfflineAudioContext::begin_offline_rendering(GC::Ref<WebIDL::Promise> promise)
 {
     // To begin offline rendering, the following steps MUST happen on a rendering thread that is created for the occasion.
-    // FIXME: 1: Given the current connections and scheduled changes, start rendering length sample-frames of audio into [[rendered buffer]]
-    // FIXME: 2: For every render quantum, check and suspend rendering if necessary.
-    // FIXME: 3: If a suspended context is resumed, continue to render the buffer.
+    // OPTIMIZATION: Nothing waits for offline rendering in real time, so the graph is copied once and rendered on the
+    //               thread pool as fast as it goes, many render quanta at a time, straight into the channel data of
+    //               [[rendered buffer]].
+    auto graph = RenderGraph::create(*m_destination);
+
+    // NB: The channel data can only be reached from the control thread, so it's looked up before rendering starts. A
+    //     channel whose storage isn't contiguous is rendered into a buffer of its own and copied over once rendering is
+    //     complete.
+    Vector<Span<float>> channels;
+    Vector<Vector<float>> non_contiguous_channels;
+    channels.ensure_capacity(m_number_of_channels);
+    non_contiguous_channels.resize(m_number_of_channels);
+    for (WebIDL::UnsignedLong channel = 0; channel < m_number_of_channels; ++channel) {
+        auto channel_data = MUST(m_rendered_buffer->get_channel_data(channel));
+        if (auto bytes = channel_data->viewed_array_buffer()->contiguous_bytes(channel_data->byte_offset(), length() * sizeof(float)); bytes.has_value()) {
+            channels.unchecked_append(bytes->reinterpret<float>());
+            continue;
+        }
+        non_contiguous_channels[channel].resize(length());
+        channels.unchecked_append(non_contiguous_channels[channel].span());
+    }
+
+    auto* on_rendered = new Function<void(Vector<Vector<float>>)>([context = GC::make_root(*this), promise = GC::make_root(promise)](Vector<Vector<float>> non_contiguous_channels) {
+        for (WebIDL::UnsignedLong channel = 0; channel < non_contiguous_channels.size(); ++channel) {
+            if (non_contiguous_channels[channel].is_empty())
+                continue;
+            auto channel_data = MUST(context->m_rendered_buffer->get_channel_data(channel));
+            channel_data->viewed_array_buffer()->overwrite(channel_data->byte_offset(), non_contiguous_channels[channel].data(), non_contiguous_channels[channel].size() * sizeof(float));
+        }
+        context->did_finish_offline_rendering(*promise);
+    });
+
+    auto& origin_event_loop = Core::EventLoop::current();
+    Threading::ThreadPool::the().submit([graph = move(graph), channels = move(channels), non_contiguous_channels = move(non_contiguous_channels), &control_message_queue = control_message_queue(), length = length(), on_rendered, &origin_event_loop]() mutable {
+        // 1: Given the current connections and scheduled changes, start rendering length sample-frames of audio into [[rendered buffer]]
+        for (size_t start_frame = 0; start_frame < length; start_frame += RenderGraph::maximum_frames_per_render) {
+            graph->apply_control_messages(control_message_queue.drain());
+            graph->render(start_frame, min(length - start_frame, RenderGraph::maximum_frames_per_render), channels.span());
+
+            // FIXME: 2: For every render quantum, check and suspend rendering if necessary.
+            // FIXME: 3: If a suspended context is resumed, continue to render the buffer.
+        }
+
+        origin_event_loop.deferred_invoke([on_rendered, non_contiguous_channels = move(non_contiguous_channels)]() mutable {
+            (*on_rendered)(move(non_contiguous_channels));
+            delete on_rendered;
+        });
+    });
+}
+
+void OfflineAudioContext::did_finish_offline_rendering(GC::Ref<WebIDL::Promise> promise)
+{
     // 4: Once the rendering is complete, queue a media element task to execute the following steps:
     queue_a_media_element_task(GC::create_function(heap(), [promise, this]() {
         HTML::TemporaryExecutionContext context(this->realm(), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
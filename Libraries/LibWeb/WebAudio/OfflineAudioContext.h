@@ -51,6 +51,7 @@ private:
     GC::Ptr<AudioBuffer> m_rendered_buffer;
 
     void begin_offline_rendering(GC::Ref<WebIDL::Promise> promise);
+    void did_finish_offline_rendering(GC::Ref<WebIDL::Promise> promise);
 };
 
 }
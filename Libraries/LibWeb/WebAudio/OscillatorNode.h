@@ -26,6 +26,7 @@ public:
     WebIDL::ExceptionOr<void> set_type(Bindings::OscillatorType);
 
     void set_periodic_wave(GC::Ptr<PeriodicWave>);
+    GC::Ptr<PeriodicWave> periodic_wave() const { return m_periodic_wave; }
 
     GC::Ref<AudioParam const> frequency() const { return m_frequency; }
     GC::Ref<AudioParam const> detune() const { return m_detune; }
@@ -0,0 +1,1001 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/IntegralMath.h>
+#include <AK/Math.h>
+#include <AK/TypeCasts.h>
+#include <LibJS/Runtime/TypedArray.h>
+#include <LibThreading/ThreadPool.h>
+#include <LibWeb/WebAudio/AnalyserNode.h>
+#include <LibWeb/WebAudio/AudioBuffer.h>
+#include <LibWeb/WebAudio/AudioBufferSourceNode.h>
+#include <LibWeb/WebAudio/AudioDestinationNode.h>
+#include <LibWeb/WebAudio/AudioParam.h>
+#include <LibWeb/WebAudio/BaseAudioContext.h>
+#include <LibWeb/WebAudio/ChannelMergerNode.h>
+#include <LibWeb/WebAudio/ChannelSplitterNode.h>
+#include <LibWeb/WebAudio/ConstantSourceNode.h>
+#include <LibWeb/WebAudio/DelayNode.h>
+#include <LibWeb/WebAudio/GainNode.h>
+#include <LibWeb/WebAudio/OscillatorNode.h>
+#include <LibWeb/WebAudio/PeriodicWave.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
+#include <LibWeb/WebAudio/StereoPannerNode.h>
+
+namespace Web::WebAudio {
+
+// One buffer of samples for every channel.
+using AudioChannels = Vector<Vector<float>>;
+
+struct RenderContext {
+    size_t start_frame { 0 };
+    size_t frame_count { 0 };
+    float sample_rate { 0 };
+
+    double time_of_frame(size_t frame) const { return static_cast<double>(start_frame + frame) / sample_rate; }
+};
+
+struct RenderConnection {
+    RenderNode* source { nullptr };
+    size_t output { 0 };
+};
+
+static void clear_channels(AudioChannels& channels, size_t channel_count, size_t frame_count)
+{
+    channels.resize_and_keep_capacity(channel_count);
+    for (auto& channel : channels) {
+        channel.resize_and_keep_capacity(frame_count);
+        channel.span().fill(0);
+    }
+}
+
+// https://webaudio.github.io/web-audio-api/#channel-up-mixing-and-down-mixing
+// Adds the first frame_count frames of source to destination, starting at destination_offset, mixed up or down to the
+// channel count of destination.
+template<typename Destination>
+static void mix_into(Destination& destination, size_t destination_offset, AudioChannels const& source, size_t frame_count, Bindings::ChannelInterpretation interpretation)
+{
+    auto source_count = source.size();
+    auto destination_count = destination.size();
+
+    auto add = [&](size_t to, size_t from, float gain) {
+        auto& to_channel = destination[to];
+        auto const& from_channel = source[from];
+        for (size_t frame = 0; frame < frame_count; ++frame)
+            to_channel[destination_offset + frame] += gain * from_channel[frame];
+    };
+
+    // Mixing rules are only defined for mono, stereo, quad and 5.1 speaker layouts, with their channels in the orders
+    // (M), (L, R), (L, R, SL, SR) and (L, R, C, LFE, SL, SR). Every other layout is mixed discretely.
+    auto is_speaker_layout = [](size_t count) { return count == 1 || count == 2 || count == 4 || count == 6; };
+    if (interpretation == Bindings::ChannelInterpretation::Discrete || source_count == destination_count || !is_speaker_layout(source_count) || !is_speaker_layout(destination_count)) {
+        // Up-mixing fills the channels in order, leaving the remaining ones silent. Down-mixing drops the remaining ones.
+        for (size_t channel = 0; channel < min(source_count, destination_count); ++channel)
+            add(channel, channel, 1);
+        return;
+    }
+
+    constexpr auto sqrt_half = AK::Sqrt1_2<float>;
+
+    // Up-mixing.
+    if (source_count == 1) {
+        if (destination_count == 6) {
+            add(2, 0, 1);
+        } else {
+            add(0, 0, 1);
+            add(1, 0, 1);
+        }
+        return;
+    }
+    if (source_count == 2 && destination_count > 2) {
+        add(0, 0, 1);
+        add(1, 1, 1);
+        return;
+    }
+    if (source_count == 4 && destination_count == 6) {
+        add(0, 0, 1);
+        add(1, 1, 1);
+        add(4, 2, 1);
+        add(5, 3, 1);
+        return;
+    }
+
+    // Down-mixing.
+    if (destination_count == 1) {
+        if (source_count == 2) {
+            add(0, 0, 0.5f);
+            add(0, 1, 0.5f);
+        } else if (source_count == 4) {
+            for (size_t channel = 0; channel < 4; ++channel)
+                add(0, channel, 0.25f);
+        } else {
+            add(0, 0, sqrt_half);
+            add(0, 1, sqrt_half);
+            add(0, 2, 1);
+            add(0, 4, 0.5f);
+            add(0, 5, 0.5f);
+        }
+        return;
+    }
+    if (destination_count == 2) {
+        if (source_count == 4) {
+            add(0, 0, 0.5f);
+            add(0, 2, 0.5f);
+            add(1, 1, 0.5f);
+            add(1, 3, 0.5f);
+        } else {
+            add(0, 0, 1);
+            add(0, 2, sqrt_half);
+            add(0, 4, sqrt_half);
+            add(1, 1, 1);
+            add(1, 2, sqrt_half);
+            add(1, 5, sqrt_half);
+        }
+        return;
+    }
+    VERIFY(source_count == 6 && destination_count == 4);
+    add(0, 0, 1);
+    add(0, 2, sqrt_half);
+    add(1, 1, 1);
+    add(1, 2, sqrt_half);
+    add(2, 4, 1);
+    add(3, 5, 1);
+}
+
+// Events take effect at the first frame at or after their time.
+static size_t frame_at_time(double time, float sample_rate)
+{
+    auto frame = AK::ceil(time * sample_rate);
+    if (frame >= static_cast<double>(NumericLimits<size_t>::max()))
+        return NumericLimits<size_t>::max();
+    return static_cast<size_t>(frame);
+}
+
+// Copies the contents of a Float32Array, which are empty if its buffer has been detached.
+static Vector<float> copy_samples(JS::Float32Array const& array)
+{
+    auto record = JS::make_typed_array_with_buffer_witness_record(array, JS::ArrayBuffer::Order::SeqCst);
+    if (JS::is_typed_array_out_of_bounds(record))
+        return {};
+
+    Vector<float> samples;
+    samples.resize(JS::typed_array_length(record));
+    array.viewed_array_buffer()->copy_to(array.byte_offset(), samples.span().reinterpret<u8>());
+    return samples;
+}
+
+// https://webaudio.github.io/web-audio-api/#computation-of-value
+class RenderParam {
+public:
+    explicit RenderParam(AudioParam const& param)
+        : m_timeline(param.timeline())
+        , m_min_value(param.min_value())
+        , m_max_value(param.max_value())
+        , m_automation_rate(param.automation_rate())
+    {
+    }
+
+    void compute_values(RenderContext const&);
+
+    float value_at(size_t frame) const { return m_values[frame]; }
+
+    // The AudioNode outputs connected to this parameter.
+    Vector<RenderConnection> inputs;
+
+private:
+    AudioParamTimeline m_timeline;
+    float m_min_value { 0 };
+    float m_max_value { 0 };
+    Bindings::AutomationRate m_automation_rate { Bindings::AutomationRate::ARate };
+
+    // The computed value for every frame that is being rendered.
+    Vector<float> m_values;
+    AudioChannels m_mixed_inputs;
+};
+
+class RenderNode {
+    AK_MAKE_NONCOPYABLE(RenderNode);
+    AK_MAKE_NONMOVABLE(RenderNode);
+
+public:
+    virtual ~RenderNode() = default;
+
+    void render(RenderContext const& context)
+    {
+        for (auto& param : params)
+            param.compute_values(context);
+        process(context);
+    }
+
+    virtual void start(double, double, Optional<double>) { }
+    virtual void stop(double) { }
+
+    // Nodes that aren't rendered yet ignore their inputs, so nothing that only feeds them needs to be rendered either.
+    virtual bool reads_inputs() const { return true; }
+
+    // The outputs connected to every input of this node.
+    Vector<Vector<RenderConnection>> inputs;
+
+    Vector<RenderParam> params;
+
+    // The frames that were rendered for every output of this node, which the nodes it's connected to read.
+    Vector<AudioChannels> outputs;
+
+    size_t level { 0 };
+
+protected:
+    explicit RenderNode(AudioNode& node)
+        : m_channel_count(node.channel_count())
+        , m_channel_count_mode(node.channel_count_mode())
+        , m_channel_interpretation(node.channel_interpretation())
+    {
+        inputs.resize(node.number_of_inputs());
+        outputs.resize(node.number_of_outputs());
+    }
+
+    virtual void process(RenderContext const&) = 0;
+
+    AudioChannels const& mix_input(size_t input, RenderContext const&);
+
+    size_t m_channel_count { 2 };
+    Bindings::ChannelCountMode m_channel_count_mode { Bindings::ChannelCountMode::Max };
+    Bindings::ChannelInterpretation m_channel_interpretation { Bindings::ChannelInterpretation::Speakers };
+
+private:
+    AudioChannels m_mixed_input;
+};
+
+void RenderParam::compute_values(RenderContext const& context)
+{
+    m_values.resize_and_keep_capacity(context.frame_count);
+
+    // The outputs connected to the parameter are mixed down to mono and added to its intrinsic value.
+    auto has_inputs = !inputs.is_empty();
+    if (has_inputs) {
+        clear_channels(m_mixed_inputs, 1, context.frame_count);
+        for (auto const& input : inputs)
+            mix_into(m_mixed_inputs, 0, input.source->outputs[input.output], context.frame_count, Bindings::ChannelInterpretation::Speakers);
+    }
+
+    auto computed_value = [&](size_t frame) {
+        auto value = m_timeline.intrinsic_value_at_time(context.time_of_frame(frame));
+        if (has_inputs)
+            value += m_mixed_inputs[0][frame];
+        return clamp(value, m_min_value, m_max_value);
+    };
+
+    // A k-rate parameter takes the value at the first frame of a render quantum for the whole render quantum.
+    if (m_automation_rate == Bindings::AutomationRate::KRate) {
+        for (size_t quantum_start = 0; quantum_start < context.frame_count; quantum_start += RenderGraph::render_quantum_size) {
+            auto quantum_frame_count = min(RenderGraph::render_quantum_size, context.frame_count - quantum_start);
+            m_values.span().slice(quantum_start, quantum_frame_count).fill(computed_value(quantum_start));
+        }
+        return;
+    }
+
+    for (size_t frame = 0; frame < context.frame_count; ++frame)
+        m_values[frame] = computed_value(frame);
+}
+
+// https://webaudio.github.io/web-audio-api/#channel-up-mixing-and-down-mixing
+AudioChannels const& RenderNode::mix_input(size_t input, RenderContext const& context)
+{
+    auto const& connections = inputs[input];
+
+    // https://webaudio.github.io/web-audio-api/#computednumberofchannels
+    size_t maximum_channel_count = 1;
+    for (auto const& connection : connections)
+        maximum_channel_count = max(maximum_channel_count, connection.source->outputs[connection.output].size());
+
+    size_t computed_number_of_channels = 0;
+    switch (m_channel_count_mode) {
+    case Bindings::ChannelCountMode::Max:
+        computed_number_of_channels = maximum_channel_count;
+        break;
+    case Bindings::ChannelCountMode::ClampedMax:
+        computed_number_of_channels = min(maximum_channel_count, m_channel_count);
+        break;
+    case Bindings::ChannelCountMode::Explicit:
+        computed_number_of_channels = m_channel_count;
+        break;
+    }
+
+    clear_channels(m_mixed_input, computed_number_of_channels, context.frame_count);
+    for (auto const& connection : connections)
+        mix_into(m_mixed_input, 0, connection.source->outputs[connection.output], context.frame_count, m_channel_interpretation);
+    return m_mixed_input;
+}
+
+static void copy_channels(AudioChannels const& source, AudioChannels& destination, size_t frame_count)
+{
+    clear_channels(destination, source.size(), frame_count);
+    for (size_t channel = 0; channel < source.size(); ++channel)
+        source[channel].span().copy_to(destination[channel].span());
+}
+
+// https://webaudio.github.io/web-audio-api/#AudioDestinationNode
+class RenderDestinationNode final : public RenderNode {
+public:
+    explicit RenderDestinationNode(AudioDestinationNode& node)
+        : RenderNode(node)
+    {
+    }
+
+    void set_destination_channels(ReadonlySpan<Span<float>> channels) { m_destination_channels = channels; }
+
+private:
+    virtual void process(RenderContext const& context) override
+    {
+        // OPTIMIZATION: The destination has as many channels as the rendered buffer, so its input is mixed straight into
+        //               the rendered buffer instead of into a buffer of its own.
+        for (auto const& connection : inputs[0])
+            mix_into(m_destination_channels, context.start_frame, connection.source->outputs[connection.output], context.frame_count, m_channel_interpretation);
+    }
+
+    ReadonlySpan<Span<float>> m_destination_channels;
+};
+
+// https://webaudio.github.io/web-audio-api/#GainNode
+class RenderGainNode final : public RenderNode {
+public:
+    explicit RenderGainNode(GainNode& node)
+        : RenderNode(node)
+    {
+    }
+
+private:
+    virtual void process(RenderContext const& context) override
+    {
+        auto const& input = mix_input(0, context);
+        auto const& gain = params[0];
+
+        auto& output = outputs[0];
+        clear_channels(output, input.size(), context.frame_count);
+        for (size_t channel = 0; channel < input.size(); ++channel) {
+            for (size_t frame = 0; frame < context.frame_count; ++frame)
+                output[channel][frame] = input[channel][frame] * gain.value_at(frame);
+        }
+    }
+};
+
+// https://webaudio.github.io/web-audio-api/#DelayNode
+class RenderDelayNode final : public RenderNode {
+public:
+    RenderDelayNode(DelayNode& node, float sample_rate)
+        : RenderNode(node)
+        , m_sample_rate(sample_rate)
+        , m_delay_line_length(frame_at_time(node.delay_time()->max_value(), sample_rate) + 2)
+    {
+    }
+
+private:
+    virtual void process(RenderContext const& context) override
+    {
+        auto const& input = mix_input(0, context);
+        auto const& delay_time = params[0];
+
+        // The delayed frames of channels that are no longer in the input keep coming out.
+        if (m_delay_lines.size() < input.size()) {
+            m_delay_lines.resize(input.size());
+            for (auto& delay_line : m_delay_lines)
+                delay_line.resize(m_delay_line_length);
+        }
+
+        auto& output = outputs[0];
+        clear_channels(output, m_delay_lines.size(), context.frame_count);
+
+        for (size_t frame = 0; frame < context.frame_count; ++frame) {
+            for (size_t channel = 0; channel < m_delay_lines.size(); ++channel)
+                m_delay_lines[channel][m_write_index] = channel < input.size() ? input[channel][frame] : 0;
+
+            auto read_position = static_cast<double>(m_write_index) - static_cast<double>(delay_time.value_at(frame)) * m_sample_rate;
+            if (read_position < 0)
+                read_position += m_delay_line_length;
+            auto read_index = static_cast<size_t>(read_position) % m_delay_line_length;
+            auto next_read_index = (read_index + 1) % m_delay_line_length;
+            auto fraction = static_cast<float>(read_position - AK::floor(read_position));
+
+            for (size_t channel = 0; channel < m_delay_lines.size(); ++channel) {
+                auto const& delay_line = m_delay_lines[channel];
+                output[channel][frame] = delay_line[read_index] + fraction * (delay_line[next_read_index] - delay_line[read_index]);
+            }
+
+            m_write_index = (m_write_index + 1) % m_delay_line_length;
+        }
+    }
+
+    float m_sample_rate { 0 };
+
+    // NB: One more frame than the longest delay is kept, so that fractional delays can be interpolated.
+    size_t m_delay_line_length { 0 };
+    AudioChannels m_delay_lines;
+    size_t m_write_index { 0 };
+};
+
+// https://webaudio.github.io/web-audio-api/#StereoPanner-algorithm
+class RenderStereoPannerNode final : public RenderNode {
+public:
+    explicit RenderStereoPannerNode(StereoPannerNode& node)
+        : RenderNode(node)
+    {
+    }
+
+private:
+    virtual void process(RenderContext const& context) override
+    {
+        auto const& input = mix_input(0, context);
+        auto const& pan = params[0];
+
+        auto& output = outputs[0];
+        clear_channels(output, 2, context.frame_count);
+
+        for (size_t frame = 0; frame < context.frame_count; ++frame) {
+            auto pan_value = pan.value_at(frame);
+
+            if (input.size() == 1) {
+                auto x = (pan_value + 1) / 2;
+                auto sample = input[0][frame];
+                output[0][frame] = sample * AK::cos(x * AK::Pi<float> / 2);
+                output[1][frame] = sample * AK::sin(x * AK::Pi<float> / 2);
+                continue;
+            }
+
+            auto x = pan_value <= 0 ? pan_value + 1 : pan_value;
+            auto gain_left = AK::cos(x * AK::Pi<float> / 2);
+            auto gain_right = AK::sin(x * AK::Pi<float> / 2);
+            auto left = input[0][frame];
+            auto right = input[1][frame];
+            if (pan_value <= 0) {
+                output[0][frame] = left + right * gain_left;
+                output[1][frame] = right * gain_right;
+            } else {
+                output[0][frame] = left * gain_left;
+                output[1][frame] = right + left * gain_right;
+            }
+        }
+    }
+};
+
+// https://webaudio.github.io/web-audio-api/#ChannelSplitterNode
+class RenderChannelSplitterNode final : public RenderNode {
+public:
+    explicit RenderChannelSplitterNode(ChannelSplitterNode& node)
+        : RenderNode(node)
+    {
+    }
+
+private:
+    virtual void process(RenderContext const& context) override
+    {
+        auto const& input = mix_input(0, context);
+        for (size_t output = 0; output < outputs.size(); ++output) {
+            clear_channels(outputs[output], 1, context.frame_count);
+            if (output < input.size())
+                input[output].span().copy_to(outputs[output][0].span());
+        }
+    }
+};
+
+// https://webaudio.github.io/web-audio-api/#ChannelMergerNode
+class RenderChannelMergerNode final : public RenderNode {
+public:
+    explicit RenderChannelMergerNode(ChannelMergerNode& node)
+        : RenderNode(node)
+    {
+    }
+
+private:
+    virtual void process(RenderContext const& context) override
+    {
+        auto& output = outputs[0];
+        clear_channels(output, inputs.size(), context.frame_count);
+
+        // NB: Every input is mixed down to mono, as the channel count of a ChannelMergerNode is always 1.
+        for (size_t input = 0; input < inputs.size(); ++input)
+            mix_input(input, context)[0].span().copy_to(output[input].span());
+    }
+};
+
+// https://webaudio.github.io/web-audio-api/#AnalyserNode
+class RenderAnalyserNode final : public RenderNode {
+public:
+    explicit RenderAnalyserNode(AnalyserNode& node)
+        : RenderNode(node)
+    {
+    }
+
+private:
+    // FIXME: Feed the rendered frames to the AnalyserNode, which passes its input through unchanged.
+    virtual void process(RenderContext const& context) override
+    {
+        copy_channels(mix_input(0, context), outputs[0], context.frame_count);
+    }
+};
+
+// FIXME: Render BiquadFilterNode, DynamicsCompressorNode, PannerNode, ScriptProcessorNode and
+//        MediaElementAudioSourceNode, which output silence until then.
+class RenderSilentNode final : public RenderNode {
+public:
+    explicit RenderSilentNode(AudioNode& node)
+        : RenderNode(node)
+    {
+    }
+
+    virtual bool reads_inputs() const override { return false; }
+
+private:
+    virtual void process(RenderContext const& context) override
+    {
+        for (auto& output : outputs)
+            clear_channels(output, 1, context.frame_count);
+    }
+};
+
+// https://webaudio.github.io/web-audio-api/#AudioScheduledSourceNode
+class RenderScheduledSourceNode : public RenderNode {
+public:
+    virtual void start(double when, double, Optional<double>) override { m_start_frame = frame_at_time(when, m_sample_rate); }
+    virtual void stop(double when) override { m_stop_frame = frame_at_time(when, m_sample_rate); }
+
+protected:
+    RenderScheduledSourceNode(AudioScheduledSourceNode& node, float sample_rate)
+        : RenderNode(node)
+        , m_sample_rate(sample_rate)
+    {
+    }
+
+    bool is_playing_at(size_t frame) const
+    {
+        return m_start_frame.has_value() && frame >= *m_start_frame && (!m_stop_frame.has_value() || frame < *m_stop_frame);
+    }
+
+    float m_sample_rate { 0 };
+
+private:
+    Optional<size_t> m_start_frame;
+    Optional<size_t> m_stop_frame;
+};
+
+// https://webaudio.github.io/web-audio-api/#ConstantSourceNode
+class RenderConstantSourceNode final : public RenderScheduledSourceNode {
+public:
+    RenderConstantSourceNode(ConstantSourceNode& node, float sample_rate)
+        : RenderScheduledSourceNode(node, sample_rate)
+    {
+    }
+
+private:
+    virtual void process(RenderContext const& context) override
+    {
+        auto const& offset = params[0];
+
+        auto& output = outputs[0];
+        clear_channels(output, 1, context.frame_count);
+        for (size_t frame = 0; frame < context.frame_count; ++frame) {
+            if (is_playing_at(context.start_frame + frame))
+                output[0][frame] = offset.value_at(frame);
+        }
+    }
+};
+
+// https://webaudio.github.io/web-audio-api/#OscillatorNode
+class RenderOscillatorNode final : public RenderScheduledSourceNode {
+public:
+    RenderOscillatorNode(OscillatorNode& node, float sample_rate)
+        : RenderScheduledSourceNode(node, sample_rate)
+    {
+        // https://webaudio.github.io/web-audio-api/#oscillator-coefficients
+        auto set_imaginary_coefficients = [&](auto coefficient) {
+            m_real.resize(maximum_harmonic_count + 1);
+            m_imag.resize(maximum_harmonic_count + 1);
+            for (size_t n = 1; n <= maximum_harmonic_count; ++n)
+                m_imag[n] = coefficient(n, static_cast<float>(n));
+        };
+
+        switch (node.type()) {
+        case Bindings::OscillatorType::Sine:
+            m_real = { 0, 0 };
+            m_imag = { 0, 1 };
+            break;
+        case Bindings::OscillatorType::Square:
+            // b[n] = (2 / (nπ)) * (1 - (-1)^n)
+            set_imaginary_coefficients([](size_t n, float x) { return n % 2 == 1 ? 4 / (x * AK::Pi<float>) : 0; });
+            break;
+        case Bindings::OscillatorType::Sawtooth:
+            // b[n] = (-1)^(n+1) * (2 / (nπ))
+            set_imaginary_coefficients([](size_t n, float x) { return (n % 2 == 1 ? 2 : -2) / (x * AK::Pi<float>); });
+            break;
+        case Bindings::OscillatorType::Triangle:
+            // b[n] = (8 * sin(nπ/2)) / (πn)^2
+            set_imaginary_coefficients([](size_t n, float x) {
+                if (n % 2 == 0)
+                    return 0.0f;
+                return (n % 4 == 1 ? 8 : -8) / ((AK::Pi<float> * x) * (AK::Pi<float> * x));
+            });
+            break;
+        case Bindings::OscillatorType::Custom:
+            if (auto periodic_wave = node.periodic_wave()) {
+                m_real = copy_samples(*periodic_wave->real());
+                m_imag = copy_samples(*periodic_wave->imag());
+                m_normalize = periodic_wave->normalize();
+            }
+            break;
+        }
+
+        // NB: The DC component is always 0, so coefficient 0 is not a harmonic.
+        auto coefficient_count = min(m_real.size(), m_imag.size());
+        m_harmonic_count = coefficient_count > 1 ? min(coefficient_count - 1, maximum_harmonic_count) : 0;
+    }
+
+private:
+    static constexpr size_t wavetable_size = 4096;
+    static constexpr size_t maximum_harmonic_count = wavetable_size / 2;
+
+    virtual void process(RenderContext const& context) override
+    {
+        auto const& frequency = params[0];
+        auto const& detune = params[1];
+        auto nyquist_frequency = m_sample_rate / 2;
+
+        auto& output = outputs[0];
+        clear_channels(output, 1, context.frame_count);
+        if (m_harmonic_count == 0)
+            return;
+
+        for (size_t frame = 0; frame < context.frame_count; ++frame) {
+            if (!is_playing_at(context.start_frame + frame))
+                continue;
+
+            // https://webaudio.github.io/web-audio-api/#dom-oscillatornode-frequency
+            auto computed_frequency = frequency.value_at(frame) * AK::exp2(detune.value_at(frame) / 1200);
+
+            // NB: Every harmonic of a frequency at or above the Nyquist frequency would alias, so none of them are played.
+            if (AK::fabs(computed_frequency) < nyquist_frequency) {
+                auto const& wavetable = wavetable_for_frequency(computed_frequency);
+                auto position = m_phase * wavetable_size;
+                auto index = static_cast<size_t>(position);
+                auto fraction = static_cast<float>(position - index);
+                output[0][frame] = wavetable[index] + fraction * (wavetable[index + 1] - wavetable[index]);
+            }
+
+            m_phase += computed_frequency / m_sample_rate;
+            m_phase -= AK::floor(m_phase);
+            if (m_phase >= 1)
+                m_phase = 0;
+        }
+    }
+
+    // OPTIMIZATION: A waveform only has the harmonics that stay below the Nyquist frequency, so a wavetable is built for
+    //               every power of two number of harmonics that is played, rather than for every frequency.
+    Vector<float> const& wavetable_for_frequency(float frequency)
+    {
+        auto harmonic_count = m_harmonic_count;
+        if (frequency != 0)
+            harmonic_count = min(harmonic_count, static_cast<size_t>(m_sample_rate / 2 / AK::fabs(frequency)));
+        harmonic_count = max<size_t>(harmonic_count, 1);
+
+        auto index = AK::log2(harmonic_count);
+        auto& wavetable = m_wavetables[index];
+        if (wavetable.is_empty()) {
+            wavetable = build_wavetable(1uz << index);
+            auto scale = normalization_scale();
+            for (auto& sample : wavetable)
+                sample *= scale;
+        }
+        return wavetable;
+    }
+
+    // https://webaudio.github.io/web-audio-api/#waveform-normalization
+    float normalization_scale()
+    {
+        if (!m_normalization_scale.has_value()) {
+            m_normalization_scale = 1.0f;
+            if (m_normalize) {
+                float peak = 0;
+                for (auto sample : build_wavetable(m_harmonic_count))
+                    peak = max(peak, AK::fabs(sample));
+                if (peak > 0)
+                    m_normalization_scale = 1 / peak;
+            }
+        }
+        return *m_normalization_scale;
+    }
+
+    // Samples one period of the sum of the first harmonic_count harmonics, with the first sample repeated at the end so
+    // that every position can be interpolated.
+    Vector<float> build_wavetable(size_t harmonic_count) const
+    {
+        Vector<float> sine;
+        sine.resize(wavetable_size);
+        for (size_t index = 0; index < wavetable_size; ++index)
+            sine[index] = static_cast<float>(AK::sin(2 * AK::Pi<double> * index / wavetable_size));
+
+        Vector<float> wavetable;
+        wavetable.resize(wavetable_size + 1);
+        for (size_t n = 1; n <= harmonic_count; ++n) {
+            auto real = m_real[n];
+            auto imag = m_imag[n];
+            if (real == 0 && imag == 0)
+                continue;
+            for (size_t index = 0; index < wavetable_size; ++index) {
+                auto phase = (n * index) % wavetable_size;
+                wavetable[index] += real * sine[(phase + wavetable_size / 4) % wavetable_size] + imag * sine[phase];
+            }
+        }
+        wavetable[wavetable_size] = wavetable[0];
+        return wavetable;
+    }
+
+    Vector<float> m_real;
+    Vector<float> m_imag;
+    bool m_normalize { true };
+    size_t m_harmonic_count { 0 };
+
+    Optional<float> m_normalization_scale;
+    Array<Vector<float>, AK::log2(maximum_harmonic_count) + 1> m_wavetables;
+
+    // The position within the current period, from 0 to 1.
+    double m_phase { 0 };
+};
+
+// https://webaudio.github.io/web-audio-api/#AudioBufferSourceNode
+class RenderAudioBufferSourceNode final : public RenderScheduledSourceNode {
+public:
+    RenderAudioBufferSourceNode(AudioBufferSourceNode& node, float sample_rate)
+        : RenderScheduledSourceNode(node, sample_rate)
+        , m_loop(node.loop())
+        , m_loop_start(node.loop_start())
+        , m_loop_end(node.loop_end())
+    {
+        // https://webaudio.github.io/web-audio-api/#acquire-the-content
+        if (auto buffer = node.buffer()) {
+            m_buffer_sample_rate = buffer->sample_rate();
+            for (WebIDL::UnsignedLong channel = 0; channel < buffer->number_of_channels(); ++channel)
+                m_buffer.append(copy_samples(*MUST(buffer->get_channel_data(channel))));
+        }
+    }
+
+    virtual void start(double when, double offset, Optional<double> duration) override
+    {
+        RenderScheduledSourceNode::start(when, offset, duration);
+        m_offset = offset;
+        m_duration = duration;
+    }
+
+private:
+    // https://webaudio.github.io/web-audio-api/#playback-AudioBufferSourceNode
+    virtual void process(RenderContext const& context) override
+    {
+        auto& output = outputs[0];
+        clear_channels(output, max<size_t>(m_buffer.size(), 1), context.frame_count);
+        if (m_buffer.is_empty() || m_has_ended)
+            return;
+
+        // NB: A detached channel has no frames, and then none of the channels are played.
+        size_t buffer_length = NumericLimits<size_t>::max();
+        for (auto const& channel : m_buffer)
+            buffer_length = min(buffer_length, channel.size());
+        auto buffer_duration = static_cast<double>(buffer_length) / m_buffer_sample_rate;
+
+        double loop_start_frame = 0;
+        double loop_end_frame = buffer_length;
+        if (m_loop && m_loop_start >= 0 && m_loop_end > 0 && m_loop_start < m_loop_end) {
+            loop_start_frame = min(m_loop_start, buffer_duration) * m_buffer_sample_rate;
+            loop_end_frame = min(m_loop_end, buffer_duration) * m_buffer_sample_rate;
+        }
+        auto loop_length = loop_end_frame - loop_start_frame;
+        auto loops = m_loop && loop_length > 0;
+
+        auto const& playback_rate = params[0];
+        auto const& detune = params[1];
+        // The number of buffer frames that the playhead moves for every rendered frame.
+        double playback_step = 0;
+
+        for (size_t frame = 0; frame < context.frame_count; ++frame) {
+            // NB: playbackRate and detune are k-rate, so the rate only changes between render quanta.
+            if (frame % RenderGraph::render_quantum_size == 0) {
+                auto computed_playback_rate = playback_rate.value_at(frame) * AK::exp2(detune.value_at(frame) / 1200);
+                playback_step = computed_playback_rate * m_buffer_sample_rate / m_sample_rate;
+            }
+
+            if (!is_playing_at(context.start_frame + frame))
+                continue;
+
+            if (!m_playhead.has_value())
+                m_playhead = clamp(m_offset, 0.0, buffer_duration) * m_buffer_sample_rate;
+
+            auto& playhead = *m_playhead;
+            if (loops) {
+                if (playhead >= loop_end_frame)
+                    playhead = loop_start_frame + AK::fmod(playhead - loop_start_frame, loop_length);
+                else if (playhead < loop_start_frame && playback_step < 0)
+                    playhead = loop_end_frame - AK::fmod(loop_start_frame - playhead, loop_length);
+            }
+            if (playhead < 0 || playhead >= buffer_length || (m_duration.has_value() && m_played_duration >= *m_duration)) {
+                m_has_ended = true;
+                return;
+            }
+
+            auto index = static_cast<size_t>(playhead);
+            auto next_index = index + 1;
+            if (loops && next_index >= loop_end_frame)
+                next_index = static_cast<size_t>(loop_start_frame);
+            auto fraction = static_cast<float>(playhead - index);
+
+            for (size_t channel = 0; channel < m_buffer.size(); ++channel) {
+                auto const& samples = m_buffer[channel];
+                auto sample = samples[index];
+                auto next_sample = next_index < buffer_length ? samples[next_index] : sample;
+                output[channel][frame] = sample + fraction * (next_sample - sample);
+            }
+
+            playhead += playback_step;
+            m_played_duration += AK::fabs(playback_step) / m_buffer_sample_rate;
+        }
+    }
+
+    AudioChannels m_buffer;
+    float m_buffer_sample_rate { 0 };
+
+    bool m_loop { false };
+    double m_loop_start { 0 };
+    double m_loop_end { 0 };
+
+    double m_offset { 0 };
+    Optional<double> m_duration;
+
+    // The position in frames of the buffer that is played next, from when playback has started.
+    Optional<double> m_playhead;
+    double m_played_duration { 0 };
+    bool m_has_ended { false };
+};
+
+// Appends the AudioParams of the node, in the order that its RenderNode reads them from RenderNode::params.
+static NonnullOwnPtr<RenderNode> create_render_node(AudioNode& node, float sample_rate, Vector<GC::Ref<AudioParam const>>& params)
+{
+    if (auto* destination = as_if<AudioDestinationNode>(node))
+        return make<RenderDestinationNode>(*destination);
+    if (auto* gain = as_if<GainNode>(node)) {
+        params.append(gain->gain());
+        return make<RenderGainNode>(*gain);
+    }
+    if (auto* delay = as_if<DelayNode>(node)) {
+        params.append(delay->delay_time());
+        return make<RenderDelayNode>(*delay, sample_rate);
+    }
+    if (auto* stereo_panner = as_if<StereoPannerNode>(node)) {
+        params.append(stereo_panner->pan());
+        return make<RenderStereoPannerNode>(*stereo_panner);
+    }
+    if (auto* channel_splitter = as_if<ChannelSplitterNode>(node))
+        return make<RenderChannelSplitterNode>(*channel_splitter);
+    if (auto* channel_merger = as_if<ChannelMergerNode>(node))
+        return make<RenderChannelMergerNode>(*channel_merger);
+    if (auto* analyser = as_if<AnalyserNode>(node))
+        return make<RenderAnalyserNode>(*analyser);
+    if (auto* constant_source = as_if<ConstantSourceNode>(node)) {
+        params.append(constant_source->offset());
+        return make<RenderConstantSourceNode>(*constant_source, sample_rate);
+    }
+    if (auto* oscillator = as_if<OscillatorNode>(node)) {
+        params.append(oscillator->frequency());
+        params.append(oscillator->detune());
+        return make<RenderOscillatorNode>(*oscillator, sample_rate);
+    }
+    if (auto* buffer_source = as_if<AudioBufferSourceNode>(node)) {
+        params.append(buffer_source->playback_rate());
+        params.append(buffer_source->detune());
+        return make<RenderAudioBufferSourceNode>(*buffer_source, sample_rate);
+    }
+    return make<RenderSilentNode>(node);
+}
+
+NonnullOwnPtr<RenderGraph> RenderGraph::create(AudioDestinationNode& destination)
+{
+    auto graph = adopt_own(*new RenderGraph(destination.context()->sample_rate()));
+
+    HashTable<NodeID> nodes_being_added;
+    graph->m_destination = static_cast<RenderDestinationNode*>(&graph->add_node(destination, nodes_being_added));
+
+    for (auto& node : graph->m_nodes) {
+        if (graph->m_levels.size() <= node->level)
+            graph->m_levels.resize(node->level + 1);
+        graph->m_levels[node->level].append(node.ptr());
+    }
+    return graph;
+}
+
+RenderGraph::RenderGraph(float sample_rate)
+    : m_sample_rate(sample_rate)
+{
+}
+
+RenderGraph::~RenderGraph() = default;
+
+RenderNode& RenderGraph::add_node(AudioNode& node, HashTable<NodeID>& nodes_being_added)
+{
+    if (auto existing_node = m_nodes_by_id.get(node.node_id()); existing_node.has_value())
+        return **existing_node;
+    nodes_being_added.set(node.node_id());
+
+    Vector<GC::Ref<AudioParam const>> audio_params;
+    auto render_node = create_render_node(node, m_sample_rate, audio_params);
+
+    auto add_source = [&](AudioNode& source, size_t output) -> Optional<RenderConnection> {
+        // FIXME: A cycle is allowed when it goes through a DelayNode, which then delays it by at least one render
+        //        quantum. Until that is rendered, the connection that closes a cycle is ignored.
+        if (nodes_being_added.contains(source.node_id()))
+            return {};
+        auto& source_node = add_node(source, nodes_being_added);
+        render_node->level = max(render_node->level, source_node.level + 1);
+        return RenderConnection { &source_node, output };
+    };
+
+    if (render_node->reads_inputs()) {
+        // NB: The destination_node of an input connection is the node that it comes from.
+        for (auto const& connection : node.input_connections()) {
+            if (auto source = add_source(*connection.destination_node, connection.output); source.has_value())
+                render_node->inputs[connection.input].append(*source);
+        }
+    }
+
+    for (auto const& audio_param : audio_params) {
+        RenderParam param { *audio_param };
+        for (auto const& connection : audio_param->input_connections()) {
+            if (auto source = add_source(*connection.source_node, connection.output); source.has_value())
+                param.inputs.append(*source);
+        }
+        render_node->params.append(move(param));
+    }
+
+    nodes_being_added.remove(node.node_id());
+
+    auto& added_node = *render_node;
+    m_nodes_by_id.set(node.node_id(), &added_node);
+    m_nodes.append(move(render_node));
+    return added_node;
+}
+
+void RenderGraph::apply_control_messages(Vector<ControlMessage> const& messages)
+{
+    // NB: Messages for nodes that the destination doesn't depend on have no audible effect, so they are dropped.
+    for (auto const& message : messages) {
+        message.visit(
+            [&](StartSource const& start) {
+                if (auto node = m_nodes_by_id.get(start.node_id); node.has_value())
+                    (*node)->start(start.when, start.offset, start.duration);
+            },
+            [&](StopSource const& stop) {
+                if (auto node = m_nodes_by_id.get(stop.node_id); node.has_value())
+                    (*node)->stop(stop.when);
+            });
+    }
+}
+
+void RenderGraph::render(size_t start_frame, size_t frame_count, ReadonlySpan<Span<float>> destination_channels)
+{
+    VERIFY(start_frame % render_quantum_size == 0);
+    VERIFY(frame_count <= maximum_frames_per_render);
+
+    RenderContext context { .start_frame = start_frame, .frame_count = frame_count, .sample_rate = m_sample_rate };
+    m_destination->set_destination_channels(destination_channels);
+
+    for (auto const& level : m_levels) {
+        if (level.size() == 1) {
+            level.first()->render(context);
+            continue;
+        }
+
+        // OPTIMIZATION: The nodes in a level don't depend on each other, so independent branches of the graph are
+        //               rendered in parallel.
+        Threading::ThreadPool::the().parallel_for(level.size(), [&](size_t index) {
+            level[index]->render(context);
+        });
+    }
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/WebAudio/ControlMessage.h>
+#include <LibWeb/WebAudio/Types.h>
+
+namespace Web::WebAudio {
+
+class RenderDestinationNode;
+class RenderNode;
+
+// https://webaudio.github.io/web-audio-api/#rendering-loop
+// NB: A copy of the nodes that a destination node depends on. It holds no GC references, so a rendering thread can run
+//     it while the control thread goes on changing the AudioNodes it was copied from.
+class RenderGraph {
+    AK_MAKE_NONCOPYABLE(RenderGraph);
+    AK_MAKE_NONMOVABLE(RenderGraph);
+
+public:
+    // https://webaudio.github.io/web-audio-api/#render-quantum-size
+    static constexpr size_t render_quantum_size = 128;
+
+    // The most frames rendered by one call to render(), which is a whole number of render quanta.
+    static constexpr size_t maximum_frames_per_render = 64 * render_quantum_size;
+
+    // Called on the control thread.
+    static NonnullOwnPtr<RenderGraph> create(AudioDestinationNode&);
+
+    ~RenderGraph();
+
+    // Called on the rendering thread.
+    void apply_control_messages(Vector<ControlMessage> const&);
+
+    // Called on the rendering thread. Renders the frames [start_frame, start_frame + frame_count) into that range of the
+    // destination channels. start_frame must be a multiple of the render quantum size.
+    void render(size_t start_frame, size_t frame_count, ReadonlySpan<Span<float>> destination_channels);
+
+private:
+    explicit RenderGraph(float sample_rate);
+
+    RenderNode& add_node(AudioNode&, HashTable<NodeID>& nodes_being_added);
+
+    float m_sample_rate { 0 };
+
+    Vector<NonnullOwnPtr<RenderNode>> m_nodes;
+    HashMap<NodeID, RenderNode*> m_nodes_by_id;
+
+    // The nodes grouped by their distance from the sources of the graph, so that each node only depends on nodes in
+    // earlier levels. The destination node is alone in the last level.
+    Vector<Vector<RenderNode*>> m_levels;
+
+    RenderDestinationNode* m_destination { nullptr };
+};
+
+}
@@ -11,6 +11,7 @@
 #include <AK/ByteBuffer.h>
 #include <AK/Debug.h>
 #include <AK/Format.h>
+#include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/Span.h>
@@ -19,6 +20,7 @@
 #include <AK/Time.h>
 #include <LibHTTP/Status.h>
 #include <LibWeb/WebDriver/Client.h>
+#include <LibWeb/WebDriver/Properties.h>
 
 namespace Web::WebDriver {
 
@@ -32,9 +34,12 @@ struct Route {
 
 struct MatchedRoute {
     RouteHandler handler;
+    StringView path;
     Vector<String> parameters;
 };
 
+static constexpr auto batch_route_path = "/session/:session_id/ladybird/batch"sv;
+
 #define ROUTE(method, path, handler)                              \
     Route                                                         \
     {                                                             \
@@ -76,6 +81,7 @@ static constexpr auto s_webdriver_endpoints = Array {
     ROUTE(POST, "/session/:session_id/ladybird/traverse-history-from-ui"sv, traverse_history_from_ui),
     ROUTE(POST, "/session/:session_id/ladybird/mark-web-content-session-history-stale"sv, mark_web_content_session_history_stale),
     ROUTE(GET, "/session/:session_id/ladybird/session-history"sv, get_session_history),
+    ROUTE(POST, batch_route_path, batch),
     ROUTE(POST, "/session/:session_id/element"sv, find_element),
     ROUTE(POST, "/session/:session_id/elements"sv, find_elements),
     ROUTE(POST, "/session/:session_id/element/:element_id/element"sv, find_element_from_element),
@@ -117,11 +123,11 @@ static constexpr auto s_webdriver_endpoints = Array {
 };
 
 // https://w3c.github.io/webdriver/#dfn-match-a-request
-static ErrorOr<MatchedRoute, Error> match_route(HTTP::HttpRequest const& request)
+static ErrorOr<MatchedRoute, Error> match_route(HTTP::HttpRequest::Method method, StringView resource)
 {
-    dbgln_if(WEBDRIVER_ROUTE_DEBUG, "match_route({}, {})", HTTP::to_string_view(request.method()), request.resource());
+    dbgln_if(WEBDRIVER_ROUTE_DEBUG, "match_route({}, {})", HTTP::to_string_view(method), resource);
 
-    auto request_path = request.resource().view();
+    auto request_path = resource;
     Vector<String> parameters;
 
     auto next_segment = [](auto& path) -> Optional<StringView> {
@@ -139,14 +145,14 @@ static ErrorOr<MatchedRoute, Error> match_route(HTTP::HttpRequest const& request
 
     for (auto const& route : s_webdriver_endpoints) {
         dbgln_if(WEBDRIVER_ROUTE_DEBUG, "- Checking {} {}", HTTP::to_string_view(route.method), route.path);
-        if (route.method != request.method())
+        if (route.method != method)
             continue;
 
         auto route_path = route.path;
         Optional<bool> match;
 
         auto on_failed_match = [&]() {
-            request_path = request.resource();
+            request_path = resource;
             parameters.clear();
             match = false;
         };
@@ -167,7 +173,7 @@ static ErrorOr<MatchedRoute, Error> match_route(HTTP::HttpRequest const& request
 
         if (*match) {
             dbgln_if(WEBDRIVER_ROUTE_DEBUG, "- Found match with parameters={}", parameters);
-            return MatchedRoute { route.handler, move(parameters) };
+            return MatchedRoute { route.handler, route.path, move(parameters) };
         }
     }
 
@@ -181,6 +187,20 @@ static JsonValue make_success_response(JsonValue value)
     return result;
 }
 
+static JsonValue make_error_response(Error const& error)
+{
+    JsonObject error_response;
+    error_response.set("error"sv, error.error);
+    error_response.set("message"sv, error.message);
+    error_response.set("stacktrace"sv, ""sv);
+    if (error.data.has_value())
+        error_response.set("data"sv, *error.data);
+
+    JsonObject result;
+    result.set("value"sv, move(error_response));
+    return result;
+}
+
 Client::Client(NonnullOwnPtr<Core::BufferedTCPSocket> socket)
     : m_socket(move(socket))
 {
@@ -274,7 +294,7 @@ ErrorOr<void, Client::WrappedError> Client::handle_request(HTTP::HttpRequest con
         dbgln("Body: {}", body);
     }
 
-    auto [handler, parameters] = TRY(match_route(request));
+    auto [handler, path, parameters] = TRY(match_route(request.method(), request.resource()));
     auto result = TRY((*handler)(*this, move(parameters), move(body)));
     return send_success_response(request, move(result));
 }
@@ -333,17 +353,7 @@ ErrorOr<void, Client::WrappedError> Client::send_error_response(HTTP::HttpReques
     dbgln_if(WEBDRIVER_DEBUG, "Sending error response: {} {}: {}", error.http_status, error.error, error.message);
     auto reason = HTTP::reason_phrase_for_code(error.http_status);
 
-    JsonObject error_response;
-    error_response.set("error"sv, error.error);
-    error_response.set("message"sv, error.message);
-    error_response.set("stacktrace"sv, ""sv);
-    if (error.data.has_value())
-        error_response.set("data"sv, *error.data);
-
-    JsonObject result;
-    result.set("value"sv, move(error_response));
-
-    auto content = result.serialized();
+    auto content = make_error_response(error).serialized();
 
     StringBuilder builder;
     builder.appendff("HTTP/1.1 {} {}\r\n", error.http_status, reason);
@@ -359,6 +369,65 @@ ErrorOr<void, Client::WrappedError> Client::send_error_response(HTTP::HttpReques
     return {};
 }
 
+static Response run_batched_command(Client& client, StringView session_id, JsonValue const& command)
+{
+    if (!command.is_object())
+        return Error::from_code(ErrorCode::InvalidArgument, "Batched command is not a JSON object"sv);
+
+    auto method_name = TRY(get_property(command, "method"sv));
+    auto path = TRY(get_property(command, "path"sv));
+
+    HTTP::HttpRequest::Method method;
+    if (method_name == "GET"sv)
+        method = HTTP::HttpRequest::Method::GET;
+    else if (method_name == "POST"sv)
+        method = HTTP::HttpRequest::Method::POST;
+    else if (method_name == "DELETE"sv)
+        method = HTTP::HttpRequest::Method::DELETE;
+    else
+        return Error::from_code(ErrorCode::InvalidArgument, MUST(String::formatted("Batched command has unsupported method '{}'", method_name)));
+
+    if (!path.is_empty() && !path.starts_with('/'))
+        return Error::from_code(ErrorCode::InvalidArgument, "Batched command path must start with '/'"sv);
+
+    auto resource = ByteString::formatted("/session/{}{}", session_id, path);
+    auto [handler, route_path, parameters] = TRY(match_route(method, resource));
+    if (route_path == batch_route_path)
+        return Error::from_code(ErrorCode::InvalidArgument, "Batches cannot be nested"sv);
+
+    JsonValue body;
+    if (auto maybe_body = command.as_object().get("body"sv); maybe_body.has_value())
+        body = *maybe_body;
+
+    return (*handler)(client, move(parameters), move(body));
+}
+
+// Ladybird extension: Run a list of commands of one session in a single round trip. The payload is of the form:
+//
+//     { "commands": [{ "method": "POST", "path": "/element", "body": { ... } }, { "method": "GET", "path": "/element/<id>/text" }] }
+//
+// where each path is relative to the session's URL. The commands run in order, and the response is the list of bodies
+// that each command would have responded with on its own. Running stops after the first command that fails, so the
+// list of responses may be shorter than the list of commands.
+Response Client::batch(Parameters parameters, JsonValue payload)
+{
+    auto const& commands = *TRY(get_property<JsonArray const*>(payload, "commands"sv));
+
+    JsonArray responses;
+    responses.ensure_capacity(commands.size());
+
+    for (auto const& command : commands.values()) {
+        auto response = run_batched_command(*this, parameters[0], command);
+        if (response.is_error()) {
+            responses.must_append(make_error_response(response.error()));
+            break;
+        }
+        responses.must_append(make_success_response(response.release_value()));
+    }
+
+    return responses;
+}
+
 void Client::log_response(HTTP::HttpRequest const& request, unsigned code)
 {
     outln("{} :: {:03d} :: {} {}", AK::UnixDateTime::now().to_byte_string(), code, request.method_name(), request.resource());
@@ -72,6 +72,9 @@ public:
     virtual Response mark_web_content_session_history_stale(Parameters parameters, JsonValue payload) = 0;
     virtual Response get_session_history(Parameters parameters, JsonValue payload) = 0;
 
+    // Ladybird extension for running several commands in a single round trip.
+    Response batch(Parameters parameters, JsonValue payload);
+
     // 12. Elements, https://w3c.github.io/webdriver/#elements
     virtual Response find_element(Parameters parameters, JsonValue payload) = 0;
     virtual Response find_elements(Parameters parameters, JsonValue payload) = 0;
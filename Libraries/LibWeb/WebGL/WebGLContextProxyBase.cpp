@@ -5,7 +5,7 @@
  */
 
 #include <AK/StringBuilder.h>
-#include <GLES2/gl2.h>
+#include <GLES3/gl3.h>
 #include <LibCore/AnonymousBuffer.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/PaintingSurface.h>
@@ -36,6 +36,8 @@ void WebGLContextProxyBase::restore(NonnullRefPtr<RemoteWebGLTransport> transpor
     m_out_of_line_commands.clear_with_capacity();
     m_pending_bitmaps.clear_with_capacity();
     m_string_cache.clear();
+    m_sync_reply_cache.clear();
+    m_may_have_gl_error = true;
     initialize_shared_command_buffer();
 }
 
@@ -58,6 +60,7 @@ void WebGLContextProxyBase::record_bytes(WebGLCommandType type, ReadonlyBytes pa
 {
     if (m_lost)
         return;
+    m_may_have_gl_error = true;
 
     if (!m_shared_command_buffer.is_valid()) {
         m_out_of_line_commands.append_bytes(type, payload, inline_data);
@@ -170,15 +173,81 @@ ByteBuffer WebGLContextProxyBase::send_sync_call(ByteBuffer request)
     if (m_lost)
         return {};
     flush_commands();
+    m_may_have_gl_error = true;
     auto reply = m_transport->sync_call(move(request));
     if (reply.is_empty())
         set_lost();
     return reply;
 }
 
+ByteBuffer WebGLContextProxyBase::send_cached_sync_call(ByteBuffer request)
+{
+    if (auto cached_reply = m_sync_reply_cache.get(request); cached_reply.has_value())
+        return MUST(ByteBuffer::copy(*cached_reply));
+
+    auto reply = send_sync_call(request);
+    if (!m_lost)
+        m_sync_reply_cache.set(move(request), MUST(ByteBuffer::copy(reply)));
+    return reply;
+}
+
+// The limits of the GL implementation, which the getters always return the same values for. Limits that only exist
+// once an extension is enabled aren't included, since asking for them before that is an error.
+bool WebGLContextProxyBase::is_implementation_limit(GLenum pname)
+{
+    switch (pname) {
+    case GL_ALIASED_LINE_WIDTH_RANGE:
+    case GL_ALIASED_POINT_SIZE_RANGE:
+    case GL_MAX_3D_TEXTURE_SIZE:
+    case GL_MAX_ARRAY_TEXTURE_LAYERS:
+    case GL_MAX_COLOR_ATTACHMENTS:
+    case GL_MAX_COMBINED_FRAGMENT_UNIFORM_COMPONENTS:
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+    case GL_MAX_COMBINED_UNIFORM_BLOCKS:
+    case GL_MAX_COMBINED_VERTEX_UNIFORM_COMPONENTS:
+    case GL_MAX_CUBE_MAP_TEXTURE_SIZE:
+    case GL_MAX_DRAW_BUFFERS:
+    case GL_MAX_ELEMENT_INDEX:
+    case GL_MAX_ELEMENTS_INDICES:
+    case GL_MAX_ELEMENTS_VERTICES:
+    case GL_MAX_FRAGMENT_INPUT_COMPONENTS:
+    case GL_MAX_FRAGMENT_UNIFORM_BLOCKS:
+    case GL_MAX_FRAGMENT_UNIFORM_COMPONENTS:
+    case GL_MAX_FRAGMENT_UNIFORM_VECTORS:
+    case GL_MAX_PROGRAM_TEXEL_OFFSET:
+    case GL_MAX_RENDERBUFFER_SIZE:
+    case GL_MAX_SAMPLES:
+    case GL_MAX_SERVER_WAIT_TIMEOUT:
+    case GL_MAX_TEXTURE_IMAGE_UNITS:
+    case GL_MAX_TEXTURE_LOD_BIAS:
+    case GL_MAX_TEXTURE_SIZE:
+    case GL_MAX_TRANSFORM_FEEDBACK_INTERLEAVED_COMPONENTS:
+    case GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS:
+    case GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_COMPONENTS:
+    case GL_MAX_UNIFORM_BLOCK_SIZE:
+    case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+    case GL_MAX_VARYING_COMPONENTS:
+    case GL_MAX_VARYING_VECTORS:
+    case GL_MAX_VERTEX_ATTRIBS:
+    case GL_MAX_VERTEX_OUTPUT_COMPONENTS:
+    case GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS:
+    case GL_MAX_VERTEX_UNIFORM_BLOCKS:
+    case GL_MAX_VERTEX_UNIFORM_COMPONENTS:
+    case GL_MAX_VERTEX_UNIFORM_VECTORS:
+    case GL_MAX_VIEWPORT_DIMS:
+    case GL_MIN_PROGRAM_TEXEL_OFFSET:
+    case GL_SUBPIXEL_BITS:
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+        return true;
+    default:
+        return false;
+    }
+}
+
 ReadPixelsResult WebGLContextProxyBase::read_pixels_robust_angle_into_shared_buffer(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLsizei buf_size, Core::AnonymousBuffer const& pixels)
 {
     flush_commands();
+    m_may_have_gl_error = true;
     return m_transport->read_pixels_robust_angle(x, y, width, height, format, type, buf_size, pixels);
 }
 
@@ -321,6 +390,7 @@ bool WebGLContextProxyBase::read_buffer_sub_data(GLenum target, long long offset
 
     auto shared_data = shared_data_or_error.release_value();
     flush_commands();
+    m_may_have_gl_error = true;
     if (!m_transport->read_buffer_sub_data(target, static_cast<GLintptr>(offset), static_cast<GLintptr>(destination.size()), shared_data))
         return false;
     if (m_lost)
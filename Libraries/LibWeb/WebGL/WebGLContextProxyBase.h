@@ -68,6 +68,10 @@ public:
         return error;
     }
 
+    // Nothing has reached the GL context since its errors were last found to be clear, so it can't have any now.
+    bool may_have_gl_error() const { return m_may_have_gl_error; }
+    void did_find_no_gl_error() { m_may_have_gl_error = false; }
+
 protected:
     static constexpr size_t max_pending_command_bytes = 4 * MiB;
 
@@ -89,9 +93,15 @@ protected:
     void record_bytes(WebGLCommandType, ReadonlyBytes payload, ReadonlyBytes inline_data);
 
     ByteBuffer send_sync_call(ByteBuffer request);
+
+    // Answers requests that were made before from the earlier reply, which is only correct for requests whose reply
+    // never changes over the lifetime of the context.
+    ByteBuffer send_cached_sync_call(ByteBuffer request);
+    static bool is_implementation_limit(GLenum pname);
     bool is_lost() const { return m_lost; }
 
     HashMap<GLenum, NonnullOwnPtr<ByteBuffer>> m_string_cache;
+    HashMap<ByteBuffer, ByteBuffer> m_sync_reply_cache;
 
 private:
     u32 append_pending_bitmap(Gfx::DecodedImageFrame);
@@ -111,6 +121,7 @@ private:
     u32 m_next_object_id { 1 };
     bool m_lost { false };
     GLenum m_pending_local_error { 0 };
+    bool m_may_have_gl_error { true };
 };
 
 }
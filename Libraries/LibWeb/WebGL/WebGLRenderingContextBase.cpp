@@ -285,9 +285,13 @@ GLenum WebGLRenderingContextBase::get_error_value()
     if (auto local_error = context().take_pending_local_error(); local_error != GL_NO_ERROR)
         return local_error;
 
-    auto context_error = context().get_error();
-    if (context_error != GL_NO_ERROR)
-        return context_error;
+    // OPTIMIZATION: Skip the round trip to the GL context if nothing reached it since it last reported no errors.
+    if (context().may_have_gl_error()) {
+        auto context_error = context().get_error();
+        if (context_error != GL_NO_ERROR)
+            return context_error;
+        context().did_find_no_gl_error();
+    }
 
     auto error = m_error;
     m_error = GL_NO_ERROR;
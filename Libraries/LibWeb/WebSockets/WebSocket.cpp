@@ -236,8 +236,8 @@ ErrorOr<void> WebSocket::establish_web_socket_connection(URL::URL const& url_rec
     m_websocket->on_open = GC::weak_callback(*this, [](auto& self) {
         self.on_open();
     });
-    m_websocket->on_message = GC::weak_callback(*this, [](auto& self, auto message) {
-        self.on_message(move(message.data), message.is_text);
+    m_websocket->on_messages = GC::weak_callback(*this, [](auto& self, auto messages) {
+        self.on_messages(move(messages));
     });
     m_websocket->on_close = GC::weak_callback(*this, [](auto& self, auto code, auto reason, bool was_clean) {
         self.on_close(code, Utf16String::from_utf8(StringView { reason.bytes() }), was_clean);
@@ -381,37 +381,46 @@ void WebSocket::on_close(u16 code, Utf16String reason, bool was_clean)
 }
 
 // https://websockets.spec.whatwg.org/#feedback-from-the-protocol
-void WebSocket::on_message(ByteBuffer message, bool is_text)
+void WebSocket::on_messages(Vector<Requests::WebSocket::Message> messages)
 {
     if (m_websocket->ready_state() != Requests::WebSocket::ReadyState::Open)
         return;
 
     // When a WebSocket message has been received with type type and data data, the user agent must queue a task to follow these steps:
-    HTML::queue_a_task(HTML::Task::Source::WebSocket, nullptr, nullptr, GC::create_function(heap(), [this, message = move(message), is_text] {
-        if (is_text) {
-            Bindings::MessageEventInit event_init;
-            event_init.data = JS::PrimitiveString::create(vm(), Utf16String::from_utf8(StringView { ReadonlyBytes(message) }));
-            dispatch_event(HTML::MessageEvent::create(realm(), HTML::EventNames::message, event_init, m_url.origin()));
-            return;
-        }
+    // OPTIMIZATION: Messages that RequestServer delivered together are handled by a single task, rather than queueing
+    //               one task per message. Microtasks still run between the message events, as each event listener
+    //               invocation performs a microtask checkpoint once it returns to an empty execution context stack.
+    HTML::queue_a_task(HTML::Task::Source::WebSocket, nullptr, nullptr, GC::create_function(heap(), [this, messages = move(messages)]() mutable {
+        for (auto& message : messages)
+            dispatch_message_event(move(message.data), message.is_text);
+    }));
+}
 
-        if (m_binary_type == "blob"sv) {
-            // type indicates that the data is Binary and binaryType is "blob"
-            Bindings::MessageEventInit event_init;
-            event_init.data = FileAPI::Blob::create(realm(), message, "text/plain;charset=utf-8"_utf16);
-            dispatch_event(HTML::MessageEvent::create(realm(), HTML::EventNames::message, event_init, m_url.origin()));
-            return;
-        } else if (m_binary_type == "arraybuffer"sv) {
-            // type indicates that the data is Binary and binaryType is "arraybuffer"
-            Bindings::MessageEventInit event_init;
-            event_init.data = JS::ArrayBuffer::create(realm(), message);
-            dispatch_event(HTML::MessageEvent::create(realm(), HTML::EventNames::message, event_init, m_url.origin()));
-            return;
-        }
+void WebSocket::dispatch_message_event(ByteBuffer message, bool is_text)
+{
+    if (is_text) {
+        Bindings::MessageEventInit event_init;
+        event_init.data = JS::PrimitiveString::create(vm(), Utf16String::from_utf8(StringView { ReadonlyBytes(message) }));
+        dispatch_event(HTML::MessageEvent::create(realm(), HTML::EventNames::message, event_init, m_url.origin()));
+        return;
+    }
 
-        dbgln("Unsupported WebSocket message type {}", m_binary_type);
-        TODO();
-    }));
+    if (m_binary_type == "blob"sv) {
+        // type indicates that the data is Binary and binaryType is "blob"
+        Bindings::MessageEventInit event_init;
+        event_init.data = FileAPI::Blob::create(realm(), message, "text/plain;charset=utf-8"_utf16);
+        dispatch_event(HTML::MessageEvent::create(realm(), HTML::EventNames::message, event_init, m_url.origin()));
+        return;
+    } else if (m_binary_type == "arraybuffer"sv) {
+        // type indicates that the data is Binary and binaryType is "arraybuffer"
+        Bindings::MessageEventInit event_init;
+        event_init.data = JS::ArrayBuffer::create(realm(), message);
+        dispatch_event(HTML::MessageEvent::create(realm(), HTML::EventNames::message, event_init, m_url.origin()));
+        return;
+    }
+
+    dbgln("Unsupported WebSocket message type {}", m_binary_type);
+    TODO();
 }
 
 // https://websockets.spec.whatwg.org/#make-disappear
@@ -65,7 +65,8 @@ public:
 
 private:
     void on_open();
-    void on_message(ByteBuffer message, bool is_text);
+    void on_messages(Vector<Requests::WebSocket::Message>);
+    void dispatch_message_event(ByteBuffer message, bool is_text);
     void on_error();
     void on_close(u16 code, Utf16String reason, bool was_clean);
 
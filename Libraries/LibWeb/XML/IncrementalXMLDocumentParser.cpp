@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/TemporaryChange.h>
+#include <AK/Utf16String.h>
+#include <LibGC/Function.h>
+#include <LibJS/Runtime/Value.h>
+#include <LibTextCodec/Decoder.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/DocumentLoading.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
+#include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
+#include <LibWeb/XML/IncrementalXMLDocumentParser.h>
+
+namespace Web {
+
+GC_DEFINE_ALLOCATOR(IncrementalXMLDocumentParser);
+
+GC::Ref<IncrementalXMLDocumentParser> IncrementalXMLDocumentParser::create(GC::Ref<DOM::Document> document, GC::Ref<Fetch::Infrastructure::Body> body, Optional<String> content_encoding)
+{
+    return document->realm().create<IncrementalXMLDocumentParser>(document, body, move(content_encoding));
+}
+
+IncrementalXMLDocumentParser::IncrementalXMLDocumentParser(GC::Ref<DOM::Document> document, GC::Ref<Fetch::Infrastructure::Body> body, Optional<String> content_encoding)
+    : m_document(document)
+    , m_body(body)
+    , m_content_encoding(move(content_encoding))
+{
+}
+
+void IncrementalXMLDocumentParser::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_document);
+    visitor.visit(m_body);
+    if (m_builder)
+        m_builder->visit_edges(visitor);
+}
+
+void IncrementalXMLDocumentParser::start()
+{
+    auto parser = GC::Ref { *this };
+    m_body->wait_for_sniff_bytes(GC::create_function(heap(), [parser](ReadonlyBytes sniff_bytes) {
+        parser->initialize_parser(sniff_bytes);
+    }));
+}
+
+void IncrementalXMLDocumentParser::initialize_parser(ReadonlyBytes sniff_bytes)
+{
+    if (m_parser)
+        return;
+
+    // The actual HTTP headers and other metadata, not the headers as mutated or implied by the algorithms given in this specification,
+    // are the ones that must be used when determining the character encoding according to the rules given in the above specifications.
+    Optional<StringView> standardized_encoding;
+    if (m_content_encoding.has_value())
+        standardized_encoding = TextCodec::get_standardized_encoding(*m_content_encoding);
+    if (!standardized_encoding.has_value()) {
+        // https://www.w3.org/TR/xml/#charencoding
+        // [...] it is a fatal error [...] for an entity which begins with neither a Byte Order Mark nor an encoding
+        // declaration to use an encoding other than UTF-8.
+        auto bom_encoding = HTML::run_bom_sniff(sniff_bytes);
+        standardized_encoding = TextCodec::get_standardized_encoding(bom_encoding.has_value() ? bom_encoding->view() : "UTF-8"sv);
+    }
+    VERIFY(standardized_encoding.has_value());
+
+    // Well-formed XML documents contain only properly encoded characters
+    m_decoder = make<TextCodec::StreamingDecoder>(standardized_encoding.value(), TextCodec::IgnoreBOM::No, TextCodec::ErrorMode::Fatal);
+    m_builder = make<XMLDocumentBuilder>(m_document);
+    m_parser = make<XML::StreamingParser>(*m_builder, XML::Parser::Options { .preserve_cdata = true, .preserve_comments = true, .resolve_named_html_entity = resolve_named_html_entity });
+
+    auto parser = GC::Ref { *this };
+    m_body->incrementally_read(
+        GC::create_function(heap(), [parser](ByteBuffer bytes) mutable {
+            parser->process_body_chunk(move(bytes));
+        }),
+        GC::create_function(heap(), [parser] {
+            parser->process_end_of_body();
+        }),
+        GC::create_function(heap(), [parser](JS::Value error) {
+            parser->process_body_error(error);
+        }),
+        GC::Ref { m_document->realm().global_object() });
+}
+
+void IncrementalXMLDocumentParser::process_body_chunk(ByteBuffer bytes)
+{
+    if (m_has_failed)
+        return;
+
+    append_decoded_input(m_decoder->to_utf8(bytes.bytes()));
+}
+
+void IncrementalXMLDocumentParser::process_end_of_body()
+{
+    if (m_has_failed)
+        return;
+
+    m_received_end_of_body = true;
+    append_decoded_input(m_decoder->finish());
+}
+
+void IncrementalXMLDocumentParser::process_body_error(JS::Value)
+{
+    dbgln("FIXME: Load XML page with an error if incremental read of body failed.");
+}
+
+void IncrementalXMLDocumentParser::append_decoded_input(ErrorOr<String> decoded)
+{
+    if (decoded.is_error()) {
+        // FIXME: Insert error message into the document.
+        dbgln("Failed to decode XML document: {}", decoded.error());
+        fail(Utf16String::formatted("Failed to decode XML document: {}", decoded.error()));
+        return;
+    }
+
+    m_pending_input.append(decoded.value().bytes());
+    m_source.append(decoded.value());
+    pump();
+}
+
+void IncrementalXMLDocumentParser::pump()
+{
+    // NB: Scripts run by the document builder may spin the event loop, which can deliver more of the body to us. That
+    //     input waits until the parser has returned to the loop below.
+    if (m_is_parsing || m_has_failed || !m_parser || m_parser->is_finished())
+        return;
+
+    // Before any script execution occurs, the user agent must wait for scripts may run for the newly-created document to be
+    // true for the newly-created Document.
+    if (!m_document->ready_to_run_scripts()) {
+        if (m_document->has_deferred_parser_start())
+            return;
+
+        auto parser = GC::Ref { *this };
+        m_document->set_deferred_parser_start(GC::create_function(heap(), [parser] {
+            parser->pump();
+        }));
+        return;
+    }
+
+    TemporaryChange is_parsing_change { m_is_parsing, true };
+
+    while (!m_pending_input.is_empty()) {
+        auto input = move(m_pending_input);
+        if (auto result = m_parser->parse_chunk(StringView { input.bytes() }); result.is_error()) {
+            // FIXME: Insert error message into the document.
+            dbgln("Failed to parse XML document: {}", result.error());
+            fail(Utf16String::formatted("Failed to parse XML document: {}", result.error()));
+            return;
+        }
+        if (m_has_failed)
+            return;
+    }
+
+    if (!m_received_end_of_body)
+        return;
+
+    m_document->set_source(Utf16String::from_utf8_with_replacement_character(m_source.string_view()));
+    m_source.clear();
+
+    if (auto result = m_parser->finish(); result.is_error()) {
+        // FIXME: Insert error message into the document.
+        dbgln("Failed to parse XML document: {}", result.error());
+        fail(Utf16String::formatted("Failed to parse XML document: {}", result.error()));
+    }
+}
+
+void IncrementalXMLDocumentParser::fail(Utf16String error_string)
+{
+    // NB: The parser may still be on the stack below us, so it stays alive until we're collected.
+    m_has_failed = true;
+    m_pending_input.clear();
+    m_source.clear();
+    convert_to_xml_error_document(m_document, move(error_string));
+}
+
+}
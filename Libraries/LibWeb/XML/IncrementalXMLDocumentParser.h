@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibTextCodec/Decoder.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/XML/XMLDocumentBuilder.h>
+#include <LibXML/Parser/Parser.h>
+
+namespace Web {
+
+// Builds an XML document from a response body as its bytes arrive, rather than once all of them have been read.
+class WEB_API IncrementalXMLDocumentParser final : public JS::Cell {
+    GC_CELL(IncrementalXMLDocumentParser, JS::Cell);
+    GC_DECLARE_ALLOCATOR(IncrementalXMLDocumentParser);
+
+public:
+    static GC::Ref<IncrementalXMLDocumentParser> create(GC::Ref<DOM::Document>, GC::Ref<Fetch::Infrastructure::Body>, Optional<String> content_encoding);
+
+    void start();
+
+private:
+    IncrementalXMLDocumentParser(GC::Ref<DOM::Document>, GC::Ref<Fetch::Infrastructure::Body>, Optional<String> content_encoding);
+
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    void initialize_parser(ReadonlyBytes sniff_bytes);
+    void process_body_chunk(ByteBuffer);
+    void process_end_of_body();
+    void process_body_error(JS::Value);
+
+    void append_decoded_input(ErrorOr<String>);
+    void pump();
+    void fail(Utf16String error_string);
+
+    GC::Ref<DOM::Document> m_document;
+    GC::Ref<Fetch::Infrastructure::Body> m_body;
+    Optional<String> m_content_encoding;
+
+    OwnPtr<TextCodec::StreamingDecoder> m_decoder;
+    OwnPtr<XMLDocumentBuilder> m_builder;
+    OwnPtr<XML::StreamingParser> m_parser;
+
+    // Decoded input waits here until scripts may run in the document, and while the parser is busy with earlier input.
+    ByteBuffer m_pending_input;
+    StringBuilder m_source;
+    bool m_received_end_of_body { false };
+    bool m_is_parsing { false };
+    bool m_has_failed { false };
+};
+
+}
@@ -52,9 +52,15 @@ XMLDocumentBuilder::XMLDocumentBuilder(DOM::Document& document, XMLScriptingSupp
     m_namespace_stack.append({ {}, 1 });
 }
 
-ErrorOr<void> XMLDocumentBuilder::set_source(ByteString source)
+void XMLDocumentBuilder::visit_edges(JS::Cell::Visitor& visitor)
 {
-    m_document->set_source(Utf16String::from_utf8_with_replacement_character(source.view()));
+    visitor.visit(m_document);
+    visitor.visit(m_current_node);
+}
+
+ErrorOr<void> XMLDocumentBuilder::set_source(StringView source)
+{
+    m_document->set_source(Utf16String::from_utf8_with_replacement_character(source));
     return {};
 }
 
@@ -89,6 +95,8 @@ void XMLDocumentBuilder::element_start(Utf16FlyString const& name, Vector<XML::L
     if (m_has_error)
         return;
 
+    flush_pending_text();
+
     Vector<NamespaceAndPrefix, 2> namespaces;
     for (auto const& attribute : attributes) {
         if (attribute.name == "xmlns"sv || attribute.name.starts_with("xmlns:"sv)) {
@@ -197,6 +205,8 @@ void XMLDocumentBuilder::element_end(Utf16FlyString const& name)
     if (m_has_error)
         return;
 
+    flush_pending_text();
+
     if (--m_namespace_stack.last().depth == 0) {
         m_namespace_stack.take_last();
     }
@@ -254,16 +264,28 @@ void XMLDocumentBuilder::text(StringView data)
     if (m_has_error)
         return;
 
+    // NB: The parser reports long runs of text in many small pieces. Rather than growing a text node with each of them,
+    //     we collect them until something other than text comes along.
+    MUST(m_pending_text.try_append(data));
+}
+
+void XMLDocumentBuilder::flush_pending_text()
+{
+    if (m_pending_text.is_empty() || !m_current_node)
+        return;
+
     if (auto* last = m_current_node->last_child(); last && last->is_text()) {
         auto& text_node = static_cast<DOM::Text&>(*last);
-        m_text_builder.append(text_node.data());
-        m_text_builder.append(Utf16String::from_utf8(data));
-        text_node.set_data(m_text_builder.to_string());
-        m_text_builder.clear();
-    } else if (!data.is_empty()) {
-        auto node = m_document->create_text_node(Utf16String::from_utf8(data));
+        Utf16StringBuilder builder;
+        builder.append(text_node.data());
+        builder.append(m_pending_text.view());
+        text_node.set_data(builder.to_string());
+    } else {
+        auto node = m_document->create_text_node(m_pending_text.to_string());
         MUST(m_current_node->append_child(node));
     }
+
+    m_pending_text.clear();
 }
 
 void XMLDocumentBuilder::comment(StringView data)
@@ -271,6 +293,8 @@ void XMLDocumentBuilder::comment(StringView data)
     if (m_has_error || !m_current_node)
         return;
 
+    flush_pending_text();
+
     MUST(m_current_node->append_child(m_document->create_comment(Utf16String::from_utf8(data))));
 }
 
@@ -279,6 +303,8 @@ void XMLDocumentBuilder::cdata_section(StringView data)
     if (m_has_error || !m_current_node)
         return;
 
+    flush_pending_text();
+
     auto section = MUST(m_document->create_cdata_section(Utf16String::from_utf8(data)));
     MUST(m_current_node->append_child(section));
 }
@@ -288,6 +314,8 @@ void XMLDocumentBuilder::processing_instruction(Utf16FlyString const& target, Ut
     if (m_has_error || !m_current_node)
         return;
 
+    flush_pending_text();
+
     auto processing_instruction = MUST(m_document->create_processing_instruction(target, data));
     MUST(m_current_node->append_child(processing_instruction));
 }
@@ -300,6 +328,9 @@ void XMLDocumentBuilder::document_end()
     // If the active speculative HTML parser is not null, then stop the speculative HTML parser and return.
     // NOTE: Noop.
 
+    if (!m_has_error)
+        flush_pending_text();
+
     // Set the insertion point to undefined.
     m_template_node_stack.clear();
     m_current_node = nullptr;
@@ -30,8 +30,10 @@ public:
 
     bool has_error() const { return m_has_error; }
 
+    void visit_edges(JS::Cell::Visitor&);
+
 private:
-    virtual ErrorOr<void> set_source(ByteString) override;
+    virtual ErrorOr<void> set_source(StringView) override;
     virtual void set_doctype(XML::Doctype) override;
     virtual void element_start(Utf16FlyString const& name, Vector<XML::ListenerAttribute> const& attributes) override;
     virtual void element_end(Utf16FlyString const& name) override;
@@ -47,13 +49,14 @@ private:
     };
 
     Optional<Utf16FlyString> namespace_for_name(Utf16FlyString const&);
+    void flush_pending_text();
 
     GC::Ref<DOM::Document> m_document;
     GC::RootVector<GC::Ref<DOM::Node>> m_template_node_stack;
     GC::Ptr<DOM::Node> m_current_node;
     XMLScriptingSupport m_scripting_support { XMLScriptingSupport::Enabled };
     bool m_has_error { false };
-    Utf16StringBuilder m_text_builder;
+    Utf16StringBuilder m_pending_text;
 
     struct NamespaceStackEntry {
         Vector<NamespaceAndPrefix, 2> namespaces;
@@ -165,45 +165,130 @@ static void convert_xpath_result(xmlXPathObjectPtr xpath_result, XPath::XPathRes
     }
 }
 
-WebIDL::ExceptionOr<GC::Ref<XPathExpression>> create_expression(JS::Realm& realm, Utf16View expression, GC::Ptr<XPathNSResolver> resolver)
+OwnPtr<CompiledExpression> CompiledExpression::compile(Utf16View expression)
 {
-    return realm.create<XPathExpression>(realm, expression, resolver);
+    auto expression_bytes = expression.to_byte_string().release_value_but_fixme_should_propagate_errors();
+    auto* xml_expression = xmlXPathCompile(bit_cast<xmlChar const*>(expression_bytes.characters()));
+    if (!xml_expression)
+        return nullptr;
+    return adopt_own(*new CompiledExpression(Utf16String::from_utf16(expression), xml_expression));
 }
 
-WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(JS::Realm& realm, Utf16View expression, DOM::Node const& context_node, GC::Ptr<XPathNSResolver> /*resolver*/, unsigned short type, GC::Ptr<XPathResult> result)
+CompiledExpression::CompiledExpression(Utf16String expression, xmlXPathCompExprPtr xml_expression)
+    : m_expression(move(expression))
+    , m_xml_expression(xml_expression)
 {
-    // Parse the expression as xpath
-    auto expression_bytes = expression.to_byte_string().release_value_but_fixme_should_propagate_errors();
-    auto* xpath_compiled = xmlXPathCompile(bit_cast<xmlChar const*>(expression_bytes.characters()));
-    if (!xpath_compiled)
-        return WebIDL::SyntaxError::create(realm, "Invalid XPath expression"_utf16);
-    ScopeGuard xpath_compiled_cleanup = [&] { xmlXPathFreeCompExpr(xpath_compiled); };
+}
+
+CompiledExpression::~CompiledExpression()
+{
+    xmlXPathFreeCompExpr(m_xml_expression);
+}
 
-    auto* xml_document = xmlNewDoc(nullptr);
-    ScopeGuard xml_cleanup = [&] { xmlFreeDoc(xml_document); };
+NonnullOwnPtr<MirroredTree> MirroredTree::create(DOM::Node const& root)
+{
+    return adopt_own(*new MirroredTree(root));
+}
 
-    if (context_node.type() == DOM::NodeType::DOCUMENT_NODE) {
-        xml_document->_private = bit_cast<void*>(&context_node);
+MirroredTree::MirroredTree(DOM::Node const& root)
+    : m_root(root)
+    , m_dom_tree_version(root.document().dom_tree_version())
+    , m_character_data_version(root.document().character_data_version())
+    , m_xml_document(xmlNewDoc(nullptr))
+{
+    if (root.type() == DOM::NodeType::DOCUMENT_NODE) {
+        m_xml_document->_private = bit_cast<void*>(&root);
     } else {
-        xml_document->_private = bit_cast<void*>(&context_node.document());
+        m_xml_document->_private = bit_cast<void*>(&root.document());
     }
 
-    auto* xml_node = mirror_node(xml_document, context_node);
-    if (!xml_node) {
-        return WebIDL::OperationError::create(realm, "XPath evaluation failed"_utf16);
+    m_xml_root = mirror_node(m_xml_document, root);
+    if (m_xml_root)
+        xmlDocSetRootElement(m_xml_document, m_xml_root);
+}
+
+MirroredTree::~MirroredTree()
+{
+    for (auto& it : m_results)
+        xmlXPathFreeObject(it.value);
+    xmlFreeDoc(m_xml_document);
+}
+
+bool MirroredTree::is_current_for(DOM::Node const& root) const
+{
+    if (m_root.ptr() != &root)
+        return false;
+    return m_dom_tree_version == root.document().dom_tree_version()
+        && m_character_data_version == root.document().character_data_version();
+}
+
+xmlXPathObjectPtr MirroredTree::cached_result(Utf16View expression) const
+{
+    return m_results.get(expression).value_or(nullptr);
+}
+
+xmlXPathObjectPtr MirroredTree::evaluate(CompiledExpression const& expression)
+{
+    VERIFY(m_xml_root);
+
+    if (auto* result = cached_result(expression.expression()))
+        return result;
+
+    auto* xpath_context = xmlXPathNewContext(m_xml_document);
+    ScopeGuard xpath_context_cleanup = [&] { xmlXPathFreeContext(xpath_context); };
+    xmlXPathSetContextNode(m_xml_root, xpath_context);
+
+    auto* xpath_result = xmlXPathCompiledEval(expression.xml_expression(), xpath_context);
+    if (!xpath_result)
+        return nullptr;
+
+    // NB: Scripts and WebDriver clients tend to evaluate the same few expressions over and over, so a small cache
+    //     is enough. It starts over rather than keeping track of which results were used last.
+    if (m_results.size() >= max_cached_results) {
+        for (auto& it : m_results)
+            xmlXPathFreeObject(it.value);
+        m_results.clear();
     }
+    m_results.set(expression.expression(), xpath_result);
+    return xpath_result;
+}
 
-    xmlDocSetRootElement(xml_document, xml_node);
+WebIDL::ExceptionOr<GC::Ref<XPathExpression>> create_expression(JS::Realm& realm, Utf16View expression, GC::Ptr<XPathNSResolver> resolver)
+{
+    auto compiled_expression = CompiledExpression::compile(expression);
+    if (!compiled_expression)
+        return WebIDL::SyntaxError::create(realm, "Invalid XPath expression"_utf16);
+    return realm.create<XPathExpression>(realm, compiled_expression.release_nonnull(), resolver);
+}
 
-    auto* xpath_context = xmlXPathNewContext(xml_document);
-    xmlXPathSetContextNode(xml_node, xpath_context);
+WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(JS::Realm& realm, Utf16View expression, DOM::Node const& context_node, GC::Ptr<XPathNSResolver> /*resolver*/, unsigned short type, GC::Ptr<XPathResult> result)
+{
+    // OPTIMIZATION: An expression that was evaluated against the same unchanged subtree before doesn't need to be
+    //               parsed again.
+    auto& mirrored_tree = context_node.document().xpath_mirrored_tree_for(context_node);
+    if (auto* xpath_result = mirrored_tree.cached_result(expression)) {
+        if (!result)
+            result = realm.create<XPathResult>(realm);
+        convert_xpath_result(xpath_result, result, type);
+        return GC::Ref<XPathResult>(*result);
+    }
 
-    auto* xpath_result = xmlXPathCompiledEval(xpath_compiled, xpath_context);
+    // Parse the expression as xpath
+    auto compiled_expression = CompiledExpression::compile(expression);
+    if (!compiled_expression)
+        return WebIDL::SyntaxError::create(realm, "Invalid XPath expression"_utf16);
+
+    return evaluate(realm, *compiled_expression, context_node, type, result);
+}
+
+WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(JS::Realm& realm, CompiledExpression const& expression, DOM::Node const& context_node, unsigned short type, GC::Ptr<XPathResult> result)
+{
+    // OPTIMIZATION: The subtree is only copied into a libxml2 document again once it has changed.
+    auto& mirrored_tree = context_node.document().xpath_mirrored_tree_for(context_node);
+    if (!mirrored_tree.has_root())
+        return WebIDL::OperationError::create(realm, "XPath evaluation failed"_utf16);
 
-    ScopeGuard xpath_result_cleanup = [&] {
-        xmlXPathFreeObject(xpath_result);
-        xmlXPathFreeContext(xpath_context);
-    };
+    auto* xpath_result = mirrored_tree.evaluate(expression);
 
     if (!result) {
         result = realm.create<XPathResult>(realm);
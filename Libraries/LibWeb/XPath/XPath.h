@@ -6,16 +6,83 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Utf16String.h>
 #include <LibGC/Ptr.h>
+#include <LibGC/Weak.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
 
 #include "XPathExpression.h"
 #include "XPathNSResolver.h"
 #include "XPathResult.h"
 
+struct _xmlDoc;
+struct _xmlNode;
+struct _xmlXPathCompExpr;
+struct _xmlXPathObject;
+
 namespace Web::XPath {
 
+// An expression that has been parsed by libxml2, which can then be evaluated any number of times.
+class CompiledExpression {
+    AK_MAKE_NONCOPYABLE(CompiledExpression);
+    AK_MAKE_NONMOVABLE(CompiledExpression);
+
+public:
+    // Returns null if the expression is not a valid XPath expression.
+    static OwnPtr<CompiledExpression> compile(Utf16View expression);
+    ~CompiledExpression();
+
+    Utf16String const& expression() const { return m_expression; }
+    _xmlXPathCompExpr* xml_expression() const { return m_xml_expression; }
+
+private:
+    CompiledExpression(Utf16String expression, _xmlXPathCompExpr*);
+
+    Utf16String m_expression;
+    _xmlXPathCompExpr* m_xml_expression { nullptr };
+};
+
+// A copy of a DOM subtree in the tree format of libxml2, which evaluates expressions against it. Documents keep the one
+// they built last, so that repeated evaluations against an unchanged subtree neither copy it nor evaluate again.
+class MirroredTree {
+    AK_MAKE_NONCOPYABLE(MirroredTree);
+    AK_MAKE_NONMOVABLE(MirroredTree);
+
+public:
+    static NonnullOwnPtr<MirroredTree> create(DOM::Node const& root);
+    ~MirroredTree();
+
+    bool is_current_for(DOM::Node const& root) const;
+    bool has_root() const { return m_xml_root; }
+
+    // Returns the result of an earlier evaluation of the expression, if there was one that succeeded.
+    _xmlXPathObject* cached_result(Utf16View expression) const;
+
+    // Returns the result of evaluating the expression with the root as the context node, or null if evaluation failed.
+    _xmlXPathObject* evaluate(CompiledExpression const&);
+
+private:
+    static constexpr size_t max_cached_results = 64;
+
+    explicit MirroredTree(DOM::Node const& root);
+
+    GC::Weak<DOM::Node> m_root;
+    u64 m_dom_tree_version { 0 };
+    u64 m_character_data_version { 0 };
+
+    // NB: These point back at the DOM nodes that they were copied from, which are still in the subtree for as long as
+    //     the document's versions are unchanged.
+    _xmlDoc* m_xml_document { nullptr };
+    _xmlNode* m_xml_root { nullptr };
+
+    HashMap<Utf16String, _xmlXPathObject*> m_results;
+};
+
 WebIDL::ExceptionOr<GC::Ref<XPathExpression>> create_expression(JS::Realm& realm, Utf16View expression, GC::Ptr<XPathNSResolver> resolver);
 WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(JS::Realm& realm, Utf16View expression, DOM::Node const& context_node, GC::Ptr<XPathNSResolver> resolver, unsigned short type, GC::Ptr<XPathResult> result);
+WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(JS::Realm& realm, CompiledExpression const& expression, DOM::Node const& context_node, unsigned short type, GC::Ptr<XPathResult> result);
 
 }
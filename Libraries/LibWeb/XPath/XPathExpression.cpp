@@ -20,9 +20,9 @@ namespace Web::XPath {
 
 GC_DEFINE_ALLOCATOR(XPathExpression);
 
-XPathExpression::XPathExpression(JS::Realm& realm, Utf16View expression, GC::Ptr<XPathNSResolver> resolver)
+XPathExpression::XPathExpression(JS::Realm& realm, NonnullOwnPtr<CompiledExpression> compiled_expression, GC::Ptr<XPathNSResolver> resolver)
     : Web::Bindings::PlatformObject(realm)
-    , m_expression(Utf16String::from_utf16(expression))
+    , m_compiled_expression(move(compiled_expression))
     , m_resolver(resolver)
 {
 }
@@ -44,7 +44,7 @@ XPathExpression::~XPathExpression() = default;
 WebIDL::ExceptionOr<GC::Ref<XPathResult>> XPathExpression::evaluate(DOM::Node const& context_node, WebIDL::UnsignedShort type, GC::Ptr<XPathResult> result)
 {
     auto& realm = this->realm();
-    return XPath::evaluate(realm, m_expression, context_node, m_resolver, type, result);
+    return XPath::evaluate(realm, *m_compiled_expression, context_node, type, result);
 }
 
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/NonnullOwnPtr.h>
 #include <LibWeb/Bindings/PlatformObject.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/WebIDL/Types.h>
@@ -19,7 +20,7 @@ class XPathExpression final : public Bindings::PlatformObject {
     GC_DECLARE_ALLOCATOR(XPathExpression);
 
 public:
-    explicit XPathExpression(JS::Realm&, Utf16View expression, GC::Ptr<XPathNSResolver> resolver);
+    XPathExpression(JS::Realm&, NonnullOwnPtr<CompiledExpression>, GC::Ptr<XPathNSResolver> resolver);
     virtual ~XPathExpression() override;
     virtual void visit_edges(Cell::Visitor&) override;
     virtual void initialize(JS::Realm&) override;
@@ -27,7 +28,7 @@ public:
     WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(DOM::Node const& context_node, WebIDL::UnsignedShort type = 0, GC::Ptr<XPathResult> result = nullptr);
 
 private:
-    Utf16String m_expression;
+    NonnullOwnPtr<CompiledExpression> m_compiled_expression;
     GC::Ptr<XPathNSResolver> m_resolver;
 };
 
@@ -16,12 +16,15 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/Environment.h>
 #include <LibCore/File.h>
+#include <LibCore/MemoryPressureNotifier.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibCore/TimeZoneWatcher.h>
+#include <LibCore/TraceEvent.h>
 #include <LibDatabase/Database.h>
 #include <LibDevTools/DevToolsServer.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibIPC/Statistics.h>
 #include <LibIPC/TransportHandle.h>
 #include <LibImageDecoderClient/Client.h>
 #include <LibURL/InternalURLs.h>
@@ -35,6 +38,7 @@
 #include <LibWebView/CompositorClient.h>
 #include <LibWebView/CookieJar.h>
 #include <LibWebView/HSTSStore.h>
+#include <LibWebView/HeadlessBatchRenderer.h>
 #include <LibWebView/HeadlessWebView.h>
 #include <LibWebView/HelperProcess.h>
 #include <LibWebView/HistoryStore.h>
@@ -167,7 +171,7 @@ Application::~Application()
     if (m_compositor_client)
         m_compositor_client->on_death = nullptr;
 
-    m_spare_web_content_process = nullptr;
+    m_spare_web_content_processes.clear();
     m_process_manager = nullptr;
     m_browser_process = nullptr;
 
@@ -242,6 +246,8 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     Optional<int> window_width;
     Optional<int> window_height;
     Optional<u32> screenshot_delay;
+    Optional<u32> spare_web_content_process_count;
+    Optional<size_t> batch_job_count;
     Optional<StringView> screenshot_path;
     bool new_window = false;
     bool force_new_process = false;
@@ -265,6 +271,9 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     bool log_all_js_exceptions = false;
     auto site_isolation_mode = SiteIsolationMode::TopLevel;
     bool enable_idl_tracing = false;
+    bool enable_ipc_statistics = false;
+    StringView trace_categories;
+    bool enable_hardware_video_decoding = false;
     bool disable_http_memory_cache = false;
     bool disable_http_disk_cache = false;
     bool disable_content_blocker = false;
@@ -288,7 +297,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
 
     args_parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Optional,
-        .help_string = "Run Ladybird without a browser window. Mode may be 'screenshot' (default), 'layout-tree', 'text', or 'manual'.",
+        .help_string = "Run Ladybird without a browser window. Mode may be 'screenshot' (default), 'layout-tree', 'text', 'manual', or 'batch'.",
         .long_name = "headless",
         .value_name = "mode",
         .accept_value = [&](StringView value) {
@@ -303,6 +312,8 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
                 headless_mode = HeadlessMode::Text;
             else if (value.equals_ignoring_ascii_case("manual"sv))
                 headless_mode = HeadlessMode::Manual;
+            else if (value.equals_ignoring_ascii_case("batch"sv))
+                headless_mode = HeadlessMode::Batch;
 
             return headless_mode.has_value();
         },
@@ -310,6 +321,8 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
 
     args_parser.add_option(screenshot_delay, "Set the number of seconds to wait before taking a screenshot (only supported for headless screenshot mode)", "screenshot-delay", 0, "seconds");
     args_parser.add_option(screenshot_path, "Save screenshots to the given location (only supported for headless screenshot mode)", "screenshot-path", 0, "path");
+    args_parser.add_option(spare_web_content_process_count, "Set the number of WebContent processes to keep ready for new tabs (default: 1)", "spare-web-content-processes", 0, "count");
+    args_parser.add_option(batch_job_count, "Set the number of screenshots to take in parallel (default: number of cores) (only supported for headless batch mode)", "batch-jobs", 0, "count");
     args_parser.add_option(window_width, "Set viewport width in pixels (default: 800) (currently only supported for headless mode)", "window-width", 0, "pixels");
     args_parser.add_option(window_height, "Set viewport height in pixels (default: 600) (currently only supported for headless mode)", "window-height", 0, "pixels");
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
@@ -359,6 +372,21 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
         },
     });
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
+    args_parser.add_option(enable_ipc_statistics, "Record IPC traffic statistics for the task manager", "enable-ipc-statistics");
+    args_parser.add_option(Core::ArgsParser::Option {
+        .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
+        .help_string = "Record trace events in every process. Categories may be 'all' or a comma-separated list of 'event-loop', 'ipc', 'gc', 'style', 'layout', 'paint', 'raster', 'network', and 'decode'.",
+        .long_name = "trace-categories",
+        .value_name = "categories",
+        .accept_value = [&](StringView value) {
+            if (!Core::trace_categories_from_string(value).has_value())
+                return false;
+
+            trace_categories = value;
+            return true;
+        },
+    });
+    args_parser.add_option(enable_hardware_video_decoding, "Decode video on the GPU where supported", "enable-hardware-video-decoding");
     args_parser.add_option(disable_http_memory_cache, "Disable HTTP memory cache", "disable-http-memory-cache");
     args_parser.add_option(disable_http_disk_cache, "Disable HTTP disk cache", "disable-http-disk-cache");
     args_parser.add_option(disable_content_blocker, "Disable content blocker", "disable-content-blocker");
@@ -569,6 +597,10 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
         m_browser_options.screenshot_delay = *screenshot_delay;
     if (screenshot_path.has_value())
         m_browser_options.screenshot_path = *screenshot_path;
+    if (spare_web_content_process_count.has_value())
+        m_browser_options.spare_web_content_process_count = *spare_web_content_process_count;
+    if (batch_job_count.has_value())
+        m_browser_options.batch_job_count = *batch_job_count;
     if (window_width.has_value())
         m_browser_options.window_width = *window_width;
     if (window_height.has_value())
@@ -595,6 +627,8 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
         .log_all_js_exceptions = log_all_js_exceptions ? LogAllJSExceptions::Yes : LogAllJSExceptions::No,
         .site_isolation_mode = site_isolation_mode,
         .enable_idl_tracing = enable_idl_tracing ? EnableIDLTracing::Yes : EnableIDLTracing::No,
+        .enable_ipc_statistics = enable_ipc_statistics ? EnableIPCStatistics::Yes : EnableIPCStatistics::No,
+        .enable_hardware_video_decoding = enable_hardware_video_decoding ? EnableHardwareVideoDecoding::Yes : EnableHardwareVideoDecoding::No,
         .enable_http_memory_cache = disable_http_memory_cache ? EnableMemoryHTTPCache::No : EnableMemoryHTTPCache::Yes,
         .expose_experimental_interfaces = expose_experimental_interfaces ? ExposeExperimentalInterfaces::Yes : ExposeExperimentalInterfaces::No,
         .expose_internals_object = expose_internals_object ? ExposeInternalsObject::Yes : ExposeInternalsObject::No,
@@ -623,6 +657,11 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
 
     set_site_isolation_mode(m_web_content_options.site_isolation_mode);
 
+    if (m_web_content_options.enable_ipc_statistics == EnableIPCStatistics::Yes)
+        IPC::Statistics::set_enabled(true);
+
+    Core::TraceEvents::initialize_for_main_thread(trace_categories);
+
     if (auto result = load_content_blocker_lists(); result.is_error()) {
         warnln("\033[31;1mUnable to load all content blocker lists:\033[0m {}", result.error());
         warnln("    Configured lists: {}", m_browser_options.content_blocker_list_paths);
@@ -962,13 +1001,49 @@ void Application::crash_compositor_process()
     m_compositor_client->async_crash();
 }
 
+void Application::set_trace_categories(Core::TraceCategory categories)
+{
+    Core::TraceEvents::set_enabled_categories(categories);
+
+    if (can_send_compositor_process_ipc(m_compositor_client))
+        m_compositor_client->async_set_trace_categories(categories);
+    if (m_image_decoder_client)
+        m_image_decoder_client->async_set_trace_categories(categories);
+    if (m_request_server_client)
+        m_request_server_client->async_set_trace_categories(categories);
+    if (m_private_request_server_client)
+        m_private_request_server_client->async_set_trace_categories(categories);
+
+    WebContentClient::for_each_client([&](WebContentClient& client) {
+        client.async_set_trace_categories(categories);
+        return IterationDecision::Continue;
+    });
+}
+
+Vector<String> Application::collect_trace_event_json()
+{
+    Vector<String> traces;
+    traces.append(Core::TraceEvents::to_trace_event_json("Browser"sv));
+
+    if (can_send_compositor_process_ipc(m_compositor_client))
+        traces.append(m_compositor_client->get_trace_event_json());
+    if (m_image_decoder_client)
+        traces.append(m_image_decoder_client->get_trace_event_json());
+    if (m_request_server_client)
+        traces.append(m_request_server_client->get_trace_event_json());
+    if (m_private_request_server_client)
+        traces.append(m_private_request_server_client->get_trace_event_json());
+
+    return traces;
+}
+
 ErrorOr<NonnullRefPtr<WebContentClient>> Application::launch_web_content_process(ViewImplementation& view)
 {
     if (view.is_private() == IsPrivate::Yes)
         return create_web_content_client(view, IsPrivate::Yes, allocate_page_id());
 
-    if (m_spare_web_content_process) {
-        auto web_content_client = m_spare_web_content_process.release_nonnull();
+    if (!m_spare_web_content_processes.is_empty()) {
+        auto web_content_client = m_spare_web_content_processes.take_first();
         launch_spare_web_content_process();
 
         web_content_client->assign_view({}, view);
@@ -1003,23 +1078,32 @@ void Application::launch_spare_web_content_process()
     if (browser_options().profile_helper_process == ProcessType::WebContent)
         return;
 
+    if (m_spare_web_content_processes.size() >= browser_options().spare_web_content_process_count)
+        return;
+
     if (m_has_queued_task_to_launch_spare_web_content_process)
         return;
     m_has_queued_task_to_launch_spare_web_content_process = true;
 
+    // NB: Spare processes are launched one per event loop iteration, so that refilling the pool after a burst of new
+    //     tabs doesn't block the UI for the whole time.
     Core::deferred_invoke([this]() {
         m_has_queued_task_to_launch_spare_web_content_process = false;
 
+        if (m_spare_web_content_processes.size() >= browser_options().spare_web_content_process_count)
+            return;
+
         auto web_content_client = create_web_content_client({}, IsPrivate::No, allocate_page_id());
         if (web_content_client.is_error()) {
             dbgln("Unable to create spare web content client: {}", web_content_client.error());
             return;
         }
 
-        m_spare_web_content_process = web_content_client.release_value();
-
-        if (auto process = find_process(m_spare_web_content_process->pid()); process.has_value())
+        if (auto process = find_process(web_content_client.value()->pid()); process.has_value())
             process->set_title("(spare)"_utf16);
+
+        m_spare_web_content_processes.append(web_content_client.release_value());
+        launch_spare_web_content_process();
     });
 }
 
@@ -1127,6 +1211,22 @@ ErrorOr<void> Application::launch_services()
         }
     }
 
+    if (auto memory_pressure_notifier = Core::MemoryPressureNotifier::create(); memory_pressure_notifier.is_error()) {
+        dbgln("Unable to monitor system memory pressure: {}", memory_pressure_notifier.error());
+    } else {
+        m_memory_pressure_notifier = memory_pressure_notifier.release_value();
+
+        m_memory_pressure_notifier->on_memory_pressure = [this](Core::MemoryPressureLevel level) {
+            WebContentClient::for_each_client([&](WebView::WebContentClient& client) {
+                client.async_did_receive_memory_pressure(level);
+                return IterationDecision::Continue;
+            });
+
+            if (m_image_decoder_client)
+                m_image_decoder_client->async_did_receive_memory_pressure(level);
+        };
+    }
+
     TRY(launch_request_server());
     TRY(launch_image_decoder_server());
     TRY(launch_compositor_process());
@@ -1401,9 +1501,16 @@ static void load_page_and_exit_on_close(Core::EventLoop& event_loop, HeadlessWeb
 ErrorOr<int> Application::execute()
 {
     OwnPtr<HeadlessWebView> view;
+    OwnPtr<HeadlessBatchRenderer> batch_renderer;
     RefPtr<Core::Timer> screenshot_timer;
 
-    if (m_browser_options.headless_mode.has_value()) {
+    if (m_browser_options.headless_mode == HeadlessMode::Batch) {
+        auto theme_path = LexicalPath::join(WebView::s_ladybird_resource_root, "themes"sv, "Default.ini"sv);
+        auto theme = TRY(Gfx::load_system_theme(theme_path.string()));
+
+        auto job_count = m_browser_options.batch_job_count.value_or(Core::System::hardware_concurrency());
+        batch_renderer = TRY(HeadlessBatchRenderer::create(*m_event_loop, move(theme), { m_browser_options.window_width, m_browser_options.window_height }, job_count));
+    } else if (m_browser_options.headless_mode.has_value()) {
         auto theme_path = LexicalPath::join(WebView::s_ladybird_resource_root, "themes"sv, "Default.ini"sv);
         auto theme = TRY(Gfx::load_system_theme(theme_path.string()));
 
@@ -1426,6 +1533,7 @@ ErrorOr<int> Application::execute()
             case HeadlessMode::Manual:
                 load_page_and_exit_on_close(*m_event_loop, *view, m_browser_options.urls.first());
                 break;
+            case HeadlessMode::Batch:
             case HeadlessMode::Test:
                 VERIFY_NOT_REACHED();
             }
@@ -1499,6 +1607,12 @@ void Application::process_did_exit(Process&& process, Optional<int> exit_status)
         break;
     case ProcessType::WebContent:
         if (auto client = process.client<WebContentClient>(); client.has_value()) {
+            // A spare process that died can no longer be handed out to a new tab, so replace it.
+            if (m_spare_web_content_processes.remove_first_matching([&](auto const& spare) { return spare.ptr() == &client.value(); })) {
+                launch_spare_web_content_process();
+                break;
+            }
+
 #if !defined(AK_OS_WINDOWS)
             if (exit_status.has_value() && WIFEXITED(*exit_status) && WEXITSTATUS(*exit_status) == 0 && !client->has_views())
                 break;
@@ -1710,6 +1824,8 @@ void Application::clear_browsing_data(ClearBrowsingDataOptions const& options)
             m_private_browsing_session->storage_jar->remove_items_accessed_since(options.since);
             m_private_browsing_session->hsts_store->remove_policies_observed_since(options.since);
         }
+
+        WebContentClient::broadcast_storage_areas_invalidated();
     }
 
     if (did_change_history)
@@ -1975,6 +2091,50 @@ void Application::initialize_actions()
             }
         }
     }));
+    m_debug_menu->add_action(Action::create("Dump GC graph snapshot"sv, ActionID::DumpGCGraphSnapshot, [this]() {
+        if (auto view = active_web_view(); view.has_value()) {
+            auto snapshot_path = view->dump_gc_graph_snapshot();
+            if (snapshot_path.is_error())
+                warnln("\033[31;1mFailed to dump GC graph snapshot: {}\033[0m", snapshot_path.error());
+            else
+                warnln("\033[33;1mWriting GC graph snapshot into {} (open it in Meta/gc-heap-explorer.html)\033[0m", snapshot_path.value());
+        }
+    }));
+    m_debug_menu->add_action(Action::create("Dump Frame Timeline"sv, ActionID::DumpFrameTimeline, [this]() {
+        if (auto view = active_web_view(); view.has_value()) {
+            auto frame_timeline_path = view->dump_frame_timeline();
+            if (frame_timeline_path.is_error())
+                warnln("\033[31;1mFailed to dump frame timeline: {}\033[0m", frame_timeline_path.error());
+            else
+                warnln("\033[33;1mDumped frame timeline into {} (open it in Perfetto or chrome://tracing)\033[0m", frame_timeline_path.value());
+        }
+    }));
+    m_debug_menu->add_action(Action::create("Dump IPC Trace"sv, ActionID::DumpIPCTrace, [this]() {
+        if (!IPC::Statistics::is_enabled()) {
+            warnln("\033[31;1mIPC statistics are not being recorded, restart with --enable-ipc-statistics\033[0m");
+            return;
+        }
+        if (auto view = active_web_view(); view.has_value()) {
+            auto ipc_trace_path = view->dump_ipc_trace();
+            if (ipc_trace_path.is_error())
+                warnln("\033[31;1mFailed to dump IPC trace: {}\033[0m", ipc_trace_path.error());
+            else
+                warnln("\033[33;1mDumped IPC trace into {} (open it in Perfetto or chrome://tracing)\033[0m", ipc_trace_path.value());
+        }
+    }));
+    m_debug_menu->add_action(Action::create("Dump Trace"sv, ActionID::DumpTrace, [this]() {
+        if (Core::TraceEvents::enabled_categories() == Core::TraceCategory::None) {
+            warnln("\033[31;1mTrace events are not being recorded, enable Record Trace Events or restart with --trace-categories\033[0m");
+            return;
+        }
+        if (auto view = active_web_view(); view.has_value()) {
+            auto trace_path = view->dump_trace();
+            if (trace_path.is_error())
+                warnln("\033[31;1mFailed to dump trace: {}\033[0m", trace_path.error());
+            else
+                warnln("\033[33;1mDumped trace into {} (open it in Perfetto or chrome://tracing)\033[0m", trace_path.value());
+        }
+    }));
     m_debug_menu->add_separator();
 
     m_show_line_box_borders_action = Action::create_checkable("Show Line Box Borders"sv, ActionID::ShowLineBoxBorders, check(m_show_line_box_borders_action, "set-line-box-borders"sv));
@@ -1982,6 +2142,12 @@ void Application::initialize_actions()
 
     m_show_caret_hit_test_debug_overlay_action = Action::create_checkable("Show Caret Hit Test Debug Overlay"sv, ActionID::ShowCaretHitTestDebugOverlay, check(m_show_caret_hit_test_debug_overlay_action, "set-caret-hit-test-debug-overlay"sv));
     m_debug_menu->add_action(*m_show_caret_hit_test_debug_overlay_action);
+
+    m_record_trace_events_action = Action::create_checkable("Record Trace Events"sv, ActionID::RecordTraceEvents, [this]() {
+        set_trace_categories(m_record_trace_events_action->checked() ? Core::TraceCategory::All : Core::TraceCategory::None);
+    });
+    m_record_trace_events_action->set_checked(Core::TraceEvents::enabled_categories() != Core::TraceCategory::None);
+    m_debug_menu->add_action(*m_record_trace_events_action);
     m_debug_menu->add_separator();
 
     m_debug_menu->add_action(Action::create("Collect Garbage"sv, ActionID::CollectGarbage, debug_request("collect-garbage"sv)));
@@ -2407,6 +2573,8 @@ ErrorOr<Optional<String>> Application::set_storage_item(DevTools::TabDescription
     auto key_utf16 = Utf16String::from_utf8(key);
     auto value_utf16 = Utf16String::from_utf8(value);
     auto old_value = TRY(storage_set_result_to_error_or_old_value(Application::storage_jar(view->is_private()).set_item(storage_endpoint, storage_key, key_utf16, value_utf16)));
+    WebContentClient::broadcast_storage_item_change(view->is_private(), storage_endpoint, storage_key, key_utf16, value_utf16);
+
     if (!old_value.has_value()) {
         view->notify_storage_changed({ storage_endpoint, storage_key, DevTools::DevToolsDelegate::StorageChange::Type::Added, key });
     } else if (*old_value != value) {
@@ -2431,6 +2599,7 @@ ErrorOr<Optional<String>> Application::remove_storage_item(DevTools::TabDescript
         return Optional<String> {};
 
     Application::storage_jar(view->is_private()).remove_item(storage_endpoint, storage_key, key_utf16);
+    WebContentClient::broadcast_storage_item_change(view->is_private(), storage_endpoint, storage_key, key_utf16, {});
     view->notify_storage_changed({ storage_endpoint, storage_key, DevTools::DevToolsDelegate::StorageChange::Type::Deleted, key });
     return old_value->to_utf8();
 }
@@ -2451,6 +2620,7 @@ ErrorOr<void> Application::clear_storage(DevTools::TabDescription const& descrip
         return {};
 
     Application::storage_jar(view->is_private()).clear_storage_key(storage_endpoint, storage_key);
+    WebContentClient::broadcast_storage_item_change(view->is_private(), storage_endpoint, storage_key, {}, {});
     view->notify_storage_changed({ storage_endpoint, storage_key, DevTools::DevToolsDelegate::StorageChange::Type::Cleared, {} });
     return {};
 }
@@ -2575,6 +2745,33 @@ void Application::inspect_accessibility_tree(DevTools::TabDescription const& des
     view->inspect_accessibility_tree();
 }
 
+void Application::start_javascript_profiler(DevTools::TabDescription const& description, AK::Duration interval) const
+{
+    if (auto view = ViewImplementation::find_view_by_id(description.id); view.has_value())
+        view->start_js_profiler(interval);
+}
+
+void Application::stop_javascript_profiler(DevTools::TabDescription const& description, OnJavaScriptProfileReceived on_complete) const
+{
+    auto view = ViewImplementation::find_view_by_id(description.id);
+    if (!view.has_value()) {
+        on_complete(Error::from_string_literal("Unable to locate tab"));
+        return;
+    }
+
+    view->on_received_js_profile = [&view = *view, on_complete = move(on_complete)](Optional<JsonObject> profile) {
+        view.on_received_js_profile = nullptr;
+
+        if (!profile.has_value()) {
+            on_complete(Error::from_string_literal("JavaScript profiler was not running"));
+            return;
+        }
+        on_complete(profile.release_value());
+    };
+
+    view->stop_js_profiler();
+}
+
 void Application::listen_for_dom_properties(DevTools::TabDescription const& description, OnDOMNodePropertiesReceived on_dom_node_properties_received) const
 {
     auto view = ViewImplementation::find_view_by_id(description.id);
@@ -85,6 +85,10 @@ public:
     static Requests::RequestClient& request_server_client(IsPrivate = IsPrivate::No);
     static ImageDecoderClient::Client& image_decoder_client() { return *the().m_image_decoder_client; }
 
+    // The trace events of the browser and of its Compositor, ImageDecoder, and RequestServer processes, which may
+    // then be merged with those of a WebContent process.
+    Vector<String> collect_trace_event_json();
+
     virtual bool supports_vertical_tabs() const { return false; }
     virtual bool supports_private_browsing_windows() const { return false; }
     virtual bool supports_client_side_window_decorations() const { return false; }
@@ -315,6 +319,7 @@ private:
     void handle_compositor_process_death();
     void recover_compositor_process();
     void crash_compositor_process();
+    void set_trace_categories(Core::TraceCategory);
     ErrorOr<void> launch_request_server();
     ErrorOr<void> launch_image_decoder_server();
     ErrorOr<void> launch_devtools_server();
@@ -358,6 +363,8 @@ private:
     virtual void remove_indexed_database_change_listener(DevTools::TabDescription const&, u64) const override;
     virtual void inspect_tab(DevTools::TabDescription const&, OnTabInspectionComplete) const override;
     virtual void inspect_accessibility_tree(DevTools::TabDescription const&, OnAccessibilityTreeInspectionComplete) const override;
+    virtual void start_javascript_profiler(DevTools::TabDescription const&, AK::Duration interval) const override;
+    virtual void stop_javascript_profiler(DevTools::TabDescription const&, OnJavaScriptProfileReceived) const override;
     virtual void listen_for_dom_properties(DevTools::TabDescription const&, OnDOMNodePropertiesReceived) const override;
     virtual void stop_listening_for_dom_properties(DevTools::TabDescription const&) const override;
     virtual void inspect_dom_node(DevTools::TabDescription const&, DOMNodeProperties::Type, Web::UniqueNodeID, Optional<Web::CSS::PseudoElement>, JsonObject options = {}) const override;
@@ -438,7 +445,7 @@ private:
     };
     CompositorRecoveryState m_compositor_recovery_state { CompositorRecoveryState::Idle };
 
-    RefPtr<WebContentClient> m_spare_web_content_process;
+    Vector<NonnullRefPtr<WebContentClient>> m_spare_web_content_processes;
     bool m_has_queued_task_to_launch_spare_web_content_process { false };
     u64 m_next_page_or_compositor_context_id { 1 };
     u64 m_next_cross_process_id_namespace { 1 };
@@ -453,6 +460,7 @@ private:
 
     OwnPtr<Core::GeolocationProvider> m_geolocation_provider;
     OwnPtr<Core::TimeZoneWatcher> m_time_zone_watcher;
+    OwnPtr<Core::MemoryPressureNotifier> m_memory_pressure_notifier;
 
     Core::EventLoop* m_event_loop { nullptr };
     OwnPtr<ProcessManager> m_process_manager;
@@ -499,6 +507,7 @@ private:
     RefPtr<Menu> m_debug_menu;
     RefPtr<Action> m_show_line_box_borders_action;
     RefPtr<Action> m_show_caret_hit_test_debug_overlay_action;
+    RefPtr<Action> m_record_trace_events_action;
     RefPtr<Action> m_enable_scripting_action;
     RefPtr<Action> m_enable_content_blocking_action;
     RefPtr<Action> m_block_pop_ups_action;
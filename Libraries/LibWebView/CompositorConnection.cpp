@@ -40,6 +40,7 @@ void CompositorConnection::stop_presenting_to_client(Web::Compositor::Compositor
 
 void CompositorConnection::destroy_context(Web::Compositor::CompositorContextId context_id)
 {
+    m_display_lists_sent_to_compositor.remove(context_id);
     if (!can_send_message_to_compositor())
         return;
     async_destroy_context(context_id);
@@ -66,7 +67,12 @@ void CompositorConnection::update_display_list(Web::Compositor::CompositorContex
         }
     }
 
-    auto encoded_message = MUST(Messages::CompositorWebContentServer::UpdateDisplayList::static_encode(context_id, display_list, visual_context_tree, resource_transaction, scroll_state_snapshot));
+    // OPTIMIZATION: The compositor keeps the last display list it got for the context, so only its changes are sent.
+    auto previous_display_list = m_display_lists_sent_to_compositor.get(context_id);
+    m_display_lists_sent_to_compositor.set(context_id, display_list);
+    auto encoded_message = previous_display_list.has_value()
+        ? MUST(Messages::CompositorWebContentServer::UpdateDisplayListWithDelta::static_encode(context_id, Web::Painting::DisplayListDelta::create(**previous_display_list, display_list), visual_context_tree, resource_transaction, scroll_state_snapshot))
+        : MUST(Messages::CompositorWebContentServer::UpdateDisplayList::static_encode(context_id, display_list, visual_context_tree, resource_transaction, scroll_state_snapshot));
     if (post_message(encoded_message).is_error())
         did_lose_compositor();
 }
@@ -78,6 +84,13 @@ void CompositorConnection::update_visual_context_tree(Web::Compositor::Composito
     async_update_visual_context_tree(context_id, visual_context_tree);
 }
 
+void CompositorConnection::update_compositor_animations(Web::Compositor::CompositorContextId context_id, u64 visual_context_tree_version, Vector<Web::Compositor::CompositorAnimation> const& animations)
+{
+    if (!can_send_message_to_compositor())
+        return;
+    async_update_compositor_animations(context_id, visual_context_tree_version, animations);
+}
+
 void CompositorConnection::update_scroll_state(Web::Compositor::CompositorContextId context_id, Web::Painting::ScrollStateSnapshot const& scroll_state_snapshot)
 {
     if (!can_send_message_to_compositor())
@@ -142,6 +155,15 @@ Gfx::ShareableBitmap CompositorConnection::get_canvas_pixels(Web::Painting::Canv
     return response->take_pixels();
 }
 
+Core::AnonymousBuffer CompositorConnection::get_unpremultiplied_canvas_pixels(Web::Painting::CanvasId canvas_id, Gfx::IntRect rect)
+{
+    if (!can_send_message_to_compositor())
+        return {};
+
+    auto response = send_sync<Messages::CompositorWebContentServer::GetUnpremultipliedCanvasPixels>(canvas_id, rect);
+    return response->take_pixels();
+}
+
 void CompositorConnection::invalidate_wheel_event_listener_state(Web::Compositor::CompositorContextId context_id, u64 generation)
 {
     if (!can_send_message_to_compositor())
@@ -202,11 +224,11 @@ void CompositorConnection::viewport_size_updated(Web::Compositor::CompositorCont
     async_viewport_size_updated(context_id, viewport_size, window_resize_in_progress);
 }
 
-void CompositorConnection::present_frame(Web::Compositor::CompositorContextId context_id, Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect)
+void CompositorConnection::present_frame(Web::Compositor::CompositorContextId context_id, Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect, Web::Compositor::FrameTiming const& frame_timing)
 {
     if (!can_send_message_to_compositor())
         return;
-    async_present_frame(context_id, viewport_rect, damage_rect);
+    async_present_frame(context_id, viewport_rect, damage_rect, frame_timing);
 }
 
 Optional<Web::Painting::CanvasId> CompositorConnection::create_webgl_context(Web::WebGL::WebGLVersion webgl_version, Gfx::IntSize size, bool depth, bool stencil, bool antialias, Vector<String>& out_supported_extensions)
@@ -321,6 +343,18 @@ void CompositorConnection::request_screenshot(Web::Compositor::CompositorContext
     async_request_screenshot(context_id, request_id, move(shareable_bitmap));
 }
 
+bool CompositorConnection::request_vsync_tick(double refresh_rate, Function<void()>&& callback)
+{
+    if (!can_send_message_to_compositor())
+        return false;
+
+    // NB: A single request covers every callback that is waiting for the next tick.
+    if (m_vsync_tick_callbacks.is_empty())
+        async_request_vsync_tick(refresh_rate);
+    m_vsync_tick_callbacks.append(move(callback));
+    return true;
+}
+
 void CompositorConnection::mouse_event(u64 page_id, Web::MouseEvent event)
 {
     if (on_mouse_event)
@@ -332,6 +366,18 @@ void CompositorConnection::request_rendering_update()
     Web::HTML::main_thread_event_loop().queue_task_to_update_the_rendering();
 }
 
+void CompositorConnection::did_finish_frame(Web::Compositor::FrameTiming frame_timing)
+{
+    Web::Compositor::FrameTimeline::the().did_finish_frame(frame_timing);
+}
+
+void CompositorConnection::did_vsync_tick()
+{
+    auto callbacks = move(m_vsync_tick_callbacks);
+    for (auto& callback : callbacks)
+        callback();
+}
+
 void CompositorConnection::did_complete_screenshot(Web::Compositor::ScreenshotRequestId request_id)
 {
     auto pending_screenshot = take_screenshot(request_id);
@@ -358,6 +404,7 @@ void CompositorConnection::did_lose_compositor()
     if (m_has_lost_compositor)
         return;
     m_has_lost_compositor = true;
+    m_display_lists_sent_to_compositor.clear();
 
     for (auto& entry : m_screenshots) {
         if (entry.value.callback)
@@ -365,6 +412,9 @@ void CompositorConnection::did_lose_compositor()
     }
     m_screenshots.clear();
 
+    // NB: There won't be a tick anymore, so let whoever was waiting for one find that out on their next request.
+    did_vsync_tick();
+
     if (on_compositor_lost)
         on_compositor_lost();
 }
@@ -6,6 +6,8 @@
 
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibGfx/Bitmap.h>
 #include <LibGfx/CanvasCommandList.h>
 #include <LibGfx/PaintingSurface.h>
 #include <LibMedia/VideoFrame.h>
@@ -169,6 +171,33 @@ private:
         return shareable_bitmap.bitmap();
     }
 
+    virtual bool read_back_unpremultiplied_pixels(Gfx::IntRect const& rect, Gfx::Bitmap& destination, Gfx::IntPoint destination_position) override
+    {
+        VERIFY(destination.format() == Gfx::BitmapFormat::RGBA8888);
+        VERIFY(destination.alpha_type() == Gfx::AlphaType::Unpremultiplied);
+        VERIFY(destination.rect().contains(rect.translated(destination_position - rect.location())));
+
+        if (!m_canvas_id.has_value())
+            return false;
+
+        // NB: The Compositor allocates a buffer for every read and never touches it again once it has been handed over,
+        //     so the buffer is mapped for this call only and released right after.
+        auto pixels = m_connection->get_unpremultiplied_canvas_pixels(*m_canvas_id, rect);
+        if (!pixels.is_valid())
+            return false;
+        if (Core::AnonymousBuffer::supports_sealing && !pixels.is_sealed())
+            return false;
+
+        auto row_size = static_cast<size_t>(rect.width()) * sizeof(u32);
+        if (pixels.size() < row_size * static_cast<size_t>(rect.height()))
+            return false;
+
+        auto const* source = pixels.data<u8>();
+        for (int y = 0; y < rect.height(); ++y)
+            memcpy(destination.scanline(destination_position.y() + y) + destination_position.x(), source + static_cast<size_t>(y) * row_size, row_size);
+        return true;
+    }
+
     NonnullRefPtr<CompositorConnection> m_connection;
     NonnullRefPtr<Web::Painting::Canvas2DCommandStream> m_stream;
     Optional<Web::Painting::CanvasId> m_canvas_id;
@@ -225,6 +254,12 @@ void CompositorHostBase::update_visual_context_tree(Web::Compositor::CompositorC
         connection->update_visual_context_tree(context_id, visual_context_tree);
 }
 
+void CompositorHostBase::update_compositor_animations(Web::Compositor::CompositorContextId context_id, u64 visual_context_tree_version, Vector<Web::Compositor::CompositorAnimation> animations)
+{
+    if (auto* connection = compositor_connection())
+        connection->update_compositor_animations(context_id, visual_context_tree_version, animations);
+}
+
 void CompositorHostBase::update_video_frame(Web::Compositor::CompositorContextId context_id, Web::Painting::VideoFrameResourceId frame_id, NonnullRefPtr<Media::VideoFrame const> frame)
 {
     if (auto* connection = compositor_connection())
@@ -283,10 +318,10 @@ void CompositorHostBase::viewport_size_updated(Web::Compositor::CompositorContex
         connection->viewport_size_updated(context_id, viewport_size, window_resize_in_progress);
 }
 
-void CompositorHostBase::present_frame(Web::Compositor::CompositorContextId context_id, Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect)
+void CompositorHostBase::present_frame(Web::Compositor::CompositorContextId context_id, Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect, Web::Compositor::FrameTiming const& frame_timing)
 {
     if (auto* connection = compositor_connection())
-        connection->present_frame(context_id, viewport_rect, damage_rect);
+        connection->present_frame(context_id, viewport_rect, damage_rect, frame_timing);
 }
 
 void CompositorHostBase::request_screenshot(Web::Compositor::CompositorContextId context_id, NonnullRefPtr<Gfx::PaintingSurface> target_surface, Function<void()>&& callback)
@@ -299,4 +334,11 @@ void CompositorHostBase::request_screenshot(Web::Compositor::CompositorContextId
         callback();
 }
 
+bool CompositorHostBase::request_vsync_tick(double refresh_rate, Function<void()>&& callback)
+{
+    if (auto* connection = compositor_connection())
+        return connection->request_vsync_tick(refresh_rate, move(callback));
+    return false;
+}
+
 }
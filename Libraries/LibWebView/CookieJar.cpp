@@ -560,7 +560,9 @@ Vector<HTTP::Cookie::Cookie> CookieJar::get_matching_cookies(URL::URL const& url
     // 3. Let cookie-list be the set of cookies from the cookie store that meets all of the following requirements:
     Vector<HTTP::Cookie::Cookie> cookie_list;
 
-    m_transient_storage.for_each_cookie([&](HTTP::Cookie::Cookie& cookie) {
+    // OPTIMIZATION: Only cookies whose domain is the host or one of its parent domains can be matched by it, so the rest
+    //               of the cookie store isn't looked at.
+    m_transient_storage.for_each_cookie_for_host(*retrieval_host_canonical, [&](HTTP::Cookie::Cookie& cookie) {
         if (!HTTP::Cookie::cookie_matches_url(cookie, url, *retrieval_host_canonical, source))
             return;
 
@@ -609,6 +611,12 @@ CookieJar::TransientStorage::TransientStorage(IsPrivate is_private)
 void CookieJar::TransientStorage::set_cookies(Cookies cookies)
 {
     m_cookies = move(cookies);
+
+    m_cookie_keys_by_domain.clear();
+    for (auto const& [key, cookie] : m_cookies)
+        m_cookie_keys_by_domain.ensure(key.domain).set(key);
+
+    m_earliest_expiry_time = UnixDateTime::earliest();
     purge_expired_cookies();
 }
 
@@ -629,6 +637,8 @@ void CookieJar::TransientStorage::set_cookie(CookieStorageKey key, HTTP::Cookie:
     }
 
     auto cookie_for_notification = cookie;
+    m_cookie_keys_by_domain.ensure(key.domain).set(key);
+    m_earliest_expiry_time = min(m_earliest_expiry_time, cookie.expiry_time);
     m_cookies.set(key, cookie);
     m_dirty_cookies.set(move(key), move(cookie));
 
@@ -653,9 +663,25 @@ UnixDateTime CookieJar::TransientStorage::purge_expired_cookies(Optional<AK::Dur
             cookie.value.expiry_time -= *offset;
     }
 
+    // OPTIMIZATION: This runs on every cookie access, so the store is only scanned once something may have expired.
+    if (now < m_earliest_expiry_time)
+        return now;
+
     auto is_expired = [&](auto const&, auto const& cookie) { return cookie.expiry_time < now; };
+    auto removed_entries = m_cookies.take_all_matching(is_expired);
+
+    for (auto const& entry : removed_entries) {
+        auto keys = m_cookie_keys_by_domain.find(entry.key.domain);
+        keys->value.remove(entry.key);
+        if (keys->value.is_empty())
+            m_cookie_keys_by_domain.remove(keys);
+    }
+
+    m_earliest_expiry_time = UnixDateTime::latest();
+    for (auto const& [key, cookie] : m_cookies)
+        m_earliest_expiry_time = min(m_earliest_expiry_time, cookie.expiry_time);
 
-    if (auto removed_entries = m_cookies.take_all_matching(is_expired); !removed_entries.is_empty())
+    if (!removed_entries.is_empty())
         send_cookie_changed_notifications(removed_entries);
 
     return now;
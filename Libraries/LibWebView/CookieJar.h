@@ -97,6 +97,24 @@ private:
             }
         }
 
+        // Calls the callback with every cookie that the given host could match, i.e. the cookies whose domain is the host
+        // itself or what follows one of its dots. Whether they actually match is still up to the caller.
+        template<typename Callback>
+        void for_each_cookie_for_host(StringView host, Callback callback)
+        {
+            for (auto domain = host;;) {
+                if (auto keys = m_cookie_keys_by_domain.find(domain); keys != m_cookie_keys_by_domain.end()) {
+                    for (auto const& key : keys->value)
+                        callback(m_cookies.find(key)->value);
+                }
+
+                auto dot = domain.find('.');
+                if (!dot.has_value())
+                    break;
+                domain = domain.substring_view(*dot + 1);
+            }
+        }
+
     private:
         using CookieEntry = decltype(declval<Cookies>().take_all_matching(nullptr))::ValueType;
         void send_cookie_changed_notifications(ReadonlySpan<CookieEntry>, bool inform_web_view_about_changed_domains = true);
@@ -104,6 +122,12 @@ private:
         IsPrivate m_is_private { IsPrivate::No };
         Cookies m_cookies;
         Cookies m_dirty_cookies;
+
+        // The keys of the cookies in the store, by their domain.
+        HashMap<String, HashTable<CookieStorageKey>> m_cookie_keys_by_domain;
+
+        // No cookie in the store expires before this time, so there's nothing to purge until then.
+        UnixDateTime m_earliest_expiry_time { UnixDateTime::earliest() };
     };
 
     struct WEBVIEW_API PersistedStorage {
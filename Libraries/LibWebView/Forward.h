@@ -47,6 +47,7 @@ struct DictionaryLookup;
 struct DictionaryLookupTextStyle;
 struct DOMNodeProperties;
 struct HistoryEntry;
+struct MemoryStatistics;
 struct Mutation;
 struct ProcessHandle;
 struct SearchEngine;
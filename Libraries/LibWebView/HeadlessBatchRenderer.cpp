@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/JsonObject.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/Promise.h>
+#include <LibCore/System.h>
+#include <LibCore/Timer.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibWebView/HeadlessBatchRenderer.h>
+#include <LibWebView/URL.h>
+#include <errno.h>
+
+namespace WebView {
+
+static constexpr u32 default_job_timeout_in_milliseconds = 30'000;
+
+ErrorOr<NonnullOwnPtr<HeadlessBatchRenderer>> HeadlessBatchRenderer::create(Core::EventLoop& event_loop, Core::AnonymousBuffer theme, Web::DevicePixelSize default_viewport_size, size_t maximum_parallel_job_count)
+{
+    auto renderer = adopt_own(*new HeadlessBatchRenderer(event_loop, move(theme), default_viewport_size, max(maximum_parallel_job_count, 1uz)));
+
+    renderer->m_standard_input_notifier = Core::Notifier::construct(STDIN_FILENO, Core::Notifier::Type::Read);
+    renderer->m_standard_input_notifier->on_activation = [renderer = renderer.ptr()] {
+        renderer->read_jobs_from_standard_input();
+    };
+
+    return renderer;
+}
+
+HeadlessBatchRenderer::HeadlessBatchRenderer(Core::EventLoop& event_loop, Core::AnonymousBuffer theme, Web::DevicePixelSize default_viewport_size, size_t maximum_parallel_job_count)
+    : m_event_loop(event_loop)
+    , m_theme(move(theme))
+    , m_default_viewport_size(default_viewport_size)
+    , m_maximum_parallel_job_count(maximum_parallel_job_count)
+{
+}
+
+HeadlessBatchRenderer::~HeadlessBatchRenderer() = default;
+
+ErrorOr<HeadlessBatchRenderer::Job> HeadlessBatchRenderer::parse_job(StringView line, Web::DevicePixelSize default_viewport_size)
+{
+    auto json = TRY(JsonValue::from_string(line));
+    if (!json.is_object())
+        return Error::from_string_literal("Job is not a JSON object");
+    auto const& object = json.as_object();
+
+    Job job;
+    if (auto id = object.get("id"sv); id.has_value())
+        job.id = *id;
+
+    auto url = object.get_string("url"sv);
+    if (!url.has_value())
+        return Error::from_string_literal("Job has no \"url\"");
+    auto sanitized_url = sanitize_url(*url);
+    if (!sanitized_url.has_value())
+        return Error::from_string_literal("Job has an invalid \"url\"");
+    job.url = sanitized_url.release_value();
+
+    auto output = object.get_string("output"sv);
+    if (!output.has_value() || output->is_empty())
+        return Error::from_string_literal("Job has no \"output\"");
+    job.output_path = LexicalPath { LexicalPath::absolute_path(TRY(FileSystem::current_working_directory()), *output) };
+
+    auto width = object.get_i32("width"sv).value_or(default_viewport_size.width().value());
+    auto height = object.get_i32("height"sv).value_or(default_viewport_size.height().value());
+    if (width <= 0 || height <= 0)
+        return Error::from_string_literal("Job has an invalid \"width\" or \"height\"");
+    job.viewport_size = { width, height };
+
+    if (!object.get_bool("full_page"sv).value_or(true))
+        job.screenshot_type = ViewImplementation::ScreenshotType::Visible;
+
+    job.delay_in_milliseconds = object.get_u32("delay"sv).value_or(0);
+    job.timeout_in_milliseconds = object.get_u32("timeout"sv).value_or(default_job_timeout_in_milliseconds);
+
+    return job;
+}
+
+JsonObject HeadlessBatchRenderer::create_job_report(Job const& job, ErrorOr<LexicalPath> const& result, AK::Duration duration)
+{
+    JsonObject report;
+    report.set("id"sv, job.id);
+    report.set("url"sv, job.url.serialize());
+    report.set("milliseconds"sv, duration.to_milliseconds());
+
+    if (result.is_error())
+        report.set("error"sv, MUST(String::formatted("{}", result.error())));
+    else
+        report.set("output"sv, result.value().string().view());
+
+    return report;
+}
+
+JsonObject HeadlessBatchRenderer::create_parse_error_report(Error const& error)
+{
+    JsonObject report;
+    report.set("error"sv, MUST(String::formatted("{}", error)));
+    return report;
+}
+
+void HeadlessBatchRenderer::read_jobs_from_standard_input()
+{
+    Array<u8, 4 * KiB> buffer;
+
+    auto nread = Core::System::read(STDIN_FILENO, buffer);
+    if (nread.is_error()) {
+        if (nread.error().code() == EAGAIN || nread.error().code() == EINTR)
+            return;
+        warnln("Unable to read jobs: {}", nread.error());
+    }
+
+    if (nread.is_error() || nread.value() == 0) {
+        m_standard_input_notifier->set_enabled(false);
+        m_reached_end_of_input = true;
+
+        // A last job may not be followed by a newline.
+        if (!m_standard_input_buffer.is_empty())
+            queue_job_or_report_error(StringView { m_standard_input_buffer.bytes() });
+        m_standard_input_buffer.clear();
+
+        run_pending_jobs();
+        exit_if_finished();
+        return;
+    }
+
+    m_standard_input_buffer.append(buffer.span().trim(nread.value()));
+
+    auto buffered_bytes = m_standard_input_buffer.bytes();
+    size_t line_start = 0;
+    for (size_t i = 0; i < buffered_bytes.size(); ++i) {
+        if (buffered_bytes[i] != '\n')
+            continue;
+        queue_job_or_report_error(StringView { buffered_bytes.slice(line_start, i - line_start) });
+        line_start = i + 1;
+    }
+
+    if (line_start != 0) {
+        auto remaining_bytes = MUST(ByteBuffer::copy(buffered_bytes.slice(line_start)));
+        m_standard_input_buffer = move(remaining_bytes);
+    }
+
+    run_pending_jobs();
+}
+
+void HeadlessBatchRenderer::queue_job_or_report_error(StringView line)
+{
+    line = line.trim_whitespace();
+    if (line.is_empty())
+        return;
+
+    auto job = parse_job(line, m_default_viewport_size);
+    if (job.is_error()) {
+        m_any_job_failed = true;
+        outln("{}", create_parse_error_report(job.error()).serialized());
+        fflush(stdout);
+        return;
+    }
+
+    m_pending_jobs.enqueue(job.release_value());
+}
+
+void HeadlessBatchRenderer::run_pending_jobs()
+{
+    // NB: This never runs from within a callback of a worker that needs replacement, as those are cleared when the
+    //     worker is marked, so its view can be destroyed here.
+    m_workers.remove_all_matching([](auto const& worker) { return worker->needs_replacement; });
+
+    size_t starting_worker_count = 0;
+
+    for (auto& worker : m_workers) {
+        if (m_pending_jobs.is_empty())
+            return;
+
+        if (!worker->is_ready)
+            ++starting_worker_count;
+        else if (!worker->job.has_value())
+            start_job(*worker, m_pending_jobs.dequeue());
+    }
+
+    // Views that are still loading their initial page pick up a job once they're ready, so only as many views are
+    // started as there are jobs left over for them.
+    while (m_workers.size() < m_maximum_parallel_job_count && starting_worker_count < m_pending_jobs.size()) {
+        create_worker();
+        ++starting_worker_count;
+    }
+}
+
+HeadlessBatchRenderer::Worker& HeadlessBatchRenderer::create_worker()
+{
+    auto worker = adopt_own(*new Worker {
+        .view = HeadlessWebView::create(m_theme, m_default_viewport_size),
+        .viewport_size = m_default_viewport_size,
+    });
+    auto& worker_reference = *worker;
+
+    // Wait for the initial about:blank load to complete, otherwise WebContent may drop the first page load.
+    worker->view->on_load_finish = [this, &worker_reference](auto const&) {
+        worker_reference.is_ready = true;
+        worker_reference.view->on_load_finish = nullptr;
+        run_pending_jobs();
+    };
+
+    // NB: The view starts a new WebContent process after a crash, but that one has to load its initial page again
+    //     before it could take a job, so the worker is replaced instead.
+    worker->view->on_web_content_crashed = [this, &worker_reference] {
+        if (worker_reference.job.has_value())
+            finish_job(worker_reference, Error::from_string_literal("WebContent process crashed"));
+        replace_worker(worker_reference);
+    };
+
+    m_workers.append(move(worker));
+    return worker_reference;
+}
+
+void HeadlessBatchRenderer::replace_worker(Worker& worker)
+{
+    VERIFY(!worker.job.has_value());
+
+    worker.needs_replacement = true;
+    worker.is_ready = false;
+    worker.view->on_load_finish = nullptr;
+    worker.view->on_web_content_crashed = nullptr;
+
+    // Destroying the view ends its WebContent process, along with any screenshot it was still taking, so a late reply
+    // can neither write the output of a job that already failed nor hold up the next one.
+    Core::deferred_invoke([this] {
+        run_pending_jobs();
+        exit_if_finished();
+    });
+}
+
+void HeadlessBatchRenderer::start_job(Worker& worker, Job job)
+{
+    VERIFY(!worker.job.has_value());
+
+    auto job_serial = m_next_job_serial++;
+    worker.job_serial = job_serial;
+    worker.job_start_time = MonotonicTime::now();
+
+    if (worker.viewport_size != job.viewport_size) {
+        worker.viewport_size = job.viewport_size;
+        worker.view->reset_viewport_size(job.viewport_size);
+    }
+
+    // NB: Only the load of the job's own navigation is reported here, which may have ended up at a different URL
+    //     after redirects.
+    worker.view->on_load_finish = [this, &worker, job_serial](URL::URL const&) {
+        if (worker.job_serial != job_serial || !worker.job.has_value())
+            return;
+        worker.view->on_load_finish = nullptr;
+
+        if (worker.job->delay_in_milliseconds == 0) {
+            take_screenshot(worker, job_serial);
+            return;
+        }
+
+        worker.delay_timer = Core::Timer::create_single_shot(static_cast<int>(worker.job->delay_in_milliseconds), [this, &worker, job_serial] {
+            take_screenshot(worker, job_serial);
+        });
+        worker.delay_timer->start();
+    };
+
+    worker.timeout_timer = Core::Timer::create_single_shot(static_cast<int>(job.timeout_in_milliseconds), [this, &worker, job_serial] {
+        if (worker.job_serial != job_serial || !worker.job.has_value())
+            return;
+        finish_job(worker, Error::from_string_literal("Timed out"));
+        replace_worker(worker);
+    });
+    worker.timeout_timer->start();
+
+    auto url = job.url;
+    worker.job = move(job);
+
+    // NB: Navigating to the job's URL replaces the document of the previous job, while the WebContent process and its
+    //     caches are kept.
+    worker.view->load(url);
+}
+
+void HeadlessBatchRenderer::take_screenshot(Worker& worker, u64 job_serial)
+{
+    if (worker.job_serial != job_serial || !worker.job.has_value())
+        return;
+
+    worker.view->take_screenshot(worker.job->screenshot_type, worker.job->output_path)
+        ->when_resolved([this, &worker, job_serial](LexicalPath const& path) {
+            if (worker.job_serial == job_serial && worker.job.has_value())
+                finish_job(worker, path);
+        })
+        .when_rejected([this, &worker, job_serial](Error const& error) {
+            if (worker.job_serial == job_serial && worker.job.has_value())
+                finish_job(worker, Error::copy(error));
+        });
+}
+
+void HeadlessBatchRenderer::finish_job(Worker& worker, ErrorOr<LexicalPath> result)
+{
+    VERIFY(worker.job.has_value());
+    auto job = worker.job.release_value();
+
+    worker.view->on_load_finish = nullptr;
+    if (worker.delay_timer)
+        worker.delay_timer->stop();
+    if (worker.timeout_timer)
+        worker.timeout_timer->stop();
+
+    if (result.is_error())
+        m_any_job_failed = true;
+
+    auto report = create_job_report(job, result, MonotonicTime::now() - worker.job_start_time);
+    outln("{}", report.serialized());
+    fflush(stdout);
+
+    // NB: The worker may be finishing its job from within one of its view's callbacks, so the next job is started
+    //     once those have returned.
+    Core::deferred_invoke([this] {
+        run_pending_jobs();
+        exit_if_finished();
+    });
+}
+
+void HeadlessBatchRenderer::exit_if_finished()
+{
+    if (!m_reached_end_of_input || !m_pending_jobs.is_empty())
+        return;
+
+    for (auto const& worker : m_workers) {
+        if (worker->job.has_value())
+            return;
+    }
+
+    m_event_loop.quit(m_any_job_failed ? 1 : 0);
+}
+
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/JsonValue.h>
+#include <AK/LexicalPath.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Queue.h>
+#include <AK/Time.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibCore/Forward.h>
+#include <LibURL/URL.h>
+#include <LibWeb/PixelUnits.h>
+#include <LibWebView/HeadlessWebView.h>
+
+namespace WebView {
+
+// Takes screenshots for a stream of jobs, which are read from stdin as one JSON object per line:
+//
+//     {"id": 1, "url": "https://ladybird.org", "output": "/tmp/ladybird.webp", "width": 1280, "height": 720}
+//
+// Only "url" and "output" are required. The screenshot is saved as a PNG, or as a WebP if the output path ends in
+// ".webp". Optionally, "delay" waits for the given number of milliseconds after the page has loaded, "timeout" fails
+// the job if it takes longer than the given number of milliseconds, and "full_page": false only captures the viewport.
+//
+// Jobs run in parallel, each in a view with a WebContent process of its own. The views are kept around and reused for
+// the next job, whose navigation replaces the previous job's document. A view whose job timed out or whose WebContent
+// process crashed is replaced by a new one instead. A JSON object is written to stdout as each job finishes, in the
+// order in which they finish, and the event loop exits once stdin is closed and every job finished.
+class HeadlessBatchRenderer {
+    AK_MAKE_NONCOPYABLE(HeadlessBatchRenderer);
+    AK_MAKE_NONMOVABLE(HeadlessBatchRenderer);
+
+public:
+    static ErrorOr<NonnullOwnPtr<HeadlessBatchRenderer>> create(Core::EventLoop&, Core::AnonymousBuffer theme, Web::DevicePixelSize default_viewport_size, size_t maximum_parallel_job_count);
+    ~HeadlessBatchRenderer();
+
+    struct Job {
+        JsonValue id;
+        URL::URL url;
+        LexicalPath output_path;
+        Web::DevicePixelSize viewport_size;
+        ViewImplementation::ScreenshotType screenshot_type { ViewImplementation::ScreenshotType::Full };
+        u32 delay_in_milliseconds { 0 };
+        u32 timeout_in_milliseconds { 0 };
+    };
+
+    static ErrorOr<Job> parse_job(StringView, Web::DevicePixelSize default_viewport_size);
+
+    // The line written to stdout for a job that finished, or for a line that couldn't be parsed as a job.
+    static JsonObject create_job_report(Job const&, ErrorOr<LexicalPath> const& result, AK::Duration);
+    static JsonObject create_parse_error_report(Error const&);
+
+private:
+    HeadlessBatchRenderer(Core::EventLoop&, Core::AnonymousBuffer theme, Web::DevicePixelSize default_viewport_size, size_t maximum_parallel_job_count);
+
+    struct Worker {
+        NonnullOwnPtr<HeadlessWebView> view;
+        Web::DevicePixelSize viewport_size;
+        bool is_ready { false };
+
+        // Set once the view can't be trusted with another job, as its WebContent process crashed or may still be busy
+        // with a job that timed out. The worker is then replaced by a new one with a fresh view.
+        bool needs_replacement { false };
+
+        Optional<Job> job;
+        u64 job_serial { 0 };
+        MonotonicTime job_start_time;
+        RefPtr<Core::Timer> delay_timer;
+        RefPtr<Core::Timer> timeout_timer;
+    };
+
+    void read_jobs_from_standard_input();
+    void queue_job_or_report_error(StringView);
+    void run_pending_jobs();
+
+    Worker& create_worker();
+    void replace_worker(Worker&);
+    void start_job(Worker&, Job);
+    void take_screenshot(Worker&, u64 job_serial);
+    void finish_job(Worker&, ErrorOr<LexicalPath>);
+    void exit_if_finished();
+
+    Core::EventLoop& m_event_loop;
+    Core::AnonymousBuffer m_theme;
+    Web::DevicePixelSize m_default_viewport_size;
+    size_t m_maximum_parallel_job_count { 0 };
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+    Queue<Job> m_pending_jobs;
+    u64 m_next_job_serial { 1 };
+
+    RefPtr<Core::Notifier> m_standard_input_notifier;
+    ByteBuffer m_standard_input_buffer;
+    bool m_reached_end_of_input { false };
+    bool m_any_job_failed { false };
+};
+
+}
@@ -7,6 +7,7 @@
 #include <AK/Enumerate.h>
 #include <LibCore/Process.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibWebView/Application.h>
 #include <LibWebView/CompositorClient.h>
 #include <LibWebView/HelperProcess.h>
@@ -36,6 +37,10 @@ static ErrorOr<NonnullRefPtr<ClientType>> launch_server_process(
     if (browser_options.debug_helper_processes.contains_slow(process_type))
         arguments.append("--wait-for-debugger"sv);
 
+    // Helper processes record the same categories as the browser, including ones enabled after it started.
+    if (auto trace_categories = Core::TraceEvents::enabled_categories(); trace_categories != Core::TraceCategory::None)
+        arguments.append(ByteString::formatted("--trace-categories={}", Core::trace_categories_to_string(trace_categories)));
+
     for (auto [i, path] : enumerate(candidate_server_paths)) {
         Core::ProcessSpawnOptions options { .name = server_name, .arguments = arguments };
 
@@ -107,6 +112,10 @@ ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(IsP
     arguments.append(ByteString::formatted("--site-isolation={}", WebView::site_isolation_mode_to_string(web_content_options.site_isolation_mode)));
     if (web_content_options.enable_idl_tracing == WebView::EnableIDLTracing::Yes)
         arguments.append("--enable-idl-tracing"sv);
+    if (web_content_options.enable_ipc_statistics == WebView::EnableIPCStatistics::Yes)
+        arguments.append("--enable-ipc-statistics"sv);
+    if (web_content_options.enable_hardware_video_decoding == WebView::EnableHardwareVideoDecoding::Yes)
+        arguments.append("--enable-hardware-video-decoding"sv);
     if (web_content_options.enable_http_memory_cache == WebView::EnableMemoryHTTPCache::Yes)
         arguments.append("--enable-http-memory-cache"sv);
     if (web_content_options.expose_experimental_interfaces == WebView::ExposeExperimentalInterfaces::Yes)
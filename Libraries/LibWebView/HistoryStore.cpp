@@ -9,6 +9,7 @@
 #include <AK/Math.h>
 #include <AK/NumericLimits.h>
 #include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 #include <LibDatabase/Database.h>
 #include <LibURL/Parser.h>
@@ -25,6 +26,14 @@ static constexpr i32 HISTORY_DATABASE_BUSY_TIMEOUT_MS = 250;
 static constexpr u32 HISTORY_SCHEMA_BASELINE_VERSION = 1u;
 static constexpr u32 HISTORY_SCHEMA_RANKING_SIGNALS_VERSION = 2u;
 static constexpr u32 HISTORY_SCHEMA_OMNIBOX_ENGAGEMENTS_VERSION = 3u;
+static constexpr u32 HISTORY_SCHEMA_SEARCH_INDEX_VERSION = 4u;
+
+// The trigram tokenizer of the search index can't look up anything shorter than a trigram.
+static constexpr size_t MINIMUM_HISTORY_SEARCH_INDEX_QUERY_LENGTH = 3;
+
+// The history entries that a search looks at: Either all of them, or only those that the search index found for ?5.
+static constexpr auto ALL_HISTORY_ENTRIES = "History"sv;
+static constexpr auto HISTORY_SEARCH_CANDIDATES = "History WHERE rowid IN (SELECT rowid FROM HistorySearch WHERE HistorySearch MATCH ?5)"sv;
 
 static Optional<StringView> url_without_scheme(StringView url)
 {
@@ -86,6 +95,32 @@ static bool matches_query(HistoryEntry const& entry, StringView title_query, Str
         && entry.title->contains(title_query, CaseSensitivity::CaseInsensitive);
 }
 
+// Builds a query for the search index that finds every history entry whose URL or title contains one of the given
+// strings. Any entry that a search matches contains one of them, so only these entries have to be looked at.
+static Optional<String> history_search_index_query(ReadonlySpan<StringView> substrings)
+{
+    StringBuilder builder;
+
+    for (auto substring : substrings) {
+        if (substring.is_empty())
+            continue;
+        if (Utf8View { substring }.length() < MINIMUM_HISTORY_SEARCH_INDEX_QUERY_LENGTH)
+            return {};
+
+        if (!builder.is_empty())
+            builder.append(" OR "sv);
+
+        // Each string is looked up as an FTS5 string literal, in which double quotes are escaped by doubling them.
+        builder.append('"');
+        builder.append(substring.replace("\""sv, "\"\""sv, ReplaceMode::All));
+        builder.append('"');
+    }
+
+    if (builder.is_empty())
+        return {};
+    return MUST(builder.to_string());
+}
+
 static u8 match_rank(HistoryEntry const& entry, StringView title_query, StringView url_query)
 {
     auto searchable_url = autocomplete_searchable_url(entry.url.bytes_as_string_view());
@@ -141,7 +176,7 @@ static void sort_matching_entries(Vector<HistoryEntry const*>& matches, StringVi
 
 ErrorOr<Database::MigrationOutcome> HistoryStore::migrate_schema(Database::Database& database, Database::MigrationMode mode)
 {
-    Array<Database::Migration, 3> migrations { {
+    Array<Database::Migration, 4> migrations { {
         { .version = HISTORY_SCHEMA_BASELINE_VERSION, .sql = R"#(
             CREATE TABLE IF NOT EXISTS History (
                 url TEXT PRIMARY KEY,
@@ -182,6 +217,24 @@ ErrorOr<Database::MigrationOutcome> HistoryStore::migrate_schema(Database::Datab
             CREATE INDEX OmniboxEngagementsByInput
             ON OmniboxEngagements(destination_kind, normalized_input);
         )#"sv },
+        { .version = HISTORY_SCHEMA_SEARCH_INDEX_VERSION, .sql = R"#(
+            CREATE VIRTUAL TABLE HistorySearch USING fts5(url, title, tokenize = 'trigram');
+
+            INSERT INTO HistorySearch (rowid, url, title)
+            SELECT rowid, url, title FROM History;
+
+            CREATE TRIGGER HistorySearchInsert AFTER INSERT ON History BEGIN
+                INSERT INTO HistorySearch (rowid, url, title) VALUES (new.rowid, new.url, new.title);
+            END;
+
+            CREATE TRIGGER HistorySearchUpdate AFTER UPDATE OF title ON History WHEN old.title != new.title BEGIN
+                UPDATE HistorySearch SET title = new.title WHERE rowid = old.rowid;
+            END;
+
+            CREATE TRIGGER HistorySearchDelete AFTER DELETE ON History BEGIN
+                DELETE FROM HistorySearch WHERE rowid = old.rowid;
+            END;
+        )#"sv },
     } };
 
     return database.migrate("History"sv, migrations, mode);
@@ -251,7 +304,8 @@ ErrorOr<NonnullOwnPtr<HistoryStore>> HistoryStore::create(Database::Database& da
         FROM History
         WHERE url = ?;
     )#"sv));
-    statements.search_entries = TRY(database.prepare_statement(R"#(
+    auto search_entries_sql = [](StringView entries) {
+        return ByteString::formatted(R"#(
         SELECT
             url,
             title,
@@ -291,7 +345,7 @@ ErrorOr<NonnullOwnPtr<HistoryStore>> HistoryStore::create(Database::Database& da
                         ELSE url
                     END
                 END AS searchable_url
-            FROM History
+            FROM {}
         )
         WHERE ((?1 != '' AND LOWER(searchable_url) LIKE LOWER(?1) || '%')
             OR (?2 != '' AND INSTR(LOWER(searchable_url), LOWER(?2)) > 0)
@@ -310,8 +364,12 @@ ErrorOr<NonnullOwnPtr<HistoryStore>> HistoryStore::create(Database::Database& da
             last_visited_time DESC,
             url ASC
         LIMIT ?4;
-    )#"sv));
-    statements.list_entries = TRY(database.prepare_statement(R"#(
+    )#", entries);
+    };
+    statements.search_entries = TRY(database.prepare_statement(search_entries_sql(ALL_HISTORY_ENTRIES)));
+    statements.search_entry_candidates = TRY(database.prepare_statement(search_entries_sql(HISTORY_SEARCH_CANDIDATES)));
+    auto list_entries_sql = [](StringView entries) {
+        return ByteString::formatted(R"#(
         SELECT
             url,
             title,
@@ -351,14 +409,17 @@ ErrorOr<NonnullOwnPtr<HistoryStore>> HistoryStore::create(Database::Database& da
                         ELSE url
                     END
                 END AS searchable_url
-            FROM History
+            FROM {}
         )
         WHERE ((?1 = '' AND ?2 = '')
             OR (?1 != '' AND INSTR(LOWER(title), LOWER(?1)) > 0)
             OR (?2 != '' AND INSTR(LOWER(searchable_url), LOWER(?2)) > 0))
         ORDER BY last_visited_time DESC, url ASC
         LIMIT ?3 OFFSET ?4;
-    )#"sv));
+    )#", entries);
+    };
+    statements.list_entries = TRY(database.prepare_statement(list_entries_sql(ALL_HISTORY_ENTRIES)));
+    statements.list_entry_candidates = TRY(database.prepare_statement(list_entries_sql(HISTORY_SEARCH_CANDIDATES)));
     statements.delete_entry = TRY(database.prepare_statement("DELETE FROM History WHERE url = ?;"sv));
     statements.delete_entries_accessed_since = TRY(database.prepare_statement("DELETE FROM History WHERE last_visited_time >= ?;"sv));
     statements.all_urls = TRY(database.prepare_statement("SELECT url FROM History;"sv));
@@ -1057,30 +1118,33 @@ Vector<HistoryEntry> HistoryStore::PersistedStorage::autocomplete_entries(String
     auto title_query_string = MUST(String::from_utf8(title_query));
     auto url_contains_query_string = MUST(String::from_utf8(autocomplete_url_contains_query(url_query)));
 
-    auto outcome = m_database.execute_interruptible_statement(
-        m_statements.search_entries,
-        [&](auto statement_id) {
-            auto title = m_database.result_column<String>(statement_id, 1);
-            auto favicon = m_database.result_column<String>(statement_id, 4);
+    auto on_result = [&](auto statement_id) {
+        auto title = m_database.result_column<String>(statement_id, 1);
+        auto favicon = m_database.result_column<String>(statement_id, 4);
+
+        entries.append(HistoryEntry {
+            .url = m_database.result_column<String>(statement_id, 0),
+            .title = title.is_empty() ? Optional<String> {} : Optional<String> { move(title) },
+            .favicon_base64_png = favicon.is_empty() ? Optional<String> {} : Optional<String> { move(favicon) },
+            .visit_count = m_database.result_column<u64>(statement_id, 2),
+            .direct_visit_count = m_database.result_column<u64>(statement_id, 5),
+            .last_visited_time = m_database.result_column<UnixDateTime>(statement_id, 3),
+            .last_qualifying_visit_time = m_database.result_column<UnixDateTime>(statement_id, 6),
+            .last_direct_visit_time = m_database.result_column<UnixDateTime>(statement_id, 7),
+            .decayed_visit_score = m_database.result_column<double>(statement_id, 8),
+            .decayed_direct_score = m_database.result_column<double>(statement_id, 9),
+            .score_updated_at = m_database.result_column<UnixDateTime>(statement_id, 10),
+        });
+    };
 
-            entries.append(HistoryEntry {
-                .url = m_database.result_column<String>(statement_id, 0),
-                .title = title.is_empty() ? Optional<String> {} : Optional<String> { move(title) },
-                .favicon_base64_png = favicon.is_empty() ? Optional<String> {} : Optional<String> { move(favicon) },
-                .visit_count = m_database.result_column<u64>(statement_id, 2),
-                .direct_visit_count = m_database.result_column<u64>(statement_id, 5),
-                .last_visited_time = m_database.result_column<UnixDateTime>(statement_id, 3),
-                .last_qualifying_visit_time = m_database.result_column<UnixDateTime>(statement_id, 6),
-                .last_direct_visit_time = m_database.result_column<UnixDateTime>(statement_id, 7),
-                .decayed_visit_score = m_database.result_column<double>(statement_id, 8),
-                .decayed_direct_score = m_database.result_column<double>(statement_id, 9),
-                .score_updated_at = m_database.result_column<UnixDateTime>(statement_id, 10),
-            });
-        },
-        url_query_string,
-        url_contains_query_string,
-        title_query_string,
-        static_cast<i64>(limit));
+    // OPTIMIZATION: Every match contains the URL query or the title query, so the search index can narrow the search
+    //               down to the entries that do, unless one of the queries is too short to be looked up in it.
+    Array search_index_substrings { url_query, title_query };
+    auto search_index_query = history_search_index_query(search_index_substrings);
+
+    auto outcome = search_index_query.has_value()
+        ? m_database.execute_interruptible_statement(m_statements.search_entry_candidates, move(on_result), url_query_string, url_contains_query_string, title_query_string, static_cast<i64>(limit), *search_index_query)
+        : m_database.execute_interruptible_statement(m_statements.search_entries, move(on_result), url_query_string, url_contains_query_string, title_query_string, static_cast<i64>(limit));
 
     if (outcome == Database::Database::StatementExecutionOutcome::Interrupted)
         entries.clear();
@@ -1095,30 +1159,30 @@ Vector<HistoryEntry> HistoryStore::PersistedStorage::list_entries(StringView tit
     auto title_query_string = MUST(String::from_utf8(title_query));
     auto url_query_string = MUST(String::from_utf8(url_query));
 
-    m_database.execute_statement(
-        m_statements.list_entries,
-        [&](auto statement_id) {
-            auto title = m_database.result_column<String>(statement_id, 1);
-            auto favicon = m_database.result_column<String>(statement_id, 4);
+    auto on_result = [&](auto statement_id) {
+        auto title = m_database.result_column<String>(statement_id, 1);
+        auto favicon = m_database.result_column<String>(statement_id, 4);
+
+        entries.append(HistoryEntry {
+            .url = m_database.result_column<String>(statement_id, 0),
+            .title = title.is_empty() ? Optional<String> {} : Optional<String> { move(title) },
+            .favicon_base64_png = favicon.is_empty() ? Optional<String> {} : Optional<String> { move(favicon) },
+            .visit_count = m_database.result_column<u64>(statement_id, 2),
+            .direct_visit_count = m_database.result_column<u64>(statement_id, 5),
+            .last_visited_time = m_database.result_column<UnixDateTime>(statement_id, 3),
+            .last_qualifying_visit_time = m_database.result_column<UnixDateTime>(statement_id, 6),
+            .last_direct_visit_time = m_database.result_column<UnixDateTime>(statement_id, 7),
+            .decayed_visit_score = m_database.result_column<double>(statement_id, 8),
+            .decayed_direct_score = m_database.result_column<double>(statement_id, 9),
+            .score_updated_at = m_database.result_column<UnixDateTime>(statement_id, 10),
+        });
+    };
 
-            entries.append(HistoryEntry {
-                .url = m_database.result_column<String>(statement_id, 0),
-                .title = title.is_empty() ? Optional<String> {} : Optional<String> { move(title) },
-                .favicon_base64_png = favicon.is_empty() ? Optional<String> {} : Optional<String> { move(favicon) },
-                .visit_count = m_database.result_column<u64>(statement_id, 2),
-                .direct_visit_count = m_database.result_column<u64>(statement_id, 5),
-                .last_visited_time = m_database.result_column<UnixDateTime>(statement_id, 3),
-                .last_qualifying_visit_time = m_database.result_column<UnixDateTime>(statement_id, 6),
-                .last_direct_visit_time = m_database.result_column<UnixDateTime>(statement_id, 7),
-                .decayed_visit_score = m_database.result_column<double>(statement_id, 8),
-                .decayed_direct_score = m_database.result_column<double>(statement_id, 9),
-                .score_updated_at = m_database.result_column<UnixDateTime>(statement_id, 10),
-            });
-        },
-        title_query_string,
-        url_query_string,
-        static_cast<i64>(limit),
-        static_cast<i64>(offset));
+    Array search_index_substrings { title_query, url_query };
+    if (auto search_index_query = history_search_index_query(search_index_substrings); search_index_query.has_value())
+        m_database.execute_statement(m_statements.list_entry_candidates, move(on_result), title_query_string, url_query_string, static_cast<i64>(limit), static_cast<i64>(offset), *search_index_query);
+    else
+        m_database.execute_statement(m_statements.list_entries, move(on_result), title_query_string, url_query_string, static_cast<i64>(limit), static_cast<i64>(offset));
 
     return entries;
 }
@@ -88,7 +88,9 @@ private:
         Database::StatementID update_favicon { 0 };
         Database::StatementID get_entry { 0 };
         Database::StatementID search_entries { 0 };
+        Database::StatementID search_entry_candidates { 0 };
         Database::StatementID list_entries { 0 };
+        Database::StatementID list_entry_candidates { 0 };
         Database::StatementID delete_entry { 0 };
         Database::StatementID delete_entries_accessed_since { 0 };
         Database::StatementID all_urls { 0 };
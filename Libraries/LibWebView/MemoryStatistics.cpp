@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibWebView/MemoryStatistics.h>
+
+namespace WebView {
+
+void MemoryStatistics::add(StringView category, StringView name, u64 bytes, u64 count)
+{
+    entries.append({
+        .category = MUST(String::from_utf8(category)),
+        .name = MUST(String::from_utf8(name)),
+        .bytes = bytes,
+        .count = count,
+    });
+}
+
+u64 MemoryStatistics::total_bytes() const
+{
+    u64 total = 0;
+    for (auto const& entry : entries)
+        total += entry.bytes;
+    return total;
+}
+
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, WebView::MemoryStatistics::Entry const& entry)
+{
+    TRY(encoder.encode(entry.category));
+    TRY(encoder.encode(entry.name));
+    TRY(encoder.encode(entry.bytes));
+    TRY(encoder.encode(entry.count));
+    return {};
+}
+
+template<>
+ErrorOr<WebView::MemoryStatistics::Entry> IPC::decode(Decoder& decoder)
+{
+    auto category = TRY(decoder.decode<String>());
+    auto name = TRY(decoder.decode<String>());
+    auto bytes = TRY(decoder.decode<u64>());
+    auto count = TRY(decoder.decode<u64>());
+
+    return WebView::MemoryStatistics::Entry { move(category), move(name), bytes, count };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, WebView::MemoryStatistics const& statistics)
+{
+    TRY(encoder.encode(statistics.entries));
+    return {};
+}
+
+template<>
+ErrorOr<WebView::MemoryStatistics> IPC::decode(Decoder& decoder)
+{
+    auto entries = TRY(decoder.decode<Vector<WebView::MemoryStatistics::Entry>>());
+    return WebView::MemoryStatistics { move(entries) };
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibIPC/Forward.h>
+#include <LibWebView/Forward.h>
+
+namespace WebView {
+
+// What a process reports its memory is being used for, as measured by the process itself. This only covers what the
+// process keeps track of, so it adds up to less than the memory usage measured by the OS.
+struct WEBVIEW_API MemoryStatistics {
+    struct Entry {
+        String category;
+        String name;
+        u64 bytes { 0 };
+        u64 count { 0 };
+    };
+
+    void add(StringView category, StringView name, u64 bytes, u64 count);
+    u64 total_bytes() const;
+
+    Vector<Entry> entries;
+};
+
+}
+
+namespace IPC {
+
+template<>
+WEBVIEW_API ErrorOr<void> encode(Encoder&, WebView::MemoryStatistics::Entry const&);
+
+template<>
+WEBVIEW_API ErrorOr<WebView::MemoryStatistics::Entry> decode(Decoder&);
+
+template<>
+WEBVIEW_API ErrorOr<void> encode(Encoder&, WebView::MemoryStatistics const&);
+
+template<>
+WEBVIEW_API ErrorOr<WebView::MemoryStatistics> decode(Decoder&);
+
+}
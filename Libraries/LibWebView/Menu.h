@@ -115,9 +115,14 @@ enum class ActionID {
     DumpLocalStorage,
     DumpSessionStorage,
     DumpGCGraph,
+    DumpGCGraphSnapshot,
+    DumpFrameTimeline,
+    DumpIPCTrace,
+    DumpTrace,
     DumpWasmStats,
     ShowLineBoxBorders,
     ShowCaretHitTestDebugOverlay,
+    RecordTraceEvents,
     CollectGarbage,
     CrashCurrentPage,
     CrashCompositorProcess,
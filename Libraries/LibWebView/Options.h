@@ -21,6 +21,7 @@ enum class HeadlessMode {
     LayoutTree,
     Text,
     Manual,
+    Batch,
     Test,
 };
 
@@ -81,6 +82,8 @@ struct BrowserOptions {
     Optional<HeadlessMode> headless_mode;
     Optional<ByteString> screenshot_path {};
     u32 screenshot_delay { 1 };
+    u32 spare_web_content_process_count { 1 };
+    Optional<size_t> batch_job_count {};
     int window_width { 800 };
     int window_height { 600 };
     NewWindow new_window { NewWindow::No };
@@ -125,6 +128,16 @@ enum class EnableIDLTracing {
     Yes,
 };
 
+enum class EnableIPCStatistics {
+    No,
+    Yes,
+};
+
+enum class EnableHardwareVideoDecoding {
+    No,
+    Yes,
+};
+
 enum class EnableMemoryHTTPCache {
     No,
     Yes,
@@ -178,6 +191,8 @@ struct WebContentOptions {
     LogAllJSExceptions log_all_js_exceptions { LogAllJSExceptions::No };
     SiteIsolationMode site_isolation_mode { SiteIsolationMode::TopLevel };
     EnableIDLTracing enable_idl_tracing { EnableIDLTracing::No };
+    EnableIPCStatistics enable_ipc_statistics { EnableIPCStatistics::No };
+    EnableHardwareVideoDecoding enable_hardware_video_decoding { EnableHardwareVideoDecoding::No };
     EnableMemoryHTTPCache enable_http_memory_cache { EnableMemoryHTTPCache::No };
     ExposeExperimentalInterfaces expose_experimental_interfaces { ExposeExperimentalInterfaces::No };
     ExposeInternalsObject expose_internals_object { ExposeInternalsObject::No };
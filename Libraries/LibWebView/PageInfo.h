@@ -16,6 +16,9 @@ enum class PageInfoType {
     PaintTree = 1 << 3,
     GCGraph = 1 << 4,
     StackingContextTree = 1 << 5,
+    FrameTimeline = 1 << 6,
+    IPCTrace = 1 << 7,
+    Trace = 1 << 8,
 };
 
 AK_ENUM_BITWISE_OPERATORS(PageInfoType);
@@ -41,7 +41,7 @@ void ImageCodecPlugin::setup_client_callbacks()
 
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
-NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<ByteString> cache_partition)
 {
     auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
     if (on_resolved)
@@ -73,11 +73,31 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
         },
         [promise](auto& error) {
             promise->reject(Error::copy(error));
-        });
+        },
+        {}, {}, move(cache_partition));
 
     return promise;
 }
 
+Optional<i64> ImageCodecPlugin::start_incremental_decode(Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image)
+{
+    if (!m_client)
+        return {};
+    return m_client->start_incremental_decode(move(on_partial_image));
+}
+
+void ImageCodecPlugin::append_incremental_decode_data(i64 decode_id, ReadonlyBytes data)
+{
+    if (m_client)
+        m_client->append_incremental_decode_data(decode_id, data);
+}
+
+void ImageCodecPlugin::end_incremental_decode(i64 decode_id)
+{
+    if (m_client)
+        m_client->end_incremental_decode(decode_id);
+}
+
 void ImageCodecPlugin::request_animation_frames(i64 session_id, u32 start_frame_index, u32 count)
 {
     if (m_client)
@@ -18,7 +18,11 @@ public:
     explicit ImageCodecPlugin(NonnullRefPtr<ImageDecoderClient::Client>);
     virtual ~ImageCodecPlugin() override;
 
-    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<ByteString> cache_partition) override;
+
+    virtual Optional<i64> start_incremental_decode(Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image) override;
+    virtual void append_incremental_decode_data(i64 decode_id, ReadonlyBytes) override;
+    virtual void end_incremental_decode(i64 decode_id) override;
 
     virtual void request_animation_frames(i64 session_id, u32 start_frame_index, u32 count) override;
     virtual void stop_animation_decode(i64 session_id) override;
@@ -40,6 +40,14 @@ Process::~Process()
         m_connection->shutdown();
 }
 
+void Process::did_finish_garbage_collection(u64 collection_count, AK::Duration collection_time)
+{
+    auto& statistics = m_garbage_collection_statistics.ensure([] { return GarbageCollectionStatistics {}; });
+    statistics.collection_count = collection_count;
+    statistics.total_collection_time += collection_time;
+    statistics.longest_collection_time = max(statistics.longest_collection_time, collection_time);
+}
+
 ErrorOr<Process::ProcessAndIPCTransport> Process::spawn_and_connect_to_process(Core::ProcessSpawnOptions const& options, bool capture_output)
 {
     // Set up pipes for stdout/stderr capture if requested
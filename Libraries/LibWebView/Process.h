@@ -6,13 +6,16 @@
 
 #pragma once
 
+#include <AK/Time.h>
 #include <AK/Utf16String.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/File.h>
 #include <LibCore/Process.h>
 #include <LibIPC/Connection.h>
+#include <LibIPC/Statistics.h>
 #include <LibIPC/Transport.h>
 #include <LibWebView/Forward.h>
+#include <LibWebView/MemoryStatistics.h>
 #include <LibWebView/ProcessType.h>
 
 namespace WebView {
@@ -41,6 +44,30 @@ public:
     Optional<Utf16String> const& title() const { return m_title; }
     void set_title(Optional<Utf16String> title) { m_title = move(title); }
 
+    // Reported by processes that run a GC heap (currently only WebContent).
+    struct GarbageCollectionStatistics {
+        u64 collection_count { 0 };
+        AK::Duration total_collection_time;
+        AK::Duration longest_collection_time;
+    };
+    Optional<GarbageCollectionStatistics> const& garbage_collection_statistics() const { return m_garbage_collection_statistics; }
+    void did_finish_garbage_collection(u64 collection_count, AK::Duration collection_time);
+
+    // Frames that were replaced before reaching the screen, or that missed their deadline (currently only WebContent).
+    u64 dropped_frame_count() const { return m_dropped_frame_count; }
+    void set_dropped_frame_count(u64 dropped_frame_count) { m_dropped_frame_count = dropped_frame_count; }
+
+    Core::Process::Priority priority() const { return m_priority; }
+    void set_priority(Core::Process::Priority priority) { m_priority = priority; }
+
+    // Only recorded with --enable-ipc-statistics (currently reported by the Browser and WebContent).
+    Optional<IPC::TrafficStatistics> const& ipc_statistics() const { return m_ipc_statistics; }
+    void set_ipc_statistics(IPC::TrafficStatistics ipc_statistics) { m_ipc_statistics = move(ipc_statistics); }
+
+    // Only measured when requested from about:processes (currently reported by WebContent and ImageDecoder).
+    Optional<MemoryStatistics> const& memory_statistics() const { return m_memory_statistics; }
+    void set_memory_statistics(MemoryStatistics memory_statistics) { m_memory_statistics = move(memory_statistics); }
+
     template<typename ConnectionFromClient>
     Optional<ConnectionFromClient&> client()
     {
@@ -73,6 +100,11 @@ private:
     Core::Process m_process;
     ProcessType m_type;
     Optional<Utf16String> m_title;
+    Optional<GarbageCollectionStatistics> m_garbage_collection_statistics;
+    u64 m_dropped_frame_count { 0 };
+    Core::Process::Priority m_priority { Core::Process::Priority::Normal };
+    Optional<IPC::TrafficStatistics> m_ipc_statistics;
+    Optional<MemoryStatistics> m_memory_statistics;
     WeakPtr<IPC::ConnectionBase> m_connection;
     ProcessOutputCapture m_output_capture;
 };
@@ -8,6 +8,7 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/Process.h>
 #include <LibWebView/ProcessManager.h>
+#include <errno.h>
 
 namespace WebView {
 
@@ -156,6 +157,23 @@ void ProcessManager::force_exit_after_timeout(pid_t pid, int timeout_ms)
     m_forced_exit_timers.set(pid, move(timer));
 }
 
+void ProcessManager::set_process_priority(pid_t pid, Core::Process::Priority priority)
+{
+    verify_event_loop();
+    auto process = m_processes.get(pid);
+    if (!process.has_value() || process->priority() == priority)
+        return;
+
+    // NB: Failing because we aren't allowed to change the priority isn't worth reporting, the process just keeps its
+    //     normal priority.
+    if (auto result = Core::Process::set_priority(pid, priority); result.is_error()) {
+        if (result.error().code() != EPERM)
+            dbgln("Failed to set the priority of {} process {}: {}", process_name_from_type(process->type()), pid, result.error());
+        return;
+    }
+    process->set_priority(priority);
+}
+
 void ProcessManager::update_all_process_statistics()
 {
     verify_event_loop();
@@ -36,6 +36,7 @@ public:
     Optional<Process&> find_process(pid_t);
     void cancel_forced_exit(pid_t);
     void force_exit_after_timeout(pid_t, int timeout_ms);
+    void set_process_priority(pid_t, Core::Process::Priority);
 
 #if defined(AK_OS_MACH)
     void set_process_mach_port(pid_t, Core::MachPort&&);
@@ -46,8 +46,8 @@ ErrorOr<NonnullOwnPtr<StorageJar>> StorageJar::create(Database::Database& databa
     statements.update_last_access_time = TRY(database.prepare_statement("UPDATE WebStorage SET last_access_time = ? WHERE storage_endpoint = ? AND storage_key = ? AND bottle_key = ?;"sv));
     statements.clear = TRY(database.prepare_statement("DELETE FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ?;"sv));
     statements.get_keys = TRY(database.prepare_statement("SELECT bottle_key FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ?;"sv));
-    statements.calculate_size_excluding_bottle_key = TRY(database.prepare_statement("SELECT SUM(OCTET_LENGTH(bottle_key) + OCTET_LENGTH(bottle_value)) FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ? AND bottle_key != ?;"sv));
-    statements.calculate_size = TRY(database.prepare_statement("SELECT COALESCE(SUM(OCTET_LENGTH(bottle_key) + OCTET_LENGTH(bottle_value)), 0) FROM WebStorage WHERE storage_key = ?;"sv));
+    statements.get_item_size = TRY(database.prepare_statement("SELECT OCTET_LENGTH(bottle_key) + OCTET_LENGTH(bottle_value) FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ? AND bottle_key = ?;"sv));
+    statements.calculate_size = TRY(database.prepare_statement("SELECT COALESCE(SUM(OCTET_LENGTH(bottle_key) + OCTET_LENGTH(bottle_value)), 0) FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ?;"sv));
     statements.estimate_storage_size_accessed_since = TRY(database.prepare_statement("SELECT SUM(OCTET_LENGTH(storage_key)) + SUM(OCTET_LENGTH(bottle_key)) + SUM(OCTET_LENGTH(bottle_value)) FROM WebStorage WHERE last_access_time >= ?;"sv));
 
     return adopt_own(*new StorageJar { PersistedStorage { database, statements } });
@@ -81,6 +81,21 @@ static size_t storage_quota_size(Utf16String const& string)
     return utf8_string.bytes().size();
 }
 
+static StorageBottleLocation storage_bottle_location(StorageLocation const& key)
+{
+    return { key.storage_endpoint, key.storage_key };
+}
+
+static void subtract_from_bottle_size(HashMap<StorageBottleLocation, u64>& bottle_sizes, StorageBottleLocation const& bottle, u64 size)
+{
+    auto it = bottle_sizes.find(bottle);
+    if (it == bottle_sizes.end())
+        return;
+
+    VERIFY(it->value >= size);
+    it->value -= size;
+}
+
 Optional<Utf16String> StorageJar::get_item(StorageEndpointType storage_endpoint, String const& storage_key, Utf16String const& bottle_key)
 {
     StorageLocation storage_location { storage_endpoint, storage_key, bottle_key };
@@ -93,6 +108,7 @@ Optional<Utf16String> StorageJar::get_item(StorageEndpointType storage_endpoint,
 StorageSetResult StorageJar::set_item(StorageEndpointType storage_endpoint, String const& storage_key, Utf16String const& bottle_key, Utf16String const& bottle_value)
 {
     StorageLocation storage_location { storage_endpoint, storage_key, bottle_key };
+    ++m_version;
 
     if (m_persisted_storage.has_value())
         return m_persisted_storage->set_item(storage_location, bottle_value);
@@ -102,6 +118,7 @@ StorageSetResult StorageJar::set_item(StorageEndpointType storage_endpoint, Stri
 void StorageJar::remove_item(StorageEndpointType storage_endpoint, String const& storage_key, Utf16String const& key)
 {
     StorageLocation storage_location { storage_endpoint, storage_key, key };
+    ++m_version;
 
     if (m_persisted_storage.has_value())
         m_persisted_storage->delete_item(storage_location);
@@ -111,6 +128,8 @@ void StorageJar::remove_item(StorageEndpointType storage_endpoint, String const&
 
 void StorageJar::remove_items_accessed_since(UnixDateTime since)
 {
+    ++m_version;
+
     if (m_persisted_storage.has_value())
         m_persisted_storage->delete_items_accessed_since(since);
     else
@@ -119,6 +138,8 @@ void StorageJar::remove_items_accessed_since(UnixDateTime since)
 
 void StorageJar::clear_storage_key(StorageEndpointType storage_endpoint, String const& storage_key)
 {
+    ++m_version;
+
     if (m_persisted_storage.has_value())
         m_persisted_storage->clear(storage_endpoint, storage_key);
     else
@@ -160,35 +181,43 @@ StorageSetResult StorageJar::TransientStorage::set_item(StorageLocation const& k
 {
     auto old_value = get_item(key);
 
-    u64 current_size = 0;
+    u64 old_size = 0;
+    if (auto entry = m_storage_items.get(key); entry.has_value())
+        old_size = entry->quota_size;
 
-    for (auto const& [existing_key, existing_entry] : m_storage_items) {
-        if (existing_key.storage_endpoint == key.storage_endpoint && existing_key.storage_key == key.storage_key && existing_key.bottle_key != key.bottle_key)
-            current_size += existing_entry.quota_size;
-    }
+    auto bottle = storage_bottle_location(key);
+    auto current_size = m_bottle_sizes.get(bottle).value_or(0) - old_size;
 
     auto new_size = storage_quota_size(key.bottle_key) + storage_quota_size(value);
     if (current_size + new_size > LOCAL_STORAGE_QUOTA)
         return StorageOperationError::QuotaExceededError;
 
     m_storage_items.set(key, { value, UnixDateTime::now(), new_size });
+    m_bottle_sizes.set(move(bottle), current_size + new_size);
     return old_value;
 }
 
 void StorageJar::TransientStorage::delete_item(StorageLocation const& key)
 {
-    m_storage_items.remove(key);
+    if (auto entry = m_storage_items.take(key); entry.has_value())
+        subtract_from_bottle_size(m_bottle_sizes, storage_bottle_location(key), entry->quota_size);
 }
 
 void StorageJar::TransientStorage::delete_items_accessed_since(UnixDateTime since)
 {
-    m_storage_items.remove_all_matching([&](auto const&, auto const& entry) {
-        return entry.last_access_time >= since;
+    m_storage_items.remove_all_matching([&](auto const& key, auto const& entry) {
+        if (entry.last_access_time < since)
+            return false;
+
+        subtract_from_bottle_size(m_bottle_sizes, storage_bottle_location(key), entry.quota_size);
+        return true;
     });
 }
 
 void StorageJar::TransientStorage::clear(StorageEndpointType storage_endpoint, String const& storage_key)
 {
+    m_bottle_sizes.remove(StorageBottleLocation { storage_endpoint, storage_key });
+
     Vector<StorageLocation> keys_to_remove;
     for (auto const& [key, value] : m_storage_items) {
         if (key.storage_endpoint == storage_endpoint && key.storage_key == storage_key)
@@ -259,15 +288,12 @@ StorageSetResult StorageJar::PersistedStorage::set_item(StorageLocation const& k
     auto bottle_key = storage_string_to_database_string(key.bottle_key);
     auto bottle_value = storage_string_to_database_string(value);
 
-    size_t current_size = 0;
-    database.execute_statement(
-        statements.calculate_size_excluding_bottle_key,
-        [&](auto statement_id) {
-            current_size = database.result_column<int>(statement_id, 0);
-        },
-        to_underlying(key.storage_endpoint),
-        key.storage_key,
-        bottle_key);
+    u64 old_size = 0;
+    if (old_value.has_value())
+        old_size = bottle_key.bytes().size() + storage_quota_size(*old_value);
+
+    auto bottle = storage_bottle_location(key);
+    auto current_size = bottle_size(bottle) - old_size;
 
     auto new_size = bottle_key.bytes().size() + bottle_value.bytes().size();
     if (current_size + new_size > LOCAL_STORAGE_QUOTA)
@@ -282,6 +308,7 @@ StorageSetResult StorageJar::PersistedStorage::set_item(StorageLocation const& k
         bottle_value,
         UnixDateTime::now());
 
+    bottle_sizes.set(move(bottle), current_size + new_size);
     return old_value;
 }
 
@@ -289,6 +316,18 @@ void StorageJar::PersistedStorage::delete_item(StorageLocation const& key)
 {
     auto bottle_key = storage_string_to_database_string(key.bottle_key);
 
+    if (auto bottle = storage_bottle_location(key); bottle_sizes.contains(bottle)) {
+        u64 size = 0;
+        database.execute_statement(
+            statements.get_item_size,
+            [&](auto statement_id) { size = database.result_column<u64>(statement_id, 0); },
+            to_underlying(key.storage_endpoint),
+            key.storage_key,
+            bottle_key);
+
+        subtract_from_bottle_size(bottle_sizes, bottle, size);
+    }
+
     database.execute_statement(
         statements.delete_item,
         {},
@@ -300,10 +339,15 @@ void StorageJar::PersistedStorage::delete_item(StorageLocation const& key)
 void StorageJar::PersistedStorage::delete_items_accessed_since(UnixDateTime since)
 {
     database.execute_statement(statements.delete_items_accessed_since, {}, since);
+
+    // NB: This may remove items from any storage bottle, so the sizes of those that are needed again are added up anew.
+    bottle_sizes.clear();
 }
 
 void StorageJar::PersistedStorage::clear(StorageEndpointType storage_endpoint, String const& storage_key)
 {
+    bottle_sizes.set(StorageBottleLocation { storage_endpoint, storage_key }, 0);
+
     database.execute_statement(
         statements.clear,
         {},
@@ -329,13 +373,25 @@ Vector<Utf16String> StorageJar::PersistedStorage::get_keys(StorageEndpointType s
 u64 StorageJar::PersistedStorage::usage(String const& storage_key)
 {
     u64 current_size_in_bytes = 0;
+    for (u8 endpoint = 0; endpoint < to_underlying(StorageEndpointType::Count); ++endpoint)
+        current_size_in_bytes += bottle_size(StorageBottleLocation { static_cast<StorageEndpointType>(endpoint), storage_key });
+    return current_size_in_bytes;
+}
+
+u64 StorageJar::PersistedStorage::bottle_size(StorageBottleLocation const& bottle)
+{
+    if (auto size = bottle_sizes.get(bottle); size.has_value())
+        return *size;
+
+    u64 size = 0;
     database.execute_statement(
         statements.calculate_size,
-        [&](auto statement_id) {
-            current_size_in_bytes = database.result_column<u64>(statement_id, 0);
-        },
-        storage_key);
-    return current_size_in_bytes;
+        [&](auto statement_id) { size = database.result_column<u64>(statement_id, 0); },
+        to_underlying(bottle.storage_endpoint),
+        bottle.storage_key);
+
+    bottle_sizes.set(bottle, size);
+    return size;
 }
 
 Requests::CacheSizes StorageJar::PersistedStorage::estimate_storage_size_accessed_since(UnixDateTime since) const
@@ -358,10 +414,8 @@ Requests::CacheSizes StorageJar::PersistedStorage::estimate_storage_size_accesse
 u64 StorageJar::TransientStorage::usage(String const& storage_key)
 {
     u64 current_size_in_bytes = 0;
-    for (auto const& [key, entry] : m_storage_items) {
-        if (key.storage_key == storage_key)
-            current_size_in_bytes += entry.quota_size;
-    }
+    for (u8 endpoint = 0; endpoint < to_underlying(StorageEndpointType::Count); ++endpoint)
+        current_size_in_bytes += m_bottle_sizes.get(StorageBottleLocation { static_cast<StorageEndpointType>(endpoint), storage_key }).value_or(0);
     return current_size_in_bytes;
 }
 
@@ -29,6 +29,14 @@ struct StorageLocation {
     Utf16String bottle_key;
 };
 
+// https://storage.spec.whatwg.org/#storage-bottle
+struct StorageBottleLocation {
+    bool operator==(StorageBottleLocation const&) const = default;
+
+    StorageEndpointType storage_endpoint;
+    String storage_key;
+};
+
 class WEBVIEW_API StorageJar {
     AK_MAKE_NONCOPYABLE(StorageJar);
     AK_MAKE_NONMOVABLE(StorageJar);
@@ -50,6 +58,9 @@ public:
     u64 usage(String const& storage_key);
     Requests::CacheSizes estimate_storage_size_accessed_since(UnixDateTime since) const;
 
+    // Incremented by every change, so that WebContent processes can tell which changes their copies already include.
+    u64 version() const { return m_version; }
+
 private:
     struct Statements {
         Database::StatementID get_item { 0 };
@@ -59,7 +70,7 @@ private:
         Database::StatementID update_last_access_time { 0 };
         Database::StatementID clear { 0 };
         Database::StatementID get_keys { 0 };
-        Database::StatementID calculate_size_excluding_bottle_key { 0 };
+        Database::StatementID get_item_size { 0 };
         Database::StatementID calculate_size { 0 };
         Database::StatementID estimate_storage_size_accessed_since { 0 };
     };
@@ -84,6 +95,9 @@ private:
         };
 
         HashMap<StorageLocation, Entry> m_storage_items;
+
+        // The sum of the quota sizes of the entries in each storage bottle.
+        HashMap<StorageBottleLocation, u64> m_bottle_sizes;
     };
 
     struct PersistedStorage {
@@ -96,14 +110,21 @@ private:
         u64 usage(String const& storage_key);
         Requests::CacheSizes estimate_storage_size_accessed_since(UnixDateTime since) const;
 
+        u64 bottle_size(StorageBottleLocation const&);
+
         Database::Database& database;
         Statements statements;
+
+        // The sums of the quota sizes of the items in the storage bottles that were looked at so far. They're kept up
+        // to date by every change, so that the database only has to add up a bottle's items the first time.
+        HashMap<StorageBottleLocation, u64> bottle_sizes {};
     };
 
     explicit StorageJar(Optional<PersistedStorage>);
 
     Optional<PersistedStorage> m_persisted_storage;
     TransientStorage m_transient_storage;
+    u64 m_version { 0 };
 };
 
 }
@@ -119,3 +140,11 @@ struct AK::Traits<WebView::StorageLocation> : public AK::DefaultTraits<WebView::
         return hash;
     }
 };
+
+template<>
+struct AK::Traits<WebView::StorageBottleLocation> : public AK::DefaultTraits<WebView::StorageBottleLocation> {
+    static unsigned hash(WebView::StorageBottleLocation const& key)
+    {
+        return pair_int_hash(to_underlying(key.storage_endpoint), key.storage_key.hash());
+    }
+};
@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/Error.h>
+#include <AK/MemoryStream.h>
 #include <AK/NeverDestroyed.h>
 #include <AK/NumericLimits.h>
 #include <AK/ScopeGuard.h>
@@ -14,7 +15,9 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGfx/ImageFormats/PNGWriter.h>
+#include <LibGfx/ImageFormats/WebPWriter.h>
 #include <LibGfx/SharedImageBuffer.h>
 #include <LibURL/Parser.h>
 #include <LibWeb/CSS/SystemColor.h>
@@ -275,6 +278,7 @@ void ViewImplementation::set_system_visibility_state(Web::HTML::VisibilityState
 
     m_top_level_traversable.set_system_visibility_state(visibility_state);
     client().async_set_system_visibility_state(m_client_state.page_index, visibility_state);
+    client().update_process_priority();
 }
 
 void ViewImplementation::load(URL::URL const& url, Web::Bindings::NavigationHistoryBehavior history_handling)
@@ -837,6 +841,16 @@ void ViewImplementation::inspect_accessibility_tree()
     client().async_inspect_accessibility_tree(page_id());
 }
 
+void ViewImplementation::start_js_profiler(AK::Duration interval)
+{
+    client().async_start_js_profiler(page_id(), static_cast<u64>(interval.to_microseconds()));
+}
+
+void ViewImplementation::stop_js_profiler()
+{
+    client().async_stop_js_profiler(page_id());
+}
+
 void ViewImplementation::get_hovered_node_id()
 {
     client().async_get_hovered_node_id(page_id());
@@ -1308,7 +1322,11 @@ void ViewImplementation::did_change_audio_play_state(Badge<WebContentClient>, We
         break;
     }
 
-    if (state_changed && on_audio_play_state_changed)
+    if (!state_changed)
+        return;
+
+    client().update_process_priority();
+    if (on_audio_play_state_changed)
         on_audio_play_state_changed(m_audio_play_state);
 }
 
@@ -1320,8 +1338,11 @@ void ViewImplementation::reset_page_media_state()
     m_audio_play_state = Web::HTML::AudioPlayState::Paused;
     m_number_of_elements_playing_audio = 0;
 
-    if (should_notify_audio_play_state_changed && on_audio_play_state_changed)
-        on_audio_play_state_changed(m_audio_play_state);
+    if (should_notify_audio_play_state_changed) {
+        client().update_process_priority();
+        if (on_audio_play_state_changed)
+            on_audio_play_state_changed(m_audio_play_state);
+    }
 
     if (m_screen_wake_lock_state != Web::ScreenWakeLockState::Released) {
         m_screen_wake_lock_state = Web::ScreenWakeLockState::Released;
@@ -2232,6 +2253,12 @@ void ViewImplementation::handle_web_content_process_crash(LoadErrorPage load_err
     // Don't keep a stale backup bitmap around.
     m_backup_shared_image_buffer = nullptr;
 
+    // The crashed process will never send the screenshot we were waiting for.
+    if (auto pending_screenshot = move(m_pending_screenshot)) {
+        m_pending_screenshot_path.clear();
+        pending_screenshot->reject(Error::from_string_literal("WebContent process crashed while taking a screenshot"));
+    }
+
     m_top_level_traversable.did_crash_requiring_web_content_session_history_seed();
 
     handle_resize();
@@ -2344,12 +2371,14 @@ void ViewImplementation::update_bookmark_action()
     m_toggle_bookmark_action->set_engaged(is_bookmarked);
 }
 
-static ErrorOr<LexicalPath> save_screenshot(Gfx::Bitmap const* bitmap)
+static ErrorOr<LexicalPath> save_screenshot(Gfx::Bitmap const* bitmap, Optional<LexicalPath> destination = {})
 {
     if (!bitmap)
         return Error::from_string_literal("Failed to take a screenshot");
 
-    auto path = TRY([] -> ErrorOr<LexicalPath> {
+    auto path = TRY([&] -> ErrorOr<LexicalPath> {
+        if (destination.has_value())
+            return destination.release_value();
         if (auto const& screenshot_path = Application::browser_options().screenshot_path; screenshot_path.has_value())
             return LexicalPath { *screenshot_path };
 
@@ -2357,7 +2386,14 @@ static ErrorOr<LexicalPath> save_screenshot(Gfx::Bitmap const* bitmap)
         return Application::the().path_for_downloaded_file(file);
     }());
 
-    auto encoded = TRY(Gfx::PNGWriter::encode(*bitmap));
+    auto encoded = TRY([&] -> ErrorOr<ByteBuffer> {
+        if (path.extension().equals_ignoring_ascii_case("webp"sv)) {
+            AllocatingMemoryStream stream;
+            TRY(Gfx::WebPWriter::encode(stream, *bitmap));
+            return stream.read_until_eof();
+        }
+        return Gfx::PNGWriter::encode(*bitmap);
+    }());
 
     auto dump_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
     TRY(dump_file->write_until_depleted(encoded));
@@ -2365,7 +2401,7 @@ static ErrorOr<LexicalPath> save_screenshot(Gfx::Bitmap const* bitmap)
     return path;
 }
 
-NonnullRefPtr<Core::Promise<LexicalPath>> ViewImplementation::take_screenshot(ScreenshotType type)
+NonnullRefPtr<Core::Promise<LexicalPath>> ViewImplementation::take_screenshot(ScreenshotType type, Optional<LexicalPath> path)
 {
     auto promise = Core::Promise<LexicalPath>::construct();
 
@@ -2386,13 +2422,14 @@ NonnullRefPtr<Core::Promise<LexicalPath>> ViewImplementation::take_screenshot(Sc
             visible_bitmap = m_backup_shared_image_buffer->bitmap_if_present();
         }
         if (visible_bitmap) {
-            if (auto result = save_screenshot(visible_bitmap.ptr()); result.is_error())
+            if (auto result = save_screenshot(visible_bitmap.ptr(), move(path)); result.is_error())
                 promise->reject(result.release_error());
             else
                 promise->resolve(result.release_value());
         } else {
             // GPU-shared backing stores have no CPU-visible pixels, so ask WebContent to paint a screenshot for us.
             m_pending_screenshot = promise;
+            m_pending_screenshot_path = move(path);
             client().async_take_document_screenshot(page_id());
         }
         break;
@@ -2400,6 +2437,7 @@ NonnullRefPtr<Core::Promise<LexicalPath>> ViewImplementation::take_screenshot(Sc
 
     case ScreenshotType::Full:
         m_pending_screenshot = promise;
+        m_pending_screenshot_path = move(path);
         client().async_take_document_screenshot(page_id());
         break;
     }
@@ -2428,7 +2466,7 @@ void ViewImplementation::did_receive_screenshot(Badge<WebContentClient>, Gfx::Sh
 {
     VERIFY(m_pending_screenshot);
 
-    if (auto result = save_screenshot(screenshot.bitmap()); result.is_error())
+    if (auto result = save_screenshot(screenshot.bitmap(), exchange(m_pending_screenshot_path, {})); result.is_error())
         m_pending_screenshot->reject(result.release_error());
     else
         m_pending_screenshot->resolve(result.release_value());
@@ -2483,6 +2521,66 @@ ErrorOr<LexicalPath> ViewImplementation::dump_gc_graph()
     return path;
 }
 
+ErrorOr<LexicalPath> ViewImplementation::dump_gc_graph_snapshot()
+{
+    LexicalPath path { Core::StandardPaths::tempfile_directory() };
+    path = path.append(TRY(AK::UnixDateTime::now().to_string("gc-graph-%Y-%m-%d-%H-%M-%S.ndjson"sv)));
+
+    // WebContent streams the snapshot straight into the file, so the graph is never held in memory on either side.
+    auto dump_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+    client().async_dump_gc_graph_snapshot(IPC::File::adopt_file(move(dump_file)));
+
+    return path;
+}
+
+ErrorOr<LexicalPath> ViewImplementation::dump_frame_timeline()
+{
+    auto promise = request_internal_page_info(PageInfoType::FrameTimeline);
+    auto frame_timeline_json = TRY(promise->await());
+
+    LexicalPath path { Core::StandardPaths::tempfile_directory() };
+    path = path.append(TRY(AK::UnixDateTime::now().to_string("frame-timeline-%Y-%m-%d-%H-%M-%S.json"sv)));
+
+    // The file is in the Trace Event Format, so it can be opened in Perfetto or chrome://tracing.
+    auto dump_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+    TRY(dump_file->write_until_depleted(frame_timeline_json.bytes()));
+
+    return path;
+}
+
+ErrorOr<LexicalPath> ViewImplementation::dump_ipc_trace()
+{
+    auto promise = request_internal_page_info(PageInfoType::IPCTrace);
+    auto ipc_trace_json = TRY(promise->await());
+
+    LexicalPath path { Core::StandardPaths::tempfile_directory() };
+    path = path.append(TRY(AK::UnixDateTime::now().to_string("ipc-trace-%Y-%m-%d-%H-%M-%S.json"sv)));
+
+    auto dump_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+    TRY(dump_file->write_until_depleted(ipc_trace_json.bytes()));
+
+    return path;
+}
+
+ErrorOr<LexicalPath> ViewImplementation::dump_trace()
+{
+    auto promise = request_internal_page_info(PageInfoType::Trace);
+    auto web_content_trace_json = TRY(promise->await());
+
+    auto traces = Application::the().collect_trace_event_json();
+    traces.append(move(web_content_trace_json));
+    auto trace_json = Core::TraceEvents::merge_trace_event_json(traces);
+
+    LexicalPath path { Core::StandardPaths::tempfile_directory() };
+    path = path.append(TRY(AK::UnixDateTime::now().to_string("trace-%Y-%m-%d-%H-%M-%S.json"sv)));
+
+    // Every process is timed by the same monotonic clock, so their events line up on a single timeline.
+    auto dump_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+    TRY(dump_file->write_until_depleted(trace_json.bytes()));
+
+    return path;
+}
+
 void ViewImplementation::set_user_style_sheet(String const& source)
 {
     client().async_set_user_style(page_id(), source);
@@ -187,6 +187,8 @@ public:
     Optional<Utf16String> remove_session_storage_item(Utf16String const& key);
     bool clear_session_storage();
     void inspect_accessibility_tree();
+    void start_js_profiler(AK::Duration interval);
+    void stop_js_profiler();
     void get_hovered_node_id();
     void start_node_picker(DevTools::DevToolsDelegate::OnNodePickerEvent);
     void stop_node_picker();
@@ -300,7 +302,8 @@ public:
         Visible,
         Full,
     };
-    NonnullRefPtr<Core::Promise<LexicalPath>> take_screenshot(ScreenshotType);
+    // Screenshots are saved as PNG, or WebP if the given path has a .webp extension.
+    NonnullRefPtr<Core::Promise<LexicalPath>> take_screenshot(ScreenshotType, Optional<LexicalPath> path = {});
     NonnullRefPtr<Core::Promise<LexicalPath>> take_dom_node_screenshot(Web::UniqueNodeID);
     virtual void did_receive_screenshot(Badge<WebContentClient>, Gfx::ShareableBitmap const&);
 
@@ -308,6 +311,10 @@ public:
     void did_receive_internal_page_info(Badge<WebContentClient>, PageInfoType, Optional<Core::AnonymousBuffer> const&);
 
     ErrorOr<LexicalPath> dump_gc_graph();
+    ErrorOr<LexicalPath> dump_gc_graph_snapshot();
+    ErrorOr<LexicalPath> dump_frame_timeline();
+    ErrorOr<LexicalPath> dump_ipc_trace();
+    ErrorOr<LexicalPath> dump_trace();
 
     void set_user_style_sheet(String const& source);
 
@@ -355,6 +362,7 @@ public:
     Function<void(Optional<JsonObject>)> on_received_current_grid;
     Function<void(Optional<JsonObject>)> on_received_current_flexbox;
     Function<void(JsonObject)> on_received_accessibility_tree;
+    Function<void(Optional<JsonObject>)> on_received_js_profile;
     Function<void(Web::UniqueNodeID)> on_received_hovered_node_id;
     Function<void(Mutation)> on_dom_mutation_received;
     Function<void(Optional<Web::UniqueNodeID> const& node_id)> on_finished_editing_dom_node;
@@ -617,6 +625,7 @@ protected:
     RefPtr<Core::Timer> m_repeated_crash_timer;
 
     RefPtr<Core::Promise<LexicalPath>> m_pending_screenshot;
+    Optional<LexicalPath> m_pending_screenshot_path;
     RefPtr<Core::Promise<String>> m_pending_info_request;
 
     Web::HTML::AudioPlayState m_audio_play_state { Web::HTML::AudioPlayState::Paused };
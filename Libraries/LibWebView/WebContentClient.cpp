@@ -147,6 +147,30 @@ void WebContentClient::did_destroy_compositor_context(Web::Compositor::Composito
     forget_compositor_context(context_id);
 }
 
+void WebContentClient::did_finish_garbage_collection(u64 collection_count, i64 collection_time_us)
+{
+    if (auto process = WebView::Application::the().find_process(m_process_handle.pid); process.has_value())
+        process->did_finish_garbage_collection(collection_count, AK::Duration::from_microseconds(collection_time_us));
+}
+
+void WebContentClient::did_drop_frame(u64 dropped_frame_count)
+{
+    if (auto process = WebView::Application::the().find_process(m_process_handle.pid); process.has_value())
+        process->set_dropped_frame_count(dropped_frame_count);
+}
+
+void WebContentClient::did_report_ipc_statistics(IPC::TrafficStatistics statistics)
+{
+    if (auto process = WebView::Application::the().find_process(m_process_handle.pid); process.has_value())
+        process->set_ipc_statistics(move(statistics));
+}
+
+void WebContentClient::did_report_memory_statistics(WebView::MemoryStatistics statistics)
+{
+    if (auto process = WebView::Application::the().find_process(m_process_handle.pid); process.has_value())
+        process->set_memory_statistics(move(statistics));
+}
+
 bool WebContentClient::forget_compositor_context(Web::Compositor::CompositorContextId context_id)
 {
     if (!m_compositor_contexts.remove(context_id))
@@ -198,9 +222,26 @@ void WebContentClient::unregister_view(u64 page_id)
 
     m_views.remove(page_id);
     m_history_recorded_urls_for_current_load.remove(page_id);
+    update_process_priority();
     close_server_if_unused();
 }
 
+void WebContentClient::update_process_priority()
+{
+    // NB: A process without views is either starting up or about to go away, so we leave it alone.
+    if (m_views.is_empty())
+        return;
+
+    auto priority = Core::Process::Priority::Background;
+    for (auto const& [page_id, view] : m_views) {
+        if (view->traversable().system_visibility_state() == Web::HTML::VisibilityState::Visible || view->audio_play_state() == Web::HTML::AudioPlayState::Playing) {
+            priority = Core::Process::Priority::Normal;
+            break;
+        }
+    }
+    Application::process_manager().set_process_priority(pid(), priority);
+}
+
 bool WebContentClient::is_renderer_owned_download(u64 page_id, u64 download_id) const
 {
     auto owning_page_id = m_renderer_owned_downloads.get(download_id);
@@ -702,7 +743,7 @@ Messages::WebContentClient::DidStartDownloadResponse WebContentClient::did_start
     return { download_id };
 }
 
-void WebContentClient::did_receive_download_data(u64 page_id, u64 download_id, ByteBuffer data)
+void WebContentClient::did_receive_download_data(u64 page_id, u64 download_id, IPC::BorrowedBytes data)
 {
     if (!is_renderer_owned_download(page_id, download_id))
         return;
@@ -1102,6 +1143,20 @@ void WebContentClient::did_inspect_accessibility_tree(u64 page_id, String access
     }
 }
 
+void WebContentClient::did_stop_js_profiler(u64 page_id, String profile)
+{
+    if (auto view = view_for_page_id(page_id); view.has_value()) {
+        if (!view->on_received_js_profile)
+            return;
+
+        // An empty profile means the profiler was not running, or could not be started.
+        if (profile.is_empty())
+            view->on_received_js_profile({});
+        else
+            view->on_received_js_profile(parse_json(profile, "JavaScript profile"sv));
+    }
+}
+
 void WebContentClient::did_get_hovered_node_id(u64 page_id, Web::UniqueNodeID node_id)
 {
     if (auto view = view_for_page_id(page_id); view.has_value()) {
@@ -1392,29 +1447,72 @@ Messages::WebContentClient::DidLoseRequestServerConnectionResponse WebContentCli
     return handle.release_value();
 }
 
-Messages::WebContentClient::DidRequestStorageItemResponse WebContentClient::did_request_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Utf16String bottle_key)
+void WebContentClient::broadcast_storage_item_change(IsPrivate is_private, Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, Optional<Utf16String> const& key, Optional<Utf16String> const& value, WebContentClient const* originator)
 {
-    return Application::storage_jar(m_is_private).get_item(storage_endpoint, storage_key, bottle_key);
+    auto version = Application::storage_jar(is_private).version();
+
+    // NB: The client that made the change is told about it as well, as its copy of the storage area only becomes
+    //     consistent with ours once it knows how its writes were ordered among those of other clients.
+    WebContentClient::for_each_client([&](auto& client) {
+        if (client.is_private() != is_private || !client.has_opened_storage_area(storage_endpoint, storage_key))
+            return IterationDecision::Continue;
+        client.async_storage_item_changed(storage_endpoint, storage_key, key, value, version, &client == originator);
+        return IterationDecision::Continue;
+    });
 }
 
-Messages::WebContentClient::DidSetStorageItemResponse WebContentClient::did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Utf16String bottle_key, Utf16String value)
+void WebContentClient::broadcast_storage_areas_invalidated()
 {
-    return Application::storage_jar(m_is_private).set_item(storage_endpoint, storage_key, bottle_key, value);
+    WebContentClient::for_each_client([&](auto& client) {
+        client.async_storage_areas_invalidated();
+        return IterationDecision::Continue;
+    });
 }
 
-void WebContentClient::did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Utf16String bottle_key)
+bool WebContentClient::has_opened_storage_area(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key) const
 {
-    Application::storage_jar(m_is_private).remove_item(storage_endpoint, storage_key, bottle_key);
+    return m_opened_storage_areas[to_underlying(storage_endpoint)].contains(storage_key);
 }
 
-Messages::WebContentClient::DidRequestStorageKeysResponse WebContentClient::did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key)
+Messages::WebContentClient::DidRequestStorageAreaResponse WebContentClient::did_request_storage_area(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key)
 {
-    return Application::storage_jar(m_is_private).get_all_keys(storage_endpoint, storage_key);
+    auto& storage_jar = Application::storage_jar(m_is_private);
+    m_opened_storage_areas[to_underlying(storage_endpoint)].set(storage_key);
+
+    auto keys = storage_jar.get_all_keys(storage_endpoint, storage_key);
+
+    Vector<Utf16String> values;
+    values.ensure_capacity(keys.size());
+    for (auto const& key : keys)
+        values.unchecked_append(storage_jar.get_item(storage_endpoint, storage_key, key).value_or({}));
+
+    return { move(keys), move(values), storage_jar.version() };
+}
+
+void WebContentClient::did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Utf16String bottle_key, Utf16String value)
+{
+    auto& storage_jar = Application::storage_jar(m_is_private);
+
+    // NB: The WebContent process checks the quota as well, but its copy of the storage area may be missing the writes
+    //     of other processes. It has stored the value already, so only it has to be told about the value we kept.
+    if (storage_jar.set_item(storage_endpoint, storage_key, bottle_key, value).has<StorageOperationError>()) {
+        async_storage_item_changed(storage_endpoint, storage_key, bottle_key, storage_jar.get_item(storage_endpoint, storage_key, bottle_key), storage_jar.version(), true);
+        return;
+    }
+
+    broadcast_storage_item_change(m_is_private, storage_endpoint, storage_key, bottle_key, value, this);
+}
+
+void WebContentClient::did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Utf16String bottle_key)
+{
+    Application::storage_jar(m_is_private).remove_item(storage_endpoint, storage_key, bottle_key);
+    broadcast_storage_item_change(m_is_private, storage_endpoint, storage_key, bottle_key, {}, this);
 }
 
 void WebContentClient::did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key)
 {
     Application::storage_jar(m_is_private).clear_storage_key(storage_endpoint, storage_key);
+    broadcast_storage_item_change(m_is_private, storage_endpoint, storage_key, {}, {}, this);
 }
 
 Messages::WebContentClient::DidRequestStorageUsageResponse WebContentClient::did_request_storage_usage(String storage_key)
@@ -1422,8 +1520,19 @@ Messages::WebContentClient::DidRequestStorageUsageResponse WebContentClient::did
     return Application::storage_jar(m_is_private).usage(storage_key);
 }
 
-void WebContentClient::did_change_storage_item(u64 page_id, Web::StorageAPI::StorageEndpointType storage_endpoint, String url, Optional<Utf16String> key, Optional<Utf16String> old_value, Optional<Utf16String> new_value)
+void WebContentClient::did_change_storage_item(u64 page_id, Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String url, Optional<Utf16String> key, Optional<Utf16String> old_value, Optional<Utf16String> new_value)
 {
+    // Documents in the same process were notified by that process already. Documents in processes that have never loaded
+    // the storage area have no Storage object that could fire the event.
+    if (storage_endpoint == Web::StorageAPI::StorageEndpointType::LocalStorage) {
+        WebContentClient::for_each_client([&](auto& client) {
+            if (&client == this || client.is_private() != m_is_private || !client.has_opened_storage_area(storage_endpoint, storage_key))
+                return IterationDecision::Continue;
+            client.async_local_storage_changed_in_other_process(storage_key, url, key, old_value, new_value);
+            return IterationDecision::Continue;
+        });
+    }
+
     if (auto view = view_for_page_id(page_id); view.has_value()) {
         auto host = DevTools::storage_host_for_url(url);
         if (!host.has_value())
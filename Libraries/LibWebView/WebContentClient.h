@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullRawPtr.h>
 #include <AK/Optional.h>
@@ -66,6 +67,10 @@ public:
     static size_t client_count() { return clients().size(); }
     static Optional<WebContentClient&> client_for_compositor_context_id(Web::Compositor::CompositorContextId);
 
+    // Keeps the copies of storage areas in WebContent processes in sync with the storage jar.
+    static void broadcast_storage_item_change(IsPrivate, Web::StorageAPI::StorageEndpointType, String const& storage_key, Optional<Utf16String> const& key, Optional<Utf16String> const& value, WebContentClient const* originator = nullptr);
+    static void broadcast_storage_areas_invalidated();
+
     WebContentClient(NonnullOwnPtr<IPC::Transport>, IsPrivate, u64 initial_page_id, Web::HTML::CrossProcessId root_navigable_id);
     ~WebContentClient();
 
@@ -75,6 +80,9 @@ public:
     void register_view(u64 page_id, ViewImplementation&);
     void unregister_view(u64 page_id);
 
+    // Lowers the priority of the process while none of its views are visible or playing audio.
+    void update_process_priority();
+
     void set_compositor_connection_id(Badge<Application>, i32);
     Optional<i32> compositor_connection_id(Badge<Application>) const { return m_compositor_connection_id; }
 
@@ -123,6 +131,10 @@ private:
 
     virtual Messages::WebContentClient::AllocateCompositorContextIdResponse allocate_compositor_context_id(u64 page_id, Web::Compositor::PagePresentationRegistration) override;
     virtual void did_destroy_compositor_context(Web::Compositor::CompositorContextId) override;
+    virtual void did_finish_garbage_collection(u64 collection_count, i64 collection_time_us) override;
+    virtual void did_drop_frame(u64 dropped_frame_count) override;
+    virtual void did_report_ipc_statistics(IPC::TrafficStatistics statistics) override;
+    virtual void did_report_memory_statistics(WebView::MemoryStatistics statistics) override;
     virtual Messages::WebContentClient::DecideNavigationProcessResponse decide_navigation_process(u64 page_id, Optional<Web::HTML::CrossProcessId> frame_id, URL::URL current_url, URL::URL target_url, Web::NavigationTarget) override;
     virtual void did_request_new_process_for_navigation(u64 page_id, URL::URL url, Web::HTML::DocumentResource document_resource, Web::Bindings::NavigationHistoryBehavior history_handling, Optional<Web::HTML::NavigationSourceSnapshot> source_snapshot) override;
     virtual void did_request_new_process_for_child_frame_navigation(u64 page_id, Web::HTML::CrossProcessId frame_id, URL::URL url, Web::HTML::DocumentResource document_resource, Web::Bindings::NavigationHistoryBehavior history_handling, Optional<Web::HTML::NavigationSourceSnapshot> source_snapshot) override;
@@ -150,7 +162,7 @@ private:
     virtual void did_cancel_loading(u64 page_id, Optional<Utf16String>, URL::URL) override;
     virtual Messages::WebContentClient::DidStartDownloadWithoutRequestResponse did_start_download_without_request(u64 page_id, URL::URL, ByteString suggested_filename, Optional<u64> total_size) override;
     virtual Messages::WebContentClient::DidStartDownloadResponse did_start_download(u64 page_id, URL::URL, ByteString suggested_filename, Optional<u64> total_size, int request_server_client_id, u64 request_server_request_id, ByteBuffer initial_data) override;
-    virtual void did_receive_download_data(u64 page_id, u64 download_id, ByteBuffer data) override;
+    virtual void did_receive_download_data(u64 page_id, u64 download_id, IPC::BorrowedBytes data) override;
     virtual void did_finish_download(u64 page_id, u64 download_id) override;
     virtual void did_fail_download(u64 page_id, u64 download_id, String error) override;
     virtual void did_request_context_menu(u64 page_id, Gfx::IntPoint, Web::ContextMenuForInputEventsTarget) override;
@@ -166,6 +178,7 @@ private:
     virtual void did_inspect_current_flexbox(u64 page_id, String) override;
     virtual void did_inspect_indexed_database(u64 page_id, u64 request_id, String) override;
     virtual void did_inspect_accessibility_tree(u64 page_id, String) override;
+    virtual void did_stop_js_profiler(u64 page_id, String) override;
     virtual void did_get_hovered_node_id(u64 page_id, Web::UniqueNodeID node_id) override;
     virtual void did_get_node_id_at_position(u64 page_id, u64 request_id, Web::UniqueNodeID node_id) override;
     virtual void did_finish_editing_dom_node(u64 page_id, Optional<Web::UniqueNodeID> node_id) override;
@@ -204,13 +217,12 @@ private:
     virtual void did_store_hsts_policy(String, HTTP::HSTS::ParsedHSTSPolicy) override;
     virtual Messages::WebContentClient::DidIsKnownHstsHostResponse did_is_known_hsts_host(String) override;
     virtual Messages::WebContentClient::DidLoseRequestServerConnectionResponse did_lose_request_server_connection() override;
-    virtual Messages::WebContentClient::DidRequestStorageItemResponse did_request_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Utf16String bottle_key) override;
-    virtual Messages::WebContentClient::DidSetStorageItemResponse did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Utf16String bottle_key, Utf16String value) override;
+    virtual Messages::WebContentClient::DidRequestStorageAreaResponse did_request_storage_area(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
+    virtual void did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Utf16String bottle_key, Utf16String value) override;
     virtual void did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Utf16String bottle_key) override;
-    virtual Messages::WebContentClient::DidRequestStorageKeysResponse did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
     virtual void did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
     virtual Messages::WebContentClient::DidRequestStorageUsageResponse did_request_storage_usage(String storage_key) override;
-    virtual void did_change_storage_item(u64 page_id, Web::StorageAPI::StorageEndpointType storage_endpoint, String url, Optional<Utf16String> key, Optional<Utf16String> old_value, Optional<Utf16String> new_value) override;
+    virtual void did_change_storage_item(u64 page_id, Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String url, Optional<Utf16String> key, Optional<Utf16String> old_value, Optional<Utf16String> new_value) override;
     virtual void did_update_indexed_database(u64 page_id, String update) override;
     virtual void did_post_broadcast_channel_message(u64 page_id, Web::HTML::BroadcastChannelMessage message) override;
     virtual Messages::WebContentClient::DidRequestNewWebViewResponse did_request_new_web_view(u64 page_id, Web::HTML::ActivateTab, Web::HTML::WebViewHints) override;
@@ -279,6 +291,8 @@ private:
     void forget_renderer_owned_download(u64 download_id);
     void fail_renderer_owned_downloads();
 
+    bool has_opened_storage_area(Web::StorageAPI::StorageEndpointType, String const& storage_key) const;
+
     IsPrivate m_is_private { IsPrivate::No };
 
     HashMap<u64, NonnullRawPtr<ViewImplementation>> m_views;
@@ -287,6 +301,10 @@ private:
     HashMap<Web::Compositor::CompositorContextId, Optional<u64>> m_compositor_contexts;
     HashMap<u64, u64> m_renderer_owned_downloads;
     HashMap<u64, String> m_history_recorded_urls_for_current_load;
+
+    // The storage keys of the storage areas this process has loaded a copy of, for each storage endpoint. Only these
+    // processes are told about changes, as the others have nothing to keep in sync and no documents that could see them.
+    Array<HashTable<String>, to_underlying(Web::StorageAPI::StorageEndpointType::Count)> m_opened_storage_areas;
     Optional<i32> m_compositor_connection_id;
     u64 m_initial_page_id { 0 };
     Web::HTML::CrossProcessId m_root_navigable_id;
@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibIPC/Statistics.h>
+#include <LibImageDecoderClient/Client.h>
 #include <LibWebView/Application.h>
 #include <LibWebView/ProcessManager.h>
 #include <LibWebView/SiteIsolationManager.h>
+#include <LibWebView/WebContentClient.h>
 #include <LibWebView/WebUI/ProcessesUI.h>
 
 #include <AK/JsonArray.h>
@@ -20,6 +23,49 @@ void ProcessesUI::register_interfaces()
     register_interface("updateProcessStatistics"sv, [this](auto const&) {
         update_process_statistics();
     });
+    register_interface("measureMemory"sv, [this](auto const&) {
+        measure_memory();
+    });
+}
+
+static JsonArray serialize_memory_statistics(MemoryStatistics const& statistics)
+{
+    JsonArray entries;
+    for (auto const& entry : statistics.entries) {
+        JsonObject object;
+        object.set("category"sv, entry.category);
+        object.set("name"sv, entry.name);
+        object.set("bytes"sv, entry.bytes);
+        object.set("count"sv, entry.count);
+        entries.must_append(move(object));
+    }
+    return entries;
+}
+
+static JsonObject serialize_ipc_statistics(IPC::TrafficStatistics const& statistics)
+{
+    JsonArray messages;
+    for (auto const& message : statistics.messages) {
+        JsonObject object;
+        object.set("name"sv, message.message_name);
+        object.set("count"sv, message.count);
+        object.set("bytes"sv, message.bytes);
+        object.set("queueingTime"sv, message.total_queueing_delay.to_microseconds());
+        object.set("longestQueueingTime"sv, message.longest_queueing_delay.to_microseconds());
+        object.set("handledCount"sv, message.handled_count);
+        object.set("handlerTime"sv, message.total_handler_time.to_microseconds());
+        object.set("longestHandlerTime"sv, message.longest_handler_time.to_microseconds());
+        messages.must_append(move(object));
+    }
+
+    JsonObject object;
+    object.set("recordingTime"sv, statistics.recording_time.to_milliseconds());
+    object.set("sentMessages"sv, statistics.sent_message_count);
+    object.set("sentBytes"sv, statistics.sent_bytes);
+    object.set("receivedMessages"sv, statistics.received_message_count);
+    object.set("receivedBytes"sv, statistics.received_bytes);
+    object.set("messages"sv, move(messages));
+    return object;
 }
 
 void ProcessesUI::update_process_statistics()
@@ -27,6 +73,18 @@ void ProcessesUI::update_process_statistics()
     auto& process_manager = Application::process_manager();
     process_manager.update_all_process_statistics();
 
+    if (IPC::Statistics::is_enabled()) {
+        // WebContent reports its statistics asynchronously, so they show up on the next update.
+        process_manager.for_each_process([](Process& process) {
+            if (process.type() == ProcessType::Browser) {
+                process.set_ipc_statistics(IPC::Statistics::the().snapshot());
+            } else if (process.type() == ProcessType::WebContent) {
+                if (auto client = process.client<WebContentClient>(); client.has_value())
+                    client->async_request_ipc_statistics();
+            }
+        });
+    }
+
     auto process_embedders = SiteIsolationManager::the().remote_frame_process_embedders();
     auto serialize_process_statistics = [&] {
         JsonArray serialized;
@@ -44,6 +102,20 @@ void ProcessesUI::update_process_statistics()
             object.set("pid"sv, statistics.pid);
             object.set("cpu"sv, statistics.cpu_percent);
             object.set("memory"sv, statistics.memory_usage_bytes);
+            if (auto const& gc_statistics = process.garbage_collection_statistics(); gc_statistics.has_value()) {
+                object.set("gcCount"sv, gc_statistics->collection_count);
+                object.set("gcTime"sv, gc_statistics->total_collection_time.to_milliseconds());
+                object.set("gcLongest"sv, gc_statistics->longest_collection_time.to_milliseconds());
+            } else {
+                object.set("gcCount"sv, 0);
+                object.set("gcTime"sv, 0);
+                object.set("gcLongest"sv, 0);
+            }
+            object.set("droppedFrames"sv, process.dropped_frame_count());
+            if (auto const& ipc_statistics = process.ipc_statistics(); ipc_statistics.has_value())
+                object.set("ipc"sv, serialize_ipc_statistics(*ipc_statistics));
+            if (auto const& memory_statistics = process.memory_statistics(); memory_statistics.has_value())
+                object.set("memoryBreakdown"sv, serialize_memory_statistics(*memory_statistics));
             if (auto embedder_pid = process_embedders.get(statistics.pid); embedder_pid.has_value())
                 object.set("embedderPID"sv, *embedder_pid);
             serialized.must_append(move(object));
@@ -55,4 +127,27 @@ void ProcessesUI::update_process_statistics()
     async_send_message("loadProcessStatistics"sv, serialize_process_statistics());
 }
 
+// Measuring walks the whole GC heap of each WebContent process, so it only happens when asked for rather than on every
+// update. The processes report back asynchronously, so the breakdown shows up on the next update.
+void ProcessesUI::measure_memory()
+{
+    Application::process_manager().for_each_process([](Process& process) {
+        if (process.type() == ProcessType::WebContent) {
+            if (auto client = process.client<WebContentClient>(); client.has_value())
+                client->async_request_memory_statistics();
+        } else if (process.type() == ProcessType::ImageDecoder) {
+            if (auto client = process.client<ImageDecoderClient::Client>(); client.has_value()) {
+                client->on_memory_statistics = [pid = process.pid()](u64 cached_image_bytes, u64 cached_image_count) {
+                    if (auto process = Application::the().find_process(pid); process.has_value()) {
+                        MemoryStatistics statistics;
+                        statistics.add("Decoded images"sv, "Shared with WebContent"sv, cached_image_bytes, cached_image_count);
+                        process->set_memory_statistics(move(statistics));
+                    }
+                };
+                client->async_request_memory_statistics();
+            }
+        }
+    });
+}
+
 }
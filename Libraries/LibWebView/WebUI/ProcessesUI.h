@@ -18,6 +18,7 @@ private:
     virtual void register_interfaces() override;
 
     void update_process_statistics();
+    void measure_memory();
 };
 
 }
@@ -38,6 +38,8 @@ public:
     pid_t pid() const { return m_pid; }
     void set_pid(pid_t pid) { m_pid = pid; }
 
+    void set_agent_id(Web::HTML::WorkerAgentId agent_id) { m_agent_id = agent_id; }
+
     virtual void did_close_worker() override;
     virtual void did_finish_loading_worker_script(bool worker_is_secure_context) override;
     virtual void did_fail_loading_worker_script() override;
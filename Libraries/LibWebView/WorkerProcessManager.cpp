@@ -110,18 +110,26 @@ Web::HTML::WorkerAgentId WorkerProcessManager::start_worker_agent(Owner owner, W
 
     // 11.6. Otherwise, in parallel, run a worker given worker, urlRecord, outsideSettings, outsidePort,
     //       and options.
-    // AD-HOC: For DedicatedWorker there is no shared worker manager step; we always launch a fresh
-    //         worker process here.
+    // AD-HOC: For DedicatedWorker there is no shared worker manager step; we always use a fresh worker process here,
+    //         which is a spare one that was launched ahead of time if there is one.
     auto agent_id = ++m_next_agent_id;
-    auto client = MUST(launch_web_worker_process(request.agent_type, is_private, agent_id));
 
-    auto request_server_handle = MUST(connect_new_request_server_client(is_private));
-    auto image_decoder_handle = MUST(connect_new_image_decoder_client());
-    client->async_connect_to_request_server(move(request_server_handle));
-    client->async_connect_to_image_decoder(move(image_decoder_handle));
-
-    if (auto compositor_handle = Application::the().connect_new_compositor_canvas_client(); !compositor_handle.is_error())
-        client->async_connect_to_compositor(compositor_handle.release_value());
+    RefPtr<WebWorkerClient> client;
+    if (request.agent_type == Web::Bindings::AgentType::DedicatedWorker) {
+        client = move(spare_dedicated_worker(is_private));
+        if (client && client->is_open())
+            client->set_agent_id(agent_id);
+        else
+            client = launch_worker_process(request.agent_type, is_private, agent_id);
+
+        // NB: Pages that start one dedicated worker tend to start more, so get the next process ready once this one is
+        //     running.
+        Core::deferred_invoke([this, is_private] {
+            launch_spare_dedicated_worker_if_needed(is_private);
+        });
+    } else {
+        client = launch_worker_process(request.agent_type, is_private, agent_id);
+    }
 
     Vector<Owner> owners;
     owners.append(owner);
@@ -132,7 +140,7 @@ Web::HTML::WorkerAgentId WorkerProcessManager::start_worker_agent(Owner owner, W
     //         inherits from outside settings, so should match).
     WorkerAgent agent {
         .id = agent_id,
-        .client = client,
+        .client = *client,
         .agent_type = request.agent_type,
         .worker_type = request.type,
         .credentials = request.credentials,
@@ -159,6 +167,36 @@ Web::HTML::WorkerAgentId WorkerProcessManager::start_worker_agent(Owner owner, W
     return agent_id;
 }
 
+NonnullRefPtr<WebWorkerClient> WorkerProcessManager::launch_worker_process(Web::Bindings::AgentType agent_type, IsPrivate is_private, Web::HTML::WorkerAgentId agent_id)
+{
+    auto client = MUST(launch_web_worker_process(agent_type, is_private, agent_id));
+
+    auto request_server_handle = MUST(connect_new_request_server_client(is_private));
+    auto image_decoder_handle = MUST(connect_new_image_decoder_client());
+    client->async_connect_to_request_server(move(request_server_handle));
+    client->async_connect_to_image_decoder(move(image_decoder_handle));
+
+    if (auto compositor_handle = Application::the().connect_new_compositor_canvas_client(); !compositor_handle.is_error())
+        client->async_connect_to_compositor(compositor_handle.release_value());
+
+    return client;
+}
+
+RefPtr<WebWorkerClient>& WorkerProcessManager::spare_dedicated_worker(IsPrivate is_private)
+{
+    return is_private == IsPrivate::Yes ? m_spare_private_dedicated_worker : m_spare_dedicated_worker;
+}
+
+void WorkerProcessManager::launch_spare_dedicated_worker_if_needed(IsPrivate is_private)
+{
+    auto& spare_worker = spare_dedicated_worker(is_private);
+    if (spare_worker && spare_worker->is_open())
+        return;
+
+    // NB: The spare process reports to agent ID 0, which no agent has, until it is taken.
+    spare_worker = launch_worker_process(Web::Bindings::AgentType::DedicatedWorker, is_private, 0);
+}
+
 void WorkerProcessManager::close_worker_agent(WebContentClient& client, Web::HTML::WorkerAgentId agent_id, Web::HTML::WorkerAgentOwnerToken owner_token)
 {
     Owner identity {
@@ -9,6 +9,7 @@
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
+#include <AK/RefPtr.h>
 #include <AK/Utf16String.h>
 #include <AK/Variant.h>
 #include <AK/Vector.h>
@@ -64,6 +65,10 @@ private:
 
     Web::HTML::WorkerAgentId start_worker_agent(Owner, Web::HTML::WorkerAgentStartRequest, IsPrivate);
 
+    NonnullRefPtr<WebWorkerClient> launch_worker_process(Web::Bindings::AgentType, IsPrivate, Web::HTML::WorkerAgentId);
+    RefPtr<WebWorkerClient>& spare_dedicated_worker(IsPrivate);
+    void launch_spare_dedicated_worker_if_needed(IsPrivate);
+
     void notify_worker_script_load_success(Owner const&);
     void notify_worker_script_load_failure(Owner const&);
     void notify_worker_exception(Owner const&, Utf16String const& message, Utf16String const& filename, u32 lineno, u32 colno);
@@ -97,6 +102,11 @@ private:
     Web::HTML::WorkerAgentId m_next_agent_id { 0 };
     HashMap<Web::HTML::WorkerAgentId, WorkerAgent> m_agents;
     HashMap<SharedWorkerKey, Web::HTML::WorkerAgentId> m_shared_workers;
+
+    // A dedicated worker process that was launched ahead of time, so that the next dedicated worker does not have to
+    // wait for a process to start. It has no agent ID until it is taken.
+    RefPtr<WebWorkerClient> m_spare_dedicated_worker;
+    RefPtr<WebWorkerClient> m_spare_private_dedicated_worker;
 };
 
 }
@@ -501,9 +501,43 @@ static xmlSAXHandler create_sax_handler(bool preserve_comments, bool resolve_htm
     return handler;
 }
 
+static xmlParserCtxtPtr create_push_parser_context(ParserContext& context, Parser::Options const& options)
+{
+    bool resolve_html_entities = static_cast<bool>(options.resolve_named_html_entity);
+    auto sax_handler = create_sax_handler(options.preserve_comments, resolve_html_entities);
+
+    int parser_options = XML_PARSE_NONET | XML_PARSE_NOWARNING;
+    if (!options.preserve_cdata)
+        parser_options |= XML_PARSE_NOCDATA;
+
+    auto* parser_ctx = xmlCreatePushParserCtxt(&sax_handler, nullptr, nullptr, 0, nullptr);
+    if (!parser_ctx)
+        return nullptr;
+
+    parser_ctx->_private = &context;
+    xmlCtxtUseOptions(parser_ctx, parser_options);
+
+    xmlSwitchEncoding(parser_ctx, XML_CHAR_ENCODING_UTF8);
+    return parser_ctx;
+}
+
+static ErrorOr<void, ParseError> result_of_parsing(ParserContext const& context, Parser::Options const& options, Vector<ParseError> const& parse_errors, int result, bool well_formed)
+{
+    if (context.error.has_value() && options.treat_errors_as_fatal)
+        return context.error.value();
+
+    if (result != 0 || !well_formed) {
+        if (!parse_errors.is_empty())
+            return parse_errors.first();
+        return ParseError { {}, ByteString("XML parsing failed") };
+    }
+
+    return {};
+}
+
 ErrorOr<void, ParseError> Parser::parse_with_listener(Listener& listener)
 {
-    auto source_result = listener.set_source(ByteString(m_source));
+    auto source_result = listener.set_source(m_source);
     if (source_result.is_error())
         return ParseError { {}, ByteString("Failed to set source") };
 
@@ -511,22 +545,10 @@ ErrorOr<void, ParseError> Parser::parse_with_listener(Listener& listener)
     context.listener = &listener;
     context.options = &m_options;
 
-    bool resolve_html_entities = static_cast<bool>(m_options.resolve_named_html_entity);
-    auto sax_handler = create_sax_handler(m_options.preserve_comments, resolve_html_entities);
-
-    int options = XML_PARSE_NONET | XML_PARSE_NOWARNING;
-    if (!m_options.preserve_cdata)
-        options |= XML_PARSE_NOCDATA;
-
-    auto* parser_ctx = xmlCreatePushParserCtxt(&sax_handler, nullptr, nullptr, 0, nullptr);
+    auto* parser_ctx = create_push_parser_context(context, m_options);
     if (!parser_ctx)
         return ParseError { {}, ByteString("Failed to create parser context") };
 
-    parser_ctx->_private = &context;
-    xmlCtxtUseOptions(parser_ctx, options);
-
-    xmlSwitchEncoding(parser_ctx, XML_CHAR_ENCODING_UTF8);
-
     auto result = xmlParseChunk(parser_ctx, m_source.characters_without_null_termination(), static_cast<int>(m_source.length()), 1);
 
     bool well_formed = parser_ctx->wellFormed;
@@ -537,16 +559,7 @@ ErrorOr<void, ParseError> Parser::parse_with_listener(Listener& listener)
     if (!context.document_ended)
         listener.document_end();
 
-    if (context.error.has_value() && m_options.treat_errors_as_fatal)
-        return context.error.release_value();
-
-    if (result != 0 || !well_formed) {
-        if (!m_parse_errors.is_empty())
-            return m_parse_errors.first();
-        return ParseError { {}, ByteString("XML parsing failed") };
-    }
-
-    return {};
+    return result_of_parsing(context, m_options, m_parse_errors, result, well_formed);
 }
 
 ErrorOr<Document, ParseError> Parser::parse()
@@ -554,22 +567,10 @@ ErrorOr<Document, ParseError> Parser::parse()
     ParserContext context;
     context.options = &m_options;
 
-    bool resolve_html_entities = static_cast<bool>(m_options.resolve_named_html_entity);
-    auto sax_handler = create_sax_handler(m_options.preserve_comments, resolve_html_entities);
-
-    int options = XML_PARSE_NONET | XML_PARSE_NOWARNING;
-    if (!m_options.preserve_cdata)
-        options |= XML_PARSE_NOCDATA;
-
-    auto* parser_ctx = xmlCreatePushParserCtxt(&sax_handler, nullptr, nullptr, 0, nullptr);
+    auto* parser_ctx = create_push_parser_context(context, m_options);
     if (!parser_ctx)
         return ParseError { {}, ByteString("Failed to create parser context") };
 
-    parser_ctx->_private = &context;
-    xmlCtxtUseOptions(parser_ctx, options);
-
-    xmlSwitchEncoding(parser_ctx, XML_CHAR_ENCODING_UTF8);
-
     auto result = xmlParseChunk(parser_ctx, m_source.characters_without_null_termination(), static_cast<int>(m_source.length()), 1);
 
     bool well_formed = parser_ctx->wellFormed;
@@ -577,14 +578,7 @@ ErrorOr<Document, ParseError> Parser::parse()
 
     m_parse_errors = move(context.parse_errors);
 
-    if (context.error.has_value() && m_options.treat_errors_as_fatal)
-        return context.error.release_value();
-
-    if (result != 0 || !well_formed) {
-        if (!m_parse_errors.is_empty())
-            return m_parse_errors.first();
-        return ParseError { {}, ByteString("XML parsing failed") };
-    }
+    TRY(result_of_parsing(context, m_options, m_parse_errors, result, well_formed));
 
     if (!context.root_node)
         return ParseError { {}, ByteString("No root element") };
@@ -592,4 +586,59 @@ ErrorOr<Document, ParseError> Parser::parse()
     return Document(context.root_node.release_nonnull(), move(context.doctype), move(context.processing_instructions), context.version);
 }
 
+StreamingParser::StreamingParser(Listener& listener, Parser::Options options)
+    : m_options(move(options))
+    , m_context(make<ParserContext>())
+{
+    m_context->listener = &listener;
+    m_context->options = &m_options;
+    m_parser_context = create_push_parser_context(*m_context, m_options);
+}
+
+StreamingParser::~StreamingParser()
+{
+    if (m_parser_context)
+        xmlFreeParserCtxt(m_parser_context);
+}
+
+Vector<ParseError> const& StreamingParser::parse_error_causes() const
+{
+    return m_context->parse_errors;
+}
+
+ErrorOr<void, ParseError> StreamingParser::parse_chunk(StringView chunk)
+{
+    return parse(chunk, false);
+}
+
+ErrorOr<void, ParseError> StreamingParser::finish()
+{
+    return parse({}, true);
+}
+
+ErrorOr<void, ParseError> StreamingParser::parse(StringView chunk, bool is_last_chunk)
+{
+    VERIFY(!m_is_finished);
+
+    if (!m_parser_context) {
+        m_is_finished = true;
+        return ParseError { {}, ByteString("Failed to create parser context") };
+    }
+
+    // NB: libxml2 keeps whatever it can't parse yet (e.g. half of a tag) around until the next chunk arrives.
+    auto result = xmlParseChunk(m_parser_context, chunk.characters_without_null_termination(), static_cast<int>(chunk.length()), is_last_chunk ? 1 : 0);
+    bool well_formed = m_parser_context->wellFormed;
+
+    auto parse_result = result_of_parsing(*m_context, m_options, m_context->parse_errors, result, well_formed);
+    if (!parse_result.is_error() && !is_last_chunk)
+        return {};
+
+    // Once the document has ended or turned out to be malformed, no more chunks are going to be parsed.
+    m_is_finished = true;
+    if (!m_context->document_ended)
+        m_context->listener->document_end();
+
+    return parse_result;
+}
+
 }
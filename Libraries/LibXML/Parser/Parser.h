@@ -11,6 +11,8 @@
 #include <AK/Function.h>
 #include <AK/GenericLexer.h>
 #include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/String.h>
@@ -23,8 +25,12 @@
 #include <LibXML/Export.h>
 #include <LibXML/Forward.h>
 
+struct _xmlParserCtxt;
+
 namespace XML {
 
+struct ParserContext;
+
 struct Expectation {
     StringView expected;
 };
@@ -42,7 +48,7 @@ struct ListenerAttribute {
 struct Listener {
     virtual ~Listener() { }
 
-    virtual ErrorOr<void> set_source(ByteString) { return {}; }
+    virtual ErrorOr<void> set_source(StringView) { return {}; }
     virtual void set_doctype(XML::Doctype) { }
     virtual void document_start() { }
     virtual void document_end() { }
@@ -86,6 +92,34 @@ private:
     Vector<ParseError> m_parse_errors;
 };
 
+// Parses a document that arrives in chunks, e.g. from the network, reporting everything in a chunk to the listener as
+// soon as it's parsed. Unlike Parser::parse_with_listener(), this never gives the source to the listener.
+class XML_API StreamingParser {
+    AK_MAKE_NONCOPYABLE(StreamingParser);
+    AK_MAKE_NONMOVABLE(StreamingParser);
+
+public:
+    explicit StreamingParser(Listener&, Parser::Options = {});
+    ~StreamingParser();
+
+    // Once either of these returns an error, or finish() has been called, the listener has seen the end of the
+    // document and no more chunks may be parsed.
+    ErrorOr<void, ParseError> parse_chunk(StringView);
+    ErrorOr<void, ParseError> finish();
+
+    bool is_finished() const { return m_is_finished; }
+
+    Vector<ParseError> const& parse_error_causes() const;
+
+private:
+    ErrorOr<void, ParseError> parse(StringView chunk, bool is_last_chunk);
+
+    Parser::Options m_options;
+    NonnullOwnPtr<ParserContext> m_context;
+    _xmlParserCtxt* m_parser_context { nullptr };
+    bool m_is_finished { false };
+};
+
 }
 
 template<>
@@ -19,6 +19,7 @@ set(FLAC_ENCODER_DEBUG ON)
 set(FORMATTING_CONTEXT_TRACE_DEBUG ON)
 set(GIF_DEBUG ON)
 set(HEAP_DEBUG ON)
+set(INCREMENTAL_MARK_DEBUG ON)
 set(INCREMENTAL_SWEEP_DEBUG ON)
 set(HIGHLIGHT_FOCUSED_FRAME_DEBUG ON)
 set(HTML_SCRIPT_DEBUG ON)
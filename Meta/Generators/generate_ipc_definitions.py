@@ -38,6 +38,8 @@ PRIMITIVE_TYPES = {
     "float",
 }
 
+INTEGRAL_TYPES = PRIMITIVE_TYPES - {"bool", "double", "float"}
+
 SIMPLE_TYPES = {
     "ReadonlyBytes",
     "StringView",
@@ -75,6 +77,8 @@ class Parameter:
 class Message:
     name: str = ""
     is_synchronous: bool = False
+    is_low_priority: bool = False
+    coalescing: str = ""
     inputs: List[Parameter] = field(default_factory=list)
     outputs: List[Parameter] = field(default_factory=list)
 
@@ -192,7 +196,7 @@ def parse(contents: str) -> List[Endpoint]:
             parameter.type_for_encoding = "StringView"
         elif parameter.type == "Utf16String":
             parameter.type_for_encoding = "Utf16View"
-        elif parameter.type == "ByteBuffer":
+        elif parameter.type in ("ByteBuffer", "IPC::BorrowedBytes"):
             parameter.type_for_encoding = "ReadonlyBytes"
         else:
             parameter.type_for_encoding = parameter.type
@@ -220,10 +224,31 @@ def parse(contents: str) -> List[Endpoint]:
             if lexer.peek() == ")":
                 break
 
+    def parse_message_attributes(message: Message) -> None:
+        while True:
+            consume_whitespace()
+            if lexer.consume_specific("]"):
+                consume_whitespace()
+                break
+
+            if lexer.consume_specific(","):
+                consume_whitespace()
+
+            attribute = lexer.consume_until(lambda c: c in ("]", ",")).strip()
+            if attribute == "Priority=low":
+                message.is_low_priority = True
+            elif attribute in ("Coalesce=latest", "Coalesce=batch"):
+                message.coalescing = attribute.removeprefix("Coalesce=")
+            elif attribute != "Priority=normal":
+                raise RuntimeError(f"Unknown message attribute '{attribute}' at position {lexer.position}")
+
     def parse_message() -> None:
         message = Message()
 
         consume_whitespace()
+        if lexer.consume_specific("["):
+            parse_message_attributes(message)
+
         message.name = lexer.consume_until(lambda c: c.isspace() or c == "(")
 
         consume_whitespace()
@@ -245,10 +270,25 @@ def parse(contents: str) -> List[Endpoint]:
         consume_whitespace()
 
         if message.is_synchronous:
+            # The sender of a synchronous message blocks until its response arrives, so nothing can overtake it.
+            if message.is_low_priority:
+                raise RuntimeError(f"Synchronous message {message.name} cannot have a priority")
+            if message.coalescing:
+                raise RuntimeError(f"Synchronous message {message.name} cannot be coalesced")
+
             assert_specific("(")
             parse_parameters(message.outputs, message.name)
             assert_specific(")")
 
+        if message.coalescing:
+            # A coalesced message is already held back until the batch it belongs to is sent.
+            if message.is_low_priority:
+                raise RuntimeError(f"Coalesced message {message.name} cannot have a priority")
+
+            # The latest message of each type is kept per value of its first parameter, which is usually a page ID.
+            if message.coalescing == "latest" and message.inputs and message.inputs[0].type not in INTEGRAL_TYPES:
+                raise RuntimeError(f"Coalesced message {message.name} must have an integral first parameter")
+
         consume_whitespace()
         endpoints[-1].messages.append(message)
 
@@ -335,6 +375,8 @@ def write_message_class(
     name: str,
     parameters: List[Parameter],
     response_type: str = "",
+    is_low_priority: bool = False,
+    coalescing: str = "",
 ) -> None:
     pascal_name = pascal_case(name)
 
@@ -370,10 +412,16 @@ public:""")
     virtual i32 message_id() const override {{ return (int)MessageID::{pascal_name}; }}
     static i32 static_message_id() {{ return (int)MessageID::{pascal_name}; }}
     virtual StringView message_name() const override {{ return "{endpoint.name}::{pascal_name}"sv; }}
+""")
 
-    static ErrorOr<NonnullOwnPtr<{pascal_name}>> decode(Stream& stream, Queue<IPC::Attachment>& attachments)
+    if is_low_priority:
+        out.write("""    virtual IPC::MessagePriority priority() const override { return IPC::MessagePriority::Low; }
+""")
+
+    out.write(f"""
+    static ErrorOr<NonnullOwnPtr<{pascal_name}>> decode(FixedMemoryStream& stream, Queue<IPC::Attachment>& attachments, IPC::ReceivedMessageBytes const& message_bytes)
     {{
-        IPC::Decoder decoder {{ stream, attachments }};""")
+        IPC::Decoder decoder {{ stream, attachments, message_bytes }};""")
 
     for parameter in parameters:
         out.write(f"\n        auto {parameter.name} = TRY((decoder.decode<{parameter.type}>()));")
@@ -394,7 +442,21 @@ public:""")
     out.write(f"""
     static ErrorOr<IPC::MessageBuffer> static_encode({encode_params})
     {{
-        IPC::MessageBuffer buffer;
+        IPC::MessageBuffer buffer;""")
+
+    if is_low_priority:
+        out.write("""
+        buffer.set_priority(IPC::MessagePriority::Low);""")
+
+    if coalescing == "latest":
+        coalescing_key = f", {parameters[0].name}" if parameters else ""
+        out.write(f"""
+        buffer.set_coalescing(IPC::MessageCoalescing::Latest, (int)MessageID::{pascal_name}{coalescing_key});""")
+    elif coalescing == "batch":
+        out.write(f"""
+        buffer.set_coalescing(IPC::MessageCoalescing::Batch, (int)MessageID::{pascal_name});""")
+
+    out.write(f"""
         IPC::Encoder stream(buffer);
         TRY(stream.encode(ENDPOINT_MAGIC));
         TRY(stream.encode((int)MessageID::{pascal_name}));""")
@@ -577,9 +639,9 @@ public:
 
     static u32 static_magic() {{ return {endpoint.magic}; }}
 
-    static ErrorOr<NonnullOwnPtr<IPC::Message>> decode_message(ReadonlyBytes buffer, [[maybe_unused]] Queue<IPC::Attachment>& attachments)
+    static ErrorOr<NonnullOwnPtr<IPC::Message>> decode_message(IPC::ReceivedMessageBytes const& message_bytes, [[maybe_unused]] Queue<IPC::Attachment>& attachments)
     {{
-        FixedMemoryStream stream {{ buffer }};
+        FixedMemoryStream stream {{ message_bytes.bytes() }};
         auto message_endpoint_magic = TRY(stream.read_value<u32>());
 
         if (message_endpoint_magic != static_magic())
@@ -598,7 +660,7 @@ public:
             pascal_name = pascal_case(name)
             out.write(f"""
         case (int)Messages::{endpoint.name}::MessageID::{pascal_name}:
-            return Messages::{endpoint.name}::{pascal_name}::decode(stream, attachments);""")
+            return Messages::{endpoint.name}::{pascal_name}::decode(stream, attachments, message_bytes);""")
 
     out.write(f"""
         default:
@@ -697,7 +759,7 @@ def write_endpoint(out: TextIO, endpoint: Endpoint) -> None:
             response_name = message.response_name()
             write_message_class(out, endpoint, response_name, message.outputs)
 
-        write_message_class(out, endpoint, message.name, message.inputs, response_name)
+        write_message_class(out, endpoint, message.name, message.inputs, response_name, message.is_low_priority, message.coalescing)
 
     out.write(f"\n}} // namespace Messages::{endpoint.name}\n")
 
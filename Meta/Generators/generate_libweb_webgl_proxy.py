@@ -148,9 +148,15 @@ def emit_sync_method(out: TextIO, function: dict) -> None:
             f"    request.{field} = {{ WebGLCommandList::first_inline_data_offset(sizeof(request)), static_cast<u32>({field}_bytes.size()) }};\n"
         )
     blob_argument = f", {blobs[0]}_bytes" if blobs else ""
-    out.write(
-        f"    auto reply_bytes = send_sync_call(WebGLSyncCall::encode_request<{call}>(request{blob_argument}));\n"
-    )
+    encoded_request = f"WebGLSyncCall::encode_request<{call}>(request{blob_argument})"
+    if "cached_if" in function:
+        # Requests matching the condition always get the same answer, so only the first one makes the round trip.
+        out.write(f"    auto request_bytes = {encoded_request};\n")
+        out.write(
+            f"    auto reply_bytes = {function['cached_if']} ? send_cached_sync_call(move(request_bytes)) : send_sync_call(move(request_bytes));\n"
+        )
+    else:
+        out.write(f"    auto reply_bytes = send_sync_call({encoded_request});\n")
 
     has_return = function["return"] != "void"
     failure = "        return {};\n" if has_return else "        return;\n"
@@ -77,6 +77,21 @@ def attribute_setter_callback_name(attribute: Attribute) -> str:
     return f"{attribute_callback_cpp_name(attribute)}_setter"
 
 
+def attribute_fast_getter_callback_name(attribute: Attribute) -> str:
+    return f"{attribute_callback_cpp_name(attribute)}_fast_getter"
+
+
+def attribute_has_fast_getter(interface: Interface, attribute: Attribute) -> bool:
+    # NB: A fast getter is a version of the getter that LibJS can call directly with the this object once an inline
+    #     cache has found the getter. The getters of promise types, of unforgeable attributes (which are shared between
+    #     realms) and of global objects (which are reached through a WindowProxy) always take the regular call path.
+    return (
+        attribute.type.name != "Promise"
+        and "LegacyUnforgeable" not in attribute.extended_attributes
+        and "Global" not in interface.extended_attributes
+    )
+
+
 def define_the_regular_attributes(
     out: TextIO,
     includes: GeneratedIncludes,
@@ -138,6 +153,12 @@ def define_the_attributes(
             definition.write(
                 f'    auto {native_getter_name} = host_defined_intrinsics(realm).ensure_web_unforgeable_function("{interface.namespaced_name}"_utf16_fly_string, {cpp_name}_id, {getter_name}, UnforgeableKey::Type::Getter);\n'
             )
+        elif attribute_has_fast_getter(interface, attribute):
+            includes.add("LibJS/Runtime/NativeFunction.h")
+            definition.write(
+                f'    auto {native_getter_name} = JS::RawNativeFunction::create(realm, {getter_name}, 0, {cpp_name}_id, &realm, "get"sv);\n'
+                f"    {native_getter_name}->set_fast_getter({attribute_fast_getter_callback_name(attribute)});\n"
+            )
         else:
             definition.write(
                 f'    auto {native_getter_name} = JS::NativeFunction::create(realm, {getter_name}, 0, {cpp_name}_id, &realm, "get"sv);\n'
@@ -196,6 +217,45 @@ def write_attribute_getters(
         write_attribute_getter(out, context, includes, interface, attribute)
 
 
+def write_attribute_getter_with_fast_getter(
+    out: TextIO,
+    includes: GeneratedIncludes,
+    interface: Interface,
+    attribute: Attribute,
+    getter_body: str,
+) -> None:
+    includes.add("AK/TypeCasts.h")
+    getter_name = attribute_getter_callback_name(attribute)
+    steps_name = f"{attribute_callback_cpp_name(attribute)}_getter_steps"
+    impl_class = fully_qualified_name_for_interface(interface)
+    out.write(
+        f"""static JS::ThrowCompletionOr<JS::Value> {steps_name}(JS::VM& vm, {impl_class}* idl_object)
+{{
+    [[maybe_unused]] auto& realm = *vm.current_realm();
+
+{getter_body}
+}}
+
+JS_DEFINE_NATIVE_FUNCTION({interface.prototype_class}::{getter_name})
+{{
+    WebIDL::log_trace(vm, "{interface.prototype_class}::{getter_name}");
+
+    auto* idl_object = TRY(impl_from(vm));
+    return {steps_name}(vm, idl_object);
+}}
+
+JS::ThrowCompletionOr<JS::Value> {interface.prototype_class}::{attribute_fast_getter_callback_name(attribute)}(JS::VM& vm, JS::Object& this_object)
+{{
+    auto* idl_object = as_if<{impl_class}>(this_object);
+    if (!idl_object)
+        return JS::js_special_empty_value();
+    return {steps_name}(vm, idl_object);
+}}
+
+"""
+    )
+
+
 def write_attribute_getter(
     out: TextIO,
     context: GenerationContext,
@@ -426,6 +486,13 @@ def write_attribute_getter(
 """
         )
         return
+    getter_body = f"""{getter_prelude}
+    {getter_steps}
+{getter_cache_check}
+    return {cached_return_value or to_javascript_value(attribute.type, "R", includes, context)};"""
+    if receiver_class == interface.prototype_class and attribute_has_fast_getter(interface, attribute):
+        write_attribute_getter_with_fast_getter(out, includes, interface, attribute, getter_body)
+        return
     out.write(
         f"""JS_DEFINE_NATIVE_FUNCTION({receiver_class}::{attribute_getter_callback_name(attribute)})
 {{
@@ -434,10 +501,7 @@ def write_attribute_getter(
 
     auto* idl_object = TRY(impl_from(vm));
 
-{getter_prelude}
-    {getter_steps}
-{getter_cache_check}
-    return {cached_return_value or to_javascript_value(attribute.type, "R", includes, context)};
+{getter_body}
 }}
 
 """
@@ -250,4 +250,37 @@ Gfx::ShareableBitmap CanvasHost::read_back_pixels(Web::Painting::CanvasId canvas
         });
 }
 
+Core::AnonymousBuffer CanvasHost::read_back_unpremultiplied_pixels(Web::Painting::CanvasId canvas_id, Gfx::IntRect rect)
+{
+    auto* context = this->context(canvas_id);
+    if (!context || !context->has<Canvas2DContext>())
+        return {};
+
+    auto& surface = context->get<Canvas2DContext>().command_player->surface();
+    if (rect.is_empty() || !surface.rect().contains(rect))
+        return {};
+
+    auto pitch = static_cast<size_t>(rect.width()) * sizeof(u32);
+    auto buffer_or_error = Core::AnonymousBuffer::create_with_size(pitch * static_cast<size_t>(rect.height()));
+    if (buffer_or_error.is_error())
+        return {};
+    auto buffer = buffer_or_error.release_value();
+
+    {
+        auto bitmap_or_error = Gfx::Bitmap::create_wrapper(Gfx::BitmapFormat::RGBA8888, Gfx::AlphaType::Unpremultiplied, rect.size(), pitch, buffer.data<void>());
+        if (bitmap_or_error.is_error())
+            return {};
+
+        // NB: Skia converts to ImageData's pixel format while reading, so the content process only has to copy rows.
+        surface.flush();
+        surface.read_into_bitmap(bitmap_or_error.value(), rect.location());
+    }
+
+    // NB: The buffer is ours and is never written to again once it's handed out, so WebContent can't make us fault by
+    //     truncating it. Sealing it keeps it from changing under WebContent as well.
+    if (buffer.seal().is_error())
+        return {};
+    return buffer;
+}
+
 }
@@ -62,6 +62,9 @@ public:
 
     void present_webgl_canvas(Web::Painting::CanvasId, bool preserve_drawing_buffer);
     Gfx::ShareableBitmap read_back_pixels(Web::Painting::CanvasId, Gfx::IntRect);
+    // Returns a sealed buffer with the pixels of a 2D canvas inside rect as tightly packed, unpremultiplied RGBA, which is
+    // the layout of ImageData.
+    Core::AnonymousBuffer read_back_unpremultiplied_pixels(Web::Painting::CanvasId, Gfx::IntRect);
 
 private:
     struct Canvas2DContext {
@@ -52,6 +52,8 @@ CompositorState::ContextOwnerCheckResult CompositorState::check_context_owner(We
 
 void CompositorState::destroy_contexts_for_web_content_client(CompositorStateWebContentClient& client)
 {
+    m_clients_waiting_for_vsync_tick.remove(&client);
+
     Vector<Web::Compositor::CompositorContextId> context_ids;
     for (auto& context : m_contexts) {
         if (context.value->is_owned_by(client))
@@ -146,6 +148,27 @@ void CompositorState::update_display_list(Web::Compositor::CompositorContextId c
     context->install_display_list_update(move(display_list), move(visual_context_tree), move(scroll_state_snapshot));
 }
 
+void CompositorState::update_display_list_with_delta(Web::Compositor::CompositorContextId context_id, Web::Painting::DisplayListDelta const& display_list_delta, Web::Painting::AccumulatedVisualContextTree visual_context_tree, Web::Painting::DisplayListResourceTransaction&& resource_transaction, Web::Painting::ScrollStateSnapshot&& scroll_state_snapshot)
+{
+    auto* context = context_if_present(context_id);
+    VERIFY(context);
+
+    // NB: WebContent only sends a delta against the last display list it sent for the context, which is the one
+    //     installed here unless that update was dropped.
+    auto const* base_display_list = context->display_list();
+    if (!base_display_list) {
+        dbgln("Compositor: Dropping display list delta for a context without a display list");
+        return;
+    }
+    auto display_list = display_list_delta.apply_to(*base_display_list);
+    if (display_list.is_error()) {
+        dbgln("Compositor: Dropping display list delta: {}", display_list.error());
+        return;
+    }
+
+    update_display_list(context_id, display_list.release_value(), move(visual_context_tree), move(resource_transaction), move(scroll_state_snapshot));
+}
+
 void CompositorState::update_image_frame_resources(Web::Compositor::CompositorContextId context_id, Vector<Web::Painting::DisplayListImageFrameResource> image_frames)
 {
     auto* context = context_if_present(context_id);
@@ -161,6 +184,18 @@ void CompositorState::update_visual_context_tree(Web::Compositor::CompositorCont
     context->update_visual_context_tree(move(visual_context_tree));
 }
 
+void CompositorState::update_compositor_animations(Web::Compositor::CompositorContextId context_id, u64 visual_context_tree_version, Vector<Web::Compositor::CompositorAnimation> animations)
+{
+    auto* context = context_if_present(context_id);
+    VERIFY(context);
+
+    context->update_compositor_animations(visual_context_tree_version, move(animations));
+    if (!context->has_active_compositor_animations())
+        return;
+    if (auto frame_rect = context->current_frame_rect_to_present(); frame_rect.has_value())
+        schedule_present_frame(context_id, *context, *frame_rect);
+}
+
 void CompositorState::update_scroll_state(Web::Compositor::CompositorContextId context_id, Web::Painting::ScrollStateSnapshot&& scroll_state_snapshot)
 {
     auto* context = context_if_present(context_id);
@@ -302,31 +337,35 @@ void CompositorState::set_display_metadata(Web::Compositor::CompositorContextId
         schedule_pending_present_frame(context_id, *context);
 }
 
-void CompositorState::present_frame(Web::Compositor::CompositorContextId context_id, Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect)
+void CompositorState::present_frame(Web::Compositor::CompositorContextId context_id, Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect, Web::Compositor::FrameTiming frame_timing)
 {
     auto* context = context_if_present(context_id);
     VERIFY(context);
+    frame_timing.record(Web::Compositor::FrameTimingStage::ResourceTransaction, context->take_resource_transaction_timing());
     if (context->should_defer_main_thread_present_for_async_scroll()) {
         dbgln_if(COMPOSITOR_DEBUG, "[Compositor] Main thread deferred present while async scroll is pending");
         // NB: The in-flight compositor frame may have been rasterized before the
         //     main thread installed its new display list. Preserve the present as
         //     a full repaint so that it uses both the new list and the latest
         //     compositor scroll state once presentation is unblocked.
-        schedule_present_frame(context_id, *context, viewport_rect);
-        return;
+        damage_rect = { {}, viewport_rect.size() };
+    } else {
+        damage_rect.intersect({ {}, viewport_rect.size() });
     }
-    damage_rect.intersect({ {}, viewport_rect.size() });
-    schedule_present_frame(context_id, *context, ContextState::PendingFrame { viewport_rect, damage_rect });
+    schedule_present_frame(context_id, *context, ContextState::PendingFrame { viewport_rect, damage_rect, move(frame_timing) });
 }
 
 void CompositorState::present_frame(Web::Compositor::CompositorContextId context_id, ContextState& context, ContextState::PendingFrame pending_frame)
 {
     auto composited_context_resolver = resolver_for(context_id);
+    auto raster_start = MonotonicTime::now();
     auto prepared_frame = context.prepare_frame(*m_display_list_player, pending_frame, &composited_context_resolver);
     if (!prepared_frame.has_value())
         return;
+    if (pending_frame.frame_timing.has_value())
+        pending_frame.frame_timing->record(Web::Compositor::FrameTimingStage::Raster, raster_start, MonotonicTime::now());
 
-    m_pending_async_presents.append(context_id, pending_frame.viewport_rect, pending_frame.damage_rect, prepared_frame->bitmap_id);
+    m_pending_async_presents.append(context_id, pending_frame.viewport_rect, pending_frame.damage_rect, prepared_frame->bitmap_id, move(pending_frame.frame_timing));
     auto* pending_present = &m_pending_async_presents.last();
 
     auto& event_loop = Core::EventLoop::current();
@@ -398,30 +437,50 @@ VSyncScheduler& CompositorState::vsync_scheduler_for_display(Optional<u64> displ
     });
 }
 
+void CompositorState::request_vsync_tick(CompositorStateWebContentClient& client, double refresh_rate)
+{
+    m_clients_waiting_for_vsync_tick.set(&client);
+    vsync_scheduler_for_display({}).schedule(refresh_rate);
+}
+
 void CompositorState::present_pending_frames_on_vsync(Optional<u64> display_id)
 {
     auto now = MonotonicTime::now();
+
+    if (!display_id.has_value()) {
+        auto clients = exchange(m_clients_waiting_for_vsync_tick, {});
+        for (auto* client : clients)
+            client->did_vsync_tick();
+    }
+
     for (auto& context_entry : m_contexts) {
         auto context_id = context_entry.key;
         auto& context = *context_entry.value;
-        auto has_active_smooth_scroll_animation_on_display = context.has_active_smooth_scroll_animations() && context.display_id() == display_id;
-        if (!context.has_pending_present_frame_scheduled_on(display_id) && !has_active_smooth_scroll_animation_on_display)
+        auto has_active_animation_on_display = context.has_active_animations() && context.display_id() == display_id;
+        if (!context.has_pending_present_frame_scheduled_on(display_id) && !has_active_animation_on_display)
             continue;
 
-        if (auto animation_frame = context.advance_smooth_scroll_animations(now); animation_frame.has_value())
+        auto queue_animation_frame = [&](Gfx::IntRect animation_frame) {
             context.queue_present_frame({
-                .viewport_rect = *animation_frame,
-                .damage_rect = { {}, animation_frame->size() },
+                .viewport_rect = animation_frame,
+                .damage_rect = { {}, animation_frame.size() },
             });
+        };
+        if (auto animation_frame = context.advance_smooth_scroll_animations(now); animation_frame.has_value())
+            queue_animation_frame(*animation_frame);
+        if (auto animation_frame = context.advance_compositor_animations(now); animation_frame.has_value())
+            queue_animation_frame(*animation_frame);
 
         auto pending_present_frame = context.take_pending_present_frame_if_unblocked();
         if (!pending_present_frame.has_value()) {
-            has_active_smooth_scroll_animation_on_display = context.has_active_smooth_scroll_animations() && context.display_id() == display_id;
-            if (context.has_pending_present_frame_scheduled_on(display_id) || has_active_smooth_scroll_animation_on_display)
+            has_active_animation_on_display = context.has_active_animations() && context.display_id() == display_id;
+            if (context.has_pending_present_frame_scheduled_on(display_id) || has_active_animation_on_display)
                 vsync_scheduler_for_display(display_id).schedule(context.display_refresh_rate());
             continue;
         }
-        if (context.has_active_smooth_scroll_animations())
+        if (pending_present_frame->frame_timing.has_value())
+            pending_present_frame->frame_timing->record(Web::Compositor::FrameTimingStage::VSyncTick, now);
+        if (context.has_active_animations())
             schedule_present_frame(context_id, context, pending_present_frame->viewport_rect);
         present_frame(context_id, context, *pending_present_frame);
     }
@@ -465,6 +524,9 @@ void CompositorState::did_finish_async_present(PendingAsyncPresent& pending_pres
     auto viewport_rect = pending_present.viewport_rect;
     auto damage_rect = pending_present.damage_rect;
     auto bitmap_id = pending_present.bitmap_id;
+    auto frame_timing = move(pending_present.frame_timing);
+    if (frame_timing.has_value())
+        frame_timing->record(Web::Compositor::FrameTimingStage::Present, pending_present.submitted_at, MonotonicTime::now());
     auto was_cancelled = pending_present.was_cancelled;
     (void)m_pending_async_presents.remove(pending_present_iterator);
     if (m_pending_async_presents.is_empty() && m_gpu_completion_timer)
@@ -477,6 +539,8 @@ void CompositorState::did_finish_async_present(PendingAsyncPresent& pending_pres
     VERIFY(context);
 
     context->did_finish_gpu_present(bitmap_id);
+    if (frame_timing.has_value())
+        context->did_finish_frame(frame_timing.release_value());
     if (context->presents_to_client()) {
         VERIFY(m_client);
         m_client->did_present_frame(context_id, viewport_rect, damage_rect, bitmap_id);
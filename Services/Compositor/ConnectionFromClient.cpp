@@ -9,6 +9,7 @@
 #include <Compositor/ConnectionFromWebContent.h>
 #include <LibCore/Process.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibIPC/Transport.h>
 
 namespace Compositor {
@@ -109,6 +110,16 @@ void ConnectionFromClient::set_client_gpu_presentation_capability(bool supported
     m_compositor_state->set_client_gpu_presentation_capability(supported, adapter_luid);
 }
 
+void ConnectionFromClient::set_trace_categories(Core::TraceCategory categories)
+{
+    Core::TraceEvents::set_enabled_categories(categories);
+}
+
+Messages::CompositorControlServer::GetTraceEventJsonResponse ConnectionFromClient::get_trace_event_json()
+{
+    return Core::TraceEvents::to_trace_event_json("Compositor"sv);
+}
+
 void ConnectionFromClient::crash()
 {
     warnln("Crashing Compositor process by request from Browser");
@@ -45,6 +45,16 @@ void ConnectionFromWebContent::request_rendering_update()
     async_request_rendering_update();
 }
 
+void ConnectionFromWebContent::did_finish_frame(Web::Compositor::FrameTiming const& frame_timing)
+{
+    async_did_finish_frame(frame_timing);
+}
+
+void ConnectionFromWebContent::did_vsync_tick()
+{
+    async_did_vsync_tick();
+}
+
 void ConnectionFromWebContent::dispatch_mouse_event_to_web_content(u64 page_id, Web::MouseEvent const& event)
 {
     async_mouse_event(page_id, event);
@@ -93,6 +103,13 @@ void ConnectionFromWebContent::update_display_list(Web::Compositor::CompositorCo
     m_compositor_state->update_display_list(context_id, move(display_list), move(visual_context_tree), move(resource_transaction), move(scroll_state_snapshot));
 }
 
+void ConnectionFromWebContent::update_display_list_with_delta(Web::Compositor::CompositorContextId context_id, Web::Painting::DisplayListDelta display_list_delta, Web::Painting::AccumulatedVisualContextTree visual_context_tree, Web::Painting::DisplayListResourceTransaction resource_transaction, Web::Painting::ScrollStateSnapshot scroll_state_snapshot)
+{
+    if (!context_is_owned_by_this_connection(context_id))
+        return;
+    m_compositor_state->update_display_list_with_delta(context_id, display_list_delta, move(visual_context_tree), move(resource_transaction), move(scroll_state_snapshot));
+}
+
 void ConnectionFromWebContent::update_image_frame_resources(Web::Compositor::CompositorContextId context_id, Vector<Web::Painting::DisplayListImageFrameResource> image_frames)
 {
     if (!context_is_owned_by_this_connection(context_id))
@@ -107,6 +124,13 @@ void ConnectionFromWebContent::update_visual_context_tree(Web::Compositor::Compo
     m_compositor_state->update_visual_context_tree(context_id, move(visual_context_tree));
 }
 
+void ConnectionFromWebContent::update_compositor_animations(Web::Compositor::CompositorContextId context_id, u64 visual_context_tree_version, Vector<Web::Compositor::CompositorAnimation> animations)
+{
+    if (!context_is_owned_by_this_connection(context_id))
+        return;
+    m_compositor_state->update_compositor_animations(context_id, visual_context_tree_version, move(animations));
+}
+
 void ConnectionFromWebContent::update_scroll_state(Web::Compositor::CompositorContextId context_id, Web::Painting::ScrollStateSnapshot scroll_state_snapshot)
 {
     if (!context_is_owned_by_this_connection(context_id))
@@ -151,6 +175,11 @@ Messages::CompositorWebContentServer::GetCanvasPixelsResponse ConnectionFromWebC
     return m_canvas_host.read_back_pixels(canvas_id, rect);
 }
 
+Messages::CompositorWebContentServer::GetUnpremultipliedCanvasPixelsResponse ConnectionFromWebContent::get_unpremultiplied_canvas_pixels(Web::Painting::CanvasId canvas_id, Gfx::IntRect rect)
+{
+    return m_canvas_host.read_back_unpremultiplied_pixels(canvas_id, rect);
+}
+
 Messages::CompositorWebContentServer::CreateWebglContextResponse ConnectionFromWebContent::create_webgl_context(Web::WebGL::WebGLVersion webgl_version, Gfx::IntSize size, bool depth, bool stencil, bool antialias)
 {
     auto result = m_canvas_host.create_webgl_context(webgl_version, size, depth, stencil, antialias);
@@ -269,11 +298,12 @@ void ConnectionFromWebContent::viewport_size_updated(Web::Compositor::Compositor
     m_compositor_state->viewport_size_updated(context_id, viewport_size, window_resize_in_progress);
 }
 
-void ConnectionFromWebContent::present_frame(Web::Compositor::CompositorContextId context_id, Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect)
+void ConnectionFromWebContent::present_frame(Web::Compositor::CompositorContextId context_id, Gfx::IntRect viewport_rect, Gfx::IntRect damage_rect, Web::Compositor::FrameTiming frame_timing)
 {
     if (!context_is_owned_by_this_connection(context_id))
         return;
-    m_compositor_state->present_frame(context_id, viewport_rect, damage_rect);
+    frame_timing.record(Web::Compositor::FrameTimingStage::CompositorReceive, MonotonicTime::now());
+    m_compositor_state->present_frame(context_id, viewport_rect, damage_rect, move(frame_timing));
 }
 
 void ConnectionFromWebContent::request_screenshot(Web::Compositor::CompositorContextId context_id, Web::Compositor::ScreenshotRequestId request_id, Gfx::ShareableBitmap target_bitmap)
@@ -286,4 +316,13 @@ void ConnectionFromWebContent::request_screenshot(Web::Compositor::CompositorCon
         async_did_fail_screenshot(request_id);
 }
 
+void ConnectionFromWebContent::request_vsync_tick(double refresh_rate)
+{
+    if (!(refresh_rate > 0 && refresh_rate < AK::Infinity<double>)) {
+        did_misbehave("WebContent requested a vsync tick with an invalid refresh rate");
+        return;
+    }
+    m_compositor_state->request_vsync_tick(*this, refresh_rate);
+}
+
 }
@@ -9,13 +9,18 @@
 #include <Compositor/CompositorState.h>
 #include <Compositor/ContextState.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/PaintingSurface.h>
 #include <LibGfx/SkiaUtils.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWeb/Page/InputEvent.h>
 #include <LibWeb/Painting/DisplayListPlayerSkia.h>
 #include <core/SkCanvas.h>
 #include <core/SkImage.h>
+#include <core/SkPicture.h>
+#include <core/SkPixmap.h>
+#include <core/SkSurface.h>
 
 namespace Compositor {
 
@@ -132,7 +137,11 @@ void ContextState::set_parent_context(Optional<Web::Compositor::CompositorContex
 
 void ContextState::apply_display_list_resource_transaction(Web::Painting::DisplayListResourceTransaction&& resource_transaction)
 {
+    auto start = MonotonicTime::now();
     m_display_list_resource_storage.apply_transaction(move(resource_transaction));
+    if (!m_resource_transaction_timing.has_value())
+        m_resource_transaction_timing.start_ns = start.nanoseconds();
+    m_resource_transaction_timing.duration_ns += (MonotonicTime::now() - start).to_nanoseconds();
 }
 
 void ContextState::update_image_frame_resources(Vector<Web::Painting::DisplayListImageFrameResource> image_frames)
@@ -202,6 +211,22 @@ void ContextState::update_visual_context_tree(Web::Painting::AccumulatedVisualCo
         rebuild_wheel_hit_test_targets();
 }
 
+void ContextState::update_compositor_animations(u64 visual_context_tree_version, Vector<Web::Compositor::CompositorAnimation> animations)
+{
+    auto now = MonotonicTime::now();
+    m_compositor_animations.clear_with_capacity();
+    m_compositor_animations.ensure_capacity(animations.size());
+    for (auto& animation : animations) {
+        // NB: An animation on a scroll timeline only changes when its scroll node scrolls, which presents a frame by
+        //     itself, so it never needs to be advanced on vsync.
+        auto is_scroll_driven = animation.scroll_timeline.has_value();
+        m_compositor_animations.unchecked_append({ move(animation), now, is_scroll_driven });
+    }
+    m_compositor_animations_visual_context_tree_version = visual_context_tree_version;
+    m_compositor_animation_time = now;
+    m_visual_context_tree_for_compositing.clear();
+}
+
 void ContextState::update_scroll_state(Web::Painting::ScrollStateSnapshot&& scroll_state_snapshot)
 {
     m_scroll_state_snapshot = move(scroll_state_snapshot);
@@ -514,6 +539,34 @@ Optional<Gfx::IntRect> ContextState::advance_smooth_scroll_animations(MonotonicT
     return {};
 }
 
+bool ContextState::has_active_compositor_animations() const
+{
+    for (auto const& active_animation : m_compositor_animations) {
+        if (!active_animation.finished)
+            return true;
+    }
+    return false;
+}
+
+Optional<Gfx::IntRect> ContextState::advance_compositor_animations(MonotonicTime now)
+{
+    bool advanced_animation = false;
+    for (auto& active_animation : m_compositor_animations) {
+        if (active_animation.finished)
+            continue;
+        auto local_time = active_animation.animation.local_time_after(now - active_animation.received_at);
+        active_animation.finished = active_animation.animation.is_finished_at(local_time);
+        advanced_animation = true;
+    }
+    if (!advanced_animation)
+        return {};
+
+    // Finished animations keep applying their final value until the main thread sends a tree that reflects it.
+    m_compositor_animation_time = now;
+    m_visual_context_tree_for_compositing.clear();
+    return current_frame_rect_to_present();
+}
+
 ContextState::ContextUpdateResult ContextState::async_scroll_by(Gfx::FloatPoint position, Gfx::FloatPoint delta)
 {
     if (!presents_to_client())
@@ -643,19 +696,26 @@ bool ContextState::set_display_metadata(Optional<u64> display_id, double refresh
 void ContextState::queue_present_frame(PendingFrame pending_frame)
 {
     if (!m_pending_present_frame.has_value()) {
-        m_pending_present_frame = pending_frame;
+        m_pending_present_frame = move(pending_frame);
         return;
     }
 
+    // A frame from WebContent that is replaced by a newer one before it was presented never reaches the screen.
+    auto frame_timing = move(pending_frame.frame_timing);
+    if (!frame_timing.has_value())
+        frame_timing = move(m_pending_present_frame->frame_timing);
+    else if (m_pending_present_frame->frame_timing.has_value())
+        did_drop_frame(m_pending_present_frame->frame_timing.release_value());
+
     if (m_pending_present_frame->viewport_rect != pending_frame.viewport_rect) {
         m_pending_present_frame = PendingFrame {
             .viewport_rect = pending_frame.viewport_rect,
             .damage_rect = { {}, pending_frame.viewport_rect.size() },
         };
-        return;
+    } else {
+        m_pending_present_frame->damage_rect.unite(pending_frame.damage_rect);
     }
-
-    m_pending_present_frame->damage_rect.unite(pending_frame.damage_rect);
+    m_pending_present_frame->frame_timing = move(frame_timing);
 }
 
 void ContextState::mark_pending_present_frame_scheduled()
@@ -711,8 +771,11 @@ Optional<ContextState::PreparedFrame> ContextState::prepare_frame(Web::Painting:
         return {};
     }
 
+    m_display_list_resource_storage.invalidate_cached_backdrop_filter_results(pending_frame.damage_rect);
     if (!can_render_frame()) {
         m_presented_frame = pending_frame.viewport_rect;
+        if (pending_frame.frame_timing.has_value())
+            did_drop_frame(pending_frame.frame_timing.release_value());
         return {};
     }
 
@@ -758,7 +821,9 @@ bool ContextState::present_synchronously(Web::Painting::DisplayListPlayerSkia& d
     auto render_target = m_backing_store_manager.acquire_render_target(pending_frame->damage_rect);
     if (!render_target.has_value())
         return false;
+    m_display_list_resource_storage.invalidate_cached_backdrop_filter_results(pending_frame->damage_rect);
     auto& back_store = render_target->surface;
+    auto raster_start = MonotonicTime::now();
     paint_current_display_list(display_list_player, back_store, composited_context_resolver, render_target->damage_rect);
     display_list_player.flush(back_store);
     m_backing_store_manager.complete_rendering(render_target->bitmap_id, false);
@@ -766,6 +831,10 @@ bool ContextState::present_synchronously(Web::Painting::DisplayListPlayerSkia& d
     m_presented_frame = pending_frame->viewport_rect;
     m_pending_present_frame.clear();
     m_pending_present_frame_scheduled = false;
+    if (auto& frame_timing = pending_frame->frame_timing; frame_timing.has_value()) {
+        frame_timing->record(Web::Compositor::FrameTimingStage::Raster, raster_start, MonotonicTime::now());
+        did_finish_frame(frame_timing.release_value());
+    }
     return true;
 }
 
@@ -796,6 +865,20 @@ void ContextState::did_finish_gpu_present(i32 bitmap_id)
     m_latest_rendered_surface = m_backing_store_manager.latest_rendered_surface();
 }
 
+void ContextState::did_finish_frame(Web::Compositor::FrameTiming frame_timing)
+{
+    auto refresh_interval = AK::Duration::from_nanoseconds(static_cast<i64>(1'000'000'000.0 / m_display_refresh_rate));
+    if (frame_timing.missed_deadline(refresh_interval))
+        frame_timing.was_dropped = true;
+    m_web_content_client.did_finish_frame(frame_timing);
+}
+
+void ContextState::did_drop_frame(Web::Compositor::FrameTiming frame_timing)
+{
+    frame_timing.was_dropped = true;
+    m_web_content_client.did_finish_frame(frame_timing);
+}
+
 void ContextState::stop_backing_store_shrink_timer()
 {
     if (!m_backing_store_shrink_timer)
@@ -963,19 +1046,104 @@ bool ContextState::can_render_frame() const
 
 Web::Painting::AccumulatedVisualContextTree const& ContextState::visual_context_tree_for_compositing() const
 {
-    if (!m_async_visual_viewport_transform.has_value())
+    // Animation node indices are only meaningful for the tree they were sent with.
+    auto applies_compositor_animations = !m_compositor_animations.is_empty()
+        && m_compositor_animation_time.has_value()
+        && current_visual_context_tree().version() == m_compositor_animations_visual_context_tree_version;
+    if (!m_async_visual_viewport_transform.has_value() && !applies_compositor_animations)
         return current_visual_context_tree();
 
     m_visual_context_tree_for_compositing = current_visual_context_tree();
-    m_visual_context_tree_for_compositing->set_visual_viewport_transform(*m_async_visual_viewport_transform);
+    if (m_async_visual_viewport_transform.has_value())
+        m_visual_context_tree_for_compositing->set_visual_viewport_transform(*m_async_visual_viewport_transform);
+
+    if (applies_compositor_animations) {
+        auto& tree = *m_visual_context_tree_for_compositing;
+        for (auto const& active_animation : m_compositor_animations) {
+            auto const& animation = active_animation.animation;
+            if (animation.node_index.value() >= tree.nodes().size())
+                continue;
+            double local_time;
+            if (animation.scroll_timeline.has_value()) {
+                // Scroll nodes store the offset that they apply to their contents, which is the negated scroll offset.
+                auto device_offset = m_scroll_state_snapshot.device_offset_for_index(animation.scroll_timeline->scroll_node_index);
+                local_time = animation.local_time_at_scroll_offset({ -device_offset.x(), -device_offset.y() });
+            } else {
+                local_time = animation.local_time_after(*m_compositor_animation_time - active_animation.received_at);
+            }
+            auto& node = tree.node_at(animation.node_index);
+            // Animated nodes change on every frame, so the content below them is composited from a cached raster.
+            node.is_layer_root = true;
+            node.data.visit(
+                [&](Web::Painting::EffectsData& effects) {
+                    if (animation.property == Web::Compositor::CompositorAnimation::Property::Opacity)
+                        animation.apply_to(effects, local_time);
+                },
+                [&](Web::Painting::TransformData& transform) {
+                    if (animation.property == Web::Compositor::CompositorAnimation::Property::Transform)
+                        animation.apply_to(transform, local_time);
+                },
+                [](auto&) {});
+        }
+    }
     return *m_visual_context_tree_for_compositing;
 }
 
+static constexpr int raster_tile_size = 256;
+static constexpr i64 min_damage_area_for_tiled_raster = 512 * 512;
+
+static bool should_rasterize_in_tiles(Gfx::PaintingSurface const& surface, Gfx::IntRect damage_rect)
+{
+    if (surface.skia_backend_context())
+        return false;
+    if (Threading::ThreadPool::the().worker_count() < 2)
+        return false;
+    return static_cast<i64>(damage_rect.width()) * damage_rect.height() >= min_damage_area_for_tiled_raster;
+}
+
+// Plays the recording back into fixed-size tiles covering the damage, in parallel. Tiles outside the damage keep the
+// pixels of earlier frames, and the recording's bounding box hierarchy culls the operations outside of each tile.
+static void rasterize_recording_in_tiles(SkPicture const& recording, Gfx::PaintingSurface& surface, Gfx::IntRect damage_rect, SkColor clear_color)
+{
+    auto& sk_surface = surface.sk_surface();
+    sk_surface.notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+    SkPixmap pixmap;
+    auto has_pixels = sk_surface.peekPixels(&pixmap);
+    VERIFY(has_pixels);
+
+    Vector<Gfx::IntRect> tiles;
+    for (auto y = damage_rect.top(); y < damage_rect.bottom(); y += raster_tile_size) {
+        for (auto x = damage_rect.left(); x < damage_rect.right(); x += raster_tile_size)
+            tiles.append(Gfx::IntRect { x, y, raster_tile_size, raster_tile_size }.intersected(damage_rect));
+    }
+
+    Threading::ThreadPool::the().parallel_for(
+        tiles.size(),
+        [&](size_t tile_index) {
+            TRACE_EVENT(Raster, "Compositor::rasterize tile"sv);
+
+            // NB: Each tile's canvas only covers the tile's own pixels, so the tiles never write to the same memory.
+            auto const& tile = tiles[tile_index];
+            auto canvas = SkCanvas::MakeRasterDirect(pixmap.info().makeWH(tile.width(), tile.height()), pixmap.writable_addr(tile.x(), tile.y()), pixmap.rowBytes());
+            canvas->clear(clear_color);
+            canvas->translate(-tile.x(), -tile.y());
+            canvas->drawPicture(&recording);
+        },
+        Threading::TaskPriority::UserBlocking);
+}
+
 void ContextState::paint_current_display_list(Web::Painting::DisplayListPlayerSkia& display_list_player, Gfx::PaintingSurface& surface, CompositedContextResolver const* composited_context_resolver, Optional<Gfx::IntRect> damage_rect)
 {
+    TRACE_EVENT(Raster, "Compositor::ContextState::paint_current_display_list"sv);
+
     VERIFY(m_display_list);
     auto surface_clear_color = Gfx::to_skia_color(m_display_list->surface_clear_color().value_or(Gfx::Color::Transparent));
-    auto paint_display_list = [&](Gfx::PaintingSurface& target_surface) {
+    // NB: Only frames report their damage to the backdrop filter results cached in the resource storage, so other
+    //     paints (e.g. screenshots) and recordings, which can't be read back from, don't use them.
+    auto paint_display_list = [&](Gfx::PaintingSurface& target_surface, bool use_cached_backdrop_filter_results = true) {
+        Optional<Gfx::IntSize> backdrop_filter_cache_viewport_size;
+        if (damage_rect.has_value() && use_cached_backdrop_filter_results)
+            backdrop_filter_cache_viewport_size = surface.size();
         display_list_player.execute(
             *m_display_list,
             visual_context_tree_for_compositing(),
@@ -983,7 +1151,8 @@ void ContextState::paint_current_display_list(Web::Painting::DisplayListPlayerSk
             m_scroll_state_snapshot,
             target_surface,
             &m_canvas_surface_registry,
-            composited_context_resolver);
+            composited_context_resolver,
+            backdrop_filter_cache_viewport_size);
         m_viewport_scrollbar_controller.paint(target_surface, display_list_player, m_scroll_state_snapshot);
     };
 
@@ -1013,6 +1182,19 @@ void ContextState::paint_current_display_list(Web::Painting::DisplayListPlayerSk
         return;
     }
 
+    // OPTIMIZATION: Rasterizing a large damaged area on the CPU, e.g. a whole 4K viewport full of blurs and shadows,
+    //               easily takes longer than a frame on a single thread. Record the display list once instead, which
+    //               is cheap, and rasterize the recording in tiles on the thread pool.
+    if (damage_rect.has_value() && should_rasterize_in_tiles(surface, damage_rect->intersected(surface.rect()))) {
+        auto tiled_damage_rect = damage_rect->intersected(surface.rect());
+        auto recording_surface = Gfx::PaintingSurface::create_for_recording(surface.size());
+        recording_surface->canvas().clipIRect(SkIRect::MakeXYWH(tiled_damage_rect.x(), tiled_damage_rect.y(), tiled_damage_rect.width(), tiled_damage_rect.height()));
+        paint_display_list(*recording_surface, false);
+        auto recording = recording_surface->take_recording<sk_sp<SkPicture>>();
+        rasterize_recording_in_tiles(*recording, surface, tiled_damage_rect, surface_clear_color);
+        return;
+    }
+
     auto& canvas = surface.canvas();
     auto save_count = canvas.save();
     if (damage_rect.has_value()) {
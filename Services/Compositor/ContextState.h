@@ -22,6 +22,8 @@
 #include <LibGfx/Size.h>
 #include <LibWeb/Compositor/AsyncScrollTree.h>
 #include <LibWeb/Compositor/AsyncScrollingState.h>
+#include <LibWeb/Compositor/CompositorAnimation.h>
+#include <LibWeb/Compositor/FrameTiming.h>
 #include <LibWeb/Compositor/SmoothScrollAnimation.h>
 #include <LibWeb/Compositor/Types.h>
 #include <LibWeb/Forward.h>
@@ -78,6 +80,8 @@ public:
     struct PendingFrame {
         Gfx::IntRect viewport_rect;
         Gfx::IntRect damage_rect;
+        // Only frames presented by WebContent are timed, not the ones the compositor makes by itself.
+        Optional<Web::Compositor::FrameTiming> frame_timing {};
     };
 
     ContextState(Optional<u64> page_id, CompositorStateWebContentClient&, Web::Painting::CanvasSurfaceRegistry const&, bool async_scrolling_enabled);
@@ -94,6 +98,7 @@ public:
     void set_parent_context(Optional<Web::Compositor::CompositorContextId>);
     Optional<Web::Compositor::CompositorContextId> parent_context_id() const { return m_parent_context_id; }
     RefPtr<Gfx::PaintingSurface> latest_rendered_surface() const { return m_latest_rendered_surface; }
+    Web::Painting::DisplayList const* display_list() const { return m_display_list.ptr(); }
 
     void apply_display_list_resource_transaction(Web::Painting::DisplayListResourceTransaction&&);
     void update_image_frame_resources(Vector<Web::Painting::DisplayListImageFrameResource>);
@@ -102,6 +107,7 @@ public:
         Web::Painting::AccumulatedVisualContextTree,
         Web::Painting::ScrollStateSnapshot&&);
     void update_visual_context_tree(Web::Painting::AccumulatedVisualContextTree);
+    void update_compositor_animations(u64 visual_context_tree_version, Vector<Web::Compositor::CompositorAnimation>);
     void update_scroll_state(Web::Painting::ScrollStateSnapshot&&);
     void update_video_frame(Web::Painting::VideoFrameResourceId, NonnullRefPtr<Media::VideoFrame const>);
     void clear_video_frame(Web::Painting::VideoFrameResourceId);
@@ -119,6 +125,9 @@ public:
     void cancel_smooth_scroll(Web::Compositor::AsyncScrollNodeStableID);
     Optional<Gfx::IntRect> advance_smooth_scroll_animations(MonotonicTime now);
     bool has_active_smooth_scroll_animations() const { return !m_smooth_scroll_animations.is_empty(); }
+    Optional<Gfx::IntRect> advance_compositor_animations(MonotonicTime now);
+    bool has_active_compositor_animations() const;
+    bool has_active_animations() const { return has_active_smooth_scroll_animations() || has_active_compositor_animations(); }
     ContextUpdateResult async_scroll_by(Gfx::FloatPoint position, Gfx::FloatPoint delta);
     bool should_defer_main_thread_present_for_async_scroll() const;
     Web::Compositor::PendingAsyncScrollUpdates take_pending_async_scroll_updates();
@@ -149,6 +158,11 @@ public:
     bool acknowledge_presented_bitmap(i32 bitmap_id);
     void did_finish_gpu_present(i32 bitmap_id);
 
+    // Timing of the resource transactions applied since the last frame presented by WebContent.
+    Web::Compositor::FrameTiming::Stage take_resource_transaction_timing() { return exchange(m_resource_transaction_timing, {}); }
+    void did_finish_frame(Web::Compositor::FrameTiming);
+    void did_drop_frame(Web::Compositor::FrameTiming);
+
 private:
     struct ActiveSmoothScrollAnimation {
         Web::Compositor::AsyncScrollNodeStableID stable_node_id;
@@ -157,6 +171,12 @@ private:
         MonotonicTime started_at;
     };
 
+    struct ActiveCompositorAnimation {
+        Web::Compositor::CompositorAnimation animation;
+        MonotonicTime received_at;
+        bool finished { false };
+    };
+
     struct VisualViewportScrollDelta {
         Web::Compositor::AsyncScrollOffset scroll_offset;
         Gfx::FloatPoint consumed_delta;
@@ -200,6 +220,9 @@ private:
     Vector<Web::Compositor::AsyncScrollOffset> m_pending_async_scroll_offsets;
     Vector<Web::Compositor::AsyncScrollOperationID> m_completed_async_scroll_operation_ids;
     Vector<ActiveSmoothScrollAnimation> m_smooth_scroll_animations;
+    Vector<ActiveCompositorAnimation> m_compositor_animations;
+    u64 m_compositor_animations_visual_context_tree_version { 0 };
+    Optional<MonotonicTime> m_compositor_animation_time;
     Web::Compositor::AsyncScrollOperationID m_next_async_scroll_operation_id { 0 };
     Gfx::IntRect m_async_scrolling_viewport_rect;
     bool m_has_async_scrolling_state { false };
@@ -217,6 +240,7 @@ private:
 
     Optional<PendingFrame> m_pending_present_frame;
     bool m_pending_present_frame_scheduled { false };
+    Web::Compositor::FrameTiming::Stage m_resource_transaction_timing;
     Optional<Gfx::IntRect> m_presented_frame;
     Optional<i32> m_gpu_present_bitmap_id_awaiting_completion;
 };
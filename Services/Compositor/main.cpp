@@ -9,6 +9,7 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Process.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/PathFontProvider.h>
@@ -23,6 +24,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
 
     StringView mach_server_name;
     StringView cache_path;
+    StringView trace_categories;
     bool wait_for_debugger = false;
     bool enable_test_mode = false;
     bool force_cpu_painting = false;
@@ -33,6 +35,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     Core::ArgsParser args_parser;
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(cache_path, "Path to the profile cache", "cache-path", 0, "path");
+    args_parser.add_option(trace_categories, "Record trace events in the given categories", "trace-categories", 0, "categories");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
     args_parser.add_option(enable_test_mode, "Enable test mode", "test-mode");
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
@@ -41,6 +44,8 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.add_option(disable_sandbox, "Disable process sandboxing", "disable-sandbox");
     args_parser.parse(arguments);
 
+    Core::TraceEvents::initialize_for_main_thread(trace_categories);
+
     if (wait_for_debugger)
         Core::Process::wait_for_debugger_and_break();
 
@@ -8,10 +8,12 @@
 #include <AK/IDAllocator.h>
 #include <AK/NonnullRefPtr.h>
 #include <ImageDecoder/ConnectionFromClient.h>
+#include <ImageDecoder/DecodedImageCache.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Process.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
@@ -41,6 +43,12 @@ void ConnectionFromClient::die()
     m_pending_frame_jobs.clear();
     m_animation_sessions.clear();
 
+    for (auto& [_, incremental_decode] : m_incremental_decodes) {
+        if (incremental_decode->job)
+            incremental_decode->job->cancel();
+    }
+    m_incremental_decodes.clear();
+
     auto client_id = this->client_id();
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
@@ -103,11 +111,46 @@ static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder
     }
 }
 
-static constexpr u32 STREAMING_BATCH_SIZE = 4;
+// Copies a still image into shared memory that is sealed against writes, so that it can be handed to every client that
+// decodes the same data without any of them being able to change what the others show.
+static ErrorOr<Gfx::ShareableBitmap> create_sealed_shareable_bitmap(Gfx::Bitmap const& bitmap)
+{
+    auto pitch = Gfx::Bitmap::minimum_pitch(bitmap.width(), bitmap.format());
+    auto size_in_bytes = Gfx::Bitmap::size_in_bytes(pitch, bitmap.height());
 
-static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(round_up_to_power_of_two(size_in_bytes, PAGE_SIZE)));
+    auto* pixels = buffer.data<u8>();
+    for (int y = 0; y < bitmap.height(); ++y)
+        memcpy(pixels + y * pitch, bitmap.scanline_u8(y), pitch);
+    TRY(buffer.seal());
+
+    auto sealed_bitmap = TRY(Gfx::Bitmap::create_with_anonymous_buffer(bitmap.format(), bitmap.alpha_type(), move(buffer), bitmap.size()));
+    return Gfx::ShareableBitmap { move(sealed_bitmap), Gfx::ShareableBitmap::ConstructWithKnownGoodBitmap };
+}
+
+static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type, Optional<ByteString> cache_partition)
 {
-    auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, known_mime_type));
+    TRACE_EVENT(Decode, "ImageDecoder::decode_image"sv);
+
+    auto encoded_data = ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() };
+
+    // NB: Without sealing, a client could write to the shared pixels that other clients are showing.
+    Optional<DecodedImageCacheKey> cache_key;
+    if (Core::AnonymousBuffer::supports_sealing && cache_partition.has_value())
+        cache_key = DecodedImageCache::key_for(cache_partition.release_value(), encoded_data, ideal_size, known_mime_type);
+
+    if (cache_key.has_value()) {
+        if (auto cached_image = DecodedImageCache::the().get(*cache_key); cached_image.has_value()) {
+            ConnectionFromClient::DecodeResult result;
+            result.frame_count = 1;
+            result.scale = cached_image->scale;
+            result.color_profile = move(cached_image->color_profile);
+            result.shared_bitmap = move(cached_image->bitmap);
+            return result;
+        }
+    }
+
+    auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(encoded_data, known_mime_type));
 
     if (!decoder)
         return Error::from_string_literal("Could not find suitable image decoder plugin for data");
@@ -147,24 +190,21 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
         for (u32 i = 0; i < result.frame_count; ++i)
             result.durations.unchecked_append(decoder->frame_duration(i));
 
-        // Decode only the first batch of frames.
-        u32 const batch_size = min(STREAMING_BATCH_SIZE, result.frame_count);
-        bitmaps.ensure_capacity(batch_size);
-        for (u32 i = 0; i < batch_size; ++i) {
-            auto frame_or_error = decoder->frame(i, ideal_size);
-            if (frame_or_error.is_error())
-                break;
+        // Decode only the first frame, so that it can be shown right away. The client requests the following frames
+        // just in time, as the animation plays.
+        if (auto frame_or_error = decoder->frame(0, ideal_size); !frame_or_error.is_error()) {
             auto frame = frame_or_error.release_value();
             frame.image->set_alpha_type_destructive(Gfx::AlphaType::Premultiplied);
-            bitmaps.unchecked_append(frame.image);
+            bitmaps.append(frame.image);
             // If frame_duration() returned 0, use the actual decoded duration.
-            if (result.durations[i] == 0)
-                result.durations[i] = frame.duration;
+            if (result.durations[0] == 0)
+                result.durations[0] = frame.duration;
         }
 
         // Keep decoder alive for future frame requests.
         result.decoder = decoder;
         result.encoded_data = move(encoded_buffer);
+        result.ideal_size = ideal_size;
     } else {
         decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), bitmaps, result.durations);
     }
@@ -172,18 +212,28 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
     if (bitmaps.is_empty())
         return Error::from_string_literal("Could not decode image");
 
+    // NB: Copying a still image into shared memory costs the same as sending it in a BitmapSequence would, and lets
+    //     later decodes of the same data for the same site map the same pixels.
+    if (cache_key.has_value() && !result.is_animated && bitmaps.size() == 1 && bitmaps.first()) {
+        if (auto shared_bitmap = create_sealed_shareable_bitmap(*bitmaps.first()); !shared_bitmap.is_error()) {
+            DecodedImageCache::the().set(cache_key.release_value(), { .bitmap = shared_bitmap.value(), .scale = result.scale, .color_profile = result.color_profile });
+            result.shared_bitmap = shared_bitmap.release_value();
+            return result;
+        }
+    }
+
     result.bitmaps = Gfx::BitmapSequence { move(bitmaps) };
 
     return result;
 }
 
-NonnullRefPtr<ConnectionFromClient::PendingJob> ConnectionFromClient::start_decode_image_job(i64 request_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<ConnectionFromClient::PendingJob> ConnectionFromClient::start_decode_image_job(i64 request_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, Optional<ByteString> cache_partition)
 {
     auto job = make_ref_counted<PendingJob>();
     auto& main_thread_event_loop = Core::EventLoop::current();
     Threading::ThreadPool::the().submit(
-        [strong_this = NonnullRefPtr(*this), job, &main_thread_event_loop, request_id, encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)]() mutable {
-            auto result = decode_image_to_details(move(encoded_buffer), ideal_size, mime_type);
+        [strong_this = NonnullRefPtr(*this), job, &main_thread_event_loop, request_id, encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type), cache_partition = move(cache_partition)]() mutable {
+            auto result = decode_image_to_details(move(encoded_buffer), ideal_size, mime_type, move(cache_partition));
 
             main_thread_event_loop.deferred_invoke([strong_this = move(strong_this), job = move(job), request_id, result = move(result)] mutable {
                 auto current_job = strong_this->m_pending_jobs.get(request_id);
@@ -211,10 +261,17 @@ NonnullRefPtr<ConnectionFromClient::PendingJob> ConnectionFromClient::start_deco
                     auto session = make_ref_counted<AnimationSession>();
                     session->encoded_data = move(result_value.encoded_data);
                     session->decoder = move(result_value.decoder);
+                    session->ideal_size = result_value.ideal_size;
                     session->frame_count = result_value.frame_count;
                     strong_this->m_animation_sessions.set(session_id, move(session));
                 }
 
+                if (result_value.shared_bitmap.is_valid()) {
+                    strong_this->async_did_decode_shared_image(request_id, move(result_value.shared_bitmap), result_value.scale, move(result_value.color_profile));
+                    strong_this->m_pending_jobs.remove(request_id);
+                    return;
+                }
+
                 strong_this->async_did_decode_image(request_id, result_value.is_animated, result_value.loop_count, move(result_value.bitmaps), move(result_value.durations), result_value.scale, move(result_value.color_profile), session_id);
                 strong_this->m_pending_jobs.remove(request_id);
             });
@@ -223,7 +280,7 @@ NonnullRefPtr<ConnectionFromClient::PendingJob> ConnectionFromClient::start_deco
     return job;
 }
 
-void ConnectionFromClient::decode_image(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, i64 request_id)
+void ConnectionFromClient::decode_image(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, Optional<ByteString> cache_partition, i64 request_id)
 {
     if (!encoded_buffer.is_valid()) {
         dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is invalid");
@@ -237,7 +294,7 @@ void ConnectionFromClient::decode_image(Core::AnonymousBuffer encoded_buffer, Op
         return;
     }
 
-    m_pending_jobs.set(request_id, start_decode_image_job(request_id, move(encoded_buffer), ideal_size, move(mime_type)));
+    m_pending_jobs.set(request_id, start_decode_image_job(request_id, move(encoded_buffer), ideal_size, move(mime_type), move(cache_partition)));
 }
 
 void ConnectionFromClient::cancel_decoding(i64 request_id)
@@ -247,6 +304,96 @@ void ConnectionFromClient::cancel_decoding(i64 request_id)
     }
 }
 
+// Showing a partially decoded image means sending all of its pixels again, so it's only done this often.
+static constexpr AK::Duration PARTIAL_IMAGE_INTERVAL = AK::Duration::from_milliseconds(100);
+
+void ConnectionFromClient::start_incremental_decode(i64 request_id)
+{
+    if (m_incremental_decodes.contains(request_id)) {
+        did_misbehave("Duplicate incremental decode request id");
+        return;
+    }
+
+    m_incremental_decodes.set(request_id, make_ref_counted<IncrementalDecode>());
+}
+
+void ConnectionFromClient::append_incremental_decode_data(i64 request_id, IPC::BorrowedBytes data)
+{
+    auto incremental_decode = m_incremental_decodes.get(request_id);
+    if (!incremental_decode.has_value())
+        return;
+
+    if (incremental_decode.value()->pending_data.try_append(data.bytes()).is_error()) {
+        end_incremental_decode(request_id);
+        return;
+    }
+
+    if (!incremental_decode.value()->job)
+        start_incremental_decode_job(request_id, *incremental_decode.value());
+}
+
+void ConnectionFromClient::end_incremental_decode(i64 request_id)
+{
+    if (auto incremental_decode = m_incremental_decodes.take(request_id); incremental_decode.has_value() && incremental_decode.value()->job)
+        incremental_decode.value()->job->cancel();
+}
+
+void ConnectionFromClient::start_incremental_decode_job(i64 request_id, NonnullRefPtr<IncrementalDecode> incremental_decode)
+{
+    auto job = make_ref_counted<PendingJob>();
+    incremental_decode->job = job;
+
+    auto& main_thread_event_loop = Core::EventLoop::current();
+    Threading::ThreadPool::the().submit(
+        [strong_this = NonnullRefPtr(*this), job, incremental_decode, &main_thread_event_loop, request_id, data = move(incremental_decode->pending_data)]() mutable {
+            auto result = [&]() -> ErrorOr<RefPtr<Gfx::Bitmap>> {
+                if (job->is_canceled())
+                    return RefPtr<Gfx::Bitmap> {};
+
+                if (!incremental_decode->decoder) {
+                    incremental_decode->decoder = TRY(Gfx::IncrementalImageDecoder::try_create(data));
+                    if (!incremental_decode->decoder)
+                        return Error::from_string_literal("Image format can't be decoded incrementally");
+                } else {
+                    TRY(incremental_decode->decoder->append_data(data));
+                }
+
+                auto now = MonotonicTime::now_coarse();
+                if (now - incremental_decode->last_partial_image_time < PARTIAL_IMAGE_INTERVAL)
+                    return RefPtr<Gfx::Bitmap> {};
+
+                auto bitmap = TRY(incremental_decode->decoder->take_partial_bitmap());
+                if (bitmap) {
+                    bitmap->set_alpha_type_destructive(Gfx::AlphaType::Premultiplied);
+                    incremental_decode->last_partial_image_time = now;
+                }
+                return bitmap;
+            }();
+
+            main_thread_event_loop.deferred_invoke([strong_this = move(strong_this), job = move(job), incremental_decode = move(incremental_decode), request_id, result = move(result)] mutable {
+                auto current_incremental_decode = strong_this->m_incremental_decodes.get(request_id);
+                if (!current_incremental_decode.has_value() || current_incremental_decode.value() != incremental_decode.ptr() || job->is_canceled())
+                    return;
+
+                // NB: The complete data is decoded as usual once it has arrived, so there's nothing to report if showing
+                //     it early didn't work out.
+                if (result.is_error()) {
+                    dbgln_if(IMAGE_DECODER_DEBUG, "Incremental decode failed: {}", result.error());
+                    strong_this->m_incremental_decodes.remove(request_id);
+                    return;
+                }
+
+                incremental_decode->job = nullptr;
+
+                if (auto bitmap = result.release_value(); bitmap && strong_this->is_open())
+                    strong_this->async_did_decode_partial_image(request_id, Gfx::BitmapSequence { { move(bitmap) } });
+
+                if (!incremental_decode->pending_data.is_empty())
+                    strong_this->start_incremental_decode_job(request_id, move(incremental_decode));
+            });
+        });
+}
+
 void ConnectionFromClient::request_animation_frames(i64 session_id, u32 start_frame_index, u32 count)
 {
     auto it = m_animation_sessions.find(session_id);
@@ -277,6 +424,8 @@ NonnullRefPtr<ConnectionFromClient::PendingJob> ConnectionFromClient::start_fram
                 if (job->is_canceled())
                     return FrameDecodeResult {};
 
+                TRACE_EVENT(Decode, "ImageDecoder::decode_animation_frames"sv);
+
                 Sync::MutexLocker locker { session->decoder_mutex };
                 if (!session->decoder)
                     return Error::from_string_literal("Animation session has no decoder");
@@ -287,7 +436,7 @@ NonnullRefPtr<ConnectionFromClient::PendingJob> ConnectionFromClient::start_fram
                     if (job->is_canceled())
                         return FrameDecodeResult {};
 
-                    auto frame_or_error = session->decoder->frame(i);
+                    auto frame_or_error = session->decoder->frame(i, session->ideal_size);
                     if (frame_or_error.is_error()) {
                         if (frames.is_empty())
                             return frame_or_error.release_error();
@@ -337,4 +486,25 @@ void ConnectionFromClient::stop_animation_decode(i64 session_id)
     m_animation_sessions.remove(session_id);
 }
 
+void ConnectionFromClient::did_receive_memory_pressure(Core::MemoryPressureLevel level)
+{
+    DecodedImageCache::the().did_receive_memory_pressure(level);
+}
+
+void ConnectionFromClient::request_memory_statistics()
+{
+    auto statistics = DecodedImageCache::the().statistics();
+    async_did_report_memory_statistics(statistics.size_in_bytes, statistics.image_count);
+}
+
+void ConnectionFromClient::set_trace_categories(Core::TraceCategory categories)
+{
+    Core::TraceEvents::set_enabled_categories(categories);
+}
+
+Messages::ImageDecoderServer::GetTraceEventJsonResponse ConnectionFromClient::get_trace_event_json()
+{
+    return Core::TraceEvents::to_trace_event_json("ImageDecoder"sv);
+}
+
 }
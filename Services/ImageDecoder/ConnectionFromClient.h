@@ -8,7 +8,9 @@
 
 #include <AK/Atomic.h>
 #include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
+#include <AK/Time.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
@@ -16,6 +18,7 @@
 #include <LibGfx/BitmapSequence.h>
 #include <LibGfx/ColorSpace.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
+#include <LibGfx/ShareableBitmap.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibSync/Mutex.h>
 
@@ -39,14 +42,19 @@ public:
         Vector<u32> durations;
         Gfx::ColorSpace color_profile;
 
+        // Set instead of bitmaps for still images, which may be shared with other clients through the DecodedImageCache.
+        Gfx::ShareableBitmap shared_bitmap;
+
         // Non-null for streaming animated sessions:
         RefPtr<Gfx::ImageDecoder> decoder;
         Core::AnonymousBuffer encoded_data;
+        Optional<Gfx::IntSize> ideal_size;
     };
 
     struct AnimationSession : public AtomicRefCounted<AnimationSession> {
         Core::AnonymousBuffer encoded_data;
         RefPtr<Gfx::ImageDecoder> decoder;
+        Optional<Gfx::IntSize> ideal_size;
         u32 frame_count { 0 };
         Sync::Mutex decoder_mutex;
     };
@@ -60,26 +68,47 @@ private:
         Atomic<bool> m_canceled { false };
     };
 
+    // An image that is shown while its data is still arriving. Its data is decoded by one job at a time, and the data
+    // that arrives in the meantime is handed to the next one.
+    struct IncrementalDecode : public AtomicRefCounted<IncrementalDecode> {
+        // Only accessed by the job that is decoding.
+        OwnPtr<Gfx::IncrementalImageDecoder> decoder;
+        MonotonicTime last_partial_image_time { MonotonicTime::now_coarse() };
+
+        // Only accessed on the main thread.
+        ByteBuffer pending_data;
+        RefPtr<PendingJob> job;
+    };
+
     using FrameDecodeResult = Vector<Gfx::ImageFrameDescriptor>;
 
     explicit ConnectionFromClient(NonnullOwnPtr<IPC::Transport>);
 
-    virtual void decode_image(Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, i64 request_id) override;
+    virtual void decode_image(Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, Optional<ByteString> cache_partition, i64 request_id) override;
     virtual void cancel_decoding(i64 request_id) override;
+    virtual void start_incremental_decode(i64 request_id) override;
+    virtual void append_incremental_decode_data(i64 request_id, IPC::BorrowedBytes data) override;
+    virtual void end_incremental_decode(i64 request_id) override;
     virtual void request_animation_frames(i64 session_id, u32 start_frame_index, u32 count) override;
     virtual void stop_animation_decode(i64 session_id) override;
+    virtual void did_receive_memory_pressure(Core::MemoryPressureLevel) override;
+    virtual void request_memory_statistics() override;
+    virtual void set_trace_categories(Core::TraceCategory) override;
+    virtual Messages::ImageDecoderServer::GetTraceEventJsonResponse get_trace_event_json() override;
     virtual Messages::ImageDecoderServer::ConnectNewClientsResponse connect_new_clients(size_t count) override;
     virtual Messages::ImageDecoderServer::InitTransportResponse init_transport(int peer_pid) override;
 
     ErrorOr<IPC::TransportHandle> connect_new_client();
 
-    NonnullRefPtr<PendingJob> start_decode_image_job(i64 request_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+    NonnullRefPtr<PendingJob> start_decode_image_job(i64 request_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, Optional<ByteString> cache_partition);
     NonnullRefPtr<PendingJob> start_frame_decode_job(i64 session_id, NonnullRefPtr<AnimationSession>, u32 start_frame_index, u32 end_index);
+    void start_incremental_decode_job(i64 request_id, NonnullRefPtr<IncrementalDecode>);
 
     i64 m_next_session_id { 1 };
     HashMap<i64, NonnullRefPtr<PendingJob>> m_pending_jobs;
     HashMap<i64, NonnullRefPtr<AnimationSession>> m_animation_sessions;
     HashMap<i64, NonnullRefPtr<PendingJob>> m_pending_frame_jobs;
+    HashMap<i64, NonnullRefPtr<IncrementalDecode>> m_incremental_decodes;
 };
 
 }
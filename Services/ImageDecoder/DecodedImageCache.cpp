@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <ImageDecoder/DecodedImageCache.h>
+#include <LibGfx/Bitmap.h>
+
+namespace ImageDecoder {
+
+// NB: The cached bitmaps are mostly mapped by the WebContent processes that are showing them as well, so this limits
+//     how much memory is kept alive for images that no page is showing anymore.
+static constexpr size_t MAXIMUM_CACHE_SIZE = 128 * MiB;
+
+// Large photos are rarely shown by more than one page, so they aren't worth evicting many smaller images for.
+static constexpr size_t MAXIMUM_CACHED_IMAGE_SIZE = 16 * MiB;
+
+DecodedImageCache& DecodedImageCache::the()
+{
+    static DecodedImageCache cache;
+    return cache;
+}
+
+DecodedImageCacheKey DecodedImageCache::key_for(ByteString partition, ReadonlyBytes encoded_data, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+{
+    return {
+        .partition = move(partition),
+        .digest = Crypto::Hash::SHA256::hash(encoded_data.data(), encoded_data.size()),
+        .ideal_size = ideal_size,
+        .mime_type = move(mime_type),
+    };
+}
+
+Optional<CachedImage> DecodedImageCache::get(DecodedImageCacheKey const& key)
+{
+    Sync::MutexLocker locker(m_mutex);
+
+    auto entry = m_entries.take(key);
+    if (!entry.has_value())
+        return {};
+
+    auto image = entry->image;
+    m_entries.set(key, entry.release_value());
+    return image;
+}
+
+void DecodedImageCache::set(DecodedImageCacheKey key, CachedImage image)
+{
+    VERIFY(image.bitmap.is_valid());
+
+    // NB: Every client that decodes the same data is handed the same memory, so it must not be writable by any of them.
+    VERIFY(image.bitmap.bitmap()->anonymous_buffer().is_sealed());
+
+    auto size_in_bytes = image.bitmap.bitmap()->size_in_bytes();
+    if (size_in_bytes > MAXIMUM_CACHED_IMAGE_SIZE)
+        return;
+
+    Sync::MutexLocker locker(m_mutex);
+
+    if (m_entries.contains(key))
+        return;
+
+    evict_until_size_is_at_most(MAXIMUM_CACHE_SIZE - size_in_bytes);
+
+    m_entries.set(move(key), { .image = move(image), .size_in_bytes = size_in_bytes });
+    m_size_in_bytes += size_in_bytes;
+}
+
+void DecodedImageCache::did_receive_memory_pressure(Core::MemoryPressureLevel level)
+{
+    Sync::MutexLocker locker(m_mutex);
+
+    switch (level) {
+    case Core::MemoryPressureLevel::Normal:
+        break;
+    case Core::MemoryPressureLevel::Warning:
+        evict_until_size_is_at_most(m_size_in_bytes / 2);
+        break;
+    case Core::MemoryPressureLevel::Critical:
+        m_entries.clear();
+        m_size_in_bytes = 0;
+        break;
+    }
+}
+
+DecodedImageCache::Statistics DecodedImageCache::statistics()
+{
+    Sync::MutexLocker locker(m_mutex);
+    return { .size_in_bytes = m_size_in_bytes, .image_count = m_entries.size() };
+}
+
+void DecodedImageCache::evict_until_size_is_at_most(size_t size_in_bytes)
+{
+    while (m_size_in_bytes > size_in_bytes) {
+        auto least_recently_used = m_entries.begin();
+        m_size_in_bytes -= least_recently_used->value.size_in_bytes;
+        m_entries.remove(least_recently_used);
+    }
+}
+
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Noncopyable.h>
+#include <AK/OrderedHashMap.h>
+#include <AK/Optional.h>
+#include <LibCore/MemoryPressureNotifier.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibGfx/ColorSpace.h>
+#include <LibGfx/Point.h>
+#include <LibGfx/ShareableBitmap.h>
+#include <LibGfx/Size.h>
+#include <LibSync/Mutex.h>
+
+namespace ImageDecoder {
+
+struct DecodedImageCacheKey {
+    ByteString partition;
+    Crypto::Hash::SHA256::DigestType digest;
+    Optional<Gfx::IntSize> ideal_size;
+    Optional<ByteString> mime_type;
+
+    bool operator==(DecodedImageCacheKey const&) const = default;
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<ImageDecoder::DecodedImageCacheKey> : public DefaultTraits<ImageDecoder::DecodedImageCacheKey> {
+    static unsigned hash(ImageDecoder::DecodedImageCacheKey const& key)
+    {
+        // The digest is uniformly distributed already, so a few of its bytes make a good hash.
+        unsigned hash = 0;
+        __builtin_memcpy(&hash, key.digest.data, sizeof(hash));
+        hash = pair_int_hash(hash, key.partition.hash());
+        if (key.ideal_size.has_value())
+            hash = pair_int_hash(hash, pair_int_hash(key.ideal_size->width(), key.ideal_size->height()));
+        return hash;
+    }
+};
+
+}
+
+namespace ImageDecoder {
+
+struct CachedImage {
+    Gfx::ShareableBitmap bitmap;
+    Gfx::FloatPoint scale { 1, 1 };
+    Gfx::ColorSpace color_profile;
+};
+
+// Still images that were decoded for any of our clients, keyed by a hash of their encoded data. Every WebContent that
+// decodes the same bytes for the same top-level site is handed the same sealed shared memory, so the pixels of common
+// logos and sprites exist only once per site. Partitioning keeps a page from telling which images other sites have
+// shown by how quickly its own decodes complete. The cache may be used from any thread.
+class DecodedImageCache {
+    AK_MAKE_NONCOPYABLE(DecodedImageCache);
+    AK_MAKE_NONMOVABLE(DecodedImageCache);
+
+public:
+    static DecodedImageCache& the();
+
+    static DecodedImageCacheKey key_for(ByteString partition, ReadonlyBytes encoded_data, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+
+    Optional<CachedImage> get(DecodedImageCacheKey const&);
+    void set(DecodedImageCacheKey, CachedImage);
+
+    void did_receive_memory_pressure(Core::MemoryPressureLevel);
+
+    struct Statistics {
+        size_t size_in_bytes { 0 };
+        size_t image_count { 0 };
+    };
+    Statistics statistics();
+
+private:
+    DecodedImageCache() = default;
+
+    struct Entry {
+        CachedImage image;
+        size_t size_in_bytes { 0 };
+    };
+
+    void evict_until_size_is_at_most(size_t);
+
+    Sync::Mutex m_mutex;
+    // Ordered from the least to the most recently used entry.
+    OrderedHashMap<DecodedImageCacheKey, Entry> m_entries;
+    size_t m_size_in_bytes { 0 };
+};
+
+}
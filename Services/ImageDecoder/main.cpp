@@ -11,6 +11,8 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Process.h>
+#include <LibCore/TraceEvent.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 
@@ -20,19 +22,26 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
 
     Core::ArgsParser args_parser;
     StringView mach_server_name;
+    StringView trace_categories;
     bool wait_for_debugger = false;
     bool disable_sandbox = false;
 
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
+    args_parser.add_option(trace_categories, "Record trace events in the given categories", "trace-categories", 0, "categories");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
     args_parser.add_option(disable_sandbox, "Disable process sandboxing", "disable-sandbox");
     args_parser.parse(arguments);
 
+    Core::TraceEvents::initialize_for_main_thread(trace_categories);
+
     if (wait_for_debugger)
         Core::Process::wait_for_debugger_and_break();
 
     auto& event_loop = Core::EventLoop::initialize_for_current_thread();
 
+    // NB: OpenSSL loads its configuration when the first digest is computed, which it can't do once we're sandboxed.
+    (void)Crypto::Hash::SHA256::hash(""sv);
+
     if (!disable_sandbox)
         TRY(ImageDecoder::apply_sandbox());
 
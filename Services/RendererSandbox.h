@@ -12,6 +12,11 @@
 
 namespace RendererSandbox {
 
-[[nodiscard]] ErrorOr<void> apply_sandbox(Optional<StringView> config_path, Optional<StringView> cache_path);
+enum class AllowVideoDecodingDevices {
+    No,
+    Yes,
+};
+
+[[nodiscard]] ErrorOr<void> apply_sandbox(Optional<StringView> config_path, Optional<StringView> cache_path, AllowVideoDecodingDevices = AllowVideoDecodingDevices::No);
 
 }
@@ -33,7 +33,9 @@ static ErrorOr<Optional<ByteString>> canonicalized_path_if_exists(StringView pat
     return ByteString { resolved_path };
 }
 
-ErrorOr<void> apply_sandbox(Optional<StringView> config_path, Optional<StringView> cache_path)
+// FIXME: Allow VideoToolbox to reach its decoder service when hardware video decoding is enabled. Until then, decoders
+//        fall back to software decoding when the hardware device can't be created.
+ErrorOr<void> apply_sandbox(Optional<StringView> config_path, Optional<StringView> cache_path, AllowVideoDecodingDevices)
 {
     TRY(Sandbox::configure_runtime());
 
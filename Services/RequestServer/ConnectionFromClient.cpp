@@ -7,10 +7,12 @@
 #include <AK/IDAllocator.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/WeakPtr.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Proxy.h>
 #include <LibCore/Socket.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibIPC/TransportHandle.h>
 #include <LibRequests/NetworkError.h>
@@ -65,6 +67,8 @@ static constexpr i64 CURL_CALL_THRESHOLD_MS = 50;
 template<typename F>
 static auto time_curl_call(StringView label, F&& f)
 {
+    TRACE_EVENT(Network, label);
+
     if constexpr (!REQUESTSERVER_WIRE_DEBUG)
         return f();
     auto start = MonotonicTime::now();
@@ -270,7 +274,35 @@ void ConnectionFromClient::set_use_system_dns()
     m_resolver->dns.reset_connection();
 }
 
-void ConnectionFromClient::start_request(u64 request_id, ByteString method, URL::URL url, Vector<HTTP::Header> request_headers, ByteBuffer request_body, HTTP::CacheMode cache_mode, HTTP::Cookie::IncludeCredentials include_credentials, Core::ProxyData proxy_data, bool keep_alive_for_transfer)
+void ConnectionFromClient::set_trace_categories(Core::TraceCategory categories)
+{
+    Core::TraceEvents::set_enabled_categories(categories);
+}
+
+Messages::RequestServer::GetTraceEventJsonResponse ConnectionFromClient::get_trace_event_json()
+{
+    return Core::TraceEvents::to_trace_event_json("RequestServer"sv);
+}
+
+void ConnectionFromClient::start_request(u64 request_id, ByteString method, URL::URL url, Vector<HTTP::Header> request_headers, ByteBuffer request_body, HTTP::CacheMode cache_mode, HTTP::Cookie::IncludeCredentials include_credentials, Core::ProxyData proxy_data, HTTP::Priority priority, bool keep_alive_for_transfer, Optional<ByteString> network_partition)
+{
+    start_fetch_request(request_id, move(method), move(url), move(request_headers), move(request_body), cache_mode, include_credentials, proxy_data, priority, keep_alive_for_transfer, move(network_partition));
+}
+
+void ConnectionFromClient::start_request_with_shared_body(u64 request_id, ByteString method, URL::URL url, Vector<HTTP::Header> request_headers, Core::AnonymousBuffer request_body, HTTP::CacheMode cache_mode, HTTP::Cookie::IncludeCredentials include_credentials, Core::ProxyData proxy_data, HTTP::Priority priority, bool keep_alive_for_transfer, Optional<ByteString> network_partition)
+{
+    // The body is uploaded straight from the client's mapping. If the client could still shrink it, reading past the
+    // new end would fault and take down RequestServer along with every other client's requests.
+    if (Core::AnonymousBuffer::supports_sealing && !request_body.is_sealed()) {
+        dbgln("RequestServer: Rejecting request {} with a shared body that isn't sealed", request_id);
+        async_request_finished(request_id, 0, {}, Requests::NetworkError::Unknown);
+        return;
+    }
+
+    start_fetch_request(request_id, move(method), move(url), move(request_headers), move(request_body), cache_mode, include_credentials, proxy_data, priority, keep_alive_for_transfer, move(network_partition));
+}
+
+void ConnectionFromClient::start_fetch_request(u64 request_id, ByteString method, URL::URL url, Vector<HTTP::Header> request_headers, RequestBody request_body, HTTP::CacheMode cache_mode, HTTP::Cookie::IncludeCredentials include_credentials, Core::ProxyData proxy_data, HTTP::Priority priority, bool keep_alive_for_transfer, Optional<ByteString> network_partition)
 {
     note_event_tick("ipc-start-request"sv);
     dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: start_request({}, {})", request_id, url);
@@ -289,7 +321,7 @@ void ConnectionFromClient::start_request(u64 request_id, ByteString method, URL:
         }
     }
 
-    auto request = Request::fetch(request_id, m_disk_cache, cache_mode, *this, m_curl_multi, m_resolver, move(url), move(method), HTTP::HeaderList::create(move(request_headers)), move(request_body), include_credentials, m_alt_svc_cache_path, proxy_data, keep_alive_for_transfer);
+    auto request = Request::fetch(request_id, m_disk_cache, cache_mode, *this, m_curl_multi, m_resolver, move(url), move(method), HTTP::HeaderList::create(move(request_headers)), move(request_body), include_credentials, m_alt_svc_cache_path, proxy_data, priority, keep_alive_for_transfer, move(network_partition));
     m_active_requests.set(request_id, move(request));
 }
 
@@ -340,14 +372,14 @@ void ConnectionFromClient::release_request_for_transfer(u64 request_id)
     }
 }
 
-void ConnectionFromClient::start_revalidation_request(Badge<Request>, ByteString method, URL::URL url, NonnullRefPtr<HTTP::HeaderList> request_headers, ByteBuffer request_body, HTTP::Cookie::IncludeCredentials include_credentials, Core::ProxyData proxy_data)
+void ConnectionFromClient::start_revalidation_request(Badge<Request>, ByteString method, URL::URL url, NonnullRefPtr<HTTP::HeaderList> request_headers, RequestBody request_body, HTTP::Cookie::IncludeCredentials include_credentials, Core::ProxyData proxy_data, Optional<ByteString> network_partition)
 {
     note_event_tick("ipc-start-revalidation"sv);
     auto request_id = m_next_revalidation_request_id++;
 
     dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: start_revalidation_request({}, {})", request_id, url);
 
-    auto request = Request::revalidate(request_id, m_disk_cache, *this, m_curl_multi, m_resolver, move(url), move(method), move(request_headers), move(request_body), include_credentials, m_alt_svc_cache_path, proxy_data);
+    auto request = Request::revalidate(request_id, m_disk_cache, *this, m_curl_multi, m_resolver, move(url), move(method), move(request_headers), move(request_body), include_credentials, m_alt_svc_cache_path, proxy_data, move(network_partition));
     m_active_revalidation_requests.set(request_id, move(request));
 }
 
@@ -451,6 +483,60 @@ void ConnectionFromClient::fail_websocket(u64 websocket_id, Requests::WebSocket:
     async_websocket_closed(websocket_id, to_underlying(WebSocket::CloseStatusCode::AbnormalClosure), {}, false);
 }
 
+// Keeps a single batch from growing into an arbitrarily large IPC message while a busy socket is being drained.
+static constexpr size_t MAXIMUM_WEBSOCKET_MESSAGE_BATCH_SIZE = 1 * MiB;
+
+void ConnectionFromClient::queue_websocket_message(u64 websocket_id, WebSocket::Message message)
+{
+    if (message.data().size() >= Requests::WEBSOCKET_SHARED_MEMORY_THRESHOLD) {
+        auto buffer_or_error = Core::AnonymousBuffer::create_with_size(message.data().size());
+        if (!buffer_or_error.is_error()) {
+            auto buffer = buffer_or_error.release_value();
+            __builtin_memcpy(buffer.data<void>(), message.data().data(), message.data().size());
+
+            flush_websocket_messages(websocket_id);
+            async_websocket_received_shared(websocket_id, message.is_text(), move(buffer));
+            return;
+        }
+        dbgln("queue_websocket_message: failed to allocate shared buffer for {} bytes: {}", message.data().size(), buffer_or_error.error());
+    }
+
+    auto& pending = m_pending_websocket_messages.ensure(websocket_id);
+    pending.size += message.data().size();
+    pending.messages.append({ message.release_data(), message.is_text() });
+
+    if (pending.size >= MAXIMUM_WEBSOCKET_MESSAGE_BATCH_SIZE) {
+        flush_websocket_messages(websocket_id);
+        return;
+    }
+
+    // The WebSocket parses every frame it has read from the socket before returning to the event loop, so flushing
+    // from a deferred invocation sends all of those frames at once.
+    if (m_websocket_message_flush_scheduled)
+        return;
+    m_websocket_message_flush_scheduled = true;
+
+    Core::deferred_invoke([weak_self = make_weak_ptr<ConnectionFromClient>()] {
+        if (auto self = weak_self.strong_ref())
+            self->flush_all_websocket_messages();
+    });
+}
+
+void ConnectionFromClient::flush_websocket_messages(u64 websocket_id)
+{
+    if (auto pending = m_pending_websocket_messages.take(websocket_id); pending.has_value())
+        async_websocket_received(websocket_id, move(pending->messages));
+}
+
+void ConnectionFromClient::flush_all_websocket_messages()
+{
+    m_websocket_message_flush_scheduled = false;
+
+    auto pending_websocket_messages = move(m_pending_websocket_messages);
+    for (auto& [websocket_id, pending] : pending_websocket_messages)
+        async_websocket_received(websocket_id, move(pending.messages));
+}
+
 Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(u64 request_id)
 {
     auto request = m_active_requests.take(request_id);
@@ -470,9 +556,36 @@ Messages::RequestServer::SetCertificateResponse ConnectionFromClient::set_certif
     TODO();
 }
 
-void ConnectionFromClient::ensure_connection(u64 request_id, URL::URL url, ::RequestServer::CacheLevel cache_level)
+// How long a resolved host or an opened connection is assumed to stay warm. This is well within the lifetime of idle
+// connections in curl's pool.
+static constexpr auto WARMED_ORIGIN_LIFETIME = AK::Duration::from_seconds(60);
+static constexpr size_t MAXIMUM_WARMED_ORIGIN_COUNT = 256;
+
+void ConnectionFromClient::ensure_connection(u64 request_id, URL::URL url, ::RequestServer::CacheLevel cache_level, Optional<ByteString> network_partition)
 {
-    auto request = Request::connect(request_id, *this, m_curl_multi, m_resolver, move(url), cache_level);
+    // OPTIMIZATION: Pages tend to hint at the same origins over and over (dns-prefetch and preconnect links, repeated
+    //               by every embed from a third party), so only warm up each origin once in a while. Connections
+    //               don't share TLS sessions across sites, so an origin is warmed up once per site.
+    if (auto origin = url.origin(); !origin.is_opaque()) {
+        auto now = MonotonicTime::now_coarse();
+        auto warmed_origin_key = MUST(String::formatted("{} {}", network_partition.value_or({}), origin.serialize()));
+
+        if (auto warmed_origin = m_warmed_origins.get(warmed_origin_key); warmed_origin.has_value()) {
+            if (now - warmed_origin->warmed_at < WARMED_ORIGIN_LIFETIME && to_underlying(warmed_origin->cache_level) >= to_underlying(cache_level))
+                return;
+        }
+
+        if (m_warmed_origins.size() >= MAXIMUM_WARMED_ORIGIN_COUNT) {
+            m_warmed_origins.remove_all_matching([&](auto const&, auto const& warmed_origin) {
+                return now - warmed_origin.warmed_at >= WARMED_ORIGIN_LIFETIME;
+            });
+        }
+
+        if (m_warmed_origins.size() < MAXIMUM_WARMED_ORIGIN_COUNT)
+            m_warmed_origins.set(warmed_origin_key, { cache_level, now });
+    }
+
+    auto request = Request::connect(request_id, *this, m_curl_multi, m_resolver, move(url), cache_level, move(network_partition));
     m_active_requests.set(request_id, move(request));
 }
 
@@ -563,6 +676,88 @@ Messages::RequestServer::CreateSyntheticCacheEntryResponse ConnectionFromClient:
     return result.value();
 }
 
+void ConnectionFromClient::store_shared_javascript_bytecode(ByteString partition, ByteBuffer source_hash, Core::AnonymousBuffer data)
+{
+    if (!m_disk_cache.has_value() || !data.is_valid())
+        return;
+
+    if (auto result = m_disk_cache->store_shared_javascript_bytecode(partition, source_hash, data.bytes()); result.is_error())
+        dbgln("Failed to store shared JavaScript bytecode: {}", result.error());
+}
+
+void ConnectionFromClient::retrieve_shared_javascript_bytecode(u64 retrieval_id, ByteString partition, ByteBuffer source_hash)
+{
+    if (!m_disk_cache.has_value()) {
+        async_retrieved_shared_javascript_bytecode(retrieval_id, {}, 0);
+        return;
+    }
+
+    auto file = m_disk_cache->retrieve_shared_javascript_bytecode_file(partition, source_hash);
+    if (file.is_error()) {
+        dbgln("Failed to retrieve shared JavaScript bytecode: {}", file.error());
+        async_retrieved_shared_javascript_bytecode(retrieval_id, {}, 0);
+        return;
+    }
+    if (!file.value().has_value()) {
+        async_retrieved_shared_javascript_bytecode(retrieval_id, {}, 0);
+        return;
+    }
+
+    async_retrieved_shared_javascript_bytecode(retrieval_id, IPC::File::adopt_fd(file.value()->fd), file.value()->size);
+}
+
+void ConnectionFromClient::store_decompressed_font(ByteString partition, ByteBuffer font_hash, Core::AnonymousBuffer data)
+{
+    if (!m_disk_cache.has_value() || !data.is_valid() || partition.is_empty())
+        return;
+
+    // The font is written to disk straight from the client's mapping, which the client must not be able to shrink.
+    if (Core::AnonymousBuffer::supports_sealing && !data.is_sealed()) {
+        dbgln("RequestServer: Rejecting a decompressed font that isn't sealed");
+        return;
+    }
+
+    auto url = HTTP::synthetic_url_for_decompressed_font(partition, font_hash);
+    if (!url.has_value())
+        return;
+
+    auto result = [&]() -> ErrorOr<void> {
+        TRY(m_disk_cache->create_synthetic_entry(*url, "GET"sv));
+        TRY(m_disk_cache->store_associated_data(*url, "GET"sv, *HTTP::HeaderList::create(), 0u, HTTP::CacheEntryAssociatedData::DecompressedFont, data.bytes()));
+        return {};
+    }();
+    if (result.is_error())
+        dbgln("Failed to store decompressed font: {}", result.error());
+}
+
+void ConnectionFromClient::retrieve_decompressed_font(u64 retrieval_id, ByteString partition, ByteBuffer font_hash)
+{
+    auto data = [&]() -> ErrorOr<Optional<Core::AnonymousBuffer>> {
+        if (!m_disk_cache.has_value() || partition.is_empty())
+            return Optional<Core::AnonymousBuffer> {};
+
+        auto url = HTTP::synthetic_url_for_decompressed_font(partition, font_hash);
+        if (!url.has_value())
+            return Optional<Core::AnonymousBuffer> {};
+
+        auto font_data = TRY(m_disk_cache->retrieve_associated_data(*url, "GET"sv, *HTTP::HeaderList::create(), 0u, HTTP::CacheEntryAssociatedData::DecompressedFont));
+        if (!font_data.has_value())
+            return Optional<Core::AnonymousBuffer> {};
+
+        auto buffer = TRY(Core::AnonymousBuffer::create_with_size(font_data->size()));
+        memcpy(buffer.data<void>(), font_data->data(), font_data->size());
+        return Optional<Core::AnonymousBuffer> { move(buffer) };
+    }();
+
+    if (data.is_error()) {
+        dbgln("Failed to retrieve decompressed font: {}", data.error());
+        async_retrieved_decompressed_font(retrieval_id, {});
+        return;
+    }
+
+    async_retrieved_decompressed_font(retrieval_id, data.release_value());
+}
+
 void ConnectionFromClient::websocket_connect(u64 websocket_id, URL::URL url, ByteString origin, Vector<ByteString> protocols, Vector<ByteString> extensions, Vector<HTTP::Header> additional_request_headers)
 {
     auto host = url.serialized_host().to_byte_string();
@@ -614,14 +809,17 @@ void ConnectionFromClient::websocket_connect(u64 websocket_id, URL::URL url, Byt
             };
             connection->on_message = [self = weak_self, websocket_id](auto message) {
                 if (auto strong_self = self.strong_ref())
-                    strong_self->async_websocket_received(websocket_id, message.is_text(), message.data());
+                    strong_self->queue_websocket_message(websocket_id, move(message));
             };
             connection->on_error = [self = weak_self, websocket_id](auto message) {
-                if (auto strong_self = self.strong_ref())
+                if (auto strong_self = self.strong_ref()) {
+                    strong_self->flush_websocket_messages(websocket_id);
                     strong_self->async_websocket_errored(websocket_id, (i32)message);
+                }
             };
             connection->on_close = [self = weak_self, websocket_id](u16 code, ByteString reason, bool was_clean) {
                 if (auto strong_self = self.strong_ref()) {
+                    strong_self->flush_websocket_messages(websocket_id);
                     strong_self->async_websocket_closed(websocket_id, code, move(reason), was_clean);
                     Core::deferred_invoke([self, websocket_id] {
                         if (auto strong_self = self.strong_ref())
@@ -630,8 +828,10 @@ void ConnectionFromClient::websocket_connect(u64 websocket_id, URL::URL url, Byt
                 }
             };
             connection->on_ready_state_change = [self = weak_self, websocket_id](auto state) {
-                if (auto strong_self = self.strong_ref())
+                if (auto strong_self = self.strong_ref()) {
+                    strong_self->flush_websocket_messages(websocket_id);
                     strong_self->async_websocket_ready_state_changed(websocket_id, (u32)state);
+                }
             };
 
             connection->start();
@@ -18,8 +18,10 @@
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibRequests/WebSocket.h>
 #include <LibWebSocket/WebSocket.h>
+#include <RequestServer/CacheLevel.h>
 #include <RequestServer/Forward.h>
 #include <RequestServer/IsPrivate.h>
+#include <RequestServer/RequestBody.h>
 #include <RequestServer/RequestClientEndpoint.h>
 #include <RequestServer/RequestServerEndpoint.h>
 
@@ -45,7 +47,7 @@ public:
 
     IsPrivate is_private() const { return m_is_private; }
 
-    void start_revalidation_request(Badge<Request>, ByteString method, URL::URL, NonnullRefPtr<HTTP::HeaderList> request_headers, ByteBuffer request_body, HTTP::Cookie::IncludeCredentials, Core::ProxyData proxy_data);
+    void start_revalidation_request(Badge<Request>, ByteString method, URL::URL, NonnullRefPtr<HTTP::HeaderList> request_headers, RequestBody request_body, HTTP::Cookie::IncludeCredentials, Core::ProxyData proxy_data, Optional<ByteString> network_partition);
     void request_complete(Badge<Request>, Request const&);
 
 private:
@@ -61,12 +63,15 @@ private:
     virtual Messages::RequestServer::GetClientIdResponse get_client_id() override;
     virtual void set_dns_server(ByteString host_or_address, u16 port, bool use_tls, bool validate_dnssec_locally) override;
     virtual void set_use_system_dns() override;
-    virtual void start_request(u64 request_id, ByteString, URL::URL, Vector<HTTP::Header>, ByteBuffer, HTTP::CacheMode, HTTP::Cookie::IncludeCredentials, Core::ProxyData, bool keep_alive_for_transfer) override;
+    virtual void set_trace_categories(Core::TraceCategory) override;
+    virtual Messages::RequestServer::GetTraceEventJsonResponse get_trace_event_json() override;
+    virtual void start_request(u64 request_id, ByteString, URL::URL, Vector<HTTP::Header>, ByteBuffer, HTTP::CacheMode, HTTP::Cookie::IncludeCredentials, Core::ProxyData, HTTP::Priority, bool keep_alive_for_transfer, Optional<ByteString> network_partition) override;
+    virtual void start_request_with_shared_body(u64 request_id, ByteString, URL::URL, Vector<HTTP::Header>, Core::AnonymousBuffer, HTTP::CacheMode, HTTP::Cookie::IncludeCredentials, Core::ProxyData, HTTP::Priority, bool keep_alive_for_transfer, Optional<ByteString> network_partition) override;
     virtual void adopt_request(int source_client_id, u64 source_request_id, u64 target_request_id) override;
     virtual void release_request_for_transfer(u64 request_id) override;
     virtual Messages::RequestServer::StopRequestResponse stop_request(u64 request_id) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(u64 request_id, ByteString, ByteString) override;
-    virtual void ensure_connection(u64 request_id, URL::URL url, ::RequestServer::CacheLevel cache_level) override;
+    virtual void ensure_connection(u64 request_id, URL::URL url, ::RequestServer::CacheLevel cache_level, Optional<ByteString> network_partition) override;
 
     virtual void retrieved_http_cookie(int client_id, u64 request_id, RequestServer::RequestType request_type, String cookie) override;
 
@@ -75,6 +80,10 @@ private:
     virtual Messages::RequestServer::StoreCacheAssociatedDataResponse store_cache_associated_data(URL::URL, ByteString method, Vector<HTTP::Header> request_headers, Optional<u64> vary_key, HTTP::CacheEntryAssociatedData, Core::AnonymousBuffer) override;
     virtual Messages::RequestServer::RetrieveCacheAssociatedDataResponse retrieve_cache_associated_data(URL::URL, ByteString method, Vector<HTTP::Header> request_headers, Optional<u64> vary_key, HTTP::CacheEntryAssociatedData) override;
     virtual Messages::RequestServer::CreateSyntheticCacheEntryResponse create_synthetic_cache_entry(URL::URL, ByteString method) override;
+    virtual void store_shared_javascript_bytecode(ByteString partition, ByteBuffer source_hash, Core::AnonymousBuffer) override;
+    virtual void retrieve_shared_javascript_bytecode(u64 retrieval_id, ByteString partition, ByteBuffer source_hash) override;
+    virtual void store_decompressed_font(ByteString partition, ByteBuffer font_hash, Core::AnonymousBuffer) override;
+    virtual void retrieve_decompressed_font(u64 retrieval_id, ByteString partition, ByteBuffer font_hash) override;
 
     virtual void websocket_connect(u64 websocket_id, URL::URL, ByteString, Vector<ByteString>, Vector<ByteString>, Vector<HTTP::Header>) override;
     virtual void websocket_send(u64 websocket_id, bool, ByteBuffer) override;
@@ -82,10 +91,15 @@ private:
     virtual void websocket_close(u64 websocket_id, u16, ByteString) override;
     virtual Messages::RequestServer::WebsocketSetCertificateResponse websocket_set_certificate(u64, ByteString, ByteString) override;
 
+    void start_fetch_request(u64 request_id, ByteString, URL::URL, Vector<HTTP::Header>, RequestBody, HTTP::CacheMode, HTTP::Cookie::IncludeCredentials, Core::ProxyData, HTTP::Priority, bool keep_alive_for_transfer, Optional<ByteString> network_partition);
+
     static int on_socket_callback(void*, int sockfd, int what, void* user_data, void*);
     static int on_timeout_callback(void*, long timeout_ms, void* user_data);
     void check_active_requests();
     void fail_websocket(u64 websocket_id, Requests::WebSocket::Error);
+    void queue_websocket_message(u64 websocket_id, WebSocket::Message);
+    void flush_websocket_messages(u64 websocket_id);
+    void flush_all_websocket_messages();
 
     ErrorOr<IPC::TransportHandle> create_client_socket(IsPrivate);
 
@@ -101,6 +115,14 @@ private:
     HashTable<u64> m_pending_websockets;
     HashMap<u64, RefPtr<WebSocket::WebSocket>> m_websockets;
 
+    // Messages parsed from the same socket read are sent to the client in one IPC message.
+    struct PendingWebSocketMessages {
+        Vector<Requests::WebSocket::Message> messages;
+        size_t size { 0 };
+    };
+    HashMap<u64, PendingWebSocketMessages> m_pending_websocket_messages;
+    bool m_websocket_message_flush_scheduled { false };
+
     RefPtr<Core::Timer> m_timer;
     HashMap<int, NonnullRefPtr<Core::Notifier>> m_read_notifiers;
     HashMap<int, NonnullRefPtr<Core::Notifier>> m_write_notifiers;
@@ -112,6 +134,12 @@ private:
 
     Optional<MonotonicTime> m_burst_window_started_at;
     u64 m_requests_in_burst_window { 0 };
+
+    struct WarmedOrigin {
+        CacheLevel cache_level { CacheLevel::ResolveOnly };
+        MonotonicTime warmed_at;
+    };
+    HashMap<String, WarmedOrigin> m_warmed_origins;
 };
 
 constexpr inline uintptr_t websocket_private_tag = 0x1;
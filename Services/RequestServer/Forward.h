@@ -11,6 +11,7 @@ namespace RequestServer {
 class ConnectionFromClient;
 class Request;
 class RequestPipe;
+class TLSSessionShare;
 
 struct DNSInfo;
 struct Resolver;
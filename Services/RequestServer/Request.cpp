@@ -11,6 +11,7 @@
 #include <LibCore/MimeData.h>
 #include <LibCore/Notifier.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibHTTP/Cache/Utilities.h>
 #include <LibHTTP/Status.h>
@@ -20,6 +21,7 @@
 #include <RequestServer/Request.h>
 #include <RequestServer/Resolver.h>
 #include <RequestServer/ResourceSubstitutionMap.h>
+#include <RequestServer/TLSSessionCache.h>
 
 namespace RequestServer {
 
@@ -27,6 +29,10 @@ extern OwnPtr<ResourceSubstitutionMap> g_resource_substitution_map;
 
 static long s_connect_timeout_seconds = 90L;
 
+// Once this much response data is waiting for the client to drain our pipe, we stop reading from the network until it
+// catches up, so that a slow consumer doesn't make us buffer the entire response.
+static constexpr size_t s_maximum_buffered_response_size = 1 * MiB;
+
 Request::TransferredBodyFile::~TransferredBodyFile()
 {
     if (fd != -1)
@@ -373,13 +379,17 @@ NonnullOwnPtr<Request> Request::fetch(
     URL::URL url,
     ByteString method,
     NonnullRefPtr<HTTP::HeaderList> request_headers,
-    ByteBuffer request_body,
+    RequestBody request_body,
     HTTP::Cookie::IncludeCredentials include_credentials,
     Optional<ByteString> alt_svc_cache_path,
     Core::ProxyData proxy_data,
-    bool keep_alive_for_transfer)
+    HTTP::Priority priority,
+    bool keep_alive_for_transfer,
+    Optional<ByteString> network_partition)
 {
     auto request = adopt_own(*new Request { request_id, RequestType::Fetch, disk_cache, cache_mode, client, curl_multi, resolver, move(url), move(method), move(request_headers), move(request_body), include_credentials, move(alt_svc_cache_path), proxy_data, keep_alive_for_transfer });
+    request->m_priority = priority;
+    request->m_network_partition = move(network_partition);
     request->process();
 
     return request;
@@ -391,10 +401,12 @@ NonnullOwnPtr<Request> Request::connect(
     void* curl_multi,
     Resolver& resolver,
     URL::URL url,
-    CacheLevel cache_level)
+    CacheLevel cache_level,
+    Optional<ByteString> network_partition)
 {
     auto request = adopt_own(*new Request { request_id, client, curl_multi, resolver, move(url) });
     request->m_connect_cache_level = cache_level;
+    request->m_network_partition = move(network_partition);
     request->transition_to_state(State::DNSLookup);
     return request;
 }
@@ -408,12 +420,14 @@ NonnullOwnPtr<Request> Request::revalidate(
     URL::URL url,
     ByteString method,
     NonnullRefPtr<HTTP::HeaderList> request_headers,
-    ByteBuffer request_body,
+    RequestBody request_body,
     HTTP::Cookie::IncludeCredentials include_credentials,
     Optional<ByteString> alt_svc_cache_path,
-    Core::ProxyData proxy_data)
+    Core::ProxyData proxy_data,
+    Optional<ByteString> network_partition)
 {
     auto request = adopt_own(*new Request { request_id, RequestType::BackgroundRevalidation, disk_cache, HTTP::CacheMode::Default, client, curl_multi, resolver, move(url), move(method), move(request_headers), move(request_body), include_credentials, move(alt_svc_cache_path), proxy_data });
+    request->m_network_partition = move(network_partition);
     request->process();
 
     return request;
@@ -430,7 +444,7 @@ Request::Request(
     URL::URL url,
     ByteString method,
     NonnullRefPtr<HTTP::HeaderList> request_headers,
-    ByteBuffer request_body,
+    RequestBody request_body,
     HTTP::Cookie::IncludeCredentials include_credentials,
     Optional<ByteString> alt_svc_cache_path,
     Core::ProxyData proxy_data,
@@ -564,6 +578,8 @@ void Request::transition_to_state(State state)
 
 void Request::process()
 {
+    TRACE_EVENT(Network, "RequestServer::Request::process"sv);
+
     switch (m_state) {
     case State::Init:
         handle_initial_state();
@@ -625,7 +641,7 @@ void Request::handle_initial_state()
 
                     if (m_cache_entry_reader.has_value()) {
                         if (m_cache_entry_reader->revalidation_type() == HTTP::CacheEntryReader::RevalidationType::StaleWhileRevalidate)
-                            m_client->start_revalidation_request({}, m_method, m_url, m_request_headers, m_request_body, m_include_credentials, m_proxy_data);
+                            m_client->start_revalidation_request({}, m_method, m_url, m_request_headers, m_request_body, m_include_credentials, m_proxy_data, m_network_partition);
 
                         if (is_revalidation_request())
                             transition_to_state(State::DNSLookup);
@@ -861,6 +877,25 @@ void Request::handle_retrieve_cookie_state()
     }
 }
 
+void Request::attach_tls_session_share()
+{
+    auto set_option = [&](auto option, auto value) {
+        if (auto result = curl_easy_setopt(m_curl_easy_handle, option, value); result != CURLE_OK)
+            dbgln("Request::attach_tls_session_share: Failed to set curl option: {}", curl_easy_strerror(result));
+    };
+
+    // NB: Without a partition (e.g. for a document with an opaque top-level origin), there is no site that the sessions
+    //     could safely be shared with, so they aren't cached at all. Otherwise they would end up in the cache of the
+    //     multi handle, which is shared by every request of the client.
+    if (!m_network_partition.has_value()) {
+        set_option(CURLOPT_SSL_SESSIONID_CACHE, 0L);
+        return;
+    }
+
+    m_tls_session_share = tls_session_share(m_client->is_private(), *m_network_partition);
+    set_option(CURLOPT_SHARE, m_tls_session_share->curl_share());
+}
+
 void Request::handle_connect_state()
 {
     m_curl_easy_handle = curl_easy_init();
@@ -877,6 +912,7 @@ void Request::handle_connect_state()
     set_option(CURLOPT_PRIVATE, this);
 
     set_option(CURLOPT_NOSIGNAL, 1L);
+    attach_tls_session_share();
 
     set_option(CURLOPT_URL, m_url.to_byte_string().characters());
     set_option(CURLOPT_PORT, m_url.port_or_default());
@@ -925,6 +961,7 @@ void Request::handle_fetch_state()
     set_option(CURLOPT_PRIVATE, this);
 
     set_option(CURLOPT_NOSIGNAL, 1L);
+    attach_tls_session_share();
 
     if (auto const& path = default_certificate_path(); !path.is_empty())
         set_option(CURLOPT_CAINFO, path.characters());
@@ -943,16 +980,29 @@ void Request::handle_fetch_state()
         set_option(CURLOPT_VERBOSE, 1);
     }
 
+    long ssl_options = 0;
+
+    // Early data may be replayed by an attacker, so only requests that are safe to repeat are sent in the first flight
+    // of a resumed TLS 1.3 session.
+    if (m_method.is_one_of("GET"sv, "HEAD"sv))
+        ssl_options |= CURLSSLOPT_EARLYDATA;
+
 #if defined(AK_OS_WINDOWS)
     // Without explicitly using the OS Native CA cert store on Windows, https requests timeout with CURLE_PEER_FAILED_VERIFICATION
-    set_option(CURLOPT_SSL_OPTIONS, CURLSSLOPT_NATIVE_CA);
+    ssl_options |= CURLSSLOPT_NATIVE_CA;
 #endif
 
+    if (ssl_options != 0)
+        set_option(CURLOPT_SSL_OPTIONS, ssl_options);
+
     curl_slist* curl_headers = nullptr;
 
     if (m_method.is_one_of("POST"sv, "PUT"sv, "PATCH"sv, "DELETE"sv)) {
-        set_option(CURLOPT_POSTFIELDSIZE, m_request_body.size());
-        set_option(CURLOPT_POSTFIELDS, m_request_body.data());
+        // NB: curl does not copy the body given to CURLOPT_POSTFIELDS, so a body in shared memory is uploaded straight
+        //     from the client's mapping.
+        auto request_body = m_request_body.visit([](auto const& body) { return body.bytes(); });
+        set_option(CURLOPT_POSTFIELDSIZE, request_body.size());
+        set_option(CURLOPT_POSTFIELDS, request_body.data());
 
         // CURLOPT_POSTFIELDS automatically sets the Content-Type header. Tell curl to remove it by setting a blank
         // value if the headers passed in don't contain a content type.
@@ -976,6 +1026,14 @@ void Request::handle_fetch_state()
         }
     }
 
+    // https://httpwg.org/specs/rfc9218.html#header-field
+    // NB: Servers that implement the extensible priority scheme use this to order the responses sharing a connection.
+    //     A Priority header set by the page itself is sent as is.
+    if (!m_priority.is_default() && !m_request_headers->contains("Priority"sv)) {
+        auto header_string = ByteString::formatted("Priority: {}", m_priority.serialize());
+        curl_headers = curl_slist_append(curl_headers, header_string.characters());
+    }
+
     if (is_revalidation_request) {
         auto revalidation_attributes = HTTP::RevalidationAttributes::create(m_cache_entry_reader->response_headers());
         VERIFY(revalidation_attributes.etag.has_value() || revalidation_attributes.last_modified.has_value());
@@ -1100,9 +1158,17 @@ size_t Request::on_header_received(void* buffer, size_t size, size_t nmemb, void
     auto total_size = size * nmemb;
     auto header_line = StringView { static_cast<char const*>(buffer), total_size };
 
-    // We need to extract the HTTP reason phrase since it can be a custom value. Fetching infrastructure needs this
-    // value for setting the status message.
-    if (!request.m_reason_phrase.has_value() && header_line.starts_with("HTTP/"sv)) {
+    if (header_line.starts_with("HTTP/"sv)) {
+        // curl also hands us the status line and headers of interim (1xx) responses, such as 100 Continue or 103 Early
+        // Hints. Start over at each status line, so that only the final response's headers are sent as its headers.
+        request.m_reason_phrase.clear();
+        request.m_response_headers = HTTP::HeaderList::create();
+
+        auto status_line_parts = HTTP::normalize_header_value(header_line).split_view(' ');
+        request.m_received_status_code = status_line_parts.size() >= 2 ? status_line_parts[1].to_number<u32>() : Optional<u32> {};
+
+        // We need to extract the HTTP reason phrase since it can be a custom value. Fetching infrastructure needs this
+        // value for setting the status message.
         auto space_index = header_line.find(' ');
         if (space_index.has_value())
             space_index = header_line.find(' ', *space_index + 1);
@@ -1113,9 +1179,17 @@ size_t Request::on_header_received(void* buffer, size_t size, size_t nmemb, void
                 VERIFY(decoder.has_value());
 
                 request.m_reason_phrase = MUST(decoder->to_utf8(reason_phrase, TextCodec::IgnoreBOM::No, TextCodec::ErrorMode::Replacement));
-                return total_size;
             }
         }
+
+        return total_size;
+    }
+
+    // Each response's headers end with an empty line.
+    if (HTTP::normalize_header_value(header_line).is_empty()) {
+        if (request.m_received_status_code == 103u)
+            request.transfer_early_hints_to_client();
+        return total_size;
     }
 
     if (auto colon_index = header_line.find(':'); colon_index.has_value()) {
@@ -1127,10 +1201,25 @@ size_t Request::on_header_received(void* buffer, size_t size, size_t nmemb, void
     return total_size;
 }
 
+void Request::transfer_early_hints_to_client()
+{
+    // NB: Only fetches have a request on the client's side that could make use of the hints.
+    if (m_type != RequestType::Fetch)
+        return;
+
+    m_client->async_request_early_hints_received(m_request_id, m_response_headers->headers());
+}
+
 size_t Request::on_data_received(void* buffer, size_t size, size_t nmemb, void* user_data)
 {
     auto& request = *static_cast<Request*>(user_data);
 
+    // NB: curl hands us this same data again once the transfer is unpaused, so nothing may be consumed before here.
+    if (request.m_response_buffer.used_buffer_size() >= s_maximum_buffered_response_size) {
+        request.m_curl_transfer_paused = true;
+        return CURL_WRITEFUNC_PAUSE;
+    }
+
     if (request.m_type == RequestType::Fetch || request.m_type == RequestType::BackgroundRevalidation)
         record_chunk(&request, size * nmemb);
 
@@ -1401,17 +1490,31 @@ ErrorOr<void> Request::write_queued_bytes_without_blocking()
 
         if (written < bytes.size()) {
             m_client_writer_notifier->set_enabled(true);
+            resume_curl_transfer_if_needed();
             return {};
         }
     }
 
     m_client_writer_notifier->set_enabled(false);
+    resume_curl_transfer_if_needed();
     if (m_curl_result_code.has_value())
         transition_to_state(State::Complete);
 
     return {};
 }
 
+void Request::resume_curl_transfer_if_needed()
+{
+    if (!m_curl_transfer_paused || m_response_buffer.used_buffer_size() >= s_maximum_buffered_response_size)
+        return;
+
+    // NB: Unpausing may deliver data to on_data_received() before curl_easy_pause() returns.
+    m_curl_transfer_paused = false;
+
+    if (auto result = curl_easy_pause(m_curl_easy_handle, CURLPAUSE_CONT); result != CURLE_OK)
+        dbgln("Request::resume_curl_transfer_if_needed: Failed to unpause transfer: {}", curl_easy_strerror(result));
+}
+
 bool Request::is_revalidation_request() const
 {
     switch (m_type) {
@@ -18,12 +18,14 @@
 #include <LibHTTP/Cache/CacheRequest.h>
 #include <LibHTTP/Cookie/IncludeCredentials.h>
 #include <LibHTTP/HeaderList.h>
+#include <LibHTTP/Priority.h>
 #include <LibIPC/File.h>
 #include <LibRequests/NetworkError.h>
 #include <LibRequests/RequestTimingInfo.h>
 #include <LibURL/URL.h>
 #include <RequestServer/CacheLevel.h>
 #include <RequestServer/Forward.h>
+#include <RequestServer/RequestBody.h>
 #include <RequestServer/RequestPipe.h>
 #include <RequestServer/RequestType.h>
 
@@ -43,11 +45,13 @@ public:
         URL::URL url,
         ByteString method,
         NonnullRefPtr<HTTP::HeaderList> request_headers,
-        ByteBuffer request_body,
+        RequestBody request_body,
         HTTP::Cookie::IncludeCredentials include_credentials,
         Optional<ByteString> alt_svc_cache_path,
         Core::ProxyData proxy_data,
-        bool keep_alive_for_transfer);
+        HTTP::Priority priority,
+        bool keep_alive_for_transfer,
+        Optional<ByteString> network_partition);
 
     static NonnullOwnPtr<Request> connect(
         u64 request_id,
@@ -55,7 +59,8 @@ public:
         void* curl_multi,
         Resolver& resolver,
         URL::URL url,
-        CacheLevel cache_level);
+        CacheLevel cache_level,
+        Optional<ByteString> network_partition);
 
     static NonnullOwnPtr<Request> revalidate(
         u64 request_id,
@@ -66,10 +71,11 @@ public:
         URL::URL url,
         ByteString method,
         NonnullRefPtr<HTTP::HeaderList> request_headers,
-        ByteBuffer request_body,
+        RequestBody request_body,
         HTTP::Cookie::IncludeCredentials include_credentials,
         Optional<ByteString> alt_svc_cache_path,
-        Core::ProxyData proxy_data);
+        Core::ProxyData proxy_data,
+        Optional<ByteString> network_partition);
 
     virtual ~Request() override;
 
@@ -153,7 +159,7 @@ private:
         URL::URL url,
         ByteString method,
         NonnullRefPtr<HTTP::HeaderList> request_headers,
-        ByteBuffer request_body,
+        RequestBody request_body,
         HTTP::Cookie::IncludeCredentials include_credentials,
         Optional<ByteString> alt_svc_cache_path,
         Core::ProxyData proxy_data,
@@ -175,6 +181,7 @@ private:
     void handle_serve_substitution_state();
     void handle_dns_lookup_state();
     void handle_retrieve_cookie_state();
+    void attach_tls_session_share();
     void handle_connect_state();
     void handle_fetch_state();
     void handle_complete_state();
@@ -188,8 +195,10 @@ private:
     ErrorOr<void> send_request_pipe_to_client();
     ErrorOr<void> send_transferred_body_file_to_client();
     void transfer_headers_to_client_if_needed();
+    void transfer_early_hints_to_client();
     void send_headers_to_client(Optional<IPC::File> javascript_bytecode = {}, u64 javascript_bytecode_size = 0, Optional<u64> javascript_bytecode_cache_vary_key = {});
     ErrorOr<void> write_queued_bytes_without_blocking();
+    void resume_curl_transfer_if_needed();
 
     virtual bool is_revalidation_request() const override;
     ErrorOr<void> revalidation_failed();
@@ -210,6 +219,7 @@ private:
     void* m_curl_multi_handle { nullptr };
     void* m_curl_easy_handle { nullptr };
     bool m_curl_easy_handle_is_in_multi { false };
+    RefPtr<TLSSessionShare> m_tls_session_share;
     Vector<curl_slist*> m_curl_string_lists;
     Optional<int> m_curl_result_code;
 
@@ -222,21 +232,29 @@ private:
 
     UnixDateTime m_request_start_time { UnixDateTime::now() };
     NonnullRefPtr<HTTP::HeaderList> m_request_headers;
-    ByteBuffer m_request_body;
+    RequestBody m_request_body;
+    HTTP::Priority m_priority;
 
     HTTP::Cookie::IncludeCredentials m_include_credentials { HTTP::Cookie::IncludeCredentials::Yes };
 
     Optional<ByteString> m_alt_svc_cache_path;
     Core::ProxyData m_proxy_data;
 
+    // The serialized top-level site this request is made on behalf of, if any.
+    Optional<ByteString> m_network_partition;
+
     Optional<u32> m_status_code;
     Optional<String> m_reason_phrase;
 
+    // The status code from the most recent status line curl handed us, which may belong to an interim response.
+    Optional<u32> m_received_status_code;
+
     NonnullRefPtr<HTTP::HeaderList> m_response_headers;
     bool m_sent_response_headers_to_client { false };
 
     AllocatingMemoryStream m_response_buffer;
     RefPtr<Core::Notifier> m_client_writer_notifier;
+    bool m_curl_transfer_paused { false };
     Optional<RequestPipe> m_client_request_pipe;
     Optional<TransferredBodyFile> m_transferred_body_file;
     size_t m_bytes_transferred_to_client { 0 };
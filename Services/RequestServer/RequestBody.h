@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Variant.h>
+#include <LibCore/AnonymousBuffer.h>
+
+namespace RequestServer {
+
+// Small request bodies arrive inline in the start_request IPC message. Large ones are handed over in shared memory,
+// which curl then uploads from directly.
+using RequestBody = Variant<ByteBuffer, Core::AnonymousBuffer>;
+
+}
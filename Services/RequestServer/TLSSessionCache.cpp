@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/OrderedHashMap.h>
+#include <RequestServer/CURL.h>
+#include <RequestServer/TLSSessionCache.h>
+
+namespace RequestServer {
+
+// Shares of the least recently used sites are dropped beyond this count. Requests that are still using such a share
+// keep it alive until they finish.
+static constexpr size_t MAXIMUM_TLS_SESSION_SHARE_COUNT = 64;
+
+NonnullRefPtr<TLSSessionShare> TLSSessionShare::create()
+{
+    auto* share = curl_share_init();
+    VERIFY(share);
+
+    // NB: Every curl handle in RequestServer is driven from the main thread, so the share doesn't need lock callbacks.
+    auto result = curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    VERIFY(result == CURLSHE_OK);
+
+    return adopt_ref(*new TLSSessionShare(share));
+}
+
+TLSSessionShare::TLSSessionShare(void* curl_share)
+    : m_curl_share(curl_share)
+{
+}
+
+TLSSessionShare::~TLSSessionShare()
+{
+    auto result = curl_share_cleanup(m_curl_share);
+    VERIFY(result == CURLSHE_OK);
+}
+
+NonnullRefPtr<TLSSessionShare> tls_session_share(IsPrivate is_private, ByteString const& network_partition)
+{
+    static OrderedHashMap<ByteString, NonnullRefPtr<TLSSessionShare>> s_shares;
+    static OrderedHashMap<ByteString, NonnullRefPtr<TLSSessionShare>> s_private_shares;
+
+    auto& shares = is_private == IsPrivate::Yes ? s_private_shares : s_shares;
+
+    // Re-inserting the share moves it to the back, so the front of the map is always the least recently used site.
+    auto share = shares.take(network_partition).value_or_lazy_evaluated([] { return TLSSessionShare::create(); });
+
+    if (shares.size() >= MAXIMUM_TLS_SESSION_SHARE_COUNT)
+        (void)shares.take_first();
+
+    shares.set(network_partition, share);
+    return share;
+}
+
+}
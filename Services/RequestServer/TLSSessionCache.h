@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <RequestServer/IsPrivate.h>
+
+namespace RequestServer {
+
+// A curl share that holds TLS sessions, so that connecting to a server again resumes the earlier session instead of
+// performing a full handshake and verifying the certificate chain again. A share can't be cleaned up while a handle
+// still uses it, so every request that attaches it also holds a reference to it.
+class TLSSessionShare : public RefCounted<TLSSessionShare> {
+public:
+    static NonnullRefPtr<TLSSessionShare> create();
+    ~TLSSessionShare();
+
+    void* curl_share() const { return m_curl_share; }
+
+private:
+    explicit TLSSessionShare(void* curl_share);
+
+    void* m_curl_share { nullptr };
+};
+
+// Resuming a session tells the server that the same client connected before, so sessions are only shared between
+// connections made on behalf of the same top-level site (the network partition key), and never with private clients.
+// The sessions live in memory only, and are gone once RequestServer exits.
+NonnullRefPtr<TLSSessionShare> tls_session_share(IsPrivate, ByteString const& network_partition);
+
+}
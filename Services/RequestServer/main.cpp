@@ -13,6 +13,7 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/Process.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
@@ -45,6 +46,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     StringView http_disk_cache_mode;
     StringView resource_map_path;
     StringView cache_path;
+    StringView trace_categories;
     bool wait_for_debugger = false;
     bool disable_sandbox = false;
 
@@ -54,10 +56,13 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.add_option(http_disk_cache_mode, "HTTP disk cache mode", "http-disk-cache-mode", 0, "mode");
     args_parser.add_option(resource_map_path, "Path to JSON file mapping URLs to local files", "resource-map", 0, "path");
     args_parser.add_option(cache_path, "Path to the profile cache", "cache-path", 0, "path");
+    args_parser.add_option(trace_categories, "Record trace events in the given categories", "trace-categories", 0, "categories");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
     args_parser.add_option(disable_sandbox, "Disable process sandboxing", "disable-sandbox");
     args_parser.parse(arguments);
 
+    Core::TraceEvents::initialize_for_main_thread(trace_categories);
+
     if (wait_for_debugger)
         Core::Process::wait_for_debugger_and_break();
 
@@ -17,16 +17,22 @@
 #include <AK/QuickSort.h>
 #include <AK/Utf16FlyString.h>
 #include <AK/Utf16String.h>
+#include <LibCore/File.h>
+#include <LibCore/MemoryPressureNotifier.h>
 #include <LibCore/Process.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibDevTools/IndexedDBSerialization.h>
 #include <LibGC/Heap.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Color.h>
+#include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/SystemTheme.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/Date.h>
+#include <LibIPC/Statistics.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibUnicode/TimeZone.h>
 #include <LibWasm/Types.h>
 #include <LibWeb/ARIA/RoleType.h>
@@ -36,6 +42,7 @@
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CSS/StyleSheetList.h>
 #include <LibWeb/Compositor/CompositorHost.h>
+#include <LibWeb/Compositor/FrameTiming.h>
 #include <LibWeb/CookieStore/CookieStore.h>
 #include <LibWeb/DOM/AbstractElement.h>
 #include <LibWeb/DOM/Attr.h>
@@ -51,8 +58,10 @@
 #include <LibWeb/Fetch/Fetching/Fetching.h>
 #include <LibWeb/Geometry/DOMRect.h>
 #include <LibWeb/HTML/AutoplaySettings.h>
+#include <LibWeb/HTML/BackForwardCache.h>
 #include <LibWeb/HTML/BroadcastChannel.h>
 #include <LibWeb/HTML/BrowsingContext.h>
+#include <LibWeb/HTML/DiscardableImageCache.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/HTMLInputElement.h>
 #include <LibWeb/HTML/HTMLTextAreaElement.h>
@@ -80,6 +89,7 @@
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/Platform/FontPlugin.h>
 #include <LibWeb/Selection/Selection.h>
+#include <LibWeb/StorageAPI/LocalStorageArea.h>
 #include <LibWebView/Attribute.h>
 #include <LibWebView/CompositorConnection.h>
 #include <LibWebView/DictionaryLookup.h>
@@ -1543,6 +1553,43 @@ void ConnectionFromClient::inspect_accessibility_tree(u64 page_id)
     }
 }
 
+void ConnectionFromClient::start_js_profiler(u64, u64 interval_in_microseconds)
+{
+    if (m_js_profiler)
+        return;
+
+    JS::SamplingProfiler::Options options;
+    options.interval = AK::Duration::from_microseconds(static_cast<i64>(interval_in_microseconds));
+
+    auto profiler = JS::SamplingProfiler::start(Web::Bindings::main_thread_vm(), options);
+    if (profiler.is_error()) {
+        dbgln("Unable to start the JavaScript profiler: {}", profiler.error());
+        return;
+    }
+    m_js_profiler = profiler.release_value();
+}
+
+void ConnectionFromClient::stop_js_profiler(u64 page_id)
+{
+    if (!m_js_profiler) {
+        async_did_stop_js_profiler(page_id, {});
+        return;
+    }
+
+    m_js_profiler->stop();
+
+    String thread_name = "WebContent"_string;
+    if (auto page = this->page(page_id); page.has_value()) {
+        if (auto* document = page->page().top_level_browsing_context().active_document())
+            thread_name = document->url().serialize();
+    }
+
+    auto profile = m_js_profiler->to_gecko_profile(thread_name).serialized();
+    m_js_profiler = nullptr;
+
+    async_did_stop_js_profiler(page_id, move(profile));
+}
+
 void ConnectionFromClient::get_hovered_node_id(u64 page_id)
 {
     auto page = this->page(page_id);
@@ -2012,6 +2059,20 @@ static void append_gc_graph(StringBuilder& builder)
     gc_graph.serialize(builder);
 }
 
+void ConnectionFromClient::dump_gc_graph_snapshot(IPC::File file)
+{
+    auto write_snapshot = [&]() -> ErrorOr<void> {
+        auto output = TRY(Core::File::adopt_fd(file.take_fd(), Core::File::OpenMode::Write));
+        auto buffered_output = TRY(Core::OutputBufferedFile::create(move(output)));
+        TRY(Web::Bindings::main_thread_vm().heap().write_graph_snapshot(*buffered_output));
+        TRY(buffered_output->flush_buffer());
+        return {};
+    };
+
+    if (auto result = write_snapshot(); result.is_error())
+        dbgln("Failed to write GC graph snapshot: {}", result.error());
+}
+
 void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::PageInfoType type)
 {
     auto page = this->page(page_id);
@@ -2050,6 +2111,24 @@ void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::Page
         append_gc_graph(builder);
     }
 
+    if (has_flag(type, WebView::PageInfoType::FrameTimeline)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        builder.append(Web::Compositor::FrameTimeline::the().to_trace_event_json());
+    }
+
+    if (has_flag(type, WebView::PageInfoType::IPCTrace)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        builder.append(IPC::Statistics::the().to_trace_event_json("WebContent"sv));
+    }
+
+    if (has_flag(type, WebView::PageInfoType::Trace)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        builder.append(Core::TraceEvents::to_trace_event_json("WebContent"sv));
+    }
+
     auto buffer = MUST(Core::AnonymousBuffer::create_with_size(builder.length()));
     if (builder.length() > 0)
         memcpy(buffer.data<void>(), builder.string_view().characters_without_null_termination(), builder.length());
@@ -2444,8 +2523,15 @@ void ConnectionFromClient::request_file(u64 page_id, Web::FileRequest file_reque
 
 void ConnectionFromClient::set_system_visibility_state(u64 page_id, Web::HTML::VisibilityState visibility_state)
 {
-    if (auto page = this->page(page_id); page.has_value())
-        page->page().top_level_traversable()->set_system_visibility_state(visibility_state);
+    auto page = this->page(page_id);
+    if (!page.has_value())
+        return;
+
+    page->page().top_level_traversable()->set_system_visibility_state(visibility_state);
+
+    // Frames requested while the page was hidden were skipped.
+    if (visibility_state == Web::HTML::VisibilityState::Visible)
+        page->page().client().request_frame();
 }
 
 void ConnectionFromClient::reset_zoom(u64 page_id)
@@ -2565,6 +2651,76 @@ void ConnectionFromClient::system_time_zone_changed()
     Unicode::clear_system_time_zone_cache();
 }
 
+void ConnectionFromClient::did_receive_memory_pressure(Core::MemoryPressureLevel level)
+{
+    // Drop the caches first, so that the collection below can reclaim whatever they were keeping alive.
+    // NB: Documents in the back/forward cache are only kept around in case the user traverses back to them, so they go
+    //     at any level of pressure.
+    Web::HTML::BackForwardCache::the().evict_all();
+    Web::HTML::DiscardableImageCache::the().did_receive_memory_pressure(level);
+
+    if (level == Core::MemoryPressureLevel::Critical) {
+        Gfx::Font::clear_all_shaping_caches();
+        Web::Fetch::Fetching::clear_http_memory_cache();
+
+        for (auto navigable : Web::HTML::all_local_navigables()) {
+            if (auto document = navigable->active_document())
+                document->purge_image_resource_caches();
+        }
+    }
+
+    Web::Bindings::main_thread_vm().heap().did_receive_memory_pressure(level);
+}
+
+void ConnectionFromClient::request_ipc_statistics()
+{
+    if (IPC::Statistics::is_enabled())
+        async_did_report_ipc_statistics(IPC::Statistics::the().snapshot());
+}
+
+void ConnectionFromClient::request_memory_statistics()
+{
+    WebView::MemoryStatistics statistics;
+
+    size_t heap_block_bytes = 0;
+    size_t live_cell_bytes = 0;
+    for (auto const& allocator : Web::Bindings::main_thread_vm().heap().allocator_statistics()) {
+        auto name = allocator.class_name.has_value()
+            ? ByteString { *allocator.class_name }
+            : ByteString::formatted("{}-byte cells", allocator.cell_size);
+        auto cell_bytes = allocator.live_cell_count * allocator.cell_size;
+
+        statistics.add("GC heap"sv, name, cell_bytes, allocator.live_cell_count);
+        if (allocator.external_bytes != 0)
+            statistics.add("External memory"sv, name, allocator.external_bytes, allocator.live_cell_count);
+
+        heap_block_bytes += allocator.block_count * GC::HeapBlock::BLOCK_SIZE;
+        live_cell_bytes += cell_bytes;
+    }
+    statistics.add("GC heap"sv, "Free cells and block headers"sv, heap_block_bytes - live_cell_bytes, 0);
+
+    auto shaping_cache_statistics = Gfx::Font::shaping_cache_statistics();
+    statistics.add("Font caches"sv, "Shaped glyphs"sv, shaping_cache_statistics.byte_size, shaping_cache_statistics.entry_count);
+
+    size_t display_list_bytes = 0;
+    size_t navigable_count = 0;
+    for (auto navigable : Web::HTML::all_local_navigables()) {
+        display_list_bytes += navigable->display_list_byte_size();
+        ++navigable_count;
+    }
+    statistics.add("Display lists"sv, "Recorded commands"sv, display_list_bytes, navigable_count);
+
+    auto http_memory_cache_size = Web::Fetch::Fetching::http_memory_cache_size();
+    statistics.add("HTTP memory cache"sv, "Responses"sv, http_memory_cache_size.bytes, http_memory_cache_size.partition_count);
+
+    async_did_report_memory_statistics(move(statistics));
+}
+
+void ConnectionFromClient::set_trace_categories(Core::TraceCategory categories)
+{
+    Core::TraceEvents::set_enabled_categories(categories);
+}
+
 void ConnectionFromClient::set_system_font_family(String family)
 {
     Web::Platform::FontPlugin::the().set_system_font_family(FlyString { family });
@@ -2598,6 +2754,21 @@ void ConnectionFromClient::broadcast_channel_message(Web::HTML::BroadcastChannel
     Web::HTML::BroadcastChannel::deliver_message_locally(message);
 }
 
+void ConnectionFromClient::storage_item_changed(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Optional<Utf16String> key, Optional<Utf16String> value, u64 version, bool is_own_change)
+{
+    Web::StorageAPI::LocalStorageArea::did_change_item(storage_endpoint, storage_key, key, value, version, is_own_change);
+}
+
+void ConnectionFromClient::storage_areas_invalidated()
+{
+    Web::StorageAPI::LocalStorageArea::invalidate_all();
+}
+
+void ConnectionFromClient::local_storage_changed_in_other_process(String storage_key, String url, Optional<Utf16String> key, Optional<Utf16String> old_value, Optional<Utf16String> new_value)
+{
+    Web::HTML::Storage::broadcast_local_storage_change_from_other_process(storage_key, url, key, old_value, new_value);
+}
+
 void ConnectionFromClient::did_worker_agent_finish_loading_script(Web::HTML::WorkerAgentOwnerToken owner_token)
 {
     Web::HTML::WorkerAgentParent::did_finish_loading_worker_script(owner_token);
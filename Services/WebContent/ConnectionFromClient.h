@@ -132,6 +132,8 @@ private:
     virtual void highlight_grid(u64 page_id, Web::UniqueNodeID node_id, JsonValue options) override;
     virtual void clear_grid_highlight(u64 page_id, Web::UniqueNodeID node_id) override;
     virtual void inspect_accessibility_tree(u64 page_id) override;
+    virtual void start_js_profiler(u64 page_id, u64 interval_in_microseconds) override;
+    virtual void stop_js_profiler(u64 page_id) override;
     virtual void get_hovered_node_id(u64 page_id) override;
     virtual void get_node_id_at_position(u64 page_id, u64 request_id, Web::DevicePixelPoint position) override;
 
@@ -206,6 +208,7 @@ private:
     virtual void take_dom_node_screenshot(u64 page_id, Web::UniqueNodeID node_id) override;
 
     virtual void request_internal_page_info(u64 page_id, WebView::PageInfoType) override;
+    virtual void dump_gc_graph_snapshot(IPC::File) override;
 
     virtual Messages::WebContentServer::GetSelectedTextResponse get_selected_text(u64 page_id) override;
     virtual Messages::WebContentServer::GetSelectedTextForLookupResponse get_selected_text_for_lookup(u64 page_id) override;
@@ -225,12 +228,19 @@ private:
     virtual void unmark_text_from_input_method(u64 page_id) override;
 
     virtual void system_time_zone_changed() override;
+    virtual void did_receive_memory_pressure(Core::MemoryPressureLevel) override;
+    virtual void request_ipc_statistics() override;
+    virtual void request_memory_statistics() override;
+    virtual void set_trace_categories(Core::TraceCategory) override;
     virtual void set_system_font_family(String family) override;
 
     virtual void set_document_cookie_version_buffer(u64 page_id, Core::AnonymousBuffer document_cookie_version_buffer) override;
     virtual void set_document_cookie_version_index(u64 page_id, i64 document_id, Core::SharedVersionIndex document_index) override;
     virtual void cookies_changed(u64 page_id, Vector<HTTP::Cookie::Cookie>) override;
     virtual void broadcast_channel_message(Web::HTML::BroadcastChannelMessage message) override;
+    virtual void storage_item_changed(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Optional<Utf16String> key, Optional<Utf16String> value, u64 version, bool is_own_change) override;
+    virtual void storage_areas_invalidated() override;
+    virtual void local_storage_changed_in_other_process(String storage_key, String url, Optional<Utf16String> key, Optional<Utf16String> old_value, Optional<Utf16String> new_value) override;
     virtual void did_worker_agent_finish_loading_script(Web::HTML::WorkerAgentOwnerToken owner_token) override;
     virtual void did_worker_agent_fail_loading_script(Web::HTML::WorkerAgentOwnerToken owner_token) override;
     virtual void did_worker_agent_report_exception(Web::HTML::WorkerAgentOwnerToken owner_token, Utf16String message, Utf16String filename, u32 lineno, u32 colno) override;
@@ -244,6 +254,9 @@ private:
     NonnullOwnPtr<PageHost> m_page_host;
 
     HashMap<int, Web::FileRequest> m_requested_files {};
+
+    // All pages hosted by this process share the main thread VM, so one profiler covers them all.
+    OwnPtr<JS::SamplingProfiler> m_js_profiler;
     int last_id { 0 };
 
     void enqueue_input_event(Web::QueuedInputEvent);
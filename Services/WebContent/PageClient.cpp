@@ -28,6 +28,7 @@
 #include <LibWeb/CSS/StyleSheetIdentifier.h>
 #include <LibWeb/CSS/StyleSheetList.h>
 #include <LibWeb/Compositor/CompositorHost.h>
+#include <LibWeb/Compositor/FrameTiming.h>
 #include <LibWeb/DOM/CharacterData.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
@@ -46,7 +47,6 @@
 #include <LibWeb/HTML/Scripting/ClassicScript.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HTML/Window.h>
-#include <LibWeb/HighResolutionTime/TimeOrigin.h>
 #include <LibWeb/InvalidateDisplayList.h>
 #include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Painting/Paintable.h>
@@ -469,23 +469,25 @@ void PageClient::request_frame()
     if (m_frame_timer->is_active())
         return;
 
-    auto delay = 0.0;
-    auto now = Web::HighResolutionTime::unsafe_shared_current_time();
-    if (m_last_scheduled_frame_dispatch_time.has_value()) {
-        auto minimum_frame_interval = 1000.0 / m_maximum_frames_per_second;
-        auto next_frame_dispatch_time = *m_last_scheduled_frame_dispatch_time + minimum_frame_interval;
-        m_last_scheduled_frame_dispatch_time = max(now, next_frame_dispatch_time);
-        delay = *m_last_scheduled_frame_dispatch_time - now;
-    } else {
-        m_last_scheduled_frame_dispatch_time = now;
-    }
+    // A hidden page isn't presented, so it skips its frames until it becomes visible again.
+    if (!page().top_level_traversable_is_initialized())
+        return;
+    auto top_level_traversable = page().top_level_traversable();
+    if (top_level_traversable->system_visibility_state() == Web::HTML::VisibilityState::Hidden)
+        return;
+
+    if (top_level_traversable->has_compositor_context())
+        m_frame_scheduler.did_finish_frames(Web::Compositor::FrameTimeline::the(), top_level_traversable->compositor_context().id());
 
-    m_frame_timer->restart(static_cast<int>(AK::ceil(delay)));
+    auto now = MonotonicTime::now();
+    auto delay = m_frame_scheduler.schedule_rendering_update(now) - now;
+    m_frame_timer->restart(static_cast<int>(AK::ceil(delay.to_nanoseconds() / 1'000'000.0)));
 }
 
 void PageClient::set_maximum_frames_per_second(double maximum_frames_per_second)
 {
     m_maximum_frames_per_second = maximum_frames_per_second;
+    m_frame_scheduler.set_refresh_rate(maximum_frames_per_second);
 }
 
 void PageClient::page_did_request_cursor_change(Gfx::Cursor const& cursor)
@@ -1057,43 +1059,28 @@ bool PageClient::page_did_is_known_hsts_host(String const& domain)
     return response->result();
 }
 
-Optional<Utf16String> PageClient::page_did_request_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, Utf16String const& bottle_key)
+Optional<Web::StorageAPI::LocalStorageAreaSnapshot> PageClient::page_did_request_storage_area(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key)
 {
-    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRequestStorageItem>(storage_endpoint, storage_key, bottle_key);
+    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRequestStorageArea>(storage_endpoint, storage_key);
     if (!response) {
-        dbgln("WebContent client disconnected during DidRequestStorageItem. Exiting peacefully.");
+        dbgln("WebContent client disconnected during DidRequestStorageArea. Exiting peacefully.");
         Core::Process::terminate_immediately(0);
     }
-    return response->take_value();
+    return Web::StorageAPI::LocalStorageAreaSnapshot {
+        .keys = response->take_keys(),
+        .values = response->take_values(),
+        .version = response->version(),
+    };
 }
 
-WebView::StorageSetResult PageClient::page_did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, Utf16String const& bottle_key, Utf16String const& value)
+void PageClient::page_did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, Utf16String const& bottle_key, Utf16String const& value)
 {
-    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidSetStorageItem>(storage_endpoint, storage_key, bottle_key, value);
-    if (!response) {
-        dbgln("WebContent client disconnected during DidSetStorageItem. Exiting peacefully.");
-        Core::Process::terminate_immediately(0);
-    }
-    return response->result();
+    client().async_did_set_storage_item(storage_endpoint, storage_key, bottle_key, value);
 }
 
 void PageClient::page_did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, Utf16String const& bottle_key)
 {
-    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRemoveStorageItem>(storage_endpoint, storage_key, bottle_key);
-    if (!response) {
-        dbgln("WebContent client disconnected during DidRemoveStorageItem. Exiting peacefully.");
-        Core::Process::terminate_immediately(0);
-    }
-}
-
-Vector<Utf16String> PageClient::page_did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key)
-{
-    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRequestStorageKeys>(storage_endpoint, storage_key);
-    if (!response) {
-        dbgln("WebContent client disconnected during DidRequestStorageKeys. Exiting peacefully.");
-        Core::Process::terminate_immediately(0);
-    }
-    return response->take_keys();
+    client().async_did_remove_storage_item(storage_endpoint, storage_key, bottle_key);
 }
 
 u64 PageClient::page_did_request_storage_usage(String const& storage_key)
@@ -1108,16 +1095,12 @@ u64 PageClient::page_did_request_storage_usage(String const& storage_key)
 
 void PageClient::page_did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key)
 {
-    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidClearStorage>(storage_endpoint, storage_key);
-    if (!response) {
-        dbgln("WebContent client disconnected during DidClearStorage. Exiting peacefully.");
-        Core::Process::terminate_immediately(0);
-    }
+    client().async_did_clear_storage(storage_endpoint, storage_key);
 }
 
-void PageClient::page_did_broadcast_storage_change(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& url, Optional<Utf16String> const& key, Optional<Utf16String> const& old_value, Optional<Utf16String> const& new_value)
+void PageClient::page_did_broadcast_storage_change(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, String const& url, Optional<Utf16String> const& key, Optional<Utf16String> const& old_value, Optional<Utf16String> const& new_value)
 {
-    client().async_did_change_storage_item(m_id, storage_endpoint, url, key, old_value, new_value);
+    client().async_did_change_storage_item(m_id, storage_endpoint, storage_key, url, key, old_value, new_value);
 }
 
 void PageClient::page_did_update_indexed_database(String const& url, Web::IndexedDB::TransactionChanges const& changes)
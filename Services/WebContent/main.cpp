@@ -12,15 +12,19 @@
 #include <LibCore/Resource.h>
 #include <LibCore/System.h>
 #include <LibCore/TimeZone.h>
+#include <LibCore/TraceEvent.h>
 #include <LibCrypto/OpenSSLForward.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/PathFontProvider.h>
 #include <LibIPC/ConnectionFromClient.h>
+#include <LibIPC/Statistics.h>
 #include <LibIPC/TransportHandle.h>
 #include <LibMain/Main.h>
+#include <LibMedia/FFmpeg/FFmpegVideoDecoder.h>
 #include <LibRequests/RequestClient.h>
 #include <LibUnicode/TimeZone.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/Compositor/FrameTiming.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/Fetch/Fetching/Fetching.h>
 #include <LibWeb/HTML/UniversalGlobalScope.h>
@@ -141,6 +145,8 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     bool log_all_js_exceptions = false;
     auto site_isolation_mode = WebView::SiteIsolationMode::TopLevel;
     bool enable_idl_tracing = false;
+    bool enable_ipc_statistics = false;
+    bool enable_hardware_video_decoding = false;
     bool enable_http_memory_cache = false;
     bool force_fontconfig = false;
     bool collect_garbage_on_every_allocation = false;
@@ -151,6 +157,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     StringView echo_server_port_string_view {};
     StringView default_time_zone {};
     StringView style_invalidation_counter_dump_interval {};
+    StringView trace_categories {};
     bool file_origins_are_tuple_origins = false;
 
     Core::ArgsParser args_parser;
@@ -178,6 +185,9 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
         },
     });
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
+    args_parser.add_option(enable_ipc_statistics, "Record IPC traffic statistics", "enable-ipc-statistics");
+    args_parser.add_option(trace_categories, "Record trace events in the given categories", "trace-categories", 0, "categories");
+    args_parser.add_option(enable_hardware_video_decoding, "Decode video on the GPU where supported", "enable-hardware-video-decoding");
     args_parser.add_option(enable_http_memory_cache, "Enable HTTP cache", "enable-http-memory-cache");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation");
@@ -256,8 +266,18 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
         Web::WebIDL::set_enable_idl_tracing(true);
     }
 
-    if (!disable_sandbox)
-        TRY(RendererSandbox::apply_sandbox(config_path, cache_path));
+    if (enable_ipc_statistics)
+        IPC::Statistics::set_enabled(true);
+
+    Core::TraceEvents::initialize_for_main_thread(trace_categories);
+
+    if (enable_hardware_video_decoding)
+        Media::FFmpeg::FFmpegVideoDecoder::set_hardware_acceleration_enabled(true);
+
+    if (!disable_sandbox) {
+        auto allow_video_decoding_devices = enable_hardware_video_decoding ? RendererSandbox::AllowVideoDecodingDevices::Yes : RendererSandbox::AllowVideoDecodingDevices::No;
+        TRY(RendererSandbox::apply_sandbox(config_path, cache_path, allow_video_decoding_devices));
+    }
 
 #if defined(AK_OS_MACOS)
     auto browser_port = TRY(Core::MachPort::look_up_from_bootstrap_server(ByteString { mach_server_name }));
@@ -277,6 +297,14 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
         if (auto result = connect_to_image_decoder(handle); result.is_error())
             dbgln("Failed to connect to image decoder: {}", result.error());
     };
+    heap.on_collection_finished = [weak_client = webcontent_client->make_weak_ptr<WebContent::ConnectionFromClient>()](auto const& statistics) {
+        if (auto client = weak_client.strong_ref())
+            client->async_did_finish_garbage_collection(statistics.sequence_number, (statistics.mark_time + statistics.sweep_time).to_microseconds());
+    };
+    Web::Compositor::FrameTimeline::the().on_dropped_frame = [weak_client = webcontent_client->make_weak_ptr<WebContent::ConnectionFromClient>()](u64 dropped_frame_count) {
+        if (auto client = weak_client.strong_ref())
+            client->async_did_drop_frame(dropped_frame_count);
+    };
 
     return event_loop.exec();
 }
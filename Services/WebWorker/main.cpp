@@ -8,6 +8,7 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/Process.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibCrypto/OpenSSLForward.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/SingleServer.h>
@@ -53,6 +54,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     StringView worker_type_string;
     StringView mach_server_name;
     StringView cache_path;
+    StringView trace_categories;
     Vector<ByteString> certificates;
     bool expose_experimental_interfaces = false;
     bool enable_http_memory_cache = false;
@@ -69,11 +71,14 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.add_option(worker_type_string, "Type of WebWorker to start (dedicated, shared, or service)", "type", 't', "type");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(cache_path, "Path to the profile cache", "cache-path", 0, "path");
+    args_parser.add_option(trace_categories, "Record trace events in the given categories", "trace-categories", 0, "categories");
     args_parser.add_option(file_origins_are_tuple_origins, "Treat file:// URLs as having tuple origins", "tuple-file-origins");
     args_parser.add_option(disable_sandbox, "Disable process sandboxing", "disable-sandbox");
 
     args_parser.parse(arguments);
 
+    Core::TraceEvents::initialize_for_main_thread(trace_categories);
+
     if (wait_for_debugger)
         Core::Process::wait_for_debugger_and_break();
 
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/BumpArena.h>
+#include <AK/Vector.h>
+
+TEST_CASE(allocations_are_aligned_and_distinct)
+{
+    BumpArena arena;
+
+    auto* a = arena.make<u8>(static_cast<u8>(1));
+    auto* b = arena.make<u64>(static_cast<u64>(2));
+    auto* c = arena.make<u8>(static_cast<u8>(3));
+
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(b) % alignof(u64), 0u);
+    EXPECT_EQ(*a, 1);
+    EXPECT_EQ(*b, 2u);
+    EXPECT_EQ(*c, 3);
+
+    auto* aligned = arena.allocate(8, 64);
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(aligned) % 64, 0u);
+}
+
+TEST_CASE(over_aligned_allocations_are_aligned_in_fresh_and_large_chunks)
+{
+    BumpArena arena;
+
+    // The first allocation of a chunk and a dedicated large allocation both start right after a chunk header.
+    auto* first = arena.allocate(8, 256);
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(first) % 256, 0u);
+
+    auto* large = static_cast<u8*>(arena.allocate(BumpArena::chunk_size, 4096));
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(large) % 4096, 0u);
+    memset(large, 0xab, BumpArena::chunk_size);
+    EXPECT_EQ(large[BumpArena::chunk_size - 1], 0xab);
+}
+
+TEST_CASE(allocations_spill_into_new_chunks)
+{
+    BumpArena arena;
+
+    // Enough to need several chunks, and every value has to survive the others being allocated.
+    static constexpr size_t count = 3 * BumpArena::chunk_size / sizeof(u64);
+    Vector<u64*> values;
+    for (size_t i = 0; i < count; ++i)
+        values.append(arena.make<u64>(static_cast<u64>(i)));
+
+    for (size_t i = 0; i < count; ++i)
+        EXPECT_EQ(*values[i], i);
+}
+
+TEST_CASE(large_allocations_get_their_own_chunk)
+{
+    BumpArena arena;
+
+    auto* small = static_cast<u8*>(arena.allocate(16, 16));
+    auto* large = static_cast<u8*>(arena.allocate(2 * BumpArena::chunk_size, 16));
+    memset(large, 0xab, 2 * BumpArena::chunk_size);
+    memset(small, 0xcd, 16);
+
+    EXPECT_EQ(large[0], 0xab);
+    EXPECT_EQ(large[2 * BumpArena::chunk_size - 1], 0xab);
+    EXPECT_EQ(small[0], 0xcd);
+}
+
+TEST_CASE(reset_allows_reuse)
+{
+    BumpArena arena;
+
+    for (size_t round = 0; round < 4; ++round) {
+        for (size_t i = 0; i < 1000; ++i)
+            *arena.make<u64>() = i;
+        arena.reset();
+    }
+
+    BumpArena::trim_thread_cache();
+    EXPECT_EQ(*arena.make<u32>(static_cast<u32>(42)), 42u);
+}
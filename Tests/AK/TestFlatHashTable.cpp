@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteString.h>
+#include <AK/FlatHashMap.h>
+#include <AK/FlatHashTable.h>
+#include <AK/HashTable.h>
+#include <AK/String.h>
+
+TEST_CASE(construct)
+{
+    using IntTable = FlatHashTable<int>;
+    EXPECT(IntTable().is_empty());
+    EXPECT_EQ(IntTable().size(), 0u);
+    EXPECT_EQ(IntTable().capacity(), 0u);
+}
+
+TEST_CASE(basic_move)
+{
+    FlatHashTable<int> foo;
+    foo.set(1);
+    EXPECT_EQ(foo.size(), 1u);
+    auto bar = move(foo);
+    EXPECT_EQ(bar.size(), 1u);
+    EXPECT_EQ(foo.size(), 0u);
+    EXPECT(!foo.contains(1));
+    foo = move(bar);
+    EXPECT_EQ(foo.size(), 1u);
+    EXPECT(foo.contains(1));
+}
+
+TEST_CASE(basic_copy)
+{
+    FlatHashTable<ByteString> strings;
+    strings.set("One");
+    strings.set("Two");
+
+    auto copy = strings;
+    strings.remove("One");
+    EXPECT_EQ(copy.size(), 2u);
+    EXPECT(copy.contains("One"));
+    EXPECT(copy.contains("Two"));
+}
+
+TEST_CASE(set_result)
+{
+    FlatHashTable<ByteString> strings;
+    EXPECT_EQ(strings.set("Apple"), HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.set("Apple"), HashSetResult::ReplacedExistingEntry);
+    EXPECT_EQ(strings.set("Apple", HashSetExistingEntryBehavior::Keep), HashSetResult::KeptExistingEntry);
+    EXPECT_EQ(strings.size(), 1u);
+}
+
+TEST_CASE(insert_and_remove_many)
+{
+    FlatHashTable<int> table;
+    for (int i = 0; i < 10'000; ++i)
+        EXPECT_EQ(table.set(i), HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(table.size(), 10'000u);
+
+    for (int i = 0; i < 10'000; i += 2)
+        EXPECT(table.remove(i));
+    EXPECT(!table.remove(0));
+    EXPECT_EQ(table.size(), 5'000u);
+
+    for (int i = 0; i < 10'000; ++i)
+        EXPECT_EQ(table.contains(i), i % 2 == 1);
+
+    size_t count = 0;
+    for (auto value : table) {
+        EXPECT_EQ(value % 2, 1);
+        ++count;
+    }
+    EXPECT_EQ(count, 5'000u);
+}
+
+TEST_CASE(deleted_slots_are_reused)
+{
+    FlatHashTable<int> table;
+    for (int i = 0; i < 1'000; ++i)
+        table.set(i);
+    auto capacity = table.capacity();
+
+    // Churning through values without ever having more of them at once shouldn't grow the table.
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 100; ++i)
+            table.set(1'000 + (round * 100) + i);
+        for (int i = 0; i < 100; ++i)
+            EXPECT(table.remove(1'000 + (round * 100) + i));
+    }
+    EXPECT_EQ(table.size(), 1'000u);
+    EXPECT_EQ(table.capacity(), capacity);
+
+    for (int i = 0; i < 1'000; ++i)
+        EXPECT(table.contains(i));
+}
+
+TEST_CASE(remove_while_iterating)
+{
+    FlatHashTable<int> table;
+    for (int i = 0; i < 100; ++i)
+        table.set(i);
+
+    // Removing the current value must not move any of the others.
+    for (auto it = table.begin(); it != table.end();) {
+        auto current = it;
+        ++it;
+        if (*current % 3 == 0)
+            table.remove(current);
+    }
+    EXPECT_EQ(table.size(), 66u);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(table.contains(i), i % 3 != 0);
+}
+
+TEST_CASE(remove_all_matching)
+{
+    FlatHashTable<int> table;
+    for (int i = 0; i < 100; ++i)
+        table.set(i);
+
+    EXPECT(table.remove_all_matching([](int value) { return value >= 50; }));
+    EXPECT(!table.remove_all_matching([](int value) { return value >= 50; }));
+    EXPECT_EQ(table.size(), 50u);
+
+    auto taken = table.take_all_matching([](int value) { return value < 10; });
+    EXPECT_EQ(taken.size(), 10u);
+    EXPECT_EQ(table.size(), 40u);
+}
+
+TEST_CASE(clear_with_capacity)
+{
+    FlatHashTable<int> table;
+    for (int i = 0; i < 100; ++i)
+        table.set(i);
+    auto capacity = table.capacity();
+
+    table.clear_with_capacity();
+    EXPECT(table.is_empty());
+    EXPECT_EQ(table.capacity(), capacity);
+    EXPECT(!table.contains(1));
+    EXPECT(table.begin() == table.end());
+
+    table.clear();
+    EXPECT_EQ(table.capacity(), 0u);
+}
+
+TEST_CASE(ensure_capacity)
+{
+    FlatHashTable<int> table;
+    table.ensure_capacity(1'000);
+    auto capacity = table.capacity();
+
+    for (int i = 0; i < 1'000; ++i)
+        table.set(i);
+    EXPECT_EQ(table.capacity(), capacity);
+}
+
+struct CollidingIntTraits : public DefaultTraits<int> {
+    static unsigned hash(int value) { return u32_hash(value) & 0xF; }
+};
+
+TEST_CASE(many_collisions)
+{
+    FlatHashTable<int, CollidingIntTraits> table;
+    for (int i = 0; i < 1'000; ++i)
+        table.set(i);
+    for (int i = 0; i < 1'000; i += 3)
+        table.remove(i);
+    for (int i = 1'000; i < 1'500; ++i)
+        table.set(i);
+
+    for (int i = 0; i < 1'500; ++i)
+        EXPECT_EQ(table.contains(i), i >= 1'000 || i % 3 != 0);
+}
+
+TEST_CASE(find_with_compatible_key)
+{
+    FlatHashTable<String> strings;
+    strings.set("Hello"_string);
+    EXPECT(strings.contains("Hello"sv));
+    EXPECT(!strings.contains("World"sv));
+    EXPECT(strings.remove("Hello"sv));
+    EXPECT(strings.is_empty());
+}
+
+TEST_CASE(map_populate_and_get)
+{
+    FlatHashMap<int, ByteString> number_to_string {
+        { 1, "One" },
+        { 2, "Two" },
+    };
+    number_to_string.set(3, "Three");
+
+    EXPECT_EQ(number_to_string.size(), 3u);
+    EXPECT_EQ(number_to_string.get(2).value(), "Two");
+    EXPECT(!number_to_string.get(4).has_value());
+
+    EXPECT_EQ(number_to_string.take(1).value(), "One");
+    EXPECT(!number_to_string.contains(1));
+    EXPECT_EQ(number_to_string.size(), 2u);
+}
+
+TEST_CASE(map_ensure)
+{
+    FlatHashMap<String, int> counts;
+    for (auto word : { "a"sv, "b"sv, "a"sv, "c"sv, "a"sv })
+        ++counts.ensure(MUST(String::from_utf8(word)));
+
+    EXPECT_EQ(counts.get("a"sv).value(), 3);
+    EXPECT_EQ(counts.get("b"sv).value(), 1);
+    EXPECT_EQ(counts.get("c"sv).value(), 1);
+
+    auto copy = MUST(counts.clone());
+    EXPECT(copy == counts);
+}
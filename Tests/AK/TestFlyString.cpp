@@ -9,6 +9,9 @@
 #include <AK/FlyString.h>
 #include <AK/String.h>
 #include <AK/Try.h>
+#include <AK/Utf16FlyString.h>
+#include <AK/Vector.h>
+#include <LibThreading/ThreadPool.h>
 
 TEST_CASE(empty_string)
 {
@@ -142,3 +145,37 @@ TEST_CASE(is_one_of)
     EXPECT(bar.is_one_of("bar"sv, "foo"sv));
     EXPECT(bar.is_one_of("bar"sv));
 }
+
+TEST_CASE(fly_strings_can_be_interned_from_many_threads)
+{
+    static constexpr size_t count = 10'000;
+    static constexpr size_t distinct_string_count = 16;
+
+    auto fly_string_count = FlyString::number_of_fly_strings();
+    auto utf16_fly_string_count = Utf16FlyString::number_of_utf16_fly_strings();
+
+    {
+        Vector<FlyString> fly_strings;
+        Vector<Utf16FlyString> utf16_fly_strings;
+        fly_strings.resize(count);
+        utf16_fly_strings.resize(count);
+
+        Threading::ThreadPool::the().parallel_for(count, [&](size_t i) {
+            auto string = MUST(String::formatted("a string that is too long to be stored inline #{}", i % distinct_string_count));
+            fly_strings[i] = FlyString { string };
+            utf16_fly_strings[i] = Utf16FlyString::from_utf8(string.bytes_as_string_view());
+        });
+
+        EXPECT_EQ(FlyString::number_of_fly_strings(), fly_string_count + distinct_string_count);
+        EXPECT_EQ(Utf16FlyString::number_of_utf16_fly_strings(), utf16_fly_string_count + distinct_string_count);
+
+        // Equal fly strings share their data no matter which thread interned them.
+        for (size_t i = distinct_string_count; i < count; ++i) {
+            EXPECT_EQ(fly_strings[i], fly_strings[i % distinct_string_count]);
+            EXPECT_EQ(utf16_fly_strings[i], utf16_fly_strings[i % distinct_string_count]);
+        }
+    }
+
+    EXPECT_EQ(FlyString::number_of_fly_strings(), fly_string_count);
+    EXPECT_EQ(Utf16FlyString::number_of_utf16_fly_strings(), utf16_fly_string_count);
+}
@@ -8,6 +8,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/ByteString.h>
+#include <AK/FlatHashTable.h>
 #include <AK/HashTable.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Vector.h>
@@ -741,3 +742,103 @@ BENCHMARK_CASE(high_collision_non_trivial)
             table.set(NonTrivialValue(i));
     }
 }
+
+// These compare HashTable with FlatHashTable on tables that are too large to fit in the cache.
+static constexpr int LARGE_TABLE_SIZE = 1'000'000;
+
+template<typename TableType>
+static void benchmark_insert()
+{
+    for (int iter = 0; iter < ITERATION_COUNT / 10; ++iter) {
+        TableType table;
+        for (int i = 0; i < LARGE_TABLE_SIZE; ++i)
+            table.set(i);
+    }
+}
+
+template<typename TableType>
+static void benchmark_lookup()
+{
+    TableType table;
+    for (int i = 0; i < LARGE_TABLE_SIZE; ++i)
+        table.set(i * 2);
+
+    size_t found_count = 0;
+    for (int iter = 0; iter < ITERATION_COUNT / 10; ++iter) {
+        for (int i = 0; i < LARGE_TABLE_SIZE; ++i)
+            found_count += table.contains(i);
+    }
+    taint_for_optimizer(found_count);
+    EXPECT_EQ(found_count, static_cast<size_t>(LARGE_TABLE_SIZE / 2 * (ITERATION_COUNT / 10)));
+}
+
+template<typename TableType>
+static void benchmark_iteration()
+{
+    TableType table;
+    for (int i = 0; i < LARGE_TABLE_SIZE; ++i)
+        table.set(i);
+
+    u64 sum = 0;
+    for (int iter = 0; iter < ITERATION_COUNT; ++iter) {
+        for (auto value : table)
+            sum += value;
+    }
+    taint_for_optimizer(sum);
+}
+
+BENCHMARK_CASE(large_insert_int)
+{
+    benchmark_insert<HashTable<int>>();
+}
+
+BENCHMARK_CASE(large_insert_int_flat)
+{
+    benchmark_insert<FlatHashTable<int>>();
+}
+
+BENCHMARK_CASE(large_lookup_int)
+{
+    benchmark_lookup<HashTable<int>>();
+}
+
+BENCHMARK_CASE(large_lookup_int_flat)
+{
+    benchmark_lookup<FlatHashTable<int>>();
+}
+
+BENCHMARK_CASE(large_iteration_int)
+{
+    benchmark_iteration<HashTable<int>>();
+}
+
+BENCHMARK_CASE(large_iteration_int_flat)
+{
+    benchmark_iteration<FlatHashTable<int>>();
+}
+
+BENCHMARK_CASE(insert_remove_int_flat)
+{
+    for (int iter = 0; iter < ITERATION_COUNT; ++iter) {
+        FlatHashTable<int> table;
+        for (int i = 0; i < 10'000; ++i)
+            table.set(i);
+        for (int i = 0; i < 10'000; i += 2)
+            table.remove(i);
+        for (int i = 10'000; i < 15'000; ++i)
+            table.set(i);
+    }
+}
+
+BENCHMARK_CASE(insert_remove_non_trivial_flat)
+{
+    for (int iter = 0; iter < ITERATION_COUNT; ++iter) {
+        FlatHashTable<NonTrivialValue> table;
+        for (int i = 0; i < 10'000; ++i)
+            table.set(NonTrivialValue(i));
+        for (int i = 0; i < 10'000; i += 2)
+            table.remove(NonTrivialValue(i));
+        for (int i = 10'000; i < 15'000; ++i)
+            table.set(NonTrivialValue(i));
+    }
+}
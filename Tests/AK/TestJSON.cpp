@@ -7,7 +7,11 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/JsonObject.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/JsonReader.h>
+#include <AK/JsonStreamWriter.h>
 #include <AK/JsonValue.h>
+#include <AK/MemoryStream.h>
 #include <AK/StringBuilder.h>
 
 TEST_CASE(load_form)
@@ -692,3 +696,177 @@ TEST_CASE(invalid_utf8)
     EXPECT(JsonValue::from_string("{\"key\": \"value\xff\xff\"}"sv).is_error());
     EXPECT(JsonValue::from_string("{\"key\xff\xff\": \"value\"}"sv).is_error());
 }
+
+static ErrorOr<void> read_all_tokens(StringView input)
+{
+    JsonReader reader { input };
+    while (TRY(reader.next()) != JsonReader::Token::EndOfInput)
+        ;
+    return {};
+}
+
+static ErrorOr<void> skip_all_values(StringView input)
+{
+    JsonReader reader { input };
+    TRY(reader.skip_value());
+    if (TRY(reader.next()) != JsonReader::Token::EndOfInput)
+        return Error::from_string_literal("Expected the end of the input");
+    return {};
+}
+
+TEST_CASE(json_reader_tokens)
+{
+    using Token = JsonReader::Token;
+
+    JsonReader reader { R"( { "a" : [ 1, "two", true, null ], "b": {} } )"sv };
+
+    EXPECT(MUST(reader.next()) == Token::ObjectStart);
+    EXPECT(MUST(reader.next()) == Token::Name);
+    EXPECT_EQ(reader.name(), "a"sv);
+    EXPECT(MUST(reader.next()) == Token::ArrayStart);
+    EXPECT_EQ(reader.depth(), 2uz);
+    EXPECT(MUST(reader.next()) == Token::Value);
+    EXPECT_EQ(reader.value().as_integer<u64>(), 1u);
+    EXPECT(MUST(reader.next()) == Token::Value);
+    EXPECT_EQ(reader.value().as_string(), "two"sv);
+    EXPECT(MUST(reader.next()) == Token::Value);
+    EXPECT_EQ(reader.value().as_bool(), true);
+    EXPECT(MUST(reader.next()) == Token::Value);
+    EXPECT(reader.value().is_null());
+    EXPECT(MUST(reader.next()) == Token::ArrayEnd);
+    EXPECT(MUST(reader.next()) == Token::Name);
+    EXPECT_EQ(reader.name(), "b"sv);
+    EXPECT(MUST(reader.next()) == Token::ObjectStart);
+    EXPECT(MUST(reader.next()) == Token::ObjectEnd);
+    EXPECT(MUST(reader.next()) == Token::ObjectEnd);
+    EXPECT_EQ(reader.depth(), 0uz);
+    EXPECT(MUST(reader.next()) == Token::EndOfInput);
+    EXPECT(MUST(reader.next()) == Token::EndOfInput);
+}
+
+TEST_CASE(json_reader_reads_and_skips_members)
+{
+    JsonReader reader { R"({"skipped": {"nested": ["\u00e9", [{}], -1.5e3]}, "id": {"value": 42}, "after": "\"x\""})"sv };
+
+    EXPECT(MUST(reader.next()) == JsonReader::Token::ObjectStart);
+
+    Optional<JsonValue> id;
+    size_t skipped_count = 0;
+    while (MUST(reader.next()) == JsonReader::Token::Name) {
+        if (reader.name() == "id"sv) {
+            id = MUST(reader.read_value());
+        } else {
+            MUST(reader.skip_value());
+            ++skipped_count;
+        }
+    }
+
+    EXPECT_EQ(skipped_count, 2uz);
+    EXPECT(id.has_value());
+    EXPECT_EQ(id->as_object().get_integer<u64>("value"sv), 42u);
+    EXPECT(MUST(reader.next()) == JsonReader::Token::EndOfInput);
+}
+
+TEST_CASE(json_reader_next_element)
+{
+    JsonReader reader { R"([{"a": 1}, 2, [3], "four"])"sv };
+
+    EXPECT(MUST(reader.next()) == JsonReader::Token::ArrayStart);
+
+    Vector<JsonValue> elements;
+    while (MUST(reader.next_element()))
+        elements.append(MUST(reader.read_value()));
+
+    EXPECT_EQ(elements.size(), 4uz);
+    EXPECT_EQ(elements[0].as_object().get_integer<u64>("a"sv), 1u);
+    EXPECT_EQ(elements[1].as_integer<u64>(), 2u);
+    EXPECT_EQ(elements[2].as_array().size(), 1uz);
+    EXPECT_EQ(elements[3].as_string(), "four"sv);
+    EXPECT(MUST(reader.next()) == JsonReader::Token::EndOfInput);
+
+    JsonReader empty_reader { "[ ]"sv };
+    EXPECT(MUST(empty_reader.next()) == JsonReader::Token::ArrayStart);
+    EXPECT(!MUST(empty_reader.next_element()));
+}
+
+TEST_CASE(json_reader_rejects_invalid_input)
+{
+    constexpr Array invalid_inputs {
+        ""sv,
+        "[1,]"sv,
+        "[,1]"sv,
+        "[1 2]"sv,
+        "{\"a\":1,}"sv,
+        "{\"a\" 1}"sv,
+        "{\"a\":1"sv,
+        "{1:1}"sv,
+        "[\"\\x\"]"sv,
+        "[\"a\x01\"]"sv,
+        "{\"key\": \"value\xcf\"}"sv,
+        "{\"key\xcf\": \"value\"}"sv,
+        "[\"unterminated]"sv,
+        "[01]"sv,
+        "[1]]"sv,
+        "1 2"sv,
+    };
+
+    for (auto input : invalid_inputs) {
+        EXPECT(read_all_tokens(input).is_error());
+        EXPECT(skip_all_values(input).is_error());
+    }
+
+    EXPECT(!read_all_tokens("[\"\\ud834\\udd1e\", {\"\\n\": [1e2, 0, -0]}]"sv).is_error());
+    EXPECT(!skip_all_values("[\"\\ud834\\udd1e\", {\"\\n\": [1e2, 0, -0]}]"sv).is_error());
+}
+
+TEST_CASE(json_reader_rejects_excessive_nesting_depth)
+{
+    StringBuilder input;
+    constexpr size_t nesting_depth = 4096;
+
+    input.append_repeated('[', nesting_depth);
+    input.append('0');
+    input.append_repeated(']', nesting_depth);
+
+    EXPECT(read_all_tokens(input.string_view()).is_error());
+    EXPECT(skip_all_values(input.string_view()).is_error());
+
+    // The depth that the reader is at counts towards the depth of values that are read as a whole.
+    JsonReader reader { input.string_view() };
+    for (size_t i = 0; i < 256; ++i)
+        EXPECT(MUST(reader.next()) == JsonReader::Token::ArrayStart);
+    EXPECT(reader.read_value().is_error());
+}
+
+TEST_CASE(json_stream_writer)
+{
+    AllocatingMemoryStream stream;
+    JsonStreamWriter writer { stream };
+
+    auto object = MUST(JsonObjectSerializer<JsonStreamWriter>::try_create(writer));
+    MUST(object.add("name"sv, "\"quoted\""sv));
+    MUST(object.add("count"sv, 3));
+
+    auto array = MUST(object.add_array("values"sv));
+    for (size_t i = 0; i < 20'000; ++i)
+        MUST(array.add(i));
+    MUST(array.finish());
+
+    JsonObject nested;
+    nested.set("nested"sv, true);
+    MUST(object.add("object"sv, JsonValue { move(nested) }));
+    MUST(object.finish());
+
+    // Most of the text is written before serializing is done, and the rest is written by flush().
+    EXPECT(stream.used_buffer_size() >= JsonStreamWriter::flush_threshold);
+    MUST(writer.flush());
+
+    auto bytes = MUST(stream.read_until_eof());
+    auto value = MUST(JsonValue::from_string(StringView { bytes }));
+
+    EXPECT_EQ(value.as_object().get_string("name"sv), "\"quoted\""sv);
+    EXPECT_EQ(value.as_object().get_integer<u64>("count"sv), 3u);
+    EXPECT_EQ(value.as_object().get_array("values"sv)->size(), 20'000uz);
+    EXPECT_EQ(value.as_object().get_array("values"sv)->at(19'999).as_integer<u64>(), 19'999u);
+    EXPECT_EQ(value.as_object().get_object("object"sv)->get_bool("nested"sv), true);
+}
@@ -5,32 +5,41 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/Math.h>
 #include <AK/Queue.h>
 #include <AK/Stream.h>
 #include <Compositor/CompositorState.h>
+#include <LibCore/EventLoop.h>
 #include <LibIPC/Decoder.h>
 #include <LibIPC/Encoder.h>
 #include <LibIPC/Message.h>
 #include <LibTest/TestCase.h>
+#include <LibWeb/Compositor/CompositorAnimation.h>
 #include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/ScrollState.h>
 
 struct TestWebContentClient final : public Compositor::CompositorStateWebContentClient {
     virtual void dispatch_mouse_event_to_web_content(u64, Web::MouseEvent const&) override { }
     virtual void request_rendering_update() override { }
+    virtual void did_finish_frame(Web::Compositor::FrameTiming const& frame_timing) override { finished_frames.append(frame_timing); }
+    virtual void did_vsync_tick() override { ++vsync_tick_count; }
+
+    Vector<Web::Compositor::FrameTiming> finished_frames;
+    size_t vsync_tick_count { 0 };
 };
 
-static NonnullRefPtr<Web::Painting::DisplayList> make_display_list(Web::Painting::AccumulatedVisualContextTree const& visual_context_tree, Optional<Gfx::Color> color, Optional<Gfx::Color> surface_clear_color = {})
+static NonnullRefPtr<Web::Painting::DisplayList> make_display_list(Web::Painting::AccumulatedVisualContextTree const& visual_context_tree, Optional<Gfx::Color> color, Optional<Gfx::Color> surface_clear_color = {}, Gfx::IntRect fill_rect = { 0, 0, 4, 4 }, Web::Painting::VisualContextIndex context_index = Web::Painting::VISUAL_VIEWPORT_NODE_INDEX)
 {
     ByteBuffer command_bytes;
     if (color.has_value()) {
-        auto command = Web::Painting::FillRect { { 0, 0, 4, 4 }, *color };
+        auto command = Web::Painting::FillRect { fill_rect, *color };
         auto payload = Web::Painting::display_list_object_bytes(command);
         auto record_size = sizeof(Web::Painting::DisplayListCommandHeader) + payload.size();
         auto payload_size = align_up_to(record_size, Web::Painting::DisplayList::command_alignment) - sizeof(Web::Painting::DisplayListCommandHeader);
         Web::Painting::DisplayListCommandHeader header {
             .type = Web::Painting::FillRect::command_type,
             .payload_size = static_cast<u32>(payload_size),
-            .context_index = Web::Painting::VISUAL_VIEWPORT_NODE_INDEX,
+            .context_index = context_index,
             .has_bounding_rect = true,
             .bounding_rect = command.rect,
         };
@@ -86,3 +95,225 @@ TEST_CASE(rasterization_clears_damaged_pixels_to_the_canvas_color_in_presentatio
     bitmap = context.latest_rendered_surface()->snapshot_bitmap();
     EXPECT_EQ(bitmap->get_pixel(0, 0), Gfx::Color::Transparent);
 }
+
+TEST_CASE(large_damage_is_rasterized_in_tiles_like_a_single_pass)
+{
+    TestWebContentClient client;
+    Web::Painting::CanvasSurfaceRegistry canvas_surface_registry;
+    Compositor::ContextState context { 0, client, canvas_surface_registry, false };
+    Web::Painting::DisplayListPlayerSkia display_list_player { RefPtr<Gfx::SkiaBackendContext> {} };
+    auto visual_context_tree = Web::Painting::AccumulatedVisualContextTree::create();
+    auto viewport_rect = Gfx::IntRect { 0, 0, 1000, 700 };
+
+    context.viewport_size_updated(viewport_rect.size(), Web::Compositor::WindowResizingInProgress::No);
+    auto publication = context.resize_backing_stores_if_needed({}, Compositor::BackingStoreManager::GpuSharing::Disallowed);
+    VERIFY(publication.has_value());
+
+    // The filled rect straddles tile boundaries, and the viewport is not a multiple of the tile size.
+    context.install_display_list_update(make_display_list(visual_context_tree, Gfx::Color::Red, Gfx::Color::Green, { 200, 200, 400, 400 }), visual_context_tree, {});
+    context.queue_present_frame({ viewport_rect, viewport_rect });
+    EXPECT(context.present_synchronously(display_list_player, nullptr));
+
+    auto bitmap = context.latest_rendered_surface()->snapshot_bitmap();
+    EXPECT_EQ(bitmap->get_pixel(0, 0), Gfx::Color::Green);
+    EXPECT_EQ(bitmap->get_pixel(199, 199), Gfx::Color::Green);
+    EXPECT_EQ(bitmap->get_pixel(200, 200), Gfx::Color::Red);
+    EXPECT_EQ(bitmap->get_pixel(511, 511), Gfx::Color::Red);
+    EXPECT_EQ(bitmap->get_pixel(512, 512), Gfx::Color::Red);
+    EXPECT_EQ(bitmap->get_pixel(599, 599), Gfx::Color::Red);
+    EXPECT_EQ(bitmap->get_pixel(600, 600), Gfx::Color::Green);
+    EXPECT_EQ(bitmap->get_pixel(999, 699), Gfx::Color::Green);
+}
+
+TEST_CASE(frame_replaced_before_presentation_is_reported_as_dropped)
+{
+    TestWebContentClient client;
+    Web::Painting::CanvasSurfaceRegistry canvas_surface_registry;
+    Compositor::ContextState context { 0, client, canvas_surface_registry, false };
+    Web::Painting::DisplayListPlayerSkia display_list_player { RefPtr<Gfx::SkiaBackendContext> {} };
+    auto visual_context_tree = Web::Painting::AccumulatedVisualContextTree::create();
+    auto viewport_rect = Gfx::IntRect { 0, 0, 4, 4 };
+
+    context.viewport_size_updated(viewport_rect.size(), Web::Compositor::WindowResizingInProgress::No);
+    auto publication = context.resize_backing_stores_if_needed({}, Compositor::BackingStoreManager::GpuSharing::Disallowed);
+    VERIFY(publication.has_value());
+    context.install_display_list_update(make_display_list(visual_context_tree, Gfx::Color::Red), visual_context_tree, {});
+
+    auto make_frame_timing = [](u64 frame_id) {
+        Web::Compositor::FrameTiming frame_timing;
+        frame_timing.frame_id = frame_id;
+        frame_timing.record(Web::Compositor::FrameTimingStage::CompositorReceive, MonotonicTime::now());
+        return frame_timing;
+    };
+    context.queue_present_frame({ viewport_rect, viewport_rect, make_frame_timing(1) });
+    context.queue_present_frame({ viewport_rect, viewport_rect, make_frame_timing(2) });
+
+    EXPECT_EQ(client.finished_frames.size(), 1u);
+    EXPECT_EQ(client.finished_frames[0].frame_id, 1u);
+    EXPECT(client.finished_frames[0].was_dropped);
+
+    EXPECT(context.present_synchronously(display_list_player, nullptr));
+    EXPECT_EQ(client.finished_frames.size(), 2u);
+    EXPECT_EQ(client.finished_frames[1].frame_id, 2u);
+    EXPECT(client.finished_frames[1].stage(Web::Compositor::FrameTimingStage::Raster).has_value());
+}
+
+TEST_CASE(clients_waiting_for_a_vsync_tick_are_ticked_once)
+{
+    Core::EventLoop event_loop;
+    auto compositor_state = Compositor::CompositorState::create({}, false);
+    TestWebContentClient first_client;
+    TestWebContentClient second_client;
+
+    compositor_state->request_vsync_tick(first_client, 1000.0);
+    compositor_state->request_vsync_tick(first_client, 1000.0);
+    compositor_state->request_vsync_tick(second_client, 1000.0);
+
+    while (first_client.vsync_tick_count == 0)
+        event_loop.pump();
+
+    EXPECT_EQ(first_client.vsync_tick_count, 1u);
+    EXPECT_EQ(second_client.vsync_tick_count, 1u);
+}
+
+// Fades from 0.2 to 0.6 opacity over one second, and holds 0.6 afterwards. The underlying opacity is 1.
+static Web::Compositor::CompositorAnimation make_opacity_animation(Web::Painting::VisualContextIndex node_index)
+{
+    return {
+        .id = 1,
+        .node_index = node_index,
+        .property = Web::Compositor::CompositorAnimation::Property::Opacity,
+        .iteration_duration = 1000,
+        .fills_forwards = true,
+        .opacity_samples = { 0.2f, 0.6f, 1.0f },
+    };
+}
+
+static void expect_presented_opacity(Compositor::ContextState& context, Web::Painting::DisplayListPlayerSkia& display_list_player, Gfx::IntRect viewport_rect, float opacity)
+{
+    context.queue_present_frame({ viewport_rect, viewport_rect });
+    EXPECT(context.present_synchronously(display_list_player, nullptr));
+
+    // The white fill is composited over a transparent canvas, so its alpha is the animated opacity.
+    auto bitmap = context.latest_rendered_surface()->snapshot_bitmap();
+    auto expected_alpha = round_to<int>(opacity * 255.0f);
+    auto alpha = static_cast<int>(bitmap->get_pixel(0, 0).alpha());
+    EXPECT(abs(alpha - expected_alpha) <= 2);
+}
+
+TEST_CASE(time_based_animation_is_sampled_at_the_time_of_the_frame)
+{
+    TestWebContentClient client;
+    Web::Painting::CanvasSurfaceRegistry canvas_surface_registry;
+    Compositor::ContextState context { 0, client, canvas_surface_registry, false };
+    Web::Painting::DisplayListPlayerSkia display_list_player { RefPtr<Gfx::SkiaBackendContext> {} };
+    auto visual_context_tree = Web::Painting::AccumulatedVisualContextTree::create();
+    auto effects_index = visual_context_tree.append(Web::Painting::EffectsData {}, Web::Painting::VISUAL_VIEWPORT_NODE_INDEX);
+    auto viewport_rect = Gfx::IntRect { 0, 0, 4, 4 };
+
+    context.viewport_size_updated(viewport_rect.size(), Web::Compositor::WindowResizingInProgress::No);
+    auto publication = context.resize_backing_stores_if_needed({}, Compositor::BackingStoreManager::GpuSharing::Disallowed);
+    VERIFY(publication.has_value());
+    context.install_display_list_update(make_display_list(visual_context_tree, Gfx::Color::White, {}, viewport_rect, effects_index), visual_context_tree, {});
+
+    // Sent 100ms into the effect, playing at twice the speed.
+    auto animation = make_opacity_animation(effects_index);
+    animation.local_time = 100;
+    animation.playback_rate = 2;
+    Vector<Web::Compositor::CompositorAnimation> animations;
+    animations.append(move(animation));
+    context.update_compositor_animations(visual_context_tree.version(), move(animations));
+    auto received_at = MonotonicTime::now();
+    EXPECT(context.has_active_compositor_animations());
+
+    // 250ms later, the local time is 100ms + 2 * 250ms, which is 60% of the way through the fade.
+    context.advance_compositor_animations(received_at + AK::Duration::from_milliseconds(250));
+    EXPECT(context.has_active_compositor_animations());
+    expect_presented_opacity(context, display_list_player, viewport_rect, 0.44f);
+
+    // Past the end of the effect, the final value is held and the animation no longer needs vsync ticks.
+    context.advance_compositor_animations(received_at + AK::Duration::from_seconds(10));
+    EXPECT(!context.has_active_compositor_animations());
+    expect_presented_opacity(context, display_list_player, viewport_rect, 0.6f);
+}
+
+TEST_CASE(scroll_driven_animation_is_sampled_at_the_scroll_offset)
+{
+    TestWebContentClient client;
+    Web::Painting::CanvasSurfaceRegistry canvas_surface_registry;
+    Compositor::ContextState context { 0, client, canvas_surface_registry, false };
+    Web::Painting::DisplayListPlayerSkia display_list_player { RefPtr<Gfx::SkiaBackendContext> {} };
+    auto visual_context_tree = Web::Painting::AccumulatedVisualContextTree::create();
+    auto effects_index = visual_context_tree.append(Web::Painting::EffectsData {}, Web::Painting::VISUAL_VIEWPORT_NODE_INDEX);
+    auto scroll_index = visual_context_tree.append(Web::Painting::ScrollData {}, Web::Painting::VISUAL_VIEWPORT_NODE_INDEX);
+    auto viewport_rect = Gfx::IntRect { 0, 0, 4, 4 };
+
+    // Scroll nodes store the offset that they apply to their contents, which is the negated scroll offset.
+    auto scroll_state_at = [&](float scroll_offset) {
+        Web::Painting::ScrollStateSnapshot snapshot;
+        snapshot.set_device_offset_for_index(scroll_index, { 0, -scroll_offset });
+        return snapshot;
+    };
+
+    context.viewport_size_updated(viewport_rect.size(), Web::Compositor::WindowResizingInProgress::No);
+    auto publication = context.resize_backing_stores_if_needed({}, Compositor::BackingStoreManager::GpuSharing::Disallowed);
+    VERIFY(publication.has_value());
+    context.install_display_list_update(make_display_list(visual_context_tree, Gfx::Color::White, {}, viewport_rect, effects_index), visual_context_tree, scroll_state_at(20));
+
+    // Sent while the scroll node was at 10% of its 200px range, with the effect spanning the whole timeline.
+    auto animation = make_opacity_animation(effects_index);
+    animation.local_time = 10;
+    animation.iteration_duration = 100;
+    animation.scroll_timeline = Web::Compositor::CompositorAnimation::ScrollTimelineSource {
+        .scroll_node_index = scroll_index,
+        .is_vertical = true,
+        .scroll_range = 200,
+        .current_time = 10,
+    };
+    Vector<Web::Compositor::CompositorAnimation> animations;
+    animations.append(move(animation));
+    context.update_compositor_animations(visual_context_tree.version(), move(animations));
+
+    // Scroll-driven animations are only sampled when a frame is presented, never on vsync ticks.
+    EXPECT(!context.has_active_compositor_animations());
+    expect_presented_opacity(context, display_list_player, viewport_rect, 0.24f);
+
+    // Time passing has no effect on the sampled value.
+    context.advance_compositor_animations(MonotonicTime::now() + AK::Duration::from_seconds(10));
+    expect_presented_opacity(context, display_list_player, viewport_rect, 0.24f);
+
+    context.update_scroll_state(scroll_state_at(150));
+    expect_presented_opacity(context, display_list_player, viewport_rect, 0.5f);
+
+    context.update_scroll_state(scroll_state_at(400));
+    expect_presented_opacity(context, display_list_player, viewport_rect, 0.6f);
+}
+
+TEST_CASE(animation_on_a_scroll_timeline_without_a_scroll_range_is_rejected)
+{
+    auto round_trip = [](float scroll_range) {
+        auto animation = make_opacity_animation(Web::Painting::VisualContextIndex { 1 });
+        animation.scroll_timeline = Web::Compositor::CompositorAnimation::ScrollTimelineSource {
+            .scroll_node_index = Web::Painting::VisualContextIndex { 2 },
+            .scroll_range = scroll_range,
+        };
+
+        IPC::MessageBuffer buffer;
+        IPC::Encoder encoder { buffer };
+        MUST(encoder.encode(animation));
+
+        FixedMemoryStream stream { buffer.data().span() };
+        Queue<IPC::Attachment> attachments;
+        IPC::Decoder decoder { stream, attachments };
+        return decoder.decode<Web::Compositor::CompositorAnimation>();
+    };
+
+    auto animation = round_trip(200);
+    EXPECT(!animation.is_error());
+    EXPECT_EQ(animation.value().scroll_timeline->scroll_range, 200.0f);
+
+    EXPECT(round_trip(0).is_error());
+    EXPECT(round_trip(-200).is_error());
+    EXPECT(round_trip(NAN).is_error());
+    EXPECT(round_trip(INFINITY).is_error());
+}
@@ -87,3 +87,31 @@ TEST_CASE(reconstruct_from_anon_fd_shares_memory)
     StringView mirrored { mirror.data<char const>(), payload.length() };
     EXPECT_EQ(mirrored, payload);
 }
+
+TEST_CASE(sealed_buffer_keeps_contents_and_refuses_changes)
+{
+    if constexpr (!Core::AnonymousBuffer::supports_sealing)
+        return;
+
+    auto original = MUST(Core::AnonymousBuffer::create_with_size(128));
+    EXPECT(!original.is_sealed());
+
+    auto const payload = "frozen in place"sv;
+    memcpy(original.data<void>(), payload.characters_without_null_termination(), payload.length());
+    MUST(original.seal());
+    EXPECT(original.is_sealed());
+    EXPECT_EQ((StringView { original.data<char const>(), payload.length() }), payload);
+
+    EXPECT(Core::System::ftruncate(original.fd(), 0).is_error());
+
+    auto mirror = MUST(Core::AnonymousBuffer::create_from_anon_fd(MUST(Core::System::dup(original.fd())), original.size()));
+    EXPECT(mirror.is_sealed());
+    EXPECT_EQ((StringView { mirror.data<char const>(), payload.length() }), payload);
+
+    // A sealed buffer that is smaller than claimed would fault on access past its end.
+    auto fd = MUST(Core::System::dup(original.fd()));
+    auto oversized = Core::AnonymousBuffer::create_from_anon_fd(fd, 2 * PAGE_SIZE);
+    EXPECT(oversized.is_error());
+    if (oversized.is_error())
+        MUST(Core::System::close(fd));
+}
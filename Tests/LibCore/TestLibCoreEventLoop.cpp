@@ -5,9 +5,12 @@
  */
 
 #include <AK/OwnPtr.h>
+#include <AK/ScopeGuard.h>
 #include <AK/Time.h>
 #include <AK/Vector.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/System.h>
 #include <LibCore/Timer.h>
 #include <LibTest/TestCase.h>
 #include <LibThreading/Thread.h>
@@ -125,3 +128,61 @@ TEST_CASE(stopped_timer_does_not_fire)
     loop.exec();
     EXPECT_EQ(stopped_count, 0);
 }
+
+// NB: Windows has its own event loop implementation, and no pipe2().
+#if !defined(AK_OS_WINDOWS)
+TEST_CASE(notifiers_can_be_added_and_removed_during_dispatch)
+{
+    Core::EventLoop loop;
+
+    auto first_pipe = MUST(Core::System::pipe2(O_CLOEXEC));
+    auto second_pipe = MUST(Core::System::pipe2(O_CLOEXEC));
+    ScopeGuard close_pipes = [&] {
+        for (auto fd : first_pipe)
+            (void)Core::System::close(fd);
+        for (auto fd : second_pipe)
+            (void)Core::System::close(fd);
+    };
+
+    // Both read ends stay readable from here on, since nothing ever drains them.
+    MUST(Core::System::write(first_pipe[1], "x"sv.bytes()));
+    MUST(Core::System::write(second_pipe[1], "x"sv.bytes()));
+
+    int first_count = 0;
+    int second_count = 0;
+    RefPtr<Core::Notifier> second_notifier;
+
+    auto first_notifier = Core::Notifier::construct(first_pipe[0], Core::Notifier::Type::Read);
+    first_notifier->on_activation = [&] {
+        ++first_count;
+        first_notifier->set_enabled(false);
+
+        second_notifier = Core::Notifier::construct(second_pipe[0], Core::Notifier::Type::Read);
+        second_notifier->on_activation = [&] {
+            ++second_count;
+            second_notifier->set_enabled(false);
+            loop.quit(0);
+        };
+    };
+
+    auto quit_timer = Core::Timer::create_single_shot(1000, [&] { loop.quit(1); });
+    quit_timer->start();
+    EXPECT_EQ(loop.exec(), 0);
+
+    // Neither descriptor has a notifier anymore, so they must not be reported again although they are still readable.
+    for (int i = 0; i < 4; ++i)
+        loop.pump(Core::EventLoop::WaitMode::PollForEvents);
+    EXPECT_EQ(first_count, 1);
+    EXPECT_EQ(second_count, 1);
+
+    // Re-enabling a notifier registers its descriptor again.
+    first_notifier->on_activation = [&] {
+        ++first_count;
+        first_notifier->set_enabled(false);
+        loop.quit(0);
+    };
+    first_notifier->set_enabled(true);
+    EXPECT_EQ(loop.exec(), 0);
+    EXPECT_EQ(first_count, 2);
+}
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/TimeoutSet.h>
+#include <LibTest/TestCase.h>
+
+using namespace AK::TimeLiterals;
+
+namespace {
+
+class TestTimeout final : public Core::EventLoopTimeout {
+public:
+    TestTimeout(int id, Vector<int>& fired, MonotonicTime fire_time)
+        : m_id(id)
+        , m_fired(fired)
+    {
+        m_fire_time = fire_time;
+    }
+
+    virtual ~TestTimeout() override = default;
+
+    virtual void fire(Core::TimeoutSet&, MonotonicTime) override { m_fired.append(m_id); }
+
+private:
+    int m_id { 0 };
+    Vector<int>& m_fired;
+};
+
+}
+
+TEST_CASE(timeouts_fire_in_deadline_order)
+{
+    auto start = MonotonicTime::now_coarse();
+    Vector<int> fired;
+    Core::TimeoutSet set;
+
+    TestTimeout late(1, fired, start + 30_ms);
+    TestTimeout early(2, fired, start + 10_ms);
+    TestTimeout same_as_late(3, fired, start + 30_ms);
+    set.schedule_absolute(&late);
+    set.schedule_absolute(&early);
+    set.schedule_absolute(&same_as_late);
+
+    EXPECT_EQ(set.next_timer_expiration(), start + 10_ms);
+    EXPECT_EQ(set.fire_expired(start + 9_ms), 0u);
+
+    EXPECT_EQ(set.fire_expired(start + 30_ms), 3u);
+    EXPECT_EQ(fired, (Vector<int> { 2, 1, 3 }));
+    EXPECT(!set.next_timer_expiration().has_value());
+}
+
+TEST_CASE(unscheduled_timeouts_do_not_fire)
+{
+    auto start = MonotonicTime::now_coarse();
+    Vector<int> fired;
+    Core::TimeoutSet set;
+
+    TestTimeout first(1, fired, start + 5_ms);
+    TestTimeout second(2, fired, start + 500_ms);
+    set.schedule_absolute(&first);
+    set.schedule_absolute(&second);
+    set.unschedule(&first);
+    EXPECT(!first.is_scheduled());
+
+    EXPECT_EQ(set.next_timer_expiration(), start + 500_ms);
+    EXPECT_EQ(set.fire_expired(start + 1000_ms), 1u);
+    EXPECT_EQ(fired, (Vector<int> { 2 }));
+}
+
+TEST_CASE(far_timeouts_cascade_down_and_fire_on_time)
+{
+    auto start = MonotonicTime::now_coarse();
+    Vector<int> fired;
+    Core::TimeoutSet set;
+
+    // One per wheel level, plus one beyond the end of the wheel.
+    TestTimeout level_0(0, fired, start + 20_ms);
+    TestTimeout level_1(1, fired, start + AK::Duration::from_seconds(2));
+    TestTimeout level_2(2, fired, start + AK::Duration::from_seconds(200));
+    TestTimeout level_3(3, fired, start + AK::Duration::from_seconds(2 * 60 * 60));
+    TestTimeout overflow(4, fired, start + AK::Duration::from_seconds(10 * 60 * 60));
+    for (auto* timeout : { &overflow, &level_3, &level_2, &level_1, &level_0 })
+        set.schedule_absolute(timeout);
+
+    for (auto* timeout : { &level_0, &level_1, &level_2, &level_3, &overflow }) {
+        EXPECT_EQ(set.next_timer_expiration(), timeout->fire_time());
+        EXPECT_EQ(set.fire_expired(timeout->fire_time() - 1_ms), 0u);
+        EXPECT_EQ(set.fire_expired(timeout->fire_time()), 1u);
+    }
+
+    EXPECT_EQ(fired, (Vector<int> { 0, 1, 2, 3, 4 }));
+}
+
+TEST_CASE(tolerant_timeouts_are_coalesced)
+{
+    auto start = MonotonicTime::now_coarse();
+    Vector<int> fired;
+    Core::TimeoutSet set;
+
+    TestTimeout first(1, fired, start + 1000_ms);
+    TestTimeout second(2, fired, start + 1001_ms);
+    first.set_tolerance(250_ms);
+    second.set_tolerance(250_ms);
+    set.schedule_absolute(&first);
+    set.schedule_absolute(&second);
+
+    for (auto* timeout : { &first, &second }) {
+        EXPECT(timeout->deadline() >= timeout->fire_time());
+        EXPECT(timeout->deadline() - timeout->fire_time() <= timeout->tolerance());
+    }
+
+    // Nothing may fire early.
+    EXPECT_EQ(set.fire_expired(start + 999_ms), 0u);
+    EXPECT_EQ(set.fire_expired(start + 1250_ms), 2u);
+}
+
+TEST_CASE(default_timer_tolerance_keeps_short_timers_exact)
+{
+    EXPECT_EQ(Core::default_timer_tolerance(0_ms), AK::Duration::zero());
+    EXPECT(Core::default_timer_tolerance(16_ms) < 2_ms);
+    EXPECT(Core::default_timer_tolerance(AK::Duration::from_seconds(3600)) <= AK::Duration::from_seconds(1));
+}
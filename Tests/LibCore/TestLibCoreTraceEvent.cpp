@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/TraceEvent.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+
+using Core::TraceCategory;
+using Core::TraceEvents;
+
+static JsonValue collect_trace()
+{
+    return MUST(JsonValue::from_string(TraceEvents::to_trace_event_json("TestLibCoreTraceEvent"sv)));
+}
+
+// The complete events of the thread with the given name, which every test picks so that it is unique to that test.
+static Vector<JsonObject> events_of_thread(JsonValue const& trace, StringView thread_name)
+{
+    auto const& events = *trace.as_object().get_array("traceEvents"sv);
+
+    Optional<u64> thread_index;
+    for (auto const& value : events.values()) {
+        auto const& event = value.as_object();
+        if (event.get_string("ph"sv) == "M"sv && event.get_string("name"sv) == "thread_name"sv && event.get_object("args"sv)->get_string("name"sv) == thread_name)
+            thread_index = event.get_u64("tid"sv);
+    }
+    if (!thread_index.has_value())
+        return {};
+
+    Vector<JsonObject> thread_events;
+    for (auto const& value : events.values()) {
+        auto const& event = value.as_object();
+        if (event.get_string("ph"sv) == "X"sv && event.get_u64("tid"sv) == thread_index)
+            thread_events.append(event);
+    }
+    return thread_events;
+}
+
+static void record_events(size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        auto now = MonotonicTime::now();
+        TraceEvents::record(TraceCategory::EventLoop, "event"sv, now, now);
+    }
+}
+
+template<typename Callback>
+static void run_on_thread(StringView thread_name, Callback callback)
+{
+    auto thread = Threading::Thread::construct(thread_name, [&callback]() -> intptr_t {
+        callback();
+        return 0;
+    });
+    thread->start();
+    MUST(thread->join());
+}
+
+TEST_CASE(parse_trace_categories)
+{
+    EXPECT_EQ(Core::trace_categories_from_string("all"sv), TraceCategory::All);
+    EXPECT_EQ(Core::trace_categories_from_string("layout"sv), TraceCategory::Layout);
+    EXPECT_EQ(Core::trace_categories_from_string("layout,paint"sv), TraceCategory::Layout | TraceCategory::Paint);
+    EXPECT_EQ(Core::trace_categories_from_string(" gc , event-loop "sv), TraceCategory::GC | TraceCategory::EventLoop);
+    EXPECT_EQ(Core::trace_categories_from_string(""sv), TraceCategory::None);
+
+    EXPECT(!Core::trace_categories_from_string("layout,bogus"sv).has_value());
+    EXPECT(!Core::trace_categories_from_string("Layout"sv).has_value());
+    EXPECT(!Core::trace_categories_from_string("all,layout"sv).has_value());
+}
+
+TEST_CASE(trace_categories_round_trip)
+{
+    EXPECT_EQ(Core::trace_categories_to_string(TraceCategory::Layout | TraceCategory::Paint), "layout,paint"sv);
+    EXPECT_EQ(Core::trace_categories_to_string(TraceCategory::None), ""sv);
+    EXPECT_EQ(Core::trace_categories_from_string(Core::trace_categories_to_string(TraceCategory::All)), TraceCategory::All);
+}
+
+TEST_CASE(trace_holds_the_events_of_enabled_categories)
+{
+    TraceEvents::set_current_thread_name("TestRecordingThread"sv);
+
+    auto start_time = MonotonicTime::now();
+    TraceEvents::set_enabled_categories(TraceCategory::Layout);
+    {
+        TRACE_EVENT(Layout, "enabled"sv);
+        TRACE_EVENT(Paint, "disabled"sv);
+    }
+    TraceEvents::set_enabled_categories(TraceCategory::None);
+    TraceEvents::record(TraceCategory::Raster, "timed"sv, start_time, start_time + AK::Duration::from_microseconds(1500));
+
+    auto trace = collect_trace();
+    EXPECT_EQ(trace.as_object().get_string("displayTimeUnit"sv), "ms"sv);
+
+    auto const& first_event = trace.as_object().get_array("traceEvents"sv)->at(0).as_object();
+    EXPECT_EQ(first_event.get_string("name"sv), "process_name"sv);
+    EXPECT_EQ(first_event.get_object("args"sv)->get_string("name"sv), "TestLibCoreTraceEvent"sv);
+
+    auto events = events_of_thread(trace, "TestRecordingThread"sv);
+    VERIFY(events.size() == 2);
+
+    EXPECT_EQ(events[0].get_string("name"sv), "enabled"sv);
+    EXPECT_EQ(events[0].get_string("cat"sv), "layout"sv);
+
+    EXPECT_EQ(events[1].get_string("name"sv), "timed"sv);
+    EXPECT_EQ(events[1].get_string("cat"sv), "raster"sv);
+    EXPECT_APPROXIMATE_WITH_ERROR(events[1].get_double_with_precision_loss("ts"sv).value(), static_cast<double>(start_time.nanoseconds()) / 1000.0, 0.001);
+    EXPECT_APPROXIMATE(events[1].get_double_with_precision_loss("dur"sv).value(), 1500.0);
+}
+
+TEST_CASE(trace_holds_the_events_of_exited_threads)
+{
+    run_on_thread("TestExitedThread"sv, [] { record_events(3); });
+
+    EXPECT_EQ(events_of_thread(collect_trace(), "TestExitedThread"sv).size(), 3u);
+}
+
+TEST_CASE(exited_threads_keep_a_bounded_number_of_events)
+{
+    constexpr auto max_events = TraceEvents::max_recorded_events_per_thread;
+
+    // Every thread that exits makes room for its events by dropping the threads that exited before it.
+    run_on_thread("TestRetiredThread1"sv, [] { record_events(max_events / 2); });
+    run_on_thread("TestRetiredThread2"sv, [] { record_events(max_events / 2); });
+
+    auto trace = collect_trace();
+    EXPECT_EQ(events_of_thread(trace, "TestRetiredThread1"sv).size(), max_events / 2);
+    EXPECT_EQ(events_of_thread(trace, "TestRetiredThread2"sv).size(), max_events / 2);
+
+    run_on_thread("TestRetiredThread3"sv, [] { record_events(1); });
+
+    trace = collect_trace();
+    EXPECT(events_of_thread(trace, "TestRetiredThread1"sv).is_empty());
+    EXPECT_EQ(events_of_thread(trace, "TestRetiredThread2"sv).size(), max_events / 2);
+    EXPECT_EQ(events_of_thread(trace, "TestRetiredThread3"sv).size(), 1u);
+
+    // The most recent events of a thread that filled its buffer are kept on their own.
+    run_on_thread("TestRetiredThread4"sv, [] { record_events(max_events + 10); });
+
+    trace = collect_trace();
+    EXPECT(events_of_thread(trace, "TestRetiredThread2"sv).is_empty());
+    EXPECT(events_of_thread(trace, "TestRetiredThread3"sv).is_empty());
+    EXPECT_EQ(events_of_thread(trace, "TestRetiredThread4"sv).size(), max_events);
+}
+
+TEST_CASE(merge_trace_event_json)
+{
+    Array traces {
+        R"({"traceEvents": [{"name": "first", "ph": "X", "pid": 1}, {"name": "second", "ph": "X", "pid": 1}], "displayTimeUnit": "ms"})"_string,
+        "not json"_string,
+        R"({"displayTimeUnit": "ms"})"_string,
+        R"({"traceEvents": [{"name": "third", "ph": "X", "pid": 2}]})"_string,
+    };
+
+    auto merged = MUST(JsonValue::from_string(TraceEvents::merge_trace_event_json(traces.span())));
+    EXPECT_EQ(merged.as_object().get_string("displayTimeUnit"sv), "ms"sv);
+
+    auto const& events = *merged.as_object().get_array("traceEvents"sv);
+    VERIFY(events.size() == 3);
+    EXPECT_EQ(events.at(0).as_object().get_string("name"sv), "first"sv);
+    EXPECT_EQ(events.at(1).as_object().get_string("name"sv), "second"sv);
+    EXPECT_EQ(events.at(2).as_object().get_string("name"sv), "third"sv);
+    EXPECT_EQ(events.at(2).as_object().get_u64("pid"sv), 2u);
+}
@@ -11,6 +11,7 @@
 #include <AK/MemoryStream.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
 #include <LibCore/TCPServer.h>
 #include <LibCore/UDPServer.h>
 #include <LibDNS/Resolver.h>
@@ -23,7 +24,7 @@ namespace {
 // Builds a canned DNS response for a query: It echoes the question section and answers with one fixed A and one fixed
 // AAAA record. The resolver correlates responses to lookups by header ID, and reads the answer section. Enough to drive
 // a successful lookup while exercising the real wire encode and decode paths — without depending on a live DNS server.
-ErrorOr<ByteBuffer> build_dns_response(ReadonlyBytes query_bytes)
+ErrorOr<ByteBuffer> build_dns_response(ReadonlyBytes query_bytes, u32 ttl = 300, IPv4Address address = { 192, 0, 2, 1 })
 {
     FixedMemoryStream stream { query_bytes };
     auto query = TRY(DNS::Messages::Message::from_raw(stream));
@@ -40,10 +41,10 @@ ErrorOr<ByteBuffer> build_dns_response(ReadonlyBytes query_bytes)
         : response.questions.first().name;
 
     response.answers.append(DNS::Messages::ResourceRecord {
-        name, DNS::Messages::ResourceType::A, DNS::Messages::Class::IN, 300,
-        DNS::Messages::Records::A { IPv4Address { 192, 0, 2, 1 } }, {} });
+        name, DNS::Messages::ResourceType::A, DNS::Messages::Class::IN, ttl,
+        DNS::Messages::Records::A { address }, {} });
     response.answers.append(DNS::Messages::ResourceRecord {
-        name, DNS::Messages::ResourceType::AAAA, DNS::Messages::Class::IN, 300,
+        name, DNS::Messages::ResourceType::AAAA, DNS::Messages::Class::IN, ttl,
         DNS::Messages::Records::AAAA { IPv6Address::loopback() }, {} });
     response.header.answer_count = response.answers.size();
 
@@ -99,6 +100,64 @@ TEST_CASE(test_udp)
     expect_successful_lookup(resolver, loop);
 }
 
+TEST_CASE(test_expired_answer_is_served_stale_while_revalidating)
+{
+    Core::EventLoop loop;
+
+    auto server = Core::UDPServer::construct();
+    EXPECT(server->bind(IPv4Address { 127, 0, 0, 1 }, 0));
+    auto server_port = server->local_port().value();
+
+    // Every answer expires after a second, and each query is answered with a different address.
+    u8 query_count = 0;
+    server->on_ready_to_receive = [&] {
+        sockaddr_in from {};
+        auto query = MUST(server->receive(4096, from));
+        ++query_count;
+        auto response = MUST(build_dns_response(query.bytes(), 1, IPv4Address { 192, 0, 2, query_count }));
+        MUST(server->send(response.bytes(), from));
+    };
+
+    DNS::Resolver resolver {
+        [server_port] -> ErrorOr<DNS::Resolver::SocketResult> {
+            Core::SocketAddress address { IPv4Address { 127, 0, 0, 1 }, server_port };
+            return DNS::Resolver::SocketResult {
+                TRY(Core::BufferedSocket<Core::UDPSocket>::create(TRY(Core::UDPSocket::connect(address)))),
+                DNS::Resolver::ConnectionMode::UDP,
+            };
+        }
+    };
+
+    TRY_OR_FAIL(resolver.when_socket_ready()->await());
+
+    auto lookup_address = [&] {
+        Optional<IPv4Address> address;
+        resolver.lookup("example.com", DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA })
+            ->when_resolved([&](auto& result) {
+                address = result->template record<DNS::Messages::Records::A>().address;
+                loop.quit(0);
+            })
+            .when_rejected([&](auto& error) {
+                outln("Failed to resolve: {}", error);
+                loop.quit(1);
+            });
+        EXPECT_EQ(0, loop.exec());
+        return address;
+    };
+
+    EXPECT_EQ(lookup_address(), IPv4Address(192, 0, 2, 1));
+    EXPECT_EQ(query_count, 1);
+
+    MUST(Core::System::sleep_ms(1100));
+
+    // The expired answer is served without waiting for the server, which is queried again in the background.
+    EXPECT_EQ(lookup_address(), IPv4Address(192, 0, 2, 1));
+
+    loop.spin_until([&] { return !resolver.lookup_in_cache("example.com"sv).is_null(); });
+    EXPECT_EQ(query_count, 2);
+    EXPECT_EQ(lookup_address(), IPv4Address(192, 0, 2, 2));
+}
+
 TEST_CASE(test_tcp)
 {
     Core::EventLoop loop;
@@ -4,6 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Random.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/Directory.h>
+#include <LibCore/StandardPaths.h>
+#include <LibFileSystem/FileSystem.h>
 #include <LibTest/TestCase.h>
 #include <Libraries/LibDatabase/Database.h>
 
@@ -111,3 +116,42 @@ TEST_CASE(busy_timeout_can_be_configured)
     });
     EXPECT_EQ(busy_timeout, 250);
 }
+
+TEST_CASE(writes_survive_background_checkpoints)
+{
+    auto database_directory = ByteString::formatted(
+        "{}/ladybird-database-test-{}",
+        Core::StandardPaths::tempfile_directory(),
+        generate_random_uuid());
+
+    auto cleanup = ScopeGuard([&] {
+        MUST(FileSystem::remove(database_directory, FileSystem::RecursionMode::Allowed));
+    });
+
+    // Each row is larger than a page, so the write-ahead log grows past the checkpoint threshold many times over.
+    static constexpr size_t row_count = 4000;
+    auto value = MUST(String::repeated('x', 8 * KiB));
+
+    {
+        auto database = TRY_OR_FAIL(Database::Database::create(database_directory, "Checkpoints"sv));
+        TRY_OR_FAIL(database->execute_raw("CREATE TABLE Rows (id INTEGER PRIMARY KEY, value TEXT);"));
+
+        auto insert_row = TRY_OR_FAIL(database->prepare_statement("INSERT INTO Rows VALUES (?, ?);"sv));
+        for (size_t i = 0; i < row_count; ++i)
+            database->execute_statement(insert_row, {}, i, value);
+
+        database->wait_for_background_checkpoint();
+    }
+
+    auto database = TRY_OR_FAIL(Database::Database::create(database_directory, "Checkpoints"sv));
+    auto count_rows = TRY_OR_FAIL(database->prepare_statement("SELECT COUNT(*), MIN(LENGTH(value)) FROM Rows;"sv));
+
+    size_t count = 0;
+    size_t minimum_length = 0;
+    database->execute_statement(count_rows, [&](auto statement_id) {
+        count = database->result_column<size_t>(statement_id, 0);
+        minimum_length = database->result_column<size_t>(statement_id, 1);
+    });
+    EXPECT_EQ(count, row_count);
+    EXPECT_EQ(minimum_length, value.bytes().size());
+}
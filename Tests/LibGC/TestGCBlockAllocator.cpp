@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <AK/Vector.h>
+#include <LibGC/BlockAllocator.h>
+#include <LibGC/HeapBlock.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+
+namespace {
+
+// NB: Matches the size of the chunks that BlockAllocator carves its blocks out of.
+constexpr size_t blocks_per_chunk = 2 * MiB / GC::HeapBlock::BLOCK_SIZE;
+
+constexpr size_t magazine_capacity = GC::BlockAllocator::MAGAZINE_CAPACITY;
+constexpr size_t magazine_batch_size = GC::BlockAllocator::MAGAZINE_BATCH_SIZE;
+
+// A thread's magazine belongs to the first allocator that the thread uses, so every test runs its allocations on new
+// threads to make sure that the allocator under test owns their magazines.
+template<typename Callback>
+void run_on_threads(size_t thread_count, Callback callback)
+{
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads.append(Threading::Thread::construct("BlockAllocatorTest"sv, [&callback, i]() -> intptr_t {
+            callback(i);
+            return 0;
+        }));
+        threads.last()->start();
+    }
+    for (auto& thread : threads)
+        MUST(thread->join());
+}
+
+void allocate_blocks(GC::BlockAllocator& allocator, Vector<void*>& blocks, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        blocks.append(allocator.allocate_block("TestGCBlockAllocator"));
+}
+
+void deallocate_blocks(GC::BlockAllocator& allocator, Vector<void*>& blocks)
+{
+    for (auto* block : blocks)
+        allocator.deallocate_block(block, GC::DeferDecommit::No);
+    blocks.clear();
+}
+
+void expect_distinct_blocks(Vector<Vector<void*>> const& blocks_by_thread)
+{
+    HashTable<void*> seen;
+    for (auto const& blocks : blocks_by_thread) {
+        for (auto* block : blocks) {
+            EXPECT_EQ(bit_cast<FlatPtr>(block) % GC::HeapBlock::BLOCK_SIZE, 0u);
+            EXPECT_EQ(seen.set(block), HashSetResult::InsertedNewEntry);
+        }
+    }
+}
+
+}
+
+TEST_CASE(magazine_is_refilled_in_batches)
+{
+    GC::BlockAllocator allocator;
+
+    run_on_threads(1, [&](size_t) {
+        Vector<void*> blocks;
+
+        // The first allocation finds both the magazine and the shared lists empty, so it carves up a new chunk and
+        // takes one of its blocks directly.
+        allocate_blocks(allocator, blocks, 1);
+        EXPECT_EQ(allocator.block_count(), blocks_per_chunk - 1);
+
+        // The next one moves a batch of blocks into the magazine, which serves the rest of the batch without taking
+        // any more blocks from the shared lists.
+        allocate_blocks(allocator, blocks, 1);
+        EXPECT_EQ(allocator.block_count(), blocks_per_chunk - 1 - magazine_batch_size);
+        allocate_blocks(allocator, blocks, magazine_batch_size - 1);
+        EXPECT_EQ(allocator.block_count(), blocks_per_chunk - 1 - magazine_batch_size);
+
+        // Once the batch is used up, the magazine is refilled with the next one.
+        allocate_blocks(allocator, blocks, 1);
+        EXPECT_EQ(allocator.block_count(), blocks_per_chunk - 1 - 2 * magazine_batch_size);
+
+        expect_distinct_blocks({ blocks });
+
+        deallocate_blocks(allocator, blocks);
+        allocator.decommit_free_blocks_now();
+        EXPECT_EQ(allocator.block_count(), blocks_per_chunk);
+    });
+}
+
+TEST_CASE(full_magazine_is_drained_to_the_shared_lists)
+{
+    GC::BlockAllocator allocator;
+
+    run_on_threads(1, [&](size_t) {
+        Vector<void*> blocks;
+        allocate_blocks(allocator, blocks, 2 * magazine_capacity);
+
+        // A block that is freed to the magazine is the next one to be handed out.
+        auto* block = blocks.take_last();
+        allocator.deallocate_block(block, GC::DeferDecommit::No);
+        EXPECT_EQ(allocator.allocate_block("TestGCBlockAllocator"), block);
+        blocks.append(block);
+
+        // Freeing more blocks than the magazine holds drains half of it at a time to the freshly freed list, which
+        // the magazine is refilled from before it falls back to the blocks that are ready for reuse.
+        auto ready_block_count = allocator.block_count();
+        deallocate_blocks(allocator, blocks);
+        EXPECT_EQ(allocator.block_count(), ready_block_count);
+        allocate_blocks(allocator, blocks, 2 * magazine_capacity);
+        EXPECT_EQ(allocator.block_count(), ready_block_count);
+
+        expect_distinct_blocks({ blocks });
+
+        deallocate_blocks(allocator, blocks);
+        allocator.decommit_free_blocks_now();
+        EXPECT_EQ(allocator.block_count(), blocks_per_chunk);
+    });
+}
+
+TEST_CASE(magazine_is_drained_when_its_thread_exits)
+{
+    GC::BlockAllocator allocator;
+
+    // Leave the blocks in the magazine of a thread that then exits.
+    run_on_threads(1, [&](size_t) {
+        Vector<void*> blocks;
+        allocate_blocks(allocator, blocks, magazine_capacity + magazine_batch_size);
+        deallocate_blocks(allocator, blocks);
+    });
+
+    // The blocks must have been handed back to the allocator rather than lost with the thread.
+    allocator.decommit_free_blocks_now();
+    EXPECT_EQ(allocator.block_count(), blocks_per_chunk);
+}
+
+TEST_CASE(blocks_freed_on_other_threads_are_reused)
+{
+    GC::BlockAllocator allocator;
+
+    constexpr size_t thread_count = 4;
+    constexpr size_t blocks_per_thread = 2 * magazine_capacity + 3;
+
+    Vector<Vector<void*>> blocks_by_thread;
+    blocks_by_thread.resize(thread_count);
+
+    run_on_threads(thread_count, [&](size_t index) {
+        allocate_blocks(allocator, blocks_by_thread[index], blocks_per_thread);
+    });
+    expect_distinct_blocks(blocks_by_thread);
+
+    // Each thread frees the blocks of another thread into its own magazine while the other threads allocate from
+    // theirs, so blocks move between magazines and the shared lists from every thread at once.
+    Vector<Vector<void*>> reallocated_blocks_by_thread;
+    reallocated_blocks_by_thread.resize(thread_count);
+
+    run_on_threads(thread_count, [&](size_t index) {
+        auto& reallocated_blocks = reallocated_blocks_by_thread[index];
+        allocate_blocks(allocator, reallocated_blocks, 1);
+        deallocate_blocks(allocator, blocks_by_thread[(index + 1) % thread_count]);
+        allocate_blocks(allocator, reallocated_blocks, blocks_per_thread - 1);
+    });
+    expect_distinct_blocks(reallocated_blocks_by_thread);
+
+    // Free everything from the main thread, whose magazine the allocator doesn't own.
+    for (auto& blocks : reallocated_blocks_by_thread)
+        deallocate_blocks(allocator, blocks);
+
+    // Racing threads may each have carved up a chunk, but every block of every chunk must be free again.
+    allocator.decommit_free_blocks_now();
+    EXPECT(allocator.block_count() >= thread_count * blocks_per_thread);
+    EXPECT_EQ(allocator.block_count() % blocks_per_chunk, 0u);
+}
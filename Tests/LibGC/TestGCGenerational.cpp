@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGC/Cell.h>
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+#include <LibGC/Ptr.h>
+#include <LibGC/Root.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+size_t s_live_cells = 0;
+
+class GenerationalCell final : public GC::Cell {
+    GC_CELL(GenerationalCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(GenerationalCell);
+
+public:
+    virtual ~GenerationalCell() override { --s_live_cells; }
+
+    GC::Ptr<GenerationalCell>& next() { return m_next; }
+
+private:
+    GenerationalCell() { ++s_live_cells; }
+
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(m_next);
+    }
+
+    GC::Ptr<GenerationalCell> m_next;
+};
+
+GC_DEFINE_ALLOCATOR(GenerationalCell);
+
+NEVER_INLINE void scrub_stack()
+{
+    u8 volatile filler[8 * KiB];
+    for (size_t i = 0; i < sizeof(filler); ++i)
+        filler[i] = 0;
+}
+
+NEVER_INLINE void allocate_garbage(GC::Heap& heap)
+{
+    (void)heap.allocate<GenerationalCell>();
+}
+
+NEVER_INLINE void attach_young_cell(GC::Heap& heap, GenerationalCell& old_cell)
+{
+    old_cell.next() = heap.allocate<GenerationalCell>();
+}
+
+}
+
+TEST_CASE(young_collection_frees_young_garbage_and_keeps_old_cells)
+{
+    GC::Heap heap([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    heap.set_incremental_sweep_enabled(false);
+    heap.set_generational_collection_enabled(true);
+
+    auto old_cell = GC::make_root(heap.allocate<GenerationalCell>());
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT_EQ(s_live_cells, 1u);
+
+    allocate_garbage(heap);
+    EXPECT_EQ(s_live_cells, 2u);
+    scrub_stack();
+    heap.collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    EXPECT_EQ(s_live_cells, 1u);
+
+    old_cell = {};
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT_EQ(s_live_cells, 0u);
+
+    heap.set_generational_collection_enabled(false);
+}
+
+TEST_CASE(write_barrier_remembers_old_to_young_edges)
+{
+    GC::Heap heap([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    heap.set_incremental_sweep_enabled(false);
+    heap.set_generational_collection_enabled(true);
+
+    auto old_cell = GC::make_root(heap.allocate<GenerationalCell>());
+    scrub_stack();
+    heap.collect_garbage();
+
+    // The young cell is only reachable through the old cell, which a young collection does not trace unless the
+    // write barrier put it in the remembered set.
+    attach_young_cell(heap, *old_cell);
+    EXPECT_EQ(s_live_cells, 2u);
+    scrub_stack();
+    heap.collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    EXPECT_EQ(s_live_cells, 2u);
+
+    old_cell->next() = nullptr;
+    old_cell = {};
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT_EQ(s_live_cells, 0u);
+
+    heap.set_generational_collection_enabled(false);
+}
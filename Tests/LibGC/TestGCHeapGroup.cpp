@@ -4,6 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/MemoryStream.h>
+#include <LibCore/MemoryPressureNotifier.h>
+#include <LibGC/BlockAddressBitmap.h>
 #include <LibGC/Cell.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/CrossHeapMember.h>
@@ -43,6 +49,28 @@ private:
 
 GC_DEFINE_ALLOCATOR(LinkedCell);
 
+class FanOutCell final : public GC::Cell {
+    GC_CELL(FanOutCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(FanOutCell);
+
+public:
+    Vector<GC::Ptr<LinkedCell>>& children() { return m_children; }
+
+private:
+    FanOutCell() = default;
+
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        for (auto& child : m_children)
+            visitor.visit(child);
+    }
+
+    Vector<GC::Ptr<LinkedCell>> m_children;
+};
+
+GC_DEFINE_ALLOCATOR(FanOutCell);
+
 NEVER_INLINE void scrub_stack()
 {
     u8 volatile filler[8 * KiB];
@@ -77,6 +105,35 @@ NEVER_INLINE GC::Root<LinkedCell> allocate_cross_heap_chain(GC::Heap& heap_a, GC
     return holder;
 }
 
+NEVER_INLINE GC::Root<LinkedCell> allocate_local_chain(GC::Heap& heap, size_t length)
+{
+    auto head = GC::make_root(heap.allocate<LinkedCell>());
+    GC::Ptr<LinkedCell> tail = head.ptr();
+    for (size_t i = 1; i < length; ++i) {
+        auto next = heap.allocate<LinkedCell>();
+        tail->local() = next.ptr();
+        tail = next.ptr();
+    }
+    return head;
+}
+
+NEVER_INLINE GC::Root<FanOutCell> allocate_fan_out(GC::Heap& heap, size_t width, size_t chain_length)
+{
+    auto fan_out = GC::make_root(heap.allocate<FanOutCell>());
+    fan_out->children().ensure_capacity(width);
+    for (size_t i = 0; i < width; ++i) {
+        auto head = heap.allocate<LinkedCell>();
+        GC::Ptr<LinkedCell> tail = head.ptr();
+        for (size_t j = 1; j < chain_length; ++j) {
+            auto next = heap.allocate<LinkedCell>();
+            tail->local() = next.ptr();
+            tail = next.ptr();
+        }
+        fan_out->children().append(head.ptr());
+    }
+    return fan_out;
+}
+
 NEVER_INLINE void allocate_garbage(GC::Heap& heap)
 {
     (void)heap.allocate<LinkedCell>();
@@ -96,6 +153,28 @@ TEST_CASE(sanity_single_heap_frees_garbage)
     EXPECT_EQ(s_live_linked_cells, 0u);
 }
 
+TEST_CASE(block_address_bitmap_tracks_allocated_blocks)
+{
+    GC::Heap heap([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    heap.set_incremental_sweep_enabled(false);
+
+    auto holder = allocate_local_chain(heap, 1);
+    auto cell_address = bit_cast<FlatPtr>(holder.ptr());
+    auto block_address = cell_address & ~(GC::HeapBlockBase::BLOCK_SIZE - 1);
+    EXPECT(GC::BlockAddressBitmap::contains(cell_address));
+    EXPECT(GC::BlockAddressBitmap::contains(block_address + GC::HeapBlockBase::BLOCK_SIZE - 1));
+
+    u8 stack_byte = 0;
+    EXPECT(!GC::BlockAddressBitmap::contains(bit_cast<FlatPtr>(&stack_byte)));
+    EXPECT(!GC::BlockAddressBitmap::contains(0));
+
+    // Once the only cell in the block dies, the block goes back to the block allocator and its bit is cleared.
+    holder = {};
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT(!GC::BlockAddressBitmap::contains(block_address));
+}
+
 TEST_CASE(incoming_cross_heap_member_roots_local_collection)
 {
     GC::Heap heap_a([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
@@ -186,3 +265,162 @@ TEST_CASE(group_collection_traces_live_cross_heap_chains)
     group.remove(heap_a);
     group.remove(heap_b);
 }
+
+TEST_CASE(parallel_marking_traces_live_cells_across_group)
+{
+    GC::Heap heap_a([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    GC::Heap heap_b([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+
+    heap_a.set_incremental_sweep_enabled(false);
+    heap_b.set_incremental_sweep_enabled(false);
+    heap_a.set_marking_thread_count(4);
+    heap_b.set_marking_thread_count(4);
+    GC::HeapGroup group;
+    group.add(heap_a);
+    group.add(heap_b);
+
+    // Visiting the fan-out pushes all of its children at once, which is far more than
+    // ParallelMarkingVisitor::PUBLISH_THRESHOLD, so half of them get published for the other workers to steal.
+    static constexpr size_t fan_out_width = 4096;
+    static constexpr size_t fan_out_chain_length = 4;
+    auto fan_out = allocate_fan_out(heap_a, fan_out_width, fan_out_chain_length);
+    auto holder = allocate_cross_heap_chain(heap_a, heap_b);
+    allocate_garbage(heap_a);
+    allocate_garbage(heap_b);
+    EXPECT_EQ(s_live_linked_cells, fan_out_width * fan_out_chain_length + 3u + 2u);
+
+    scrub_stack();
+    group.collect_garbage();
+    EXPECT_EQ(s_live_linked_cells, fan_out_width * fan_out_chain_length + 3u);
+
+    fan_out = {};
+    holder = {};
+    scrub_stack();
+    group.collect_garbage();
+    EXPECT_EQ(s_live_linked_cells, 0u);
+
+    group.remove(heap_a);
+    group.remove(heap_b);
+}
+
+TEST_CASE(collection_statistics_record_freed_bytes_per_allocator)
+{
+    GC::Heap heap([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    heap.set_incremental_sweep_enabled(false);
+
+    size_t reported_collections = 0;
+    heap.on_collection_finished = [&](auto const&) { ++reported_collections; };
+
+    auto holder = allocate_local_chain(heap, 2);
+    allocate_garbage(heap);
+    allocate_garbage(heap);
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT_EQ(s_live_linked_cells, 2u);
+    EXPECT_EQ(reported_collections, 1u);
+    EXPECT_EQ(heap.collection_statistics().size(), 1u);
+
+    auto const& statistics = heap.collection_statistics().last();
+    EXPECT_EQ(statistics.sequence_number, heap.collection_count());
+    EXPECT(statistics.type == GC::Heap::CollectionType::CollectGarbage);
+    EXPECT(statistics.trigger == GC::Heap::CollectionTrigger::Explicit);
+    EXPECT(statistics.root_count >= 1u);
+    EXPECT(statistics.conservative_root_count <= statistics.root_count);
+    EXPECT_EQ(statistics.freed_bytes_by_allocator.size(), 1u);
+    EXPECT_EQ(statistics.freed_bytes_by_allocator[0].class_name.value_or({}), "LinkedCell"sv);
+    EXPECT_EQ(statistics.freed_bytes_by_allocator[0].bytes, 2 * statistics.freed_bytes_by_allocator[0].cell_size);
+    EXPECT_EQ(statistics.freed_bytes, statistics.freed_bytes_by_allocator[0].bytes);
+
+    holder = {};
+    scrub_stack();
+    heap.collect_garbage();
+}
+
+TEST_CASE(allocator_statistics_count_live_cells)
+{
+    GC::Heap heap([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    heap.set_incremental_sweep_enabled(false);
+
+    auto holder = allocate_local_chain(heap, 3);
+    allocate_garbage(heap);
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT_EQ(s_live_linked_cells, 3u);
+
+    auto statistics = heap.allocator_statistics();
+    VERIFY(statistics.size() == 1);
+    EXPECT_EQ(statistics[0].class_name.value_or({}), "LinkedCell"sv);
+    EXPECT_EQ(statistics[0].cell_size, sizeof(LinkedCell));
+    EXPECT_EQ(statistics[0].block_count, 1u);
+    EXPECT_EQ(statistics[0].live_cell_count, 3u);
+    EXPECT_EQ(statistics[0].external_bytes, 0u);
+
+    holder = {};
+    scrub_stack();
+    heap.collect_garbage();
+}
+
+TEST_CASE(graph_snapshot_streams_one_record_per_cell)
+{
+    GC::Heap heap([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    heap.set_incremental_sweep_enabled(false);
+
+    auto holder = allocate_local_chain(heap, 2);
+    auto holder_id = MUST(String::formatted("{}", bit_cast<FlatPtr>(holder.ptr())));
+    auto tail_id = MUST(String::formatted("{}", bit_cast<FlatPtr>(holder->local().ptr())));
+
+    AllocatingMemoryStream stream;
+    TRY_OR_FAIL(heap.write_graph_snapshot(stream));
+    auto snapshot = TRY_OR_FAIL(stream.read_until_eof());
+
+    size_t linked_cell_nodes = 0;
+    bool holder_is_rooted = false;
+    bool holder_points_at_tail = false;
+    for (auto line : StringView { snapshot }.split_view('\n')) {
+        auto record = TRY_OR_FAIL(JsonValue::from_string(line)).as_object();
+        auto type = record.get_string("type"sv).value();
+        auto id = record.get_string("id"sv);
+        bool is_holder = id.has_value() && *id == holder_id;
+        if (type == "root"sv && is_holder)
+            holder_is_rooted = true;
+        auto class_name = record.get_string("class_name"sv);
+        if (type != "node"sv || !class_name.has_value() || *class_name != "LinkedCell"sv)
+            continue;
+        ++linked_cell_nodes;
+        if (is_holder) {
+            for (auto const& edge : record.get_array("edges"sv)->values())
+                holder_points_at_tail |= edge.as_string() == tail_id;
+        }
+    }
+
+    EXPECT_EQ(linked_cell_nodes, 2u);
+    EXPECT(holder_is_rooted);
+    EXPECT(holder_points_at_tail);
+
+    holder = {};
+    scrub_stack();
+    heap.collect_garbage();
+}
+
+TEST_CASE(memory_pressure_collects_only_when_worthwhile)
+{
+    GC::Heap heap([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    heap.set_incremental_sweep_enabled(false);
+
+    auto holder = allocate_local_chain(heap, 2);
+    allocate_garbage(heap);
+    scrub_stack();
+
+    // A single garbage cell is far below the idle policy's gate, so a warning only decommits free blocks.
+    heap.did_receive_memory_pressure(Core::MemoryPressureLevel::Warning);
+    EXPECT_EQ(heap.collection_count(), 0u);
+
+    heap.did_receive_memory_pressure(Core::MemoryPressureLevel::Critical);
+    EXPECT_EQ(s_live_linked_cells, 2u);
+    EXPECT_EQ(heap.collection_count(), 1u);
+    EXPECT(heap.collection_statistics().last().trigger == GC::Heap::CollectionTrigger::MemoryPressure);
+
+    holder = {};
+    scrub_stack();
+    heap.collect_garbage();
+}
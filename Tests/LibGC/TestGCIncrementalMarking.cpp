@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGC/Cell.h>
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+#include <LibGC/Ptr.h>
+#include <LibGC/Root.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+size_t s_live_cells = 0;
+
+constexpr size_t chain_length = 1000;
+
+class MarkedCell final : public GC::Cell {
+    GC_CELL(MarkedCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(MarkedCell);
+
+public:
+    virtual ~MarkedCell() override { --s_live_cells; }
+
+    GC::Ptr<MarkedCell>& first() { return m_first; }
+    GC::Ptr<MarkedCell>& second() { return m_second; }
+
+private:
+    explicit MarkedCell(GC::Ptr<MarkedCell> first = nullptr)
+        : m_first(first)
+    {
+        ++s_live_cells;
+    }
+
+    // NB: The marker traces the edges that it finds last first, so the second edge is traced ahead of the first.
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(m_first);
+        visitor.visit(m_second);
+    }
+
+    GC::Ptr<MarkedCell> m_first;
+    GC::Ptr<MarkedCell> m_second;
+};
+
+GC_DEFINE_ALLOCATOR(MarkedCell);
+
+NEVER_INLINE void scrub_stack()
+{
+    u8 volatile filler[8 * KiB];
+    for (size_t i = 0; i < sizeof(filler); ++i)
+        filler[i] = 0;
+}
+
+// Hangs a chain of cells linked through their first edge off the owner's first edge, and a leaf cell off its second
+// edge. Marking traces the leaf before the chain, so the leaf has been traced while most of the chain is still white.
+NEVER_INLINE void build_graph(GC::Heap& heap, MarkedCell& owner)
+{
+    owner.second() = heap.allocate<MarkedCell>();
+    GC::Ptr<MarkedCell> chain;
+    for (size_t i = 0; i < chain_length; ++i)
+        chain = heap.allocate<MarkedCell>(chain);
+    owner.first() = chain;
+}
+
+NEVER_INLINE MarkedCell& chain_cell_at(MarkedCell& owner, size_t index)
+{
+    auto* cell = owner.first().ptr();
+    for (size_t i = 0; i < index; ++i)
+        cell = cell->first().ptr();
+    return *cell;
+}
+
+NEVER_INLINE size_t chain_length_from(MarkedCell* cell)
+{
+    size_t length = 0;
+    for (; cell; cell = cell->first().ptr())
+        ++length;
+    return length;
+}
+
+// Moves the part of the chain after index to the leaf, which the marker has already traced by now, so that the only
+// path that the marker knows about to those cells is gone.
+NEVER_INLINE void move_chain_tail_to_leaf(MarkedCell& owner, size_t index)
+{
+    auto& cell = chain_cell_at(owner, index);
+    owner.second()->first() = cell.first();
+    cell.first() = nullptr;
+}
+
+NEVER_INLINE void move_leaf_tail_back_to_chain(MarkedCell& owner, size_t index)
+{
+    auto& cell = chain_cell_at(owner, index);
+    cell.first() = owner.second()->first();
+    owner.second()->first() = nullptr;
+}
+
+// Same as above, but through a cell that is allocated mid-mark and constructed with the tail as its first edge, which
+// initializes the edge without going through the write barrier.
+NEVER_INLINE void move_chain_tail_to_new_cell(GC::Heap& heap, MarkedCell& owner, size_t index)
+{
+    auto& cell = chain_cell_at(owner, index);
+    owner.second()->first() = heap.allocate<MarkedCell>(cell.first());
+    cell.first() = nullptr;
+}
+
+NEVER_INLINE void drop_chain(MarkedCell& owner)
+{
+    owner.first() = nullptr;
+}
+
+}
+
+TEST_CASE(write_barrier_keeps_cells_moved_behind_the_marker_alive)
+{
+    GC::Heap heap([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    heap.set_incremental_sweep_enabled(false);
+
+    auto owner = GC::make_root(heap.allocate<MarkedCell>());
+    build_graph(heap, *owner);
+    EXPECT_EQ(s_live_cells, chain_length + 2);
+
+    scrub_stack();
+    heap.start_incremental_marking_for_testing();
+    EXPECT(heap.is_incremental_marking_active());
+
+    // Trace the owner, the leaf and the start of the chain, then move the rest of the chain behind the leaf.
+    EXPECT(!heap.mark_incrementally_for_testing(16));
+    move_chain_tail_to_leaf(*owner, chain_length / 2);
+
+    // Keep moving the tail back and forth between the chain and the leaf between the remaining steps.
+    for (size_t step = 0; !heap.mark_incrementally_for_testing(16); ++step) {
+        if (step % 2 == 0)
+            move_leaf_tail_back_to_chain(*owner, chain_length / 2);
+        else
+            move_chain_tail_to_leaf(*owner, chain_length / 2);
+    }
+
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT(!heap.is_incremental_marking_active());
+    EXPECT_EQ(s_live_cells, chain_length + 2);
+    EXPECT_EQ(chain_length_from(owner->first().ptr()) + chain_length_from(owner->second().ptr()), chain_length + 1);
+
+    drop_chain(*owner);
+    owner->second() = nullptr;
+    owner = {};
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT_EQ(s_live_cells, 0u);
+}
+
+TEST_CASE(cells_allocated_during_incremental_marking_are_traced)
+{
+    GC::Heap heap([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    heap.set_incremental_sweep_enabled(false);
+
+    auto owner = GC::make_root(heap.allocate<MarkedCell>());
+    build_graph(heap, *owner);
+
+    scrub_stack();
+    heap.start_incremental_marking_for_testing();
+    EXPECT(!heap.mark_incrementally_for_testing(16));
+    move_chain_tail_to_new_cell(heap, *owner, chain_length / 2);
+    EXPECT_EQ(s_live_cells, chain_length + 3);
+
+    while (!heap.mark_incrementally_for_testing(16)) { }
+
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT_EQ(s_live_cells, chain_length + 3);
+    EXPECT_EQ(chain_length_from(owner->second().ptr()), chain_length / 2 + 1);
+
+    drop_chain(*owner);
+    owner->second() = nullptr;
+    owner = {};
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT_EQ(s_live_cells, 0u);
+}
+
+TEST_CASE(incremental_marking_collects_cells_that_were_unreachable_when_it_started)
+{
+    GC::Heap heap([](auto&) { }, GC::Heap::BecomeProcessDefault::No);
+    heap.set_incremental_sweep_enabled(false);
+
+    auto owner = GC::make_root(heap.allocate<MarkedCell>());
+    build_graph(heap, *owner);
+    drop_chain(*owner);
+
+    scrub_stack();
+    heap.start_incremental_marking_for_testing();
+    while (!heap.mark_incrementally_for_testing(16)) { }
+
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT_EQ(s_live_cells, 2u);
+
+    owner->second() = nullptr;
+    owner = {};
+    scrub_stack();
+    heap.collect_garbage();
+    EXPECT_EQ(s_live_cells, 0u);
+}
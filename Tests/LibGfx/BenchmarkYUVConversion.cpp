@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/YUVData.h>
+#include <LibTest/TestCase.h>
+
+static constexpr Gfx::IntSize frame_size { 1920, 1080 };
+
+static Media::CodingIndependentCodePoints cicp_for(Media::MatrixCoefficients matrix_coefficients, Media::VideoFullRangeFlag range)
+{
+    return { Media::ColorPrimaries::BT709, Media::TransferCharacteristics::BT709, matrix_coefficients, range };
+}
+
+// Fills the planes with a gradient, so that the conversion doesn't see a flat image.
+static void fill_planes(Gfx::YUVData& yuv_data)
+{
+    auto sample_max = (1u << yuv_data.bit_depth()) - 1;
+    auto fill = [&](Bytes plane) {
+        if (yuv_data.bit_depth() <= 8) {
+            for (size_t i = 0; i < plane.size(); i++)
+                plane[i] = static_cast<u8>(i % (sample_max + 1));
+            return;
+        }
+        auto* samples = reinterpret_cast<u16*>(plane.data());
+        for (size_t i = 0; i < plane.size() / sizeof(u16); i++)
+            samples[i] = static_cast<u16>(i % (sample_max + 1));
+    };
+    fill(yuv_data.y_data());
+    fill(yuv_data.u_data());
+    fill(yuv_data.v_data());
+}
+
+static void convert(u8 bit_depth, Media::Subsampling subsampling, Media::MatrixCoefficients matrix_coefficients = Media::MatrixCoefficients::BT709, Media::VideoFullRangeFlag range = Media::VideoFullRangeFlag::Studio)
+{
+    auto yuv_data = MUST(Gfx::YUVData::create(frame_size, bit_depth, subsampling, cicp_for(matrix_coefficients, range)));
+    fill_planes(*yuv_data);
+    auto bitmap = MUST(yuv_data->to_bitmap());
+    EXPECT_EQ(bitmap->size(), frame_size);
+}
+
+BENCHMARK_CASE(yuv420_8_bit)
+{
+    convert(8, { true, true });
+}
+
+BENCHMARK_CASE(yuv422_8_bit)
+{
+    convert(8, { true, false });
+}
+
+BENCHMARK_CASE(yuv444_8_bit)
+{
+    convert(8, { false, false });
+}
+
+BENCHMARK_CASE(yuv420_10_bit)
+{
+    convert(10, { true, true });
+}
+
+BENCHMARK_CASE(yuv422_10_bit)
+{
+    convert(10, { true, false });
+}
+
+BENCHMARK_CASE(yuv444_10_bit)
+{
+    convert(10, { false, false });
+}
+
+BENCHMARK_CASE(yuv420_12_bit)
+{
+    convert(12, { true, true });
+}
+
+BENCHMARK_CASE(yuv444_12_bit)
+{
+    convert(12, { false, false });
+}
+
+BENCHMARK_CASE(yuv420_8_bit_bt601_full_range)
+{
+    convert(8, { true, true }, Media::MatrixCoefficients::BT601, Media::VideoFullRangeFlag::Full);
+}
+
+BENCHMARK_CASE(yuv420_10_bit_bt2020)
+{
+    convert(10, { true, true }, Media::MatrixCoefficients::BT2020NonConstantLuminance);
+}
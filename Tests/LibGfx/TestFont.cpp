@@ -4,12 +4,21 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/LexicalPath.h>
+#include <AK/Random.h>
+#include <AK/ScopeGuard.h>
+#include <AK/Utf16String.h>
+#include <LibCore/Directory.h>
 #include <LibCore/MappedFile.h>
+#include <LibCore/StandardPaths.h>
+#include <LibFileSystem/FileSystem.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/PathFontProvider.h>
 #include <LibGfx/Font/Typeface.h>
+#include <LibGfx/TextLayout.h>
 #include <LibTest/TestCase.h>
+#include <stdlib.h>
 
 #define TEST_INPUT(x) ("test-inputs/" x)
 
@@ -51,3 +60,91 @@ TEST_CASE(text_font_is_not_emoji_font)
 {
     EXPECT(!font_is_emoji(TEST_INPUT("fonts/text.ttf"sv)));
 }
+
+// A second provider finds the same fonts through the metadata cache that the first one wrote.
+TEST_CASE(fonts_are_found_again_through_metadata_cache)
+{
+    auto cache_directory = ByteString::formatted("{}/Ladybird-TestFont-{}", Core::StandardPaths::tempfile_directory(), generate_random_uuid());
+    MUST(Core::Directory::create(cache_directory, Core::Directory::CreateDirectories::Yes));
+    auto cleanup_cache_directory = ScopeGuard([&] {
+        MUST(FileSystem::remove(cache_directory, FileSystem::RecursionMode::Allowed));
+    });
+    VERIFY(setenv("XDG_CACHE_HOME", cache_directory.characters(), 1) == 0);
+
+    auto fonts_uri = MUST(String::formatted("file://{}", MUST(FileSystem::absolute_path(TEST_INPUT("fonts"sv)))));
+
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("fonts/text.ttf"sv)));
+    auto text_typeface = MUST(Gfx::Typeface::try_load_from_externally_owned_memory(file->bytes()));
+    auto family = text_typeface->family();
+
+    auto typeface_count = [&](Gfx::PathFontProvider& provider) {
+        size_t count = 0;
+        provider.for_each_typeface_with_family_name(family, [&](Gfx::Typeface const& typeface) {
+            EXPECT_EQ(typeface.family(), family);
+            ++count;
+        });
+        return count;
+    };
+
+    Gfx::PathFontProvider provider_without_cache;
+    provider_without_cache.load_all_fonts_from_uri(fonts_uri);
+    auto count = typeface_count(provider_without_cache);
+    EXPECT(count > 0);
+    EXPECT(FileSystem::exists(LexicalPath::join(cache_directory, "Ladybird"sv, "FontMetadata"sv).string()));
+
+    Gfx::PathFontProvider provider_with_cache;
+    provider_with_cache.load_all_fonts_from_uri(fonts_uri);
+    EXPECT(provider_with_cache.get_font(family, 12, text_typeface->weight(), text_typeface->width(), text_typeface->slope()));
+    EXPECT_EQ(typeface_count(provider_with_cache), count);
+}
+
+static NonnullRefPtr<Gfx::Font> load_text_font(Core::MappedFile const& file)
+{
+    auto typeface = MUST(Gfx::Typeface::try_load_from_externally_owned_memory(file.bytes()));
+    return adopt_ref(*new Gfx::Font(typeface, 12, 12, {}, {}));
+}
+
+static void expect_same_glyphs(Gfx::GlyphRun const& a, Gfx::GlyphRun const& b)
+{
+    EXPECT_EQ(a.width(), b.width());
+    EXPECT_EQ(a.glyphs().size(), b.glyphs().size());
+    for (size_t i = 0; i < min(a.glyphs().size(), b.glyphs().size()); ++i) {
+        EXPECT_EQ(a.glyphs()[i].glyph_id, b.glyphs()[i].glyph_id);
+        EXPECT_EQ(a.glyphs()[i].position, b.glyphs()[i].position);
+    }
+}
+
+// Texts shaped on the thread pool land in the shaping cache once each, and shape the same as text shaped on demand.
+TEST_CASE(primed_shaping_cache_matches_shaping_on_demand)
+{
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("fonts/text.ttf"sv)));
+    auto font = load_text_font(*file);
+    auto reference_font = load_text_font(*file);
+
+    auto hello = Utf16String::from_utf8("Hello"sv);
+    auto world = Utf16String::from_utf8("world"sv);
+    auto letter = Utf16String::from_utf8("x"sv);
+
+    Vector<Gfx::TextToShape> texts;
+    texts.append({ .text = hello, .font = font });
+    texts.append({ .text = world, .font = font });
+    texts.append({ .text = hello, .font = font });
+    texts.append({ .text = letter, .font = font });
+    texts.append({ .text = hello, .font = font, .letter_spacing = 2.f });
+
+    Gfx::prime_shaping_caches(texts);
+    EXPECT_EQ(font->shaping_cache().miss_count, 4u);
+    EXPECT_EQ(font->shaping_cache().hit_count, 0u);
+
+    // Texts that are already in the cache aren't shaped again.
+    Gfx::prime_shaping_caches(texts);
+    EXPECT_EQ(font->shaping_cache().miss_count, 4u);
+
+    for (auto const& text : texts) {
+        auto primed = Gfx::shape_text({}, text.letter_spacing, text.text, font, text.text_type);
+        auto on_demand = Gfx::shape_text({}, text.letter_spacing, text.text, reference_font, text.text_type);
+        expect_same_glyphs(primed, on_demand);
+    }
+    EXPECT_EQ(font->shaping_cache().miss_count, 4u);
+    EXPECT_EQ(font->shaping_cache().hit_count, texts.size());
+}
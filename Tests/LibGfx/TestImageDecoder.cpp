@@ -665,6 +665,70 @@ TEST_CASE(test_png_large_dimensions)
     EXPECT_EQ(plugin_decoder->frame(0).value().image->get_pixel(0, 0), Gfx::Color::NamedColor::Red);
 }
 
+// Appends the data a chunk at a time, and returns how many partial bitmaps were decoded along the way. The last of
+// them has to match the image that is decoded from the complete data.
+static ErrorOr<size_t> decode_incrementally_and_compare(ReadonlyBytes data, size_t chunk_size)
+{
+    auto complete_decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(data));
+    EXPECT(complete_decoder);
+    auto complete_frame = TRY(complete_decoder->frame(0));
+
+    auto decoder = TRY(Gfx::IncrementalImageDecoder::try_create(data.trim(chunk_size)));
+    EXPECT(decoder);
+
+    size_t partial_bitmap_count = 0;
+    RefPtr<Gfx::Bitmap> last_partial_bitmap;
+    for (size_t offset = chunk_size; offset < data.size(); offset += chunk_size) {
+        TRY(decoder->append_data(data.slice(offset, min(chunk_size, data.size() - offset))));
+        if (auto bitmap = TRY(decoder->take_partial_bitmap())) {
+            last_partial_bitmap = move(bitmap);
+            ++partial_bitmap_count;
+        }
+    }
+
+    EXPECT(last_partial_bitmap);
+    auto bitmap_after_last_append = TRY(decoder->take_partial_bitmap());
+    EXPECT(!bitmap_after_last_append);
+    EXPECT_EQ(last_partial_bitmap->size(), complete_frame.image->size());
+    for (int y = 0; y < last_partial_bitmap->height(); ++y) {
+        for (int x = 0; x < last_partial_bitmap->width(); ++x) {
+            if (last_partial_bitmap->get_pixel(x, y) != complete_frame.image->get_pixel(x, y)) {
+                FAIL(ByteString::formatted("Pixel at {},{} differs from the complete decode", x, y));
+                return partial_bitmap_count;
+            }
+        }
+    }
+    return partial_bitmap_count;
+}
+
+TEST_CASE(test_jpeg_incremental_sequential)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans.jpg"sv)));
+    EXPECT(TRY_OR_FAIL(decode_incrementally_and_compare(file->bytes(), 1024)) > 1);
+
+    file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb24.jpg"sv)));
+    EXPECT(TRY_OR_FAIL(decode_incrementally_and_compare(file->bytes(), 256)) >= 1);
+}
+
+TEST_CASE(test_jpeg_incremental_progressive)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/spectral_selection.jpg"sv)));
+    EXPECT(TRY_OR_FAIL(decode_incrementally_and_compare(file->bytes(), 512)) > 1);
+}
+
+TEST_CASE(test_jpeg_incremental_cmyk)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/buggie-cmyk.jpg"sv)));
+    auto decoder_or_error = Gfx::IncrementalImageDecoder::try_create(file->bytes());
+    EXPECT(decoder_or_error.is_error());
+}
+
+TEST_CASE(test_png_incremental)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    EXPECT(TRY_OR_FAIL(decode_incrementally_and_compare(file->bytes(), 512)) > 1);
+}
+
 TEST_CASE(test_webp_simple_lossy)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/simple-vp8.webp"sv)));
@@ -5,6 +5,7 @@
  */
 
 #include <AK/Array.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/YUVData.h>
 #include <LibTest/TestCase.h>
@@ -83,3 +84,59 @@ TEST_CASE(high_bit_depth_pixmaps_expand_without_mutating_native_samples)
             EXPECT_EQ(bitmap_after->get_pixel(x, y), bitmap_before->get_pixel(x, y));
     }
 }
+
+TEST_CASE(planes_are_views_into_the_shared_buffer)
+{
+    auto const cicp = Media::CodingIndependentCodePoints {
+        Media::ColorPrimaries::BT709,
+        Media::TransferCharacteristics::BT709,
+        Media::MatrixCoefficients::BT709,
+        Media::VideoFullRangeFlag::Full,
+    };
+    auto sizes = TRY_OR_FAIL(Gfx::YUVData::plane_sizes({ 4, 2 }, 8, Media::Subsampling { true, true }));
+    EXPECT_EQ(sizes.total, 12u);
+
+    auto buffer = TRY_OR_FAIL(Core::AnonymousBuffer::create_with_size(sizes.total));
+    for (size_t i = 0; i < sizes.total; i++)
+        buffer.data<u8>()[i] = static_cast<u8>(i);
+
+    auto yuv_data = TRY_OR_FAIL(Gfx::YUVData::create_from_buffer({ 4, 2 }, 8, Media::Subsampling { true, true }, cicp, buffer));
+    EXPECT_EQ(yuv_data->buffer().data<u8>(), buffer.data<u8>());
+    EXPECT_EQ(yuv_data->y_data().size(), 8u);
+    EXPECT_EQ(yuv_data->y_data()[0], 0);
+    EXPECT_EQ(yuv_data->u_data()[0], 8);
+    EXPECT_EQ(yuv_data->v_data()[1], 11);
+
+    auto too_small = TRY_OR_FAIL(Core::AnonymousBuffer::create_with_size(sizes.total - 1));
+    EXPECT(Gfx::YUVData::create_from_buffer({ 4, 2 }, 8, Media::Subsampling { true, true }, cicp, too_small).is_error());
+}
+
+TEST_CASE(planes_are_sealed_once_filled)
+{
+    auto const cicp = Media::CodingIndependentCodePoints {
+        Media::ColorPrimaries::BT709,
+        Media::TransferCharacteristics::BT709,
+        Media::MatrixCoefficients::BT709,
+        Media::VideoFullRangeFlag::Full,
+    };
+    Array<u8, 8> const y_samples { 1, 2, 3, 4, 5, 6, 7, 8 };
+    Array<u8, 2> const u_samples { 9, 10 };
+    Array<u8, 2> const v_samples { 11, 12 };
+
+    auto yuv_data = TRY_OR_FAIL(Gfx::YUVData::create({ 4, 2 }, 8, Media::Subsampling { true, true }, cicp));
+    EXPECT(!yuv_data->buffer().is_sealed());
+    y_samples.span().copy_to(yuv_data->y_data());
+    u_samples.span().copy_to(yuv_data->u_data());
+    v_samples.span().copy_to(yuv_data->v_data());
+
+    TRY_OR_FAIL(yuv_data->seal());
+    EXPECT_EQ(yuv_data->buffer().is_sealed(), Core::AnonymousBuffer::supports_sealing);
+
+    Gfx::YUVData const& sealed_data = *yuv_data;
+    EXPECT_EQ(sealed_data.y_data()[7], 8);
+    EXPECT_EQ(sealed_data.u_data()[1], 10);
+    EXPECT_EQ(sealed_data.v_data()[0], 11);
+
+    auto copied_data = TRY_OR_FAIL(Gfx::YUVData::create_from_data({ 4, 2 }, 8, Media::Subsampling { true, true }, cicp, y_samples.span(), u_samples.span(), v_samples.span()));
+    EXPECT_EQ(copied_data->buffer().is_sealed(), Core::AnonymousBuffer::supports_sealing);
+}
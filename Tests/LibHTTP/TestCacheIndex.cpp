@@ -114,6 +114,30 @@ TEST_CASE(remove_entries_exceeding_cache_limit_tolerates_replaced_unloaded_entri
     EXPECT_EQ(reloaded_index.estimate_cache_size_accessed_since(UnixDateTime::earliest()).total, 80u);
 }
 
+TEST_CASE(last_access_times_are_written_back_when_flushed)
+{
+    auto state = create_cache_index();
+
+    auto request_headers = HTTP::HeaderList::create();
+    auto response_headers = HTTP::HeaderList::create();
+    auto vary_key = HTTP::create_vary_key(*request_headers, *response_headers);
+    auto now = UnixDateTime::now();
+
+    TRY_OR_FAIL(state.index.create_entry(1, vary_key, "https://example.com"_string, request_headers, response_headers, 10, now, now));
+    state.index.update_last_access_time(1, vary_key);
+
+    auto entry = state.index.find_entry(1, *request_headers);
+    VERIFY(entry.has_value());
+    auto last_access_time = entry->last_access_time;
+
+    state.index.flush_pending_last_access_times();
+
+    auto reloaded_index = MUST(HTTP::CacheIndex::create(*state.database, cache_directory()));
+    auto reloaded_entry = reloaded_index.find_entry(1, *request_headers);
+    VERIFY(reloaded_entry.has_value());
+    EXPECT_EQ(reloaded_entry->last_access_time.milliseconds_since_epoch(), last_access_time.milliseconds_since_epoch());
+}
+
 TEST_CASE(associated_data_counts_toward_cache_size)
 {
     auto state = create_cache_index();
@@ -43,3 +43,20 @@ TEST_CASE(is_cacheable_must_understand_accepts_304_status)
     auto headers = HTTP::HeaderList::create({ { "Cache-Control", "must-understand, no-store, max-age=3600" } });
     EXPECT(HTTP::is_cacheable(304, *headers));
 }
+
+TEST_CASE(cache_entry_files_are_sharded_by_cache_key)
+{
+    LexicalPath cache_directory { "/cache" };
+
+    auto path = HTTP::path_for_cache_entry(cache_directory, 0xab00000000000001, 0);
+    EXPECT_EQ(path.string(), "/cache/ab/ab00000000000001"sv);
+
+    path = HTTP::path_for_cache_entry(cache_directory, 0x0100000000000002, 0x3);
+    EXPECT_EQ(path.string(), "/cache/01/0100000000000002_0000000000000003"sv);
+
+    auto cache_entry_data = HTTP::cache_entry_data_for_file(path);
+    VERIFY(cache_entry_data.has_value());
+    EXPECT_EQ(cache_entry_data->cache_key, 0x0100000000000002u);
+    EXPECT_EQ(cache_entry_data->vary_key, 0x3u);
+    EXPECT(!cache_entry_data->associated_data.has_value());
+}
@@ -220,3 +220,76 @@ TEST_CASE(associated_data_participates_in_cache_eviction)
     auto retrieved_bytecode = TRY_OR_FAIL(disk_cache.retrieve_associated_data(url, "GET"sv, *request_headers, {}, HTTP::CacheEntryAssociatedData::JavaScriptBytecode));
     EXPECT(!retrieved_bytecode.has_value());
 }
+
+static ByteBuffer create_javascript_bytecode(ReadonlyBytes source_hash, StringView payload)
+{
+    ByteBuffer bytecode;
+    bytecode.append("LBJSBC\0\0"sv.bytes());
+    bytecode.append("\0\0\0\0\0"sv.bytes());
+    bytecode.append(source_hash);
+    bytecode.append(payload.bytes());
+    return bytecode;
+}
+
+TEST_CASE(shared_javascript_bytecode_round_trips_by_source_hash)
+{
+    auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
+
+    auto source_hash = TRY_OR_FAIL(ByteBuffer::create_zeroed(32));
+    source_hash[0] = 0x4c;
+    auto other_source_hash = TRY_OR_FAIL(ByteBuffer::create_zeroed(32));
+
+    auto retrieved_bytecode_file = TRY_OR_FAIL(disk_cache.retrieve_shared_javascript_bytecode_file("https://example.com"sv, source_hash.bytes()));
+    EXPECT(!retrieved_bytecode_file.has_value());
+
+    TRY_OR_FAIL(disk_cache.store_shared_javascript_bytecode("https://example.com"sv, source_hash.bytes(), create_javascript_bytecode(source_hash, "bytecode"sv)));
+    auto new_bytecode = create_javascript_bytecode(source_hash, "new bytecode"sv);
+    TRY_OR_FAIL(disk_cache.store_shared_javascript_bytecode("https://example.com"sv, source_hash.bytes(), new_bytecode));
+
+    retrieved_bytecode_file = TRY_OR_FAIL(disk_cache.retrieve_shared_javascript_bytecode_file("https://example.com"sv, source_hash.bytes()));
+    VERIFY(retrieved_bytecode_file.has_value());
+    auto mapped_bytecode = TRY_OR_FAIL(Core::ImmutableBytes::map_from_fd_range_and_close(retrieved_bytecode_file->fd, "bytecode"sv, retrieved_bytecode_file->offset, retrieved_bytecode_file->size));
+    EXPECT_EQ(mapped_bytecode.bytes(), new_bytecode.bytes());
+
+    retrieved_bytecode_file = TRY_OR_FAIL(disk_cache.retrieve_shared_javascript_bytecode_file("https://example.com"sv, other_source_hash.bytes()));
+    EXPECT(!retrieved_bytecode_file.has_value());
+
+    disk_cache.remove_entries_accessed_since(UnixDateTime::earliest());
+
+    retrieved_bytecode_file = TRY_OR_FAIL(disk_cache.retrieve_shared_javascript_bytecode_file("https://example.com"sv, source_hash.bytes()));
+    EXPECT(!retrieved_bytecode_file.has_value());
+}
+
+TEST_CASE(shared_javascript_bytecode_is_partitioned_by_top_level_site)
+{
+    auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
+
+    auto source_hash = TRY_OR_FAIL(ByteBuffer::create_zeroed(32));
+    source_hash[0] = 0x4c;
+
+    TRY_OR_FAIL(disk_cache.store_shared_javascript_bytecode("https://example.com"sv, source_hash.bytes(), create_javascript_bytecode(source_hash, "bytecode"sv)));
+
+    auto retrieved_bytecode_file = TRY_OR_FAIL(disk_cache.retrieve_shared_javascript_bytecode_file("https://example.org"sv, source_hash.bytes()));
+    EXPECT(!retrieved_bytecode_file.has_value());
+
+    retrieved_bytecode_file = TRY_OR_FAIL(disk_cache.retrieve_shared_javascript_bytecode_file("https://example.com"sv, source_hash.bytes()));
+    VERIFY(retrieved_bytecode_file.has_value());
+    (void)Core::ImmutableBytes::map_from_fd_range_and_close(retrieved_bytecode_file->fd, "bytecode"sv, retrieved_bytecode_file->offset, retrieved_bytecode_file->size);
+
+    disk_cache.remove_entries_accessed_since(UnixDateTime::earliest());
+}
+
+TEST_CASE(shared_javascript_bytecode_rejects_blobs_for_other_sources)
+{
+    auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
+
+    auto source_hash = TRY_OR_FAIL(ByteBuffer::create_zeroed(32));
+    source_hash[0] = 0x4c;
+    auto other_source_hash = TRY_OR_FAIL(ByteBuffer::create_zeroed(32));
+
+    EXPECT(disk_cache.store_shared_javascript_bytecode("https://example.com"sv, source_hash.bytes(), "bytecode"sv.bytes()).is_error());
+    EXPECT(disk_cache.store_shared_javascript_bytecode("https://example.com"sv, source_hash.bytes(), create_javascript_bytecode(other_source_hash, "bytecode"sv)).is_error());
+
+    auto retrieved_bytecode_file = TRY_OR_FAIL(disk_cache.retrieve_shared_javascript_bytecode_file("https://example.com"sv, source_hash.bytes()));
+    EXPECT(!retrieved_bytecode_file.has_value());
+}
@@ -11,7 +11,9 @@
 #include <LibHTTP/Cache/Utilities.h>
 #include <LibHTTP/HTTP.h>
 #include <LibHTTP/Header.h>
+#include <LibHTTP/Link.h>
 #include <LibHTTP/Method.h>
+#include <LibHTTP/Priority.h>
 
 TEST_CASE(collect_an_http_quoted_string)
 {
@@ -246,3 +248,58 @@ TEST_CASE(extract_header_values)
     auto result = HTTP::Header { "Content-Type"sv, "text/html; charset=utf-8"sv }.extract_header_values();
     EXPECT_EQ(result, (Vector<ByteString> { "text/html; charset=utf-8" }));
 }
+
+TEST_CASE(serialize_priority)
+{
+    EXPECT_EQ(HTTP::Priority {}.serialize(), ""sv);
+    EXPECT_EQ((HTTP::Priority { .urgency = 0 }).serialize(), "u=0"sv);
+    EXPECT_EQ((HTTP::Priority { .incremental = true }).serialize(), "i"sv);
+    EXPECT_EQ((HTTP::Priority { .urgency = 5, .incremental = true }).serialize(), "u=5, i"sv);
+}
+
+TEST_CASE(parse_link_field_value)
+{
+    {
+        auto links = HTTP::parse_link_field_value("</style.css>; rel=preload; as=style"sv);
+        EXPECT_EQ(links.size(), 1u);
+        EXPECT_EQ(links[0].target, "/style.css"sv);
+        EXPECT_EQ(links[0].relation_type, "preload"sv);
+        EXPECT_EQ(links[0].target_attribute("as"sv), "style"sv);
+        EXPECT(!links[0].target_attribute("rel"sv).has_value());
+    }
+    {
+        // Multiple link-values, quoted strings, whitespace, and case normalization.
+        auto links = HTTP::parse_link_field_value(R"(<https://cdn.example>; rel="PreConnect"; crossorigin , </font.woff2> ;rel=preload ; as=font; type="font/woff2")"sv);
+        EXPECT_EQ(links.size(), 2u);
+        EXPECT_EQ(links[0].target, "https://cdn.example"sv);
+        EXPECT_EQ(links[0].relation_type, "preconnect"sv);
+        EXPECT_EQ(links[0].target_attribute("crossorigin"sv), ""sv);
+        EXPECT_EQ(links[1].target, "/font.woff2"sv);
+        EXPECT_EQ(links[1].relation_type, "preload"sv);
+        EXPECT_EQ(links[1].target_attribute("as"sv), "font"sv);
+        EXPECT_EQ(links[1].target_attribute("type"sv), "font/woff2"sv);
+    }
+    {
+        // Each relation type produces its own link object.
+        auto links = HTTP::parse_link_field_value("</a>; rel=\"preload prefetch\"; as=script"sv);
+        EXPECT_EQ(links.size(), 2u);
+        EXPECT_EQ(links[0].relation_type, "preload"sv);
+        EXPECT_EQ(links[1].relation_type, "prefetch"sv);
+        EXPECT_EQ(links[1].target_attribute("as"sv), "script"sv);
+    }
+    {
+        // Only the first "type" attribute is kept.
+        auto links = HTTP::parse_link_field_value("</a>; rel=preload; type=text/css; type=text/plain"sv);
+        EXPECT_EQ(links.size(), 1u);
+        EXPECT_EQ(links[0].target_attribute("type"sv), "text/css"sv);
+    }
+    {
+        // Parsing stops at the first malformed link-value.
+        auto links = HTTP::parse_link_field_value("</a>; rel=preload, garbage, </b>; rel=preload"sv);
+        EXPECT_EQ(links.size(), 1u);
+        EXPECT_EQ(links[0].target, "/a"sv);
+
+        EXPECT(HTTP::parse_link_field_value("</unterminated; rel=preload"sv).is_empty());
+        EXPECT(HTTP::parse_link_field_value(""sv).is_empty());
+    }
+}
@@ -117,3 +117,139 @@ TEST_CASE(javascript_bytecode_cache_can_be_added_after_memory_cache_entry_is_com
     EXPECT_EQ(entry->javascript_bytecode_cache->bytes(), bytecode.bytes());
     EXPECT_EQ(entry->javascript_bytecode_cache_vary_key, Optional<u64> { 0 });
 }
+
+static void store_response(HTTP::MemoryCache& cache, URL::URL const& url, StringView body)
+{
+    auto request_headers = create_cacheable_request_headers();
+    auto response_headers = create_cacheable_response_headers();
+
+    cache.create_entry(url, "GET"sv, *request_headers, UnixDateTime::now(), 200, "OK"sv, *response_headers);
+    cache.finalize_entry(url, "GET"sv, *request_headers, 200, *response_headers, immutable_bytes(body));
+}
+
+static bool has_response(HTTP::MemoryCache& cache, URL::URL const& url)
+{
+    auto request_headers = create_cacheable_request_headers();
+    return cache.open_entry(url, "GET"sv, *request_headers, HTTP::CacheMode::Default).has_value();
+}
+
+TEST_CASE(memory_cache_evicts_least_recently_stored_entries_beyond_its_maximum_size)
+{
+    auto cache = HTTP::MemoryCache::create(10);
+    auto first_url = parse_url("https://example.com/1"sv);
+    auto second_url = parse_url("https://example.com/2"sv);
+    auto third_url = parse_url("https://example.com/3"sv);
+
+    store_response(*cache, first_url, "aaaa"sv);
+    store_response(*cache, second_url, "bbbb"sv);
+    EXPECT_EQ(cache->statistics().size, 8u);
+
+    store_response(*cache, third_url, "cccc"sv);
+    EXPECT_EQ(cache->statistics().size, 8u);
+    EXPECT_EQ(cache->statistics().evictions, 1u);
+
+    EXPECT(!has_response(*cache, first_url));
+    EXPECT(has_response(*cache, second_url));
+    EXPECT(has_response(*cache, third_url));
+
+    EXPECT_EQ(cache->statistics().hits, 2u);
+    EXPECT_EQ(cache->statistics().misses, 1u);
+}
+
+TEST_CASE(memory_cache_keeps_reused_entries_over_one_off_entries)
+{
+    auto cache = HTTP::MemoryCache::create(10);
+    auto reused_url = parse_url("https://example.com/reused"sv);
+
+    store_response(*cache, reused_url, "aaaa"sv);
+    EXPECT(has_response(*cache, reused_url));
+
+    for (auto i = 0; i < 5; ++i)
+        store_response(*cache, parse_url(ByteString::formatted("https://example.com/one-off/{}", i)), "bbbb"sv);
+
+    EXPECT(has_response(*cache, reused_url));
+    EXPECT(has_response(*cache, parse_url("https://example.com/one-off/4"sv)));
+    EXPECT(!has_response(*cache, parse_url("https://example.com/one-off/3"sv)));
+}
+
+TEST_CASE(memory_cache_does_not_store_entries_larger_than_its_maximum_size)
+{
+    auto cache = HTTP::MemoryCache::create(4);
+    auto url = parse_url("https://example.com/large"sv);
+
+    store_response(*cache, url, "too large"sv);
+    EXPECT_EQ(cache->statistics().size, 0u);
+    EXPECT(!has_response(*cache, url));
+}
+
+TEST_CASE(memory_cache_size_includes_javascript_bytecode_cache)
+{
+    auto cache = HTTP::MemoryCache::create(20);
+    auto first_url = parse_url("https://example.com/1.js"sv);
+    auto second_url = parse_url("https://example.com/2.js"sv);
+    auto request_headers = create_cacheable_request_headers();
+
+    store_response(*cache, first_url, "aaaa"sv);
+    store_response(*cache, second_url, "bbbb"sv);
+    EXPECT_EQ(cache->statistics().size, 8u);
+
+    cache->update_javascript_bytecode_cache(second_url, "GET"sv, *request_headers, 0, immutable_bytes("bytecode"sv));
+    EXPECT_EQ(cache->statistics().size, 16u);
+
+    cache->update_javascript_bytecode_cache(second_url, "GET"sv, *request_headers, 0, immutable_bytes("larger bytecode"sv));
+    EXPECT_EQ(cache->statistics().size, 19u);
+    EXPECT(!has_response(*cache, first_url));
+    EXPECT(has_response(*cache, second_url));
+}
+
+TEST_CASE(memory_cache_serves_stale_while_revalidate_responses_while_they_are_revalidated)
+{
+    using RevalidationType = HTTP::MemoryCache::RevalidationType;
+
+    auto cache = HTTP::MemoryCache::create();
+    auto url = parse_url("https://example.com/stale"sv);
+    auto request_headers = create_cacheable_request_headers();
+    auto stale_response_headers = HTTP::HeaderList::create({
+        { "Cache-Control"sv, "max-age=0, stale-while-revalidate=60"sv },
+        { "Last-Modified"sv, "Wed, 21 Oct 2015 07:28:00 GMT"sv },
+    });
+
+    cache->create_entry(url, "GET"sv, *request_headers, UnixDateTime::now(), 200, "OK"sv, *stale_response_headers);
+    cache->finalize_entry(url, "GET"sv, *request_headers, 200, *stale_response_headers, immutable_bytes("stale"sv));
+
+    // Only the first caller is asked to revalidate the stale response.
+    auto revalidation_type = RevalidationType::None;
+    auto entry = cache->open_entry(url, "GET"sv, *request_headers, HTTP::CacheMode::Default, &revalidation_type);
+    VERIFY(entry.has_value());
+    EXPECT_EQ(entry->response_body.bytes(), "stale"sv.bytes());
+    EXPECT_EQ(revalidation_type, RevalidationType::StaleWhileRevalidate);
+
+    entry = cache->open_entry(url, "GET"sv, *request_headers, HTTP::CacheMode::Default, &revalidation_type);
+    VERIFY(entry.has_value());
+    EXPECT_EQ(revalidation_type, RevalidationType::None);
+
+    // The revalidated response replaces the stale one.
+    store_response(*cache, url, "fresh"sv);
+
+    entry = cache->open_entry(url, "GET"sv, *request_headers, HTTP::CacheMode::Default, &revalidation_type);
+    VERIFY(entry.has_value());
+    EXPECT_EQ(entry->response_body.bytes(), "fresh"sv.bytes());
+    EXPECT_EQ(revalidation_type, RevalidationType::None);
+}
+
+TEST_CASE(memory_cache_does_not_serve_stale_while_revalidate_responses_to_callers_that_cannot_revalidate)
+{
+    auto cache = HTTP::MemoryCache::create();
+    auto url = parse_url("https://example.com/stale"sv);
+    auto request_headers = create_cacheable_request_headers();
+    auto stale_response_headers = HTTP::HeaderList::create({
+        { "Cache-Control"sv, "max-age=0, stale-while-revalidate=60"sv },
+        { "Last-Modified"sv, "Wed, 21 Oct 2015 07:28:00 GMT"sv },
+    });
+
+    cache->create_entry(url, "GET"sv, *request_headers, UnixDateTime::now(), 200, "OK"sv, *stale_response_headers);
+    cache->finalize_entry(url, "GET"sv, *request_headers, 200, *stale_response_headers, immutable_bytes("stale"sv));
+
+    EXPECT(!has_response(*cache, url));
+    EXPECT_EQ(cache->statistics().size, 0u);
+}
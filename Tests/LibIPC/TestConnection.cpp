@@ -5,8 +5,11 @@
  */
 
 #include <AK/ByteString.h>
+#include <AK/Function.h>
 #include <AK/Queue.h>
 #include <AK/RefPtr.h>
+#include <AK/StringBuilder.h>
+#include <AK/Time.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Socket.h>
 #include <LibCore/System.h>
@@ -16,6 +19,8 @@
 #include <LibIPC/TransportSocket.h>
 #include <LibTest/TestCase.h>
 
+using namespace AK::TimeLiterals;
+
 namespace {
 
 constexpr u32 TEST_MAGIC = 0xCAFEF00D;
@@ -74,7 +79,7 @@ public:
     }
 
 protected:
-    OwnPtr<IPC::Message> try_parse_message(ReadonlyBytes, Queue<IPC::Attachment>&) override
+    OwnPtr<IPC::Message> try_parse_message(IPC::ReceivedMessageBytes const&, Queue<IPC::Attachment>&) override
     {
         return nullptr;
     }
@@ -120,3 +125,96 @@ TEST_CASE(sync_wait_failure_does_not_dispatch_queued_messages)
     EXPECT(!response);
     EXPECT_EQ(stub.handle_count(), 0u);
 }
+
+static void spin_until(Core::EventLoop& loop, Function<bool()> condition, AK::Duration timeout = 2000_ms)
+{
+    i64 const timeout_ms = timeout.to_milliseconds();
+    for (i64 elapsed_ms = 0; elapsed_ms < timeout_ms; elapsed_ms += 5) {
+        (void)loop.pump(Core::EventLoop::WaitMode::PollForEvents);
+        if (condition())
+            return;
+        MUST(Core::System::sleep_ms(5));
+    }
+
+    FAIL("Timed out waiting for condition");
+}
+
+static IPC::MessageBuffer message_buffer_for(char byte, IPC::MessageCoalescing coalescing = IPC::MessageCoalescing::None, i32 message_id = 0, u64 coalescing_key = 0)
+{
+    IPC::MessageBuffer buffer;
+    MUST(buffer.append_data(reinterpret_cast<u8 const*>(&byte), 1));
+    buffer.set_coalescing(coalescing, message_id, coalescing_key);
+    return buffer;
+}
+
+static void receive_messages(IPC::TransportSocket& transport, StringBuilder& received)
+{
+    transport.set_up_read_hook([&] {
+        (void)transport.read_as_many_messages_as_possible_without_blocking([&](auto&& raw_message) {
+            received.append(StringView { raw_message.bytes.bytes() });
+        });
+    });
+}
+
+TEST_CASE(coalesced_messages_are_sent_before_the_next_message)
+{
+    Core::EventLoop loop;
+
+    int fds[2] = {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    auto local_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[0]));
+    auto peer_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[1]));
+
+    MUST(local_socket->set_blocking(false));
+    MUST(peer_socket->set_blocking(false));
+
+    CountingStub stub;
+    auto connection = TestConnection::construct(stub, make<IPC::TransportSocket>(move(local_socket)));
+
+    IPC::TransportSocket peer(move(peer_socket));
+    StringBuilder received;
+    receive_messages(peer, received);
+
+    auto post = [&](IPC::MessageBuffer buffer) { MUST(connection->post_message(buffer)); };
+    post(message_buffer_for('A', IPC::MessageCoalescing::Latest, 1, 1));
+    post(message_buffer_for('B', IPC::MessageCoalescing::Latest, 1, 2));
+    post(message_buffer_for('C', IPC::MessageCoalescing::Batch, 2));
+    post(message_buffer_for('D', IPC::MessageCoalescing::Batch, 2));
+
+    // Replaces A, and is ordered after the messages that were held back before it.
+    post(message_buffer_for('E', IPC::MessageCoalescing::Latest, 1, 1));
+
+    post(message_buffer_for('F'));
+
+    spin_until(loop, [&] { return received.length() == 5; });
+    EXPECT_EQ(received.string_view(), "BCDEF"sv);
+}
+
+TEST_CASE(coalesced_messages_are_flushed_without_further_messages)
+{
+    Core::EventLoop loop;
+
+    int fds[2] = {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    auto local_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[0]));
+    auto peer_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[1]));
+
+    MUST(local_socket->set_blocking(false));
+    MUST(peer_socket->set_blocking(false));
+
+    CountingStub stub;
+    auto connection = TestConnection::construct(stub, make<IPC::TransportSocket>(move(local_socket)));
+
+    IPC::TransportSocket peer(move(peer_socket));
+    StringBuilder received;
+    receive_messages(peer, received);
+
+    auto post = [&](IPC::MessageBuffer buffer) { MUST(connection->post_message(buffer)); };
+    post(message_buffer_for('A', IPC::MessageCoalescing::Latest, 1, 1));
+    post(message_buffer_for('B', IPC::MessageCoalescing::Latest, 1, 1));
+
+    spin_until(loop, [&] { return received.length() == 1; });
+    EXPECT_EQ(received.string_view(), "B"sv);
+}
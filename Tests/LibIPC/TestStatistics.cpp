@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <AK/Queue.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibIPC/Statistics.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(statistics_aggregate_received_messages_by_name)
+{
+    IPC::Statistics::set_enabled(true);
+    auto& statistics = IPC::Statistics::the();
+
+    auto received_time = MonotonicTime::now();
+    auto after = [&](i64 milliseconds) { return received_time + AK::Duration::from_milliseconds(milliseconds); };
+
+    statistics.did_send_message(20);
+    statistics.did_receive_message("Test::Small"sv, 10);
+    statistics.did_receive_message("Test::Large"sv, 100);
+    statistics.did_receive_message("Test::Large"sv, 50);
+
+    statistics.did_handle_message("Test::Small"sv, received_time, after(1), after(2));
+    statistics.did_handle_message("Test::Large"sv, received_time, after(2), after(5));
+    statistics.did_handle_message("Test::Large"sv, received_time, after(6), after(8));
+
+    auto snapshot = statistics.snapshot();
+    EXPECT_EQ(snapshot.sent_message_count, 1u);
+    EXPECT_EQ(snapshot.sent_bytes, 20u);
+    EXPECT_EQ(snapshot.received_message_count, 3u);
+    EXPECT_EQ(snapshot.received_bytes, 160u);
+
+    // Messages are sorted by the total time spent in their handlers.
+    VERIFY(snapshot.messages.size() == 2);
+    auto const& large = snapshot.messages[0];
+    EXPECT_EQ(large.message_name, "Test::Large"sv);
+    EXPECT_EQ(large.count, 2u);
+    EXPECT_EQ(large.bytes, 150u);
+    EXPECT_EQ(large.handled_count, 2u);
+    EXPECT_EQ(large.total_queueing_delay, AK::Duration::from_milliseconds(8));
+    EXPECT_EQ(large.longest_queueing_delay, AK::Duration::from_milliseconds(6));
+    EXPECT_EQ(large.total_handler_time, AK::Duration::from_milliseconds(5));
+    EXPECT_EQ(large.longest_handler_time, AK::Duration::from_milliseconds(3));
+
+    auto const& small = snapshot.messages[1];
+    EXPECT_EQ(small.message_name, "Test::Small"sv);
+    EXPECT_EQ(small.count, 1u);
+    EXPECT_EQ(small.total_handler_time, AK::Duration::from_milliseconds(1));
+}
+
+TEST_CASE(traffic_statistics_round_trip)
+{
+    IPC::TrafficStatistics statistics;
+    statistics.recording_time = AK::Duration::from_seconds(3);
+    statistics.sent_message_count = 4;
+    statistics.sent_bytes = 400;
+    statistics.received_message_count = 2;
+    statistics.received_bytes = 64;
+    statistics.messages.append({
+        .message_name = "Test::Message"_string,
+        .count = 2,
+        .bytes = 64,
+        .total_queueing_delay = AK::Duration::from_microseconds(30),
+        .longest_queueing_delay = AK::Duration::from_microseconds(20),
+        .handled_count = 2,
+        .total_handler_time = AK::Duration::from_microseconds(500),
+        .longest_handler_time = AK::Duration::from_microseconds(300),
+    });
+
+    IPC::MessageBuffer buffer;
+    IPC::Encoder encoder { buffer };
+    MUST(encoder.encode(statistics));
+
+    FixedMemoryStream stream { buffer.data().span() };
+    Queue<IPC::Attachment> attachments;
+    IPC::Decoder decoder { stream, attachments };
+    auto decoded = MUST(decoder.decode<IPC::TrafficStatistics>());
+
+    EXPECT_EQ(decoded.recording_time, statistics.recording_time);
+    EXPECT_EQ(decoded.sent_message_count, 4u);
+    EXPECT_EQ(decoded.sent_bytes, 400u);
+    EXPECT_EQ(decoded.received_message_count, 2u);
+    EXPECT_EQ(decoded.received_bytes, 64u);
+
+    VERIFY(decoded.messages.size() == 1);
+    EXPECT_EQ(decoded.messages[0].message_name, "Test::Message"sv);
+    EXPECT_EQ(decoded.messages[0].count, 2u);
+    EXPECT_EQ(decoded.messages[0].bytes, 64u);
+    EXPECT_EQ(decoded.messages[0].total_queueing_delay, AK::Duration::from_microseconds(30));
+    EXPECT_EQ(decoded.messages[0].longest_queueing_delay, AK::Duration::from_microseconds(20));
+    EXPECT_EQ(decoded.messages[0].handled_count, 2u);
+    EXPECT_EQ(decoded.messages[0].total_handler_time, AK::Duration::from_microseconds(500));
+    EXPECT_EQ(decoded.messages[0].longest_handler_time, AK::Duration::from_microseconds(300));
+}
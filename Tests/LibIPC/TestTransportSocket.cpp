@@ -65,6 +65,78 @@ TEST_CASE(send_queue_does_not_send_message_bytes_without_fds)
     EXPECT_EQ(second_batch.fds.size(), 1u);
 }
 
+static IPC::MessageDataType payload_of(char byte)
+{
+    IPC::MessageDataType payload;
+    payload.append(byte);
+    return payload;
+}
+
+TEST_CASE(send_queue_sends_normal_priority_messages_ahead_of_low_priority_ones)
+{
+    auto queue = adopt_ref(*new IPC::SendQueue);
+    static constexpr size_t message_size = sizeof(IPC::SocketMessageHeader) + 1;
+
+    queue->enqueue_message({}, payload_of('A'), {}, IPC::MessagePriority::Low);
+    queue->enqueue_message({}, payload_of('B'), {}, IPC::MessagePriority::Low);
+
+    // Part of A has been handed to the socket, so A must be sent in full before anything else.
+    auto first_batch = queue->peek(1);
+    queue->discard(first_batch.bytes.size(), 0);
+
+    queue->enqueue_message({}, payload_of('C'), {});
+    queue->enqueue_message({}, payload_of('D'), {});
+
+    auto second_batch = queue->peek(4096);
+    EXPECT_EQ(second_batch.bytes.size(), 4 * message_size - 1);
+    EXPECT_EQ(second_batch.bytes[message_size - 2], static_cast<u8>('A'));
+    EXPECT_EQ(second_batch.bytes[2 * message_size - 2], static_cast<u8>('C'));
+    EXPECT_EQ(second_batch.bytes[3 * message_size - 2], static_cast<u8>('D'));
+    EXPECT_EQ(second_batch.bytes[4 * message_size - 2], static_cast<u8>('B'));
+}
+
+TEST_CASE(send_queue_keeps_normal_priority_messages_in_order)
+{
+    auto queue = adopt_ref(*new IPC::SendQueue);
+    static constexpr size_t message_size = sizeof(IPC::SocketMessageHeader) + 1;
+
+    queue->enqueue_message({}, payload_of('A'), {}, IPC::MessagePriority::Low);
+
+    // A message with file descriptors keeps its place in the queue, and so do the normal-priority messages after it.
+    Vector<int> fds;
+    fds.append(999);
+    queue->enqueue_message({}, payload_of('B'), move(fds));
+    queue->enqueue_message({}, payload_of('C'), {}, IPC::MessagePriority::Low);
+    queue->enqueue_message({}, payload_of('D'), {});
+
+    auto batch = queue->peek(4096);
+    EXPECT_EQ(batch.bytes.size(), 4 * message_size);
+    EXPECT_EQ(batch.bytes[message_size - 1], static_cast<u8>('A'));
+    EXPECT_EQ(batch.bytes[2 * message_size - 1], static_cast<u8>('B'));
+    EXPECT_EQ(batch.bytes[3 * message_size - 1], static_cast<u8>('D'));
+    EXPECT_EQ(batch.bytes[4 * message_size - 1], static_cast<u8>('C'));
+    EXPECT_EQ(batch.fds.size(), 1u);
+}
+
+TEST_CASE(send_queue_does_not_queue_messages_ahead_of_peeked_bytes)
+{
+    auto queue = adopt_ref(*new IPC::SendQueue);
+    static constexpr size_t message_size = sizeof(IPC::SocketMessageHeader) + 1;
+
+    queue->enqueue_message({}, payload_of('A'), {}, IPC::MessagePriority::Low);
+    queue->enqueue_message({}, payload_of('B'), {}, IPC::MessagePriority::Low);
+    auto first_batch = queue->peek(4096);
+    EXPECT_EQ(first_batch.bytes.size(), 2 * message_size);
+
+    // The IO thread may still be writing the peeked bytes, and it discards whatever it wrote from the front of the queue.
+    queue->enqueue_message({}, payload_of('C'), {});
+    queue->discard(first_batch.bytes.size(), 0);
+
+    auto second_batch = queue->peek(4096);
+    EXPECT_EQ(second_batch.bytes.size(), message_size);
+    EXPECT_EQ(second_batch.bytes[message_size - 1], static_cast<u8>('C'));
+}
+
 TEST_CASE(read_hook_is_notified_on_peer_hangup)
 {
     Core::EventLoop loop;
@@ -243,3 +315,96 @@ TEST_CASE(buffered_message_is_drained_when_io_thread_stops_without_reading_it)
 
     EXPECT_EQ(delivered.load(AK::MemoryOrder::memory_order_relaxed), 1u);
 }
+
+TEST_CASE(large_message_is_received_intact_through_shared_memory)
+{
+    Core::EventLoop loop;
+
+    int fds[2] = {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    auto sender_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[1]));
+    auto reader_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[0]));
+    MUST(sender_socket->set_blocking(false));
+    MUST(reader_socket->set_blocking(false));
+
+    IPC::TransportSocket sender(move(sender_socket));
+    IPC::TransportSocket transport(move(reader_socket));
+
+    IPC::MessageDataType payload;
+    for (size_t i = 0; i < IPC::TransportSocket::SHARED_MEMORY_PAYLOAD_THRESHOLD + 123; ++i)
+        payload.append(static_cast<u8>(i * 31));
+    auto expected_payload = payload;
+
+    auto pipe_fds = MUST(Core::System::pipe2(O_CLOEXEC));
+    ScopeGuard close_pipe_write_end = [&] { MUST(Core::System::close(pipe_fds[1])); };
+
+    Vector<IPC::Attachment> attachments;
+    attachments.append(IPC::Attachment::from_fd(pipe_fds[0]));
+    MUST(sender.post_message(move(payload), attachments));
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Vector<u8> received_payload;
+    IGNORE_USE_IN_ESCAPING_LAMBDA size_t received_attachment_count = 0;
+    IGNORE_USE_IN_ESCAPING_LAMBDA u32 delivered = 0;
+
+    transport.set_up_read_hook([&] {
+        (void)transport.read_as_many_messages_as_possible_without_blocking([&](IPC::TransportSocket::Message&& message) {
+            auto bytes = message.bytes.bytes();
+            received_payload.append(bytes.data(), bytes.size());
+            received_attachment_count = message.attachments.size();
+            ++delivered;
+        });
+    });
+
+    spin_until(loop, [&] {
+        return delivered > 0;
+    });
+
+    EXPECT_EQ(delivered, 1u);
+    EXPECT_EQ(received_attachment_count, 1u);
+    EXPECT(received_payload.span() == expected_payload.span());
+}
+
+TEST_CASE(shared_memory_payload_larger_than_its_segment_is_rejected)
+{
+    Core::EventLoop loop;
+
+    int fds[2] = {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    auto sender_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[1]));
+    auto reader_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[0]));
+    MUST(reader_socket->set_blocking(false));
+
+    // A hostile peer claims more payload than its segment holds, as if it had truncated the segment after sending it.
+    auto segment_fd = MUST(Core::System::anon_create(4096, O_CLOEXEC));
+    ScopeGuard close_segment = [&] { MUST(Core::System::close(segment_fd)); };
+
+    IPC::SocketMessageHeader header {
+        .type = IPC::SocketMessageHeader::Type::SharedMemoryPayload,
+        .payload_size = static_cast<u32>(IPC::TransportSocket::SHARED_MEMORY_PAYLOAD_THRESHOLD),
+        .fd_count = 1,
+    };
+    MUST(sender_socket->send_message({ &header, sizeof(header) }, 0, { segment_fd }));
+
+    IPC::TransportSocket transport(move(reader_socket));
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<u32> delivered = 0;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> observed_shutdown = false;
+
+    transport.set_up_read_hook([&] {
+        if (observed_shutdown.load(AK::MemoryOrder::memory_order_relaxed))
+            return;
+        auto should_shutdown = transport.read_as_many_messages_as_possible_without_blocking([&](auto&&) {
+            delivered.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        });
+        if (should_shutdown == IPC::TransportSocket::ShouldShutdown::Yes)
+            observed_shutdown.store(true, AK::MemoryOrder::memory_order_relaxed);
+    });
+
+    spin_until(loop, [&] {
+        return observed_shutdown.load(AK::MemoryOrder::memory_order_relaxed);
+    });
+
+    EXPECT_EQ(delivered.load(AK::MemoryOrder::memory_order_relaxed), 0u);
+}
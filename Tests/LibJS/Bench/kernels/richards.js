@@ -0,0 +1,89 @@
+// A small task scheduler in the spirit of the classic Richards benchmark, which is mostly polymorphic method calls on a
+// handful of classes.
+
+class Packet {
+    constructor(link, kind) {
+        this.link = link;
+        this.kind = kind;
+        this.value = 0;
+    }
+}
+
+class Task {
+    constructor(scheduler, priority) {
+        this.scheduler = scheduler;
+        this.priority = priority;
+        this.queue = [];
+        this.runCount = 0;
+    }
+
+    enqueue(packet) {
+        this.queue.push(packet);
+    }
+}
+
+class WorkerTask extends Task {
+    run(packet) {
+        ++this.runCount;
+        packet.value = (packet.value * 31 + this.priority) & 0xffff;
+        this.scheduler.send(packet.value % 2 === 0 ? "handlerA" : "handlerB", packet);
+    }
+}
+
+class HandlerTask extends Task {
+    run(packet) {
+        ++this.runCount;
+        packet.value ^= this.priority;
+        packet.kind = packet.kind === "data" ? "work" : "data";
+        this.scheduler.send("device", packet);
+    }
+}
+
+class DeviceTask extends Task {
+    run(packet) {
+        ++this.runCount;
+        this.scheduler.completed += 1;
+        if (this.scheduler.completed < this.scheduler.limit) this.scheduler.send("worker", packet);
+    }
+}
+
+class Scheduler {
+    constructor(limit) {
+        this.limit = limit;
+        this.completed = 0;
+        this.tasks = {
+            worker: new WorkerTask(this, 3),
+            handlerA: new HandlerTask(this, 5),
+            handlerB: new HandlerTask(this, 7),
+            device: new DeviceTask(this, 11),
+        };
+        this.order = Object.values(this.tasks);
+    }
+
+    send(name, packet) {
+        this.tasks[name].enqueue(packet);
+    }
+
+    schedule() {
+        let ran = true;
+        while (ran) {
+            ran = false;
+            for (const task of this.order) {
+                const packet = task.queue.shift();
+                if (packet === undefined) continue;
+                task.run(packet);
+                ran = true;
+            }
+        }
+    }
+}
+
+function benchmark() {
+    const scheduler = new Scheduler(10000);
+    for (let i = 0; i < 10; ++i) scheduler.send("worker", new Packet(null, "data"));
+    scheduler.schedule();
+    let runs = 0;
+    for (const task of scheduler.order) runs += task.runCount;
+    if (scheduler.completed < scheduler.limit) throw new Error(`Only ${scheduler.completed} packets completed`);
+    return runs;
+}
@@ -0,0 +1,118 @@
+// Inserts into and removes from a splay tree, which allocates many short-lived objects and stresses the GC.
+
+class Node {
+    constructor(key, value) {
+        this.key = key;
+        this.value = value;
+        this.left = null;
+        this.right = null;
+    }
+}
+
+class SplayTree {
+    constructor() {
+        this.root = null;
+        this.size = 0;
+    }
+
+    splay(key) {
+        if (this.root === null) return;
+        const dummy = new Node(null, null);
+        let left = dummy;
+        let right = dummy;
+        let current = this.root;
+        while (true) {
+            if (key < current.key) {
+                if (current.left === null) break;
+                if (key < current.left.key) {
+                    const temp = current.left;
+                    current.left = temp.right;
+                    temp.right = current;
+                    current = temp;
+                    if (current.left === null) break;
+                }
+                right.left = current;
+                right = current;
+                current = current.left;
+            } else if (key > current.key) {
+                if (current.right === null) break;
+                if (key > current.right.key) {
+                    const temp = current.right;
+                    current.right = temp.left;
+                    temp.left = current;
+                    current = temp;
+                    if (current.right === null) break;
+                }
+                left.right = current;
+                left = current;
+                current = current.right;
+            } else {
+                break;
+            }
+        }
+        left.right = current.left;
+        right.left = current.right;
+        current.left = dummy.right;
+        current.right = dummy.left;
+        this.root = current;
+    }
+
+    insert(key, value) {
+        if (this.root === null) {
+            this.root = new Node(key, value);
+            ++this.size;
+            return;
+        }
+        this.splay(key);
+        if (this.root.key === key) return;
+        const node = new Node(key, value);
+        if (key > this.root.key) {
+            node.left = this.root;
+            node.right = this.root.right;
+            this.root.right = null;
+        } else {
+            node.right = this.root;
+            node.left = this.root.left;
+            this.root.left = null;
+        }
+        this.root = node;
+        ++this.size;
+    }
+
+    remove(key) {
+        this.splay(key);
+        if (this.root === null || this.root.key !== key) return false;
+        if (this.root.left === null) {
+            this.root = this.root.right;
+        } else {
+            const right = this.root.right;
+            this.root = this.root.left;
+            this.splay(key);
+            this.root.right = right;
+        }
+        --this.size;
+        return true;
+    }
+}
+
+// A deterministic pseudo-random sequence, so that every run does the same work.
+function createRandom(seed) {
+    return () => {
+        seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+        return seed;
+    };
+}
+
+function benchmark() {
+    const random = createRandom(42);
+    const tree = new SplayTree();
+    const keys = [];
+    for (let i = 0; i < 4000; ++i) {
+        const key = random();
+        tree.insert(key, { payload: [key, key + 1], label: `node ${key}` });
+        keys.push(key);
+    }
+    for (let i = 0; i < keys.length; i += 2) tree.remove(keys[i]);
+    if (tree.size !== 2000) throw new Error(`Unexpected tree size ${tree.size}`);
+    return tree.size;
+}
@@ -0,0 +1,22 @@
+// Calls hot builtins, both directly and through aliases that the compiler can't recognize as builtins.
+
+const { floor, max } = Math;
+const isInteger = Number.isInteger;
+
+function benchmark() {
+    let total = 0;
+    const values = [];
+    for (let i = 0; i < 100000; ++i) {
+        const x = i / 3;
+        total += Math.floor(x) - floor(x);
+        total += Math.max(i & 15, 8) + max(i & 7, 4) - Math.min(i, 2);
+        if (Number.isInteger(x) && isInteger(i)) ++total;
+        values.push(i & 1);
+    }
+
+    const text = "abcdefghijklmnopqrstuvwxyz";
+    for (let i = 0; i < 100000; ++i) total += text.charCodeAt(i % text.length) & 1;
+
+    if (values.length !== 100000) throw new Error(`Unexpected length ${values.length}`);
+    return total;
+}
@@ -0,0 +1,30 @@
+// Creates and calls closures that capture variables of their enclosing functions.
+
+function makeCounter(step) {
+    let count = 0;
+    return {
+        increment: () => (count += step),
+        get: () => count,
+    };
+}
+
+function compose(f, g) {
+    return x => f(g(x));
+}
+
+function benchmark() {
+    let total = 0;
+    for (let i = 0; i < 20000; ++i) {
+        const counter = makeCounter(i & 7);
+        for (let j = 0; j < 10; ++j) counter.increment();
+        total += counter.get();
+    }
+
+    const addOne = x => x + 1;
+    const double = x => x * 2;
+    const composed = compose(addOne, double);
+    for (let i = 0; i < 200000; ++i) total += composed(i) & 1;
+
+    if (total !== 700000 + 200000) throw new Error(`Unexpected total ${total}`);
+    return total;
+}
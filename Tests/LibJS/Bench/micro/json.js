@@ -0,0 +1,24 @@
+// Serializes and parses a document of nested objects, arrays, strings and numbers.
+
+const document = {
+    version: 3,
+    items: Array.from({ length: 500 }, (_, i) => ({
+        id: i,
+        name: `item ${i}`,
+        price: i * 1.25,
+        tags: ["a", "b", `tag${i % 10}`],
+        available: i % 3 === 0,
+        dimensions: { width: i, height: i * 2, depth: null },
+    })),
+};
+
+function benchmark() {
+    let total = 0;
+    for (let i = 0; i < 5; ++i) {
+        const text = JSON.stringify(document);
+        const parsed = JSON.parse(text);
+        total += parsed.items.length + text.length;
+    }
+    if (total % 5 !== 0) throw new Error(`Unexpected total ${total}`);
+    return total;
+}
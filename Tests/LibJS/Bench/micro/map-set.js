@@ -0,0 +1,28 @@
+// Inserts, looks up and deletes keys in Maps and Sets, with both number and string keys.
+
+function benchmark() {
+    const map = new Map();
+    const set = new Set();
+    for (let i = 0; i < 20000; ++i) {
+        map.set(i, i * 2);
+        set.add(`key${i}`);
+    }
+
+    let hits = 0;
+    for (let i = 0; i < 40000; ++i) {
+        if (map.has(i)) hits += map.get(i) & 1 ? 0 : 1;
+        if (set.has(`key${i}`)) ++hits;
+    }
+
+    for (let i = 0; i < 20000; i += 2) {
+        map.delete(i);
+        set.delete(`key${i}`);
+    }
+
+    let sum = 0;
+    for (const [key, value] of map) sum += value - key;
+    for (const key of set) sum += key.length;
+
+    if (hits !== 40000 || map.size !== 10000 || set.size !== 10000) throw new Error("Unexpected collection results");
+    return sum;
+}
@@ -0,0 +1,25 @@
+// Creates, chains and awaits promises. The promise jobs run once the iteration's call into the interpreter returns, so
+// they are included in its time; the result is checked at the start of the next iteration.
+
+let lastResult = null;
+
+async function add(a, b) {
+    return a + b;
+}
+
+async function chain(length) {
+    let total = 0;
+    for (let i = 0; i < length; ++i) total = await add(total, 1);
+    return total;
+}
+
+function benchmark() {
+    if (lastResult !== null && lastResult !== 20000) throw new Error(`Unexpected result ${lastResult}`);
+
+    const promises = [];
+    for (let i = 0; i < 100; ++i) promises.push(chain(100).then(value => value * 2));
+    Promise.all(promises).then(values => {
+        lastResult = values.reduce((a, b) => a + b, 0);
+    });
+    return promises.length;
+}
@@ -0,0 +1,49 @@
+// Reads and writes properties on objects of a few shapes, so that inline caches see monomorphic and polymorphic sites.
+
+function createPoints() {
+    const points = [];
+    for (let i = 0; i < 1000; ++i) {
+        switch (i % 4) {
+        case 0:
+            points.push({ x: i, y: i + 1 });
+            break;
+        case 1:
+            points.push({ y: i + 1, x: i });
+            break;
+        case 2:
+            points.push({ x: i, y: i + 1, z: 0 });
+            break;
+        default:
+            points.push({ w: 0, x: i, y: i + 1 });
+            break;
+        }
+    }
+    return points;
+}
+
+const monomorphic = Array.from({ length: 1000 }, (_, i) => ({ x: i, y: i + 1 }));
+const polymorphic = createPoints();
+
+function sum(points) {
+    let total = 0;
+    for (let i = 0; i < points.length; ++i) total += points[i].x + points[i].y;
+    return total;
+}
+
+function move(points) {
+    for (let i = 0; i < points.length; ++i) {
+        points[i].x += 1;
+        points[i].x -= 1;
+    }
+}
+
+function benchmark() {
+    let total = 0;
+    for (let i = 0; i < 20; ++i) {
+        move(monomorphic);
+        move(polymorphic);
+        total += sum(monomorphic) + sum(polymorphic);
+    }
+    if (total !== 40000000) throw new Error(`Unexpected total ${total}`);
+    return total;
+}
@@ -0,0 +1,28 @@
+// Matches, captures and replaces with regular expressions.
+
+const lines = [];
+for (let i = 0; i < 2000; ++i) {
+    const month = String((i % 12) + 1).padStart(2, "0");
+    const day = String((i % 28) + 1).padStart(2, "0");
+    lines.push(`2026-${month}-${day} user${i}@example.com GET /path/${i}?q=${i * 7} 200`);
+}
+const log = lines.join("\n");
+
+function benchmark() {
+    let emails = 0;
+    for (const match of log.matchAll(/(\w+)@(\w+)\.com/g)) {
+        if (match[2] === "example") ++emails;
+    }
+
+    const dates = /^(\d{4})-(\d{2})-(\d{2})/gm;
+    let months = 0;
+    let match;
+    while ((match = dates.exec(log)) !== null) months += Number(match[2]);
+
+    const redacted = log.replace(/q=\d+/g, "q=?");
+    const words = log.split(/\s+/).length;
+
+    if (emails !== 2000 || words !== 10000 || redacted.includes("q=7 "))
+        throw new Error("Unexpected regular expression results");
+    return emails + months;
+}
@@ -0,0 +1,29 @@
+// Builds, slices, searches and compares strings.
+
+const words = ["lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit"];
+
+function benchmark() {
+    let text = "";
+    for (let i = 0; i < 20000; ++i) text += words[i % words.length] + " ";
+
+    let count = 0;
+    let index = text.indexOf("dolor");
+    while (index !== -1) {
+        ++count;
+        index = text.indexOf("dolor", index + 1);
+    }
+
+    const parts = text.split(" ");
+    let upper = 0;
+    for (const part of parts) {
+        if (part.toUpperCase().startsWith("CON")) ++upper;
+    }
+
+    const joined = parts.slice(0, 1000).join("-");
+    const replaced = joined.replaceAll("-", "+");
+    const padded = `${count}`.padStart(10, "0");
+
+    if (count !== 2500 || upper !== 2500 || replaced.length !== joined.length || padded !== "0000002500")
+        throw new Error("Unexpected string results");
+    return count + upper;
+}
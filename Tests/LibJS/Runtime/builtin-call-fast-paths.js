@@ -0,0 +1,114 @@
+test("Math.max and Math.min", () => {
+    const { max, min } = Math;
+
+    expect(Math.max(3, 7)).toBe(7);
+    expect(Math.min(3, 7)).toBe(3);
+    expect(Math.max(-5, -2147483648)).toBe(-5);
+    expect(Math.min(-5, -2147483648)).toBe(-2147483648);
+    expect(Math.max(1.5, 1)).toBe(1.5);
+    expect(Math.min(1.5, 1)).toBe(1);
+
+    expect(Math.max(-0, 0)).toBe(0);
+    expect(Math.max(0, -0)).toBe(0);
+    expect(Math.min(0, -0)).toBe(-0);
+    expect(Math.min(-0, 0)).toBe(-0);
+    expect(max(-0, 0)).toBe(0);
+    expect(min(0, -0)).toBe(-0);
+
+    expect(Math.max(NaN, 1)).toBeNaN();
+    expect(Math.min(1, NaN)).toBeNaN();
+    expect(max(1, NaN)).toBeNaN();
+    expect(min(NaN, 1)).toBeNaN();
+});
+
+test("Math.max and Math.min convert both arguments in order", () => {
+    const calls = [];
+    const lhs = {
+        valueOf() {
+            calls.push("lhs");
+            return NaN;
+        },
+    };
+    const rhs = {
+        valueOf() {
+            calls.push("rhs");
+            return 2;
+        },
+    };
+
+    expect(Math.max(lhs, rhs)).toBeNaN();
+    expect(Math.min(lhs, rhs)).toBeNaN();
+    expect(calls).toEqual(["lhs", "rhs", "lhs", "rhs"]);
+});
+
+test("Number.isInteger", () => {
+    const isInteger = Number.isInteger;
+
+    [Number.isInteger, isInteger].forEach(f => {
+        expect(f(1)).toBeTrue();
+        expect(f(-0)).toBeTrue();
+        expect(f(2 ** 53)).toBeTrue();
+        expect(f(1e300)).toBeTrue();
+        expect(f(1.5)).toBeFalse();
+        expect(f(-0.5)).toBeFalse();
+        expect(f(NaN)).toBeFalse();
+        expect(f(Infinity)).toBeFalse();
+        expect(f(-Infinity)).toBeFalse();
+        expect(f("1")).toBeFalse();
+        expect(f(1n)).toBeFalse();
+        expect(f(undefined)).toBeFalse();
+    });
+});
+
+test("Array.prototype.push on arrays that aren't simple", () => {
+    const frozen = Object.freeze([1, 2]);
+    expect(() => frozen.push(3)).toThrow(TypeError);
+    expect(frozen).toEqual([1, 2]);
+
+    const holey = [1, , 3];
+    expect(holey.push(4)).toBe(4);
+    expect(holey[3]).toBe(4);
+
+    const withReadOnlyLength = [1];
+    Object.defineProperty(withReadOnlyLength, "length", { writable: false });
+    expect(() => withReadOnlyLength.push(2)).toThrow(TypeError);
+    expect(withReadOnlyLength).toEqual([1]);
+
+    const pushed = [];
+    const arrayLike = { length: 0 };
+    const push = Array.prototype.push;
+    expect(push.call(arrayLike, "a")).toBe(1);
+    expect(arrayLike[0]).toBe("a");
+    expect(pushed.push()).toBe(0);
+    expect(pushed.push(1, 2, 3)).toBe(3);
+});
+
+test("Array.prototype.push sees setters on the prototype chain", () => {
+    let setValue;
+    Object.defineProperty(Array.prototype, "0", {
+        set(value) {
+            setValue = value;
+        },
+        configurable: true,
+    });
+
+    try {
+        const array = [];
+        expect(array.push("x")).toBe(1);
+        expect(setValue).toBe("x");
+        expect(Object.hasOwn(array, "0")).toBeFalse();
+    } finally {
+        delete Array.prototype[0];
+    }
+});
+
+test("reassigned builtins are called as usual", () => {
+    const originalMax = Math.max;
+    Math.max = () => "replaced";
+    try {
+        expect(Math.max(1, 2)).toBe("replaced");
+    } finally {
+        Math.max = originalMax;
+    }
+    expect(Math.max(1, 2)).toBe(2);
+});
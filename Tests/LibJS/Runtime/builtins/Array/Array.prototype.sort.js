@@ -89,6 +89,37 @@ describe("Array.prototype.sort", () => {
         expect(arr[2].other_property == 2);
     });
 
+    test("that it is stable for long arrays with runs", () => {
+        const items = [];
+        for (let i = 0; i < 1000; ++i) items.push({ key: i % 100 < 60 ? i : 1000 - i, index: i });
+        for (let i = 0; i < 1000; ++i) items.push({ key: i % 7, index: 1000 + i });
+
+        const sorted = [...items].sort((a, b) => a.key - b.key);
+        expect(sorted).toHaveLength(items.length);
+        for (let i = 1; i < sorted.length; ++i) {
+            expect(sorted[i - 1].key <= sorted[i].key).toBeTrue();
+            if (sorted[i - 1].key === sorted[i].key) expect(sorted[i - 1].index < sorted[i].index).toBeTrue();
+        }
+    });
+
+    test("that it orders numbers and strings by their strings without a compare function", () => {
+        let arr = [10, undefined, 9.5, -0, 1e21, 0, NaN, -1, Infinity, undefined, 0, -0];
+        arr.sort();
+        expect(arr).toEqual([-1, -0, 0, 0, -0, 10, 1e21, 9.5, Infinity, NaN, undefined, undefined]);
+        expect(Object.is(arr[1], -0)).toBeTrue();
+        expect(Object.is(arr[2], 0)).toBeTrue();
+        expect(Object.is(arr[3], 0)).toBeTrue();
+        expect(Object.is(arr[4], -0)).toBeTrue();
+
+        arr = ["b", undefined, "a", "\u{1F600}", "\uFFFF", "ab", "", "a"];
+        arr.sort();
+        expect(arr).toEqual(["", "a", "a", "ab", "b", "\u{1F600}", "\uFFFF", undefined]);
+
+        arr = [2, "10", 1, undefined, "1"];
+        arr.sort();
+        expect(arr).toEqual([1, "1", "10", 2, undefined]);
+    });
+
     test("that it makes no unnecessary calls to compare function", () => {
         expectNoCallCompareFunction = function (a, b) {
             expect().fail();
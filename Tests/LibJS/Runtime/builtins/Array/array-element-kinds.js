@@ -0,0 +1,87 @@
+describe("int32 arrays", () => {
+    test("indexOf and includes match numbers with an int32 value", () => {
+        const array = [1, 2, 3, -4, 0];
+        expect(array.indexOf(3)).toBe(2);
+        expect(array.indexOf(3.0)).toBe(2);
+        expect(array.indexOf(-4)).toBe(3);
+        expect(array.indexOf(-0)).toBe(4);
+        expect(array.indexOf(3.5)).toBe(-1);
+        expect(array.indexOf("3")).toBe(-1);
+        expect(array.indexOf(NaN)).toBe(-1);
+        expect(array.indexOf(3, 3)).toBe(-1);
+        expect(array.includes(-0)).toBeTrue();
+        expect(array.includes(NaN)).toBeFalse();
+        expect(array.includes(2 ** 40)).toBeFalse();
+    });
+
+    test("default sort orders by decimal string", () => {
+        const array = [10, 9, 1, -1, -10, -2, 100, 0, 2147483647, -2147483648, 21];
+        array.sort();
+        expect(array).toEqual([-1, -10, -2, -2147483648, 0, 1, 10, 100, 21, 2147483647, 9]);
+    });
+
+    test("storing a non-int32 value widens the array", () => {
+        const array = [1, 2, 3];
+        array[1] = 2.5;
+        expect(array.indexOf(2.5)).toBe(1);
+        expect(array.includes(2)).toBeFalse();
+        array[2] = "three";
+        expect(array.indexOf("three")).toBe(2);
+        array.sort();
+        expect(array).toEqual([1, 2.5, "three"]);
+    });
+});
+
+describe("number arrays", () => {
+    test("indexOf and includes compare numerically", () => {
+        const array = [1.5, 2, NaN, -0, Infinity];
+        expect(array.indexOf(2)).toBe(1);
+        expect(array.indexOf(0)).toBe(3);
+        expect(array.indexOf(NaN)).toBe(-1);
+        expect(array.indexOf(Infinity)).toBe(4);
+        expect(array.indexOf("2")).toBe(-1);
+        expect(array.includes(NaN)).toBeTrue();
+        expect(array.includes(0)).toBeTrue();
+        expect(array.includes(1.5, 1)).toBeFalse();
+    });
+});
+
+describe("fill", () => {
+    test("filling with an object keeps it reachable", () => {
+        const array = [1, 2, 3, 4];
+        array.fill({ value: 42 }, 1, 3);
+        gc();
+        expect(array[0]).toBe(1);
+        expect(array[1].value).toBe(42);
+        expect(array[2]).toBe(array[1]);
+        expect(array[3]).toBe(4);
+    });
+
+    test("filling with a double widens the array", () => {
+        const array = [1, 2, 3];
+        array.fill(0.5, 2);
+        expect(array).toEqual([1, 2, 0.5]);
+        expect(array.indexOf(0.5)).toBe(2);
+    });
+});
+
+describe("slice", () => {
+    test("slices keep their elements", () => {
+        const array = [1, 2.5, "three", { four: 4 }];
+        const slice = array.slice(1, 4);
+        gc();
+        expect(slice).toHaveLength(3);
+        expect(slice[0]).toBe(2.5);
+        expect(slice[1]).toBe("three");
+        expect(slice[2].four).toBe(4);
+        expect([1, 2, 3].slice(1).indexOf(3)).toBe(1);
+        expect([1, 2, 3].slice(2, 1)).toEqual([]);
+    });
+});
+
+test("objects stored into number arrays stay reachable", () => {
+    const array = [1, 2, 3];
+    for (let i = 0; i < array.length; ++i) array[i] = { index: i };
+    gc();
+    for (let i = 0; i < array.length; ++i) expect(array[i].index).toBe(i);
+});
@@ -70,4 +70,27 @@ test("basic functionality", () => {
     test("invariants", () => {
         expect(Atomics.wait).toHaveLength(4);
     });
+
+    test("value not equal", () => {
+        const buffer = new SharedArrayBuffer(4 * Int32Array.BYTES_PER_ELEMENT);
+        const typedArray = new Int32Array(buffer);
+        typedArray[1] = 42;
+        expect(Atomics.wait(typedArray, 1, 0, 0)).toBe("not-equal");
+
+        const bigBuffer = new SharedArrayBuffer(4 * BigInt64Array.BYTES_PER_ELEMENT);
+        const bigTypedArray = new BigInt64Array(bigBuffer);
+        bigTypedArray[1] = 42n;
+        expect(Atomics.wait(bigTypedArray, 1, 0n, 0)).toBe("not-equal");
+    });
+
+    test("timed out", () => {
+        const buffer = new SharedArrayBuffer(4 * Int32Array.BYTES_PER_ELEMENT);
+        const typedArray = new Int32Array(buffer);
+        expect(Atomics.wait(typedArray, 0, 0, 0)).toBe("timed-out");
+        expect(Atomics.wait(typedArray, 0, 0, 1)).toBe("timed-out");
+
+        const bigBuffer = new SharedArrayBuffer(4 * BigInt64Array.BYTES_PER_ELEMENT);
+        const bigTypedArray = new BigInt64Array(bigBuffer);
+        expect(Atomics.wait(bigTypedArray, 0, 0n, 0)).toBe("timed-out");
+    });
 });
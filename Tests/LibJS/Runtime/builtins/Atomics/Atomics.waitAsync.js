@@ -70,4 +70,45 @@ test("basic functionality", () => {
     test("invariants", () => {
         expect(Atomics.waitAsync).toHaveLength(4);
     });
+
+    test("value not equal", () => {
+        const buffer = new SharedArrayBuffer(4 * Int32Array.BYTES_PER_ELEMENT);
+        const typedArray = new Int32Array(buffer);
+        typedArray[0] = 1;
+
+        const result = Atomics.waitAsync(typedArray, 0, 0, 0);
+        expect(result.async).toBeFalse();
+        expect(result.value).toBe("not-equal");
+    });
+
+    test("zero timeout", () => {
+        const buffer = new SharedArrayBuffer(4 * Int32Array.BYTES_PER_ELEMENT);
+        const typedArray = new Int32Array(buffer);
+
+        const result = Atomics.waitAsync(typedArray, 0, 0, 0);
+        expect(result.async).toBeFalse();
+        expect(result.value).toBe("timed-out");
+    });
+
+    test("notified", () => {
+        const buffer = new SharedArrayBuffer(4 * Int32Array.BYTES_PER_ELEMENT);
+        const typedArray = new Int32Array(buffer);
+
+        const result = Atomics.waitAsync(typedArray, 0, 0);
+        expect(result.async).toBeTrue();
+        expect(result.value).toBeInstanceOf(Promise);
+
+        let resolutionValue;
+        result.value.then(value => {
+            resolutionValue = value;
+        });
+
+        expect(Atomics.notify(typedArray, 1)).toBe(0);
+        expect(Atomics.notify(typedArray, 0)).toBe(1);
+        expect(resolutionValue).toBeUndefined();
+
+        runQueuedPromiseJobs();
+        expect(resolutionValue).toBe("ok");
+        expect(Atomics.notify(typedArray, 0)).toBe(0);
+    });
 });
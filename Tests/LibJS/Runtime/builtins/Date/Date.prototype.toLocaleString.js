@@ -54,3 +54,17 @@ describe("correct behavior", () => {
         expect(d1.toLocaleString("ar-u-nu-arab", { timeStyle: "short", timeZone: "UTC" })).toBe("٧:٠٨ ص");
     });
 });
+
+test("follows changes to the system time zone", () => {
+    const originalTimeZone = setTimeZone("UTC");
+
+    const date = new Date(Date.UTC(2021, 11, 7, 17, 40, 50, 456));
+    expect(date.toLocaleString("en")).toBe("12/7/2021, 5:40:50 PM");
+    expect(date.toLocaleTimeString("en")).toBe("5:40:50 PM");
+
+    setTimeZone("America/New_York");
+    expect(date.toLocaleString("en")).toBe("12/7/2021, 12:40:50 PM");
+    expect(date.toLocaleTimeString("en")).toBe("12:40:50 PM");
+
+    setTimeZone(originalTimeZone);
+});
@@ -154,3 +154,34 @@ test("whitespace handling", () => {
     expect(JSON.parse("  {  }  ")).toEqual({});
     expect(JSON.parse("  [  ]  ")).toEqual([]);
 });
+
+test("arrays of objects with the same keys", () => {
+    const objects = JSON.parse('[{"a":1,"b":{"c":2}},{"a":3,"b":{"c":4}},{"a":5,"b":{"c":6}}]');
+    expect(objects).toEqual([
+        { a: 1, b: { c: 2 } },
+        { a: 3, b: { c: 4 } },
+        { a: 5, b: { c: 6 } },
+    ]);
+    expect(Object.keys(objects[2])).toEqual(["a", "b"]);
+});
+
+test("arrays of objects whose keys diverge", () => {
+    const objects = JSON.parse(
+        '[{"a":1,"b":2},{"a":3},{"a":4,"c":5},{"b":6,"a":7},{"a":8,"a":9},{"a":10,"\\u0062":11},{"a":12,"0":13},{"a":14,"b":15,"c":16},{"a":17,"b":18}]'
+    );
+    expect(objects).toEqual([
+        { a: 1, b: 2 },
+        { a: 3 },
+        { a: 4, c: 5 },
+        { b: 6, a: 7 },
+        { a: 9 },
+        { a: 10, b: 11 },
+        { a: 12, 0: 13 },
+        { a: 14, b: 15, c: 16 },
+        { a: 17, b: 18 },
+    ]);
+    expect(Object.keys(objects[3])).toEqual(["b", "a"]);
+    expect(Object.keys(objects[6])).toEqual(["0", "a"]);
+    expect(Object.keys(objects[8])).toEqual(["a", "b"]);
+    expect(objects[1].hasOwnProperty("b")).toBeFalse();
+});
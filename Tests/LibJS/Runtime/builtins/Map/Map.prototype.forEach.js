@@ -68,4 +68,44 @@ describe("normal behavior", () => {
 
         expect(visited).toEqual([["a", 0]]);
     });
+
+    test("deleting many entries during iteration keeps insertion order", () => {
+        const map = new Map();
+        for (let i = 0; i < 1000; ++i) map.set(i, i);
+
+        const visited = [];
+        map.forEach((value, key) => {
+            visited.push(key);
+            // Removing most entries shrinks and compacts the table while we are iterating it.
+            if (key === 0) {
+                for (let i = 1; i < 1000; ++i) {
+                    if (i % 100 !== 0) map.delete(i);
+                }
+            }
+            if (key === 500) map.set("added", -1);
+        });
+
+        expect(visited).toEqual([0, 100, 200, 300, 400, 500, 600, 700, 800, 900, "added"]);
+        expect(map.size).toBe(11);
+    });
+
+    test("entries added after clearing during iteration are visited", () => {
+        const map = new Map([
+            ["a", 0],
+            ["b", 1],
+        ]);
+        const visited = [];
+
+        map.forEach((value, key) => {
+            visited.push(key);
+            if (key === "a") {
+                map.clear();
+                map.set("c", 2);
+                map.set("a", 3);
+            }
+        });
+
+        expect(visited).toEqual(["a", "c", "a"]);
+        expect(Array.from(map.keys())).toEqual(["c", "a"]);
+    });
 });
@@ -76,3 +76,20 @@ describe("styles", () => {
         ).toBe("\u0661\u066b\u0662\u0663 كيلومتر في الساعة");
     });
 });
+
+describe("repeated calls", () => {
+    test("alternating locales", () => {
+        for (let i = 0; i < 20; ++i) {
+            expect((1234.5).toLocaleString("en")).toBe("1,234.5");
+            expect((1234.5).toLocaleString("de")).toBe("1.234,5");
+            expect((12).toLocaleString("ar-u-nu-arab")).toBe("\u0661\u0662");
+            expect((1234.5).toLocaleString(`en-x-p${i}`)).toBe("1,234.5");
+        }
+    });
+
+    test("options are not shared with calls that have none", () => {
+        expect((0.5).toLocaleString("en")).toBe("0.5");
+        expect((0.5).toLocaleString("en", { style: "percent" })).toBe("50%");
+        expect((0.5).toLocaleString("en")).toBe("0.5");
+    });
+});
@@ -73,6 +73,16 @@ test("basic functionality", () => {
     });
 });
 
+test("NaN and signed zeros", () => {
+    [Float16Array, Float32Array, Float64Array].forEach(T => {
+        const typedArray = new T([NaN, 0, 1, -0, -Infinity, NaN, -1, 0, Infinity]);
+        expect(typedArray.sort()).toBe(typedArray);
+        expect(Array.from(typedArray)).toEqual([-Infinity, -1, -0, 0, 0, 1, Infinity, NaN, NaN]);
+        expect(Object.is(typedArray[2], -0)).toBeTrue();
+        expect(Object.is(typedArray[3], 0)).toBeTrue();
+    });
+});
+
 test("detached buffer", () => {
     TYPED_ARRAYS.forEach(T => {
         const typedArray = new T(3);
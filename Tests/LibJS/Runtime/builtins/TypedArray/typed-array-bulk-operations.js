@@ -0,0 +1,194 @@
+const NUMBER_TYPED_ARRAYS = [
+    Uint8Array,
+    Uint8ClampedArray,
+    Uint16Array,
+    Uint32Array,
+    Int8Array,
+    Int16Array,
+    Int32Array,
+    Float16Array,
+    Float32Array,
+    Float64Array,
+];
+
+const BIGINT_TYPED_ARRAYS = [BigUint64Array, BigInt64Array];
+
+// Long enough for every element size to span several vectors, with elements left over at the end.
+const LENGTH = 77;
+
+describe("search", () => {
+    test("finds elements anywhere in long arrays", () => {
+        NUMBER_TYPED_ARRAYS.forEach(T => {
+            const typedArray = new T(LENGTH);
+            typedArray[0] = 1;
+            typedArray[40] = 2;
+            typedArray[LENGTH - 1] = 1;
+
+            expect(typedArray.indexOf(1)).toBe(0);
+            expect(typedArray.indexOf(1, 1)).toBe(LENGTH - 1);
+            expect(typedArray.indexOf(2)).toBe(40);
+            expect(typedArray.indexOf(2, 41)).toBe(-1);
+            expect(typedArray.lastIndexOf(1)).toBe(LENGTH - 1);
+            expect(typedArray.lastIndexOf(1, LENGTH - 2)).toBe(0);
+            expect(typedArray.lastIndexOf(2, 39)).toBe(-1);
+            expect(typedArray.includes(2, -LENGTH)).toBe(true);
+            expect(typedArray.includes(3)).toBe(false);
+        });
+
+        BIGINT_TYPED_ARRAYS.forEach(T => {
+            const typedArray = new T(LENGTH);
+            typedArray[50] = 5n;
+
+            expect(typedArray.indexOf(5n)).toBe(50);
+            expect(typedArray.lastIndexOf(5n)).toBe(50);
+            expect(typedArray.includes(5n)).toBe(true);
+            expect(typedArray.indexOf(5)).toBe(-1);
+            expect(typedArray.includes(2n ** 64n + 5n)).toBe(false);
+        });
+    });
+
+    test("values that the element type cannot represent are not found", () => {
+        const uint8Array = new Uint8Array(LENGTH);
+        uint8Array[10] = 255;
+        expect(uint8Array.indexOf(-1)).toBe(-1);
+        expect(uint8Array.indexOf(255.5)).toBe(-1);
+        expect(uint8Array.indexOf(255 + 256)).toBe(-1);
+        expect(uint8Array.indexOf("255")).toBe(-1);
+        expect(uint8Array.indexOf(255n)).toBe(-1);
+        expect(uint8Array.indexOf(255)).toBe(10);
+
+        const float32Array = new Float32Array(LENGTH);
+        float32Array[20] = 0.1;
+        expect(float32Array.indexOf(0.1)).toBe(-1);
+        expect(float32Array.indexOf(Math.fround(0.1))).toBe(20);
+    });
+
+    test("zeros and NaN", () => {
+        [Float16Array, Float32Array, Float64Array].forEach(T => {
+            const typedArray = new T(LENGTH).fill(1);
+            typedArray[30] = -0;
+            typedArray[60] = NaN;
+
+            expect(typedArray.indexOf(0)).toBe(30);
+            expect(typedArray.lastIndexOf(-0)).toBe(30);
+            expect(typedArray.includes(+0)).toBe(true);
+            expect(typedArray.indexOf(NaN)).toBe(-1);
+            expect(typedArray.lastIndexOf(NaN)).toBe(-1);
+            expect(typedArray.includes(NaN)).toBe(true);
+            expect(typedArray.includes(NaN, 61)).toBe(false);
+        });
+
+        expect(new Int32Array(LENGTH).includes(NaN)).toBe(false);
+    });
+
+    test("elements past a length that shrank while converting fromIndex are undefined", () => {
+        const arrayBuffer = new ArrayBuffer(LENGTH, { maxByteLength: LENGTH });
+        const typedArray = new Uint8Array(arrayBuffer);
+        const fromIndex = {
+            valueOf() {
+                arrayBuffer.resize(10);
+                return 0;
+            },
+        };
+        expect(typedArray.includes(undefined, fromIndex)).toBe(true);
+    });
+});
+
+test("fill converts the value once for every element type", () => {
+    NUMBER_TYPED_ARRAYS.forEach(T => {
+        const typedArray = new T(LENGTH).fill(1.5, 10, -10);
+        const expected = T === Float16Array || T === Float32Array || T === Float64Array ? 1.5 : 1;
+        const expectedClamped = T === Uint8ClampedArray ? 2 : expected;
+
+        expect(typedArray[9]).toBe(0);
+        expect(typedArray[10]).toBe(expectedClamped);
+        expect(typedArray[LENGTH - 11]).toBe(expectedClamped);
+        expect(typedArray[LENGTH - 10]).toBe(0);
+    });
+
+    expect(new Uint8Array(4).fill(257)[3]).toBe(1);
+    expect(new Int8Array(4).fill(-129)[3]).toBe(127);
+    expect(new Uint8ClampedArray(4).fill(300)[3]).toBe(255);
+    expect(new BigInt64Array(4).fill(2n ** 63n)[3]).toBe(-(2n ** 63n));
+    expect(new BigUint64Array(4).fill(-1n)[3]).toBe(2n ** 64n - 1n);
+});
+
+test("reverse keeps every element for all element sizes", () => {
+    [...NUMBER_TYPED_ARRAYS, ...BIGINT_TYPED_ARRAYS].forEach(T => {
+        [0, 1, 2, 3, LENGTH, LENGTH + 1].forEach(length => {
+            const isBigInt = T === BigUint64Array || T === BigInt64Array;
+            const values = Array.from({ length }, (_, i) => (isBigInt ? BigInt(i) : i));
+            const typedArray = new T(values);
+
+            expect(typedArray.reverse()).toBe(typedArray);
+            expect(Array.from(typedArray)).toEqual(values.reverse());
+        });
+    });
+
+    const float32Array = new Float32Array([NaN, 1, -0]);
+    float32Array.reverse();
+    expect(Object.is(float32Array[0], -0)).toBeTrue();
+    expect(float32Array[2]).toBeNaN();
+});
+
+describe("conversion between element types", () => {
+    const SOURCE_VALUES = [0, -0, 1, -1, 1.5, 2.5, -2.5, 127, 128, 255.5, 256, 65537, -(2 ** 31), 2 ** 32 + 3, 1e20];
+    const SPECIAL_VALUES = [NaN, Infinity, -Infinity];
+
+    test("set from another typed array", () => {
+        [Float64Array, Float32Array, Int32Array].forEach(S => {
+            NUMBER_TYPED_ARRAYS.forEach(T => {
+                const source = new S([...SOURCE_VALUES, ...(S === Int32Array ? [] : SPECIAL_VALUES)]);
+                const target = new T(source.length + 2);
+                target.set(source, 1);
+
+                const expected = new T(source.length + 2);
+                for (let i = 0; i < source.length; ++i) expected[i + 1] = source[i];
+
+                expect(Array.from(target)).toEqual(Array.from(expected));
+            });
+        });
+    });
+
+    test("set between BigInt typed arrays", () => {
+        const source = new BigInt64Array([-1n, 2n, -(2n ** 63n)]);
+        const target = new BigUint64Array(3);
+        target.set(source);
+        expect(Array.from(target)).toEqual([2n ** 64n - 1n, 2n, 2n ** 63n]);
+    });
+
+    test("set from a view of the same buffer", () => {
+        const buffer = new ArrayBuffer(16);
+        const bytes = new Uint8Array(buffer);
+        bytes.set([1, 2, 3, 4, 5, 6, 7, 8]);
+        const words = new Uint16Array(buffer);
+        words.set(bytes.subarray(0, 4));
+        expect(Array.from(words.subarray(0, 4))).toEqual([1, 2, 3, 4]);
+    });
+
+    test("slice into a typed array of another type", () => {
+        class Float32Species extends Uint8Array {
+            static get [Symbol.species]() {
+                return Float32Array;
+            }
+        }
+
+        const source = new Float32Species([1, 2, 250, 255]);
+        const sliced = source.slice(1);
+        expect(sliced).toBeInstanceOf(Float32Array);
+        expect(Array.from(sliced)).toEqual([2, 250, 255]);
+
+        class SameBufferSpecies extends Uint8Array {
+            static get [Symbol.species]() {
+                return function (length) {
+                    return new Uint16Array(overlappingSource.buffer, 0, length);
+                };
+            }
+        }
+
+        const overlappingSource = new SameBufferSpecies([1, 2, 3, 4, 5, 6]);
+        const overlappingSlice = overlappingSource.slice(1, 3);
+        expect(overlappingSlice).toBeInstanceOf(Uint16Array);
+        expect(Array.from(overlappingSlice)).toEqual([2, 3]);
+    });
+});
@@ -1611,3 +1611,79 @@ describe("polymorphic IC boundary tests", () => {
         expect(sum).toBe(100);
     });
 });
+
+describe("megamorphic IC", () => {
+    test("own properties across many shapes", () => {
+        function getValue(obj) {
+            return obj.value;
+        }
+
+        const shapes = [];
+        for (let i = 0; i < 16; i++) {
+            const obj = {};
+            obj["padding" + i] = i;
+            obj.value = i;
+            shapes.push(obj);
+        }
+
+        let sum = 0;
+        for (let i = 0; i < 1600; i++) {
+            sum += getValue(shapes[i % 16]);
+        }
+        expect(sum).toBe(12000);
+    });
+
+    test("prototype chain properties across many shapes", () => {
+        function getValue(obj) {
+            return obj.inherited;
+        }
+
+        const proto = { inherited: 5 };
+        const shapes = [];
+        for (let i = 0; i < 16; i++) {
+            const obj = Object.create(proto);
+            obj["own" + i] = i;
+            shapes.push(obj);
+        }
+
+        let sum = 0;
+        for (let i = 0; i < 1600; i++) {
+            sum += getValue(shapes[i % 16]);
+        }
+        expect(sum).toBe(8000);
+
+        proto.inherited = 7;
+        expect(getValue(shapes[3])).toBe(7);
+
+        Object.defineProperty(proto, "inherited", { get: () => 9 });
+        for (let i = 0; i < 16; i++) {
+            expect(getValue(shapes[i])).toBe(9);
+        }
+
+        shapes[5].inherited = 1;
+        expect(getValue(shapes[5])).toBe(1);
+        expect(getValue(shapes[6])).toBe(9);
+    });
+
+    test("prototype replacement invalidates megamorphic entries", () => {
+        function getValue(obj) {
+            return obj.inherited;
+        }
+
+        const shapes = [];
+        for (let i = 0; i < 16; i++) {
+            const obj = Object.create({ inherited: i });
+            obj["own" + i] = i;
+            shapes.push(obj);
+        }
+
+        for (let i = 0; i < 160; i++) {
+            getValue(shapes[i % 16]);
+        }
+
+        Object.setPrototypeOf(shapes[2], { inherited: 100 });
+        expect(getValue(shapes[2])).toBe(100);
+        delete Object.getPrototypeOf(shapes[4]).inherited;
+        expect(getValue(shapes[4])).toBeUndefined();
+    });
+});
@@ -11,3 +11,54 @@ test("basic that non-strict direct eval() prevents non-local access caching", ()
     expect(foo(false)).toBe(1);
     expect(foo(true)).toBe(2);
 });
+
+test("cached lookups through an eval-tainted function see bindings that eval adds later", () => {
+    function outer() {
+        var a = "outer";
+        return function inner(code) {
+            var results = [];
+            for (var i = 0; i < 3; ++i) results.push(a);
+            eval(code);
+            for (var i = 0; i < 3; ++i) results.push(a);
+            return results;
+        };
+    }
+
+    const inner = outer();
+    expect(inner("")).toEqual(["outer", "outer", "outer", "outer", "outer", "outer"]);
+    expect(inner("var a = 'inner';")).toEqual(["outer", "outer", "outer", "inner", "inner", "inner"]);
+});
+
+test("cached lookups into an eval-tainted function environment", () => {
+    function outer() {
+        var a = 1;
+        eval("var b = 2;");
+        return function inner() {
+            a += 1;
+            return a + b;
+        };
+    }
+
+    const inner = outer();
+    expect(inner()).toBe(4);
+    expect(inner()).toBe(5);
+    expect(inner()).toBe(6);
+});
+
+test("bindings that eval adds and deletes are not cached", () => {
+    var results = [];
+    var x = "outer";
+    function f() {
+        eval("var x = 'eval';");
+        function read() {
+            return x;
+        }
+        results.push(read());
+        results.push(read());
+        delete x;
+        results.push(read());
+        results.push(read());
+    }
+    f();
+    expect(results).toEqual(["eval", "eval", "outer", "outer"]);
+});
@@ -757,3 +757,43 @@ describe("await observably looks up constructor of Promise objects", () => {
     runQueuedPromiseJobs();
     expect(calls).toBe(4);
 });
+
+describe("repeated awaits of pending promises", () => {
+    test("resume in the same order as equivalent then() reactions", () => {
+        const log = [];
+        const resolvers = [];
+        const pending = () => new Promise(resolve => resolvers.push(resolve));
+
+        async function f(name) {
+            for (let i = 0; i < 3; ++i) log.push(`${name}${await pending()}`);
+        }
+        f("a");
+        f("b");
+        for (let i = 0; i < 3; ++i) {
+            resolvers.splice(0).forEach((resolve, index) => resolve(i * 2 + index));
+            Promise.resolve().then(() => log.push(`then${i}`));
+            runQueuedPromiseJobs();
+        }
+        expect(log).toEqual(["a0", "b1", "then0", "a2", "b3", "then1", "a4", "b5", "then2"]);
+    });
+
+    test("alternate between fulfilled and rejected resumptions", () => {
+        const results = [];
+        async function f() {
+            for (let i = 0; i < 4; ++i) {
+                try {
+                    const promise = new Promise((resolve, reject) => (i % 2 ? reject : resolve)(i));
+                    results.push(await promise.then(value => value));
+                } catch (error) {
+                    results.push(`caught ${error}`);
+                }
+            }
+            return "done";
+        }
+        let returnValue;
+        f().then(value => (returnValue = value));
+        runQueuedPromiseJobs();
+        expect(results).toEqual([0, "caught 1", 2, "caught 3"]);
+        expect(returnValue).toBe("done");
+    });
+});
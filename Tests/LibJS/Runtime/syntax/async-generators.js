@@ -73,3 +73,22 @@ test("async generator instances use the intrinsic prototype when function protot
         expect(Object.getPrototypeOf(generator())).toBe(AsyncGeneratorPrototype);
     }
 });
+
+test("async generators resume correctly after repeated awaits of pending promises", () => {
+    async function* generator() {
+        for (let i = 0; i < 3; ++i) {
+            try {
+                yield await new Promise((resolve, reject) => Promise.resolve().then(() => (i === 1 ? reject : resolve)(i)));
+            } catch (error) {
+                yield `caught ${error}`;
+            }
+        }
+    }
+
+    const values = [];
+    (async () => {
+        for await (const value of generator()) values.push(value);
+    })();
+    runQueuedPromiseJobs();
+    expect(values).toEqual([0, "caught 1", 2]);
+});
@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <AK/ScopeGuard.h>
+#include <AK/Utf16String.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Environment.h>
+#include <LibCore/File.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibGC/Heap.h>
+#include <LibJS/Bytecode/Debug.h>
+#include <LibJS/Runtime/AbstractOperations.h>
+#include <LibJS/Runtime/FunctionObject.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/ValueInlines.h>
+#include <LibJS/Script.h>
+#include <LibMain/Main.h>
+#include <errno.h>
+#include <math.h>
+
+#if defined(AK_OS_LINUX)
+#    include <sched.h>
+#endif
+
+namespace JSBench {
+
+struct Options {
+    ByteString bench_root_path;
+    Vector<ByteString> benchmark_globs;
+    size_t warmup_iterations { 3 };
+    size_t iterations { 10 };
+    Optional<size_t> pinned_cpu;
+    ByteString output_path;
+    ByteString baseline_path;
+    double regression_threshold_percent { 5 };
+};
+
+static Options s_options;
+
+// Medians that moved by less than this are timer noise, however large the relative change.
+static constexpr double REGRESSION_FLOOR_IN_MILLISECONDS = 0.1;
+
+struct Benchmark {
+    ByteString name;
+    ByteString path;
+};
+
+static ErrorOr<void> collect_benchmarks(Vector<Benchmark>& benchmarks, ByteString const& path, ByteString const& root_path)
+{
+    if (FileSystem::is_directory(path)) {
+        Core::DirIterator it(path, Core::DirIterator::Flags::SkipDots);
+        while (it.has_next())
+            TRY(collect_benchmarks(benchmarks, LexicalPath::join(path, it.next_path()).string(), root_path));
+        return {};
+    }
+
+    if (!path.ends_with(".js"sv))
+        return {};
+
+    auto name = LexicalPath::relative_path(path, root_path).value_or(path);
+    if (!s_options.benchmark_globs.is_empty() && !any_of(s_options.benchmark_globs, [&](auto const& glob) { return name.matches(glob); }))
+        return {};
+
+    benchmarks.append({ move(name), path });
+    return {};
+}
+
+static ErrorOr<void> pin_to_cpu(size_t cpu)
+{
+#if defined(AK_OS_LINUX)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) < 0)
+        return Error::from_syscall("sched_setaffinity"sv, errno);
+    return {};
+#else
+    (void)cpu;
+    return Error::from_string_literal("Pinning to a CPU is only supported on Linux");
+#endif
+}
+
+// What the GC, compiler and interpreter did while some iterations ran.
+struct EngineCounters {
+    u64 collection_count { 0 };
+    AK::Duration collection_time;
+    u64 allocated_bytes { 0 };
+    JS::Bytecode::Statistics bytecode;
+};
+
+class EngineCounterScope {
+    AK_MAKE_NONCOPYABLE(EngineCounterScope);
+    AK_MAKE_NONMOVABLE(EngineCounterScope);
+
+public:
+    explicit EngineCounterScope(GC::Heap& heap)
+        : m_heap(heap)
+        , m_collection_count_at_start(heap.collection_count())
+        , m_allocated_bytes_at_start(heap.total_allocated_bytes())
+        , m_bytecode_at_start(JS::Bytecode::g_statistics)
+    {
+        m_heap.on_collection_finished = [this](auto const& statistics) {
+            m_collection_time += statistics.mark_time + statistics.sweep_time;
+        };
+    }
+
+    ~EngineCounterScope()
+    {
+        m_heap.on_collection_finished = nullptr;
+    }
+
+    EngineCounters counters() const
+    {
+        auto const& bytecode = JS::Bytecode::g_statistics;
+        return {
+            .collection_count = m_heap.collection_count() - m_collection_count_at_start,
+            .collection_time = m_collection_time,
+            .allocated_bytes = m_heap.total_allocated_bytes() - m_allocated_bytes_at_start,
+            .bytecode = {
+                .executable_count = bytecode.executable_count - m_bytecode_at_start.executable_count,
+                .bytecode_bytes = bytecode.bytecode_bytes - m_bytecode_at_start.bytecode_bytes,
+                .interpreter_entry_count = bytecode.interpreter_entry_count - m_bytecode_at_start.interpreter_entry_count,
+                .builtin_call_count = bytecode.builtin_call_count - m_bytecode_at_start.builtin_call_count,
+                .builtin_call_miss_count = bytecode.builtin_call_miss_count - m_bytecode_at_start.builtin_call_miss_count,
+                .baseline_jit_executable_count = bytecode.baseline_jit_executable_count - m_bytecode_at_start.baseline_jit_executable_count,
+                .baseline_jit_code_bytes = bytecode.baseline_jit_code_bytes - m_bytecode_at_start.baseline_jit_code_bytes,
+            },
+        };
+    }
+
+private:
+    GC::Heap& m_heap;
+    u64 m_collection_count_at_start { 0 };
+    u64 m_allocated_bytes_at_start { 0 };
+    JS::Bytecode::Statistics m_bytecode_at_start;
+    AK::Duration m_collection_time;
+};
+
+static JsonObject counters_to_json(EngineCounters const& counters)
+{
+    JsonObject gc;
+    gc.set("collections"sv, counters.collection_count);
+    gc.set("milliseconds"sv, counters.collection_time.to_nanoseconds() / 1'000'000.0);
+    gc.set("allocated_bytes"sv, counters.allocated_bytes);
+
+    JsonObject bytecode;
+    bytecode.set("executables"sv, counters.bytecode.executable_count);
+    bytecode.set("bytes"sv, counters.bytecode.bytecode_bytes);
+    bytecode.set("interpreter_entries"sv, counters.bytecode.interpreter_entry_count);
+    bytecode.set("builtin_calls"sv, counters.bytecode.builtin_call_count);
+    bytecode.set("builtin_call_misses"sv, counters.bytecode.builtin_call_miss_count);
+    bytecode.set("baseline_jit_executables"sv, counters.bytecode.baseline_jit_executable_count);
+    bytecode.set("baseline_jit_bytes"sv, counters.bytecode.baseline_jit_code_bytes);
+
+    JsonObject json;
+    json.set("gc"sv, move(gc));
+    json.set("bytecode"sv, move(bytecode));
+    return json;
+}
+
+static double percentile(Vector<double> const& sorted_values, size_t percentile)
+{
+    // Nearest-rank percentile.
+    return sorted_values[max(ceil_div(percentile * sorted_values.size(), 100uz), 1uz) - 1];
+}
+
+static ErrorOr<JsonObject> run_benchmark(JS::VM& vm, Benchmark const& benchmark)
+{
+    auto file = TRY(Core::File::open(benchmark.path, Core::File::OpenMode::Read));
+    auto source = Utf16String::from_utf8(StringView { TRY(file->read_until_eof()) });
+
+    // Every benchmark gets a realm of its own, and starts out with a heap that holds no garbage of the previous one.
+    auto execution_context = JS::create_simple_execution_context<JS::GlobalObject>(vm);
+    auto& realm = *execution_context->realm;
+    ScopeGuard pop_execution_context = [&] { vm.pop_execution_context(); };
+    vm.heap().collect_garbage();
+
+    auto describe_exception = [&](JS::Value exception) -> Error {
+        warnln("{}: Uncaught exception: {}", benchmark.name, exception);
+        return Error::from_string_literal("Benchmark threw an exception");
+    };
+
+    // Parsing, compiling and running the top-level code happens once, and is reported separately.
+    auto load_start_time = MonotonicTime::now();
+    Optional<EngineCounters> load_counters;
+    {
+        EngineCounterScope scope { vm.heap() };
+
+        auto script = JS::Script::parse(source.utf16_view(), realm, benchmark.path);
+        if (script.is_error()) {
+            warnln("{}: {}", benchmark.name, script.error()[0].to_utf16_string());
+            return Error::from_string_literal("Benchmark has a syntax error");
+        }
+        if (auto result = vm.run(*script.value()); result.is_error())
+            return describe_exception(result.error_value());
+
+        load_counters = scope.counters();
+    }
+    auto load_time = MonotonicTime::now() - load_start_time;
+
+    auto benchmark_function = MUST(realm.global_object().get("benchmark"_utf16_fly_string));
+    if (!benchmark_function.is_function())
+        return Error::from_string_literal("Benchmark does not define a benchmark() function");
+
+    auto run_iteration = [&]() -> ErrorOr<void> {
+        // NB: This is the outermost call into the interpreter, so any promise jobs the iteration queued run before
+        //     it returns, and are timed along with it.
+        if (auto result = JS::call(vm, benchmark_function.as_function(), JS::js_undefined()); result.is_error())
+            return describe_exception(result.error_value());
+        return {};
+    };
+
+    for (size_t i = 0; i < s_options.warmup_iterations; ++i)
+        TRY(run_iteration());
+
+    Vector<double> samples;
+    samples.ensure_capacity(s_options.iterations);
+
+    EngineCounterScope scope { vm.heap() };
+    for (size_t i = 0; i < s_options.iterations; ++i) {
+        auto start_time = MonotonicTime::now();
+        TRY(run_iteration());
+        samples.unchecked_append((MonotonicTime::now() - start_time).to_nanoseconds() / 1'000'000.0);
+    }
+    auto counters = scope.counters();
+
+    double total = 0;
+    for (auto sample : samples)
+        total += sample;
+
+    auto sorted_samples = samples;
+    quick_sort(sorted_samples);
+    auto median = percentile(sorted_samples, 50);
+
+    JsonArray sample_array;
+    for (auto sample : samples)
+        sample_array.must_append(sample);
+
+    JsonObject load;
+    load.set("milliseconds"sv, load_time.to_nanoseconds() / 1'000'000.0);
+    load.set("counters"sv, counters_to_json(*load_counters));
+
+    JsonObject report;
+    // Iterations per second of the median iteration, so that higher is better.
+    report.set("score"sv, median > 0 ? 1000.0 / median : 0.0);
+    report.set("min"sv, sorted_samples.first());
+    report.set("p50"sv, median);
+    report.set("p90"sv, percentile(sorted_samples, 90));
+    report.set("max"sv, sorted_samples.last());
+    report.set("mean"sv, total / samples.size());
+    report.set("samples"sv, move(sample_array));
+    report.set("load"sv, move(load));
+    report.set("counters"sv, counters_to_json(counters));
+    return report;
+}
+
+static ErrorOr<size_t> count_regressions_against_baseline(JsonObject const& benchmarks, StringView baseline_path)
+{
+    auto file = TRY(Core::File::open(baseline_path, Core::File::OpenMode::Read));
+    auto baseline = TRY(JsonValue::from_string(TRY(file->read_until_eof())));
+    if (!baseline.is_object() || !baseline.as_object().get_object("benchmarks"sv).has_value())
+        return Error::from_string_literal("Baseline is not a js-bench report");
+    auto const& baseline_benchmarks = *baseline.as_object().get_object("benchmarks"sv);
+
+    auto threshold = 1 + s_options.regression_threshold_percent / 100;
+    size_t regression_count = 0;
+
+    benchmarks.for_each_member([&](String const& name, JsonValue const& report) {
+        auto baseline_report = baseline_benchmarks.get_object(name);
+        if (!baseline_report.has_value())
+            return;
+
+        auto current = report.as_object().get_double_with_precision_loss("p50"sv).value_or(0);
+        auto previous = baseline_report->get_double_with_precision_loss("p50"sv).value_or(0);
+        if (current - previous <= REGRESSION_FLOOR_IN_MILLISECONDS || current <= previous * threshold)
+            return;
+
+        warnln("Regression in {}: median went from {:.3}ms to {:.3}ms", name, previous, current);
+        ++regression_count;
+    });
+
+    return regression_count;
+}
+
+static ErrorOr<int> run_benchmarks()
+{
+    Vector<Benchmark> benchmarks;
+    auto root_path = TRY(FileSystem::real_path(s_options.bench_root_path));
+    TRY(collect_benchmarks(benchmarks, root_path, root_path));
+    quick_sort(benchmarks, [](auto const& a, auto const& b) { return a.name < b.name; });
+
+    if (benchmarks.is_empty()) {
+        warnln("Error: No benchmarks to run.");
+        return 1;
+    }
+
+    auto vm = JS::VM::create();
+    JS::Bytecode::g_collect_statistics = true;
+
+    JsonObject benchmark_reports;
+    Vector<double> scores;
+    size_t failed_benchmark_count = 0;
+
+    for (auto const& benchmark : benchmarks) {
+        warnln("Running {}", benchmark.name);
+
+        auto report = run_benchmark(*vm, benchmark);
+        if (report.is_error()) {
+            warnln("Error: {}: {}", benchmark.name, report.error());
+            ++failed_benchmark_count;
+            continue;
+        }
+
+        scores.append(report.value().get_double_with_precision_loss("score"sv).value_or(0));
+        benchmark_reports.set(benchmark.name, report.release_value());
+    }
+
+    // The geometric mean weighs every benchmark the same, however long its iterations take.
+    double log_score_sum = 0;
+    for (auto score : scores)
+        log_score_sum += log(max(score, 1e-9));
+
+    JsonObject report;
+    report.set("warmup_iterations"sv, s_options.warmup_iterations);
+    report.set("iterations"sv, s_options.iterations);
+    if (s_options.pinned_cpu.has_value())
+        report.set("cpu"sv, *s_options.pinned_cpu);
+    report.set("score"sv, scores.is_empty() ? 0.0 : exp(log_score_sum / scores.size()));
+    report.set("benchmarks"sv, benchmark_reports);
+
+    if (s_options.output_path.is_empty()) {
+        outln("{}", report.serialized());
+    } else {
+        auto output_file = TRY(Core::File::open(s_options.output_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(output_file->write_until_depleted(report.serialized()));
+    }
+
+    size_t regression_count = 0;
+    if (!s_options.baseline_path.is_empty())
+        regression_count = TRY(count_regressions_against_baseline(benchmark_reports, s_options.baseline_path));
+
+    return failed_benchmark_count + regression_count == 0 ? 0 : 1;
+}
+
+}
+
+ErrorOr<int> ladybird_main(Main::Arguments arguments)
+{
+    auto& options = JSBench::s_options;
+    if (auto ladybird_source_dir = Core::Environment::get("LADYBIRD_SOURCE_DIR"sv); ladybird_source_dir.has_value())
+        options.bench_root_path = LexicalPath::join(*ladybird_source_dir, "Tests"sv, "LibJS"sv, "Bench"sv).string();
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Runs the JavaScript benchmark corpus and reports the timings and engine counters as JSON.");
+    args_parser.add_option(options.bench_root_path, "Path containing the benchmark corpus", "bench-path", 0, "path");
+    args_parser.add_option(options.benchmark_globs, "Only run benchmarks matching the given glob", "filter", 'f', "glob");
+    args_parser.add_option(options.warmup_iterations, "Number of iterations run before measuring (default: 3)", "warmup", 'w', "count");
+    args_parser.add_option(options.iterations, "Number of measured iterations (default: 10)", "iterations", 'n', "count");
+    args_parser.add_option(options.pinned_cpu, "Pin the process to the given CPU, to keep timings stable", "cpu", 0, "index");
+    args_parser.add_option(options.output_path, "Write the JSON report to this file instead of stdout", "output", 'o', "path");
+    args_parser.add_option(options.baseline_path, "Compare against the JSON report of an earlier run, failing on regressions", "baseline", 'b', "path");
+    args_parser.add_option(options.regression_threshold_percent, "Slowdown of a median that counts as a regression (default: 5)", "threshold", 't', "percent");
+    args_parser.parse(arguments);
+
+    if (options.bench_root_path.is_empty()) {
+        warnln("Error: --bench-path must be passed to specify the location of the benchmark corpus.");
+        return 1;
+    }
+    if (options.iterations == 0) {
+        warnln("Error: --iterations must be at least 1.");
+        return 1;
+    }
+    options.bench_root_path = LexicalPath::absolute_path(TRY(FileSystem::current_working_directory()), options.bench_root_path);
+
+    if (options.pinned_cpu.has_value())
+        TRY(JSBench::pin_to_cpu(*options.pinned_cpu));
+
+    return JSBench::run_benchmarks();
+}
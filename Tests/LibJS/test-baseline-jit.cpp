@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Platform.h>
+#include <AK/ScopeGuard.h>
+#include <LibJS/Bytecode/Debug.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+// NB: asmintgen only emits baseline JIT templates for x86_64 ELF. Everywhere else, the same scripts must give the same
+//     results in the interpreter.
+#if ARCH(X86_64) && !defined(AK_OS_MACOS) && !defined(AK_OS_WINDOWS)
+static constexpr bool baseline_jit_is_supported = true;
+#else
+static constexpr bool baseline_jit_is_supported = false;
+#endif
+
+struct RunResult {
+    i32 value { 0 };
+    u64 compiled_executable_count { 0 };
+};
+
+static RunResult run(StringView source)
+{
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+
+    JS::Bytecode::g_collect_statistics = true;
+    ScopeGuard stop_collecting_statistics = [] { JS::Bytecode::g_collect_statistics = false; };
+    auto compiled_executable_count_before = JS::Bytecode::g_statistics.baseline_jit_executable_count;
+
+    auto script_or_error = JS::Script::parse(Utf16String::from_utf8(source), realm, "baseline-jit.js"sv);
+    VERIFY(!script_or_error.is_error());
+    auto result = vm->run(script_or_error.release_value());
+    VERIFY(!result.is_throw_completion());
+
+    return {
+        .value = MUST(result.value().to_i32(*vm)),
+        .compiled_executable_count = JS::Bytecode::g_statistics.baseline_jit_executable_count - compiled_executable_count_before,
+    };
+}
+
+TEST_CASE(hot_loop_tiers_up_in_the_middle_of_running)
+{
+    auto result = run(R"~~~(
+var sum = 0;
+for (let i = 0; i < 5000; ++i)
+    sum = (sum + i * 3) | 0;
+sum;
+)~~~"sv);
+    EXPECT_EQ(result.value, 37492500);
+    if constexpr (baseline_jit_is_supported)
+        EXPECT_EQ(result.compiled_executable_count, 1u);
+}
+
+TEST_CASE(cold_code_stays_in_the_interpreter)
+{
+    auto result = run(R"~~~(
+var sum = 0;
+for (let i = 0; i < 10; ++i)
+    sum += i;
+sum;
+)~~~"sv);
+    EXPECT_EQ(result.value, 45);
+    EXPECT_EQ(result.compiled_executable_count, 0u);
+}
+
+// Calls and returns run in the interpreter, so this moves back and forth between the tiers all the time, and property
+// accesses go through the same inline caches in both.
+TEST_CASE(hot_callee_is_entered_from_compiled_and_interpreted_callers)
+{
+    auto result = run(R"~~~(
+function length(point) {
+    return point.x * point.x + point.y * point.y;
+}
+
+function sum_of_lengths(count) {
+    var sum = 0;
+    for (let i = 0; i < count; ++i)
+        sum = (sum + length({ x: i % 7, y: i % 5 })) | 0;
+    return sum;
+}
+
+var total = 0;
+for (let i = 0; i < 20; ++i)
+    total = (total + sum_of_lengths(200)) | 0;
+total + [1, 2, 3].map(value => length({ x: value, y: 0 })).length;
+)~~~"sv);
+    EXPECT_EQ(result.value, 20 * 3762 + 3);
+    if constexpr (baseline_jit_is_supported)
+        EXPECT(result.compiled_executable_count >= 2u);
+}
+
+TEST_CASE(exceptions_unwind_out_of_compiled_code)
+{
+    auto result = run(R"~~~(
+function check(value) {
+    if (value % 100 === 99)
+        throw value;
+    return value;
+}
+
+var sum = 0;
+for (let i = 0; i < 3000; ++i) {
+    try {
+        sum = (sum + check(i)) | 0;
+    } catch (value) {
+        sum = (sum - value) | 0;
+    }
+}
+sum;
+)~~~"sv);
+    // Every value is added, except for the ones ending in 99, which are subtracted.
+    i32 expected = 0;
+    for (i32 i = 0; i < 3000; ++i)
+        expected += i % 100 == 99 ? -i : i;
+    EXPECT_EQ(result.value, expected);
+    if constexpr (baseline_jit_is_supported)
+        EXPECT(result.compiled_executable_count >= 2u);
+}
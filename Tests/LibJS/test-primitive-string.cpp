@@ -6,6 +6,7 @@
 
 #include <AK/StringView.h>
 #include <AK/Try.h>
+#include <AK/Utf16StringBuilder.h>
 #include <LibGC/Root.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/Realm.h>
@@ -107,6 +108,53 @@ TEST_CASE(primitive_string_concat_longer_strings_stays_deferred)
     EXPECT(concatenated->utf16_string_view() == "abcdefgh"sv);
 }
 
+TEST_CASE(primitive_string_concat_loop_reading_the_string_matches_builder)
+{
+    TestVM test_vm;
+
+    auto start = "start"_utf16;
+    auto string = PrimitiveString::create(*test_vm.vm, start);
+    Utf16StringBuilder expected;
+    expected.append(start);
+
+    for (size_t i = 0; i < 5000; ++i) {
+        auto chunk = i == 2500 ? "😀"_utf16 : Utf16String::number(i);
+        string = PrimitiveString::create(*test_vm.vm, *string, *PrimitiveString::create(*test_vm.vm, chunk));
+        expected.append(chunk);
+
+        EXPECT_EQ(string->length_in_utf16_code_units(), expected.length_in_code_units());
+        if (i % 1000 == 0)
+            EXPECT(string->utf16_string_view() == expected.view());
+    }
+
+    EXPECT(string->utf16_string_view() == expected.view());
+    EXPECT(string->utf16_string() == expected.to_string());
+}
+
+TEST_CASE(primitive_string_concat_onto_shared_prefix_keeps_both_strings)
+{
+    TestVM test_vm;
+
+    auto prefix = PrimitiveString::create(*test_vm.vm, "x"_utf16);
+    for (size_t i = 0; i < 300; ++i) {
+        prefix = PrimitiveString::create(*test_vm.vm, *prefix, *PrimitiveString::create(*test_vm.vm, "yz"_utf16));
+        (void)prefix->utf16_string_view();
+    }
+    auto prefix_string = prefix->utf16_string();
+
+    auto first = PrimitiveString::create(*test_vm.vm, *prefix, *PrimitiveString::create(*test_vm.vm, "first"_utf16));
+    auto second = PrimitiveString::create(*test_vm.vm, *prefix, *PrimitiveString::create(*test_vm.vm, "second"_utf16));
+    auto longer_first = PrimitiveString::create(*test_vm.vm, *first, *PrimitiveString::create(*test_vm.vm, "!"_utf16));
+
+    EXPECT(prefix->utf16_string() == prefix_string);
+    EXPECT(first->utf16_string() == Utf16String::formatted("{}first", prefix_string));
+    EXPECT(second->utf16_string() == Utf16String::formatted("{}second", prefix_string));
+    EXPECT(longer_first->utf16_string() == Utf16String::formatted("{}first!", prefix_string));
+
+    auto substring = PrimitiveString::create(*test_vm.vm, *first, prefix_string.length_in_code_units(), 5);
+    EXPECT(substring->utf16_string_view() == "first"sv);
+}
+
 TEST_CASE(primitive_string_substring_reuses_cached_single_ascii_strings)
 {
     TestVM test_vm;
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/Time.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+// Pushes and unwinds inline frames as fast as it can, both by returning and by throwing, and calls into natives that
+// call back into JavaScript, so that samples land while the running execution context is being changed.
+static constexpr auto sampled_source = R"~~~(
+function recurse(depth) {
+    if (depth === 0)
+        throw new Error("unwound");
+    return recurse(depth - 1) + 1;
+}
+
+function count(depth) {
+    return depth === 0 ? 0 : count(depth - 1) + 1;
+}
+
+var total = 0;
+for (let i = 0; i < 200; ++i) {
+    try {
+        recurse(50);
+    } catch {
+        total += count(50);
+    }
+    total += [1, 2, 3].map(value => value * 2).length;
+}
+total;
+)~~~"sv;
+
+static JS::SamplingProfiler::Options fast_sampling_options()
+{
+    return { .interval = AK::Duration::from_microseconds(50), .maximum_sample_count = 10'000, .maximum_frame_count = 1'000'000 };
+}
+
+TEST_CASE(start_rejects_invalid_options)
+{
+    auto vm = JS::VM::create();
+
+    auto options = fast_sampling_options();
+    options.interval = AK::Duration::zero();
+    auto result = JS::SamplingProfiler::start(*vm, options);
+    VERIFY(result.is_error());
+    EXPECT_EQ(result.error().code(), EINVAL);
+
+    options = fast_sampling_options();
+    options.maximum_sample_count = 0;
+    result = JS::SamplingProfiler::start(*vm, options);
+    VERIFY(result.is_error());
+    EXPECT_EQ(result.error().code(), EINVAL);
+}
+
+TEST_CASE(only_one_profiler_runs_at_a_time)
+{
+    auto vm = JS::VM::create();
+
+    auto profiler = TRY_OR_FAIL(JS::SamplingProfiler::start(*vm, fast_sampling_options()));
+    auto second_profiler = JS::SamplingProfiler::start(*vm, fast_sampling_options());
+    VERIFY(second_profiler.is_error());
+    EXPECT_EQ(second_profiler.error().code(), EBUSY);
+
+    profiler->stop();
+    EXPECT(!profiler->is_running());
+
+    auto next_profiler = TRY_OR_FAIL(JS::SamplingProfiler::start(*vm, fast_sampling_options()));
+    EXPECT(next_profiler->is_running());
+}
+
+TEST_CASE(samples_while_frames_are_pushed_and_unwound)
+{
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+
+    auto source = Utf16String::from_utf8(sampled_source);
+    auto profiler = TRY_OR_FAIL(JS::SamplingProfiler::start(*vm, fast_sampling_options()));
+
+    // NB: Keep running until some samples have been taken, so that slow machines still get coverage, but give up
+    //     eventually so that a profiler that never samples fails instead of hanging.
+    auto deadline = MonotonicTime::now() + AK::Duration::from_seconds(10);
+    while (profiler->sample_count() == 0 && MonotonicTime::now() < deadline) {
+        auto script_or_error = JS::Script::parse(source, realm, "sampled.js"sv);
+        VERIFY(!script_or_error.is_error());
+
+        auto result = vm->run(script_or_error.release_value());
+        VERIFY(!result.is_throw_completion());
+        EXPECT_EQ(MUST(result.value().to_i32(*vm)), 200 * 53);
+    }
+    profiler->stop();
+
+    auto sample_count = profiler->sample_count();
+    EXPECT(sample_count > 0);
+
+    auto profile = profiler->to_gecko_profile("main"sv);
+    EXPECT_EQ(profile.get_object("meta"sv)->get_u64("droppedSampleCount"sv), profiler->dropped_sample_count());
+
+    auto const& threads = *profile.get_array("threads"sv);
+    EXPECT_EQ(threads.size(), 1u);
+    auto const& thread = threads.at(0).as_object();
+
+    auto const& samples = *thread.get_object("samples"sv)->get_array("data"sv);
+    auto const& stacks = *thread.get_object("stackTable"sv)->get_array("data"sv);
+    auto const& frames = *thread.get_object("frameTable"sv)->get_array("data"sv);
+    auto const& strings = *thread.get_array("stringTable"sv);
+    EXPECT_EQ(samples.size(), sample_count);
+
+    // Every sample must resolve to a stack, every stack to a frame, and every frame to a location, which only holds if
+    // no sample recorded a frame that was half set up or already released.
+    for (auto const& sample : samples.values()) {
+        auto const& stack = sample.as_array().at(0);
+        if (stack.is_null())
+            continue;
+        EXPECT(stack.as_integer<u64>() < stacks.size());
+    }
+    for (auto const& stack : stacks.values()) {
+        auto const& prefix = stack.as_array().at(0);
+        if (!prefix.is_null())
+            EXPECT(prefix.as_integer<u64>() < stacks.size());
+        EXPECT(stack.as_array().at(1).as_integer<u64>() < frames.size());
+    }
+    for (auto const& frame : frames.values())
+        EXPECT(frame.as_array().at(0).as_integer<u64>() < strings.size());
+}
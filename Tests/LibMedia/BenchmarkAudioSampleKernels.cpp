@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/FixedArray.h>
+#include <LibMedia/Audio/SampleKernels.h>
+#include <LibTest/TestCase.h>
+
+// A minute of audio at 48kHz.
+static constexpr size_t BENCHMARK_FRAME_COUNT = 48'000 * 60;
+
+static FixedArray<float> make_samples(size_t count, float offset)
+{
+    auto samples = MUST(FixedArray<float>::create(count));
+    for (size_t i = 0; i < count; ++i)
+        samples[i] = offset + static_cast<float>(i);
+    return samples;
+}
+
+TEST_CASE(add_samples_includes_the_tail)
+{
+    auto destination = make_samples(7, 0);
+    auto source = make_samples(7, 100);
+    Audio::add_samples(destination.span(), source.span());
+    for (size_t i = 0; i < destination.size(); ++i)
+        EXPECT_EQ(destination[i], 100.0f + static_cast<float>(i * 2));
+}
+
+TEST_CASE(interleave_and_deinterleave_stereo_round_trip)
+{
+    auto left = make_samples(9, 0);
+    auto right = make_samples(9, 1000);
+
+    auto interleaved = MUST(FixedArray<float>::create(18));
+    Audio::interleave_stereo(interleaved.span(), left.span(), right.span());
+    for (size_t frame = 0; frame < left.size(); ++frame) {
+        EXPECT_EQ(interleaved[frame * 2], left[frame]);
+        EXPECT_EQ(interleaved[(frame * 2) + 1], right[frame]);
+    }
+
+    auto decoded_left = MUST(FixedArray<float>::create(9));
+    auto decoded_right = MUST(FixedArray<float>::create(9));
+    Audio::deinterleave_stereo(decoded_left.span(), decoded_right.span(), interleaved.span());
+    for (size_t frame = 0; frame < left.size(); ++frame) {
+        EXPECT_EQ(decoded_left[frame], left[frame]);
+        EXPECT_EQ(decoded_right[frame], right[frame]);
+    }
+}
+
+BENCHMARK_CASE(add_samples)
+{
+    auto destination = make_samples(BENCHMARK_FRAME_COUNT, 0);
+    auto source = make_samples(BENCHMARK_FRAME_COUNT, 1);
+    for (size_t i = 0; i < 100; ++i)
+        Audio::add_samples(destination.span(), source.span());
+}
+
+BENCHMARK_CASE(interleave_stereo)
+{
+    auto left = make_samples(BENCHMARK_FRAME_COUNT, 0);
+    auto right = make_samples(BENCHMARK_FRAME_COUNT, 1);
+    auto interleaved = MUST(FixedArray<float>::create(BENCHMARK_FRAME_COUNT * 2));
+    for (size_t i = 0; i < 100; ++i)
+        Audio::interleave_stereo(interleaved.span(), left.span(), right.span());
+}
+
+BENCHMARK_CASE(deinterleave_stereo)
+{
+    auto interleaved = make_samples(BENCHMARK_FRAME_COUNT * 2, 0);
+    auto left = MUST(FixedArray<float>::create(BENCHMARK_FRAME_COUNT));
+    auto right = MUST(FixedArray<float>::create(BENCHMARK_FRAME_COUNT));
+    for (size_t i = 0; i < 100; ++i)
+        Audio::deinterleave_stereo(left.span(), right.span(), interleaved.span());
+}
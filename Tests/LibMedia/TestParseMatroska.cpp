@@ -668,6 +668,23 @@ TEST_CASE(seeking)
     }
 }
 
+TEST_CASE(keyframe_index_finds_latest_keyframe_at_or_before)
+{
+    auto index = adopt_ref(*new Media::Matroska::KeyframeIndex);
+    index->add(1, { .position = 300, .timestamp = AK::Duration::from_seconds(3) });
+    index->add(1, { .position = 100, .timestamp = AK::Duration::from_seconds(1) });
+    index->add(1, { .position = 200, .timestamp = AK::Duration::from_seconds(2) });
+    index->add(1, { .position = 200, .timestamp = AK::Duration::from_seconds(2) });
+    index->add(2, { .position = 50, .timestamp = AK::Duration::zero() });
+
+    EXPECT(!index->find_at_or_before(1, AK::Duration::from_milliseconds(500)).has_value());
+    EXPECT_EQ(index->find_at_or_before(1, AK::Duration::from_seconds(1))->position, 100u);
+    EXPECT_EQ(index->find_at_or_before(1, AK::Duration::from_milliseconds(2500))->position, 200u);
+    EXPECT_EQ(index->find_at_or_before(1, AK::Duration::from_seconds(60))->position, 300u);
+    EXPECT_EQ(index->find_at_or_before(2, AK::Duration::from_seconds(60))->position, 50u);
+    EXPECT(!index->find_at_or_before(3, AK::Duration::from_seconds(60)).has_value());
+}
+
 TEST_CASE(opus_frame_duration)
 {
     auto file = MUST(Core::File::open("./vp9_in_webm.webm"sv, Core::File::OpenMode::Read));
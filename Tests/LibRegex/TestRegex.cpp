@@ -175,6 +175,41 @@ TEST_CASE(ascii_ignore_case_literal_alternation_respects_source_order)
     EXPECT_EQ(regex.capture_slot(1), 3);
 }
 
+TEST_CASE(literal_search_finds_matches_across_long_inputs)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 37; ++i)
+        builder.append("xyzzy-abcd-abc-"sv);
+    auto ascii_subject = Utf16String::from_utf8(builder.string_view());
+    builder.append("éabcd"sv);
+    auto utf16_subject = Utf16String::from_utf8(builder.string_view());
+
+    struct Test {
+        StringView pattern;
+        regex::ECMAScriptCompileFlags flags;
+        int ascii_match_count;
+        int utf16_match_count;
+        int first_match_start;
+        int second_match_start;
+    };
+
+    static constexpr Test tests[] {
+        { "abcd"sv, {}, 37, 38, 6, 21 },
+        { "ABC-"sv, { .ignore_case = true }, 37, 37, 11, 26 },
+        { "zy|cd|c-"sv, {}, 111, 112, 3, 8 },
+    };
+
+    for (auto const& test : tests) {
+        auto regex = compile_regex(test.pattern, test.flags);
+        for (auto const& subject : { ascii_subject, utf16_subject }) {
+            auto expected_match_count = subject.is_ascii() ? test.ascii_match_count : test.utf16_match_count;
+            EXPECT_EQ(regex.find_all(subject, 0), expected_match_count);
+            EXPECT_EQ(regex.find_all_match(0).start, test.first_match_start);
+            EXPECT_EQ(regex.find_all_match(1).start, test.second_match_start);
+        }
+    }
+}
+
 TEST_CASE(unicode_ignore_case_literal_alternation_preserves_behavior)
 {
     auto regex = MUST(compile_regex_result("s|k"sv, { .ignore_case = true, .unicode = true }));
@@ -739,3 +774,51 @@ TEST_CASE(restored_long_fork_chain_coverage)
 
     EXPECT_EQ(regex.test(utf16_subject, 0), regex::MatchResult::Match);
 }
+
+TEST_CASE(exponential_backtracking_patterns_complete)
+{
+    auto regex = compile_regex("(?:a|aa)+(?:b|c)"sv);
+    auto subject = MUST(String::repeated('a', 5000));
+    auto utf16_subject = Utf16String::from_utf8(subject.bytes_as_string_view());
+
+    EXPECT_EQ(regex.test(utf16_subject, 0), regex::MatchResult::NoMatch);
+    EXPECT_EQ(regex.exec(utf16_subject, 0), regex::MatchResult::NoMatch);
+
+    auto matching_subject = Utf16String::from_utf8(MUST(String::formatted("{}c", subject)));
+    EXPECT_EQ(regex.exec(matching_subject, 0), regex::MatchResult::Match);
+    EXPECT_EQ(regex.capture_slot(0), 0);
+    EXPECT_EQ(regex.capture_slot(1), 5001);
+}
+
+TEST_CASE(leftmost_first_match_bounds_and_captures)
+{
+    struct Test {
+        StringView pattern;
+        StringView subject;
+        int start;
+        int end;
+    };
+
+    static constexpr Test tests[] {
+        { "a|ab"sv, "xab"sv, 1, 2 },
+        { "ab|a"sv, "xab"sv, 1, 3 },
+        { "[ab]+?b"sv, "xaabb"sv, 1, 4 },
+        { "(?:a|b)*c"sv, "abab abc"sv, 5, 8 },
+        { "(?:.{0,2}?)?"sv, "bAA"sv, 0, 1 },
+        { "(?:x*)*y|\\bz"sv, "xz z"sv, 3, 4 },
+    };
+
+    for (auto const& test : tests) {
+        auto regex = compile_regex(test.pattern, { .global = true });
+        auto subject = Utf16String::from_utf8(test.subject);
+        EXPECT_EQ(regex.exec(subject, 0), regex::MatchResult::Match);
+        EXPECT_EQ(regex.capture_slot(0), test.start);
+        EXPECT_EQ(regex.capture_slot(1), test.end);
+    }
+
+    auto regex = compile_regex("(\\d+)-(\\d+?)"sv);
+    auto subject = Utf16String::from_utf8("a 12-345"sv);
+    EXPECT_EQ(regex.exec(subject, 0), regex::MatchResult::Match);
+    expect_capture_eq(regex, subject, 1, "12"sv);
+    expect_capture_eq(regex, subject, 2, "3"sv);
+}
@@ -5,6 +5,7 @@
  */
 
 #include <AK/String.h>
+#include <AK/Utf16String.h>
 #include <AK/Vector.h>
 #include <LibTest/TestCase.h>
 #include <LibTextCodec/Decoder.h>
@@ -256,3 +257,37 @@ TEST_CASE(test_utf16le_process_code_points)
     EXPECT_EQ(process_code_points(decoder, StringView(bytes({ 'A', 0x00, 0xff }))), (Vector<u32> { 0x41, 0xfffd }));
     EXPECT_EQ(MUST(decoder.to_utf8(StringView(bytes({ 'A', 0x00, 0xff })), TextCodec::IgnoreBOM::No, TextCodec::ErrorMode::Replacement)), "A\xef\xbf\xbd"sv);
 }
+
+TEST_CASE(test_to_utf16)
+{
+    auto& utf16le_decoder = decoder_for("UTF-16LE"sv);
+    EXPECT_EQ(MUST(utf16le_decoder.to_utf16("s\x00\xe4\x00k\x00=\xd8\x00\xde"sv)), u"säk😀"sv);
+    EXPECT_EQ(MUST(utf16le_decoder.to_utf16(StringView(bytes({ 'A', 0x00, 0xff })))), u"A\ufffd"sv);
+
+    auto& utf8_decoder = decoder_for("UTF-8"sv);
+    EXPECT_EQ(MUST(utf8_decoder.to_utf16("well hello friends, this is a longer ASCII string \xf0\x9f\x98\x80"sv)), u"well hello friends, this is a longer ASCII string 😀"sv);
+
+    auto& shift_jis_decoder = decoder_for("Shift_JIS"sv);
+    EXPECT_EQ(MUST(shift_jis_decoder.to_utf16("abc\x82\xa0"sv)), u"abcあ"sv);
+
+    auto& latin1_decoder = decoder_for("iso-8859-1"sv);
+    EXPECT_EQ(MUST(latin1_decoder.to_utf16(StringView(bytes({ 'a', 'b', 'c', 0xe4, 'd', 'e', 'f', 0xff })))), u"abcädefÿ"sv);
+}
+
+TEST_CASE(test_length_in_utf16_code_units)
+{
+    EXPECT_EQ(MUST(decoder_for("UTF-8"sv).length_in_utf16_code_units("a\xc3\xa4\xe3\x81\x82\xf0\x9f\x98\x80\xff"sv)), 6u);
+    EXPECT_EQ(MUST(decoder_for("UTF-16BE"sv).length_in_utf16_code_units(StringView(bytes({ 0x00, 'A', 0xd8, 0x3d, 0xde, 0x00 })))), 3u);
+    EXPECT_EQ(MUST(decoder_for("Shift_JIS"sv).length_in_utf16_code_units("abc\x82\xa0"sv)), 4u);
+}
+
+TEST_CASE(test_isomorphic_decode)
+{
+    EXPECT_EQ(TextCodec::isomorphic_decode(""sv), ""sv);
+    EXPECT_EQ(TextCodec::isomorphic_decode("only ASCII"sv), "only ASCII"sv);
+    EXPECT_EQ(TextCodec::isomorphic_decode(StringView(bytes({ 0xe4, 'b', 'c', 0xff }))), "äbcÿ"sv);
+
+    EXPECT_EQ(TextCodec::isomorphic_decode_to_utf16(""sv), u""sv);
+    EXPECT_EQ(TextCodec::isomorphic_decode_to_utf16("only ASCII"sv), u"only ASCII"sv);
+    EXPECT_EQ(TextCodec::isomorphic_decode_to_utf16(StringView(bytes({ 0xe4, 'b', 'c', 0xff }))), u"äbcÿ"sv);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Vector.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ThreadPool.h>
+
+static void wait_until(Function<bool()> const& condition)
+{
+    for (auto i = 0; i < 250; ++i) {
+        if (condition())
+            return;
+        (void)Core::System::sleep_ms(20);
+    }
+
+    FAIL("Timed out waiting for the thread pool");
+}
+
+TEST_CASE(pool_has_at_least_two_workers)
+{
+    EXPECT(Threading::ThreadPool::the().worker_count() >= 2);
+}
+
+TEST_CASE(submitted_work_runs_at_every_priority)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> completed { 0 };
+
+    for (auto priority : { Threading::TaskPriority::UserBlocking, Threading::TaskPriority::UserVisible, Threading::TaskPriority::Background }) {
+        for (size_t i = 0; i < 10; ++i)
+            Threading::ThreadPool::the().submit([&completed] { completed.fetch_add(1); }, priority);
+    }
+
+    wait_until([&] { return completed.load() == 30; });
+}
+
+TEST_CASE(work_submitted_from_a_worker_runs)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> completed { 0 };
+
+    Threading::ThreadPool::the().submit([&completed] {
+        for (size_t i = 0; i < 10; ++i)
+            Threading::ThreadPool::the().submit([&completed] { completed.fetch_add(1); });
+        completed.fetch_add(1);
+    });
+
+    wait_until([&] { return completed.load() == 11; });
+}
+
+TEST_CASE(cancelled_work_does_not_run)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> cancelled_work_ran { false };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> fence_ran { false };
+
+    auto token = Threading::CancellationToken::create();
+    token->cancel();
+    Threading::ThreadPool::the().submit([&cancelled_work_ran] { cancelled_work_ran.store(true); }, Threading::TaskPriority::UserBlocking, token);
+
+    // Lower priority work only runs once all of the higher priority work has been picked up.
+    Threading::ThreadPool::the().submit([&fence_ran] { fence_ran.store(true); }, Threading::TaskPriority::Background);
+
+    wait_until([&] { return fence_ran.load(); });
+    EXPECT(!cancelled_work_ran.load());
+}
+
+TEST_CASE(parallel_for_visits_every_index_once)
+{
+    static constexpr size_t count = 10'000;
+    Vector<u32> visits;
+    visits.resize(count);
+
+    Threading::ThreadPool::the().parallel_for(count, [&](size_t i) {
+        AK::atomic_fetch_add(&visits[i], static_cast<u32>(1));
+    });
+
+    for (size_t i = 0; i < count; ++i)
+        EXPECT_EQ(visits[i], 1u);
+}
+
+TEST_CASE(parallel_for_handles_small_counts)
+{
+    Atomic<size_t> sum { 0 };
+    Threading::ThreadPool::the().parallel_for(0, [&](size_t) { sum.fetch_add(1); });
+    EXPECT_EQ(sum.load(), 0u);
+
+    Threading::ThreadPool::the().parallel_for(1, [&](size_t i) { sum.fetch_add(i + 1); });
+    EXPECT_EQ(sum.load(), 1u);
+}
+
+TEST_CASE(parallel_for_can_be_nested_in_a_worker)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> sum { 0 };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> done { false };
+
+    Threading::ThreadPool::the().submit([&] {
+        Threading::ThreadPool::the().parallel_for(100, [&](size_t i) { sum.fetch_add(i); });
+        done.store(true);
+    });
+
+    wait_until([&] { return done.load(); });
+    EXPECT_EQ(sum.load(), 4950u);
+}
@@ -8,6 +8,7 @@
 
 #include <LibTest/TestCase.h>
 
+#include <LibURL/ParsedURLCache.h>
 #include <LibURL/Parser.h>
 #include <LibURL/URL.h>
 
@@ -744,3 +745,62 @@ TEST_CASE(authority_state_lots_of_at_symbols)
     auto horror_url = MUST(String::formatted("ws::{}", many_at_symbols));
     EXPECT(!URL::Parser::basic_parse(horror_url).has_value());
 }
+
+TEST_CASE(parsed_url_cache)
+{
+    URL::ParsedURLCache cache;
+    auto base_url = URL::Parser::basic_parse("https://example.com/dir/"sv).release_value();
+    auto other_base_url = URL::Parser::basic_parse("https://example.org/"sv).release_value();
+
+    EXPECT(!cache.get(u"page.html"sv, base_url, u"UTF-8"sv).has_value());
+
+    cache.set(u"page.html"sv, base_url, u"UTF-8"sv, URL::Parser::basic_parse("page.html"sv, base_url));
+    cache.set(u"https://["sv, base_url, u"UTF-8"sv, {});
+
+    auto cached_url = cache.get(u"page.html"sv, base_url, u"UTF-8"sv);
+    EXPECT(cached_url.has_value());
+    EXPECT_EQ(cached_url->value(), URL::Parser::basic_parse("https://example.com/dir/page.html"sv).value());
+
+    auto cached_failure = cache.get(u"https://["sv, base_url, u"UTF-8"sv);
+    EXPECT(cached_failure.has_value());
+    EXPECT(!cached_failure->has_value());
+
+    // Results are only handed out for the base URL and encoding they were parsed against.
+    EXPECT(!cache.get(u"page.html"sv, other_base_url, u"UTF-8"sv).has_value());
+    EXPECT(!cache.get(u"page.html"sv, base_url, u"windows-1252"sv).has_value());
+
+    // Caching a result for another base URL forgets the others.
+    cache.set(u"page.html"sv, other_base_url, u"UTF-8"sv, URL::Parser::basic_parse("page.html"sv, other_base_url));
+    EXPECT(!cache.get(u"page.html"sv, base_url, u"UTF-8"sv).has_value());
+    EXPECT(cache.get(u"page.html"sv, other_base_url, u"UTF-8"sv).has_value());
+}
+
+TEST_CASE(parsed_url_cache_keeps_recently_used_results)
+{
+    URL::ParsedURLCache cache;
+    auto base_url = URL::Parser::basic_parse("https://example.com/"sv).release_value();
+
+    auto input_for = [](size_t i) { return Utf16String::formatted("page{}.html", i); };
+    auto add = [&](size_t i) {
+        auto input = input_for(i);
+        cache.set(input, base_url, u"UTF-8"sv, URL::Parser::basic_parse(input.to_utf8(), base_url));
+    };
+
+    constexpr auto generation_size = URL::ParsedURLCache::max_entries_per_generation;
+
+    for (size_t i = 0; i <= generation_size; ++i)
+        add(i);
+
+    // The first generation is full, so this moves the first result into the second one.
+    EXPECT(cache.get(input_for(0), base_url, u"UTF-8"sv).has_value());
+
+    // Starting a third generation drops the results that went unused for a whole generation.
+    for (size_t i = generation_size + 1; i < 2 * generation_size; ++i)
+        add(i);
+
+    EXPECT(cache.get(input_for(0), base_url, u"UTF-8"sv).has_value());
+    EXPECT(!cache.get(input_for(1), base_url, u"UTF-8"sv).has_value());
+    EXPECT(!cache.get(input_for(generation_size - 1), base_url, u"UTF-8"sv).has_value());
+    EXPECT(cache.get(input_for(generation_size), base_url, u"UTF-8"sv).has_value());
+    EXPECT(cache.get(input_for(2 * generation_size - 1), base_url, u"UTF-8"sv).has_value());
+}
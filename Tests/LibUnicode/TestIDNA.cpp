@@ -33,6 +33,11 @@ TEST_CASE(to_ascii)
     TEST_TO_ASCII("A.b.c。D。"sv, "a.b.c.d."sv);
     TEST_TO_ASCII("βόλος"sv, "xn--nxasmm1c"sv);
     TEST_TO_ASCII_T("βόλος"sv, "xn--nxasmq6b"sv);
+
+    // ASCII host names only need to be lowercased.
+    TEST_TO_ASCII("ladybird.org"sv, "ladybird.org"sv);
+    TEST_TO_ASCII("WWW.LadyBird.ORG"sv, "www.ladybird.org"sv);
+    TEST_TO_ASCII_T("a-b.c0"sv, "a-b.c0"sv);
 #undef TEST_TO_ASCII_T
 #undef TEST_TO_ASCII
 
@@ -8,8 +8,10 @@
 
 #include <AK/Array.h>
 #include <AK/String.h>
+#include <AK/StringBuilder.h>
 #include <AK/StringView.h>
 #include <AK/Utf16String.h>
+#include <AK/Utf16StringBuilder.h>
 #include <AK/Utf16View.h>
 #include <AK/Vector.h>
 #include <LibUnicode/Segmenter.h>
@@ -450,3 +452,86 @@ TEST_CASE(out_of_bounds)
         EXPECT(!result.has_value());
     }
 }
+
+TEST_CASE(line_segmenter_with_cached_boundaries_matches_icu)
+{
+    // Longer than a few blocks of cached boundaries, with breaks both between ideographs and after spaces.
+    StringBuilder builder;
+    for (size_t i = 0; i < 20; ++i)
+        builder.append("你好世界 hello, world! ab你好cd\n"sv);
+    auto string = Utf16String::from_utf8(builder.string_view());
+    auto view = string.utf16_view();
+
+    auto icu_segmenter = Unicode::Segmenter::create(Unicode::SegmenterGranularity::Line);
+    icu_segmenter->set_segmented_text(view);
+
+    auto cached_segmenter = Unicode::Segmenter::create_with_cached_boundaries(Unicode::Segmenter::create(Unicode::SegmenterGranularity::Line));
+    cached_segmenter->set_segmented_text(view);
+
+    // Query out of order, so that later blocks are looked up before earlier ones.
+    for (size_t i = view.length_in_code_units() + 1; i > 0; --i) {
+        auto index = i - 1;
+        EXPECT_EQ(cached_segmenter->next_boundary(index, Unicode::Segmenter::Inclusive::Yes), icu_segmenter->next_boundary(index, Unicode::Segmenter::Inclusive::Yes));
+        EXPECT_EQ(cached_segmenter->next_boundary(index), icu_segmenter->next_boundary(index));
+        EXPECT_EQ(cached_segmenter->previous_boundary(index), icu_segmenter->previous_boundary(index));
+    }
+
+    Vector<size_t> icu_boundaries;
+    icu_segmenter->for_each_boundary(view, [&](auto boundary) {
+        icu_boundaries.append(boundary);
+        return IterationDecision::Continue;
+    });
+
+    Vector<size_t> cached_boundaries;
+    cached_segmenter->for_each_boundary(view, [&](auto boundary) {
+        cached_boundaries.append(boundary);
+        return IterationDecision::Continue;
+    });
+
+    EXPECT_EQ(cached_boundaries, icu_boundaries);
+
+    // A clone segments its own text.
+    auto clone = cached_segmenter->clone();
+    clone->set_segmented_text("ab cd"_string);
+    EXPECT_EQ(clone->next_boundary(0).value_or(0u), 3u);
+    EXPECT_EQ(cached_segmenter->next_boundary(0), icu_segmenter->next_boundary(0));
+}
+
+TEST_CASE(segmenter_with_cached_boundaries_after_change)
+{
+    auto sentence = Utf16String::from_utf8("Hello, well-known world! e\u0301 \u0915\u094D\u0937\u093F 3.14 "sv);
+    Utf16StringBuilder builder;
+    for (size_t i = 0; i < 20; ++i)
+        builder.append(sentence.utf16_view());
+    auto original = builder.to_string();
+
+    for (auto granularity : { Unicode::SegmenterGranularity::Grapheme, Unicode::SegmenterGranularity::Word }) {
+        auto cached_segmenter = Unicode::Segmenter::create_with_cached_boundaries(Unicode::Segmenter::create(granularity));
+        cached_segmenter->set_segmented_text(original.utf16_view());
+
+        // Look up every block before changing the text, so that the boundaries kept from before the change are checked.
+        for (size_t i = 0; i <= original.length_in_code_units(); ++i)
+            (void)cached_segmenter->next_boundary(i, Unicode::Segmenter::Inclusive::Yes);
+
+        // Put a combining mark after the "Hello" in the middle of the text, then delete the end of the text.
+        auto offset = sentence.length_in_code_units() * 10 + 5;
+        Utf16StringBuilder changed_builder;
+        changed_builder.append(original.substring_view(0, offset));
+        changed_builder.append(u"\u0301"sv);
+        changed_builder.append(original.substring_view(offset));
+        auto changed = changed_builder.to_string();
+        auto truncated = Utf16String::from_utf16(changed.substring_view(0, offset + 1));
+
+        for (auto const& text : { changed, truncated }) {
+            cached_segmenter->set_segmented_text_after_change(text.utf16_view(), offset);
+
+            auto icu_segmenter = Unicode::Segmenter::create(granularity);
+            icu_segmenter->set_segmented_text(text.utf16_view());
+
+            for (size_t index = 0; index <= text.length_in_code_units(); ++index) {
+                EXPECT_EQ(cached_segmenter->next_boundary(index, Unicode::Segmenter::Inclusive::Yes), icu_segmenter->next_boundary(index, Unicode::Segmenter::Inclusive::Yes));
+                EXPECT_EQ(cached_segmenter->previous_boundary(index), icu_segmenter->previous_boundary(index));
+            }
+        }
+    }
+}
@@ -93,3 +93,16 @@ TEST_CASE(normalize_nfkc)
     EXPECT_EQ(normalize("\u0958"sv, NormalizationForm::NFKC), "\u0915\u093C"sv);
     EXPECT_EQ(normalize("\u2126"sv, NormalizationForm::NFKC), "\u03A9"sv);
 }
+
+TEST_CASE(normalize_already_normalized_text)
+{
+    for (auto form : { NormalizationForm::NFD, NormalizationForm::NFC, NormalizationForm::NFKD, NormalizationForm::NFKC }) {
+        EXPECT_EQ(normalize("Hello, friends!"sv, form), "Hello, friends!"sv);
+        EXPECT_EQ(normalize(u"Hello, friends!"sv, form), u"Hello, friends!"sv);
+    }
+
+    EXPECT_EQ(normalize("Am\u00E9lie"sv, NormalizationForm::NFC), "Am\u00E9lie"sv);
+    EXPECT_EQ(normalize(u"Am\u00E9lie"sv, NormalizationForm::NFC), u"Am\u00E9lie"sv);
+    EXPECT_EQ(normalize(u"Ame\u0301lie"sv, NormalizationForm::NFD), u"Ame\u0301lie"sv);
+    EXPECT_EQ(normalize(u"Ame\u0301lie"sv, NormalizationForm::NFC), u"Am\u00E9lie"sv);
+}
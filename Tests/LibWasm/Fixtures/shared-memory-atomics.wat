@@ -0,0 +1,16 @@
+(module
+  (memory (export "memory") 1 1 shared)
+
+  ;; Read-modify-write and compare-exchange return the value that was in memory before the operation.
+  (func (export "add") (param i32) (param i32) (result i32)
+    (i32.atomic.rmw.add (local.get 0) (local.get 1)))
+  (func (export "load") (param i32) (result i32)
+    (i32.atomic.load (local.get 0)))
+  (func (export "compare_exchange") (param i32) (param i32) (param i32) (result i32)
+    (i32.atomic.rmw.cmpxchg (local.get 0) (local.get 1) (local.get 2)))
+
+  ;; wait returns 0 ("ok"), 1 ("not-equal") or 2 ("timed-out"); notify returns the number of woken waiters.
+  (func (export "wait") (param i32) (param i32) (param i64) (result i32)
+    (memory.atomic.wait32 (local.get 0) (local.get 1) (local.get 2)))
+  (func (export "notify") (param i32) (param i32) (result i32)
+    (memory.atomic.notify (local.get 0) (local.get 1))))
@@ -4,12 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
 #include <AK/MemoryStream.h>
 #include <LibCore/File.h>
 #include <LibTest/TestCase.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/Constants.h>
+#include <LibWasm/Types.h>
 
 TEST_CASE(compiled_to_interpreter_call_restores_label_stack)
 {
@@ -69,6 +72,8 @@ TEST_CASE(compiled_memory_access_traps_out_of_bounds)
     auto load = find_export("load"sv);
     auto store = find_export("store"sv);
     auto load_high = find_export("load_high"sv);
+    auto load_second = find_export("load_second"sv);
+    auto store_second = find_export("store_second"sv);
 
     auto invoke = [&](Wasm::FunctionAddress address, Vector<Wasm::Value> arguments) {
         return machine.invoke(address, move(arguments));
@@ -99,4 +104,163 @@ TEST_CASE(compiled_memory_access_traps_out_of_bounds)
     // base + offset can reach high into the guarded reservation; those accesses must trap too.
     expect_oob_trap(invoke(load_high, { Wasm::Value(static_cast<i32>(0)) }));
     expect_oob_trap(invoke(load_high, { Wasm::Value(static_cast<i32>(0xffffffff)) }));
+
+    // Non-default memories are accessed through their own guarded base and must behave the same way.
+    auto store_second_in_bounds = invoke(store_second, { Wasm::Value(static_cast<i32>(Wasm::Constants::page_size - 4)), Wasm::Value(static_cast<i32>(0x4242)) });
+    EXPECT(!store_second_in_bounds.is_trap());
+    auto load_second_back = invoke(load_second, { Wasm::Value(static_cast<i32>(Wasm::Constants::page_size - 4)) });
+    EXPECT(!load_second_back.is_trap());
+    EXPECT_EQ(load_second_back.values()[0].to<i32>(), 0x4242);
+    // ...and writes to one memory must not show up in the other.
+    auto load_default_unchanged = invoke(load, { Wasm::Value(static_cast<i32>(Wasm::Constants::page_size - 4)) });
+    EXPECT_EQ(load_default_unchanged.values()[0].to<i32>(), 0x1337);
+    expect_oob_trap(invoke(load_second, { Wasm::Value(static_cast<i32>(Wasm::Constants::page_size - 1)) }));
+    expect_oob_trap(invoke(store_second, { Wasm::Value(static_cast<i32>(Wasm::Constants::page_size)), Wasm::Value(static_cast<i32>(0x42)) }));
+}
+
+TEST_CASE(streaming_parser_matches_whole_module_parse)
+{
+    auto file = MUST(Core::File::open("Fixtures/memory-guard-trap.wasm"sv, Core::File::OpenMode::Read));
+    auto bytes = MUST(file->read_until_eof());
+    FixedMemoryStream stream { bytes.bytes() };
+    auto module = MUST(Wasm::Module::parse(stream));
+
+    // Feed the module one byte at a time so every section (and every function body) is split across chunks.
+    Wasm::StreamingModuleParser parser;
+    for (auto byte : bytes.bytes())
+        MUST(parser.append({ &byte, 1 }));
+    auto streamed_module = MUST(parser.finish());
+
+    EXPECT_EQ(parser.total_size(), bytes.size());
+    EXPECT_EQ(streamed_module->type_section().types().size(), module->type_section().types().size());
+    EXPECT_EQ(streamed_module->export_section().entries().size(), module->export_section().entries().size());
+    EXPECT_EQ(streamed_module->code_section().functions().size(), module->code_section().functions().size());
+    for (size_t i = 0; i < module->code_section().functions().size(); ++i) {
+        auto& expected = module->code_section().functions()[i];
+        auto& actual = streamed_module->code_section().functions()[i];
+        EXPECT_EQ(actual.size(), expected.size());
+        EXPECT_EQ(actual.func().body().instructions().size(), expected.func().body().instructions().size());
+    }
+
+    Wasm::AbstractMachine machine;
+    MUST(machine.instantiate(*streamed_module, {}));
+}
+
+TEST_CASE(streaming_parser_rejects_truncated_module)
+{
+    auto file = MUST(Core::File::open("Fixtures/memory-guard-trap.wasm"sv, Core::File::OpenMode::Read));
+    auto bytes = MUST(file->read_until_eof());
+
+    Wasm::StreamingModuleParser parser;
+    MUST(parser.append(bytes.bytes().slice(0, bytes.size() - 1)));
+    auto result = parser.finish();
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error(), Wasm::ParseError::UnexpectedEof);
+}
+
+TEST_CASE(shared_memory_atomics)
+{
+    auto file = MUST(Core::File::open("Fixtures/shared-memory-atomics.wasm"sv, Core::File::OpenMode::Read));
+    auto bytes = MUST(file->read_until_eof());
+    FixedMemoryStream stream { bytes.bytes() };
+    auto module = MUST(Wasm::Module::parse(stream));
+
+    Wasm::AbstractMachine machine;
+    auto instance = MUST(machine.instantiate(*module, {}));
+
+    Optional<Wasm::MemoryAddress> memory;
+    for (auto const& export_ : instance->exports()) {
+        if (export_.name() == "memory"sv)
+            memory = export_.value().get<Wasm::MemoryAddress>();
+    }
+    VERIFY(memory.has_value());
+    EXPECT(machine.store().get(*memory)->type().is_shared());
+
+    auto find_export = [&](StringView name) {
+        Optional<Wasm::FunctionAddress> address;
+        for (auto const& export_ : instance->exports()) {
+            if (export_.name() == name)
+                address = export_.value().get<Wasm::FunctionAddress>();
+        }
+        VERIFY(address.has_value());
+        return *address;
+    };
+    auto add = find_export("add"sv);
+    auto load = find_export("load"sv);
+    auto compare_exchange = find_export("compare_exchange"sv);
+    auto wait = find_export("wait"sv);
+    auto notify = find_export("notify"sv);
+
+    auto invoke_for_i32 = [&](Wasm::FunctionAddress address, Vector<Wasm::Value> arguments) {
+        auto result = machine.invoke(address, move(arguments));
+        EXPECT(!result.is_trap());
+        return result.values()[0].to<i32>();
+    };
+
+    EXPECT_EQ(invoke_for_i32(add, { Wasm::Value(static_cast<i32>(8)), Wasm::Value(static_cast<i32>(5)) }), 0);
+    EXPECT_EQ(invoke_for_i32(add, { Wasm::Value(static_cast<i32>(8)), Wasm::Value(static_cast<i32>(2)) }), 5);
+    EXPECT_EQ(invoke_for_i32(load, { Wasm::Value(static_cast<i32>(8)) }), 7);
+
+    // A failed compare-exchange leaves memory untouched; both report the value that was read.
+    EXPECT_EQ(invoke_for_i32(compare_exchange, { Wasm::Value(static_cast<i32>(8)), Wasm::Value(static_cast<i32>(1)), Wasm::Value(static_cast<i32>(9)) }), 7);
+    EXPECT_EQ(invoke_for_i32(load, { Wasm::Value(static_cast<i32>(8)) }), 7);
+    EXPECT_EQ(invoke_for_i32(compare_exchange, { Wasm::Value(static_cast<i32>(8)), Wasm::Value(static_cast<i32>(7)), Wasm::Value(static_cast<i32>(9)) }), 7);
+    EXPECT_EQ(invoke_for_i32(load, { Wasm::Value(static_cast<i32>(8)) }), 9);
+
+    EXPECT_EQ(invoke_for_i32(wait, { Wasm::Value(static_cast<i32>(8)), Wasm::Value(static_cast<i32>(0)), Wasm::Value(static_cast<i64>(-1)) }), 1);
+    EXPECT_EQ(invoke_for_i32(wait, { Wasm::Value(static_cast<i32>(8)), Wasm::Value(static_cast<i32>(9)), Wasm::Value(static_cast<i64>(0)) }), 2);
+    EXPECT_EQ(invoke_for_i32(notify, { Wasm::Value(static_cast<i32>(8)), Wasm::Value(static_cast<i32>(1)) }), 0);
+
+    auto unaligned = machine.invoke(load, { Wasm::Value(static_cast<i32>(2)) });
+    EXPECT(unaligned.is_trap());
+    EXPECT_EQ(unaligned.trap().format(), "Unaligned atomic memory access"sv);
+
+    // An agent that cannot block traps on wait, even when the value would not match.
+    machine.store().set_can_block(false);
+    auto wait_without_blocking = machine.invoke(wait, { Wasm::Value(static_cast<i32>(8)), Wasm::Value(static_cast<i32>(0)), Wasm::Value(static_cast<i64>(0)) });
+    EXPECT(wait_without_blocking.is_trap());
+    EXPECT_EQ(wait_without_blocking.trap().format(), "Atomic wait is not allowed in this agent"sv);
+    EXPECT_EQ(invoke_for_i32(notify, { Wasm::Value(static_cast<i32>(8)), Wasm::Value(static_cast<i32>(1)) }), 0);
+}
+
+TEST_CASE(function_profile_counts_calls)
+{
+    Wasm::set_function_profiling_enabled(true);
+    auto file = MUST(Core::File::open("Fixtures/memory-guard-trap.wasm"sv, Core::File::OpenMode::Read));
+    auto bytes = MUST(file->read_until_eof());
+    FixedMemoryStream stream { bytes.bytes() };
+    auto module = MUST(Wasm::Module::parse(stream));
+
+    Wasm::AbstractMachine machine;
+    auto instance = MUST(machine.instantiate(*module, {}));
+    Wasm::set_function_profiling_enabled(false);
+
+    Optional<Wasm::FunctionAddress> load;
+    for (auto const& export_ : instance->exports()) {
+        if (export_.name() == "load"sv)
+            load = export_.value().get<Wasm::FunctionAddress>();
+    }
+    VERIFY(load.has_value());
+
+    constexpr u64 call_count = 5;
+    for (u64 i = 0; i < call_count; ++i)
+        EXPECT(!machine.invoke(*load, { Wasm::Value(static_cast<i32>(0)) }).is_trap());
+
+    // Only this module was validated with profiling enabled, so its `load` (function 0) is the only function 0 in there.
+    auto profile = Wasm::function_profiles_as_json();
+    auto functions = profile.get_array("functions"sv);
+    VERIFY(functions.has_value());
+    Optional<JsonObject const&> load_profile;
+    functions->for_each([&](JsonValue const& value) {
+        if (value.as_object().get_u32("function"sv) == 0u)
+            load_profile = value.as_object();
+    });
+    VERIFY(load_profile.has_value());
+
+    auto interpreted_calls = load_profile->get_u64("interpreted_calls"sv).value();
+    auto native_calls = load_profile->get_u64("native_calls"sv).value();
+    EXPECT_EQ(interpreted_calls + native_calls, call_count);
+    if (interpreted_calls != 0)
+        EXPECT(load_profile->get_u64("interpreted_instructions"sv).value() > 0);
+    EXPECT(profile.get_array("traceEvents"sv).has_value());
 }
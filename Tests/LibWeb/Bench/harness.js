@@ -0,0 +1,55 @@
+// Injected by layout-bench into every corpus page once it has loaded, so saved real-world pages work unmodified.
+// layout-bench defines __layoutBenchIterations before this script runs.
+(() => {
+    const iterations = globalThis.__layoutBenchIterations ?? 20;
+
+    function lastTextNode() {
+        const walker = document.createTreeWalker(document.body ?? document.documentElement, NodeFilter.SHOW_TEXT, {
+            acceptNode: node => {
+                if (!node.data.trim().length || node.parentElement?.closest("script, style"))
+                    return NodeFilter.FILTER_SKIP;
+                return NodeFilter.FILTER_ACCEPT;
+            },
+        });
+        let last = null;
+        while (walker.nextNode()) last = walker.currentNode;
+        return last;
+    }
+
+    const textNode = lastTextNode();
+    const originalText = textNode?.data;
+    const root = document.documentElement;
+
+    // Each pattern dirties the document in a different way before the rendering update is measured.
+    const invalidationPatterns = {
+        // Nothing is dirty, this is the fixed cost of a rendering update.
+        "clean": () => {},
+        // An inherited custom property on the root restyles every element, but doesn't change any used value.
+        "restyle": i => root.style.setProperty("--layout-bench-generation", `${i}`),
+        // Changing the root's width relayouts everything.
+        "resize": i => (root.style.width = i % 2 ? "99%" : ""),
+        // Editing a single text node near the end of the document.
+        "text-edit": i => {
+            if (textNode) textNode.data = i % 2 ? `${originalText}x` : originalText;
+        },
+    };
+
+    const samples = {};
+    for (const [name, invalidate] of Object.entries(invalidationPatterns)) {
+        internals.measureRenderingUpdate();
+
+        const phases = { style: [], layout: [], paint: [] };
+        for (let i = 0; i < iterations; ++i) {
+            invalidate(i);
+            const timings = internals.measureRenderingUpdate();
+            phases.style.push(timings.style);
+            phases.layout.push(timings.layout);
+            phases.paint.push(timings.paint);
+        }
+        samples[name] = phases;
+
+        invalidate(0);
+    }
+
+    internals.signalTestIsDone(JSON.stringify(samples));
+})();
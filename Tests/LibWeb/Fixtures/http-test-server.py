@@ -46,6 +46,7 @@ class Echo:
     reflect_headers_in_body: bool
     close_connection: bool
     wait_for_unblock: Optional[str]
+    early_hints: Optional[Dict[str, str]]
 
     def __eq__(self, other):
         if not isinstance(other, Echo):
@@ -63,6 +64,7 @@ class Echo:
             and self.reflect_headers_in_body == other.reflect_headers_in_body
             and self.close_connection == other.close_connection
             and self.wait_for_unblock == other.wait_for_unblock
+            and self.early_hints == other.early_hints
         )
 
 
@@ -328,6 +330,7 @@ class TestHTTPRequestHandler(http.server.SimpleHTTPRequestHandler):
         echo.reflect_headers_in_body = data.get("reflect_headers_in_body", False)
         echo.close_connection = data.get("close_connection", False)
         echo.wait_for_unblock = data.get("wait_for_unblock", None)
+        echo.early_hints = data.get("early_hints", None)
 
         is_invalid_echo_path = echo.path is None or not echo.path.startswith("/echo/")
 
@@ -439,6 +442,13 @@ class TestHTTPRequestHandler(http.server.SimpleHTTPRequestHandler):
 
         response_headers = echo.headers.copy()
 
+        # Send the headers of a 103 (Early Hints) interim response ahead of the final response.
+        if echo.early_hints is not None and not send_not_modified:
+            self.send_response_only(103, "Early Hints")
+            for header, value in echo.early_hints.items():
+                self.send_header(header, value)
+            self.end_headers()
+
         if echo.delay_ms is not None:
             time.sleep(echo.delay_ms / 1000)
 
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/Compositor/AsyncScrollTree.h>
+#include <LibWeb/Painting/DisplayList.h>
+
+using namespace Web::Compositor;
+
+static AsyncScrollNodeID scroll_node_id(size_t index)
+{
+    return { Web::UniqueNodeID { 1 }, Web::Painting::VisualContextIndex { index } };
+}
+
+TEST_CASE(wheel_hit_testing_finds_the_topmost_target_among_many)
+{
+    AsyncScrollingState state;
+    auto add_target = [&](size_t node_index, Gfx::FloatRect rect) {
+        state.scroll_nodes.append({
+            .node_id = scroll_node_id(node_index),
+            .stable_node_id = {},
+            .parent_node_id = {},
+            .scrollport_rect = rect.to_type<int>(),
+            .max_scroll_offset = { 0, 100 },
+            .is_viewport = false,
+            .can_be_wheel_scrolled_horizontally = false,
+            .can_be_wheel_scrolled_vertically = true,
+        });
+        state.wheel_hit_test_targets.append({
+            .visual_context_index = Web::Painting::VISUAL_VIEWPORT_NODE_INDEX,
+            .rect = rect,
+            .corner_radii = {},
+            .target_node_id = scroll_node_id(node_index),
+        });
+    };
+
+    // A background target that is too large for the grid, a thousand small targets on top of it, and a large
+    // overlay on top of everything below them.
+    add_target(1, { 0, 0, 100000, 100000 });
+    for (size_t i = 0; i < 1000; ++i)
+        add_target(i + 2, { static_cast<float>(i % 100) * 10, static_cast<float>(i / 100) * 10, 10, 10 });
+    add_target(2000, { 0, 100, 100000, 100000 });
+
+    auto visual_context_tree = Web::Painting::AccumulatedVisualContextTree::create();
+    auto display_list = Web::Painting::DisplayList::create(visual_context_tree);
+    AsyncScrollTree scroll_tree;
+    scroll_tree.set_state(move(state));
+    scroll_tree.rebuild_wheel_hit_test_targets(display_list, &visual_context_tree, {});
+
+    auto hit_node = [&](Gfx::FloatPoint position) {
+        return scroll_tree.hit_test_scroll_node_for_wheel(position, { 0, 10 }).node_id;
+    };
+    EXPECT(hit_node({ 5, 5 }) == scroll_node_id(2));
+    EXPECT(hit_node({ 995, 95 }) == scroll_node_id(1001));
+    EXPECT(hit_node({ 5000, 5 }) == scroll_node_id(1));
+    EXPECT(hit_node({ 5, 105 }) == scroll_node_id(2000));
+    EXPECT(!hit_node({ -5, 5 }).has_value());
+}
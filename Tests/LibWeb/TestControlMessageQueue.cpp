@@ -45,3 +45,23 @@ TEST_CASE(drain_preserves_first_in_first_out)
     EXPECT_EQ(batch[2].get<Web::WebAudio::StartSource>().when, 3.0);
     EXPECT_EQ(batch[2].get<Web::WebAudio::StartSource>().node_id, Web::WebAudio::NodeID { 2 });
 }
+
+TEST_CASE(enqueue_after_drain_starts_a_new_batch)
+{
+    Web::WebAudio::ControlMessageQueue queue;
+
+    for (size_t i = 0; i < 100; ++i)
+        queue.enqueue(Web::WebAudio::StartSource { .node_id = Web::WebAudio::NodeID { i }, .when = 0.0 });
+    auto first_batch = queue.drain();
+    EXPECT_EQ(first_batch.size(), 100u);
+    for (size_t i = 0; i < first_batch.size(); ++i)
+        EXPECT_EQ(first_batch[i].get<Web::WebAudio::StartSource>().node_id, Web::WebAudio::NodeID { i });
+
+    queue.enqueue(Web::WebAudio::StopSource { .node_id = Web::WebAudio::NodeID { 100 }, .when = 1.0 });
+    auto second_batch = queue.drain();
+    EXPECT_EQ(second_batch.size(), 1u);
+    EXPECT_EQ(second_batch[0].get<Web::WebAudio::StopSource>().node_id, Web::WebAudio::NodeID { 100 });
+
+    // Messages that are never drained are freed along with the queue.
+    queue.enqueue(Web::WebAudio::StartSource { .node_id = Web::WebAudio::NodeID { 101 }, .when = 2.0 });
+}
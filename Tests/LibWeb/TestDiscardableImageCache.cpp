@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/Promise.h>
+#include <LibGC/Root.h>
+#include <LibGfx/Bitmap.h>
+#include <LibJS/Runtime/Realm.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Bindings/HostDefined.h>
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/HTML/BitmapDecodedImageData.h>
+#include <LibWeb/HTML/DiscardableImageCache.h>
+#include <LibWeb/Platform/ImageCodecPlugin.h>
+
+namespace {
+
+struct TestVM {
+    TestVM()
+        : vm(JS::VM::create())
+        , execution_context(MUST(JS::Realm::initialize_host_defined_realm(*vm, nullptr, nullptr)))
+    {
+        auto& realm = *vm->current_realm();
+        auto intrinsics = realm.create<Web::Bindings::Intrinsics>(realm);
+        realm.set_host_defined(make<Web::Bindings::HostDefined>(intrinsics));
+    }
+
+    ~TestVM()
+    {
+        vm->pop_execution_context();
+    }
+
+    NonnullRefPtr<JS::VM> vm;
+    NonnullOwnPtr<JS::ExecutionContext> execution_context;
+};
+
+constexpr Gfx::IntSize image_size { 4, 4 };
+
+// Decodes every image to a blank bitmap before returning, so that an image that is decoded again is back right away.
+class TestImageCodecPlugin final : public Web::Platform::ImageCodecPlugin {
+public:
+    static TestImageCodecPlugin& the()
+    {
+        static TestImageCodecPlugin plugin;
+        if (!Web::Platform::ImageCodecPlugin::is_initialized())
+            Web::Platform::ImageCodecPlugin::install(plugin);
+        return plugin;
+    }
+
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<ByteString>) override
+    {
+        ++decode_count;
+
+        auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
+        promise->on_resolution = move(on_resolved);
+        promise->on_rejection = move(on_rejected);
+
+        Web::Platform::DecodedImage image;
+        image.frame_count = 1;
+        image.frames.append({ MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, image_size)) });
+        promise->resolve(move(image));
+        return promise;
+    }
+
+    virtual Optional<i64> start_incremental_decode(Function<void(NonnullRefPtr<Gfx::Bitmap>)>) override { return {}; }
+    virtual void append_incremental_decode_data(i64, ReadonlyBytes) override { }
+    virtual void end_incremental_decode(i64) override { }
+
+    virtual void request_animation_frames(i64, u32, u32) override { }
+    virtual void stop_animation_decode(i64) override { }
+
+    size_t decode_count { 0 };
+};
+
+class TestImageClient final : public Web::HTML::DecodedImageData::Client {
+public:
+    TestImageClient(GC::Ref<Web::HTML::DecodedImageData> image_data, bool exposes_pixels_to_script)
+        : m_image_data(image_data)
+        , m_exposes_pixels_to_script(exposes_pixels_to_script)
+    {
+    }
+
+    ~TestImageClient()
+    {
+        unregister_with_decoded_image_data_if_needed();
+    }
+
+    void start_using_image() { register_with_decoded_image_data_if_needed(); }
+
+    virtual GC::Ptr<Web::HTML::DecodedImageData> decoded_image_data() const override { return m_image_data.ptr(); }
+    virtual void decoded_image_data_did_update() override { ++update_count; }
+    virtual bool exposes_pixels_to_script() const override { return m_exposes_pixels_to_script; }
+
+    size_t update_count { 0 };
+
+private:
+    GC::Root<Web::HTML::DecodedImageData> m_image_data;
+    bool m_exposes_pixels_to_script { false };
+};
+
+GC::Ref<Web::HTML::BitmapDecodedImageData> create_discardable_image(JS::Realm& realm)
+{
+    auto encoded_data = MUST(ByteBuffer::copy("not really a PNG"sv.bytes()));
+    return Web::HTML::BitmapDecodedImageData::create(realm, Gfx::DecodedImageFrame { MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, image_size)) }, move(encoded_data));
+}
+
+void discard_every_unused_image()
+{
+    Web::HTML::DiscardableImageCache::the().did_receive_memory_pressure(Core::MemoryPressureLevel::Critical);
+}
+
+// NB: The cache is shared by the whole process, so images left behind by earlier tests are discarded first, so that
+//     they don't show up in the statistics.
+void discard_images_of_earlier_tests()
+{
+    discard_every_unused_image();
+}
+
+}
+
+TEST_CASE(discarded_image_is_decoded_again_once_used)
+{
+    TestVM test_vm;
+    auto& plugin = TestImageCodecPlugin::the();
+    auto& cache = Web::HTML::DiscardableImageCache::the();
+    discard_images_of_earlier_tests();
+
+    auto image = GC::make_root(create_discardable_image(*test_vm.vm->current_realm()));
+    TestImageClient style_client { *image, false };
+    style_client.start_using_image();
+
+    auto statistics_before = cache.statistics();
+    discard_every_unused_image();
+    EXPECT_EQ(cache.statistics().discarded_image_count, statistics_before.discarded_image_count + 1);
+    EXPECT_EQ(cache.statistics().decoded_image_count, statistics_before.decoded_image_count - 1);
+
+    // The first use finds the pixels gone and starts decoding them again.
+    auto decode_count_before = plugin.decode_count;
+    EXPECT(!image->default_frame().has_value());
+    EXPECT_EQ(plugin.decode_count, decode_count_before + 1);
+    EXPECT_EQ(style_client.update_count, 1u);
+    EXPECT_EQ(cache.statistics().redecoded_image_count, statistics_before.redecoded_image_count + 1);
+
+    auto frame = image->default_frame();
+    EXPECT(frame.has_value());
+    EXPECT_EQ(frame->size(), image_size);
+    EXPECT_EQ(plugin.decode_count, decode_count_before + 1);
+}
+
+TEST_CASE(image_that_script_can_read_is_not_discarded)
+{
+    TestVM test_vm;
+    auto& cache = Web::HTML::DiscardableImageCache::the();
+    discard_images_of_earlier_tests();
+
+    auto image = GC::make_root(create_discardable_image(*test_vm.vm->current_realm()));
+    {
+        TestImageClient element_client { *image, true };
+        element_client.start_using_image();
+
+        auto discarded_image_count_before = cache.statistics().discarded_image_count;
+        discard_every_unused_image();
+        EXPECT_EQ(cache.statistics().discarded_image_count, discarded_image_count_before);
+        EXPECT(image->default_frame().has_value());
+    }
+
+    // Once the element lets go of it, the image is treated like any other.
+    auto discarded_image_count_before = cache.statistics().discarded_image_count;
+    discard_every_unused_image();
+    EXPECT_EQ(cache.statistics().discarded_image_count, discarded_image_count_before + 1);
+}
+
+TEST_CASE(discarded_image_is_decoded_again_when_script_can_read_it)
+{
+    TestVM test_vm;
+    auto& plugin = TestImageCodecPlugin::the();
+
+    auto image = GC::make_root(create_discardable_image(*test_vm.vm->current_realm()));
+    discard_every_unused_image();
+
+    auto decode_count_before = plugin.decode_count;
+    TestImageClient element_client { *image, true };
+    element_client.start_using_image();
+    EXPECT_EQ(plugin.decode_count, decode_count_before + 1);
+    EXPECT_EQ(element_client.update_count, 1u);
+
+    // Synchronous readers like CanvasRenderingContext2D.drawImage() now get the pixels on their first try.
+    EXPECT(image->default_frame().has_value());
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Filter.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/DisplayListRecorder.h>
+
+using namespace Web::Painting;
+
+TEST_CASE(backdrop_filter_results_are_reused_until_their_backdrop_is_damaged)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    DisplayListResourceStorage resource_storage;
+    auto record = [&](Gfx::Color backdrop_color) {
+        auto display_list = DisplayList::create(visual_context_tree);
+        DisplayListRecorder recorder(*display_list, visual_context_tree, resource_storage);
+        recorder.fill_rect({ 0, 0, 40, 20 }, Gfx::Color::White);
+        recorder.fill_rect({ 0, 0, 20, 20 }, backdrop_color);
+        recorder.apply_backdrop_filter({ 0, 0, 40, 20 }, {}, Gfx::Filter::offset(10, 0));
+        return display_list;
+    };
+
+    DisplayListPlayerSkia display_list_player { RefPtr<Gfx::SkiaBackendContext> {} };
+    auto surface = Gfx::PaintingSurface::create_with_size({ 40, 20 }, Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, nullptr);
+    auto paint = [&](DisplayList const& display_list) {
+        display_list_player.execute(display_list, visual_context_tree, resource_storage, {}, surface, nullptr, nullptr, Gfx::IntSize { 40, 20 });
+        return surface->snapshot_bitmap();
+    };
+
+    // The filtered backdrop is painted the same way whether it's computed or reused.
+    auto red_display_list = record(Gfx::Color::Red);
+    for (size_t i = 0; i < 2; ++i) {
+        auto bitmap = paint(*red_display_list);
+        EXPECT_EQ(bitmap->get_pixel(25, 10), Gfx::Color::Red);
+        EXPECT_EQ(bitmap->get_pixel(35, 10), Gfx::Color::White);
+    }
+
+    // Without damage to the backdrop, the earlier result is still used.
+    auto blue_display_list = record(Gfx::Color::Blue);
+    EXPECT_EQ(paint(*blue_display_list)->get_pixel(25, 10), Gfx::Color::Red);
+
+    // Damage that only touches pixels the filter doesn't read keeps the result as well.
+    resource_storage.invalidate_cached_backdrop_filter_results({ 35, 0, 5, 20 });
+    EXPECT_EQ(paint(*blue_display_list)->get_pixel(25, 10), Gfx::Color::Red);
+
+    resource_storage.invalidate_cached_backdrop_filter_results({ 10, 0, 5, 20 });
+    EXPECT_EQ(paint(*blue_display_list)->get_pixel(25, 10), Gfx::Color::Blue);
+}
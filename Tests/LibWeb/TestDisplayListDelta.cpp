@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/DisplayList.h>
+
+using namespace Web::Painting;
+
+static NonnullRefPtr<DisplayList> make_display_list(AccumulatedVisualContextTree const& visual_context_tree, Vector<Gfx::Color> const& colors)
+{
+    auto display_list = DisplayList::create(visual_context_tree);
+    for (size_t i = 0; i < colors.size(); ++i) {
+        Gfx::IntRect rect { static_cast<int>(i) * 10, 0, 10, 10 };
+        display_list->append(FillRect { rect, colors[i] }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    }
+    return display_list;
+}
+
+TEST_CASE(delta_only_carries_the_changed_commands)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    auto base = make_display_list(visual_context_tree, { Gfx::Color::Red, Gfx::Color::Green, Gfx::Color::Blue, Gfx::Color::Black });
+    auto display_list = make_display_list(visual_context_tree, { Gfx::Color::Red, Gfx::Color::White, Gfx::Color::Blue, Gfx::Color::Black });
+    display_list->set_surface_clear_color(Gfx::Color::Yellow);
+
+    auto delta = DisplayListDelta::create(base, display_list);
+    EXPECT_EQ(delta.base_display_list_id, base->id());
+    EXPECT(delta.changed_command_bytes.size() < display_list->command_byte_size() / 4);
+
+    auto patched = MUST(delta.apply_to(base));
+    EXPECT_EQ(patched->id(), display_list->id());
+    EXPECT(patched->command_bytes() == display_list->command_bytes());
+    EXPECT(patched->surface_clear_color() == Gfx::Color::Yellow);
+}
+
+TEST_CASE(delta_handles_inserted_and_removed_commands)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    auto base = make_display_list(visual_context_tree, { Gfx::Color::Red, Gfx::Color::Green });
+    auto longer = make_display_list(visual_context_tree, { Gfx::Color::Red, Gfx::Color::Green, Gfx::Color::Blue });
+    auto shorter = make_display_list(visual_context_tree, { Gfx::Color::Red });
+    auto empty = make_display_list(visual_context_tree, {});
+
+    EXPECT(MUST(DisplayListDelta::create(base, longer).apply_to(base))->command_bytes() == longer->command_bytes());
+    EXPECT(MUST(DisplayListDelta::create(base, shorter).apply_to(base))->command_bytes() == shorter->command_bytes());
+    EXPECT(MUST(DisplayListDelta::create(base, empty).apply_to(base))->command_bytes() == empty->command_bytes());
+    EXPECT(MUST(DisplayListDelta::create(empty, base).apply_to(empty))->command_bytes() == base->command_bytes());
+
+    auto unchanged = DisplayListDelta::create(base, base);
+    EXPECT(unchanged.changed_command_bytes.is_empty());
+    EXPECT(MUST(unchanged.apply_to(base))->command_bytes() == base->command_bytes());
+}
+
+TEST_CASE(delta_is_rejected_for_a_different_base)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    auto base = make_display_list(visual_context_tree, { Gfx::Color::Red });
+    auto other = make_display_list(visual_context_tree, { Gfx::Color::Red });
+    auto display_list = make_display_list(visual_context_tree, { Gfx::Color::Green });
+
+    auto delta = DisplayListDelta::create(base, display_list);
+    EXPECT(delta.apply_to(other).is_error());
+
+    delta.common_suffix_size = base->command_byte_size() + 1;
+    EXPECT(delta.apply_to(base).is_error());
+}
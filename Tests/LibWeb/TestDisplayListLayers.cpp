@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListPlayerSkia.h>
+
+using namespace Web::Painting;
+
+TEST_CASE(layer_content_follows_changes_of_its_root_and_its_content)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    auto transform = visual_context_tree.append(TransformData { Gfx::FloatMatrix4x4::identity(), {} }, VISUAL_VIEWPORT_NODE_INDEX);
+    visual_context_tree.node_at(transform).is_layer_root = true;
+    auto clip = visual_context_tree.append(ClipData { Web::DevicePixelRect { 0, 0, 10, 10 }, {} }, transform);
+
+    auto display_list = DisplayList::create(visual_context_tree);
+    display_list->append(FillRect { { 0, 0, 40, 20 }, Gfx::Color::White }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(FillRect { { 0, 0, 20, 10 }, Gfx::Color::Red }, visual_context_tree, clip, false);
+
+    DisplayListResourceStorage resource_storage;
+    DisplayListPlayerSkia display_list_player { RefPtr<Gfx::SkiaBackendContext> {} };
+    auto surface = Gfx::PaintingSurface::create_with_size({ 40, 20 }, Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, nullptr);
+    auto paint = [&] {
+        display_list_player.execute(*display_list, visual_context_tree, resource_storage, {}, surface);
+        return surface->snapshot_bitmap();
+    };
+
+    // The content is replayed on the first paint, rasterized on the second and composited from the raster after that.
+    for (size_t i = 0; i < 3; ++i) {
+        auto bitmap = paint();
+        EXPECT_EQ(bitmap->get_pixel(5, 5), Gfx::Color::Red);
+        EXPECT_EQ(bitmap->get_pixel(15, 5), Gfx::Color::White);
+    }
+
+    // Moving the root moves the raster.
+    visual_context_tree.node_at(transform).data = TransformData { Gfx::translation_matrix(Vector3<float>(20, 0, 0)), {} };
+    for (size_t i = 0; i < 3; ++i) {
+        auto bitmap = paint();
+        EXPECT_EQ(bitmap->get_pixel(5, 5), Gfx::Color::White);
+        EXPECT_EQ(bitmap->get_pixel(25, 5), Gfx::Color::Red);
+        EXPECT_EQ(bitmap->get_pixel(35, 5), Gfx::Color::White);
+    }
+
+    // Changing a node inside the layer invalidates the raster.
+    visual_context_tree.node_at(clip).data = ClipData { Web::DevicePixelRect { 0, 0, 5, 10 }, {} };
+    for (size_t i = 0; i < 3; ++i) {
+        auto bitmap = paint();
+        EXPECT_EQ(bitmap->get_pixel(22, 5), Gfx::Color::Red);
+        EXPECT_EQ(bitmap->get_pixel(27, 5), Gfx::Color::White);
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/Compositor/FrameScheduler.h>
+#include <LibWeb/Compositor/FrameTiming.h>
+
+using Web::Compositor::FrameScheduler;
+using Web::Compositor::FrameTiming;
+using Web::Compositor::FrameTimingStage;
+
+static AK::Duration milliseconds(i64 milliseconds)
+{
+    return AK::Duration::from_milliseconds(milliseconds);
+}
+
+static FrameTiming make_frame_timing(MonotonicTime rendering_opportunity, AK::Duration main_thread_cost, Optional<MonotonicTime> vsync_tick = {})
+{
+    FrameTiming frame_timing;
+    frame_timing.record(FrameTimingStage::RenderingOpportunity, rendering_opportunity);
+    frame_timing.record(FrameTimingStage::IPCSend, rendering_opportunity + main_thread_cost);
+    if (vsync_tick.has_value())
+        frame_timing.record(FrameTimingStage::VSyncTick, *vsync_tick);
+    return frame_timing;
+}
+
+static void feed_frames(FrameScheduler& scheduler, MonotonicTime vsync_tick, size_t count, AK::Duration main_thread_cost)
+{
+    for (size_t i = 0; i < count; ++i)
+        scheduler.did_finish_frame(make_frame_timing(vsync_tick - milliseconds(50), main_thread_cost, vsync_tick));
+}
+
+TEST_CASE(updates_are_a_refresh_interval_apart_without_a_vsync)
+{
+    FrameScheduler scheduler { 100.0 };
+    auto now = MonotonicTime::now();
+
+    EXPECT_EQ(scheduler.schedule_rendering_update(now) - now, AK::Duration::zero());
+    EXPECT_EQ(scheduler.schedule_rendering_update(now) - now, milliseconds(10));
+}
+
+TEST_CASE(updates_start_ahead_of_vsync_by_the_predicted_cost)
+{
+    FrameScheduler scheduler { 100.0 };
+    auto vsync_tick = MonotonicTime::now();
+    feed_frames(scheduler, vsync_tick, 8, milliseconds(4));
+    EXPECT_EQ(scheduler.predicted_main_thread_cost(), milliseconds(4));
+
+    // The next vsync is 10ms after the last one, and the update needs 4ms plus a 1ms safety margin.
+    EXPECT_EQ(scheduler.schedule_rendering_update(vsync_tick + milliseconds(1)) - vsync_tick, milliseconds(5));
+
+    // The following update aims at the vsync after that, even if it is requested right away.
+    EXPECT_EQ(scheduler.schedule_rendering_update(vsync_tick + milliseconds(6)) - vsync_tick, milliseconds(15));
+}
+
+TEST_CASE(a_single_slow_frame_does_not_change_the_prediction)
+{
+    FrameScheduler scheduler { 100.0 };
+    auto vsync_tick = MonotonicTime::now();
+    feed_frames(scheduler, vsync_tick, 7, milliseconds(4));
+    feed_frames(scheduler, vsync_tick, 1, milliseconds(30));
+
+    EXPECT_EQ(scheduler.predicted_main_thread_cost(), milliseconds(4));
+    EXPECT(!scheduler.is_running_at_half_rate());
+}
+
+TEST_CASE(sustained_overload_drops_to_half_rate_and_recovers)
+{
+    FrameScheduler scheduler { 100.0 };
+    auto vsync_tick = MonotonicTime::now();
+    feed_frames(scheduler, vsync_tick, 8, milliseconds(15));
+    EXPECT(scheduler.is_running_at_half_rate());
+
+    // Frames are aimed at every other vsync, starting 16ms ahead of it.
+    EXPECT_EQ(scheduler.schedule_rendering_update(vsync_tick + milliseconds(1)) - vsync_tick, milliseconds(4));
+    EXPECT_EQ(scheduler.schedule_rendering_update(vsync_tick + milliseconds(5)) - vsync_tick, milliseconds(24));
+
+    // Being just under budget again isn't enough to go back to the full rate.
+    feed_frames(scheduler, vsync_tick, 16, milliseconds(9));
+    EXPECT(scheduler.is_running_at_half_rate());
+
+    feed_frames(scheduler, vsync_tick, 16, milliseconds(5));
+    EXPECT(!scheduler.is_running_at_half_rate());
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/IndexedDB/Internal/RecordList.h>
+
+using Web::IndexedDB::RecordList;
+
+struct TestRecord {
+    int key { 0 };
+};
+
+static constexpr size_t PAGE_SIZE = RecordList<TestRecord>::MAXIMUM_PAGE_SIZE;
+
+static void expect_keys(RecordList<TestRecord> const& list, Vector<int> const& expected)
+{
+    EXPECT_EQ(list.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_EQ(list[i].key, expected[i]);
+
+    size_t index = 0;
+    for (auto const& record : list) {
+        EXPECT_EQ(record.key, expected[index]);
+        ++index;
+    }
+    EXPECT_EQ(index, expected.size());
+}
+
+TEST_CASE(append_spans_pages)
+{
+    RecordList<TestRecord> list;
+    Vector<int> expected;
+    for (int i = 0; i < static_cast<int>(PAGE_SIZE * 3 + 7); ++i) {
+        list.append({ i });
+        expected.append(i);
+    }
+    expect_keys(list, expected);
+    EXPECT_EQ(list.last().key, expected.last());
+}
+
+TEST_CASE(insert_splits_full_pages)
+{
+    RecordList<TestRecord> list;
+    Vector<int> expected;
+
+    // Insert every record at the front, so that the first page is split over and over.
+    for (int i = static_cast<int>(PAGE_SIZE * 4); i >= 0; --i) {
+        list.insert(0, { i });
+        expected.insert(0, i);
+    }
+    expect_keys(list, expected);
+
+    for (int i = 0; i < 100; ++i) {
+        auto index = (static_cast<size_t>(i) * 37) % list.size();
+        list.insert(index, { -i });
+        expected.insert(index, -i);
+    }
+    expect_keys(list, expected);
+}
+
+TEST_CASE(remove_across_pages)
+{
+    RecordList<TestRecord> list;
+    Vector<int> expected;
+    for (int i = 0; i < static_cast<int>(PAGE_SIZE * 4); ++i) {
+        list.append({ i });
+        expected.append(i);
+    }
+
+    list.remove(PAGE_SIZE / 2, PAGE_SIZE * 2);
+    expected.remove(PAGE_SIZE / 2, PAGE_SIZE * 2);
+    expect_keys(list, expected);
+
+    EXPECT_EQ(list.take(PAGE_SIZE).key, expected.take(PAGE_SIZE));
+    expect_keys(list, expected);
+
+    Vector<int> removed;
+    list.remove_all_matching([](auto const& record) { return record.key % 3 == 0; }, [&](auto record) { removed.append(record.key); });
+    Vector<int> expected_removed;
+    expected.remove_all_matching([&](int key) {
+        if (key % 3 != 0)
+            return false;
+        expected_removed.append(key);
+        return true;
+    });
+    expect_keys(list, expected);
+    EXPECT_EQ(removed, expected_removed);
+
+    list.remove(0, list.size());
+    EXPECT(list.is_empty());
+    EXPECT(list.begin() == list.end());
+}
+
+TEST_CASE(take_all_returns_records_in_order)
+{
+    RecordList<TestRecord> list;
+    for (int i = 0; i < static_cast<int>(PAGE_SIZE * 2 + 1); ++i)
+        list.insert(list.size() / 2, { i });
+
+    Vector<int> expected;
+    for (auto const& record : list)
+        expected.append(record.key);
+
+    auto records = list.take_all();
+    EXPECT(list.is_empty());
+    EXPECT_EQ(records.size(), expected.size());
+    for (size_t i = 0; i < records.size(); ++i)
+        EXPECT_EQ(records[i].key, expected[i]);
+}
+
+TEST_CASE(bounded_scans)
+{
+    RecordList<TestRecord> list;
+    for (int i = 0; i < static_cast<int>(PAGE_SIZE * 3); ++i)
+        list.append({ i });
+
+    auto is_even = [](auto const& record) { return record.key % 2 == 0; };
+
+    auto first = list.first_matching(PAGE_SIZE - 1, is_even);
+    EXPECT(first.has_value());
+    EXPECT_EQ(first->key, static_cast<int>(PAGE_SIZE));
+    EXPECT(!list.first_matching(list.size(), is_even).has_value());
+
+    auto last = list.last_matching(PAGE_SIZE + 1, is_even);
+    EXPECT(last.has_value());
+    EXPECT_EQ(last->key, static_cast<int>(PAGE_SIZE));
+    EXPECT(!list.last_matching(0, is_even).has_value());
+
+    auto last_overall = list.last_matching(list.size() + 10, [](auto const&) { return true; });
+    EXPECT(last_overall.has_value());
+    EXPECT_EQ(last_overall->key, static_cast<int>(PAGE_SIZE * 3 - 1));
+}
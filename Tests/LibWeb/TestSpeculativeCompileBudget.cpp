@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/HTML/Scripting/Fetching.h>
+
+using Web::HTML::select_functions_for_speculative_compile;
+using Web::HTML::speculative_compile_code_unit_budget;
+
+TEST_CASE(functions_within_the_budget_are_all_selected)
+{
+    Vector<size_t> source_lengths { 100, 2000, 30 };
+    EXPECT_EQ(select_functions_for_speculative_compile(source_lengths), (Vector<size_t> { 0, 1, 2 }));
+
+    EXPECT(select_functions_for_speculative_compile({}).is_empty());
+}
+
+TEST_CASE(budget_is_not_exceeded)
+{
+    auto quarter = speculative_compile_code_unit_budget / 4;
+
+    // The fifth function no longer fits, even though it is no larger than the first four.
+    Vector<size_t> source_lengths { quarter, quarter, quarter, quarter, quarter };
+    EXPECT_EQ(select_functions_for_speculative_compile(source_lengths), (Vector<size_t> { 0, 1, 2, 3 }));
+
+    // A function that uses up exactly the whole budget fits on its own.
+    source_lengths = { speculative_compile_code_unit_budget, 1 };
+    EXPECT_EQ(select_functions_for_speculative_compile(source_lengths), (Vector<size_t> { 0 }));
+
+    source_lengths = { speculative_compile_code_unit_budget + 1 };
+    EXPECT(select_functions_for_speculative_compile(source_lengths).is_empty());
+}
+
+TEST_CASE(smaller_functions_after_one_that_does_not_fit_are_still_selected)
+{
+    Vector<size_t> source_lengths { speculative_compile_code_unit_budget - 10, 500, 10, 1 };
+    EXPECT_EQ(select_functions_for_speculative_compile(source_lengths), (Vector<size_t> { 0, 2 }));
+}
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <AK/Array.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Environment.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/Timer.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibGfx/SystemTheme.h>
+#include <LibMain/Main.h>
+#include <LibURL/URL.h>
+#include <LibWebView/Application.h>
+#include <LibWebView/HeadlessWebView.h>
+#include <LibWebView/Utilities.h>
+#include <errno.h>
+
+namespace LayoutBench {
+
+class Application : public WebView::Application {
+    WEB_VIEW_APPLICATION(Application)
+
+public:
+    explicit Application(Optional<ByteString> ladybird_binary_path)
+        : WebView::Application(move(ladybird_binary_path))
+    {
+        if (auto ladybird_source_dir = Core::Environment::get("LADYBIRD_SOURCE_DIR"sv); ladybird_source_dir.has_value())
+            bench_root_path = LexicalPath::join(*ladybird_source_dir, "Tests"sv, "LibWeb"sv, "Bench"sv).string();
+    }
+
+    virtual void create_platform_arguments(Core::ArgsParser& args_parser) override
+    {
+        args_parser.add_option(bench_root_path, "Path containing the benchmark harness and synthetic corpus", "bench-path", 0, "path");
+        args_parser.add_option(corpus_paths, "Additional page or directory of pages to benchmark, e.g. saved real-world pages", "corpus", 'c', "path");
+        args_parser.add_option(page_globs, "Only benchmark pages matching the given glob", "filter", 'f', "glob");
+        args_parser.add_option(iterations, "Number of rendering updates measured per invalidation pattern (default: 20)", "iterations", 'n', "count");
+        args_parser.add_option(output_path, "Write the JSON report to this file instead of stdout", "output", 'o', "path");
+        args_parser.add_option(baseline_path, "Compare against the JSON report of an earlier run, failing on regressions", "baseline", 'b', "path");
+        args_parser.add_option(regression_threshold_percent, "Slowdown of a median that counts as a regression (default: 10)", "threshold", 't', "percent");
+        args_parser.add_option(per_page_timeout_in_seconds, "Per-page timeout (default: 120)", "per-page-timeout", 0, "seconds");
+    }
+
+    virtual void create_platform_options(WebView::BrowserOptions& browser_options, WebView::RequestServerOptions& request_server_options, WebView::WebContentOptions& web_content_options) override
+    {
+        browser_options.headless_mode = WebView::HeadlessMode::Test;
+        browser_options.disable_sql_database = WebView::DisableSQLDatabase::Yes;
+
+        request_server_options.http_disk_cache_mode = WebView::HTTPDiskCacheMode::Testing;
+
+        // The harness needs window.internals.
+        web_content_options.is_test_mode = WebView::IsTestMode::Yes;
+
+        // Keep font rendering, and so text layout, comparable between machines.
+        web_content_options.force_fontconfig = WebView::ForceFontconfig::Yes;
+    }
+
+    virtual bool should_coordinate_browser_process() const override { return false; }
+
+    virtual ErrorOr<LexicalPath> default_path_for_downloaded_file(ByteString const&) const override { return Error::from_errno(ECANCELED); }
+
+    ByteString bench_root_path;
+    Vector<ByteString> corpus_paths;
+    Vector<ByteString> page_globs;
+    size_t iterations { 20 };
+    ByteString output_path;
+    ByteString baseline_path;
+    double regression_threshold_percent { 10 };
+    int per_page_timeout_in_seconds { 120 };
+};
+
+// Medians that moved by less than this are timer noise, however large the relative change.
+static constexpr double REGRESSION_FLOOR_IN_MILLISECONDS = 0.1;
+
+static constexpr Array REPORTED_PERCENTILES { 50u, 90u, 99u };
+
+struct Page {
+    ByteString name;
+    URL::URL url;
+};
+
+static bool is_page(StringView name)
+{
+    return name.ends_with(".html"sv) || name.ends_with(".htm"sv) || name.ends_with(".xhtml"sv);
+}
+
+static ErrorOr<void> collect_pages(Vector<Page>& pages, ByteString const& path, ByteString const& root_path)
+{
+    auto real_path = TRY(FileSystem::real_path(path));
+
+    if (FileSystem::is_directory(real_path)) {
+        Core::DirIterator it(real_path, Core::DirIterator::Flags::SkipDots);
+        while (it.has_next())
+            TRY(collect_pages(pages, LexicalPath::join(real_path, it.next_path()).string(), root_path));
+        return {};
+    }
+
+    if (!is_page(real_path))
+        return {};
+
+    auto name = LexicalPath::relative_path(real_path, root_path).value_or(real_path);
+    auto const& globs = Application::the().page_globs;
+    if (!globs.is_empty() && !any_of(globs, [&](auto const& glob) { return name.matches(glob); }))
+        return {};
+
+    pages.append({ move(name), URL::create_with_file_scheme(real_path).release_value() });
+    return {};
+}
+
+static JsonObject summarize_samples(JsonArray const& samples)
+{
+    Vector<double> values;
+    values.ensure_capacity(samples.size());
+    samples.for_each([&](JsonValue const& sample) {
+        values.unchecked_append(sample.get_double_with_precision_loss().value_or(0));
+    });
+    quick_sort(values);
+
+    JsonObject summary;
+    for (auto percentile : REPORTED_PERCENTILES) {
+        // Nearest-rank percentile.
+        double value = 0;
+        if (!values.is_empty())
+            value = values[max(ceil_div(percentile * values.size(), 100uz), 1uz) - 1];
+        summary.set(ByteString::formatted("p{}", percentile), value);
+    }
+    return summary;
+}
+
+// The page reports { pattern: { phase: [milliseconds...] } }, which becomes { pattern: { phase: { p50, p90, p99 } } }.
+static ErrorOr<JsonObject> summarize_page(StringView page_output)
+{
+    auto samples = TRY(JsonValue::from_string(page_output));
+    if (!samples.is_object())
+        return Error::from_string_literal("Page did not report an object of samples");
+
+    JsonObject patterns;
+    samples.as_object().for_each_member([&](String const& pattern, JsonValue const& phases) {
+        if (!phases.is_object())
+            return;
+
+        JsonObject phase_summaries;
+        phases.as_object().for_each_member([&](String const& phase, JsonValue const& phase_samples) {
+            if (phase_samples.is_array())
+                phase_summaries.set(phase, summarize_samples(phase_samples.as_array()));
+        });
+        patterns.set(pattern, move(phase_summaries));
+    });
+    return patterns;
+}
+
+static ErrorOr<JsonObject> run_page(WebView::HeadlessWebView& view, Page const& page, String const& harness)
+{
+    Optional<String> result;
+    bool timed_out = false;
+
+    view.on_load_finish = [&](URL::URL const& loaded_url) {
+        // We don't want subframe loads to start the harness.
+        if (page.url.equals(loaded_url, URL::ExcludeFragment::Yes))
+            view.run_javascript(harness);
+    };
+    view.on_test_finish = [&](String const& text) {
+        result = text;
+    };
+
+    auto timer = Core::Timer::create_single_shot(Application::the().per_page_timeout_in_seconds * 1000, [&] {
+        timed_out = true;
+    });
+    timer->start();
+
+    view.load(page.url);
+    Core::EventLoop::current().spin_until([&] { return result.has_value() || timed_out; });
+
+    timer->stop();
+    view.on_load_finish = nullptr;
+    view.on_test_finish = nullptr;
+
+    if (!result.has_value())
+        return Error::from_string_literal("Timed out waiting for the page to report its timings");
+    return summarize_page(*result);
+}
+
+static ErrorOr<size_t> count_regressions_against_baseline(JsonObject const& pages, StringView baseline_path)
+{
+    auto file = TRY(Core::File::open(baseline_path, Core::File::OpenMode::Read));
+    auto baseline = TRY(JsonValue::from_string(TRY(file->read_until_eof())));
+    if (!baseline.is_object() || !baseline.as_object().get_object("pages"sv).has_value())
+        return Error::from_string_literal("Baseline is not a layout-bench report");
+    auto const& baseline_pages = *baseline.as_object().get_object("pages"sv);
+
+    auto threshold = 1 + Application::the().regression_threshold_percent / 100;
+    size_t regression_count = 0;
+
+    // Only the medians are compared, the tail percentiles are too noisy to fail on.
+    pages.for_each_member([&](String const& page, JsonValue const& patterns) {
+        auto baseline_patterns = baseline_pages.get_object(page);
+        if (!baseline_patterns.has_value())
+            return;
+
+        patterns.as_object().for_each_member([&](String const& pattern, JsonValue const& phases) {
+            auto baseline_phases = baseline_patterns->get_object(pattern);
+            if (!baseline_phases.has_value())
+                return;
+
+            phases.as_object().for_each_member([&](String const& phase, JsonValue const& summary) {
+                auto baseline_summary = baseline_phases->get_object(phase);
+                if (!baseline_summary.has_value())
+                    return;
+
+                auto current = summary.as_object().get_double_with_precision_loss("p50"sv).value_or(0);
+                auto previous = baseline_summary->get_double_with_precision_loss("p50"sv).value_or(0);
+                if (current - previous <= REGRESSION_FLOOR_IN_MILLISECONDS || current <= previous * threshold)
+                    return;
+
+                warnln("Regression in {} ({}, {}): median went from {:.3}ms to {:.3}ms", page, pattern, phase, previous, current);
+                ++regression_count;
+            });
+        });
+    });
+
+    return regression_count;
+}
+
+static ErrorOr<int> run_benchmarks(Core::AnonymousBuffer const& theme, Web::DevicePixelSize window_size)
+{
+    auto& app = Application::the();
+
+    Vector<Page> pages;
+    auto corpus_root_path = TRY(FileSystem::real_path(LexicalPath::join(app.bench_root_path, "input"sv).string()));
+    TRY(collect_pages(pages, corpus_root_path, corpus_root_path));
+    for (auto const& path : app.corpus_paths) {
+        auto absolute_path = LexicalPath::absolute_path(TRY(FileSystem::current_working_directory()), path);
+        TRY(collect_pages(pages, absolute_path, LexicalPath { absolute_path }.dirname()));
+    }
+    quick_sort(pages, [](auto const& a, auto const& b) { return a.name < b.name; });
+
+    if (pages.is_empty()) {
+        warnln("Error: No pages to benchmark.");
+        return 1;
+    }
+
+    auto harness_file = TRY(Core::File::open(LexicalPath::join(app.bench_root_path, "harness.js"sv).string(), Core::File::OpenMode::Read));
+    auto harness_source = TRY(harness_file->read_until_eof());
+    auto harness = TRY(String::formatted("globalThis.__layoutBenchIterations = {};\n{}", app.iterations, StringView { harness_source }));
+
+    auto view = WebView::HeadlessWebView::create(theme, window_size);
+
+    // Wait for the initial about:blank load to complete, otherwise WebContent may drop the first page load.
+    bool loaded_initial_page = false;
+    view->on_load_finish = [&](auto const&) { loaded_initial_page = true; };
+    Core::EventLoop::current().spin_until([&] { return loaded_initial_page; });
+
+    JsonObject page_reports;
+    size_t failed_page_count = 0;
+
+    for (auto const& page : pages) {
+        warnln("Benchmarking {}", page.name);
+
+        auto summary = run_page(*view, page, harness);
+        if (summary.is_error()) {
+            warnln("Error: {}: {}", page.name, summary.error());
+            ++failed_page_count;
+            continue;
+        }
+        page_reports.set(page.name, summary.release_value());
+    }
+
+    JsonObject report;
+    report.set("iterations"sv, app.iterations);
+    report.set("pages"sv, page_reports);
+
+    if (app.output_path.is_empty()) {
+        outln("{}", report.serialized());
+    } else {
+        auto output_file = TRY(Core::File::open(app.output_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(output_file->write_until_depleted(report.serialized()));
+    }
+
+    size_t regression_count = 0;
+    if (!app.baseline_path.is_empty())
+        regression_count = TRY(count_regressions_against_baseline(page_reports, app.baseline_path));
+
+    return failed_page_count + regression_count == 0 ? 0 : 1;
+}
+
+}
+
+ErrorOr<int> ladybird_main(Main::Arguments arguments)
+{
+#if defined(LADYBIRD_BINARY_PATH)
+    auto app = TRY(LayoutBench::Application::create(arguments, LADYBIRD_BINARY_PATH));
+#else
+    auto app = TRY(LayoutBench::Application::create(arguments, OptionalNone {}));
+#endif
+
+    if (app->bench_root_path.is_empty()) {
+        warnln("Error: --bench-path must be passed to specify the location of the benchmark corpus.");
+        return 1;
+    }
+    app->bench_root_path = LexicalPath::absolute_path(TRY(FileSystem::current_working_directory()), app->bench_root_path);
+
+    auto theme_path = LexicalPath::join(WebView::s_ladybird_resource_root, "themes"sv, "Default.ini"sv);
+    auto theme = TRY(Gfx::load_system_theme(theme_path.string()));
+
+    auto const& browser_options = LayoutBench::Application::browser_options();
+    Web::DevicePixelSize window_size { browser_options.window_width, browser_options.window_height };
+
+    return LayoutBench::run_benchmarks(theme, window_size);
+}
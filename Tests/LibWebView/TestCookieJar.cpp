@@ -94,3 +94,38 @@ TEST_CASE(newer_cookie_schema_reports_database_too_new)
     EXPECT_EQ(TRY_OR_FAIL(WebView::CookieJar::migrate_schema(*database)), Database::MigrationOutcome::DatabaseTooNew);
     EXPECT_EQ(TRY_OR_FAIL(WebView::CookieJar::migrate_schema(*database, Database::MigrationMode::CheckOnly)), Database::MigrationOutcome::DatabaseTooNew);
 }
+
+TEST_CASE(cookies_are_matched_by_host_and_parent_domains)
+{
+    auto jar = WebView::CookieJar::create();
+    auto expiry_time = UnixDateTime::now() + AK::Duration::from_seconds(3600);
+
+    jar->set_cookie(parse_url("https://www.example.com/"sv), { .name = "domain"_string, .value = "1"_string, .expiry_time_from_expires_attribute = expiry_time, .domain = "example.com"_string }, HTTP::Cookie::Source::Http);
+    jar->set_cookie(parse_url("https://www.example.com/"sv), { .name = "host"_string, .value = "2"_string, .expiry_time_from_expires_attribute = expiry_time, .path = "/path"_string }, HTTP::Cookie::Source::Http);
+    jar->set_cookie(parse_url("https://example.org/"sv), { .name = "other"_string, .value = "3"_string, .expiry_time_from_expires_attribute = expiry_time }, HTTP::Cookie::Source::Http);
+
+    EXPECT_EQ(jar->get_cookie(parse_url("https://www.example.com/path"sv), HTTP::Cookie::Source::Http), "host=2; domain=1"sv);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://www.example.com/"sv), HTTP::Cookie::Source::Http), "domain=1"sv);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://sub.www.example.com/path"sv), HTTP::Cookie::Source::Http), "domain=1"sv);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://example.com/"sv), HTTP::Cookie::Source::Http), "domain=1"sv);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://notexample.com/"sv), HTTP::Cookie::Source::Http), ""sv);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://example.org/"sv), HTTP::Cookie::Source::Http), "other=3"sv);
+}
+
+TEST_CASE(expired_cookies_are_no_longer_matched)
+{
+    auto jar = WebView::CookieJar::create();
+    auto url = parse_url("https://example.com/"sv);
+
+    jar->set_cookie(url, { .name = "short"_string, .value = "1"_string, .expiry_time_from_max_age_attribute = UnixDateTime::now() + AK::Duration::from_seconds(60) }, HTTP::Cookie::Source::Http);
+    jar->set_cookie(url, { .name = "long"_string, .value = "2"_string, .expiry_time_from_max_age_attribute = UnixDateTime::now() + AK::Duration::from_seconds(3600) }, HTTP::Cookie::Source::Http);
+    EXPECT_EQ(jar->get_all_cookies().size(), 2uz);
+
+    jar->expire_cookies_with_time_offset(AK::Duration::from_seconds(120));
+    EXPECT_EQ(jar->get_all_cookies().size(), 1uz);
+    EXPECT_EQ(jar->get_cookie(url, HTTP::Cookie::Source::Http), "long=2"sv);
+
+    jar->expire_cookies_with_time_offset(AK::Duration::from_seconds(7200));
+    EXPECT(jar->get_all_cookies().is_empty());
+    EXPECT_EQ(jar->get_cookie(url, HTTP::Cookie::Source::Http), ""sv);
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObject.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibTest/TestCase.h>
+#include <LibWebView/HeadlessBatchRenderer.h>
+
+using Job = WebView::HeadlessBatchRenderer::Job;
+
+static constexpr Web::DevicePixelSize default_viewport_size { 800, 600 };
+
+static ErrorOr<Job> parse_job(StringView line)
+{
+    return WebView::HeadlessBatchRenderer::parse_job(line, default_viewport_size);
+}
+
+TEST_CASE(parse_job_with_every_option)
+{
+    auto job = TRY_OR_FAIL(parse_job(R"({"id": "front-page", "url": "https://ladybird.org", "output": "/tmp/ladybird.webp", "width": 1280, "height": 720, "full_page": false, "delay": 250, "timeout": 5000})"sv));
+
+    EXPECT_EQ(job.id.as_string(), "front-page"sv);
+    EXPECT_EQ(job.url.serialize(), "https://ladybird.org/"sv);
+    EXPECT_EQ(job.output_path.string(), "/tmp/ladybird.webp"sv);
+    EXPECT_EQ(job.viewport_size, Web::DevicePixelSize(1280, 720));
+    EXPECT_EQ(job.screenshot_type, WebView::ViewImplementation::ScreenshotType::Visible);
+    EXPECT_EQ(job.delay_in_milliseconds, 250u);
+    EXPECT_EQ(job.timeout_in_milliseconds, 5000u);
+}
+
+TEST_CASE(parse_job_with_defaults)
+{
+    auto job = TRY_OR_FAIL(parse_job(R"({"url": "https://ladybird.org", "output": "ladybird.png"})"sv));
+
+    EXPECT(job.id.is_null());
+    EXPECT_EQ(job.viewport_size, default_viewport_size);
+    EXPECT_EQ(job.screenshot_type, WebView::ViewImplementation::ScreenshotType::Full);
+    EXPECT_EQ(job.delay_in_milliseconds, 0u);
+    EXPECT_EQ(job.timeout_in_milliseconds, 30'000u);
+
+    // Relative output paths are resolved against the working directory, as the screenshot is saved by the view.
+    auto working_directory = TRY_OR_FAIL(FileSystem::current_working_directory());
+    EXPECT_EQ(job.output_path.string(), LexicalPath::join(working_directory, "ladybird.png"sv).string());
+}
+
+TEST_CASE(parse_invalid_jobs)
+{
+    EXPECT(parse_job("not json"sv).is_error());
+    EXPECT(parse_job(R"(["https://ladybird.org", "ladybird.png"])"sv).is_error());
+    EXPECT(parse_job(R"({"output": "ladybird.png"})"sv).is_error());
+    EXPECT(parse_job(R"({"url": "https://ladybird.org"})"sv).is_error());
+    EXPECT(parse_job(R"({"url": "https://ladybird.org", "output": ""})"sv).is_error());
+    EXPECT(parse_job(R"({"url": "https://ladybird.org", "output": "ladybird.png", "width": 0})"sv).is_error());
+    EXPECT(parse_job(R"({"url": "https://ladybird.org", "output": "ladybird.png", "height": -1})"sv).is_error());
+}
+
+TEST_CASE(report_finished_job)
+{
+    auto job = TRY_OR_FAIL(parse_job(R"({"id": 7, "url": "https://ladybird.org", "output": "/tmp/ladybird.png"})"sv));
+
+    auto report = WebView::HeadlessBatchRenderer::create_job_report(job, LexicalPath { "/tmp/ladybird.png" }, AK::Duration::from_milliseconds(1234));
+    EXPECT_EQ(report.get_i64("id"sv), 7);
+    EXPECT_EQ(report.get_string("url"sv), "https://ladybird.org/"sv);
+    EXPECT_EQ(report.get_string("output"sv), "/tmp/ladybird.png"sv);
+    EXPECT_EQ(report.get_i64("milliseconds"sv), 1234);
+    EXPECT(!report.has("error"sv));
+}
+
+TEST_CASE(report_failed_job)
+{
+    auto job = TRY_OR_FAIL(parse_job(R"({"id": 7, "url": "https://ladybird.org", "output": "/tmp/ladybird.png"})"sv));
+
+    auto report = WebView::HeadlessBatchRenderer::create_job_report(job, Error::from_string_literal("Timed out"), AK::Duration::from_milliseconds(30'000));
+    EXPECT_EQ(report.get_i64("id"sv), 7);
+    EXPECT_EQ(report.get_string("error"sv), "Timed out"sv);
+    EXPECT_EQ(report.get_i64("milliseconds"sv), 30'000);
+    EXPECT(!report.has("output"sv));
+}
+
+TEST_CASE(report_unparsable_job)
+{
+    auto error = parse_job(R"({"output": "ladybird.png"})"sv).release_error();
+
+    auto report = WebView::HeadlessBatchRenderer::create_parse_error_report(error);
+    EXPECT_EQ(report.get_string("error"sv), "Job has no \"url\""sv);
+    EXPECT_EQ(report.size(), 1u);
+}
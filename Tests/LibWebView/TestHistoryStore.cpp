@@ -843,3 +843,54 @@ TEST_CASE(history_ranking_signal_migration_preserves_existing_entries)
     EXPECT_EQ(entry->score_updated_at, UnixDateTime::from_seconds_since_epoch(123));
     EXPECT_APPROXIMATE(entry->decayed_visit_score, 8.0);
 }
+
+TEST_CASE(persisted_history_search_index_follows_title_updates_and_removals)
+{
+    auto database = TRY_OR_FAIL(Database::Database::create_memory_backed());
+    auto store = create_persisted_store(*database);
+
+    auto url = parse_url("https://example.com/"sv);
+    store->record_visit(url, "Stale title"_string, UnixDateTime::from_seconds_since_epoch(10));
+    store->update_title(url, "Fresh title"_string);
+
+    EXPECT(store->autocomplete_entries("stale"sv, 8).is_empty());
+    EXPECT(store->list_entries("stale"sv).is_empty());
+
+    auto entries = store->autocomplete_entries("fresh"sv, 8);
+    VERIFY(entries.size() == 1);
+    EXPECT_EQ(entries[0].url, "https://example.com/"_string);
+    EXPECT_EQ(store->list_entries("fresh"sv).size(), 1uz);
+
+    store->remove_entry_for_url(url);
+    EXPECT(store->autocomplete_entries("fresh"sv, 8).is_empty());
+    EXPECT(store->list_entries("fresh"sv).is_empty());
+}
+
+TEST_CASE(history_search_index_migration_indexes_existing_entries)
+{
+    auto database = TRY_OR_FAIL(Database::Database::create_memory_backed());
+    TRY_OR_FAIL(database->execute_raw(R"#(
+        CREATE TABLE SchemaVersions (store TEXT PRIMARY KEY, version INTEGER NOT NULL);
+        INSERT INTO SchemaVersions (store, version) VALUES ('History', 1);
+        CREATE TABLE History (
+            url TEXT PRIMARY KEY,
+            title TEXT NOT NULL,
+            favicon TEXT,
+            visit_count INTEGER NOT NULL,
+            last_visited_time INTEGER NOT NULL
+        );
+        INSERT INTO History (url, title, visit_count, last_visited_time)
+        VALUES ('https://example.com/existing-path', 'Existing page', 1, 123000);
+    )#"sv));
+
+    EXPECT_EQ(TRY_OR_FAIL(WebView::HistoryStore::migrate_schema(*database)), Database::MigrationOutcome::Success);
+    auto store = TRY_OR_FAIL(WebView::HistoryStore::create(*database));
+
+    auto title_entries = store->autocomplete_entries("existing page"sv, 8);
+    VERIFY(title_entries.size() == 1);
+    EXPECT_EQ(title_entries[0].url, "https://example.com/existing-path"_string);
+
+    auto url_entries = store->list_entries("existing-path"sv);
+    VERIFY(url_entries.size() == 1);
+    EXPECT_EQ(url_entries[0].url, "https://example.com/existing-path"_string);
+}
@@ -99,3 +99,56 @@ TEST_CASE(storage_quota_is_enforced_per_storage_key)
     // A different storage key has its own quota.
     EXPECT(jar->set_item(WebView::StorageEndpointType::LocalStorage, "https://other.example"_string, "a"_utf16, large_value).has<Optional<Utf16String>>());
 }
+
+TEST_CASE(storage_version_increases_with_every_change)
+{
+    auto jar = WebView::StorageJar::create();
+    auto version = jar->version();
+
+    jar->set_item(WebView::StorageEndpointType::LocalStorage, "https://example.com"_string, "key"_utf16, "value"_utf16);
+    EXPECT(jar->version() > version);
+    version = jar->version();
+
+    // Reads don't change anything, so they don't get a version.
+    (void)jar->get_item(WebView::StorageEndpointType::LocalStorage, "https://example.com"_string, "key"_utf16);
+    (void)jar->get_all_keys(WebView::StorageEndpointType::LocalStorage, "https://example.com"_string);
+    EXPECT_EQ(jar->version(), version);
+
+    jar->remove_item(WebView::StorageEndpointType::LocalStorage, "https://example.com"_string, "key"_utf16);
+    EXPECT(jar->version() > version);
+    version = jar->version();
+
+    jar->clear_storage_key(WebView::StorageEndpointType::LocalStorage, "https://example.com"_string);
+    EXPECT(jar->version() > version);
+}
+
+TEST_CASE(persisted_storage_usage_tracks_item_sizes)
+{
+    auto database = TRY_OR_FAIL(Database::Database::create_memory_backed());
+    EXPECT_EQ(TRY_OR_FAIL(WebView::StorageJar::migrate_schema(*database)), Database::MigrationOutcome::Success);
+
+    {
+        auto jar = TRY_OR_FAIL(WebView::StorageJar::create(*database));
+        jar->set_item(WebView::StorageEndpointType::LocalStorage, "https://example.com"_string, "key"_utf16, "value"_utf16);
+        jar->set_item(WebView::StorageEndpointType::SessionStorage, "https://example.com"_string, "other"_utf16, "v"_utf16);
+    }
+
+    // The sizes of items that were stored before the jar was created are included.
+    auto jar = TRY_OR_FAIL(WebView::StorageJar::create(*database));
+    EXPECT_EQ(jar->usage("https://example.com"_string), 14u);
+
+    jar->set_item(WebView::StorageEndpointType::LocalStorage, "https://example.com"_string, "key"_utf16, "v"_utf16);
+    EXPECT_EQ(jar->usage("https://example.com"_string), 10u);
+
+    jar->set_item(WebView::StorageEndpointType::LocalStorage, "https://example.com"_string, "é"_utf16, "v"_utf16);
+    EXPECT_EQ(jar->usage("https://example.com"_string), 13u);
+
+    jar->remove_item(WebView::StorageEndpointType::LocalStorage, "https://example.com"_string, "key"_utf16);
+    EXPECT_EQ(jar->usage("https://example.com"_string), 9u);
+
+    jar->clear_storage_key(WebView::StorageEndpointType::LocalStorage, "https://example.com"_string);
+    EXPECT_EQ(jar->usage("https://example.com"_string), 6u);
+
+    jar->remove_items_accessed_since(UnixDateTime::earliest());
+    EXPECT_EQ(jar->usage("https://example.com"_string), 0u);
+}
@@ -45,3 +45,61 @@ TEST_CASE(unicode_name)
     XML::Parser parser("<div 中文=\"\"></div>"sv);
     TRY_OR_FAIL(parser.parse());
 }
+
+namespace {
+
+struct EventCollector final : public XML::Listener {
+    virtual void element_start(Utf16FlyString const& name, Vector<XML::ListenerAttribute> const& attributes) override
+    {
+        events.appendff("<{}", name);
+        for (auto const& attribute : attributes)
+            events.appendff(" {}={}", attribute.name, attribute.value);
+        events.append('>');
+    }
+
+    virtual void element_end(Utf16FlyString const& name) override { events.appendff("</{}>", name); }
+    virtual void text(StringView data) override { events.append(data); }
+    virtual void document_end() override { events.append("[end]"sv); }
+
+    StringBuilder events;
+};
+
+}
+
+TEST_CASE(streaming_parser_with_chunked_input)
+{
+    EventCollector collector;
+    XML::StreamingParser parser { collector };
+
+    for (auto chunk : { "<ro"sv, "ot a=\"1"sv, "\">hello "sv, "wor"sv, "ld<child/></root"sv, ">"sv })
+        TRY_OR_FAIL(parser.parse_chunk(chunk));
+    EXPECT(!parser.is_finished());
+
+    TRY_OR_FAIL(parser.finish());
+    EXPECT(parser.is_finished());
+
+    // NB: Text may be reported in more than one piece, but never out of order.
+    EXPECT_EQ(collector.events.string_view(), "<root a=1>hello world<child></child></root>[end]"sv);
+}
+
+TEST_CASE(streaming_parser_with_malformed_input)
+{
+    EventCollector collector;
+    XML::StreamingParser parser { collector };
+
+    TRY_OR_FAIL(parser.parse_chunk("<root><a>"sv));
+    EXPECT(parser.parse_chunk("</b></root>"sv).is_error());
+    EXPECT(parser.is_finished());
+    EXPECT(collector.events.string_view().ends_with("[end]"sv));
+}
+
+TEST_CASE(streaming_parser_with_truncated_input)
+{
+    EventCollector collector;
+    XML::StreamingParser parser { collector };
+
+    TRY_OR_FAIL(parser.parse_chunk("<root><a>"sv));
+    EXPECT(parser.finish().is_error());
+    EXPECT(parser.is_finished());
+    EXPECT(collector.events.string_view().ends_with("[end]"sv));
+}
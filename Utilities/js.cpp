@@ -25,6 +25,7 @@
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/JSONObject.h>
 #include <LibJS/Runtime/Reference.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/StringPrototype.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Runtime/ValueInlines.h>
@@ -837,6 +838,8 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     bool use_test262_global = false;
     bool parse_only = false;
     StringView evaluate_script;
+    StringView profile_path;
+    double profile_interval_in_milliseconds = 1.0;
     Vector<StringView> script_paths;
 
     Core::ArgsParser args_parser;
@@ -854,6 +857,8 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
     args_parser.add_option(use_test262_global, "Use test262 global ($262)", "use-test262-global", {});
+    args_parser.add_option(profile_path, "Write a sampling profile in the Firefox Profiler format to the given path", "profile", {}, "path");
+    args_parser.add_option(profile_interval_in_milliseconds, "Interval between profile samples in milliseconds (default: 1)", "profile-interval", {}, "milliseconds");
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -939,9 +944,28 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
             source_name = "eval"sv;
         }
 
+        OwnPtr<JS::SamplingProfiler> profiler;
+        if (!profile_path.is_empty()) {
+            JS::SamplingProfiler::Options options;
+            options.interval = AK::Duration::from_microseconds(static_cast<i64>(profile_interval_in_milliseconds * 1000));
+            profiler = TRY(JS::SamplingProfiler::start(*g_vm, options));
+        }
+
         // We resolve modules as if it is the first file
 
-        if (!TRY(parse_and_run(realm, builder.string_view(), source_name, parse_only)))
+        auto did_run = TRY(parse_and_run(realm, builder.string_view(), source_name, parse_only));
+
+        if (profiler) {
+            profiler->stop();
+            if (auto dropped_sample_count = profiler->dropped_sample_count(); dropped_sample_count > 0)
+                warnln("Warning: The profiler dropped {} samples", dropped_sample_count);
+
+            auto profile = profiler->to_gecko_profile(source_name).serialized();
+            auto file = TRY(Core::File::open(profile_path, Core::File::OpenMode::Write));
+            TRY(file->write_until_depleted(profile.bytes()));
+        }
+
+        if (!did_run)
             return 1;
     }
 
@@ -7,7 +7,9 @@
 
 #include <AK/GenericLexer.h>
 #include <AK/Hex.h>
+#include <AK/JsonObject.h>
 #include <AK/MemoryStream.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StackInfo.h>
 #include <AK/Utf16String.h>
 #include <AK/Utf16StringBuilder.h>
@@ -317,6 +319,8 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     bool print = false;
     bool print_compiled = false;
     bool dump_native = false;
+    bool profile = false;
+    ByteString profile_trace_path;
     bool attempt_instantiate = false;
     bool export_all_imports = false;
     [[maybe_unused]] bool wasi = false;
@@ -339,6 +343,8 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     parser.add_option(print, "Print the parsed module", "print", 'p');
     parser.add_option(print_compiled, "Print the compiled module", "print-compiled");
     parser.add_option(dump_native, "Disassemble Cranelift-compiled native code for each function", "dump-native");
+    parser.add_option(profile, "Print per-function call counts, interpreted instruction counts and time-to-native on exit", "profile");
+    parser.add_option(profile_trace_path, "Write the function profile as Chrome trace events to a file on exit (implies --profile)", "profile-trace", 0, "file");
     parser.add_option(specific_function_address, "Optional compiled function address to print", "print-function", 'f', "address");
     parser.add_option(attempt_instantiate, "Attempt to instantiate the module", "instantiate", 'i');
     parser.add_option(exported_function_to_execute, "Attempt to execute the named exported function from the module (implies -i)", "execute", 'e', "name");
@@ -653,6 +659,26 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     if (!exported_function_to_execute.is_empty())
         attempt_instantiate = true;
 
+    if (!profile_trace_path.is_empty())
+        profile = true;
+    // Must be enabled before anything is validated, only functions validated afterwards are profiled.
+    if (profile)
+        Wasm::set_function_profiling_enabled(true);
+    ScopeGuard report_profile = [&] {
+        if (!profile)
+            return;
+        Wasm::dump_function_profiles();
+        if (profile_trace_path.is_empty())
+            return;
+        auto file = Core::File::open(profile_trace_path, Core::File::OpenMode::Write);
+        if (file.is_error()) {
+            warnln("Failed to open '{}' for writing: {}", profile_trace_path, file.error());
+            return;
+        }
+        if (auto result = file.value()->write_until_depleted(Wasm::function_profiles_as_json().serialized().bytes()); result.is_error())
+            warnln("Failed to write the profile trace to '{}': {}", profile_trace_path, result.error());
+    };
+
     auto parse_result = parse(filename);
     if (parse_result.is_null())
         return 1;